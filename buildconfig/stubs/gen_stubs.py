@@ -48,7 +48,13 @@ PG_AUTOIMPORT_SUBMODS = [
     "surface",
     "surflock",
     "sysfont",
-    "context"
+    "context",
+    "atlas",
+    "profiler",
+    "assets",
+    "tilemap",
+    "particles",
+    "sharedsurface",
 ]
 
 # pygame classes that are autoimported into main namespace are kept in this dict
@@ -61,6 +67,10 @@ PG_AUTOIMPORT_CLASSES = {
     "cursors": ["Cursor"],
     "bufferproxy": ["BufferProxy"],
     "mask": ["Mask"],
+    "atlas": ["Atlas"],
+    "tilemap": ["Tilemap"],
+    "particles": ["ParticleSystem"],
+    "sharedsurface": ["SharedSurface"],
 }
 
 # pygame modules from which __init__.py does the equivalent of
@@ -90,9 +100,10 @@ for k in PG_STAR_IMPORTS:
 
 # misc stubs that must be added to __init__.pyi
 misc_stubs = """
-from typing import Tuple, NoReturn
+from typing import Dict, Tuple, NoReturn
 
 def Overlay(format: int, size: Tuple[int, int]) -> NoReturn: ...
+def get_import_times() -> Dict[str, float]: ...
 """
 
 # write constants.pyi file
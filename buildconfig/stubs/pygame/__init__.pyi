@@ -5,9 +5,10 @@ A script to auto-generate constants.pyi and __init__.pyi typestubs
 IMPORTANT NOTE: Do not edit this file by hand!
 """
 
-from typing import Tuple, NoReturn
+from typing import Dict, Tuple, NoReturn
 
 def Overlay(format: int, size: Tuple[int, int]) -> NoReturn: ...
+def get_import_times() -> Dict[str, float]: ...
 
 from pygame import (
     display as display,
@@ -44,16 +45,47 @@ from pygame import (
     surflock as surflock,
     sysfont as sysfont,
     context as context,
+    atlas as atlas,
+    profiler as profiler,
+    assets as assets,
+    tilemap as tilemap,
+    particles as particles,
+    sharedsurface as sharedsurface,
 )
 
-from .rect import Rect as Rect
-from .surface import Surface as Surface, SurfaceType as SurfaceType
+from .rect import (
+    Rect as Rect,
+    FRect as FRect,
+    RectArray as RectArray,
+    RectIndex as RectIndex,
+    RectPacker as RectPacker,
+)
+from .surface import (
+    Surface as Surface,
+    SurfaceType as SurfaceType,
+    convert_many as convert_many,
+    get_bounding_rects as get_bounding_rects,
+    set_auto_convert as set_auto_convert,
+    get_auto_convert as get_auto_convert,
+    SurfacePool as SurfacePool,
+    SurfaceRegion as SurfaceRegion,
+    HDRSurface as HDRSurface,
+)
 from .color import Color as Color
 from .pixelarray import PixelArray as PixelArray
-from .math import Vector2 as Vector2, Vector3 as Vector3
+from .math import (
+    Vector2 as Vector2,
+    Vector2Array as Vector2Array,
+    Vector3 as Vector3,
+    Vector3Array as Vector3Array,
+)
 from .cursors import Cursor as Cursor
 from .bufferproxy import BufferProxy as BufferProxy
 from .mask import Mask as Mask
+from .atlas import Atlas as Atlas
+from .tilemap import Tilemap as Tilemap
+from .particles import ParticleSystem as ParticleSystem
+from .sharedsurface import SharedSurface as SharedSurface
 from .base import (
     BufferError as BufferError,
     HAVE_NEWBUF as HAVE_NEWBUF,
@@ -61,15 +93,26 @@ from .base import (
     get_array_interface as get_array_interface,
     get_error as get_error,
     get_init as get_init,
+    get_num_threads as get_num_threads,
+    get_parallel_threshold as get_parallel_threshold,
     get_sdl_byteorder as get_sdl_byteorder,
     get_sdl_version as get_sdl_version,
+    get_simd_backend as get_simd_backend,
+    get_simd_backends as get_simd_backends,
+    get_thread_pool_info as get_thread_pool_info,
     init as init,
     quit as quit,
     register_quit as register_quit,
+    save_trace as save_trace,
     set_error as set_error,
+    set_num_threads as set_num_threads,
+    set_simd_backend as set_simd_backend,
+    set_stats_enabled as set_stats_enabled,
+    stats as stats,
 )
 
 from .rwobject import (
+    Bundle as Bundle,
     encode_file_path as encode_file_path,
     encode_string as encode_string,
 )
@@ -177,6 +220,9 @@ from .constants import (
     FINGERDOWN as FINGERDOWN,
     FINGERMOTION as FINGERMOTION,
     FINGERUP as FINGERUP,
+    FONT_CENTER as FONT_CENTER,
+    FONT_LEFT as FONT_LEFT,
+    FONT_RIGHT as FONT_RIGHT,
     FULLSCREEN as FULLSCREEN,
     GL_ACCELERATED_VISUAL as GL_ACCELERATED_VISUAL,
     GL_ACCUM_ALPHA_SIZE as GL_ACCUM_ALPHA_SIZE,
@@ -577,6 +623,7 @@ from .constants import (
     OPENGL as OPENGL,
     OPENGLBLIT as OPENGLBLIT,
     PREALLOC as PREALLOC,
+    PREMULTIPLIED as PREMULTIPLIED,
     QUIT as QUIT,
     RENDER_DEVICE_RESET as RENDER_DEVICE_RESET,
     RENDER_TARGETS_RESET as RENDER_TARGETS_RESET,
@@ -1,6 +1,7 @@
-from typing import Dict, Union
+from typing import Any, Dict, Union
 
 def get_num_devices() -> int: ...
 def get_device(index: int) -> int: ...
 def get_num_fingers(device_id: int) -> int: ...
 def get_finger(touchid: int, index: int) -> Dict[str, Union[int, float]]: ...
+def get_fingers(touchid: int, out: Any) -> int: ...
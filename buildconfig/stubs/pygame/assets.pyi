@@ -0,0 +1,35 @@
+from typing import Iterable, List, Optional, Union
+
+from pygame._sdl2.video import Renderer, Texture
+from pygame.surface import Surface
+
+from ._common import FileArg
+
+class Batch:
+    total: int
+    loaded: int
+    def __init__(
+        self,
+        files: Iterable[FileArg],
+        convert: bool = False,
+        alpha: bool = False,
+        renderer: Optional[Renderer] = None,
+        event: int = 0,
+        chunk_size: int = 16,
+    ) -> None: ...
+    def __len__(self) -> int: ...
+    def done(self) -> bool: ...
+    def cancel(self) -> None: ...
+    def update(self) -> int: ...
+    def result(
+        self, timeout: Optional[float] = None
+    ) -> List[Union[Surface, Texture]]: ...
+
+def load_batch(
+    files: Iterable[FileArg],
+    convert: bool = False,
+    alpha: bool = False,
+    renderer: Optional[Renderer] = None,
+    event: int = 0,
+    chunk_size: int = 16,
+) -> Batch: ...
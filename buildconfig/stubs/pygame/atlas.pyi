@@ -0,0 +1,26 @@
+from typing import Iterable, List, Tuple
+
+from pygame._sdl2.video import Renderer, Texture
+from pygame.rect import Rect
+from pygame.surface import Surface
+
+from ._common import Coordinate
+
+class Atlas:
+    size: Tuple[int, int]
+    padding: int
+    flags: int
+    depth: int
+    pages: List[Surface]
+    def __init__(
+        self,
+        size: Coordinate = (1024, 1024),
+        padding: int = 1,
+        flags: int = ...,
+        depth: int = 32,
+    ) -> None: ...
+    def __len__(self) -> int: ...
+    def add(self, surface: Surface) -> Surface: ...
+    def add_many(self, surfaces: Iterable[Surface]) -> List[Surface]: ...
+    def locate(self, image: Surface) -> Tuple[int, Rect]: ...
+    def textures(self, renderer: Renderer) -> List[Texture]: ...
@@ -1,4 +1,4 @@
-from typing import Any, Tuple, Callable
+from typing import Any, Dict, List, Tuple, Callable
 
 class error(RuntimeError): ...
 class BufferError(Exception): ...
@@ -13,6 +13,16 @@ def get_error() -> str: ...
 def set_error(error_msg: str) -> None: ...
 def get_sdl_version() -> Tuple[int, int, int]: ...
 def get_sdl_byteorder() -> int: ...
+def set_num_threads(count: int) -> None: ...
+def get_num_threads() -> int: ...
+def get_parallel_threshold() -> int: ...
+def get_thread_pool_info() -> Tuple[int, int, int]: ...
+def get_simd_backends() -> List[str]: ...
+def get_simd_backend() -> str: ...
+def set_simd_backend(backend: str) -> None: ...
+def set_stats_enabled(enabled: bool, trace: bool = False) -> None: ...
+def stats(reset: bool = False) -> Dict[str, Dict[str, Dict[str, int]]]: ...
+def save_trace(file: Any) -> None: ...
 def register_quit(callable: Callable[[], Any]) -> None: ...
 
 # undocumented part of pygame API, kept here to make stubtest happy
@@ -1,5 +1,5 @@
 from abc import ABC, abstractmethod
-from typing import List, Optional, Sequence, Tuple, Union
+from typing import Dict, List, Optional, Sequence, Tuple, Union
 
 from pygame.surface import Surface
 
@@ -47,3 +47,13 @@ class Camera(AbstractCamera):
     def query_image(self) -> bool: ...
     def get_image(self, surface: Optional[Surface] = None) -> Surface: ...
     def get_raw(self) -> bytes: ...
+    def get_raw_view(self) -> memoryview: ...
+    def release_raw_view(self) -> None: ...
+    def export_dmabuf(self) -> int: ...
+    def start_capture(self, frames: int = 3, event: int = 0) -> None: ...
+    def stop_capture(self) -> None: ...
+    def get_latest(self, surface: Optional[Surface] = None) -> Optional[Surface]: ...
+    def get_next(
+        self, timeout: int = -1, surface: Optional[Surface] = None
+    ) -> Optional[Surface]: ...
+    def get_capture_stats(self) -> Dict[str, int]: ...
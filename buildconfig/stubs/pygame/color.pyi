@@ -53,3 +53,14 @@ class Color(Collection[int]):
     def update(self, r: int, g: int, b: int, a: int = 255) -> None: ...
     @overload
     def update(self, rgbvalue: ColorValue) -> None: ...
+
+# Buffer protocol is still not implemented in typing, hence the Any
+def correct_gamma_array(rgba: Any, gamma: float) -> None: ...
+def lerp_array(rgba: Any, color: Any, amount: float) -> None: ...
+def premul_alpha_array(rgba: Any) -> None: ...
+def rgba_to_hsva(rgba: Any, out: Any) -> None: ...
+def hsva_to_rgba(values: Any, out: Any) -> None: ...
+def rgba_to_hsla(rgba: Any, out: Any) -> None: ...
+def hsla_to_rgba(values: Any, out: Any) -> None: ...
+def rgba_to_yuva(rgba: Any, out: Any) -> None: ...
+def yuva_to_rgba(values: Any, out: Any) -> None: ...
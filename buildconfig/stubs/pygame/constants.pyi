@@ -108,6 +108,9 @@ DROPTEXT: int
 FINGERDOWN: int
 FINGERMOTION: int
 FINGERUP: int
+FONT_CENTER: int
+FONT_LEFT: int
+FONT_RIGHT: int
 FULLSCREEN: int
 GL_ACCELERATED_VISUAL: int
 GL_ACCUM_ALPHA_SIZE: int
@@ -508,6 +511,7 @@ NUMEVENTS: int
 OPENGL: int
 OPENGLBLIT: int
 PREALLOC: int
+PREMULTIPLIED: int
 QUIT: int
 RENDER_DEVICE_RESET: int
 RENDER_TARGETS_RESET: int
@@ -42,7 +42,13 @@ def update(
 def update(x: int, y: int, w: int, h: int) -> None: ...
 @overload
 def update(xy: Coordinate, wh: Coordinate) -> None: ...
+def update_damage() -> None: ...
+def set_update_threshold(threshold: float) -> None: ...
+def get_update_threshold() -> float: ...
+def set_async_present(enabled: bool = True, buffers: int = 3) -> None: ...
+def get_present_stats() -> Tuple[float, int, int]: ...
 def get_driver() -> str: ...
+def is_headless() -> bool: ...
 def Info() -> _VidInfo: ...
 def get_wm_info() -> Dict[str, int]: ...
 def list_modes(
@@ -1,4 +1,4 @@
-from typing import Optional, Sequence
+from typing import Any, Optional, Sequence, Tuple, Union, final
 
 from pygame.rect import Rect
 from pygame.surface import Surface
@@ -72,3 +72,78 @@ def aalines(
     points: Sequence[Coordinate],
     blend: int = 1,
 ) -> Rect: ...
+def circles(
+    surface: Surface,
+    color: Union[ColorValue, Any],
+    centers: Any,
+    radii: Union[float, Any],
+    width: int = 0,
+) -> Rect: ...
+def rects(
+    surface: Surface, color: Union[ColorValue, Any], rects: Any, width: int = 0
+) -> Rect: ...
+def line_segments(
+    surface: Surface,
+    color: Union[ColorValue, Any],
+    segments: Any,
+    width: int = 1,
+) -> Rect: ...
+def aapolygon(
+    surface: Surface, color: ColorValue, points: Sequence[Coordinate]
+) -> Rect: ...
+def aacircle(
+    surface: Surface, color: ColorValue, center: Coordinate, radius: float
+) -> Rect: ...
+def aaellipse(surface: Surface, color: ColorValue, rect: RectValue) -> Rect: ...
+def aarect(
+    surface: Surface, color: ColorValue, rect: RectValue, border_radius: float = 0
+) -> Rect: ...
+def path(
+    surface: Surface,
+    color: ColorValue,
+    points: Sequence[Coordinate],
+    width: float = 1,
+    join: str = "miter",
+    cap: str = "butt",
+) -> Rect: ...
+def linear_gradient(
+    surface: Surface,
+    rect: RectValue,
+    start_color: ColorValue,
+    end_color: ColorValue,
+    start_pos: Optional[Coordinate] = None,
+    end_pos: Optional[Coordinate] = None,
+) -> Rect: ...
+def radial_gradient(
+    surface: Surface,
+    center: Coordinate,
+    radius: float,
+    inner_color: ColorValue,
+    outer_color: ColorValue,
+) -> Rect: ...
+def textured_polygon(
+    surface: Surface,
+    points: Sequence[Coordinate],
+    texture: Surface,
+    offset: Coordinate = (0, 0),
+) -> Rect: ...
+@final
+class Curve:
+    def __init__(
+        self, points: Sequence[Coordinate], tolerance: float = 0.25
+    ) -> None: ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, index: int) -> Tuple[float, float]: ...
+    @property
+    def control_points(self) -> Tuple[Tuple[float, float], ...]: ...
+    @property
+    def tolerance(self) -> float: ...
+    def stroke(
+        self,
+        surface: Surface,
+        color: ColorValue,
+        width: float = 1,
+        join: str = "miter",
+        cap: str = "butt",
+    ) -> Rect: ...
+    def fill(self, surface: Surface, color: ColorValue) -> Rect: ...
@@ -25,6 +25,8 @@ class Event:
     def __delattr__(self, name: str) -> None: ...
     def __bool__(self) -> bool: ...
 
+BUFFER_FIELDS: Tuple[str, ...]
+
 _EventTypes = Union[SupportsInt, Tuple[SupportsInt, ...], Sequence[SupportsInt]]
 
 def pump() -> None: ...
@@ -33,14 +35,20 @@ def get(
     pump: Any = True,
     exclude: Optional[_EventTypes] = None,
 ) -> List[Event]: ...
+def get_buffer(
+    buffer: Any, eventtype: Optional[_EventTypes] = None, pump: Any = True
+) -> int: ...
 def poll() -> Event: ...
-def wait(timeout: int = 0) -> Event: ...
+def wait(timeout: float = 0) -> Event: ...
+def wakeup() -> None: ...
 def peek(eventtype: Optional[_EventTypes] = None, pump: Any = True) -> bool: ...
 def clear(eventtype: Optional[_EventTypes] = None, pump: Any = True) -> None: ...
 def event_name(type: int) -> str: ...
 def set_blocked(type: Optional[_EventTypes]) -> None: ...
 def set_allowed(type: Optional[_EventTypes]) -> None: ...
 def get_blocked(type: _EventTypes) -> bool: ...
+def set_coalesce(eventtype: int, coalesce: bool = True) -> None: ...
+def get_coalesce(eventtype: int) -> bool: ...
 def set_grab(grab: bool) -> None: ...
 def get_grab() -> bool: ...
 def post(event: Event) -> bool: ...
@@ -1,5 +1,6 @@
-from typing import Callable, Hashable, Iterable, List, Optional, Tuple, Union
+from typing import Callable, Dict, Hashable, Iterable, List, Optional, Tuple, Union
 
+from pygame.constants import FONT_LEFT
 from pygame.surface import Surface
 
 from ._common import ColorValue, FileArg, Literal
@@ -32,6 +33,7 @@ class Font:
     italic: bool
     underline: bool
     strikethrough: bool
+    render_cache_limit: int
     def __init__(self, name: Optional[FileArg], size: int) -> None: ...
     def render(
         self,
@@ -39,8 +41,11 @@ class Font:
         antialias: bool,
         color: ColorValue,
         background: Optional[ColorValue] = None,
+        wraplength: int = 0,
+        align: int = FONT_LEFT,
     ) -> Surface: ...
     def size(self, text: Union[str, bytes]) -> Tuple[int, int]: ...
+    def get_render_cache_stats(self) -> Dict[str, int]: ...
     def set_underline(self, value: bool) -> None: ...
     def get_underline(self) -> bool: ...
     def set_strikethrough(self, value: bool) -> None: ...
@@ -1,8 +1,10 @@
-from typing import Any, Callable, Iterable, List, Optional, Tuple, Union
+from typing import Any, Callable, Dict, Iterable, List, Optional, Tuple, Union
 
+from pygame.atlas import Atlas
 from pygame.color import Color
+from pygame.constants import FONT_LEFT
 from pygame.rect import Rect
-from pygame.surface import Surface
+from pygame.surface import Surface, SurfacePool
 
 from ._common import ColorValue, FileArg, RectValue
 
@@ -65,6 +67,8 @@ class Font:
     pad: bool
     ucs4: bool
     resolution: int
+    cache_limit: int
+    render_cache_limit: int
     def __init__(
         self,
         file: Optional[FileArg],
@@ -79,6 +83,8 @@ class Font:
         style: int = STYLE_DEFAULT,
         rotation: int = 0,
         size: float = 0,
+        wraplength: int = 0,
+        align: int = FONT_LEFT,
     ) -> Rect: ...
     def get_metrics(
         self, text: str, size: float = 0
@@ -88,6 +94,9 @@ class Font:
     def get_sized_height(self, size: float) -> int: ...
     def get_sized_glyph_height(self, size: float) -> int: ...
     def get_sizes(self) -> List[Tuple[int, int, int, float, float]]: ...
+    def get_cache_stats(self) -> Dict[str, int]: ...
+    def share_cache(self, font: Font) -> None: ...
+    def get_render_cache_stats(self) -> Dict[str, int]: ...
     def render(
         self,
         text: str,
@@ -96,6 +105,9 @@ class Font:
         style: int = STYLE_DEFAULT,
         rotation: int = 0,
         size: float = 0,
+        pool: Optional[SurfacePool] = None,
+        wraplength: int = 0,
+        align: int = FONT_LEFT,
     ) -> Tuple[Surface, Rect]: ...
     def render_to(
         self,
@@ -107,6 +119,8 @@ class Font:
         style: int = STYLE_DEFAULT,
         rotation: int = 0,
         size: float = 0,
+        wraplength: int = 0,
+        align: int = FONT_LEFT,
     ) -> Rect: ...
     def render_raw(
         self,
@@ -126,3 +140,51 @@ class Font:
         size: float = 0,
         invert: bool = False,
     ) -> Rect: ...
+
+class TextLayout:
+    font: Font
+    text: str
+    def __init__(
+        self,
+        font: Font,
+        text: str,
+        style: int = STYLE_DEFAULT,
+        rotation: Optional[int] = None,
+        size: float = 0,
+    ) -> None: ...
+    def get_rect(self) -> Rect: ...
+    def get_metrics(self) -> List[Tuple[int, int, int, int, float, float]]: ...
+    def render(
+        self, fgcolor: Optional[ColorValue] = None, bgcolor: Optional[ColorValue] = None
+    ) -> Tuple[Surface, Rect]: ...
+    def render_to(
+        self,
+        surf: Surface,
+        dest: RectValue,
+        fgcolor: Optional[ColorValue] = None,
+        bgcolor: Optional[ColorValue] = None,
+    ) -> Rect: ...
+    def get_caret_positions(self) -> List[int]: ...
+    def index_at(self, pos: Tuple[int, int]) -> int: ...
+
+class GlyphAtlas:
+    font: Font
+    fgcolor: Color
+    size: float
+    atlas: Atlas
+    def __init__(
+        self,
+        font: Font,
+        fgcolor: ColorValue,
+        size: float = 0,
+        page_size: Tuple[int, int] = (512, 512),
+    ) -> None: ...
+    def __len__(self) -> int: ...
+    def add(self, text: str) -> None: ...
+    def layout(
+        self, text: str, dest: Tuple[int, int] = (0, 0)
+    ) -> List[Tuple[Surface, Rect]]: ...
+    def render_to(self, surf: Surface, dest: Tuple[int, int], text: str) -> Rect: ...
+    def draw(
+        self, textures: List[Any], text: str, dest: Tuple[int, int] = (0, 0)
+    ) -> None: ...
@@ -1,9 +1,9 @@
-from typing import Sequence, Tuple, Union
+from typing import Iterator, List, Optional, Sequence, Tuple, Union
 
 from pygame.bufferproxy import BufferProxy
 from pygame.surface import Surface
 
-from ._common import FileArg, Literal
+from ._common import FileArg, Literal, RectValue
 
 _BufferStyle = Union[BufferProxy, bytes, bytearray, memoryview]
 _to_string_format = Literal[
@@ -13,7 +13,33 @@ _from_buffer_format = Literal["P", "RGB", "BGR", "RGBX", "RGBA", "ARGB"]
 _from_string_format = Literal["P", "RGB", "RGBX", "RGBA", "ARGB"]
 
 def load(filename: FileArg, namehint: str = "") -> Surface: ...
-def save(surface: Surface, filename: FileArg, namehint: str = "") -> None: ...
+def load_many(
+    files: Sequence[FileArg], convert: bool = False, alpha: bool = False
+) -> List[Surface]: ...
+def load_region(filename: FileArg, rect: RectValue, namehint: str = "") -> Surface: ...
+def iter_bands(
+    filename: FileArg, band_height: int = 64, namehint: str = ""
+) -> Iterator[Tuple[int, Surface]]: ...
+def save(
+    surface: Surface,
+    filename: FileArg,
+    namehint: str = "",
+    compression: int = -1,
+    filter: Optional[str] = None,
+) -> None: ...
+def save_async(
+    surface: Surface,
+    filename: FileArg,
+    namehint: str = "",
+    compression: int = -1,
+    filter: Optional[str] = None,
+) -> None: ...
+def wait_saves() -> None: ...
+def load_raw(filename: FileArg) -> Surface: ...
+def save_raw(surface: Surface, filename: FileArg) -> None: ...
+def raw_size(surface: Surface) -> int: ...
+def tobuffer_raw(surface: Surface, buffer: Union[bytearray, memoryview]) -> None: ...
+def frombuffer_raw(buffer: _BufferStyle) -> Surface: ...
 def get_sdl_image_version() -> Union[None, Tuple[int, int, int]]: ...
 def get_extended() -> bool: ...
 def tostring(
@@ -29,7 +55,14 @@ def frombuffer(
     bytes: _BufferStyle,
     size: Union[Sequence[int], Tuple[int, int]],
     format: _from_buffer_format,
+    pitch: int = -1,
 ) -> Surface: ...
 def load_basic(filename: FileArg) -> Surface: ...
 def load_extended(filename: FileArg, namehint: str = "") -> Surface: ...
-def save_extended(surface: Surface, filename: FileArg, namehint: str = "") -> None: ...
+def save_extended(
+    surface: Surface,
+    filename: FileArg,
+    namehint: str = "",
+    compression: int = -1,
+    filter: Optional[str] = None,
+) -> None: ...
@@ -1,4 +1,4 @@
-from typing import Tuple, final
+from typing import Any, Tuple, final
 
 def init() -> None: ...
 def quit() -> None: ...
@@ -23,6 +23,7 @@ class JoystickType:
     def get_button(self, button: int) -> bool: ...
     def get_numhats(self) -> int: ...
     def get_hat(self, hat_number: int) -> Tuple[float, float]: ...
+    def get_state(self, out: Any = None) -> Any: ...
     def rumble(
         self, low_frequency: float, high_frequency: float, duration: int
     ) -> bool: ...
@@ -1,4 +1,4 @@
-from typing import Tuple
+from typing import Any, Tuple
 
 from ._common import RectValue
 
@@ -6,6 +6,7 @@ class ScancodeWrapper(Tuple[bool, ...]): ...
 
 def get_focused() -> bool: ...
 def get_pressed() -> ScancodeWrapper: ...
+def get_pressed_buffer(out: Any = None, changed: Any = None) -> Any: ...
 def get_mods() -> int: ...
 def set_mods(mods: int) -> None: ...
 def set_repeat(delay: int = 0, interval: int = 0) -> None: ...
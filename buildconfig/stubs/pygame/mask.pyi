@@ -1,5 +1,6 @@
 from typing import Any, List, Optional, Sequence, Tuple, Union
 
+from pygame.bufferproxy import BufferProxy
 from pygame.rect import Rect
 from pygame.surface import Surface
 
@@ -13,6 +14,12 @@ def from_threshold(
     othersurface: Optional[Surface] = None,
     palette_colors: int = 1,
 ) -> Mask: ...
+def collide_many(
+    masks: Sequence[Mask],
+    positions: Sequence[Coordinate],
+    other_masks: Sequence[Mask],
+    other_positions: Sequence[Coordinate],
+) -> List[Tuple[int, int]]: ...
 
 class Mask:
     def __init__(self, size: Coordinate, fill: bool = False) -> None: ...
@@ -43,6 +50,9 @@ class Mask:
         output: Optional[Mask] = None,
         offset: Coordinate = (0, 0),
     ) -> Mask: ...
+    def dilate(self, n: int) -> None: ...
+    def erode(self, n: int) -> None: ...
+    def distance_transform(self) -> BufferProxy: ...
     def connected_component(
         self, pos: Union[Sequence[int], Tuple[int, int]] = ...
     ) -> Mask: ...
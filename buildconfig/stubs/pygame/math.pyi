@@ -357,6 +357,140 @@ class Vector3(Collection[float]):
     @overload
     def update(self, x: int, y: int, z: int) -> None: ...
 
+class Vector2Array:
+    @overload
+    def __init__(self, vectors: Union[Sequence[_SupportsVector2], Vector2Array] = ...) -> None: ...
+    @overload
+    def __init__(self, length: int) -> None: ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, i: int) -> Vector2: ...
+    def __setitem__(self, i: int, vector: _SupportsVector2) -> None: ...
+    def __delitem__(self, i: int) -> None: ...
+    def __iter__(self) -> Iterator[Vector2]: ...
+    def __add__(self, other: Union[_SupportsVector2, Vector2Array]) -> Vector2Array: ...
+    def __radd__(self, other: _SupportsVector2) -> Vector2Array: ...
+    def __sub__(self, other: Union[_SupportsVector2, Vector2Array]) -> Vector2Array: ...
+    def __rsub__(self, other: _SupportsVector2) -> Vector2Array: ...
+    def __mul__(self, other: float) -> Vector2Array: ...
+    def __rmul__(self, other: float) -> Vector2Array: ...
+    def __truediv__(self, other: float) -> Vector2Array: ...
+    def __iadd__(self, other: Union[_SupportsVector2, Vector2Array]) -> Vector2Array: ...
+    def __isub__(self, other: Union[_SupportsVector2, Vector2Array]) -> Vector2Array: ...
+    def __imul__(self, other: float) -> Vector2Array: ...
+    def __itruediv__(self, other: float) -> Vector2Array: ...
+    def append(self, vector: _SupportsVector2) -> None: ...
+    def copy(self) -> Vector2Array: ...
+    def dot(self, other: Union[_SupportsVector2, Vector2Array]) -> List[float]: ...
+    def distance_to(self, other: Union[_SupportsVector2, Vector2Array]) -> List[float]: ...
+    def normalize_ip(self) -> None: ...
+    def rotate_ip(self, angle: float) -> None: ...
+    def lerp(self, other: Union[_SupportsVector2, Vector2Array], value: float) -> Vector2Array: ...
+    @overload
+    def clamp_magnitude_ip(self, max_length: float) -> None: ...
+    @overload
+    def clamp_magnitude_ip(self, min_length: float, max_length: float) -> None: ...
+
+class Vector3Array:
+    @overload
+    def __init__(self, vectors: Union[Sequence[_SupportsVector3], Vector3Array] = ...) -> None: ...
+    @overload
+    def __init__(self, length: int) -> None: ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, i: int) -> Vector3: ...
+    def __setitem__(self, i: int, vector: _SupportsVector3) -> None: ...
+    def __delitem__(self, i: int) -> None: ...
+    def __iter__(self) -> Iterator[Vector3]: ...
+    def __add__(self, other: Union[_SupportsVector3, Vector3Array]) -> Vector3Array: ...
+    def __radd__(self, other: _SupportsVector3) -> Vector3Array: ...
+    def __sub__(self, other: Union[_SupportsVector3, Vector3Array]) -> Vector3Array: ...
+    def __rsub__(self, other: _SupportsVector3) -> Vector3Array: ...
+    def __mul__(self, other: float) -> Vector3Array: ...
+    def __rmul__(self, other: float) -> Vector3Array: ...
+    def __truediv__(self, other: float) -> Vector3Array: ...
+    def __iadd__(self, other: Union[_SupportsVector3, Vector3Array]) -> Vector3Array: ...
+    def __isub__(self, other: Union[_SupportsVector3, Vector3Array]) -> Vector3Array: ...
+    def __imul__(self, other: float) -> Vector3Array: ...
+    def __itruediv__(self, other: float) -> Vector3Array: ...
+    def append(self, vector: _SupportsVector3) -> None: ...
+    def copy(self) -> Vector3Array: ...
+    def dot(self, other: Union[_SupportsVector3, Vector3Array]) -> List[float]: ...
+    def distance_to(self, other: Union[_SupportsVector3, Vector3Array]) -> List[float]: ...
+    def normalize_ip(self) -> None: ...
+    def rotate_ip(self, angle: float, axis: _SupportsVector3) -> None: ...
+    def lerp(self, other: Union[_SupportsVector3, Vector3Array], value: float) -> Vector3Array: ...
+    @overload
+    def clamp_magnitude_ip(self, max_length: float) -> None: ...
+    @overload
+    def clamp_magnitude_ip(self, min_length: float, max_length: float) -> None: ...
+
+class Affine2:
+    @overload
+    def __init__(self) -> None: ...
+    @overload
+    def __init__(self, m: Sequence[float]) -> None: ...
+    @overload
+    def __init__(
+        self, a: float, b: float, c: float, d: float, e: float, f: float
+    ) -> None: ...
+    @classmethod
+    def identity(cls) -> Affine2: ...
+    @overload
+    @classmethod
+    def translation(cls, x: float, y: float) -> Affine2: ...
+    @overload
+    @classmethod
+    def translation(cls, xy: _SupportsVector2) -> Affine2: ...
+    @classmethod
+    def rotation(cls, angle: float) -> Affine2: ...
+    @overload
+    @classmethod
+    def scale(cls, factor: float) -> Affine2: ...
+    @overload
+    @classmethod
+    def scale(cls, x: float, y: float) -> Affine2: ...
+    @overload
+    @classmethod
+    def scale(cls, xy: _SupportsVector2) -> Affine2: ...
+    @overload
+    @classmethod
+    def shear(cls, x: float, y: float) -> Affine2: ...
+    @overload
+    @classmethod
+    def shear(cls, xy: _SupportsVector2) -> Affine2: ...
+    def inverse(self) -> Affine2: ...
+    def transform_points(
+        self, points: Union[Sequence[_SupportsVector2], Vector2Array]
+    ) -> Vector2Array: ...
+    @overload
+    def __matmul__(self, other: Affine2) -> Affine2: ...
+    @overload
+    def __matmul__(self, other: Vector2Array) -> Vector2Array: ...
+    @overload
+    def __matmul__(self, other: _SupportsVector2) -> Vector2: ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, i: int) -> float: ...
+    def __iter__(self) -> Iterator[float]: ...
+
+def noise2d(
+    dest: Any,
+    scale: float,
+    offset: _SupportsVector2 = (0, 0),
+    octaves: int = 1,
+    persistence: float = 0.5,
+    lacunarity: float = 2.0,
+    seed: int = 0,
+) -> None: ...
+def noise3d(
+    dest: Any,
+    scale: float,
+    z: float,
+    offset: _SupportsVector2 = (0, 0),
+    octaves: int = 1,
+    persistence: float = 0.5,
+    lacunarity: float = 2.0,
+    seed: int = 0,
+) -> None: ...
+
 # typehints for deprecated functions, to be removed in a future version
 def enable_swizzling() -> None: ...
 def disable_swizzling() -> None: ...
@@ -5,7 +5,7 @@ import numpy
 from pygame.event import Event
 
 from . import mixer_music
-from ._common import FileArg
+from ._common import FileArg, Literal
 
 # export mixer_music as mixer.music
 music = mixer_music
@@ -34,21 +34,30 @@ def unpause() -> None: ...
 def fadeout(time: int) -> None: ...
 def set_num_channels(count: int) -> None: ...
 def get_num_channels() -> int: ...
+def get_sample_clock() -> int: ...
 def set_reserved(count: int) -> int: ...
+def set_num_voices(count: int) -> None: ...
+def get_num_voices() -> int: ...
+def play_voice(
+    sound: Sound, priority: int = 0, volume: float = 1.0, loops: int = 0
+) -> int: ...
+def stop_voices() -> None: ...
+def get_voice_stats() -> Dict[str, int]: ...
 def find_channel(force: bool = False) -> Channel: ...
 def get_busy() -> bool: ...
 def get_sdl_mixer_version(linked: bool = True) -> Tuple[int, int, int]: ...
+def load_async(file: FileArg, event: int = 0) -> SoundLoad: ...
 
 class Sound:
     @overload
     def __init__(self, file: FileArg) -> None: ...
     @overload
     def __init__(
-        self, buffer: Any
+        self, buffer: Any, copy: bool = True
     ) -> None: ...  # Buffer protocol is still not implemented in typing
     @overload
     def __init__(
-        self, array: numpy.ndarray
+        self, array: numpy.ndarray, copy: bool = True
     ) -> None: ...  # Buffer protocol is still not implemented in typing
     def play(
         self,
@@ -78,6 +87,7 @@ class Channel:
         maxtime: int = 0,
         fade_ms: int = 0,
     ) -> None: ...
+    def play_at(self, sound: Sound, time: int, loops: int = 0) -> None: ...
     def stop(self) -> None: ...
     def pause(self) -> None: ...
     def unpause(self) -> None: ...
@@ -88,11 +98,41 @@ class Channel:
     @overload
     def set_volume(self, left: float, right: float) -> None: ...
     def get_volume(self) -> float: ...
+    def set_filter(
+        self,
+        type: Optional[Literal["lowpass", "highpass", "bandpass"]] = None,
+        frequency: float = 1000.0,
+        q: float = 0.7071,
+    ) -> None: ...
+    def set_reverb(
+        self, wet: float, room_size: float = 0.5, damping: float = 0.5
+    ) -> None: ...
     def get_busy(self) -> bool: ...
     def get_sound(self) -> Sound: ...
     def get_queue(self) -> Sound: ...
     def set_endevent(self, type: Union[int, Event] = 0) -> None: ...
     def get_endevent(self) -> int: ...
 
+class Stream:
+    def __init__(
+        self, size: int = 0, file: Optional[FileArg] = None, loops: int = 0
+    ) -> None: ...
+    def write(
+        self, buffer: Any
+    ) -> int: ...  # Buffer protocol is still not implemented in typing
+    def play(self) -> Optional[Channel]: ...
+    def stop(self) -> None: ...
+    def get_busy(self) -> bool: ...
+    def get_queued(self) -> int: ...
+    def get_free(self) -> int: ...
+    def advance(self, frames: int) -> None: ...
+    def get_underruns(self) -> int: ...
+    def reset_underruns(self) -> None: ...
+
+@final
+class SoundLoad:
+    def done(self) -> bool: ...
+    def result(self, timeout: Optional[float] = None) -> Sound: ...
+
 SoundType = Sound
 ChannelType = Channel
@@ -15,6 +15,14 @@ def get_volume() -> float: ...
 def get_busy() -> bool: ...
 def set_pos(pos: float) -> None: ...
 def get_pos() -> int: ...
-def queue(filename: FileArg, namehint: str = "", loops: int = 0) -> None: ...
+def queue(
+    filename: FileArg,
+    namehint: str = "",
+    loops: int = 0,
+    append: bool = False,
+    fade_ms: int = 0,
+    wait: bool = True,
+) -> None: ...
+def get_queued() -> int: ...
 def set_endevent(event_type: int) -> None: ...
 def get_endevent() -> int: ...
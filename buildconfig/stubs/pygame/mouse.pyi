@@ -1,4 +1,4 @@
-from typing import Sequence, Tuple, Union, overload
+from typing import Any, Sequence, Tuple, Union, overload
 
 from pygame.cursors import Cursor
 from pygame.surface import Surface
@@ -8,6 +8,7 @@ def get_pressed(
 ) -> Union[Tuple[bool, bool, bool], Tuple[bool, bool, bool, bool, bool]]: ...
 def get_pos() -> Tuple[int, int]: ...
 def get_rel() -> Tuple[int, int]: ...
+def get_state_into(buffer: Any) -> None: ...
 @overload
 def set_pos(pos: Union[Sequence[float], Tuple[float, float]]) -> None: ...
 @overload
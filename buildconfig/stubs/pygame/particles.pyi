@@ -0,0 +1,39 @@
+from typing import Optional, Tuple
+
+from pygame.surface import Surface
+
+from ._common import ColorValue, Coordinate
+
+class ParticleSystem:
+    @property
+    def capacity(self) -> int: ...
+    gravity: Tuple[float, float]
+    drag: float
+    size: int
+    image: Optional[Surface]
+    additive: bool
+    fade: bool
+    def __init__(
+        self,
+        capacity: int,
+        gravity: Coordinate = (0, 0),
+        drag: float = 0.0,
+        image: Optional[Surface] = None,
+        size: int = 1,
+        additive: bool = False,
+        fade: bool = True,
+        seed: Optional[int] = None,
+    ) -> None: ...
+    def __len__(self) -> int: ...
+    def emit(
+        self,
+        pos: Coordinate,
+        count: int = 1,
+        velocity: Coordinate = (0, 0),
+        spread: Coordinate = (0, 0),
+        life: float = 1.0,
+        color: ColorValue = (255, 255, 255, 255),
+    ) -> int: ...
+    def update(self, dt: float) -> None: ...
+    def draw(self, surface: Surface, offset: Coordinate = (0, 0)) -> None: ...
+    def clear(self) -> None: ...
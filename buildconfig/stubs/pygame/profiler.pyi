@@ -0,0 +1,24 @@
+from typing import List, Optional, Tuple
+
+from pygame.rect import Rect
+from pygame.surface import Surface
+from pygame.time import Profiler as Profiler, Span
+
+from ._common import ColorValue, RectValue
+
+BACKGROUND: ColorValue
+OTHER: ColorValue
+TARGET: ColorValue
+COLORS: List[ColorValue]
+
+def frame_begin() -> None: ...
+def frame_end() -> float: ...
+def span(name: str) -> Span: ...
+def get_frames() -> List[Tuple[float, List[Tuple[str, int, float, float]]]]: ...
+def clear() -> None: ...
+def draw(
+    surface: Surface,
+    rect: Optional[RectValue] = None,
+    target: float = ...,
+    profiler: Optional[Profiler] = None,
+) -> Rect: ...
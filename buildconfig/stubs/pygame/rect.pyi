@@ -196,3 +196,234 @@ class Rect(Collection[int]):
     def collidedictall(
         self, rect_dict: Dict[_K, "Rect"], values: bool
     ) -> List[Tuple[_K, "Rect"]]: ...
+
+class FRect(Collection[float]):
+    x: float
+    y: float
+    top: float
+    left: float
+    bottom: float
+    right: float
+    topleft: Tuple[float, float]
+    bottomleft: Tuple[float, float]
+    topright: Tuple[float, float]
+    bottomright: Tuple[float, float]
+    midtop: Tuple[float, float]
+    midleft: Tuple[float, float]
+    midbottom: Tuple[float, float]
+    midright: Tuple[float, float]
+    center: Tuple[float, float]
+    centerx: float
+    centery: float
+    size: Tuple[float, float]
+    width: float
+    height: float
+    w: float
+    h: float
+    __hash__: None  # type: ignore
+    __safe_for_unpickling__: Literal[True]
+    @overload
+    def __init__(
+        self, left: float, top: float, width: float, height: float
+    ) -> None: ...
+    @overload
+    def __init__(self, left_top: Coordinate, width_height: Coordinate) -> None: ...
+    @overload
+    def __init__(self, single_arg: RectValue) -> None: ...
+    def __len__(self) -> Literal[4]: ...
+    def __iter__(self) -> Iterator[float]: ...
+    @overload
+    def __getitem__(self, i: int) -> float: ...
+    @overload
+    def __getitem__(self, s: slice) -> List[float]: ...
+    @overload
+    def __setitem__(self, key: int, value: float) -> None: ...
+    @overload
+    def __setitem__(self, key: slice, value: Union[float, RectValue]) -> None: ...
+    def __copy__(self) -> FRect: ...
+    copy = __copy__
+    @overload
+    def move(self, x: float, y: float) -> FRect: ...
+    @overload
+    def move(self, move_by: Coordinate) -> FRect: ...
+    @overload
+    def move_ip(self, x: float, y: float) -> None: ...
+    @overload
+    def move_ip(self, move_by: Coordinate) -> None: ...
+    @overload
+    def inflate(self, x: float, y: float) -> FRect: ...
+    @overload
+    def inflate(self, inflate_by: Coordinate) -> FRect: ...
+    @overload
+    def inflate_ip(self, x: float, y: float) -> None: ...
+    @overload
+    def inflate_ip(self, inflate_by: Coordinate) -> None: ...
+    @overload
+    def update(self, left: float, top: float, width: float, height: float) -> None: ...
+    @overload
+    def update(self, left_top: Coordinate, width_height: Coordinate) -> None: ...
+    @overload
+    def update(self, single_arg: RectValue) -> None: ...
+    @overload
+    def clamp(self, rect: RectValue) -> FRect: ...
+    @overload
+    def clamp(self, left_top: Coordinate, width_height: Coordinate) -> FRect: ...
+    @overload
+    def clamp(self, left: float, top: float, width: float, height: float) -> FRect: ...
+    @overload
+    def clamp_ip(self, rect: RectValue) -> None: ...
+    @overload
+    def clamp_ip(self, left_top: Coordinate, width_height: Coordinate) -> None: ...
+    @overload
+    def clamp_ip(
+        self, left: float, top: float, width: float, height: float
+    ) -> None: ...
+    @overload
+    def clip(self, rect: RectValue) -> FRect: ...
+    @overload
+    def clip(self, left_top: Coordinate, width_height: Coordinate) -> FRect: ...
+    @overload
+    def clip(self, left: float, top: float, width: float, height: float) -> FRect: ...
+    @overload
+    def union(self, rect: RectValue) -> FRect: ...
+    @overload
+    def union(self, left_top: Coordinate, width_height: Coordinate) -> FRect: ...
+    @overload
+    def union(self, left: float, top: float, width: float, height: float) -> FRect: ...
+    @overload
+    def union_ip(self, rect: RectValue) -> None: ...
+    @overload
+    def union_ip(self, left_top: Coordinate, width_height: Coordinate) -> None: ...
+    @overload
+    def union_ip(
+        self, left: float, top: float, width: float, height: float
+    ) -> None: ...
+    def unionall(self, rect: Sequence[RectValue]) -> FRect: ...
+    def unionall_ip(self, rect_sequence: Sequence[RectValue]) -> None: ...
+    @overload
+    def fit(self, rect: RectValue) -> FRect: ...
+    @overload
+    def fit(self, left_top: Coordinate, width_height: Coordinate) -> FRect: ...
+    @overload
+    def fit(self, left: float, top: float, width: float, height: float) -> FRect: ...
+    def normalize(self) -> None: ...
+    def __contains__(self, rect: Union[RectValue, float]) -> bool: ...  # type: ignore[override]
+    @overload
+    def contains(self, rect: RectValue) -> bool: ...
+    @overload
+    def contains(self, left_top: Coordinate, width_height: Coordinate) -> bool: ...
+    @overload
+    def contains(
+        self, left: float, top: float, width: float, height: float
+    ) -> bool: ...
+    @overload
+    def collidepoint(self, x: float, y: float) -> bool: ...
+    @overload
+    def collidepoint(self, x_y: Coordinate) -> bool: ...
+    @overload
+    def colliderect(self, rect: RectValue) -> bool: ...
+    @overload
+    def colliderect(self, left_top: Coordinate, width_height: Coordinate) -> bool: ...
+    @overload
+    def colliderect(
+        self, left: float, top: float, width: float, height: float
+    ) -> bool: ...
+    def collidelist(self, rect_list: Sequence[RectValue]) -> int: ...
+    def collidelistall(self, rect_list: Sequence[RectValue]) -> List[int]: ...
+    def collideobjectsall(
+        self, objects: Sequence[_T], key: Optional[Callable[[_T], RectValue]] = None
+    ) -> List[_T]: ...
+    def collideobjects(
+        self, objects: Sequence[_T], key: Optional[Callable[[_T], RectValue]] = None
+    ) -> Optional[_T]: ...
+    # Also undocumented: the dict collision methods take a 'values' argument
+    # that defaults to False. If it is False, the keys in rect_dict must be
+    # Rect-like; otherwise, the values must be Rects.
+    @overload
+    def collidedict(
+        self, rect_dict: Dict[RectValue, _V], values: bool = ...
+    ) -> Tuple[RectValue, _V]: ...
+    @overload
+    def collidedict(
+        self, rect_dict: Dict[_K, "FRect"], values: bool
+    ) -> Tuple[_K, "FRect"]: ...
+    @overload
+    def collidedictall(
+        self, rect_dict: Dict[RectValue, _V], values: bool = ...
+    ) -> List[Tuple[RectValue, _V]]: ...
+    @overload
+    def collidedictall(
+        self, rect_dict: Dict[_K, "FRect"], values: bool
+    ) -> List[Tuple[_K, "FRect"]]: ...
+
+class RectArray:
+    @overload
+    def __init__(self, rects: Sequence[RectValue] = ...) -> None: ...
+    @overload
+    def __init__(self, length: int) -> None: ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, i: int) -> Rect: ...
+    def __setitem__(self, i: int, rect: RectValue) -> None: ...
+    def __delitem__(self, i: int) -> None: ...
+    def __iter__(self) -> Iterator[Rect]: ...
+    @overload
+    def append(self, rect: RectValue) -> None: ...
+    @overload
+    def append(self, left_top: Coordinate, width_height: Coordinate) -> None: ...
+    @overload
+    def append(self, left: float, top: float, width: float, height: float) -> None: ...
+    @overload
+    def move_ip(self, x: float, y: float) -> None: ...
+    @overload
+    def move_ip(self, move_by: Coordinate) -> None: ...
+    def clamp_ip(self, rect: RectValue) -> None: ...
+    def clip(self, rect: RectValue) -> RectArray: ...
+    def union(self) -> Rect: ...
+    def merge_ip(self, clip: Optional[RectValue] = None) -> None: ...
+    @overload
+    def collidepoint(self, x: float, y: float) -> List[int]: ...
+    @overload
+    def collidepoint(self, x_y: Coordinate) -> List[int]: ...
+    def colliderect(self, rect: RectValue) -> List[int]: ...
+
+class RectIndex:
+    def __init__(
+        self, rects: Sequence[RectValue] = ..., cell_size: int = 64
+    ) -> None: ...
+    def __len__(self) -> int: ...
+    def __contains__(self, id: object) -> bool: ...
+    def __getitem__(self, id: int) -> Rect: ...
+    @overload
+    def insert(self, rect: RectValue) -> int: ...
+    @overload
+    def insert(self, left_top: Coordinate, width_height: Coordinate) -> int: ...
+    @overload
+    def insert(self, left: float, top: float, width: float, height: float) -> int: ...
+    def remove(self, id: int) -> None: ...
+    def move(self, id: int, rect: RectValue) -> None: ...
+    @overload
+    def collidepoint(self, x: float, y: float) -> List[int]: ...
+    @overload
+    def collidepoint(self, x_y: Coordinate) -> List[int]: ...
+    @overload
+    def colliderect(self, rect: RectValue) -> List[int]: ...
+    @overload
+    def colliderect(
+        self, left_top: Coordinate, width_height: Coordinate
+    ) -> List[int]: ...
+    @overload
+    def colliderect(
+        self, left: float, top: float, width: float, height: float
+    ) -> List[int]: ...
+    def collidelist(self, rect_list: Sequence[RectValue]) -> List[List[int]]: ...
+
+class RectPacker:
+    def __init__(self, size: Coordinate) -> None: ...
+    @property
+    def size(self) -> Tuple[int, int]: ...
+    @overload
+    def insert(self, width: int, height: int) -> Optional[Rect]: ...
+    @overload
+    def insert(self, width_height: Coordinate) -> Optional[Rect]: ...
+    def insertlist(self, sizes: Sequence[Coordinate]) -> List[Optional[Rect]]: ...
+    def clear(self) -> None: ...
@@ -1,4 +1,4 @@
-from typing import Any, Optional, overload, Type
+from typing import Any, List, Optional, overload, Type
 
 from ._common import AnyPath
 
@@ -16,3 +16,20 @@ def encode_file_path(
 def encode_file_path(
     obj: Any, etype: Optional[Type[Exception]] = UnicodeEncodeError
 ) -> bytes: ...
+
+class BundleEntry:
+    name: str
+    closed: bool
+    def read(self, size: int = -1) -> bytes: ...
+    def seek(self, offset: int, whence: int = 0) -> int: ...
+    def tell(self) -> int: ...
+    def readable(self) -> bool: ...
+    def seekable(self) -> bool: ...
+    def close(self) -> None: ...
+
+class Bundle:
+    def __init__(self, file: AnyPath) -> None: ...
+    def __len__(self) -> int: ...
+    def __contains__(self, name: object) -> bool: ...
+    def open(self, name: str) -> BundleEntry: ...
+    def names(self) -> List[str]: ...
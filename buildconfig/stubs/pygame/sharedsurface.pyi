@@ -0,0 +1,27 @@
+from typing import Optional
+
+from pygame.surface import Surface
+
+from ._common import Coordinate
+
+class SharedSurface:
+    surface: Optional[Surface]
+    def __init__(
+        self,
+        size: Coordinate,
+        flags: int = 0,
+        depth: int = 32,
+        name: Optional[str] = None,
+    ) -> None: ...
+    @classmethod
+    def from_surface(
+        cls, surface: Surface, name: Optional[str] = None
+    ) -> SharedSurface: ...
+    @classmethod
+    def attach(cls, name: str) -> SharedSurface: ...
+    def __enter__(self) -> SharedSurface: ...
+    def __exit__(self, *args, **kwargs) -> None: ...
+    @property
+    def name(self) -> str: ...
+    def close(self) -> None: ...
+    def unlink(self) -> None: ...
@@ -6,7 +6,7 @@ from pygame.mixer import Sound
 
 def array(sound: Sound) -> numpy.ndarray: ...
 def samples(sound: Sound) -> numpy.ndarray: ...
-def make_sound(array: numpy.ndarray) -> Sound: ...
+def make_sound(array: numpy.ndarray, copy: bool = True) -> Sound: ...
 def use_arraytype(arraytype: str) -> Sound: ...
 def get_arraytype() -> str: ...
 def get_arraytypes() -> Tuple[str]: ...
@@ -1,3 +1,4 @@
+from array import array
 from typing import (
     Any,
     Callable,
@@ -12,7 +13,7 @@ from typing import (
     Union,
 )
 
-from pygame.rect import Rect
+from pygame.rect import Rect, RectArray
 from pygame.surface import Surface
 
 from ._common import RectValue
@@ -46,6 +47,8 @@ class DirtySprite(Sprite):
 class AbstractGroup:
     spritedict: Dict[Sprite, Rect]
     lostsprites: List[int]  # I think
+    cache_update: bool
+    sort_key: Union[str, Callable[[Any], Any], None]
     def __init__(self) -> None: ...
     def __len__(self) -> int: ...
     def __iter__(self) -> Iterator[Sprite]: ...
@@ -129,6 +132,20 @@ class GroupSingle(AbstractGroup):
     def __init__(self, sprite: Optional[Sprite] = None) -> None: ...
     def copy(self) -> GroupSingle: ...
 
+class ArrayGroup:
+    images: List[Surface]
+    rects: RectArray
+    flags: array[int]
+    def __init__(self) -> None: ...
+    def add(
+        self, image: Surface, rect: Optional[RectValue] = None, special_flags: int = 0
+    ) -> int: ...
+    def remove(self, index: int) -> None: ...
+    def empty(self) -> None: ...
+    def draw(self, surface: Surface) -> None: ...
+    def clear(self, surface: Surface, bgd: Surface) -> None: ...
+    def __len__(self) -> int: ...
+
 def spritecollide(
     sprite: Sprite,
     group: AbstractGroup,
@@ -1,4 +1,5 @@
-from typing import Any, List, Optional, Sequence, Tuple, Union, overload
+from array import array
+from typing import Any, Dict, List, Optional, Sequence, Tuple, Union, overload
 
 from pygame.bufferproxy import BufferProxy
 from pygame.color import Color
@@ -54,7 +55,7 @@ class Surface:
     copy = __copy__
     def blit(
         self,
-        source: Surface,
+        source: _Source,
         dest: Union[Coordinate, RectValue],
         area: Optional[RectValue] = None,
         special_flags: int = 0,
@@ -63,14 +64,31 @@ class Surface:
         self,
         blit_sequence: Sequence[
             Union[
-                Tuple[Surface, Union[Coordinate, RectValue]],
-                Tuple[Surface, Union[Coordinate, RectValue], Union[RectValue, int]],
-                Tuple[Surface, Union[Coordinate, RectValue], RectValue, int],
+                Tuple[_Source, Union[Coordinate, RectValue]],
+                Tuple[_Source, Union[Coordinate, RectValue], Union[RectValue, int]],
+                Tuple[_Source, Union[Coordinate, RectValue], RectValue, int],
             ]
         ],
         doreturn: Union[int, bool] = 1,
     ) -> Union[List[Rect], None]: ...
     @overload
+    def fblits(
+        self, sources: _Source, positions: Any, special_flags: int = 0
+    ) -> None: ...
+    @overload
+    def fblits(
+        self, sources: Sequence[_Source], positions: Any, special_flags: int = 0
+    ) -> None: ...
+    def blit_many(
+        self, source: _Source, positions: Any, special_flags: int = 0
+    ) -> None: ...
+    def blit_array(
+        self, sources: Sequence[Surface], rects: Any, special_flags: Any = 0
+    ) -> None: ...
+    def set_damage_tracking(self, enabled: bool = True) -> None: ...
+    def get_damage(self, clear: bool = True) -> List[Rect]: ...
+    def get_version(self) -> int: ...
+    @overload
     def convert(self, surface: Surface) -> Surface: ...
     @overload
     def convert(self, depth: int, flags: int = 0) -> Surface: ...
@@ -82,13 +100,14 @@ class Surface:
     def convert_alpha(self, surface: Surface) -> Surface: ...
     @overload
     def convert_alpha(self) -> Surface: ...
+    def premul_alpha(self) -> Surface: ...
     def fill(
         self,
         color: ColorValue,
         rect: Optional[RectValue] = None,
         special_flags: int = 0,
     ) -> Rect: ...
-    def scroll(self, dx: int = 0, dy: int = 0) -> None: ...
+    def scroll(self, dx: int = 0, dy: int = 0, wrap: bool = False) -> None: ...
     @overload
     def set_colorkey(self, color: ColorValue, flags: int = 0) -> None: ...
     @overload
@@ -107,6 +126,8 @@ class Surface:
     def get_at(self, x_y: Sequence[int]) -> Color: ...
     def set_at(self, x_y: Sequence[int], color: ColorValue) -> None: ...
     def get_at_mapped(self, x_y: Sequence[int]) -> int: ...
+    def get_at_many(self, coords: Any) -> array[int]: ...
+    def set_at_many(self, coords: Any, colors: Union[ColorValue, Any]) -> None: ...
     def get_palette(self) -> List[Color]: ...
     def get_palette_at(self, index: int) -> Color: ...
     def set_palette(self, palette: Sequence[ColorValue]) -> None: ...
@@ -123,6 +144,14 @@ class Surface:
     def subsurface(
         self, left: float, top: float, width: float, height: float
     ) -> Surface: ...
+    @overload
+    def region(self, rect: RectValue) -> SurfaceRegion: ...
+    @overload
+    def region(self, left_top: Coordinate, width_height: Coordinate) -> SurfaceRegion: ...
+    @overload
+    def region(
+        self, left: float, top: float, width: float, height: float
+    ) -> SurfaceRegion: ...
     def get_parent(self) -> Surface: ...
     def get_abs_parent(self) -> Surface: ...
     def get_offset(self) -> Tuple[int, int]: ...
@@ -141,8 +170,77 @@ class Surface:
     def set_shifts(self, color: ColorValue) -> None: ...
     def get_losses(self) -> RGBAOutput: ...
     def get_bounding_rect(self, min_alpha: int = 1) -> Rect: ...
+    def get_stats(self, rect: Optional[RectValue] = None) -> Dict[str, Any]: ...
     def get_view(self, kind: _ViewKind = "2") -> BufferProxy: ...
     def get_buffer(self) -> BufferProxy: ...
+    def compress(self) -> int: ...
+    def get_compressed_size(self) -> int: ...
+    def gl_upload(
+        self,
+        target: int = 0x0DE1,
+        level: int = 0,
+        offset: Optional[Coordinate] = None,
+        pbo: int = 0,
+    ) -> None: ...
     def get_blendmode(self) -> int: ...
 
 SurfaceType = Surface
+
+def convert_many(
+    surfaces: Sequence[Surface],
+    format: Optional[Surface] = None,
+    alpha: bool = False,
+) -> List[Surface]: ...
+def get_bounding_rects(
+    surfaces: Sequence[Surface], min_alpha: int = 1
+) -> List[Rect]: ...
+def set_auto_convert(enabled: bool) -> None: ...
+def get_auto_convert() -> bool: ...
+
+class SurfacePool:
+    hits: int
+    misses: int
+    idle: int
+    max_buffers: int
+    def __init__(self, max_buffers: int = 16) -> None: ...
+    def clear(self) -> None: ...
+
+class SurfaceRegion:
+    @property
+    def surface(self) -> Surface: ...
+    @property
+    def rect(self) -> Rect: ...
+    def __init__(self, surface: Surface, rect: RectValue) -> None: ...
+    def get_size(self) -> Tuple[int, int]: ...
+    def subsurface(self) -> Surface: ...
+    def get_view(self, kind: _ViewKind = "2") -> BufferProxy: ...
+
+class HDRSurface:
+    def __init__(self, size: Coordinate) -> None: ...
+    def get_size(self) -> Tuple[int, int]: ...
+    def get_width(self) -> int: ...
+    def get_height(self) -> int: ...
+    def get_at(self, x_y: Coordinate) -> Tuple[float, float, float, float]: ...
+    def fill(
+        self,
+        color: Union[ColorValue, Sequence[float]],
+        rect: Optional[RectValue] = None,
+        special_flags: int = 0,
+    ) -> Rect: ...
+    def blit(
+        self,
+        source: Union[Surface, HDRSurface],
+        dest: Union[Coordinate, RectValue] = (0, 0),
+        area: Optional[RectValue] = None,
+        special_flags: int = 0,
+    ) -> Rect: ...
+    def tonemap(
+        self,
+        surface: Surface,
+        dest: Union[Coordinate, RectValue] = (0, 0),
+        area: Optional[RectValue] = None,
+        exposure: float = 1.0,
+        method: Literal["clamp", "reinhard", "aces"] = "reinhard",
+    ) -> Rect: ...
+
+_Source = Union[Surface, SurfaceRegion]
@@ -0,0 +1,31 @@
+from typing import Iterable, List, Optional, Sequence, Tuple, Union
+
+from pygame._sdl2.video import Renderer
+from pygame.rect import Rect
+from pygame.surface import Surface
+
+from ._common import Coordinate, RectValue
+
+class Tilemap:
+    tiles: List[Surface]
+    tile_size: Tuple[int, int]
+    size: Tuple[int, int]
+    chunk_size: Tuple[int, int]
+    def __init__(
+        self,
+        tileset: Union[Surface, Iterable[Surface]],
+        tile_size: Coordinate,
+        size: Coordinate,
+        chunk_size: Coordinate = (16, 16),
+        data: Optional[Iterable[Sequence[int]]] = None,
+    ) -> None: ...
+    def __getitem__(self, pos: Tuple[int, int]) -> int: ...
+    def __setitem__(self, pos: Tuple[int, int], index: int) -> None: ...
+    def fill(self, index: int, rect: Optional[RectValue] = None) -> None: ...
+    def invalidate(self, rect: Optional[RectValue] = None) -> None: ...
+    def draw(
+        self,
+        target: Union[Surface, Renderer],
+        camera: Coordinate = (0, 0),
+        area: Optional[RectValue] = None,
+    ) -> Rect: ...
@@ -1,4 +1,4 @@
-from typing import Union, final
+from typing import Any, List, Optional, Tuple, Union, final
 
 from pygame.event import Event
 
@@ -8,8 +8,28 @@ def delay(milliseconds: int) -> int: ...
 def set_timer(event: Union[int, Event], millis: int, loops: int = 0) -> None: ...
 @final
 class Clock:
+    def __init__(self, history: int = 0) -> None: ...
     def tick(self, framerate: float = 0) -> int: ...
     def tick_busy_loop(self, framerate: float = 0) -> int: ...
     def get_time(self) -> int: ...
     def get_rawtime(self) -> int: ...
     def get_fps(self) -> float: ...
+    def get_jitter(self) -> Tuple[float, float]: ...
+    def get_frame_times(self) -> memoryview: ...
+    def get_frame_stats(self) -> Tuple[float, float, float, float]: ...
+@final
+class Span:
+    @property
+    def name(self) -> str: ...
+    def __enter__(self) -> Span: ...
+    def __exit__(self, *args: Any) -> Optional[bool]: ...
+@final
+class Profiler:
+    def __init__(self, frames: int = 120, spans: int = 64) -> None: ...
+    def frame_begin(self) -> None: ...
+    def frame_end(self) -> float: ...
+    def span(self, name: str) -> Span: ...
+    def get_frames(
+        self,
+    ) -> List[Tuple[float, List[Tuple[str, int, float, float]]]]: ...
+    def clear(self) -> None: ...
@@ -1,28 +1,62 @@
-from typing import Optional, Sequence, Union
+from typing import List, Optional, Sequence, Tuple, Union, overload
 
 from pygame.color import Color
-from pygame.surface import Surface
+from pygame.mask import Mask
+from pygame.rect import Rect
+from pygame.surface import Surface, SurfacePool
 
-from ._common import ColorValue, Coordinate, RectValue
+from ._common import ColorValue, Coordinate, Literal, RectValue
 
-def flip(surface: Surface, flip_x: bool, flip_y: bool) -> Surface: ...
+def flip(
+    surface: Surface,
+    flip_x: bool,
+    flip_y: bool,
+    dest_surface: Optional[Surface] = None,
+    pool: Optional[SurfacePool] = None,
+) -> Surface: ...
 def scale(
     surface: Surface,
     size: Coordinate,
     dest_surface: Optional[Surface] = None,
+    pool: Optional[SurfacePool] = None,
 ) -> Surface: ...
 def scale_by(
     surface: Surface,
     factor: Union[float, Sequence[float]],
     dest_surface: Optional[Surface] = None,
 ) -> Surface: ...
-def rotate(surface: Surface, angle: float) -> Surface: ...
-def rotozoom(surface: Surface, angle: float, scale: float) -> Surface: ...
+def rotate(
+    surface: Surface,
+    angle: float,
+    dest_surface: Optional[Surface] = None,
+    pool: Optional[SurfacePool] = None,
+) -> Surface: ...
+def rotozoom(
+    surface: Surface,
+    angle: float,
+    scale: float,
+    dest_surface: Optional[Surface] = None,
+    pool: Optional[SurfacePool] = None,
+) -> Surface: ...
+def affine(
+    surface: Surface,
+    matrix: Sequence[float],
+    size: Optional[Coordinate] = None,
+    smooth: bool = True,
+) -> Surface: ...
 def scale2x(surface: Surface, dest_surface: Optional[Surface] = None) -> Surface: ...
+def scale3x(surface: Surface, dest_surface: Optional[Surface] = None) -> Surface: ...
+def scale_by_int(
+    surface: Surface,
+    factor: int,
+    dest_surface: Optional[Surface] = None,
+    pool: Optional[SurfacePool] = None,
+) -> Surface: ...
 def smoothscale(
     surface: Surface,
     size: Coordinate,
     dest_surface: Optional[Surface] = None,
+    pool: Optional[SurfacePool] = None,
 ) -> Surface: ...
 def smoothscale_by(
     surface: Surface,
@@ -31,8 +65,74 @@ def smoothscale_by(
 ) -> Surface: ...
 def get_smoothscale_backend() -> str: ...
 def set_smoothscale_backend(backend: str) -> None: ...
-def chop(surface: Surface, rect: RectValue) -> Surface: ...
+def resample(
+    surface: Surface,
+    size: Coordinate,
+    filter: Literal["bilinear", "bicubic", "lanczos"] = "bicubic",
+    dest_surface: Optional[Surface] = None,
+) -> Surface: ...
+
+class RotationCache:
+    def __init__(
+        self, surface: Surface, steps: int = 36, smooth: bool = False
+    ) -> None: ...
+    def get(self, angle: float) -> Surface: ...
+    def render_all(self) -> None: ...
+    @property
+    def atlas(self) -> Optional[Surface]: ...
+    @property
+    def steps(self) -> int: ...
+    @property
+    def smooth(self) -> bool: ...
+
+def chop(
+    surface: Surface, rect: RectValue, dest_surface: Optional[Surface] = None
+) -> Surface: ...
+@overload
+def split_grid(
+    surface: Surface, cell_size: Coordinate, as_atlas: Literal[False] = False
+) -> List[Surface]: ...
+@overload
+def split_grid(
+    surface: Surface, cell_size: Coordinate, as_atlas: Literal[True]
+) -> Tuple[Surface, List[Rect]]: ...
 def laplacian(surface: Surface, dest_surface: Optional[Surface] = None) -> Surface: ...
+@overload
+def sobel(
+    surface: Surface,
+    output: Literal["magnitude", "direction"] = "magnitude",
+    threshold: int = 128,
+    dest_surface: Optional[Surface] = None,
+) -> Surface: ...
+@overload
+def sobel(surface: Surface, output: Literal["mask"], threshold: int = 128) -> Mask: ...
+@overload
+def scharr(
+    surface: Surface,
+    output: Literal["magnitude", "direction"] = "magnitude",
+    threshold: int = 128,
+    dest_surface: Optional[Surface] = None,
+) -> Surface: ...
+@overload
+def scharr(surface: Surface, output: Literal["mask"], threshold: int = 128) -> Mask: ...
+def box_blur(
+    surface: Surface,
+    radius: int,
+    repeat_edge_pixels: bool = True,
+    dest_surface: Optional[Surface] = None,
+) -> Surface: ...
+def gaussian_blur(
+    surface: Surface,
+    radius: int,
+    repeat_edge_pixels: bool = True,
+    dest_surface: Optional[Surface] = None,
+) -> Surface: ...
+def convolve(
+    surface: Surface,
+    kernel: Sequence[Sequence[float]],
+    repeat_edge_pixels: bool = True,
+    dest_surface: Optional[Surface] = None,
+) -> Surface: ...
 def average_surfaces(
     surfaces: Sequence[Surface],
     dest_surface: Optional[Surface] = None,
@@ -41,6 +141,24 @@ def average_surfaces(
 def average_color(
     surface: Surface, rect: Optional[RectValue] = None, consider_alpha: bool = False
 ) -> Color: ...
+def histogram(
+    surface: Surface,
+    channels: str = "rgb",
+    bins: int = 256,
+    rect: Optional[RectValue] = None,
+) -> Tuple[List[int], ...]: ...
+def colorkey_to_alpha(
+    surface: Surface, dest_surface: Optional[Surface] = None
+) -> Surface: ...
+def alpha_to_colorkey(
+    surface: Surface, threshold: int = 128, colorkey: ColorValue = (255, 0, 255)
+) -> Surface: ...
+def compose_lights(
+    scene: Surface,
+    ambient: ColorValue,
+    lights: Sequence[Tuple[Surface, Union[Coordinate, RectValue]]],
+    dest_surface: Optional[Surface] = None,
+) -> Surface: ...
 def threshold(
     dest_surface: Optional[Surface],
     surface: Surface,
@@ -55,6 +55,30 @@ typedef struct {
 #define clip_ymin(surface) surface->clip_rect.y
 #define clip_ymax(surface) surface->clip_rect.y+surface->clip_rect.h-1
 
+/*!
+\brief Internal color mapping, inlined for the per-pixel drawing functions.
+
+Gives the same value as SDL_MapRGBA, computed in place for formats without a palette.
+
+\param format The pixel format to map the color to.
+\param r The red value of the color.
+\param g The green value of the color.
+\param b The blue value of the color.
+\param a The alpha value of the color.
+
+\returns Returns the color value in the pixel format.
+*/
+static SDL_INLINE Uint32 _mapRGBA(const SDL_PixelFormat * format, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+	if (format->palette) {
+		return (SDL_MapRGBA(format, r, g, b, a));
+	}
+	return ((r >> format->Rloss) << format->Rshift |
+		(g >> format->Gloss) << format->Gshift |
+		(b >> format->Bloss) << format->Bshift |
+		((Uint32) (a >> format->Aloss) << format->Ashift & format->Amask));
+}
+
 /*!
 \brief Internal pixel drawing - fast, no blending, no locking, clipping.
 
@@ -65,7 +89,7 @@ typedef struct {
 
 \returns Returns 0 on success, -1 on failure.
 */
-int fastPixelColorNolock(SDL_Surface * dst, Sint16 x, Sint16 y, Uint32 color)
+static SDL_INLINE int fastPixelColorNolock(SDL_Surface * dst, Sint16 x, Sint16 y, Uint32 color)
 {
 	int bpp;
 	Uint8 *p;
@@ -268,7 +292,7 @@ Only the bits up to the surface depth are significant in the color value.
 
 \returns Returns 0 on success, -1 on failure.
 */
-int _putPixelAlpha(SDL_Surface *dst, Sint16 x, Sint16 y, Uint32 color, Uint8 alpha)
+static SDL_INLINE int _putPixelAlpha(SDL_Surface *dst, Sint16 x, Sint16 y, Uint32 color, Uint8 alpha)
 {
 	SDL_PixelFormat *format;
 	Uint32 Rmask, Gmask, Bmask, Amask;
@@ -499,7 +523,7 @@ int pixelColor(SDL_Surface * dst, Sint16 x, Sint16 y, Uint32 color)
 	*/
 	alpha = color & 0x000000ff;
 	mcolor =
-		SDL_MapRGBA(dst->format, (color & 0xff000000) >> 24,
+		_mapRGBA(dst->format, (color & 0xff000000) >> 24,
 		(color & 0x00ff0000) >> 16, (color & 0x0000ff00) >> 8, alpha);
 
 	/*
@@ -527,7 +551,7 @@ int pixelColor(SDL_Surface * dst, Sint16 x, Sint16 y, Uint32 color)
 
 \returns Returns 0 on success, -1 on failure.
 */
-int pixelColorNolock(SDL_Surface * dst, Sint16 x, Sint16 y, Uint32 color)
+static SDL_INLINE int pixelColorNolock(SDL_Surface * dst, Sint16 x, Sint16 y, Uint32 color)
 {
 	Uint8 alpha;
 	Uint32 mcolor;
@@ -538,7 +562,7 @@ int pixelColorNolock(SDL_Surface * dst, Sint16 x, Sint16 y, Uint32 color)
 	*/
 	alpha = color & 0x000000ff;
 	mcolor =
-		SDL_MapRGBA(dst->format, (color & 0xff000000) >> 24,
+		_mapRGBA(dst->format, (color & 0xff000000) >> 24,
 		(color & 0x00ff0000) >> 16, (color & 0x0000ff00) >> 8, alpha);
 
 	/*
@@ -899,7 +923,7 @@ int pixelColorWeight(SDL_Surface * dst, Sint16 x, Sint16 y, Uint32 color, Uint32
 
 \returns Returns 0 on success, -1 on failure.
 */
-int pixelColorWeightNolock(SDL_Surface * dst, Sint16 x, Sint16 y, Uint32 color, Uint32 weight)
+static SDL_INLINE int pixelColorWeightNolock(SDL_Surface * dst, Sint16 x, Sint16 y, Uint32 color, Uint32 weight)
 {
 	Uint32 a;
 
@@ -18,4 +18,13 @@ typedef struct {
     Uint32 src_colorkey;
     SDL_BlendMode src_blend;
     SDL_BlendMode dst_blend;
+    /* runs of the source, or NULL, and where the blit starts in it */
+    const pgBlitSpans *s_spans;
+    int s_x;
+    int s_y;
+    /* 8 bit sources: the palette mapped to the destination, or NULL */
+    const Uint32 *s_table;
 } SDL_BlitInfo;
+
+/* A low level blit function */
+typedef void (*pg_BlitFunc)(SDL_BlitInfo *info);
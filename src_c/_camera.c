@@ -37,6 +37,21 @@
 #include "camera.h"
 #include "pgcompat.h"
 
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+// arm64 has neon optimisations enabled by default, even when fpu=neon is not
+// passed
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+#if defined(PG_ENABLE_ARM_NEON)
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "include/sse2neon.h"
+#define PG_CAMERA_SIMD
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define PG_CAMERA_SIMD
+#endif
+
 /*
 #if defined(__unix__) || !defined(__APPLE__)
 #else
@@ -66,6 +81,47 @@ PyObject *
 camera_get_image(pgCameraObject *self, PyObject *arg);
 PyObject *
 camera_get_raw(pgCameraObject *self, PyObject *args);
+PyObject *
+camera_get_raw_view(pgCameraObject *self, PyObject *args);
+PyObject *
+camera_release_raw_view(pgCameraObject *self, PyObject *args);
+PyObject *
+camera_export_dmabuf(pgCameraObject *self, PyObject *args);
+PyObject *
+camera_start_capture(pgCameraObject *self, PyObject *args, PyObject *kwds);
+PyObject *
+camera_stop_capture(pgCameraObject *self, PyObject *args);
+PyObject *
+camera_get_latest(pgCameraObject *self, PyObject *args, PyObject *kwds);
+PyObject *
+camera_get_next(pgCameraObject *self, PyObject *args, PyObject *kwds);
+PyObject *
+camera_get_capture_stats(pgCameraObject *self, PyObject *args);
+
+#if defined(__unix__)
+/* the calls that dequeue frames themselves, which would race the capture
+ * thread */
+/* Stops the capture thread, if any. It is taken off self->capture with the
+ * GIL held, so no new get_latest() or get_next() call can start on it. */
+static void
+camera_end_capture(pgCameraObject *self)
+{
+    SDL_Thread *thread = self->capture;
+
+    if (!thread)
+        return;
+    self->capture = NULL;
+    Py_BEGIN_ALLOW_THREADS;
+    v4l2_stop_capture(self, thread);
+    Py_END_ALLOW_THREADS;
+}
+
+#define CAPTURE_THREAD_CHECK(self)                                   \
+    if ((self)->capture)                                             \
+    return RAISE(PyExc_RuntimeError,                                 \
+                 "the capture thread is running, use get_latest() or " \
+                 "get_next()")
+#endif
 
 /*
  * Functions available to pygame users.  The idea is to make these as simple as
@@ -129,6 +185,8 @@ surf_colorspace(PyObject *self, PyObject *arg)
     /* check to see if the format of the surface is the same. */
     if (surf->format->BitsPerPixel != newsurf->format->BitsPerPixel)
         return RAISE(PyExc_ValueError, "Surfaces not the same depth");
+    if (!pgSurface_Unshare(newsurf))
+        return NULL;
 
     SDL_LockSurface(newsurf);
     pgSurface_Lock(surfobj);
@@ -243,6 +301,11 @@ PyObject *
 camera_stop(pgCameraObject *self, PyObject *_null)
 {
 #if defined(__unix__)
+    if (self->n_views) {
+        return RAISE(pgExc_BufferError,
+                     "raw views of the camera buffers are still in use");
+    }
+    camera_end_capture(self);
     if (v4l2_stop_capturing(self) == 0)
         return NULL;
     if (v4l2_uninit_device(self) == 0)
@@ -351,6 +414,7 @@ PyObject *
 camera_query_image(pgCameraObject *self, PyObject *_null)
 {
 #if defined(__unix__)
+    CAPTURE_THREAD_CHECK(self);
     return PyBool_FromLong(v4l2_query_buffer(self));
 #elif defined(PYGAME_WINDOWS_CAMERA)
     int ready;
@@ -375,6 +439,8 @@ camera_get_image(pgCameraObject *self, PyObject *arg)
     if (!PyArg_ParseTuple(arg, "|O!", &pgSurface_Type, &surfobj))
         return NULL;
 
+    CAPTURE_THREAD_CHECK(self);
+
     if (!surfobj) {
         surf = SDL_CreateRGBSurface(0, self->width, self->height, 24,
                                     0xFF << 16, 0xFF << 8, 0xFF, 0);
@@ -390,6 +456,8 @@ camera_get_image(pgCameraObject *self, PyObject *arg)
         return RAISE(PyExc_ValueError,
                      "Destination surface not the correct width or height.");
     }
+    if (!pgSurface_Unshare(surf))
+        return NULL;
 
     Py_BEGIN_ALLOW_THREADS;
     ret = v4l2_read_frame(self, surf, &errno_code);
@@ -437,6 +505,8 @@ camera_get_image(pgCameraObject *self, PyObject *arg)
         return RAISE(PyExc_ValueError,
                      "Destination surface not the correct width or height.");
     }
+    if (!pgSurface_Unshare(surf))
+        return NULL;
 
     if (!windows_read_frame(self, surf))
         return NULL;
@@ -458,6 +528,7 @@ PyObject *
 camera_get_raw(pgCameraObject *self, PyObject *_null)
 {
 #if defined(__unix__)
+    CAPTURE_THREAD_CHECK(self);
     return v4l2_read_raw(self);
 #elif defined(PYGAME_WINDOWS_CAMERA)
     return windows_read_raw(self);
@@ -465,10 +536,760 @@ camera_get_raw(pgCameraObject *self, PyObject *_null)
     Py_RETURN_NONE;
 }
 
+/* get_raw_view() - returns a memoryview of the frame in the buffer itself */
+PyObject *
+camera_get_raw_view(pgCameraObject *self, PyObject *_null)
+{
+#if defined(__unix__)
+    int ret, errno_code = 0;
+
+    CAPTURE_THREAD_CHECK(self);
+    Py_BEGIN_ALLOW_THREADS;
+    ret = v4l2_hold_frame(self, &errno_code);
+    Py_END_ALLOW_THREADS;
+    if (!ret) {
+        return PyErr_Format(PyExc_SystemError,
+                            "ioctl(VIDIOC_DQBUF) failure : %d, %s",
+                            errno_code, strerror(errno_code));
+    }
+    return PyMemoryView_FromObject((PyObject *)self);
+#else
+    return RAISE(PyExc_NotImplementedError,
+                 "get_raw_view() needs a V4L2 camera");
+#endif
+}
+
+/* release_raw_view() - gives the held buffer back to the camera */
+PyObject *
+camera_release_raw_view(pgCameraObject *self, PyObject *_null)
+{
+#if defined(__unix__)
+    if (!v4l2_release_frame(self))
+        return NULL;
+#endif
+    Py_RETURN_NONE;
+}
+
+/* export_dmabuf() - returns a DMABUF file descriptor of the held buffer */
+PyObject *
+camera_export_dmabuf(pgCameraObject *self, PyObject *_null)
+{
+#if defined(__unix__)
+    int fd;
+
+    if (self->held == -1) {
+        return RAISE(PyExc_RuntimeError,
+                     "no frame held, call get_raw_view() first");
+    }
+    fd = v4l2_export_dmabuf(self);
+    if (fd == -1)
+        return NULL;
+    return PyLong_FromLong(fd);
+#else
+    return RAISE(PyExc_NotImplementedError,
+                 "export_dmabuf() needs a V4L2 camera");
+#endif
+}
+
+/* start_capture(frames=3, event=0) - captures on a thread of its own */
+PyObject *
+camera_start_capture(pgCameraObject *self, PyObject *args, PyObject *kwds)
+{
+#if defined(__unix__)
+    int frames = 3, event = 0;
+    char *kwids[] = {"frames", "event", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|ii", kwids, &frames,
+                                     &event))
+        return NULL;
+
+    if (frames < 2 || frames > 16)
+        return RAISE(PyExc_ValueError, "frames must be from 2 to 16");
+    if (event < 0 || event >= PG_NUMEVENTS)
+        return RAISE(PyExc_ValueError, "event type out of range");
+    if (self->fd == -1)
+        return RAISE(PyExc_RuntimeError, "the camera is not started");
+    if (self->capture)
+        return RAISE(PyExc_RuntimeError, "the capture thread is running");
+
+    if (!v4l2_start_capture(self, frames, event))
+        return NULL;
+    Py_RETURN_NONE;
+#else
+    return RAISE(PyExc_NotImplementedError,
+                 "start_capture() needs a V4L2 camera");
+#endif
+}
+
+/* stop_capture() - stops the capture thread */
+PyObject *
+camera_stop_capture(pgCameraObject *self, PyObject *_null)
+{
+#if defined(__unix__)
+    camera_end_capture(self);
+#endif
+    Py_RETURN_NONE;
+}
+
+#if defined(__unix__)
+/* Checks a surface given to get_latest() or get_next(). */
+static int
+camera_check_frame_surface(pgCameraObject *self, pgSurfaceObject *surfobj)
+{
+    SDL_Surface *surf;
+
+    if (!self->capture) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "no capture thread, call start_capture() first");
+        return 0;
+    }
+    if (!surfobj)
+        return 1;
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf) {
+        PyErr_SetString(pgExc_SDLError, "display Surface quit");
+        return 0;
+    }
+    if (surf->w != self->width || surf->h != self->height) {
+        PyErr_SetString(PyExc_ValueError,
+                        "Destination surface not the correct width or "
+                        "height.");
+        return 0;
+    }
+    return pgSurface_Unshare(surf);
+}
+
+/* Hands out frame slot, which the caller took off the queue and marked as
+ * self->reading. The GIL stays held, so there is one reader at a time. */
+static PyObject *
+camera_take_frame(pgCameraObject *self, int slot, pgSurfaceObject *surfobj)
+{
+    SDL_Surface *frame = self->frames[slot];
+    SDL_Surface *surf;
+    int failed = 0;
+
+    if (surfobj) {
+        surf = pgSurface_AsSurface(surfobj);
+        failed = SDL_BlitSurface(frame, NULL, surf, NULL);
+    }
+    else {
+        surf = SDL_ConvertSurface(frame, frame->format, 0);
+        failed = !surf;
+    }
+
+    SDL_LockMutex(self->capture_lock);
+    self->reading = -1;
+    SDL_UnlockMutex(self->capture_lock);
+
+    if (failed)
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    if (surfobj) {
+        Py_INCREF(surfobj);
+        return (PyObject *)surfobj;
+    }
+    return (PyObject *)pgSurface_New(surf);
+}
+
+/* Queued frame with the lowest (oldest) or highest (newest) order, or -1.
+ * Called with capture_lock held. */
+static int
+camera_queued_frame(pgCameraObject *self, int newest)
+{
+    int i, slot = -1;
+
+    for (i = 0; i < self->n_frames; i++) {
+        if (!self->frame_seq[i])
+            continue;
+        if (slot == -1 ||
+            (newest ? self->frame_seq[i] > self->frame_seq[slot]
+                    : self->frame_seq[i] < self->frame_seq[slot]))
+            slot = i;
+    }
+    return slot;
+}
+
+/* Takes slot off the queue to read. Called with capture_lock held. */
+static void
+camera_mark_read(pgCameraObject *self, int slot)
+{
+    self->frame_seq[slot] = 0;
+    self->reading = slot;
+    self->delivered++;
+}
+
+static PyObject *
+camera_capture_error(pgCameraObject *self, int error)
+{
+    return PyErr_Format(PyExc_SystemError, "capture thread failure : %d, %s",
+                        error, strerror(error));
+}
+#endif
+
+/* get_latest(surface=None) - the newest frame, dropping older ones */
+PyObject *
+camera_get_latest(pgCameraObject *self, PyObject *args, PyObject *kwds)
+{
+#if defined(__unix__)
+    pgSurfaceObject *surfobj = NULL;
+    char *kwids[] = {"surface", NULL};
+    int i, slot, error;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O!", kwids,
+                                     &pgSurface_Type, &surfobj))
+        return NULL;
+    if (!camera_check_frame_surface(self, surfobj))
+        return NULL;
+
+    SDL_LockMutex(self->capture_lock);
+    slot = camera_queued_frame(self, 1);
+    if (slot != -1) {
+        for (i = 0; i < self->n_frames; i++) {
+            if (i != slot && self->frame_seq[i]) {
+                self->frame_seq[i] = 0;
+                self->dropped++;
+            }
+        }
+        camera_mark_read(self, slot);
+    }
+    error = self->capture_error;
+    SDL_UnlockMutex(self->capture_lock);
+
+    if (slot != -1)
+        return camera_take_frame(self, slot, surfobj);
+    if (error)
+        return camera_capture_error(self, error);
+    Py_RETURN_NONE;
+#else
+    return RAISE(PyExc_NotImplementedError,
+                 "get_latest() needs a V4L2 camera");
+#endif
+}
+
+/* get_next(timeout=-1, surface=None) - the oldest frame not handed out */
+PyObject *
+camera_get_next(pgCameraObject *self, PyObject *args, PyObject *kwds)
+{
+#if defined(__unix__)
+    pgSurfaceObject *surfobj = NULL;
+    char *kwids[] = {"timeout", "surface", NULL};
+    int timeout = -1, slot, error;
+    Uint32 start, elapsed;
+    PyObject *frame = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|iO!", kwids, &timeout,
+                                     &pgSurface_Type, &surfobj))
+        return NULL;
+    if (!camera_check_frame_surface(self, surfobj))
+        return NULL;
+
+    /* stop_capture() waits for us to be done with the frames */
+    self->capture_waiters++;
+    Py_BEGIN_ALLOW_THREADS;
+    start = SDL_GetTicks();
+    SDL_LockMutex(self->capture_lock);
+    while ((slot = camera_queued_frame(self, 0)) == -1 &&
+           !self->capture_error && !self->capture_quit) {
+        if (timeout < 0) {
+            SDL_CondWait(self->capture_cond, self->capture_lock);
+            continue;
+        }
+        elapsed = SDL_GetTicks() - start;
+        if (elapsed >= (Uint32)timeout)
+            break;
+        SDL_CondWaitTimeout(self->capture_cond, self->capture_lock,
+                            timeout - elapsed);
+    }
+    if (self->capture_quit)
+        slot = -1;
+    if (slot != -1)
+        camera_mark_read(self, slot);
+    error = self->capture_error;
+    SDL_UnlockMutex(self->capture_lock);
+    Py_END_ALLOW_THREADS;
+
+    if (slot != -1)
+        frame = camera_take_frame(self, slot, surfobj);
+    else if (error)
+        camera_capture_error(self, error);
+    else {
+        Py_INCREF(Py_None);
+        frame = Py_None;
+    }
+
+    SDL_LockMutex(self->capture_lock);
+    self->capture_waiters--;
+    SDL_CondBroadcast(self->capture_cond);
+    SDL_UnlockMutex(self->capture_lock);
+    return frame;
+#else
+    return RAISE(PyExc_NotImplementedError,
+                 "get_next() needs a V4L2 camera");
+#endif
+}
+
+/* get_capture_stats() - frame counts of the capture thread */
+PyObject *
+camera_get_capture_stats(pgCameraObject *self, PyObject *_null)
+{
+#if defined(__unix__)
+    unsigned long captured = 0, delivered = 0, dropped = 0;
+    int queued = 0, i;
+
+    if (self->capture) {
+        SDL_LockMutex(self->capture_lock);
+        captured = self->captured;
+        delivered = self->delivered;
+        dropped = self->dropped;
+        for (i = 0; i < self->n_frames; i++) {
+            if (self->frame_seq[i])
+                queued++;
+        }
+        SDL_UnlockMutex(self->capture_lock);
+    }
+    return Py_BuildValue("{s:k,s:k,s:k,s:i}", "captured", captured,
+                         "delivered", delivered, "dropped", dropped, "queued",
+                         queued);
+#else
+    return RAISE(PyExc_NotImplementedError,
+                 "get_capture_stats() needs a V4L2 camera");
+#endif
+}
+
+#if defined(__unix__)
+static int
+camera_getbuffer(pgCameraObject *self, Py_buffer *view, int flags)
+{
+    if (self->held == -1) {
+        view->obj = NULL;
+        PyErr_SetString(pgExc_BufferError,
+                        "no frame held, call get_raw_view() first");
+        return -1;
+    }
+    if (PyBuffer_FillInfo(view, (PyObject *)self,
+                          self->buffers[self->held].start,
+                          (Py_ssize_t)self->held_bytes, 1, flags)) {
+        return -1;
+    }
+    ++self->n_views;
+    return 0;
+}
+
+static void
+camera_releasebuffer(pgCameraObject *self, Py_buffer *view)
+{
+    --self->n_views;
+}
+
+static PyBufferProcs camera_as_buffer = {
+    (getbufferproc)camera_getbuffer, (releasebufferproc)camera_releasebuffer};
+#endif
+
 /*
  * Pixelformat conversion functions
  */
 
+/* The converters below that run on every frame are split into a kernel
+ * over a span of pixels (or of rows, for the planar and bayer formats) and
+ * a public wrapper, which hands large frames to the worker pool in bands.
+ * Every band runs the same kernel, so output does not depend on the number
+ * of threads. */
+typedef void (*cam_span_func)(const void *src, void *dst, int length,
+                              unsigned long source, SDL_PixelFormat *format);
+typedef void (*cam_rows_func)(const void *src, void *dst, int width,
+                              int height, int start, int end,
+                              SDL_PixelFormat *format);
+
+typedef struct {
+    cam_span_func span;
+    cam_rows_func rows;
+    const Uint8 *src;
+    Uint8 *dst;
+    int length; /* pixels for span kernels, rows for row kernels */
+    int srcbytes;
+    int width;
+    int height;
+    unsigned long source;
+    SDL_PixelFormat *format;
+} CameraBands;
+
+/* Span bands start on 16 pixel boundaries, keeping the pixel pairs of the
+ * 4:2:2 formats and the SIMD blocks whole. */
+static void
+camera_span_band(void *data, int band, int nbands)
+{
+    CameraBands *bands = (CameraBands *)data;
+    int blocks = (bands->length + 15) / 16;
+    int start = blocks * band / nbands * 16;
+    int end = blocks * (band + 1) / nbands * 16;
+
+    if (end > bands->length) {
+        end = bands->length;
+    }
+    if (start >= end) {
+        return;
+    }
+    bands->span(bands->src + (size_t)start * bands->srcbytes,
+                bands->dst + (size_t)start * bands->format->BytesPerPixel,
+                end - start, bands->source, bands->format);
+}
+
+static void
+camera_rows_band(void *data, int band, int nbands)
+{
+    CameraBands *bands = (CameraBands *)data;
+    int start = bands->length * band / nbands;
+    int end = bands->length * (band + 1) / nbands;
+
+    if (start < end) {
+        bands->rows(bands->src, bands->dst, bands->width, bands->height,
+                    start, end, bands->format);
+    }
+}
+
+static void
+camera_run_span(cam_span_func span, const void *src, int srcbytes,
+                void *dst, int length, unsigned long source,
+                SDL_PixelFormat *format)
+{
+    CameraBands bands;
+    int nthreads = pg_GetNumThreads();
+
+    if (nthreads < 2 || length < PG_PARALLEL_MIN_PIXELS) {
+        span(src, dst, length, source, format);
+        return;
+    }
+    bands.span = span;
+    bands.rows = NULL;
+    bands.src = (const Uint8 *)src;
+    bands.dst = (Uint8 *)dst;
+    bands.length = length;
+    bands.srcbytes = srcbytes;
+    bands.width = length;
+    bands.height = 1;
+    bands.source = source;
+    bands.format = format;
+    pg_ParallelFor(camera_span_band, &bands, nthreads);
+}
+
+/* rows is the number of units rows() steps over, which for yuv420 is pairs
+ * of rows sharing their chroma. */
+static void
+camera_run_rows(cam_rows_func rows, const void *src, void *dst, int width,
+                int height, int nrows, SDL_PixelFormat *format)
+{
+    CameraBands bands;
+    int nthreads = pg_GetNumThreads();
+
+    if (nthreads < 2 || nrows < 2 ||
+        (long long)width * height < PG_PARALLEL_MIN_PIXELS) {
+        rows(src, dst, width, height, 0, nrows, format);
+        return;
+    }
+    if (nthreads > nrows) {
+        nthreads = nrows;
+    }
+    bands.span = NULL;
+    bands.rows = rows;
+    bands.src = (const Uint8 *)src;
+    bands.dst = (Uint8 *)dst;
+    bands.length = nrows;
+    bands.srcbytes = 1;
+    bands.width = width;
+    bands.height = height;
+    bands.source = 0;
+    bands.format = format;
+    pg_ParallelFor(camera_rows_band, &bands, nthreads);
+}
+
+/* bytes per pixel read by rgb_to_hsv() and rgb_to_yuv() for a source */
+static int
+camera_source_bytes(unsigned long source, SDL_PixelFormat *format)
+{
+    switch (source) {
+        case V4L2_PIX_FMT_RGB444:
+            return 2;
+        case V4L2_PIX_FMT_RGB24:
+            return 3;
+        case V4L2_PIX_FMT_XBGR32:
+            return 4;
+        default:
+            return format->BytesPerPixel;
+    }
+}
+
+#ifdef PG_CAMERA_SIMD
+/* The SIMD kernels handle 32 bit pixels with 8 bit channels, the format of
+ * nearly every display surface. Everything else takes the scalar loops. */
+#define CAMERA_SIMD_FORMAT(f)                                    \
+    ((f)->BytesPerPixel == 4 && !(f)->Rloss && !(f)->Gloss && \
+     !(f)->Bloss)
+
+/* a pair of 16 bit multipliers for _mm_madd_epi16 */
+#define CAMERA_MADD_PAIR(lo, hi) \
+    _mm_set1_epi32((int)(((Uint32)(Uint16)(hi) << 16) | (Uint16)(lo)))
+
+/* Packs 8 lanes each of 16 bit r, g and b into 8 pixels at dst. */
+static PG_INLINE void
+camera_store8_sse2(Uint8 *dst, __m128i r, __m128i g, __m128i b,
+                   SDL_PixelFormat *format)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i rs = _mm_cvtsi32_si128(format->Rshift);
+    __m128i gs = _mm_cvtsi32_si128(format->Gshift);
+    __m128i bs = _mm_cvtsi32_si128(format->Bshift);
+    __m128i lo, hi;
+
+    lo = _mm_or_si128(
+        _mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(r, zero), rs),
+                     _mm_sll_epi32(_mm_unpacklo_epi16(g, zero), gs)),
+        _mm_sll_epi32(_mm_unpacklo_epi16(b, zero), bs));
+    hi = _mm_or_si128(
+        _mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(r, zero), rs),
+                     _mm_sll_epi32(_mm_unpackhi_epi16(g, zero), gs)),
+        _mm_sll_epi32(_mm_unpackhi_epi16(b, zero), bs));
+    _mm_storeu_si128((__m128i *)dst, lo);
+    _mm_storeu_si128((__m128i *)(dst + 16), hi);
+}
+
+/* The libv4l terms of yuyv_to_rgb(), for 8 lanes of u - 128 and v - 128.
+ * They fit 16 bits, so the results match the scalar code exactly. */
+static PG_INLINE void
+camera_uv_terms_sse2(__m128i u, __m128i v, __m128i *u1, __m128i *rg,
+                     __m128i *v1)
+{
+    __m128i three = _mm_set1_epi16(3);
+
+    *u1 = _mm_srai_epi16(_mm_mullo_epi16(u, _mm_set1_epi16(129)), 6);
+    *rg = _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(u, three),
+                                       _mm_mullo_epi16(v, _mm_set1_epi16(6))),
+                         3);
+    *v1 = _mm_srai_epi16(_mm_mullo_epi16(v, three), 1);
+}
+
+/* SAT2() on 8 lanes of y plus the u and v terms, stored as 8 pixels */
+static PG_INLINE void
+camera_store_yuv8_sse2(Uint8 *dst, __m128i y, __m128i u1, __m128i rg,
+                       __m128i v1, SDL_PixelFormat *format)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i max = _mm_set1_epi16(255);
+    __m128i r, g, b;
+
+    r = _mm_min_epi16(_mm_max_epi16(_mm_add_epi16(y, v1), zero), max);
+    g = _mm_min_epi16(_mm_max_epi16(_mm_sub_epi16(y, rg), zero), max);
+    b = _mm_min_epi16(_mm_max_epi16(_mm_add_epi16(y, u1), zero), max);
+    camera_store8_sse2(dst, r, g, b, format);
+}
+
+/* Converts whole blocks of 8 yuyv (or uyvy) pixels, returning how many
+ * pixels it did. */
+static int
+camera_yuv422_sse2(const Uint8 *src, Uint8 *dst, int length, int uyvy,
+                   SDL_PixelFormat *format)
+{
+    __m128i lomask = _mm_set1_epi16(0xFF);
+    __m128i half = _mm_set1_epi16(128);
+    __m128i px, y, c, u, v, u1, rg, v1;
+    int n;
+
+    for (n = 0; n + 8 <= length; n += 8, src += 16, dst += 32) {
+        px = _mm_loadu_si128((const __m128i *)src);
+        if (uyvy) {
+            y = _mm_srli_epi16(px, 8);
+            c = _mm_and_si128(px, lomask);
+        }
+        else {
+            y = _mm_and_si128(px, lomask);
+            c = _mm_srli_epi16(px, 8);
+        }
+        /* c holds u, v for each pair of pixels; spread them out */
+        c = _mm_sub_epi16(c, half);
+        u = _mm_shufflehi_epi16(
+            _mm_shufflelo_epi16(c, _MM_SHUFFLE(2, 2, 0, 0)),
+            _MM_SHUFFLE(2, 2, 0, 0));
+        v = _mm_shufflehi_epi16(
+            _mm_shufflelo_epi16(c, _MM_SHUFFLE(3, 3, 1, 1)),
+            _MM_SHUFFLE(3, 3, 1, 1));
+        camera_uv_terms_sse2(u, v, &u1, &rg, &v1);
+        camera_store_yuv8_sse2(dst, y, u1, rg, v1, format);
+    }
+    return n;
+}
+
+/* Converts whole blocks of 8 pixels of a pair of yuv420 rows, returning
+ * how many pixels of each row it did. */
+static int
+camera_yuv420_sse2(const Uint8 *y1, const Uint8 *y2, const Uint8 *u,
+                   const Uint8 *v, Uint8 *d1, Uint8 *d2, int width,
+                   SDL_PixelFormat *format)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i half = _mm_set1_epi16(128);
+    __m128i uu, vv, u1, rg, v1;
+    int n, quad;
+
+    for (n = 0; n + 8 <= width; n += 8) {
+        memcpy(&quad, u + n / 2, 4);
+        uu = _mm_unpacklo_epi8(_mm_cvtsi32_si128(quad), zero);
+        memcpy(&quad, v + n / 2, 4);
+        vv = _mm_unpacklo_epi8(_mm_cvtsi32_si128(quad), zero);
+        uu = _mm_sub_epi16(_mm_unpacklo_epi16(uu, uu), half);
+        vv = _mm_sub_epi16(_mm_unpacklo_epi16(vv, vv), half);
+        camera_uv_terms_sse2(uu, vv, &u1, &rg, &v1);
+        camera_store_yuv8_sse2(
+            d1 + n * 4,
+            _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(y1 + n)),
+                              zero),
+            u1, rg, v1, format);
+        camera_store_yuv8_sse2(
+            d2 + n * 4,
+            _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(y2 + n)),
+                              zero),
+            u1, rg, v1, format);
+    }
+    return n;
+}
+
+/* Splits 4 32 bit pixels into lanes of their r, g and b channels */
+static PG_INLINE void
+camera_load_rgb4_sse2(const Uint8 *src, __m128i *r, __m128i *g, __m128i *b,
+                      SDL_PixelFormat *format)
+{
+    __m128i mask = _mm_set1_epi32(0xFF);
+    __m128i px = _mm_loadu_si128((const __m128i *)src);
+
+    *r = _mm_and_si128(_mm_srl_epi32(px, _mm_cvtsi32_si128(format->Rshift)),
+                       mask);
+    *g = _mm_and_si128(_mm_srl_epi32(px, _mm_cvtsi32_si128(format->Gshift)),
+                       mask);
+    *b = _mm_and_si128(_mm_srl_epi32(px, _mm_cvtsi32_si128(format->Bshift)),
+                       mask);
+}
+
+/* Packs 4 lanes each of 32 bit channels into 4 pixels at dst. */
+static PG_INLINE void
+camera_store4_sse2(Uint8 *dst, __m128i r, __m128i g, __m128i b,
+                   SDL_PixelFormat *format)
+{
+    _mm_storeu_si128(
+        (__m128i *)dst,
+        _mm_or_si128(
+            _mm_or_si128(_mm_sll_epi32(r, _mm_cvtsi32_si128(format->Rshift)),
+                         _mm_sll_epi32(g, _mm_cvtsi32_si128(format->Gshift))),
+            _mm_sll_epi32(b, _mm_cvtsi32_si128(format->Bshift))));
+}
+
+/* bgr32_to_rgb() on whole blocks of 4 pixels. Returns the pixels done. */
+static int
+camera_bgr32_sse2(const Uint8 *src, Uint8 *dst, int length,
+                  SDL_PixelFormat *format)
+{
+    __m128i mask = _mm_set1_epi32(0xFF);
+    __m128i px;
+    int n;
+
+    for (n = 0; n + 4 <= length; n += 4, src += 16, dst += 16) {
+        px = _mm_loadu_si128((const __m128i *)src);
+        camera_store4_sse2(dst, _mm_and_si128(_mm_srli_epi32(px, 16), mask),
+                           _mm_and_si128(_mm_srli_epi32(px, 8), mask),
+                           _mm_and_si128(px, mask), format);
+    }
+    return n;
+}
+
+/* rgb_to_yuv() stage 2 on whole blocks of 4 pixels, in 32 bit fixed point
+ * with the same coefficients and rounding. Returns the pixels done. */
+static int
+camera_rgb_to_yuv_sse2(const Uint8 *src, Uint8 *dst, int length,
+                       SDL_PixelFormat *format)
+{
+    __m128i one = _mm_set1_epi32(0x10000);
+    __m128i half = _mm_set1_epi32(128);
+    __m128i ky = CAMERA_MADD_PAIR(77, 150), kyb = CAMERA_MADD_PAIR(29, 128);
+    __m128i ku = CAMERA_MADD_PAIR(-38, -74),
+            kub = CAMERA_MADD_PAIR(112, 128);
+    __m128i kv = CAMERA_MADD_PAIR(112, -94),
+            kvb = CAMERA_MADD_PAIR(-18, 128);
+    __m128i r, g, b, rg, b1, y, u, v;
+    int n;
+
+    for (n = 0; n + 4 <= length; n += 4, src += 16, dst += 16) {
+        camera_load_rgb4_sse2(src, &r, &g, &b, format);
+        /* pairs of (r, g) and (b, 1) for the multiply-adds */
+        rg = _mm_or_si128(r, _mm_slli_epi32(g, 16));
+        b1 = _mm_or_si128(b, one);
+        y = _mm_srai_epi32(
+            _mm_add_epi32(_mm_madd_epi16(rg, ky), _mm_madd_epi16(b1, kyb)),
+            8);
+        u = _mm_add_epi32(
+            _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(rg, ku),
+                                         _mm_madd_epi16(b1, kub)),
+                           8),
+            half);
+        v = _mm_add_epi32(
+            _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(rg, kv),
+                                         _mm_madd_epi16(b1, kvb)),
+                           8),
+            half);
+        camera_store4_sse2(dst, y, u, v, format);
+    }
+    return n;
+}
+
+/* rgb_to_hsv() stage 2 on whole blocks of 4 pixels. The quotients are at
+ * most 255 with integer operands, so single precision division truncated
+ * toward zero gives exactly the integer division of the scalar code. */
+static int
+camera_rgb_to_hsv_sse2(const Uint8 *src, Uint8 *dst, int length,
+                       SDL_PixelFormat *format)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i mask = _mm_set1_epi32(0xFF);
+    __m128 k43 = _mm_set1_ps(43.0f), k255 = _mm_set1_ps(255.0f);
+    __m128i r, g, b, max, min, delta, isr, isg, grey, h, hr, hg, hb, s;
+    __m128 fdelta;
+    int n;
+
+    for (n = 0; n + 4 <= length; n += 4, src += 16, dst += 16) {
+        camera_load_rgb4_sse2(src, &r, &g, &b, format);
+        /* the channels fit 16 bits, so the 16 bit min and max will do */
+        max = _mm_max_epi16(_mm_max_epi16(r, g), b);
+        min = _mm_min_epi16(_mm_min_epi16(r, g), b);
+        delta = _mm_sub_epi32(max, min);
+        fdelta = _mm_cvtepi32_ps(delta);
+
+        s = _mm_cvttps_epi32(_mm_div_ps(_mm_mul_ps(k255, fdelta),
+                                        _mm_cvtepi32_ps(max)));
+        hr = _mm_cvttps_epi32(_mm_div_ps(
+            _mm_mul_ps(k43, _mm_cvtepi32_ps(_mm_sub_epi32(g, b))), fdelta));
+        hg = _mm_add_epi32(
+            _mm_set1_epi32(85),
+            _mm_cvttps_epi32(_mm_div_ps(
+                _mm_mul_ps(k43, _mm_cvtepi32_ps(_mm_sub_epi32(b, r))),
+                fdelta)));
+        hb = _mm_add_epi32(
+            _mm_set1_epi32(170),
+            _mm_cvttps_epi32(_mm_div_ps(
+                _mm_mul_ps(k43, _mm_cvtepi32_ps(_mm_sub_epi32(r, g))),
+                fdelta)));
+
+        /* pick the hue of the largest channel, red first, then green */
+        isr = _mm_cmpeq_epi32(r, max);
+        isg = _mm_andnot_si128(isr, _mm_cmpeq_epi32(g, max));
+        h = _mm_or_si128(
+            _mm_or_si128(_mm_and_si128(isr, hr), _mm_and_si128(isg, hg)),
+            _mm_andnot_si128(_mm_or_si128(isr, isg), hb));
+
+        /* grey has zero hue and saturation, and h wraps as a Uint8 */
+        grey = _mm_cmpeq_epi32(delta, zero);
+        h = _mm_and_si128(_mm_andnot_si128(grey, h), mask);
+        s = _mm_andnot_si128(grey, s);
+        camera_store4_sse2(dst, h, s, max, format);
+    }
+    return n;
+}
+#endif /* PG_CAMERA_SIMD */
+
 /* converts from rgb Surface to yuv or hsv */
 /* TODO: Allow for conversion from yuv and hsv to all */
 void
@@ -549,8 +1370,9 @@ rgb24_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
 
 /* slight variation on rgb24_to_rgb, just drops the 4th byte of each pixel,
  * changes the R, G, B ordering. */
-void
-bgr32_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
+static void
+bgr32_span_to_rgb(const void *src, void *dst, int length,
+                  unsigned long source, SDL_PixelFormat *format)
 {
     Uint8 *s = (Uint8 *)src;
     Uint8 *d8;
@@ -566,6 +1388,15 @@ bgr32_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
     gloss = format->Gloss;
     bloss = format->Bloss;
 
+#ifdef PG_CAMERA_SIMD
+    if (CAMERA_SIMD_FORMAT(format)) {
+        int done = camera_bgr32_sse2(s, (Uint8 *)dst, length, format);
+        s += done * 4;
+        dst = (Uint32 *)dst + done;
+        length -= done;
+    }
+#endif
+
     switch (format->BytesPerPixel) {
         case 1:
             d8 = (Uint8 *)dst;
@@ -612,10 +1443,16 @@ bgr32_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
     }
 }
 
-/* converts packed rgb to packed hsv. formulas modified from wikipedia */
 void
-rgb_to_hsv(const void *src, void *dst, int length, unsigned long source,
-           SDL_PixelFormat *format)
+bgr32_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
+{
+    camera_run_span(bgr32_span_to_rgb, src, 4, dst, length, 0, format);
+}
+
+/* converts packed rgb to packed hsv. formulas modified from wikipedia */
+static void
+rgb_span_to_hsv(const void *src, void *dst, int length, unsigned long source,
+                SDL_PixelFormat *format)
 {
     Uint8 *s8, *d8;
     Uint16 *s16, *d16;
@@ -641,6 +1478,16 @@ rgb_to_hsv(const void *src, void *dst, int length, unsigned long source,
     /* 10 yrs later... about that... */
     if (source == V4L2_PIX_FMT_RGB444 || source == V4L2_PIX_FMT_RGB24 ||
         source == V4L2_PIX_FMT_XBGR32) {
+#ifdef PG_CAMERA_SIMD
+        /* unpack xbgr32 into dst, then convert it there as stage 2 does */
+        if (source == V4L2_PIX_FMT_XBGR32 && CAMERA_SIMD_FORMAT(format)) {
+            int done = camera_bgr32_sse2(s8, d8, length, format);
+            camera_rgb_to_hsv_sse2(d8, d8, done, format);
+            s8 += done * 4;
+            d32 += done;
+            length -= done;
+        }
+#endif
         while (length--) {
             if (source == V4L2_PIX_FMT_RGB444) {
                 p1 = *s8++;
@@ -705,6 +1552,15 @@ rgb_to_hsv(const void *src, void *dst, int length, unsigned long source,
         }
     }
     else { /* for use as stage 2 in yuv or bayer to hsv, r and b switched */
+#ifdef PG_CAMERA_SIMD
+        if (CAMERA_SIMD_FORMAT(format)) {
+            int done = camera_rgb_to_hsv_sse2((const Uint8 *)src,
+                                              (Uint8 *)dst, length, format);
+            s32 += done;
+            d32 += done;
+            length -= done;
+        }
+#endif
         while (length--) {
             switch (format->BytesPerPixel) {
                 case 1:
@@ -774,11 +1630,19 @@ rgb_to_hsv(const void *src, void *dst, int length, unsigned long source,
     }
 }
 
-/* convert packed rgb to yuv. Note that unlike many implementations of YUV,
-   this has a full range of 0-255 for Y, not 16-235. Formulas from wikipedia */
 void
-rgb_to_yuv(const void *src, void *dst, int length, unsigned long source,
+rgb_to_hsv(const void *src, void *dst, int length, unsigned long source,
            SDL_PixelFormat *format)
+{
+    camera_run_span(rgb_span_to_hsv, src, camera_source_bytes(source, format),
+                    dst, length, source, format);
+}
+
+/* convert packed rgb to yuv. Note that unlike many implementations of YUV,
+   this has a full range of 0-255 for Y, not 16-235. Formulas from wikipedia */
+static void
+rgb_span_to_yuv(const void *src, void *dst, int length, unsigned long source,
+                SDL_PixelFormat *format)
 {
     Uint8 *s8, *d8;
     Uint16 *s16, *d16;
@@ -802,6 +1666,16 @@ rgb_to_yuv(const void *src, void *dst, int length, unsigned long source,
 
     if (source == V4L2_PIX_FMT_RGB444 || source == V4L2_PIX_FMT_RGB24 ||
         source == V4L2_PIX_FMT_XBGR32) {
+#ifdef PG_CAMERA_SIMD
+        /* unpack xbgr32 into dst, then convert it there as stage 2 does */
+        if (source == V4L2_PIX_FMT_XBGR32 && CAMERA_SIMD_FORMAT(format)) {
+            int done = camera_bgr32_sse2(s8, d8, length, format);
+            camera_rgb_to_yuv_sse2(d8, d8, done, format);
+            s8 += done * 4;
+            d32 += done;
+            length -= done;
+        }
+#endif
         while (length--) {
             if (source == V4L2_PIX_FMT_RGB444) {
                 p1 = *s8++;
@@ -894,6 +1768,15 @@ rgb_to_yuv(const void *src, void *dst, int length, unsigned long source,
                 }
                 break;
             default:
+#ifdef PG_CAMERA_SIMD
+                if (CAMERA_SIMD_FORMAT(format)) {
+                    int done = camera_rgb_to_yuv_sse2(
+                        (const Uint8 *)src, (Uint8 *)dst, length, format);
+                    s32 += done;
+                    d32 += done;
+                    length -= done;
+                }
+#endif
                 while (length--) {
                     r = *s32 >> rshift << rloss;
                     g = *s32 >> gshift << gloss;
@@ -913,6 +1796,14 @@ rgb_to_yuv(const void *src, void *dst, int length, unsigned long source,
     }
 }
 
+void
+rgb_to_yuv(const void *src, void *dst, int length, unsigned long source,
+           SDL_PixelFormat *format)
+{
+    camera_run_span(rgb_span_to_yuv, src, camera_source_bytes(source, format),
+                    dst, length, source, format);
+}
+
 /* Converts from rgb444 (R444) to rgb24 (RGB3) */
 void
 rgb444_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
@@ -978,8 +1869,9 @@ rgb444_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
 /* convert from 4:2:2 YUYV interlaced to RGB */
 /* colorspace conversion routine from libv4l. Licensed LGPL 2.1
    (C) 2008 Hans de Goede <j.w.r.degoede@hhs.nl> */
-void
-yuyv_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
+static void
+yuyv_span_to_rgb(const void *src, void *dst, int length, unsigned long source,
+                 SDL_PixelFormat *format)
 {
     Uint8 *s, *d8;
     Uint16 *d16;
@@ -998,8 +1890,16 @@ yuyv_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
     d8 = (Uint8 *)dst;
     d16 = (Uint16 *)dst;
     d32 = (Uint32 *)dst;
-    i = length >> 1;
     s = (Uint8 *)src;
+#ifdef PG_CAMERA_SIMD
+    if (CAMERA_SIMD_FORMAT(format)) {
+        int done = camera_yuv422_sse2(s, (Uint8 *)dst, length, 0, format);
+        s += done * 2;
+        d32 += done;
+        length -= done;
+    }
+#endif
+    i = length >> 1;
 
     /* yuyv packs 2 pixels into every 4 bytes, sharing the u and v color
        terms between the 2, with each pixel having a unique y luminance term.
@@ -1056,6 +1956,12 @@ yuyv_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
     }
 }
 
+void
+yuyv_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
+{
+    camera_run_span(yuyv_span_to_rgb, src, 2, dst, length, 0, format);
+}
+
 /* turn yuyv into packed yuv. */
 void
 yuyv_to_yuv(const void *src, void *dst, int length, SDL_PixelFormat *format)
@@ -1131,8 +2037,9 @@ yuyv_to_yuv(const void *src, void *dst, int length, SDL_PixelFormat *format)
 }
 
 /* cribbed from above, but modified for uyvy ordering */
-void
-uyvy_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
+static void
+uyvy_span_to_rgb(const void *src, void *dst, int length, unsigned long source,
+                 SDL_PixelFormat *format)
 {
     Uint8 *s, *d8;
     Uint16 *d16;
@@ -1151,8 +2058,16 @@ uyvy_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
     d8 = (Uint8 *)dst;
     d16 = (Uint16 *)dst;
     d32 = (Uint32 *)dst;
-    i = length >> 1;
     s = (Uint8 *)src;
+#ifdef PG_CAMERA_SIMD
+    if (CAMERA_SIMD_FORMAT(format)) {
+        int done = camera_yuv422_sse2(s, (Uint8 *)dst, length, 1, format);
+        s += done * 2;
+        d32 += done;
+        length -= done;
+    }
+#endif
+    i = length >> 1;
 
     /* yuyv packs 2 pixels into every 4 bytes, sharing the u and v color
        terms between the 2, with each pixel having a unique y luminance term.
@@ -1209,6 +2124,13 @@ uyvy_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
         }
     }
 }
+
+void
+uyvy_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
+{
+    camera_run_span(uyvy_span_to_rgb, src, 2, dst, length, 0, format);
+}
+
 /* turn uyvy into packed yuv. */
 void
 uyvy_to_yuv(const void *src, void *dst, int length, SDL_PixelFormat *format)
@@ -1308,132 +2230,211 @@ uyvy_to_yuv(const void *src, void *dst, int length, SDL_PixelFormat *format)
  * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
  * SUCH DAMAGE.
  */
-/* TODO: Certainly not the most efficient way of doing this conversion. */
-void
-sbggr8_to_rgb(const void *src, void *dst, int width, int height,
-              SDL_PixelFormat *format)
+/* Demosaics the pixel at rawpt, with the edge cases of the original loop.
+ * i counts down from the last pixel of the frame, as that loop did. */
+static void
+sbggr8_pixel(const Uint8 *rawpt, int i, int width, int height, Uint8 *rp,
+             Uint8 *gp, Uint8 *bp)
 {
-    Uint8 *rawpt, *d8;
-    Uint16 *d16;
-    Uint32 *d32;
     Uint8 r, g, b;
-    int rshift, gshift, bshift, rloss, gloss, bloss;
-    int i = width * height;
-    rawpt = (Uint8 *)src;
-    rshift = format->Rshift;
-    gshift = format->Gshift;
-    bshift = format->Bshift;
-    rloss = format->Rloss;
-    gloss = format->Gloss;
-    bloss = format->Bloss;
 
-    d8 = (Uint8 *)dst;
-    d16 = (Uint16 *)dst;
-    d32 = (Uint32 *)dst;
+    if ((i / width) % 2 == 0) {
+        /* even row (BGBGBGBG)*/
+        if ((i % 2) == 0) {
+            /* B */
+            if ((i > width) && ((i % width) > 0)) {
+                b = *rawpt; /* B */
+                g = (*(rawpt - 1) + *(rawpt + 1) + *(rawpt + width) +
+                     *(rawpt - width)) /
+                    4; /* G */
+                r = (*(rawpt - width - 1) + *(rawpt - width + 1) +
+                     *(rawpt + width - 1) + *(rawpt + width + 1)) /
+                    4; /* R */
+            }
+            else {
+                /* first line or left column */
+                b = *rawpt;                                /* B */
+                g = (*(rawpt + 1) + *(rawpt + width)) / 2; /* G */
+                r = *(rawpt + width + 1);                  /* R */
+            }
+        }
+        else {
+            /* (B)G */
+            if ((i > width) && ((i % width) < (width - 1))) {
+                b = (*(rawpt - 1) + *(rawpt + 1)) / 2;         /* B */
+                g = *rawpt;                                    /* G */
+                r = (*(rawpt + width) + *(rawpt - width)) / 2; /* R */
+            }
+            else {
+                /* first line or right column */
+                b = *(rawpt - 1);     /* B */
+                g = *rawpt;           /* G */
+                r = *(rawpt + width); /* R */
+            }
+        }
+    }
+    else {
+        /* odd row (GRGRGRGR) */
+        if ((i % 2) == 0) {
+            /* G(R) */
+            if ((i < (width * (height - 1))) && ((i % width) > 0)) {
+                b = (*(rawpt + width) + *(rawpt - width)) / 2; /* B */
+                g = *rawpt;                                    /* G */
+                r = (*(rawpt - 1) + *(rawpt + 1)) / 2;         /* R */
+            }
+            else {
+                /* bottom line or left column */
+                b = *(rawpt - width); /* B */
+                g = *rawpt;           /* G */
+                r = *(rawpt + 1);     /* R */
+            }
+        }
+        else {
+            /* R */
+            if (i < (width * (height - 1)) &&
+                ((i % width) < (width - 1))) {
+                b = (*(rawpt - width - 1) + *(rawpt - width + 1) +
+                     *(rawpt + width - 1) + *(rawpt + width + 1)) /
+                    4; /* B */
+                g = (*(rawpt - 1) + *(rawpt + 1) + *(rawpt - width) +
+                     *(rawpt + width)) /
+                    4;      /* G */
+                r = *rawpt; /* R */
+            }
+            else {
+                /* bottom line or right column */
+                b = *(rawpt - width - 1);                  /* B */
+                g = (*(rawpt - 1) + *(rawpt - width)) / 2; /* G */
+                r = *rawpt;                                /* R */
+            }
+        }
+    }
+    *rp = r;
+    *gp = g;
+    *bp = b;
+}
 
-    while (i--) {
-        if ((i / width) % 2 == 0) {
-            /* even row (BGBGBGBG)*/
-            if ((i % 2) == 0) {
-                /* B */
-                if ((i > width) && ((i % width) > 0)) {
-                    b = *rawpt; /* B */
+static PG_INLINE void
+camera_put_pixel(Uint8 *d, Uint8 r, Uint8 g, Uint8 b, SDL_PixelFormat *format)
+{
+    switch (format->BytesPerPixel) {
+        case 1:
+            *d = ((r >> format->Rloss) << format->Rshift) |
+                 ((g >> format->Gloss) << format->Gshift) |
+                 ((b >> format->Bloss) << format->Bshift);
+            break;
+        case 2:
+            *(Uint16 *)d = ((r >> format->Rloss) << format->Rshift) |
+                           ((g >> format->Gloss) << format->Gshift) |
+                           ((b >> format->Bloss) << format->Bshift);
+            break;
+        case 3:
+            d[0] = b;
+            d[1] = g;
+            d[2] = r;
+            break;
+        default:
+            *(Uint32 *)d = ((r >> format->Rloss) << format->Rshift) |
+                           ((g >> format->Gloss) << format->Gshift) |
+                           ((b >> format->Bloss) << format->Bshift);
+            break;
+    }
+}
+
+/* Demosaics rows [start, end). The borders go through sbggr8_pixel(), and
+ * the rest of each row skips its divisions and edge tests. */
+static void
+sbggr8_rows_to_rgb(const void *src, void *dst, int width, int height,
+                   int start, int end, SDL_PixelFormat *format)
+{
+    const Uint8 *rawpt;
+    Uint8 *d;
+    Uint8 r, g, b;
+    int bpp = format->BytesPerPixel;
+    int row, col, i, bgrow;
+
+    for (row = start; row < end; row++) {
+        rawpt = (const Uint8 *)src + (size_t)row * width;
+        d = (Uint8 *)dst + (size_t)row * width * bpp;
+        i = (height - row) * width - 1;
+
+        if (row == 0 || row >= height - 1 || width < 3) {
+            for (col = 0; col < width; col++, rawpt++, d += bpp, i--) {
+                sbggr8_pixel(rawpt, i, width, height, &r, &g, &b);
+                camera_put_pixel(d, r, g, b, format);
+            }
+            continue;
+        }
+
+        sbggr8_pixel(rawpt, i, width, height, &r, &g, &b);
+        camera_put_pixel(d, r, g, b, format);
+        rawpt++;
+        d += bpp;
+        i--;
+
+        bgrow = (height - 1 - row) % 2 == 0;
+        for (col = 1; col < width - 1; col++, rawpt++, d += bpp, i--) {
+            if (bgrow) {
+                if ((i % 2) == 0) {
+                    /* B */
+                    b = *rawpt;
                     g = (*(rawpt - 1) + *(rawpt + 1) + *(rawpt + width) +
                          *(rawpt - width)) /
-                        4; /* G */
+                        4;
                     r = (*(rawpt - width - 1) + *(rawpt - width + 1) +
                          *(rawpt + width - 1) + *(rawpt + width + 1)) /
-                        4; /* R */
+                        4;
                 }
                 else {
-                    /* first line or left column */
-                    b = *rawpt;                                /* B */
-                    g = (*(rawpt + 1) + *(rawpt + width)) / 2; /* G */
-                    r = *(rawpt + width + 1);                  /* R */
+                    /* (B)G */
+                    b = (*(rawpt - 1) + *(rawpt + 1)) / 2;
+                    g = *rawpt;
+                    r = (*(rawpt + width) + *(rawpt - width)) / 2;
                 }
             }
             else {
-                /* (B)G */
-                if ((i > width) && ((i % width) < (width - 1))) {
-                    b = (*(rawpt - 1) + *(rawpt + 1)) / 2;         /* B */
-                    g = *rawpt;                                    /* G */
-                    r = (*(rawpt + width) + *(rawpt - width)) / 2; /* R */
-                }
-                else {
-                    /* first line or right column */
-                    b = *(rawpt - 1);     /* B */
-                    g = *rawpt;           /* G */
-                    r = *(rawpt + width); /* R */
-                }
-            }
-        }
-        else {
-            /* odd row (GRGRGRGR) */
-            if ((i % 2) == 0) {
-                /* G(R) */
-                if ((i < (width * (height - 1))) && ((i % width) > 0)) {
-                    b = (*(rawpt + width) + *(rawpt - width)) / 2; /* B */
-                    g = *rawpt;                                    /* G */
-                    r = (*(rawpt - 1) + *(rawpt + 1)) / 2;         /* R */
+                if ((i % 2) == 0) {
+                    /* G(R) */
+                    b = (*(rawpt + width) + *(rawpt - width)) / 2;
+                    g = *rawpt;
+                    r = (*(rawpt - 1) + *(rawpt + 1)) / 2;
                 }
                 else {
-                    /* bottom line or left column */
-                    b = *(rawpt - width); /* B */
-                    g = *rawpt;           /* G */
-                    r = *(rawpt + 1);     /* R */
-                }
-            }
-            else {
-                /* R */
-                if (i < (width * (height - 1)) &&
-                    ((i % width) < (width - 1))) {
+                    /* R */
                     b = (*(rawpt - width - 1) + *(rawpt - width + 1) +
                          *(rawpt + width - 1) + *(rawpt + width + 1)) /
-                        4; /* B */
+                        4;
                     g = (*(rawpt - 1) + *(rawpt + 1) + *(rawpt - width) +
                          *(rawpt + width)) /
-                        4;      /* G */
-                    r = *rawpt; /* R */
-                }
-                else {
-                    /* bottom line or right column */
-                    b = *(rawpt - width - 1);                  /* B */
-                    g = (*(rawpt - 1) + *(rawpt - width)) / 2; /* G */
-                    r = *rawpt;                                /* R */
+                        4;
+                    r = *rawpt;
                 }
             }
+            camera_put_pixel(d, r, g, b, format);
         }
-        rawpt++;
-        switch (format->BytesPerPixel) {
-            case 1:
-                *d8++ = ((r >> rloss) << rshift) | ((g >> gloss) << gshift) |
-                        ((b >> bloss) << bshift);
-                break;
-            case 2:
-                *d16++ = ((r >> rloss) << rshift) | ((g >> gloss) << gshift) |
-                         ((b >> bloss) << bshift);
-                break;
-            case 3:
-                *d8++ = b;
-                *d8++ = g;
-                *d8++ = r;
-                break;
-            default:
-                *d32++ = ((r >> rloss) << rshift) | ((g >> gloss) << gshift) |
-                         ((b >> bloss) << bshift);
-                break;
-        }
+
+        sbggr8_pixel(rawpt, i, width, height, &r, &g, &b);
+        camera_put_pixel(d, r, g, b, format);
     }
 }
 
+void
+sbggr8_to_rgb(const void *src, void *dst, int width, int height,
+              SDL_PixelFormat *format)
+{
+    camera_run_rows(sbggr8_rows_to_rgb, src, dst, width, height, height,
+                    format);
+}
+
 /* convert from YUV 4:2:0 (YU12) to RGB24 */
 /* based on v4lconvert_yuv420_to_rgb24 in libv4l (C) 2008 Hans de Goede. LGPL
  */
-void
-yuv420_to_rgb(const void *src, void *dst, int width, int height,
-              SDL_PixelFormat *format)
+static void
+yuv420_rows_to_rgb(const void *src, void *dst, int width, int height,
+                   int start, int end, SDL_PixelFormat *format)
 {
     int rshift, gshift, bshift, rloss, gloss, bloss, i, j, u1, v1, rg, y;
+    int bpp = format->BytesPerPixel;
     const Uint8 *y1, *y2, *u, *v;
     Uint8 *d8_1, *d8_2;
     Uint16 *d16_1, *d16_2;
@@ -1447,18 +2448,20 @@ yuv420_to_rgb(const void *src, void *dst, int width, int height,
     bloss = format->Bloss;
 
     /* see http://en.wikipedia.org/wiki/YUV for an explanation of YUV420 */
+    /* start and end count pairs of rows, which share their u and v */
     y1 = (Uint8 *)src;
+    u = y1 + width * height + start * (width / 2);
+    v = y1 + width * height + (width * height) / 4 + start * (width / 2);
+    y1 += (size_t)start * 2 * width;
     y2 = y1 + width;
-    u = y1 + width * height;
-    v = u + (width * height) / 4;
-    j = height / 2;
+    j = end - start;
     /* prepare the destination pointers for different surface depths. */
-    d8_1 = (Uint8 *)dst;
+    d8_1 = (Uint8 *)dst + (size_t)start * 2 * width * bpp;
     /* the following is because d8 used for both 8 and 24 bit surfaces */
-    d8_2 = d8_1 + (format->BytesPerPixel == 3 ? width * 3 : 3);
-    d16_1 = (Uint16 *)dst;
+    d8_2 = d8_1 + width * bpp;
+    d16_1 = (Uint16 *)d8_1;
     d16_2 = d16_1 + width;
-    d32_1 = (Uint32 *)dst;
+    d32_1 = (Uint32 *)d8_1;
     d32_2 = d32_1 + width;
 
     /* for the sake of speed, the nested while loops are inside of the switch
@@ -1588,6 +2591,20 @@ yuv420_to_rgb(const void *src, void *dst, int width, int height,
         default:
             while (j--) {
                 i = width / 2;
+#ifdef PG_CAMERA_SIMD
+                if (CAMERA_SIMD_FORMAT(format)) {
+                    int done = camera_yuv420_sse2(
+                        y1, y2, u, v, (Uint8 *)d32_1, (Uint8 *)d32_2,
+                        i * 2, format);
+                    y1 += done;
+                    y2 += done;
+                    u += done / 2;
+                    v += done / 2;
+                    d32_1 += done;
+                    d32_2 += done;
+                    i -= done / 2;
+                }
+#endif
                 while (i--) {
                     /* These formulas are from libv4l */
                     u1 = (((*u - 128) << 7) + (*u - 128)) >> 6;
@@ -1628,6 +2645,14 @@ yuv420_to_rgb(const void *src, void *dst, int width, int height,
     }
 }
 
+void
+yuv420_to_rgb(const void *src, void *dst, int width, int height,
+              SDL_PixelFormat *format)
+{
+    camera_run_rows(yuv420_rows_to_rgb, src, dst, width, height, height / 2,
+                    format);
+}
+
 /* turn yuv420 into packed yuv. */
 void
 yuv420_to_yuv(const void *src, void *dst, int width, int height,
@@ -1772,6 +2797,22 @@ PyMethodDef cameraobj_builtins[] = {
     {"get_image", (PyCFunction)camera_get_image, METH_VARARGS,
      DOC_CAMERAGETIMAGE},
     {"get_raw", (PyCFunction)camera_get_raw, METH_NOARGS, DOC_CAMERAGETRAW},
+    {"get_raw_view", (PyCFunction)camera_get_raw_view, METH_NOARGS,
+     DOC_CAMERAGETRAWVIEW},
+    {"release_raw_view", (PyCFunction)camera_release_raw_view, METH_NOARGS,
+     DOC_CAMERARELEASERAWVIEW},
+    {"export_dmabuf", (PyCFunction)camera_export_dmabuf, METH_NOARGS,
+     DOC_CAMERAEXPORTDMABUF},
+    {"start_capture", (PyCFunction)camera_start_capture,
+     METH_VARARGS | METH_KEYWORDS, DOC_CAMERASTARTCAPTURE},
+    {"stop_capture", (PyCFunction)camera_stop_capture, METH_NOARGS,
+     DOC_CAMERASTOPCAPTURE},
+    {"get_latest", (PyCFunction)camera_get_latest,
+     METH_VARARGS | METH_KEYWORDS, DOC_CAMERAGETLATEST},
+    {"get_next", (PyCFunction)camera_get_next, METH_VARARGS | METH_KEYWORDS,
+     DOC_CAMERAGETNEXT},
+    {"get_capture_stats", (PyCFunction)camera_get_capture_stats, METH_NOARGS,
+     DOC_CAMERAGETCAPTURESTATS},
     {NULL, NULL, 0, NULL}};
 
 void
@@ -1783,6 +2824,9 @@ camera_dealloc(PyObject *self)
     }
     windows_dealloc_device((pgCameraObject *)self);
 #else
+#if defined(__unix__)
+    camera_end_capture((pgCameraObject *)self);
+#endif
     free(((pgCameraObject *)self)->device_name);
 #endif
     PyObject_Free(self);
@@ -1839,6 +2883,19 @@ camera_init(pgCameraObject *self, PyObject *arg, PyObject *kwargs)
     self->vflip = 0;
     self->brightness = 0;
     self->fd = -1;
+    self->held = -1;
+    self->held_bytes = 0;
+    self->n_views = 0;
+    self->capture = NULL;
+    self->capture_lock = NULL;
+    self->capture_cond = NULL;
+    self->frames = NULL;
+    self->frame_seq = NULL;
+    self->n_frames = 0;
+    self->reading = -1;
+    self->capture_waiters = 0;
+    self->jpeg = NULL;
+    self->jpeg_rgb = NULL;
 
     return 0;
 #elif defined(PYGAME_WINDOWS_CAMERA)
@@ -1889,9 +2946,19 @@ camera_init(pgCameraObject *self, PyObject *arg, PyObject *kwargs)
     self->vflip = 0;
     self->last_vflip = 0;
 
+    self->last_hflip = -1;
+
+    self->callback = NULL;
+    for (int i = 0; i < WINDOWS_CAMERA_POOL; i++) {
+        self->pool[i] = NULL;
+        self->pool_bufs[i] = NULL;
+    }
     self->raw_buf = NULL;
-    self->buf = NULL;
-    self->t_handle = NULL;
+    InitializeSRWLock(&self->lock);
+    self->ready_slot = -1;
+    self->read_slot = -1;
+    self->buffer_ready = 0;
+    self->stopped = NULL;
 
     if (!windows_init_device(NULL)) {
         return -1;
@@ -1910,6 +2977,9 @@ PyTypeObject pgCamera_Type = {
     .tp_basicsize = sizeof(pgCameraObject),
     .tp_dealloc = camera_dealloc,
     .tp_doc = DOC_PYGAMECAMERACAMERA,
+#if defined(__unix__)
+    .tp_as_buffer = &camera_as_buffer,
+#endif
     .tp_methods = cameraobj_builtins,
     .tp_init = (initproc)camera_init,
     .tp_new = PyType_GenericNew,
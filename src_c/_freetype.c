@@ -27,6 +27,8 @@
 
 #include "doc/freetype_doc.h"
 
+#include "pgrendercache.h"
+
 #define MODULE_NAME "_freetype"
 #define FONT_TYPE_NAME "Font"
 
@@ -98,6 +100,12 @@ static PyObject *
 _ftfont_getsizedglyphheight(pgFontObject *, PyObject *);
 static PyObject *
 _ftfont_getsizes(pgFontObject *, PyObject *);
+static PyObject *
+_ftfont_getcachestats(pgFontObject *, PyObject *);
+static PyObject *
+_ftfont_sharecache(pgFontObject *, PyObject *);
+static PyObject *
+_ftfont_getrendercachestats(pgFontObject *, PyObject *);
 
 /* static PyObject *_ftfont_copy(pgFontObject *); */
 
@@ -146,6 +154,15 @@ _ftfont_setbgcolor(pgFontObject *, PyObject *, void *);
 static PyObject *
 _ftfont_getresolution(pgFontObject *, void *);
 
+static PyObject *
+_ftfont_getcachelimit(pgFontObject *, void *);
+static int
+_ftfont_setcachelimit(pgFontObject *, PyObject *, void *);
+static PyObject *
+_ftfont_getrendercachelimit(pgFontObject *, void *);
+static int
+_ftfont_setrendercachelimit(pgFontObject *, PyObject *, void *);
+
 static PyObject *
 _ftfont_getfontmetric(pgFontObject *, void *);
 
@@ -524,6 +541,12 @@ static PyMethodDef _ftfont_methods[] = {
      METH_VARARGS | METH_KEYWORDS, DOC_FONTGETMETRICS},
     {"get_sizes", (PyCFunction)_ftfont_getsizes, METH_NOARGS,
      DOC_FONTGETSIZES},
+    {"get_cache_stats", (PyCFunction)_ftfont_getcachestats, METH_NOARGS,
+     DOC_FONTGETCACHESTATS},
+    {"share_cache", (PyCFunction)_ftfont_sharecache, METH_O,
+     DOC_FONTSHARECACHE},
+    {"get_render_cache_stats", (PyCFunction)_ftfont_getrendercachestats,
+     METH_NOARGS, DOC_FONTGETRENDERCACHESTATS},
     {"render", (PyCFunction)_ftfont_render, METH_VARARGS | METH_KEYWORDS,
      DOC_FONTRENDER},
     {"render_to", (PyCFunction)_ftfont_render_to, METH_VARARGS | METH_KEYWORDS,
@@ -590,6 +613,10 @@ static PyGetSetDef _ftfont_getsets[] = {
      DOC_FONTBGCOLOR, 0},
     {"origin", (getter)_ftfont_getrender_flag, (setter)_ftfont_setrender_flag,
      DOC_FONTORIGIN, (void *)FT_RFLAG_ORIGIN},
+    {"cache_limit", (getter)_ftfont_getcachelimit,
+     (setter)_ftfont_setcachelimit, DOC_FONTCACHELIMIT, 0},
+    {"render_cache_limit", (getter)_ftfont_getrendercachelimit,
+     (setter)_ftfont_setrendercachelimit, DOC_FONTRENDERCACHELIMIT, 0},
 #if defined(PGFT_DEBUG_CACHE)
     {"_debug_cache_stats", (getter)_ftfont_getdebugcachestats, 0,
      "_debug cache fields as a tuple", 0},
@@ -652,6 +679,7 @@ _ftfont_new(PyTypeObject *subtype, PyObject *args, PyObject *kwds)
         obj->bgcolor[1] = 0;
         obj->bgcolor[2] = 0;
         obj->bgcolor[3] = 0;
+        obj->render_cache = 0;
     }
     return (PyObject *)obj;
 }
@@ -660,11 +688,20 @@ static void
 _ftfont_dealloc(pgFontObject *self)
 {
     SDL_RWops *src = _PGFT_GetRWops(self);
-    _PGFT_UnloadFont(self->freetype, self);
+
+    if (self->freetype) {
+        _PGFT_Lock(self->freetype);
+        _PGFT_UnloadFont(self->freetype, self);
+        _PGFT_Unlock(self->freetype);
+    }
+    else {
+        _PGFT_UnloadFont(0, self);
+    }
     if (src) {
         pgRWops_ReleaseObject(src);
     }
     _PGFT_Quit(self->freetype);
+    pgRenderCache_SetLimit(&self->render_cache, 0);
 
     Py_XDECREF(self->path);
     ((PyObject *)self)->ob_type->tp_free((PyObject *)self);
@@ -687,6 +724,7 @@ _ftfont_init(pgFontObject *self, PyObject *args, PyObject *kwds)
     double x_ppem = 0;
     double y_ppem = 0;
     int rval = -1;
+    int rc;
     SDL_RWops *source;
 
     FreeTypeInstance *ft;
@@ -702,10 +740,14 @@ _ftfont_init(pgFontObject *self, PyObject *args, PyObject *kwds)
 
     if (self->freetype) {
         /* Font.__init__ was previously called on this object. Reset */
+        _PGFT_Lock(self->freetype);
         _PGFT_UnloadFont(self->freetype, self);
+        _PGFT_Unlock(self->freetype);
         _PGFT_Quit(self->freetype);
         self->freetype = 0;
     }
+    /* the results kept were rendered with the face replaced */
+    pgRenderCache_SetLimit(&self->render_cache, 0);
     Py_XDECREF(self->path);
     self->path = 0;
     self->is_scalable = 0;
@@ -752,8 +794,11 @@ _ftfont_init(pgFontObject *self, PyObject *args, PyObject *kwds)
             goto end;
         }
 
-        if (_PGFT_TryLoadFont_Filename(ft, self, PyBytes_AS_STRING(file),
-                                       font_index)) {
+        _PGFT_Lock(ft);
+        rc = _PGFT_TryLoadFont_Filename(ft, self, PyBytes_AS_STRING(file),
+                                        font_index);
+        _PGFT_Unlock(ft);
+        if (rc) {
             goto end;
         }
     }
@@ -797,7 +842,10 @@ _ftfont_init(pgFontObject *self, PyObject *args, PyObject *kwds)
             goto end;
         }
 
-        if (_PGFT_TryLoadFont_RWops(ft, self, source, font_index)) {
+        _PGFT_Lock(ft);
+        rc = _PGFT_TryLoadFont_RWops(ft, self, source, font_index);
+        _PGFT_Unlock(ft);
+        if (rc) {
             goto end;
         }
     }
@@ -853,14 +901,20 @@ _ftfont_init(pgFontObject *self, PyObject *args, PyObject *kwds)
         goto end;
     }
 
-    if (_PGFT_TryLoadFont_RWops(ft, self, source, font_index)) {
+    _PGFT_Lock(ft);
+    rc = _PGFT_TryLoadFont_RWops(ft, self, source, font_index);
+    _PGFT_Unlock(ft);
+    if (rc) {
         goto end;
     }
 #endif /* WIN32 */
 
     if (!self->is_scalable && self->face_size.x == 0) {
-        if (_PGFT_Font_GetAvailableSize(ft, self, 0, &size, &height, &width,
-                                        &x_ppem, &y_ppem)) {
+        _PGFT_Lock(ft);
+        rc = _PGFT_Font_GetAvailableSize(ft, self, 0, &size, &height, &width,
+                                         &x_ppem, &y_ppem);
+        _PGFT_Unlock(ft);
+        if (rc) {
             self->face_size.x = DBL_TO_FX6(x_ppem);
             self->face_size.y = DBL_TO_FX6(y_ppem);
         }
@@ -1081,7 +1135,9 @@ _ftfont_getfontmetric(pgFontObject *self, void *closure)
     long height;
 
     ASSERT_SELF_IS_ALIVE(self);
+    _PGFT_Lock(self->freetype);
     height = ((getter)closure)(self->freetype, self);
+    _PGFT_Unlock(self->freetype);
     if (!height && PyErr_Occurred()) {
         return 0;
     }
@@ -1092,8 +1148,15 @@ static PyObject *
 _ftfont_getname(pgFontObject *self, void *closure)
 {
     if (pgFont_IS_ALIVE(self)) {
-        const char *name = _PGFT_Font_GetName(self->freetype, self);
-        return name ? PyUnicode_FromString(name) : 0;
+        const char *name;
+        PyObject *result;
+
+        /* the name belongs to the face, which another thread may drop */
+        _PGFT_Lock(self->freetype);
+        name = _PGFT_Font_GetName(self->freetype, self);
+        result = name ? PyUnicode_FromString(name) : 0;
+        _PGFT_Unlock(self->freetype);
+        return result;
     }
     return PyObject_Repr((PyObject *)self);
 }
@@ -1124,8 +1187,10 @@ _ftfont_getfixedwidth(pgFontObject *self, void *closure)
     long fixed_width;
 
     ASSERT_SELF_IS_ALIVE(self);
+    _PGFT_Lock(self->freetype);
     fixed_width =
         _PGFT_Font_IsFixedWidth(self->freetype, (pgFontObject *)self);
+    _PGFT_Unlock(self->freetype);
     return fixed_width >= 0 ? PyBool_FromLong(fixed_width) : 0;
 }
 
@@ -1135,7 +1200,9 @@ _ftfont_getfixedsizes(pgFontObject *self, void *closure)
     long num_fixed_sizes;
 
     ASSERT_SELF_IS_ALIVE(self);
+    _PGFT_Lock(self->freetype);
     num_fixed_sizes = _PGFT_Font_NumFixedSizes(self->freetype, self);
+    _PGFT_Unlock(self->freetype);
     return num_fixed_sizes >= 0 ? PyLong_FromLong(num_fixed_sizes) : 0;
 }
 
@@ -1248,6 +1315,83 @@ _ftfont_setbgcolor(pgFontObject *self, PyObject *value, void *closure)
     return 0;
 }
 
+static PyObject *
+_ftfont_getcachelimit(pgFontObject *self, void *closure)
+{
+    ASSERT_SELF_IS_ALIVE(self);
+
+    return PyLong_FromSize_t(PGFT_FONT_CACHE(self).max_bytes);
+}
+
+static int
+_ftfont_setcachelimit(pgFontObject *self, PyObject *value, void *closure)
+{
+    size_t max_bytes;
+
+    DEL_ATTR_NOT_SUPPORTED_CHECK("cache_limit", value);
+
+    if (!pgFont_IS_ALIVE(self)) {
+        PyErr_SetString(PyExc_RuntimeError, MODULE_NAME "." FONT_TYPE_NAME
+                        " instance is not initialized");
+        return -1;
+    }
+    if (!PyLong_Check(value)) {
+        PyErr_Format(PyExc_TypeError,
+                     "cache_limit must be an int, not %.200s",
+                     Py_TYPE(value)->tp_name);
+        return -1;
+    }
+    max_bytes = PyLong_AsSize_t(value);
+    if (max_bytes == (size_t)-1 && PyErr_Occurred()) {
+        if (PyErr_ExceptionMatches(PyExc_OverflowError)) {
+            PyErr_Clear();
+            PyErr_SetString(PyExc_ValueError,
+                            "cache_limit must be a byte count >= 0");
+        }
+        return -1;
+    }
+    /* Evict right away, so the font gives the memory back now rather than
+     * on the next render. */
+    _PGFT_Lock(self->freetype);
+    PGFT_FONT_CACHE(self).max_bytes = max_bytes;
+    _PGFT_Cache_Cleanup(&PGFT_FONT_CACHE(self));
+    _PGFT_Unlock(self->freetype);
+    return 0;
+}
+
+static PyObject *
+_ftfont_getrendercachelimit(pgFontObject *self, void *closure)
+{
+    return PyLong_FromSize_t(self->render_cache ? self->render_cache->max_bytes
+                                                : 0);
+}
+
+static int
+_ftfont_setrendercachelimit(pgFontObject *self, PyObject *value,
+                            void *closure)
+{
+    size_t max_bytes;
+
+    DEL_ATTR_NOT_SUPPORTED_CHECK("render_cache_limit", value);
+
+    if (!PyLong_Check(value)) {
+        PyErr_Format(PyExc_TypeError,
+                     "render_cache_limit must be an int, not %.200s",
+                     Py_TYPE(value)->tp_name);
+        return -1;
+    }
+    max_bytes = PyLong_AsSize_t(value);
+    if (max_bytes == (size_t)-1 && PyErr_Occurred()) {
+        if (PyErr_ExceptionMatches(PyExc_OverflowError)) {
+            PyErr_Clear();
+            PyErr_SetString(PyExc_ValueError,
+                            "render_cache_limit must be a byte count >= 0");
+        }
+        return -1;
+    }
+    return pgRenderCache_SetLimit(&self->render_cache, max_bytes);
+}
+
 /** testing and debugging */
 #if defined(PGFT_DEBUG_CACHE)
 static PyObject *
@@ -1278,20 +1422,25 @@ _ftfont_getrect(pgFontObject *self, PyObject *args, PyObject *kwds)
     /* MODIFIED
      */
     /* keyword list */
-    static char *kwlist[] = {"text", "style", "rotation", "size", 0};
+    static char *kwlist[] = {"text", "style",      "rotation",
+                             "size", "wraplength", "align",    0};
 
     PyObject *textobj;
     PGFT_String *text = 0;
     Scale_t face_size = FACE_SIZE_NONE;
     SDL_Rect r;
+    int rc;
 
     FontRenderMode render;
     Angle_t rotation = self->rotation;
     int style = FT_STYLE_DEFAULT;
+    int wraplength = 0;
+    int align = FT_ALIGN_LEFT;
 
-    if (!PyArg_ParseTupleAndKeywords(
-            args, kwds, "O|iO&O&", kwlist, &textobj, &style, obj_to_rotation,
-            (void *)&rotation, obj_to_scale, (void *)&face_size))
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|iO&O&ii", kwlist,
+                                     &textobj, &style, obj_to_rotation,
+                                     (void *)&rotation, obj_to_scale,
+                                     (void *)&face_size, &wraplength, &align))
         goto error;
 
     /* Encode text */
@@ -1305,11 +1454,13 @@ _ftfont_getrect(pgFontObject *self, PyObject *args, PyObject *kwds)
     ASSERT_SELF_IS_ALIVE(self);
 
     /* Build rendering mode, always anti-aliased by default */
-    if (_PGFT_BuildRenderMode(self->freetype, self, &render, face_size, style,
-                              rotation))
-        goto error;
-
-    if (_PGFT_GetTextRect(self->freetype, self, &render, text, &r))
+    _PGFT_Lock(self->freetype);
+    rc = _PGFT_BuildRenderMode(self->freetype, self, &render, face_size,
+                               style, rotation) ||
+         _PGFT_SetRenderWrap(&render, wraplength, align) ||
+         _PGFT_GetTextRect(self->freetype, self, &render, text, &r);
+    _PGFT_Unlock(self->freetype);
+    if (rc)
         goto error;
     free_string(text);
 
@@ -1398,12 +1549,13 @@ _ftfont_getmetrics(pgFontObject *self, PyObject *args, PyObject *kwds)
      * Build the render mode with the given size and support
      * for rotation/styles/size changes in text
      */
-    if (_PGFT_BuildRenderMode(self->freetype, self, &render, face_size,
-                              FT_STYLE_DEFAULT, self->rotation))
-        goto error;
-
-    /* get metrics */
-    list = get_metrics(&render, self, text);
+    _PGFT_Lock(self->freetype);
+    if (!_PGFT_BuildRenderMode(self->freetype, self, &render, face_size,
+                               FT_STYLE_DEFAULT, self->rotation)) {
+        /* get metrics */
+        list = get_metrics(&render, self, text);
+    }
+    _PGFT_Unlock(self->freetype);
     if (!list)
         goto error;
     free_string(text);
@@ -1436,7 +1588,9 @@ _ftfont_getsizedascender(pgFontObject *self, PyObject *args)
 
         face_size = self->face_size;
     }
+    _PGFT_Lock(self->freetype);
     value = (long)_PGFT_Font_GetAscenderSized(self->freetype, self, face_size);
+    _PGFT_Unlock(self->freetype);
     if (!value && PyErr_Occurred()) {
         return 0;
     }
@@ -1463,8 +1617,10 @@ _ftfont_getsizeddescender(pgFontObject *self, PyObject *args)
 
         face_size = self->face_size;
     }
+    _PGFT_Lock(self->freetype);
     value =
         (long)_PGFT_Font_GetDescenderSized(self->freetype, self, face_size);
+    _PGFT_Unlock(self->freetype);
     if (!value && PyErr_Occurred()) {
         return 0;
     }
@@ -1491,7 +1647,9 @@ _ftfont_getsizedheight(pgFontObject *self, PyObject *args)
 
         face_size = self->face_size;
     }
+    _PGFT_Lock(self->freetype);
     value = _PGFT_Font_GetHeightSized(self->freetype, self, face_size);
+    _PGFT_Unlock(self->freetype);
     if (!value && PyErr_Occurred()) {
         return 0;
     }
@@ -1518,8 +1676,10 @@ _ftfont_getsizedglyphheight(pgFontObject *self, PyObject *args)
 
         face_size = self->face_size;
     }
+    _PGFT_Lock(self->freetype);
     value =
         (long)_PGFT_Font_GetGlyphHeightSized(self->freetype, self, face_size);
+    _PGFT_Unlock(self->freetype);
     if (!value && PyErr_Occurred()) {
         return 0;
     }
@@ -1538,6 +1698,7 @@ _ftfont_getsizes(pgFontObject *self, PyObject *_null)
     PyObject *size_list = 0;
     PyObject *size_item;
 
+    _PGFT_Lock(self->freetype);
     nsizes = _PGFT_Font_NumFixedSizes(self->freetype, self);
     if (nsizes < 0)
         goto error;
@@ -1556,13 +1717,78 @@ _ftfont_getsizes(pgFontObject *self, PyObject *_null)
             goto error;
         PyList_SET_ITEM(size_list, i, size_item);
     }
+    _PGFT_Unlock(self->freetype);
     return size_list;
 
 error:
+    _PGFT_Unlock(self->freetype);
     Py_XDECREF(size_list);
     return 0;
 }
 
+static PyObject *
+_ftfont_getcachestats(pgFontObject *self, PyObject *_null)
+{
+    const FontCache *cache;
+    PyObject *stats;
+
+    ASSERT_SELF_IS_ALIVE(self);
+
+    _PGFT_Lock(self->freetype);
+    cache = &PGFT_FONT_CACHE(self);
+    stats = Py_BuildValue("{snsnsnsnsn}", "hits", (Py_ssize_t)cache->hits,
+                          "misses", (Py_ssize_t)cache->misses, "evictions",
+                          (Py_ssize_t)cache->evictions, "glyphs",
+                          (Py_ssize_t)cache->count, "bytes",
+                          (Py_ssize_t)cache->bytes);
+    _PGFT_Unlock(self->freetype);
+    return stats;
+}
+
+static PyObject *
+_ftfont_sharecache(pgFontObject *self, PyObject *other)
+{
+    pgFontObject *source;
+    int same_path;
+
+    ASSERT_SELF_IS_ALIVE(self);
+
+    if (!PyObject_IsInstance(other, (PyObject *)&pgFont_Type)) {
+        return RAISE(PyExc_TypeError, "share_cache expects a Font");
+    }
+    source = (pgFontObject *)other;
+    if (!pgFont_IS_ALIVE(source)) {
+        return RAISE(PyExc_RuntimeError, MODULE_NAME "." FONT_TYPE_NAME
+                     " instance is not initialized");
+    }
+    if (source == self) {
+        Py_RETURN_NONE;
+    }
+
+    /* Cached glyphs are only valid for the face they were rendered from,
+     * at the resolution they were rendered at. */
+    same_path = PyObject_RichCompareBool(self->path, source->path, Py_EQ);
+    if (same_path < 0) {
+        return 0;
+    }
+    if (!same_path || self->id.font_index != source->id.font_index ||
+        self->resolution != source->resolution) {
+        return RAISE(PyExc_ValueError,
+                     "can only share a glyph cache between fonts of the same"
+                     " face, index and resolution");
+    }
+    _PGFT_Lock(self->freetype);
+    _PGFT_LayoutShareCache(self, source);
+    _PGFT_Unlock(self->freetype);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+_ftfont_getrendercachestats(pgFontObject *self, PyObject *_null)
+{
+    return pgRenderCache_Stats(self->render_cache);
+}
+
 static PyObject *
 _ftfont_render_raw(pgFontObject *self, PyObject *args, PyObject *kwds)
 {
@@ -1603,12 +1829,13 @@ _ftfont_render_raw(pgFontObject *self, PyObject *args, PyObject *kwds)
      * Build the render mode with the given size and no
      * rotation/styles/vertical text
      */
-    if (_PGFT_BuildRenderMode(self->freetype, self, &mode, face_size, style,
-                              rotation))
-        goto error;
-
-    rbuffer = _PGFT_Render_PixelArray(self->freetype, self, &mode, text,
-                                      invert, &width, &height);
+    _PGFT_Lock(self->freetype);
+    if (!_PGFT_BuildRenderMode(self->freetype, self, &mode, face_size, style,
+                               rotation)) {
+        rbuffer = _PGFT_Render_PixelArray(self->freetype, self, &mode, text,
+                                          invert, &width, &height);
+    }
+    _PGFT_Unlock(self->freetype);
     if (!rbuffer)
         goto error;
     free_string(text);
@@ -1649,6 +1876,7 @@ _ftfont_render_raw_to(pgFontObject *self, PyObject *args, PyObject *kwds)
 
     /* output arguments */
     SDL_Rect r;
+    int rc;
 
     ASSERT_SELF_IS_ALIVE(self);
 
@@ -1675,12 +1903,13 @@ _ftfont_render_raw_to(pgFontObject *self, PyObject *args, PyObject *kwds)
      * Build the render mode with the given size and no
      * rotation/styles/vertical text
      */
-    if (_PGFT_BuildRenderMode(self->freetype, self, &mode, face_size, style,
-                              rotation))
-        goto error;
-
-    if (_PGFT_Render_Array(self->freetype, self, &mode, arrayobj, text, invert,
-                           xpos, ypos, &r))
+    _PGFT_Lock(self->freetype);
+    rc = _PGFT_BuildRenderMode(self->freetype, self, &mode, face_size, style,
+                               rotation) ||
+         _PGFT_Render_Array(self->freetype, self, &mode, arrayobj, text,
+                            invert, xpos, ypos, &r);
+    _PGFT_Unlock(self->freetype);
+    if (rc)
         goto error;
     free_string(text);
 
@@ -1695,8 +1924,9 @@ static PyObject *
 _ftfont_render(pgFontObject *self, PyObject *args, PyObject *kwds)
 {
     /* keyword list */
-    static char *kwlist[] = {"text",     "fgcolor", "bgcolor", "style",
-                             "rotation", "size",    0};
+    static char *kwlist[] = {"text",       "fgcolor", "bgcolor", "style",
+                             "rotation",   "size",    "pool",    "wraplength",
+                             "align",      0};
 
     /* input arguments */
     PyObject *textobj = 0;
@@ -1706,6 +1936,9 @@ _ftfont_render(pgFontObject *self, PyObject *args, PyObject *kwds)
     PyObject *bg_color_obj = 0;
     Angle_t rotation = self->rotation;
     int style = FT_STYLE_DEFAULT;
+    PyObject *pool = 0;
+    int wraplength = 0;
+    int align = FT_ALIGN_LEFT;
 
     /* output arguments */
     SDL_Surface *surface = 0;
@@ -1713,6 +1946,10 @@ _ftfont_render(pgFontObject *self, PyObject *args, PyObject *kwds)
     PyObject *rtuple = 0;
     SDL_Rect r;
     PyObject *rect_obj = 0;
+    PyObject *cache_key = 0;
+    PyObject *cached;
+    int rc;
+    Uint64 start;
 
     FontColor fg_color;
     FontColor bg_color;
@@ -1720,13 +1957,15 @@ _ftfont_render(pgFontObject *self, PyObject *args, PyObject *kwds)
 
     ASSERT_SELF_IS_ALIVE(self);
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOiO&O&", kwlist,
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOiO&O&O!ii", kwlist,
                                      /* required */
                                      &textobj,
                                      /* optional */
                                      &fg_color_obj, &bg_color_obj, &style,
                                      obj_to_rotation, (void *)&rotation,
-                                     obj_to_scale, (void *)&face_size))
+                                     obj_to_scale, (void *)&face_size,
+                                     &pgSurfacePool_Type, &pool, &wraplength,
+                                     &align))
         goto error;
 
     if (fg_color_obj == Py_None) {
@@ -1775,15 +2014,58 @@ _ftfont_render(pgFontObject *self, PyObject *args, PyObject *kwds)
             goto error;
     }
 
-    if (_PGFT_BuildRenderMode(self->freetype, self, &render, face_size, style,
-                              rotation))
+    /* zeroed, padding included, as the render cache compares its bytes */
+    memset(&render, 0, sizeof(render));
+    _PGFT_Lock(self->freetype);
+    rc = _PGFT_BuildRenderMode(self->freetype, self, &render, face_size,
+                               style, rotation) ||
+         _PGFT_SetRenderWrap(&render, wraplength, align);
+    _PGFT_Unlock(self->freetype);
+    if (rc)
         goto error;
 
+    if (self->render_cache && !pool &&
+        (PyUnicode_CheckExact(textobj) || PyBytes_CheckExact(textobj))) {
+        /* everything the surface depends on: the render mode holds the
+         * size, style, rotation and render flags used */
+        cache_key = Py_BuildValue(
+            "(Oy#y#z#)", textobj, (const char *)&render,
+            (Py_ssize_t)sizeof(render), (const char *)&fg_color,
+            (Py_ssize_t)sizeof(fg_color),
+            (bg_color_obj || self->is_bg_col_set) ? (const char *)&bg_color
+                                                  : 0,
+            (Py_ssize_t)sizeof(bg_color));
+        if (!cache_key)
+            goto error;
+        cached = pgRenderCache_Get(self->render_cache, cache_key);
+        if (cached) {
+            free_string(text);
+            Py_DECREF(cache_key);
+            /* the Rect is copied, as callers may move it */
+            r = pgRect_AsRect(PyTuple_GET_ITEM(cached, 1));
+            rect_obj = pgRect_New(&r);
+            if (rect_obj) {
+                rtuple =
+                    PyTuple_Pack(2, PyTuple_GET_ITEM(cached, 0), rect_obj);
+                Py_DECREF(rect_obj);
+            }
+            Py_DECREF(cached);
+            return rtuple;
+        }
+        if (PyErr_Occurred())
+            goto error;
+    }
+
+    start = pg_StatsBegin();
+    _PGFT_Lock(self->freetype);
     surface = _PGFT_Render_NewSurface(
         self->freetype, self, &render, text, &fg_color,
-        (bg_color_obj || self->is_bg_col_set) ? &bg_color : 0, &r);
+        (bg_color_obj || self->is_bg_col_set) ? &bg_color : 0, &r, pool);
+    _PGFT_Unlock(self->freetype);
     if (!surface)
         goto error;
+    pg_StatsEnd(PG_STAT_TEXT, "freetype_render", start,
+                (Sint64)surface->w * surface->h);
     free_string(text);
     surface_obj = (PyObject *)pgSurface_New(surface);
     if (!surface_obj)
@@ -1795,18 +2077,25 @@ _ftfont_render(pgFontObject *self, PyObject *args, PyObject *kwds)
     rtuple = PyTuple_Pack(2, surface_obj, rect_obj);
     if (!rtuple)
         goto error;
+    if (cache_key) {
+        if (pgRenderCache_Put(self->render_cache, cache_key, rtuple,
+                              (size_t)surface->h * (size_t)surface->pitch))
+            goto error;
+        Py_DECREF(cache_key);
+    }
     Py_DECREF(surface_obj);
     Py_DECREF(rect_obj);
 
     return rtuple;
 
 error:
+    Py_XDECREF(cache_key);
     free_string(text);
     if (surface_obj) {
         Py_DECREF(surface_obj);
     }
     else if (surface) {
-        SDL_FreeSurface(surface);
+        pgSurfacePool_FreeSurface(surface);
     }
     Py_XDECREF(rect_obj);
     Py_XDECREF(rtuple);
@@ -1817,8 +2106,9 @@ static PyObject *
 _ftfont_render_to(pgFontObject *self, PyObject *args, PyObject *kwds)
 {
     /* keyword list */
-    static char *kwlist[] = {"surf",  "dest",     "text", "fgcolor", "bgcolor",
-                             "style", "rotation", "size", 0};
+    static char *kwlist[] = {"surf",       "dest",    "text",     "fgcolor",
+                             "bgcolor",    "style",   "rotation", "size",
+                             "wraplength", "align",   0};
 
     /* input arguments */
     PyObject *surface_obj = 0;
@@ -1832,7 +2122,11 @@ _ftfont_render_to(pgFontObject *self, PyObject *args, PyObject *kwds)
     PyObject *bg_color_obj = 0;
     Angle_t rotation = self->rotation;
     int style = FT_STYLE_DEFAULT;
+    int wraplength = 0;
+    int align = FT_ALIGN_LEFT;
     SDL_Surface *surface = 0;
+    int rc;
+    Uint64 start;
 
     /* output arguments */
     SDL_Rect r;
@@ -1842,12 +2136,12 @@ _ftfont_render_to(pgFontObject *self, PyObject *args, PyObject *kwds)
     FontRenderMode render;
 
     if (!PyArg_ParseTupleAndKeywords(
-            args, kwds, "O!OO|OOiO&O&", kwlist,
+            args, kwds, "O!OO|OOiO&O&ii", kwlist,
             /* required */
             &pgSurface_Type, &surface_obj, &dest, &textobj, &fg_color_obj,
             /* optional */
             &bg_color_obj, &style, obj_to_rotation, (void *)&rotation,
-            obj_to_scale, (void *)&face_size))
+            obj_to_scale, (void *)&face_size, &wraplength, &align))
         goto error;
 
     if (fg_color_obj == Py_None) {
@@ -1899,20 +2193,27 @@ _ftfont_render_to(pgFontObject *self, PyObject *args, PyObject *kwds)
             goto error;
     }
 
-    if (_PGFT_BuildRenderMode(self->freetype, self, &render, face_size, style,
-                              rotation))
-        goto error;
-
     surface = surface_obj ? pgSurface_AsSurface(surface_obj) : NULL;
     if (!surface) {
         PyErr_SetString(pgExc_SDLError, "display Surface quit");
         goto error;
     }
-    if (_PGFT_Render_ExistingSurface(
-            self->freetype, self, &render, text, surface, xpos, ypos,
-            &fg_color, (bg_color_obj || self->is_bg_col_set) ? &bg_color : 0,
-            &r))
+    if (!pgSurface_Unshare(surface))
         goto error;
+    start = pg_StatsBegin();
+    _PGFT_Lock(self->freetype);
+    rc = _PGFT_BuildRenderMode(self->freetype, self, &render, face_size,
+                               style, rotation) ||
+         _PGFT_SetRenderWrap(&render, wraplength, align) ||
+         _PGFT_Render_ExistingSurface(
+             self->freetype, self, &render, text, surface, xpos, ypos,
+             &fg_color, (bg_color_obj || self->is_bg_col_set) ? &bg_color : 0,
+             &r);
+    _PGFT_Unlock(self->freetype);
+    if (rc)
+        goto error;
+    pg_StatsEnd(PG_STAT_TEXT, "freetype_render_to", start,
+                (Sint64)r.w * r.h);
     free_string(text);
 
     return pgRect_New(&r);
@@ -1922,6 +2223,480 @@ error:
     return 0;
 }
 
+/****************************************************
+ * TEXT LAYOUT
+ ****************************************************/
+#define TEXT_LAYOUT_TYPE_NAME "TextLayout"
+
+/* A text laid out once by a Font, kept to be measured and drawn many times.
+ * The layout is swapped in as the active layout of the Font for the render
+ * functions, which are then given no text to lay out. The FreeType lock is
+ * held from the swap in to the swap back.
+ */
+typedef struct {
+    PyObject_HEAD pgFontObject *font;
+    PyObject *text;
+    PGFT_String *string;
+    FontRenderMode mode;
+    Layout layout;
+    FontCache *cache; /* a reference to the cache the glyphs are in */
+} pgTextLayoutObject;
+
+static int
+_fttextlayout_enter(pgTextLayoutObject *self)
+{
+    if (!pgFont_IS_ALIVE(self->font)) {
+        PyErr_SetString(PyExc_RuntimeError, MODULE_NAME "." FONT_TYPE_NAME
+                        " instance is not initialized");
+        return -1;
+    }
+    _PGFT_Lock(self->font->freetype);
+    _PGFT_LayoutExchange(self->font, &self->layout);
+    return 0;
+}
+
+static void
+_fttextlayout_leave(pgTextLayoutObject *self)
+{
+    FontCache *cache;
+
+    _PGFT_LayoutExchange(self->font, &self->layout);
+
+    /* Keep the cache the glyphs were found in, so it is not freed, and
+     * its address reused, while the layout points into it. */
+    cache = self->layout.cache;
+    if (cache != self->cache) {
+        if (cache) {
+            ++cache->ref_count;
+        }
+        _PGFT_Cache_Release(self->cache);
+        self->cache = cache;
+    }
+    _PGFT_Unlock(self->font->freetype);
+}
+
+static int
+_fttextlayout_colors(pgTextLayoutObject *self, PyObject *fg_color_obj,
+                     PyObject *bg_color_obj, FontColor *fg_color,
+                     FontColor *bg_color, int *has_bg)
+{
+    pgFontObject *font = self->font;
+
+    if (fg_color_obj && fg_color_obj != Py_None) {
+        if (!pg_RGBAFromFuzzyColorObj(fg_color_obj, (Uint8 *)fg_color)) {
+            return -1;
+        }
+    }
+    else {
+        fg_color->r = font->fgcolor[0];
+        fg_color->g = font->fgcolor[1];
+        fg_color->b = font->fgcolor[2];
+        fg_color->a = font->fgcolor[3];
+    }
+    *has_bg = 1;
+    if (bg_color_obj && bg_color_obj != Py_None) {
+        if (!pg_RGBAFromFuzzyColorObj(bg_color_obj, (Uint8 *)bg_color)) {
+            return -1;
+        }
+    }
+    else if (font->is_bg_col_set) {
+        bg_color->r = font->bgcolor[0];
+        bg_color->g = font->bgcolor[1];
+        bg_color->b = font->bgcolor[2];
+        bg_color->a = font->bgcolor[3];
+    }
+    else {
+        *has_bg = 0;
+    }
+    return 0;
+}
+
+/* Fills carets, of one more entry than there are characters, with the
+ * offsets in pixels of the pen before each character, and after the last,
+ * along the direction of the text, from the edge of the text rect.
+ */
+static int
+_fttextlayout_getcarets(pgTextLayoutObject *self, long *carets, unsigned *w,
+                        unsigned *h)
+{
+    Layout *ftext;
+    GlyphSlot *slot;
+    FT_Vector offset;
+    FT_Pos underline_top;
+    FT_Fixed underline_size;
+    FT_Pos pen;
+    int vertical = self->mode.render_flags & FT_RFLAG_VERTICAL;
+    int i;
+
+    if (self->mode.rotation_angle != 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "caret positions are unsupported for rotated text");
+        return -1;
+    }
+    if (_fttextlayout_enter(self)) {
+        return -1;
+    }
+    ftext = _PGFT_LoadLayout(self->font->freetype, self->font, &self->mode,
+                             0);
+    if (ftext) {
+        _PGFT_GetRenderMetrics(&self->mode, ftext, w, h, &offset,
+                               &underline_top, &underline_size);
+        for (i = 0; i < ftext->length; ++i) {
+            slot = &ftext->glyphs[i];
+            if (vertical) {
+                pen = slot->posn.y -
+                      slot->glyph->v_metrics.bearing_rotated.y + offset.y;
+            }
+            else {
+                pen = slot->posn.x -
+                      slot->glyph->h_metrics.bearing_rotated.x + offset.x;
+            }
+            carets[i] = (long)FX6_TRUNC(FX6_ROUND(pen));
+        }
+        pen = vertical ? ftext->advance.y + offset.y
+                       : ftext->advance.x + offset.x;
+        carets[i] = (long)FX6_TRUNC(FX6_ROUND(pen));
+    }
+    _fttextlayout_leave(self);
+    return ftext ? 0 : -1;
+}
+
+static PyObject *
+_fttextlayout_new(PyTypeObject *subtype, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"font", "text", "style", "rotation", "size", 0};
+
+    pgFontObject *font;
+    PyObject *textobj;
+    int style = FT_STYLE_DEFAULT;
+    PyObject *rotation_obj = 0;
+    Angle_t rotation;
+    Scale_t face_size = FACE_SIZE_NONE;
+    pgTextLayoutObject *self;
+    Layout *ftext;
+    int rc;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!O|iOO&", kwlist,
+                                     &pgFont_Type, &font, &textobj, &style,
+                                     &rotation_obj, obj_to_scale,
+                                     (void *)&face_size)) {
+        return 0;
+    }
+    ASSERT_SELF_IS_ALIVE(font);
+    rotation = font->rotation;
+    if (rotation_obj && !obj_to_rotation(rotation_obj, &rotation)) {
+        return 0;
+    }
+
+    self = (pgTextLayoutObject *)subtype->tp_alloc(subtype, 0);
+    if (!self) {
+        return 0;
+    }
+    Py_INCREF(font);
+    self->font = font;
+    Py_INCREF(textobj);
+    self->text = textobj;
+    self->string =
+        _PGFT_EncodePyString(textobj, font->render_flags & FT_RFLAG_UCS4);
+    if (!self->string) {
+        goto error;
+    }
+    _PGFT_Lock(font->freetype);
+    rc = _PGFT_BuildRenderMode(font->freetype, font, &self->mode, face_size,
+                               style, rotation);
+    _PGFT_Unlock(font->freetype);
+    if (rc) {
+        goto error;
+    }
+
+    _fttextlayout_enter(self);
+    ftext = _PGFT_LoadLayout(font->freetype, font, &self->mode, self->string);
+    _fttextlayout_leave(self);
+    if (!ftext) {
+        goto error;
+    }
+    return (PyObject *)self;
+
+error:
+    Py_DECREF(self);
+    return 0;
+}
+
+static void
+_fttextlayout_dealloc(pgTextLayoutObject *self)
+{
+    FreeTypeInstance *ft = self->font ? self->font->freetype : 0;
+
+    _PGFT_LayoutRelease(&self->layout);
+    if (ft) {
+        _PGFT_Lock(ft);
+        _PGFT_Cache_Release(self->cache);
+        _PGFT_Unlock(ft);
+    }
+    else {
+        _PGFT_Cache_Release(self->cache);
+    }
+    free_string(self->string);
+    Py_XDECREF(self->text);
+    Py_XDECREF(self->font);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+_fttextlayout_getrect(pgTextLayoutObject *self, PyObject *_null)
+{
+    SDL_Rect r;
+    int rc;
+
+    if (_fttextlayout_enter(self)) {
+        return 0;
+    }
+    rc = _PGFT_GetTextRect(self->font->freetype, self->font, &self->mode, 0,
+                           &r);
+    _fttextlayout_leave(self);
+    if (rc) {
+        return 0;
+    }
+    return pgRect_New(&r);
+}
+
+static PyObject *
+_fttextlayout_getmetrics(pgTextLayoutObject *self, PyObject *_null)
+{
+    PyObject *list;
+
+    if (!pgFont_IS_ALIVE(self->font)) {
+        return RAISE(PyExc_RuntimeError, MODULE_NAME "." FONT_TYPE_NAME
+                     " instance is not initialized");
+    }
+    _PGFT_Lock(self->font->freetype);
+    list = get_metrics(&self->mode, self->font, self->string);
+    _PGFT_Unlock(self->font->freetype);
+    return list;
+}
+
+static PyObject *
+_fttextlayout_render(pgTextLayoutObject *self, PyObject *args,
+                     PyObject *kwds)
+{
+    static char *kwlist[] = {"fgcolor", "bgcolor", 0};
+
+    PyObject *fg_color_obj = 0;
+    PyObject *bg_color_obj = 0;
+    FontColor fg_color;
+    FontColor bg_color;
+    int has_bg;
+    SDL_Surface *surface;
+    SDL_Rect r;
+    PyObject *surface_obj;
+    PyObject *rect_obj;
+    PyObject *rtuple;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO", kwlist,
+                                     &fg_color_obj, &bg_color_obj) ||
+        _fttextlayout_colors(self, fg_color_obj, bg_color_obj, &fg_color,
+                             &bg_color, &has_bg) ||
+        _fttextlayout_enter(self)) {
+        return 0;
+    }
+    surface = _PGFT_Render_NewSurface(self->font->freetype, self->font,
+                                      &self->mode, 0, &fg_color,
+                                      has_bg ? &bg_color : 0, &r, 0);
+    _fttextlayout_leave(self);
+    if (!surface) {
+        return 0;
+    }
+    surface_obj = (PyObject *)pgSurface_New(surface);
+    if (!surface_obj) {
+        SDL_FreeSurface(surface);
+        return 0;
+    }
+    rect_obj = pgRect_New(&r);
+    if (!rect_obj) {
+        Py_DECREF(surface_obj);
+        return 0;
+    }
+    rtuple = PyTuple_Pack(2, surface_obj, rect_obj);
+    Py_DECREF(surface_obj);
+    Py_DECREF(rect_obj);
+    return rtuple;
+}
+
+static PyObject *
+_fttextlayout_render_to(pgTextLayoutObject *self, PyObject *args,
+                        PyObject *kwds)
+{
+    static char *kwlist[] = {"surf", "dest", "fgcolor", "bgcolor", 0};
+
+    PyObject *surface_obj;
+    PyObject *dest;
+    PyObject *fg_color_obj = 0;
+    PyObject *bg_color_obj = 0;
+    int xpos = 0;
+    int ypos = 0;
+    FontColor fg_color;
+    FontColor bg_color;
+    int has_bg;
+    SDL_Surface *surface;
+    SDL_Rect r;
+    int rc;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!O|OO", kwlist,
+                                     &pgSurface_Type, &surface_obj, &dest,
+                                     &fg_color_obj, &bg_color_obj) ||
+        parse_dest(dest, &xpos, &ypos) ||
+        _fttextlayout_colors(self, fg_color_obj, bg_color_obj, &fg_color,
+                             &bg_color, &has_bg)) {
+        return 0;
+    }
+    surface = pgSurface_AsSurface(surface_obj);
+    if (!surface) {
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    }
+    if (!pgSurface_Unshare(surface) || _fttextlayout_enter(self)) {
+        return 0;
+    }
+    rc = _PGFT_Render_ExistingSurface(self->font->freetype, self->font,
+                                      &self->mode, 0, surface, xpos, ypos,
+                                      &fg_color, has_bg ? &bg_color : 0, &r);
+    _fttextlayout_leave(self);
+    if (rc) {
+        return 0;
+    }
+    return pgRect_New(&r);
+}
+
+static PyObject *
+_fttextlayout_getcaretpositions(pgTextLayoutObject *self, PyObject *_null)
+{
+    Py_ssize_t length = PGFT_String_GET_LENGTH(self->string);
+    long *carets;
+    unsigned w, h;
+    PyObject *list = 0;
+    PyObject *item;
+    Py_ssize_t i;
+
+    carets = PyMem_New(long, length + 1);
+    if (!carets) {
+        return PyErr_NoMemory();
+    }
+    if (_fttextlayout_getcarets(self, carets, &w, &h)) {
+        goto finish;
+    }
+    list = PyList_New(length + 1);
+    if (!list) {
+        goto finish;
+    }
+    for (i = 0; i <= length; ++i) {
+        item = PyLong_FromLong(carets[i]);
+        if (!item) {
+            Py_CLEAR(list);
+            goto finish;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+
+finish:
+    PyMem_Free(carets);
+    return list;
+}
+
+static PyObject *
+_fttextlayout_indexat(pgTextLayoutObject *self, PyObject *pos)
+{
+    Py_ssize_t length = PGFT_String_GET_LENGTH(self->string);
+    int vertical = self->mode.render_flags & FT_RFLAG_VERTICAL;
+    long *carets;
+    unsigned w, h;
+    int x, y;
+    long along, start, end;
+    Py_ssize_t i, index = -1;
+
+    if (!pg_TwoIntsFromObj(pos, &x, &y)) {
+        return RAISE(PyExc_TypeError, "pos must be two numbers");
+    }
+    carets = PyMem_New(long, length + 1);
+    if (!carets) {
+        return PyErr_NoMemory();
+    }
+    if (_fttextlayout_getcarets(self, carets, &w, &h)) {
+        PyMem_Free(carets);
+        return 0;
+    }
+
+    /* across the text, the whole rect belongs to each character */
+    if (vertical ? (x >= 0 && (unsigned)x < w) : (y >= 0 && (unsigned)y < h)) {
+        along = vertical ? y : x;
+        for (i = 0; i < length; ++i) {
+            /* kerning may move a pen back */
+            start = MIN(carets[i], carets[i + 1]);
+            end = MAX(carets[i], carets[i + 1]);
+            if (along >= start && along < end) {
+                index = i;
+                break;
+            }
+        }
+    }
+    PyMem_Free(carets);
+    return PyLong_FromSsize_t(index);
+}
+
+static PyObject *
+_fttextlayout_getfont(pgTextLayoutObject *self, void *closure)
+{
+    Py_INCREF(self->font);
+    return (PyObject *)self->font;
+}
+
+static PyObject *
+_fttextlayout_gettext(pgTextLayoutObject *self, void *closure)
+{
+    Py_INCREF(self->text);
+    return self->text;
+}
+
+static PyObject *
+_fttextlayout_repr(pgTextLayoutObject *self)
+{
+    return PyUnicode_FromFormat("<" TEXT_LAYOUT_TYPE_NAME "(%R)>",
+                                self->text);
+}
+
+static PyMethodDef _fttextlayout_methods[] = {
+    {"get_rect", (PyCFunction)_fttextlayout_getrect, METH_NOARGS,
+     DOC_TEXTLAYOUTGETRECT},
+    {"get_metrics", (PyCFunction)_fttextlayout_getmetrics, METH_NOARGS,
+     DOC_TEXTLAYOUTGETMETRICS},
+    {"render", (PyCFunction)_fttextlayout_render,
+     METH_VARARGS | METH_KEYWORDS, DOC_TEXTLAYOUTRENDER},
+    {"render_to", (PyCFunction)_fttextlayout_render_to,
+     METH_VARARGS | METH_KEYWORDS, DOC_TEXTLAYOUTRENDERTO},
+    {"get_caret_positions", (PyCFunction)_fttextlayout_getcaretpositions,
+     METH_NOARGS, DOC_TEXTLAYOUTGETCARETPOSITIONS},
+    {"index_at", (PyCFunction)_fttextlayout_indexat, METH_O,
+     DOC_TEXTLAYOUTINDEXAT},
+
+    {0, 0, 0, 0}};
+
+static PyGetSetDef _fttextlayout_getsets[] = {
+    {"font", (getter)_fttextlayout_getfont, 0, DOC_TEXTLAYOUTFONT, 0},
+    {"text", (getter)_fttextlayout_gettext, 0, DOC_TEXTLAYOUTTEXT, 0},
+
+    {0, 0, 0, 0, 0}};
+
+static PyTypeObject pgTextLayout_Type = {
+    PyVarObject_HEAD_INIT(0, 0).tp_name =
+        MODULE_NAME "." TEXT_LAYOUT_TYPE_NAME,
+    .tp_basicsize = sizeof(pgTextLayoutObject),
+    .tp_dealloc = (destructor)_fttextlayout_dealloc,
+    .tp_repr = (reprfunc)_fttextlayout_repr,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_PYGAMEFREETYPETEXTLAYOUT,
+    .tp_methods = _fttextlayout_methods,
+    .tp_getset = _fttextlayout_getsets,
+    .tp_new = (newfunc)_fttextlayout_new,
+};
+
 /****************************************************
  * C API CALLS
  ****************************************************/
@@ -1929,6 +2704,7 @@ static PyObject *
 pgFont_New(const char *filename, long font_index)
 {
     pgFontObject *font;
+    int rc;
 
     FreeTypeInstance *ft;
     ASSERT_GRAB_FREETYPE(ft, 0);
@@ -1943,7 +2719,10 @@ pgFont_New(const char *filename, long font_index)
         return 0;
     }
 
-    if (_PGFT_TryLoadFont_Filename(ft, font, filename, font_index)) {
+    _PGFT_Lock(ft);
+    rc = _PGFT_TryLoadFont_Filename(ft, font, filename, font_index);
+    _PGFT_Unlock(ft);
+    if (rc) {
         return 0;
     }
 
@@ -2159,6 +2938,9 @@ MODINIT_DEFINE(_freetype)
     if (PyType_Ready(&pgFont_Type) < 0) {
         return NULL;
     }
+    if (PyType_Ready(&pgTextLayout_Type) < 0) {
+        return NULL;
+    }
 
     module = PyModule_Create(&_freetypemodule);
 
@@ -2177,6 +2959,14 @@ MODINIT_DEFINE(_freetype)
         return NULL;
     }
 
+    Py_INCREF(&pgTextLayout_Type);
+    if (PyModule_AddObject(module, TEXT_LAYOUT_TYPE_NAME,
+                           (PyObject *)&pgTextLayout_Type)) {
+        Py_DECREF(&pgTextLayout_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
 #define DEC_CONST(x)                                        \
     if (PyModule_AddIntConstant(module, #x, (int)FT_##x)) { \
         Py_DECREF(module);                                  \
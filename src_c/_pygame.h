@@ -232,9 +232,39 @@ typedef enum {
     PGS_RLEACCELOK = 0x00002000,
     PGS_RLEACCEL = 0x00004000,
     PGS_SRCALPHA = 0x00010000,
+    PGS_PREMULTIPLIED = 0x00100000,
     PGS_PREALLOC = 0x01000000
 } PygameSurfaceFlags;
 
+/* Private SDL_Surface.flags bit marking surfaces whose colour channels are
+ * premultiplied by their alpha. SDL itself only uses the lowest bits.
+ */
+#define PG_SURF_PREMULTIPLIED 0x00100000
+
+/* Private SDL_Surface.flags bits for copy-on-write copies. PG_SURF_SHARED
+ * marks surfaces sharing their pixels with other Surface.copy() results;
+ * PG_SURF_PINNED marks surfaces whose pixels must never move, because
+ * subsurfaces or a handed out pixel address point into them.
+ */
+#define PG_SURF_SHARED 0x00200000
+#define PG_SURF_PINNED 0x00400000
+
+/* Private SDL_Surface.flags bit for surfaces whose pixels belong to the
+ * SurfacePool in their userdata.
+ */
+#define PG_SURF_POOLED 0x00800000
+
+/* Private SDL_Surface.flags bit for surfaces whose pixels have not been
+ * written to since their blit spans were recorded. pgSurface_Unshare,
+ * called before every write, clears it.
+ */
+#define PG_SURF_SPANS 0x01000000
+
+/* Private SDL_Surface.flags bit for surfaces whose pixels were packed by
+ * pgSurface_Pack, leaving them NULL until pgSurface_Unpack.
+ */
+#define PG_SURF_PACKED 0x02000000
+
 // TODO Implement check below in a way that does not break CI
 /* New buffer protocol (PEP 3118) implemented on all supported Py versions.
 #if !defined(Py_TPFLAGS_HAVE_NEWBUFFER)
@@ -287,6 +317,10 @@ supported Python version. #endif */
 struct pgEventObject {
     PyObject_HEAD int type;
     PyObject *dict;
+    /* while dict is NULL, the SDL event the dict is made from on first use
+       and the pygame Window it came from */
+    SDL_Event event;
+    PyObject *window;
 };
 
 /*
@@ -324,16 +358,16 @@ struct pgColorObject {
  * Remember to keep these constants up to date.
  */
 
-#define PYGAMEAPI_RECT_NUMSLOTS 5
+#define PYGAMEAPI_RECT_NUMSLOTS 8
 #define PYGAMEAPI_JOYSTICK_NUMSLOTS 2
 #define PYGAMEAPI_DISPLAY_NUMSLOTS 2
-#define PYGAMEAPI_SURFACE_NUMSLOTS 4
-#define PYGAMEAPI_SURFLOCK_NUMSLOTS 8
-#define PYGAMEAPI_RWOBJECT_NUMSLOTS 7
+#define PYGAMEAPI_SURFACE_NUMSLOTS 10
+#define PYGAMEAPI_SURFLOCK_NUMSLOTS 17
+#define PYGAMEAPI_RWOBJECT_NUMSLOTS 8
 #define PYGAMEAPI_PIXELARRAY_NUMSLOTS 2
 #define PYGAMEAPI_COLOR_NUMSLOTS 5
 #define PYGAMEAPI_MATH_NUMSLOTS 2
-#define PYGAMEAPI_BASE_NUMSLOTS 24
-#define PYGAMEAPI_EVENT_NUMSLOTS 6
+#define PYGAMEAPI_BASE_NUMSLOTS 30
+#define PYGAMEAPI_EVENT_NUMSLOTS 7
 
 #endif /* _PYGAME_INTERNAL_H */
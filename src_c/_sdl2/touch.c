@@ -117,6 +117,70 @@ pg_touch_get_finger(PyObject *self, PyObject *args, PyObject *kwargs)
     return fingerobj;
 }
 
+/* the id, x, y and pressure of a finger */
+#define PG_FINGER_RECORD_LEN 4
+
+static PyObject *
+pg_touch_get_fingers(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    char *keywords[] = {"touchid", "out", NULL};
+    SDL_TouchID touchid;
+    SDL_Finger *finger;
+    PyObject *obj;
+    Py_buffer view;
+    const char *format;
+    double *records;
+    int count, max, i;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "LO", keywords, &touchid,
+                                     &obj)) {
+        return NULL;
+    }
+
+    VIDEO_INIT_CHECK();
+
+    if (PyObject_GetBuffer(obj, &view,
+                           PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_ND)) {
+        return NULL;
+    }
+    format = view.format ? view.format : "B";
+    if (*format == '@' || *format == '=' ||
+        *format == (SDL_BYTEORDER == SDL_LIL_ENDIAN ? '<' : '>')) {
+        format++;
+    }
+    if (view.itemsize != sizeof(double) || strcmp(format, "d") != 0 ||
+        !PyBuffer_IsContiguous(&view, 'C') ||
+        view.len % (PG_FINGER_RECORD_LEN * sizeof(double))) {
+        PyBuffer_Release(&view);
+        return RAISE(PyExc_ValueError,
+                     "out must be a contiguous buffer of doubles, four for "
+                     "each finger");
+    }
+    max = (int)SDL_min(view.len / (PG_FINGER_RECORD_LEN * sizeof(double)),
+                       INT_MAX);
+
+    /* 0 also for a device that is not there */
+    count = SDL_GetNumTouchFingers(touchid);
+    if (count > max) {
+        count = max;
+    }
+    records = (double *)view.buf;
+    for (i = 0; i < count; i++) {
+        if (!(finger = SDL_GetTouchFinger(touchid, i))) {
+            count = i;
+            break;
+        }
+        records[0] = (double)finger->id;
+        records[1] = finger->x;
+        records[2] = finger->y;
+        records[3] = finger->pressure;
+        records += PG_FINGER_RECORD_LEN;
+    }
+
+    PyBuffer_Release(&view);
+    return PyLong_FromLong(count);
+}
+
 static PyMethodDef _touch_methods[] = {
     {"get_num_devices", pg_touch_num_devices, METH_NOARGS,
      DOC_PYGAMESDL2TOUCHGETNUMDEVICES},
@@ -126,6 +190,8 @@ static PyMethodDef _touch_methods[] = {
      DOC_PYGAMESDL2TOUCHGETNUMFINGERS},
     {"get_finger", (PyCFunction)pg_touch_get_finger,
      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMESDL2TOUCHGETFINGER},
+    {"get_fingers", (PyCFunction)pg_touch_get_fingers,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMESDL2TOUCHGETFINGERS},
 
     {NULL, NULL, 0, NULL}};
 
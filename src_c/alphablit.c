@@ -22,7 +22,6 @@
   pete@shinners.org
 */
 
-#define NO_PYGAME_C_API
 #include "_surface.h"
 
 #if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
@@ -55,20 +54,22 @@
 static void
 alphablit_alpha(SDL_BlitInfo *info);
 
-#if (defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON))
+#if PG_ENABLE_ARM_NEON
 static void
-alphablit_alpha_sse2_argb_surf_alpha(SDL_BlitInfo *info);
+alphablit_alpha_neon_argb_surf_alpha(SDL_BlitInfo *info);
 static void
-alphablit_alpha_sse2_argb_no_surf_alpha(SDL_BlitInfo *info);
+alphablit_alpha_neon_argb_no_surf_alpha(SDL_BlitInfo *info);
 static void
-alphablit_alpha_sse2_argb_no_surf_alpha_opaque_dst(SDL_BlitInfo *info);
-#endif /* (defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)) */
+alphablit_alpha_neon_argb_no_surf_alpha_opaque_dst(SDL_BlitInfo *info);
+#endif /* PG_ENABLE_ARM_NEON */
 
 static void
 alphablit_colorkey(SDL_BlitInfo *info);
 static void
 alphablit_solid(SDL_BlitInfo *info);
 static void
+blit_palette8(SDL_BlitInfo *info);
+static void
 blit_blend_add(SDL_BlitInfo *info);
 static void
 blit_blend_sub(SDL_BlitInfo *info);
@@ -104,640 +105,1157 @@ blit_blend_premultiplied_sse2(SDL_BlitInfo *info);
 
 static int
 SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
-               SDL_Rect *dstrect, int the_args);
+               SDL_Rect *dstrect, int the_args, const pgBlitSpans *spans);
 extern int
 SDL_RLESurface(SDL_Surface *surface);
 extern void
 SDL_UnRLESurface(SDL_Surface *surface, int recode);
 
-static int
-SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
-               SDL_Rect *dstrect, int the_args)
+/* Skip and copy runs shorter than this are blended with their
+ * neighbours, as a blitter call costs more than blending them.
+ */
+#define PG_SPAN_MIN_RUN 8
+
+/* Record the runs of src, in the mode already set in spans. Returns -1
+ * if out of memory. Surfaces of 1 byte per pixel have no spans.
+ */
+int
+pg_BuildBlitSpans(SDL_Surface *src, pgBlitSpans *spans)
 {
-    int okay;
-    int src_locked;
-    int dst_locked;
+    int bpp = src->format->BytesPerPixel;
+    Uint32 amask = src->format->Amask;
+    Uint32 *runs = NULL, *grown;
+    size_t *rows;
+    size_t count = 0, size = 0, first;
+    Uint8 *row, *p;
+    Uint32 pixel, a;
+    int x, y, start, kind = PG_SPAN_BLEND, prev, length;
+
+    if (bpp < 2 || src->w >= (1 << 30)) {
+        return -1;
+    }
+    rows = (size_t *)PyMem_Malloc(sizeof(size_t) * ((size_t)src->h + 1));
+    if (!rows) {
+        return -1;
+    }
+    for (y = 0; y < src->h; ++y) {
+        row = (Uint8 *)src->pixels + (size_t)y * src->pitch;
+        rows[y] = first = count;
+        start = 0;
+        prev = -1;
+        for (x = 0; x <= src->w; ++x) {
+            if (x < src->w) {
+                p = row + x * bpp;
+                GET_PIXEL(pixel, bpp, p);
+                if (spans->mode == PG_SPANS_KEY) {
+                    kind = pixel == spans->colorkey ? PG_SPAN_SKIP
+                                                    : PG_SPAN_COPY;
+                }
+                else {
+                    a = pixel & amask;
+                    kind = !a            ? PG_SPAN_SKIP
+                           : a == amask ? PG_SPAN_COPY
+                                        : PG_SPAN_BLEND;
+                }
+                if (kind == prev) {
+                    continue;
+                }
+            }
+            if (prev >= 0) {
+                length = x - start;
+                if (prev != PG_SPAN_BLEND && length < PG_SPAN_MIN_RUN &&
+                    length < src->w) {
+                    prev = PG_SPAN_BLEND;
+                }
+                if (prev == PG_SPAN_BLEND && count > first &&
+                    PG_SPAN_KIND(runs[count - 1]) == PG_SPAN_BLEND) {
+                    runs[count - 1] += (Uint32)length;
+                }
+                else {
+                    if (count == size) {
+                        size = size ? size * 2 : (size_t)src->h * 4 + 16;
+                        grown = (Uint32 *)PyMem_Realloc(runs,
+                                                        size * sizeof(Uint32));
+                        if (!grown) {
+                            PyMem_Free(runs);
+                            PyMem_Free(rows);
+                            return -1;
+                        }
+                        runs = grown;
+                    }
+                    runs[count++] = (Uint32)prev << 30 | (Uint32)length;
+                }
+            }
+            start = x;
+            prev = kind;
+        }
+    }
+    rows[src->h] = count;
+    spans->runs = runs ? runs : (Uint32 *)PyMem_Malloc(sizeof(Uint32));
+    if (!spans->runs) {
+        PyMem_Free(rows);
+        return -1;
+    }
+    spans->rows = rows;
+    return 0;
+}
 
-    /* Everything is okay at the beginning...  */
-    okay = 1;
+/* Copy an opaque run: the plain blend of a fully opaque pixel gives the
+ * source colour with the destination alpha, if any, set to opaque.
+ */
+static void
+copy_span(Uint8 *dst, Uint8 *src, int n, int bpp, Uint32 keep, Uint32 set)
+{
+    Uint32 *d32 = (Uint32 *)dst, *s32 = (Uint32 *)src;
 
-    /* Lock the destination if it's in hardware */
-    dst_locked = 0;
-    if (SDL_MUSTLOCK(dst)) {
-        if (SDL_LockSurface(dst) < 0)
-            okay = 0;
-        else
-            dst_locked = 1;
+    if (bpp != 4 || (keep == 0xFFFFFFFF && !set)) {
+        memcpy(dst, src, (size_t)n * bpp);
+        return;
     }
-    /* Lock the source if it's in hardware */
-    src_locked = 0;
-    if (SDL_MUSTLOCK(src)) {
-        if (SDL_LockSurface(src) < 0)
-            okay = 0;
-        else
-            src_locked = 1;
+    while (n--) {
+        *d32++ = (*s32++ & keep) | set;
     }
+}
 
-    /* Set up source and destination buffer pointers, and BLIT! */
-    if (okay && srcrect->w && srcrect->h) {
-        SDL_BlitInfo info;
+/* Blit info row by row along the runs of info->s_spans: skip runs are left
+ * out and copy runs copied where that gives what blitter would, and the
+ * rest goes to blitter one stretch of a row at a time.
+ */
+static void
+blit_spans(pg_BlitFunc blitter, SDL_BlitInfo *info)
+{
+    const pgBlitSpans *spans = info->s_spans;
+    SDL_PixelFormat *srcfmt = info->src;
+    SDL_PixelFormat *dstfmt = info->dst;
+    int sbpp = info->s_pxskip, dbpp = info->d_pxskip;
+    int left = info->s_x, right = info->s_x + info->width;
+    int spitch = info->width * sbpp + info->s_skip;
+    int dpitch = info->width * dbpp + info->d_skip;
+    Uint32 keep = srcfmt->Rmask | srcfmt->Gmask | srcfmt->Bmask;
+    Uint32 set = dstfmt->Amask;
+    Uint8 *srow = info->s_pixels, *drow = info->d_pixels;
+    SDL_BlitInfo part = *info;
+    const Uint32 *run, *end;
+    int can_skip, can_copy, x, y, from, to, pending;
+
+    /* a zero alpha source pixel still gives its colour to a zero alpha
+       destination pixel, so only opaque destinations can be skipped */
+    can_skip = dbpp > 1 && !dstfmt->Amask;
+    can_copy = sbpp == dbpp && sbpp > 1 && info->src_blanket_alpha == 255 &&
+               keep == (dstfmt->Rmask | dstfmt->Gmask | dstfmt->Bmask);
+    if (spans->mode == PG_SPANS_ALPHA) {
+        can_copy = can_copy && sbpp == 4 &&
+                   (!set || (set == srcfmt->Amask &&
+                             info->dst_blend != SDL_BLENDMODE_NONE));
+    }
+    else {
+        can_copy = can_copy && !srcfmt->Amask && (sbpp == 4 || !set);
+    }
+    if (sbpp != 4 || (set && set == srcfmt->Amask)) {
+        /* no alpha to set, or the copy runs have it set already */
+        keep = 0xFFFFFFFF;
+        set = 0;
+    }
 
-        /* Set up the blit information */
-        info.width = srcrect->w;
-        info.height = srcrect->h;
-        info.s_pixels = (Uint8 *)src->pixels +
-                        (Uint16)srcrect->y * src->pitch +
-                        (Uint16)srcrect->x * src->format->BytesPerPixel;
-        info.s_pxskip = src->format->BytesPerPixel;
-        info.s_skip = src->pitch - info.width * src->format->BytesPerPixel;
-        info.d_pixels = (Uint8 *)dst->pixels +
-                        (Uint16)dstrect->y * dst->pitch +
-                        (Uint16)dstrect->x * dst->format->BytesPerPixel;
-        info.d_pxskip = dst->format->BytesPerPixel;
-        info.d_skip = dst->pitch - info.width * dst->format->BytesPerPixel;
-        info.src = src->format;
-        info.dst = dst->format;
-        SDL_GetSurfaceAlphaMod(src, &info.src_blanket_alpha);
-        info.src_has_colorkey = SDL_GetColorKey(src, &info.src_colorkey) == 0;
-        if (SDL_GetSurfaceBlendMode(src, &info.src_blend) ||
-            SDL_GetSurfaceBlendMode(dst, &info.dst_blend)) {
-            okay = 0;
+    part.height = 1;
+    part.s_skip = part.d_skip = 0;
+    part.s_spans = NULL;
+    for (y = info->s_y; y < info->s_y + info->height; ++y) {
+        run = spans->runs + spans->rows[y];
+        end = spans->runs + spans->rows[y + 1];
+        pending = -1;
+        for (x = 0; run < end && x < right; ++run) {
+            from = x;
+            to = x + PG_SPAN_LENGTH(*run);
+            x = to;
+            if (to <= left) {
+                continue;
+            }
+            if (from < left) {
+                from = left;
+            }
+            if (to > right) {
+                to = right;
+            }
+            if ((PG_SPAN_KIND(*run) == PG_SPAN_SKIP && can_skip) ||
+                (PG_SPAN_KIND(*run) == PG_SPAN_COPY && can_copy)) {
+                if (pending >= 0) {
+                    part.width = from - pending;
+                    part.s_pixels = srow + (pending - left) * sbpp;
+                    part.d_pixels = drow + (pending - left) * dbpp;
+                    blitter(&part);
+                    pending = -1;
+                }
+                if (PG_SPAN_KIND(*run) == PG_SPAN_COPY) {
+                    copy_span(drow + (from - left) * dbpp,
+                              srow + (from - left) * sbpp, to - from, sbpp,
+                              keep, set);
+                }
+            }
+            else if (pending < 0) {
+                pending = from;
+            }
         }
-        if (okay) {
-            if (info.d_pixels > info.s_pixels) {
-                int span = info.width * info.src->BytesPerPixel;
-                Uint8 *srcpixend =
-                    info.s_pixels + (info.height - 1) * src->pitch + span;
+        if (pending >= 0) {
+            part.width = right - pending;
+            part.s_pixels = srow + (pending - left) * sbpp;
+            part.d_pixels = drow + (pending - left) * dbpp;
+            blitter(&part);
+        }
+        srow += spitch;
+        drow += dpitch;
+    }
+}
 
-                if (info.d_pixels < srcpixend) {
-                    int dstoffset =
-                        (info.d_pixels - info.s_pixels) % src->pitch;
+/* Run blitter on info, along the source spans when there are some */
+static void
+blit_rows(pg_BlitFunc blitter, SDL_BlitInfo *info)
+{
+    if (info->s_spans) {
+        blit_spans(blitter, info);
+    }
+    else {
+        blitter(info);
+    }
+}
 
-                    if (dstoffset < span || dstoffset > src->pitch - span) {
-                        /* Overlapping Self blit with positive destination
-                           offset. Reverse direction of the blit.
-                        */
-                        info.s_pixels = srcpixend - info.s_pxskip;
-                        info.s_pxskip = -info.s_pxskip;
-                        info.s_skip = -info.s_skip;
-                        info.d_pixels =
-                            (info.d_pixels + (info.height - 1) * dst->pitch +
-                             span - info.d_pxskip);
-                        info.d_pxskip = -info.d_pxskip;
-                        info.d_skip = -info.d_skip;
-                    }
-                }
-            }
-            /* Convert alpha multiply blends to regular blends if either of
-             the surfaces don't have alpha channels */
-            if (the_args == PYGAME_BLEND_RGBA_MULT &&
-                (info.src_blend == SDL_BLENDMODE_NONE ||
-                 info.dst_blend == SDL_BLENDMODE_NONE)) {
-                the_args = PYGAME_BLEND_MULT;
+typedef struct {
+    pg_BlitFunc blitter;
+    SDL_BlitInfo *info;
+} BlitBands;
+
+/* Blit rows [height * band / nbands, height * (band + 1) / nbands) */
+static void
+blit_band(void *data, int band, int nbands)
+{
+    BlitBands *bands = (BlitBands *)data;
+    SDL_BlitInfo info = *bands->info;
+    int start = info.height * band / nbands;
+    int end = info.height * (band + 1) / nbands;
+
+    info.height = end - start;
+    if (!info.height) {
+        return;
+    }
+    info.s_pixels += start * (info.width * info.s_pxskip + info.s_skip);
+    info.d_pixels += start * (info.width * info.d_pxskip + info.d_skip);
+    info.s_y += start;
+    blit_rows(bands->blitter, &info);
+}
+
+/* Run a blitter, splitting large blits into row bands over the worker
+ * pool when the source and destination pixels do not overlap. The blit is
+ * counted under name in pygame.stats().
+ */
+static void
+run_blitter(pg_BlitFunc blitter, const char *name, SDL_BlitInfo *info,
+            SDL_Surface *src, SDL_Surface *dst)
+{
+    BlitBands bands;
+    Uint8 *srcend, *dstend;
+    int nthreads = pg_GetNumThreads();
+    Uint64 start = pg_StatsBegin();
+
+    if (nthreads < 2 || info->height < 2 ||
+        info->width * info->height < PG_PARALLEL_MIN_PIXELS ||
+        info->s_pxskip < 0) {
+        blit_rows(blitter, info);
+    }
+    else {
+        srcend = info->s_pixels + (info->height - 1) * src->pitch +
+                 info->width * info->s_pxskip;
+        dstend = info->d_pixels + (info->height - 1) * dst->pitch +
+                 info->width * info->d_pxskip;
+        if (info->s_pixels < dstend && info->d_pixels < srcend) {
+            blit_rows(blitter, info);
+        }
+        else {
+            bands.blitter = blitter;
+            bands.info = info;
+            if (nthreads > info->height) {
+                nthreads = info->height;
             }
+            pg_ParallelFor(blit_band, &bands, nthreads);
+        }
+    }
+    pg_StatsEnd(PG_STAT_BLIT, name, start,
+                (Sint64)info->width * info->height);
+}
+
+/* The palettes of 8 bit sources last mapped to 32 bit destinations. A
+ * palette is matched by its colors rather than its address, so changing
+ * it with set_palette() or set_palette_at() misses the cache, and a freed
+ * palette is never mistaken for a new one at the same address.
+ */
+#define PG_PALETTE_CACHE_SIZE 8
+
+typedef struct {
+    int ncolors; /* 0 for an unused entry */
+    SDL_Color colors[256];
+    Uint32 masks[4];
+    Uint8 mod[3];
+    Uint32 table[256];
+} PaletteTable;
+
+static PaletteTable palette_cache[PG_PALETTE_CACHE_SIZE];
+static int palette_cache_next = 0;
+static SDL_SpinLock palette_cache_lock = 0;
+
+/* Fill table with the 32 bit pixels of the palette of src, the way SDL maps
+ * them for a plain blit. Returns 0 if the blit can not use a table: it must
+ * be a plain blit of opaque 8 bit pixels to a 32 bit surface.
+ */
+static int
+palette_table(SDL_BlitInfo *info, SDL_Surface *src, SDL_Surface *dst,
+              int the_args, Uint32 *table)
+{
+    SDL_Palette *palette = src->format->palette;
+    SDL_PixelFormat *fmt = dst->format;
+    PaletteTable *entry;
+    Uint8 mod[3];
+    int i, ncolors;
+
+    if (the_args != 0 || !palette || src->format->BytesPerPixel != 1 ||
+        fmt->BytesPerPixel != 4 || info->s_pxskip != 1 ||
+        info->src_blanket_alpha != 255 ||
+        info->src_blend != SDL_BLENDMODE_NONE ||
+        SDL_GetSurfaceColorMod(src, &mod[0], &mod[1], &mod[2])) {
+        return 0;
+    }
+    ncolors = palette->ncolors < 256 ? palette->ncolors : 256;
+    if (ncolors < 1) {
+        return 0;
+    }
+
+    SDL_AtomicLock(&palette_cache_lock);
+    for (i = 0; i < PG_PALETTE_CACHE_SIZE; ++i) {
+        entry = &palette_cache[i];
+        if (entry->ncolors == ncolors && entry->masks[0] == fmt->Rmask &&
+            entry->masks[1] == fmt->Gmask && entry->masks[2] == fmt->Bmask &&
+            entry->masks[3] == fmt->Amask && !memcmp(entry->mod, mod, 3) &&
+            !memcmp(entry->colors, palette->colors,
+                    ncolors * sizeof(SDL_Color))) {
+            memcpy(table, entry->table, sizeof(entry->table));
+            SDL_AtomicUnlock(&palette_cache_lock);
+            return 1;
+        }
+    }
+    SDL_AtomicUnlock(&palette_cache_lock);
+
+    /* the same mapping as SDL_MapSurface makes for a blit to 32 bits */
+    for (i = 0; i < ncolors; ++i) {
+        SDL_Color *c = &palette->colors[i];
 
-            switch (the_args) {
-                case 0: {
-                    if (info.src_blend != SDL_BLENDMODE_NONE &&
-                        src->format->Amask) {
+        table[i] = SDL_MapRGBA(fmt, (Uint8)(c->r * mod[0] / 255),
+                               (Uint8)(c->g * mod[1] / 255),
+                               (Uint8)(c->b * mod[2] / 255), c->a);
+    }
+    for (; i < 256; ++i) {
+        table[i] = 0;
+    }
+
+    SDL_AtomicLock(&palette_cache_lock);
+    entry = &palette_cache[palette_cache_next];
+    palette_cache_next = (palette_cache_next + 1) % PG_PALETTE_CACHE_SIZE;
+    entry->ncolors = ncolors;
+    memcpy(entry->colors, palette->colors, ncolors * sizeof(SDL_Color));
+    entry->masks[0] = fmt->Rmask;
+    entry->masks[1] = fmt->Gmask;
+    entry->masks[2] = fmt->Bmask;
+    entry->masks[3] = fmt->Amask;
+    memcpy(entry->mod, mod, 3);
+    memcpy(entry->table, table, sizeof(entry->table));
+    SDL_AtomicUnlock(&palette_cache_lock);
+    return 1;
+}
+
+#if !defined(__EMSCRIPTEN__) && SDL_BYTEORDER == SDL_LIL_ENDIAN && \
+    (defined(__SSE2__) || PG_ENABLE_ARM_NEON)
+#define PG_HAS_RGB565_SIMD 1
+
+/* If the RGB565 kernels, or their NEON translation, can blit to dst on
+   this CPU. The caller checks the source format. */
+static int
+blit_rgb565_simd(SDL_Surface *src, SDL_Surface *dst)
+{
+    if (src == dst || dst->format->format != SDL_PIXELFORMAT_RGB565) {
+        return 0;
+    }
+#if PG_ENABLE_ARM_NEON
+    if (pg_HasNEON()) {
+        return 1;
+    }
+#endif /* PG_ENABLE_ARM_NEON */
+#ifdef __SSE2__
+    if (pg_HasSSE2()) {
+        return 1;
+    }
+#endif /* __SSE2__ */
+    return 0;
+}
+#endif
+
+/* Use func as the blitter, and its name for pygame.stats() */
+#define PICK_BLITTER(func) \
+    do {                   \
+        blitter = func;    \
+        *name = #func;     \
+    } while (0)
+
+/* Pick the blit kernel for a source and destination pair, and set *name to
+ * its name. Returns NULL, with the SDL error set, for an unknown blend mode.
+ */
+static pg_BlitFunc
+select_blitter(SDL_BlitInfo *info, SDL_Surface *src, SDL_Surface *dst,
+               int the_args, const char **name)
+{
+    pg_BlitFunc blitter = NULL;
+
+    /* Convert alpha multiply blends to regular blends if either of
+     the surfaces don't have alpha channels */
+    if (the_args == PYGAME_BLEND_RGBA_MULT &&
+        (info->src_blend == SDL_BLENDMODE_NONE ||
+         info->dst_blend == SDL_BLENDMODE_NONE)) {
+        the_args = PYGAME_BLEND_MULT;
+    }
+
+    switch (the_args) {
+        case 0: {
+            if (info->s_table) {
+#if !defined(__EMSCRIPTEN__)
+                if (pg_HasAVX2()) {
+                    PICK_BLITTER(blit_palette8_avx2);
+                    break;
+                }
+#if PG_ENABLE_ARM_NEON
+                if (pg_HasNEON()) {
+                    PICK_BLITTER(blit_palette8_sse2);
+                    break;
+                }
+#endif /* PG_ENABLE_ARM_NEON */
+#ifdef __SSE2__
+                if (pg_HasSSE2()) {
+                    PICK_BLITTER(blit_palette8_sse2);
+                    break;
+                }
+#endif /* __SSE2__*/
+#endif /* __EMSCRIPTEN__ */
+                PICK_BLITTER(blit_palette8);
+            }
+            else if (info->src_blend != SDL_BLENDMODE_NONE &&
+                     src->format->Amask) {
 #if !defined(__EMSCRIPTEN__)
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                        if (src->format->BytesPerPixel == 4 &&
-                            dst->format->BytesPerPixel == 4 &&
-                            src->format->Rmask == dst->format->Rmask &&
-                            src->format->Gmask == dst->format->Gmask &&
-                            src->format->Bmask == dst->format->Bmask) {
+                if (src->format->BytesPerPixel == 4 &&
+                    dst->format->BytesPerPixel == 4 &&
+                    src->format->Rmask == dst->format->Rmask &&
+                    src->format->Gmask == dst->format->Gmask &&
+                    src->format->Bmask == dst->format->Bmask) {
 /* If our source and destination are the same ARGB 32bit
-   format we can use SSE2 to speed up the blend */
+   format we can use SIMD to speed up the blend */
+                    if (pg_HasAVX2() && (src != dst)) {
+                        if (info->src_blanket_alpha != 255) {
+                            PICK_BLITTER(alphablit_alpha_avx2_argb_surf_alpha);
+                        }
+                        else {
+                            if (SDL_ISPIXELFORMAT_ALPHA(dst->format->format) &&
+                                info->dst_blend != SDL_BLENDMODE_NONE) {
+                                PICK_BLITTER(
+                                    alphablit_alpha_avx2_argb_no_surf_alpha);
+                            }
+                            else {
+                                PICK_BLITTER(
+                                    alphablit_alpha_avx2_argb_no_surf_alpha_opaque_dst);
+                            }
+                        }
+                        break;
+                    }
 #if PG_ENABLE_ARM_NEON
-                            if ((SDL_HasNEON() == SDL_TRUE) && (src != dst)) {
-                                if (info.src_blanket_alpha != 255) {
-                                    alphablit_alpha_sse2_argb_surf_alpha(
-                                        &info);
-                                }
-                                else {
-                                    if (SDL_ISPIXELFORMAT_ALPHA(
-                                            dst->format->format) &&
-                                        info.dst_blend != SDL_BLENDMODE_NONE) {
-                                        alphablit_alpha_sse2_argb_no_surf_alpha(
-                                            &info);
-                                    }
-                                    else {
-                                        alphablit_alpha_sse2_argb_no_surf_alpha_opaque_dst(
-                                            &info);
-                                    }
-                                }
-                                break;
+                    if (pg_HasNEON() && (src != dst)) {
+                        if (info->src_blanket_alpha != 255) {
+                            PICK_BLITTER(alphablit_alpha_neon_argb_surf_alpha);
+                        }
+                        else {
+                            if (SDL_ISPIXELFORMAT_ALPHA(dst->format->format) &&
+                                info->dst_blend != SDL_BLENDMODE_NONE) {
+                                PICK_BLITTER(
+                                    alphablit_alpha_neon_argb_no_surf_alpha);
+                            }
+                            else {
+                                PICK_BLITTER(
+                                    alphablit_alpha_neon_argb_no_surf_alpha_opaque_dst);
                             }
+                        }
+                        break;
+                    }
 #endif /* PG_ENABLE_ARM_NEON */
 #ifdef __SSE2__
-                            if ((SDL_HasSSE2()) && (src != dst)) {
-                                if (info.src_blanket_alpha != 255) {
-                                    alphablit_alpha_sse2_argb_surf_alpha(
-                                        &info);
-                                }
-                                else {
-                                    if (SDL_ISPIXELFORMAT_ALPHA(
-                                            dst->format->format) &&
-                                        info.dst_blend != SDL_BLENDMODE_NONE) {
-                                        alphablit_alpha_sse2_argb_no_surf_alpha(
-                                            &info);
-                                    }
-                                    else {
-                                        alphablit_alpha_sse2_argb_no_surf_alpha_opaque_dst(
-                                            &info);
-                                    }
-                                }
-                                break;
+                    if (pg_HasSSE2() && (src != dst)) {
+                        if (info->src_blanket_alpha != 255) {
+                            PICK_BLITTER(alphablit_alpha_sse2_argb_surf_alpha);
+                        }
+                        else {
+                            if (SDL_ISPIXELFORMAT_ALPHA(dst->format->format) &&
+                                info->dst_blend != SDL_BLENDMODE_NONE) {
+                                PICK_BLITTER(
+                                    alphablit_alpha_sse2_argb_no_surf_alpha);
+                            }
+                            else {
+                                PICK_BLITTER(
+                                    alphablit_alpha_sse2_argb_no_surf_alpha_opaque_dst);
                             }
-#endif /* __SSE2__*/
                         }
+                        break;
+                    }
+#endif /* __SSE2__*/
+                }
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                        alphablit_alpha(&info);
-                    }
-                    else if (info.src_has_colorkey) {
-                        alphablit_colorkey(&info);
-                    }
-                    else {
-                        alphablit_solid(&info);
-                    }
+#ifdef PG_HAS_RGB565_SIMD
+                if (src->format->BytesPerPixel == 4 &&
+                    src->format->Rloss == 0 && src->format->Gloss == 0 &&
+                    src->format->Bloss == 0 && src->format->Aloss == 0 &&
+                    blit_rgb565_simd(src, dst)) {
+                    PICK_BLITTER(alphablit_alpha_sse2_argb_rgb565);
                     break;
                 }
-                case PYGAME_BLEND_ADD: {
+#endif /* PG_HAS_RGB565_SIMD */
+                PICK_BLITTER(alphablit_alpha);
+            }
+            else if (info->src_has_colorkey) {
+                PICK_BLITTER(alphablit_colorkey);
+            }
+            else {
+                PICK_BLITTER(alphablit_solid);
+            }
+            break;
+        }
+        case PYGAME_BLEND_ADD: {
 #if !defined(__EMSCRIPTEN__)
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        !(src->format->Amask != 0 && dst->format->Amask != 0 &&
-                          src->format->Amask != dst->format->Amask) &&
-                        SDL_HasAVX2() && (src != dst)) {
-                        blit_blend_rgb_add_avx2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                !(src->format->Amask != 0 && dst->format->Amask != 0 &&
+                  src->format->Amask != dst->format->Amask) &&
+                pg_HasAVX2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgb_add_avx2);
+                break;
+            }
 #if defined(__SSE2__)
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        !(src->format->Amask != 0 && dst->format->Amask != 0 &&
-                          src->format->Amask != dst->format->Amask) &&
-                        SDL_HasSSE2() && (src != dst)) {
-                        blit_blend_rgb_add_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                !(src->format->Amask != 0 && dst->format->Amask != 0 &&
+                  src->format->Amask != dst->format->Amask) &&
+                pg_HasSSE2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgb_add_sse2);
+                break;
+            }
 #endif /* __SSE2__*/
 #if PG_ENABLE_ARM_NEON
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        !(src->format->Amask != 0 && dst->format->Amask != 0 &&
-                          src->format->Amask != dst->format->Amask) &&
-                        SDL_HasNEON() && (src != dst)) {
-                        blit_blend_rgb_add_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                !(src->format->Amask != 0 && dst->format->Amask != 0 &&
+                  src->format->Amask != dst->format->Amask) &&
+                pg_HasNEON() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgb_add_sse2);
+                break;
+            }
 #endif /* PG_ENABLE_ARM_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_add(&info);
-                    break;
-                }
-                case PYGAME_BLEND_SUB: {
+#ifdef PG_HAS_RGB565_SIMD
+            if (src->format->format == SDL_PIXELFORMAT_RGB565 &&
+                blit_rgb565_simd(src, dst)) {
+                PICK_BLITTER(blit_blend_rgb565_add_sse2);
+                break;
+            }
+#endif /* PG_HAS_RGB565_SIMD */
+            PICK_BLITTER(blit_blend_add);
+            break;
+        }
+        case PYGAME_BLEND_SUB: {
 #if !defined(__EMSCRIPTEN__)
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        !(src->format->Amask != 0 && dst->format->Amask != 0 &&
-                          src->format->Amask != dst->format->Amask) &&
-                        SDL_HasAVX2() && (src != dst)) {
-                        blit_blend_rgb_sub_avx2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                !(src->format->Amask != 0 && dst->format->Amask != 0 &&
+                  src->format->Amask != dst->format->Amask) &&
+                pg_HasAVX2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgb_sub_avx2);
+                break;
+            }
 #if defined(__SSE2__)
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        !(src->format->Amask != 0 && dst->format->Amask != 0 &&
-                          src->format->Amask != dst->format->Amask) &&
-                        SDL_HasSSE2() && (src != dst)) {
-                        blit_blend_rgb_sub_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                !(src->format->Amask != 0 && dst->format->Amask != 0 &&
+                  src->format->Amask != dst->format->Amask) &&
+                pg_HasSSE2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgb_sub_sse2);
+                break;
+            }
 #endif /* __SSE2__*/
 #if PG_ENABLE_ARM_NEON
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        !(src->format->Amask != 0 && dst->format->Amask != 0 &&
-                          src->format->Amask != dst->format->Amask) &&
-                        SDL_HasNEON() && (src != dst)) {
-                        blit_blend_rgb_sub_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                !(src->format->Amask != 0 && dst->format->Amask != 0 &&
+                  src->format->Amask != dst->format->Amask) &&
+                pg_HasNEON() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgb_sub_sse2);
+                break;
+            }
 #endif /* PG_ENABLE_ARM_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_sub(&info);
-                    break;
-                }
-                case PYGAME_BLEND_MULT: {
+#ifdef PG_HAS_RGB565_SIMD
+            if (src->format->format == SDL_PIXELFORMAT_RGB565 &&
+                blit_rgb565_simd(src, dst)) {
+                PICK_BLITTER(blit_blend_rgb565_sub_sse2);
+                break;
+            }
+#endif /* PG_HAS_RGB565_SIMD */
+            PICK_BLITTER(blit_blend_sub);
+            break;
+        }
+        case PYGAME_BLEND_MULT: {
 #if !defined(__EMSCRIPTEN__)
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        !(src->format->Amask != 0 && dst->format->Amask != 0 &&
-                          src->format->Amask != dst->format->Amask) &&
-                        SDL_HasAVX2() && (src != dst)) {
-                        blit_blend_rgb_mul_avx2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                !(src->format->Amask != 0 && dst->format->Amask != 0 &&
+                  src->format->Amask != dst->format->Amask) &&
+                pg_HasAVX2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgb_mul_avx2);
+                break;
+            }
 #if defined(__SSE2__)
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        !(src->format->Amask != 0 && dst->format->Amask != 0 &&
-                          src->format->Amask != dst->format->Amask) &&
-                        SDL_HasSSE2() && (src != dst)) {
-                        blit_blend_rgb_mul_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                !(src->format->Amask != 0 && dst->format->Amask != 0 &&
+                  src->format->Amask != dst->format->Amask) &&
+                pg_HasSSE2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgb_mul_sse2);
+                break;
+            }
 #endif /* __SSE2__*/
 #if PG_ENABLE_ARM_NEON
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        !(src->format->Amask != 0 && dst->format->Amask != 0 &&
-                          src->format->Amask != dst->format->Amask) &&
-                        SDL_HasNEON() && (src != dst)) {
-                        blit_blend_rgb_mul_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                !(src->format->Amask != 0 && dst->format->Amask != 0 &&
+                  src->format->Amask != dst->format->Amask) &&
+                pg_HasNEON() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgb_mul_sse2);
+                break;
+            }
 #endif /* PG_ENABLE_ARM_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_mul(&info);
-                    break;
-                }
-                case PYGAME_BLEND_MIN: {
+#ifdef PG_HAS_RGB565_SIMD
+            if (src->format->format == SDL_PIXELFORMAT_RGB565 &&
+                blit_rgb565_simd(src, dst)) {
+                PICK_BLITTER(blit_blend_rgb565_mul_sse2);
+                break;
+            }
+#endif /* PG_HAS_RGB565_SIMD */
+            PICK_BLITTER(blit_blend_mul);
+            break;
+        }
+        case PYGAME_BLEND_MIN: {
 #if !defined(__EMSCRIPTEN__)
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        !(src->format->Amask != 0 && dst->format->Amask != 0 &&
-                          src->format->Amask != dst->format->Amask) &&
-                        SDL_HasAVX2() && (src != dst)) {
-                        blit_blend_rgb_min_avx2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                !(src->format->Amask != 0 && dst->format->Amask != 0 &&
+                  src->format->Amask != dst->format->Amask) &&
+                pg_HasAVX2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgb_min_avx2);
+                break;
+            }
 #if defined(__SSE2__)
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        !(src->format->Amask != 0 && dst->format->Amask != 0 &&
-                          src->format->Amask != dst->format->Amask) &&
-                        SDL_HasSSE2() && (src != dst)) {
-                        blit_blend_rgb_min_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                !(src->format->Amask != 0 && dst->format->Amask != 0 &&
+                  src->format->Amask != dst->format->Amask) &&
+                pg_HasSSE2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgb_min_sse2);
+                break;
+            }
 #endif /* __SSE2__*/
 #if PG_ENABLE_ARM_NEON
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        !(src->format->Amask != 0 && dst->format->Amask != 0 &&
-                          src->format->Amask != dst->format->Amask) &&
-                        SDL_HasNEON() && (src != dst)) {
-                        blit_blend_rgb_min_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                !(src->format->Amask != 0 && dst->format->Amask != 0 &&
+                  src->format->Amask != dst->format->Amask) &&
+                pg_HasNEON() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgb_min_sse2);
+                break;
+            }
 #endif /* PG_ENABLE_ARM_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_min(&info);
-                    break;
-                }
-                case PYGAME_BLEND_MAX: {
+#ifdef PG_HAS_RGB565_SIMD
+            if (src->format->format == SDL_PIXELFORMAT_RGB565 &&
+                blit_rgb565_simd(src, dst)) {
+                PICK_BLITTER(blit_blend_rgb565_min_sse2);
+                break;
+            }
+#endif /* PG_HAS_RGB565_SIMD */
+            PICK_BLITTER(blit_blend_min);
+            break;
+        }
+        case PYGAME_BLEND_MAX: {
 #if !defined(__EMSCRIPTEN__)
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        !(src->format->Amask != 0 && dst->format->Amask != 0 &&
-                          src->format->Amask != dst->format->Amask) &&
-                        SDL_HasAVX2() && (src != dst)) {
-                        blit_blend_rgb_max_avx2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                !(src->format->Amask != 0 && dst->format->Amask != 0 &&
+                  src->format->Amask != dst->format->Amask) &&
+                pg_HasAVX2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgb_max_avx2);
+                break;
+            }
 #if defined(__SSE2__)
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        !(src->format->Amask != 0 && dst->format->Amask != 0 &&
-                          src->format->Amask != dst->format->Amask) &&
-                        SDL_HasSSE2() && (src != dst)) {
-                        blit_blend_rgb_max_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                !(src->format->Amask != 0 && dst->format->Amask != 0 &&
+                  src->format->Amask != dst->format->Amask) &&
+                pg_HasSSE2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgb_max_sse2);
+                break;
+            }
 #endif /* __SSE2__*/
 #if PG_ENABLE_ARM_NEON
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        !(src->format->Amask != 0 && dst->format->Amask != 0 &&
-                          src->format->Amask != dst->format->Amask) &&
-                        SDL_HasNEON() && (src != dst)) {
-                        blit_blend_rgb_max_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                !(src->format->Amask != 0 && dst->format->Amask != 0 &&
+                  src->format->Amask != dst->format->Amask) &&
+                pg_HasNEON() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgb_max_sse2);
+                break;
+            }
 #endif /* PG_ENABLE_ARM_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_max(&info);
-                    break;
-                }
+#ifdef PG_HAS_RGB565_SIMD
+            if (src->format->format == SDL_PIXELFORMAT_RGB565 &&
+                blit_rgb565_simd(src, dst)) {
+                PICK_BLITTER(blit_blend_rgb565_max_sse2);
+                break;
+            }
+#endif /* PG_HAS_RGB565_SIMD */
+            PICK_BLITTER(blit_blend_max);
+            break;
+        }
 
-                case PYGAME_BLEND_RGBA_ADD: {
+        case PYGAME_BLEND_RGBA_ADD: {
 #if !defined(__EMSCRIPTEN__)
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        info.src_blend != SDL_BLENDMODE_NONE &&
-                        SDL_HasAVX2() && (src != dst)) {
-                        blit_blend_rgba_add_avx2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                info->src_blend != SDL_BLENDMODE_NONE &&
+                pg_HasAVX2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgba_add_avx2);
+                break;
+            }
 #if defined(__SSE2__)
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        info.src_blend != SDL_BLENDMODE_NONE &&
-                        SDL_HasSSE2() && (src != dst)) {
-                        blit_blend_rgba_add_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                info->src_blend != SDL_BLENDMODE_NONE &&
+                pg_HasSSE2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgba_add_sse2);
+                break;
+            }
 #endif /* __SSE2__*/
 #if PG_ENABLE_ARM_NEON
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        info.src_blend != SDL_BLENDMODE_NONE &&
-                        SDL_HasNEON() && (src != dst)) {
-                        blit_blend_rgba_add_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                info->src_blend != SDL_BLENDMODE_NONE &&
+                pg_HasNEON() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgba_add_sse2);
+                break;
+            }
 #endif /* PG_ENABLE_ARM_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_rgba_add(&info);
-                    break;
-                }
-                case PYGAME_BLEND_RGBA_SUB: {
+            PICK_BLITTER(blit_blend_rgba_add);
+            break;
+        }
+        case PYGAME_BLEND_RGBA_SUB: {
 #if !defined(__EMSCRIPTEN__)
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        info.src_blend != SDL_BLENDMODE_NONE &&
-                        SDL_HasAVX2() && (src != dst)) {
-                        blit_blend_rgba_sub_avx2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                info->src_blend != SDL_BLENDMODE_NONE &&
+                pg_HasAVX2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgba_sub_avx2);
+                break;
+            }
 #if defined(__SSE2__)
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        info.src_blend != SDL_BLENDMODE_NONE &&
-                        SDL_HasSSE2() && (src != dst)) {
-                        blit_blend_rgba_sub_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                info->src_blend != SDL_BLENDMODE_NONE &&
+                pg_HasSSE2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgba_sub_sse2);
+                break;
+            }
 #endif /* __SSE2__*/
 #if PG_ENABLE_ARM_NEON
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        info.src_blend != SDL_BLENDMODE_NONE &&
-                        SDL_HasNEON() && (src != dst)) {
-                        blit_blend_rgba_sub_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                info->src_blend != SDL_BLENDMODE_NONE &&
+                pg_HasNEON() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgba_sub_sse2);
+                break;
+            }
 #endif /* PG_ENABLE_ARM_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_rgba_sub(&info);
-                    break;
-                }
-                case PYGAME_BLEND_RGBA_MULT: {
+            PICK_BLITTER(blit_blend_rgba_sub);
+            break;
+        }
+        case PYGAME_BLEND_RGBA_MULT: {
 #if !defined(__EMSCRIPTEN__)
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        info.src_blend != SDL_BLENDMODE_NONE &&
-                        SDL_HasAVX2() && (src != dst)) {
-                        blit_blend_rgba_mul_avx2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                info->src_blend != SDL_BLENDMODE_NONE &&
+                pg_HasAVX2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgba_mul_avx2);
+                break;
+            }
 #if defined(__SSE2__)
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        info.src_blend != SDL_BLENDMODE_NONE &&
-                        SDL_HasSSE2() && (src != dst)) {
-                        blit_blend_rgba_mul_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                info->src_blend != SDL_BLENDMODE_NONE &&
+                pg_HasSSE2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgba_mul_sse2);
+                break;
+            }
 #endif /* __SSE2__*/
 #if PG_ENABLE_ARM_NEON
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        info.src_blend != SDL_BLENDMODE_NONE &&
-                        SDL_HasNEON() && (src != dst)) {
-                        blit_blend_rgba_mul_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                info->src_blend != SDL_BLENDMODE_NONE &&
+                pg_HasNEON() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgba_mul_sse2);
+                break;
+            }
 #endif /* PG_ENABLE_ARM_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_rgba_mul(&info);
-                    break;
-                }
-                case PYGAME_BLEND_RGBA_MIN: {
+            PICK_BLITTER(blit_blend_rgba_mul);
+            break;
+        }
+        case PYGAME_BLEND_RGBA_MIN: {
 #if !defined(__EMSCRIPTEN__)
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        info.src_blend != SDL_BLENDMODE_NONE &&
-                        SDL_HasAVX2() && (src != dst)) {
-                        blit_blend_rgba_min_avx2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                info->src_blend != SDL_BLENDMODE_NONE &&
+                pg_HasAVX2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgba_min_avx2);
+                break;
+            }
 #if defined(__SSE2__)
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        info.src_blend != SDL_BLENDMODE_NONE &&
-                        SDL_HasSSE2() && (src != dst)) {
-                        blit_blend_rgba_min_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                info->src_blend != SDL_BLENDMODE_NONE &&
+                pg_HasSSE2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgba_min_sse2);
+                break;
+            }
 #endif /* __SSE2__*/
 #if PG_ENABLE_ARM_NEON
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        info.src_blend != SDL_BLENDMODE_NONE &&
-                        SDL_HasNEON() && (src != dst)) {
-                        blit_blend_rgba_min_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                info->src_blend != SDL_BLENDMODE_NONE &&
+                pg_HasNEON() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgba_min_sse2);
+                break;
+            }
 #endif /* PG_ENABLE_ARM_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_rgba_min(&info);
-                    break;
-                }
-                case PYGAME_BLEND_RGBA_MAX: {
+            PICK_BLITTER(blit_blend_rgba_min);
+            break;
+        }
+        case PYGAME_BLEND_RGBA_MAX: {
 #if !defined(__EMSCRIPTEN__)
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        info.src_blend != SDL_BLENDMODE_NONE &&
-                        SDL_HasAVX2() && (src != dst)) {
-                        blit_blend_rgba_max_avx2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                info->src_blend != SDL_BLENDMODE_NONE &&
+                pg_HasAVX2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgba_max_avx2);
+                break;
+            }
 #if defined(__SSE2__)
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        info.src_blend != SDL_BLENDMODE_NONE &&
-                        SDL_HasSSE2() && (src != dst)) {
-                        blit_blend_rgba_max_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                info->src_blend != SDL_BLENDMODE_NONE &&
+                pg_HasSSE2() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgba_max_sse2);
+                break;
+            }
 #endif /* __SSE2__*/
 #if PG_ENABLE_ARM_NEON
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        info.src_blend != SDL_BLENDMODE_NONE &&
-                        SDL_HasNEON() && (src != dst)) {
-                        blit_blend_rgba_max_sse2(&info);
-                        break;
-                    }
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                info->src_blend != SDL_BLENDMODE_NONE &&
+                pg_HasNEON() && (src != dst)) {
+                PICK_BLITTER(blit_blend_rgba_max_sse2);
+                break;
+            }
 #endif /* PG_ENABLE_ARM_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_rgba_max(&info);
-                    break;
-                }
-                case PYGAME_BLEND_PREMULTIPLIED: {
-                    if (src->format->BytesPerPixel == 4 &&
-                        dst->format->BytesPerPixel == 4 &&
-                        src->format->Rmask == dst->format->Rmask &&
-                        src->format->Gmask == dst->format->Gmask &&
-                        src->format->Bmask == dst->format->Bmask &&
-                        info.src_blend != SDL_BLENDMODE_NONE) {
+            PICK_BLITTER(blit_blend_rgba_max);
+            break;
+        }
+        case PYGAME_BLEND_PREMULTIPLIED: {
+            if (src->format->BytesPerPixel == 4 &&
+                dst->format->BytesPerPixel == 4 &&
+                src->format->Rmask == dst->format->Rmask &&
+                src->format->Gmask == dst->format->Gmask &&
+                src->format->Bmask == dst->format->Bmask &&
+                info->src_blend != SDL_BLENDMODE_NONE) {
 #if defined(__MMX__) || defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)
 #if PG_ENABLE_ARM_NEON
-                        if (SDL_HasNEON() == SDL_TRUE) {
-                            blit_blend_premultiplied_sse2(&info);
-                            break;
-                        }
+                if (pg_HasNEON()) {
+                    PICK_BLITTER(blit_blend_premultiplied_sse2);
+                    break;
+                }
 #endif /* PG_ENABLE_ARM_NEON */
 #ifdef __SSE2__
-                        if (SDL_HasSSE2()) {
-                            blit_blend_premultiplied_sse2(&info);
-                            break;
-                        }
+                if (pg_HasSSE2()) {
+                    PICK_BLITTER(blit_blend_premultiplied_sse2);
+                    break;
+                }
 #endif /* __SSE2__*/
 #ifdef __MMX__
-                        if (SDL_HasMMX() == SDL_TRUE) {
-                            blit_blend_premultiplied_mmx(&info);
-                            break;
-                        }
+                if (pg_HasMMX()) {
+                    PICK_BLITTER(blit_blend_premultiplied_mmx);
+                    break;
+                }
 #endif /*__MMX__*/
 #endif /*__MMX__ || __SSE2__ || PG_ENABLE_ARM_NEON*/
-                    }
+            }
 
-                    blit_blend_premultiplied(&info);
-                    break;
-                }
-                default: {
-                    SDL_SetError("Invalid argument passed to blit.");
-                    okay = 0;
-                    break;
+            PICK_BLITTER(blit_blend_premultiplied);
+            break;
+        }
+        default: {
+            SDL_SetError("Invalid argument passed to blit.");
+            break;
+        }
+    }
+    return blitter;
+}
+
+#undef PICK_BLITTER
+
+/* Whether spans fit a blit set up in info: a plain blit using the same
+ * kind of transparency the runs were recorded for.
+ */
+static int
+spans_match(const pgBlitSpans *spans, SDL_BlitInfo *info, int the_args)
+{
+    if (!spans || !spans->runs || the_args != 0 || info->s_pxskip < 0) {
+        return 0;
+    }
+    if (info->src_blend != SDL_BLENDMODE_NONE && info->src->Amask) {
+        return spans->mode == PG_SPANS_ALPHA;
+    }
+    return info->src_has_colorkey && spans->mode == PG_SPANS_KEY &&
+           spans->colorkey == info->src_colorkey;
+}
+
+static int
+SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
+               SDL_Rect *dstrect, int the_args, const pgBlitSpans *spans)
+{
+    int okay;
+    int src_locked;
+    int dst_locked;
+
+    /* Everything is okay at the beginning...  */
+    okay = 1;
+
+    /* Lock the destination if it's in hardware */
+    dst_locked = 0;
+    if (SDL_MUSTLOCK(dst)) {
+        if (SDL_LockSurface(dst) < 0)
+            okay = 0;
+        else
+            dst_locked = 1;
+    }
+    /* Lock the source if it's in hardware */
+    src_locked = 0;
+    if (SDL_MUSTLOCK(src)) {
+        if (SDL_LockSurface(src) < 0)
+            okay = 0;
+        else
+            src_locked = 1;
+    }
+
+    /* Set up source and destination buffer pointers, and BLIT! */
+    if (okay && srcrect->w && srcrect->h) {
+        SDL_BlitInfo info;
+        pg_BlitFunc blitter = NULL;
+        const char *name = NULL;
+        Uint32 table[256];
+
+        /* Set up the blit information */
+        info.width = srcrect->w;
+        info.height = srcrect->h;
+        info.s_pixels = (Uint8 *)src->pixels +
+                        (Uint16)srcrect->y * src->pitch +
+                        (Uint16)srcrect->x * src->format->BytesPerPixel;
+        info.s_pxskip = src->format->BytesPerPixel;
+        info.s_skip = src->pitch - info.width * src->format->BytesPerPixel;
+        info.d_pixels = (Uint8 *)dst->pixels +
+                        (Uint16)dstrect->y * dst->pitch +
+                        (Uint16)dstrect->x * dst->format->BytesPerPixel;
+        info.d_pxskip = dst->format->BytesPerPixel;
+        info.d_skip = dst->pitch - info.width * dst->format->BytesPerPixel;
+        info.src = src->format;
+        info.dst = dst->format;
+        SDL_GetSurfaceAlphaMod(src, &info.src_blanket_alpha);
+        info.src_has_colorkey = SDL_GetColorKey(src, &info.src_colorkey) == 0;
+        if (SDL_GetSurfaceBlendMode(src, &info.src_blend) ||
+            SDL_GetSurfaceBlendMode(dst, &info.dst_blend)) {
+            okay = 0;
+        }
+        if (okay) {
+            if (info.d_pixels > info.s_pixels) {
+                int span = info.width * info.src->BytesPerPixel;
+                Uint8 *srcpixend =
+                    info.s_pixels + (info.height - 1) * src->pitch + span;
+
+                if (info.d_pixels < srcpixend) {
+                    int dstoffset =
+                        (info.d_pixels - info.s_pixels) % src->pitch;
+
+                    if (dstoffset < span || dstoffset > src->pitch - span) {
+                        /* Overlapping Self blit with positive destination
+                           offset. Reverse direction of the blit.
+                        */
+                        info.s_pixels = srcpixend - info.s_pxskip;
+                        info.s_pxskip = -info.s_pxskip;
+                        info.s_skip = -info.s_skip;
+                        info.d_pixels =
+                            (info.d_pixels + (info.height - 1) * dst->pitch +
+                             span - info.d_pxskip);
+                        info.d_pxskip = -info.d_pxskip;
+                        info.d_skip = -info.d_skip;
+                    }
                 }
             }
+            info.s_table =
+                palette_table(&info, src, dst, the_args, table) ? table : NULL;
+            blitter = select_blitter(&info, src, dst, the_args, &name);
+            if (!blitter) {
+                okay = 0;
+            }
+            /* copies along the runs could overlap in a self blit */
+            info.s_spans = src->pixels != dst->pixels &&
+                                   spans_match(spans, &info, the_args)
+                               ? spans
+                               : NULL;
+            info.s_x = srcrect->x;
+            info.s_y = srcrect->y;
+        }
+        if (okay) {
+            run_blitter(blitter, name, &info, src, dst);
         }
     }
 
@@ -2658,7 +3176,7 @@ blit_blend_max(SDL_BlitInfo *info)
 /* --------------------------------------------------------- */
 
 #if (defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON))
-static void
+void
 alphablit_alpha_sse2_argb_surf_alpha(SDL_BlitInfo *info)
 {
     int n;
@@ -2803,7 +3321,7 @@ alphablit_alpha_sse2_argb_surf_alpha(SDL_BlitInfo *info)
     }
 }
 
-static void
+void
 alphablit_alpha_sse2_argb_no_surf_alpha(SDL_BlitInfo *info)
 {
     int n;
@@ -3177,7 +3695,7 @@ alphablit_alpha_sse2_argb_no_surf_alpha(SDL_BlitInfo *info)
     }
 }
 
-static void
+void
 alphablit_alpha_sse2_argb_no_surf_alpha_opaque_dst(SDL_BlitInfo *info)
 {
     int n;
@@ -3427,6 +3945,146 @@ alphablit_alpha_sse2_argb_no_surf_alpha_opaque_dst(SDL_BlitInfo *info)
 
 #endif /* (defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)) */
 
+#if PG_ENABLE_ARM_NEON
+/* Native NEON versions of the SSE2 ARGB alpha blitters above. vld4_u8
+   splits eight pixels into B, G, R and A planes, so each channel is
+   blended eight at a time. The results match the SSE2 versions:
+
+       dstRGB = (((dstRGB << 8) + (srcRGB - dstRGB) * srcA + srcRGB) >> 8)
+         dstA = srcA + dstA - ((srcA * dstA) / 255);
+
+   A source alpha of 255 already copies the source colour with this
+   equation, so the "dst alpha is 0" copy is done by raising the alpha used
+   for RGB to 255 for those pixels. */
+
+/* (x / 255) for x <= 255 * 255 */
+static PG_INLINE uint8x8_t
+neon_div255(uint16x8_t x)
+{
+    return vshrn_n_u16(vaddq_u16(vsraq_n_u16(x, x, 8), vdupq_n_u16(1)), 8);
+}
+
+static PG_INLINE uint8x8_t
+neon_blend_channel(uint8x8_t src, uint8x8_t dst, uint16x8_t alpha)
+{
+    /* ((dst << 8) + (src - dst) * alpha + src) >> 8, rearranged to stay
+       unsigned as (dst * (256 - alpha) + src * (alpha + 1)) >> 8 */
+    uint16x8_t sum =
+        vmulq_u16(vmovl_u8(dst), vsubq_u16(vdupq_n_u16(256), alpha));
+    sum = vmlaq_u16(sum, vmovl_u8(src), vaddq_u16(alpha, vdupq_n_u16(1)));
+    return vshrn_n_u16(sum, 8);
+}
+
+/* Blend src into dst, using src_alpha for RGB and dst_alpha for the
+   resulting alpha. copy holds 0xFF for pixels that should take the source
+   colour unchanged. */
+static PG_INLINE void
+neon_blend_argb(uint8x8x4_t *src, uint8x8x4_t *dst, uint8x8_t src_alpha,
+                uint8x8_t dst_alpha, uint8x8_t copy)
+{
+    uint16x8_t rgb_alpha = vmovl_u8(vorr_u8(src_alpha, copy));
+
+    dst->val[0] = neon_blend_channel(src->val[0], dst->val[0], rgb_alpha);
+    dst->val[1] = neon_blend_channel(src->val[1], dst->val[1], rgb_alpha);
+    dst->val[2] = neon_blend_channel(src->val[2], dst->val[2], rgb_alpha);
+    /* wrapping 8 bit arithmetic, the end result always fits */
+    dst->val[3] = vsub_u8(vadd_u8(src_alpha, dst_alpha),
+                          neon_div255(vmull_u8(src_alpha, dst_alpha)));
+}
+
+/* Run kernel (which updates mm_dst from mm_src) over every row of the
+   blit, eight pixels at a time. The last (width % 8) pixels of a row go
+   through a small stack buffer. */
+#define RUN_NEON_ALPHA_KERNEL(kernel)                                     \
+    int n;                                                                \
+    int width = info->width;                                              \
+    int height = info->height;                                            \
+    Uint32 *srcp = (Uint32 *)info->s_pixels;                              \
+    int srcskip = info->s_skip >> 2;                                      \
+    Uint32 *dstp = (Uint32 *)info->d_pixels;                              \
+    int dstskip = info->d_skip >> 2;                                      \
+    int pre_8_width = width % 8;                                          \
+    int post_8_width = width / 8;                                         \
+    Uint32 src_tail[8], dst_tail[8];                                      \
+    uint8x8x4_t mm_src, mm_dst;                                           \
+                                                                          \
+    while (height--) {                                                    \
+        if (post_8_width > 0) {                                           \
+            LOOP_UNROLLED4(                                               \
+                {                                                         \
+                    mm_src = vld4_u8((Uint8 *)srcp);                      \
+                    mm_dst = vld4_u8((Uint8 *)dstp);                      \
+                    kernel;                                               \
+                    vst4_u8((Uint8 *)dstp, mm_dst);                       \
+                    srcp += 8;                                            \
+                    dstp += 8;                                            \
+                },                                                        \
+                n, post_8_width);                                         \
+        }                                                                 \
+        if (pre_8_width > 0) {                                            \
+            memcpy(src_tail, srcp, pre_8_width * sizeof(Uint32));         \
+            memcpy(dst_tail, dstp, pre_8_width * sizeof(Uint32));         \
+            mm_src = vld4_u8((Uint8 *)src_tail);                          \
+            mm_dst = vld4_u8((Uint8 *)dst_tail);                          \
+            kernel;                                                       \
+            vst4_u8((Uint8 *)dst_tail, mm_dst);                           \
+            memcpy(dstp, dst_tail, pre_8_width * sizeof(Uint32));         \
+            srcp += pre_8_width;                                          \
+            dstp += pre_8_width;                                          \
+        }                                                                 \
+        srcp += srcskip;                                                  \
+        dstp += dstskip;                                                  \
+    }
+
+static void
+alphablit_alpha_neon_argb_surf_alpha(SDL_BlitInfo *info)
+{
+    uint8x8_t mm_zero = vdup_n_u8(0);
+    uint8x8_t mm_modulate = vdup_n_u8(info->src_blanket_alpha);
+    /* a destination without an alpha mask counts as 0 alpha in the result
+       alpha, but is never copied over */
+    uint8x8_t mm_has_dst_alpha = vdup_n_u8(info->dst->Amask ? 0xFF : 0);
+    uint8x8_t mm_src_alpha, mm_dst_alpha;
+
+    RUN_NEON_ALPHA_KERNEL({
+        mm_src_alpha = neon_div255(vmull_u8(mm_src.val[3], mm_modulate));
+        mm_dst_alpha = vand_u8(mm_dst.val[3], mm_has_dst_alpha);
+        neon_blend_argb(
+            &mm_src, &mm_dst, mm_src_alpha, mm_dst_alpha,
+            vand_u8(vceq_u8(mm_dst_alpha, mm_zero), mm_has_dst_alpha));
+    });
+}
+
+static void
+alphablit_alpha_neon_argb_no_surf_alpha(SDL_BlitInfo *info)
+{
+    uint8x8_t mm_zero = vdup_n_u8(0);
+
+    RUN_NEON_ALPHA_KERNEL({
+        neon_blend_argb(&mm_src, &mm_dst, mm_src.val[3], mm_dst.val[3],
+                        vceq_u8(mm_dst.val[3], mm_zero));
+    });
+}
+
+static void
+alphablit_alpha_neon_argb_no_surf_alpha_opaque_dst(SDL_BlitInfo *info)
+{
+    uint16x8_t mm_src_alpha;
+
+    RUN_NEON_ALPHA_KERNEL({
+        mm_src_alpha = vmovl_u8(mm_src.val[3]);
+        mm_dst.val[0] =
+            neon_blend_channel(mm_src.val[0], mm_dst.val[0], mm_src_alpha);
+        mm_dst.val[1] =
+            neon_blend_channel(mm_src.val[1], mm_dst.val[1], mm_src_alpha);
+        mm_dst.val[2] =
+            neon_blend_channel(mm_src.val[2], mm_dst.val[2], mm_src_alpha);
+        /* reset alpha to 0 */
+        mm_dst.val[3] = vdup_n_u8(0);
+    });
+}
+#endif /* PG_ENABLE_ARM_NEON */
+
 static void
 alphablit_alpha(SDL_BlitInfo *info)
 {
@@ -3825,10 +4483,54 @@ alphablit_solid(SDL_BlitInfo *info)
     }
 }
 
+/* Blit 8 bit pixels to 32 bit ones by looking them up in info->s_table,
+ * leaving out the pixels of the colorkey if there is one.
+ */
+static void
+blit_palette8(SDL_BlitInfo *info)
+{
+    int n;
+    int width = info->width;
+    int height = info->height;
+    Uint8 *src = info->s_pixels;
+    int srcskip = info->s_skip;
+    Uint32 *dst = (Uint32 *)info->d_pixels;
+    int dstskip = info->d_skip >> 2;
+    const Uint32 *table = info->s_table;
+    Uint32 key = info->src_colorkey;
+
+    if (info->src_has_colorkey) {
+        while (height--) {
+            LOOP_UNROLLED4(
+                {
+                    if (*src != key) {
+                        *dst = table[*src];
+                    }
+                    src++;
+                    dst++;
+                },
+                n, width);
+            src += srcskip;
+            dst += dstskip;
+        }
+    }
+    else {
+        while (height--) {
+            LOOP_UNROLLED4(
+                {
+                    *dst++ = table[*src++];
+                },
+                n, width);
+            src += srcskip;
+            dst += dstskip;
+        }
+    }
+}
+
 /*we assume the "dst" has pixel alpha*/
 int
 pygame_Blit(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
-            SDL_Rect *dstrect, int the_args)
+            SDL_Rect *dstrect, int the_args, const pgBlitSpans *spans)
 {
     SDL_Rect fulldst;
     int srcx, srcy, w, h;
@@ -3914,15 +4616,133 @@ pygame_Blit(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
         sr.y = srcy;
         sr.w = dstrect->w = w;
         sr.h = dstrect->h = h;
-        return SoftBlitPyGame(src, &sr, dst, dstrect, the_args);
+        return SoftBlitPyGame(src, &sr, dst, dstrect, the_args, spans);
     }
     dstrect->w = dstrect->h = 0;
     return 0;
 }
 
+/* Blit the whole of src at count (x, y) positions of dst, taking the
+   surface locks and picking the blitter once for the batch. */
+int
+pygame_BlitMany(SDL_Surface *src, SDL_Surface *dst, const int *positions,
+                Py_ssize_t count, int the_args, const pgBlitSpans *spans)
+{
+    SDL_BlitInfo info;
+    SDL_Rect *clip;
+    pg_BlitFunc blitter = NULL;
+    const char *name = NULL;
+    Uint32 table[256];
+    Py_ssize_t i;
+    int okay = 1;
+    int src_locked = 0;
+    int dst_locked = 0;
+
+    if (!src || !dst) {
+        SDL_SetError("pygame_BlitMany: passed a NULL surface");
+        return (-1);
+    }
+    if (src->locked || dst->locked) {
+        SDL_SetError(
+            "pygame_BlitMany: Surfaces must not be locked during blit");
+        return (-1);
+    }
+
+    /* Self blits may need the row order reversed, which depends on each
+       position, so leave them to pygame_Blit */
+    if (src->pixels == dst->pixels) {
+        for (i = 0; i < count; ++i) {
+            SDL_Rect dstrect;
+
+            dstrect.x = positions[2 * i];
+            dstrect.y = positions[2 * i + 1];
+            if (pygame_Blit(src, NULL, dst, &dstrect, the_args, spans)) {
+                return (-1);
+            }
+        }
+        return 0;
+    }
+
+    if (SDL_MUSTLOCK(dst)) {
+        if (SDL_LockSurface(dst) < 0)
+            okay = 0;
+        else
+            dst_locked = 1;
+    }
+    if (SDL_MUSTLOCK(src)) {
+        if (SDL_LockSurface(src) < 0)
+            okay = 0;
+        else
+            src_locked = 1;
+    }
+
+    if (okay) {
+        info.s_pxskip = src->format->BytesPerPixel;
+        info.d_pxskip = dst->format->BytesPerPixel;
+        info.src = src->format;
+        info.dst = dst->format;
+        SDL_GetSurfaceAlphaMod(src, &info.src_blanket_alpha);
+        info.src_has_colorkey = SDL_GetColorKey(src, &info.src_colorkey) == 0;
+        if (SDL_GetSurfaceBlendMode(src, &info.src_blend) ||
+            SDL_GetSurfaceBlendMode(dst, &info.dst_blend)) {
+            okay = 0;
+        }
+    }
+    if (okay) {
+        info.s_table =
+            palette_table(&info, src, dst, the_args, table) ? table : NULL;
+        blitter = select_blitter(&info, src, dst, the_args, &name);
+        if (!blitter) {
+            okay = 0;
+        }
+        info.s_spans = spans_match(spans, &info, the_args) ? spans : NULL;
+    }
+
+    clip = &dst->clip_rect;
+    for (i = 0; okay && i < count; ++i) {
+        /* clip the destination rectangle against the clip rectangle, in
+           64 bits as the positions can be anywhere in the int range */
+        Sint64 x0 = positions[2 * i];
+        Sint64 y0 = positions[2 * i + 1];
+        Sint64 left = MAX(x0, clip->x);
+        Sint64 top = MAX(y0, clip->y);
+        Sint64 right = MIN(x0 + src->w, (Sint64)clip->x + clip->w);
+        Sint64 bottom = MIN(y0 + src->h, (Sint64)clip->y + clip->h);
+        int x, y, srcx, srcy, w, h;
+
+        if (right <= left || bottom <= top) {
+            continue;
+        }
+        x = (int)left;
+        y = (int)top;
+        srcx = (int)(left - x0);
+        srcy = (int)(top - y0);
+        w = (int)(right - left);
+        h = (int)(bottom - top);
+
+        info.width = w;
+        info.height = h;
+        info.s_pixels = (Uint8 *)src->pixels + srcy * src->pitch +
+                        srcx * info.s_pxskip;
+        info.s_skip = src->pitch - w * info.s_pxskip;
+        info.d_pixels =
+            (Uint8 *)dst->pixels + y * dst->pitch + x * info.d_pxskip;
+        info.d_skip = dst->pitch - w * info.d_pxskip;
+        info.s_x = srcx;
+        info.s_y = srcy;
+        run_blitter(blitter, name, &info, src, dst);
+    }
+
+    if (dst_locked)
+        SDL_UnlockSurface(dst);
+    if (src_locked)
+        SDL_UnlockSurface(src);
+    return (okay ? 0 : -1);
+}
+
 int
 pygame_AlphaBlit(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                  SDL_Rect *dstrect, int the_args)
 {
-    return pygame_Blit(src, srcrect, dst, dstrect, the_args);
+    return pygame_Blit(src, srcrect, dst, dstrect, the_args, NULL);
 }
@@ -25,6 +25,7 @@
 #include "pygame.h"
 
 #include <signal.h>
+#include <stdarg.h>
 #include "doc/pygame_doc.h"
 #include "pgarrinter.h"
 #include "pgcompat.h"
@@ -172,6 +173,20 @@ static void
 pg_SetDefaultWindowSurface(pgSurfaceObject *);
 static char *
 pg_EnvShouldBlendAlphaSDL2(void);
+static int
+pg_GetNumThreads(void);
+static void
+pg_ParallelFor(pg_parallel_proc, void *, int);
+static int
+pg_SubmitTask(pg_task_proc, void *);
+static int
+pg_GetSIMDFlags(void);
+static Uint64
+pg_StatsBegin(void);
+static void
+pg_StatsEnd(int, const char *, Uint64, Sint64);
+static void
+pg_atexit_pool(void);
 
 static int
 pg_CheckSDLVersions(void) /*compare compiled to linked*/
@@ -1966,6 +1981,776 @@ pg_EnvShouldBlendAlphaSDL2(void)
     return pg_env_blend_alpha_SDL2;
 }
 
+/* Worker pool shared by the C modules to split pixel work into independent
+ * bands. The calling thread always takes part in a run, so the pool only
+ * keeps pg_pool_nthreads - 1 persistent SDL threads. Between runs, idle
+ * workers also pick up single tasks queued with pg_SubmitTask. Everything
+ * here runs without touching the Python API, so callers may release the
+ * GIL first.
+ */
+#define PG_POOL_MAX_THREADS 64
+
+typedef struct pg_pool_task_s {
+    pg_task_proc func;
+    void *data;
+    struct pg_pool_task_s *next;
+} pg_pool_task;
+
+static SDL_Thread *pg_pool_workers[PG_POOL_MAX_THREADS];
+static int pg_pool_nthreads = 1;
+static SDL_mutex *pg_pool_lock = NULL;    /* guards the fields below */
+static SDL_mutex *pg_pool_runlock = NULL; /* one pg_ParallelFor at a time */
+static SDL_cond *pg_pool_wake = NULL;
+static SDL_cond *pg_pool_done = NULL;
+static int pg_pool_quit = 0;
+static pg_parallel_proc pg_pool_func = NULL;
+static void *pg_pool_data = NULL;
+static int pg_pool_count = 0;
+static int pg_pool_next = 0;
+static int pg_pool_pending = 0;
+static pg_pool_task *pg_pool_tasks = NULL; /* FIFO of submitted tasks */
+static pg_pool_task *pg_pool_lasttask = NULL;
+static int pg_pool_ntasks = 0;
+static int pg_pool_busy = 0; /* threads running an item or a task */
+
+/* Run queued work items until none are left. Called with pg_pool_lock
+ * held, returns with it held.
+ */
+static void
+pg_pool_drain(void)
+{
+    pg_parallel_proc func;
+    void *data;
+    int index, count;
+
+    while (pg_pool_next < pg_pool_count) {
+        func = pg_pool_func;
+        data = pg_pool_data;
+        count = pg_pool_count;
+        index = pg_pool_next++;
+        ++pg_pool_busy;
+        SDL_UnlockMutex(pg_pool_lock);
+        func(data, index, count);
+        SDL_LockMutex(pg_pool_lock);
+        --pg_pool_busy;
+        if (--pg_pool_pending == 0) {
+            SDL_CondBroadcast(pg_pool_done);
+        }
+    }
+}
+
+/* Take the oldest submitted task off the queue, or return NULL if there
+ * are none. Called with pg_pool_lock held.
+ */
+static pg_pool_task *
+pg_pool_pop_task(void)
+{
+    pg_pool_task *task = pg_pool_tasks;
+
+    if (task) {
+        pg_pool_tasks = task->next;
+        if (!pg_pool_tasks) {
+            pg_pool_lasttask = NULL;
+        }
+        --pg_pool_ntasks;
+    }
+    return task;
+}
+
+static int SDLCALL
+pg_pool_worker(void *unused)
+{
+    pg_pool_task *task;
+
+    SDL_LockMutex(pg_pool_lock);
+    while (!pg_pool_quit) {
+        pg_pool_drain();
+        /* pg_ParallelFor items go first, as their caller is waiting */
+        task = pg_pool_pop_task();
+        if (task) {
+            ++pg_pool_busy;
+            SDL_UnlockMutex(pg_pool_lock);
+            task->func(task->data);
+            free(task);
+            SDL_LockMutex(pg_pool_lock);
+            --pg_pool_busy;
+        }
+        else if (!pg_pool_quit) {
+            SDL_CondWait(pg_pool_wake, pg_pool_lock);
+        }
+    }
+    SDL_UnlockMutex(pg_pool_lock);
+    return 0;
+}
+
+static void
+pg_pool_stop(void)
+{
+    pg_pool_task *task;
+    int i;
+
+    if (!pg_pool_lock) {
+        return;
+    }
+    SDL_LockMutex(pg_pool_lock);
+    pg_pool_quit = 1;
+    pg_pool_nthreads = 1; /* new tasks now run on the submitting thread */
+    SDL_CondBroadcast(pg_pool_wake);
+    SDL_UnlockMutex(pg_pool_lock);
+    for (i = 0; i < PG_POOL_MAX_THREADS; i++) {
+        if (pg_pool_workers[i]) {
+            SDL_WaitThread(pg_pool_workers[i], NULL);
+            pg_pool_workers[i] = NULL;
+        }
+    }
+    pg_pool_quit = 0;
+
+    /* Someone may be waiting on the tasks the workers left behind */
+    SDL_LockMutex(pg_pool_lock);
+    while ((task = pg_pool_pop_task())) {
+        SDL_UnlockMutex(pg_pool_lock);
+        task->func(task->data);
+        free(task);
+        SDL_LockMutex(pg_pool_lock);
+    }
+    SDL_UnlockMutex(pg_pool_lock);
+}
+
+/* Resize the pool to nthreads, counting the calling thread.
+ * Returns 0 on success, -1 with an SDL error set otherwise.
+ */
+static int
+pg_pool_resize(int nthreads)
+{
+    int i;
+
+    if (!pg_pool_lock) {
+        pg_pool_lock = SDL_CreateMutex();
+        pg_pool_runlock = SDL_CreateMutex();
+        pg_pool_wake = SDL_CreateCond();
+        pg_pool_done = SDL_CreateCond();
+        if (!pg_pool_lock || !pg_pool_runlock || !pg_pool_wake ||
+            !pg_pool_done) {
+            return -1;
+        }
+    }
+
+    /* wait for a run in progress on another thread to finish */
+    SDL_LockMutex(pg_pool_runlock);
+    pg_pool_stop();
+    for (i = 0; i < nthreads - 1; i++) {
+        pg_pool_workers[i] =
+            SDL_CreateThread(pg_pool_worker, "pygame_worker", NULL);
+        if (!pg_pool_workers[i]) {
+            pg_pool_stop();
+            SDL_UnlockMutex(pg_pool_runlock);
+            return -1;
+        }
+    }
+    SDL_LockMutex(pg_pool_lock);
+    pg_pool_nthreads = nthreads;
+    SDL_UnlockMutex(pg_pool_lock);
+    SDL_UnlockMutex(pg_pool_runlock);
+    return 0;
+}
+
+static int
+pg_GetNumThreads(void)
+{
+    return pg_pool_nthreads;
+}
+
+static void
+pg_ParallelFor(pg_parallel_proc func, void *data, int count)
+{
+    int i;
+
+    /* Nested or concurrent runs, say from a worker thread, fall back to
+       running serially instead of waiting on the pool. */
+    if (count < 2 || pg_pool_nthreads < 2 ||
+        SDL_TryLockMutex(pg_pool_runlock) != 0) {
+        for (i = 0; i < count; i++) {
+            func(data, i, count);
+        }
+        return;
+    }
+
+    SDL_LockMutex(pg_pool_lock);
+    pg_pool_func = func;
+    pg_pool_data = data;
+    pg_pool_count = count;
+    pg_pool_next = 0;
+    pg_pool_pending = count;
+    SDL_CondBroadcast(pg_pool_wake);
+    pg_pool_drain();
+    while (pg_pool_pending) {
+        SDL_CondWait(pg_pool_done, pg_pool_lock);
+    }
+    pg_pool_func = NULL;
+    pg_pool_data = NULL;
+    pg_pool_count = 0;
+    pg_pool_next = 0;
+    SDL_UnlockMutex(pg_pool_lock);
+    SDL_UnlockMutex(pg_pool_runlock);
+}
+
+/* Queue func(data) to run once on a pool worker and return without waiting
+ * for it. With no workers to hand it to, func runs right away on the
+ * calling thread. Returns 0 on success, -1 with an SDL error set otherwise.
+ */
+static int
+pg_SubmitTask(pg_task_proc func, void *data)
+{
+    pg_pool_task *task;
+
+    if (!pg_pool_lock) {
+        func(data);
+        return 0;
+    }
+
+    task = (pg_pool_task *)malloc(sizeof(pg_pool_task));
+    if (!task) {
+        return SDL_SetError("cannot allocate a pool task");
+    }
+    task->func = func;
+    task->data = data;
+    task->next = NULL;
+
+    SDL_LockMutex(pg_pool_lock);
+    if (pg_pool_nthreads < 2) {
+        SDL_UnlockMutex(pg_pool_lock);
+        free(task);
+        func(data);
+        return 0;
+    }
+    if (pg_pool_lasttask) {
+        pg_pool_lasttask->next = task;
+    }
+    else {
+        pg_pool_tasks = task;
+    }
+    pg_pool_lasttask = task;
+    ++pg_pool_ntasks;
+    SDL_CondSignal(pg_pool_wake);
+    SDL_UnlockMutex(pg_pool_lock);
+    return 0;
+}
+
+static void
+pg_atexit_pool(void)
+{
+    if (pg_pool_runlock) {
+        SDL_LockMutex(pg_pool_runlock);
+        pg_pool_stop();
+        SDL_UnlockMutex(pg_pool_runlock);
+    }
+}
+
+static PyObject *
+pg_set_num_threads(PyObject *self, PyObject *arg)
+{
+    int nthreads, result;
+
+    if (!pg_IntFromObj(arg, &nthreads)) {
+        return RAISE(PyExc_TypeError, "count must be an integer");
+    }
+    if (nthreads < 0) {
+        return RAISE(PyExc_ValueError, "count must not be negative");
+    }
+    if (nthreads == 0) {
+        nthreads = SDL_GetCPUCount();
+    }
+    if (nthreads > PG_POOL_MAX_THREADS) {
+        nthreads = PG_POOL_MAX_THREADS;
+    }
+    if (nthreads < 1) {
+        nthreads = 1;
+    }
+    if (nthreads == pg_pool_nthreads) {
+        Py_RETURN_NONE;
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    result = pg_pool_resize(nthreads);
+    Py_END_ALLOW_THREADS;
+    if (result) {
+        return RAISE(PyExc_RuntimeError, SDL_GetError());
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_get_num_threads(PyObject *self, PyObject *_null)
+{
+    return PyLong_FromLong(pg_pool_nthreads);
+}
+
+static PyObject *
+pg_get_parallel_threshold(PyObject *self, PyObject *_null)
+{
+    return PyLong_FromLong(PG_PARALLEL_MIN_PIXELS);
+}
+
+static PyObject *
+pg_get_thread_pool_info(PyObject *self, PyObject *_null)
+{
+    int nthreads, busy = 0, queued = 0;
+
+    if (!pg_pool_lock) {
+        return Py_BuildValue("(iii)", pg_pool_nthreads, 0, 0);
+    }
+    SDL_LockMutex(pg_pool_lock);
+    nthreads = pg_pool_nthreads;
+    busy = pg_pool_busy;
+    queued = pg_pool_ntasks;
+    SDL_UnlockMutex(pg_pool_lock);
+    return Py_BuildValue("(iii)", nthreads, busy, queued);
+}
+
+/* The instruction sets the CPU has, and the ones code paths may use. Each
+ * backend named for pygame.set_simd_backend() turns off what it does not
+ * allow. The "avx2" backend allows everything on x86, like "auto" does.
+ */
+static int pg_simd_detected = 0;
+static int pg_simd_flags = 0;
+
+static const struct {
+    const char *name;
+    int requires; /* what the CPU must have for the backend */
+    int allows;
+} pg_simd_backends[] = {
+    {"scalar", 0, 0},
+    {"sse2", PG_SIMD_SSE2, PG_SIMD_MMX | PG_SIMD_SSE | PG_SIMD_SSE2},
+    {"avx2", PG_SIMD_AVX2,
+     PG_SIMD_MMX | PG_SIMD_SSE | PG_SIMD_SSE2 | PG_SIMD_SSE42 | PG_SIMD_AVX2},
+    {"neon", PG_SIMD_NEON, PG_SIMD_NEON},
+    {NULL, 0, 0}};
+
+static int
+pg_GetSIMDFlags(void)
+{
+    return pg_simd_flags;
+}
+
+/* Switch to the named backend, or "auto" for everything the CPU has.
+ * Returns 0 on success, -1 for an unknown name and -2 for a backend the
+ * CPU cannot run.
+ */
+static int
+pg_simd_select(const char *name)
+{
+    int i;
+
+    if (!strcmp(name, "auto")) {
+        pg_simd_flags = pg_simd_detected;
+        return 0;
+    }
+    for (i = 0; pg_simd_backends[i].name; i++) {
+        if (!strcmp(name, pg_simd_backends[i].name)) {
+            if ((pg_simd_detected & pg_simd_backends[i].requires) !=
+                pg_simd_backends[i].requires) {
+                return -2;
+            }
+            pg_simd_flags = pg_simd_detected & pg_simd_backends[i].allows;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/* Detect the CPU's instruction sets, and apply a PYGAME_SIMD_BACKEND
+ * environment variable naming a backend it can run.
+ */
+static void
+pg_simd_init(void)
+{
+    const char *name;
+
+    pg_simd_detected = 0;
+    if (SDL_HasMMX()) {
+        pg_simd_detected |= PG_SIMD_MMX;
+    }
+    if (SDL_HasSSE()) {
+        pg_simd_detected |= PG_SIMD_SSE;
+    }
+    if (SDL_HasSSE2()) {
+        pg_simd_detected |= PG_SIMD_SSE2;
+    }
+    if (SDL_HasSSE42()) {
+        pg_simd_detected |= PG_SIMD_SSE42;
+    }
+    if (SDL_HasAVX2()) {
+        pg_simd_detected |= PG_SIMD_AVX2;
+    }
+    if (SDL_HasNEON()) {
+        pg_simd_detected |= PG_SIMD_NEON;
+    }
+    pg_simd_flags = pg_simd_detected;
+
+    name = SDL_getenv("PYGAME_SIMD_BACKEND");
+    if (name) {
+        pg_simd_select(name);
+    }
+}
+
+static PyObject *
+pg_get_simd_backends(PyObject *self, PyObject *_null)
+{
+    PyObject *list, *item;
+    int i;
+
+    list = PyList_New(0);
+    if (!list) {
+        return NULL;
+    }
+    for (i = 0; pg_simd_backends[i].name; i++) {
+        if ((pg_simd_detected & pg_simd_backends[i].requires) !=
+            pg_simd_backends[i].requires) {
+            continue;
+        }
+        item = PyUnicode_FromString(pg_simd_backends[i].name);
+        if (!item || PyList_Append(list, item)) {
+            Py_XDECREF(item);
+            Py_DECREF(list);
+            return NULL;
+        }
+        Py_DECREF(item);
+    }
+    return list;
+}
+
+static PyObject *
+pg_get_simd_backend(PyObject *self, PyObject *_null)
+{
+    const char *name = "scalar";
+
+    if (pg_simd_flags & PG_SIMD_AVX2) {
+        name = "avx2";
+    }
+    else if (pg_simd_flags & PG_SIMD_SSE2) {
+        name = "sse2";
+    }
+    else if (pg_simd_flags & PG_SIMD_NEON) {
+        name = "neon";
+    }
+    return PyUnicode_FromString(name);
+}
+
+static PyObject *
+pg_set_simd_backend(PyObject *self, PyObject *arg)
+{
+    const char *name;
+
+    if (!PyUnicode_Check(arg)) {
+        return RAISE(PyExc_TypeError, "backend must be a string");
+    }
+    name = PyUnicode_AsUTF8(arg);
+    if (!name) {
+        return NULL;
+    }
+    switch (pg_simd_select(name)) {
+        case -1:
+            return PyErr_Format(PyExc_ValueError, "unknown backend '%s'",
+                                name);
+        case -2:
+            return PyErr_Format(PyExc_ValueError,
+                                "backend '%s' is not supported by this CPU",
+                                name);
+    }
+    Py_RETURN_NONE;
+}
+
+/* Call, pixel and time counts of the C hot paths for pygame.stats(), kept
+ * per category and name. While they are off, the default, pg_StatsBegin()
+ * only reads a flag and pg_StatsEnd() returns at once. The names are
+ * string literals of the calling modules, so they are never copied.
+ */
+#define PG_STATS_MAX_NAMES 256
+#define PG_TRACE_MAX_EVENTS (1 << 20)
+
+typedef struct {
+    int category;
+    const char *name;
+    Uint64 calls;
+    Uint64 pixels;
+    Uint64 ticks; /* performance counter ticks */
+} pg_stats_entry;
+
+typedef struct {
+    int category;
+    const char *name;
+    Uint64 start; /* ticks since tracing started */
+    Uint64 ticks;
+    unsigned long thread;
+} pg_trace_event;
+
+static const char *pg_stats_categories[PG_STAT_NUM] = {
+    "blit", "convert", "transform", "draw", "text", "event", "display"};
+
+static int pg_stats_enabled = 0;
+static int pg_stats_tracing = 0;
+static SDL_SpinLock pg_stats_lock = 0; /* guards the fields below */
+static pg_stats_entry pg_stats[PG_STATS_MAX_NAMES];
+static int pg_stats_count = 0;
+static Uint64 pg_trace_epoch = 0;
+static pg_trace_event *pg_trace_events = NULL;
+static size_t pg_trace_count = 0;
+static size_t pg_trace_alloc = 0;
+
+static Uint64
+pg_StatsBegin(void)
+{
+    return pg_stats_enabled ? SDL_GetPerformanceCounter() : 0;
+}
+
+static void
+pg_StatsEnd(int category, const char *name, Uint64 start, Sint64 pixels)
+{
+    Uint64 ticks;
+    pg_stats_entry *entry = NULL;
+    pg_trace_event *events;
+    int i;
+
+    if (!start) {
+        return;
+    }
+    ticks = SDL_GetPerformanceCounter() - start;
+
+    SDL_AtomicLock(&pg_stats_lock);
+    for (i = 0; i < pg_stats_count; i++) {
+        if (pg_stats[i].category == category &&
+            (pg_stats[i].name == name || !strcmp(pg_stats[i].name, name))) {
+            entry = pg_stats + i;
+            break;
+        }
+    }
+    if (!entry && pg_stats_count < PG_STATS_MAX_NAMES) {
+        entry = pg_stats + pg_stats_count++;
+        entry->category = category;
+        entry->name = name;
+    }
+    if (entry) {
+        entry->calls++;
+        entry->pixels += pixels > 0 ? (Uint64)pixels : 0;
+        entry->ticks += ticks;
+    }
+
+    if (pg_stats_tracing && start >= pg_trace_epoch &&
+        pg_trace_count < PG_TRACE_MAX_EVENTS) {
+        if (pg_trace_count == pg_trace_alloc) {
+            pg_trace_alloc = pg_trace_alloc ? pg_trace_alloc * 2 : 4096;
+            events = (pg_trace_event *)realloc(
+                pg_trace_events, pg_trace_alloc * sizeof(pg_trace_event));
+            if (!events) {
+                pg_trace_alloc = pg_trace_count;
+            }
+            else {
+                pg_trace_events = events;
+            }
+        }
+        if (pg_trace_count < pg_trace_alloc) {
+            events = pg_trace_events + pg_trace_count++;
+            events->category = category;
+            events->name = name;
+            events->start = start - pg_trace_epoch;
+            events->ticks = ticks;
+            events->thread = SDL_ThreadID();
+        }
+    }
+    SDL_AtomicUnlock(&pg_stats_lock);
+}
+
+static PyObject *
+pg_set_stats_enabled(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int enabled, trace = 0;
+    static char *keywords[] = {"enabled", "trace", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "p|p", keywords, &enabled,
+                                     &trace)) {
+        return NULL;
+    }
+
+    SDL_AtomicLock(&pg_stats_lock);
+    if (trace && !pg_stats_tracing) {
+        pg_trace_epoch = SDL_GetPerformanceCounter();
+        pg_trace_count = 0;
+    }
+    pg_stats_tracing = enabled && trace;
+    pg_stats_enabled = enabled;
+    SDL_AtomicUnlock(&pg_stats_lock);
+    Py_RETURN_NONE;
+}
+
+/* Add one {"calls", "pixels", "ns"} dict per counted name to a dict per
+ * category.
+ */
+static PyObject *
+pg_stats_to_dict(const pg_stats_entry *entries, int count)
+{
+    PyObject *result, *category, *item;
+    double ns_per_tick = 1e9 / (double)SDL_GetPerformanceFrequency();
+    int i;
+
+    result = PyDict_New();
+    for (i = 0; result && i < PG_STAT_NUM; i++) {
+        category = PyDict_New();
+        if (!category ||
+            PyDict_SetItemString(result, pg_stats_categories[i], category)) {
+            Py_XDECREF(category);
+            Py_CLEAR(result);
+            break;
+        }
+        Py_DECREF(category);
+    }
+    for (i = 0; result && i < count; i++) {
+        category = PyDict_GetItemString(
+            result, pg_stats_categories[entries[i].category]);
+        item = Py_BuildValue(
+            "{sKsKsK}", "calls", (unsigned long long)entries[i].calls,
+            "pixels", (unsigned long long)entries[i].pixels, "ns",
+            (unsigned long long)(entries[i].ticks * ns_per_tick));
+        if (!item || PyDict_SetItemString(category, entries[i].name, item)) {
+            Py_XDECREF(item);
+            Py_CLEAR(result);
+            break;
+        }
+        Py_DECREF(item);
+    }
+    return result;
+}
+
+static PyObject *
+pg_stats_get(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pg_stats_entry entries[PG_STATS_MAX_NAMES];
+    int count, reset = 0;
+    static char *keywords[] = {"reset", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|p", keywords, &reset)) {
+        return NULL;
+    }
+
+    SDL_AtomicLock(&pg_stats_lock);
+    count = pg_stats_count;
+    memcpy(entries, pg_stats, count * sizeof(pg_stats_entry));
+    if (reset) {
+        pg_stats_count = 0;
+    }
+    SDL_AtomicUnlock(&pg_stats_lock);
+
+    return pg_stats_to_dict(entries, count);
+}
+
+/* Append printf formatted text to the growing buffer *buf. Returns 0 on
+ * success, -1 when out of memory.
+ */
+static int
+pg_trace_append(char **buf, size_t *len, size_t *alloc, const char *fmt,
+                ...)
+{
+    va_list ap;
+    char *grown;
+    int n;
+
+    for (;;) {
+        va_start(ap, fmt);
+        n = vsnprintf(*buf + *len, *alloc - *len, fmt, ap);
+        va_end(ap);
+        if (n < 0) {
+            return -1;
+        }
+        if ((size_t)n < *alloc - *len) {
+            *len += n;
+            return 0;
+        }
+        grown = (char *)realloc(*buf, *alloc * 2 + n);
+        if (!grown) {
+            return -1;
+        }
+        *buf = grown;
+        *alloc = *alloc * 2 + n;
+    }
+}
+
+static PyObject *
+pg_save_trace(PyObject *self, PyObject *file)
+{
+    pg_trace_event *events;
+    size_t count, i, len = 0, alloc = 65536;
+    double us_per_tick = 1e6 / (double)SDL_GetPerformanceFrequency();
+    char *buf;
+    int failed = 0;
+    PyObject *text, *io, *result;
+
+    /* take the events recorded so far, later ones start a new trace */
+    SDL_AtomicLock(&pg_stats_lock);
+    events = pg_trace_events;
+    count = pg_trace_count;
+    pg_trace_events = NULL;
+    pg_trace_count = pg_trace_alloc = 0;
+    SDL_AtomicUnlock(&pg_stats_lock);
+
+    buf = (char *)malloc(alloc);
+    if (!buf) {
+        free(events);
+        return PyErr_NoMemory();
+    }
+    buf[0] = '\0';
+    failed = pg_trace_append(&buf, &len, &alloc,
+                             "{\"displayTimeUnit\": \"ns\", "
+                             "\"traceEvents\": [");
+    for (i = 0; !failed && i < count; i++) {
+        failed = pg_trace_append(
+            &buf, &len, &alloc,
+            "%s\n{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", "
+            "\"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %lu}",
+            i ? "," : "", events[i].name,
+            pg_stats_categories[events[i].category],
+            events[i].start * us_per_tick, events[i].ticks * us_per_tick,
+            events[i].thread);
+    }
+    if (!failed) {
+        failed = pg_trace_append(&buf, &len, &alloc, "\n]}\n");
+    }
+    free(events);
+    if (failed) {
+        free(buf);
+        return PyErr_NoMemory();
+    }
+    text = PyUnicode_DecodeUTF8(buf, len, "replace");
+    free(buf);
+    if (!text) {
+        return NULL;
+    }
+
+    if (PyObject_HasAttrString(file, "write")) {
+        result = PyObject_CallMethod(file, "write", "O", text);
+    }
+    else {
+        io = PyImport_ImportModule("io");
+        result = io ? PyObject_CallMethod(io, "open", "Osis", file, "w", -1,
+                                          "utf-8")
+                    : NULL;
+        Py_XDECREF(io);
+        if (result) {
+            file = result;
+            result = PyObject_CallMethod(file, "write", "O", text);
+            if (result) {
+                Py_DECREF(result);
+                result = PyObject_CallMethod(file, "close", NULL);
+            }
+            Py_DECREF(file);
+        }
+    }
+    Py_DECREF(text);
+    if (!result) {
+        return NULL;
+    }
+    Py_DECREF(result);
+    Py_RETURN_NONE;
+}
+
 /*error signal handlers(replacing SDL parachute)*/
 static void
 pygame_parachute(int sig)
@@ -2081,6 +2866,25 @@ static PyMethodDef _base_methods[] = {
      DOC_PYGAMEGETSDLVERSION},
     {"get_sdl_byteorder", (PyCFunction)pg_get_sdl_byteorder, METH_NOARGS,
      DOC_PYGAMEGETSDLBYTEORDER},
+    {"set_num_threads", (PyCFunction)pg_set_num_threads, METH_O,
+     DOC_PYGAMESETNUMTHREADS},
+    {"get_num_threads", (PyCFunction)pg_get_num_threads, METH_NOARGS,
+     DOC_PYGAMEGETNUMTHREADS},
+    {"get_parallel_threshold", (PyCFunction)pg_get_parallel_threshold,
+     METH_NOARGS, DOC_PYGAMEGETPARALLELTHRESHOLD},
+    {"get_thread_pool_info", (PyCFunction)pg_get_thread_pool_info,
+     METH_NOARGS, DOC_PYGAMEGETTHREADPOOLINFO},
+    {"get_simd_backends", (PyCFunction)pg_get_simd_backends, METH_NOARGS,
+     DOC_PYGAMEGETSIMDBACKENDS},
+    {"get_simd_backend", (PyCFunction)pg_get_simd_backend, METH_NOARGS,
+     DOC_PYGAMEGETSIMDBACKEND},
+    {"set_simd_backend", (PyCFunction)pg_set_simd_backend, METH_O,
+     DOC_PYGAMESETSIMDBACKEND},
+    {"set_stats_enabled", (PyCFunction)pg_set_stats_enabled,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMESETSTATSENABLED},
+    {"stats", (PyCFunction)pg_stats_get, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMESTATS},
+    {"save_trace", (PyCFunction)pg_save_trace, METH_O, DOC_PYGAMESAVETRACE},
 
     {"get_array_interface", (PyCFunction)pg_get_array_interface, METH_O,
      "return an array struct interface as an interface dictionary"},
@@ -2150,6 +2954,8 @@ MODINIT_DEFINE(base)
         goto error;
     }
 
+    pg_simd_init();
+
     /* export the c api */
     c_api[0] = pgExc_SDLError;
     c_api[1] = pg_RegisterQuit;
@@ -2175,7 +2981,13 @@ MODINIT_DEFINE(base)
     c_api[21] = pg_GetDefaultWindowSurface;
     c_api[22] = pg_SetDefaultWindowSurface;
     c_api[23] = pg_EnvShouldBlendAlphaSDL2;
-#define FILLED_SLOTS 24
+    c_api[24] = pg_ParallelFor;
+    c_api[25] = pg_GetNumThreads;
+    c_api[26] = pg_SubmitTask;
+    c_api[27] = pg_GetSIMDFlags;
+    c_api[28] = pg_StatsBegin;
+    c_api[29] = pg_StatsEnd;
+#define FILLED_SLOTS 30
 
 #if PYGAMEAPI_BASE_NUMSLOTS != FILLED_SLOTS
 #error export slot count mismatch
@@ -2207,6 +3019,7 @@ MODINIT_DEFINE(base)
     }
     Py_DECREF(rval);
     Py_AtExit(pg_atexit_quit);
+    Py_AtExit(pg_atexit_pool);
 #ifdef HAVE_SIGNAL_H
     pg_install_parachute();
 #endif
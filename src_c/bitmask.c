@@ -39,6 +39,10 @@
 static INLINE unsigned int
 bitcount(BITMASK_W n)
 {
+#if defined(__GNUC__) || defined(__clang__)
+    /* a single instruction wherever the target has one */
+    return (unsigned int)__builtin_popcountl(n);
+#else
     const int bitmask_len = BITMASK_W_LEN;
     if (bitmask_len == 32) {
 #ifdef GILLIES
@@ -87,6 +91,7 @@ bitcount(BITMASK_W n)
         }
         return nbits;
     }
+#endif
 }
 
 /* Positive modulo of the given dividend and divisor (dividend % divisor).
@@ -106,6 +111,118 @@ positive_modulo(int dividend, int divisor)
     return (result >= 0) ? result : result + divisor;
 }
 
+/* Will hang if there are no bits set in w! */
+static INLINE int
+firstsetbit(BITMASK_W w)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzl(w);
+#else
+    int i = 0;
+    while ((w & 1) == 0) {
+        i++;
+        w /= 2;
+    }
+    return i;
+#endif
+}
+
+/* Will hang if there are no bits set in w! */
+static INLINE int
+lastsetbit(BITMASK_W w)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (int)BITMASK_W_LEN - 1 - __builtin_clzl(w);
+#else
+    int i = 0;
+    while (w >>= 1) {
+        i++;
+    }
+    return i;
+#endif
+}
+
+/* Rows of a stripe tested together by the overlap functions. Combining a
+ * block of words before branching lets the compiler keep them in vector
+ * registers, so large masks are compared several words per step.
+ */
+#define BITMASK_BLOCK 4
+
+/* Returns nonzero if any of the n rows at bp overlaps the rows at ap
+ * shifted right by shift, combined with the rows at app shifted left by
+ * rshift. A nextmask of 0 leaves out app, which must still be readable for
+ * the n rows; otherwise it must be all ones.
+ */
+static INLINE int
+stripe_overlap(const BITMASK_W *ap, const BITMASK_W *app, const BITMASK_W *bp,
+               size_t n, unsigned int shift, unsigned int rshift,
+               BITMASK_W nextmask)
+{
+    BITMASK_W acc;
+    size_t i = 0, j;
+
+    for (; i + BITMASK_BLOCK <= n; i += BITMASK_BLOCK) {
+        acc = 0;
+        for (j = i; j < i + BITMASK_BLOCK; j++)
+            acc |= ((ap[j] >> shift) | ((app[j] << rshift) & nextmask)) &
+                   bp[j];
+        if (acc)
+            return 1;
+    }
+    for (; i < n; i++)
+        if (((ap[i] >> shift) | ((app[i] << rshift) & nextmask)) & bp[i])
+            return 1;
+    return 0;
+}
+
+/* Counts the bits set in both the n rows at bp and the rows at ap and app,
+ * combined as in stripe_overlap().
+ */
+static INLINE unsigned int
+stripe_overlap_area(const BITMASK_W *ap, const BITMASK_W *app,
+                    const BITMASK_W *bp, size_t n, unsigned int shift,
+                    unsigned int rshift, BITMASK_W nextmask)
+{
+    unsigned int count = 0;
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        count += bitcount(
+            ((ap[i] >> shift) | ((app[i] << rshift) & nextmask)) & bp[i]);
+    return count;
+}
+
+/* Finds the first of the n rows at ap overlapping the rows at bp shifted
+ * left by lshift and right by rshift. On a hit the position is stored in x
+ * and y, with x0 the first column of the stripe at ap and y0 its first row,
+ * and 1 is returned; otherwise 0 is returned.
+ */
+static INLINE int
+stripe_overlap_pos(const BITMASK_W *ap, const BITMASK_W *bp, size_t n,
+                   unsigned int lshift, unsigned int rshift, int x0, int y0,
+                   int *x, int *y)
+{
+    BITMASK_W acc;
+    size_t i = 0, j;
+
+    for (; i + BITMASK_BLOCK <= n; i += BITMASK_BLOCK) {
+        acc = 0;
+        for (j = i; j < i + BITMASK_BLOCK; j++)
+            acc |= ap[j] & ((bp[j] << lshift) >> rshift);
+        if (acc)
+            break;
+    }
+    for (; i < n; i++) {
+        acc = ap[i] & ((bp[i] << lshift) >> rshift);
+        if (acc) {
+            *y = (int)i + y0;
+            *x = x0 + firstsetbit(acc);
+            return 1;
+        }
+    }
+    return 0;
+}
+
 bitmask_t *
 bitmask_create(int w, int h)
 {
@@ -131,6 +248,8 @@ bitmask_create(int w, int h)
 
     temp->w = w;
     temp->h = h;
+    temp->exported = 0;
+    temp->changes = 0;
     bitmask_clear(temp);
 
     return temp;
@@ -169,6 +288,11 @@ bitmask_copy(bitmask_t *mask)
 
     memcpy(mask_copy->bits, mask->bits,
            mask->h * ((mask->w - 1) / BITMASK_W_LEN + 1) * sizeof(BITMASK_W));
+    mask_copy->bounds_valid = mask->bounds_valid;
+    mask_copy->bounds_x = mask->bounds_x;
+    mask_copy->bounds_y = mask->bounds_y;
+    mask_copy->bounds_w = mask->bounds_w;
+    mask_copy->bounds_h = mask->bounds_h;
 
     return mask_copy;
 }
@@ -176,6 +300,10 @@ bitmask_copy(bitmask_t *mask)
 void
 bitmask_clear(bitmask_t *m)
 {
+    m->bounds_valid = 1;
+    m->bounds_x = m->bounds_y = m->bounds_w = m->bounds_h = 0;
+    m->changes++;
+
     if (!m->h || !m->w)
         return;
 
@@ -193,6 +321,12 @@ bitmask_fill(bitmask_t *m)
         return;
     }
 
+    m->bounds_valid = 1;
+    m->bounds_x = m->bounds_y = 0;
+    m->bounds_w = m->w;
+    m->bounds_h = m->h;
+    m->changes++;
+
     len = m->h * ((m->w - 1) / BITMASK_W_LEN);
 
     shift = positive_modulo(BITMASK_W_LEN - m->w, (int)BITMASK_W_LEN);
@@ -220,6 +354,7 @@ bitmask_invert(bitmask_t *m)
         return;
     }
 
+    bitmask_changed(m);
     len = m->h * ((m->w - 1) / BITMASK_W_LEN);
 
     shift = positive_modulo(BITMASK_W_LEN - m->w, (int)BITMASK_W_LEN);
@@ -255,13 +390,79 @@ bitmask_count(bitmask_t *m)
     return tot;
 }
 
+int
+bitmask_bounds(const bitmask_t *m, int *x, int *y, int *w, int *h)
+{
+    /* the kept bounds are a cache, not part of the value of m */
+    bitmask_t *cache = (bitmask_t *)m;
+    const BITMASK_W *pixels;
+    int stripe, stripes, row, col, minx, miny, maxx = -1, maxy = -1;
+
+    if (!m->bounds_valid || m->exported) {
+        minx = m->w;
+        miny = m->h;
+        if (m->w && m->h) {
+            stripes = (m->w - 1) / BITMASK_W_LEN + 1;
+            pixels = m->bits;
+            for (stripe = 0; stripe < stripes; stripe++) {
+                col = stripe * BITMASK_W_LEN;
+                for (row = 0; row < m->h; row++, pixels++) {
+                    if (*pixels) {
+                        miny = MIN(miny, row);
+                        maxy = MAX(maxy, row);
+                        minx = MIN(minx, col + firstsetbit(*pixels));
+                        maxx = MAX(maxx, col + lastsetbit(*pixels));
+                    }
+                }
+            }
+        }
+        cache->bounds_valid = 1;
+        if (maxx < 0) {
+            cache->bounds_x = cache->bounds_y = 0;
+            cache->bounds_w = cache->bounds_h = 0;
+        }
+        else {
+            cache->bounds_x = minx;
+            cache->bounds_y = miny;
+            cache->bounds_w = maxx - minx + 1;
+            cache->bounds_h = maxy - miny + 1;
+        }
+    }
+
+    if (!m->bounds_w) {
+        return 0;
+    }
+    *x = m->bounds_x;
+    *y = m->bounds_y;
+    *w = m->bounds_w;
+    *h = m->bounds_h;
+    return 1;
+}
+
+/* Returns nonzero if the bounds of the set bits of a and b meet, with b at
+ * the given offset from a. If they do not, the masks cannot overlap.
+ */
+static int
+bounds_overlap(const bitmask_t *a, const bitmask_t *b, int xoffset,
+               int yoffset)
+{
+    int ax, ay, aw, ah, bx, by, bw, bh;
+
+    if (!bitmask_bounds(a, &ax, &ay, &aw, &ah) ||
+        !bitmask_bounds(b, &bx, &by, &bw, &bh)) {
+        return 0;
+    }
+    bx += xoffset;
+    by += yoffset;
+    return ax < bx + bw && bx < ax + aw && ay < by + bh && by < ay + ah;
+}
+
 int
 bitmask_overlap(const bitmask_t *a, const bitmask_t *b, int xoffset,
                 int yoffset)
 {
     const BITMASK_W *a_entry, *a_end;
     const BITMASK_W *b_entry;
-    const BITMASK_W *ap, *app, *bp;
     unsigned int shift, rshift, i, astripes, bstripes;
 
     /* Return if no overlap or one mask has a width/height of 0. */
@@ -270,6 +471,11 @@ bitmask_overlap(const bitmask_t *a, const bitmask_t *b, int xoffset,
         return 0;
     }
 
+    /* Return if the set bits are too far apart to overlap. */
+    if (!bounds_overlap(a, b, xoffset, yoffset)) {
+        return 0;
+    }
+
     if (xoffset >= 0) {
     swapentry:
         if (yoffset >= 0) {
@@ -292,28 +498,24 @@ bitmask_overlap(const bitmask_t *a, const bitmask_t *b, int xoffset,
             if (bstripes > astripes) /* zig-zag .. zig*/
             {
                 for (i = 0; i < astripes; i++) {
-                    for (ap = a_entry, app = ap + a->h, bp = b_entry;
-                         ap < a_end;)
-                        if ((*ap++ >> shift) & *bp ||
-                            (*app++ << rshift) & *bp++)
-                            return 1;
+                    if (stripe_overlap(a_entry, a_entry + a->h, b_entry,
+                                       a_end - a_entry, shift, rshift,
+                                       ~(BITMASK_W)0))
+                        return 1;
                     a_entry += a->h;
                     a_end += a->h;
                     b_entry += b->h;
                 }
-                for (ap = a_entry, bp = b_entry; ap < a_end;)
-                    if ((*ap++ >> shift) & *bp++)
-                        return 1;
-                return 0;
+                return stripe_overlap(a_entry, a_entry, b_entry,
+                                      a_end - a_entry, shift, rshift, 0);
             }
             else /* zig-zag */
             {
                 for (i = 0; i < bstripes; i++) {
-                    for (ap = a_entry, app = ap + a->h, bp = b_entry;
-                         ap < a_end;)
-                        if ((*ap++ >> shift) & *bp ||
-                            (*app++ << rshift) & *bp++)
-                            return 1;
+                    if (stripe_overlap(a_entry, a_entry + a->h, b_entry,
+                                       a_end - a_entry, shift, rshift,
+                                       ~(BITMASK_W)0))
+                        return 1;
                     a_entry += a->h;
                     a_end += a->h;
                     b_entry += b->h;
@@ -326,9 +528,9 @@ bitmask_overlap(const bitmask_t *a, const bitmask_t *b, int xoffset,
         {
             astripes = (MIN(b->w, a->w - xoffset) - 1) / BITMASK_W_LEN + 1;
             for (i = 0; i < astripes; i++) {
-                for (ap = a_entry, bp = b_entry; ap < a_end;)
-                    if (*ap++ & *bp++)
-                        return 1;
+                if (stripe_overlap(a_entry, a_entry, b_entry, a_end - a_entry,
+                                   0, 0, 0))
+                    return 1;
                 a_entry += a->h;
                 a_end += a->h;
                 b_entry += b->h;
@@ -346,18 +548,6 @@ bitmask_overlap(const bitmask_t *a, const bitmask_t *b, int xoffset,
     }
 }
 
-/* Will hang if there are no bits set in w! */
-static INLINE int
-firstsetbit(BITMASK_W w)
-{
-    int i = 0;
-    while ((w & 1) == 0) {
-        i++;
-        w /= 2;
-    }
-    return i;
-}
-
 /* x and y are given in the coordinates of mask a, and are untouched if there
  * is no overlap */
 int
@@ -370,8 +560,13 @@ bitmask_overlap_pos(const bitmask_t *a, const bitmask_t *b, int xoffset,
         return 0;
     }
 
+    /* Return if the set bits are too far apart to overlap. */
+    if (!bounds_overlap(a, b, xoffset, yoffset)) {
+        return 0;
+    }
+
     if (xoffset >= 0) {
-        const BITMASK_W *a_entry, *a_end, *b_entry, *ap, *bp;
+        const BITMASK_W *a_entry, *a_end, *b_entry;
         unsigned int shift, rshift, i, astripes, bstripes, xbase;
 
         xbase = xoffset / BITMASK_W_LEN; /* first stripe from mask a */
@@ -395,52 +590,40 @@ bitmask_overlap_pos(const bitmask_t *a, const bitmask_t *b, int xoffset,
             if (bstripes > astripes) /* zig-zag .. zig*/
             {
                 for (i = 0; i < astripes; i++) {
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        if (*ap & (*bp << shift)) {
-                            *y = (int)(ap - a_entry) + yoffset;
-                            *x = (xbase + i) * BITMASK_W_LEN +
-                                 firstsetbit(*ap & (*bp << shift));
-                            return 1;
-                        }
+                    if (stripe_overlap_pos(a_entry, b_entry, a_end - a_entry,
+                                           shift, 0,
+                                           (xbase + i) * BITMASK_W_LEN,
+                                           yoffset, x, y))
+                        return 1;
                     a_entry += a->h;
                     a_end += a->h;
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        if (*ap & (*bp >> rshift)) {
-                            *y = (int)(ap - a_entry) + yoffset;
-                            *x = (xbase + i + 1) * BITMASK_W_LEN +
-                                 firstsetbit(*ap & (*bp >> rshift));
-                            return 1;
-                        }
+                    if (stripe_overlap_pos(a_entry, b_entry, a_end - a_entry,
+                                           0, rshift,
+                                           (xbase + i + 1) * BITMASK_W_LEN,
+                                           yoffset, x, y))
+                        return 1;
                     b_entry += b->h;
                 }
-                for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                    if (*ap & (*bp << shift)) {
-                        *y = (int)(ap - a_entry) + yoffset;
-                        *x = (xbase + astripes) * BITMASK_W_LEN +
-                             firstsetbit(*ap & (*bp << shift));
-                        return 1;
-                    }
-                return 0;
+                return stripe_overlap_pos(a_entry, b_entry, a_end - a_entry,
+                                          shift, 0,
+                                          (xbase + astripes) * BITMASK_W_LEN,
+                                          yoffset, x, y);
             }
             else /* zig-zag */
             {
                 for (i = 0; i < bstripes; i++) {
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        if (*ap & (*bp << shift)) {
-                            *y = (int)(ap - a_entry) + yoffset;
-                            *x = (xbase + i) * BITMASK_W_LEN +
-                                 firstsetbit(*ap & (*bp << shift));
-                            return 1;
-                        }
+                    if (stripe_overlap_pos(a_entry, b_entry, a_end - a_entry,
+                                           shift, 0,
+                                           (xbase + i) * BITMASK_W_LEN,
+                                           yoffset, x, y))
+                        return 1;
                     a_entry += a->h;
                     a_end += a->h;
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        if (*ap & (*bp >> rshift)) {
-                            *y = (int)(ap - a_entry) + yoffset;
-                            *x = (xbase + i + 1) * BITMASK_W_LEN +
-                                 firstsetbit(*ap & (*bp >> rshift));
-                            return 1;
-                        }
+                    if (stripe_overlap_pos(a_entry, b_entry, a_end - a_entry,
+                                           0, rshift,
+                                           (xbase + i + 1) * BITMASK_W_LEN,
+                                           yoffset, x, y))
+                        return 1;
                     b_entry += b->h;
                 }
                 return 0;
@@ -452,14 +635,10 @@ bitmask_overlap_pos(const bitmask_t *a, const bitmask_t *b, int xoffset,
         {
             astripes = (MIN(b->w, a->w - xoffset) - 1) / BITMASK_W_LEN + 1;
             for (i = 0; i < astripes; i++) {
-                for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++) {
-                    if (*ap & *bp) {
-                        *y = (int)(ap - a_entry) + yoffset;
-                        *x = (xbase + i) * BITMASK_W_LEN +
-                             firstsetbit(*ap & *bp);
-                        return 1;
-                    }
-                }
+                if (stripe_overlap_pos(a_entry, b_entry, a_end - a_entry, 0, 0,
+                                       (xbase + i) * BITMASK_W_LEN, yoffset, x,
+                                       y))
+                    return 1;
                 a_entry += a->h;
                 a_end += a->h;
                 b_entry += b->h;
@@ -482,7 +661,7 @@ int
 bitmask_overlap_area(const bitmask_t *a, const bitmask_t *b, int xoffset,
                      int yoffset)
 {
-    const BITMASK_W *a_entry, *a_end, *b_entry, *ap, *bp;
+    const BITMASK_W *a_entry, *a_end, *b_entry;
     unsigned int shift, rshift, i, astripes, bstripes;
     unsigned int count = 0;
 
@@ -492,6 +671,11 @@ bitmask_overlap_area(const bitmask_t *a, const bitmask_t *b, int xoffset,
         return 0;
     }
 
+    /* Return if the set bits are too far apart to overlap. */
+    if (!bounds_overlap(a, b, xoffset, yoffset)) {
+        return 0;
+    }
+
     if (xoffset >= 0) {
     swapentry:
         if (yoffset >= 0) {
@@ -512,23 +696,24 @@ bitmask_overlap_area(const bitmask_t *a, const bitmask_t *b, int xoffset,
             if (bstripes > astripes) /* zig-zag .. zig*/
             {
                 for (i = 0; i < astripes; i++) {
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        count += bitcount(
-                            ((*ap >> shift) | (*(ap + a->h) << rshift)) & *bp);
+                    count += stripe_overlap_area(
+                        a_entry, a_entry + a->h, b_entry, a_end - a_entry,
+                        shift, rshift, ~(BITMASK_W)0);
                     a_entry += a->h;
                     a_end += a->h;
                     b_entry += b->h;
                 }
-                for (ap = a_entry, bp = b_entry; ap < a_end;)
-                    count += bitcount((*ap++ >> shift) & *bp++);
+                count += stripe_overlap_area(a_entry, a_entry, b_entry,
+                                             a_end - a_entry, shift, rshift,
+                                             0);
                 return count;
             }
             else /* zig-zag */
             {
                 for (i = 0; i < bstripes; i++) {
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        count += bitcount(
-                            ((*ap >> shift) | (*(ap + a->h) << rshift)) & *bp);
+                    count += stripe_overlap_area(
+                        a_entry, a_entry + a->h, b_entry, a_end - a_entry,
+                        shift, rshift, ~(BITMASK_W)0);
                     a_entry += a->h;
                     a_end += a->h;
                     b_entry += b->h;
@@ -541,9 +726,8 @@ bitmask_overlap_area(const bitmask_t *a, const bitmask_t *b, int xoffset,
         {
             astripes = (MIN(b->w, a->w - xoffset) - 1) / BITMASK_W_LEN + 1;
             for (i = 0; i < astripes; i++) {
-                for (ap = a_entry, bp = b_entry; ap < a_end;)
-                    count += bitcount(*ap++ & *bp++);
-
+                count += stripe_overlap_area(a_entry, a_entry, b_entry,
+                                             a_end - a_entry, 0, 0, 0);
                 a_entry += a->h;
                 a_end += a->h;
                 b_entry += b->h;
@@ -578,6 +762,8 @@ bitmask_overlap_mask(const bitmask_t *a, const bitmask_t *b, bitmask_t *c,
         return;
     }
 
+    bitmask_changed(c);
+
     if (xoffset >= 0) {
         const BITMASK_W *a_end;
 
@@ -762,6 +948,8 @@ bitmask_draw(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
         return;
     }
 
+    bitmask_changed(a);
+
     if (xoffset >= 0) {
         if (yoffset >= 0) {
             a_entry = a->bits + a->h * (xoffset / BITMASK_W_LEN) + yoffset;
@@ -912,6 +1100,8 @@ bitmask_erase(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
         return;
     }
 
+    bitmask_changed(a);
+
     if (xoffset >= 0) {
         const BITMASK_W *a_end;
 
@@ -1034,11 +1224,92 @@ bitmask_erase(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
     }
 }
 
+/* Returns the low half of the bits of x spread out to the even bits, by
+ * moving ever smaller blocks of them apart. */
+static INLINE BITMASK_W
+spread_bits(BITMASK_W x)
+{
+    const int half = BITMASK_W_LEN / 2;
+    int k;
+
+    x &= (~(BITMASK_W)0) >> half;
+    for (k = half / 2; k >= 1; k /= 2) {
+        x = (x | (x << k)) & (~(BITMASK_W)0 / ((((BITMASK_W)1) << k) + 1));
+    }
+    return x;
+}
+
+/* Returns the even bits of x packed into the low half, the reverse of
+ * spread_bits(). */
+static INLINE BITMASK_W
+pack_even_bits(BITMASK_W x)
+{
+    const int half = BITMASK_W_LEN / 2;
+    int k;
+
+    x &= ~(BITMASK_W)0 / 3;
+    for (k = 1; k < half; k *= 2) {
+        x = (x | (x >> k)) &
+            (~(BITMASK_W)0 / ((((BITMASK_W)1) << (2 * k)) + 1));
+    }
+    return x;
+}
+
+/* Fills the words of row ny of nm, of width w, from row y of m. Output bit
+ * nx is source bit x = nx * m->w / w, so twice and half the width are done
+ * a word at a time. Otherwise the bits are gathered from the stripe offset
+ * src_off[nx] and shift src_bit[nx] of each source bit.
+ */
+static void
+bitmask_scale_row(const bitmask_t *m, bitmask_t *nm, int y, int ny,
+                  const int *src_off, const unsigned char *src_bit)
+{
+    const int half = BITMASK_W_LEN / 2;
+    int stripes = (nm->w - 1) / BITMASK_W_LEN + 1;
+    int src_stripes = (m->w - 1) / BITMASK_W_LEN + 1;
+    const BITMASK_W *src = m->bits + y;
+    BITMASK_W *dst = nm->bits + ny, word;
+    int s, i, nx, n;
+
+    if (nm->w == m->w) {
+        for (s = 0; s < stripes; s++) {
+            dst[s * nm->h] = src[s * m->h];
+        }
+    }
+    else if (nm->w == 2 * m->w) {
+        for (s = 0; s < stripes; s++) {
+            word = spread_bits(src[s / 2 * m->h] >> (s & 1) * half);
+            dst[s * nm->h] = word | (word << 1);
+        }
+    }
+    else if (2 * nm->w == m->w) {
+        for (s = 0; s < stripes; s++) {
+            word = pack_even_bits(src[2 * s * m->h]);
+            if (2 * s + 1 < src_stripes) {
+                word |= pack_even_bits(src[(2 * s + 1) * m->h]) << half;
+            }
+            dst[s * nm->h] = word;
+        }
+    }
+    else {
+        for (s = 0, nx = 0; s < stripes; s++) {
+            n = MIN((int)BITMASK_W_LEN, nm->w - nx);
+            word = 0;
+            for (i = 0; i < n; i++, nx++) {
+                word |= ((src[src_off[nx]] >> src_bit[nx]) & 1) << i;
+            }
+            dst[s * nm->h] = word;
+        }
+    }
+}
+
 bitmask_t *
 bitmask_scale(const bitmask_t *m, int w, int h)
 {
     bitmask_t *nm;
-    int x, y, nx, ny, dx, dy, dnx, dny;
+    int *src_off = NULL;
+    unsigned char *src_bit = NULL;
+    int x, y, nx, ny, prev_y = -1, s;
 
     if (m->w < 0 || m->h < 0 || w < 0 || h < 0) {
         return 0;
@@ -1049,37 +1320,103 @@ bitmask_scale(const bitmask_t *m, int w, int h)
     if (!nm)
         return NULL;
 
-    ny = dny = 0;
-    for (y = 0, dy = h; y < m->h; y++, dy += h) {
-        while (dny < dy) {
-            nx = dnx = 0;
-            for (x = 0, dx = w; x < m->w; x++, dx += w) {
-                if (bitmask_getbit(m, x, y)) {
-                    while (dnx < dx) {
-                        bitmask_setbit(nm, nx, ny);
-                        nx++;
-                        dnx += m->w;
-                    }
-                }
-                else {
-                    while (dnx < dx) {
-                        nx++;
-                        dnx += m->w;
-                    }
-                }
+    if (!m->w || !m->h || !w || !h) {
+        return nm;
+    }
+
+    if (w != m->w && w != 2 * m->w && 2 * w != m->w) {
+        src_off = malloc(w * sizeof(int));
+        src_bit = malloc(w);
+        if (!src_off || !src_bit) {
+            free(src_off);
+            free(src_bit);
+            bitmask_free(nm);
+            return NULL;
+        }
+        for (nx = 0; nx < w; nx++) {
+            x = (int)((long long)nx * m->w / w);
+            src_off[nx] = x / BITMASK_W_LEN * m->h;
+            src_bit[nx] = (unsigned char)(x & BITMASK_W_MASK);
+        }
+    }
+
+    for (ny = 0; ny < h; ny++) {
+        y = (int)((long long)ny * m->h / h);
+        if (y == prev_y) {
+            /* the same source row as the last one, so copy it */
+            for (s = 0; s <= (w - 1) / BITMASK_W_LEN; s++) {
+                nm->bits[s * h + ny] = nm->bits[s * h + ny - 1];
             }
-            ny++;
-            dny += m->h;
         }
+        else {
+            bitmask_scale_row(m, nm, y, ny, src_off, src_bit);
+        }
+        prev_y = y;
     }
+
+    free(src_off);
+    free(src_bit);
+    bitmask_changed(nm);
     return nm;
 }
 
+/* Sets each bit (x, y) of m that has the bit (x - n, y) set, for n > 0.
+ * The stripes are done from the right, so the bits read are not yet
+ * changed.
+ */
+static void
+bitmask_dilate_x(bitmask_t *m, int n)
+{
+    int stripes = (m->w - 1) / BITMASK_W_LEN + 1;
+    int q = n / BITMASK_W_LEN, r = n & BITMASK_W_MASK;
+    int s, y;
+    BITMASK_W *dst, *src;
+
+    for (s = stripes - 1; s >= q; s--) {
+        dst = m->bits + s * m->h;
+        src = m->bits + (s - q) * m->h;
+        if (!r) {
+            for (y = 0; y < m->h; y++) {
+                dst[y] |= src[y];
+            }
+        }
+        else if (s > q) {
+            for (y = 0; y < m->h; y++) {
+                dst[y] |= (src[y] << r) |
+                          (src[y - m->h] >> (BITMASK_W_LEN - r));
+            }
+        }
+        else {
+            for (y = 0; y < m->h; y++) {
+                dst[y] |= src[y] << r;
+            }
+        }
+    }
+}
+
+/* Fills d with a drawn len times, from x = 0 to len - 1, by doubling. */
+static void
+bitmask_dilate_run(bitmask_t *d, const bitmask_t *a, int len)
+{
+    int done;
+
+    bitmask_clear(d);
+    bitmask_draw(d, a, 0, 0);
+    for (done = 1; 2 * done <= len; done *= 2) {
+        bitmask_dilate_x(d, done);
+    }
+    if (done < len) {
+        /* shifts [0, done) and [len - done, len) cover [0, len) */
+        bitmask_dilate_x(d, len - done);
+    }
+}
+
 void
 bitmask_convolve(const bitmask_t *a, const bitmask_t *b, bitmask_t *output,
                  int xoffset, int yoffset)
 {
-    int x, y;
+    bitmask_t *run = NULL;
+    int x, y, i, len, run_len = 0;
 
     if (!a->h || !a->w || !b->h || !b->w || !output->h || !output->w) {
         return;
@@ -1088,8 +1425,167 @@ bitmask_convolve(const bitmask_t *a, const bitmask_t *b, bitmask_t *output,
     xoffset += b->w - 1;
     yoffset += b->h - 1;
 
-    for (y = 0; y < b->h; y++)
-        for (x = 0; x < b->w; x++)
-            if (bitmask_getbit(b, x, y))
-                bitmask_draw(output, a, xoffset - x, yoffset - y);
+    /* Each horizontal run of bits in b draws a, dilated along the run, once.
+       The dilated mask is only remade when the run length changes. */
+    for (y = 0; y < b->h; y++) {
+        for (x = 0; x < b->w; x += len) {
+            len = 1;
+            if (!bitmask_getbit(b, x, y)) {
+                continue;
+            }
+            while (x + len < b->w && bitmask_getbit(b, x + len, y)) {
+                len++;
+            }
+
+            if (len > 1 && len != run_len) {
+                if (!run) {
+                    run = bitmask_create(a->w + b->w - 1, a->h);
+                }
+                if (run) {
+                    bitmask_dilate_run(run, a, len);
+                    run_len = len;
+                }
+            }
+
+            if (len > 1 && len == run_len) {
+                bitmask_draw(output, run, xoffset - x - len + 1,
+                             yoffset - y);
+            }
+            else {
+                /* a single bit, or out of memory for the dilated mask */
+                for (i = 0; i < len; i++) {
+                    bitmask_draw(output, a, xoffset - x - i, yoffset - y);
+                }
+            }
+        }
+    }
+
+    bitmask_free(run);
+}
+
+/* Combines each bit (x, y) of m with the bit (x - n, y), ORing them to
+ * dilate or ANDing them to erode. Bits from outside of m count as unset.
+ * The stripes are done away from the ones read, so those are not yet
+ * changed.
+ */
+static void
+bitmask_shift_x(bitmask_t *m, int n, int erode)
+{
+    int stripes = (m->w - 1) / BITMASK_W_LEN + 1;
+    int q = abs(n) / BITMASK_W_LEN, r = abs(n) & BITMASK_W_MASK;
+    int i, s, near, far, y;
+    BITMASK_W *dst, *nearp, *farp, word, cmask;
+
+    for (i = 0; i < stripes; i++) {
+        s = n > 0 ? stripes - 1 - i : i;
+        near = n > 0 ? s - q : s + q;
+        far = n > 0 ? near - 1 : near + 1;
+        dst = m->bits + s * m->h;
+
+        if (near < 0 || near >= stripes) {
+            if (erode) {
+                memset(dst, 0, m->h * sizeof(BITMASK_W));
+            }
+            continue;
+        }
+        nearp = m->bits + near * m->h;
+        farp = (r && far >= 0 && far < stripes) ? m->bits + far * m->h : NULL;
+
+        for (y = 0; y < m->h; y++) {
+            word = n > 0 ? nearp[y] << r : nearp[y] >> r;
+            if (farp) {
+                word |= n > 0 ? farp[y] >> (BITMASK_W_LEN - r)
+                              : farp[y] << (BITMASK_W_LEN - r);
+            }
+            if (erode) {
+                dst[y] &= word;
+            }
+            else {
+                dst[y] |= word;
+            }
+        }
+    }
+
+    if (!erode && n > 0) {
+        /* keep the bits past the right edge clear */
+        cmask = (~(BITMASK_W)0) >>
+                positive_modulo(BITMASK_W_LEN - m->w, (int)BITMASK_W_LEN);
+        dst = m->bits + (stripes - 1) * m->h;
+        for (y = 0; y < m->h; y++) {
+            dst[y] &= cmask;
+        }
+    }
+}
+
+/* Combines each bit (x, y) of m with the bit (x, y - n), as
+ * bitmask_shift_x() does.
+ */
+static void
+bitmask_shift_y(bitmask_t *m, int n, int erode)
+{
+    int stripes = (m->w - 1) / BITMASK_W_LEN + 1;
+    int s, y, d = abs(n), edge = MIN(d, m->h);
+    BITMASK_W *col;
+
+    for (s = 0; s < stripes; s++) {
+        col = m->bits + s * m->h;
+        if (n > 0) {
+            for (y = m->h - 1; y >= d; y--) {
+                col[y] = erode ? col[y] & col[y - d] : col[y] | col[y - d];
+            }
+            if (erode) {
+                memset(col, 0, edge * sizeof(BITMASK_W));
+            }
+        }
+        else {
+            for (y = 0; y < m->h - d; y++) {
+                col[y] = erode ? col[y] & col[y + d] : col[y] | col[y + d];
+            }
+            if (erode) {
+                memset(col + m->h - edge, 0, edge * sizeof(BITMASK_W));
+            }
+        }
+    }
+}
+
+/* Combines each bit of m with all the bits up to n away from it in x and y,
+ * by doubling the shifts done in each direction.
+ */
+static void
+bitmask_morph(bitmask_t *m, int n, int erode)
+{
+    int dir, len, done;
+
+    if (!m->w || !m->h || n <= 0) {
+        return;
+    }
+
+    /* larger shifts only bring in bits from outside of m */
+    len = MIN(n, MAX(m->w, m->h)) + 1;
+
+    for (dir = 1; dir >= -1; dir -= 2) {
+        for (done = 1; 2 * done <= len; done *= 2) {
+            bitmask_shift_x(m, dir * done, erode);
+            bitmask_shift_y(m, dir * done, erode);
+        }
+        if (done < len) {
+            /* shifts [0, done) and [len - done, len) cover [0, len) */
+            bitmask_shift_x(m, dir * (len - done), erode);
+            bitmask_shift_y(m, dir * (len - done), erode);
+        }
+    }
+
+    bitmask_changed(m);
+}
+
+void
+bitmask_dilate(bitmask_t *m, int n)
+{
+    bitmask_morph(m, n, 0);
+}
+
+void
+bitmask_erode(bitmask_t *m, int n)
+{
+    bitmask_morph(m, n, 1);
 }
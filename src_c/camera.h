@@ -38,6 +38,7 @@
 #include <sys/time.h>
 #include <sys/mman.h>
 #include <sys/ioctl.h>
+#include <poll.h>
 
 /* on freebsd there is no asm/types */
 #ifdef linux
@@ -50,6 +51,10 @@
 #if defined(__WIN32__)
 #define PYGAME_WINDOWS_CAMERA 1
 
+/* converted frames kept by the windows backend: one being written, the
+ * newest one, and one being read */
+#define WINDOWS_CAMERA_POOL 3
+
 #include <mfapi.h>
 #include <mfobjects.h>
 #include <mfidl.h>
@@ -110,6 +115,25 @@ typedef struct pgCameraObject {
     int vflip;
     int brightness;
     int fd;
+    int held;            /* buffer dequeued for get_raw_view(), or -1 */
+    size_t held_bytes;   /* bytes of frame data in it */
+    Py_ssize_t n_views;  /* buffer exports of it still alive */
+    SDL_Thread *capture; /* start_capture() thread, or NULL */
+    SDL_mutex *capture_lock; /* guards the capture fields below */
+    SDL_cond *capture_cond;  /* signalled for every new frame */
+    SDL_Surface **frames;    /* pool of converted frames */
+    unsigned long *frame_seq; /* order of the queued frames, 0 if free */
+    int n_frames;
+    int reading;       /* frame being copied out, or -1 */
+    int capture_quit;
+    int capture_error; /* errno that ended the thread, or 0 */
+    int capture_event; /* event type posted for every frame, or 0 */
+    int capture_waiters; /* get_next() calls using the frames */
+    unsigned long captured;  /* frames converted */
+    unsigned long delivered; /* frames handed out */
+    unsigned long dropped;   /* frames replaced before being handed out */
+    void *jpeg;      /* TurboJPEG decompressor for MJPEG, or NULL */
+    Uint8 *jpeg_rgb; /* RGB24 frame for surfaces it cannot decode into */
 } pgCameraObject;
 #elif defined(PYGAME_WINDOWS_CAMERA)
 typedef struct pgCameraObject {
@@ -117,17 +141,23 @@ typedef struct pgCameraObject {
     IMFSourceReader *reader;
     IMFTransform *transform;
     IMFVideoProcessorControl *control;
-    IMFMediaBuffer *buf;
+    IMFSourceReaderCallback *callback; /* receives the async samples */
+    IMFSample *pool[WINDOWS_CAMERA_POOL]; /* converted frames, reused */
+    IMFMediaBuffer *pool_bufs[WINDOWS_CAMERA_POOL];
     IMFMediaBuffer *raw_buf;
+    SRWLOCK lock;   /* guards raw_buf and the pool slots below */
+    int ready_slot; /* newest converted frame, or -1 */
+    int read_slot;  /* frame being copied out, or -1 */
     int buffer_ready;
-    short open; /* used to signal the update_function to exit */
-    HANDLE t_handle;
+    short open;     /* used to signal the callback to stop reading */
+    HANDLE stopped; /* set once the callback has stopped reading */
     HRESULT t_error;
     int t_error_line;
     int width;
     int height;
     int hflip;
     int vflip;
+    int last_hflip;
     int last_vflip;
     int color_out;
     unsigned long pixelformat;
@@ -207,6 +237,16 @@ v4l2_query_buffer(pgCameraObject *self);
 int
 v4l2_read_frame(pgCameraObject *self, SDL_Surface *surf, int *errno_code);
 int
+v4l2_hold_frame(pgCameraObject *self, int *errno_code);
+int
+v4l2_release_frame(pgCameraObject *self);
+int
+v4l2_export_dmabuf(pgCameraObject *self);
+int
+v4l2_start_capture(pgCameraObject *self, int count, int event);
+void
+v4l2_stop_capture(pgCameraObject *self, SDL_Thread *thread);
+int
 v4l2_stop_capturing(pgCameraObject *self);
 int
 v4l2_start_capturing(pgCameraObject *self);
@@ -141,6 +141,13 @@ v4l2_set_control(int fd, int id, int value)
     return 1;
 }
 
+/* bytes of frame data in a dequeued buffer, which for MJPEG vary */
+static unsigned int
+v4l2_frame_bytes(pgCameraObject *self, struct v4l2_buffer *buf)
+{
+    return buf->bytesused ? buf->bytesused : self->buffers[buf->index].length;
+}
+
 /* returns a string of the buffer from the camera */
 /* TODO: fold this into the regular read_frame. lots of duplicate code */
 PyObject *
@@ -163,7 +170,7 @@ v4l2_read_raw(pgCameraObject *self)
     assert(buf.index < self->n_buffers);
 
     raw = PyBytes_FromStringAndSize(self->buffers[buf.index].start,
-                                    self->buffers[buf.index].length);
+                                    v4l2_frame_bytes(self, &buf));
 
     if (-1 == v4l2_xioctl(self->fd, VIDIOC_QBUF, &buf)) {
         PyErr_Format(PyExc_SystemError, "ioctl(VIDIOC_QBUF) failure : %d, %s",
@@ -194,6 +201,176 @@ v4l2_xioctl(int fd, int request, void *arg)
     return r;
 }
 
+/* MJPEG frames are decoded with the TurboJPEG API of libjpeg-turbo. It is
+ * loaded when a camera first looks for a format, so pygame neither links
+ * against it nor needs it for the raw formats. */
+typedef void *pg_tjhandle;
+
+#define PG_TJPF_RGB 0
+#define PG_TJPF_BGR 1
+#define PG_TJPF_RGBX 2
+#define PG_TJPF_BGRX 3
+#define PG_TJPF_XBGR 4
+#define PG_TJPF_XRGB 5
+#define PG_TJFLAG_FASTDCT 2048
+#define PG_TJERR_WARNING 0
+
+static struct {
+    int loaded; /* 0 if not tried yet, 1 if loaded, -1 if missing */
+    void *lib;
+    pg_tjhandle (*InitDecompress)(void);
+    int (*DecompressHeader3)(pg_tjhandle, const unsigned char *,
+                             unsigned long, int *, int *, int *, int *);
+    int (*Decompress2)(pg_tjhandle, const unsigned char *, unsigned long,
+                       unsigned char *, int, int, int, int, int);
+    int (*Destroy)(pg_tjhandle);
+    int (*GetErrorCode)(pg_tjhandle); /* libjpeg-turbo 2.0 and up */
+} pg_tj;
+
+/* Loads libjpeg-turbo if it can. Called with the GIL held. */
+static int
+v4l2_load_turbojpeg(void)
+{
+    static const char *names[] = {"libturbojpeg.so.0", "libturbojpeg.so",
+                                  NULL};
+    void *lib = NULL;
+    int i;
+
+    if (pg_tj.loaded)
+        return pg_tj.loaded > 0;
+    pg_tj.loaded = -1;
+
+    for (i = 0; names[i] && !lib; i++)
+        lib = SDL_LoadObject(names[i]);
+    if (!lib) {
+        SDL_ClearError();
+        return 0;
+    }
+    pg_tj.InitDecompress = SDL_LoadFunction(lib, "tjInitDecompress");
+    pg_tj.DecompressHeader3 = SDL_LoadFunction(lib, "tjDecompressHeader3");
+    pg_tj.Decompress2 = SDL_LoadFunction(lib, "tjDecompress2");
+    pg_tj.Destroy = SDL_LoadFunction(lib, "tjDestroy");
+    pg_tj.GetErrorCode = SDL_LoadFunction(lib, "tjGetErrorCode");
+    SDL_ClearError();
+    if (!pg_tj.InitDecompress || !pg_tj.DecompressHeader3 ||
+        !pg_tj.Decompress2 || !pg_tj.Destroy) {
+        SDL_UnloadObject(lib);
+        return 0;
+    }
+    pg_tj.lib = lib;
+    pg_tj.loaded = 1;
+    return 1;
+}
+
+/* The TurboJPEG pixel format laying out channels as surf does, or -1.
+ * 24 bit surfaces are b, g, r in memory, as the other converters write
+ * them. */
+static int
+v4l2_turbojpeg_format(SDL_PixelFormat *format)
+{
+    int r, g, b;
+
+    if (format->Rloss || format->Gloss || format->Bloss)
+        return -1;
+    if (format->BytesPerPixel == 3)
+        return PG_TJPF_BGR;
+    if (format->BytesPerPixel != 4 || format->Rshift % 8 ||
+        format->Gshift % 8 || format->Bshift % 8)
+        return -1;
+
+    /* byte offsets of the channels in memory */
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    r = format->Rshift / 8;
+    g = format->Gshift / 8;
+    b = format->Bshift / 8;
+#else
+    r = 3 - format->Rshift / 8;
+    g = 3 - format->Gshift / 8;
+    b = 3 - format->Bshift / 8;
+#endif
+    if (r == 0 && g == 1 && b == 2)
+        return PG_TJPF_RGBX;
+    if (b == 0 && g == 1 && r == 2)
+        return PG_TJPF_BGRX;
+    if (b == 1 && g == 2 && r == 3)
+        return PG_TJPF_XBGR;
+    if (r == 1 && g == 2 && b == 3)
+        return PG_TJPF_XRGB;
+    return -1;
+}
+
+/* Decompresses a JPEG, counting a warning such as a truncated frame, which
+ * webcams send now and then, as decoded. */
+static int
+v4l2_decompress(pgCameraObject *self, const void *image, int size,
+                Uint8 *dst, int pitch, int tjpf)
+{
+    if (!pg_tj.Decompress2(self->jpeg, (const unsigned char *)image, size,
+                           dst, self->width, pitch, self->height, tjpf,
+                           PG_TJFLAG_FASTDCT))
+        return 1;
+    return pg_tj.GetErrorCode &&
+           pg_tj.GetErrorCode(self->jpeg) == PG_TJERR_WARNING;
+}
+
+/* Decodes a MJPEG frame into surf, straight into its pixels when
+ * TurboJPEG can write their layout.
+ * This function is safe to be called with GIL released. */
+static int
+v4l2_decode_mjpeg(pgCameraObject *self, const void *image, int size,
+                  SDL_Surface *surf)
+{
+    int w, h, subsamp, colorspace;
+    int tjpf = v4l2_turbojpeg_format(surf->format);
+
+    if (!self->jpeg ||
+        pg_tj.DecompressHeader3(self->jpeg, (const unsigned char *)image,
+                                size, &w, &h, &subsamp, &colorspace) ||
+        w != self->width || h != self->height)
+        return 0;
+
+    if (tjpf != -1) {
+        if (!v4l2_decompress(self, image, size, (Uint8 *)surf->pixels,
+                             surf->pitch, tjpf))
+            return 0;
+        switch (self->color_out) {
+            case HSV_OUT:
+                rgb_to_hsv(surf->pixels, surf->pixels, self->size,
+                           V4L2_PIX_FMT_MJPEG, surf->format);
+                break;
+            case YUV_OUT:
+                rgb_to_yuv(surf->pixels, surf->pixels, self->size,
+                           V4L2_PIX_FMT_MJPEG, surf->format);
+                break;
+        }
+        return 1;
+    }
+
+    if (!self->jpeg_rgb) {
+        self->jpeg_rgb = (Uint8 *)malloc((size_t)self->size * 3);
+        if (!self->jpeg_rgb)
+            return 0;
+    }
+    if (!v4l2_decompress(self, image, size, self->jpeg_rgb, self->width * 3,
+                         PG_TJPF_RGB))
+        return 0;
+    switch (self->color_out) {
+        case RGB_OUT:
+            rgb24_to_rgb(self->jpeg_rgb, surf->pixels, self->size,
+                         surf->format);
+            break;
+        case HSV_OUT:
+            rgb_to_hsv(self->jpeg_rgb, surf->pixels, self->size,
+                       V4L2_PIX_FMT_RGB24, surf->format);
+            break;
+        case YUV_OUT:
+            rgb_to_yuv(self->jpeg_rgb, surf->pixels, self->size,
+                       V4L2_PIX_FMT_RGB24, surf->format);
+            break;
+    }
+    return 1;
+}
+
 /* sends the image to the conversion function based on input format and
    desired output format.  Note that some of the less common conversions are
    currently two step processes. */
@@ -350,6 +527,12 @@ v4l2_process_image(pgCameraObject *self, const void *image, int buffer_size,
                 return 0;
             }
             break;
+        case V4L2_PIX_FMT_MJPEG:
+            if (!v4l2_decode_mjpeg(self, image, buffer_size, surf)) {
+                SDL_UnlockSurface(surf);
+                return 0;
+            }
+            break;
     }
     SDL_UnlockSurface(surf);
     return 1;
@@ -405,7 +588,7 @@ v4l2_read_frame(pgCameraObject *self, SDL_Surface *surf, int *errno_code)
     assert(buf.index < self->n_buffers);
 
     if (!v4l2_process_image(self, self->buffers[buf.index].start,
-                            self->buffers[buf.index].length, surf)) {
+                            v4l2_frame_bytes(self, &buf), surf)) {
         return 0;
     }
 
@@ -416,11 +599,278 @@ v4l2_read_frame(pgCameraObject *self, SDL_Surface *surf, int *errno_code)
     return 1;
 }
 
+/* Dequeues the next frame, and keeps its buffer out of the queue so it can
+ * be read in place. The buffer held before goes back into the queue.
+ * This function is safe to be called with GIL released.
+ */
+int
+v4l2_hold_frame(pgCameraObject *self, int *errno_code)
+{
+    struct v4l2_buffer buf;
+
+    CLEAR(buf);
+
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+
+    if (self->held != -1) {
+        buf.index = self->held;
+        if (-1 == v4l2_xioctl(self->fd, VIDIOC_QBUF, &buf)) {
+            *errno_code = errno;
+            return 0;
+        }
+        self->held = -1;
+    }
+
+    if (-1 == v4l2_xioctl(self->fd, VIDIOC_DQBUF, &buf)) {
+        *errno_code = errno;
+        return 0;
+    }
+
+    assert(buf.index < self->n_buffers);
+
+    self->held = buf.index;
+    self->held_bytes = buf.bytesused ? buf.bytesused
+                                     : self->buffers[buf.index].length;
+    return 1;
+}
+
+/* puts the held buffer back into the queue */
+int
+v4l2_release_frame(pgCameraObject *self)
+{
+    struct v4l2_buffer buf;
+
+    if (self->held == -1)
+        return 1;
+
+    CLEAR(buf);
+
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = self->held;
+
+    self->held = -1;
+    if (-1 == v4l2_xioctl(self->fd, VIDIOC_QBUF, &buf)) {
+        PyErr_Format(PyExc_SystemError, "ioctl(VIDIOC_QBUF) failure : %d, %s",
+                     errno, strerror(errno));
+        return 0;
+    }
+    return 1;
+}
+
+/* returns a new DMABUF file descriptor for the held buffer, or -1 */
+int
+v4l2_export_dmabuf(pgCameraObject *self)
+{
+#ifdef VIDIOC_EXPBUF
+    struct v4l2_exportbuffer expbuf;
+
+    CLEAR(expbuf);
+
+    expbuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    expbuf.index = self->held;
+    expbuf.flags = O_RDONLY | O_CLOEXEC;
+
+    if (-1 == v4l2_xioctl(self->fd, VIDIOC_EXPBUF, &expbuf)) {
+        PyErr_Format(PyExc_SystemError,
+                     "ioctl(VIDIOC_EXPBUF) failure : %d, %s", errno,
+                     strerror(errno));
+        return -1;
+    }
+    return expbuf.fd;
+#else
+    PyErr_SetString(PyExc_NotImplementedError,
+                    "DMABUF export needs V4L2 headers from Linux 3.8");
+    return -1;
+#endif
+}
+
+/* Picks the frame the capture thread converts into next: a free one, or
+ * failing that the oldest queued one, which is then dropped. Called with
+ * capture_lock held. */
+static int
+v4l2_capture_slot(pgCameraObject *self)
+{
+    int i, oldest = -1;
+
+    for (i = 0; i < self->n_frames; i++) {
+        if (i == self->reading)
+            continue;
+        if (!self->frame_seq[i])
+            return i;
+        if (oldest == -1 || self->frame_seq[i] < self->frame_seq[oldest])
+            oldest = i;
+    }
+    self->frame_seq[oldest] = 0;
+    self->dropped++;
+    return oldest;
+}
+
+/* The start_capture() thread. It never takes the GIL. */
+static int SDLCALL
+v4l2_capture_run(void *data)
+{
+    pgCameraObject *self = (pgCameraObject *)data;
+    struct v4l2_buffer buf;
+    struct pollfd pfd;
+    SDL_Event event;
+    int slot, ready, error = 0;
+
+    pfd.fd = self->fd;
+    pfd.events = POLLIN;
+
+    SDL_LockMutex(self->capture_lock);
+    while (!self->capture_quit) {
+        SDL_UnlockMutex(self->capture_lock);
+
+        /* wake up now and then to see if we are asked to quit */
+        ready = poll(&pfd, 1, 100);
+        if (ready == -1 && errno != EINTR) {
+            error = errno;
+        }
+        else if (ready > 0) {
+            CLEAR(buf);
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = V4L2_MEMORY_MMAP;
+            if (-1 == v4l2_xioctl(self->fd, VIDIOC_DQBUF, &buf)) {
+                if (errno != EAGAIN)
+                    error = errno;
+            }
+            else {
+                SDL_LockMutex(self->capture_lock);
+                slot = v4l2_capture_slot(self);
+                /* keeps get_next() off the frame while it is written */
+                self->frame_seq[slot] = 0;
+                SDL_UnlockMutex(self->capture_lock);
+
+                ready = v4l2_process_image(
+                    self, self->buffers[buf.index].start,
+                    v4l2_frame_bytes(self, &buf), self->frames[slot]);
+                if (-1 == v4l2_xioctl(self->fd, VIDIOC_QBUF, &buf))
+                    error = errno;
+
+                SDL_LockMutex(self->capture_lock);
+                if (ready) {
+                    self->frame_seq[slot] = ++self->captured;
+                    SDL_CondBroadcast(self->capture_cond);
+                }
+                SDL_UnlockMutex(self->capture_lock);
+
+                if (ready && self->capture_event &&
+                    SDL_WasInit(SDL_INIT_VIDEO)) {
+                    SDL_zero(event);
+                    event.type = self->capture_event;
+                    SDL_PushEvent(&event);
+                }
+            }
+        }
+
+        SDL_LockMutex(self->capture_lock);
+        if (error) {
+            self->capture_error = error;
+            SDL_CondBroadcast(self->capture_cond);
+            break;
+        }
+    }
+    SDL_UnlockMutex(self->capture_lock);
+    return 0;
+}
+
+/* Frees the frame pool and the capture thread's locks. */
+static void
+v4l2_free_capture(pgCameraObject *self)
+{
+    int i;
+
+    if (self->frames) {
+        for (i = 0; i < self->n_frames; i++)
+            SDL_FreeSurface(self->frames[i]);
+        free(self->frames);
+        self->frames = NULL;
+    }
+    free(self->frame_seq);
+    self->frame_seq = NULL;
+    self->n_frames = 0;
+    if (self->capture_cond) {
+        SDL_DestroyCond(self->capture_cond);
+        self->capture_cond = NULL;
+    }
+    if (self->capture_lock) {
+        SDL_DestroyMutex(self->capture_lock);
+        self->capture_lock = NULL;
+    }
+}
+
+/* Starts a thread converting every frame into a pool of count surfaces.
+ * Returns 0 with a Python error set on failure. */
+int
+v4l2_start_capture(pgCameraObject *self, int count, int event)
+{
+    int i;
+
+    self->frames = (SDL_Surface **)calloc(count, sizeof(SDL_Surface *));
+    self->frame_seq = (unsigned long *)calloc(count, sizeof(unsigned long));
+    self->capture_lock = SDL_CreateMutex();
+    self->capture_cond = SDL_CreateCond();
+    if (!self->frames || !self->frame_seq || !self->capture_lock ||
+        !self->capture_cond) {
+        self->n_frames = count;
+        v4l2_free_capture(self);
+        PyErr_NoMemory();
+        return 0;
+    }
+    self->n_frames = count;
+    for (i = 0; i < count; i++) {
+        /* the same format get_image() makes its surfaces in */
+        self->frames[i] =
+            SDL_CreateRGBSurface(0, self->width, self->height, 24,
+                                 0xFF << 16, 0xFF << 8, 0xFF, 0);
+        if (!self->frames[i]) {
+            PyErr_SetString(pgExc_SDLError, SDL_GetError());
+            v4l2_free_capture(self);
+            return 0;
+        }
+    }
+
+    self->reading = -1;
+    self->capture_quit = 0;
+    self->capture_error = 0;
+    self->capture_event = event;
+    self->captured = self->delivered = self->dropped = 0;
+    self->capture = SDL_CreateThread(v4l2_capture_run, "pygame_camera", self);
+    if (!self->capture) {
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        v4l2_free_capture(self);
+        return 0;
+    }
+    return 1;
+}
+
+/* Stops the capture thread, which the caller already took off
+ * self->capture, and frees its frames. get_next() calls still using them
+ * are woken and waited for first.
+ * This function is safe to be called with GIL released. */
+void
+v4l2_stop_capture(pgCameraObject *self, SDL_Thread *thread)
+{
+    SDL_LockMutex(self->capture_lock);
+    self->capture_quit = 1;
+    SDL_CondBroadcast(self->capture_cond);
+    while (self->capture_waiters)
+        SDL_CondWait(self->capture_cond, self->capture_lock);
+    SDL_UnlockMutex(self->capture_lock);
+    SDL_WaitThread(thread, NULL);
+    v4l2_free_capture(self);
+}
+
 int
 v4l2_stop_capturing(pgCameraObject *self)
 {
     enum v4l2_buf_type type;
 
+    /* the buffers all leave the queues on VIDIOC_STREAMOFF */
+    self->held = -1;
     type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
 
     if (-1 == v4l2_xioctl(self->fd, VIDIOC_STREAMOFF, &type)) {
@@ -483,6 +933,13 @@ v4l2_uninit_device(pgCameraObject *self)
 
     free(self->buffers);
 
+    if (self->jpeg) {
+        pg_tj.Destroy(self->jpeg);
+        self->jpeg = NULL;
+    }
+    free(self->jpeg_rgb);
+    self->jpeg_rgb = NULL;
+
     return 1;
 }
 
@@ -624,6 +1081,10 @@ v4l2_init_device(pgCameraObject *self)
             else if (v4l2_pixelformat(self->fd, &fmt, V4L2_PIX_FMT_SBGGR8)) {
                 self->pixelformat = V4L2_PIX_FMT_SBGGR8;
             }
+            else if (v4l2_load_turbojpeg() &&
+                     v4l2_pixelformat(self->fd, &fmt, V4L2_PIX_FMT_MJPEG)) {
+                self->pixelformat = V4L2_PIX_FMT_MJPEG;
+            }
             else {
                 PyErr_Format(
                     PyExc_SystemError,
@@ -650,6 +1111,10 @@ v4l2_init_device(pgCameraObject *self)
             else if (v4l2_pixelformat(self->fd, &fmt, V4L2_PIX_FMT_UYVY)) {
                 self->pixelformat = V4L2_PIX_FMT_UYVY;
             }
+            else if (v4l2_load_turbojpeg() &&
+                     v4l2_pixelformat(self->fd, &fmt, V4L2_PIX_FMT_MJPEG)) {
+                self->pixelformat = V4L2_PIX_FMT_MJPEG;
+            }
             else {
                 PyErr_Format(
                     PyExc_SystemError,
@@ -659,6 +1124,41 @@ v4l2_init_device(pgCameraObject *self)
             break;
     }
 
+    /* USB 2 cameras often give their larger sizes only as MJPEG, so take it
+       over a raw format the driver had to shrink. */
+    if (fmt.fmt.pix.pixelformat != V4L2_PIX_FMT_MJPEG &&
+        (fmt.fmt.pix.width < (unsigned int)self->width ||
+         fmt.fmt.pix.height < (unsigned int)self->height) &&
+        v4l2_load_turbojpeg()) {
+        struct v4l2_format mjpeg;
+
+        CLEAR(mjpeg);
+        mjpeg.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        mjpeg.fmt.pix.width = self->width;
+        mjpeg.fmt.pix.height = self->height;
+        mjpeg.fmt.pix.field = V4L2_FIELD_ANY;
+        if (v4l2_pixelformat(self->fd, &mjpeg, V4L2_PIX_FMT_MJPEG) &&
+            mjpeg.fmt.pix.width * mjpeg.fmt.pix.height >
+                fmt.fmt.pix.width * fmt.fmt.pix.height) {
+            fmt = mjpeg;
+        }
+        else if (-1 == v4l2_xioctl(self->fd, VIDIOC_S_FMT, &fmt)) {
+            PyErr_Format(PyExc_SystemError,
+                         "ioctl(VIDIOC_S_FMT) failure : %d, %s", errno,
+                         strerror(errno));
+            return 0;
+        }
+    }
+
+    if (fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_MJPEG) {
+        self->jpeg = pg_tj.InitDecompress();
+        if (!self->jpeg) {
+            PyErr_SetString(PyExc_SystemError,
+                            "cannot start the MJPEG decoder");
+            return 0;
+        }
+    }
+
     /* Note VIDIOC_S_FMT may change width and height. */
     self->width = fmt.fmt.pix.width;
     self->height = fmt.fmt.pix.height;
@@ -79,7 +79,7 @@
     if (FAILED(hr)) {                  \
         self->t_error = hr;            \
         self->t_error_line = __LINE__; \
-        break;                         \
+        return hr;                     \
     }
 
 #define T_FORMATHR(hr, line)                               \
@@ -513,103 +513,224 @@ cleanup:
     return 0;
 }
 
-DWORD WINAPI
-update_function(LPVOID lpParam)
+/* The source reader runs in asynchronous mode. Every sample arrives in
+ * OnReadSample() on a Media Foundation work queue thread, which puts it
+ * through the video processor into a free frame of self->pool and asks for
+ * the next one. The pool is allocated once in windows_open_device(), so no
+ * COM objects are created per frame. */
+typedef struct pgReaderCallback {
+    IMFSourceReaderCallback iface; /* must stay first */
+    LONG refs;
+    pgCameraObject *cam;
+} pgReaderCallback;
+
+static HRESULT STDMETHODCALLTYPE
+_callback_query_interface(IMFSourceReaderCallback *iface, REFIID riid,
+                          void **ppv)
 {
-    pgCameraObject *self = (pgCameraObject *)lpParam;
+    if (IsEqualIID(riid, &IID_IUnknown) ||
+        IsEqualIID(riid, &IID_IMFSourceReaderCallback)) {
+        *ppv = iface;
+        iface->lpVtbl->AddRef(iface);
+        return S_OK;
+    }
+    *ppv = NULL;
+    return E_NOINTERFACE;
+}
 
-    IMFSample *sample;
-    HRESULT hr;
-    DWORD pdwStreamFlags;
+static ULONG STDMETHODCALLTYPE
+_callback_add_ref(IMFSourceReaderCallback *iface)
+{
+    return InterlockedIncrement(&((pgReaderCallback *)iface)->refs);
+}
 
-    IMFSourceReader *reader = self->reader;
+static ULONG STDMETHODCALLTYPE
+_callback_release(IMFSourceReaderCallback *iface)
+{
+    LONG refs = InterlockedDecrement(&((pgReaderCallback *)iface)->refs);
+    if (!refs) {
+        free(iface);
+    }
+    return refs;
+}
 
-    IMFMediaType *output_type;
+/* flip control subsystem -
+ * I managed to do it all within media foundation, without
+ * camera_mac.m's flip_image, or v4l2's set_controls API.
+ * The self->transform (Video Processor MFT) also exposes a control
+ * interface, which can be used to set vertical or horizontal
+ * mirroring, but not both. So for vertical mirroring, it changes the
+ * stride of the image so it comes out of the transform upside down */
+static HRESULT
+_update_flips(pgCameraObject *self)
+{
+    IMFMediaType *output_type = NULL;
+    HRESULT hr;
     INT32 stride;
+    int hflip = self->hflip, vflip = self->vflip;
 
-    while (1) {
-        sample = NULL;
-
-        /* flip control subsystem -
-         * I managed to do it all within media foundation, without
-         * camera_mac.m's flip_image, or v4l2's set_controls API.
-         * The self->transform (Video Processor MFT) also exposes a control
-         * interface, which can be used to set vertical or horizontal
-         * mirroring, but not both. So for vertical mirroring, it changes the
-         * stride of the image so it comes out of the transform upside down */
-        if (self->hflip) {
-            hr = self->control->lpVtbl->SetMirror(self->control,
-                                                  MIRROR_HORIZONTAL);
-            T_HANDLEHR(hr);
-        }
-        else {
-            hr = self->control->lpVtbl->SetMirror(self->control, MIRROR_NONE);
-            T_HANDLEHR(hr);
-        }
+    if (hflip != self->last_hflip) {
+        hr = self->control->lpVtbl->SetMirror(
+            self->control, hflip ? MIRROR_HORIZONTAL : MIRROR_NONE);
+        T_HANDLEHR(hr);
+        self->last_hflip = hflip;
+    }
 
-        if (self->vflip != self->last_vflip) {
-            hr = self->transform->lpVtbl->GetOutputCurrentType(
-                self->transform, 0, &output_type);
-            T_HANDLEHR(hr);
-            hr = output_type->lpVtbl->GetUINT32(
-                output_type, &MF_MT_DEFAULT_STRIDE, &stride);
-            T_HANDLEHR(hr);
+    if (vflip != self->last_vflip) {
+        hr = self->transform->lpVtbl->GetOutputCurrentType(self->transform,
+                                                           0, &output_type);
+        T_HANDLEHR(hr);
+        hr = output_type->lpVtbl->GetUINT32(output_type,
+                                            &MF_MT_DEFAULT_STRIDE, &stride);
+        if (SUCCEEDED(hr)) {
             hr = output_type->lpVtbl->SetUINT32(
                 output_type, &MF_MT_DEFAULT_STRIDE, -stride);
-            T_HANDLEHR(hr);
+        }
+        if (SUCCEEDED(hr)) {
             hr = self->transform->lpVtbl->SetOutputType(self->transform, 0,
                                                         output_type, 0);
-            T_HANDLEHR(hr);
-            self->last_vflip = self->vflip;
         }
-
-        hr = reader->lpVtbl->ReadSample(reader, FIRST_VIDEO, 0, 0,
-                                        &pdwStreamFlags, NULL, &sample);
+        RELEASE(output_type);
         T_HANDLEHR(hr);
+        self->last_vflip = vflip;
+    }
+    return S_OK;
+}
 
-        if (!self->open) {
-            RELEASE(sample);
-            break;
-        }
+/* Converts a sample from the camera into a free frame of the pool and
+ * publishes it as the newest one. */
+static HRESULT
+_process_sample(pgCameraObject *self, IMFSample *sample)
+{
+    MFT_OUTPUT_DATA_BUFFER out_buf;
+    IMFMediaBuffer *raw = NULL;
+    HRESULT hr;
+    DWORD status;
+    int slot;
+
+    hr = _update_flips(self);
+    if (FAILED(hr)) {
+        return hr;
+    }
 
-        if (sample) {
-            /* Put unprocessed sample into another buffer for get_raw() */
-            RELEASE(self->raw_buf);
-            sample->lpVtbl->ConvertToContiguousBuffer(sample, &self->raw_buf);
+    /* Keep the unprocessed sample for get_raw(). For the single buffer
+     * samples cameras deliver this references the buffer, it doesn't copy */
+    if (SUCCEEDED(sample->lpVtbl->ConvertToContiguousBuffer(sample, &raw))) {
+        AcquireSRWLockExclusive(&self->lock);
+        RELEASE(self->raw_buf);
+        self->raw_buf = raw;
+        ReleaseSRWLockExclusive(&self->lock);
+    }
 
-            hr = self->transform->lpVtbl->ProcessInput(self->transform, 0,
-                                                       sample, 0);
-            T_HANDLEHR(hr);
+    hr = self->transform->lpVtbl->ProcessInput(self->transform, 0, sample, 0);
+    T_HANDLEHR(hr);
 
-            MFT_OUTPUT_DATA_BUFFER mft_buffer[1];
-            MFT_OUTPUT_DATA_BUFFER x;
+    /* with three frames there is always one that is neither the newest
+     * frame nor the one being read */
+    AcquireSRWLockShared(&self->lock);
+    for (slot = 0; slot < WINDOWS_CAMERA_POOL; slot++) {
+        if (slot != self->ready_slot && slot != self->read_slot) {
+            break;
+        }
+    }
+    ReleaseSRWLockShared(&self->lock);
+
+    out_buf.dwStreamID = 0;
+    out_buf.pSample = self->pool[slot];
+    out_buf.dwStatus = 0;
+    out_buf.pEvents = NULL;
+
+    hr = self->transform->lpVtbl->ProcessOutput(self->transform, 0, 1,
+                                                &out_buf, &status);
+    RELEASE(out_buf.pEvents);
+    if (hr == MF_E_TRANSFORM_NEED_MORE_INPUT) {
+        return S_OK;
+    }
+    T_HANDLEHR(hr);
 
-            IMFSample *ns;
-            hr = MFCreateSample(&ns);
-            T_HANDLEHR(hr);
+    AcquireSRWLockExclusive(&self->lock);
+    self->ready_slot = slot;
+    self->buffer_ready = 1;
+    ReleaseSRWLockExclusive(&self->lock);
+    return S_OK;
+}
 
-            hr = ns->lpVtbl->AddBuffer(ns, self->buf);
-            T_HANDLEHR(hr);
+static HRESULT STDMETHODCALLTYPE
+_callback_on_read_sample(IMFSourceReaderCallback *iface, HRESULT hr_status,
+                         DWORD stream_index, DWORD stream_flags,
+                         LONGLONG timestamp, IMFSample *sample)
+{
+    pgCameraObject *self = ((pgReaderCallback *)iface)->cam;
+    HRESULT hr = hr_status;
 
-            x.pSample = ns;
-            x.dwStreamID = 0;
-            x.dwStatus = 0;
-            x.pEvents = NULL;
-            mft_buffer[0] = x;
+    if (!self) {
+        return S_OK;
+    }
 
-            DWORD out;
-            hr = self->transform->lpVtbl->ProcessOutput(self->transform, 0, 1,
-                                                        mft_buffer, &out);
-            T_HANDLEHR(hr);
+    if (SUCCEEDED(hr) && self->open) {
+        if (stream_flags & MF_SOURCE_READERF_ERROR) {
+            hr = E_FAIL;
+            self->t_error = hr;
+            self->t_error_line = __LINE__;
+        }
+        else if (sample) {
+            hr = _process_sample(self, sample);
+        }
 
-            self->buffer_ready = 1;
+        if (SUCCEEDED(hr) && self->open) {
+            hr = self->reader->lpVtbl->ReadSample(self->reader, FIRST_VIDEO,
+                                                  0, NULL, NULL, NULL, NULL);
+            if (SUCCEEDED(hr)) {
+                return S_OK;
+            }
+            self->t_error = hr;
+            self->t_error_line = __LINE__;
         }
+    }
+    else if (FAILED(hr) && self->open) {
+        self->t_error = hr;
+        self->t_error_line = __LINE__;
+    }
+
+    /* closed or failed, either way no more samples were asked for */
+    SetEvent(self->stopped);
+    return S_OK;
+}
+
+static HRESULT STDMETHODCALLTYPE
+_callback_on_flush(IMFSourceReaderCallback *iface, DWORD stream_index)
+{
+    pgCameraObject *self = ((pgReaderCallback *)iface)->cam;
 
-        RELEASE(sample);
+    if (self) {
+        SetEvent(self->stopped);
     }
+    return S_OK;
+}
+
+static HRESULT STDMETHODCALLTYPE
+_callback_on_event(IMFSourceReaderCallback *iface, DWORD stream_index,
+                   IMFMediaEvent *event)
+{
+    return S_OK;
+}
 
-    /* printf("exiting 2nd thread...\n"); */
-    ExitThread(0);
+static IMFSourceReaderCallbackVtbl callback_vtbl = {
+    _callback_query_interface, _callback_add_ref, _callback_release,
+    _callback_on_read_sample,  _callback_on_flush, _callback_on_event};
+
+static IMFSourceReaderCallback *
+_create_callback(pgCameraObject *self)
+{
+    pgReaderCallback *callback = malloc(sizeof(pgReaderCallback));
+
+    if (!callback) {
+        return NULL;
+    }
+    callback->iface.lpVtbl = &callback_vtbl;
+    callback->refs = 1;
+    callback->cam = self;
+    return &callback->iface;
 }
 
 int
@@ -621,6 +742,7 @@ windows_open_device(pgCameraObject *self)
     IMFTransform *transform = NULL;
     IMFMediaType *source_type = NULL;
     IMFMediaType *conv_type = NULL;
+    IMFAttributes *rsa = NULL;
     MFT_OUTPUT_STREAM_INFO info;
     HRESULT hr;
 
@@ -630,23 +752,29 @@ windows_open_device(pgCameraObject *self)
     RELEASE(act);
     HANDLEHR(hr);
 
-    /* The commented out code below sets the source reader to use video
-     * processing, which guarantees it can output RGB32 from any format.
-     * Sadly, using the source reader in this way would only let me open
-     * the webcam in a single size, so I replaced it with a video processor
-     * MFT. (Which also helps with the flip controls). */
-    /*
-    IMFAttributes *rsa;
-    MFCreateAttributes(&rsa, 1);
-    rsa->lpVtbl->SetUINT32(rsa, &MF_SOURCE_READER_ENABLE_VIDEO_PROCESSING, 1);
-
-    hr = MFCreateSourceReaderFromMediaSource(source, rsa, &reader);
-    RELEASE(rsa);
-    CHECKHR(hr);
-    */
+    /* The source reader could also do video processing itself, which
+     * guarantees it can output RGB32 from any format
+     * (MF_SOURCE_READER_ENABLE_VIDEO_PROCESSING). Sadly, using the source
+     * reader in this way would only let me open the webcam in a single size,
+     * so I replaced it with a video processor MFT. (Which also helps with
+     * the flip controls). */
+    self->callback = _create_callback(self);
+    if (!self->callback) {
+        RELEASE(source);
+        hr = E_OUTOFMEMORY;
+        HANDLEHR(hr);
+    }
 
-    hr = MFCreateSourceReaderFromMediaSource(source, NULL, &reader);
+    hr = MFCreateAttributes(&rsa, 1);
+    if (SUCCEEDED(hr)) {
+        hr = rsa->lpVtbl->SetUnknown(rsa, &MF_SOURCE_READER_ASYNC_CALLBACK,
+                                     (IUnknown *)self->callback);
+    }
+    if (SUCCEEDED(hr)) {
+        hr = MFCreateSourceReaderFromMediaSource(source, rsa, &reader);
+    }
     self->reader = reader;
+    RELEASE(rsa);
     RELEASE(source);
     HANDLEHR(hr);
 
@@ -682,14 +810,38 @@ windows_open_device(pgCameraObject *self)
                                                       &info);
     HANDLEHR(hr);
 
-    hr = MFCreateMemoryBuffer(info.cbSize, &self->buf);
-    HANDLEHR(hr);
+    for (int i = 0; i < WINDOWS_CAMERA_POOL; i++) {
+        hr = MFCreateSample(&self->pool[i]);
+        HANDLEHR(hr);
 
-    self->t_handle = CreateThread(NULL, 0, update_function, self, 0, NULL);
+        hr = MFCreateMemoryBuffer(info.cbSize, &self->pool_bufs[i]);
+        HANDLEHR(hr);
 
-    self->open = 1; /* set here, since this shouldn't happen on error */
+        hr = self->pool[i]->lpVtbl->AddBuffer(self->pool[i],
+                                              self->pool_bufs[i]);
+        HANDLEHR(hr);
+    }
+
+    self->stopped = CreateEvent(NULL, TRUE, FALSE, NULL);
+    if (!self->stopped) {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        HANDLEHR(hr);
+    }
+
+    self->ready_slot = -1;
+    self->read_slot = -1;
+    self->buffer_ready = 0;
+    self->last_hflip = -1;
     self->t_error = S_OK;
     self->t_error_line = 0;
+    self->open = 1; /* set here, since this shouldn't happen on error */
+
+    /* In asynchronous mode this returns at once, the sample goes to the
+     * callback, which then asks for the next one itself */
+    hr = reader->lpVtbl->ReadSample(reader, FIRST_VIDEO, 0, NULL, NULL, NULL,
+                                    NULL);
+    HANDLEHR(hr);
+
     return 1;
 
 cleanup:
@@ -700,16 +852,35 @@ cleanup:
 int
 windows_close_device(pgCameraObject *self)
 {
+    short was_open = self->open;
+
     self->open = 0;
-    if (self->t_handle) {
-        WaitForSingleObject(self->t_handle, 3000);
+    if (self->reader && self->stopped && was_open) {
+        /* cancels the outstanding read, the callback sets self->stopped
+         * from OnFlush() or from the last OnReadSample() */
+        self->reader->lpVtbl->Flush(self->reader, FIRST_VIDEO);
+        WaitForSingleObject(self->stopped, 3000);
+    }
+    if (self->callback) {
+        ((pgReaderCallback *)self->callback)->cam = NULL;
     }
 
     RELEASE(self->reader);
+    RELEASE(self->callback);
     RELEASE(self->transform);
     RELEASE(self->control);
-    RELEASE(self->buf);
+    for (int i = 0; i < WINDOWS_CAMERA_POOL; i++) {
+        RELEASE(self->pool[i]);
+        RELEASE(self->pool_bufs[i]);
+    }
     RELEASE(self->raw_buf);
+    if (self->stopped) {
+        CloseHandle(self->stopped);
+        self->stopped = NULL;
+    }
+    self->ready_slot = -1;
+    self->read_slot = -1;
+    self->buffer_ready = 0;
 
     return 1;
 }
@@ -740,6 +911,16 @@ windows_dealloc_device(pgCameraObject *self)
     CoUninitialize();
 }
 
+static int
+_surface_is_rgb32(SDL_Surface *surf)
+{
+    SDL_PixelFormat *format = surf->format;
+
+    return format->BytesPerPixel == 4 && format->Rmask == 0xFF0000 &&
+           format->Gmask == 0xFF00 && format->Bmask == 0xFF &&
+           !format->Amask && surf->pitch == surf->w * 4;
+}
+
 int
 windows_process_image(pgCameraObject *self, BYTE *data, DWORD length,
                       SDL_Surface *surf)
@@ -752,10 +933,14 @@ windows_process_image(pgCameraObject *self, BYTE *data, DWORD length,
     if (self->pixelformat == MFVideoFormat_RGB32.Data1) {
         switch (self->color_out) {
             case RGB_OUT:
-                /* optimized version for 32 bit output surfaces*/
-                /* memcpy(surf->pixels, data, length); */
-
-                bgr32_to_rgb(data, surf->pixels, size, surf->format);
+                /* the default get_image() surface has the same layout as
+                 * RGB32, so it needs no conversion at all */
+                if (_surface_is_rgb32(surf) && length >= (DWORD)size * 4) {
+                    memcpy(surf->pixels, data, (size_t)size * 4);
+                }
+                else {
+                    bgr32_to_rgb(data, surf->pixels, size, surf->format);
+                }
                 break;
             case YUV_OUT:
                 rgb_to_yuv(data, surf->pixels, size, V4L2_PIX_FMT_XBGR32,
@@ -792,7 +977,12 @@ windows_process_image(pgCameraObject *self, BYTE *data, DWORD length,
 int
 windows_read_frame(pgCameraObject *self, SDL_Surface *surf)
 {
+    IMFMediaBuffer *buf;
+    BYTE *buf_data;
+    DWORD buf_max_length;
+    DWORD buf_length;
     HRESULT hr;
+    int slot, ret = 0;
 
     if (!self->open) {
         PyErr_SetString(pgExc_SDLError,
@@ -804,25 +994,30 @@ windows_read_frame(pgCameraObject *self, SDL_Surface *surf)
         return 0;
     };
 
-    if (self->buf) {
-        BYTE *buf_data;
-        DWORD buf_max_length;
-        DWORD buf_length;
-        hr = self->buf->lpVtbl->Lock(self->buf, &buf_data, &buf_max_length,
-                                     &buf_length);
-        CHECKHR(hr);
-
-        if (!windows_process_image(self, buf_data, buf_length, surf)) {
-            return 0;
-        }
+    /* claim the newest frame, so the callback converts around it */
+    AcquireSRWLockExclusive(&self->lock);
+    slot = self->ready_slot;
+    self->read_slot = slot;
+    self->buffer_ready = 0;
+    ReleaseSRWLockExclusive(&self->lock);
 
-        hr = self->buf->lpVtbl->Unlock(self->buf);
-        CHECKHR(hr);
+    if (slot < 0) {
+        return 1;
+    }
 
-        self->buffer_ready = 0;
+    buf = self->pool_bufs[slot];
+    hr = buf->lpVtbl->Lock(buf, &buf_data, &buf_max_length, &buf_length);
+    if (SUCCEEDED(hr)) {
+        ret = windows_process_image(self, buf_data, buf_length, surf);
+        hr = buf->lpVtbl->Unlock(buf);
     }
 
-    return 1;
+    AcquireSRWLockExclusive(&self->lock);
+    self->read_slot = -1;
+    ReleaseSRWLockExclusive(&self->lock);
+
+    CHECKHR(hr);
+    return ret;
 }
 
 int
@@ -846,6 +1041,7 @@ windows_frame_ready(pgCameraObject *self, int *result)
 PyObject *
 windows_read_raw(pgCameraObject *self)
 {
+    IMFMediaBuffer *raw_buf;
     PyObject *data = NULL;
     HRESULT hr;
 
@@ -859,23 +1055,37 @@ windows_read_raw(pgCameraObject *self)
         return 0;
     };
 
-    if (self->raw_buf) {
+    /* hold a reference, the callback swaps in a new buffer every frame */
+    AcquireSRWLockExclusive(&self->lock);
+    raw_buf = self->raw_buf;
+    if (raw_buf) {
+        raw_buf->lpVtbl->AddRef(raw_buf);
+    }
+    ReleaseSRWLockExclusive(&self->lock);
+
+    if (raw_buf) {
         BYTE *buf_data;
         DWORD buf_max_length;
         DWORD buf_length;
-        hr = self->raw_buf->lpVtbl->Lock(self->raw_buf, &buf_data,
-                                         &buf_max_length, &buf_length);
-        CHECKHR(hr);
+        hr = raw_buf->lpVtbl->Lock(raw_buf, &buf_data, &buf_max_length,
+                                   &buf_length);
+        if (FAILED(hr)) {
+            RELEASE(raw_buf);
+            CHECKHR(hr);
+        }
 
         data = PyBytes_FromStringAndSize(buf_data, buf_length);
+        hr = raw_buf->lpVtbl->Unlock(raw_buf);
+        RELEASE(raw_buf);
         if (!data) {
             PyErr_SetString(pgExc_SDLError,
                             "Error constructing bytes from data");
             return 0;
         }
-
-        hr = self->raw_buf->lpVtbl->Unlock(self->raw_buf);
-        CHECKHR(hr);
+        if (FAILED(hr)) {
+            Py_DECREF(data);
+            CHECKHR(hr);
+        }
 
         self->buffer_ready = 0;
 
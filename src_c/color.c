@@ -43,6 +43,8 @@
 
 #include "pgcompat.h"
 
+#include "pgfreelist.h"
+
 #include <ctype.h>
 
 #if (!defined(__STDC_VERSION__) || __STDC_VERSION__ < 199901L) && \
@@ -61,7 +63,9 @@ _get_double(PyObject *, double *);
 static int
 _get_color(PyObject *, Uint32 *);
 static int
-_hextoint(char *, Uint8 *);
+_hextoint(const char *, Uint8 *);
+static int
+_hexcolor_chars(const char *, size_t, Uint8 *);
 static tristate
 _hexcolor(PyObject *, Uint8 *);
 static int
@@ -278,6 +282,9 @@ static PyTypeObject pgColor_Type = {
 
 #define PyColor_Check(o) ((o)->ob_type == (PyTypeObject *)&pgColor_Type)
 
+/* Deallocated Color objects, kept for reuse. */
+static pgFreeList _color_freelist;
+
 #define RGB_EQUALS(x, y)                                              \
     ((((pgColorObject *)x)->data[0] == ((pgColorObj *)y)->data[0]) && \
      (((pgColorObject *)x)->data[1] == ((pgColorObj *)y)->data[1]) && \
@@ -319,7 +326,7 @@ _get_color(PyObject *val, Uint32 *color)
 }
 
 static int
-_hextoint(char *hex, Uint8 *val)
+_hextoint(const char *hex, Uint8 *val)
 {
     /* 'hex' is a two digit hexadecimal number, no spaces, no signs.
      * This algorithm is brute force, but it is character system agnostic.
@@ -435,23 +442,9 @@ _hextoint(char *hex, Uint8 *val)
     return 1;
 }
 
-static tristate
-_hexcolor(PyObject *color, Uint8 rgba[])
+static int
+_hexcolor_chars(const char *name, size_t len, Uint8 rgba[])
 {
-    size_t len;
-    tristate rcode = TRISTATE_FAIL;
-    char *name;
-    PyObject *ascii = PyUnicode_AsASCIIString(color);
-    if (ascii == NULL) {
-        rcode = TRISTATE_ERROR;
-        goto Fail;
-    }
-    name = PyBytes_AsString(ascii);
-    if (name == NULL) {
-        goto Fail;
-    }
-
-    len = strlen(name);
     /* hex colors can be
      * #RRGGBB
      * #RRGGBBAA
@@ -459,43 +452,60 @@ _hexcolor(PyObject *color, Uint8 rgba[])
      * 0xRRGGBBAA
      */
     if (len < 7) {
-        goto Fail;
+        return 0;
     }
 
     if (name[0] == '#') {
         if (len != 7 && len != 9)
-            goto Fail;
+            return 0;
         if (!_hextoint(name + 1, &rgba[0]))
-            goto Fail;
+            return 0;
         if (!_hextoint(name + 3, &rgba[1]))
-            goto Fail;
+            return 0;
         if (!_hextoint(name + 5, &rgba[2]))
-            goto Fail;
+            return 0;
         rgba[3] = 255;
         if (len == 9 && !_hextoint(name + 7, &rgba[3])) {
-            goto Fail;
+            return 0;
         }
-        goto Success;
+        return 1;
     }
     else if (name[0] == '0' && name[1] == 'x') {
         if (len != 8 && len != 10)
-            goto Fail;
+            return 0;
         if (!_hextoint(name + 2, &rgba[0]))
-            goto Fail;
+            return 0;
         if (!_hextoint(name + 4, &rgba[1]))
-            goto Fail;
+            return 0;
         if (!_hextoint(name + 6, &rgba[2]))
-            goto Fail;
+            return 0;
         rgba[3] = 255;
         if (len == 10 && !_hextoint(name + 8, &rgba[3])) {
-            goto Fail;
+            return 0;
         }
-        goto Success;
+        return 1;
+    }
+    return 0;
+}
+
+static tristate
+_hexcolor(PyObject *color, Uint8 rgba[])
+{
+    tristate rcode = TRISTATE_FAIL;
+    char *name;
+    PyObject *ascii = PyUnicode_AsASCIIString(color);
+    if (ascii == NULL) {
+        rcode = TRISTATE_ERROR;
+        goto Fail;
+    }
+    name = PyBytes_AsString(ascii);
+    if (name == NULL) {
+        goto Fail;
     }
-    goto Fail;
 
-Success:
-    rcode = TRISTATE_SUCCESS;
+    if (_hexcolor_chars(name, strlen(name), rgba)) {
+        rcode = TRISTATE_SUCCESS;
+    }
 Fail:
     Py_XDECREF(ascii);
     return rcode;
@@ -534,7 +544,14 @@ static pgColorObject *
 _color_new_internal_length(PyTypeObject *type, const Uint8 rgba[],
                            Uint8 length)
 {
-    pgColorObject *color = (pgColorObject *)type->tp_alloc(type, 0);
+    pgColorObject *color = NULL;
+
+    if (type == &pgColor_Type) {
+        color = (pgColorObject *)pgFreeList_Pop(&_color_freelist, type);
+    }
+    if (!color) {
+        color = (pgColorObject *)type->tp_alloc(type, 0);
+    }
     if (!color) {
         return NULL;
     }
@@ -560,7 +577,7 @@ _color_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 }
 
 static int
-_parse_color_from_text(PyObject *str_obj, Uint8 *rgba)
+_parse_color_from_dict(PyObject *str_obj, Uint8 *rgba)
 {
     /* Named color */
     PyObject *color = NULL;
@@ -598,6 +615,202 @@ _parse_color_from_text(PyObject *str_obj, Uint8 *rgba)
     return 0;
 }
 
+/*
+ * Color names are looked up in a C copy of THECOLORS, which is made again
+ * when names are added to or removed from the dict. Strings that parsed
+ * are also kept in a small cache, keyed by the string object, so UI code
+ * passing the same "red" or "#ff8800" every frame only parses it once.
+ */
+#define COLOR_NAME_MAX 64
+#define COLOR_CACHE_SIZE 256 /* a power of 2 */
+
+typedef struct {
+    const char *name; /* NULL for an empty slot */
+    size_t len;
+    Uint8 rgba[4];
+} _color_name_entry;
+
+typedef struct {
+    PyObject *key; /* an exact str, NULL for an empty slot */
+    Py_hash_t hash;
+    Uint8 rgba[4];
+} _color_cache_entry;
+
+static _color_name_entry *_color_names = NULL;
+static char *_color_names_chars = NULL;
+static size_t _color_names_mask = 0;
+static Py_ssize_t _color_names_dictsize = -1;
+static _color_cache_entry _color_cache[COLOR_CACHE_SIZE];
+
+static size_t
+_color_name_hash(const char *name, size_t len)
+{
+    /* FNV-1a */
+    size_t i, hash = 2166136261u;
+
+    for (i = 0; i < len; i++) {
+        hash = (hash ^ (unsigned char)name[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static void
+_color_cache_clear(void)
+{
+    int i;
+
+    for (i = 0; i < COLOR_CACHE_SIZE; i++) {
+        Py_CLEAR(_color_cache[i].key);
+    }
+}
+
+static int
+_color_names_build(void)
+{
+    PyObject *key, *value;
+    Py_ssize_t pos = 0, size = PyDict_Size(_COLORDICT);
+    size_t capacity = 16, total = 0, nchars = 0, count = 0, len, i;
+    _color_name_entry *names;
+    char *chars;
+    Uint8 rgba[4];
+
+    while (capacity < (size_t)size * 2) {
+        capacity <<= 1;
+    }
+    while (PyDict_Next(_COLORDICT, &pos, &key, &value)) {
+        if (PyUnicode_Check(key) && PyUnicode_IS_ASCII(key)) {
+            total += PyUnicode_GET_LENGTH(key);
+        }
+    }
+    names = PyMem_Calloc(capacity, sizeof(_color_name_entry));
+    chars = PyMem_Malloc(total + 1);
+    if (!names || !chars) {
+        PyMem_Free(names);
+        PyMem_Free(chars);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    pos = 0;
+    while (PyDict_Next(_COLORDICT, &pos, &key, &value)) {
+        /* anything else is left to the dict lookup */
+        if (!PyUnicode_Check(key) || !PyUnicode_IS_ASCII(key) ||
+            PyUnicode_GET_LENGTH(key) >= COLOR_NAME_MAX) {
+            continue;
+        }
+        if (!pg_RGBAFromObj(value, rgba)) {
+            PyErr_Clear();
+            continue;
+        }
+        len = PyUnicode_GET_LENGTH(key);
+        /* the values can be anything, and could change the dict */
+        if (nchars + len > total || count >= capacity / 2) {
+            break;
+        }
+        memcpy(chars + nchars, PyUnicode_1BYTE_DATA(key), len);
+        i = _color_name_hash(chars + nchars, len) & (capacity - 1);
+        while (names[i].name) {
+            i = (i + 1) & (capacity - 1);
+        }
+        names[i].name = chars + nchars;
+        names[i].len = len;
+        memcpy(names[i].rgba, rgba, 4);
+        nchars += len;
+        ++count;
+    }
+
+    PyMem_Free(_color_names);
+    PyMem_Free(_color_names_chars);
+    _color_names = names;
+    _color_names_chars = chars;
+    _color_names_mask = capacity - 1;
+    _color_names_dictsize = size;
+    /* cached names may have gone */
+    _color_cache_clear();
+    return 0;
+}
+
+static int
+_color_names_get(const char *name, size_t len, Uint8 *rgba)
+{
+    size_t i = _color_name_hash(name, len) & _color_names_mask;
+
+    while (_color_names[i].name) {
+        if (_color_names[i].len == len &&
+            memcmp(_color_names[i].name, name, len) == 0) {
+            memcpy(rgba, _color_names[i].rgba, 4);
+            return 1;
+        }
+        i = (i + 1) & _color_names_mask;
+    }
+    return 0;
+}
+
+static int
+_parse_color_from_text(PyObject *str_obj, Uint8 *rgba)
+{
+    _color_cache_entry *entry = NULL;
+    Py_hash_t hash;
+    const char *chars;
+    char name[COLOR_NAME_MAX];
+    Py_ssize_t i, len;
+    size_t n = 0;
+
+    /* We assume the caller handled this check for us. */
+    assert(PyUnicode_Check(str_obj));
+
+    if (PyDict_Size(_COLORDICT) != _color_names_dictsize &&
+        _color_names_build()) {
+        return -1;
+    }
+
+    if (PyUnicode_CheckExact(str_obj)) {
+        hash = PyObject_Hash(str_obj);
+        if (hash == -1) {
+            return -1;
+        }
+        entry = &_color_cache[hash & (COLOR_CACHE_SIZE - 1)];
+        if (entry->key &&
+            (entry->key == str_obj ||
+             (entry->hash == hash &&
+              PyUnicode_Compare(entry->key, str_obj) == 0))) {
+            memcpy(rgba, entry->rgba, 4);
+            return 0;
+        }
+    }
+
+    if (PyUnicode_IS_ASCII(str_obj)) {
+        chars = (const char *)PyUnicode_1BYTE_DATA(str_obj);
+        len = PyUnicode_GET_LENGTH(str_obj);
+        /* str_obj.replace(" ", "").lower() */
+        for (i = 0; i < len && n < COLOR_NAME_MAX; i++) {
+            if (chars[i] != ' ') {
+                name[n++] = (chars[i] >= 'A' && chars[i] <= 'Z')
+                                ? chars[i] - 'A' + 'a'
+                                : chars[i];
+            }
+        }
+        if (i < len || (!_color_names_get(name, n, rgba) &&
+                        !_hexcolor_chars(chars, (size_t)len, rgba))) {
+            if (_parse_color_from_dict(str_obj, rgba)) {
+                return -1;
+            }
+        }
+    }
+    else if (_parse_color_from_dict(str_obj, rgba)) {
+        return -1;
+    }
+
+    if (entry) {
+        Py_INCREF(str_obj);
+        Py_XDECREF(entry->key);
+        entry->key = str_obj;
+        entry->hash = hash;
+        memcpy(entry->rgba, rgba, 4);
+    }
+    return 0;
+}
+
 static int
 _parse_color_from_single_object(PyObject *obj, Uint8 *rgba)
 {
@@ -697,7 +910,10 @@ _color_init(pgColorObject *self, PyObject *args, PyObject *kwds)
 static void
 _color_dealloc(pgColorObject *color)
 {
-    Py_TYPE(color)->tp_free((PyObject *)color);
+    if (Py_TYPE(color) != &pgColor_Type ||
+        !pgFreeList_Push(&_color_freelist, (PyObject *)color)) {
+        Py_TYPE(color)->tp_free((PyObject *)color);
+    }
 }
 
 /**
@@ -998,122 +1214,68 @@ _color_set_a(pgColorObject *color, PyObject *value, void *closure)
     return 0;
 }
 
-/**
- * color.hsva
- */
-static PyObject *
-_color_get_hsva(pgColorObject *color, void *closure)
+/* Color space conversions shared by the Color attributes and the bulk
+ * functions of the module. H is in [0, 360], the other values in
+ * [0, 100]. */
+static void
+_rgba_to_hsva(const Uint8 *rgba, double *hsva)
 {
-    double hsv[3] = {0, 0, 0};
     double frgb[4];
     double minv, maxv, diff;
 
     /* Normalize */
-    frgb[0] = color->data[0] / 255.0;
-    frgb[1] = color->data[1] / 255.0;
-    frgb[2] = color->data[2] / 255.0;
-    frgb[3] = color->data[3] / 255.0;
+    frgb[0] = rgba[0] / 255.0;
+    frgb[1] = rgba[1] / 255.0;
+    frgb[2] = rgba[2] / 255.0;
+    frgb[3] = rgba[3] / 255.0;
 
     maxv = MAX(MAX(frgb[0], frgb[1]), frgb[2]);
     minv = MIN(MIN(frgb[0], frgb[1]), frgb[2]);
     diff = maxv - minv;
 
     /* Calculate V */
-    hsv[2] = 100. * maxv;
+    hsva[2] = 100. * maxv;
+    hsva[3] = frgb[3] * 100;
 
     if (maxv == minv) {
-        hsv[0] = 0;
-        hsv[1] = 0;
-        return Py_BuildValue("(ffff)", hsv[0], hsv[1], hsv[2], frgb[3] * 100);
+        hsva[0] = 0;
+        hsva[1] = 0;
+        return;
     }
     /* Calculate S */
-    hsv[1] = 100. * (maxv - minv) / maxv;
+    hsva[1] = 100. * (maxv - minv) / maxv;
 
     /* Clamp S, needed on some but not all FPUs */
-    if (hsv[1] < 0) {
-        hsv[1] = 0.f;
+    if (hsva[1] < 0) {
+        hsva[1] = 0.f;
     }
-    else if (hsv[1] > 100) {
-        hsv[1] = 100.f;
+    else if (hsva[1] > 100) {
+        hsva[1] = 100.f;
     }
 
     /* Calculate H */
     if (maxv == frgb[0]) {
-        hsv[0] = fmod((60 * ((frgb[1] - frgb[2]) / diff)), 360.f);
+        hsva[0] = fmod((60 * ((frgb[1] - frgb[2]) / diff)), 360.f);
     }
     else if (maxv == frgb[1]) {
-        hsv[0] = (60 * ((frgb[2] - frgb[0]) / diff)) + 120.f;
+        hsva[0] = (60 * ((frgb[2] - frgb[0]) / diff)) + 120.f;
     }
     else {
-        hsv[0] = (60 * ((frgb[0] - frgb[1]) / diff)) + 240.f;
+        hsva[0] = (60 * ((frgb[0] - frgb[1]) / diff)) + 240.f;
     }
 
-    if (hsv[0] < 0) {
-        hsv[0] += 360.f;
+    if (hsva[0] < 0) {
+        hsva[0] += 360.f;
     }
-
-    /* H,S,V,A */
-    return Py_BuildValue("(ffff)", hsv[0], hsv[1], hsv[2], frgb[3] * 100);
 }
 
-static int
-_color_set_hsva(pgColorObject *color, PyObject *value, void *closure)
+static void
+_hsva_to_rgba(const double *hsva, Uint8 *rgba)
 {
-    PyObject *item;
-    double hsva[4] = {0, 0, 0, 0};
     double f, p, q, t, v, s;
     int hi;
 
-    DEL_ATTR_NOT_SUPPORTED_CHECK("hsva", value);
-
-    if (!PySequence_Check(value) || PySequence_Size(value) < 3) {
-        PyErr_SetString(PyExc_ValueError, "invalid HSVA value");
-        return -1;
-    }
-
-    /* H */
-    item = PySequence_GetItem(value, 0);
-    if (!item || !_get_double(item, &(hsva[0])) || hsva[0] < 0 ||
-        hsva[0] > 360) {
-        Py_XDECREF(item);
-        PyErr_SetString(PyExc_ValueError, "invalid HSVA value");
-        return -1;
-    }
-    Py_DECREF(item);
-
-    /* S */
-    item = PySequence_GetItem(value, 1);
-    if (!item || !_get_double(item, &(hsva[1])) || hsva[1] < 0 ||
-        hsva[1] > 100) {
-        Py_XDECREF(item);
-        PyErr_SetString(PyExc_ValueError, "invalid HSVA value");
-        return -1;
-    }
-    Py_DECREF(item);
-
-    /* V */
-    item = PySequence_GetItem(value, 2);
-    if (!item || !_get_double(item, &(hsva[2])) || hsva[2] < 0 ||
-        hsva[2] > 100) {
-        Py_XDECREF(item);
-        PyErr_SetString(PyExc_ValueError, "invalid HSVA value");
-        return -1;
-    }
-    Py_DECREF(item);
-
-    /* A */
-    if (PySequence_Size(value) > 3) {
-        item = PySequence_GetItem(value, 3);
-        if (!item || !_get_double(item, &(hsva[3])) || hsva[3] < 0 ||
-            hsva[3] > 100) {
-            Py_XDECREF(item);
-            PyErr_SetString(PyExc_ValueError, "invalid HSVA value");
-            return -1;
-        }
-        Py_DECREF(item);
-    }
-
-    color->data[3] = (Uint8)((hsva[3] / 100.0f) * 255);
+    rgba[3] = (Uint8)((hsva[3] / 100.0f) * 255);
 
     s = hsva[1] / 100.f;
     v = hsva[2] / 100.f;
@@ -1126,56 +1288,50 @@ _color_set_hsva(pgColorObject *color, PyObject *value, void *closure)
 
     switch (hi) {
         case 1:
-            color->data[0] = (Uint8)(q * 255);
-            color->data[1] = (Uint8)(v * 255);
-            color->data[2] = (Uint8)(p * 255);
+            rgba[0] = (Uint8)(q * 255);
+            rgba[1] = (Uint8)(v * 255);
+            rgba[2] = (Uint8)(p * 255);
             break;
         case 2:
-            color->data[0] = (Uint8)(p * 255);
-            color->data[1] = (Uint8)(v * 255);
-            color->data[2] = (Uint8)(t * 255);
+            rgba[0] = (Uint8)(p * 255);
+            rgba[1] = (Uint8)(v * 255);
+            rgba[2] = (Uint8)(t * 255);
             break;
         case 3:
-            color->data[0] = (Uint8)(p * 255);
-            color->data[1] = (Uint8)(q * 255);
-            color->data[2] = (Uint8)(v * 255);
+            rgba[0] = (Uint8)(p * 255);
+            rgba[1] = (Uint8)(q * 255);
+            rgba[2] = (Uint8)(v * 255);
             break;
         case 4:
-            color->data[0] = (Uint8)(t * 255);
-            color->data[1] = (Uint8)(p * 255);
-            color->data[2] = (Uint8)(v * 255);
+            rgba[0] = (Uint8)(t * 255);
+            rgba[1] = (Uint8)(p * 255);
+            rgba[2] = (Uint8)(v * 255);
             break;
         case 5:
-            color->data[0] = (Uint8)(v * 255);
-            color->data[1] = (Uint8)(p * 255);
-            color->data[2] = (Uint8)(q * 255);
+            rgba[0] = (Uint8)(v * 255);
+            rgba[1] = (Uint8)(p * 255);
+            rgba[2] = (Uint8)(q * 255);
             break;
         default:
             /* 0 or 6, which are equivalent. */
             assert(hi == 0 || hi == 6);
-            color->data[0] = (Uint8)(v * 255);
-            color->data[1] = (Uint8)(t * 255);
-            color->data[2] = (Uint8)(p * 255);
+            rgba[0] = (Uint8)(v * 255);
+            rgba[1] = (Uint8)(t * 255);
+            rgba[2] = (Uint8)(p * 255);
     }
-
-    return 0;
 }
 
-/**
- * color.hsla
- */
-static PyObject *
-_color_get_hsla(pgColorObject *color, void *closure)
+static void
+_rgba_to_hsla(const Uint8 *rgba, double *hsla)
 {
-    double hsl[3] = {0, 0, 0};
     double frgb[4];
     double minv, maxv, diff;
 
     /* Normalize */
-    frgb[0] = color->data[0] / 255.0;
-    frgb[1] = color->data[1] / 255.0;
-    frgb[2] = color->data[2] / 255.0;
-    frgb[3] = color->data[3] / 255.0;
+    frgb[0] = rgba[0] / 255.0;
+    frgb[1] = rgba[1] / 255.0;
+    frgb[2] = rgba[2] / 255.0;
+    frgb[3] = rgba[3] / 255.0;
 
     maxv = MAX(MAX(frgb[0], frgb[1]), frgb[2]);
     minv = MIN(MIN(frgb[0], frgb[1]), frgb[2]);
@@ -1183,85 +1339,146 @@ _color_get_hsla(pgColorObject *color, void *closure)
     diff = maxv - minv;
 
     /* Calculate L */
-    hsl[2] = 50.f * (maxv + minv); /* 1/2 (max + min) */
+    hsla[2] = 50.f * (maxv + minv); /* 1/2 (max + min) */
+    hsla[3] = frgb[3] * 100;
 
     if (maxv == minv) {
-        hsl[1] = 0;
-        hsl[0] = 0;
-        return Py_BuildValue("(ffff)", hsl[0], hsl[1], hsl[2], frgb[3] * 100);
+        hsla[1] = 0;
+        hsla[0] = 0;
+        return;
     }
 
     /* Calculate S */
-    if (hsl[2] <= 50) {
-        hsl[1] = diff / (maxv + minv);
+    if (hsla[2] <= 50) {
+        hsla[1] = diff / (maxv + minv);
     }
     else {
-        hsl[1] = diff / (2 - maxv - minv);
+        hsla[1] = diff / (2 - maxv - minv);
     }
-    hsl[1] *= 100.f;
+    hsla[1] *= 100.f;
 
     /* Calculate H */
     if (maxv == frgb[0]) {
-        hsl[0] = fmod((60 * ((frgb[1] - frgb[2]) / diff)), 360.f);
+        hsla[0] = fmod((60 * ((frgb[1] - frgb[2]) / diff)), 360.f);
     }
     else if (maxv == frgb[1]) {
-        hsl[0] = (60 * ((frgb[2] - frgb[0]) / diff)) + 120.f;
+        hsla[0] = (60 * ((frgb[2] - frgb[0]) / diff)) + 120.f;
     }
     else {
-        hsl[0] = (60 * ((frgb[0] - frgb[1]) / diff)) + 240.f;
+        hsla[0] = (60 * ((frgb[0] - frgb[1]) / diff)) + 240.f;
     }
-    if (hsl[0] < 0) {
-        hsl[0] += 360.f;
+    if (hsla[0] < 0) {
+        hsla[0] += 360.f;
     }
+}
 
-    /* H,S,L,A */
-    return Py_BuildValue("(ffff)", hsl[0], hsl[1], hsl[2], frgb[3] * 100);
+static Uint8
+_hsla_channel(double p, double q, double h)
+{
+    if (h < 0) {
+        h += 1;
+    }
+    else if (h > 1) {
+        h -= 1;
+    }
+
+    if (h < 1. / 6.f) {
+        return (Uint8)((p + ((q - p) * 6 * h)) * 255);
+    }
+    else if (h < 0.5f) {
+        return (Uint8)(q * 255);
+    }
+    else if (h < 2. / 3.f) {
+        return (Uint8)((p + ((q - p) * 6 * (2. / 3.f - h))) * 255);
+    }
+    return (Uint8)(p * 255);
 }
 
-/**
- * color.hsla = x
- */
-static int
-_color_set_hsla(pgColorObject *color, PyObject *value, void *closure)
+static void
+_hsla_to_rgba(const double *hsla, Uint8 *rgba)
 {
-    PyObject *item;
-    double hsla[4] = {0, 0, 0, 0};
-    double ht, h, q, p = 0, s, l = 0;
+    double ht, q, p, s, l;
     static double onethird = 1.0 / 3.0f;
 
-    DEL_ATTR_NOT_SUPPORTED_CHECK("hsla", value);
+    rgba[3] = (Uint8)((hsla[3] / 100.f) * 255);
 
-    if (!PySequence_Check(value) || PySequence_Size(value) < 3) {
-        PyErr_SetString(PyExc_ValueError, "invalid HSLA value");
-        return -1;
+    s = hsla[1] / 100.f;
+    l = hsla[2] / 100.f;
+
+    if (s == 0) {
+        rgba[0] = (Uint8)(l * 255);
+        rgba[1] = (Uint8)(l * 255);
+        rgba[2] = (Uint8)(l * 255);
+        return;
     }
 
-    /* H */
-    item = PySequence_GetItem(value, 0);
-    if (!item || !_get_double(item, &(hsla[0])) || hsla[0] < 0 ||
-        hsla[0] > 360) {
-        Py_XDECREF(item);
-        PyErr_SetString(PyExc_ValueError, "invalid HSLA value");
-        return -1;
+    if (l < 0.5f) {
+        q = l * (1 + s);
     }
-    Py_DECREF(item);
+    else {
+        q = l + s - (l * s);
+    }
+    p = 2 * l - q;
+
+    ht = hsla[0] / 360.f;
+
+    rgba[0] = _hsla_channel(p, q, ht + onethird);
+    rgba[1] = _hsla_channel(p, q, ht);
+    rgba[2] = _hsla_channel(p, q, ht - onethird);
+}
+
+/**
+ * color.hsva
+ */
+static PyObject *
+_color_get_hsva(pgColorObject *color, void *closure)
+{
+    double hsva[4];
+
+    _rgba_to_hsva(color->data, hsva);
+    /* H,S,V,A */
+    return Py_BuildValue("(ffff)", hsva[0], hsva[1], hsva[2], hsva[3]);
+}
+
+static int
+_color_set_hsva(pgColorObject *color, PyObject *value, void *closure)
+{
+    PyObject *item;
+    double hsva[4] = {0, 0, 0, 0};
+
+    DEL_ATTR_NOT_SUPPORTED_CHECK("hsva", value);
+
+    if (!PySequence_Check(value) || PySequence_Size(value) < 3) {
+        PyErr_SetString(PyExc_ValueError, "invalid HSVA value");
+        return -1;
+    }
+
+    /* H */
+    item = PySequence_GetItem(value, 0);
+    if (!item || !_get_double(item, &(hsva[0])) || hsva[0] < 0 ||
+        hsva[0] > 360) {
+        Py_XDECREF(item);
+        PyErr_SetString(PyExc_ValueError, "invalid HSVA value");
+        return -1;
+    }
+    Py_DECREF(item);
 
     /* S */
     item = PySequence_GetItem(value, 1);
-    if (!item || !_get_double(item, &(hsla[1])) || hsla[1] < 0 ||
-        hsla[1] > 100) {
+    if (!item || !_get_double(item, &(hsva[1])) || hsva[1] < 0 ||
+        hsva[1] > 100) {
         Py_XDECREF(item);
-        PyErr_SetString(PyExc_ValueError, "invalid HSLA value");
+        PyErr_SetString(PyExc_ValueError, "invalid HSVA value");
         return -1;
     }
     Py_DECREF(item);
 
-    /* L */
+    /* V */
     item = PySequence_GetItem(value, 2);
-    if (!item || !_get_double(item, &(hsla[2])) || hsla[2] < 0 ||
-        hsla[2] > 100) {
+    if (!item || !_get_double(item, &(hsva[2])) || hsva[2] < 0 ||
+        hsva[2] > 100) {
         Py_XDECREF(item);
-        PyErr_SetString(PyExc_ValueError, "invalid HSLA value");
+        PyErr_SetString(PyExc_ValueError, "invalid HSVA value");
         return -1;
     }
     Py_DECREF(item);
@@ -1269,103 +1486,91 @@ _color_set_hsla(pgColorObject *color, PyObject *value, void *closure)
     /* A */
     if (PySequence_Size(value) > 3) {
         item = PySequence_GetItem(value, 3);
-        if (!item || !_get_double(item, &(hsla[3])) || hsla[3] < 0 ||
-            hsla[3] > 100) {
+        if (!item || !_get_double(item, &(hsva[3])) || hsva[3] < 0 ||
+            hsva[3] > 100) {
             Py_XDECREF(item);
-            PyErr_SetString(PyExc_ValueError, "invalid HSLA value");
+            PyErr_SetString(PyExc_ValueError, "invalid HSVA value");
             return -1;
         }
         Py_DECREF(item);
     }
 
-    color->data[3] = (Uint8)((hsla[3] / 100.f) * 255);
-
-    s = hsla[1] / 100.f;
-    l = hsla[2] / 100.f;
+    _hsva_to_rgba(hsva, color->data);
+    return 0;
+}
 
-    if (s == 0) {
-        color->data[0] = (Uint8)(l * 255);
-        color->data[1] = (Uint8)(l * 255);
-        color->data[2] = (Uint8)(l * 255);
-        return 0;
-    }
+/**
+ * color.hsla
+ */
+static PyObject *
+_color_get_hsla(pgColorObject *color, void *closure)
+{
+    double hsla[4];
 
-    if (l < 0.5f) {
-        q = l * (1 + s);
-    }
-    else {
-        q = l + s - (l * s);
-    }
-    p = 2 * l - q;
+    _rgba_to_hsla(color->data, hsla);
+    /* H,S,L,A */
+    return Py_BuildValue("(ffff)", hsla[0], hsla[1], hsla[2], hsla[3]);
+}
 
-    ht = hsla[0] / 360.f;
+/**
+ * color.hsla = x
+ */
+static int
+_color_set_hsla(pgColorObject *color, PyObject *value, void *closure)
+{
+    PyObject *item;
+    double hsla[4] = {0, 0, 0, 0};
 
-    /* Calculate R */
-    h = ht + onethird;
-    if (h < 0) {
-        h += 1;
-    }
-    else if (h > 1) {
-        h -= 1;
-    }
+    DEL_ATTR_NOT_SUPPORTED_CHECK("hsla", value);
 
-    if (h < 1. / 6.f) {
-        color->data[0] = (Uint8)((p + ((q - p) * 6 * h)) * 255);
-    }
-    else if (h < 0.5f) {
-        color->data[0] = (Uint8)(q * 255);
-    }
-    else if (h < 2. / 3.f) {
-        color->data[0] = (Uint8)((p + ((q - p) * 6 * (2. / 3.f - h))) * 255);
-    }
-    else {
-        color->data[0] = (Uint8)(p * 255);
+    if (!PySequence_Check(value) || PySequence_Size(value) < 3) {
+        PyErr_SetString(PyExc_ValueError, "invalid HSLA value");
+        return -1;
     }
 
-    /* Calculate G */
-    h = ht;
-    if (h < 0) {
-        h += 1;
-    }
-    else if (h > 1) {
-        h -= 1;
+    /* H */
+    item = PySequence_GetItem(value, 0);
+    if (!item || !_get_double(item, &(hsla[0])) || hsla[0] < 0 ||
+        hsla[0] > 360) {
+        Py_XDECREF(item);
+        PyErr_SetString(PyExc_ValueError, "invalid HSLA value");
+        return -1;
     }
+    Py_DECREF(item);
 
-    if (h < 1. / 6.f) {
-        color->data[1] = (Uint8)((p + ((q - p) * 6 * h)) * 255);
-    }
-    else if (h < 0.5f) {
-        color->data[1] = (Uint8)(q * 255);
-    }
-    else if (h < 2. / 3.f) {
-        color->data[1] = (Uint8)((p + ((q - p) * 6 * (2. / 3.f - h))) * 255);
-    }
-    else {
-        color->data[1] = (Uint8)(p * 255);
+    /* S */
+    item = PySequence_GetItem(value, 1);
+    if (!item || !_get_double(item, &(hsla[1])) || hsla[1] < 0 ||
+        hsla[1] > 100) {
+        Py_XDECREF(item);
+        PyErr_SetString(PyExc_ValueError, "invalid HSLA value");
+        return -1;
     }
+    Py_DECREF(item);
 
-    /* Calculate B */
-    h = ht - onethird;
-    if (h < 0) {
-        h += 1;
-    }
-    else if (h > 1) {
-        h -= 1;
+    /* L */
+    item = PySequence_GetItem(value, 2);
+    if (!item || !_get_double(item, &(hsla[2])) || hsla[2] < 0 ||
+        hsla[2] > 100) {
+        Py_XDECREF(item);
+        PyErr_SetString(PyExc_ValueError, "invalid HSLA value");
+        return -1;
     }
+    Py_DECREF(item);
 
-    if (h < 1. / 6.f) {
-        color->data[2] = (Uint8)((p + ((q - p) * 6 * h)) * 255);
-    }
-    else if (h < 0.5f) {
-        color->data[2] = (Uint8)(q * 255);
-    }
-    else if (h < 2. / 3.f) {
-        color->data[2] = (Uint8)((p + ((q - p) * 6 * (2. / 3.f - h))) * 255);
-    }
-    else {
-        color->data[2] = (Uint8)(p * 255);
+    /* A */
+    if (PySequence_Size(value) > 3) {
+        item = PySequence_GetItem(value, 3);
+        if (!item || !_get_double(item, &(hsla[3])) || hsla[3] < 0 ||
+            hsla[3] > 100) {
+            Py_XDECREF(item);
+            PyErr_SetString(PyExc_ValueError, "invalid HSLA value");
+            return -1;
+        }
+        Py_DECREF(item);
     }
 
+    _hsla_to_rgba(hsla, color->data);
     return 0;
 }
 
@@ -2071,9 +2276,429 @@ pg_RGBAFromFuzzyColorObj(PyObject *color, Uint8 rgba[])
     return _parse_color_from_single_object(color, rgba) == 0;
 }
 
+/*
+ * Bulk functions of the module. They work on C contiguous buffers of
+ * colors: RGBA colors are bytes, four to a color, and the other color
+ * spaces are four floats or doubles to a color, in the ranges the Color
+ * attributes of the same name use.
+ */
+static Py_ssize_t
+_get_rgba_buffer(PyObject *obj, Py_buffer *view, int writable)
+{
+    int flags = PyBUF_FORMAT | PyBUF_C_CONTIGUOUS;
+
+    if (writable) {
+        flags |= PyBUF_WRITABLE;
+    }
+    if (PyObject_GetBuffer(obj, view, flags)) {
+        return -1;
+    }
+    if (view->itemsize != 1) {
+        PyBuffer_Release(view);
+        PyErr_SetString(PyExc_ValueError,
+                        "RGBA colors must be a buffer of bytes");
+        return -1;
+    }
+    if (view->len % 4) {
+        PyBuffer_Release(view);
+        PyErr_SetString(PyExc_ValueError,
+                        "RGBA buffer length must be a multiple of 4");
+        return -1;
+    }
+    return view->len / 4;
+}
+
+static Py_ssize_t
+_get_float_buffer(PyObject *obj, Py_buffer *view, int writable)
+{
+    int flags = PyBUF_FORMAT | PyBUF_C_CONTIGUOUS;
+    const char *format;
+
+    if (writable) {
+        flags |= PyBUF_WRITABLE;
+    }
+    if (PyObject_GetBuffer(obj, view, flags)) {
+        return -1;
+    }
+    format = view->format ? view->format : "B";
+    if (*format == '@' || *format == '=') {
+        ++format;
+    }
+    if (!((view->itemsize == sizeof(float) && strcmp(format, "f") == 0) ||
+          (view->itemsize == sizeof(double) && strcmp(format, "d") == 0))) {
+        PyBuffer_Release(view);
+        PyErr_SetString(PyExc_ValueError,
+                        "expected a buffer of floats or doubles");
+        return -1;
+    }
+    if ((view->len / view->itemsize) % 4) {
+        PyBuffer_Release(view);
+        PyErr_SetString(PyExc_ValueError,
+                        "buffer length must be a multiple of 4 items");
+        return -1;
+    }
+    return view->len / view->itemsize / 4;
+}
+
+static PG_INLINE double
+_float_item(const Py_buffer *view, Py_ssize_t i)
+{
+    if (view->itemsize == sizeof(float)) {
+        return ((float *)view->buf)[i];
+    }
+    return ((double *)view->buf)[i];
+}
+
+static PG_INLINE void
+_set_float_item(Py_buffer *view, Py_ssize_t i, double value)
+{
+    if (view->itemsize == sizeof(float)) {
+        ((float *)view->buf)[i] = (float)value;
+    }
+    else {
+        ((double *)view->buf)[i] = value;
+    }
+}
+
+/* Rounds and clamps a [0, 1] value to a byte; NaN gives 0 */
+static PG_INLINE Uint8
+_unit_to_byte(double value)
+{
+    return (value > 0.) ? ((value < 1.) ? (Uint8)(value * 255 + .5) : 255)
+                        : 0;
+}
+
+/**
+ * pygame.color.correct_gamma_array(rgba, gamma)
+ */
+static PyObject *
+_color_correct_gamma_array(PyObject *self, PyObject *args, PyObject *kw)
+{
+    PyObject *obj;
+    Py_buffer view;
+    Uint8 table[256], *data;
+    double _gamma, f;
+    Py_ssize_t i, len;
+    static char *keywords[] = {"rgba", "gamma", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "Od", keywords, &obj,
+                                     &_gamma)) {
+        return NULL;
+    }
+    if (_get_rgba_buffer(obj, &view, 1) < 0) {
+        return NULL;
+    }
+
+    /* the same rounding as Color.correct_gamma, once per byte value */
+    for (i = 0; i < 256; i++) {
+        f = pow(i / 255.0, _gamma);
+        table[i] = (f > 1.0) ? 255 : ((f < 0.0) ? 0 : (Uint8)(f * 255 + .5));
+    }
+
+    data = (Uint8 *)view.buf;
+    len = view.len;
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < len; i++) {
+        data[i] = table[data[i]];
+    }
+    Py_END_ALLOW_THREADS;
+    PyBuffer_Release(&view);
+    Py_RETURN_NONE;
+}
+
+/**
+ * pygame.color.lerp_array(rgba, color, amount)
+ */
+static PyObject *
+_color_lerp_array(PyObject *self, PyObject *args, PyObject *kw)
+{
+    PyObject *obj, *colobj;
+    Py_buffer view, other;
+    Uint8 rgba[4], *data;
+    const Uint8 *odata = NULL;
+    double amt, scaled[4];
+    Py_ssize_t i, len;
+    static char *keywords[] = {"rgba", "color", "amount", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "OOd", keywords, &obj,
+                                     &colobj, &amt)) {
+        return NULL;
+    }
+    if (amt < 0 || amt > 1) {
+        return RAISE(PyExc_ValueError, "Argument 3 must be in range [0, 1]");
+    }
+    /* a Color is a buffer too, but it is one color for the whole array */
+    if (PyObject_CheckBuffer(colobj) &&
+        !PyObject_TypeCheck(colobj, &pgColor_Type)) {
+        if (_get_rgba_buffer(colobj, &other, 0) < 0) {
+            return NULL;
+        }
+        odata = (const Uint8 *)other.buf;
+    }
+    else if (!pg_RGBAFromFuzzyColorObj(colobj, rgba)) {
+        return NULL;
+    }
+    if (_get_rgba_buffer(obj, &view, 1) < 0) {
+        if (odata) {
+            PyBuffer_Release(&other);
+        }
+        return NULL;
+    }
+    if (odata && other.len != view.len) {
+        PyBuffer_Release(&other);
+        PyBuffer_Release(&view);
+        return RAISE(PyExc_ValueError,
+                     "color buffer must have the same length as rgba");
+    }
+
+    data = (Uint8 *)view.buf;
+    len = view.len;
+    Py_BEGIN_ALLOW_THREADS;
+    if (odata) {
+        for (i = 0; i < len; i++) {
+            data[i] = (Uint8)pg_round(data[i] * (1 - amt) + odata[i] * amt);
+        }
+    }
+    else {
+        for (i = 0; i < 4; i++) {
+            scaled[i] = rgba[i] * amt;
+        }
+        for (i = 0; i < len; i++) {
+            data[i] = (Uint8)pg_round(data[i] * (1 - amt) + scaled[i & 3]);
+        }
+    }
+    Py_END_ALLOW_THREADS;
+    if (odata) {
+        PyBuffer_Release(&other);
+    }
+    PyBuffer_Release(&view);
+    Py_RETURN_NONE;
+}
+
+/**
+ * pygame.color.premul_alpha_array(rgba)
+ */
+static PyObject *
+_color_premul_alpha_array(PyObject *self, PyObject *obj)
+{
+    Py_buffer view;
+    Uint8 *data;
+    Py_ssize_t i, len;
+
+    if ((len = _get_rgba_buffer(obj, &view, 1)) < 0) {
+        return NULL;
+    }
+
+    data = (Uint8 *)view.buf;
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < len; i++, data += 4) {
+        data[0] = (Uint8)(((data[0] + 1) * data[3]) >> 8);
+        data[1] = (Uint8)(((data[1] + 1) * data[3]) >> 8);
+        data[2] = (Uint8)(((data[2] + 1) * data[3]) >> 8);
+    }
+    Py_END_ALLOW_THREADS;
+    PyBuffer_Release(&view);
+    Py_RETURN_NONE;
+}
+
+/* Full range BT.601 (JPEG) YUV: Y in [0, 1], U and V in [-0.5, 0.5],
+ * and A in [0, 1]. */
+static void
+_rgba_to_yuva(const Uint8 *rgba, double *yuva)
+{
+    double r = rgba[0] / 255.0, g = rgba[1] / 255.0, b = rgba[2] / 255.0;
+
+    yuva[0] = 0.299 * r + 0.587 * g + 0.114 * b;
+    yuva[1] = -0.168736 * r - 0.331264 * g + 0.5 * b;
+    yuva[2] = 0.5 * r - 0.418688 * g - 0.081312 * b;
+    yuva[3] = rgba[3] / 255.0;
+}
+
+static void
+_yuva_to_rgba(const double *yuva, Uint8 *rgba)
+{
+    rgba[0] = _unit_to_byte(yuva[0] + 1.402 * yuva[2]);
+    rgba[1] = _unit_to_byte(yuva[0] - 0.344136 * yuva[1] - 0.714136 * yuva[2]);
+    rgba[2] = _unit_to_byte(yuva[0] + 1.772 * yuva[1]);
+    rgba[3] = _unit_to_byte(yuva[3]);
+}
+
+typedef void (*_to_space_func)(const Uint8 *, double *);
+typedef void (*_from_space_func)(const double *, Uint8 *);
+
+static PyObject *
+_color_to_space(PyObject *args, PyObject *kw, _to_space_func convert)
+{
+    PyObject *obj, *outobj;
+    Py_buffer view, out;
+    const Uint8 *data;
+    double values[4];
+    Py_ssize_t i, j, len;
+    static char *keywords[] = {"rgba", "out", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "OO", keywords, &obj,
+                                     &outobj)) {
+        return NULL;
+    }
+    if ((len = _get_rgba_buffer(obj, &view, 0)) < 0) {
+        return NULL;
+    }
+    if (_get_float_buffer(outobj, &out, 1) < 0) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    if (out.len / out.itemsize != len * 4) {
+        PyBuffer_Release(&out);
+        PyBuffer_Release(&view);
+        return RAISE(PyExc_ValueError,
+                     "out must hold as many colors as rgba");
+    }
+
+    data = (const Uint8 *)view.buf;
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < len; i++) {
+        convert(data + i * 4, values);
+        for (j = 0; j < 4; j++) {
+            _set_float_item(&out, i * 4 + j, values[j]);
+        }
+    }
+    Py_END_ALLOW_THREADS;
+    PyBuffer_Release(&out);
+    PyBuffer_Release(&view);
+    Py_RETURN_NONE;
+}
+
+/* limits are {min, max} of the four values, or NULL for no check */
+static PyObject *
+_color_from_space(PyObject *args, PyObject *kw, _from_space_func convert,
+                  const double (*limits)[2], const char *name)
+{
+    PyObject *obj, *outobj;
+    Py_buffer view, out;
+    Uint8 *data;
+    double values[4];
+    Py_ssize_t i, j, len;
+    static char *keywords[] = {"values", "out", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "OO", keywords, &obj,
+                                     &outobj)) {
+        return NULL;
+    }
+    if ((len = _get_float_buffer(obj, &view, 0)) < 0) {
+        return NULL;
+    }
+    if (_get_rgba_buffer(outobj, &out, 1) < 0) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    if (out.len != len * 4) {
+        PyBuffer_Release(&out);
+        PyBuffer_Release(&view);
+        return RAISE(PyExc_ValueError,
+                     "out must hold as many colors as values");
+    }
+    /* check everything first, so nothing is written on errors */
+    if (limits) {
+        for (i = 0; i < len * 4; i++) {
+            values[0] = _float_item(&view, i);
+            if (!(values[0] >= limits[i & 3][0] &&
+                  values[0] <= limits[i & 3][1])) {
+                PyBuffer_Release(&out);
+                PyBuffer_Release(&view);
+                return RAISE(PyExc_ValueError, name);
+            }
+        }
+    }
+
+    data = (Uint8 *)out.buf;
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < len; i++) {
+        for (j = 0; j < 4; j++) {
+            values[j] = _float_item(&view, i * 4 + j);
+        }
+        convert(values, data + i * 4);
+    }
+    Py_END_ALLOW_THREADS;
+    PyBuffer_Release(&out);
+    PyBuffer_Release(&view);
+    Py_RETURN_NONE;
+}
+
+static const double _percent_limits[4][2] = {
+    {0, 360}, {0, 100}, {0, 100}, {0, 100}};
+
+static PyObject *
+_color_rgba_to_hsva(PyObject *self, PyObject *args, PyObject *kw)
+{
+    return _color_to_space(args, kw, _rgba_to_hsva);
+}
+
+static PyObject *
+_color_hsva_to_rgba(PyObject *self, PyObject *args, PyObject *kw)
+{
+    return _color_from_space(args, kw, _hsva_to_rgba, _percent_limits,
+                             "invalid HSVA value");
+}
+
+static PyObject *
+_color_rgba_to_hsla(PyObject *self, PyObject *args, PyObject *kw)
+{
+    return _color_to_space(args, kw, _rgba_to_hsla);
+}
+
+static PyObject *
+_color_hsla_to_rgba(PyObject *self, PyObject *args, PyObject *kw)
+{
+    return _color_from_space(args, kw, _hsla_to_rgba, _percent_limits,
+                             "invalid HSLA value");
+}
+
+static PyObject *
+_color_rgba_to_yuva(PyObject *self, PyObject *args, PyObject *kw)
+{
+    return _color_to_space(args, kw, _rgba_to_yuva);
+}
+
+static PyObject *
+_color_yuva_to_rgba(PyObject *self, PyObject *args, PyObject *kw)
+{
+    /* out of gamut values are clamped */
+    return _color_from_space(args, kw, _yuva_to_rgba, NULL, NULL);
+}
+
 /*DOC*/ static char _color_doc[] =
     /*DOC*/ "color module for pygame";
 
+static PyObject *
+_color_freelist_stats(PyObject *self, PyObject *_null)
+{
+    return pgFreeList_Stats(&_color_freelist);
+}
+
+static PyMethodDef _color_module_methods[] = {
+    {"correct_gamma_array", (PyCFunction)_color_correct_gamma_array,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMECOLORCORRECTGAMMAARRAY},
+    {"lerp_array", (PyCFunction)_color_lerp_array,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMECOLORLERPARRAY},
+    {"premul_alpha_array", _color_premul_alpha_array, METH_O,
+     DOC_PYGAMECOLORPREMULALPHAARRAY},
+    {"rgba_to_hsva", (PyCFunction)_color_rgba_to_hsva,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMECOLORRGBATOHSVA},
+    {"hsva_to_rgba", (PyCFunction)_color_hsva_to_rgba,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMECOLORHSVATORGBA},
+    {"rgba_to_hsla", (PyCFunction)_color_rgba_to_hsla,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMECOLORRGBATOHSLA},
+    {"hsla_to_rgba", (PyCFunction)_color_hsla_to_rgba,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMECOLORHSLATORGBA},
+    {"rgba_to_yuva", (PyCFunction)_color_rgba_to_yuva,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMECOLORRGBATOYUVA},
+    {"yuva_to_rgba", (PyCFunction)_color_yuva_to_rgba,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMECOLORYUVATORGBA},
+    {"_freelist_stats", _color_freelist_stats, METH_NOARGS,
+     "_freelist_stats() -> dict\nreturns how often new Colors reused "
+     "deallocated ones"},
+    {NULL, NULL, 0, NULL}};
+
 MODINIT_DEFINE(color)
 {
     PyObject *module = NULL, *colordict_module, *apiobj;
@@ -2083,7 +2708,7 @@ MODINIT_DEFINE(color)
                                          "color",
                                          _color_doc,
                                          -1,
-                                         NULL,
+                                         _color_module_methods,
                                          NULL,
                                          NULL,
                                          NULL,
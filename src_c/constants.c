@@ -108,6 +108,7 @@ MODINIT_DEFINE(constants)
     DEC_CONSTSF(RLEACCELOK);
     DEC_CONSTSF(RLEACCEL);
     DEC_CONSTSF(SRCALPHA);
+    DEC_CONSTSF(PREMULTIPLIED);
     DEC_CONSTSF(PREALLOC);
     DEC_CONSTSF(NOFRAME);
     DEC_CONSTSF(SHOWN);
@@ -649,6 +650,12 @@ MODINIT_DEFINE(constants)
 #define PYGAME_USEREVENT_DROPFILE 0x1000
     DEC_CONSTS(USEREVENT_DROPFILE, PYGAME_USEREVENT_DROPFILE);
 
+    /* alignments of wrapped text, the values of SDL_ttf's
+     * TTF_WRAPPED_ALIGN_* */
+    DEC_CONSTS(FONT_LEFT, 0);
+    DEC_CONSTS(FONT_CENTER, 1);
+    DEC_CONSTS(FONT_RIGHT, 2);
+
     if (PyModule_AddObject(module, "__all__", all_list)) {
         Py_DECREF(all_list);
         Py_DECREF(module);
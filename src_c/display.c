@@ -55,6 +55,10 @@ typedef struct _display_state_s {
     int fullscreen_backup_x;
     int fullscreen_backup_y;
     SDL_bool auto_resize;
+    /* the part of the screen update() may cover before it flips instead */
+    float update_threshold;
+    /* a dummy or offscreen video driver shows nothing, so flip() is free */
+    Uint8 headless;
 } _DisplayState;
 
 static int
@@ -92,6 +96,244 @@ _display_state_cleanup(_DisplayState *state)
     }
 }
 
+/* With a renderer that keeps the pixels of a locked streaming texture between
+ * locks, the display Surface of a SCALED display draws straight into the
+ * locked texture, so flip() has nothing to copy before the upload. The
+ * Surface's own pixels are kept aside meanwhile. */
+static SDL_Surface *pg_screen_surf = NULL;
+static void *pg_screen_pixels = NULL;
+static int pg_screen_pitch = 0;
+
+static void
+_pg_screen_copy(void *dst, int dst_pitch, const void *src, int src_pitch,
+                int row, int h)
+{
+    int y;
+
+    for (y = 0; y < h; ++y) {
+        memcpy((Uint8 *)dst + y * dst_pitch,
+               (const Uint8 *)src + y * src_pitch, row);
+    }
+}
+
+static void
+_pg_screen_bind(void)
+{
+    pgSurfaceObject *screen = pg_GetDefaultWindowSurface();
+    SDL_Surface *surf;
+    SDL_RendererInfo info;
+    void *pixels;
+    int pitch;
+
+    if (pg_screen_surf || !pg_renderer || !pg_texture || !screen)
+        return;
+    /* others hand out fresh memory on each lock */
+    if (SDL_GetRendererInfo(pg_renderer, &info) < 0 ||
+        (strcmp(info.name, "opengl") && strcmp(info.name, "opengles2")))
+        return;
+    surf = pgSurface_AsSurface(screen);
+    if (!surf || SDL_LockTexture(pg_texture, NULL, &pixels, &pitch) < 0)
+        return;
+
+    _pg_screen_copy(pixels, pitch, surf->pixels, surf->pitch,
+                    surf->w * surf->format->BytesPerPixel, surf->h);
+    pg_screen_surf = surf;
+    pg_screen_pixels = surf->pixels;
+    pg_screen_pitch = surf->pitch;
+    surf->pixels = pixels;
+    surf->pitch = pitch;
+}
+
+/* Give the display Surface its own pixels back, before the texture or the
+ * Surface change. */
+static void
+_pg_screen_unbind(void)
+{
+    SDL_Surface *surf = pg_screen_surf;
+
+    if (!surf)
+        return;
+    _pg_screen_copy(pg_screen_pixels, pg_screen_pitch, surf->pixels,
+                    surf->pitch, surf->w * surf->format->BytesPerPixel,
+                    surf->h);
+    surf->pixels = pg_screen_pixels;
+    surf->pitch = pg_screen_pitch;
+    pg_screen_surf = NULL;
+    SDL_UnlockTexture(pg_texture);
+}
+
+/* Upload the locked texture and lock it again for the next frame. Called
+ * without the GIL. */
+static void
+_pg_screen_present(void)
+{
+    SDL_Surface *surf = pg_screen_surf;
+    void *pixels;
+    int pitch;
+
+    SDL_UnlockTexture(pg_texture);
+    SDL_RenderClear(pg_renderer);
+    SDL_RenderCopy(pg_renderer, pg_texture, NULL, NULL);
+    SDL_RenderPresent(pg_renderer);
+
+    if (SDL_LockTexture(pg_texture, NULL, &pixels, &pitch) < 0) {
+        /* keep drawing, if into the Surface's own, older, pixels */
+        surf->pixels = pg_screen_pixels;
+        surf->pitch = pg_screen_pitch;
+        pg_screen_surf = NULL;
+        return;
+    }
+    surf->pixels = pixels;
+    surf->pitch = pitch;
+}
+
+/* With an async present, flip() on a SCALED display copies the display
+ * Surface to a pending frame and returns, while a thread of its own sends the
+ * frames to the renderer and waits for vsync there. */
+typedef struct {
+    SDL_Thread *thread;
+    /* guards the fields below, frames is signalled when a frame is queued or
+     * taken, and to stop the thread */
+    SDL_mutex *lock;
+    SDL_cond *frames;
+    /* held by any thread using the renderer while the presenter runs */
+    SDL_mutex *render_lock;
+    /* flip() fills pending while the presenter shows front */
+    SDL_Surface *pending;
+    SDL_Surface *front;
+    Uint64 pending_at;
+    int has_pending;
+    int presenting;
+    int buffers;
+    int quit;
+    Uint64 presented;
+    Uint64 dropped;
+    /* running average of the milliseconds from flip() to the present */
+    double latency;
+} _pgPresenter;
+
+static _pgPresenter pg_presenter = {0};
+
+static int SDLCALL
+_pg_present_thread(void *_null)
+{
+    _pgPresenter *p = &pg_presenter;
+    SDL_Surface *frame;
+    Uint64 queued_at;
+    double latency;
+
+    SDL_LockMutex(p->lock);
+    for (;;) {
+        while (!p->has_pending && !p->quit)
+            SDL_CondWait(p->frames, p->lock);
+        if (p->quit)
+            break;
+        /* take the frame, flip() can fill the other one meanwhile */
+        frame = p->pending;
+        p->pending = p->front;
+        p->front = frame;
+        queued_at = p->pending_at;
+        p->has_pending = 0;
+        p->presenting = 1;
+        SDL_CondBroadcast(p->frames);
+        SDL_UnlockMutex(p->lock);
+
+        SDL_LockMutex(p->render_lock);
+        SDL_UpdateTexture(pg_texture, NULL, frame->pixels, frame->pitch);
+        SDL_RenderClear(pg_renderer);
+        SDL_RenderCopy(pg_renderer, pg_texture, NULL, NULL);
+        SDL_RenderPresent(pg_renderer);
+        SDL_UnlockMutex(p->render_lock);
+
+        latency = (double)(SDL_GetPerformanceCounter() - queued_at) * 1000.0 /
+                  (double)SDL_GetPerformanceFrequency();
+        SDL_LockMutex(p->lock);
+        p->presenting = 0;
+        p->presented++;
+        if (p->presented == 1)
+            p->latency = latency;
+        else
+            p->latency += (latency - p->latency) / 16.0;
+        SDL_CondBroadcast(p->frames);
+    }
+    SDL_UnlockMutex(p->lock);
+    return 0;
+}
+
+/* Hand a copy of the display Surface to the presenter. Called without the
+ * GIL. */
+static void
+_pg_present_queue(SDL_Surface *screen)
+{
+    _pgPresenter *p = &pg_presenter;
+
+    SDL_LockMutex(p->lock);
+    if (p->buffers == 2) {
+        /* double buffered, wait until the last frame has been shown */
+        while ((p->has_pending || p->presenting) && !p->quit)
+            SDL_CondWait(p->frames, p->lock);
+    }
+    if (p->has_pending) {
+        /* triple buffered, the frame not shown yet is replaced */
+        p->dropped++;
+    }
+    /* the frames are made like the display Surface, pitch included */
+    memcpy(p->pending->pixels, screen->pixels,
+           (size_t)screen->pitch * screen->h);
+    p->pending_at = SDL_GetPerformanceCounter();
+    p->has_pending = 1;
+    SDL_CondBroadcast(p->frames);
+    SDL_UnlockMutex(p->lock);
+}
+
+static void
+_pg_present_free(void)
+{
+    _pgPresenter *p = &pg_presenter;
+
+    if (p->frames) {
+        SDL_DestroyCond(p->frames);
+        p->frames = NULL;
+    }
+    if (p->lock) {
+        SDL_DestroyMutex(p->lock);
+        p->lock = NULL;
+    }
+    if (p->render_lock) {
+        SDL_DestroyMutex(p->render_lock);
+        p->render_lock = NULL;
+    }
+    if (p->pending) {
+        SDL_FreeSurface(p->pending);
+        p->pending = NULL;
+    }
+    if (p->front) {
+        SDL_FreeSurface(p->front);
+        p->front = NULL;
+    }
+}
+
+/* Stop the presenter, before the renderer or the display Surface change.
+ * The frame still pending is not shown. The statistics are kept. */
+static void
+pg_present_stop(void)
+{
+    _pgPresenter *p = &pg_presenter;
+
+    if (!p->thread)
+        return;
+    SDL_LockMutex(p->lock);
+    p->quit = 1;
+    SDL_CondBroadcast(p->frames);
+    SDL_UnlockMutex(p->lock);
+
+    Py_BEGIN_ALLOW_THREADS;
+    SDL_WaitThread(p->thread, NULL);
+    Py_END_ALLOW_THREADS;
+    p->thread = NULL;
+    _pg_present_free();
+}
+
 #if !defined(__APPLE__)
 static char *icon_defaultname = "pygame_icon.bmp";
 static int icon_colorkey = 0;
@@ -180,6 +422,8 @@ static PyObject *
 pg_display_quit(PyObject *self, PyObject *_null)
 {
     _DisplayState *state = DISPLAY_STATE;
+    pg_present_stop();
+    _pg_screen_unbind();
     _display_state_cleanup(state);
     if (pg_GetDefaultWindowSurface()) {
         pgSurface_AsSurface(pg_GetDefaultWindowSurface()) = NULL;
@@ -254,6 +498,22 @@ pg_get_init(PyObject *self, PyObject *_null)
     return PyBool_FromLong(SDL_WasInit(SDL_INIT_VIDEO) != 0);
 }
 
+static int
+_pg_is_headless_driver(void)
+{
+    const char *name = SDL_GetCurrentVideoDriver();
+    return name && (!strcmp(name, "dummy") || !strcmp(name, "offscreen"));
+}
+
+static PyObject *
+pg_is_headless(PyObject *self, PyObject *_null)
+{
+    VIDEO_INIT_CHECK();
+    if (pg_GetDefaultWindow())
+        return PyBool_FromLong(DISPLAY_MOD_STATE(self)->headless);
+    return PyBool_FromLong(_pg_is_headless_driver());
+}
+
 static PyObject *
 pg_get_active(PyObject *self, PyObject *_null)
 {
@@ -708,7 +968,8 @@ pg_ResizeEventWatch(void *userdata, SDL_Event *event)
 
     if (pg_renderer != NULL) {
 #if (SDL_VERSION_ATLEAST(2, 0, 5))
-
+        if (pg_presenter.thread)
+            SDL_LockMutex(pg_presenter.render_lock);
         if (event->window.event == SDL_WINDOWEVENT_MAXIMIZED) {
             SDL_RenderSetIntegerScale(pg_renderer, SDL_FALSE);
         }
@@ -717,6 +978,8 @@ pg_ResizeEventWatch(void *userdata, SDL_Event *event)
                 pg_renderer, !(SDL_GetHintBoolean(
                                  "SDL_HINT_RENDER_SCALE_QUALITY", SDL_FALSE)));
         }
+        if (pg_presenter.thread)
+            SDL_UnlockMutex(pg_presenter.render_lock);
 #endif
         return 0;
     }
@@ -881,6 +1144,9 @@ pg_set_mode(PyObject *self, PyObject *arg, PyObject *kwds)
 
     state->using_gl = (flags & PGS_OPENGL) != 0;
     state->scaled_gl = state->using_gl && (flags & PGS_SCALED) != 0;
+    /* a renderer or GL context still has work to do without a screen */
+    state->headless = _pg_is_headless_driver() &&
+                      !(flags & (PGS_OPENGL | PGS_SCALED));
 
     if (state->scaled_gl) {
         if (PyErr_WarnEx(PyExc_FutureWarning,
@@ -906,6 +1172,9 @@ pg_set_mode(PyObject *self, PyObject *arg, PyObject *kwds)
     state->toggle_windowed_w = 0;
     state->toggle_windowed_h = 0;
 
+    pg_present_stop();
+    _pg_screen_unbind();
+
     if (pg_texture) {
         SDL_DestroyTexture(pg_texture);
         pg_texture = NULL;
@@ -961,7 +1230,7 @@ pg_set_mode(PyObject *self, PyObject *arg, PyObject *kwds)
             sdl_flags |= SDL_WINDOW_BORDERLESS;
         if (flags & PGS_RESIZABLE) {
             sdl_flags |= SDL_WINDOW_RESIZABLE;
-            if (state->auto_resize)
+            if (state->auto_resize && !state->headless)
                 SDL_AddEventWatch(pg_ResizeEventWatch, self);
         }
         if (flags & PGS_SHOWN)
@@ -1309,6 +1578,7 @@ pg_set_mode(PyObject *self, PyObject *arg, PyObject *kwds)
         pg_SetDefaultWindow(win);
         pg_SetDefaultWindowSurface(surface);
         Py_DECREF(surface);
+        _pg_screen_bind();
 
         /* ensure window is initially black */
         if (init_flip) {
@@ -1317,6 +1587,12 @@ pg_set_mode(PyObject *self, PyObject *arg, PyObject *kwds)
         }
     }
 
+    /*nobody sees the icon or sends events to a headless window*/
+    if (state->headless) {
+        Py_INCREF(surface);
+        return (PyObject *)surface;
+    }
+
     /*set the window icon*/
     if (!state->icon) {
         state->icon = pg_display_resource(icon_defaultname);
@@ -1327,8 +1603,13 @@ pg_set_mode(PyObject *self, PyObject *arg, PyObject *kwds)
                             icon_colorkey);
         }
     }
-    if (state->icon)
-        SDL_SetWindowIcon(win, pgSurface_AsSurface(state->icon));
+    if (state->icon) {
+        /* an icon that cannot be unpacked is only left out */
+        if (pgSurface_Unpack(pgSurface_AsSurface(state->icon)))
+            SDL_SetWindowIcon(win, pgSurface_AsSurface(state->icon));
+        else
+            PyErr_Clear();
+    }
 
     /*probably won't do much, but can't hurt, and might help*/
     SDL_PumpEvents();
@@ -1526,6 +1807,8 @@ pg_flip_internal(_DisplayState *state)
 {
     SDL_Window *win = pg_GetDefaultWindow();
     int status = 0;
+    int w, h;
+    Uint64 start;
 
     /* Same check as VIDEO_INIT_CHECK() but returns -1 instead of NULL on
      * fail. */
@@ -1539,6 +1822,11 @@ pg_flip_internal(_DisplayState *state)
         return -1;
     }
 
+    /* the display surface is the only copy of the frame */
+    if (state->headless)
+        return 0;
+
+    start = pg_StatsBegin();
     Py_BEGIN_ALLOW_THREADS;
     if (state->using_gl) {
         SDL_GL_SwapWindow(win);
@@ -1547,10 +1835,19 @@ pg_flip_internal(_DisplayState *state)
         if (pg_renderer != NULL) {
             SDL_Surface *screen =
                 pgSurface_AsSurface(pg_GetDefaultWindowSurface());
-            SDL_UpdateTexture(pg_texture, NULL, screen->pixels, screen->pitch);
-            SDL_RenderClear(pg_renderer);
-            SDL_RenderCopy(pg_renderer, pg_texture, NULL, NULL);
-            SDL_RenderPresent(pg_renderer);
+            if (pg_presenter.thread) {
+                _pg_present_queue(screen);
+            }
+            else if (pg_screen_surf) {
+                _pg_screen_present();
+            }
+            else {
+                SDL_UpdateTexture(pg_texture, NULL, screen->pixels,
+                                  screen->pitch);
+                SDL_RenderClear(pg_renderer);
+                SDL_RenderCopy(pg_renderer, pg_texture, NULL, NULL);
+                SDL_RenderPresent(pg_renderer);
+            }
         }
         else {
             /* Force a re-initialization of the surface in case it
@@ -1567,6 +1864,8 @@ pg_flip_internal(_DisplayState *state)
         }
     }
     Py_END_ALLOW_THREADS;
+    SDL_GetWindowSize(win, &w, &h);
+    pg_StatsEnd(PG_STAT_DISPLAY, "flip", start, (Sint64)w * h);
 
     if (status < 0) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
@@ -1611,6 +1910,104 @@ pg_screencroprect(SDL_Rect *r, int w, int h, SDL_Rect *cur)
     return cur;
 }
 
+/* The pixels an update rectangle costs on top of its area. Two rectangles
+ * are merged when sending the one holding both costs no more than sending
+ * each, counting their overlap twice, so adjacent and mostly overlapping
+ * areas are sent once. */
+#define PG_UPDATE_RECT_COST 1024
+
+static int
+pg_coalesce_rects(SDL_Rect *rects, int count)
+{
+    SDL_Rect both;
+    Sint64 apart;
+    int i, j, merged;
+
+    do {
+        merged = 0;
+        for (i = 0; i < count; ++i) {
+            for (j = i + 1; j < count; ++j) {
+                SDL_UnionRect(&rects[i], &rects[j], &both);
+                apart = (Sint64)rects[i].w * rects[i].h +
+                        (Sint64)rects[j].w * rects[j].h;
+                if ((Sint64)both.w * both.h > apart + PG_UPDATE_RECT_COST)
+                    continue;
+                /* the grown rectangle is checked against the rest again */
+                rects[i] = both;
+                rects[j--] = rects[--count];
+                merged = 1;
+            }
+        }
+    } while (merged);
+    return count;
+}
+
+/* The size update rectangles are cropped to, the display Surface when it is
+ * scaled by a renderer, else the window. */
+static void
+pg_update_size(SDL_Window *win, int *w, int *h)
+{
+    if (pg_renderer != NULL) {
+        SDL_Surface *screen =
+            pgSurface_AsSurface(pg_GetDefaultWindowSurface());
+        *w = screen->w;
+        *h = screen->h;
+    }
+    else {
+        SDL_GetWindowSize(win, w, h);
+    }
+}
+
+/* Send the areas of the display Surface to the screen after merging them, or
+ * all of it when they cover more of it than the update threshold. With a
+ * renderer only the areas are streamed to its texture. */
+static int
+pg_update_rects_internal(_DisplayState *state, SDL_Window *win,
+                         SDL_Rect *rects, int count, int wide, int high)
+{
+    SDL_Surface *screen;
+    Sint64 area = 0;
+    int loop;
+    Uint64 start;
+
+    if (state->headless)
+        return 0;
+    count = pg_coalesce_rects(rects, count);
+    if (!count)
+        return 0;
+    for (loop = 0; loop < count; ++loop)
+        area += (Sint64)rects[loop].w * rects[loop].h;
+    /* the presenter only takes whole frames */
+    if (area > state->update_threshold * ((Sint64)wide * high) ||
+        pg_presenter.thread)
+        return pg_flip_internal(state);
+
+    start = pg_StatsBegin();
+    Py_BEGIN_ALLOW_THREADS;
+    if (pg_renderer != NULL) {
+        /* the pixels may be those of the locked texture, the renderers
+           that keep them upload from them as well */
+        screen = pgSurface_AsSurface(pg_GetDefaultWindowSurface());
+        for (loop = 0; loop < count; ++loop) {
+            SDL_UpdateTexture(pg_texture, &rects[loop],
+                              (Uint8 *)screen->pixels +
+                                  rects[loop].y * screen->pitch +
+                                  rects[loop].x *
+                                      screen->format->BytesPerPixel,
+                              screen->pitch);
+        }
+        SDL_RenderClear(pg_renderer);
+        SDL_RenderCopy(pg_renderer, pg_texture, NULL, NULL);
+        SDL_RenderPresent(pg_renderer);
+    }
+    else {
+        SDL_UpdateWindowSurfaceRects(win, rects, count);
+    }
+    Py_END_ALLOW_THREADS;
+    pg_StatsEnd(PG_STAT_DISPLAY, "update", start, area);
+    return 0;
+}
+
 static PyObject *
 pg_update(PyObject *self, PyObject *arg)
 {
@@ -1624,10 +2021,9 @@ pg_update(PyObject *self, PyObject *arg)
     if (!win)
         return RAISE(pgExc_SDLError, "Display mode not set");
 
-    if (pg_renderer != NULL) {
+    if (pg_renderer != NULL && state->using_gl) {
         return pg_flip(self, NULL);
     }
-    SDL_GetWindowSize(win, &wide, &high);
 
     if (state->using_gl)
         return RAISE(pgExc_SDLError, "Cannot update an OPENGL display");
@@ -1643,12 +2039,18 @@ pg_update(PyObject *self, PyObject *arg)
         Py_RETURN_NONE;
     }
 
+    pg_update_size(win, &wide, &high);
+
     gr = pgRect_FromObject(arg, &temp);
     if (gr) {
         SDL_Rect sdlr;
 
-        if (pg_screencroprect(gr, wide, high, &sdlr))
-            SDL_UpdateWindowSurfaceRects(win, &sdlr, 1);
+        if (pg_screencroprect(gr, wide, high, &sdlr) && sdlr.w > 0 &&
+            sdlr.h > 0) {
+            if (pg_update_rects_internal(state, win, &sdlr, 1, wide, high) <
+                0)
+                return NULL;
+        }
     }
     else {
         PyObject *seq;
@@ -1692,16 +2094,17 @@ pg_update(PyObject *self, PyObject *arg)
                 continue;
 
             /*bail out if rect not onscreen*/
-            if (!pg_screencroprect(gr, wide, high, cur_rect))
+            if (!pg_screencroprect(gr, wide, high, cur_rect) ||
+                cur_rect->w < 1 || cur_rect->h < 1)
                 continue;
 
             ++count;
         }
 
-        if (count) {
-            Py_BEGIN_ALLOW_THREADS;
-            SDL_UpdateWindowSurfaceRects(win, rects, count);
-            Py_END_ALLOW_THREADS;
+        if (pg_update_rects_internal(state, win, rects, count, wide, high) <
+            0) {
+            PyMem_Free((char *)rects);
+            return NULL;
         }
 
         PyMem_Free((char *)rects);
@@ -1709,6 +2112,146 @@ pg_update(PyObject *self, PyObject *arg)
     Py_RETURN_NONE;
 }
 
+static PyObject *
+pg_update_damage(PyObject *self, PyObject *_null)
+{
+    SDL_Window *win = pg_GetDefaultWindow();
+    _DisplayState *state = DISPLAY_MOD_STATE(self);
+    pgSurfaceObject *surface;
+    SDL_Rect damage[PG_DAMAGE_MAX_RECTS];
+    SDL_Rect rects[PG_DAMAGE_MAX_RECTS];
+    int wide, high, num, count, loop;
+
+    VIDEO_INIT_CHECK();
+
+    if (!win)
+        return RAISE(pgExc_SDLError, "Display mode not set");
+
+    if (pg_renderer != NULL && state->using_gl) {
+        return pg_flip(self, NULL);
+    }
+
+    if (state->using_gl)
+        return RAISE(pgExc_SDLError, "Cannot update an OPENGL display");
+
+    surface = pg_GetDefaultWindowSurface();
+    num = surface ? pgSurface_PopDamage(surface, damage) : -1;
+    if (num < 0) {
+        /* not tracked, so anything may have changed */
+        return pg_flip(self, NULL);
+    }
+
+    pg_update_size(win, &wide, &high);
+    count = 0;
+    for (loop = 0; loop < num; ++loop) {
+        if (pg_screencroprect(&damage[loop], wide, high, &rects[count]) &&
+            rects[count].w > 0 && rects[count].h > 0)
+            ++count;
+    }
+
+    if (pg_update_rects_internal(state, win, rects, count, wide, high) < 0)
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_set_update_threshold(PyObject *self, PyObject *arg)
+{
+    double threshold = PyFloat_AsDouble(arg);
+
+    if (threshold == -1.0 && PyErr_Occurred())
+        return NULL;
+    if (threshold < 0.0 || threshold > 1.0)
+        return RAISE(PyExc_ValueError,
+                     "update threshold must be between 0 and 1");
+    DISPLAY_MOD_STATE(self)->update_threshold = (float)threshold;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_get_update_threshold(PyObject *self, PyObject *_null)
+{
+    return PyFloat_FromDouble(DISPLAY_MOD_STATE(self)->update_threshold);
+}
+
+static PyObject *
+pg_set_async_present(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    _DisplayState *state = DISPLAY_MOD_STATE(self);
+    _pgPresenter *p = &pg_presenter;
+    SDL_Surface *screen;
+    int enabled = 1, buffers = 3;
+    static char *keywords[] = {"enabled", "buffers", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|pi", keywords, &enabled,
+                                     &buffers))
+        return NULL;
+
+    VIDEO_INIT_CHECK();
+
+    if (buffers != 2 && buffers != 3)
+        return RAISE(PyExc_ValueError, "buffers must be 2 or 3");
+
+    pg_present_stop();
+    if (!enabled) {
+        _pg_screen_bind();
+        Py_RETURN_NONE;
+    }
+
+#if defined(__APPLE__) || defined(__EMSCRIPTEN__)
+    /* the renderer may only be used by the main thread here */
+    return RAISE(pgExc_SDLError,
+                 "async present is not supported on this platform");
+#endif
+    if (pg_renderer == NULL || state->using_gl)
+        return RAISE(pgExc_SDLError, "async present needs a SCALED display");
+
+    /* the presenter uploads frames of its own */
+    _pg_screen_unbind();
+    screen = pgSurface_AsSurface(pg_GetDefaultWindowSurface());
+    p->buffers = buffers;
+    p->has_pending = p->presenting = p->quit = 0;
+    p->presented = p->dropped = 0;
+    p->latency = 0.0;
+    p->pending = SDL_ConvertSurface(screen, screen->format, 0);
+    p->front = SDL_ConvertSurface(screen, screen->format, 0);
+    p->lock = SDL_CreateMutex();
+    p->render_lock = SDL_CreateMutex();
+    p->frames = SDL_CreateCond();
+    if (!p->pending || !p->front || !p->lock || !p->render_lock ||
+        !p->frames) {
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        _pg_present_free();
+        _pg_screen_bind();
+        return NULL;
+    }
+
+    p->thread = SDL_CreateThread(_pg_present_thread, "pygame present", NULL);
+    if (!p->thread) {
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        _pg_present_free();
+        _pg_screen_bind();
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_get_present_stats(PyObject *self, PyObject *_null)
+{
+    _pgPresenter *p = &pg_presenter;
+    PyObject *ret;
+
+    if (p->thread)
+        SDL_LockMutex(p->lock);
+    ret = Py_BuildValue("(dKK)", p->latency,
+                        (unsigned long long)p->presented,
+                        (unsigned long long)p->dropped);
+    if (p->thread)
+        SDL_UnlockMutex(p->lock);
+    return ret;
+}
+
 static PyObject *
 pg_set_palette(PyObject *self, PyObject *args)
 {
@@ -1971,6 +2514,8 @@ pg_set_icon(PyObject *self, PyObject *arg)
         if (!pg_display_init(NULL, NULL))
             return NULL;
     }
+    if (!pgSurface_Unpack(pgSurface_AsSurface(surface)))
+        return NULL;
     Py_INCREF(surface);
     Py_XDECREF(state->icon);
     state->icon = surface;
@@ -2067,7 +2612,7 @@ pg_is_fullscreen(PyObject *self, PyObject *_null)
 }
 
 static PyObject *
-pg_toggle_fullscreen(PyObject *self, PyObject *_null)
+_pg_toggle_fullscreen(PyObject *self)
 {
     SDL_Window *win = pg_GetDefaultWindow();
     int result, flags;
@@ -2393,6 +2938,19 @@ pg_toggle_fullscreen(PyObject *self, PyObject *_null)
     return PyLong_FromLong(result != 0);
 }
 
+static PyObject *
+pg_toggle_fullscreen(PyObject *self, PyObject *_null)
+{
+    PyObject *result;
+
+    /* the renderer and its texture may be made again */
+    pg_present_stop();
+    _pg_screen_unbind();
+    result = _pg_toggle_fullscreen(self);
+    _pg_screen_bind();
+    return result;
+}
+
 /* This API is provisional, and, not finalised, and should not be documented
  * in any user-facing docs until we are sure when this is safe to call and when
  * it should raise an exception */
@@ -2502,6 +3060,8 @@ static PyMethodDef _pg_display_methods[] = {
     {"quit", (PyCFunction)pg_display_quit, METH_NOARGS, DOC_PYGAMEDISPLAYQUIT},
     {"get_init", (PyCFunction)pg_get_init, METH_NOARGS,
      DOC_PYGAMEDISPLAYGETINIT},
+    {"is_headless", (PyCFunction)pg_is_headless, METH_NOARGS,
+     DOC_PYGAMEDISPLAYISHEADLESS},
     {"get_active", (PyCFunction)pg_get_active, METH_NOARGS,
      DOC_PYGAMEDISPLAYGETACTIVE},
 
@@ -2527,6 +3087,16 @@ static PyMethodDef _pg_display_methods[] = {
 
     {"flip", (PyCFunction)pg_flip, METH_NOARGS, DOC_PYGAMEDISPLAYFLIP},
     {"update", (PyCFunction)pg_update, METH_VARARGS, DOC_PYGAMEDISPLAYUPDATE},
+    {"update_damage", (PyCFunction)pg_update_damage, METH_NOARGS,
+     DOC_PYGAMEDISPLAYUPDATEDAMAGE},
+    {"set_update_threshold", (PyCFunction)pg_set_update_threshold, METH_O,
+     DOC_PYGAMEDISPLAYSETUPDATETHRESHOLD},
+    {"get_update_threshold", (PyCFunction)pg_get_update_threshold,
+     METH_NOARGS, DOC_PYGAMEDISPLAYGETUPDATETHRESHOLD},
+    {"set_async_present", (PyCFunction)pg_set_async_present,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEDISPLAYSETASYNCPRESENT},
+    {"get_present_stats", (PyCFunction)pg_get_present_stats, METH_NOARGS,
+     DOC_PYGAMEDISPLAYGETPRESENTSTATS},
 
     {"set_palette", pg_set_palette, METH_VARARGS, DOC_PYGAMEDISPLAYSETPALETTE},
     {"set_gamma", pg_set_gamma, METH_VARARGS, DOC_PYGAMEDISPLAYSETGAMMA},
@@ -2628,6 +3198,7 @@ MODINIT_DEFINE(display)
     state->gamma_ramp = NULL;
     state->using_gl = 0;
     state->auto_resize = SDL_TRUE;
+    state->update_threshold = 0.75f;
 
     return module;
 }
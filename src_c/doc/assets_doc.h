@@ -0,0 +1,52 @@
+/* Auto generated file: with makeref.py .  Docs go in docs/reST/ref/ . */
+#define DOC_PYGAMEASSETS "pygame module for loading many images in the background"
+#define DOC_PYGAMEASSETSLOADBATCH "load_batch(files, convert=False, alpha=False, renderer=None, event=0, chunk_size=16) -> Batch\nload many images in the background"
+#define DOC_PYGAMEASSETSBATCH "Batch(files, convert=False, alpha=False, renderer=None, event=0, chunk_size=16) -> Batch\npygame object for a group of images loading in the background"
+#define DOC_BATCHTOTAL "total -> int\nthe number of images in the batch"
+#define DOC_BATCHLOADED "loaded -> int\nthe number of images loaded so far"
+#define DOC_BATCHDONE "done() -> bool\ncheck if the loading has finished"
+#define DOC_BATCHCANCEL "cancel() -> None\nstop loading after the chunk being loaded"
+#define DOC_BATCHUPDATE "update() -> int\ntake the images loaded since the last call"
+#define DOC_BATCHRESULT "result(timeout=None) -> list\nwait for every image and get them all"
+
+
+/* Docs in a comment... slightly easier to read. */
+
+/*
+
+pygame.assets
+pygame module for loading many images in the background
+
+pygame.assets.load_batch
+ load_batch(files, convert=False, alpha=False, renderer=None, event=0, chunk_size=16) -> Batch
+load many images in the background
+
+pygame.assets.Batch
+ Batch(files, convert=False, alpha=False, renderer=None, event=0, chunk_size=16) -> Batch
+pygame object for a group of images loading in the background
+
+pygame.assets.Batch.total
+ total -> int
+the number of images in the batch
+
+pygame.assets.Batch.loaded
+ loaded -> int
+the number of images loaded so far
+
+pygame.assets.Batch.done
+ done() -> bool
+check if the loading has finished
+
+pygame.assets.Batch.cancel
+ cancel() -> None
+stop loading after the chunk being loaded
+
+pygame.assets.Batch.update
+ update() -> int
+take the images loaded since the last call
+
+pygame.assets.Batch.result
+ result(timeout=None) -> list
+wait for every image and get them all
+
+*/
@@ -0,0 +1,42 @@
+/* Auto generated file: with makeref.py .  Docs go in docs/reST/ref/ . */
+#define DOC_PYGAMEATLAS "pygame module for packing many small images into a few large ones"
+#define DOC_PYGAMEATLASATLAS "Atlas(size=(1024, 1024), padding=1, flags=SRCALPHA, depth=32) -> Atlas\npygame object for packing many small images into a few large ones"
+#define DOC_ATLASPAGES "pages -> list\nthe surfaces holding the images"
+#define DOC_ATLASADD "add(surface) -> Surface\ncopies an image into the atlas"
+#define DOC_ATLASADDMANY "add_many(surfaces) -> [Surface, ...]\ncopies many images into the atlas"
+#define DOC_ATLASLOCATE "locate(image) -> (page_index, Rect)\nfinds where an image is in the atlas"
+#define DOC_ATLASTEXTURES "textures(renderer) -> [Texture, ...]\nuploads the pages as Textures"
+
+
+/* Docs in a comment... slightly easier to read. */
+
+/*
+
+pygame.atlas
+pygame module for packing many small images into a few large ones
+
+pygame.atlas.Atlas
+ Atlas(size=(1024, 1024), padding=1, flags=SRCALPHA, depth=32) -> Atlas
+pygame object for packing many small images into a few large ones
+
+pygame.atlas.Atlas.pages
+ pages -> list
+the surfaces holding the images
+
+pygame.atlas.Atlas.add
+ add(surface) -> Surface
+copies an image into the atlas
+
+pygame.atlas.Atlas.add_many
+ add_many(surfaces) -> [Surface, ...]
+copies many images into the atlas
+
+pygame.atlas.Atlas.locate
+ locate(image) -> (page_index, Rect)
+finds where an image is in the atlas
+
+pygame.atlas.Atlas.textures
+ textures(renderer) -> [Texture, ...]
+uploads the pages as Textures
+
+*/
\ No newline at end of file
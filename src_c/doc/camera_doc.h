@@ -13,6 +13,14 @@
 #define DOC_CAMERAQUERYIMAGE "query_image() -> bool\nchecks if a frame is ready"
 #define DOC_CAMERAGETIMAGE "get_image(Surface = None) -> Surface\ncaptures an image as a Surface"
 #define DOC_CAMERAGETRAW "get_raw() -> bytes\nreturns an unmodified image as bytes"
+#define DOC_CAMERAGETRAWVIEW "get_raw_view() -> memoryview\nreturns a view of an unmodified image in the camera buffer"
+#define DOC_CAMERARELEASERAWVIEW "release_raw_view() -> None\ngives the buffer of the raw view back to the camera"
+#define DOC_CAMERAEXPORTDMABUF "export_dmabuf() -> fd\nexports the buffer of the raw view as a DMABUF"
+#define DOC_CAMERASTARTCAPTURE "start_capture(frames=3, event=0) -> None\nstarts capturing frames on a background thread"
+#define DOC_CAMERASTOPCAPTURE "stop_capture() -> None\nstops the background capture thread"
+#define DOC_CAMERAGETLATEST "get_latest(surface=None) -> Surface or None\nreturns the newest captured frame, dropping older ones"
+#define DOC_CAMERAGETNEXT "get_next(timeout=-1, surface=None) -> Surface or None\nreturns the oldest captured frame, waiting for one if needed"
+#define DOC_CAMERAGETCAPTURESTATS "get_capture_stats() -> dict\nreturns the frame counters of the capture thread"
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -74,4 +82,36 @@ pygame.camera.Camera.get_raw
  get_raw() -> bytes
 returns an unmodified image as bytes
 
+pygame.camera.Camera.get_raw_view
+ get_raw_view() -> memoryview
+returns a view of an unmodified image in the camera buffer
+
+pygame.camera.Camera.release_raw_view
+ release_raw_view() -> None
+gives the buffer of the raw view back to the camera
+
+pygame.camera.Camera.export_dmabuf
+ export_dmabuf() -> fd
+exports the buffer of the raw view as a DMABUF
+
+pygame.camera.Camera.start_capture
+ start_capture(frames=3, event=0) -> None
+starts capturing frames on a background thread
+
+pygame.camera.Camera.stop_capture
+ stop_capture() -> None
+stops the background capture thread
+
+pygame.camera.Camera.get_latest
+ get_latest(surface=None) -> Surface or None
+returns the newest captured frame, dropping older ones
+
+pygame.camera.Camera.get_next
+ get_next(timeout=-1, surface=None) -> Surface or None
+returns the oldest captured frame, waiting for one if needed
+
+pygame.camera.Camera.get_capture_stats
+ get_capture_stats() -> dict
+returns the frame counters of the capture thread
+
 */
\ No newline at end of file
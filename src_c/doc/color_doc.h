@@ -14,6 +14,15 @@
 #define DOC_COLORLERP "lerp(Color, float) -> Color\nreturns a linear interpolation to the given Color."
 #define DOC_COLORPREMULALPHA "premul_alpha() -> Color\nreturns a Color where the r,g,b components have been multiplied by the alpha."
 #define DOC_COLORUPDATE "update(r, g, b) -> None\nupdate(r, g, b, a=255) -> None\nupdate(color_value) -> None\nSets the elements of the color"
+#define DOC_PYGAMECOLORCORRECTGAMMAARRAY "correct_gamma_array(rgba, gamma) -> None\napplies a gamma value to a buffer of RGBA colors"
+#define DOC_PYGAMECOLORLERPARRAY "lerp_array(rgba, color, amount) -> None\ninterpolates a buffer of RGBA colors towards other colors"
+#define DOC_PYGAMECOLORPREMULALPHAARRAY "premul_alpha_array(rgba) -> None\nmultiplies the r,g,b components of a buffer of RGBA colors by their alpha"
+#define DOC_PYGAMECOLORRGBATOHSVA "rgba_to_hsva(rgba, out) -> None\nconverts a buffer of RGBA colors to HSVA"
+#define DOC_PYGAMECOLORHSVATORGBA "hsva_to_rgba(values, out) -> None\nconverts a buffer of HSVA colors to RGBA"
+#define DOC_PYGAMECOLORRGBATOHSLA "rgba_to_hsla(rgba, out) -> None\nconverts a buffer of RGBA colors to HSLA"
+#define DOC_PYGAMECOLORHSLATORGBA "hsla_to_rgba(values, out) -> None\nconverts a buffer of HSLA colors to RGBA"
+#define DOC_PYGAMECOLORRGBATOYUVA "rgba_to_yuva(rgba, out) -> None\nconverts a buffer of RGBA colors to YUVA"
+#define DOC_PYGAMECOLORYUVATORGBA "yuva_to_rgba(values, out) -> None\nconverts a buffer of YUVA colors to RGBA"
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -84,4 +93,40 @@ pygame.Color.update
  update(color_value) -> None
 Sets the elements of the color
 
+pygame.color.correct_gamma_array
+ correct_gamma_array(rgba, gamma) -> None
+applies a gamma value to a buffer of RGBA colors
+
+pygame.color.lerp_array
+ lerp_array(rgba, color, amount) -> None
+interpolates a buffer of RGBA colors towards other colors
+
+pygame.color.premul_alpha_array
+ premul_alpha_array(rgba) -> None
+multiplies the r,g,b components of a buffer of RGBA colors by their alpha
+
+pygame.color.rgba_to_hsva
+ rgba_to_hsva(rgba, out) -> None
+converts a buffer of RGBA colors to HSVA
+
+pygame.color.hsva_to_rgba
+ hsva_to_rgba(values, out) -> None
+converts a buffer of HSVA colors to RGBA
+
+pygame.color.rgba_to_hsla
+ rgba_to_hsla(rgba, out) -> None
+converts a buffer of RGBA colors to HSLA
+
+pygame.color.hsla_to_rgba
+ hsla_to_rgba(values, out) -> None
+converts a buffer of HSLA colors to RGBA
+
+pygame.color.rgba_to_yuva
+ rgba_to_yuva(rgba, out) -> None
+converts a buffer of RGBA colors to YUVA
+
+pygame.color.yuva_to_rgba
+ yuva_to_rgba(values, out) -> None
+converts a buffer of YUVA colors to RGBA
+
 */
\ No newline at end of file
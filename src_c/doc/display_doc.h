@@ -7,7 +7,13 @@
 #define DOC_PYGAMEDISPLAYGETSURFACE "get_surface() -> Surface\nGet a reference to the currently set display surface"
 #define DOC_PYGAMEDISPLAYFLIP "flip() -> None\nUpdate the full display Surface to the screen"
 #define DOC_PYGAMEDISPLAYUPDATE "update(rectangle=None) -> None\nupdate(rectangle_list) -> None\nUpdate portions of the screen for software displays"
+#define DOC_PYGAMEDISPLAYUPDATEDAMAGE "update_damage() -> None\nUpdate the areas changed on a damage tracked display Surface"
+#define DOC_PYGAMEDISPLAYSETUPDATETHRESHOLD "set_update_threshold(threshold) -> None\nSet how much of the screen update may cover before a full update"
+#define DOC_PYGAMEDISPLAYGETUPDATETHRESHOLD "get_update_threshold() -> float\nGet how much of the screen update may cover before a full update"
+#define DOC_PYGAMEDISPLAYSETASYNCPRESENT "set_async_present(enabled=True, buffers=3) -> None\nPresent the frames of a SCALED display from a thread of its own"
+#define DOC_PYGAMEDISPLAYGETPRESENTSTATS "get_present_stats() -> (latency, presented, dropped)\nGet the latency and counts of the async present"
 #define DOC_PYGAMEDISPLAYGETDRIVER "get_driver() -> name\nGet the name of the pygame display backend"
+#define DOC_PYGAMEDISPLAYISHEADLESS "is_headless() -> bool\nReturns True when the display is rendered without a screen"
 #define DOC_PYGAMEDISPLAYINFO "Info() -> VideoInfo\nCreate a video display information object"
 #define DOC_PYGAMEDISPLAYGETWMINFO "get_wm_info() -> dict\nGet information about the current windowing system"
 #define DOC_PYGAMEDISPLAYGETDESKTOPSIZES "get_desktop_sizes() -> list\nGet sizes of active desktops"
@@ -66,10 +72,34 @@ pygame.display.update
  update(rectangle_list) -> None
 Update portions of the screen for software displays
 
+pygame.display.update_damage
+ update_damage() -> None
+Update the areas changed on a damage tracked display Surface
+
+pygame.display.set_update_threshold
+ set_update_threshold(threshold) -> None
+Set how much of the screen update may cover before a full update
+
+pygame.display.get_update_threshold
+ get_update_threshold() -> float
+Get how much of the screen update may cover before a full update
+
+pygame.display.set_async_present
+ set_async_present(enabled=True, buffers=3) -> None
+Present the frames of a SCALED display from a thread of its own
+
+pygame.display.get_present_stats
+ get_present_stats() -> (latency, presented, dropped)
+Get the latency and counts of the async present
+
 pygame.display.get_driver
  get_driver() -> name
 Get the name of the pygame display backend
 
+pygame.display.is_headless
+ is_headless() -> bool
+Returns True when the display is rendered without a screen
+
 pygame.display.Info
  Info() -> VideoInfo
 Create a video display information object
@@ -9,6 +9,22 @@
 #define DOC_PYGAMEDRAWLINES "lines(surface, color, closed, points) -> Rect\nlines(surface, color, closed, points, width=1) -> Rect\ndraw multiple contiguous straight line segments"
 #define DOC_PYGAMEDRAWAALINE "aaline(surface, color, start_pos, end_pos) -> Rect\naaline(surface, color, start_pos, end_pos, blend=1) -> Rect\ndraw a straight antialiased line"
 #define DOC_PYGAMEDRAWAALINES "aalines(surface, color, closed, points) -> Rect\naalines(surface, color, closed, points, blend=1) -> Rect\ndraw multiple contiguous straight antialiased line segments"
+#define DOC_PYGAMEDRAWCIRCLES "circles(surface, color, centers, radii, width=0) -> Rect\ndraw many circles in one call"
+#define DOC_PYGAMEDRAWRECTS "rects(surface, color, rects, width=0) -> Rect\ndraw many rectangles in one call"
+#define DOC_PYGAMEDRAWLINESEGMENTS "line_segments(surface, color, segments, width=1) -> Rect\ndraw many separate straight line segments in one call"
+#define DOC_PYGAMEDRAWAAPOLYGON "aapolygon(surface, color, points) -> Rect\ndraw an antialiased filled polygon"
+#define DOC_PYGAMEDRAWAACIRCLE "aacircle(surface, color, center, radius) -> Rect\ndraw an antialiased filled circle"
+#define DOC_PYGAMEDRAWAAELLIPSE "aaellipse(surface, color, rect) -> Rect\ndraw an antialiased filled ellipse"
+#define DOC_PYGAMEDRAWAARECT "aarect(surface, color, rect, border_radius=0) -> Rect\ndraw an antialiased filled rectangle"
+#define DOC_PYGAMEDRAWPATH "path(surface, color, points, width=1, join='miter', cap='butt') -> Rect\ndraw an antialiased stroke along a series of points"
+#define DOC_PYGAMEDRAWLINEARGRADIENT "linear_gradient(surface, rect, start_color, end_color, start_pos=None, end_pos=None) -> Rect\nfill a rectangle with a linear gradient"
+#define DOC_PYGAMEDRAWRADIALGRADIENT "radial_gradient(surface, center, radius, inner_color, outer_color) -> Rect\nfill a circle with a radial gradient"
+#define DOC_PYGAMEDRAWTEXTUREDPOLYGON "textured_polygon(surface, points, texture, offset=(0, 0)) -> Rect\nfill a polygon with a texture"
+#define DOC_PYGAMEDRAWCURVE "Curve(points, tolerance=0.25) -> Curve\na Bezier spline flattened once for repeated drawing"
+#define DOC_CURVESTROKE "stroke(surface, color, width=1, join='miter', cap='butt') -> Rect\ndraw an antialiased stroke along the curve"
+#define DOC_CURVEFILL "fill(surface, color) -> Rect\ndraw the area enclosed by the curve"
+#define DOC_CURVECONTROLPOINTS "control_points -> tuple\nthe control points the curve was made from"
+#define DOC_CURVETOLERANCE "tolerance -> float\nthe largest distance of the lines from the curve"
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -63,4 +79,68 @@ pygame.draw.aalines
  aalines(surface, color, closed, points, blend=1) -> Rect
 draw multiple contiguous straight antialiased line segments
 
-*/
\ No newline at end of file
+pygame.draw.circles
+ circles(surface, color, centers, radii, width=0) -> Rect
+draw many circles in one call
+
+pygame.draw.rects
+ rects(surface, color, rects, width=0) -> Rect
+draw many rectangles in one call
+
+pygame.draw.line_segments
+ line_segments(surface, color, segments, width=1) -> Rect
+draw many separate straight line segments in one call
+
+pygame.draw.aapolygon
+ aapolygon(surface, color, points) -> Rect
+draw an antialiased filled polygon
+
+pygame.draw.aacircle
+ aacircle(surface, color, center, radius) -> Rect
+draw an antialiased filled circle
+
+pygame.draw.aaellipse
+ aaellipse(surface, color, rect) -> Rect
+draw an antialiased filled ellipse
+
+pygame.draw.aarect
+ aarect(surface, color, rect, border_radius=0) -> Rect
+draw an antialiased filled rectangle
+
+pygame.draw.path
+ path(surface, color, points, width=1, join='miter', cap='butt') -> Rect
+draw an antialiased stroke along a series of points
+
+pygame.draw.linear_gradient
+ linear_gradient(surface, rect, start_color, end_color, start_pos=None, end_pos=None) -> Rect
+fill a rectangle with a linear gradient
+
+pygame.draw.radial_gradient
+ radial_gradient(surface, center, radius, inner_color, outer_color) -> Rect
+fill a circle with a radial gradient
+
+pygame.draw.textured_polygon
+ textured_polygon(surface, points, texture, offset=(0, 0)) -> Rect
+fill a polygon with a texture
+
+pygame.draw.Curve
+ Curve(points, tolerance=0.25) -> Curve
+a Bezier spline flattened once for repeated drawing
+
+pygame.draw.Curve.stroke
+ stroke(surface, color, width=1, join='miter', cap='butt') -> Rect
+draw an antialiased stroke along the curve
+
+pygame.draw.Curve.fill
+ fill(surface, color) -> Rect
+draw the area enclosed by the curve
+
+pygame.draw.Curve.control_points
+ control_points -> tuple
+the control points the curve was made from
+
+pygame.draw.Curve.tolerance
+ tolerance -> float
+the largest distance of the lines from the curve
+
+*/
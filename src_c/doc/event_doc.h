@@ -2,14 +2,19 @@
 #define DOC_PYGAMEEVENT "pygame module for interacting with events and queues"
 #define DOC_PYGAMEEVENTPUMP "pump() -> None\ninternally process pygame event handlers"
 #define DOC_PYGAMEEVENTGET "get(eventtype=None) -> Eventlist\nget(eventtype=None, pump=True) -> Eventlist\nget(eventtype=None, pump=True, exclude=None) -> Eventlist\nget events from the queue"
+#define DOC_PYGAMEEVENTGETBUFFER "get_buffer(buffer, eventtype=None, pump=True) -> int\nget events from the queue into a buffer of records"
+#define DOC_PYGAMEEVENTBUFFERFIELDS "BUFFER_FIELDS -> tuple\nthe names of the fields of the records written by get_buffer"
 #define DOC_PYGAMEEVENTPOLL "poll() -> Event instance\nget a single event from the queue"
 #define DOC_PYGAMEEVENTWAIT "wait() -> Event instance\nwait(timeout) -> Event instance\nwait for a single event from the queue"
+#define DOC_PYGAMEEVENTWAKEUP "wakeup() -> None\nmake wait() return without an event"
 #define DOC_PYGAMEEVENTPEEK "peek(eventtype=None) -> bool\npeek(eventtype=None, pump=True) -> bool\ntest if event types are waiting on the queue"
 #define DOC_PYGAMEEVENTCLEAR "clear(eventtype=None) -> None\nclear(eventtype=None, pump=True) -> None\nremove all events from the queue"
 #define DOC_PYGAMEEVENTEVENTNAME "event_name(type) -> string\nget the string name from an event id"
 #define DOC_PYGAMEEVENTSETBLOCKED "set_blocked(type) -> None\nset_blocked(typelist) -> None\nset_blocked(None) -> None\ncontrol which events are allowed on the queue"
 #define DOC_PYGAMEEVENTSETALLOWED "set_allowed(type) -> None\nset_allowed(typelist) -> None\nset_allowed(None) -> None\ncontrol which events are allowed on the queue"
 #define DOC_PYGAMEEVENTGETBLOCKED "get_blocked(type) -> bool\nget_blocked(typelist) -> bool\ntest if a type of event is blocked from the queue"
+#define DOC_PYGAMEEVENTSETCOALESCE "set_coalesce(eventtype, coalesce=True) -> None\nmerge runs of motion events on the queue"
+#define DOC_PYGAMEEVENTGETCOALESCE "get_coalesce(eventtype) -> bool\ntest if motion events are merged on the queue"
 #define DOC_PYGAMEEVENTSETGRAB "set_grab(bool) -> None\ncontrol the sharing of input devices with other applications"
 #define DOC_PYGAMEEVENTGETGRAB "get_grab() -> bool\ntest if the program is sharing input devices"
 #define DOC_PYGAMEEVENTPOST "post(Event) -> bool\nplace a new event on the queue"
@@ -36,6 +41,14 @@ pygame.event.get
  get(eventtype=None, pump=True, exclude=None) -> Eventlist
 get events from the queue
 
+pygame.event.get_buffer
+ get_buffer(buffer, eventtype=None, pump=True) -> int
+get events from the queue into a buffer of records
+
+pygame.event.BUFFER_FIELDS
+ BUFFER_FIELDS -> tuple
+the names of the fields of the records written by get_buffer
+
 pygame.event.poll
  poll() -> Event instance
 get a single event from the queue
@@ -45,6 +58,10 @@ pygame.event.wait
  wait(timeout) -> Event instance
 wait for a single event from the queue
 
+pygame.event.wakeup
+ wakeup() -> None
+make wait() return without an event
+
 pygame.event.peek
  peek(eventtype=None) -> bool
  peek(eventtype=None, pump=True) -> bool
@@ -76,6 +93,14 @@ pygame.event.get_blocked
  get_blocked(typelist) -> bool
 test if a type of event is blocked from the queue
 
+pygame.event.set_coalesce
+ set_coalesce(eventtype, coalesce=True) -> None
+merge runs of motion events on the queue
+
+pygame.event.get_coalesce
+ get_coalesce(eventtype) -> bool
+test if motion events are merged on the queue
+
 pygame.event.set_grab
  set_grab(bool) -> None
 control the sharing of input devices with other applications
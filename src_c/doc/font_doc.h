@@ -13,8 +13,10 @@
 #define DOC_FONTITALIC "italic -> bool\nGets or sets whether the font should be rendered in (faked) italics."
 #define DOC_FONTUNDERLINE "underline -> bool\nGets or sets whether the font should be rendered with an underline."
 #define DOC_FONTSTRIKETHROUGH "strikethrough -> bool\nGets or sets whether the font should be rendered with a strikethrough."
-#define DOC_FONTRENDER "render(text, antialias, color, background=None) -> Surface\ndraw text on a new Surface"
+#define DOC_FONTRENDERCACHELIMIT "render_cache_limit -> int\nByte limit of the rendered text cache"
+#define DOC_FONTRENDER "render(text, antialias, color, background=None, wraplength=0, align=FONT_LEFT) -> Surface\ndraw text on a new Surface"
 #define DOC_FONTSIZE "size(text) -> (width, height)\ndetermine the amount of space needed to render text"
+#define DOC_FONTGETRENDERCACHESTATS "get_render_cache_stats() -> dict\nreturn the rendered text cache counters"
 #define DOC_FONTSETUNDERLINE "set_underline(bool) -> None\ncontrol if text is rendered with an underline"
 #define DOC_FONTGETUNDERLINE "get_underline() -> bool\ncheck if text will be rendered with an underline"
 #define DOC_FONTSETSTRIKETHROUGH "set_strikethrough(bool) -> None\ncontrol if text is rendered with a strikethrough"
@@ -91,14 +93,22 @@ pygame.font.Font.strikethrough
  strikethrough -> bool
 Gets or sets whether the font should be rendered with a strikethrough.
 
+pygame.font.Font.render_cache_limit
+ render_cache_limit -> int
+Byte limit of the rendered text cache
+
 pygame.font.Font.render
- render(text, antialias, color, background=None) -> Surface
+ render(text, antialias, color, background=None, wraplength=0, align=FONT_LEFT) -> Surface
 draw text on a new Surface
 
 pygame.font.Font.size
  size(text) -> (width, height)
 determine the amount of space needed to render text
 
+pygame.font.Font.get_render_cache_stats
+ get_render_cache_stats() -> dict
+return the rendered text cache counters
+
 pygame.font.Font.set_underline
  set_underline(bool) -> None
 control if text is rendered with an underline
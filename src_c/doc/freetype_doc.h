@@ -15,7 +15,7 @@
 #define DOC_FONTNAME "name -> string\nProper font name."
 #define DOC_FONTPATH "path -> unicode\nFont file path"
 #define DOC_FONTSIZE "size -> float\nsize -> (float, float)\nThe default point size used in rendering"
-#define DOC_FONTGETRECT "get_rect(text, style=STYLE_DEFAULT, rotation=0, size=0) -> rect\nReturn the size and offset of rendered text"
+#define DOC_FONTGETRECT "get_rect(text, style=STYLE_DEFAULT, rotation=0, size=0, wraplength=0, align=FONT_LEFT) -> rect\nReturn the size and offset of rendered text"
 #define DOC_FONTGETMETRICS "get_metrics(text, size=0) -> [(...), ...]\nReturn the glyph metrics for the given text"
 #define DOC_FONTHEIGHT "height -> int\nThe unscaled height of the font in font units"
 #define DOC_FONTASCENDER "ascender -> int\nThe unscaled ascent of the font in font units"
@@ -25,8 +25,11 @@
 #define DOC_FONTGETSIZEDHEIGHT "get_sized_height(<size>=0) -> int\nThe scaled height of the font in pixels"
 #define DOC_FONTGETSIZEDGLYPHHEIGHT "get_sized_glyph_height(<size>=0) -> int\nThe scaled bounding box height of the font in pixels"
 #define DOC_FONTGETSIZES "get_sizes() -> [(int, int, int, float, float), ...]\nget_sizes() -> []\nreturn the available sizes of embedded bitmaps"
-#define DOC_FONTRENDER "render(text, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0) -> (Surface, Rect)\nReturn rendered text as a surface"
-#define DOC_FONTRENDERTO "render_to(surf, dest, text, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0) -> Rect\nRender text onto an existing surface"
+#define DOC_FONTGETCACHESTATS "get_cache_stats() -> dict\nreturn the glyph cache counters"
+#define DOC_FONTSHARECACHE "share_cache(font) -> None\nuse the glyph cache of another font"
+#define DOC_FONTGETRENDERCACHESTATS "get_render_cache_stats() -> dict\nreturn the rendered text cache counters"
+#define DOC_FONTRENDER "render(text, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0, pool=None, wraplength=0, align=FONT_LEFT) -> (Surface, Rect)\nReturn rendered text as a surface"
+#define DOC_FONTRENDERTO "render_to(surf, dest, text, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0, wraplength=0, align=FONT_LEFT) -> Rect\nRender text onto an existing surface"
 #define DOC_FONTRENDERRAW "render_raw(text, style=STYLE_DEFAULT, rotation=0, size=0, invert=False) -> (bytes, (int, int))\nReturn rendered text as a string of bytes"
 #define DOC_FONTRENDERRAWTO "render_raw_to(array, text, dest=None, style=STYLE_DEFAULT, rotation=0, size=0, invert=False) -> Rect\nRender text into an array of ints"
 #define DOC_FONTSTYLE "style -> int\nThe font's style flags"
@@ -50,6 +53,23 @@
 #define DOC_FONTPAD "pad -> bool\npadded boundary mode"
 #define DOC_FONTUCS4 "ucs4 -> bool\nEnable UCS-4 mode"
 #define DOC_FONTRESOLUTION "resolution -> int\nPixel resolution in dots per inch"
+#define DOC_FONTCACHELIMIT "cache_limit -> int\nByte limit of the glyph cache"
+#define DOC_FONTRENDERCACHELIMIT "render_cache_limit -> int\nByte limit of the rendered text cache"
+#define DOC_PYGAMEFREETYPEGLYPHATLAS "GlyphAtlas(font, fgcolor, size=0, page_size=(512, 512)) -> GlyphAtlas\npygame object for drawing text from glyphs kept in an Atlas"
+#define DOC_GLYPHATLASATLAS "atlas -> Atlas\nthe Atlas holding the glyphs"
+#define DOC_GLYPHATLASADD "add(text) -> None\nrender the characters of a text into the atlas"
+#define DOC_GLYPHATLASLAYOUT "layout(text, dest=(0, 0)) -> [(Surface, Rect), ...]\nfind where the glyphs of a text go"
+#define DOC_GLYPHATLASRENDERTO "render_to(surf, dest, text) -> Rect\ndraw text onto a surface"
+#define DOC_GLYPHATLASDRAW "draw(textures, text, dest=(0, 0)) -> None\ndraw text with the textures of the atlas pages"
+#define DOC_PYGAMEFREETYPETEXTLAYOUT "TextLayout(font, text, style=STYLE_DEFAULT, rotation=None, size=0) -> TextLayout\npygame object for a text laid out once and drawn many times"
+#define DOC_TEXTLAYOUTFONT "font -> Font\nthe Font the text was laid out with"
+#define DOC_TEXTLAYOUTTEXT "text -> str\nthe text laid out"
+#define DOC_TEXTLAYOUTGETRECT "get_rect() -> rect\nreturn the size and offset of the text"
+#define DOC_TEXTLAYOUTGETMETRICS "get_metrics() -> metrics\nreturn the glyph metrics of the text"
+#define DOC_TEXTLAYOUTRENDER "render(fgcolor=None, bgcolor=None) -> (Surface, Rect)\nreturn the text rendered as a surface"
+#define DOC_TEXTLAYOUTRENDERTO "render_to(surf, dest, fgcolor=None, bgcolor=None) -> Rect\nrender the text onto an existing surface"
+#define DOC_TEXTLAYOUTGETCARETPOSITIONS "get_caret_positions() -> list\nreturn the positions between the characters"
+#define DOC_TEXTLAYOUTINDEXAT "index_at(pos) -> int\nreturn the index of the character at a position"
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -123,7 +143,7 @@ pygame.freetype.Font.size
 The default point size used in rendering
 
 pygame.freetype.Font.get_rect
- get_rect(text, style=STYLE_DEFAULT, rotation=0, size=0) -> rect
+ get_rect(text, style=STYLE_DEFAULT, rotation=0, size=0, wraplength=0, align=FONT_LEFT) -> rect
 Return the size and offset of rendered text
 
 pygame.freetype.Font.get_metrics
@@ -163,12 +183,24 @@ pygame.freetype.Font.get_sizes
  get_sizes() -> []
 return the available sizes of embedded bitmaps
 
+pygame.freetype.Font.get_cache_stats
+ get_cache_stats() -> dict
+return the glyph cache counters
+
+pygame.freetype.Font.share_cache
+ share_cache(font) -> None
+use the glyph cache of another font
+
+pygame.freetype.Font.get_render_cache_stats
+ get_render_cache_stats() -> dict
+return the rendered text cache counters
+
 pygame.freetype.Font.render
- render(text, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0) -> (Surface, Rect)
+ render(text, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0, pool=None, wraplength=0, align=FONT_LEFT) -> (Surface, Rect)
 Return rendered text as a surface
 
 pygame.freetype.Font.render_to
- render_to(surf, dest, text, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0) -> Rect
+ render_to(surf, dest, text, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0, wraplength=0, align=FONT_LEFT) -> Rect
 Render text onto an existing surface
 
 pygame.freetype.Font.render_raw
@@ -263,4 +295,72 @@ pygame.freetype.Font.resolution
  resolution -> int
 Pixel resolution in dots per inch
 
+pygame.freetype.Font.cache_limit
+ cache_limit -> int
+Byte limit of the glyph cache
+
+pygame.freetype.Font.render_cache_limit
+ render_cache_limit -> int
+Byte limit of the rendered text cache
+
+pygame.freetype.GlyphAtlas
+ GlyphAtlas(font, fgcolor, size=0, page_size=(512, 512)) -> GlyphAtlas
+pygame object for drawing text from glyphs kept in an Atlas
+
+pygame.freetype.GlyphAtlas.atlas
+ atlas -> Atlas
+the Atlas holding the glyphs
+
+pygame.freetype.GlyphAtlas.add
+ add(text) -> None
+render the characters of a text into the atlas
+
+pygame.freetype.GlyphAtlas.layout
+ layout(text, dest=(0, 0)) -> [(Surface, Rect), ...]
+find where the glyphs of a text go
+
+pygame.freetype.GlyphAtlas.render_to
+ render_to(surf, dest, text) -> Rect
+draw text onto a surface
+
+pygame.freetype.GlyphAtlas.draw
+ draw(textures, text, dest=(0, 0)) -> None
+draw text with the textures of the atlas pages
+
+pygame.freetype.TextLayout
+ TextLayout(font, text, style=STYLE_DEFAULT, rotation=None, size=0) -> TextLayout
+pygame object for a text laid out once and drawn many times
+
+pygame.freetype.TextLayout.font
+ font -> Font
+the Font the text was laid out with
+
+pygame.freetype.TextLayout.text
+ text -> str
+the text laid out
+
+pygame.freetype.TextLayout.get_rect
+ get_rect() -> rect
+return the size and offset of the text
+
+pygame.freetype.TextLayout.get_metrics
+ get_metrics() -> metrics
+return the glyph metrics of the text
+
+pygame.freetype.TextLayout.render
+ render(fgcolor=None, bgcolor=None) -> (Surface, Rect)
+return the text rendered as a surface
+
+pygame.freetype.TextLayout.render_to
+ render_to(surf, dest, fgcolor=None, bgcolor=None) -> Rect
+render the text onto an existing surface
+
+pygame.freetype.TextLayout.get_caret_positions
+ get_caret_positions() -> list
+return the positions between the characters
+
+pygame.freetype.TextLayout.index_at
+ index_at(pos) -> int
+return the index of the character at a position
+
 */
\ No newline at end of file
@@ -1,12 +1,22 @@
 /* Auto generated file: with makeref.py .  Docs go in docs/reST/ref/ . */
 #define DOC_PYGAMEIMAGE "pygame module for image transfer"
 #define DOC_PYGAMEIMAGELOAD "load(filename) -> Surface\nload(fileobj, namehint="") -> Surface\nload new image from a file (or file-like object)"
-#define DOC_PYGAMEIMAGESAVE "save(Surface, filename) -> None\nsave(Surface, fileobj, namehint="") -> None\nsave an image to file (or file-like object)"
+#define DOC_PYGAMEIMAGELOADMANY "load_many(files, convert=False, alpha=False) -> list\nload many images from files (or file-like objects) at once"
+#define DOC_PYGAMEIMAGELOADREGION "load_region(filename, rect) -> Surface\nload_region(fileobj, rect, namehint="") -> Surface\nload part of an image from a file (or file-like object)"
+#define DOC_PYGAMEIMAGEITERBANDS "iter_bands(filename, band_height=64) -> iterator\niter_bands(fileobj, band_height=64, namehint="") -> iterator\nload an image a band of rows at a time"
+#define DOC_PYGAMEIMAGESAVE "save(Surface, filename, compression=-1, filter=None) -> None\nsave(Surface, fileobj, namehint="", compression=-1, filter=None) -> None\nsave an image to file (or file-like object)"
+#define DOC_PYGAMEIMAGESAVEASYNC "save_async(Surface, filename, namehint="", compression=-1, filter=None) -> None\nsave an image to file on a background thread"
+#define DOC_PYGAMEIMAGEWAITSAVES "wait_saves() -> None\nwait for the images queued by save_async() to be written"
+#define DOC_PYGAMEIMAGELOADRAW "load_raw(filename) -> Surface\nload_raw(fileobj) -> Surface\nload an image saved with save_raw() without decoding it"
+#define DOC_PYGAMEIMAGESAVERAW "save_raw(Surface, filename) -> None\nsave_raw(Surface, fileobj) -> None\nsave the pixels of a Surface for load_raw()"
+#define DOC_PYGAMEIMAGERAWSIZE "raw_size(Surface) -> int\nget the bytes a raw image of a Surface takes"
+#define DOC_PYGAMEIMAGETOBUFFERRAW "tobuffer_raw(Surface, buffer) -> None\nwrite a raw image of a Surface into a buffer"
+#define DOC_PYGAMEIMAGEFROMBUFFERRAW "frombuffer_raw(buffer) -> Surface\ncreate a new Surface over a raw image in a buffer"
 #define DOC_PYGAMEIMAGEGETSDLIMAGEVERSION "get_sdl_image_version() -> None\nget_sdl_image_version() -> (major, minor, patch)\nget version number of the SDL_Image library being used"
 #define DOC_PYGAMEIMAGEGETEXTENDED "get_extended() -> bool\ntest if extended image formats can be loaded"
 #define DOC_PYGAMEIMAGETOSTRING "tostring(Surface, format, flipped=False) -> bytes\ntransfer image to string buffer"
 #define DOC_PYGAMEIMAGEFROMSTRING "fromstring(bytes, size, format, flipped=False) -> Surface\ncreate new Surface from a string buffer"
-#define DOC_PYGAMEIMAGEFROMBUFFER "frombuffer(buffer, size, format) -> Surface\ncreate a new Surface that shares data inside a bytes buffer"
+#define DOC_PYGAMEIMAGEFROMBUFFER "frombuffer(buffer, size, format) -> Surface\nfrombuffer(buffer, size, format, pitch) -> Surface\ncreate a new Surface that shares data inside a bytes buffer"
 #define DOC_PYGAMEIMAGELOADBASIC "load_basic(file) -> Surface\nload new BMP image from a file (or file-like object)"
 #define DOC_PYGAMEIMAGELOADEXTENDED "load_extended(filename) -> Surface\nload_extended(fileobj, namehint="") -> Surface\nload an image from a file (or file-like object)"
 #define DOC_PYGAMEIMAGESAVEEXTENDED "save_extended(Surface, filename) -> None\nsave_extended(Surface, fileobj, namehint="") -> None\nsave a png/jpg image to file (or file-like object)"
@@ -24,11 +34,55 @@ pygame.image.load
  load(fileobj, namehint="") -> Surface
 load new image from a file (or file-like object)
 
+pygame.image.load_many
+ load_many(files, convert=False, alpha=False) -> list
+load many images from files (or file-like objects) at once
+
+pygame.image.load_region
+ load_region(filename, rect) -> Surface
+ load_region(fileobj, rect, namehint="") -> Surface
+load part of an image from a file (or file-like object)
+
+pygame.image.iter_bands
+ iter_bands(filename, band_height=64) -> iterator
+ iter_bands(fileobj, band_height=64, namehint="") -> iterator
+load an image a band of rows at a time
+
 pygame.image.save
- save(Surface, filename) -> None
- save(Surface, fileobj, namehint="") -> None
+ save(Surface, filename, compression=-1, filter=None) -> None
+ save(Surface, fileobj, namehint="", compression=-1, filter=None) -> None
 save an image to file (or file-like object)
 
+pygame.image.save_async
+ save_async(Surface, filename, namehint="", compression=-1, filter=None) -> None
+save an image to file on a background thread
+
+pygame.image.wait_saves
+ wait_saves() -> None
+wait for the images queued by save_async() to be written
+
+pygame.image.load_raw
+ load_raw(filename) -> Surface
+ load_raw(fileobj) -> Surface
+load an image saved with save_raw() without decoding it
+
+pygame.image.save_raw
+ save_raw(Surface, filename) -> None
+ save_raw(Surface, fileobj) -> None
+save the pixels of a Surface for load_raw()
+
+pygame.image.raw_size
+ raw_size(Surface) -> int
+get the bytes a raw image of a Surface takes
+
+pygame.image.tobuffer_raw
+ tobuffer_raw(Surface, buffer) -> None
+write a raw image of a Surface into a buffer
+
+pygame.image.frombuffer_raw
+ frombuffer_raw(buffer) -> Surface
+create a new Surface over a raw image in a buffer
+
 pygame.image.get_sdl_image_version
  get_sdl_image_version() -> None
  get_sdl_image_version() -> (major, minor, patch)
@@ -48,6 +102,7 @@ create new Surface from a string buffer
 
 pygame.image.frombuffer
  frombuffer(buffer, size, format) -> Surface
+ frombuffer(buffer, size, format, pitch) -> Surface
 create a new Surface that shares data inside a bytes buffer
 
 pygame.image.load_basic
@@ -21,6 +21,7 @@
 #define DOC_JOYSTICKGETBUTTON "get_button(button) -> bool\nget the current button state"
 #define DOC_JOYSTICKGETNUMHATS "get_numhats() -> int\nget the number of hat controls on a Joystick"
 #define DOC_JOYSTICKGETHAT "get_hat(hat_number) -> x, y\nget the position of a joystick hat"
+#define DOC_JOYSTICKGETSTATE "get_state(out=None) -> array\nget the state of all axes, buttons, hats and sensors at once"
 #define DOC_JOYSTICKRUMBLE "rumble(low_frequency, high_frequency, duration) -> bool\nStart a rumbling effect"
 #define DOC_JOYSTICKSTOPRUMBLE "stop_rumble() -> None\nStop any rumble effect playing"
 
@@ -116,6 +117,10 @@ pygame.joystick.Joystick.get_hat
  get_hat(hat_number) -> x, y
 get the position of a joystick hat
 
+pygame.joystick.Joystick.get_state
+ get_state(out=None) -> array
+get the state of all axes, buttons, hats and sensors at once
+
 pygame.joystick.Joystick.rumble
  rumble(low_frequency, high_frequency, duration) -> bool
 Start a rumbling effect
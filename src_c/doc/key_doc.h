@@ -2,6 +2,7 @@
 #define DOC_PYGAMEKEY "pygame module to work with the keyboard"
 #define DOC_PYGAMEKEYGETFOCUSED "get_focused() -> bool\ntrue if the display is receiving keyboard input from the system"
 #define DOC_PYGAMEKEYGETPRESSED "get_pressed() -> bools\nget the state of all keyboard buttons"
+#define DOC_PYGAMEKEYGETPRESSEDBUFFER "get_pressed_buffer(out=None, changed=None) -> buffer\ncopy the state of all keyboard buttons into a buffer"
 #define DOC_PYGAMEKEYGETMODS "get_mods() -> int\ndetermine which modifier keys are being held"
 #define DOC_PYGAMEKEYSETMODS "set_mods(int) -> None\ntemporarily set which modifier keys are pressed"
 #define DOC_PYGAMEKEYSETREPEAT "set_repeat() -> None\nset_repeat(delay) -> None\nset_repeat(delay, interval) -> None\ncontrol how held keys are repeated"
@@ -28,6 +29,10 @@ pygame.key.get_pressed
  get_pressed() -> bools
 get the state of all keyboard buttons
 
+pygame.key.get_pressed_buffer
+ get_pressed_buffer(out=None, changed=None) -> buffer
+copy the state of all keyboard buttons into a buffer
+
 pygame.key.get_mods
  get_mods() -> int
 determine which modifier keys are being held
@@ -2,6 +2,7 @@
 #define DOC_PYGAMEMASK "pygame module for image masks."
 #define DOC_PYGAMEMASKFROMSURFACE "from_surface(surface) -> Mask\nfrom_surface(surface, threshold=127) -> Mask\nCreates a Mask from the given surface"
 #define DOC_PYGAMEMASKFROMTHRESHOLD "from_threshold(surface, color) -> Mask\nfrom_threshold(surface, color, threshold=(0, 0, 0, 255), othersurface=None, palette_colors=1) -> Mask\nCreates a mask by thresholding Surfaces"
+#define DOC_PYGAMEMASKCOLLIDEMANY "collide_many(masks, positions, other_masks, other_positions) -> list\nFinds the colliding pairs between two groups of masks"
 #define DOC_PYGAMEMASKMASK "Mask(size=(width, height)) -> Mask\nMask(size=(width, height), fill=False) -> Mask\npygame object for representing 2D bitmasks"
 #define DOC_MASKCOPY "copy() -> Mask\nReturns a new copy of the mask"
 #define DOC_MASKGETSIZE "get_size() -> (width, height)\nReturns the size of the mask"
@@ -22,6 +23,9 @@
 #define DOC_MASKANGLE "angle() -> theta\nReturns the orientation of the set bits"
 #define DOC_MASKOUTLINE "outline() -> [(x, y), ...]\noutline(every=1) -> [(x, y), ...]\nReturns a list of points outlining an object"
 #define DOC_MASKCONVOLVE "convolve(other) -> Mask\nconvolve(other, output=None, offset=(0, 0)) -> Mask\nReturns the convolution of this mask with another mask"
+#define DOC_MASKDILATE "dilate(n) -> None\nGrows the set bits of this mask"
+#define DOC_MASKERODE "erode(n) -> None\nShrinks the set bits of this mask"
+#define DOC_MASKDISTANCETRANSFORM "distance_transform() -> BufferProxy\nReturns the distance from each bit to the nearest set bit"
 #define DOC_MASKCONNECTEDCOMPONENT "connected_component() -> Mask\nconnected_component(pos) -> Mask\nReturns a mask containing a connected component"
 #define DOC_MASKCONNECTEDCOMPONENTS "connected_components() -> [Mask, ...]\nconnected_components(minimum=0) -> [Mask, ...]\nReturns a list of masks of connected components"
 #define DOC_MASKGETBOUNDINGRECTS "get_bounding_rects() -> [Rect, ...]\nReturns a list of bounding rects of connected components"
@@ -45,6 +49,10 @@ pygame.mask.from_threshold
  from_threshold(surface, color, threshold=(0, 0, 0, 255), othersurface=None, palette_colors=1) -> Mask
 Creates a mask by thresholding Surfaces
 
+pygame.mask.collide_many
+ collide_many(masks, positions, other_masks, other_positions) -> list
+Finds the colliding pairs between two groups of masks
+
 pygame.mask.Mask
  Mask(size=(width, height)) -> Mask
  Mask(size=(width, height), fill=False) -> Mask
@@ -130,6 +138,18 @@ pygame.mask.Mask.convolve
  convolve(other, output=None, offset=(0, 0)) -> Mask
 Returns the convolution of this mask with another mask
 
+pygame.mask.Mask.dilate
+ dilate(n) -> None
+Grows the set bits of this mask
+
+pygame.mask.Mask.erode
+ erode(n) -> None
+Shrinks the set bits of this mask
+
+pygame.mask.Mask.distance_transform
+ distance_transform() -> BufferProxy
+Returns the distance from each bit to the nearest set bit
+
 pygame.mask.Mask.connected_component
  connected_component() -> Mask
  connected_component(pos) -> Mask
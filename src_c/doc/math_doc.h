@@ -81,7 +81,34 @@
 #define DOC_VECTOR3CLAMPMAGNITUDE "clamp_magnitude(max_length) -> Vector3\nclamp_magnitude(min_length, max_length) -> Vector3\nReturns a copy of a vector with the magnitude clamped between max_length and min_length."
 #define DOC_VECTOR3CLAMPMAGNITUDEIP "clamp_magnitude_ip(max_length) -> None\nclamp_magnitude_ip(min_length, max_length) -> None\nClamps the vector's magnitude between max_length and min_length"
 #define DOC_VECTOR3UPDATE "update() -> None\nupdate(int) -> None\nupdate(float) -> None\nupdate(Vector3) -> None\nupdate(x, y, z) -> None\nupdate((x, y, z)) -> None\nSets the coordinates of the vector."
-
+#define DOC_PYGAMEMATHVECTOR2ARRAY "Vector2Array(vectors=()) -> Vector2Array\nVector2Array(length) -> Vector2Array\npygame object for storing many 2-Dimensional vectors together"
+#define DOC_VECTOR2ARRAYAPPEND "append(Vector2) -> None\nadds a vector to the end of the array"
+#define DOC_VECTOR2ARRAYCOPY "copy() -> Vector2Array\nreturns a copy of the array"
+#define DOC_VECTOR2ARRAYDOT "dot(Vector2) -> [float, ...]\ndot(Vector2Array) -> [float, ...]\ncalculates the dot products of all the vectors"
+#define DOC_VECTOR2ARRAYDISTANCETO "distance_to(Vector2) -> [float, ...]\ndistance_to(Vector2Array) -> [float, ...]\ncalculates the distances of all the vectors"
+#define DOC_VECTOR2ARRAYNORMALIZEIP "normalize_ip() -> None\nnormalizes all the vectors in place"
+#define DOC_VECTOR2ARRAYROTATEIP "rotate_ip(angle) -> None\nrotates all the vectors by an angle in degrees in place"
+#define DOC_VECTOR2ARRAYLERP "lerp(Vector2, float) -> Vector2Array\nlerp(Vector2Array, float) -> Vector2Array\nreturns the linear interpolations of all the vectors"
+#define DOC_VECTOR2ARRAYCLAMPMAGNITUDEIP "clamp_magnitude_ip(max_length) -> None\nclamp_magnitude_ip(min_length, max_length) -> None\nclamps the magnitudes of all the vectors in place"
+#define DOC_PYGAMEMATHVECTOR3ARRAY "Vector3Array(vectors=()) -> Vector3Array\nVector3Array(length) -> Vector3Array\npygame object for storing many 3-Dimensional vectors together"
+#define DOC_VECTOR3ARRAYAPPEND "append(Vector3) -> None\nadds a vector to the end of the array"
+#define DOC_VECTOR3ARRAYCOPY "copy() -> Vector3Array\nreturns a copy of the array"
+#define DOC_VECTOR3ARRAYDOT "dot(Vector3) -> [float, ...]\ndot(Vector3Array) -> [float, ...]\ncalculates the dot products of all the vectors"
+#define DOC_VECTOR3ARRAYDISTANCETO "distance_to(Vector3) -> [float, ...]\ndistance_to(Vector3Array) -> [float, ...]\ncalculates the distances of all the vectors"
+#define DOC_VECTOR3ARRAYNORMALIZEIP "normalize_ip() -> None\nnormalizes all the vectors in place"
+#define DOC_VECTOR3ARRAYROTATEIP "rotate_ip(angle, Vector3) -> None\nrotates all the vectors by an angle in degrees in place"
+#define DOC_VECTOR3ARRAYLERP "lerp(Vector3, float) -> Vector3Array\nlerp(Vector3Array, float) -> Vector3Array\nreturns the linear interpolations of all the vectors"
+#define DOC_VECTOR3ARRAYCLAMPMAGNITUDEIP "clamp_magnitude_ip(max_length) -> None\nclamp_magnitude_ip(min_length, max_length) -> None\nclamps the magnitudes of all the vectors in place"
+#define DOC_PYGAMEMATHAFFINE2 "Affine2() -> Affine2\nAffine2(a, b, c, d, e, f) -> Affine2\nAffine2((a, b, c, d, e, f)) -> Affine2\na 2-Dimensional affine transform"
+#define DOC_AFFINE2IDENTITY "identity() -> Affine2\nreturns the identity transform"
+#define DOC_AFFINE2TRANSLATION "translation(x, y) -> Affine2\ntranslation((x, y)) -> Affine2\nreturns a transform moving points"
+#define DOC_AFFINE2ROTATION "rotation(angle) -> Affine2\nreturns a transform rotating points by an angle in degrees"
+#define DOC_AFFINE2SCALE "scale(factor) -> Affine2\nscale(x, y) -> Affine2\nscale((x, y)) -> Affine2\nreturns a transform scaling points"
+#define DOC_AFFINE2SHEAR "shear(x, y) -> Affine2\nshear((x, y)) -> Affine2\nreturns a transform shearing points"
+#define DOC_AFFINE2INVERSE "inverse() -> Affine2\nreturns the inverse transform"
+#define DOC_AFFINE2TRANSFORMPOINTS "transform_points(Vector2Array) -> Vector2Array\ntransform_points(points) -> Vector2Array\ntransforms many points at once"
+#define DOC_PYGAMEMATHNOISE2D "noise2d(dest, scale, offset=(0, 0), octaves=1, persistence=0.5, lacunarity=2.0, seed=0) -> None\nfills a 2D buffer with gradient noise"
+#define DOC_PYGAMEMATHNOISE3D "noise3d(dest, scale, z, offset=(0, 0), octaves=1, persistence=0.5, lacunarity=2.0, seed=0) -> None\nfills a 2D buffer with a slice of 3D gradient noise"
 
 /* Docs in a comment... slightly easier to read. */
 
@@ -438,4 +465,133 @@ pygame.math.Vector3.update
  update((x, y, z)) -> None
 Sets the coordinates of the vector.
 
+pygame.math.Vector2Array
+ Vector2Array(vectors=()) -> Vector2Array
+ Vector2Array(length) -> Vector2Array
+pygame object for storing many 2-Dimensional vectors together
+
+pygame.math.Vector2Array.append
+ append(Vector2) -> None
+adds a vector to the end of the array
+
+pygame.math.Vector2Array.copy
+ copy() -> Vector2Array
+returns a copy of the array
+
+pygame.math.Vector2Array.dot
+ dot(Vector2) -> [float, ...]
+ dot(Vector2Array) -> [float, ...]
+calculates the dot products of all the vectors
+
+pygame.math.Vector2Array.distance_to
+ distance_to(Vector2) -> [float, ...]
+ distance_to(Vector2Array) -> [float, ...]
+calculates the distances of all the vectors
+
+pygame.math.Vector2Array.normalize_ip
+ normalize_ip() -> None
+normalizes all the vectors in place
+
+pygame.math.Vector2Array.rotate_ip
+ rotate_ip(angle) -> None
+rotates all the vectors by an angle in degrees in place
+
+pygame.math.Vector2Array.lerp
+ lerp(Vector2, float) -> Vector2Array
+ lerp(Vector2Array, float) -> Vector2Array
+returns the linear interpolations of all the vectors
+
+pygame.math.Vector2Array.clamp_magnitude_ip
+ clamp_magnitude_ip(max_length) -> None
+ clamp_magnitude_ip(min_length, max_length) -> None
+clamps the magnitudes of all the vectors in place
+
+pygame.math.Vector3Array
+ Vector3Array(vectors=()) -> Vector3Array
+ Vector3Array(length) -> Vector3Array
+pygame object for storing many 3-Dimensional vectors together
+
+pygame.math.Vector3Array.append
+ append(Vector3) -> None
+adds a vector to the end of the array
+
+pygame.math.Vector3Array.copy
+ copy() -> Vector3Array
+returns a copy of the array
+
+pygame.math.Vector3Array.dot
+ dot(Vector3) -> [float, ...]
+ dot(Vector3Array) -> [float, ...]
+calculates the dot products of all the vectors
+
+pygame.math.Vector3Array.distance_to
+ distance_to(Vector3) -> [float, ...]
+ distance_to(Vector3Array) -> [float, ...]
+calculates the distances of all the vectors
+
+pygame.math.Vector3Array.normalize_ip
+ normalize_ip() -> None
+normalizes all the vectors in place
+
+pygame.math.Vector3Array.rotate_ip
+ rotate_ip(angle, Vector3) -> None
+rotates all the vectors by an angle in degrees in place
+
+pygame.math.Vector3Array.lerp
+ lerp(Vector3, float) -> Vector3Array
+ lerp(Vector3Array, float) -> Vector3Array
+returns the linear interpolations of all the vectors
+
+pygame.math.Vector3Array.clamp_magnitude_ip
+ clamp_magnitude_ip(max_length) -> None
+ clamp_magnitude_ip(min_length, max_length) -> None
+clamps the magnitudes of all the vectors in place
+
+pygame.math.Affine2
+ Affine2() -> Affine2
+ Affine2(a, b, c, d, e, f) -> Affine2
+ Affine2((a, b, c, d, e, f)) -> Affine2
+a 2-Dimensional affine transform
+
+pygame.math.Affine2.identity
+ identity() -> Affine2
+returns the identity transform
+
+pygame.math.Affine2.translation
+ translation(x, y) -> Affine2
+ translation((x, y)) -> Affine2
+returns a transform moving points
+
+pygame.math.Affine2.rotation
+ rotation(angle) -> Affine2
+returns a transform rotating points by an angle in degrees
+
+pygame.math.Affine2.scale
+ scale(factor) -> Affine2
+ scale(x, y) -> Affine2
+ scale((x, y)) -> Affine2
+returns a transform scaling points
+
+pygame.math.Affine2.shear
+ shear(x, y) -> Affine2
+ shear((x, y)) -> Affine2
+returns a transform shearing points
+
+pygame.math.Affine2.inverse
+ inverse() -> Affine2
+returns the inverse transform
+
+pygame.math.Affine2.transform_points
+ transform_points(Vector2Array) -> Vector2Array
+ transform_points(points) -> Vector2Array
+transforms many points at once
+
+pygame.math.noise2d
+ noise2d(dest, scale, offset=(0, 0), octaves=1, persistence=0.5, lacunarity=2.0, seed=0) -> None
+fills a 2D buffer with gradient noise
+
+pygame.math.noise3d
+ noise3d(dest, scale, z, offset=(0, 0), octaves=1, persistence=0.5, lacunarity=2.0, seed=0) -> None
+fills a 2D buffer with a slice of 3D gradient noise
+
 */
\ No newline at end of file
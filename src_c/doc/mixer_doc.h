@@ -10,11 +10,18 @@
 #define DOC_PYGAMEMIXERFADEOUT "fadeout(time) -> None\nfade out the volume on all sounds before stopping"
 #define DOC_PYGAMEMIXERSETNUMCHANNELS "set_num_channels(count) -> None\nset the total number of playback channels"
 #define DOC_PYGAMEMIXERGETNUMCHANNELS "get_num_channels() -> count\nget the total number of playback channels"
+#define DOC_PYGAMEMIXERGETSAMPLECLOCK "get_sample_clock() -> frames\nget the number of sample frames mixed"
 #define DOC_PYGAMEMIXERSETRESERVED "set_reserved(count) -> count\nreserve channels from being automatically used"
+#define DOC_PYGAMEMIXERSETNUMVOICES "set_num_voices(count) -> None\nset the size of the voice pool"
+#define DOC_PYGAMEMIXERGETNUMVOICES "get_num_voices() -> count\nget the size of the voice pool"
+#define DOC_PYGAMEMIXERPLAYVOICE "play_voice(sound, priority=0, volume=1.0, loops=0) -> voice\nplay a Sound on a voice from the pool"
+#define DOC_PYGAMEMIXERSTOPVOICES "stop_voices() -> None\nstop every voice"
+#define DOC_PYGAMEMIXERGETVOICESTATS "get_voice_stats() -> dict\nget counters for the voice pool"
 #define DOC_PYGAMEMIXERFINDCHANNEL "find_channel(force=False) -> Channel\nfind an unused channel"
 #define DOC_PYGAMEMIXERGETBUSY "get_busy() -> bool\ntest if any sound is being mixed"
 #define DOC_PYGAMEMIXERGETSDLMIXERVERSION "get_sdl_mixer_version() -> (major, minor, patch)\nget_sdl_mixer_version(linked=True) -> (major, minor, patch)\nget the mixer's SDL version"
-#define DOC_PYGAMEMIXERSOUND "Sound(filename) -> Sound\nSound(file=filename) -> Sound\nSound(file=pathlib_path) -> Sound\nSound(buffer) -> Sound\nSound(buffer=buffer) -> Sound\nSound(object) -> Sound\nSound(file=object) -> Sound\nSound(array=object) -> Sound\nCreate a new Sound object from a file or buffer object"
+#define DOC_PYGAMEMIXERLOADASYNC "load_async(file, event=0) -> SoundLoad\nload a Sound on a background thread"
+#define DOC_PYGAMEMIXERSOUND "Sound(filename) -> Sound\nSound(file=filename) -> Sound\nSound(file=pathlib_path) -> Sound\nSound(buffer) -> Sound\nSound(buffer=buffer) -> Sound\nSound(object) -> Sound\nSound(file=object) -> Sound\nSound(array=object) -> Sound\nSound(buffer=buffer, copy=False) -> Sound\nSound(array=object, copy=False) -> Sound\nCreate a new Sound object from a file or buffer object"
 #define DOC_SOUNDPLAY "play(loops=0, maxtime=0, fade_ms=0) -> Channel\nbegin sound playback"
 #define DOC_SOUNDSTOP "stop() -> None\nstop sound playback"
 #define DOC_SOUNDFADEOUT "fadeout(time) -> None\nstop sound playback after fading out"
@@ -25,18 +32,34 @@
 #define DOC_SOUNDGETRAW "get_raw() -> bytes\nreturn a bytestring copy of the Sound samples."
 #define DOC_PYGAMEMIXERCHANNEL "Channel(id) -> Channel\nCreate a Channel object for controlling playback"
 #define DOC_CHANNELPLAY "play(Sound, loops=0, maxtime=0, fade_ms=0) -> None\nplay a Sound on a specific Channel"
+#define DOC_CHANNELPLAYAT "play_at(Sound, time, loops=0) -> None\nplay a Sound on a Channel at an exact sample frame"
 #define DOC_CHANNELSTOP "stop() -> None\nstop playback on a Channel"
 #define DOC_CHANNELPAUSE "pause() -> None\ntemporarily stop playback of a channel"
 #define DOC_CHANNELUNPAUSE "unpause() -> None\nresume pause playback of a channel"
 #define DOC_CHANNELFADEOUT "fadeout(time) -> None\nstop playback after fading channel out"
 #define DOC_CHANNELSETVOLUME "set_volume(value) -> None\nset_volume(left, right) -> None\nset the volume of a playing channel"
 #define DOC_CHANNELGETVOLUME "get_volume() -> value\nget the volume of the playing channel"
+#define DOC_CHANNELSETFILTER "set_filter(type=None, frequency=1000.0, q=0.7071) -> None\nfilter the sound of a Channel"
+#define DOC_CHANNELSETREVERB "set_reverb(wet, room_size=0.5, damping=0.5) -> None\nadd reverberation to a Channel"
 #define DOC_CHANNELGETBUSY "get_busy() -> bool\ncheck if the channel is active"
 #define DOC_CHANNELGETSOUND "get_sound() -> Sound\nget the currently playing Sound"
 #define DOC_CHANNELQUEUE "queue(Sound) -> None\nqueue a Sound object to follow the current"
 #define DOC_CHANNELGETQUEUE "get_queue() -> Sound\nreturn any Sound that is queued"
 #define DOC_CHANNELSETENDEVENT "set_endevent() -> None\nset_endevent(type) -> None\nhave the channel send an event when playback stops"
 #define DOC_CHANNELGETENDEVENT "get_endevent() -> type\nget the event a channel sends when playback stops"
+#define DOC_PYGAMEMIXERSTREAM "Stream(size=0) -> Stream\nStream(size=0, file=path, loops=0) -> Stream\nCreate a Stream to play samples as they are generated"
+#define DOC_STREAMWRITE "write(buffer) -> int\nqueue samples for playback"
+#define DOC_STREAMPLAY "play() -> Channel\nbegin playing queued samples"
+#define DOC_STREAMSTOP "stop() -> None\nstop playback"
+#define DOC_STREAMGETBUSY "get_busy() -> bool\ncheck if the Stream is playing"
+#define DOC_STREAMGETQUEUED "get_queued() -> int\nget the number of bytes waiting to be played"
+#define DOC_STREAMGETFREE "get_free() -> int\nget the number of bytes that can be written"
+#define DOC_STREAMADVANCE "advance(frames) -> None\nqueue samples written in place"
+#define DOC_STREAMGETUNDERRUNS "get_underruns() -> int\nget the number of times the Stream ran out of samples"
+#define DOC_STREAMRESETUNDERRUNS "reset_underruns() -> None\nreset the underrun count"
+#define DOC_PYGAMEMIXERSOUNDLOAD "load_async(file, event=0) -> SoundLoad\nA Sound being loaded in the background"
+#define DOC_SOUNDLOADDONE "done() -> bool\ncheck if the load has finished"
+#define DOC_SOUNDLOADRESULT "result(timeout=None) -> Sound\nget the loaded Sound"
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -86,10 +109,34 @@ pygame.mixer.get_num_channels
  get_num_channels() -> count
 get the total number of playback channels
 
+pygame.mixer.get_sample_clock
+ get_sample_clock() -> frames
+get the number of sample frames mixed
+
 pygame.mixer.set_reserved
  set_reserved(count) -> count
 reserve channels from being automatically used
 
+pygame.mixer.set_num_voices
+ set_num_voices(count) -> None
+set the size of the voice pool
+
+pygame.mixer.get_num_voices
+ get_num_voices() -> count
+get the size of the voice pool
+
+pygame.mixer.play_voice
+ play_voice(sound, priority=0, volume=1.0, loops=0) -> voice
+play a Sound on a voice from the pool
+
+pygame.mixer.stop_voices
+ stop_voices() -> None
+stop every voice
+
+pygame.mixer.get_voice_stats
+ get_voice_stats() -> dict
+get counters for the voice pool
+
 pygame.mixer.find_channel
  find_channel(force=False) -> Channel
 find an unused channel
@@ -103,6 +150,10 @@ pygame.mixer.get_sdl_mixer_version
  get_sdl_mixer_version(linked=True) -> (major, minor, patch)
 get the mixer's SDL version
 
+pygame.mixer.load_async
+ load_async(file, event=0) -> SoundLoad
+load a Sound on a background thread
+
 pygame.mixer.Sound
  Sound(filename) -> Sound
  Sound(file=filename) -> Sound
@@ -112,6 +163,8 @@ pygame.mixer.Sound
  Sound(object) -> Sound
  Sound(file=object) -> Sound
  Sound(array=object) -> Sound
+ Sound(buffer=buffer, copy=False) -> Sound
+ Sound(array=object, copy=False) -> Sound
 Create a new Sound object from a file or buffer object
 
 pygame.mixer.Sound.play
@@ -154,6 +207,10 @@ pygame.mixer.Channel.play
  play(Sound, loops=0, maxtime=0, fade_ms=0) -> None
 play a Sound on a specific Channel
 
+pygame.mixer.Channel.play_at
+ play_at(Sound, time, loops=0) -> None
+play a Sound on a Channel at an exact sample frame
+
 pygame.mixer.Channel.stop
  stop() -> None
 stop playback on a Channel
@@ -179,6 +236,14 @@ pygame.mixer.Channel.get_volume
  get_volume() -> value
 get the volume of the playing channel
 
+pygame.mixer.Channel.set_filter
+ set_filter(type=None, frequency=1000.0, q=0.7071) -> None
+filter the sound of a Channel
+
+pygame.mixer.Channel.set_reverb
+ set_reverb(wet, room_size=0.5, damping=0.5) -> None
+add reverberation to a Channel
+
 pygame.mixer.Channel.get_busy
  get_busy() -> bool
 check if the channel is active
@@ -204,4 +269,57 @@ pygame.mixer.Channel.get_endevent
  get_endevent() -> type
 get the event a channel sends when playback stops
 
+pygame.mixer.Stream
+ Stream(size=0) -> Stream
+ Stream(size=0, file=path, loops=0) -> Stream
+Create a Stream to play samples as they are generated
+
+pygame.mixer.Stream.write
+ write(buffer) -> int
+queue samples for playback
+
+pygame.mixer.Stream.play
+ play() -> Channel
+begin playing queued samples
+
+pygame.mixer.Stream.stop
+ stop() -> None
+stop playback
+
+pygame.mixer.Stream.get_busy
+ get_busy() -> bool
+check if the Stream is playing
+
+pygame.mixer.Stream.get_queued
+ get_queued() -> int
+get the number of bytes waiting to be played
+
+pygame.mixer.Stream.get_free
+ get_free() -> int
+get the number of bytes that can be written
+
+pygame.mixer.Stream.advance
+ advance(frames) -> None
+queue samples written in place
+
+pygame.mixer.Stream.get_underruns
+ get_underruns() -> int
+get the number of times the Stream ran out of samples
+
+pygame.mixer.Stream.reset_underruns
+ reset_underruns() -> None
+reset the underrun count
+
+pygame.mixer.SoundLoad
+ load_async(file, event=0) -> SoundLoad
+A Sound being loaded in the background
+
+pygame.mixer.SoundLoad.done
+ done() -> bool
+check if the load has finished
+
+pygame.mixer.SoundLoad.result
+ result(timeout=None) -> Sound
+get the loaded Sound
+
 */
\ No newline at end of file
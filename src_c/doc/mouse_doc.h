@@ -3,6 +3,7 @@
 #define DOC_PYGAMEMOUSEGETPRESSED "get_pressed(num_buttons=3) -> (button1, button2, button3)\nget_pressed(num_buttons=5) -> (button1, button2, button3, button4, button5)\nget the state of the mouse buttons"
 #define DOC_PYGAMEMOUSEGETPOS "get_pos() -> (x, y)\nget the mouse cursor position"
 #define DOC_PYGAMEMOUSEGETREL "get_rel() -> (x, y)\nget the amount of mouse movement"
+#define DOC_PYGAMEMOUSEGETSTATEINTO "get_state_into(buffer) -> None\ncopy the mouse position and buttons into a buffer"
 #define DOC_PYGAMEMOUSESETPOS "set_pos([x, y]) -> None\nset the mouse cursor position"
 #define DOC_PYGAMEMOUSESETVISIBLE "set_visible(bool) -> bool\nhide or show the mouse cursor"
 #define DOC_PYGAMEMOUSEGETVISIBLE "get_visible() -> bool\nget the current visibility state of the mouse cursor"
@@ -31,6 +32,10 @@ pygame.mouse.get_rel
  get_rel() -> (x, y)
 get the amount of mouse movement
 
+pygame.mouse.get_state_into
+ get_state_into(buffer) -> None
+copy the mouse position and buttons into a buffer
+
 pygame.mouse.set_pos
  set_pos([x, y]) -> None
 set the mouse cursor position
@@ -13,7 +13,8 @@
 #define DOC_PYGAMEMIXERMUSICGETBUSY "get_busy() -> bool\ncheck if the music stream is playing"
 #define DOC_PYGAMEMIXERMUSICSETPOS "set_pos(pos) -> None\nset position to play from"
 #define DOC_PYGAMEMIXERMUSICGETPOS "get_pos() -> time\nget the music play time"
-#define DOC_PYGAMEMIXERMUSICQUEUE "queue(filename) -> None\nqueue(fileobj, namehint="", loops=0) -> None\nqueue a sound file to follow the current"
+#define DOC_PYGAMEMIXERMUSICQUEUE "queue(filename) -> None\nqueue(fileobj, namehint="", loops=0, append=False, fade_ms=0, wait=True) -> None\nqueue a sound file to follow the current"
+#define DOC_PYGAMEMIXERMUSICGETQUEUED "get_queued() -> count\nget the number of sound files queued"
 #define DOC_PYGAMEMIXERMUSICSETENDEVENT "set_endevent() -> None\nset_endevent(type) -> None\nhave the music send an event when playback stops"
 #define DOC_PYGAMEMIXERMUSICGETENDEVENT "get_endevent() -> type\nget the event a channel sends when playback stops"
 
@@ -80,9 +81,13 @@ get the music play time
 
 pygame.mixer.music.queue
  queue(filename) -> None
- queue(fileobj, namehint="", loops=0) -> None
+ queue(fileobj, namehint="", loops=0, append=False, fade_ms=0, wait=True) -> None
 queue a sound file to follow the current
 
+pygame.mixer.music.get_queued
+ get_queued() -> count
+get the number of sound files queued
+
 pygame.mixer.music.set_endevent
  set_endevent() -> None
  set_endevent(type) -> None
@@ -0,0 +1,72 @@
+/* Auto generated file: with makeref.py .  Docs go in docs/reST/ref/ . */
+#define DOC_PYGAMEPARTICLES "pygame module for simulating and drawing particles"
+#define DOC_PYGAMEPARTICLESPARTICLESYSTEM "ParticleSystem(capacity, gravity=(0, 0), drag=0.0, image=None, size=1, additive=False, fade=True, seed=None) -> ParticleSystem\npygame object for a group of particles"
+#define DOC_PARTICLESYSTEMEMIT "emit(pos, count=1, velocity=(0, 0), spread=(0, 0), life=1.0, color=(255, 255, 255, 255)) -> int\nadds particles to the system"
+#define DOC_PARTICLESYSTEMUPDATE "update(dt) -> None\nmoves the particles on by a time step"
+#define DOC_PARTICLESYSTEMDRAW "draw(surface, offset=(0, 0)) -> None\ndraws the particles onto a Surface"
+#define DOC_PARTICLESYSTEMCLEAR "clear() -> None\nremoves every particle"
+#define DOC_PARTICLESYSTEMCAPACITY "capacity -> int\nthe most particles the system holds"
+#define DOC_PARTICLESYSTEMGRAVITY "gravity -> (float, float)\nthe acceleration of every particle"
+#define DOC_PARTICLESYSTEMDRAG "drag -> float\nthe share of its speed a particle loses each second"
+#define DOC_PARTICLESYSTEMSIZE "size -> int\nthe width of the squares drawn for particles"
+#define DOC_PARTICLESYSTEMIMAGE "image -> Surface or None\nthe Surface drawn for each particle"
+#define DOC_PARTICLESYSTEMADDITIVE "additive -> bool\nwhether particles are added to the target"
+#define DOC_PARTICLESYSTEMFADE "fade -> bool\nwhether particles fade out over their life"
+
+
+/* Docs in a comment... slightly easier to read. */
+
+/*
+
+pygame.particles
+pygame module for simulating and drawing particles
+
+pygame.particles.ParticleSystem
+ ParticleSystem(capacity, gravity=(0, 0), drag=0.0, image=None, size=1, additive=False, fade=True, seed=None) -> ParticleSystem
+pygame object for a group of particles
+
+pygame.particles.ParticleSystem.emit
+ emit(pos, count=1, velocity=(0, 0), spread=(0, 0), life=1.0, color=(255, 255, 255, 255)) -> int
+adds particles to the system
+
+pygame.particles.ParticleSystem.update
+ update(dt) -> None
+moves the particles on by a time step
+
+pygame.particles.ParticleSystem.draw
+ draw(surface, offset=(0, 0)) -> None
+draws the particles onto a Surface
+
+pygame.particles.ParticleSystem.clear
+ clear() -> None
+removes every particle
+
+pygame.particles.ParticleSystem.capacity
+ capacity -> int
+the most particles the system holds
+
+pygame.particles.ParticleSystem.gravity
+ gravity -> (float, float)
+the acceleration of every particle
+
+pygame.particles.ParticleSystem.drag
+ drag -> float
+the share of its speed a particle loses each second
+
+pygame.particles.ParticleSystem.size
+ size -> int
+the width of the squares drawn for particles
+
+pygame.particles.ParticleSystem.image
+ image -> Surface or None
+the Surface drawn for each particle
+
+pygame.particles.ParticleSystem.additive
+ additive -> bool
+whether particles are added to the target
+
+pygame.particles.ParticleSystem.fade
+ fade -> bool
+whether particles fade out over their life
+
+*/
@@ -0,0 +1,42 @@
+/* Auto generated file: with makeref.py .  Docs go in docs/reST/ref/ . */
+#define DOC_PYGAMEPROFILER "pygame module for timing the parts of each frame"
+#define DOC_PYGAMEPROFILERFRAMEBEGIN "frame_begin() -> None\nstart timing a frame"
+#define DOC_PYGAMEPROFILERFRAMEEND "frame_end() -> milliseconds\nfinish timing a frame"
+#define DOC_PYGAMEPROFILERSPAN "span(name) -> Span\nget the context manager that times a part of a frame"
+#define DOC_PYGAMEPROFILERGETFRAMES "get_frames() -> list\nget the timings of the recorded frames"
+#define DOC_PYGAMEPROFILERCLEAR "clear() -> None\nforget the recorded frames"
+#define DOC_PYGAMEPROFILERDRAW "draw(surface, rect=None, target=1000/60, profiler=None) -> Rect\ndraw a graph of the recorded frames"
+
+
+/* Docs in a comment... slightly easier to read. */
+
+/*
+
+pygame.profiler
+pygame module for timing the parts of each frame
+
+pygame.profiler.frame_begin
+ frame_begin() -> None
+start timing a frame
+
+pygame.profiler.frame_end
+ frame_end() -> milliseconds
+finish timing a frame
+
+pygame.profiler.span
+ span(name) -> Span
+get the context manager that times a part of a frame
+
+pygame.profiler.get_frames
+ get_frames() -> list
+get the timings of the recorded frames
+
+pygame.profiler.clear
+ clear() -> None
+forget the recorded frames
+
+pygame.profiler.draw
+ draw(surface, rect=None, target=1000/60, profiler=None) -> Rect
+draw a graph of the recorded frames
+
+*/
\ No newline at end of file
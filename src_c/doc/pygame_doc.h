@@ -8,9 +8,23 @@
 #define DOC_PYGAMESETERROR "set_error(error_msg) -> None\nset the current error message"
 #define DOC_PYGAMEGETSDLVERSION "get_sdl_version() -> major, minor, patch\nget the version number of SDL"
 #define DOC_PYGAMEGETSDLBYTEORDER "get_sdl_byteorder() -> int\nget the byte order of SDL"
+#define DOC_PYGAMESETNUMTHREADS "set_num_threads(count) -> None\nset the number of threads used for large pixel operations"
+#define DOC_PYGAMEGETNUMTHREADS "get_num_threads() -> int\nget the number of threads used for large pixel operations"
+#define DOC_PYGAMEGETPARALLELTHRESHOLD "get_parallel_threshold() -> int\nget the pixel count above which work is split across threads"
+#define DOC_PYGAMEGETTHREADPOOLINFO "get_thread_pool_info() -> (threads, busy, queued)\nget the size and occupancy of the worker thread pool"
+#define DOC_PYGAMEGETSIMDBACKENDS "get_simd_backends() -> list\nget the SIMD backends this CPU can run"
+#define DOC_PYGAMEGETSIMDBACKEND "get_simd_backend() -> str\nget the SIMD backend in use"
+#define DOC_PYGAMESETSIMDBACKEND "set_simd_backend(backend) -> None\nchoose the SIMD instruction sets pygame may use"
+#define DOC_PYGAMESETSTATSENABLED "set_stats_enabled(enabled, trace=False) -> None\nturn the counters of pygame's internal work on or off"
+#define DOC_PYGAMESTATS "stats(reset=False) -> dict\nget the counters of pygame's internal work"
+#define DOC_PYGAMESAVETRACE "save_trace(file) -> None\nwrite the recorded trace of pygame's internal work"
+#define DOC_PYGAMEGETIMPORTTIMES "get_import_times() -> dict\nget the time taken to import pygame and its modules"
 #define DOC_PYGAMEREGISTERQUIT "register_quit(callable) -> None\nregister a function to be called when pygame quits"
 #define DOC_PYGAMEENCODESTRING "encode_string([obj [, encoding [, errors [, etype]]]]) -> bytes or None\nEncode a Unicode or bytes object"
 #define DOC_PYGAMEENCODEFILEPATH "encode_file_path([obj [, etype]]) -> bytes or None\nEncode a Unicode or bytes object as a file system path"
+#define DOC_PYGAMEBUNDLE "Bundle(file) -> Bundle\npygame object for reading assets packed into one archive"
+#define DOC_BUNDLEOPEN "open(name) -> file object\nopen an entry of the archive"
+#define DOC_BUNDLENAMES "names() -> list\nlist the entries of the archive"
 #define DOC_PYGAMEVERSION "small module containing version information"
 #define DOC_PYGAMEVERSIONVER "ver = '1.2'\nversion number as a string"
 #define DOC_PYGAMEVERSIONVERNUM "vernum = (1, 5, 3)\ntupled integers of the version"
@@ -57,6 +71,50 @@ pygame.get_sdl_byteorder
  get_sdl_byteorder() -> int
 get the byte order of SDL
 
+pygame.set_num_threads
+ set_num_threads(count) -> None
+set the number of threads used for large pixel operations
+
+pygame.get_num_threads
+ get_num_threads() -> int
+get the number of threads used for large pixel operations
+
+pygame.get_parallel_threshold
+ get_parallel_threshold() -> int
+get the pixel count above which work is split across threads
+
+pygame.get_thread_pool_info
+ get_thread_pool_info() -> (threads, busy, queued)
+get the size and occupancy of the worker thread pool
+
+pygame.get_simd_backends
+ get_simd_backends() -> list
+get the SIMD backends this CPU can run
+
+pygame.get_simd_backend
+ get_simd_backend() -> str
+get the SIMD backend in use
+
+pygame.set_simd_backend
+ set_simd_backend(backend) -> None
+choose the SIMD instruction sets pygame may use
+
+pygame.set_stats_enabled
+ set_stats_enabled(enabled, trace=False) -> None
+turn the counters of pygame's internal work on or off
+
+pygame.stats
+ stats(reset=False) -> dict
+get the counters of pygame's internal work
+
+pygame.save_trace
+ save_trace(file) -> None
+write the recorded trace of pygame's internal work
+
+pygame.get_import_times
+ get_import_times() -> dict
+get the time taken to import pygame and its modules
+
 pygame.register_quit
  register_quit(callable) -> None
 register a function to be called when pygame quits
@@ -69,6 +127,18 @@ pygame.encode_file_path
  encode_file_path([obj [, etype]]) -> bytes or None
 Encode a Unicode or bytes object as a file system path
 
+pygame.Bundle
+ Bundle(file) -> Bundle
+pygame object for reading assets packed into one archive
+
+pygame.Bundle.open
+ open(name) -> file object
+open an entry of the archive
+
+pygame.Bundle.names
+ names() -> list
+list the entries of the archive
+
 pygame.version
 small module containing version information
 
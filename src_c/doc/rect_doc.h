@@ -26,6 +26,29 @@
 #define DOC_RECTCOLLIDEDICT "collidedict(dict) -> (key, value)\ncollidedict(dict) -> None\ncollidedict(dict, use_values=0) -> (key, value)\ncollidedict(dict, use_values=0) -> None\ntest if one rectangle in a dictionary intersects"
 #define DOC_RECTCOLLIDEDICTALL "collidedictall(dict) -> [(key, value), ...]\ncollidedictall(dict, use_values=0) -> [(key, value), ...]\ntest if all rectangles in a dictionary intersect"
 
+#define DOC_PYGAMEFRECT "FRect(left, top, width, height) -> FRect\nFRect((left, top), (width, height)) -> FRect\nFRect(object) -> FRect\npygame object for storing rectangular coordinates as floats"
+
+#define DOC_PYGAMERECTINDEX "RectIndex(rects=(), cell_size=64) -> RectIndex\npygame object for finding the rectangles near an area"
+#define DOC_RECTINDEXINSERT "insert(Rect) -> id\nadds a rectangle to the index"
+#define DOC_RECTINDEXREMOVE "remove(id) -> None\nremoves a rectangle from the index"
+#define DOC_RECTINDEXMOVE "move(id, Rect) -> None\nchanges a rectangle in the index"
+#define DOC_RECTINDEXCOLLIDEPOINT "collidepoint(x, y) -> [id, ...]\ncollidepoint((x,y)) -> [id, ...]\nfinds the rectangles containing a point"
+#define DOC_RECTINDEXCOLLIDERECT "colliderect(Rect) -> [id, ...]\nfinds the rectangles intersecting a rectangle"
+#define DOC_RECTINDEXCOLLIDELIST "collidelist(list) -> [[id, ...], ...]\nfinds the rectangles intersecting each rectangle in a list"
+#define DOC_PYGAMERECTARRAY "RectArray(rects=()) -> RectArray\nRectArray(length) -> RectArray\npygame object for storing many rectangles together"
+#define DOC_RECTARRAYAPPEND "append(Rect) -> None\nadds a rectangle to the end of the array"
+#define DOC_RECTARRAYMOVEIP "move_ip(x, y) -> None\nmoves all the rectangles, in place"
+#define DOC_RECTARRAYCLAMPIP "clamp_ip(Rect) -> None\nmoves all the rectangles inside another, in place"
+#define DOC_RECTARRAYCLIP "clip(Rect) -> RectArray\ncrops all the rectangles inside another"
+#define DOC_RECTARRAYUNION "union() -> Rect\nthe union of all the rectangles"
+#define DOC_RECTARRAYMERGEIP "merge_ip() -> None\nmerge_ip(clip) -> None\nmerges the overlapping rectangles, in place"
+#define DOC_RECTARRAYCOLLIDEPOINT "collidepoint(x, y) -> [index, ...]\ncollidepoint((x,y)) -> [index, ...]\nfinds the rectangles containing a point"
+#define DOC_RECTARRAYCOLLIDERECT "colliderect(Rect) -> [index, ...]\nfinds the rectangles intersecting a rectangle"
+#define DOC_PYGAMERECTPACKER "RectPacker(size) -> RectPacker\npygame object for placing rectangles side by side in an area"
+#define DOC_RECTPACKERSIZE "size -> (width, height)\nthe size of the area"
+#define DOC_RECTPACKERINSERT "insert(width, height) -> Rect or None\ninsert((width, height)) -> Rect or None\nplaces a rectangle"
+#define DOC_RECTPACKERINSERTLIST "insertlist(sizes) -> [Rect or None, ...]\nplaces many rectangles"
+#define DOC_RECTPACKERCLEAR "clear() -> None\nforgets all the rectangles placed"
 
 /* Docs in a comment... slightly easier to read. */
 
@@ -153,4 +176,99 @@ pygame.Rect.collidedictall
  collidedictall(dict, use_values=0) -> [(key, value), ...]
 test if all rectangles in a dictionary intersect
 
-*/
\ No newline at end of file
+pygame.FRect
+ FRect(left, top, width, height) -> FRect
+ FRect((left, top), (width, height)) -> FRect
+ FRect(object) -> FRect
+pygame object for storing rectangular coordinates as floats
+
+pygame.RectIndex
+ RectIndex(rects=(), cell_size=64) -> RectIndex
+pygame object for finding the rectangles near an area
+
+pygame.RectIndex.insert
+ insert(Rect) -> id
+adds a rectangle to the index
+
+pygame.RectIndex.remove
+ remove(id) -> None
+removes a rectangle from the index
+
+pygame.RectIndex.move
+ move(id, Rect) -> None
+changes a rectangle in the index
+
+pygame.RectIndex.collidepoint
+ collidepoint(x, y) -> [id, ...]
+ collidepoint((x,y)) -> [id, ...]
+finds the rectangles containing a point
+
+pygame.RectIndex.colliderect
+ colliderect(Rect) -> [id, ...]
+finds the rectangles intersecting a rectangle
+
+pygame.RectIndex.collidelist
+ collidelist(list) -> [[id, ...], ...]
+finds the rectangles intersecting each rectangle in a list
+
+pygame.RectArray
+ RectArray(rects=()) -> RectArray
+ RectArray(length) -> RectArray
+pygame object for storing many rectangles together
+
+pygame.RectArray.append
+ append(Rect) -> None
+adds a rectangle to the end of the array
+
+pygame.RectArray.move_ip
+ move_ip(x, y) -> None
+moves all the rectangles, in place
+
+pygame.RectArray.clamp_ip
+ clamp_ip(Rect) -> None
+moves all the rectangles inside another, in place
+
+pygame.RectArray.clip
+ clip(Rect) -> RectArray
+crops all the rectangles inside another
+
+pygame.RectArray.union
+ union() -> Rect
+the union of all the rectangles
+
+pygame.RectArray.merge_ip
+ merge_ip() -> None
+ merge_ip(clip) -> None
+merges the overlapping rectangles, in place
+
+pygame.RectArray.collidepoint
+ collidepoint(x, y) -> [index, ...]
+ collidepoint((x,y)) -> [index, ...]
+finds the rectangles containing a point
+
+pygame.RectArray.colliderect
+ colliderect(Rect) -> [index, ...]
+finds the rectangles intersecting a rectangle
+
+pygame.RectPacker
+ RectPacker(size) -> RectPacker
+pygame object for placing rectangles side by side in an area
+
+pygame.RectPacker.size
+ size -> (width, height)
+the size of the area
+
+pygame.RectPacker.insert
+ insert(width, height) -> Rect or None
+ insert((width, height)) -> Rect or None
+places a rectangle
+
+pygame.RectPacker.insertlist
+ insertlist(sizes) -> [Rect or None, ...]
+places many rectangles
+
+pygame.RectPacker.clear
+ clear() -> None
+forgets all the rectangles placed
+
+*/
@@ -0,0 +1,47 @@
+/* Auto generated file: with makeref.py .  Docs go in docs/reST/ref/ . */
+#define DOC_PYGAMESHAREDSURFACE "pygame module for surfaces shared between processes"
+#define DOC_PYGAMESHAREDSURFACESHAREDSURFACE "SharedSurface(size, flags=0, depth=32, name=None) -> SharedSurface\npygame object for a Surface in memory shared between processes"
+#define DOC_SHAREDSURFACEFROMSURFACE "from_surface(surface, name=None) -> SharedSurface\nshares a copy of a Surface"
+#define DOC_SHAREDSURFACEATTACH "attach(name) -> SharedSurface\nreaches a SharedSurface made by another process"
+#define DOC_SHAREDSURFACESURFACE "surface -> Surface or None\nthe Surface over the shared memory"
+#define DOC_SHAREDSURFACENAME "name -> str\nthe name other processes attach with"
+#define DOC_SHAREDSURFACECLOSE "close() -> None\nstops using the shared memory in this process"
+#define DOC_SHAREDSURFACEUNLINK "unlink() -> None\nfrees the shared memory once every process has closed it"
+
+
+/* Docs in a comment... slightly easier to read. */
+
+/*
+
+pygame.sharedsurface
+pygame module for surfaces shared between processes
+
+pygame.sharedsurface.SharedSurface
+ SharedSurface(size, flags=0, depth=32, name=None) -> SharedSurface
+pygame object for a Surface in memory shared between processes
+
+pygame.sharedsurface.SharedSurface.from_surface
+ from_surface(surface, name=None) -> SharedSurface
+shares a copy of a Surface
+
+pygame.sharedsurface.SharedSurface.attach
+ attach(name) -> SharedSurface
+reaches a SharedSurface made by another process
+
+pygame.sharedsurface.SharedSurface.surface
+ surface -> Surface or None
+the Surface over the shared memory
+
+pygame.sharedsurface.SharedSurface.name
+ name -> str
+the name other processes attach with
+
+pygame.sharedsurface.SharedSurface.close
+ close() -> None
+stops using the shared memory in this process
+
+pygame.sharedsurface.SharedSurface.unlink
+ unlink() -> None
+frees the shared memory once every process has closed it
+
+*/
@@ -2,7 +2,7 @@
 #define DOC_PYGAMESNDARRAY "pygame module for accessing sound sample data"
 #define DOC_PYGAMESNDARRAYARRAY "array(Sound) -> array\ncopy Sound samples into an array"
 #define DOC_PYGAMESNDARRAYSAMPLES "samples(Sound) -> array\nreference Sound samples into an array"
-#define DOC_PYGAMESNDARRAYMAKESOUND "make_sound(array) -> Sound\nconvert an array into a Sound object"
+#define DOC_PYGAMESNDARRAYMAKESOUND "make_sound(array, copy=True) -> Sound\nconvert an array into a Sound object"
 #define DOC_PYGAMESNDARRAYUSEARRAYTYPE "use_arraytype (arraytype) -> None\nSets the array system to be used for sound arrays"
 #define DOC_PYGAMESNDARRAYGETARRAYTYPE "get_arraytype () -> str\nGets the currently active array type."
 #define DOC_PYGAMESNDARRAYGETARRAYTYPES "get_arraytypes () -> tuple\nGets the array system types currently supported."
@@ -24,7 +24,7 @@ pygame.sndarray.samples
 reference Sound samples into an array
 
 pygame.sndarray.make_sound
- make_sound(array) -> Sound
+ make_sound(array, copy=True) -> Sound
 convert an array into a Sound object
 
 pygame.sndarray.use_arraytype
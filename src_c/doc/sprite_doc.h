@@ -15,7 +15,9 @@
 #define DOC_GROUPREMOVE "remove(*sprites) -> None\nremove Sprites from the Group"
 #define DOC_GROUPHAS "has(*sprites) -> bool\ntest if a Group contains Sprites"
 #define DOC_GROUPUPDATE "update(*args, **kwargs) -> None\ncall the update method on contained Sprites"
+#define DOC_GROUPCACHEUPDATE "cache_update -> bool\nwhether update() reuses the update calls it looked up"
 #define DOC_GROUPDRAW "draw(Surface) -> List[Rect]\nblit the Sprite images"
+#define DOC_GROUPSORTKEY "sort_key -> str or callable or None\nthe order draw() blits the Sprites in"
 #define DOC_GROUPCLEAR "clear(Surface_dest, background) -> None\ndraw a background over the Sprites"
 #define DOC_GROUPEMPTY "empty() -> None\nremove all Sprites"
 #define DOC_PYGAMESPRITERENDERPLAIN "Same as pygame.sprite.Group"
@@ -50,6 +52,12 @@
 #define DOC_LAYEREDDIRTYSETTIMINGTRESHOLD "set_timing_treshold(time_ms) -> None\nsets the threshold in milliseconds"
 #define DOC_LAYEREDDIRTYSETTIMINGTHRESHOLD "set_timing_threshold(time_ms) -> None\nsets the threshold in milliseconds"
 #define DOC_PYGAMESPRITEGROUPSINGLE "GroupSingle(sprite=None) -> GroupSingle\nGroup container that holds a single sprite."
+#define DOC_PYGAMESPRITEARRAYGROUP "ArrayGroup() -> ArrayGroup\nGroup that keeps its sprites in packed arrays."
+#define DOC_ARRAYGROUPADD "add(image, rect=None, special_flags=0) -> int\nadd a sprite and return its index"
+#define DOC_ARRAYGROUPREMOVE "remove(index) -> None\nremove the sprite at an index"
+#define DOC_ARRAYGROUPEMPTY "empty() -> None\nremove all sprites"
+#define DOC_ARRAYGROUPDRAW "draw(surface) -> None\ndraw all sprites onto a surface"
+#define DOC_ARRAYGROUPCLEAR "clear(surface, bgd) -> None\ndraw a background over the sprites"
 #define DOC_PYGAMESPRITESPRITECOLLIDE "spritecollide(sprite, group, dokill, collided = None) -> Sprite_list\nFind sprites in a group that intersect another sprite."
 #define DOC_PYGAMESPRITECOLLIDERECT "collide_rect(left, right) -> bool\nCollision detection between two sprites, using rects."
 #define DOC_PYGAMESPRITECOLLIDERECTRATIO "collide_rect_ratio(ratio) -> collided_callable\nCollision detection between two sprites, using rects scaled to a ratio."
@@ -127,10 +135,18 @@ pygame.sprite.Group.update
  update(*args, **kwargs) -> None
 call the update method on contained Sprites
 
+pygame.sprite.Group.cache_update
+ cache_update -> bool
+whether update() reuses the update calls it looked up
+
 pygame.sprite.Group.draw
  draw(Surface) -> List[Rect]
 blit the Sprite images
 
+pygame.sprite.Group.sort_key
+ sort_key -> str or callable or None
+the order draw() blits the Sprites in
+
 pygame.sprite.Group.clear
  clear(Surface_dest, background) -> None
 draw a background over the Sprites
@@ -265,6 +281,30 @@ pygame.sprite.GroupSingle
  GroupSingle(sprite=None) -> GroupSingle
 Group container that holds a single sprite.
 
+pygame.sprite.ArrayGroup
+ ArrayGroup() -> ArrayGroup
+Group that keeps its sprites in packed arrays.
+
+pygame.sprite.ArrayGroup.add
+ add(image, rect=None, special_flags=0) -> int
+add a sprite and return its index
+
+pygame.sprite.ArrayGroup.remove
+ remove(index) -> None
+remove the sprite at an index
+
+pygame.sprite.ArrayGroup.empty
+ empty() -> None
+remove all sprites
+
+pygame.sprite.ArrayGroup.draw
+ draw(surface) -> None
+draw all sprites onto a surface
+
+pygame.sprite.ArrayGroup.clear
+ clear(surface, bgd) -> None
+draw a background over the sprites
+
 pygame.sprite.spritecollide
  spritecollide(sprite, group, dokill, collided = None) -> Sprite_list
 Find sprites in a group that intersect another sprite.
@@ -2,11 +2,18 @@
 #define DOC_PYGAMESURFACE "Surface((width, height), flags=0, depth=0, masks=None) -> Surface\nSurface((width, height), flags=0, Surface) -> Surface\npygame object for representing images"
 #define DOC_SURFACEBLIT "blit(source, dest, area=None, special_flags=0) -> Rect\ndraw one image onto another"
 #define DOC_SURFACEBLITS "blits(blit_sequence=((source, dest), ...), doreturn=1) -> [Rect, ...] or None\nblits(((source, dest, area), ...)) -> [Rect, ...]\nblits(((source, dest, area, special_flags), ...)) -> [Rect, ...]\ndraw many images onto another"
+#define DOC_SURFACEFBLITS "fblits(source, positions, special_flags=0) -> None\nfblits(sources, records, special_flags=0) -> None\ndraw many images from a buffer of positions"
+#define DOC_SURFACEBLITMANY "blit_many(source, positions, special_flags=0) -> None\ndraw one image at many positions"
+#define DOC_SURFACEBLITARRAY "blit_array(sources, rects, special_flags=0) -> None\ndraw one image per rect of a packed rect buffer"
+#define DOC_SURFACESETDAMAGETRACKING "set_damage_tracking(enabled=True) -> None\nrecord the areas changed by drawing"
+#define DOC_SURFACEGETDAMAGE "get_damage(clear=True) -> [Rect, ...]\nget the areas changed since the damage was last cleared"
+#define DOC_SURFACEGETVERSION "get_version() -> int\nget a number that changes whenever the Surface is modified"
 #define DOC_SURFACECONVERT "convert(Surface=None) -> Surface\nconvert(depth, flags=0) -> Surface\nconvert(masks, flags=0) -> Surface\nchange the pixel format of an image"
 #define DOC_SURFACECONVERTALPHA "convert_alpha(Surface) -> Surface\nconvert_alpha() -> Surface\nchange the pixel format of an image including per pixel alphas"
+#define DOC_SURFACEPREMULALPHA "premul_alpha() -> Surface\nreturns a copy of the surface with the RGB channels pre-multiplied by the alpha channel"
 #define DOC_SURFACECOPY "copy() -> Surface\ncreate a new copy of a Surface"
 #define DOC_SURFACEFILL "fill(color, rect=None, special_flags=0) -> Rect\nfill Surface with a solid color"
-#define DOC_SURFACESCROLL "scroll(dx=0, dy=0) -> None\nShift the surface image in place"
+#define DOC_SURFACESCROLL "scroll(dx=0, dy=0, wrap=False) -> None\nShift the surface image in place"
 #define DOC_SURFACESETCOLORKEY "set_colorkey(Color, flags=0) -> None\nset_colorkey(None) -> None\nSet the transparent colorkey"
 #define DOC_SURFACEGETCOLORKEY "get_colorkey() -> RGB or None\nGet the current transparent colorkey"
 #define DOC_SURFACESETALPHA "set_alpha(value, flags=0) -> None\nset_alpha(None) -> None\nset the alpha value for the full Surface image"
@@ -19,6 +26,8 @@
 #define DOC_SURFACEGETAT "get_at((x, y)) -> Color\nget the color value at a single pixel"
 #define DOC_SURFACESETAT "set_at((x, y), Color) -> None\nset the color value for a single pixel"
 #define DOC_SURFACEGETATMAPPED "get_at_mapped((x, y)) -> Color\nget the mapped color value at a single pixel"
+#define DOC_SURFACEGETATMANY "get_at_many(coords) -> array\nget the mapped color values of many pixels at once"
+#define DOC_SURFACESETATMANY "set_at_many(coords, colors) -> None\nset the color values of many pixels at once"
 #define DOC_SURFACEGETPALETTE "get_palette() -> [RGB, RGB, RGB, ...]\nget the color index palette for an 8-bit Surface"
 #define DOC_SURFACEGETPALETTEAT "get_palette_at(index) -> RGB\nget the color for a single entry in a palette"
 #define DOC_SURFACESETPALETTE "set_palette([RGB, RGB, RGB, ...]) -> None\nset the color palette for an 8-bit Surface"
@@ -28,6 +37,7 @@
 #define DOC_SURFACESETCLIP "set_clip(rect) -> None\nset_clip(None) -> None\nset the current clipping area of the Surface"
 #define DOC_SURFACEGETCLIP "get_clip() -> Rect\nget the current clipping area of the Surface"
 #define DOC_SURFACESUBSURFACE "subsurface(Rect) -> Surface\ncreate a new surface that references its parent"
+#define DOC_SURFACEREGION "region(Rect) -> SurfaceRegion\nrefer to an area of the Surface without making a subsurface"
 #define DOC_SURFACEGETPARENT "get_parent() -> Surface\nfind the parent of a subsurface"
 #define DOC_SURFACEGETABSPARENT "get_abs_parent() -> Surface\nfind the top level parent of a subsurface"
 #define DOC_SURFACEGETOFFSET "get_offset() -> (x, y)\nfind the position of a child subsurface inside a parent"
@@ -46,9 +56,37 @@
 #define DOC_SURFACESETSHIFTS "set_shifts((r,g,b,a)) -> None\nsets the bit shifts needed to convert between a color and a mapped integer"
 #define DOC_SURFACEGETLOSSES "get_losses() -> (R, G, B, A)\nthe significant bits used to convert between a color and a mapped integer"
 #define DOC_SURFACEGETBOUNDINGRECT "get_bounding_rect(min_alpha = 1) -> Rect\nfind the smallest rect containing data"
+#define DOC_SURFACEGETSTATS "get_stats(rect=None) -> dict\nfind the range and totals of the pixel values"
 #define DOC_SURFACEGETVIEW "get_view(<kind>='2') -> BufferProxy\nreturn a buffer view of the Surface's pixels."
 #define DOC_SURFACEGETBUFFER "get_buffer() -> BufferProxy\nacquires a buffer object for the pixels of the Surface."
+#define DOC_SURFACECOMPRESS "compress() -> int\nfree the pixels, keeping a compressed copy until they are used"
+#define DOC_SURFACEGETCOMPRESSEDSIZE "get_compressed_size() -> int\nget the bytes the compressed pixels take"
+#define DOC_SURFACEGLUPLOAD "gl_upload(target=GL_TEXTURE_2D, level=0, offset=None, pbo=0) -> None\nupload the pixels to the bound OpenGL texture"
 #define DOC_SURFACEPIXELSADDRESS "_pixels_address -> int\npixel buffer address"
+#define DOC_PYGAMECONVERTMANY "convert_many(surfaces, format=None, alpha=False) -> list\nconvert many surfaces to the same pixel format at once"
+#define DOC_PYGAMEGETBOUNDINGRECTS "get_bounding_rects(surfaces, min_alpha=1) -> list\nfind the bounding rects of many surfaces at once"
+#define DOC_PYGAMESETAUTOCONVERT "set_auto_convert(enabled) -> None\nconvert surfaces blitted in another pixel format behind the scenes"
+#define DOC_PYGAMEGETAUTOCONVERT "get_auto_convert() -> bool\ncheck if surfaces are converted when blitted"
+#define DOC_PYGAMESURFACEPOOL "SurfacePool(max_buffers=16) -> SurfacePool\npygame object for reusing the pixels of temporary surfaces"
+#define DOC_SURFACEPOOLHITS "hits -> int\nnumber of surfaces made from a reused buffer"
+#define DOC_SURFACEPOOLMISSES "misses -> int\nnumber of surfaces that needed a new buffer"
+#define DOC_SURFACEPOOLIDLE "idle -> int\nnumber of buffers waiting to be reused"
+#define DOC_SURFACEPOOLMAXBUFFERS "max_buffers -> int\nmost idle buffers the pool keeps"
+#define DOC_SURFACEPOOLCLEAR "clear() -> None\nfree all idle buffers"
+#define DOC_PYGAMESURFACEREGION "SurfaceRegion(surface, rect) -> SurfaceRegion\npygame object for blitting an area of a Surface"
+#define DOC_SURFACEREGIONSURFACE "surface -> Surface\nthe Surface the region is an area of"
+#define DOC_SURFACEREGIONRECT "rect -> Rect\nthe area of the Surface"
+#define DOC_SURFACEREGIONGETSIZE "get_size() -> (width, height)\nget the dimensions of the region"
+#define DOC_SURFACEREGIONSUBSURFACE "subsurface() -> Surface\nget a subsurface for the region"
+#define DOC_SURFACEREGIONGETVIEW "get_view(<kind>='2') -> BufferProxy\nreturn a buffer view of the region's pixels"
+#define DOC_PYGAMEHDRSURFACE "HDRSurface((width, height)) -> HDRSurface\npygame object for float pixels in linear light"
+#define DOC_HDRSURFACEGETSIZE "get_size() -> (width, height)\nget the dimensions of the HDRSurface"
+#define DOC_HDRSURFACEGETWIDTH "get_width() -> width\nget the width of the HDRSurface"
+#define DOC_HDRSURFACEGETHEIGHT "get_height() -> height\nget the height of the HDRSurface"
+#define DOC_HDRSURFACEGETAT "get_at((x, y)) -> (r, g, b, a)\nget the floats of a single pixel"
+#define DOC_HDRSURFACEFILL "fill(color, rect=None, special_flags=0) -> Rect\nfill, add to or multiply an area by a color"
+#define DOC_HDRSURFACEBLIT "blit(source, dest=(0, 0), area=None, special_flags=0) -> Rect\nblend a Surface or HDRSurface onto this one"
+#define DOC_HDRSURFACETONEMAP "tonemap(surface, dest=(0, 0), area=None, exposure=1.0, method='reinhard') -> Rect\nwrite the pixels to a 32 bit Surface"
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -70,6 +108,31 @@ pygame.Surface.blits
  blits(((source, dest, area, special_flags), ...)) -> [Rect, ...]
 draw many images onto another
 
+pygame.Surface.fblits
+ fblits(source, positions, special_flags=0) -> None
+ fblits(sources, records, special_flags=0) -> None
+draw many images from a buffer of positions
+
+pygame.Surface.blit_many
+ blit_many(source, positions, special_flags=0) -> None
+draw one image at many positions
+
+pygame.Surface.blit_array
+ blit_array(sources, rects, special_flags=0) -> None
+draw one image per rect of a packed rect buffer
+
+pygame.Surface.set_damage_tracking
+ set_damage_tracking(enabled=True) -> None
+record the areas changed by drawing
+
+pygame.Surface.get_damage
+ get_damage(clear=True) -> [Rect, ...]
+get the areas changed since the damage was last cleared
+
+pygame.Surface.get_version
+ get_version() -> int
+get a number that changes whenever the Surface is modified
+
 pygame.Surface.convert
  convert(Surface=None) -> Surface
  convert(depth, flags=0) -> Surface
@@ -81,6 +144,10 @@ pygame.Surface.convert_alpha
  convert_alpha() -> Surface
 change the pixel format of an image including per pixel alphas
 
+pygame.Surface.premul_alpha
+ premul_alpha() -> Surface
+returns a copy of the surface with the RGB channels pre-multiplied by the alpha channel
+
 pygame.Surface.copy
  copy() -> Surface
 create a new copy of a Surface
@@ -90,7 +157,7 @@ pygame.Surface.fill
 fill Surface with a solid color
 
 pygame.Surface.scroll
- scroll(dx=0, dy=0) -> None
+ scroll(dx=0, dy=0, wrap=False) -> None
 Shift the surface image in place
 
 pygame.Surface.set_colorkey
@@ -143,6 +210,14 @@ pygame.Surface.get_at_mapped
  get_at_mapped((x, y)) -> Color
 get the mapped color value at a single pixel
 
+pygame.Surface.get_at_many
+ get_at_many(coords) -> array
+get the mapped color values of many pixels at once
+
+pygame.Surface.set_at_many
+ set_at_many(coords, colors) -> None
+set the color values of many pixels at once
+
 pygame.Surface.get_palette
  get_palette() -> [RGB, RGB, RGB, ...]
 get the color index palette for an 8-bit Surface
@@ -180,6 +255,10 @@ pygame.Surface.subsurface
  subsurface(Rect) -> Surface
 create a new surface that references its parent
 
+pygame.Surface.region
+ region(Rect) -> SurfaceRegion
+refer to an area of the Surface without making a subsurface
+
 pygame.Surface.get_parent
  get_parent() -> Surface
 find the parent of a subsurface
@@ -252,6 +331,10 @@ pygame.Surface.get_bounding_rect
  get_bounding_rect(min_alpha = 1) -> Rect
 find the smallest rect containing data
 
+pygame.Surface.get_stats
+ get_stats(rect=None) -> dict
+find the range and totals of the pixel values
+
 pygame.Surface.get_view
  get_view(<kind>='2') -> BufferProxy
 return a buffer view of the Surface's pixels.
@@ -260,8 +343,116 @@ pygame.Surface.get_buffer
  get_buffer() -> BufferProxy
 acquires a buffer object for the pixels of the Surface.
 
+pygame.Surface.compress
+ compress() -> int
+free the pixels, keeping a compressed copy until they are used
+
+pygame.Surface.get_compressed_size
+ get_compressed_size() -> int
+get the bytes the compressed pixels take
+
+pygame.Surface.gl_upload
+ gl_upload(target=GL_TEXTURE_2D, level=0, offset=None, pbo=0) -> None
+upload the pixels to the bound OpenGL texture
+
 pygame.Surface._pixels_address
  _pixels_address -> int
 pixel buffer address
 
+pygame.convert_many
+ convert_many(surfaces, format=None, alpha=False) -> list
+convert many surfaces to the same pixel format at once
+
+pygame.get_bounding_rects
+ get_bounding_rects(surfaces, min_alpha=1) -> list
+find the bounding rects of many surfaces at once
+
+pygame.set_auto_convert
+ set_auto_convert(enabled) -> None
+convert surfaces blitted in another pixel format behind the scenes
+
+pygame.get_auto_convert
+ get_auto_convert() -> bool
+check if surfaces are converted when blitted
+
+pygame.SurfacePool
+ SurfacePool(max_buffers=16) -> SurfacePool
+pygame object for reusing the pixels of temporary surfaces
+
+pygame.SurfacePool.hits
+ hits -> int
+number of surfaces made from a reused buffer
+
+pygame.SurfacePool.misses
+ misses -> int
+number of surfaces that needed a new buffer
+
+pygame.SurfacePool.idle
+ idle -> int
+number of buffers waiting to be reused
+
+pygame.SurfacePool.max_buffers
+ max_buffers -> int
+most idle buffers the pool keeps
+
+pygame.SurfacePool.clear
+ clear() -> None
+free all idle buffers
+
+pygame.SurfaceRegion
+ SurfaceRegion(surface, rect) -> SurfaceRegion
+pygame object for blitting an area of a Surface
+
+pygame.SurfaceRegion.surface
+ surface -> Surface
+the Surface the region is an area of
+
+pygame.SurfaceRegion.rect
+ rect -> Rect
+the area of the Surface
+
+pygame.SurfaceRegion.get_size
+ get_size() -> (width, height)
+get the dimensions of the region
+
+pygame.SurfaceRegion.subsurface
+ subsurface() -> Surface
+get a subsurface for the region
+
+pygame.SurfaceRegion.get_view
+ get_view(<kind>='2') -> BufferProxy
+return a buffer view of the region's pixels
+
+pygame.HDRSurface
+ HDRSurface((width, height)) -> HDRSurface
+pygame object for float pixels in linear light
+
+pygame.HDRSurface.get_size
+ get_size() -> (width, height)
+get the dimensions of the HDRSurface
+
+pygame.HDRSurface.get_width
+ get_width() -> width
+get the width of the HDRSurface
+
+pygame.HDRSurface.get_height
+ get_height() -> height
+get the height of the HDRSurface
+
+pygame.HDRSurface.get_at
+ get_at((x, y)) -> (r, g, b, a)
+get the floats of a single pixel
+
+pygame.HDRSurface.fill
+ fill(color, rect=None, special_flags=0) -> Rect
+fill, add to or multiply an area by a color
+
+pygame.HDRSurface.blit
+ blit(source, dest=(0, 0), area=None, special_flags=0) -> Rect
+blend a Surface or HDRSurface onto this one
+
+pygame.HDRSurface.tonemap
+ tonemap(surface, dest=(0, 0), area=None, exposure=1.0, method='reinhard') -> Rect
+write the pixels to a 32 bit Surface
+
 */
\ No newline at end of file
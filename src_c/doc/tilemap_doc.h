@@ -0,0 +1,37 @@
+/* Auto generated file: with makeref.py .  Docs go in docs/reST/ref/ . */
+#define DOC_PYGAMETILEMAP "pygame module for drawing grids of tiles"
+#define DOC_PYGAMETILEMAPTILEMAP "Tilemap(tileset, tile_size, size, chunk_size=(16, 16), data=None) -> Tilemap\npygame object for drawing a grid of tiles"
+#define DOC_TILEMAPTILES "tiles -> list\nthe tile images"
+#define DOC_TILEMAPFILL "fill(index, rect=None) -> None\nsets many tiles to the same index"
+#define DOC_TILEMAPINVALIDATE "invalidate(rect=None) -> None\ndrops the cached chunks"
+#define DOC_TILEMAPDRAW "draw(target, camera=(0, 0), area=None) -> Rect\ndraws the tiles seen by a camera"
+
+
+/* Docs in a comment... slightly easier to read. */
+
+/*
+
+pygame.tilemap
+pygame module for drawing grids of tiles
+
+pygame.tilemap.Tilemap
+ Tilemap(tileset, tile_size, size, chunk_size=(16, 16), data=None) -> Tilemap
+pygame object for drawing a grid of tiles
+
+pygame.tilemap.Tilemap.tiles
+ tiles -> list
+the tile images
+
+pygame.tilemap.Tilemap.fill
+ fill(index, rect=None) -> None
+sets many tiles to the same index
+
+pygame.tilemap.Tilemap.invalidate
+ invalidate(rect=None) -> None
+drops the cached chunks
+
+pygame.tilemap.Tilemap.draw
+ draw(target, camera=(0, 0), area=None) -> Rect
+draws the tiles seen by a camera
+
+*/
@@ -4,12 +4,21 @@
 #define DOC_PYGAMETIMEWAIT "wait(milliseconds) -> time\npause the program for an amount of time"
 #define DOC_PYGAMETIMEDELAY "delay(milliseconds) -> time\npause the program for an amount of time"
 #define DOC_PYGAMETIMESETTIMER "set_timer(event, millis) -> None\nset_timer(event, millis, loops=0) -> None\nrepeatedly create an event on the event queue"
-#define DOC_PYGAMETIMECLOCK "Clock() -> Clock\ncreate an object to help track time"
+#define DOC_PYGAMETIMECLOCK "Clock(history=0) -> Clock\ncreate an object to help track time"
 #define DOC_CLOCKTICK "tick(framerate=0) -> milliseconds\nupdate the clock"
 #define DOC_CLOCKTICKBUSYLOOP "tick_busy_loop(framerate=0) -> milliseconds\nupdate the clock"
 #define DOC_CLOCKGETTIME "get_time() -> milliseconds\ntime used in the previous tick"
 #define DOC_CLOCKGETRAWTIME "get_rawtime() -> milliseconds\nactual time used in the previous tick"
 #define DOC_CLOCKGETFPS "get_fps() -> float\ncompute the clock framerate"
+#define DOC_CLOCKGETJITTER "get_jitter() -> (mean, max)\nhow late the framerate delays ended"
+#define DOC_CLOCKGETFRAMETIMES "get_frame_times() -> memoryview\nthe frame times in the history"
+#define DOC_CLOCKGETFRAMESTATS "get_frame_stats() -> (p50, p95, p99, max)\npercentiles of the frame times in the history"
+#define DOC_PYGAMETIMEPROFILER "Profiler(frames=120, spans=64) -> Profiler\ncreate an object to time the parts of each frame"
+#define DOC_PROFILERFRAMEBEGIN "frame_begin() -> None\nstart timing a frame"
+#define DOC_PROFILERFRAMEEND "frame_end() -> milliseconds\nfinish timing a frame"
+#define DOC_PROFILERSPAN "span(name) -> Span\nget the context manager that times a part of a frame"
+#define DOC_PROFILERGETFRAMES "get_frames() -> list\nget the timings of the recorded frames"
+#define DOC_PROFILERCLEAR "clear() -> None\nforget the recorded frames"
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -37,7 +46,7 @@ pygame.time.set_timer
 repeatedly create an event on the event queue
 
 pygame.time.Clock
- Clock() -> Clock
+ Clock(history=0) -> Clock
 create an object to help track time
 
 pygame.time.Clock.tick
@@ -60,4 +69,40 @@ pygame.time.Clock.get_fps
  get_fps() -> float
 compute the clock framerate
 
+pygame.time.Clock.get_jitter
+ get_jitter() -> (mean, max)
+how late the framerate delays ended
+
+pygame.time.Clock.get_frame_times
+ get_frame_times() -> memoryview
+the frame times in the history
+
+pygame.time.Clock.get_frame_stats
+ get_frame_stats() -> (p50, p95, p99, max)
+percentiles of the frame times in the history
+
+pygame.time.Profiler
+ Profiler(frames=120, spans=64) -> Profiler
+create an object to time the parts of each frame
+
+pygame.time.Profiler.frame_begin
+ frame_begin() -> None
+start timing a frame
+
+pygame.time.Profiler.frame_end
+ frame_end() -> milliseconds
+finish timing a frame
+
+pygame.time.Profiler.span
+ span(name) -> Span
+get the context manager that times a part of a frame
+
+pygame.time.Profiler.get_frames
+ get_frames() -> list
+get the timings of the recorded frames
+
+pygame.time.Profiler.clear
+ clear() -> None
+forget the recorded frames
+
 */
\ No newline at end of file
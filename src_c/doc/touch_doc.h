@@ -4,6 +4,7 @@
 #define DOC_PYGAMESDL2TOUCHGETDEVICE "get_device(index) -> touchid\nget the a touch device id for a given index"
 #define DOC_PYGAMESDL2TOUCHGETNUMFINGERS "get_num_fingers(touchid) -> int\nthe number of active fingers for a given touch device"
 #define DOC_PYGAMESDL2TOUCHGETFINGER "get_finger(touchid, index) -> int\nget information about an active finger"
+#define DOC_PYGAMESDL2TOUCHGETFINGERS "get_fingers(touchid, out) -> int\nget the active fingers into a buffer of records"
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -29,4 +30,8 @@ pygame._sdl2.touch.get_finger
  get_finger(touchid, index) -> int
 get information about an active finger
 
+pygame._sdl2.touch.get_fingers
+ get_fingers(touchid, out) -> int
+get the active fingers into a buffer of records
+
 */
\ No newline at end of file
@@ -1,19 +1,39 @@
 /* Auto generated file: with makeref.py .  Docs go in docs/reST/ref/ . */
 #define DOC_PYGAMETRANSFORM "pygame module to transform surfaces"
-#define DOC_PYGAMETRANSFORMFLIP "flip(surface, flip_x, flip_y) -> Surface\nflip vertically and horizontally"
-#define DOC_PYGAMETRANSFORMSCALE "scale(surface, size, dest_surface=None) -> Surface\nresize to new resolution"
+#define DOC_PYGAMETRANSFORMFLIP "flip(surface, flip_x, flip_y, dest_surface=None, pool=None) -> Surface\nflip vertically and horizontally"
+#define DOC_PYGAMETRANSFORMSCALE "scale(surface, size, dest_surface=None, pool=None) -> Surface\nresize to new resolution"
 #define DOC_PYGAMETRANSFORMSCALEBY "scale_by(surface, factor, dest_surface=None) -> Surface\nresize to new resolution, using scalar(s)"
-#define DOC_PYGAMETRANSFORMROTATE "rotate(surface, angle) -> Surface\nrotate an image"
-#define DOC_PYGAMETRANSFORMROTOZOOM "rotozoom(surface, angle, scale) -> Surface\nfiltered scale and rotation"
+#define DOC_PYGAMETRANSFORMROTATE "rotate(surface, angle, dest_surface=None, pool=None) -> Surface\nrotate an image"
+#define DOC_PYGAMETRANSFORMROTOZOOM "rotozoom(surface, angle, scale, dest_surface=None, pool=None) -> Surface\nfiltered scale and rotation"
+#define DOC_PYGAMETRANSFORMAFFINE "affine(surface, matrix, size=None, smooth=True) -> Surface\napply an affine transform in one filtered pass"
 #define DOC_PYGAMETRANSFORMSCALE2X "scale2x(surface, dest_surface=None) -> Surface\nspecialized image doubler"
-#define DOC_PYGAMETRANSFORMSMOOTHSCALE "smoothscale(surface, size, dest_surface=None) -> Surface\nscale a surface to an arbitrary size smoothly"
+#define DOC_PYGAMETRANSFORMSCALE3X "scale3x(surface, dest_surface=None) -> Surface\nspecialized image tripler"
+#define DOC_PYGAMETRANSFORMSCALEBYINT "scale_by_int(surface, factor, dest_surface=None, pool=None) -> Surface\nscale a surface up by a whole factor"
+#define DOC_PYGAMETRANSFORMSMOOTHSCALE "smoothscale(surface, size, dest_surface=None, pool=None) -> Surface\nscale a surface to an arbitrary size smoothly"
 #define DOC_PYGAMETRANSFORMSMOOTHSCALEBY "smoothscale_by(surface, factor, dest_surface=None) -> Surface\nresize to new resolution, using scalar(s)"
-#define DOC_PYGAMETRANSFORMGETSMOOTHSCALEBACKEND "get_smoothscale_backend() -> string\nreturn smoothscale filter version in use: 'GENERIC', 'MMX', or 'SSE'"
-#define DOC_PYGAMETRANSFORMSETSMOOTHSCALEBACKEND "set_smoothscale_backend(backend) -> None\nset smoothscale filter version to one of: 'GENERIC', 'MMX', or 'SSE'"
-#define DOC_PYGAMETRANSFORMCHOP "chop(surface, rect) -> Surface\ngets a copy of an image with an interior area removed"
+#define DOC_PYGAMETRANSFORMGETSMOOTHSCALEBACKEND "get_smoothscale_backend() -> string\nreturn smoothscale filter version in use: 'GENERIC', 'SSE2', 'NEON', 'MMX', or 'SSE'"
+#define DOC_PYGAMETRANSFORMSETSMOOTHSCALEBACKEND "set_smoothscale_backend(backend) -> None\nset smoothscale filter version to one of: 'GENERIC', 'SSE2', 'NEON', 'MMX', or 'SSE'"
+#define DOC_PYGAMETRANSFORMRESAMPLE "resample(surface, size, filter=\"bicubic\", dest_surface=None) -> Surface\nresize using a bilinear, bicubic or Lanczos filter"
+#define DOC_PYGAMETRANSFORMROTATIONCACHE "RotationCache(surface, steps=36, smooth=False) -> RotationCache\nrotated copies of a surface, packed into one atlas"
+#define DOC_ROTATIONCACHEGET "get(angle) -> Surface\nget the surface rotated to the nearest step"
+#define DOC_ROTATIONCACHERENDERALL "render_all() -> None\nrender every step ahead of time"
+#define DOC_ROTATIONCACHEATLAS "atlas -> Surface or None\nthe surface holding the rendered steps"
+#define DOC_ROTATIONCACHESTEPS "steps -> int\nnumber of angles a full turn is split into"
+#define DOC_ROTATIONCACHESMOOTH "smooth -> bool\nwhether steps are rendered with rotozoom"
+#define DOC_PYGAMETRANSFORMCHOP "chop(surface, rect, dest_surface=None) -> Surface\ngets a copy of an image with an interior area removed"
+#define DOC_PYGAMETRANSFORMSPLITGRID "split_grid(surface, cell_size, as_atlas=False) -> list\nsplit_grid(surface, cell_size, as_atlas=True) -> (Surface, list)\ncuts an image into a grid of cells"
 #define DOC_PYGAMETRANSFORMLAPLACIAN "laplacian(surface, dest_surface=None) -> Surface\nfind edges in a surface"
+#define DOC_PYGAMETRANSFORMSOBEL "sobel(surface, output='magnitude', threshold=128, dest_surface=None) -> Surface or Mask\nfind edges in a surface with the Sobel operator"
+#define DOC_PYGAMETRANSFORMSCHARR "scharr(surface, output='magnitude', threshold=128, dest_surface=None) -> Surface or Mask\nfind edges in a surface with the Scharr operator"
+#define DOC_PYGAMETRANSFORMBOXBLUR "box_blur(surface, radius, repeat_edge_pixels=True, dest_surface=None) -> Surface\nblur a surface with a box filter"
+#define DOC_PYGAMETRANSFORMGAUSSIANBLUR "gaussian_blur(surface, radius, repeat_edge_pixels=True, dest_surface=None) -> Surface\nblur a surface with a gaussian filter"
+#define DOC_PYGAMETRANSFORMCONVOLVE "convolve(surface, kernel, repeat_edge_pixels=True, dest_surface=None) -> Surface\nfilter a surface with a convolution kernel"
 #define DOC_PYGAMETRANSFORMAVERAGESURFACES "average_surfaces(surfaces, dest_surface=None, palette_colors=1) -> Surface\nfind the average surface from many surfaces."
 #define DOC_PYGAMETRANSFORMAVERAGECOLOR "average_color(surface, rect=None, consider_alpha=False) -> Color\nfinds the average color of a surface"
+#define DOC_PYGAMETRANSFORMHISTOGRAM "histogram(surface, channels='rgb', bins=256, rect=None) -> tuple\ncounts the values of the channels of a surface"
+#define DOC_PYGAMETRANSFORMCOLORKEYTOALPHA "colorkey_to_alpha(surface, dest_surface=None) -> Surface\nturns the colorkey of a surface into per pixel alpha"
+#define DOC_PYGAMETRANSFORMALPHATOCOLORKEY "alpha_to_colorkey(surface, threshold=128, colorkey=(255, 0, 255)) -> Surface\nturns the per pixel alpha of a surface into a colorkey"
+#define DOC_PYGAMETRANSFORMCOMPOSELIGHTS "compose_lights(scene, ambient, lights, dest_surface=None) -> Surface\nlights a scene with an ambient colour and additive light sprites"
 #define DOC_PYGAMETRANSFORMTHRESHOLD "threshold(dest_surface, surface, search_color, threshold=(0,0,0,0), set_color=(0,0,0,0), set_behavior=1, search_surf=None, inverse_set=False) -> num_threshold_pixels\nfinds which, and how many pixels in a surface are within a threshold of a 'search_color' or a 'search_surf'."
 
 
@@ -25,11 +45,11 @@ pygame.transform
 pygame module to transform surfaces
 
 pygame.transform.flip
- flip(surface, flip_x, flip_y) -> Surface
+ flip(surface, flip_x, flip_y, dest_surface=None, pool=None) -> Surface
 flip vertically and horizontally
 
 pygame.transform.scale
- scale(surface, size, dest_surface=None) -> Surface
+ scale(surface, size, dest_surface=None, pool=None) -> Surface
 resize to new resolution
 
 pygame.transform.scale_by
@@ -37,19 +57,31 @@ pygame.transform.scale_by
 resize to new resolution, using scalar(s)
 
 pygame.transform.rotate
- rotate(surface, angle) -> Surface
+ rotate(surface, angle, dest_surface=None, pool=None) -> Surface
 rotate an image
 
 pygame.transform.rotozoom
- rotozoom(surface, angle, scale) -> Surface
+ rotozoom(surface, angle, scale, dest_surface=None, pool=None) -> Surface
 filtered scale and rotation
 
+pygame.transform.affine
+ affine(surface, matrix, size=None, smooth=True) -> Surface
+apply an affine transform in one filtered pass
+
 pygame.transform.scale2x
  scale2x(surface, dest_surface=None) -> Surface
 specialized image doubler
 
+pygame.transform.scale3x
+ scale3x(surface, dest_surface=None) -> Surface
+specialized image tripler
+
+pygame.transform.scale_by_int
+ scale_by_int(surface, factor, dest_surface=None, pool=None) -> Surface
+scale a surface up by a whole factor
+
 pygame.transform.smoothscale
- smoothscale(surface, size, dest_surface=None) -> Surface
+ smoothscale(surface, size, dest_surface=None, pool=None) -> Surface
 scale a surface to an arbitrary size smoothly
 
 pygame.transform.smoothscale_by
@@ -58,20 +90,73 @@ resize to new resolution, using scalar(s)
 
 pygame.transform.get_smoothscale_backend
  get_smoothscale_backend() -> string
-return smoothscale filter version in use: 'GENERIC', 'MMX', or 'SSE'
+return smoothscale filter version in use: 'GENERIC', 'SSE2', 'NEON', 'MMX', or 'SSE'
 
 pygame.transform.set_smoothscale_backend
  set_smoothscale_backend(backend) -> None
-set smoothscale filter version to one of: 'GENERIC', 'MMX', or 'SSE'
+set smoothscale filter version to one of: 'GENERIC', 'SSE2', 'NEON', 'MMX', or 'SSE'
+
+pygame.transform.resample
+ resample(surface, size, filter="bicubic", dest_surface=None) -> Surface
+resize using a bilinear, bicubic or Lanczos filter
+
+pygame.transform.RotationCache
+ RotationCache(surface, steps=36, smooth=False) -> RotationCache
+rotated copies of a surface, packed into one atlas
+
+pygame.transform.RotationCache.get
+ get(angle) -> Surface
+get the surface rotated to the nearest step
+
+pygame.transform.RotationCache.render_all
+ render_all() -> None
+render every step ahead of time
+
+pygame.transform.RotationCache.atlas
+ atlas -> Surface or None
+the surface holding the rendered steps
+
+pygame.transform.RotationCache.steps
+ steps -> int
+number of angles a full turn is split into
+
+pygame.transform.RotationCache.smooth
+ smooth -> bool
+whether steps are rendered with rotozoom
 
 pygame.transform.chop
- chop(surface, rect) -> Surface
+ chop(surface, rect, dest_surface=None) -> Surface
 gets a copy of an image with an interior area removed
 
+pygame.transform.split_grid
+ split_grid(surface, cell_size, as_atlas=False) -> list
+ split_grid(surface, cell_size, as_atlas=True) -> (Surface, list)
+cuts an image into a grid of cells
+
 pygame.transform.laplacian
  laplacian(surface, dest_surface=None) -> Surface
 find edges in a surface
 
+pygame.transform.sobel
+ sobel(surface, output='magnitude', threshold=128, dest_surface=None) -> Surface or Mask
+find edges in a surface with the Sobel operator
+
+pygame.transform.scharr
+ scharr(surface, output='magnitude', threshold=128, dest_surface=None) -> Surface or Mask
+find edges in a surface with the Scharr operator
+
+pygame.transform.box_blur
+ box_blur(surface, radius, repeat_edge_pixels=True, dest_surface=None) -> Surface
+blur a surface with a box filter
+
+pygame.transform.gaussian_blur
+ gaussian_blur(surface, radius, repeat_edge_pixels=True, dest_surface=None) -> Surface
+blur a surface with a gaussian filter
+
+pygame.transform.convolve
+ convolve(surface, kernel, repeat_edge_pixels=True, dest_surface=None) -> Surface
+filter a surface with a convolution kernel
+
 pygame.transform.average_surfaces
  average_surfaces(surfaces, dest_surface=None, palette_colors=1) -> Surface
 find the average surface from many surfaces.
@@ -80,6 +165,22 @@ pygame.transform.average_color
  average_color(surface, rect=None, consider_alpha=False) -> Color
 finds the average color of a surface
 
+pygame.transform.histogram
+ histogram(surface, channels='rgb', bins=256, rect=None) -> tuple
+counts the values of the channels of a surface
+
+pygame.transform.colorkey_to_alpha
+ colorkey_to_alpha(surface, dest_surface=None) -> Surface
+turns the colorkey of a surface into per pixel alpha
+
+pygame.transform.alpha_to_colorkey
+ alpha_to_colorkey(surface, threshold=128, colorkey=(255, 0, 255)) -> Surface
+turns the per pixel alpha of a surface into a colorkey
+
+pygame.transform.compose_lights
+ compose_lights(scene, ambient, lights, dest_surface=None) -> Surface
+lights a scene with an ambient colour and additive light sprites
+
 pygame.transform.threshold
  threshold(dest_surface, surface, search_color, threshold=(0,0,0,0), set_color=(0,0,0,0), set_behavior=1, search_surf=None, inverse_set=False) -> num_threshold_pixels
 finds which, and how many pixels in a surface are within a threshold of a 'search_color' or a 'search_surf'.
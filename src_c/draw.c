@@ -47,6 +47,12 @@ draw_line(SDL_Surface *surf, int x1, int y1, int x2, int y2, Uint32 color,
 static void
 draw_aaline(SDL_Surface *surf, Uint32 color, float startx, float starty,
             float endx, float endy, int blend, int *drawn_area);
+static int
+aalines32_supported(SDL_Surface *surf);
+static void
+draw_aalines32(SDL_Surface *surf, Uint32 color, const float *xlist,
+               const float *ylist, Py_ssize_t length, int closed, int blend,
+               int *drawn_area);
 static void
 draw_arc(SDL_Surface *surf, int x, int y, int radius1, int radius2,
          double angle_start, double angle_stop, Uint32 color, int *drawn_area);
@@ -70,9 +76,25 @@ static void
 draw_ellipse_thickness(SDL_Surface *surf, int x0, int y0, int width,
                        int height, int thickness, Uint32 color,
                        int *drawn_area);
+/* A surface tiled across the plane, with its top left corner at (x, y),
+ * for draw_fillpoly to copy spans from instead of a solid color
+ */
+typedef struct {
+    SDL_Surface *surf;
+    int x, y;
+} FillTexture;
+
 static void
 draw_fillpoly(SDL_Surface *surf, int *vx, int *vy, Py_ssize_t n, Uint32 color,
-              int *drawn_area);
+              const FillTexture *texture, int *drawn_area);
+static void
+draw_linear_gradient(SDL_Surface *surf, SDL_Rect *area, const Uint32 *lut,
+                     int last, double t, double dtx, double dty, Uint32 *row,
+                     int *drawn_area);
+static void
+draw_radial_gradient(SDL_Surface *surf, float cx, float cy, float radius,
+                     const Uint32 *lut, int last, Uint32 *row,
+                     int *drawn_area);
 static void
 draw_rect(SDL_Surface *surf, int x1, int y1, int x2, int y2, int width,
           Uint32 color);
@@ -81,6 +103,49 @@ draw_round_rect(SDL_Surface *surf, int x1, int y1, int x2, int y2, int radius,
                 int width, Uint32 color, int top_left, int top_right,
                 int bottom_left, int bottom_right, int *drawn_area);
 
+/* Filled shapes kept in the span cache, named by a key of the shape kind
+ * followed by the sizes the drawing function takes
+ */
+#define SHAPE_KEY_LEN 9
+enum { SHAPE_ELLIPSE = 1, SHAPE_ROUND_RECT };
+
+static void
+draw_shape_cached(SDL_Surface *surf, const int *key, int x, int y,
+                  Uint32 color, int *drawn_area);
+static void
+add_pixel_to_drawn_list(int x, int y, int *pts);
+
+/* Coverage accumulation for antialiased filled shapes. cells holds, for
+ * each pixel of the w by h box at (left, top), how much the area covered
+ * changes from the pixel before it on the row, so a running sum along a
+ * row gives the coverage of each pixel. Rows have two spare cells for
+ * edges on the right border.
+ */
+typedef struct {
+    float *cells;
+    int left, top, w, h;
+    float startx, starty; /* first point of the current contour */
+    float curx, cury;     /* last point added */
+} AARaster;
+
+static int
+aa_raster_init(AARaster *r, SDL_Surface *surf, float minx, float miny,
+               float maxx, float maxy);
+static void
+aa_raster_move_to(AARaster *r, float x, float y);
+static void
+aa_raster_line_to(AARaster *r, float x, float y);
+static void
+aa_raster_close(AARaster *r);
+static void
+aa_raster_arc(AARaster *r, float cx, float cy, float rx, float ry,
+              double start, double stop);
+static void
+aa_raster_piece(AARaster *r, const float *xs, const float *ys, int n);
+static void
+aa_raster_fill(AARaster *r, SDL_Surface *surf, Uint32 color,
+               int *drawn_area);
+
 // validation of a draw color
 #define CHECK_LOAD_COLOR(colorobj)                                         \
     if (PyLong_Check(colorobj))                                            \
@@ -91,6 +156,35 @@ draw_round_rect(SDL_Surface *surf, int x1, int y1, int x2, int y2, int radius,
     else                                                                   \
         return NULL; /* pg_RGBAFromFuzzyColorObj sets the exception for us */
 
+/* Returns the Rect bounding drawn_area, also recording it as damage on
+ * surfobj.
+ */
+static PyObject *
+_drawn_area_rect(pgSurfaceObject *surfobj, int *drawn_area)
+{
+    SDL_Rect area;
+
+    area.x = drawn_area[0];
+    area.y = drawn_area[1];
+    area.w = drawn_area[2] - drawn_area[0] + 1;
+    area.h = drawn_area[3] - drawn_area[1] + 1;
+    pgSurface_AddDamage(surfobj, &area);
+    return pgRect_New(&area);
+}
+
+/* Returns the number of pixels in the box bounding drawn_area, or 0 if
+ * nothing was drawn. Used to count the pixels drawn in pygame.stats().
+ */
+static Sint64
+_drawn_area_pixels(const int *drawn_area)
+{
+    if (drawn_area[0] == INT_MAX || drawn_area[1] == INT_MAX ||
+        drawn_area[2] == INT_MIN || drawn_area[3] == INT_MIN)
+        return 0;
+    return (Sint64)(drawn_area[2] - drawn_area[0] + 1) *
+           (drawn_area[3] - drawn_area[1] + 1);
+}
+
 /* Definition of functions that get called in Python */
 
 /* Draws an antialiased line on the given surface.
@@ -110,6 +204,7 @@ aaline(PyObject *self, PyObject *arg, PyObject *kwargs)
                          INT_MIN}; /* Used to store bounding box values */
     Uint8 rgba[4];
     Uint32 color;
+    Uint64 stats_start;
     static char *keywords[] = {"surface", "color", "start_pos",
                                "end_pos", "blend", NULL};
 
@@ -147,6 +242,7 @@ aaline(PyObject *self, PyObject *arg, PyObject *kwargs)
         return RAISE(PyExc_TypeError, "invalid end_pos argument");
     }
 
+    stats_start = pg_StatsBegin();
     if (!pgSurface_Lock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error locking surface");
     }
@@ -158,15 +254,15 @@ aaline(PyObject *self, PyObject *arg, PyObject *kwargs)
     draw_aaline(surf, color, pts[0], pts[1], pts[2], pts[3], blend,
                 drawn_area);
 
+    pg_StatsEnd(PG_STAT_DRAW, "aaline", stats_start,
+                _drawn_area_pixels(drawn_area));
     if (!pgSurface_Unlock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
 
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
         drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
+        return _drawn_area_rect(surfobj, drawn_area);
     else
         return pgRect_New4((int)startx, (int)starty, 0, 0);
 }
@@ -187,6 +283,7 @@ line(PyObject *self, PyObject *arg, PyObject *kwargs)
     int width = 1; /* Default width. */
     int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
                          INT_MIN}; /* Used to store bounding box values */
+    Uint64 stats_start;
     static char *keywords[] = {"surface", "color", "start_pos",
                                "end_pos", "width", NULL};
 
@@ -218,6 +315,7 @@ line(PyObject *self, PyObject *arg, PyObject *kwargs)
         return pgRect_New4(startx, starty, 0, 0);
     }
 
+    stats_start = pg_StatsBegin();
     if (!pgSurface_Lock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error locking surface");
     }
@@ -225,6 +323,8 @@ line(PyObject *self, PyObject *arg, PyObject *kwargs)
     draw_line_width(surf, color, startx, starty, endx, endy, width,
                     drawn_area);
 
+    pg_StatsEnd(PG_STAT_DRAW, "line", stats_start,
+                _drawn_area_pixels(drawn_area));
     if (!pgSurface_Unlock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
@@ -232,9 +332,7 @@ line(PyObject *self, PyObject *arg, PyObject *kwargs)
     /* Compute return rect. */
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
         drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
+        return _drawn_area_rect(surfobj, drawn_area);
     else
         return pgRect_New4(startx, starty, 0, 0);
 }
@@ -261,6 +359,7 @@ aalines(PyObject *self, PyObject *arg, PyObject *kwargs)
     int result, closed;
     int blend = 1; /* Default blend. */
     Py_ssize_t loop, length;
+    Uint64 stats_start;
     static char *keywords[] = {"surface", "color", "closed",
                                "points",  "blend", NULL};
 
@@ -335,32 +434,41 @@ aalines(PyObject *self, PyObject *arg, PyObject *kwargs)
         ylist[loop] = y;
     }
 
+    stats_start = pg_StatsBegin();
     if (!pgSurface_Lock(surfobj)) {
         PyMem_Free(xlist);
         PyMem_Free(ylist);
         return RAISE(PyExc_RuntimeError, "error locking surface");
     }
 
-    for (loop = 1; loop < length; ++loop) {
-        pts[0] = xlist[loop - 1];
-        pts[1] = ylist[loop - 1];
-        pts[2] = xlist[loop];
-        pts[3] = ylist[loop];
-        draw_aaline(surf, color, pts[0], pts[1], pts[2], pts[3], blend,
-                    drawn_area);
+    if (aalines32_supported(surf)) {
+        draw_aalines32(surf, color, xlist, ylist, length, closed, blend,
+                       drawn_area);
     }
-    if (closed && length > 2) {
-        pts[0] = xlist[length - 1];
-        pts[1] = ylist[length - 1];
-        pts[2] = xlist[0];
-        pts[3] = ylist[0];
-        draw_aaline(surf, color, pts[0], pts[1], pts[2], pts[3], blend,
-                    drawn_area);
+    else {
+        for (loop = 1; loop < length; ++loop) {
+            pts[0] = xlist[loop - 1];
+            pts[1] = ylist[loop - 1];
+            pts[2] = xlist[loop];
+            pts[3] = ylist[loop];
+            draw_aaline(surf, color, pts[0], pts[1], pts[2], pts[3], blend,
+                        drawn_area);
+        }
+        if (closed && length > 2) {
+            pts[0] = xlist[length - 1];
+            pts[1] = ylist[length - 1];
+            pts[2] = xlist[0];
+            pts[3] = ylist[0];
+            draw_aaline(surf, color, pts[0], pts[1], pts[2], pts[3], blend,
+                        drawn_area);
+        }
     }
 
     PyMem_Free(xlist);
     PyMem_Free(ylist);
 
+    pg_StatsEnd(PG_STAT_DRAW, "aalines", stats_start,
+                _drawn_area_pixels(drawn_area));
     if (!pgSurface_Unlock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
@@ -368,9 +476,7 @@ aalines(PyObject *self, PyObject *arg, PyObject *kwargs)
     /* Compute return rect. */
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
         drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
+        return _drawn_area_rect(surfobj, drawn_area);
     else
         return pgRect_New4(l, t, 0, 0);
 }
@@ -394,6 +500,7 @@ lines(PyObject *self, PyObject *arg, PyObject *kwargs)
     Py_ssize_t loop, length;
     int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
                          INT_MIN}; /* Used to store bounding box values */
+    Uint64 stats_start;
     static char *keywords[] = {"surface", "color", "closed",
                                "points",  "width", NULL};
 
@@ -463,6 +570,7 @@ lines(PyObject *self, PyObject *arg, PyObject *kwargs)
         return pgRect_New4(x, y, 0, 0);
     }
 
+    stats_start = pg_StatsBegin();
     if (!pgSurface_Lock(surfobj)) {
         PyMem_Free(xlist);
         PyMem_Free(ylist);
@@ -482,6 +590,8 @@ lines(PyObject *self, PyObject *arg, PyObject *kwargs)
     PyMem_Free(xlist);
     PyMem_Free(ylist);
 
+    pg_StatsEnd(PG_STAT_DRAW, "lines", stats_start,
+                _drawn_area_pixels(drawn_area));
     if (!pgSurface_Unlock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
@@ -489,9 +599,7 @@ lines(PyObject *self, PyObject *arg, PyObject *kwargs)
     /* Compute return rect. */
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
         drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
+        return _drawn_area_rect(surfobj, drawn_area);
     else
         return pgRect_New4(x, y, 0, 0);
 }
@@ -510,6 +618,7 @@ arc(PyObject *self, PyObject *arg, PyObject *kwargs)
     int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
                          INT_MIN}; /* Used to store bounding box values */
     double angle_start, angle_stop;
+    Uint64 stats_start;
     static char *keywords[] = {"surface",    "color", "rect", "start_angle",
                                "stop_angle", "width", NULL};
 
@@ -548,6 +657,7 @@ arc(PyObject *self, PyObject *arg, PyObject *kwargs)
         angle_stop += 2 * M_PI;
     }
 
+    stats_start = pg_StatsBegin();
     if (!pgSurface_Lock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error locking surface");
     }
@@ -560,6 +670,8 @@ arc(PyObject *self, PyObject *arg, PyObject *kwargs)
                  angle_stop, color, drawn_area);
     }
 
+    pg_StatsEnd(PG_STAT_DRAW, "arc", stats_start,
+                _drawn_area_pixels(drawn_area));
     if (!pgSurface_Unlock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
@@ -567,9 +679,7 @@ arc(PyObject *self, PyObject *arg, PyObject *kwargs)
     /* Compute return rect. */
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
         drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
+        return _drawn_area_rect(surfobj, drawn_area);
     else
         return pgRect_New4(rect->x, rect->y, 0, 0);
 }
@@ -586,6 +696,7 @@ ellipse(PyObject *self, PyObject *arg, PyObject *kwargs)
     int width = 0; /* Default width. */
     int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
                          INT_MIN}; /* Used to store bounding box values */
+    Uint64 stats_start;
     static char *keywords[] = {"surface", "color", "rect", "width", NULL};
 
     if (!PyArg_ParseTupleAndKeywords(arg, kwargs, "O!OO|i", keywords,
@@ -614,29 +725,30 @@ ellipse(PyObject *self, PyObject *arg, PyObject *kwargs)
         return pgRect_New4(rect->x, rect->y, 0, 0);
     }
 
+    stats_start = pg_StatsBegin();
     if (!pgSurface_Lock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error locking surface");
     }
 
     if (!width ||
         width >= MIN(rect->w / 2 + rect->w % 2, rect->h / 2 + rect->h % 2)) {
-        draw_ellipse_filled(surf, rect->x, rect->y, rect->w, rect->h, color,
-                            drawn_area);
+        int key[SHAPE_KEY_LEN] = {SHAPE_ELLIPSE, rect->w, rect->h};
+        draw_shape_cached(surf, key, rect->x, rect->y, color, drawn_area);
     }
     else {
         draw_ellipse_thickness(surf, rect->x, rect->y, rect->w, rect->h,
                                width - 1, color, drawn_area);
     }
 
+    pg_StatsEnd(PG_STAT_DRAW, "ellipse", stats_start,
+                _drawn_area_pixels(drawn_area));
     if (!pgSurface_Unlock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
 
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
         drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
+        return _drawn_area_rect(surfobj, drawn_area);
     else
         return pgRect_New4(rect->x, rect->y, 0, 0);
 }
@@ -655,6 +767,7 @@ circle(PyObject *self, PyObject *args, PyObject *kwargs)
     int top_right = 0, top_left = 0, bottom_left = 0, bottom_right = 0;
     int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
                          INT_MIN}; /* Used to store bounding box values */
+    Uint64 stats_start;
     static char *keywords[] = {"surface",
                                "color",
                                "center",
@@ -701,6 +814,7 @@ circle(PyObject *self, PyObject *args, PyObject *kwargs)
         width = radius;
     }
 
+    stats_start = pg_StatsBegin();
     if (!pgSurface_Lock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error locking surface");
     }
@@ -724,14 +838,14 @@ circle(PyObject *self, PyObject *args, PyObject *kwargs)
                              top_left, bottom_left, bottom_right, drawn_area);
     }
 
+    pg_StatsEnd(PG_STAT_DRAW, "circle", stats_start,
+                _drawn_area_pixels(drawn_area));
     if (!pgSurface_Unlock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
         drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
+        return _drawn_area_rect(surfobj, drawn_area);
     else
         return pgRect_New4(posx, posy, 0, 0);
 }
@@ -750,6 +864,7 @@ polygon(PyObject *self, PyObject *arg, PyObject *kwargs)
     int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
                          INT_MIN}; /* Used to store bounding box values */
     Py_ssize_t loop, length;
+    Uint64 stats_start;
     static char *keywords[] = {"surface", "color", "points", "width", NULL};
 
     if (!PyArg_ParseTupleAndKeywords(arg, kwargs, "O!OO|i", keywords,
@@ -827,25 +942,26 @@ polygon(PyObject *self, PyObject *arg, PyObject *kwargs)
         ylist[loop] = y;
     }
 
+    stats_start = pg_StatsBegin();
     if (!pgSurface_Lock(surfobj)) {
         PyMem_Free(xlist);
         PyMem_Free(ylist);
         return RAISE(PyExc_RuntimeError, "error locking surface");
     }
 
-    draw_fillpoly(surf, xlist, ylist, length, color, drawn_area);
+    draw_fillpoly(surf, xlist, ylist, length, color, NULL, drawn_area);
     PyMem_Free(xlist);
     PyMem_Free(ylist);
 
+    pg_StatsEnd(PG_STAT_DRAW, "polygon", stats_start,
+                _drawn_area_pixels(drawn_area));
     if (!pgSurface_Unlock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
 
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
         drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
+        return _drawn_area_rect(surfobj, drawn_area);
     else
         return pgRect_New4(l, t, 0, 0);
 }
@@ -866,8 +982,10 @@ rect(PyObject *self, PyObject *args, PyObject *kwargs)
     SDL_Rect cliprect;
     int result;
     SDL_Rect clipped;
+    int key[SHAPE_KEY_LEN];
     int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
                          INT_MIN}; /* Used to store bounding box values */
+    Uint64 stats_start;
     static char *keywords[] = {"surface",
                                "color",
                                "rect",
@@ -926,16 +1044,21 @@ rect(PyObject *self, PyObject *args, PyObject *kwargs)
         }
         else {
             pgSurface_Prep(surfobj);
-            pgSurface_Lock(surfobj);
+            if (!pgSurface_Lock(surfobj)) {
+                pgSurface_Unprep(surfobj);
+                return RAISE(PyExc_RuntimeError, "error locking surface");
+            }
             result = SDL_FillRect(surf, &clipped, color);
             pgSurface_Unlock(surfobj);
             pgSurface_Unprep(surfobj);
             if (result != 0)
                 return RAISE(pgExc_SDLError, SDL_GetError());
         }
+        pgSurface_AddDamage(surfobj, &clipped);
         return pgRect_New(&clipped);
     }
     else {
+        stats_start = pg_StatsBegin();
         if (!pgSurface_Lock(surfobj)) {
             return RAISE(PyExc_RuntimeError, "error locking surface");
         }
@@ -955,10 +1078,18 @@ rect(PyObject *self, PyObject *args, PyObject *kwargs)
             width = MAX(rect->w / 2, rect->h / 2);
         }
 
-        draw_round_rect(surf, rect->x, rect->y, rect->x + rect->w - 1,
-                        rect->y + rect->h - 1, radius, width, color,
-                        top_left_radius, top_right_radius, bottom_left_radius,
-                        bottom_right_radius, drawn_area);
+        key[0] = SHAPE_ROUND_RECT;
+        key[1] = rect->w;
+        key[2] = rect->h;
+        key[3] = width;
+        key[4] = radius;
+        key[5] = top_left_radius;
+        key[6] = top_right_radius;
+        key[7] = bottom_left_radius;
+        key[8] = bottom_right_radius;
+        draw_shape_cached(surf, key, rect->x, rect->y, color, drawn_area);
+        pg_StatsEnd(PG_STAT_DRAW, "rect", stats_start,
+                    _drawn_area_pixels(drawn_area));
         if (!pgSurface_Unlock(surfobj)) {
             return RAISE(PyExc_RuntimeError, "error unlocking surface");
         }
@@ -966,165 +1097,1825 @@ rect(PyObject *self, PyObject *args, PyObject *kwargs)
 
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
         drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
+        return _drawn_area_rect(surfobj, drawn_area);
     else
         return pgRect_New4(rect->x, rect->y, 0, 0);
 }
 
-/* Functions used in drawing algorithms */
-
-static void
-swap(float *a, float *b)
+/* Accept only native 32 bit integer buffer formats, signed or not, so
+ * mapped colors above 0x7FFFFFFF can come from a uint32 array.
+ */
+static int
+_is_int32_format(const char *format, Py_ssize_t itemsize)
 {
-    float temp = *a;
-    *a = *b;
-    *b = temp;
+    if (itemsize != 4 || !format)
+        return 0;
+    switch (*format) {
+        case '@':
+        case '=':
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        case '<':
+#else
+        case '>':
+        case '!':
+#endif
+            ++format;
+            break;
+    }
+    return (format[0] == 'i' || format[0] == 'l' || format[0] == 'I' ||
+            format[0] == 'L') &&
+           format[1] == '\0';
 }
 
-static int
-compare_int(const void *a, const void *b)
+/* Get a C contiguous buffer of 32 bit integers from obj, holding records
+ * of stride values each. When count is not negative the buffer must hold
+ * exactly count records. Returns the record count, or -1 with an
+ * exception set.
+ */
+static Py_ssize_t
+_get_int32_records(PyObject *obj, Py_buffer *view, int stride,
+                   Py_ssize_t count, const char *name)
 {
-    return (*(const int *)a) - (*(const int *)b);
+    Py_ssize_t length;
+
+    if (PyObject_GetBuffer(obj, view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) !=
+        0)
+        return -1;
+    if (!_is_int32_format(view->format, view->itemsize)) {
+        PyBuffer_Release(view);
+        PyErr_Format(PyExc_TypeError,
+                     "%s must be a buffer of 32 bit integers", name);
+        return -1;
+    }
+    length = view->len / view->itemsize;
+    if (length % stride != 0) {
+        PyBuffer_Release(view);
+        PyErr_Format(PyExc_ValueError, "%s must hold groups of %d values",
+                     name, stride);
+        return -1;
+    }
+    if (count >= 0 && length / stride != count) {
+        PyBuffer_Release(view);
+        PyErr_Format(PyExc_ValueError,
+                     "%s must hold %zd values, one for each item", name,
+                     count);
+        return -1;
+    }
+    return length / stride;
 }
 
-static int
-sign(int x, int y)
+/* Load the color argument of a batch draw: either one color for every
+ * item, or a buffer of count mapped colors. Returns the colors buffer,
+ * or NULL with *color set for a single color. Sets *failed with an
+ * exception set on error.
+ */
+static const Uint32 *
+_get_batch_colors(SDL_Surface *surf, PyObject *colorobj, Py_buffer *view,
+                  Py_ssize_t count, Uint32 *color, int *failed)
 {
-    return (x > 0) ? 1 : ((x < 0) ? -1 : y);
+    Uint8 rgba[4];
+
+    *failed = 0;
+    view->obj = NULL;
+    if (!PyLong_Check(colorobj) &&
+        PyObject_IsInstance(colorobj, &pgColor_Type) <= 0 &&
+        PyObject_CheckBuffer(colorobj)) {
+        if (_get_int32_records(colorobj, view, 1, count, "colors") < 0) {
+            *failed = 1;
+        }
+        return *failed ? NULL : (const Uint32 *)view->buf;
+    }
+    if (PyLong_Check(colorobj)) {
+        *color = (Uint32)PyLong_AsLong(colorobj);
+    }
+    else if (pg_RGBAFromFuzzyColorObj(colorobj, rgba)) {
+        *color = SDL_MapRGBA(surf->format, rgba[0], rgba[1], rgba[2], rgba[3]);
+    }
+    else {
+        *failed = 1;
+    }
+    return NULL;
 }
 
-static Uint32
-get_antialiased_color(SDL_Surface *surf, int x, int y, Uint32 original_color,
-                      float brightness, int blend)
+/* Shared checks of the batch draw functions. Returns the surface, or
+ * NULL with an exception set.
+ */
+static SDL_Surface *
+_batch_surface(pgSurfaceObject *surfobj)
 {
-    Uint8 color_part[4], background_color[4];
-    Uint32 *pixels = (Uint32 *)surf->pixels;
-    SDL_GetRGBA(original_color, surf->format, &color_part[0], &color_part[1],
-                &color_part[2], &color_part[3]);
-    if (blend) {
-        if (x < surf->clip_rect.x ||
-            x >= surf->clip_rect.x + surf->clip_rect.w ||
-            y < surf->clip_rect.y ||
-            y >= surf->clip_rect.y + surf->clip_rect.h)
-            return original_color;
-        SDL_GetRGBA(pixels[(y * surf->w) + x], surf->format,
-                    &background_color[0], &background_color[1],
-                    &background_color[2], &background_color[3]);
-        color_part[0] = (Uint8)(brightness * color_part[0] +
-                                (1 - brightness) * background_color[0]);
-        color_part[1] = (Uint8)(brightness * color_part[1] +
-                                (1 - brightness) * background_color[1]);
-        color_part[2] = (Uint8)(brightness * color_part[2] +
-                                (1 - brightness) * background_color[2]);
-        color_part[3] = (Uint8)(brightness * color_part[3] +
-                                (1 - brightness) * background_color[3]);
+    SDL_Surface *surf = pgSurface_AsSurface(surfobj);
+
+    if (!surf) {
+        PyErr_SetString(pgExc_SDLError, "display Surface quit");
+        return NULL;
     }
-    else {
-        color_part[0] = (Uint8)(brightness * color_part[0]);
-        color_part[1] = (Uint8)(brightness * color_part[1]);
-        color_part[2] = (Uint8)(brightness * color_part[2]);
-        color_part[3] = (Uint8)(brightness * color_part[3]);
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        PyErr_Format(PyExc_ValueError,
+                     "unsupported surface bit depth (%d) for drawing",
+                     surf->format->BytesPerPixel);
+        return NULL;
     }
-    original_color = SDL_MapRGBA(surf->format, color_part[0], color_part[1],
-                                 color_part[2], color_part[3]);
-    return original_color;
+    return surf;
 }
 
+/* Release the buffers of a batch draw, skipping those never taken */
 static void
-add_pixel_to_drawn_list(int x, int y, int *pts)
+_release_batch(Py_buffer *items, Py_buffer *values, Py_buffer *colors)
 {
-    if (x < pts[0]) {
-        pts[0] = x;
+    PyBuffer_Release(items);
+    if (values && values->obj)
+        PyBuffer_Release(values);
+    if (colors->obj)
+        PyBuffer_Release(colors);
+}
+
+/* Returns the Rect bounding drawn_area, or a zero size Rect at (0, 0) if
+ * nothing was drawn.
+ */
+static PyObject *
+_batch_result(pgSurfaceObject *surfobj, int *drawn_area)
+{
+    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
+        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
+        return _drawn_area_rect(surfobj, drawn_area);
+    return pgRect_New4(0, 0, 0, 0);
+}
+
+/* Draws many circles on the given surface, locking it once.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+circles(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *centersobj, *radiiobj;
+    SDL_Surface *surf;
+    Py_buffer centers, radii, colorview;
+    const Uint32 *colors;
+    const int *center, *radius_values = NULL;
+    Uint32 color = 0;
+    Py_ssize_t count, i;
+    int radius = 0, width = 0, thickness, failed;
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
+                         INT_MIN}; /* Used to store bounding box values */
+    Uint64 stats_start;
+    static char *keywords[] = {"surface", "color", "centers",
+                               "radii",   "width", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OOO|i", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &centersobj, &radiiobj, &width))
+        return NULL; /* Exception already set. */
+
+    if (!(surf = _batch_surface(surfobj)))
+        return NULL;
+
+    count = _get_int32_records(centersobj, &centers, 2, -1, "centers");
+    if (count < 0)
+        return NULL;
+
+    radii.obj = NULL;
+    if (!PyObject_CheckBuffer(radiiobj)) {
+        if (!pg_IntFromObj(radiiobj, &radius)) {
+            PyBuffer_Release(&centers);
+            return RAISE(PyExc_TypeError,
+                         "radii must be a number or a buffer of 32 bit "
+                         "integers");
+        }
     }
-    if (y < pts[1]) {
-        pts[1] = y;
+    else if (_get_int32_records(radiiobj, &radii, 1, count, "radii") < 0) {
+        PyBuffer_Release(&centers);
+        return NULL;
     }
-    if (x > pts[2]) {
-        pts[2] = x;
+    else {
+        radius_values = (const int *)radii.buf;
     }
-    if (y > pts[3]) {
-        pts[3] = y;
+
+    colors =
+        _get_batch_colors(surf, colorobj, &colorview, count, &color, &failed);
+    if (failed || width < 0) {
+        _release_batch(&centers, &radii, &colorview);
+        return failed ? NULL : pgRect_New4(0, 0, 0, 0);
+    }
+    stats_start = pg_StatsBegin();
+    if (!pgSurface_Lock(surfobj)) {
+        _release_batch(&centers, &radii, &colorview);
+        return RAISE(PyExc_RuntimeError, "error locking surface");
     }
-}
 
-static int
-clip_line(SDL_Surface *surf, int *x1, int *y1, int *x2, int *y2)
-{
-    int p1 = *x1 - *x2;
-    int p2 = -p1;
-    int p3 = *y1 - *y2;
-    int p4 = -p3;
-    int q1 = *x1 - surf->clip_rect.x;
-    int q2 = surf->clip_rect.w + surf->clip_rect.x - *x1;
-    int q3 = *y1 - surf->clip_rect.y;
-    int q4 = surf->clip_rect.h + surf->clip_rect.y - *y1;
-    int old_x1 = *x1;
-    int old_y1 = *y1;
-    double nmax = 0;
-    double pmin = 1;
-    double r1, r2;
-    if ((p1 == 0 && q1 < 0) || (p2 == 0 && q2 < 0) || (p3 == 0 && q3 < 0) ||
-        (p4 == 0 && q4 < 0))
-        return 0;
-    if (p1) {
-        r1 = (double)q1 / p1;
-        r2 = (double)q2 / p2;
-        if (p1 < 0) {
-            if (r1 > nmax)
-                nmax = r1;
-            if (r2 < pmin)
-                pmin = r2;
+    center = (const int *)centers.buf;
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < count; ++i, center += 2) {
+        if (radius_values)
+            radius = radius_values[i];
+        if (colors)
+            color = colors[i];
+        if (radius < 1)
+            continue;
+        thickness = MIN(width, radius);
+        if (!thickness || thickness == radius) {
+            draw_circle_filled(surf, center[0], center[1], radius, color,
+                               drawn_area);
+        }
+        else if (thickness == 1) {
+            draw_circle_bresenham_thin(surf, center[0], center[1], radius,
+                                       color, drawn_area);
         }
         else {
-            if (r2 > nmax)
-                nmax = r2;
-            if (r1 < pmin)
-                pmin = r1;
+            draw_circle_bresenham(surf, center[0], center[1], radius,
+                                  thickness, color, drawn_area);
         }
     }
-    if (p3) {
-        r1 = (double)q3 / p3;
-        r2 = (double)q4 / p4;
-        if (p3 < 0) {
-            if (r1 > nmax)
-                nmax = r1;
-            if (r2 < pmin)
-                pmin = r2;
+    Py_END_ALLOW_THREADS;
+
+    _release_batch(&centers, &radii, &colorview);
+    pg_StatsEnd(PG_STAT_DRAW, "circles", stats_start,
+                _drawn_area_pixels(drawn_area));
+    if (!pgSurface_Unlock(surfobj)) {
+        return RAISE(PyExc_RuntimeError, "error unlocking surface");
+    }
+    return _batch_result(surfobj, drawn_area);
+}
+
+/* Draws many rectangles on the given surface, locking it once.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+rects(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *rectsobj;
+    SDL_Surface *surf;
+    Py_buffer rectview, colorview;
+    const Uint32 *colors;
+    const int *rec;
+    SDL_Rect sdlrect, clipped;
+    Uint32 color = 0;
+    Py_ssize_t count, i;
+    int width = 0, result = 0, failed;
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
+                         INT_MIN}; /* Used to store bounding box values */
+    Uint64 stats_start;
+    static char *keywords[] = {"surface", "color", "rects", "width", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OO|i", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &rectsobj, &width))
+        return NULL; /* Exception already set. */
+
+    if (!(surf = _batch_surface(surfobj)))
+        return NULL;
+
+    count = _get_int32_records(rectsobj, &rectview, 4, -1, "rects");
+    if (count < 0)
+        return NULL;
+
+    colors =
+        _get_batch_colors(surf, colorobj, &colorview, count, &color, &failed);
+    if (failed || width < 0) {
+        _release_batch(&rectview, NULL, &colorview);
+        return failed ? NULL : pgRect_New4(0, 0, 0, 0);
+    }
+    stats_start = pg_StatsBegin();
+    if (!pgSurface_Lock(surfobj)) {
+        _release_batch(&rectview, NULL, &colorview);
+        return RAISE(PyExc_RuntimeError, "error locking surface");
+    }
+
+    rec = (const int *)rectview.buf;
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < count && !result; ++i, rec += 4) {
+        if (colors)
+            color = colors[i];
+        sdlrect.x = rec[0];
+        sdlrect.y = rec[1];
+        sdlrect.w = rec[2];
+        sdlrect.h = rec[3];
+        if (!SDL_IntersectRect(&sdlrect, &surf->clip_rect, &clipped))
+            continue;
+        if (width > 0 && (width * 2) < clipped.w && (width * 2) < clipped.h) {
+            draw_rect(surf, sdlrect.x, sdlrect.y, sdlrect.x + sdlrect.w - 1,
+                      sdlrect.y + sdlrect.h - 1, width, color);
         }
         else {
-            if (r2 > nmax)
-                nmax = r2;
-            if (r1 < pmin)
-                pmin = r1;
+            result = SDL_FillRect(surf, &clipped, color);
         }
+        add_pixel_to_drawn_list(clipped.x, clipped.y, drawn_area);
+        add_pixel_to_drawn_list(clipped.x + clipped.w - 1,
+                                clipped.y + clipped.h - 1, drawn_area);
     }
-    if (nmax > pmin)
-        return 0;
-    *x1 =
-        old_x1 + (int)(p2 * nmax < 0 ? (p2 * nmax - 0.5) : (p2 * nmax + 0.5));
-    *y1 =
-        old_y1 + (int)(p4 * nmax < 0 ? (p4 * nmax - 0.5) : (p4 * nmax + 0.5));
-    *x2 =
-        old_x1 + (int)(p2 * pmin < 0 ? (p2 * pmin - 0.5) : (p2 * pmin + 0.5));
-    *y2 =
-        old_y1 + (int)(p4 * pmin < 0 ? (p4 * pmin - 0.5) : (p4 * pmin + 0.5));
-    return 1;
+    Py_END_ALLOW_THREADS;
+
+    _release_batch(&rectview, NULL, &colorview);
+    pg_StatsEnd(PG_STAT_DRAW, "rects", stats_start,
+                _drawn_area_pixels(drawn_area));
+    if (!pgSurface_Unlock(surfobj)) {
+        return RAISE(PyExc_RuntimeError, "error unlocking surface");
+    }
+    if (result) {
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    return _batch_result(surfobj, drawn_area);
 }
 
-static int
-set_at(SDL_Surface *surf, int x, int y, Uint32 color)
+/* Draws many separate line segments on the given surface, locking it
+ * once.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+line_segments(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    SDL_PixelFormat *format = surf->format;
-    Uint8 *pixels = (Uint8 *)surf->pixels;
-    Uint8 *byte_buf, rgb[4];
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *segmentsobj;
+    SDL_Surface *surf;
+    Py_buffer segview, colorview;
+    const Uint32 *colors;
+    const int *seg;
+    Uint32 color = 0;
+    Py_ssize_t count, i;
+    int width = 1, failed; /* Default width. */
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
+                         INT_MIN}; /* Used to store bounding box values */
+    Uint64 stats_start;
+    static char *keywords[] = {"surface", "color", "segments", "width", NULL};
 
-    if (x < surf->clip_rect.x || x >= surf->clip_rect.x + surf->clip_rect.w ||
-        y < surf->clip_rect.y || y >= surf->clip_rect.y + surf->clip_rect.h)
-        return 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OO|i", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &segmentsobj, &width))
+        return NULL; /* Exception already set. */
 
-    switch (format->BytesPerPixel) {
+    if (!(surf = _batch_surface(surfobj)))
+        return NULL;
+
+    count = _get_int32_records(segmentsobj, &segview, 4, -1, "segments");
+    if (count < 0)
+        return NULL;
+
+    colors =
+        _get_batch_colors(surf, colorobj, &colorview, count, &color, &failed);
+    if (failed || width < 1) {
+        _release_batch(&segview, NULL, &colorview);
+        return failed ? NULL : pgRect_New4(0, 0, 0, 0);
+    }
+    stats_start = pg_StatsBegin();
+    if (!pgSurface_Lock(surfobj)) {
+        _release_batch(&segview, NULL, &colorview);
+        return RAISE(PyExc_RuntimeError, "error locking surface");
+    }
+
+    seg = (const int *)segview.buf;
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < count; ++i, seg += 4) {
+        if (colors)
+            color = colors[i];
+        draw_line_width(surf, color, seg[0], seg[1], seg[2], seg[3], width,
+                        drawn_area);
+    }
+    Py_END_ALLOW_THREADS;
+
+    _release_batch(&segview, NULL, &colorview);
+    pg_StatsEnd(PG_STAT_DRAW, "line_segments", stats_start,
+                _drawn_area_pixels(drawn_area));
+    if (!pgSurface_Unlock(surfobj)) {
+        return RAISE(PyExc_RuntimeError, "error unlocking surface");
+    }
+    return _batch_result(surfobj, drawn_area);
+}
+
+/* Fill the outline added to r on the surface, then free r.
+ *
+ * Returns a Rect bounding the drawn area, or a zero size Rect at (x, y) if
+ * nothing was drawn.
+ */
+static PyObject *
+_aa_fill_result(pgSurfaceObject *surfobj, AARaster *r, Uint32 color, int x,
+                int y)
+{
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
+                         INT_MIN}; /* Used to store bounding box values */
+    Uint64 stats_start;
+
+    if (!pgSurface_Lock(surfobj)) {
+        PyMem_Free(r->cells);
+        return RAISE(PyExc_RuntimeError, "error locking surface");
+    }
+    stats_start = pg_StatsBegin();
+    aa_raster_close(r);
+    aa_raster_fill(r, pgSurface_AsSurface(surfobj), color, drawn_area);
+    pg_StatsEnd(PG_STAT_DRAW, "aa_fill", stats_start,
+                _drawn_area_pixels(drawn_area));
+    PyMem_Free(r->cells);
+    if (!pgSurface_Unlock(surfobj)) {
+        return RAISE(PyExc_RuntimeError, "error unlocking surface");
+    }
+
+    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
+        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
+        return _drawn_area_rect(surfobj, drawn_area);
+    else
+        return pgRect_New4(x, y, 0, 0);
+}
+
+/* Fill the polygon of the n points in xlist and ylist, n > 0.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+_fill_points(pgSurfaceObject *surfobj, Uint32 color, const float *xlist,
+             const float *ylist, Py_ssize_t length)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(surfobj);
+    float minx, miny, maxx, maxy;
+    AARaster r;
+    int result;
+    Py_ssize_t loop;
+
+    minx = maxx = xlist[0];
+    miny = maxy = ylist[0];
+    for (loop = 1; loop < length; ++loop) {
+        minx = MIN(minx, xlist[loop]);
+        maxx = MAX(maxx, xlist[loop]);
+        miny = MIN(miny, ylist[loop]);
+        maxy = MAX(maxy, ylist[loop]);
+    }
+
+    result = aa_raster_init(&r, surf, minx, miny, maxx, maxy);
+    if (result > 0) {
+        aa_raster_move_to(&r, xlist[0], ylist[0]);
+        for (loop = 1; loop < length; ++loop) {
+            aa_raster_line_to(&r, xlist[loop], ylist[loop]);
+        }
+    }
+
+    if (result < 0) {
+        return RAISE(PyExc_MemoryError,
+                     "cannot allocate memory to draw polygon");
+    }
+    if (result == 0) {
+        return pgRect_New4((int)xlist[0], (int)ylist[0], 0, 0);
+    }
+    return _aa_fill_result(surfobj, &r, color, (int)xlist[0], (int)ylist[0]);
+}
+
+/* Draws an antialiased filled polygon on the given surface.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+aapolygon(PyObject *self, PyObject *arg, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *points, *item, *ret;
+    SDL_Surface *surf = NULL;
+    Uint8 rgba[4];
+    Uint32 color;
+    float *xlist, *ylist;
+    int result;
+    Py_ssize_t loop, length;
+    static char *keywords[] = {"surface", "color", "points", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(arg, kwargs, "O!OO", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &points)) {
+        return NULL; /* Exception already set. */
+    }
+
+    surf = pgSurface_AsSurface(surfobj);
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
+
+    CHECK_LOAD_COLOR(colorobj)
+
+    if (!PySequence_Check(points)) {
+        return RAISE(PyExc_TypeError,
+                     "points argument must be a sequence of number pairs");
+    }
+
+    length = PySequence_Length(points);
+
+    if (length < 3) {
+        return RAISE(PyExc_ValueError,
+                     "points argument must contain more than 2 points");
+    }
+
+    xlist = PyMem_New(float, length);
+    ylist = PyMem_New(float, length);
+
+    if (NULL == xlist || NULL == ylist) {
+        PyMem_Free(xlist);
+        PyMem_Free(ylist);
+        return RAISE(PyExc_MemoryError,
+                     "cannot allocate memory to draw polygon");
+    }
+
+    for (loop = 0; loop < length; ++loop) {
+        item = PySequence_GetItem(points, loop);
+        result = item && pg_TwoFloatsFromObj(item, &xlist[loop], &ylist[loop]);
+        Py_XDECREF(item);
+
+        if (!result) {
+            PyMem_Free(xlist);
+            PyMem_Free(ylist);
+            return RAISE(PyExc_TypeError, "points must be number pairs");
+        }
+    }
+
+    ret = _fill_points(surfobj, color, xlist, ylist, length);
+    PyMem_Free(xlist);
+    PyMem_Free(ylist);
+    return ret;
+}
+
+/* Draws an antialiased filled circle on the given surface.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+aacircle(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *posobj, *radiusobj;
+    SDL_Surface *surf = NULL;
+    Uint8 rgba[4];
+    Uint32 color;
+    float posx, posy, radius;
+    AARaster r;
+    int result;
+    static char *keywords[] = {"surface", "color", "center", "radius", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OOO", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &posobj, &radiusobj))
+        return NULL; /* Exception already set. */
+
+    if (!pg_TwoFloatsFromObj(posobj, &posx, &posy)) {
+        return RAISE(PyExc_TypeError,
+                     "center argument must be a pair of numbers");
+    }
+
+    if (!pg_FloatFromObj(radiusobj, &radius)) {
+        return RAISE(PyExc_TypeError, "radius argument must be a number");
+    }
+
+    surf = pgSurface_AsSurface(surfobj);
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
+
+    CHECK_LOAD_COLOR(colorobj)
+
+    if (!(radius > 0.0f)) {
+        return pgRect_New4((int)posx, (int)posy, 0, 0);
+    }
+
+    result = aa_raster_init(&r, surf, posx - radius, posy - radius,
+                            posx + radius, posy + radius);
+    if (result < 0) {
+        return RAISE(PyExc_MemoryError,
+                     "cannot allocate memory to draw circle");
+    }
+    if (result == 0) {
+        return pgRect_New4((int)posx, (int)posy, 0, 0);
+    }
+    aa_raster_move_to(&r, posx + radius, posy);
+    aa_raster_arc(&r, posx, posy, radius, radius, 0.0, 2.0 * M_PI);
+    return _aa_fill_result(surfobj, &r, color, (int)posx, (int)posy);
+}
+
+/* Draws an antialiased filled ellipse on the given surface.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+aaellipse(PyObject *self, PyObject *arg, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *rectobj;
+    SDL_Rect *rect = NULL, temp;
+    SDL_Surface *surf = NULL;
+    Uint8 rgba[4];
+    Uint32 color;
+    float cx, cy, rx, ry;
+    AARaster r;
+    int result;
+    static char *keywords[] = {"surface", "color", "rect", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(arg, kwargs, "O!OO", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &rectobj)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!(rect = pgRect_FromObject(rectobj, &temp))) {
+        return RAISE(PyExc_TypeError, "rect argument is invalid");
+    }
+
+    surf = pgSurface_AsSurface(surfobj);
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
+
+    CHECK_LOAD_COLOR(colorobj)
+
+    if (rect->w < 1 || rect->h < 1) {
+        return pgRect_New4(rect->x, rect->y, 0, 0);
+    }
+
+    rx = rect->w / 2.0f;
+    ry = rect->h / 2.0f;
+    cx = rect->x + rx;
+    cy = rect->y + ry;
+    result = aa_raster_init(&r, surf, (float)rect->x, (float)rect->y,
+                            (float)rect->x + rect->w,
+                            (float)rect->y + rect->h);
+    if (result < 0) {
+        return RAISE(PyExc_MemoryError,
+                     "cannot allocate memory to draw ellipse");
+    }
+    if (result == 0) {
+        return pgRect_New4(rect->x, rect->y, 0, 0);
+    }
+    aa_raster_move_to(&r, cx + rx, cy);
+    aa_raster_arc(&r, cx, cy, rx, ry, 0.0, 2.0 * M_PI);
+    return _aa_fill_result(surfobj, &r, color, rect->x, rect->y);
+}
+
+/* Draws an antialiased filled rectangle, with optionally rounded corners,
+ * on the given surface.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+aarect(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *rectobj;
+    SDL_Rect *rect = NULL, temp;
+    SDL_Surface *surf = NULL;
+    Uint8 rgba[4];
+    Uint32 color;
+    float x1, y1, x2, y2, radius = 0.0f;
+    AARaster r;
+    int result;
+    static char *keywords[] = {"surface", "color", "rect", "border_radius",
+                               NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OO|f", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &rectobj, &radius)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!(rect = pgRect_FromObject(rectobj, &temp))) {
+        return RAISE(PyExc_TypeError, "rect argument is invalid");
+    }
+
+    surf = pgSurface_AsSurface(surfobj);
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
+
+    CHECK_LOAD_COLOR(colorobj)
+
+    if (rect->w < 1 || rect->h < 1) {
+        return pgRect_New4(rect->x, rect->y, 0, 0);
+    }
+
+    x1 = (float)rect->x;
+    y1 = (float)rect->y;
+    x2 = x1 + rect->w;
+    y2 = y1 + rect->h;
+    radius = MIN(radius, MIN(rect->w, rect->h) / 2.0f);
+
+    result = aa_raster_init(&r, surf, x1, y1, x2, y2);
+    if (result < 0) {
+        return RAISE(PyExc_MemoryError,
+                     "cannot allocate memory to draw rect");
+    }
+    if (result == 0) {
+        return pgRect_New4(rect->x, rect->y, 0, 0);
+    }
+    if (radius > 0.0f) {
+        aa_raster_move_to(&r, x1 + radius, y1);
+        aa_raster_line_to(&r, x2 - radius, y1);
+        aa_raster_arc(&r, x2 - radius, y1 + radius, radius, radius,
+                      -M_PI / 2.0, 0.0);
+        aa_raster_line_to(&r, x2, y2 - radius);
+        aa_raster_arc(&r, x2 - radius, y2 - radius, radius, radius, 0.0,
+                      M_PI / 2.0);
+        aa_raster_line_to(&r, x1 + radius, y2);
+        aa_raster_arc(&r, x1 + radius, y2 - radius, radius, radius,
+                      M_PI / 2.0, M_PI);
+        aa_raster_line_to(&r, x1, y1 + radius);
+        aa_raster_arc(&r, x1 + radius, y1 + radius, radius, radius, M_PI,
+                      1.5 * M_PI);
+    }
+    else {
+        aa_raster_move_to(&r, x1, y1);
+        aa_raster_line_to(&r, x2, y1);
+        aa_raster_line_to(&r, x2, y2);
+        aa_raster_line_to(&r, x1, y2);
+    }
+    return _aa_fill_result(surfobj, &r, color, rect->x, rect->y);
+}
+
+/* Longest miter join, as a multiple of the stroke width, before path()
+ * bevels the corner instead
+ */
+#define PATH_MITER_LIMIT 4.0f
+
+/* Check the join and cap names of a path. Returns 0 with an exception set
+ * if either is unknown.
+ */
+static int
+_check_path_style(const char *join, const char *cap)
+{
+    if (strcmp(join, "miter") && strcmp(join, "round") &&
+        strcmp(join, "bevel")) {
+        PyErr_SetString(PyExc_ValueError,
+                        "join must be 'miter', 'round' or 'bevel'");
+        return 0;
+    }
+    if (strcmp(cap, "butt") && strcmp(cap, "round") &&
+        strcmp(cap, "square")) {
+        PyErr_SetString(PyExc_ValueError,
+                        "cap must be 'butt', 'round' or 'square'");
+        return 0;
+    }
+    return 1;
+}
+
+/* Stroke the count points in xlist and ylist, none repeating the one
+ * before it. The segments, joins and caps are added to one raster as
+ * separate pieces, so every pixel of the stroke is written once.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+_stroke_path(pgSurfaceObject *surfobj, Uint32 color, const float *xlist,
+             const float *ylist, Py_ssize_t count, float width,
+             const char *join, const char *cap)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(surfobj);
+    float minx, miny, maxx, maxy, hw;
+    float xs[4], ys[4], x, y, dx, dy, len, nx, ny, pnx = 0.0f, pny = 0.0f;
+    float cross, dot, side, scale;
+    AARaster r;
+    int result;
+    Py_ssize_t loop;
+
+    minx = maxx = xlist[0];
+    miny = maxy = ylist[0];
+    for (loop = 1; loop < count; ++loop) {
+        minx = MIN(minx, xlist[loop]);
+        maxx = MAX(maxx, xlist[loop]);
+        miny = MIN(miny, ylist[loop]);
+        maxy = MAX(maxy, ylist[loop]);
+    }
+
+    hw = width / 2.0f;
+    result = 0;
+    if (hw > 0.0f) {
+        /* no join or cap reaches further than a miter at the limit */
+        result = aa_raster_init(&r, surf, minx - hw * PATH_MITER_LIMIT,
+                                miny - hw * PATH_MITER_LIMIT,
+                                maxx + hw * PATH_MITER_LIMIT,
+                                maxy + hw * PATH_MITER_LIMIT);
+    }
+    if (result > 0) {
+        if (count == 1 && cap[0] == 's') {
+            xs[0] = xs[3] = xlist[0] - hw;
+            xs[1] = xs[2] = xlist[0] + hw;
+            ys[0] = ys[1] = ylist[0] - hw;
+            ys[2] = ys[3] = ylist[0] + hw;
+            aa_raster_piece(&r, xs, ys, 4);
+        }
+        for (loop = 0; loop < count - 1; ++loop) {
+            dx = xlist[loop + 1] - xlist[loop];
+            dy = ylist[loop + 1] - ylist[loop];
+            len = sqrtf(dx * dx + dy * dy);
+            dx = dx * hw / len;
+            dy = dy * hw / len;
+            nx = -dy;
+            ny = dx;
+
+            /* the segment, stretched by the square caps at either end */
+            xs[0] = xs[3] = xlist[loop];
+            ys[0] = ys[3] = ylist[loop];
+            xs[1] = xs[2] = xlist[loop + 1];
+            ys[1] = ys[2] = ylist[loop + 1];
+            if (cap[0] == 's' && loop == 0) {
+                xs[0] = xs[3] -= dx;
+                ys[0] = ys[3] -= dy;
+            }
+            if (cap[0] == 's' && loop == count - 2) {
+                xs[1] = xs[2] += dx;
+                ys[1] = ys[2] += dy;
+            }
+            xs[0] += nx;
+            ys[0] += ny;
+            xs[1] += nx;
+            ys[1] += ny;
+            xs[2] -= nx;
+            ys[2] -= ny;
+            xs[3] -= nx;
+            ys[3] -= ny;
+            aa_raster_piece(&r, xs, ys, 4);
+
+            /* the join with the segment before, filling the gap on the
+             * outside of the corner
+             */
+            x = xlist[loop];
+            y = ylist[loop];
+            cross = pnx * ny - pny * nx;
+            if (loop == 0 || join[0] == 'r' || cross == 0.0f) {
+                pnx = nx;
+                pny = ny;
+                continue;
+            }
+            side = cross > 0.0f ? -1.0f : 1.0f;
+            dot = (pnx * nx + pny * ny) / (hw * hw);
+            xs[0] = x;
+            ys[0] = y;
+            xs[1] = x + side * pnx;
+            ys[1] = y + side * pny;
+            if (join[0] == 'm' &&
+                1.0f + dot >= 2.0f / (PATH_MITER_LIMIT * PATH_MITER_LIMIT)) {
+                scale = side / (1.0f + dot);
+                xs[2] = x + (pnx + nx) * scale;
+                ys[2] = y + (pny + ny) * scale;
+                xs[3] = x + side * nx;
+                ys[3] = y + side * ny;
+                aa_raster_piece(&r, xs, ys, 4);
+            }
+            else {
+                xs[2] = x + side * nx;
+                ys[2] = y + side * ny;
+                aa_raster_piece(&r, xs, ys, 3);
+            }
+            pnx = nx;
+            pny = ny;
+        }
+        for (loop = 0; loop < count; ++loop) {
+            if ((join[0] == 'r' && loop > 0 && loop < count - 1) ||
+                (cap[0] == 'r' && (loop == 0 || loop == count - 1))) {
+                aa_raster_move_to(&r, xlist[loop] + hw, ylist[loop]);
+                aa_raster_arc(&r, xlist[loop], ylist[loop], hw, hw, 0.0,
+                              2.0 * M_PI);
+            }
+        }
+    }
+
+    if (result < 0) {
+        return RAISE(PyExc_MemoryError, "cannot allocate memory to draw path");
+    }
+    if (result == 0) {
+        return pgRect_New4((int)xlist[0], (int)ylist[0], 0, 0);
+    }
+    return _aa_fill_result(surfobj, &r, color, (int)xlist[0], (int)ylist[0]);
+}
+
+/* Draws an antialiased stroke along the given points on the given
+ * surface.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+path(PyObject *self, PyObject *arg, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *points, *item, *ret;
+    SDL_Surface *surf = NULL;
+    Uint8 rgba[4];
+    Uint32 color;
+    float *xlist, *ylist, width = 1.0f;
+    const char *join = "miter", *cap = "butt";
+    int result;
+    Py_ssize_t loop, length, count = 0;
+    static char *keywords[] = {"surface", "color", "points", "width",
+                               "join",    "cap",   NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(arg, kwargs, "O!OO|fss", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &points, &width, &join, &cap)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!_check_path_style(join, cap)) {
+        return NULL;
+    }
+
+    surf = pgSurface_AsSurface(surfobj);
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
+
+    CHECK_LOAD_COLOR(colorobj)
+
+    if (!PySequence_Check(points)) {
+        return RAISE(PyExc_TypeError,
+                     "points argument must be a sequence of number pairs");
+    }
+
+    length = PySequence_Length(points);
+
+    if (length < 2) {
+        return RAISE(PyExc_ValueError,
+                     "points argument must contain 2 or more points");
+    }
+
+    xlist = PyMem_New(float, length);
+    ylist = PyMem_New(float, length);
+
+    if (NULL == xlist || NULL == ylist) {
+        PyMem_Free(xlist);
+        PyMem_Free(ylist);
+        return RAISE(PyExc_MemoryError, "cannot allocate memory to draw path");
+    }
+
+    /* Repeated points add nothing but a direction-less segment */
+    for (loop = 0; loop < length; ++loop) {
+        item = PySequence_GetItem(points, loop);
+        result = item && pg_TwoFloatsFromObj(item, &xlist[count],
+                                             &ylist[count]);
+        Py_XDECREF(item);
+
+        if (!result) {
+            PyMem_Free(xlist);
+            PyMem_Free(ylist);
+            return RAISE(PyExc_TypeError, "points must be number pairs");
+        }
+        if (!count || xlist[count] != xlist[count - 1] ||
+            ylist[count] != ylist[count - 1]) {
+            ++count;
+        }
+    }
+
+    ret = _stroke_path(surfobj, color, xlist, ylist, count, width, join, cap);
+    PyMem_Free(xlist);
+    PyMem_Free(ylist);
+    return ret;
+}
+
+/* Deepest subdivision of one curve segment, for at most 65536 lines */
+#define CURVE_MAX_DEPTH 16
+
+/* A Bezier spline, flattened to lines once when created */
+typedef struct {
+    PyObject_HEAD float *xs, *ys;
+    Py_ssize_t length, allocated;
+    double tolerance;
+    PyObject *control_points; /* tuple of (x, y) tuples */
+} pgCurveObject;
+
+/* Append (x, y) to the flattened points, unless it repeats the last one.
+ * Returns 0 if out of memory.
+ */
+static int
+_curve_add_point(pgCurveObject *self, double x, double y)
+{
+    Py_ssize_t allocated;
+    float *xs, *ys;
+
+    if (self->length &&
+        (float)x == self->xs[self->length - 1] &&
+        (float)y == self->ys[self->length - 1]) {
+        return 1;
+    }
+    if (self->length == self->allocated) {
+        allocated = self->allocated ? self->allocated * 2 : 64;
+        xs = PyMem_Resize(self->xs, float, allocated);
+        if (xs) {
+            self->xs = xs;
+        }
+        ys = PyMem_Resize(self->ys, float, allocated);
+        if (ys) {
+            self->ys = ys;
+        }
+        if (!xs || !ys) {
+            return 0;
+        }
+        self->allocated = allocated;
+    }
+    self->xs[self->length] = (float)x;
+    self->ys[self->length] = (float)y;
+    ++self->length;
+    return 1;
+}
+
+/* Flatten the cubic segment with control points p[0..7] as x, y pairs,
+ * after its first point. The segment is split in half until its control
+ * points are close enough to the chord that no part of the curve is more
+ * than the tolerance away from it; limit is 16 times the tolerance
+ * squared. Returns 0 if out of memory.
+ */
+static int
+_curve_flatten(pgCurveObject *self, const double *p, double limit, int depth)
+{
+    double ux = 3.0 * p[2] - 2.0 * p[0] - p[6];
+    double uy = 3.0 * p[3] - 2.0 * p[1] - p[7];
+    double vx = 3.0 * p[4] - p[0] - 2.0 * p[6];
+    double vy = 3.0 * p[5] - p[1] - 2.0 * p[7];
+    double q[14], m;
+    int i;
+
+    if (depth == CURVE_MAX_DEPTH ||
+        MAX(ux * ux, vx * vx) + MAX(uy * uy, vy * vy) <= limit) {
+        return _curve_add_point(self, p[6], p[7]);
+    }
+
+    /* de Casteljau split at the middle: q[0..7] is the first half and
+     * q[6..13] the second
+     */
+    for (i = 0; i < 2; ++i) {
+        m = (p[2 + i] + p[4 + i]) / 2.0;
+        q[0 + i] = p[0 + i];
+        q[2 + i] = (p[0 + i] + p[2 + i]) / 2.0;
+        q[10 + i] = (p[4 + i] + p[6 + i]) / 2.0;
+        q[12 + i] = p[6 + i];
+        q[4 + i] = (q[2 + i] + m) / 2.0;
+        q[8 + i] = (m + q[10 + i]) / 2.0;
+        q[6 + i] = (q[4 + i] + q[8 + i]) / 2.0;
+    }
+    return _curve_flatten(self, q, limit, depth + 1) &&
+           _curve_flatten(self, q + 6, limit, depth + 1);
+}
+
+static PyObject *
+curve_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    pgCurveObject *self;
+    PyObject *points, *item;
+    double p[8];
+    float x, y;
+    int result, slot;
+    Py_ssize_t loop, length;
+    static char *keywords[] = {"points", "tolerance", NULL};
+    double tolerance = 0.25;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|d", keywords, &points,
+                                     &tolerance)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!(tolerance > 0.0)) {
+        return RAISE(PyExc_ValueError, "tolerance must be positive");
+    }
+
+    if (!PySequence_Check(points)) {
+        return RAISE(PyExc_TypeError,
+                     "points argument must be a sequence of number pairs");
+    }
+
+    length = PySequence_Length(points);
+
+    if (length < 4 || (length - 1) % 3) {
+        return RAISE(PyExc_ValueError,
+                     "points argument must contain 3 * n + 1 control points "
+                     "for n cubic segments");
+    }
+
+    self = (pgCurveObject *)type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+    self->tolerance = tolerance;
+    self->control_points = PyTuple_New(length);
+    if (!self->control_points) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    for (loop = 0; loop < length; ++loop) {
+        item = PySequence_GetItem(points, loop);
+        result = item && pg_TwoFloatsFromObj(item, &x, &y);
+        Py_XDECREF(item);
+
+        if (!result) {
+            Py_DECREF(self);
+            return RAISE(PyExc_TypeError, "points must be number pairs");
+        }
+        item = Py_BuildValue("(ff)", x, y);
+        if (!item) {
+            Py_DECREF(self);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(self->control_points, loop, item);
+
+        /* p collects the control points of the current segment */
+        slot = loop ? (int)((loop - 1) % 3) + 1 : 0;
+        p[2 * slot] = x;
+        p[2 * slot + 1] = y;
+        if (loop == 0) {
+            result = _curve_add_point(self, x, y);
+        }
+        else if (slot == 3) {
+            result = _curve_flatten(self, p, 16.0 * tolerance * tolerance,
+                                    0);
+            p[0] = p[6];
+            p[1] = p[7];
+        }
+        if (!result) {
+            Py_DECREF(self);
+            return RAISE(PyExc_MemoryError,
+                         "cannot allocate memory to flatten curve");
+        }
+    }
+    return (PyObject *)self;
+}
+
+static void
+curve_dealloc(pgCurveObject *self)
+{
+    PyMem_Free(self->xs);
+    PyMem_Free(self->ys);
+    Py_XDECREF(self->control_points);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static Py_ssize_t
+curve_length(pgCurveObject *self)
+{
+    return self->length;
+}
+
+static PyObject *
+curve_item(pgCurveObject *self, Py_ssize_t index)
+{
+    if (index < 0 || index >= self->length) {
+        return RAISE(PyExc_IndexError, "Invalid curve index");
+    }
+    return Py_BuildValue("(ff)", self->xs[index], self->ys[index]);
+}
+
+static PyObject *
+curve_get_control_points(pgCurveObject *self, void *closure)
+{
+    Py_INCREF(self->control_points);
+    return self->control_points;
+}
+
+static PyObject *
+curve_get_tolerance(pgCurveObject *self, void *closure)
+{
+    return PyFloat_FromDouble(self->tolerance);
+}
+
+/* Draws an antialiased stroke along the flattened curve.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+curve_stroke(pgCurveObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj;
+    SDL_Surface *surf = NULL;
+    Uint8 rgba[4];
+    Uint32 color;
+    float width = 1.0f;
+    const char *join = "miter", *cap = "butt";
+    static char *keywords[] = {"surface", "color", "width",
+                               "join",    "cap",   NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|fss", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &width, &join, &cap)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!_check_path_style(join, cap)) {
+        return NULL;
+    }
+
+    surf = pgSurface_AsSurface(surfobj);
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
+
+    CHECK_LOAD_COLOR(colorobj)
+
+    return _stroke_path(surfobj, color, self->xs, self->ys, self->length,
+                        width, join, cap);
+}
+
+/* Draws the area enclosed by the flattened curve, antialiased, closing it
+ * with a line back to its start.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+curve_fill(pgCurveObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj;
+    SDL_Surface *surf = NULL;
+    Uint8 rgba[4];
+    Uint32 color;
+    static char *keywords[] = {"surface", "color", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj)) {
+        return NULL; /* Exception already set. */
+    }
+
+    surf = pgSurface_AsSurface(surfobj);
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
+
+    CHECK_LOAD_COLOR(colorobj)
+
+    return _fill_points(surfobj, color, self->xs, self->ys, self->length);
+}
+
+static PyMethodDef curve_methods[] = {
+    {"stroke", (PyCFunction)curve_stroke, METH_VARARGS | METH_KEYWORDS,
+     DOC_CURVESTROKE},
+    {"fill", (PyCFunction)curve_fill, METH_VARARGS | METH_KEYWORDS,
+     DOC_CURVEFILL},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef curve_getsets[] = {
+    {"control_points", (getter)curve_get_control_points, NULL,
+     DOC_CURVECONTROLPOINTS, NULL},
+    {"tolerance", (getter)curve_get_tolerance, NULL, DOC_CURVETOLERANCE,
+     NULL},
+    {NULL, NULL, NULL, NULL, NULL}};
+
+static PySequenceMethods curve_as_sequence = {
+    .sq_length = (lenfunc)curve_length,
+    .sq_item = (ssizeargfunc)curve_item,
+};
+
+static PyTypeObject pgCurve_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.draw.Curve",
+    .tp_basicsize = sizeof(pgCurveObject),
+    .tp_dealloc = (destructor)curve_dealloc,
+    .tp_as_sequence = &curve_as_sequence,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_PYGAMEDRAWCURVE,
+    .tp_methods = curve_methods,
+    .tp_getset = curve_getsets,
+    .tp_new = curve_new,
+};
+
+/* Most entries in the color table of a gradient */
+#define GRADIENT_MAX_STEPS 4096
+
+/* Load the color obj as RGBA components, taking an int as a pixel value
+ * of surf. Returns 0 with an exception set if obj is not a color.
+ */
+static int
+_get_rgba(SDL_Surface *surf, PyObject *obj, Uint8 *rgba)
+{
+    if (PyLong_Check(obj)) {
+        SDL_GetRGBA((Uint32)PyLong_AsLong(obj), surf->format, &rgba[0],
+                    &rgba[1], &rgba[2], &rgba[3]);
+        return 1;
+    }
+    return pg_RGBAFromFuzzyColorObj(obj, rgba);
+}
+
+/* Returns a new table of n pixel values for surf, stepping evenly from
+ * startobj to endobj, or NULL with an exception set.
+ */
+static Uint32 *
+_gradient_lut(SDL_Surface *surf, PyObject *startobj, PyObject *endobj, int n)
+{
+    Uint8 start[4], end[4], rgba[4];
+    Uint32 *lut;
+    double t;
+    int i, k;
+
+    if (!_get_rgba(surf, startobj, start) || !_get_rgba(surf, endobj, end)) {
+        return NULL; /* Exception already set. */
+    }
+    lut = PyMem_New(Uint32, n);
+    if (!lut) {
+        return (Uint32 *)RAISE(PyExc_MemoryError,
+                               "cannot allocate memory to draw gradient");
+    }
+    for (i = 0; i < n; ++i) {
+        t = n > 1 ? (double)i / (n - 1) : 0.0;
+        for (k = 0; k < 4; ++k) {
+            rgba[k] = (Uint8)(start[k] + (end[k] - start[k]) * t + 0.5);
+        }
+        lut[i] = SDL_MapRGBA(surf->format, rgba[0], rgba[1], rgba[2], rgba[3]);
+    }
+    return lut;
+}
+
+/* Fills a rectangle with a linear gradient on the given surface.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+linear_gradient(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *rectobj, *startobj, *endobj;
+    PyObject *startposobj = Py_None, *endposobj = Py_None;
+    SDL_Rect *rect = NULL, temp, area;
+    SDL_Surface *surf = NULL;
+    float startx, starty, endx, endy;
+    double dx, dy, length, inv;
+    Uint32 *lut, *row;
+    int steps;
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
+                         INT_MIN}; /* Used to store bounding box values */
+    Uint64 stats_start;
+    static char *keywords[] = {"surface",   "rect",      "start_color",
+                               "end_color", "start_pos", "end_pos",
+                               NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OOO|OO", keywords,
+                                     &pgSurface_Type, &surfobj, &rectobj,
+                                     &startobj, &endobj, &startposobj,
+                                     &endposobj)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!(rect = pgRect_FromObject(rectobj, &temp))) {
+        return RAISE(PyExc_TypeError, "rect argument is invalid");
+    }
+
+    /* a top to bottom gradient by default */
+    startx = endx = (float)rect->x;
+    starty = (float)rect->y;
+    endy = (float)(rect->y + rect->h - 1);
+    if (startposobj != Py_None &&
+        !pg_TwoFloatsFromObj(startposobj, &startx, &starty)) {
+        return RAISE(PyExc_TypeError,
+                     "start_pos argument must be a pair of numbers");
+    }
+    if (endposobj != Py_None &&
+        !pg_TwoFloatsFromObj(endposobj, &endx, &endy)) {
+        return RAISE(PyExc_TypeError,
+                     "end_pos argument must be a pair of numbers");
+    }
+
+    surf = pgSurface_AsSurface(surfobj);
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
+
+    dx = endx - startx;
+    dy = endy - starty;
+    length = sqrt(dx * dx + dy * dy);
+    steps = (int)MIN(ceil(length), GRADIENT_MAX_STEPS) + 1;
+    lut = _gradient_lut(surf, startobj, endobj, steps);
+    if (!lut) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!SDL_IntersectRect(rect, &surf->clip_rect, &area)) {
+        PyMem_Free(lut);
+        return pgRect_New4(rect->x, rect->y, 0, 0);
+    }
+
+    row = PyMem_New(Uint32, area.w);
+    if (!row) {
+        PyMem_Free(lut);
+        return RAISE(PyExc_MemoryError,
+                     "cannot allocate memory to draw gradient");
+    }
+
+    stats_start = pg_StatsBegin();
+    if (!pgSurface_Lock(surfobj)) {
+        PyMem_Free(lut);
+        PyMem_Free(row);
+        return RAISE(PyExc_RuntimeError, "error locking surface");
+    }
+
+    /* the gradient position is the projection onto start_pos to end_pos */
+    inv = length > 0.0 ? 1.0 / (length * length) : 0.0;
+    draw_linear_gradient(
+        surf, &area, lut, steps - 1,
+        ((area.x - startx) * dx + (area.y - starty) * dy) * inv, dx * inv,
+        dy * inv, row, drawn_area);
+    PyMem_Free(lut);
+    PyMem_Free(row);
+
+    pg_StatsEnd(PG_STAT_DRAW, "linear_gradient", stats_start,
+                _drawn_area_pixels(drawn_area));
+    if (!pgSurface_Unlock(surfobj)) {
+        return RAISE(PyExc_RuntimeError, "error unlocking surface");
+    }
+
+    return _drawn_area_rect(surfobj, drawn_area);
+}
+
+/* Fills a circle with a radial gradient on the given surface.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+radial_gradient(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *posobj, *radiusobj, *innerobj, *outerobj;
+    SDL_Surface *surf = NULL;
+    float posx, posy, radius;
+    Uint32 *lut, *row;
+    int steps;
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
+                         INT_MIN}; /* Used to store bounding box values */
+    Uint64 stats_start;
+    static char *keywords[] = {"surface",     "center",      "radius",
+                               "inner_color", "outer_color", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OOOO", keywords,
+                                     &pgSurface_Type, &surfobj, &posobj,
+                                     &radiusobj, &innerobj, &outerobj)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!pg_TwoFloatsFromObj(posobj, &posx, &posy)) {
+        return RAISE(PyExc_TypeError,
+                     "center argument must be a pair of numbers");
+    }
+
+    if (!pg_FloatFromObj(radiusobj, &radius)) {
+        return RAISE(PyExc_TypeError, "radius argument must be a number");
+    }
+
+    surf = pgSurface_AsSurface(surfobj);
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
+
+    steps = radius > 0.0f ? (int)MIN(ceil(radius), GRADIENT_MAX_STEPS) : 0;
+    lut = _gradient_lut(surf, innerobj, outerobj, steps + 1);
+    if (!lut) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!(radius > 0.0f)) {
+        PyMem_Free(lut);
+        return pgRect_New4((int)posx, (int)posy, 0, 0);
+    }
+
+    row = PyMem_New(Uint32, MAX(surf->clip_rect.w, 1));
+    if (!row) {
+        PyMem_Free(lut);
+        return RAISE(PyExc_MemoryError,
+                     "cannot allocate memory to draw gradient");
+    }
+
+    stats_start = pg_StatsBegin();
+    if (!pgSurface_Lock(surfobj)) {
+        PyMem_Free(lut);
+        PyMem_Free(row);
+        return RAISE(PyExc_RuntimeError, "error locking surface");
+    }
+
+    draw_radial_gradient(surf, posx, posy, radius, lut, steps, row,
+                         drawn_area);
+    PyMem_Free(lut);
+    PyMem_Free(row);
+
+    pg_StatsEnd(PG_STAT_DRAW, "radial_gradient", stats_start,
+                _drawn_area_pixels(drawn_area));
+    if (!pgSurface_Unlock(surfobj)) {
+        return RAISE(PyExc_RuntimeError, "error unlocking surface");
+    }
+
+    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
+        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
+        return _drawn_area_rect(surfobj, drawn_area);
+    else
+        return pgRect_New4((int)posx, (int)posy, 0, 0);
+}
+
+/* Fills a polygon with a tiled texture on the given surface.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+textured_polygon(PyObject *self, PyObject *arg, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj, *textureobj;
+    PyObject *points, *item, *offsetobj = NULL;
+    SDL_Surface *surf = NULL, *converted = NULL;
+    FillTexture texture = {NULL, 0, 0};
+    int *xlist = NULL, *ylist = NULL;
+    int x, y, result;
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
+                         INT_MIN}; /* Used to store bounding box values */
+    Py_ssize_t loop, length;
+    Uint64 stats_start;
+    static char *keywords[] = {"surface", "points", "texture", "offset",
+                               NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(arg, kwargs, "O!OO!|O", keywords,
+                                     &pgSurface_Type, &surfobj, &points,
+                                     &pgSurface_Type, &textureobj,
+                                     &offsetobj)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (offsetobj &&
+        !pg_TwoIntsFromObj(offsetobj, &texture.x, &texture.y)) {
+        return RAISE(PyExc_TypeError,
+                     "offset argument must be a pair of integers");
+    }
+
+    surf = pgSurface_AsSurface(surfobj);
+    texture.surf = pgSurface_AsSurface(textureobj);
+
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
+
+    if (!texture.surf) {
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    }
+
+    if (!PySequence_Check(points)) {
+        return RAISE(PyExc_TypeError,
+                     "points argument must be a sequence of number pairs");
+    }
+
+    length = PySequence_Length(points);
+
+    if (length < 3) {
+        return RAISE(PyExc_ValueError,
+                     "points argument must contain more than 2 points");
+    }
+
+    xlist = PyMem_New(int, length);
+    ylist = PyMem_New(int, length);
+
+    if (NULL == xlist || NULL == ylist) {
+        PyMem_Free(xlist);
+        PyMem_Free(ylist);
+        return RAISE(PyExc_MemoryError,
+                     "cannot allocate memory to draw polygon");
+    }
+
+    for (loop = 0; loop < length; ++loop) {
+        item = PySequence_GetItem(points, loop);
+        result = item && pg_TwoIntsFromObj(item, &x, &y);
+        Py_XDECREF(item);
+
+        if (!result) {
+            PyMem_Free(xlist);
+            PyMem_Free(ylist);
+            return RAISE(PyExc_TypeError, "points must be number pairs");
+        }
+
+        xlist[loop] = x;
+        ylist[loop] = y;
+    }
+    x = xlist[0];
+    y = ylist[0];
+
+    if (texture.surf->w < 1 || texture.surf->h < 1) {
+        PyMem_Free(xlist);
+        PyMem_Free(ylist);
+        return pgRect_New4(x, y, 0, 0);
+    }
+
+    /* Spans are copied straight from the texture, so it needs the pixel
+     * format of the surface, and must not be the surface itself.
+     */
+    if (texture.surf == surf ||
+        texture.surf->format->format != surf->format->format ||
+        SDL_ISPIXELFORMAT_INDEXED(surf->format->format)) {
+        converted = SDL_ConvertSurface(texture.surf, surf->format, 0);
+        if (!converted) {
+            PyMem_Free(xlist);
+            PyMem_Free(ylist);
+            return RAISE(pgExc_SDLError, SDL_GetError());
+        }
+        texture.surf = converted;
+    }
+
+    if (converted ? SDL_LockSurface(converted) < 0
+                  : !pgSurface_Lock(textureobj)) {
+        PyMem_Free(xlist);
+        PyMem_Free(ylist);
+        SDL_FreeSurface(converted);
+        return RAISE(PyExc_RuntimeError, "error locking texture");
+    }
+    stats_start = pg_StatsBegin();
+    if (!pgSurface_Lock(surfobj)) {
+        PyMem_Free(xlist);
+        PyMem_Free(ylist);
+        if (converted) {
+            SDL_FreeSurface(converted);
+        }
+        else {
+            pgSurface_Unlock(textureobj);
+        }
+        return RAISE(PyExc_RuntimeError, "error locking surface");
+    }
+
+    draw_fillpoly(surf, xlist, ylist, length, 0, &texture, drawn_area);
+    PyMem_Free(xlist);
+    PyMem_Free(ylist);
+
+    if (converted) {
+        SDL_UnlockSurface(converted);
+        SDL_FreeSurface(converted);
+    }
+    else if (!pgSurface_Unlock(textureobj)) {
+        pgSurface_Unlock(surfobj);
+        return RAISE(PyExc_RuntimeError, "error unlocking surface");
+    }
+    pg_StatsEnd(PG_STAT_DRAW, "textured_polygon", stats_start,
+                _drawn_area_pixels(drawn_area));
+    if (!pgSurface_Unlock(surfobj)) {
+        return RAISE(PyExc_RuntimeError, "error unlocking surface");
+    }
+
+    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
+        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
+        return _drawn_area_rect(surfobj, drawn_area);
+    else
+        return pgRect_New4(x, y, 0, 0);
+}
+
+/* Functions used in drawing algorithms */
+
+static void
+swap(float *a, float *b)
+{
+    float temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+static int
+sign(int x, int y)
+{
+    return (x > 0) ? 1 : ((x < 0) ? -1 : y);
+}
+
+static Uint32
+get_antialiased_color(SDL_Surface *surf, int x, int y, Uint32 original_color,
+                      float brightness, int blend)
+{
+    Uint8 color_part[4], background_color[4];
+    Uint32 *pixels = (Uint32 *)surf->pixels;
+    SDL_GetRGBA(original_color, surf->format, &color_part[0], &color_part[1],
+                &color_part[2], &color_part[3]);
+    if (blend) {
+        if (x < surf->clip_rect.x ||
+            x >= surf->clip_rect.x + surf->clip_rect.w ||
+            y < surf->clip_rect.y ||
+            y >= surf->clip_rect.y + surf->clip_rect.h)
+            return original_color;
+        SDL_GetRGBA(pixels[(y * surf->w) + x], surf->format,
+                    &background_color[0], &background_color[1],
+                    &background_color[2], &background_color[3]);
+        color_part[0] = (Uint8)(brightness * color_part[0] +
+                                (1 - brightness) * background_color[0]);
+        color_part[1] = (Uint8)(brightness * color_part[1] +
+                                (1 - brightness) * background_color[1]);
+        color_part[2] = (Uint8)(brightness * color_part[2] +
+                                (1 - brightness) * background_color[2]);
+        color_part[3] = (Uint8)(brightness * color_part[3] +
+                                (1 - brightness) * background_color[3]);
+    }
+    else {
+        color_part[0] = (Uint8)(brightness * color_part[0]);
+        color_part[1] = (Uint8)(brightness * color_part[1]);
+        color_part[2] = (Uint8)(brightness * color_part[2]);
+        color_part[3] = (Uint8)(brightness * color_part[3]);
+    }
+    original_color = SDL_MapRGBA(surf->format, color_part[0], color_part[1],
+                                 color_part[2], color_part[3]);
+    return original_color;
+}
+
+static void
+add_pixel_to_drawn_list(int x, int y, int *pts)
+{
+    if (x < pts[0]) {
+        pts[0] = x;
+    }
+    if (y < pts[1]) {
+        pts[1] = y;
+    }
+    if (x > pts[2]) {
+        pts[2] = x;
+    }
+    if (y > pts[3]) {
+        pts[3] = y;
+    }
+}
+
+static int
+clip_line(SDL_Surface *surf, int *x1, int *y1, int *x2, int *y2)
+{
+    int p1 = *x1 - *x2;
+    int p2 = -p1;
+    int p3 = *y1 - *y2;
+    int p4 = -p3;
+    int q1 = *x1 - surf->clip_rect.x;
+    int q2 = surf->clip_rect.w + surf->clip_rect.x - *x1;
+    int q3 = *y1 - surf->clip_rect.y;
+    int q4 = surf->clip_rect.h + surf->clip_rect.y - *y1;
+    int old_x1 = *x1;
+    int old_y1 = *y1;
+    double nmax = 0;
+    double pmin = 1;
+    double r1, r2;
+    if ((p1 == 0 && q1 < 0) || (p2 == 0 && q2 < 0) || (p3 == 0 && q3 < 0) ||
+        (p4 == 0 && q4 < 0))
+        return 0;
+    if (p1) {
+        r1 = (double)q1 / p1;
+        r2 = (double)q2 / p2;
+        if (p1 < 0) {
+            if (r1 > nmax)
+                nmax = r1;
+            if (r2 < pmin)
+                pmin = r2;
+        }
+        else {
+            if (r2 > nmax)
+                nmax = r2;
+            if (r1 < pmin)
+                pmin = r1;
+        }
+    }
+    if (p3) {
+        r1 = (double)q3 / p3;
+        r2 = (double)q4 / p4;
+        if (p3 < 0) {
+            if (r1 > nmax)
+                nmax = r1;
+            if (r2 < pmin)
+                pmin = r2;
+        }
+        else {
+            if (r2 > nmax)
+                nmax = r2;
+            if (r1 < pmin)
+                pmin = r1;
+        }
+    }
+    if (nmax > pmin)
+        return 0;
+    *x1 =
+        old_x1 + (int)(p2 * nmax < 0 ? (p2 * nmax - 0.5) : (p2 * nmax + 0.5));
+    *y1 =
+        old_y1 + (int)(p4 * nmax < 0 ? (p4 * nmax - 0.5) : (p4 * nmax + 0.5));
+    *x2 =
+        old_x1 + (int)(p2 * pmin < 0 ? (p2 * pmin - 0.5) : (p2 * pmin + 0.5));
+    *y2 =
+        old_y1 + (int)(p4 * pmin < 0 ? (p4 * pmin - 0.5) : (p4 * pmin + 0.5));
+    return 1;
+}
+
+static int
+set_at(SDL_Surface *surf, int x, int y, Uint32 color)
+{
+    SDL_PixelFormat *format = surf->format;
+    Uint8 *pixels = (Uint8 *)surf->pixels;
+    Uint8 *byte_buf, rgb[4];
+
+    if (x < surf->clip_rect.x || x >= surf->clip_rect.x + surf->clip_rect.w ||
+        y < surf->clip_rect.y || y >= surf->clip_rect.y + surf->clip_rect.h)
+        return 0;
+
+    switch (format->BytesPerPixel) {
         case 1:
             *((Uint8 *)pixels + y * surf->pitch + x) = (Uint8)color;
             break;
@@ -1159,13 +2950,18 @@ set_and_check_rect(SDL_Surface *surf, int x, int y, Uint32 color,
         add_pixel_to_drawn_list(x, y, drawn_area);
 }
 
+/* Called by aaline_walk() for each pixel of a line, with its coverage */
+typedef void (*aa_plot_fn)(void *ctx, int x, int y, float brightness);
+
+/* Walk the pixels of an antialiased line, clipped to the clip rect of
+ * surf, calling plot with the coverage of each.
+ */
 static void
-draw_aaline(SDL_Surface *surf, Uint32 color, float from_x, float from_y,
-            float to_x, float to_y, int blend, int *drawn_area)
+aaline_walk(SDL_Surface *surf, float from_x, float from_y, float to_x,
+            float to_y, aa_plot_fn plot, void *ctx)
 {
     float gradient, dx, dy, intersect_y, brightness;
     int x, x_pixel_start, x_pixel_end;
-    Uint32 pixel_color;
     float x_gap, y_endpoint, clip_left, clip_right, clip_top, clip_bottom;
     int steep, y;
 
@@ -1175,11 +2971,7 @@ draw_aaline(SDL_Surface *surf, Uint32 color, float from_x, float from_y,
     /* Single point.
      * A line with length 0 is drawn as a single pixel at full brightness. */
     if (fabs(dx) < 0.0001 && fabs(dy) < 0.0001) {
-        pixel_color =
-            get_antialiased_color(surf, (int)floor(from_x + 0.5),
-                                  (int)floor(from_y + 0.5), color, 1, blend);
-        set_and_check_rect(surf, (int)floor(from_x + 0.5),
-                           (int)floor(from_y + 0.5), pixel_color, drawn_area);
+        plot(ctx, (int)floor(from_x + 0.5), (int)floor(from_y + 0.5), 1);
         return;
     }
 
@@ -1280,9 +3072,7 @@ draw_aaline(SDL_Surface *surf, Uint32 color, float from_x, float from_y,
             y = (int)y_endpoint;
         }
         if ((int)y_endpoint < y_endpoint) {
-            pixel_color = get_antialiased_color(surf, x, y, color,
-                                                brightness * x_gap, blend);
-            set_and_check_rect(surf, x, y, pixel_color, drawn_area);
+            plot(ctx, x, y, brightness * x_gap);
         }
         if (steep) {
             x--;
@@ -1291,9 +3081,7 @@ draw_aaline(SDL_Surface *surf, Uint32 color, float from_x, float from_y,
             y--;
         }
         brightness = 1 - brightness;
-        pixel_color = get_antialiased_color(surf, x, y, color,
-                                            brightness * x_gap, blend);
-        set_and_check_rect(surf, x, y, pixel_color, drawn_area);
+        plot(ctx, x, y, brightness * x_gap);
         intersect_y += gradient;
         x_pixel_start++;
     }
@@ -1312,9 +3100,7 @@ draw_aaline(SDL_Surface *surf, Uint32 color, float from_x, float from_y,
             y = (int)y_endpoint;
         }
         if ((int)y_endpoint < y_endpoint) {
-            pixel_color = get_antialiased_color(surf, x, y, color,
-                                                brightness * x_gap, blend);
-            set_and_check_rect(surf, x, y, pixel_color, drawn_area);
+            plot(ctx, x, y, brightness * x_gap);
         }
         if (steep) {
             x--;
@@ -1323,9 +3109,7 @@ draw_aaline(SDL_Surface *surf, Uint32 color, float from_x, float from_y,
             y--;
         }
         brightness = 1 - brightness;
-        pixel_color = get_antialiased_color(surf, x, y, color,
-                                            brightness * x_gap, blend);
-        set_and_check_rect(surf, x, y, pixel_color, drawn_area);
+        plot(ctx, x, y, brightness * x_gap);
     }
 
     /* main line drawing loop */
@@ -1333,77 +3117,256 @@ draw_aaline(SDL_Surface *surf, Uint32 color, float from_x, float from_y,
         y = (int)intersect_y;
         if (steep) {
             brightness = 1 - intersect_y + y;
-            pixel_color = get_antialiased_color(surf, y - 1, x, color,
-                                                brightness, blend);
-            set_and_check_rect(surf, y - 1, x, pixel_color, drawn_area);
+            plot(ctx, y - 1, x, brightness);
             if (y < intersect_y) {
                 brightness = 1 - brightness;
-                pixel_color = get_antialiased_color(surf, y, x, color,
-                                                    brightness, blend);
-                set_and_check_rect(surf, y, x, pixel_color, drawn_area);
+                plot(ctx, y, x, brightness);
             }
         }
         else {
             brightness = 1 - intersect_y + y;
-            pixel_color = get_antialiased_color(surf, x, y - 1, color,
-                                                brightness, blend);
-            set_and_check_rect(surf, x, y - 1, pixel_color, drawn_area);
+            plot(ctx, x, y - 1, brightness);
             if (y < intersect_y) {
                 brightness = 1 - brightness;
-                pixel_color = get_antialiased_color(surf, x, y, color,
-                                                    brightness, blend);
-                set_and_check_rect(surf, x, y, pixel_color, drawn_area);
+                plot(ctx, x, y, brightness);
             }
         }
         intersect_y += gradient;
     }
 }
 
+typedef struct {
+    SDL_Surface *surf;
+    Uint32 color;
+    int blend;
+    int *drawn_area;
+} AALinePlot;
+
+/* Plot a pixel of any surface, reading it back to blend with */
 static void
-drawhorzline(SDL_Surface *surf, Uint32 color, int x1, int y1, int x2)
+aaline_plot_pixel(void *ctx, int x, int y, float brightness)
 {
-    Uint8 *pixel, *end;
+    AALinePlot *p = (AALinePlot *)ctx;
+    Uint32 pixel_color = get_antialiased_color(p->surf, x, y, p->color,
+                                               brightness, p->blend);
 
-    if (x1 == x2) {
+    set_and_check_rect(p->surf, x, y, pixel_color, p->drawn_area);
+}
+
+static void
+draw_aaline(SDL_Surface *surf, Uint32 color, float from_x, float from_y,
+            float to_x, float to_y, int blend, int *drawn_area)
+{
+    AALinePlot p;
+
+    p.surf = surf;
+    p.color = color;
+    p.blend = blend;
+    p.drawn_area = drawn_area;
+    aaline_walk(surf, from_x, from_y, to_x, to_y, aaline_plot_pixel, &p);
+}
+
+/* A 32 bit surface with a byte for each channel, and the colour of the
+ * lines split into those bytes once for all their pixels.
+ */
+typedef struct {
+    SDL_Surface *surf;
+    SDL_Rect clip;
+    Uint8 rgba[4];
+    Uint8 shifts[4];
+    Uint32 amask;
+    int blend;
+    int *drawn_area;
+} AALinePlot32;
+
+/* Plot a pixel of a 32 bit surface straight through its pixel pointer,
+ * with the same arithmetic as get_antialiased_color().
+ */
+static void
+aaline_plot_pixel32(void *ctx, int x, int y, float brightness)
+{
+    AALinePlot32 *p = (AALinePlot32 *)ctx;
+    Uint32 *pixel, old;
+    Uint8 part[4], background;
+    int i;
+
+    if (x < p->clip.x || x >= p->clip.x + p->clip.w || y < p->clip.y ||
+        y >= p->clip.y + p->clip.h)
         return;
+    pixel = (Uint32 *)((Uint8 *)p->surf->pixels +
+                       (size_t)y * p->surf->pitch) +
+            x;
+
+    if (p->blend) {
+        old = *pixel;
+        for (i = 0; i < 4; i++) {
+            background =
+                (i < 3 || p->amask) ? (Uint8)(old >> p->shifts[i]) : 255;
+            part[i] = (Uint8)(brightness * p->rgba[i] +
+                              (1 - brightness) * background);
+        }
+    }
+    else {
+        for (i = 0; i < 4; i++) {
+            part[i] = (Uint8)(brightness * p->rgba[i]);
+        }
     }
+    *pixel = ((Uint32)part[0] << p->shifts[0]) |
+             ((Uint32)part[1] << p->shifts[1]) |
+             ((Uint32)part[2] << p->shifts[2]) |
+             (((Uint32)part[3] << p->shifts[3]) & p->amask);
+    add_pixel_to_drawn_list(x, y, p->drawn_area);
+}
+
+/* Whether draw_aalines32() can draw on surf */
+static int
+aalines32_supported(SDL_Surface *surf)
+{
+    SDL_PixelFormat *format = surf->format;
+
+    return format->BytesPerPixel == 4 && format->Rloss == 0 &&
+           format->Gloss == 0 && format->Bloss == 0 &&
+           format->Rshift % 8 == 0 && format->Gshift % 8 == 0 &&
+           format->Bshift % 8 == 0 &&
+           (format->Amask == 0 ||
+            (format->Aloss == 0 && format->Ashift % 8 == 0));
+}
 
-    pixel = ((Uint8 *)surf->pixels) + surf->pitch * y1;
-    if (x1 < x2) {
-        end = pixel + x2 * surf->format->BytesPerPixel;
-        pixel += x1 * surf->format->BytesPerPixel;
+/* Draw the segments of a polyline on a surface aalines32_supported() allows.
+ * The pixels are the same as drawing each segment with draw_aaline(), but
+ * the colour and format are unpacked once, and pixels are read and written
+ * through the pixel pointer rather than with SDL_GetRGBA and SDL_MapRGBA.
+ */
+static void
+draw_aalines32(SDL_Surface *surf, Uint32 color, const float *xlist,
+               const float *ylist, Py_ssize_t length, int closed, int blend,
+               int *drawn_area)
+{
+    AALinePlot32 p;
+    float left, top, right, bottom;
+    Py_ssize_t loop, from, to;
+
+    p.surf = surf;
+    p.clip = surf->clip_rect;
+    SDL_GetRGBA(color, surf->format, &p.rgba[0], &p.rgba[1], &p.rgba[2],
+                &p.rgba[3]);
+    p.shifts[0] = surf->format->Rshift;
+    p.shifts[1] = surf->format->Gshift;
+    p.shifts[2] = surf->format->Bshift;
+    p.shifts[3] = surf->format->Amask ? surf->format->Ashift : 0;
+    p.amask = surf->format->Amask;
+    p.blend = blend;
+    p.drawn_area = drawn_area;
+
+    /* a segment wholly beyond the clip rect, widened by the pixel
+     * aaline_walk() keeps around it, has nothing to draw */
+    left = (float)p.clip.x - 2.0f;
+    top = (float)p.clip.y - 2.0f;
+    right = (float)(p.clip.x + p.clip.w) + 1.0f;
+    bottom = (float)(p.clip.y + p.clip.h) + 1.0f;
+
+    for (loop = 1; loop < length + (closed && length > 2); ++loop) {
+        from = loop - 1;
+        to = loop < length ? loop : 0;
+        if ((xlist[from] < left && xlist[to] < left) ||
+            (xlist[from] > right && xlist[to] > right) ||
+            (ylist[from] < top && ylist[to] < top) ||
+            (ylist[from] > bottom && ylist[to] > bottom))
+            continue;
+        aaline_walk(surf, xlist[from], ylist[from], xlist[to], ylist[to],
+                    aaline_plot_pixel32, &p);
     }
-    else {
-        end = pixel + x1 * surf->format->BytesPerPixel;
-        pixel += x2 * surf->format->BytesPerPixel;
+}
+
+/* Fill a run of n pixels starting at pixel with color. Every span the
+ * draw functions emit ends up here, so each bpp gets its own loop.
+ */
+static void
+fill_span(Uint8 *pixel, int n, int bpp, Uint32 color)
+{
+    Uint32 *p32;
+    Uint16 *p16;
+    int done;
+
+    switch (bpp) {
+        case 1:
+            memset(pixel, (Uint8)color, n);
+            break;
+        case 2:
+            p16 = (Uint16 *)pixel;
+            while (n--) {
+                *p16++ = (Uint16)color;
+            }
+            break;
+        case 3:
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+            color <<= 8;
+#endif
+            /* write one pixel, then keep doubling what is written */
+            memcpy(pixel, &color, 3 * sizeof(Uint8));
+            for (done = 1; done < n; done += MIN(done, n - done)) {
+                memcpy(pixel + done * 3, pixel, MIN(done, n - done) * 3);
+            }
+            break;
+        default: /*case 4*/
+            p32 = (Uint32 *)pixel;
+            while (n--) {
+                *p32++ = color;
+            }
+            break;
     }
-    switch (surf->format->BytesPerPixel) {
+}
+
+/* Write the n pixel values in colors to the run starting at pixel */
+static void
+store_span(Uint8 *pixel, int n, int bpp, const Uint32 *colors)
+{
+    Uint32 color;
+    int i;
+
+    switch (bpp) {
         case 1:
-            for (; pixel <= end; ++pixel) {
-                *pixel = (Uint8)color;
+            for (i = 0; i < n; ++i) {
+                pixel[i] = (Uint8)colors[i];
             }
             break;
         case 2:
-            for (; pixel <= end; pixel += 2) {
-                *(Uint16 *)pixel = (Uint16)color;
+            for (i = 0; i < n; ++i) {
+                ((Uint16 *)pixel)[i] = (Uint16)colors[i];
             }
             break;
         case 3:
+            for (i = 0; i < n; ++i, pixel += 3) {
+                color = colors[i];
 #if SDL_BYTEORDER == SDL_BIG_ENDIAN
-            color <<= 8;
+                color <<= 8;
 #endif
-            for (; pixel <= end; pixel += 3) {
                 memcpy(pixel, &color, 3 * sizeof(Uint8));
             }
             break;
         default: /*case 4*/
-            for (; pixel <= end; pixel += 4) {
-                *(Uint32 *)pixel = color;
-            }
+            memcpy(pixel, colors, n * sizeof(Uint32));
             break;
     }
 }
 
+static void
+drawhorzline(SDL_Surface *surf, Uint32 color, int x1, int y1, int x2)
+{
+    int bpp = surf->format->BytesPerPixel;
+
+    if (x1 == x2) {
+        return;
+    }
+    if (x2 < x1) {
+        int temp = x1;
+        x1 = x2;
+        x2 = temp;
+    }
+    fill_span((Uint8 *)surf->pixels + surf->pitch * y1 + x1 * bpp,
+              x2 - x1 + 1, bpp, color);
+}
+
 static void
 drawhorzlineclip(SDL_Surface *surf, Uint32 color, int x1, int y1, int x2)
 {
@@ -1453,10 +3416,106 @@ drawhorzlineclipbounding(SDL_Surface *surf, Uint32 color, int x1, int y1,
         return;
     }
 
-    add_pixel_to_drawn_list(x1, y1, pts);
-    add_pixel_to_drawn_list(x2, y1, pts);
+    add_pixel_to_drawn_list(x1, y1, pts);
+    add_pixel_to_drawn_list(x2, y1, pts);
+
+    drawhorzline(surf, color, x1, y1, x2);
+}
+
+/* Draw the clipped vertical run from (x, y1) to (x, y2) */
+static void
+drawvertlineclipbounding(SDL_Surface *surf, Uint32 color, int x, int y1,
+                         int y2, int *pts)
+{
+    Uint8 *pixel;
+    int bpp = surf->format->BytesPerPixel;
+    int pitch = surf->pitch;
+
+    if (x < surf->clip_rect.x || x >= surf->clip_rect.x + surf->clip_rect.w)
+        return;
+
+    if (y2 < y1) {
+        int temp = y1;
+        y1 = y2;
+        y2 = temp;
+    }
+
+    y1 = MAX(y1, surf->clip_rect.y);
+    y2 = MIN(y2, surf->clip_rect.y + surf->clip_rect.h - 1);
+
+    if (y2 < y1)
+        return;
+
+    add_pixel_to_drawn_list(x, y1, pts);
+    add_pixel_to_drawn_list(x, y2, pts);
+
+    pixel = (Uint8 *)surf->pixels + y1 * pitch + x * bpp;
+    switch (bpp) {
+        case 1:
+            for (; y1 <= y2; ++y1, pixel += pitch) {
+                *pixel = (Uint8)color;
+            }
+            break;
+        case 2:
+            for (; y1 <= y2; ++y1, pixel += pitch) {
+                *(Uint16 *)pixel = (Uint16)color;
+            }
+            break;
+        case 3:
+            for (; y1 <= y2; ++y1, pixel += pitch) {
+                fill_span(pixel, 1, 3, color);
+            }
+            break;
+        default: /*case 4*/
+            for (; y1 <= y2; ++y1, pixel += pitch) {
+                *(Uint32 *)pixel = color;
+            }
+            break;
+    }
+}
+
+/* Copy the clipped run from (x1, y) to (x2, y) from texture, which has
+ * the same pixel format and is tiled from (tx, ty)
+ */
+static void
+drawtexturedhorzlineclipbounding(SDL_Surface *surf, SDL_Surface *texture,
+                                 int tx, int ty, int x1, int y, int x2,
+                                 int *pts)
+{
+    Uint8 *pixel, *src;
+    int bpp = surf->format->BytesPerPixel;
+    int n, u, chunk;
+
+    if (y < surf->clip_rect.y || y >= surf->clip_rect.y + surf->clip_rect.h)
+        return;
+
+    if (x2 < x1) {
+        int temp = x1;
+        x1 = x2;
+        x2 = temp;
+    }
+
+    x1 = MAX(x1, surf->clip_rect.x);
+    x2 = MIN(x2, surf->clip_rect.x + surf->clip_rect.w - 1);
+
+    if (x2 < x1)
+        return;
 
-    drawhorzline(surf, color, x1, y1, x2);
+    add_pixel_to_drawn_list(x1, y, pts);
+    add_pixel_to_drawn_list(x2, y, pts);
+
+    /* the texture row and column, wrapped around for negative offsets */
+    u = (y - ty) % texture->h;
+    src = (Uint8 *)texture->pixels + (u < 0 ? u + texture->h : u) *
+                                         texture->pitch;
+    u = (x1 - tx) % texture->w;
+    u = u < 0 ? u + texture->w : u;
+    pixel = (Uint8 *)surf->pixels + y * surf->pitch + x1 * bpp;
+    for (n = x2 - x1 + 1; n > 0; n -= chunk, u = 0) {
+        chunk = MIN(n, texture->w - u);
+        memcpy(pixel, src + u * bpp, (size_t)chunk * bpp);
+        pixel += chunk * bpp;
+    }
 }
 
 int
@@ -1472,7 +3531,7 @@ static void
 draw_line_width(SDL_Surface *surf, Uint32 color, int x1, int y1, int x2,
                 int y2, int width, int *drawn_area)
 {
-    int dx, dy, err, e2, sx, sy, y;
+    int dx, dy, err, e2, sx, sy;
     int left_top, right_bottom;
     int end_x = x2;
     int end_y = y2;
@@ -1505,8 +3564,8 @@ draw_line_width(SDL_Surface *surf, Uint32 color, int x1, int y1, int x2,
                     drawhorzlineclipbounding(surf, color, left_top, y1,
                                              right_bottom, drawn_area);
                 else {
-                    for (y = left_top; y <= right_bottom; y++)
-                        set_and_check_rect(surf, x1, y, color, drawn_area);
+                    drawvertlineclipbounding(surf, color, x1, left_top,
+                                             right_bottom, drawn_area);
                 }
                 e2 = err;
                 if (e2 > -dx) {
@@ -1549,8 +3608,8 @@ draw_line_width(SDL_Surface *surf, Uint32 color, int x1, int y1, int x2,
             else {
                 while (x1 != end_x && (inside_clip(surf, x1, left_top) ||
                                        inside_clip(surf, x1, right_bottom))) {
-                    for (y = left_top; y <= right_bottom; y++)
-                        set_and_check_rect(surf, x1, y, color, drawn_area);
+                    drawvertlineclipbounding(surf, color, x1, left_top,
+                                             right_bottom, drawn_area);
                     e2 = err;
                     if (e2 > -dx) {
                         err -= dy;
@@ -1563,8 +3622,8 @@ draw_line_width(SDL_Surface *surf, Uint32 color, int x1, int y1, int x2,
                         right_bottom += sy;
                     }
                 }
-                for (y = left_top; y <= right_bottom; y++)
-                    set_and_check_rect(surf, x1, y, color, drawn_area);
+                drawvertlineclipbounding(surf, color, x1, left_top,
+                                         right_bottom, drawn_area);
             }
         }
     }
@@ -1583,17 +3642,11 @@ draw_line(SDL_Surface *surf, int x1, int y1, int x2, int y2, Uint32 color,
         return;
     }
     if (y1 == y2) { /* Horizontal line */
-        dx = (x1 < x2) ? 1 : -1;
-        for (sx = 0; sx <= abs(x1 - x2); sx++) {
-            set_and_check_rect(surf, x1 + dx * sx, y1, color, drawn_area);
-        }
-
+        drawhorzlineclipbounding(surf, color, x1, y1, x2, drawn_area);
         return;
     }
     if (x1 == x2) { /* Vertical line */
-        dy = (y1 < y2) ? 1 : -1;
-        for (sy = 0; sy <= abs(y1 - y2); sy++)
-            set_and_check_rect(surf, x1, y1 + dy * sy, color, drawn_area);
+        drawvertlineclipbounding(surf, color, x1, y1, y2, drawn_area);
         return;
     }
     dx = abs(x2 - x1), sx = x1 < x2 ? 1 : -1;
@@ -1680,7 +3733,6 @@ draw_circle_bresenham(SDL_Surface *surf, int x0, int y0, int radius,
     int i_f = 1 - i_y;
     int i_ddF_x = 0;
     int i_ddF_y = -2 * i_y;
-    int i;
 
     while (x < y) {
         if (f >= 0) {
@@ -1712,27 +3764,30 @@ draw_circle_bresenham(SDL_Surface *surf, int x0, int y0, int radius,
             thickness_inner = y - i_y;
         }
 
-        /* Numbers represent parts of circle function draw in radians
-           interval: [number - 1 * pi / 4, number * pi / 4] */
-        for (i = 0; i < thickness_inner; i++) {
-            y1 = y - i;
-            set_and_check_rect(surf, x0 + x - 1, y0 + y1 - 1, color,
-                               drawn_area); /* 7 */
-            set_and_check_rect(surf, x0 - x, y0 + y1 - 1, color,
-                               drawn_area); /* 6 */
-            set_and_check_rect(surf, x0 + x - 1, y0 - y1, color,
-                               drawn_area); /* 2 */
-            set_and_check_rect(surf, x0 - x, y0 - y1, color,
-                               drawn_area); /* 3 */
-            set_and_check_rect(surf, x0 + y1 - 1, y0 + x - 1, color,
-                               drawn_area); /* 8 */
-            set_and_check_rect(surf, x0 + y1 - 1, y0 - x, color,
-                               drawn_area); /* 1 */
-            set_and_check_rect(surf, x0 - y1, y0 + x - 1, color,
-                               drawn_area); /* 5 */
-            set_and_check_rect(surf, x0 - y1, y0 - x, color,
-                               drawn_area); /* 4 */
+        if (thickness_inner < 1) {
+            continue;
         }
+
+        /* Numbers represent parts of circle function draw in radians
+           interval: [number - 1 * pi / 4, number * pi / 4]. Each part is
+           one run of thickness_inner pixels, from y down to y1. */
+        y1 = y - thickness_inner + 1;
+        drawvertlineclipbounding(surf, color, x0 + x - 1, y0 + y1 - 1,
+                                 y0 + y - 1, drawn_area); /* 7 */
+        drawvertlineclipbounding(surf, color, x0 - x, y0 + y1 - 1,
+                                 y0 + y - 1, drawn_area); /* 6 */
+        drawvertlineclipbounding(surf, color, x0 + x - 1, y0 - y, y0 - y1,
+                                 drawn_area); /* 2 */
+        drawvertlineclipbounding(surf, color, x0 - x, y0 - y, y0 - y1,
+                                 drawn_area); /* 3 */
+        drawhorzlineclipbounding(surf, color, x0 + y1 - 1, y0 + x - 1,
+                                 x0 + y - 1, drawn_area); /* 8 */
+        drawhorzlineclipbounding(surf, color, x0 + y1 - 1, y0 - x,
+                                 x0 + y - 1, drawn_area); /* 1 */
+        drawhorzlineclipbounding(surf, color, x0 - y, y0 + x - 1, x0 - y1,
+                                 drawn_area); /* 5 */
+        drawhorzlineclipbounding(surf, color, x0 - y, y0 - x, x0 - y1,
+                                 drawn_area); /* 4 */
     }
 }
 
@@ -1882,44 +3937,28 @@ draw_circle_quadrant(SDL_Surface *surf, int x0, int y0, int radius,
             ddF_x += 2;
             f += ddF_x + 1;
             if (top_right > 0) {
-                for (y1 = y0 - x; y1 <= y0; y1++) {
-                    set_and_check_rect(surf, x0 + y - 1, y1, color,
-                                       drawn_area); /* 1 */
-                }
-                for (y1 = y0 - y; y1 <= y0; y1++) {
-                    set_and_check_rect(surf, x0 + x - 1, y1, color,
-                                       drawn_area); /* 2 */
-                }
+                drawvertlineclipbounding(surf, color, x0 + y - 1, y0 - x, y0,
+                                         drawn_area); /* 1 */
+                drawvertlineclipbounding(surf, color, x0 + x - 1, y0 - y, y0,
+                                         drawn_area); /* 2 */
             }
             if (top_left > 0) {
-                for (y1 = y0 - x; y1 <= y0; y1++) {
-                    set_and_check_rect(surf, x0 - y, y1, color,
-                                       drawn_area); /* 4 */
-                }
-                for (y1 = y0 - y; y1 <= y0; y1++) {
-                    set_and_check_rect(surf, x0 - x, y1, color,
-                                       drawn_area); /* 3 */
-                }
+                drawvertlineclipbounding(surf, color, x0 - y, y0 - x, y0,
+                                         drawn_area); /* 4 */
+                drawvertlineclipbounding(surf, color, x0 - x, y0 - y, y0,
+                                         drawn_area); /* 3 */
             }
             if (bottom_left > 0) {
-                for (y1 = y0; y1 < y0 + x; y1++) {
-                    set_and_check_rect(surf, x0 - y, y1, color,
-                                       drawn_area); /* 4 */
-                }
-                for (y1 = y0; y1 < y0 + y; y1++) {
-                    set_and_check_rect(surf, x0 - x, y1, color,
-                                       drawn_area); /* 3 */
-                }
+                drawvertlineclipbounding(surf, color, x0 - y, y0, y0 + x - 1,
+                                         drawn_area); /* 4 */
+                drawvertlineclipbounding(surf, color, x0 - x, y0, y0 + y - 1,
+                                         drawn_area); /* 3 */
             }
             if (bottom_right > 0) {
-                for (y1 = y0; y1 < y0 + x; y1++) {
-                    set_and_check_rect(surf, x0 + y - 1, y1, color,
-                                       drawn_area); /* 1 */
-                }
-                for (y1 = y0; y1 < y0 + y; y1++) {
-                    set_and_check_rect(surf, x0 + x - 1, y1, color,
-                                       drawn_area); /* 2 */
-                }
+                drawvertlineclipbounding(surf, color, x0 + y - 1, y0,
+                                         y0 + x - 1, drawn_area); /* 1 */
+                drawvertlineclipbounding(surf, color, x0 + x - 1, y0,
+                                         y0 + y - 1, drawn_area); /* 2 */
             }
         }
     }
@@ -2206,25 +4245,54 @@ draw_ellipse_thickness(SDL_Surface *surf, int x0, int y0, int width,
     }
 }
 
+/* A polygon border line in the edge table of draw_fillpoly. x is where
+ * it crosses the current row, stepped down one row at a time as
+ * x1 + dir * (offset + rem / dy).
+ */
+typedef struct {
+    int x, x1, y1, last; /* last is the final row the edge crosses */
+    int dy, dir, whole, frac, offset, rem;
+} FillEdge;
+
+static int
+compare_fill_edges(const void *a, const void *b)
+{
+    return ((const FillEdge *)a)->y1 - ((const FillEdge *)b)->y1;
+}
+
+/* Fill the clipped run from (x1, y) to (x2, y) with color, or copy it
+ * from texture if there is one
+ */
+static void
+fillpoly_span(SDL_Surface *surf, Uint32 color, const FillTexture *texture,
+              int x1, int y, int x2, int *drawn_area)
+{
+    if (texture) {
+        drawtexturedhorzlineclipbounding(surf, texture->surf, texture->x,
+                                         texture->y, x1, y, x2, drawn_area);
+    }
+    else {
+        drawhorzlineclipbounding(surf, color, x1, y, x2, drawn_area);
+    }
+}
+
 static void
 draw_fillpoly(SDL_Surface *surf, int *point_x, int *point_y,
-              Py_ssize_t num_points, Uint32 color, int *drawn_area)
+              Py_ssize_t num_points, Uint32 color, const FillTexture *texture,
+              int *drawn_area)
 {
     /* point_x : x coordinates of the points
      * point-y : the y coordinates of the points
      * num_points : the number of points
+     * texture : where to copy the pixels from, or NULL to fill with color
      */
     Py_ssize_t i, i_previous;  // i_previous is the index of the point before i
-    int y, miny, maxy;
+    Py_ssize_t n_edges = 0, n_active = 0, next = 0, j;
+    int y, miny, maxy, top, bottom;
     int x1, y1;
     int x2, y2;
-    /* x_intersect are the x-coordinates of intersections of the polygon
-     * with some horizontal line */
-    int *x_intersect = PyMem_New(int, num_points);
-    if (x_intersect == NULL) {
-        PyErr_NoMemory();
-        return;
-    }
+    long long offset;
+    FillEdge *edges, *edge, **active;
 
     /* Determine Y maxima */
     miny = point_y[0];
@@ -2244,54 +4312,107 @@ draw_fillpoly(SDL_Surface *surf, int *point_x, int *point_y,
             minx = MIN(minx, point_x[i]);
             maxx = MAX(maxx, point_x[i]);
         }
-        drawhorzlineclipbounding(surf, color, minx, miny, maxx, drawn_area);
-        PyMem_Free(x_intersect);
+        fillpoly_span(surf, color, texture, minx, miny, maxx, drawn_area);
         return;
     }
 
-    /* Draw, scanning y
-     * ----------------
-     * The algorithm uses a horizontal line (y) that moves from top to the
-     * bottom of the polygon:
-     *
-     * 1. search intersections with the border lines
-     * 2. sort intersections (x_intersect)
-     * 3. each two x-coordinates in x_intersect are then inside the polygon
-     *    (draw line for a pair of two such points)
+    edges = PyMem_New(FillEdge, num_points);
+    active = PyMem_New(FillEdge *, num_points);
+    if (edges == NULL || active == NULL) {
+        PyMem_Free(edges);
+        PyMem_Free(active);
+        PyErr_NoMemory();
+        return;
+    }
+
+    /* Build the edge table, sorted by top row. A horizontal line (y)
+     * moves from top to the bottom of the polygon: each edge crosses it
+     * from its upper end to just above its lower end, or to its lower end
+     * too when that is the lowest line (maxy).
      */
-    for (y = miny; (y <= maxy); y++) {
-        // n_intersections is the number of intersections with the polygon
-        int n_intersections = 0;
-        for (i = 0; (i < num_points); i++) {
-            i_previous = ((i) ? (i - 1) : (num_points - 1));
-
-            y1 = point_y[i_previous];
-            y2 = point_y[i];
-            if (y1 < y2) {
-                x1 = point_x[i_previous];
-                x2 = point_x[i];
-            }
-            else if (y1 > y2) {
-                y2 = point_y[i_previous];
-                y1 = point_y[i];
-                x2 = point_x[i_previous];
-                x1 = point_x[i];
+    for (i = 0; (i < num_points); i++) {
+        i_previous = ((i) ? (i - 1) : (num_points - 1));
+
+        y1 = point_y[i_previous];
+        y2 = point_y[i];
+        if (y1 < y2) {
+            x1 = point_x[i_previous];
+            x2 = point_x[i];
+        }
+        else if (y1 > y2) {
+            y2 = point_y[i_previous];
+            y1 = point_y[i];
+            x2 = point_x[i_previous];
+            x1 = point_x[i];
+        }
+        else {  // y1 == y2 : has to be handled as special case (below)
+            continue;
+        }
+        edge = &edges[n_edges++];
+        edge->x1 = x1;
+        edge->y1 = y1;
+        edge->last = (y2 == maxy) ? y2 : y2 - 1;
+        edge->dy = y2 - y1;
+        edge->dir = x2 < x1 ? -1 : 1;
+        edge->whole = abs(x2 - x1) / edge->dy;
+        edge->frac = abs(x2 - x1) % edge->dy;
+    }
+    qsort(edges, n_edges, sizeof(FillEdge), compare_fill_edges);
+
+    /* Draw, scanning y over the clip area
+     * -----------------------------------
+     * 1. drop the edges that ended above y and add those starting at y
+     * 2. re-sort the active edges by x, which barely changes between rows
+     * 3. each two x-coordinates are then inside the polygon (draw line for
+     *    a pair of two such points)
+     * 4. step every active edge down to the next row
+     */
+    top = MAX(miny, surf->clip_rect.y);
+    bottom = MIN(maxy, surf->clip_rect.y + surf->clip_rect.h - 1);
+    for (y = top; (y <= bottom); y++) {
+        for (i = j = 0; (i < n_active); i++) {
+            if (active[i]->last >= y) {
+                active[j++] = active[i];
             }
-            else {  // y1 == y2 : has to be handled as special case (below)
+        }
+        n_active = j;
+
+        for (; next < n_edges && edges[next].y1 <= y; next++) {
+            edge = &edges[next];
+            if (edge->last < y) {
                 continue;
             }
-            if (((y >= y1) && (y < y2)) || ((y == maxy) && (y2 == maxy))) {
-                // add intersection if y crosses the edge (excluding the lower
-                // end), or when we are on the lowest line (maxy)
-                x_intersect[n_intersections++] =
-                    (y - y1) * (x2 - x1) / (y2 - y1) + x1;
+            /* the same rounding toward zero as a single division */
+            offset = (long long)(y - edge->y1) *
+                     (edge->whole * (long long)edge->dy + edge->frac);
+            edge->offset = (int)(offset / edge->dy);
+            edge->rem = (int)(offset % edge->dy);
+            edge->x = edge->x1 + edge->dir * edge->offset;
+            active[n_active++] = edge;
+        }
+
+        for (i = 1; (i < n_active); i++) {
+            edge = active[i];
+            for (j = i; j > 0 && active[j - 1]->x > edge->x; j--) {
+                active[j] = active[j - 1];
             }
+            active[j] = edge;
+        }
+
+        for (i = 0; (i + 1 < n_active); i += 2) {
+            fillpoly_span(surf, color, texture, active[i]->x, y,
+                          active[i + 1]->x, drawn_area);
         }
-        qsort(x_intersect, n_intersections, sizeof(int), compare_int);
 
-        for (i = 0; (i < n_intersections); i += 2) {
-            drawhorzlineclipbounding(surf, color, x_intersect[i], y,
-                                     x_intersect[i + 1], drawn_area);
+        for (i = 0; (i < n_active); i++) {
+            edge = active[i];
+            edge->offset += edge->whole;
+            edge->rem += edge->frac;
+            if (edge->rem >= edge->dy) {
+                edge->offset++;
+                edge->rem -= edge->dy;
+            }
+            edge->x = edge->x1 + edge->dir * edge->offset;
         }
     }
 
@@ -2309,11 +4430,92 @@ draw_fillpoly(SDL_Surface *surf, int *point_x, int *point_y,
         y = point_y[i];
 
         if ((miny < y) && (point_y[i_previous] == y) && (y < maxy)) {
-            drawhorzlineclipbounding(surf, color, point_x[i], y,
-                                     point_x[i_previous], drawn_area);
+            fillpoly_span(surf, color, texture, point_x[i], y,
+                          point_x[i_previous], drawn_area);
+        }
+    }
+    PyMem_Free(edges);
+    PyMem_Free(active);
+}
+
+/* Entry of lut, with last as its final index, for a gradient position t
+ * that runs from 0 to 1
+ */
+static Uint32
+gradient_color(const Uint32 *lut, int last, double t)
+{
+    if (!(t > 0.0)) {
+        return lut[0];
+    }
+    if (t >= 1.0) {
+        return lut[last];
+    }
+    return lut[(int)(t * last + 0.5)];
+}
+
+/* Fill area, which is inside the clip area, with the gradient in lut. t
+ * is the gradient position at the top left pixel and it changes by dtx
+ * to the right and by dty downwards. row is scratch space for area->w
+ * pixel values.
+ */
+static void
+draw_linear_gradient(SDL_Surface *surf, SDL_Rect *area, const Uint32 *lut,
+                     int last, double t, double dtx, double dty, Uint32 *row,
+                     int *drawn_area)
+{
+    int bpp = surf->format->BytesPerPixel;
+    Uint8 *pixel = (Uint8 *)surf->pixels + area->y * surf->pitch +
+                   area->x * bpp;
+    int x, y;
+
+    for (y = 0; y < area->h; ++y, t += dty, pixel += surf->pitch) {
+        if (dtx == 0.0) {
+            /* each row is one color */
+            fill_span(pixel, area->w, bpp, gradient_color(lut, last, t));
+            continue;
+        }
+        for (x = 0; x < area->w; ++x) {
+            row[x] = gradient_color(lut, last, t + x * dtx);
+        }
+        store_span(pixel, area->w, bpp, row);
+    }
+    add_pixel_to_drawn_list(area->x, area->y, drawn_area);
+    add_pixel_to_drawn_list(area->x + area->w - 1, area->y + area->h - 1,
+                            drawn_area);
+}
+
+/* Fill the pixels within radius of (cx, cy) with the gradient in lut,
+ * from its first entry at the center to its last at radius. row is
+ * scratch space for a clip area width of pixel values.
+ */
+static void
+draw_radial_gradient(SDL_Surface *surf, float cx, float cy, float radius,
+                     const Uint32 *lut, int last, Uint32 *row,
+                     int *drawn_area)
+{
+    SDL_Rect *clip = &surf->clip_rect;
+    int bpp = surf->format->BytesPerPixel;
+    int x, y, x1, x2, y1, y2;
+    double dx, dy2, half, inv = 1.0 / radius;
+
+    y1 = MAX((int)ceil(cy - radius), clip->y);
+    y2 = MIN((int)floor(cy + radius), clip->y + clip->h - 1);
+    for (y = y1; y <= y2; ++y) {
+        dy2 = (y - cy) * (double)(y - cy);
+        half = sqrt(MAX((double)radius * radius - dy2, 0.0));
+        x1 = MAX((int)ceil(cx - half), clip->x);
+        x2 = MIN((int)floor(cx + half), clip->x + clip->w - 1);
+        if (x2 < x1) {
+            continue;
         }
+        for (x = x1, dx = x1 - cx; x <= x2; ++x, ++dx) {
+            row[x - x1] = gradient_color(lut, last, sqrt(dx * dx + dy2) * inv);
+        }
+        store_span((Uint8 *)surf->pixels + y * surf->pitch + x1 * bpp,
+                   x2 - x1 + 1, bpp, row);
+        add_pixel_to_drawn_list(x1, y, drawn_area);
+        add_pixel_to_drawn_list(x2, y, drawn_area);
     }
-    PyMem_Free(x_intersect);
 }
 
 static void
@@ -2377,7 +4579,7 @@ draw_round_rect(SDL_Surface *surf, int x1, int y1, int x2, int y2, int radius,
         pts[13] = y2;
         pts[14] = y2;
         pts[15] = y2 - bottom_left;
-        draw_fillpoly(surf, pts, pts + 8, 8, color, drawn_area);
+        draw_fillpoly(surf, pts, pts + 8, 8, color, NULL, drawn_area);
         draw_circle_quadrant(surf, x2 - top_right + 1, y1 + top_right,
                              top_right, 0, color, 1, 0, 0, 0, drawn_area);
         draw_circle_quadrant(surf, x1 + top_left, y1 + top_left, top_left, 0,
@@ -2451,6 +4653,506 @@ draw_round_rect(SDL_Surface *surf, int x1, int y1, int x2, int y2, int radius,
     }
 }
 
+/* Span tables for shapes drawn again and again at the same size, such as
+ * the buttons and panels of a user interface. A table holds the runs of
+ * pixels each row of the shape covers, so drawing the shape again is one
+ * span fill for each run. The least recently drawn table is dropped to
+ * make room for a new one.
+ */
+#define SHAPE_CACHE_SIZE 32
+
+/* Largest box, in pixels, of a shape kept in the cache. Building a table
+ * draws the shape into a scratch surface of this size.
+ */
+#define SHAPE_CACHE_MAX_AREA (512 * 512)
+
+/* Margin around the rect of a shape in its table, so that a shape reaching
+ * outside its rect is seen when the table is built
+ */
+#define SHAPE_MARGIN 2
+
+typedef struct {
+    int key[SHAPE_KEY_LEN];
+    int h;      /* rows in the table, which starts SHAPE_MARGIN above and
+                 * left of the shape */
+    int *rows;  /* h + 1 offsets into spans of the runs of each row */
+    int *spans; /* start and end x of each run, from the left of the table */
+    unsigned long used; /* shape_cache_clock when last drawn, 0 if free */
+} ShapeSpans;
+
+static ShapeSpans shape_cache[SHAPE_CACHE_SIZE];
+static unsigned long shape_cache_clock = 0;
+
+/* Draw the shape named by key with its position at (x, y) */
+static void
+shape_draw(SDL_Surface *surf, const int *key, int x, int y, Uint32 color,
+           int *drawn_area)
+{
+    if (key[0] == SHAPE_ELLIPSE) {
+        draw_ellipse_filled(surf, x, y, key[1], key[2], color, drawn_area);
+    }
+    else {
+        draw_round_rect(surf, x, y, x + key[1] - 1, y + key[2] - 1, key[4],
+                        key[3], color, key[5], key[6], key[7], key[8],
+                        drawn_area);
+    }
+}
+
+/* Fill in entry for the shape named by key, by drawing it into a w by h
+ * scratch surface and reading back its runs. Returns 0 if the shape is not
+ * cached.
+ */
+static int
+shape_spans_build(ShapeSpans *entry, const int *key, int w, int h)
+{
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN, INT_MIN};
+    SDL_Surface *scratch;
+    Uint8 *row;
+    int *table, *spans;
+    int x, y, start, runs = 0;
+
+    scratch = SDL_CreateRGBSurface(0, w, h, 8, 0, 0, 0, 0);
+    if (!scratch) {
+        return 0;
+    }
+    shape_draw(scratch, key, SHAPE_MARGIN, SHAPE_MARGIN, 1, drawn_area);
+    if (PyErr_Occurred() ||
+        (drawn_area[0] != INT_MAX &&
+         (drawn_area[0] <= 0 || drawn_area[1] <= 0 ||
+          drawn_area[2] >= w - 1 || drawn_area[3] >= h - 1))) {
+        /* out of memory, or the shape reached the edge of its table */
+        PyErr_Clear();
+        SDL_FreeSurface(scratch);
+        return 0;
+    }
+
+    for (y = 0; y < h; y++) {
+        row = (Uint8 *)scratch->pixels + (size_t)y * scratch->pitch;
+        for (x = 0; x < w; x++) {
+            if (row[x] && (x == 0 || !row[x - 1])) {
+                runs++;
+            }
+        }
+    }
+    table = PyMem_New(int, (size_t)h + 1 + 2 * (size_t)runs);
+    if (!table) {
+        PyErr_Clear();
+        SDL_FreeSurface(scratch);
+        return 0;
+    }
+    spans = table + h + 1;
+    runs = 0;
+    for (y = 0; y < h; y++) {
+        row = (Uint8 *)scratch->pixels + (size_t)y * scratch->pitch;
+        table[y] = 2 * runs;
+        for (x = 0; x < w;) {
+            if (!row[x]) {
+                x++;
+                continue;
+            }
+            start = x;
+            while (x < w && row[x]) {
+                x++;
+            }
+            spans[2 * runs] = start;
+            spans[2 * runs + 1] = x - 1;
+            runs++;
+        }
+    }
+    table[h] = 2 * runs;
+    SDL_FreeSurface(scratch);
+
+    memcpy(entry->key, key, sizeof(entry->key));
+    entry->h = h;
+    entry->rows = table;
+    entry->spans = spans;
+    return 1;
+}
+
+/* Draw the shape named by key with its position at (x, y), from its span
+ * table. The pixels drawn are the same as those of its drawing function.
+ */
+static void
+draw_shape_cached(SDL_Surface *surf, const int *key, int x, int y,
+                  Uint32 color, int *drawn_area)
+{
+    SDL_Rect *clip = &surf->clip_rect;
+    ShapeSpans *entry = NULL, *oldest = shape_cache;
+    int w = key[1] + 2 * SHAPE_MARGIN, h = key[2] + 2 * SHAPE_MARGIN;
+    int row, last, i;
+    int *spans;
+
+    if (key[1] < 1 || key[2] < 1 ||
+        (long long)w * h > SHAPE_CACHE_MAX_AREA) {
+        /* empty, or too big to cache */
+        shape_draw(surf, key, x, y, color, drawn_area);
+        return;
+    }
+    if (key[0] == SHAPE_ROUND_RECT && key[3] > 0 &&
+        (2 * key[3] > MIN(key[1], key[2]) || x - SHAPE_MARGIN < clip->x ||
+         y - SHAPE_MARGIN < clip->y ||
+         x - SHAPE_MARGIN + w > clip->x + clip->w ||
+         y - SHAPE_MARGIN + h > clip->y + clip->h)) {
+        /* a wide line of an outline is dropped along with its middle when
+         * that is clipped, so only outlines inside the clip area, and not
+         * wider than the rect, are the same pixels as their span table
+         */
+        shape_draw(surf, key, x, y, color, drawn_area);
+        return;
+    }
+
+    for (i = 0; i < SHAPE_CACHE_SIZE; i++) {
+        if (shape_cache[i].used &&
+            !memcmp(shape_cache[i].key, key, sizeof(shape_cache[i].key))) {
+            entry = &shape_cache[i];
+            break;
+        }
+        if (shape_cache[i].used < oldest->used) {
+            oldest = &shape_cache[i];
+        }
+    }
+    if (!entry) {
+        if (oldest->used) {
+            PyMem_Free(oldest->rows);
+            oldest->used = 0;
+        }
+        if (!shape_spans_build(oldest, key, w, h)) {
+            shape_draw(surf, key, x, y, color, drawn_area);
+            return;
+        }
+        entry = oldest;
+    }
+    entry->used = ++shape_cache_clock;
+
+    x -= SHAPE_MARGIN;
+    y -= SHAPE_MARGIN;
+    row = MAX(clip->y - y, 0);
+    last = MIN(clip->y + clip->h - y, entry->h);
+    for (; row < last; row++) {
+        spans = entry->spans + entry->rows[row];
+        for (i = entry->rows[row]; i < entry->rows[row + 1]; i += 2) {
+            drawhorzlineclipbounding(surf, color, x + spans[0], y + row,
+                                     x + spans[1], drawn_area);
+            spans += 2;
+        }
+    }
+}
+
+/* Largest gap, in pixels, between the inside and outside of a curve that
+ * the lines drawn for it may span
+ */
+#define AA_FLATNESS 0.0625
+
+/* Set up r for a shape within minx, miny, maxx, maxy, as clipped to the
+ * surface clip area. Returns 1 on success, 0 if nothing of the shape is
+ * inside the clip area, and -1 if out of memory.
+ */
+static int
+aa_raster_init(AARaster *r, SDL_Surface *surf, float minx, float miny,
+               float maxx, float maxy)
+{
+    SDL_Rect *clip = &surf->clip_rect;
+    double left = MAX(floor(minx), (double)clip->x);
+    double top = MAX(floor(miny), (double)clip->y);
+    double right = MIN(ceil(maxx), (double)clip->x + clip->w);
+    double bottom = MIN(ceil(maxy), (double)clip->y + clip->h);
+
+    if (!(left < right) || !(top < bottom)) {
+        return 0;
+    }
+    r->left = (int)left;
+    r->top = (int)top;
+    r->w = (int)right - r->left;
+    r->h = (int)bottom - r->top;
+    r->cells = (float *)PyMem_Calloc((size_t)(r->w + 2) * r->h,
+                                     sizeof(float));
+    if (!r->cells) {
+        return -1;
+    }
+    r->startx = r->curx = 0.0f;
+    r->starty = r->cury = 0.0f;
+    return 1;
+}
+
+/* Add the coverage change along the edge from (x0, y0) to (x1, y1), both
+ * in box coordinates with 0 <= x <= w. This is the exact area of each
+ * cell to the right of the edge, signed by the edge direction.
+ */
+static void
+aa_raster_cells(AARaster *r, float x0, float y0, float x1, float y1)
+{
+    float dir = 1.0f, dxdy, x, xnext, xa, xb, dy, d;
+    float x0f, x1f, s, a0, a1, a2, am, xmf, w = (float)r->w;
+    float *row;
+    int y, yend, xai, xbi, xi;
+
+    if (y0 == y1) {
+        return;
+    }
+    if (y0 > y1) {
+        dir = -1.0f;
+        swap(&x0, &x1);
+        swap(&y0, &y1);
+    }
+    if (y1 <= 0.0f || y0 >= (float)r->h) {
+        return;
+    }
+    dxdy = (x1 - x0) / (y1 - y0);
+    x = x0;
+    if (y0 < 0.0f) {
+        x = MIN(MAX(x - y0 * dxdy, 0.0f), w);
+        y0 = 0.0f;
+    }
+    y1 = MIN(y1, (float)r->h);
+    yend = (int)ceilf(y1);
+
+    for (y = (int)y0; y < yend; ++y) {
+        row = r->cells + (size_t)y * (r->w + 2);
+        dy = MIN((float)(y + 1), y1) - MAX((float)y, y0);
+        xnext = MIN(MAX(x + dxdy * dy, 0.0f), w);
+        d = dy * dir;
+        xa = MIN(x, xnext);
+        xb = MAX(x, xnext);
+        xai = (int)floorf(xa);
+        xbi = (int)ceilf(xb);
+        if (xbi <= xai + 1) {
+            /* the edge stays within one cell on this row */
+            xmf = 0.5f * (x + xnext) - xai;
+            row[xai] += d - d * xmf;
+            row[xai + 1] += d * xmf;
+        }
+        else {
+            s = 1.0f / (xb - xa);
+            x0f = xa - xai;
+            a0 = 0.5f * s * (1.0f - x0f) * (1.0f - x0f);
+            x1f = xb - xbi + 1.0f;
+            am = 0.5f * s * x1f * x1f;
+            row[xai] += d * a0;
+            if (xbi == xai + 2) {
+                row[xai + 1] += d * (1.0f - a0 - am);
+            }
+            else {
+                a1 = s * (1.5f - x0f);
+                row[xai + 1] += d * (a1 - a0);
+                for (xi = xai + 2; xi < xbi - 1; ++xi) {
+                    row[xi] += d * s;
+                }
+                a2 = a1 + (xbi - xai - 3) * s;
+                row[xbi - 1] += d * (1.0f - a2 - am);
+            }
+            row[xbi] += d * am;
+        }
+        x = xnext;
+    }
+}
+
+/* Add the edge from (x0, y0) to (x1, y1), in surface coordinates. Parts
+ * left of the box still cover the whole row to their right, so they are
+ * moved onto its left side. Parts right of the box cover nothing in it.
+ */
+static void
+aa_raster_edge(AARaster *r, float x0, float y0, float x1, float y1)
+{
+    float t[4], w = (float)r->w;
+    float xa, ya, xb, yb;
+    int n = 0, i;
+
+    x0 -= r->left;
+    x1 -= r->left;
+    y0 -= r->top;
+    y1 -= r->top;
+    if (x0 >= w && x1 >= w) {
+        return;
+    }
+
+    t[n++] = 0.0f;
+    if ((x0 < 0.0f) != (x1 < 0.0f)) {
+        t[n++] = -x0 / (x1 - x0);
+    }
+    if ((x0 < w) != (x1 < w)) {
+        t[n++] = (w - x0) / (x1 - x0);
+    }
+    if (n == 3 && t[1] > t[2]) {
+        swap(&t[1], &t[2]);
+    }
+    t[n++] = 1.0f;
+
+    xa = x0;
+    ya = y0;
+    for (i = 1; i < n; ++i) {
+        if (i == n - 1) {
+            xb = x1;
+            yb = y1;
+        }
+        else {
+            xb = x0 + (x1 - x0) * t[i];
+            yb = y0 + (y1 - y0) * t[i];
+        }
+        if ((xa + xb) * 0.5f < w) {
+            aa_raster_cells(r, MIN(MAX(xa, 0.0f), w), ya,
+                            MIN(MAX(xb, 0.0f), w), yb);
+        }
+        xa = xb;
+        ya = yb;
+    }
+}
+
+/* Close the current contour of r and start a new one at (x, y) */
+static void
+aa_raster_move_to(AARaster *r, float x, float y)
+{
+    aa_raster_close(r);
+    r->startx = r->curx = x;
+    r->starty = r->cury = y;
+}
+
+static void
+aa_raster_line_to(AARaster *r, float x, float y)
+{
+    aa_raster_edge(r, r->curx, r->cury, x, y);
+    r->curx = x;
+    r->cury = y;
+}
+
+static void
+aa_raster_close(AARaster *r)
+{
+    aa_raster_line_to(r, r->startx, r->starty);
+}
+
+/* Add lines along the arc of the ellipse centered on (cx, cy) with radii
+ * rx and ry, from angle start to stop in radians. The arc continues from
+ * the current point, which should be its start. The inner points sit just
+ * outside the curve, so the lines cross it and stay within AA_FLATNESS / 2
+ * of it on either side.
+ */
+static void
+aa_raster_arc(AARaster *r, float cx, float cy, float rx, float ry,
+              double start, double stop)
+{
+    double radius = MAX(rx, ry), step = M_PI / 2.0, angle, grow;
+    int i, n;
+
+    if (radius > AA_FLATNESS) {
+        step = MIN(step, 2.0 * acos(1.0 - AA_FLATNESS / radius));
+    }
+    n = (int)MIN(ceil((stop - start) / step), 65536.0);
+    n = MAX(n, 1);
+    grow = 2.0 / (1.0 + cos((stop - start) / n / 2.0));
+    for (i = 1; i < n; ++i) {
+        angle = start + (stop - start) * i / n;
+        aa_raster_line_to(r, cx + (float)(rx * grow * cos(angle)),
+                          cy + (float)(ry * grow * sin(angle)));
+    }
+    aa_raster_line_to(r, cx + rx * (float)cos(stop),
+                      cy + ry * (float)sin(stop));
+}
+
+/* Add the n point polygon xs, ys as a contour of its own, turned so that
+ * it always adds coverage. Overlapping pieces of one shape then join up
+ * instead of cancelling each other out.
+ */
+static void
+aa_raster_piece(AARaster *r, const float *xs, const float *ys, int n)
+{
+    float area = 0.0f;
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        area += xs[i] * ys[(i + 1) % n] - xs[(i + 1) % n] * ys[i];
+    }
+    if (area >= 0.0f) {
+        aa_raster_move_to(r, xs[0], ys[0]);
+        for (i = 1; i < n; ++i) {
+            aa_raster_line_to(r, xs[i], ys[i]);
+        }
+    }
+    else {
+        aa_raster_move_to(r, xs[n - 1], ys[n - 1]);
+        for (i = n - 2; i >= 0; --i) {
+            aa_raster_line_to(r, xs[i], ys[i]);
+        }
+    }
+}
+
+/* Read the pixel at x, y, which is inside the surface */
+static Uint32
+aa_get_pixel(SDL_Surface *surf, int x, int y)
+{
+    Uint8 *p = (Uint8 *)surf->pixels + y * surf->pitch +
+               x * surf->format->BytesPerPixel;
+
+    switch (surf->format->BytesPerPixel) {
+        case 1:
+            return *p;
+        case 2:
+            return *(Uint16 *)p;
+        case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            return p[0] | p[1] << 8 | p[2] << 16;
+#else
+            return p[2] | p[1] << 8 | p[0] << 16;
+#endif
+        default: /*case 4*/
+            return *(Uint32 *)p;
+    }
+}
+
+/* Fill the outline in r with color, blending each edge pixel with the
+ * surface by how much of it the outline covers. Overlapping parts of the
+ * outline are filled once.
+ */
+static void
+aa_raster_fill(AARaster *r, SDL_Surface *surf, Uint32 color,
+               int *drawn_area)
+{
+    SDL_PixelFormat *format = surf->format;
+    Uint8 rgba[4], bg[4];
+    float acc, *row;
+    int x, y, px, py, run, alpha, i;
+
+    SDL_GetRGBA(color, format, &rgba[0], &rgba[1], &rgba[2], &rgba[3]);
+    for (y = 0; y < r->h; ++y) {
+        row = r->cells + (size_t)y * (r->w + 2);
+        py = r->top + y;
+        acc = 0.0f;
+        run = -1;
+        for (x = 0; x <= r->w; ++x) {
+            alpha = 0;
+            if (x < r->w) {
+                acc += row[x];
+                alpha = (int)(MIN(fabsf(acc), 1.0f) * 255.0f + 0.5f);
+                if (alpha == 255) {
+                    if (run < 0) {
+                        run = x;
+                    }
+                    continue;
+                }
+            }
+            if (run >= 0) {
+                /* a run of fully covered pixels ends before x */
+                drawhorzlineclipbounding(surf, color, r->left + run, py,
+                                         r->left + x - 1, drawn_area);
+                run = -1;
+            }
+            if (alpha > 0) {
+                px = r->left + x;
+                SDL_GetRGBA(aa_get_pixel(surf, px, py), format, &bg[0],
+                            &bg[1], &bg[2], &bg[3]);
+                for (i = 0; i < 4; ++i) {
+                    bg[i] = (Uint8)((rgba[i] * alpha + bg[i] * (255 - alpha) +
+                                     127) /
+                                    255);
+                }
+                set_and_check_rect(
+                    surf, px, py,
+                    SDL_MapRGBA(format, bg[0], bg[1], bg[2], bg[3]),
+                    drawn_area);
+            }
+        }
+    }
+}
+
 /* List of python functions */
 static PyMethodDef _draw_methods[] = {
     {"aaline", (PyCFunction)aaline, METH_VARARGS | METH_KEYWORDS,
@@ -2470,11 +5172,34 @@ static PyMethodDef _draw_methods[] = {
      DOC_PYGAMEDRAWPOLYGON},
     {"rect", (PyCFunction)rect, METH_VARARGS | METH_KEYWORDS,
      DOC_PYGAMEDRAWRECT},
+    {"circles", (PyCFunction)circles, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEDRAWCIRCLES},
+    {"rects", (PyCFunction)rects, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEDRAWRECTS},
+    {"line_segments", (PyCFunction)line_segments,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEDRAWLINESEGMENTS},
+    {"aapolygon", (PyCFunction)aapolygon, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEDRAWAAPOLYGON},
+    {"aacircle", (PyCFunction)aacircle, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEDRAWAACIRCLE},
+    {"aaellipse", (PyCFunction)aaellipse, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEDRAWAAELLIPSE},
+    {"aarect", (PyCFunction)aarect, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEDRAWAARECT},
+    {"path", (PyCFunction)path, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEDRAWPATH},
+    {"linear_gradient", (PyCFunction)linear_gradient,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEDRAWLINEARGRADIENT},
+    {"radial_gradient", (PyCFunction)radial_gradient,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEDRAWRADIALGRADIENT},
+    {"textured_polygon", (PyCFunction)textured_polygon,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEDRAWTEXTUREDPOLYGON},
 
     {NULL, NULL, 0, NULL}};
 
 MODINIT_DEFINE(draw)
 {
+    PyObject *module;
     static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
                                          "draw",
                                          DOC_PYGAMEDRAW,
@@ -2505,6 +5230,23 @@ MODINIT_DEFINE(draw)
         return NULL;
     }
 
+    /* type preparation */
+    if (PyType_Ready(&pgCurve_Type) < 0) {
+        return NULL;
+    }
+
     /* create the module */
-    return PyModule_Create(&_module);
+    module = PyModule_Create(&_module);
+    if (!module) {
+        return NULL;
+    }
+
+    Py_INCREF(&pgCurve_Type);
+    if (PyModule_AddObject(module, "Curve", (PyObject *)&pgCurve_Type)) {
+        Py_DECREF(&pgCurve_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    return module;
 }
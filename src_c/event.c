@@ -85,8 +85,16 @@ static int _pg_event_is_init = 0;
 /* emscripten does not allow multithreading for now and SDL_CreateMutex fails.
  * Don't bother with mutexes on emscripten for now */
 static SDL_mutex *pg_evfilter_mutex = NULL;
+
+/* Posted when an event enters the queue or pygame.event.wakeup() is called,
+ * so _pg_event_wait() does not need to sleep a full millisecond between
+ * checks of the queue. Immortalised like the mutex above. */
+static SDL_sem *pg_event_wait_sem = NULL;
 #endif
 
+/* set by pgEvent_Wakeup() to make _pg_event_wait() return without an event */
+static SDL_atomic_t pg_event_wakeup_pending;
+
 static struct ScanAndUnicode {
     SDL_Scancode key;
     char unicode[UNICODE_LEN];
@@ -95,6 +103,11 @@ static struct ScanAndUnicode {
 static int pg_key_repeat_delay = 0;
 static int pg_key_repeat_interval = 0;
 
+/* whether runs of MOUSEMOTION and FINGERMOTION events are merged into one
+ * event when the queue is pumped, see pygame.event.set_coalesce() */
+static int _pg_coalesce_mousemotion = 0;
+static int _pg_coalesce_fingermotion = 0;
+
 static SDL_TimerID _pg_repeat_timer = 0;
 static SDL_Event _pg_repeat_event;
 static SDL_Event _pg_last_keydown_event = {0};
@@ -440,6 +453,44 @@ _pg_translate_windowevent(void *_, SDL_Event *event)
     return 1;
 }
 
+/* Merge a motion event into the one just before it in the queue when both
+ * come from the same device: the motion is summed and the rest is taken from
+ * the later event. SDL holds the queue lock while filtering, and the previous
+ * event kept is in *userdata. */
+static int SDLCALL
+_pg_coalesce_motion(void *userdata, SDL_Event *event)
+{
+    SDL_Event **prev = (SDL_Event **)userdata;
+    SDL_Event *last = *prev;
+
+    if (last && last->type == event->type) {
+        if (event->type == SDL_MOUSEMOTION && _pg_coalesce_mousemotion &&
+            last->motion.which == event->motion.which &&
+            last->motion.windowID == event->motion.windowID) {
+            int xrel = last->motion.xrel + event->motion.xrel;
+            int yrel = last->motion.yrel + event->motion.yrel;
+
+            last->motion = event->motion;
+            last->motion.xrel = xrel;
+            last->motion.yrel = yrel;
+            return 0;
+        }
+        if (event->type == SDL_FINGERMOTION && _pg_coalesce_fingermotion &&
+            last->tfinger.touchId == event->tfinger.touchId &&
+            last->tfinger.fingerId == event->tfinger.fingerId) {
+            float dx = last->tfinger.dx + event->tfinger.dx;
+            float dy = last->tfinger.dy + event->tfinger.dy;
+
+            last->tfinger = event->tfinger;
+            last->tfinger.dx = dx;
+            last->tfinger.dy = dy;
+            return 0;
+        }
+    }
+    *prev = event;
+    return 1;
+}
+
 static int SDLCALL
 _pg_remove_pending_VIDEORESIZE(void *userdata, SDL_Event *event)
 {
@@ -466,6 +517,27 @@ _pg_remove_pending_VIDEOEXPOSE(void *userdata, SDL_Event *event)
     return 1;
 }
 
+/* Wake _pg_event_wait() if it is sleeping. This can be called from any
+ * thread, without the GIL. */
+static void
+_pg_event_wait_signal(void)
+{
+#ifndef __EMSCRIPTEN__
+    /* the count only needs to reach 1, each wakeup checks the queue again */
+    if (pg_event_wait_sem && SDL_SemValue(pg_event_wait_sem) == 0)
+        SDL_SemPost(pg_event_wait_sem);
+#endif
+}
+
+/* Make the wait() in progress, or the next one, return a NOEVENT if no event
+ * comes first. Safe to call from any thread without holding the GIL. */
+static void
+pgEvent_Wakeup(void)
+{
+    SDL_AtomicSet(&pg_event_wakeup_pending, 1);
+    _pg_event_wait_signal();
+}
+
 /* SDL 2 to SDL 1.2 event mapping and SDL 1.2 key repeat emulation,
  * this can alter events in-place.
  * This function can be called from multiple threads, so a mutex must be held
@@ -598,7 +670,12 @@ pg_event_filter(void *_, SDL_Event *event)
             return RAISE(pgExc_SDLError, SDL_GetError()), 0;
         */
     }
-    return SDL_EventState(_pg_pgevent_proxify(event->type), SDL_QUERY);
+    if (SDL_EventState(_pg_pgevent_proxify(event->type), SDL_QUERY) ==
+        SDL_IGNORE)
+        return 0;
+    /* events pushed from other threads end the sleep of wait() */
+    _pg_event_wait_signal();
+    return 1;
 }
 
 /* The two keyrepeat functions below modify state accessed by the event filter,
@@ -653,6 +730,8 @@ pgEvent_AutoInit(PyObject *self, PyObject *_null)
     if (!_pg_event_is_init) {
         pg_key_repeat_delay = 0;
         pg_key_repeat_interval = 0;
+        _pg_coalesce_mousemotion = 0;
+        _pg_coalesce_fingermotion = 0;
 #ifndef __EMSCRIPTEN__
         if (!pg_evfilter_mutex) {
             /* Create mutex only if it has not been created already */
@@ -660,17 +739,28 @@ pgEvent_AutoInit(PyObject *self, PyObject *_null)
             if (!pg_evfilter_mutex)
                 return RAISE(pgExc_SDLError, SDL_GetError());
         }
+        if (!pg_event_wait_sem) {
+            pg_event_wait_sem = SDL_CreateSemaphore(0);
+            if (!pg_event_wait_sem)
+                return RAISE(pgExc_SDLError, SDL_GetError());
+        }
 #endif
+        SDL_AtomicSet(&pg_event_wakeup_pending, 0);
         SDL_SetEventFilter(pg_event_filter, NULL);
     }
     _pg_event_is_init = 1;
     Py_RETURN_NONE;
 }
 
+static int
+_pg_event_load_dict(pgEventObject *e);
+
 /* This function can fill an SDL event from pygame event */
 static int
 pgEvent_FillUserEvent(pgEventObject *e, SDL_Event *event)
 {
+    if (_pg_event_load_dict(e) == -1)
+        return -1;
     Py_INCREF(e->dict);
 
     memset(event, 0, sizeof(SDL_Event));
@@ -920,8 +1010,101 @@ _joy_map_discard(int instance_id)
     }
 }
 
+/* Return a new reference to the pygame Window a window, keyboard, text or
+ * mouse event came from, None if it came from no Window, or NULL if events of
+ * its type have no window attribute. */
+static PyObject *
+_pg_event_window(SDL_Event *event)
+{
+    switch (event->type) {
+        case PGE_WINDOWSHOWN:
+        case PGE_WINDOWHIDDEN:
+        case PGE_WINDOWEXPOSED:
+        case PGE_WINDOWMOVED:
+        case PGE_WINDOWRESIZED:
+        case PGE_WINDOWSIZECHANGED:
+        case PGE_WINDOWMINIMIZED:
+        case PGE_WINDOWMAXIMIZED:
+        case PGE_WINDOWRESTORED:
+        case PGE_WINDOWENTER:
+        case PGE_WINDOWLEAVE:
+        case PGE_WINDOWFOCUSGAINED:
+        case PGE_WINDOWFOCUSLOST:
+        case PGE_WINDOWCLOSE:
+        case PGE_WINDOWTAKEFOCUS:
+        case PGE_WINDOWHITTEST:
+        case PGE_WINDOWICCPROFCHANGED:
+        case PGE_WINDOWDISPLAYCHANGED:
+        case SDL_TEXTEDITING:
+        case SDL_TEXTINPUT:
+        case SDL_MOUSEWHEEL:
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+        case SDL_MOUSEMOTION:
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP: {
+            SDL_Window *window = SDL_GetWindowFromID(event->window.windowID);
+            PyObject *pgWindow;
+            if (!window ||
+                !(pgWindow = SDL_GetWindowData(window, "pg_window"))) {
+                pgWindow = Py_None;
+            }
+            Py_INCREF(pgWindow);
+            return pgWindow;
+        }
+    }
+    return NULL;
+}
+
+/* Events of these types keep their SDL event in the Event object, and the
+ * dict is made from it the first time it is needed. Making their dict must
+ * not depend on, or change, any state besides the event: the Window is looked
+ * up beforehand, while the others, like the key events freeing their unicode
+ * slot, get their dict straight away. */
+static int
+_pg_event_is_lazy(Uint32 type)
+{
+    switch (type) {
+        case SDL_MOUSEMOTION:
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+        case SDL_MOUSEWHEEL:
+        case SDL_FINGERMOTION:
+        case SDL_FINGERDOWN:
+        case SDL_FINGERUP:
+        case SDL_MULTIGESTURE:
+        case SDL_TEXTINPUT:
+        case SDL_TEXTEDITING:
+        case SDL_CONTROLLERAXISMOTION:
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP:
+        case PGE_WINDOWSHOWN:
+        case PGE_WINDOWHIDDEN:
+        case PGE_WINDOWEXPOSED:
+        case PGE_WINDOWMOVED:
+        case PGE_WINDOWRESIZED:
+        case PGE_WINDOWSIZECHANGED:
+        case PGE_WINDOWMINIMIZED:
+        case PGE_WINDOWMAXIMIZED:
+        case PGE_WINDOWRESTORED:
+        case PGE_WINDOWENTER:
+        case PGE_WINDOWLEAVE:
+        case PGE_WINDOWFOCUSGAINED:
+        case PGE_WINDOWFOCUSLOST:
+        case PGE_WINDOWCLOSE:
+        case PGE_WINDOWTAKEFOCUS:
+        case PGE_WINDOWHITTEST:
+        case PGE_WINDOWICCPROFCHANGED:
+        case PGE_WINDOWDISPLAYCHANGED:
+            return 1;
+    }
+    return 0;
+}
+
+/* window is the pygame Window of the event from _pg_event_window(), which
+ * becomes the window attribute when it is not NULL. */
 static PyObject *
-dict_from_event(SDL_Event *event)
+dict_from_event(SDL_Event *event, PyObject *window)
 {
     PyObject *dict = NULL, *tuple, *obj;
     int hx, hy;
@@ -1250,47 +1433,24 @@ dict_from_event(SDL_Event *event)
     /* Events that dont have any attributes are not handled in switch
      * statement */
 
-    switch (event->type) {
-        case PGE_WINDOWSHOWN:
-        case PGE_WINDOWHIDDEN:
-        case PGE_WINDOWEXPOSED:
-        case PGE_WINDOWMOVED:
-        case PGE_WINDOWRESIZED:
-        case PGE_WINDOWSIZECHANGED:
-        case PGE_WINDOWMINIMIZED:
-        case PGE_WINDOWMAXIMIZED:
-        case PGE_WINDOWRESTORED:
-        case PGE_WINDOWENTER:
-        case PGE_WINDOWLEAVE:
-        case PGE_WINDOWFOCUSGAINED:
-        case PGE_WINDOWFOCUSLOST:
-        case PGE_WINDOWCLOSE:
-        case PGE_WINDOWTAKEFOCUS:
-        case PGE_WINDOWHITTEST:
-        case PGE_WINDOWICCPROFCHANGED:
-        case PGE_WINDOWDISPLAYCHANGED:
-        case SDL_TEXTEDITING:
-        case SDL_TEXTINPUT:
-        case SDL_MOUSEWHEEL:
-        case SDL_KEYDOWN:
-        case SDL_KEYUP:
-        case SDL_MOUSEMOTION:
-        case SDL_MOUSEBUTTONDOWN:
-        case SDL_MOUSEBUTTONUP: {
-            SDL_Window *window = SDL_GetWindowFromID(event->window.windowID);
-            PyObject *pgWindow;
-            if (!window ||
-                !(pgWindow = SDL_GetWindowData(window, "pg_window"))) {
-                pgWindow = Py_None;
-            }
-            Py_INCREF(pgWindow);
-            _pg_insobj(dict, "window", pgWindow);
-            break;
-        }
+    if (window) {
+        Py_INCREF(window);
+        _pg_insobj(dict, "window", window);
     }
     return dict;
 }
 
+/* Make the dict of an Event still holding its SDL event. */
+static int
+_pg_event_load_dict(pgEventObject *e)
+{
+    if (e->dict)
+        return 0;
+    e->dict = dict_from_event(&e->event, e->window);
+    Py_CLEAR(e->window);
+    return e->dict ? 0 : -1;
+}
+
 /* event object internals */
 
 static void
@@ -1298,6 +1458,7 @@ pg_event_dealloc(PyObject *self)
 {
     pgEventObject *e = (pgEventObject *)self;
     Py_XDECREF(e->dict);
+    Py_XDECREF(e->window);
     PyObject_Free(self);
 }
 
@@ -1306,8 +1467,12 @@ pg_event_dealloc(PyObject *self)
 PyObject *
 pg_EventGetAttr(PyObject *o, PyObject *attr_name)
 {
+    PyObject *result;
+
+    if (_pg_event_load_dict((pgEventObject *)o) == -1)
+        return NULL;
     /* Try e->dict first, if not try the generic attribute. */
-    PyObject *result = PyDict_GetItem(((pgEventObject *)o)->dict, attr_name);
+    result = PyDict_GetItem(((pgEventObject *)o)->dict, attr_name);
     if (!result) {
         return PyObject_GenericGetAttr(o, attr_name);
     }
@@ -1323,7 +1488,11 @@ pg_EventSetAttr(PyObject *o, PyObject *name, PyObject *value)
     */
     int dictResult;
     int setInDict = 0;
-    PyObject *result = PyDict_GetItem(((pgEventObject *)o)->dict, name);
+    PyObject *result;
+
+    if (_pg_event_load_dict((pgEventObject *)o) == -1)
+        return -1;
+    result = PyDict_GetItem(((pgEventObject *)o)->dict, name);
 
     if (result) {
         setInDict = 1;
@@ -1346,12 +1515,40 @@ pg_EventSetAttr(PyObject *o, PyObject *name, PyObject *value)
         return PyObject_GenericSetAttr(o, name, value);
     }
 }
-#endif
+#else /* ~PYPY_VERSION */
+static PyObject *
+pg_EventGetAttr(PyObject *o, PyObject *attr_name)
+{
+    PyObject *result;
+
+    /* The members and methods do not need the dict, so it is only made when
+       an attribute is not found without it. */
+    if (((pgEventObject *)o)->dict)
+        return PyObject_GenericGetAttr(o, attr_name);
+    result = PyObject_GenericGetAttr(o, attr_name);
+    if (result || !PyErr_ExceptionMatches(PyExc_AttributeError))
+        return result;
+    PyErr_Clear();
+    if (_pg_event_load_dict((pgEventObject *)o) == -1)
+        return NULL;
+    return PyObject_GenericGetAttr(o, attr_name);
+}
+
+static int
+pg_EventSetAttr(PyObject *o, PyObject *name, PyObject *value)
+{
+    if (_pg_event_load_dict((pgEventObject *)o) == -1)
+        return -1;
+    return PyObject_GenericSetAttr(o, name, value);
+}
+#endif /* ~PYPY_VERSION */
 
 PyObject *
 pg_event_str(PyObject *self)
 {
     pgEventObject *e = (pgEventObject *)self;
+    if (_pg_event_load_dict(e) == -1)
+        return NULL;
     return PyUnicode_FromFormat("<Event(%d-%s %S)>", e->type,
                                 _pg_name_from_eventtype(e->type), e->dict);
 }
@@ -1371,9 +1568,22 @@ static PyTypeObject pgEvent_Type;
 #define OFF(x) offsetof(pgEventObject, x)
 
 static PyMemberDef pg_event_members[] = {
-    {"__dict__", T_OBJECT, OFF(dict), READONLY},
     {"type", T_INT, OFF(type), READONLY},
-    {"dict", T_OBJECT, OFF(dict), READONLY},
+    {NULL} /* Sentinel */
+};
+
+static PyObject *
+pg_event_get_dict(pgEventObject *self, void *closure)
+{
+    if (_pg_event_load_dict(self) == -1)
+        return NULL;
+    Py_INCREF(self->dict);
+    return self->dict;
+}
+
+static PyGetSetDef pg_event_getsets[] = {
+    {"__dict__", (getter)pg_event_get_dict, NULL, NULL, NULL},
+    {"dict", (getter)pg_event_get_dict, NULL, NULL, NULL},
     {NULL} /* Sentinel */
 };
 
@@ -1392,6 +1602,8 @@ pg_event_richcompare(PyObject *o1, PyObject *o2, int opid)
 
     e1 = (pgEventObject *)o1;
     e2 = (pgEventObject *)o2;
+    if (_pg_event_load_dict(e1) == -1 || _pg_event_load_dict(e2) == -1)
+        return NULL;
     switch (opid) {
         case Py_EQ:
             return PyBool_FromLong(
@@ -1429,6 +1641,7 @@ _pg_event_populate(pgEventObject *event, int type, PyObject *dict)
         }
         Py_INCREF(dict);
     }
+    Py_CLEAR(event->window);
     event->dict = dict;
     return 0;
 }
@@ -1479,16 +1692,12 @@ static PyTypeObject pgEvent_Type = {
     .tp_dealloc = pg_event_dealloc,
     .tp_repr = pg_event_str,
     .tp_as_number = &pg_event_as_number,
-#ifdef PYPY_VERSION
     .tp_getattro = pg_EventGetAttr,
     .tp_setattro = pg_EventSetAttr,
-#else
-    .tp_getattro = PyObject_GenericGetAttr,
-    .tp_setattro = PyObject_GenericSetAttr,
-#endif
     .tp_doc = DOC_PYGAMEEVENTEVENT,
     .tp_richcompare = pg_event_richcompare,
     .tp_members = pg_event_members,
+    .tp_getset = pg_event_getsets,
     .tp_dictoffset = offsetof(pgEventObject, dict),
     .tp_init = (initproc)pg_event_init,
     .tp_new = PyType_GenericNew,
@@ -1502,13 +1711,25 @@ pgEvent_New(SDL_Event *event)
     if (!e)
         return PyErr_NoMemory();
 
-    if (event) {
+    e->window = NULL;
+    if (!event) {
+        e->type = SDL_NOEVENT;
+        e->dict = PyDict_New();
+    }
+    else if (_pg_event_is_lazy(event->type)) {
+        /* most events are only checked for their type, so their dict is
+           left until it is used */
         e->type = _pg_pgevent_deproxify(event->type);
-        e->dict = dict_from_event(event);
+        e->dict = NULL;
+        e->event = *event;
+        e->window = _pg_event_window(event);
+        return (PyObject *)e;
     }
     else {
-        e->type = SDL_NOEVENT;
-        e->dict = PyDict_New();
+        PyObject *window = _pg_event_window(event);
+        e->type = _pg_pgevent_deproxify(event->type);
+        e->dict = dict_from_event(event, window);
+        Py_XDECREF(window);
     }
     if (!e->dict) {
         PyObject_Free(e);
@@ -1525,6 +1746,7 @@ pgEvent_New2(int type, PyObject *dict)
     if (!e)
         return PyErr_NoMemory();
 
+    e->window = NULL;
     if (_pg_event_populate(e, type, dict) == -1) {
         PyObject_Free(e);
         return NULL;
@@ -1588,6 +1810,8 @@ get_grab(PyObject *self, PyObject *_null)
 static void
 _pg_event_pump(int dopump)
 {
+    Uint64 start = pg_StatsBegin();
+
     if (dopump) {
         SDL_PumpEvents();
     }
@@ -1596,18 +1820,43 @@ _pg_event_pump(int dopump)
      * might break. So after every event pump, we translate events from
      * here */
     SDL_FilterEvents(_pg_translate_windowevent, NULL);
+    if (_pg_coalesce_mousemotion || _pg_coalesce_fingermotion) {
+        SDL_Event *prev = NULL;
+        SDL_FilterEvents(_pg_coalesce_motion, &prev);
+    }
+    pg_StatsEnd(PG_STAT_EVENT, "pump", start, 0);
+}
+
+/* Sleep for up to a millisecond, or less when pg_event_wait_sem is posted.
+ * The queue has to be pumped at least this often for the events from the OS
+ * to arrive. */
+static void
+_pg_event_wait_sleep(Uint64 ticks_left)
+{
+    Uint32 ms = ticks_left >= SDL_GetPerformanceFrequency() / 1000 ? 1 : 0;
+
+#ifndef __EMSCRIPTEN__
+    if (pg_event_wait_sem) {
+        SDL_SemWaitTimeout(pg_event_wait_sem, ms);
+        return;
+    }
+#endif
+    if (ms)
+        SDL_Delay(ms);
 }
 
 static int
-_pg_event_wait(SDL_Event *event, int timeout)
+_pg_event_wait(SDL_Event *event, double timeout)
 {
     /* Custom re-implementation of SDL_WaitEventTimeout, doing this has
      * many advantages. This is copied from SDL source code, with a few
-     * minor modifications */
-    Uint32 finish = 0;
+     * minor modifications. timeout is in milliseconds, and may have a
+     * fractional part. */
+    Uint64 now, finish = 0;
 
     if (timeout > 0)
-        finish = SDL_GetTicks() + timeout;
+        finish = SDL_GetPerformanceCounter() +
+                 (Uint64)(timeout * SDL_GetPerformanceFrequency() / 1000.0);
 
     while (1) {
         _pg_event_pump(1); /* Use our custom pump here */
@@ -1618,11 +1867,18 @@ _pg_event_wait(SDL_Event *event, int timeout)
                 return 1;
 
             default:
-                if (timeout >= 0 && SDL_GetTicks() >= finish) {
+                now = SDL_GetPerformanceCounter();
+                if (timeout >= 0 && now >= finish) {
                     /* no events */
                     return 0;
                 }
-                SDL_Delay(1);
+                if (SDL_AtomicSet(&pg_event_wakeup_pending, 0)) {
+                    /* woken up by pgEvent_Wakeup() */
+                    return 0;
+                }
+                /* the last fraction of a millisecond is spent polling */
+                _pg_event_wait_sleep(timeout >= 0 ? finish - now
+                                                  : (Uint64)-1);
         }
     }
 }
@@ -1635,6 +1891,13 @@ pg_event_pump(PyObject *self, PyObject *_null)
     Py_RETURN_NONE;
 }
 
+static PyObject *
+pg_event_wakeup(PyObject *self, PyObject *_null)
+{
+    pgEvent_Wakeup();
+    Py_RETURN_NONE;
+}
+
 static PyObject *
 pg_event_poll(PyObject *self, PyObject *_null)
 {
@@ -1651,12 +1914,13 @@ static PyObject *
 pg_event_wait(PyObject *self, PyObject *args, PyObject *kwargs)
 {
     SDL_Event event;
-    int status, timeout = 0;
+    int status;
+    double timeout = 0;
     static char *kwids[] = {"timeout", NULL};
 
     VIDEO_INIT_CHECK();
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|i", kwids, &timeout)) {
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|d", kwids, &timeout)) {
         return NULL;
     }
 
@@ -1758,9 +2022,11 @@ static int
 _pg_event_append_to_list(PyObject *list, SDL_Event *event)
 {
     /* The caller of this function must handle decref of list on error */
+    Uint64 start = pg_StatsBegin();
     PyObject *e = pgEvent_New(event);
     if (!e) /* Exception already set. */
         return 0;
+    pg_StatsEnd(PG_STAT_EVENT, "translate", start, 0);
 
     if (PyList_Append(list, e)) {
         Py_DECREF(e);
@@ -1998,6 +2264,302 @@ pg_event_get(PyObject *self, PyObject *args, PyObject *kwargs)
     }
 }
 
+/* A record event.get_buffer() writes for each event: ints in the order of
+ * the names in pg_event_record_fields. Fields an event does not have are 0.
+ */
+typedef struct {
+    Sint32 type, timestamp, window_id, which;
+    Sint32 x, y, rel_x, rel_y;
+    Sint32 button, value;
+    Sint32 key, scancode, mod, unicode;
+} pgEventRecord;
+
+#define NUM_EVENT_RECORD_FIELDS \
+    ((int)(sizeof(pgEventRecord) / sizeof(Sint32)))
+
+static const char *pg_event_record_fields[NUM_EVENT_RECORD_FIELDS] = {
+    "type",  "timestamp", "window_id", "which", "x",        "y",   "rel_x",
+    "rel_y", "button",    "value",     "key",   "scancode", "mod", "unicode"};
+
+/* The code point of the first character of a UTF-8 string cut down by
+ * _pg_strip_utf8().
+ */
+static Sint32
+_pg_codepoint_from_utf8(const char *str)
+{
+    const Uint8 *s = (const Uint8 *)str;
+
+    if (s[0] < 0x80) {
+        return s[0];
+    }
+    if (s[0] >= 0xE0) {
+        return ((s[0] & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+    }
+    return ((s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+}
+
+/* Like _pg_get_event_unicode(), but returns the code point of the character
+ * without making a str. The event filter mutex must be held.
+ */
+static Sint32
+_pg_get_event_codepoint(SDL_Event *event)
+{
+    int i;
+
+    for (i = 0; i < MAX_SCAN_UNICODE; i++) {
+        if (scanunicode[i].key == event->key.keysym.scancode) {
+            if (event->type == SDL_KEYUP) {
+                scanunicode[i].key = 0;
+            }
+            return _pg_codepoint_from_utf8(scanunicode[i].unicode);
+        }
+    }
+    return (Uint8)_pg_unicode_from_event(event);
+}
+
+/* Fills rec from an event taken off the queue, and does everything else
+ * dict_from_event() does for it: freeing what the event owns and keeping the
+ * joystick and unicode tables up to date.
+ */
+static void
+_pg_event_to_record(SDL_Event *event, pgEventRecord *rec)
+{
+    memset(rec, 0, sizeof(pgEventRecord));
+    rec->type = _pg_pgevent_deproxify(event->type);
+    rec->timestamp = (Sint32)event->common.timestamp;
+
+    if (event->type >= PGPOST_EVENTBEGIN &&
+        event->user.code == USEROBJ_CHECK) {
+        /* the dict of a posted event */
+        Py_XDECREF((PyObject *)event->user.data1);
+        return;
+    }
+
+    switch (event->type) {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            rec->window_id = event->key.windowID;
+            rec->key = event->key.keysym.sym;
+            rec->scancode = event->key.keysym.scancode;
+            rec->mod = event->key.keysym.mod;
+            PG_LOCK_EVFILTER_MUTEX
+            rec->unicode = _pg_get_event_codepoint(event);
+            PG_UNLOCK_EVFILTER_MUTEX
+            break;
+        case SDL_MOUSEMOTION:
+            rec->window_id = event->motion.windowID;
+            rec->which = event->motion.which;
+            rec->x = event->motion.x;
+            rec->y = event->motion.y;
+            rec->rel_x = event->motion.xrel;
+            rec->rel_y = event->motion.yrel;
+            rec->button = event->motion.state;
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            rec->window_id = event->button.windowID;
+            rec->which = event->button.which;
+            rec->x = event->button.x;
+            rec->y = event->button.y;
+            rec->button = event->button.button;
+            rec->value = event->button.clicks;
+            break;
+        case SDL_MOUSEWHEEL:
+            rec->window_id = event->wheel.windowID;
+            rec->which = event->wheel.which;
+            rec->x = event->wheel.x;
+            rec->y = event->wheel.y;
+            break;
+        case SDL_JOYAXISMOTION:
+            rec->which = event->jaxis.which;
+            rec->button = event->jaxis.axis;
+            rec->value = event->jaxis.value;
+            break;
+        case SDL_JOYBALLMOTION:
+            rec->which = event->jball.which;
+            rec->button = event->jball.ball;
+            rec->rel_x = event->jball.xrel;
+            rec->rel_y = event->jball.yrel;
+            break;
+        case SDL_JOYHATMOTION:
+            rec->which = event->jhat.which;
+            rec->button = event->jhat.hat;
+            rec->value = event->jhat.value;
+            break;
+        case SDL_JOYBUTTONUP:
+        case SDL_JOYBUTTONDOWN:
+            rec->which = event->jbutton.which;
+            rec->button = event->jbutton.button;
+            break;
+        case SDL_CONTROLLERAXISMOTION:
+            rec->which = event->caxis.which;
+            rec->button = event->caxis.axis;
+            rec->value = event->caxis.value;
+            break;
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP:
+            rec->which = event->cbutton.which;
+            rec->button = event->cbutton.button;
+            break;
+        case SDL_CONTROLLERDEVICEADDED:
+        case SDL_CONTROLLERDEVICEREMOVED:
+        case SDL_CONTROLLERDEVICEREMAPPED:
+            rec->which = event->cdevice.which;
+            break;
+        case SDL_JOYDEVICEADDED:
+            _joy_map_add(event->jdevice.which);
+            rec->which = event->jdevice.which;
+            break;
+        case SDL_JOYDEVICEREMOVED:
+            _joy_map_discard(event->jdevice.which);
+            rec->which = event->jdevice.which;
+            break;
+        case SDL_DROPFILE:
+        case SDL_DROPTEXT:
+            SDL_free(event->drop.file);
+            break;
+        case PGE_WINDOWMOVED:
+        case PGE_WINDOWRESIZED:
+        case PGE_WINDOWSIZECHANGED:
+            rec->x = event->window.data1;
+            rec->y = event->window.data2;
+            break;
+    }
+
+    switch (event->type) {
+        case PGE_WINDOWSHOWN:
+        case PGE_WINDOWHIDDEN:
+        case PGE_WINDOWEXPOSED:
+        case PGE_WINDOWMOVED:
+        case PGE_WINDOWRESIZED:
+        case PGE_WINDOWSIZECHANGED:
+        case PGE_WINDOWMINIMIZED:
+        case PGE_WINDOWMAXIMIZED:
+        case PGE_WINDOWRESTORED:
+        case PGE_WINDOWENTER:
+        case PGE_WINDOWLEAVE:
+        case PGE_WINDOWFOCUSGAINED:
+        case PGE_WINDOWFOCUSLOST:
+        case PGE_WINDOWCLOSE:
+        case PGE_WINDOWTAKEFOCUS:
+        case PGE_WINDOWHITTEST:
+        case PGE_WINDOWICCPROFCHANGED:
+        case PGE_WINDOWDISPLAYCHANGED:
+        case SDL_TEXTEDITING:
+        case SDL_TEXTINPUT:
+            rec->window_id = event->window.windowID;
+            break;
+    }
+}
+
+/* Takes up to max events of the given type, or of all types if type is
+ * MAX_UINT32, off the queue into records. Returns how many were taken, or
+ * -1 with an exception set on failure.
+ */
+static Py_ssize_t
+_pg_event_get_records(char *records, Py_ssize_t max, Uint32 type)
+{
+    SDL_Event eventbuf[PG_GET_LIST_LEN];
+    pgEventRecord rec;
+    Py_ssize_t count = 0;
+    int len, i, pass;
+    Uint32 peek_type;
+
+    for (pass = 0; pass < 2; pass++) {
+        /* a type is looked for as itself and as its proxy */
+        peek_type = pass ? _pg_pgevent_proxify(type) : type;
+        if (pass && (type == MAX_UINT32 || peek_type == type)) {
+            break;
+        }
+        do {
+            len = (int)MIN(max - count, PG_GET_LIST_LEN);
+            if (!len) {
+                return count;
+            }
+            if (type == MAX_UINT32) {
+                len = PG_PEEP_EVENT_ALL(eventbuf, len, SDL_GETEVENT);
+            }
+            else {
+                len = PG_PEEP_EVENT(eventbuf, len, SDL_GETEVENT, peek_type);
+            }
+            if (len < 0) {
+                PyErr_SetString(pgExc_SDLError, SDL_GetError());
+                return -1;
+            }
+            for (i = 0; i < len; i++) {
+                _pg_event_to_record(&eventbuf[i], &rec);
+                /* the buffer may not be aligned for ints */
+                memcpy(records + count * sizeof(pgEventRecord), &rec,
+                       sizeof(pgEventRecord));
+                count++;
+            }
+        } while (len == PG_GET_LIST_LEN);
+    }
+    return count;
+}
+
+static PyObject *
+pg_event_get_buffer(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *obj, *obj_evtype = NULL, *seq = NULL;
+    Py_buffer view;
+    Py_ssize_t max, count = 0, got, len, loop;
+    int dopump = 1, type;
+
+    static char *kwids[] = {"buffer", "eventtype", "pump", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|Op", kwids, &obj,
+                                     &obj_evtype, &dopump))
+        return NULL;
+
+    VIDEO_INIT_CHECK();
+
+    if (PyObject_GetBuffer(obj, &view, PyBUF_WRITABLE)) {
+        return NULL;
+    }
+    if (view.len % sizeof(pgEventRecord)) {
+        PyBuffer_Release(&view);
+        return PyErr_Format(PyExc_ValueError,
+                            "buffer length must be a multiple of the %d "
+                            "byte record size",
+                            (int)sizeof(pgEventRecord));
+    }
+    max = view.len / sizeof(pgEventRecord);
+
+    if (obj_evtype != NULL && obj_evtype != Py_None) {
+        seq = _pg_eventtype_as_seq(obj_evtype, &len);
+        if (!seq) {
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+    }
+
+    _pg_event_pump(dopump);
+
+    if (!seq) {
+        count = _pg_event_get_records(view.buf, max, MAX_UINT32);
+    }
+    else {
+        for (loop = 0; loop < len && count >= 0; loop++) {
+            type = _pg_eventtype_from_seq(seq, (int)loop);
+            if (type == -1) {
+                count = -1;
+                break;
+            }
+            got = _pg_event_get_records((char *)view.buf +
+                                            count * sizeof(pgEventRecord),
+                                        max - count, type);
+            count = got < 0 ? -1 : count + got;
+        }
+        Py_DECREF(seq);
+    }
+    PyBuffer_Release(&view);
+    if (count < 0) {
+        return NULL; /* Exception already set. */
+    }
+    return PyLong_FromSsize_t(count);
+}
+
 static PyObject *
 pg_event_peek(PyObject *self, PyObject *args, PyObject *kwargs)
 {
@@ -2077,7 +2639,8 @@ pg_event_post(PyObject *self, PyObject *obj)
     if (SDL_EventState(_pg_pgevent_proxify(e->type), SDL_QUERY) == SDL_IGNORE)
         Py_RETURN_FALSE;
 
-    pgEvent_FillUserEvent(e, &event);
+    if (pgEvent_FillUserEvent(e, &event) == -1)
+        return NULL;
 
     ret = SDL_PushEvent(&event);
     if (ret == 1)
@@ -2190,6 +2753,58 @@ pg_event_get_blocked(PyObject *self, PyObject *obj)
     return PyBool_FromLong(isblocked);
 }
 
+static int *
+_pg_coalesce_flag(int type)
+{
+    switch (type) {
+        case SDL_MOUSEMOTION:
+            return &_pg_coalesce_mousemotion;
+        case SDL_FINGERMOTION:
+            return &_pg_coalesce_fingermotion;
+    }
+    PyErr_SetString(PyExc_ValueError,
+                    "only MOUSEMOTION and FINGERMOTION events can be "
+                    "coalesced");
+    return NULL;
+}
+
+static PyObject *
+pg_event_set_coalesce(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int type, coalesce = 1;
+    int *flag;
+    static char *kwids[] = {"eventtype", "coalesce", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "i|p", kwids, &type,
+                                     &coalesce))
+        return NULL;
+
+    VIDEO_INIT_CHECK();
+
+    flag = _pg_coalesce_flag(type);
+    if (!flag)
+        return NULL;
+    *flag = coalesce;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_event_get_coalesce(PyObject *self, PyObject *args)
+{
+    int type;
+    int *flag;
+
+    if (!PyArg_ParseTuple(args, "i", &type))
+        return NULL;
+
+    VIDEO_INIT_CHECK();
+
+    flag = _pg_coalesce_flag(type);
+    if (!flag)
+        return NULL;
+    return PyBool_FromLong(*flag);
+}
+
 static PyObject *
 pg_event_custom_type(PyObject *self, PyObject *_null)
 {
@@ -2215,10 +2830,14 @@ static PyMethodDef _event_methods[] = {
     {"wait", (PyCFunction)pg_event_wait, METH_VARARGS | METH_KEYWORDS,
      DOC_PYGAMEEVENTWAIT},
     {"poll", (PyCFunction)pg_event_poll, METH_NOARGS, DOC_PYGAMEEVENTPOLL},
+    {"wakeup", (PyCFunction)pg_event_wakeup, METH_NOARGS,
+     DOC_PYGAMEEVENTWAKEUP},
     {"clear", (PyCFunction)pg_event_clear, METH_VARARGS | METH_KEYWORDS,
      DOC_PYGAMEEVENTCLEAR},
     {"get", (PyCFunction)pg_event_get, METH_VARARGS | METH_KEYWORDS,
      DOC_PYGAMEEVENTGET},
+    {"get_buffer", (PyCFunction)pg_event_get_buffer,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEEVENTGETBUFFER},
     {"peek", (PyCFunction)pg_event_peek, METH_VARARGS | METH_KEYWORDS,
      DOC_PYGAMEEVENTPEEK},
     {"post", (PyCFunction)pg_event_post, METH_O, DOC_PYGAMEEVENTPOST},
@@ -2229,6 +2848,10 @@ static PyMethodDef _event_methods[] = {
      DOC_PYGAMEEVENTSETBLOCKED},
     {"get_blocked", (PyCFunction)pg_event_get_blocked, METH_O,
      DOC_PYGAMEEVENTGETBLOCKED},
+    {"set_coalesce", (PyCFunction)pg_event_set_coalesce,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEEVENTSETCOALESCE},
+    {"get_coalesce", (PyCFunction)pg_event_get_coalesce, METH_VARARGS,
+     DOC_PYGAMEEVENTGETCOALESCE},
     {"custom_type", (PyCFunction)pg_event_custom_type, METH_NOARGS,
      DOC_PYGAMEEVENTCUSTOMTYPE},
 
@@ -2236,7 +2859,8 @@ static PyMethodDef _event_methods[] = {
 
 MODINIT_DEFINE(event)
 {
-    PyObject *module, *apiobj;
+    PyObject *module, *apiobj, *fields, *field;
+    int i;
     static void *c_api[PYGAMEAPI_EVENT_NUMSLOTS];
 
     static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
@@ -2290,14 +2914,35 @@ MODINIT_DEFINE(event)
         return NULL;
     }
 
+    fields = PyTuple_New(NUM_EVENT_RECORD_FIELDS);
+    if (!fields) {
+        Py_DECREF(module);
+        return NULL;
+    }
+    for (i = 0; i < NUM_EVENT_RECORD_FIELDS; i++) {
+        field = PyUnicode_FromString(pg_event_record_fields[i]);
+        if (!field) {
+            Py_DECREF(fields);
+            Py_DECREF(module);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(fields, i, field);
+    }
+    if (PyModule_AddObject(module, "BUFFER_FIELDS", fields)) {
+        Py_DECREF(fields);
+        Py_DECREF(module);
+        return NULL;
+    }
+
     /* export the c api */
-    assert(PYGAMEAPI_EVENT_NUMSLOTS == 6);
+    assert(PYGAMEAPI_EVENT_NUMSLOTS == 7);
     c_api[0] = &pgEvent_Type;
     c_api[1] = pgEvent_New;
     c_api[2] = pgEvent_New2;
     c_api[3] = pgEvent_FillUserEvent;
     c_api[4] = pg_EnableKeyRepeat;
     c_api[5] = pg_GetKeyRepeat;
+    c_api[6] = pgEvent_Wakeup;
 
     apiobj = encapsulate_api(c_api, "event");
     if (PyModule_AddObject(module, PYGAMEAPI_LOCAL_ENTRY, apiobj)) {
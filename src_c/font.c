@@ -33,6 +33,8 @@
 
 #include "pgcompat.h"
 
+#include "pgrendercache.h"
+
 #include "doc/font_doc.h"
 
 #include "structmember.h"
@@ -414,8 +416,46 @@ font_set_strikethrough(PyObject *self, PyObject *args)
     Py_RETURN_NONE;
 }
 
+static char *font_render_kwlist[] = {"text",       "antialias", "color",
+                                      "background", "wraplength", "align",
+                                      NULL};
+
+/* Renders text broken into lines no wider than wraplength pixels, and at
+ * newlines. Like TTF_RenderText_*, backg is left out by the solid render.
+ */
+static SDL_Surface *
+font_render_wrapped(TTF_Font *font, const char *astring, int utf8, int aa,
+                    SDL_Color foreg, SDL_Color *backg, Uint32 wraplength)
+{
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+    if (utf8) {
+        if (!aa) {
+            return TTF_RenderUTF8_Solid_Wrapped(font, astring, foreg,
+                                                wraplength);
+        }
+        if (backg) {
+            return TTF_RenderUTF8_Shaded_Wrapped(font, astring, foreg, *backg,
+                                                 wraplength);
+        }
+        return TTF_RenderUTF8_Blended_Wrapped(font, astring, foreg,
+                                              wraplength);
+    }
+    if (!aa) {
+        return TTF_RenderText_Solid_Wrapped(font, astring, foreg, wraplength);
+    }
+    if (backg) {
+        return TTF_RenderText_Shaded_Wrapped(font, astring, foreg, *backg,
+                                             wraplength);
+    }
+    return TTF_RenderText_Blended_Wrapped(font, astring, foreg, wraplength);
+#else
+    TTF_SetError("wraplength requires SDL_ttf 2.0.18 or newer");
+    return NULL;
+#endif
+}
+
 static PyObject *
-font_render(PyObject *self, PyObject *args)
+font_render_text(PyObject *self, PyObject *args, PyObject *kwds)
 {
     TTF_Font *font = PyFont_AsFont(self);
     int aa;
@@ -425,11 +465,30 @@ font_render(PyObject *self, PyObject *args)
     SDL_Surface *surf;
     SDL_Color foreg, backg;
     int just_return;
-
-    if (!PyArg_ParseTuple(args, "OpO|O", &text, &aa, &fg_rgba_obj,
-                          &bg_rgba_obj)) {
+    int wraplength = 0;
+    int align = 0;
+    Uint64 start;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OpO|Oii",
+                                     font_render_kwlist, &text, &aa,
+                                     &fg_rgba_obj, &bg_rgba_obj, &wraplength,
+                                     &align)) {
         return NULL;
     }
+    if (wraplength < 0) {
+        return RAISE(PyExc_ValueError, "wraplength must be 0 or more");
+    }
+    if (align < 0 || align > 2) {
+        return RAISE(PyExc_ValueError,
+                     "align must be FONT_LEFT, FONT_CENTER or FONT_RIGHT");
+    }
+#if SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+    TTF_SetFontWrappedAlign(font, align);
+#else
+    if (align) {
+        return RAISE(pgExc_SDLError, "align requires SDL_ttf 2.20.0 or newer");
+    }
+#endif
 
     if (!pg_RGBAFromFuzzyColorObj(fg_rgba_obj, rgba)) {
         /* Exception already set for us */
@@ -462,6 +521,7 @@ font_render(PyObject *self, PyObject *args)
         backg.a = SDL_ALPHA_OPAQUE;
     }
 
+    start = pg_StatsBegin();
     just_return = PyObject_Not(text);
     if (just_return) {
         int height = TTF_FontHeight(font);
@@ -505,7 +565,12 @@ font_render(PyObject *self, PyObject *args)
                          " not supported with SDL_ttf version below 2.0.15");
         }
 #endif
-        if (aa) {
+        if (wraplength) {
+            surf = font_render_wrapped(font, astring, 1, aa, foreg,
+                                       bg_rgba_obj ? &backg : NULL,
+                                       (Uint32)wraplength);
+        }
+        else if (aa) {
             if (bg_rgba_obj == NULL) {
                 surf = TTF_RenderUTF8_Blended(font, astring, foreg);
             }
@@ -525,7 +590,12 @@ font_render(PyObject *self, PyObject *args)
             return RAISE(PyExc_ValueError,
                          "A null character was found in the text");
         }
-        if (aa) {
+        if (wraplength) {
+            surf = font_render_wrapped(font, astring, 0, aa, foreg,
+                                       bg_rgba_obj ? &backg : NULL,
+                                       (Uint32)wraplength);
+        }
+        else if (aa) {
             if (bg_rgba_obj == NULL) {
                 surf = TTF_RenderText_Blended(font, astring, foreg);
             }
@@ -543,6 +613,10 @@ font_render(PyObject *self, PyObject *args)
     if (surf == NULL) {
         return RAISE(pgExc_SDLError, TTF_GetError());
     }
+    pg_StatsEnd(PG_STAT_TEXT,
+                aa ? (bg_rgba_obj ? "font_shaded" : "font_blended")
+                   : "font_solid",
+                start, (Sint64)surf->w * surf->h);
     if (!aa && (bg_rgba_obj != NULL) && !just_return) {
         /* turn off transparency */
         SDL_SetColorKey(surf, 0, 0);
@@ -557,6 +631,111 @@ font_render(PyObject *self, PyObject *args)
     return final;
 }
 
+static PyObject *
+font_render(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    pgRenderCache *cache = ((PyFontObject *)self)->render_cache;
+    int aa;
+    PyObject *text, *fg_rgba_obj, *bg_rgba_obj = NULL;
+    Uint8 rgba[] = {0, 0, 0, 0};
+    long fg, bg = -1;
+    int wraplength = 0;
+    int align = 0;
+    PyObject *key, *final;
+    SDL_Surface *surf;
+
+    if (!cache) {
+        return font_render_text(self, args, kwds);
+    }
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OpO|Oii",
+                                     font_render_kwlist, &text, &aa,
+                                     &fg_rgba_obj, &bg_rgba_obj, &wraplength,
+                                     &align)) {
+        return NULL;
+    }
+    if (!PyUnicode_CheckExact(text) && !PyBytes_CheckExact(text)) {
+        return font_render_text(self, args, kwds);
+    }
+
+    /* the alpha of the colors is not used */
+    if (!pg_RGBAFromFuzzyColorObj(fg_rgba_obj, rgba)) {
+        return NULL;
+    }
+    fg = (long)rgba[0] << 16 | rgba[1] << 8 | rgba[2];
+    if (bg_rgba_obj != NULL && bg_rgba_obj != Py_None) {
+        if (!pg_RGBAFromFuzzyColorObj(bg_rgba_obj, rgba)) {
+            return NULL;
+        }
+        bg = (long)rgba[0] << 16 | rgba[1] << 8 | rgba[2];
+    }
+    key = Py_BuildValue("(Oilliii)", text, aa, fg, bg,
+                        TTF_GetFontStyle(PyFont_AsFont(self)), wraplength,
+                        align);
+    if (!key) {
+        return NULL;
+    }
+
+    final = pgRenderCache_Get(cache, key);
+    if (final || PyErr_Occurred()) {
+        Py_DECREF(key);
+        return final;
+    }
+    final = font_render_text(self, args, kwds);
+    if (final) {
+        surf = pgSurface_AsSurface(final);
+        if (pgRenderCache_Put(cache, key, final,
+                              (size_t)surf->h * (size_t)surf->pitch)) {
+            Py_CLEAR(final);
+        }
+    }
+    Py_DECREF(key);
+    return final;
+}
+
+/* Implements getter for the render_cache_limit attribute */
+static PyObject *
+font_getter_render_cache_limit(PyObject *self, void *closure)
+{
+    pgRenderCache *cache = ((PyFontObject *)self)->render_cache;
+
+    return PyLong_FromSize_t(cache ? cache->max_bytes : 0);
+}
+
+/* Implements setter for the render_cache_limit attribute */
+static int
+font_setter_render_cache_limit(PyObject *self, PyObject *value,
+                               void *closure)
+{
+    size_t max_bytes;
+
+    DEL_ATTR_NOT_SUPPORTED_CHECK("render_cache_limit", value);
+
+    if (!PyLong_Check(value)) {
+        PyErr_Format(PyExc_TypeError,
+                     "render_cache_limit must be an int, not %.200s",
+                     Py_TYPE(value)->tp_name);
+        return -1;
+    }
+    max_bytes = PyLong_AsSize_t(value);
+    if (max_bytes == (size_t)-1 && PyErr_Occurred()) {
+        if (PyErr_ExceptionMatches(PyExc_OverflowError)) {
+            PyErr_Clear();
+            PyErr_SetString(PyExc_ValueError,
+                            "render_cache_limit must be a byte count >= 0");
+        }
+        return -1;
+    }
+    return pgRenderCache_SetLimit(&((PyFontObject *)self)->render_cache,
+                                  max_bytes);
+}
+
+/* Implements get_render_cache_stats() */
+static PyObject *
+font_get_render_cache_stats(PyObject *self, PyObject *_null)
+{
+    return pgRenderCache_Stats(((PyFontObject *)self)->render_cache);
+}
+
 static PyObject *
 font_size(PyObject *self, PyObject *args)
 {
@@ -694,6 +873,8 @@ static PyGetSetDef font_getsets[] = {
      DOC_FONTUNDERLINE, NULL},
     {"strikethrough", (getter)font_getter_strikethrough,
      (setter)font_setter_strikethrough, DOC_FONTSTRIKETHROUGH, NULL},
+    {"render_cache_limit", (getter)font_getter_render_cache_limit,
+     (setter)font_setter_render_cache_limit, DOC_FONTRENDERCACHELIMIT, NULL},
     {NULL, NULL, NULL, NULL, NULL}};
 
 static PyMethodDef font_methods[] = {
@@ -714,12 +895,85 @@ static PyMethodDef font_methods[] = {
      DOC_FONTSETSTRIKETHROUGH},
 
     {"metrics", font_metrics, METH_VARARGS, DOC_FONTMETRICS},
-    {"render", font_render, METH_VARARGS, DOC_FONTRENDER},
+    {"render", (PyCFunction)font_render, METH_VARARGS | METH_KEYWORDS,
+     DOC_FONTRENDER},
     {"size", font_size, METH_VARARGS, DOC_FONTSIZE},
+    {"get_render_cache_stats", font_get_render_cache_stats, METH_NOARGS,
+     DOC_FONTGETRENDERCACHESTATS},
 
     {NULL, NULL, 0, NULL}};
 
 /*font object internals*/
+/* Font files opened by path are mapped into memory once, and the mapping is
+ * shared by every Font of the file whatever its size, so that opening another
+ * size neither reads nor parses the file from disk again. The registry holds
+ * the mappings weakly by absolute path, each Font keeping its own alive
+ * through a view of it.
+ */
+static PyObject *font_files = NULL;
+
+/* Returns a SDL_RWops reading the shared mapping of the font file at path,
+ * keeping a view of it in self. Returns NULL without an exception set if path
+ * is not a file path or the file could not be mapped, in which case the font
+ * is to be opened as before.
+ */
+static SDL_RWops *
+font_map_file(PyFontObject *self, PyObject *path)
+{
+    PyObject *os_path, *key = NULL, *mapping = NULL;
+    SDL_RWops *rw = NULL;
+
+    path = pg_EncodeFilePath(path, NULL);
+    if (!path || path == Py_None) {
+        goto end;
+    }
+    os_path = PyImport_ImportModule("os.path");
+    if (!os_path) {
+        goto end;
+    }
+    key = PyObject_CallMethod(os_path, "abspath", "O", path);
+    Py_DECREF(os_path);
+    if (!key) {
+        goto end;
+    }
+
+    if (!font_files) {
+        PyObject *weakref = PyImport_ImportModule("weakref");
+        if (!weakref) {
+            goto end;
+        }
+        font_files =
+            PyObject_CallMethod(weakref, "WeakValueDictionary", NULL);
+        Py_DECREF(weakref);
+        if (!font_files) {
+            goto end;
+        }
+    }
+    mapping = PyObject_GetItem(font_files, key);
+    if (!mapping) {
+        PyErr_Clear();
+        mapping = pg_MapFile(key);
+        if (!mapping || PyObject_SetItem(font_files, key, mapping)) {
+            goto end;
+        }
+    }
+
+    if (PyObject_GetBuffer(mapping, &self->file_view, PyBUF_SIMPLE)) {
+        goto end;
+    }
+    rw = SDL_RWFromConstMem(self->file_view.buf, (int)self->file_view.len);
+    if (!rw) {
+        PyBuffer_Release(&self->file_view);
+    }
+
+end:
+    PyErr_Clear();
+    Py_XDECREF(mapping);
+    Py_XDECREF(key);
+    Py_XDECREF(path);
+    return rw;
+}
+
 static void
 font_dealloc(PyFontObject *self)
 {
@@ -734,6 +988,10 @@ font_dealloc(PyFontObject *self)
         TTF_CloseFont(font);
         self->font = NULL;
     }
+    if (self->file_view.obj) {
+        PyBuffer_Release(&self->file_view);
+    }
+    pgRenderCache_SetLimit(&self->render_cache, 0);
 
     if (self->weakreflist)
         PyObject_ClearWeakRefs((PyObject *)self);
@@ -749,6 +1007,11 @@ font_init(PyFontObject *self, PyObject *args, PyObject *kwds)
     SDL_RWops *rw;
 
     self->font = NULL;
+    /* the results kept were rendered with the font replaced */
+    pgRenderCache_SetLimit(&self->render_cache, 0);
+    if (self->file_view.obj) {
+        PyBuffer_Release(&self->file_view);
+    }
     if (!PyArg_ParseTuple(args, "Oi", &obj, &fontsize)) {
         return -1;
     }
@@ -780,7 +1043,10 @@ font_init(PyFontObject *self, PyObject *args, PyObject *kwds)
         fontsize = (int)(fontsize * .6875);
     }
 
-    rw = pgRWops_FromObject(obj);
+    rw = font_map_file(self, obj);
+    if (rw == NULL) {
+        rw = pgRWops_FromObject(obj);
+    }
 
     if (rw == NULL && PyUnicode_Check(obj)) {
         if (!PyUnicode_CompareWithASCIIString(obj, font_defaultname)) {
@@ -803,7 +1069,10 @@ font_init(PyFontObject *self, PyObject *args, PyObject *kwds)
              * but this rewritten code aims to keep the exact behavior as the
              * old one */
 
-            rw = pgRWops_FromObject(obj);
+            rw = font_map_file(self, obj);
+            if (rw == NULL) {
+                rw = pgRWops_FromObject(obj);
+            }
         }
     }
 
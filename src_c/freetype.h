@@ -77,6 +77,7 @@ typedef FT_Angle Angle_t;
 
 struct fontinternals_;
 struct freetypeinstance_;
+struct pgRenderCache_;
 
 typedef struct {
     FT_Long font_index;
@@ -102,6 +103,7 @@ typedef struct {
 
     struct freetypeinstance_ *freetype; /* Personal reference */
     struct fontinternals_ *_internals;
+    struct pgRenderCache_ *render_cache;
 } pgFontObject;
 
 #define pgFont_IS_ALIVE(o) (((pgFontObject *)(o))->_internals != 0)
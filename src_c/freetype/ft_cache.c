@@ -41,10 +41,17 @@ typedef union cachenodekey_ {
 typedef struct cachenode_ {
     FontGlyph glyph;
     struct cachenode_ *next;
+    struct cachenode_ *lru_prev;
+    struct cachenode_ *lru_next;
     NodeKey key;
     FT_UInt32 hash;
+    size_t bytes;
 } CacheNode;
 
+/* The bucket table grows to keep about two glyphs in each bucket when the
+ * cache is limited by bytes, up to this many buckets. */
+#define PGFT_MAX_CACHE_BUCKETS (1 << 20)
+
 static FT_UInt32
 get_hash(const NodeKey *);
 static CacheNode *
@@ -55,6 +62,10 @@ static void
 set_node_key(NodeKey *, GlyphIndex_t, const FontRenderMode *);
 static int
 equal_node_keys(const NodeKey *, const NodeKey *);
+static void
+unlink_node(FontCache *, CacheNode *);
+static void
+grow_buckets(FontCache *);
 
 const int render_flags_mask =
     (FT_RFLAG_ANTIALIAS | FT_RFLAG_HINTED | FT_RFLAG_AUTOHINT);
@@ -162,6 +173,17 @@ _PGFT_Cache_Init(FreeTypeInstance *ft, FontCache *cache)
     cache->free_nodes = 0;
     cache->size_mask = (FT_UInt32)(cache_size - 1);
 
+    cache->lru_first = 0;
+    cache->lru_last = 0;
+    cache->max_bytes = 0;
+    cache->bytes = 0;
+    cache->count = 0;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+    cache->generation = 0;
+    cache->ref_count = 1;
+
 #ifdef PGFT_DEBUG_CACHE
     cache->_debug_count = 0;
     cache->_debug_delete_count = 0;
@@ -172,6 +194,30 @@ _PGFT_Cache_Init(FreeTypeInstance *ft, FontCache *cache)
     return 0;
 }
 
+FontCache *
+_PGFT_Cache_New(FreeTypeInstance *ft)
+{
+    FontCache *cache = _PGFT_malloc(sizeof(FontCache));
+
+    if (!cache) {
+        return 0;
+    }
+    if (_PGFT_Cache_Init(ft, cache)) {
+        _PGFT_free(cache);
+        return 0;
+    }
+    return cache;
+}
+
+void
+_PGFT_Cache_Release(FontCache *cache)
+{
+    if (cache && --cache->ref_count == 0) {
+        _PGFT_Cache_Destroy(cache);
+        _PGFT_free(cache);
+    }
+}
+
 void
 _PGFT_Cache_Destroy(FontCache *cache)
 {
@@ -210,6 +256,18 @@ _PGFT_Cache_Cleanup(FontCache *cache)
     const FT_Byte MAX_BUCKET_DEPTH = 2;
     CacheNode *node, *prev;
     FT_UInt32 i;
+    size_t evictions = cache->evictions;
+
+    if (cache->max_bytes) {
+        while (cache->bytes > cache->max_bytes && cache->lru_first) {
+            node = cache->lru_first;
+            unlink_node(cache, node);
+            free_node(cache, node);
+            cache->evictions++;
+        }
+        grow_buckets(cache);
+        goto end;
+    }
 
     for (i = 0; i <= cache->size_mask; ++i) {
         while (cache->depths[i] > MAX_BUCKET_DEPTH) {
@@ -227,6 +285,7 @@ _PGFT_Cache_Cleanup(FontCache *cache)
                     }
 
                     free_node(cache, node);
+                    cache->evictions++;
                     break;
                 }
 
@@ -235,6 +294,12 @@ _PGFT_Cache_Cleanup(FontCache *cache)
             }
         }
     }
+
+end:
+    /* Layouts holding freed glyphs see this and load them again */
+    if (cache->evictions != evictions) {
+        cache->generation++;
+    }
 }
 
 FontGlyph *
@@ -265,6 +330,21 @@ _PGFT_Cache_FindGlyph(GlyphIndex_t id, const FontRenderMode *render,
                 node->next = nodes[bucket];
                 nodes[bucket] = node;
             }
+            if (node != cache->lru_last) {
+                /* move to the most recently used end */
+                if (node->lru_prev) {
+                    node->lru_prev->lru_next = node->lru_next;
+                }
+                else {
+                    cache->lru_first = node->lru_next;
+                }
+                node->lru_next->lru_prev = node->lru_prev;
+                node->lru_prev = cache->lru_last;
+                node->lru_next = 0;
+                cache->lru_last->lru_next = node;
+                cache->lru_last = node;
+            }
+            cache->hits++;
 
 #ifdef PGFT_DEBUG_CACHE
             cache->_debug_hit++;
@@ -278,6 +358,7 @@ _PGFT_Cache_FindGlyph(GlyphIndex_t id, const FontRenderMode *render,
     }
 
     node = allocate_node(cache, render, id, internal);
+    cache->misses++;
 
 #ifdef PGFT_DEBUG_CACHE
     cache->_debug_miss++;
@@ -299,6 +380,21 @@ free_node(FontCache *cache, CacheNode *node)
 
     cache->depths[node->hash & cache->size_mask]--;
 
+    if (node->lru_prev) {
+        node->lru_prev->lru_next = node->lru_next;
+    }
+    else {
+        cache->lru_first = node->lru_next;
+    }
+    if (node->lru_next) {
+        node->lru_next->lru_prev = node->lru_prev;
+    }
+    else {
+        cache->lru_last = node->lru_prev;
+    }
+    cache->bytes -= node->bytes;
+    cache->count--;
+
     FT_Done_Glyph((FT_Glyph)(node->glyph.image));
     _PGFT_free(node);
 }
@@ -327,6 +423,20 @@ allocate_node(FontCache *cache, const FontRenderMode *render, GlyphIndex_t id,
 
     cache->depths[bucket]++;
 
+    node->lru_prev = cache->lru_last;
+    if (cache->lru_last) {
+        cache->lru_last->lru_next = node;
+    }
+    else {
+        cache->lru_first = node;
+    }
+    cache->lru_last = node;
+    node->bytes = sizeof(CacheNode) + sizeof(FT_BitmapGlyphRec) +
+                  (size_t)node->glyph.image->bitmap.rows *
+                      (size_t)abs(node->glyph.image->bitmap.pitch);
+    cache->bytes += node->bytes;
+    cache->count++;
+
 #ifdef PGFT_DEBUG_CACHE
     cache->_debug_count++;
 #endif
@@ -340,3 +450,58 @@ cleanup:
     _PGFT_free(node);
     return 0;
 }
+
+static void
+unlink_node(FontCache *cache, CacheNode *node)
+{
+    CacheNode **link = &cache->nodes[node->hash & cache->size_mask];
+
+    while (*link != node) {
+        link = &(*link)->next;
+    }
+    *link = node->next;
+}
+
+static void
+grow_buckets(FontCache *cache)
+{
+    FT_UInt32 size = cache->size_mask + 1;
+    FT_UInt32 new_size = size;
+    CacheNode **nodes;
+    FT_Byte *depths;
+    CacheNode *node, *next;
+    FT_UInt32 i, bucket;
+
+    while (new_size < cache->count / 2 && new_size < PGFT_MAX_CACHE_BUCKETS) {
+        new_size <<= 1;
+    }
+    if (new_size == size) {
+        return;
+    }
+
+    /* on failure the table is kept, lookups are only slower */
+    nodes = _PGFT_malloc((size_t)new_size * sizeof(CacheNode *));
+    depths = _PGFT_malloc((size_t)new_size);
+    if (!nodes || !depths) {
+        _PGFT_free(nodes);
+        _PGFT_free(depths);
+        return;
+    }
+    memset(nodes, 0, (size_t)new_size * sizeof(CacheNode *));
+    memset(depths, 0, (size_t)new_size);
+
+    for (i = 0; i < size; ++i) {
+        for (node = cache->nodes[i]; node; node = next) {
+            next = node->next;
+            bucket = node->hash & (new_size - 1);
+            node->next = nodes[bucket];
+            nodes[bucket] = node;
+            depths[bucket]++;
+        }
+    }
+    _PGFT_free(cache->nodes);
+    _PGFT_free(cache->depths);
+    cache->nodes = nodes;
+    cache->depths = depths;
+    cache->size_mask = new_size - 1;
+}
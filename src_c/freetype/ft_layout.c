@@ -82,6 +82,10 @@ static int
 load_glyphs(Layout *, TextContext *, FontCache *);
 static void
 position_glyphs(Layout *);
+static FT_Pos
+find_line_end(Layout *, int, int *);
+static void
+wrap_glyphs(Layout *, FT_Pos);
 static void
 fill_text_bounding_box(Layout *, FT_Vector, FT_Pos, FT_Pos, FT_Pos, FT_Pos,
                        FT_Pos);
@@ -98,12 +102,15 @@ int
 _PGFT_LayoutInit(FreeTypeInstance *ft, pgFontObject *fontobj)
 {
     Layout *ftext = &fontobj->_internals->active_text;
-    FontCache *cache = &fontobj->_internals->glyph_cache;
 
+    ftext->length = 0;
     ftext->buffer_size = 0;
     ftext->glyphs = 0;
+    ftext->cache = 0;
+    ftext->cache_generation = 0;
 
-    if (_PGFT_Cache_Init(ft, cache)) {
+    fontobj->_internals->glyph_cache = _PGFT_Cache_New(ft);
+    if (!fontobj->_internals->glyph_cache) {
         PyErr_NoMemory();
         return -1;
     }
@@ -115,13 +122,54 @@ void
 _PGFT_LayoutFree(pgFontObject *fontobj)
 {
     Layout *ftext = &(fontobj->_internals->active_text);
-    FontCache *cache = &fontobj->_internals->glyph_cache;
 
     if (ftext->buffer_size > 0) {
         _PGFT_free(ftext->glyphs);
         ftext->glyphs = 0;
     }
-    _PGFT_Cache_Destroy(cache);
+    _PGFT_Cache_Release(fontobj->_internals->glyph_cache);
+    fontobj->_internals->glyph_cache = 0;
+}
+
+void
+_PGFT_LayoutShareCache(pgFontObject *fontobj, pgFontObject *source)
+{
+    FontInternals *internals = fontobj->_internals;
+    FontCache *cache = source->_internals->glyph_cache;
+
+    if (internals->glyph_cache == cache) {
+        return;
+    }
+    ++cache->ref_count;
+    _PGFT_Cache_Release(internals->glyph_cache);
+    internals->glyph_cache = cache;
+
+    /* the glyphs of the last text were in the old cache */
+    internals->active_text.cache_generation = cache->generation - 1;
+}
+
+/* Swaps ftext with the active layout of the font. The render functions,
+ * given no text, then draw ftext, a layout kept apart from the font, and a
+ * second swap puts both back.
+ */
+void
+_PGFT_LayoutExchange(pgFontObject *fontobj, Layout *ftext)
+{
+    Layout *active = &fontobj->_internals->active_text;
+    Layout swap = *active;
+
+    *active = *ftext;
+    *ftext = swap;
+}
+
+/* Frees the glyph buffer of a layout kept apart from a font */
+void
+_PGFT_LayoutRelease(Layout *ftext)
+{
+    _PGFT_free(ftext->glyphs);
+    ftext->glyphs = 0;
+    ftext->buffer_size = 0;
+    ftext->length = 0;
 }
 
 Layout *
@@ -129,12 +177,19 @@ _PGFT_LoadLayout(FreeTypeInstance *ft, pgFontObject *fontobj,
                  const FontRenderMode *mode, PGFT_String *text)
 {
     Layout *ftext = &fontobj->_internals->active_text;
-    FontCache *cache = &fontobj->_internals->glyph_cache;
+    FontCache *cache = fontobj->_internals->glyph_cache;
     UpdateLevel_t level =
         (text ? UPDATE_GLYPHS : mode_compare(&ftext->mode, mode));
     FT_Face font = 0;
     TextContext context;
 
+    /* glyphs of the last text may have been freed since, by this Font or
+     * another sharing the cache, or be in a cache the Font no longer uses */
+    if (ftext->cache != cache ||
+        ftext->cache_generation != cache->generation) {
+        level = UPDATE_GLYPHS;
+    }
+
     if (level != UPDATE_NONE) {
         copy_mode(&ftext->mode, mode);
         font = _PGFT_GetFontSized(ft, fontobj, mode->face_size);
@@ -156,6 +211,8 @@ _PGFT_LoadLayout(FreeTypeInstance *ft, pgFontObject *fontobj,
             if (load_glyphs(ftext, &context, cache)) {
                 return 0;
             }
+            ftext->cache = cache;
+            ftext->cache_generation = cache->generation;
             /* fall through */
 
         case UPDATE_LAYOUT:
@@ -208,6 +265,7 @@ size_text(Layout *ftext, FreeTypeInstance *ft, TextContext *context,
         ch = chars[i];
         id = FTC_CMapCache_Lookup(context->charmap, context->id, -1, ch);
         slots[length].id = id;
+        slots[length].ch = ch;
         if (have_kerning) {
             error = FT_Get_Kerning(font, prev_id, id, FT_KERNING_UNFITTED,
                                    &slots[length].kerning);
@@ -244,18 +302,26 @@ load_glyphs(Layout *ftext, TextContext *context, FontCache *cache)
     GlyphSlot *slot = ftext->glyphs;
     Py_ssize_t length = ftext->length;
     FontRenderMode *mode = &ftext->mode;
-    FontGlyph *glyph;
+    FontGlyph *glyph = 0;
     Py_ssize_t i;
 
+    /* Rasterizing uncached glyphs is most of the work of rendering, and
+     * needs nothing from Python, the font being locked by the caller. */
+    Py_BEGIN_ALLOW_THREADS;
     for (i = 0; i < length; ++i) {
         glyph = _PGFT_Cache_FindGlyph(slot[i].id, mode, cache, context);
         if (!glyph) {
-            PyErr_Format(pgExc_SDLError, "Unable to load glyph for id %lu",
-                         (unsigned long)slot[i].id);
-            return -1;
+            break;
         }
         slot[i].glyph = glyph;
     }
+    Py_END_ALLOW_THREADS;
+
+    if (!glyph && length) {
+        PyErr_Format(pgExc_SDLError, "Unable to load glyph for id %lu",
+                     (unsigned long)slot[i].id);
+        return -1;
+    }
     return 0;
 }
 
@@ -355,6 +421,11 @@ position_glyphs(Layout *ftext)
         }
     }
 
+    if (ftext->mode.wrap_length) {
+        wrap_glyphs(ftext, top);
+        return;
+    }
+
     /* Deal with the special case of a trailing space.
      *
      * In determining the bounding box of the text, the above loop omits
@@ -382,6 +453,134 @@ position_glyphs(Layout *ftext)
     fill_text_bounding_box(ftext, pen, min_x, max_x, min_y, max_y, top);
 }
 
+/* The pen position before the glyph of a slot of horizontal text */
+#define SLOT_PEN_X(slot) \
+    ((slot)->posn.x - (slot)->glyph->h_metrics.bearing_rotated.x)
+
+/* Finds where the line starting at slot start ends, at a newline, or else
+ * at the last space before a glyph crossing the wrap length. A word too
+ * long for a line of its own is broken before the glyph crossing it.
+ * Returns the width of the line, trailing spaces left out, and sets *next
+ * to the slot starting the next line.
+ */
+static FT_Pos
+find_line_end(Layout *ftext, int start, int *next)
+{
+    GlyphSlot *slots = ftext->glyphs;
+    FT_Pos start_x = SLOT_PEN_X(slots + start);
+    FT_Pos width = 0;
+    FT_Pos end_x;
+    FT_Pos space_width = 0;
+    int space = -1;
+    int i;
+
+    for (i = start; i < ftext->length; ++i) {
+        if (slots[i].ch == '\n') {
+            *next = i + 1;
+            return width;
+        }
+        if (slots[i].ch == UNICODE_SPACE) {
+            if (space != i - 1 || i == start) {
+                space_width = width;
+            }
+            space = i;
+            continue;
+        }
+        end_x = (SLOT_PEN_X(slots + i) - start_x +
+                 slots[i].glyph->h_metrics.advance_rotated.x);
+        if (end_x > ftext->mode.wrap_length && i > start) {
+            if (space_width > 0) {
+                *next = space + 1;
+                return space_width;
+            }
+            *next = i;
+            return width;
+        }
+        width = end_x;
+    }
+    *next = ftext->length;
+    return width;
+}
+
+/* Breaks the glyphs, positioned along one horizontal line, into lines
+ * below each other, aligned within the widest of them.
+ */
+static void
+wrap_glyphs(Layout *ftext, FT_Pos top)
+{
+    GlyphSlot *slots = ftext->glyphs;
+    FontGlyph *glyph;
+    FT_Pos widest = 0;
+    FT_Pos width;
+    FT_Pos shift_x;
+    FT_Pos baseline = 0;
+    FT_Pos min_x = FX6_MAX;
+    FT_Pos max_x = FX6_MIN;
+    FT_Pos min_y = -ftext->ascender;
+    FT_Pos max_y = FX6_MIN;
+    FT_Vector pen;
+    int start;
+    int next;
+    int i;
+
+    for (start = 0; start < ftext->length; start = next) {
+        width = find_line_end(ftext, start, &next);
+        if (width > widest) {
+            widest = width;
+        }
+    }
+
+    for (start = 0; start < ftext->length; start = next) {
+        width = find_line_end(ftext, start, &next);
+        shift_x = -SLOT_PEN_X(slots + start);
+        if (ftext->mode.align == FT_ALIGN_CENTER) {
+            shift_x += FX6_ROUND((widest - width) / 2);
+        }
+        else if (ftext->mode.align == FT_ALIGN_RIGHT) {
+            shift_x += widest - width;
+        }
+        for (i = start; i < next; ++i) {
+            slots[i].posn.x += shift_x;
+            slots[i].posn.y += baseline;
+            glyph = slots[i].glyph;
+            if (glyph->image->bitmap.width == 0 || slots[i].ch == '\n') {
+                continue;
+            }
+            if (slots[i].posn.x < min_x) {
+                min_x = slots[i].posn.x;
+            }
+            if (slots[i].posn.x + glyph->width > max_x) {
+                max_x = slots[i].posn.x + glyph->width;
+            }
+            if (slots[i].posn.y < min_y) {
+                min_y = slots[i].posn.y;
+            }
+            if (slots[i].posn.y + glyph->height > max_y) {
+                max_y = slots[i].posn.y + glyph->height;
+            }
+        }
+        if (next < ftext->length) {
+            baseline += ftext->height;
+        }
+    }
+    if (ftext->length > 0 && slots[ftext->length - 1].ch == '\n') {
+        /* a trailing newline starts an empty last line */
+        baseline += ftext->height;
+    }
+    if (baseline - ftext->descender > max_y) {
+        max_y = baseline - ftext->descender;
+    }
+
+    if (min_x > max_x) {
+        /* nothing but spaces */
+        min_x = 0;
+        max_x = 0;
+    }
+    pen.x = widest;
+    pen.y = 0;
+    fill_text_bounding_box(ftext, pen, min_x, max_x, min_y, max_y, top);
+}
+
 static void
 fill_text_bounding_box(Layout *ftext, FT_Vector pen, FT_Pos min_x,
                        FT_Pos max_x, FT_Pos min_y, FT_Pos max_y, FT_Pos top)
@@ -453,7 +652,7 @@ _PGFT_GetMetrics(FreeTypeInstance *ft, pgFontObject *fontobj,
                  FT_UInt *gindex, long *minx, long *maxx, long *miny,
                  long *maxy, double *advance_x, double *advance_y)
 {
-    FontCache *cache = &(fontobj->_internals->glyph_cache);
+    FontCache *cache = fontobj->_internals->glyph_cache;
     FT_UInt32 ch = (FT_UInt32)character;
     GlyphIndex_t id;
     FontGlyph *glyph = 0;
@@ -734,7 +933,8 @@ mode_compare(const FontRenderMode *a, const FontRenderMode *b)
          !same_transforms(&a->transform, &b->transform))) {
         return UPDATE_GLYPHS;
     }
-    if ((a_rflags & LAYOUT_RENDER_FLAGS) != (b_rflags & LAYOUT_RENDER_FLAGS)) {
+    if ((a_rflags & LAYOUT_RENDER_FLAGS) != (b_rflags & LAYOUT_RENDER_FLAGS) ||
+        a->wrap_length != b->wrap_length || a->align != b->align) {
         return UPDATE_LAYOUT;
     }
     return UPDATE_NONE;
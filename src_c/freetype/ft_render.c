@@ -157,6 +157,8 @@ _PGFT_BuildRenderMode(FreeTypeInstance *ft, pgFontObject *fontobj,
     mode->render_flags = fontobj->render_flags;
     mode->rotation_angle = rotation;
     mode->transform = fontobj->transform;
+    mode->wrap_length = 0;
+    mode->align = FT_ALIGN_LEFT;
 
     if (mode->rotation_angle != 0) {
         if (!fontobj->is_scalable) {
@@ -206,6 +208,46 @@ _PGFT_BuildRenderMode(FreeTypeInstance *ft, pgFontObject *fontobj,
     return 0;
 }
 
+/* Sets a render mode, already built, to break the text into lines no wider
+ * than wraplength pixels, and at newlines. A wraplength of 0 keeps the text
+ * to one line.
+ */
+int
+_PGFT_SetRenderWrap(FontRenderMode *mode, int wraplength, int align)
+{
+    if (wraplength < 0) {
+        PyErr_SetString(PyExc_ValueError, "wraplength must be 0 or more");
+        return -1;
+    }
+    if (align != FT_ALIGN_LEFT && align != FT_ALIGN_CENTER &&
+        align != FT_ALIGN_RIGHT) {
+        PyErr_SetString(PyExc_ValueError,
+                        "align must be FONT_LEFT, FONT_CENTER or FONT_RIGHT");
+        return -1;
+    }
+    if (!wraplength) {
+        return 0;
+    }
+    if (mode->rotation_angle != 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "wrapping is unsupported for rotated text");
+        return -1;
+    }
+    if (mode->render_flags & FT_RFLAG_VERTICAL) {
+        PyErr_SetString(PyExc_ValueError,
+                        "wrapping is unsupported for vertical text");
+        return -1;
+    }
+    if (mode->style & FT_STYLE_UNDERLINE) {
+        PyErr_SetString(PyExc_ValueError,
+                        "the underline style is unsupported for wrapped text");
+        return -1;
+    }
+    mode->wrap_length = INT_TO_FX6(wraplength);
+    mode->align = (FT_UInt16)align;
+    return 0;
+}
+
 void
 _PGFT_GetRenderMetrics(const FontRenderMode *mode, Layout *text, unsigned *w,
                        unsigned *h, FT_Vector *offset, FT_Pos *underline_top,
@@ -398,7 +440,8 @@ _PGFT_Render_ExistingSurface(FreeTypeInstance *ft, pgFontObject *fontobj,
 SDL_Surface *
 _PGFT_Render_NewSurface(FreeTypeInstance *ft, pgFontObject *fontobj,
                         const FontRenderMode *mode, PGFT_String *text,
-                        FontColor *fgcolor, FontColor *bgcolor, SDL_Rect *r)
+                        FontColor *fgcolor, FontColor *bgcolor, SDL_Rect *r,
+                        PyObject *pool)
 {
     FT_UInt32 rmask = 0;
     FT_UInt32 gmask = 0;
@@ -448,17 +491,17 @@ _PGFT_Render_NewSurface(FreeTypeInstance *ft, pgFontObject *fontobj,
         amask = 0xff000000;
 #endif
     }
-    surface = SDL_CreateRGBSurface(0, width, height, bits_per_pixel, rmask,
-                                   gmask, bmask, amask);
+    surface = pgSurfacePool_CreateSurface(pool, width, height, bits_per_pixel,
+                                          rmask, gmask, bmask, amask);
     if (!surface) {
-        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        /* Exception already set for us */
         return 0;
     }
 
     if (SDL_MUSTLOCK(surface)) {
         if (SDL_LockSurface(surface) == -1) {
             PyErr_SetString(pgExc_SDLError, SDL_GetError());
-            SDL_FreeSurface(surface);
+            pgSurfacePool_FreeSurface(surface);
             return 0;
         }
         locked = 1;
@@ -493,7 +536,7 @@ _PGFT_Render_NewSurface(FreeTypeInstance *ft, pgFontObject *fontobj,
         SDL_Color colors[2];
 
         if (!palette) {
-            SDL_FreeSurface(surface);
+            pgSurfacePool_FreeSurface(surface);
             PyErr_NoMemory();
             return 0;
         }
@@ -509,7 +552,7 @@ _PGFT_Render_NewSurface(FreeTypeInstance *ft, pgFontObject *fontobj,
             PyErr_Format(PyExc_SystemError,
                          "Pygame bug in _PGFT_Render_NewSurface: %.200s",
                          SDL_GetError());
-            SDL_FreeSurface(surface);
+            pgSurfacePool_FreeSurface(surface);
             return 0;
         }
         SDL_SetColorKey(surface, SDL_TRUE, (FT_UInt32)0);
@@ -763,7 +806,13 @@ render(FreeTypeInstance *ft, Layout *text, const FontRenderMode *mode,
     }
     left = offset->x;
     top = offset->y;
+
+    /* The target is held by the caller and the layout by the font lock */
+    Py_BEGIN_ALLOW_THREADS;
     for (n = 0; n < length; ++n) {
+        if (mode->wrap_length && slots[n].ch == '\n') {
+            continue;
+        }
         image = slots[n].glyph->image;
         x = FX6_TRUNC(FX6_CEIL(left + slots[n].posn.x));
         y = FX6_TRUNC(FX6_CEIL(top + slots[n].posn.y));
@@ -788,4 +837,5 @@ render(FreeTypeInstance *ft, Layout *text, const FontRenderMode *mode,
                           FX6_CEIL(underline_size), surface, fg_color);
         }
     }
+    Py_END_ALLOW_THREADS;
 }
@@ -369,6 +369,11 @@ _PGFT_font_request(FTC_FaceID font_id, FT_Library library,
     pgFontId *id = (pgFontId *)font_id;
     FT_Error error;
 
+    /* a face dropped by the cache manager may be opened again while
+     * glyphs are loaded, when the GIL is already released */
+    if (!PyGILState_Check()) {
+        return FT_Open_Face(library, &id->open_args, id->font_index, afont);
+    }
     Py_BEGIN_ALLOW_THREADS;
     error = FT_Open_Face(library, &id->open_args, id->font_index, afont);
     Py_END_ALLOW_THREADS;
@@ -552,6 +557,12 @@ _PGFT_Init(FreeTypeInstance **_instance, int cache_size)
     inst->library = 0;
     inst->cache_size = cache_size;
 
+    inst->lock = SDL_CreateMutex();
+    if (!inst->lock) {
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        goto error_cleanup;
+    }
+
     error = FT_Init_FreeType(&inst->library);
     if (error) {
         PyErr_SetString(
@@ -602,5 +613,28 @@ _PGFT_Quit(FreeTypeInstance *ft)
     if (ft->library)
         FT_Done_FreeType(ft->library);
 
+    if (ft->lock)
+        SDL_DestroyMutex(ft->lock);
+
     _PGFT_free(ft);
 }
+
+/* Takes the lock of the instance, which may be held by a thread waiting
+ * for the GIL to finish rendering, so waiting for it releases the GIL.
+ */
+void
+_PGFT_Lock(FreeTypeInstance *ft)
+{
+    if (SDL_TryLockMutex(ft->lock) == 0) {
+        return;
+    }
+    Py_BEGIN_ALLOW_THREADS;
+    SDL_LockMutex(ft->lock);
+    Py_END_ALLOW_THREADS;
+}
+
+void
+_PGFT_Unlock(FreeTypeInstance *ft)
+{
+    SDL_UnlockMutex(ft->lock);
+}
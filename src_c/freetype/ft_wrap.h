@@ -61,6 +61,11 @@
 /* Rendering styles unsupported for bitmap fonts */
 #define FT_STYLES_SCALABLE_ONLY (FT_STYLE_STRONG | FT_STYLE_OBLIQUE)
 
+/* Alignments of wrapped lines, the values of pygame.FONT_LEFT and co. */
+#define FT_ALIGN_LEFT 0
+#define FT_ALIGN_CENTER 1
+#define FT_ALIGN_RIGHT 2
+
 /**********************************************************
  * Internal basic types
  **********************************************************/
@@ -81,6 +86,11 @@ typedef FT_UInt GlyphIndex_t;
  * When removing a reference, call _PGFT_Quit, which will decrement
  * the reference count and free the resource if the count reaches
  * zero.
+ *
+ * Glyphs are loaded and drawn with the GIL released, so the GIL no longer
+ * keeps threads apart. Everything reached through the instance, the
+ * library, its caches and the layouts and glyph caches of the fonts, is
+ * used only between _PGFT_Lock and _PGFT_Unlock.
  */
 typedef struct freetypeinstance_ {
     Py_ssize_t ref_count;
@@ -89,6 +99,7 @@ typedef struct freetypeinstance_ {
     FT_Library library;
     FTC_Manager cache_manager;
     FTC_CMapCache cache_charmap;
+    SDL_mutex *lock; /* recursive */
 
     int cache_size;
     char _error_msg[1024];
@@ -106,6 +117,8 @@ typedef struct rendermode_ {
     FT_Angle rotation_angle;
     FT_UInt16 render_flags;
     FT_UInt16 style;
+    FT_UInt16 align;    /* of the lines of wrapped text */
+    FT_Pos wrap_length; /* 26.6, 0 to keep the text to one line */
 
     /* All these are Fixed 16.16 */
     FT_Fixed strength;
@@ -125,6 +138,19 @@ typedef struct fontcache_ {
 
     FT_Byte *depths;
 
+    /* Least recently used glyph first, evicted first above max_bytes */
+    struct cachenode_ *lru_first;
+    struct cachenode_ *lru_last;
+
+    size_t max_bytes; /* 0 to keep at most 2 glyphs in each bucket */
+    size_t bytes;
+    size_t count;
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    FT_UInt32 generation; /* changes whenever glyphs are freed */
+    int ref_count;        /* Fonts sharing the cache */
+
 #ifdef PGFT_DEBUG_CACHE
     FT_UInt32 _debug_count;
     FT_UInt32 _debug_delete_count;
@@ -155,6 +181,7 @@ typedef struct fontglyph_ {
 
 typedef struct glyphslot_ {
     GlyphIndex_t id;
+    PGFT_char ch;
     FontGlyph *glyph;
     FT_Vector posn;
     FT_Vector kerning;
@@ -183,6 +210,8 @@ typedef struct layout_ {
 
     int buffer_size;
     GlyphSlot *glyphs;
+    struct fontcache_ *cache;   /* the glyphs were found in */
+    FT_UInt32 cache_generation; /* of the cache the glyphs were found in */
 } Layout;
 
 struct fontsurface_;
@@ -210,7 +239,7 @@ typedef struct fontsurface_ {
 
 typedef struct fontinternals_ {
     Layout active_text;
-    FontCache glyph_cache;
+    FontCache *glyph_cache;
 } FontInternals;
 
 typedef struct PGFT_String_ {
@@ -218,9 +247,7 @@ typedef struct PGFT_String_ {
     PGFT_char data[1];
 } PGFT_String;
 
-#if defined(PGFT_DEBUG_CACHE)
-#define PGFT_FONT_CACHE(f) ((f)->_internals->glyph_cache)
-#endif
+#define PGFT_FONT_CACHE(f) (*(f)->_internals->glyph_cache)
 
 /**********************************************************
  * Module state
@@ -260,6 +287,10 @@ void
 _PGFT_Quit(FreeTypeInstance *);
 int
 _PGFT_Init(FreeTypeInstance **, int);
+void
+_PGFT_Lock(FreeTypeInstance *);
+void
+_PGFT_Unlock(FreeTypeInstance *);
 long
 _PGFT_Font_GetAscender(FreeTypeInstance *, pgFontObject *);
 long
@@ -313,7 +344,7 @@ _PGFT_Render_PixelArray(FreeTypeInstance *, pgFontObject *,
 SDL_Surface *
 _PGFT_Render_NewSurface(FreeTypeInstance *, pgFontObject *,
                         const FontRenderMode *, PGFT_String *, FontColor *,
-                        FontColor *, SDL_Rect *);
+                        FontColor *, SDL_Rect *, PyObject *);
 int
 _PGFT_Render_ExistingSurface(FreeTypeInstance *, pgFontObject *,
                              const FontRenderMode *, PGFT_String *,
@@ -325,6 +356,8 @@ _PGFT_Render_Array(FreeTypeInstance *, pgFontObject *, const FontRenderMode *,
 int
 _PGFT_BuildRenderMode(FreeTypeInstance *, pgFontObject *, FontRenderMode *,
                       Scale_t, int, Angle_t);
+int
+_PGFT_SetRenderWrap(FontRenderMode *, int, int);
 int _PGFT_CheckStyle(FT_UInt32);
 
 /**************************************** Render callbacks *******************/
@@ -397,6 +430,12 @@ int
 _PGFT_LayoutInit(FreeTypeInstance *, pgFontObject *);
 void
 _PGFT_LayoutFree(pgFontObject *);
+void
+_PGFT_LayoutShareCache(pgFontObject *, pgFontObject *);
+void
+_PGFT_LayoutExchange(pgFontObject *, Layout *);
+void
+_PGFT_LayoutRelease(Layout *);
 Layout *
 _PGFT_LoadLayout(FreeTypeInstance *, pgFontObject *, const FontRenderMode *,
                  PGFT_String *);
@@ -406,6 +445,10 @@ _PGFT_LoadGlyph(FontGlyph *, GlyphIndex_t, const FontRenderMode *, void *);
 /**************************************** Glyph cache management *************/
 int
 _PGFT_Cache_Init(FreeTypeInstance *, FontCache *);
+FontCache *
+_PGFT_Cache_New(FreeTypeInstance *);
+void
+_PGFT_Cache_Release(FontCache *);
 void
 _PGFT_Cache_Destroy(FontCache *);
 void
@@ -429,7 +472,8 @@ FT_Face
 _PGFT_GetFontSized(FreeTypeInstance *, pgFontObject *, Scale_t);
 void
 _PGFT_BuildScaler(pgFontObject *, FTC_Scaler, Scale_t);
-#define _PGFT_malloc PyMem_Malloc
-#define _PGFT_free PyMem_Free
+/* The raw allocator, as glyphs are cached with the GIL released */
+#define _PGFT_malloc PyMem_RawMalloc
+#define _PGFT_free PyMem_RawFree
 
 #endif
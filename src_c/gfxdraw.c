@@ -153,12 +153,53 @@ Sint16FromSeqIndex(PyObject *obj, Py_ssize_t _index, Sint16 *val)
     return result;
 }
 
+/* Scanline intersection buffer for filledPolygonMT and texturedPolygonMT.
+ * It is kept between calls so large polygons do not reallocate it every
+ * time, and handed out with the GIL held, to one call at a time.
+ */
+typedef struct {
+    int *ints;
+    int allocated;
+} GfxScratch;
+
+static GfxScratch _gfx_scratch = {NULL, 0};
+static int _gfx_scratch_busy = 0;
+
+/* Returns the shared scratch buffer, or the empty local one if another
+ * thread is drawing with it. Call with the GIL held.
+ */
+static GfxScratch *
+_gfx_scratch_acquire(GfxScratch *local)
+{
+    if (_gfx_scratch_busy) {
+        local->ints = NULL;
+        local->allocated = 0;
+        return local;
+    }
+    _gfx_scratch_busy = 1;
+    return &_gfx_scratch;
+}
+
+/* Hands back a buffer from _gfx_scratch_acquire. Call with the GIL held. */
+static void
+_gfx_scratch_release(GfxScratch *scratch)
+{
+    if (scratch == &_gfx_scratch) {
+        _gfx_scratch_busy = 0;
+    }
+    else {
+        /* allocated by SDL_gfx, with malloc */
+        free(scratch->ints);
+    }
+}
+
 static PyObject *
 _gfx_pixelcolor(PyObject *self, PyObject *args)
 {
     PyObject *surface, *color;
     Sint16 x, y;
     Uint8 rgba[4];
+    int ret;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -169,13 +210,19 @@ _gfx_pixelcolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
     }
 
-    if (pixelRGBA(pgSurface_AsSurface(surface), x, y, rgba[0], rgba[1],
-                  rgba[2], rgba[3]) == -1) {
+    Py_BEGIN_ALLOW_THREADS;
+    ret = pixelRGBA(pgSurface_AsSurface(surface), x, y, rgba[0], rgba[1],
+                    rgba[2], rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -188,6 +235,7 @@ _gfx_hlinecolor(PyObject *self, PyObject *args)
     PyObject *surface, *color;
     Sint16 x1, x2, y;
     Uint8 rgba[4];
+    int ret;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -198,13 +246,19 @@ _gfx_hlinecolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
     }
 
-    if (hlineRGBA(pgSurface_AsSurface(surface), x1, x2, y, rgba[0], rgba[1],
-                  rgba[2], rgba[3]) == -1) {
+    Py_BEGIN_ALLOW_THREADS;
+    ret = hlineRGBA(pgSurface_AsSurface(surface), x1, x2, y, rgba[0], rgba[1],
+                    rgba[2], rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -217,6 +271,7 @@ _gfx_vlinecolor(PyObject *self, PyObject *args)
     PyObject *surface, *color;
     Sint16 x, _y1, y2;
     Uint8 rgba[4];
+    int ret;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -228,13 +283,19 @@ _gfx_vlinecolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
     }
 
-    if (vlineRGBA(pgSurface_AsSurface(surface), x, _y1, y2, rgba[0], rgba[1],
-                  rgba[2], rgba[3]) == -1) {
+    Py_BEGIN_ALLOW_THREADS;
+    ret = vlineRGBA(pgSurface_AsSurface(surface), x, _y1, y2, rgba[0],
+                    rgba[1], rgba[2], rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -248,6 +309,7 @@ _gfx_rectanglecolor(PyObject *self, PyObject *args)
     SDL_Rect temprect, *sdlrect;
     Sint16 x1, x2, _y1, y2;
     Uint8 rgba[4];
+    int ret;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -260,6 +322,8 @@ _gfx_rectanglecolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     sdlrect = pgRect_FromObject(rect, &temprect);
     if (sdlrect == NULL) {
         PyErr_SetString(PyExc_TypeError, "invalid rect style argument");
@@ -276,8 +340,12 @@ _gfx_rectanglecolor(PyObject *self, PyObject *args)
     x2 = (Sint16)(sdlrect->x + sdlrect->w - 1);
     y2 = (Sint16)(sdlrect->y + sdlrect->h - 1);
 
-    if (rectangleRGBA(pgSurface_AsSurface(surface), x1, _y1, x2, y2, rgba[0],
-                      rgba[1], rgba[2], rgba[3]) == -1) {
+    Py_BEGIN_ALLOW_THREADS;
+    ret = rectangleRGBA(pgSurface_AsSurface(surface), x1, _y1, x2, y2,
+                        rgba[0], rgba[1], rgba[2], rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -291,6 +359,7 @@ _gfx_boxcolor(PyObject *self, PyObject *args)
     SDL_Rect temprect, *sdlrect;
     Sint16 x1, x2, _y1, y2;
     Uint8 rgba[4];
+    int ret;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -303,6 +372,8 @@ _gfx_boxcolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     sdlrect = pgRect_FromObject(rect, &temprect);
     if (sdlrect == NULL) {
         PyErr_SetString(PyExc_TypeError, "invalid rect style argument");
@@ -318,8 +389,12 @@ _gfx_boxcolor(PyObject *self, PyObject *args)
     x2 = (Sint16)(sdlrect->x + sdlrect->w - 1);
     y2 = (Sint16)(sdlrect->y + sdlrect->h - 1);
 
-    if (boxRGBA(pgSurface_AsSurface(surface), x1, _y1, x2, y2, rgba[0],
-                rgba[1], rgba[2], rgba[3]) == -1) {
+    Py_BEGIN_ALLOW_THREADS;
+    ret = boxRGBA(pgSurface_AsSurface(surface), x1, _y1, x2, y2, rgba[0],
+                  rgba[1], rgba[2], rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -332,6 +407,7 @@ _gfx_linecolor(PyObject *self, PyObject *args)
     PyObject *surface, *color;
     Sint16 x1, x2, _y1, y2;
     Uint8 rgba[4];
+    int ret;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -343,13 +419,19 @@ _gfx_linecolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
     }
 
-    if (lineRGBA(pgSurface_AsSurface(surface), x1, _y1, x2, y2, rgba[0],
-                 rgba[1], rgba[2], rgba[3]) == -1) {
+    Py_BEGIN_ALLOW_THREADS;
+    ret = lineRGBA(pgSurface_AsSurface(surface), x1, _y1, x2, y2, rgba[0],
+                   rgba[1], rgba[2], rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -362,6 +444,7 @@ _gfx_circlecolor(PyObject *self, PyObject *args)
     PyObject *surface, *color;
     Sint16 x, y, r;
     Uint8 rgba[4];
+    int ret;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -372,13 +455,19 @@ _gfx_circlecolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
     }
 
-    if (circleRGBA(pgSurface_AsSurface(surface), x, y, r, rgba[0], rgba[1],
-                   rgba[2], rgba[3]) == -1) {
+    Py_BEGIN_ALLOW_THREADS;
+    ret = circleRGBA(pgSurface_AsSurface(surface), x, y, r, rgba[0], rgba[1],
+                     rgba[2], rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -391,6 +480,7 @@ _gfx_arccolor(PyObject *self, PyObject *args)
     PyObject *surface, *color;
     Sint16 x, y, r, start, end;
     Uint8 rgba[4];
+    int ret;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -402,13 +492,19 @@ _gfx_arccolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
     }
 
-    if (arcRGBA(pgSurface_AsSurface(surface), x, y, r, start, end, rgba[0],
-                rgba[1], rgba[2], rgba[3]) == -1) {
+    Py_BEGIN_ALLOW_THREADS;
+    ret = arcRGBA(pgSurface_AsSurface(surface), x, y, r, start, end, rgba[0],
+                  rgba[1], rgba[2], rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -421,6 +517,7 @@ _gfx_aacirclecolor(PyObject *self, PyObject *args)
     PyObject *surface, *color;
     Sint16 x, y, r;
     Uint8 rgba[4];
+    int ret;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -432,13 +529,19 @@ _gfx_aacirclecolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
     }
 
-    if (aacircleRGBA(pgSurface_AsSurface(surface), x, y, r, rgba[0], rgba[1],
-                     rgba[2], rgba[3]) == -1) {
+    Py_BEGIN_ALLOW_THREADS;
+    ret = aacircleRGBA(pgSurface_AsSurface(surface), x, y, r, rgba[0],
+                       rgba[1], rgba[2], rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -451,6 +554,7 @@ _gfx_filledcirclecolor(PyObject *self, PyObject *args)
     PyObject *surface, *color;
     Sint16 x, y, r;
     Uint8 rgba[4];
+    int ret;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -462,13 +566,19 @@ _gfx_filledcirclecolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
     }
 
-    if (filledCircleRGBA(pgSurface_AsSurface(surface), x, y, r, rgba[0],
-                         rgba[1], rgba[2], rgba[3]) == -1) {
+    Py_BEGIN_ALLOW_THREADS;
+    ret = filledCircleRGBA(pgSurface_AsSurface(surface), x, y, r, rgba[0],
+                           rgba[1], rgba[2], rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -481,6 +591,7 @@ _gfx_ellipsecolor(PyObject *self, PyObject *args)
     PyObject *surface, *color;
     Sint16 x, y, rx, ry;
     Uint8 rgba[4];
+    int ret;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -492,13 +603,19 @@ _gfx_ellipsecolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
     }
 
-    if (ellipseRGBA(pgSurface_AsSurface(surface), x, y, rx, ry, rgba[0],
-                    rgba[1], rgba[2], rgba[3]) == -1) {
+    Py_BEGIN_ALLOW_THREADS;
+    ret = ellipseRGBA(pgSurface_AsSurface(surface), x, y, rx, ry, rgba[0],
+                      rgba[1], rgba[2], rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -511,6 +628,7 @@ _gfx_aaellipsecolor(PyObject *self, PyObject *args)
     PyObject *surface, *color;
     Sint16 x, y, rx, ry;
     Uint8 rgba[4];
+    int ret;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -522,13 +640,19 @@ _gfx_aaellipsecolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
     }
 
-    if (aaellipseRGBA(pgSurface_AsSurface(surface), x, y, rx, ry, rgba[0],
-                      rgba[1], rgba[2], rgba[3]) == -1) {
+    Py_BEGIN_ALLOW_THREADS;
+    ret = aaellipseRGBA(pgSurface_AsSurface(surface), x, y, rx, ry, rgba[0],
+                        rgba[1], rgba[2], rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -541,6 +665,7 @@ _gfx_filledellipsecolor(PyObject *self, PyObject *args)
     PyObject *surface, *color;
     Sint16 x, y, rx, ry;
     Uint8 rgba[4];
+    int ret;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -552,13 +677,19 @@ _gfx_filledellipsecolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
     }
 
-    if (filledEllipseRGBA(pgSurface_AsSurface(surface), x, y, rx, ry, rgba[0],
-                          rgba[1], rgba[2], rgba[3]) == -1) {
+    Py_BEGIN_ALLOW_THREADS;
+    ret = filledEllipseRGBA(pgSurface_AsSurface(surface), x, y, rx, ry,
+                            rgba[0], rgba[1], rgba[2], rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -571,6 +702,7 @@ _gfx_piecolor(PyObject *self, PyObject *args)
     PyObject *surface, *color;
     Sint16 x, y, r, start, end;
     Uint8 rgba[4];
+    int ret;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -582,13 +714,19 @@ _gfx_piecolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
     }
 
-    if (pieRGBA(pgSurface_AsSurface(surface), x, y, r, start, end, rgba[0],
-                rgba[1], rgba[2], rgba[3]) == -1) {
+    Py_BEGIN_ALLOW_THREADS;
+    ret = pieRGBA(pgSurface_AsSurface(surface), x, y, r, start, end, rgba[0],
+                  rgba[1], rgba[2], rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -601,6 +739,7 @@ _gfx_trigoncolor(PyObject *self, PyObject *args)
     PyObject *surface, *color;
     Sint16 x1, x2, x3, _y1, y2, y3;
     Uint8 rgba[4];
+    int ret;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -612,13 +751,19 @@ _gfx_trigoncolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
     }
 
-    if (trigonRGBA(pgSurface_AsSurface(surface), x1, _y1, x2, y2, x3, y3,
-                   rgba[0], rgba[1], rgba[2], rgba[3]) == -1) {
+    Py_BEGIN_ALLOW_THREADS;
+    ret = trigonRGBA(pgSurface_AsSurface(surface), x1, _y1, x2, y2, x3, y3,
+                     rgba[0], rgba[1], rgba[2], rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -631,6 +776,7 @@ _gfx_aatrigoncolor(PyObject *self, PyObject *args)
     PyObject *surface, *color;
     Sint16 x1, x2, x3, _y1, y2, y3;
     Uint8 rgba[4];
+    int ret;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -642,13 +788,19 @@ _gfx_aatrigoncolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
     }
 
-    if (aatrigonRGBA(pgSurface_AsSurface(surface), x1, _y1, x2, y2, x3, y3,
-                     rgba[0], rgba[1], rgba[2], rgba[3]) == -1) {
+    Py_BEGIN_ALLOW_THREADS;
+    ret = aatrigonRGBA(pgSurface_AsSurface(surface), x1, _y1, x2, y2, x3, y3,
+                       rgba[0], rgba[1], rgba[2], rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -661,6 +813,7 @@ _gfx_filledtrigoncolor(PyObject *self, PyObject *args)
     PyObject *surface, *color;
     Sint16 x1, x2, x3, _y1, y2, y3;
     Uint8 rgba[4];
+    int ret;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -672,13 +825,19 @@ _gfx_filledtrigoncolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
     }
 
-    if (filledTrigonRGBA(pgSurface_AsSurface(surface), x1, _y1, x2, y2, x3, y3,
-                         rgba[0], rgba[1], rgba[2], rgba[3]) == -1) {
+    Py_BEGIN_ALLOW_THREADS;
+    ret = filledTrigonRGBA(pgSurface_AsSurface(surface), x1, _y1, x2, y2, x3,
+                           y3, rgba[0], rgba[1], rgba[2], rgba[3]);
+    Py_END_ALLOW_THREADS;
+
+    if (ret == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -703,6 +862,8 @@ _gfx_polygoncolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
@@ -781,6 +942,8 @@ _gfx_aapolygoncolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
@@ -849,6 +1012,7 @@ _gfx_filledpolygoncolor(PyObject *self, PyObject *args)
     Py_ssize_t count, i;
     int ret;
     Uint8 rgba[4];
+    GfxScratch local, *scratch;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -860,6 +1024,8 @@ _gfx_filledpolygoncolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
@@ -905,10 +1071,13 @@ _gfx_filledpolygoncolor(PyObject *self, PyObject *args)
         vy[i] = y;
     }
 
+    scratch = _gfx_scratch_acquire(&local);
     Py_BEGIN_ALLOW_THREADS;
-    ret = filledPolygonRGBA(pgSurface_AsSurface(surface), vx, vy, (int)count,
-                            rgba[0], rgba[1], rgba[2], rgba[3]);
+    ret = filledPolygonRGBAMT(pgSurface_AsSurface(surface), vx, vy,
+                              (int)count, rgba[0], rgba[1], rgba[2], rgba[3],
+                              &scratch->ints, &scratch->allocated);
     Py_END_ALLOW_THREADS;
+    _gfx_scratch_release(scratch);
 
     PyMem_Free(vx);
     PyMem_Free(vy);
@@ -928,6 +1097,7 @@ _gfx_texturedpolygon(PyObject *self, PyObject *args)
     Sint16 *vx, *vy, x, y, tdx, tdy;
     Py_ssize_t count, i;
     int ret;
+    GfxScratch local, *scratch;
 
     ASSERT_VIDEO_INIT(NULL);
 
@@ -939,12 +1109,16 @@ _gfx_texturedpolygon(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     s_surface = pgSurface_AsSurface(surface);
     if (!pgSurface_Check(texture)) {
         PyErr_SetString(PyExc_TypeError, "texture must be a Surface");
         return NULL;
     }
     s_texture = pgSurface_AsSurface(texture);
+    if (!pgSurface_Unpack(s_texture))
+        return NULL;
     if (!PySequence_Check(points)) {
         PyErr_SetString(PyExc_TypeError, "points must be a sequence");
         return NULL;
@@ -993,9 +1167,12 @@ _gfx_texturedpolygon(PyObject *self, PyObject *args)
         vy[i] = y;
     }
 
+    scratch = _gfx_scratch_acquire(&local);
     Py_BEGIN_ALLOW_THREADS;
-    ret = texturedPolygon(s_surface, vx, vy, (int)count, s_texture, tdx, tdy);
+    ret = texturedPolygonMT(s_surface, vx, vy, (int)count, s_texture, tdx, tdy,
+                            &scratch->ints, &scratch->allocated);
     Py_END_ALLOW_THREADS;
+    _gfx_scratch_release(scratch);
 
     PyMem_Free(vx);
     PyMem_Free(vy);
@@ -1026,6 +1203,8 @@ _gfx_beziercolor(PyObject *self, PyObject *args)
         PyErr_SetString(PyExc_TypeError, "surface must be a Surface");
         return NULL;
     }
+    if (!pgSurface_Unshare(pgSurface_AsSurface(surface)))
+        return NULL;
     if (!pg_RGBAFromObj(color, rgba)) {
         PyErr_SetString(PyExc_TypeError, "invalid color argument");
         return NULL;
@@ -30,24 +30,54 @@
 
 #include "doc/image_doc.h"
 
-#if PG_COMPILE_SSE4_2
+#if PG_COMPILE_SSE4_2 || defined(__SSE2__)
 #include <emmintrin.h>
+#endif
+#if PG_COMPILE_SSE4_2
 /* SSSE 3 */
 #include <tmmintrin.h>
 #endif
 
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 static int
 SaveTGA(SDL_Surface *surface, const char *file, int rle);
 static int
 SaveTGA_RW(SDL_Surface *surface, SDL_RWops *out, int rle);
+static SDL_Surface *
+LoadTGA_RW(SDL_RWops *src, int *supported);
 
 #define DATAROW(data, row, width, height, flipped)             \
     ((flipped) ? (((char *)data) + (height - row - 1) * width) \
                : (((char *)data) + row * width))
 
-static PyObject *extloadobj = NULL;
-static PyObject *extsaveobj = NULL;
-static PyObject *extverobj = NULL;
+/* The imageext functions used when that module is available, kept per
+ * module object so each interpreter holds its own references.
+ */
+typedef struct _image_state_s {
+    PyObject *extload;
+    PyObject *extloadmany;
+    PyObject *extloadregion;
+    PyObject *extbands;
+    PyObject *extsave;
+    PyObject *extsaveasync;
+    PyObject *extwait;
+    PyObject *extver;
+} _ImageState;
+
+#ifndef PYPY_VERSION
+#define IMAGE_MOD_STATE(mod) ((_ImageState *)PyModule_GetState(mod))
+#else  /* PYPY_VERSION */
+static _ImageState _image_modstate = {0};
+#define IMAGE_MOD_STATE(mod) (&_image_modstate)
+#endif /* PYPY_VERSION */
 
 static const char *
 find_extension(const char *fullname)
@@ -65,18 +95,33 @@ find_extension(const char *fullname)
     return dot + 1;
 }
 
+#ifdef WIN32
+#define strcasecmp _stricmp
+#else
+#include <strings.h>
+#endif
+
 static PyObject *
 image_load_basic(PyObject *self, PyObject *obj)
 {
     PyObject *final;
     SDL_Surface *surf;
+    const char *ext;
+    int supported;
 
     SDL_RWops *rw = pgRWops_FromObject(obj);
     if (rw == NULL) {
         return NULL;
     }
+    ext = pgRWops_GetFileExtension(rw);
     Py_BEGIN_ALLOW_THREADS;
-    surf = SDL_LoadBMP_RW(rw, 1);
+    if (ext && !strcasecmp(ext, "tga")) {
+        surf = LoadTGA_RW(rw, &supported);
+        SDL_RWclose(rw);
+    }
+    else {
+        surf = SDL_LoadBMP_RW(rw, 1);
+    }
     Py_END_ALLOW_THREADS;
 
     if (surf == NULL) {
@@ -93,58 +138,226 @@ image_load_basic(PyObject *self, PyObject *obj)
 static PyObject *
 image_load_extended(PyObject *self, PyObject *arg)
 {
-    if (extloadobj == NULL)
+    _ImageState *state = IMAGE_MOD_STATE(self);
+
+    if (state->extload == NULL)
         return RAISE(PyExc_NotImplementedError,
                      "loading images of extended format is not available");
     else
-        return PyObject_CallObject(extloadobj, arg);
+        return PyObject_CallObject(state->extload, arg);
+}
+
+/* Whether the namehint, or else the file name obj, ends in ".tga" */
+static int
+_is_tga(PyObject *obj, const char *namehint)
+{
+    PyObject *oencoded;
+    int is_tga;
+
+    if (namehint)
+        return !strcasecmp(find_extension(namehint), "tga");
+    oencoded = pg_EncodeString(obj, "UTF-8", NULL, pgExc_SDLError);
+    if (oencoded == NULL) {
+        /* left for the loaders to report */
+        PyErr_Clear();
+        return 0;
+    }
+    is_tga = oencoded != Py_None &&
+             !strcasecmp(find_extension(PyBytes_AS_STRING(oencoded)), "tga");
+    Py_DECREF(oencoded);
+    return is_tga;
 }
 
 static PyObject *
 image_load(PyObject *self, PyObject *arg)
 {
-    PyObject *obj;
+    _ImageState *state = IMAGE_MOD_STATE(self);
+    PyObject *obj, *final = NULL;
     const char *name = NULL;
+    SDL_RWops *rw;
+    SDL_Surface *surf;
+    int supported;
+
+    if (!PyArg_ParseTuple(arg, "O|s", &obj, &name)) {
+        return NULL;
+    }
 
-    if (extloadobj == NULL) {
-        if (!PyArg_ParseTuple(arg, "O|s", &obj, &name)) {
+    /* TGA files are read here, being what save() writes without imageext.
+     * Variants LoadTGA_RW does not read are left to SDL_image. */
+    if (_is_tga(obj, name)) {
+        rw = pgRWops_FromObject(obj);
+        if (rw == NULL)
             return NULL;
+        Py_BEGIN_ALLOW_THREADS;
+        surf = LoadTGA_RW(rw, &supported);
+        Py_END_ALLOW_THREADS;
+        if (surf) {
+            final = (PyObject *)pgSurface_New(surf);
+            if (final == NULL)
+                SDL_FreeSurface(surf);
         }
-        return image_load_basic(self, obj);
+        else if (supported || state->extload == NULL) {
+            PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        }
+        if (pgRWops_ReleaseObject(rw) < 0) {
+            Py_XDECREF(final);
+            return NULL;
+        }
+        if (final || PyErr_Occurred())
+            return final;
     }
+
+    if (state->extload == NULL)
+        return image_load_basic(self, obj);
     else
         return image_load_extended(self, arg);
 }
 
-#ifdef WIN32
-#define strcasecmp _stricmp
-#else
-#include <strings.h>
-#endif
+static PyObject *
+image_load_region(PyObject *self, PyObject *arg)
+{
+    _ImageState *state = IMAGE_MOD_STATE(self);
+    PyObject *obj, *rect, *surfobj, *sub, *final;
+    const char *name = NULL;
+
+    if (state->extloadregion != NULL)
+        return PyObject_CallObject(state->extloadregion, arg);
+
+    /* without imageext the whole image is loaded, and the region copied */
+    if (!PyArg_ParseTuple(arg, "OO|s", &obj, &rect, &name)) {
+        return NULL;
+    }
+    surfobj = image_load_basic(self, obj);
+    if (surfobj == NULL)
+        return NULL;
+    sub = PyObject_CallMethod(surfobj, "subsurface", "O", rect);
+    Py_DECREF(surfobj);
+    if (sub == NULL)
+        return NULL;
+    final = PyObject_CallMethod(sub, "copy", NULL);
+    Py_DECREF(sub);
+    return final;
+}
+
+static PyObject *
+image_iter_bands(PyObject *self, PyObject *arg)
+{
+    _ImageState *state = IMAGE_MOD_STATE(self);
+
+    if (state->extbands == NULL)
+        return RAISE(PyExc_NotImplementedError,
+                     "loading images of extended format is not available");
+    else
+        return PyObject_CallObject(state->extbands, arg);
+}
+
+static PyObject *
+image_load_many(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    _ImageState *state = IMAGE_MOD_STATE(self);
+    PyObject *files, *seq, *surfobj, *surfaces, *module, *final;
+    Py_ssize_t count, i;
+    int convert = 0, alpha = 0;
+    static char *keywords[] = {"files", "convert", "alpha", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|pp", keywords, &files,
+                                     &convert, &alpha)) {
+        return NULL;
+    }
+
+    if (state->extloadmany != NULL) {
+        surfaces =
+            PyObject_CallFunctionObjArgs(state->extloadmany, files, NULL);
+    }
+    else {
+        seq = PySequence_Fast(files, "files must be a sequence");
+        if (seq == NULL) {
+            return NULL;
+        }
+        count = PySequence_Fast_GET_SIZE(seq);
+        surfaces = PyList_New(count);
+        for (i = 0; surfaces && i < count; i++) {
+            surfobj =
+                image_load_basic(self, PySequence_Fast_GET_ITEM(seq, i));
+            if (surfobj == NULL) {
+                Py_CLEAR(surfaces);
+                break;
+            }
+            PyList_SET_ITEM(surfaces, i, surfobj);
+        }
+        Py_DECREF(seq);
+    }
+    if (surfaces == NULL || !(convert || alpha)) {
+        return surfaces;
+    }
+
+    /* convert on the worker pool too */
+    module = PyImport_ImportModule(IMPPREFIX "surface");
+    if (module == NULL) {
+        Py_DECREF(surfaces);
+        return NULL;
+    }
+    final = PyObject_CallMethod(module, "convert_many", "OOi", surfaces,
+                                Py_None, alpha);
+    Py_DECREF(module);
+    Py_DECREF(surfaces);
+    return final;
+}
+
+static PyObject *
+image_save_extended(PyObject *self, PyObject *arg, PyObject *kwargs)
+{
+    _ImageState *state = IMAGE_MOD_STATE(self);
+
+    if (state->extsave == NULL)
+        return RAISE(PyExc_NotImplementedError,
+                     "saving images of extended format is not available");
+    else
+        return PyObject_Call(state->extsave, arg, kwargs);
+}
+
+static PyObject *
+image_save_async(PyObject *self, PyObject *arg, PyObject *kwargs)
+{
+    _ImageState *state = IMAGE_MOD_STATE(self);
+
+    if (state->extsaveasync == NULL)
+        return RAISE(PyExc_NotImplementedError,
+                     "saving images of extended format is not available");
+    else
+        return PyObject_Call(state->extsaveasync, arg, kwargs);
+}
 
 static PyObject *
-image_save_extended(PyObject *self, PyObject *arg)
+image_wait_saves(PyObject *self, PyObject *_null)
 {
-    if (extsaveobj == NULL)
+    _ImageState *state = IMAGE_MOD_STATE(self);
+
+    if (state->extwait == NULL)
         return RAISE(PyExc_NotImplementedError,
                      "saving images of extended format is not available");
     else
-        return PyObject_CallObject(extsaveobj, arg);
+        return PyObject_CallObject(state->extwait, NULL);
 }
 
 static PyObject *
-image_save(PyObject *self, PyObject *arg)
+image_save(PyObject *self, PyObject *arg, PyObject *kwargs)
 {
     pgSurfaceObject *surfobj;
     PyObject *obj;
     const char *namehint = NULL;
+    int compression = -1;
+    PyObject *filterobj = Py_None;
     PyObject *oencoded;
     PyObject *ret;
     SDL_Surface *surf;
     int result = 1;
+    static char *keywords[] = {"surface", "file",   "namehint",
+                               "compression", "filter", NULL};
 
-    if (!PyArg_ParseTuple(arg, "O!O|s", &pgSurface_Type, &surfobj, &obj,
-                          &namehint)) {
+    if (!PyArg_ParseTupleAndKeywords(arg, kwargs, "O!O|siO", keywords,
+                                     &pgSurface_Type, &surfobj, &obj,
+                                     &namehint, &compression, &filterobj)) {
         return NULL;
     }
 
@@ -170,9 +383,15 @@ image_save(PyObject *self, PyObject *arg)
             !strcasecmp(ext, "jpeg")) {
             /* If it is .png .jpg .jpeg use the extended module. */
             /* try to get extended formats */
-            ret = image_save_extended(self, arg);
+            ret = image_save_extended(self, arg, kwargs);
+            Py_XDECREF(ret);
             result = (ret == NULL ? -2 : 0);
         }
+        else if (compression != -1 || filterobj != Py_None) {
+            PyErr_SetString(PyExc_ValueError,
+                            "compression and filter only apply to PNG");
+            result = -2;
+        }
         else if (oencoded == Py_None) {
             SDL_RWops *rw = pgRWops_FromFileObject(obj);
             if (rw != NULL) {
@@ -229,7 +448,9 @@ image_save(PyObject *self, PyObject *arg)
 static PyObject *
 image_get_extended(PyObject *self, PyObject *_null)
 {
-    if (extverobj == NULL)
+    _ImageState *state = IMAGE_MOD_STATE(self);
+
+    if (state->extver == NULL)
         Py_RETURN_FALSE;
     else
         Py_RETURN_TRUE;
@@ -238,10 +459,12 @@ image_get_extended(PyObject *self, PyObject *_null)
 static PyObject *
 image_get_sdl_image_version(PyObject *self, PyObject *_null)
 {
-    if (extverobj == NULL)
+    _ImageState *state = IMAGE_MOD_STATE(self);
+
+    if (state->extver == NULL)
         Py_RETURN_NONE;
     else
-        return PyObject_CallObject(extverobj, NULL);
+        return PyObject_CallObject(state->extver, NULL);
 }
 
 #if PG_COMPILE_SSE4_2
@@ -405,6 +628,90 @@ tostring_surf_32bpp_sse42(SDL_Surface *surf, int flipped, char *data,
         }
     }
 }
+
+/*
+ * SSE4.2 variant of the "RGB" case of tostring for 32 bit surfaces whose
+ * color channels are whole bytes.
+ *
+ * Each step shuffles 4 pixels into 12 bytes but stores all 16, so the
+ * vector loop stops 6 pixels short of the end of a row and the last
+ * pixels are done one at a time.
+ */
+static PG_FUNCTION_TARGET_SSE4_2 void
+tostring_surf_32bpp_rgb_sse42(SDL_Surface *surf, int flipped, char *data)
+{
+    SDL_PixelFormat *format = surf->format;
+    int r = format->Rshift / 8, g = format->Gshift / 8, b = format->Bshift / 8;
+    Uint8 shuffle[16];
+    __m128i align_vector;
+    int i, w, h;
+
+    for (i = 0; i < 12; i++) {
+        int channel = i % 3;
+        shuffle[i] = (Uint8)((i / 3) * 4 + (channel == 0   ? r
+                                            : channel == 1 ? g
+                                                           : b));
+    }
+    for (; i < 16; i++) {
+        shuffle[i] = 0x80;
+    }
+    align_vector = _mm_loadu_si128((const __m128i *)shuffle);
+
+    for (h = 0; h < surf->h; ++h) {
+        const Uint8 *row =
+            (Uint8 *)DATAROW(surf->pixels, h, surf->pitch, surf->h, flipped);
+        for (w = 0; w + 6 <= surf->w; w += 4) {
+            __m128i pvector = _mm_loadu_si128((const __m128i *)row);
+            pvector = _mm_shuffle_epi8(pvector, align_vector);
+            _mm_storeu_si128((__m128i *)data, pvector);
+            row += 16;
+            data += 12;
+        }
+        for (; w < surf->w; ++w) {
+            data[0] = (char)row[r];
+            data[1] = (char)row[g];
+            data[2] = (char)row[b];
+            row += 4;
+            data += 3;
+        }
+    }
+}
+
+/*
+ * SSE4.2 variant of the "RGB" case of fromstring on little endian
+ * machines, where the 24 bit surface holds each pixel as B, G, R.
+ *
+ * Each step reverses 5 pixels of the 16 bytes loaded. The 16th byte
+ * stored is rewritten by the next step, and the vector loop stops 6
+ * pixels short of the end of a row so nothing is read or written past it.
+ */
+static PG_FUNCTION_TARGET_SSE4_2 void
+fromstring_rgb_sse42(SDL_Surface *surf, int flipped, const char *data)
+{
+    const __m128i align_vector =
+        _mm_set_epi8((char)0x80, 12, 13, 14, 9, 10, 11, 6, 7, 8, 3, 4, 5, 0,
+                     1, 2);
+    int w, h;
+
+    for (h = 0; h < surf->h; ++h) {
+        Uint8 *pix =
+            (Uint8 *)DATAROW(surf->pixels, h, surf->pitch, surf->h, flipped);
+        for (w = 0; w + 6 <= surf->w; w += 5) {
+            __m128i pvector = _mm_loadu_si128((const __m128i *)data);
+            pvector = _mm_shuffle_epi8(pvector, align_vector);
+            _mm_storeu_si128((__m128i *)pix, pvector);
+            pix += 15;
+            data += 15;
+        }
+        for (; w < surf->w; ++w) {
+            pix[2] = data[0];
+            pix[1] = data[1];
+            pix[0] = data[2];
+            pix += 3;
+            data += 3;
+        }
+    }
+}
 #endif /* PG_COMPILE_SSE4_2 */
 
 static void
@@ -437,7 +744,7 @@ tostring_surf_32bpp(SDL_Surface *surf, int flipped, int hascolorkey,
         sizeof(int) == sizeof(Uint32) &&
         4 * sizeof(Uint32) == sizeof(__m128i) &&
         !hascolorkey /* No color key */
-        && SDL_HasSSE42() == SDL_TRUE
+        && pg_HasSSE42()
         /* The SSE code assumes it will always read at least 4 pixels */
         && surf->w >= 4
         /* Our SSE code assumes masks are at most 0xff */
@@ -591,14 +898,23 @@ image_tostring(PyObject *self, PyObject *arg)
                 }
                 break;
             case 4:
+#if PG_COMPILE_SSE4_2
+                /* The SSE code needs every color channel to be a byte */
+                if (pg_HasSSE42() && Rmask == 0xFFu << Rshift &&
+                    Gmask == 0xFFu << Gshift && Bmask == 0xFFu << Bshift &&
+                    Rshift % 8 == 0 && Gshift % 8 == 0 && Bshift % 8 == 0) {
+                    tostring_surf_32bpp_rgb_sse42(surf, flipped, data);
+                    break;
+                }
+#endif /* PG_COMPILE_SSE4_2 */
                 for (h = 0; h < surf->h; ++h) {
                     Uint32 *ptr = (Uint32 *)DATAROW(
                         surf->pixels, h, surf->pitch, surf->h, flipped);
                     for (w = 0; w < surf->w; ++w) {
                         color = *ptr++;
                         data[0] = (char)(((color & Rmask) >> Rshift) << Rloss);
-                        data[1] = (char)(((color & Gmask) >> Gshift) << Rloss);
-                        data[2] = (char)(((color & Bmask) >> Bshift) << Rloss);
+                        data[1] = (char)(((color & Gmask) >> Gshift) << Gloss);
+                        data[2] = (char)(((color & Bmask) >> Bshift) << Bloss);
                         data += 3;
                     }
                 }
@@ -991,6 +1307,13 @@ image_fromstring(PyObject *self, PyObject *arg)
         if (!surf)
             return RAISE(pgExc_SDLError, SDL_GetError());
         SDL_LockSurface(surf);
+#if PG_COMPILE_SSE4_2 && SDL_BYTEORDER == SDL_LIL_ENDIAN
+        if (pg_HasSSE42()) {
+            fromstring_rgb_sse42(surf, flipped, data);
+            SDL_UnlockSurface(surf);
+            return (PyObject *)pgSurface_New(surf);
+        }
+#endif /* PG_COMPILE_SSE4_2 && SDL_BYTEORDER == SDL_LIL_ENDIAN */
         for (looph = 0; looph < h; ++looph) {
             Uint8 *pix =
                 (Uint8 *)DATAROW(surf->pixels, looph, surf->pitch, h, flipped);
@@ -1090,14 +1413,88 @@ pgObject_AsCharBuffer(PyObject *obj, const char **buffer,
     return _as_read_buffer(obj, (const void **)buffer, buffer_len);
 }
 
+/* Find the first pixel and the pitch of a buffer holding h rows of
+ * row_size bytes. A C contiguous buffer is taken as rows pitch bytes apart,
+ * packed when pitch is -1. Otherwise the buffer must be strided like an
+ * array of rows, each row packed, such as a slice of a wider array.
+ * Returns 0 on failure with an exception set.
+ */
+static int
+_frombuffer_layout(Py_buffer *view, int row_size, int h, int *pitch,
+                   char **data)
+{
+    Py_ssize_t needed, inner;
+    int i;
+
+    *data = (char *)view->buf;
+    if (PyBuffer_IsContiguous(view, 'C')) {
+        if (*pitch < 0) {
+            if (view->len != (Py_ssize_t)row_size * h) {
+                PyErr_SetString(
+                    PyExc_ValueError,
+                    "Buffer length does not equal format and resolution size");
+                return 0;
+            }
+            *pitch = row_size;
+            return 1;
+        }
+        if (*pitch < row_size) {
+            PyErr_SetString(PyExc_ValueError,
+                            "pitch is less than the width of a row");
+            return 0;
+        }
+        needed = (Py_ssize_t)*pitch * (h - 1) + row_size;
+        if (view->len < needed) {
+            PyErr_Format(PyExc_ValueError,
+                         "Buffer of %zd bytes is too short for %d rows of "
+                         "pitch %d",
+                         view->len, h, *pitch);
+            return 0;
+        }
+        return 1;
+    }
+
+    /* a strided buffer: rows along the first dimension, each row packed */
+    if (view->suboffsets || !view->strides || view->ndim < 2 ||
+        view->shape[0] != h) {
+        PyErr_SetString(PyExc_ValueError,
+                        "Buffer must be contiguous, or strided with a row "
+                        "for each line of the image");
+        return 0;
+    }
+    inner = view->itemsize;
+    for (i = view->ndim - 1; i > 0; i--) {
+        if (view->strides[i] != inner) {
+            PyErr_SetString(PyExc_ValueError,
+                            "the pixels of a buffer row must be packed");
+            return 0;
+        }
+        inner *= view->shape[i];
+    }
+    if (inner != row_size) {
+        PyErr_SetString(
+            PyExc_ValueError,
+            "Buffer row length does not equal format and resolution size");
+        return 0;
+    }
+    if (view->strides[0] < row_size || view->strides[0] > INT_MAX ||
+        (*pitch >= 0 && *pitch != view->strides[0])) {
+        PyErr_SetString(PyExc_ValueError,
+                        "the row stride of the buffer does not suit a "
+                        "Surface pitch");
+        return 0;
+    }
+    *pitch = (int)view->strides[0];
+    return 1;
+}
+
 PyObject *
 image_frombuffer(PyObject *self, PyObject *arg)
 {
-    PyObject *buffer;
+    PyObject *buffer, *view;
     char *format, *data;
     SDL_Surface *surf = NULL;
-    int w, h;
-    Py_ssize_t len;
+    int w, h, pitch = -1, bpp;
     pgSurfaceObject *surfobj;
 
 #ifdef _MSC_VER
@@ -1106,58 +1503,62 @@ image_frombuffer(PyObject *self, PyObject *arg)
     __analysis_assume(format = "inited");
 #endif
 
-    if (!PyArg_ParseTuple(arg, "O(ii)s|i", &buffer, &w, &h, &format))
+    if (!PyArg_ParseTuple(arg, "O(ii)s|i", &buffer, &w, &h, &format, &pitch))
         return NULL;
 
     if (w < 1 || h < 1)
         return RAISE(PyExc_ValueError,
                      "Resolution must be nonzero positive values");
 
-    /* breaking constness here, we should really not change this string */
-    if (pgObject_AsCharBuffer(buffer, (const char **)&data, &len) == -1)
+    if (!strcmp(format, "P"))
+        bpp = 1;
+    else if (!strcmp(format, "RGB") || !strcmp(format, "BGR"))
+        bpp = 3;
+    else if (!strcmp(format, "RGBA") || !strcmp(format, "RGBX") ||
+             !strcmp(format, "ARGB"))
+        bpp = 4;
+    else
+        return RAISE(PyExc_ValueError, "Unrecognized type of format");
+
+    if (w > INT_MAX / bpp)
+        return RAISE(PyExc_ValueError, "Resolution is too large");
+
+    /* The memoryview holds the export of the buffer, and so its memory,
+     * for as long as the Surface lives. */
+    view = PyMemoryView_FromObject(buffer);
+    if (!view)
+        return NULL;
+    /* breaking constness here, we should really not change this memory */
+    if (!_frombuffer_layout(PyMemoryView_GET_BUFFER(view), w * bpp, h,
+                            &pitch, &data)) {
+        Py_DECREF(view);
         return NULL;
+    }
 
     if (!strcmp(format, "P")) {
-        if (len != (Py_ssize_t)w * h)
-            return RAISE(
-                PyExc_ValueError,
-                "Buffer length does not equal format and resolution size");
-
-        surf = SDL_CreateRGBSurfaceFrom(data, w, h, 8, w, 0, 0, 0, 0);
+        surf = SDL_CreateRGBSurfaceFrom(data, w, h, 8, pitch, 0, 0, 0, 0);
     }
     else if (!strcmp(format, "RGB")) {
-        if (len != (Py_ssize_t)w * h * 3)
-            return RAISE(
-                PyExc_ValueError,
-                "Buffer length does not equal format and resolution size");
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-        surf = SDL_CreateRGBSurfaceFrom(data, w, h, 24, w * 3, 0xFF, 0xFF << 8,
-                                        0xFF << 16, 0);
+        surf = SDL_CreateRGBSurfaceFrom(data, w, h, 24, pitch, 0xFF,
+                                        0xFF << 8, 0xFF << 16, 0);
 #else
-        surf = SDL_CreateRGBSurfaceFrom(data, w, h, 24, w * 3, 0xFF << 16,
+        surf = SDL_CreateRGBSurfaceFrom(data, w, h, 24, pitch, 0xFF << 16,
                                         0xFF << 8, 0xFF, 0);
 #endif
     }
     else if (!strcmp(format, "BGR")) {
-        if (len != (Py_ssize_t)w * h * 3)
-            return RAISE(
-                PyExc_ValueError,
-                "Buffer length does not equal format and resolution size");
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-        surf = SDL_CreateRGBSurfaceFrom(data, w, h, 24, w * 3, 0xFF << 16,
+        surf = SDL_CreateRGBSurfaceFrom(data, w, h, 24, pitch, 0xFF << 16,
                                         0xFF << 8, 0xFF, 0);
 #else
-        surf = SDL_CreateRGBSurfaceFrom(data, w, h, 24, w * 3, 0xFF, 0xFF << 8,
-                                        0xFF << 16, 0);
+        surf = SDL_CreateRGBSurfaceFrom(data, w, h, 24, pitch, 0xFF,
+                                        0xFF << 8, 0xFF << 16, 0);
 #endif
     }
     else if (!strcmp(format, "RGBA") || !strcmp(format, "RGBX")) {
         int alphamult = !strcmp(format, "RGBA");
-        if (len != (Py_ssize_t)w * h * 4)
-            return RAISE(
-                PyExc_ValueError,
-                "Buffer length does not equal format and resolution size");
-        surf = SDL_CreateRGBSurfaceFrom(data, w, h, 32, w * 4,
+        surf = SDL_CreateRGBSurfaceFrom(data, w, h, 32, pitch,
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
                                         0xFF, 0xFF << 8, 0xFF << 16,
                                         (alphamult ? 0xFF << 24 : 0));
@@ -1165,99 +1566,674 @@ image_frombuffer(PyObject *self, PyObject *arg)
                                         0xFF << 24, 0xFF << 16, 0xFF << 8,
                                         (alphamult ? 0xFF : 0));
 #endif
-        if (alphamult)
+        if (surf && alphamult)
             surf->flags |= SDL_SRCALPHA;
     }
-    else if (!strcmp(format, "ARGB")) {
-        if (len != (Py_ssize_t)w * h * 4)
-            return RAISE(
-                PyExc_ValueError,
-                "Buffer length does not equal format and resolution size");
+    else { /* ARGB */
         surf =
-            SDL_CreateRGBSurfaceFrom(data, w, h, 32, w * 4,
+            SDL_CreateRGBSurfaceFrom(data, w, h, 32, pitch,
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
                                      0xFF << 8, 0xFF << 16, 0xFF << 24, 0xFF);
 #else
                                      0xFF << 16, 0xFF << 8, 0xFF, 0xFF << 24);
 #endif
-        surf->flags |= SDL_SRCALPHA;
+        if (surf)
+            surf->flags |= SDL_SRCALPHA;
     }
-    else
-        return RAISE(PyExc_ValueError, "Unrecognized type of format");
 
-    if (!surf)
+    if (!surf) {
+        Py_DECREF(view);
         return RAISE(pgExc_SDLError, SDL_GetError());
+    }
     surfobj = (pgSurfaceObject *)pgSurface_New(surf);
-    Py_INCREF(buffer);
-    surfobj->dependency = buffer;
+    if (!surfobj) {
+        Py_DECREF(view);
+        return NULL;
+    }
+    surfobj->dependency = view;
     return (PyObject *)surfobj;
 }
 
-/*******************************************************/
-/* tga code by Mattias Engdegard, in the public domain */
-/*******************************************************/
-struct TGAheader {
-    Uint8 infolen;  /* length of info field */
-    Uint8 has_cmap; /* 1 if image has colormap, 0 otherwise */
-    Uint8 type;
-
-    Uint8 cmap_start[2]; /* index of first colormap entry */
-    Uint8 cmap_len[2];   /* number of entries in colormap */
-    Uint8 cmap_bits;     /* bits per colormap entry */
-
-    Uint8 yorigin[2]; /* image origin (ignored here) */
-    Uint8 xorigin[2];
-    Uint8 width[2]; /* image size */
-    Uint8 height[2];
-    Uint8 pixel_bits; /* bits/pixel */
-    Uint8 flags;
-};
-
-enum tga_type {
-    TGA_TYPE_INDEXED = 1,
-    TGA_TYPE_RGB = 2,
-    TGA_TYPE_BW = 3,
-    TGA_TYPE_RLE = 8 /* additive */
-};
-
-#define TGA_INTERLEAVE_MASK 0xc0
-#define TGA_INTERLEAVE_NONE 0x00
-#define TGA_INTERLEAVE_2WAY 0x40
-#define TGA_INTERLEAVE_4WAY 0x80
-
-#define TGA_ORIGIN_MASK 0x30
-#define TGA_ORIGIN_LEFT 0x00
-#define TGA_ORIGIN_RIGHT 0x10
-#define TGA_ORIGIN_LOWER 0x00
-#define TGA_ORIGIN_UPPER 0x20
-
-/* read/write unaligned little-endian 16-bit ints */
-#define LE16(p) ((p)[0] + ((p)[1] << 8))
-#define SETLE16(p, v) ((p)[0] = (v), (p)[1] = (v) >> 8)
+/*
+ * Raw surfaces: a pgRawHeader, the palette colors, then the rows of pixels
+ * in the surface's own format, starting PG_RAW_ALIGN bytes into the file.
+ * load_raw() maps the file copy-on-write and makes a surface right over
+ * the mapping, so loading costs no decoding and no copying.
+ */
+#define PG_RAW_MAGIC 0x57415250 /* "PRAW", in the byte order of the saver */
+#define PG_RAW_VERSION 1
+#define PG_RAW_ALIGN 64
+
+#define PG_RAW_COLORKEY 0x1
+#define PG_RAW_BLEND 0x2
+#define PG_RAW_PREMULTIPLIED 0x4
+
+typedef struct {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 format; /* SDL_PixelFormatEnum */
+    Uint32 width;
+    Uint32 height;
+    Uint32 pitch;
+    Uint32 flags;
+    Uint32 colorkey;
+    Uint32 alpha;   /* surface alpha modulation */
+    Uint32 ncolors; /* SDL_Colors following the header */
+    Uint32 offset;  /* where the pixels start */
+} pgRawHeader;
+
+/* The memory a raw surface is made over, freed with the surface */
+typedef struct {
+    void *base;
+    size_t size;
+    int mapped;
+} pgRawData;
+
+#define PG_RAW_CAPSULE "pygame.image.raw"
 
-#ifndef MIN
-#define MIN(a, b) ((a) < (b) ? (a) : (b))
+static void
+_raw_data_release(pgRawData *data)
+{
+    if (data->mapped) {
+#ifdef WIN32
+        UnmapViewOfFile(data->base);
+#else
+        munmap(data->base, data->size);
 #endif
+    }
+    else {
+        PyMem_Free(data->base);
+    }
+    PyMem_Free(data);
+}
 
-#define TGA_RLE_MAX 128 /* max length of a TGA RLE chunk */
-/* return the number of bytes in the resulting buffer after RLE-encoding
-   a line of TGA data */
+static void
+_raw_data_free(PyObject *capsule)
+{
+    _raw_data_release(PyCapsule_GetPointer(capsule, PG_RAW_CAPSULE));
+}
+
+/* Map a file copy-on-write. Returns -1 with a Python error set on
+ * failure.
+ */
 static int
-rle_line(Uint8 *src, Uint8 *dst, int w, int bpp)
+_raw_map_file(const char *path, pgRawData *data)
 {
-    int x = 0;
-    int out = 0;
-    int raw = 0;
-    while (x < w) {
-        Uint32 pix;
-        int x0 = x;
-        memcpy(&pix, src + x * bpp, bpp);
-        x++;
-        while (x < w && memcmp(&pix, src + x * bpp, bpp) == 0 &&
-               x - x0 < TGA_RLE_MAX)
-            x++;
-        /* use a repetition chunk iff the repeated pixels would consume
-           two bytes or more */
+#ifdef WIN32
+    HANDLE file, mapping;
+    LARGE_INTEGER size;
+    wchar_t *wpath;
+    int len;
+
+    len = MultiByteToWideChar(CP_UTF8, 0, path, -1, NULL, 0);
+    wpath = len ? (wchar_t *)PyMem_Malloc(len * sizeof(wchar_t)) : NULL;
+    if (!wpath) {
+        PyErr_SetFromWindowsErr(0);
+        return -1;
+    }
+    MultiByteToWideChar(CP_UTF8, 0, path, -1, wpath, len);
+    file = CreateFileW(wpath, GENERIC_READ, FILE_SHARE_READ, NULL,
+                       OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    PyMem_Free(wpath);
+    if (file == INVALID_HANDLE_VALUE) {
+        PyErr_SetExcFromWindowsErrWithFilename(PyExc_OSError, 0, path);
+        return -1;
+    }
+    if (!GetFileSizeEx(file, &size)) {
+        PyErr_SetFromWindowsErr(0);
+        CloseHandle(file);
+        return -1;
+    }
+    if ((ULONGLONG)size.QuadPart < sizeof(pgRawHeader)) {
+        CloseHandle(file);
+        PyErr_SetString(pgExc_SDLError, "not a raw image file");
+        return -1;
+    }
+    mapping = CreateFileMappingW(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping) {
+        PyErr_SetFromWindowsErr(0);
+        return -1;
+    }
+    /* the view keeps the mapping alive */
+    data->base = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data->base) {
+        PyErr_SetFromWindowsErr(0);
+        return -1;
+    }
+    data->size = (size_t)size.QuadPart;
+#else
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+        return -1;
+    }
+    if (fstat(fd, &st) < 0) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        close(fd);
+        return -1;
+    }
+    if ((size_t)st.st_size < sizeof(pgRawHeader)) {
+        close(fd);
+        PyErr_SetString(pgExc_SDLError, "not a raw image file");
+        return -1;
+    }
+    data->base = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data->base == MAP_FAILED) {
+        data->base = NULL;
+        PyErr_SetFromErrno(PyExc_OSError);
+        return -1;
+    }
+    data->size = (size_t)st.st_size;
+#endif
+    data->mapped = 1;
+    return 0;
+}
+
+/* Read all of a file-like object. Returns -1 with a Python error set on
+ * failure.
+ */
+static int
+_raw_read_file(PyObject *obj, pgRawData *data)
+{
+    SDL_RWops *rw = pgRWops_FromFileObject(obj);
+    Sint64 size;
+    int result = -1;
+
+    if (!rw)
+        return -1;
+    size = SDL_RWsize(rw);
+    if (size < (Sint64)sizeof(pgRawHeader) || (Uint64)size > PY_SSIZE_T_MAX) {
+        PyErr_SetString(pgExc_SDLError, "not a raw image file");
+    }
+    else if (!(data->base = PyMem_Malloc((size_t)size))) {
+        PyErr_NoMemory();
+    }
+    else if (SDL_RWread(rw, data->base, 1, (size_t)size) != (size_t)size) {
+        PyMem_Free(data->base);
+        data->base = NULL;
+        if (!PyErr_Occurred())
+            PyErr_SetString(pgExc_SDLError, "the raw image file is cut short");
+    }
+    else {
+        data->size = (size_t)size;
+        result = 0;
+    }
+    pgRWops_ReleaseObject(rw);
+    return result;
+}
+
+/* Make a surface over the pixels of a raw image, or set an SDL error */
+static SDL_Surface *
+_raw_surface(const pgRawData *data)
+{
+    const pgRawHeader *h = (const pgRawHeader *)data->base;
+    SDL_Surface *surf;
+    Uint64 end;
+
+    if (h->magic == SDL_Swap32(PG_RAW_MAGIC)) {
+        SDL_SetError("the raw image was saved with the other byte order");
+        return NULL;
+    }
+    if (h->magic != PG_RAW_MAGIC || h->version != PG_RAW_VERSION) {
+        SDL_SetError("not a raw image file");
+        return NULL;
+    }
+    end = (Uint64)h->offset + (Uint64)h->pitch * h->height;
+    if (h->width < 1 || h->height < 1 || h->width > INT_MAX ||
+        h->height > INT_MAX || h->pitch > INT_MAX ||
+        h->offset % PG_RAW_ALIGN ||
+        h->offset < sizeof(pgRawHeader) + (Uint64)h->ncolors * 4 ||
+        end > data->size || SDL_ISPIXELFORMAT_FOURCC(h->format) ||
+        (Uint64)h->pitch < (Uint64)h->width * SDL_BYTESPERPIXEL(h->format)) {
+        SDL_SetError("the raw image file is damaged");
+        return NULL;
+    }
+
+    surf = SDL_CreateRGBSurfaceWithFormatFrom(
+        (Uint8 *)data->base + h->offset, (int)h->width, (int)h->height,
+        SDL_BITSPERPIXEL(h->format), (int)h->pitch, h->format);
+    if (!surf)
+        return NULL;
+    if (surf->format->palette && h->ncolors &&
+        SDL_SetPaletteColors(surf->format->palette,
+                             (const SDL_Color *)(h + 1), 0,
+                             SDL_min((int)h->ncolors,
+                                     surf->format->palette->ncolors))) {
+        SDL_FreeSurface(surf);
+        return NULL;
+    }
+    if ((h->flags & PG_RAW_COLORKEY) &&
+        SDL_SetColorKey(surf, SDL_TRUE, h->colorkey)) {
+        SDL_FreeSurface(surf);
+        return NULL;
+    }
+    SDL_SetSurfaceBlendMode(surf, (h->flags & PG_RAW_BLEND)
+                                      ? SDL_BLENDMODE_BLEND
+                                      : SDL_BLENDMODE_NONE);
+    SDL_SetSurfaceAlphaMod(surf, (Uint8)h->alpha);
+    if (h->flags & PG_RAW_PREMULTIPLIED)
+        surf->flags |= PG_SURF_PREMULTIPLIED;
+    return surf;
+}
+
+static PyObject *
+image_load_raw(PyObject *self, PyObject *obj)
+{
+    PyObject *oencoded, *capsule;
+    pgRawData *data;
+    SDL_Surface *surf;
+    pgSurfaceObject *surfobj;
+    int result;
+
+    data = (pgRawData *)PyMem_Calloc(1, sizeof(pgRawData));
+    if (!data)
+        return PyErr_NoMemory();
+    oencoded = pg_EncodeString(obj, "UTF-8", NULL, pgExc_SDLError);
+    if (!oencoded) {
+        PyMem_Free(data);
+        return NULL;
+    }
+    if (oencoded == Py_None)
+        result = _raw_read_file(obj, data);
+    else
+        result = _raw_map_file(PyBytes_AS_STRING(oencoded), data);
+    Py_DECREF(oencoded);
+    if (result) {
+        PyMem_Free(data);
+        return NULL;
+    }
+    capsule = PyCapsule_New(data, PG_RAW_CAPSULE, _raw_data_free);
+    if (!capsule) {
+        _raw_data_release(data);
+        return NULL;
+    }
+
+    surf = _raw_surface(data);
+    if (!surf) {
+        Py_DECREF(capsule);
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    surfobj = (pgSurfaceObject *)pgSurface_New(surf);
+    if (!surfobj) {
+        SDL_FreeSurface(surf);
+        Py_DECREF(capsule);
+        return NULL;
+    }
+    /* the pixels live as long as the surface */
+    surfobj->dependency = capsule;
+    return (PyObject *)surfobj;
+}
+
+/* Fill in the raw header of surf, or set an SDL error */
+static int
+_raw_header(SDL_Surface *surf, pgRawHeader *h)
+{
+    SDL_Palette *palette = surf->format->palette;
+    SDL_BlendMode mode;
+    Uint32 colorkey;
+    Uint8 alpha;
+    size_t used;
+
+    if (surf->format->format == SDL_PIXELFORMAT_UNKNOWN) {
+        SDL_SetError("the surface has no named pixel format");
+        return -1;
+    }
+
+    SDL_memset(h, 0, sizeof(*h));
+    h->magic = PG_RAW_MAGIC;
+    h->version = PG_RAW_VERSION;
+    h->format = surf->format->format;
+    h->width = surf->w;
+    h->height = surf->h;
+    /* rows padded to 4 bytes, as SDL lays them out */
+    h->pitch = (Uint32)(((size_t)surf->w * surf->format->BytesPerPixel + 3) &
+                        ~(size_t)3);
+    if (SDL_GetColorKey(surf, &colorkey) == 0) {
+        h->flags |= PG_RAW_COLORKEY;
+        h->colorkey = colorkey;
+    }
+    else {
+        SDL_ClearError();
+    }
+    if (SDL_GetSurfaceBlendMode(surf, &mode) == 0 &&
+        mode == SDL_BLENDMODE_BLEND)
+        h->flags |= PG_RAW_BLEND;
+    if (surf->flags & PG_SURF_PREMULTIPLIED)
+        h->flags |= PG_RAW_PREMULTIPLIED;
+    SDL_GetSurfaceAlphaMod(surf, &alpha);
+    h->alpha = alpha;
+    h->ncolors = palette ? palette->ncolors : 0;
+    used = sizeof(*h) + h->ncolors * sizeof(SDL_Color);
+    h->offset =
+        (Uint32)((used + PG_RAW_ALIGN - 1) / PG_RAW_ALIGN * PG_RAW_ALIGN);
+    return 0;
+}
+
+static int
+SaveRaw_RW(SDL_Surface *surf, SDL_RWops *out)
+{
+    static const Uint8 zeros[PG_RAW_ALIGN] = {0};
+    SDL_Palette *palette = surf->format->palette;
+    pgRawHeader h;
+    size_t used, rowbytes;
+    int y, result = 0;
+
+    if (_raw_header(surf, &h))
+        return -1;
+    used = sizeof(h) + h.ncolors * sizeof(SDL_Color);
+    rowbytes = (size_t)surf->w * surf->format->BytesPerPixel;
+
+    if (SDL_RWwrite(out, &h, sizeof(h), 1) != 1 ||
+        (h.ncolors &&
+         SDL_RWwrite(out, palette->colors, sizeof(SDL_Color), h.ncolors) !=
+             h.ncolors) ||
+        (h.offset > used &&
+         SDL_RWwrite(out, zeros, h.offset - used, 1) != 1))
+        return -1;
+
+    if (SDL_LockSurface(surf))
+        return -1;
+    if ((Uint32)surf->pitch == h.pitch) {
+        if (SDL_RWwrite(out, surf->pixels, h.pitch, h.height) != h.height)
+            result = -1;
+    }
+    else {
+        /* a subsurface, or a surface with extra padding */
+        for (y = 0; y < surf->h && !result; y++) {
+            if (SDL_RWwrite(out, (Uint8 *)surf->pixels + y * surf->pitch,
+                            rowbytes, 1) != 1 ||
+                (h.pitch > rowbytes &&
+                 SDL_RWwrite(out, zeros, h.pitch - rowbytes, 1) != 1))
+                result = -1;
+        }
+    }
+    SDL_UnlockSurface(surf);
+    return result;
+}
+
+static PyObject *
+image_save_raw(PyObject *self, PyObject *arg)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *obj, *oencoded;
+    SDL_Surface *surf;
+    SDL_RWops *rw;
+    int result, fileobj;
+
+    if (!PyArg_ParseTuple(arg, "O!O", &pgSurface_Type, &surfobj, &obj))
+        return NULL;
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+
+    oencoded = pg_EncodeString(obj, "UTF-8", NULL, pgExc_SDLError);
+    if (!oencoded)
+        return NULL;
+    if (oencoded == Py_None) {
+        rw = pgRWops_FromFileObject(obj);
+        Py_DECREF(oencoded);
+        if (!rw)
+            return NULL;
+    }
+    else {
+        rw = SDL_RWFromFile(PyBytes_AS_STRING(oencoded), "wb");
+        Py_DECREF(oencoded);
+        if (!rw)
+            return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+
+    fileobj = pgRWops_IsFileObject(rw);
+    pgSurface_Prep(surfobj);
+    if (fileobj) {
+        result = SaveRaw_RW(surf, rw);
+    }
+    else {
+        Py_BEGIN_ALLOW_THREADS;
+        result = SaveRaw_RW(surf, rw);
+        Py_END_ALLOW_THREADS;
+    }
+    pgSurface_Unprep(surfobj);
+
+    if (result && !PyErr_Occurred())
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+    if (fileobj) {
+        if (pgRWops_ReleaseObject(rw) < 0)
+            result = -1;
+    }
+    else if (SDL_RWclose(rw) < 0 && !result) {
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        result = -1;
+    }
+    if (result)
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+image_raw_size(PyObject *self, PyObject *arg)
+{
+    SDL_Surface *surf;
+    pgRawHeader h;
+
+    if (!pgSurface_Check(arg))
+        return RAISE(PyExc_TypeError, "argument must be a Surface");
+    surf = pgSurface_AsSurface(arg);
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    if (_raw_header(surf, &h))
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    return PyLong_FromUnsignedLongLong((unsigned long long)h.offset +
+                                       (unsigned long long)h.pitch *
+                                           h.height);
+}
+
+static PyObject *
+image_tobuffer_raw(PyObject *self, PyObject *arg)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *obj;
+    Py_buffer view;
+    SDL_Surface *surf;
+    SDL_RWops *rw;
+    pgRawHeader h;
+    int result;
+
+    if (!PyArg_ParseTuple(arg, "O!O", &pgSurface_Type, &surfobj, &obj))
+        return NULL;
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    if (_raw_header(surf, &h))
+        return RAISE(pgExc_SDLError, SDL_GetError());
+
+    if (PyObject_GetBuffer(obj, &view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS))
+        return NULL;
+    if ((Uint64)view.len < (Uint64)h.offset + (Uint64)h.pitch * h.height) {
+        PyBuffer_Release(&view);
+        return RAISE(PyExc_ValueError,
+                     "the buffer is shorter than raw_size() of the Surface");
+    }
+    rw = SDL_RWFromMem(view.buf, (int)SDL_min(view.len, INT_MAX));
+    if (!rw) {
+        PyBuffer_Release(&view);
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+
+    pgSurface_Prep(surfobj);
+    Py_BEGIN_ALLOW_THREADS;
+    result = SaveRaw_RW(surf, rw);
+    Py_END_ALLOW_THREADS;
+    pgSurface_Unprep(surfobj);
+    SDL_RWclose(rw);
+    PyBuffer_Release(&view);
+
+    if (result)
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+image_frombuffer_raw(PyObject *self, PyObject *buffer)
+{
+    PyObject *view;
+    Py_buffer *pybuf;
+    pgRawData data;
+    SDL_Surface *surf;
+    pgSurfaceObject *surfobj;
+
+    /* The memoryview holds the export of the buffer, and so its memory,
+     * for as long as the Surface lives. */
+    view = PyMemoryView_FromObject(buffer);
+    if (!view)
+        return NULL;
+    pybuf = PyMemoryView_GET_BUFFER(view);
+    if (!PyBuffer_IsContiguous(pybuf, 'C') ||
+        (uintptr_t)pybuf->buf % sizeof(Uint32)) {
+        Py_DECREF(view);
+        return RAISE(PyExc_ValueError,
+                     "the buffer must be contiguous and aligned to 4 bytes");
+    }
+    if ((size_t)pybuf->len < sizeof(pgRawHeader)) {
+        Py_DECREF(view);
+        return RAISE(pgExc_SDLError, "not a raw image file");
+    }
+
+    data.base = pybuf->buf;
+    data.size = (size_t)pybuf->len;
+    data.mapped = 0;
+    surf = _raw_surface(&data);
+    if (!surf) {
+        Py_DECREF(view);
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    surfobj = (pgSurfaceObject *)pgSurface_New(surf);
+    if (!surfobj) {
+        SDL_FreeSurface(surf);
+        Py_DECREF(view);
+        return NULL;
+    }
+    surfobj->dependency = view;
+    return (PyObject *)surfobj;
+}
+
+/*******************************************************/
+/* tga code by Mattias Engdegard, in the public domain */
+/*******************************************************/
+struct TGAheader {
+    Uint8 infolen;  /* length of info field */
+    Uint8 has_cmap; /* 1 if image has colormap, 0 otherwise */
+    Uint8 type;
+
+    Uint8 cmap_start[2]; /* index of first colormap entry */
+    Uint8 cmap_len[2];   /* number of entries in colormap */
+    Uint8 cmap_bits;     /* bits per colormap entry */
+
+    Uint8 yorigin[2]; /* image origin (ignored here) */
+    Uint8 xorigin[2];
+    Uint8 width[2]; /* image size */
+    Uint8 height[2];
+    Uint8 pixel_bits; /* bits/pixel */
+    Uint8 flags;
+};
+
+enum tga_type {
+    TGA_TYPE_INDEXED = 1,
+    TGA_TYPE_RGB = 2,
+    TGA_TYPE_BW = 3,
+    TGA_TYPE_RLE = 8 /* additive */
+};
+
+#define TGA_INTERLEAVE_MASK 0xc0
+#define TGA_INTERLEAVE_NONE 0x00
+#define TGA_INTERLEAVE_2WAY 0x40
+#define TGA_INTERLEAVE_4WAY 0x80
+
+#define TGA_ORIGIN_MASK 0x30
+#define TGA_ORIGIN_LEFT 0x00
+#define TGA_ORIGIN_RIGHT 0x10
+#define TGA_ORIGIN_LOWER 0x00
+#define TGA_ORIGIN_UPPER 0x20
+
+/* read/write unaligned little-endian 16-bit ints */
+#define LE16(p) ((p)[0] + ((p)[1] << 8))
+#define SETLE16(p, v) ((p)[0] = (v), (p)[1] = (v) >> 8)
+
+#ifndef MIN
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#endif
+
+#define TGA_RLE_MAX 128 /* max length of a TGA RLE chunk */
+#define TGA_CHUNK 65536 /* bytes of rows converted and written at once */
+
+#ifndef MAX
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#endif
+
+/* The number of pixels from src on equal to the first, at most max */
+static int
+tga_run_length(const Uint8 *src, int max, int bpp)
+{
+    int n = 1;
+
+    if (bpp == 4) {
+        Uint32 pix, next;
+        memcpy(&pix, src, 4);
+#ifdef __SSE2__
+        {
+            /* four pixels at a time, while they all match */
+            __m128i pvector = _mm_set1_epi32((int)pix);
+            while (n + 4 <= max) {
+                __m128i block =
+                    _mm_loadu_si128((const __m128i *)(src + n * 4));
+                int mask =
+                    _mm_movemask_epi8(_mm_cmpeq_epi32(block, pvector));
+                if (mask != 0xffff) {
+                    while ((mask & 0xf) == 0xf) {
+                        mask >>= 4;
+                        n++;
+                    }
+                    return n;
+                }
+                n += 4;
+            }
+        }
+#endif /* __SSE2__ */
+        for (; n < max; n++) {
+            memcpy(&next, src + n * 4, 4);
+            if (next != pix)
+                break;
+        }
+    }
+    else if (bpp == 1) {
+        while (n < max && src[n] == src[0])
+            n++;
+    }
+    else {
+        while (n < max && !memcmp(src, src + n * bpp, bpp))
+            n++;
+    }
+    return n;
+}
+
+/* return the number of bytes in the resulting buffer after RLE-encoding
+   a line of TGA data */
+static int
+rle_line(Uint8 *src, Uint8 *dst, int w, int bpp)
+{
+    int x = 0;
+    int out = 0;
+    int raw = 0;
+    while (x < w) {
+        int x0 = x;
+        x += tga_run_length(src + x * bpp, MIN(w - x, TGA_RLE_MAX), bpp);
+        /* use a repetition chunk iff the repeated pixels would consume
+           two bytes or more */
         if ((x - x0 - 1) * bpp >= 2 || x == w) {
             /* output previous raw chunks */
             while (raw < x0) {
@@ -1271,7 +2247,7 @@ rle_line(Uint8 *src, Uint8 *dst, int w, int bpp)
             if (x - x0 > 0) {
                 /* output new repetition chunk */
                 dst[out++] = 0x7f + x - x0;
-                memcpy(dst + out, &pix, bpp);
+                memcpy(dst + out, src + x0 * bpp, bpp);
                 out += bpp;
             }
             raw = x;
@@ -1287,7 +2263,7 @@ rle_line(Uint8 *src, Uint8 *dst, int w, int bpp)
  * 15, 16, 24 and 32bpp surfaces are saved as 24bpp RGB images,
  * or as 32bpp RGBA images if alpha channel is used.
  *
- * RLE compression is not used in the output file.
+ * Rows are RLE compressed when rle is set.
  *
  * Returns -1 upon error, 0 if success
  */
@@ -1304,7 +2280,9 @@ SaveTGA_RW(SDL_Surface *surface, SDL_RWops *out, int rle)
     Uint32 rmask, gmask, bmask, amask;
     SDL_Rect r;
     int bpp;
-    Uint8 *rlebuf = NULL;
+    Uint8 *chunk = NULL;
+    int band, rowmax;
+    int result = 0;
 
     h.infolen = 0;
     SETLE16(h.cmap_start, 0);
@@ -1380,8 +2358,12 @@ SaveTGA_RW(SDL_Surface *surface, SDL_RWops *out, int rle)
         }
     }
 
-    linebuf = SDL_CreateRGBSurface(SDL_SWSURFACE, surface->w, 1, h.pixel_bits,
-                                   rmask, gmask, bmask, amask);
+    /* the surface is converted a band of rows per blit, and the rows
+       written out in chunks of about TGA_CHUNK bytes */
+    band = surface->w ? TGA_CHUNK / (surface->w * bpp) : 1;
+    band = MAX(1, MIN(surface->h, band));
+    linebuf = SDL_CreateRGBSurface(SDL_SWSURFACE, surface->w, band,
+                                   h.pixel_bits, rmask, gmask, bmask, amask);
     if (!linebuf)
         return -1;
 
@@ -1394,12 +2376,13 @@ SaveTGA_RW(SDL_Surface *surface, SDL_RWops *out, int rle)
         }
     }
 
-    if (rle) {
-        rlebuf = malloc(bpp * surface->w + 1 + surface->w / TGA_RLE_MAX);
-        if (!rlebuf) {
-            SDL_SetError("out of memory");
-            goto error;
-        }
+    /* room for a band of rows, each at worst one header byte longer per
+       TGA_RLE_MAX pixels when run length encoded */
+    rowmax = bpp * surface->w + 1 + surface->w / TGA_RLE_MAX;
+    chunk = malloc((size_t)rowmax * band);
+    if (!chunk) {
+        SDL_SetError("out of memory");
+        goto error;
     }
 
     /* Temporarily remove colourkey and alpha from surface so copies are
@@ -1410,22 +2393,25 @@ SaveTGA_RW(SDL_Surface *surface, SDL_RWops *out, int rle)
 
     r.x = 0;
     r.w = surface->w;
-    r.h = 1;
-    for (r.y = 0; r.y < surface->h; r.y++) {
-        int n;
-        void *buf;
-        if (SDL_BlitSurface(surface, &r, linebuf, NULL) < 0)
+    for (r.y = 0; r.y < surface->h && !result; r.y += band) {
+        int y, n = 0;
+        r.h = MIN(band, surface->h - r.y);
+        if (SDL_BlitSurface(surface, &r, linebuf, NULL) < 0) {
+            result = -1;
             break;
-        if (rle) {
-            buf = rlebuf;
-            n = rle_line(linebuf->pixels, rlebuf, surface->w, bpp);
         }
-        else {
-            buf = linebuf->pixels;
-            n = surface->w * bpp;
+        for (y = 0; y < r.h; y++) {
+            Uint8 *row = (Uint8 *)linebuf->pixels + y * linebuf->pitch;
+            if (rle) {
+                n += rle_line(row, chunk + n, surface->w, bpp);
+            }
+            else {
+                memcpy(chunk + n, row, (size_t)surface->w * bpp);
+                n += surface->w * bpp;
+            }
         }
-        if (!SDL_RWwrite(out, buf, n, 1))
-            break;
+        if (!SDL_RWwrite(out, chunk, n, 1))
+            result = -1;
     }
 
     /* restore flags */
@@ -1433,16 +2419,234 @@ SaveTGA_RW(SDL_Surface *surface, SDL_RWops *out, int rle)
     if (have_surf_colorkey)
         SDL_SetColorKey(surface, SDL_TRUE, surf_colorkey);
 
-    free(rlebuf);
+    free(chunk);
     SDL_FreeSurface(linebuf);
-    return 0;
+    return result;
 
 error:
-    free(rlebuf);
+    free(chunk);
     SDL_FreeSurface(linebuf);
     return -1;
 }
 
+/* Whether LoadTGA_RW reads images with this header: colormapped,
+ * truecolor or grayscale images, raw or run length encoded, of 8 bit
+ * indices into 24 or 32 bit colormaps, 24 or 32 bit pixels, or 8 bit gray
+ * levels, stored from the left.
+ */
+static int
+tga_supported(struct TGAheader *h)
+{
+    if ((h->flags & TGA_INTERLEAVE_MASK) != TGA_INTERLEAVE_NONE ||
+        (h->flags & TGA_ORIGIN_RIGHT)) {
+        return 0;
+    }
+    switch (h->type & ~TGA_TYPE_RLE) {
+        case TGA_TYPE_INDEXED:
+            return h->has_cmap == 1 && h->pixel_bits == 8 &&
+                   LE16(h->cmap_start) == 0 && LE16(h->cmap_len) <= 256 &&
+                   (h->cmap_bits == 24 || h->cmap_bits == 32);
+        case TGA_TYPE_RGB:
+            return !h->has_cmap &&
+                   (h->pixel_bits == 24 || h->pixel_bits == 32);
+        case TGA_TYPE_BW:
+            return !h->has_cmap && h->pixel_bits == 8;
+    }
+    return 0;
+}
+
+/* Read the rest of src into memory, in one read when its size is known */
+static Uint8 *
+tga_read_rest(SDL_RWops *src, size_t *size)
+{
+    Sint64 total = SDL_RWsize(src), pos = SDL_RWtell(src);
+    /* one byte spare, to see the end without growing the buffer */
+    size_t cap = (total > 0 && pos >= 0 && total >= pos)
+                     ? (size_t)(total - pos) + 1
+                     : TGA_CHUNK;
+    size_t used = 0, got;
+    Uint8 *buf = malloc(cap), *grown;
+
+    while (buf) {
+        got = SDL_RWread(src, buf + used, 1, cap - used);
+        used += got;
+        if (used < cap) {
+            *size = used;
+            return buf;
+        }
+        cap *= 2;
+        grown = realloc(buf, cap);
+        if (!grown)
+            free(buf);
+        buf = grown;
+    }
+    SDL_OutOfMemory();
+    return NULL;
+}
+
+/*
+ * Load a TGA image, decoding the rows of the whole file in memory.
+ * Returns NULL with *supported cleared, after seeking src back to where
+ * the image starts, for the variants tga_supported() rejects.
+ */
+static SDL_Surface *
+LoadTGA_RW(SDL_RWops *src, int *supported)
+{
+    struct TGAheader h;
+    Sint64 start = SDL_RWtell(src);
+    SDL_Surface *surf = NULL;
+    Uint8 *data = NULL, *p, *end;
+    size_t size;
+    int w, height, bpp, upper, rle, x, y, i;
+    Uint32 rmask, gmask, bmask, amask;
+
+    *supported = 1;
+    if (!SDL_RWread(src, &h, sizeof(h), 1)) {
+        SDL_SetError("could not read the TGA header");
+        return NULL;
+    }
+    if (!tga_supported(&h)) {
+        *supported = 0;
+        SDL_SetError("unsupported TGA image");
+        if (start >= 0)
+            SDL_RWseek(src, start, RW_SEEK_SET);
+        return NULL;
+    }
+    w = LE16(h.width);
+    height = LE16(h.height);
+    bpp = h.pixel_bits >> 3;
+    upper = h.flags & TGA_ORIGIN_UPPER;
+    rle = h.type & TGA_TYPE_RLE;
+    if (!w || !height) {
+        SDL_SetError("TGA image has no pixels");
+        return NULL;
+    }
+
+    data = tga_read_rest(src, &size);
+    if (!data)
+        return NULL;
+    p = data + h.infolen;
+    end = data + size;
+
+    if (bpp == 1) {
+        surf = SDL_CreateRGBSurface(SDL_SWSURFACE, w, height, 8, 0, 0, 0, 0);
+    }
+    else {
+        /* the same layout as SaveTGA_RW writes from */
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+        int s = bpp == 4 ? 0 : 8;
+        amask = bpp == 4 ? 0x000000ff : 0;
+        rmask = 0x0000ff00 >> s;
+        gmask = 0x00ff0000 >> s;
+        bmask = 0xff000000 >> s;
+#else  /* SDL_BYTEORDER != SDL_BIG_ENDIAN */
+        amask = bpp == 4 ? 0xff000000 : 0;
+        rmask = 0x00ff0000;
+        gmask = 0x0000ff00;
+        bmask = 0x000000ff;
+#endif /* SDL_BYTEORDER != SDL_BIG_ENDIAN */
+        surf = SDL_CreateRGBSurface(SDL_SWSURFACE, w, height, h.pixel_bits,
+                                    rmask, gmask, bmask, amask);
+    }
+    if (!surf)
+        goto error;
+
+    if (h.has_cmap) {
+        SDL_Color colors[256];
+        int ncolors = LE16(h.cmap_len), entry = h.cmap_bits >> 3;
+        int colorkey = -1;
+        if (p + ncolors * entry > end)
+            goto truncated;
+        for (i = 0; i < ncolors; i++, p += entry) {
+            colors[i].b = p[0];
+            colors[i].g = p[1];
+            colors[i].r = p[2];
+            colors[i].a = 0xff;
+            /* SaveTGA_RW marks the colorkey as the transparent entry */
+            if (entry == 4 && !p[3] && colorkey < 0)
+                colorkey = i;
+        }
+        if (SDL_SetPaletteColors(surf->format->palette, colors, 0, ncolors))
+            goto error;
+        if (colorkey >= 0)
+            SDL_SetColorKey(surf, SDL_TRUE, colorkey);
+    }
+    else if (bpp == 1) {
+        SDL_Color grays[256];
+        for (i = 0; i < 256; i++) {
+            grays[i].r = grays[i].g = grays[i].b = (Uint8)i;
+            grays[i].a = 0xff;
+        }
+        if (SDL_SetPaletteColors(surf->format->palette, grays, 0, 256))
+            goto error;
+    }
+
+#define TGA_ROW(y)                 \
+    ((Uint8 *)surf->pixels +       \
+     (upper ? (y) : height - 1 - (y)) * surf->pitch)
+
+    if (!rle) {
+        if ((size_t)(end - p) < (size_t)w * height * bpp)
+            goto truncated;
+        for (y = 0; y < height; y++, p += w * bpp)
+            memcpy(TGA_ROW(y), p, (size_t)w * bpp);
+    }
+    else {
+        /* packets may run on from one row to the next */
+        x = y = 0;
+        while (y < height) {
+            int n, k, run;
+            if (p >= end)
+                goto truncated;
+            n = (*p & 0x7f) + 1;
+            run = *p++ & 0x80;
+            if ((size_t)(end - p) < (size_t)(run ? 1 : n) * bpp)
+                goto truncated;
+            while (n && y < height) {
+                Uint8 *dst = TGA_ROW(y) + x * bpp;
+                k = MIN(n, w - x);
+                if (!run) {
+                    memcpy(dst, p, (size_t)k * bpp);
+                    p += k * bpp;
+                }
+                else if (bpp == 1) {
+                    memset(dst, *p, k);
+                }
+                else if (bpp == 4) {
+                    Uint32 pix;
+                    memcpy(&pix, p, 4);
+                    for (i = 0; i < k; i++)
+                        memcpy(dst + i * 4, &pix, 4);
+                }
+                else {
+                    for (i = 0; i < k; i++)
+                        memcpy(dst + i * bpp, p, bpp);
+                }
+                n -= k;
+                x += k;
+                if (x == w) {
+                    x = 0;
+                    y++;
+                }
+            }
+            if (run)
+                p += bpp;
+        }
+    }
+#undef TGA_ROW
+
+    free(data);
+    return surf;
+
+truncated:
+    SDL_SetError("TGA image is truncated");
+error:
+    free(data);
+    if (surf)
+        SDL_FreeSurface(surf);
+    return NULL;
+}
+
 static int
 SaveTGA(SDL_Surface *surface, const char *file, int rle)
 {
@@ -1461,10 +2665,26 @@ static PyMethodDef _image_methods[] = {
     {"load_extended", image_load_extended, METH_VARARGS,
      DOC_PYGAMEIMAGELOADEXTENDED},
     {"load", image_load, METH_VARARGS, DOC_PYGAMEIMAGELOAD},
-
-    {"save_extended", image_save_extended, METH_VARARGS,
-     DOC_PYGAMEIMAGESAVEEXTENDED},
-    {"save", image_save, METH_VARARGS, DOC_PYGAMEIMAGESAVE},
+    {"load_many", (PyCFunction)image_load_many, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEIMAGELOADMANY},
+    {"load_region", image_load_region, METH_VARARGS,
+     DOC_PYGAMEIMAGELOADREGION},
+    {"iter_bands", image_iter_bands, METH_VARARGS, DOC_PYGAMEIMAGEITERBANDS},
+
+    {"save_extended", (PyCFunction)image_save_extended,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEIMAGESAVEEXTENDED},
+    {"save", (PyCFunction)image_save, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEIMAGESAVE},
+    {"save_async", (PyCFunction)image_save_async,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEIMAGESAVEASYNC},
+    {"wait_saves", image_wait_saves, METH_NOARGS, DOC_PYGAMEIMAGEWAITSAVES},
+    {"load_raw", image_load_raw, METH_O, DOC_PYGAMEIMAGELOADRAW},
+    {"save_raw", image_save_raw, METH_VARARGS, DOC_PYGAMEIMAGESAVERAW},
+    {"raw_size", image_raw_size, METH_O, DOC_PYGAMEIMAGERAWSIZE},
+    {"tobuffer_raw", image_tobuffer_raw, METH_VARARGS,
+     DOC_PYGAMEIMAGETOBUFFERRAW},
+    {"frombuffer_raw", image_frombuffer_raw, METH_O,
+     DOC_PYGAMEIMAGEFROMBUFFERRAW},
     {"get_extended", (PyCFunction)image_get_extended, METH_NOARGS,
      DOC_PYGAMEIMAGEGETEXTENDED},
     {"get_sdl_image_version", (PyCFunction)image_get_sdl_image_version,
@@ -1475,20 +2695,68 @@ static PyMethodDef _image_methods[] = {
     {"frombuffer", image_frombuffer, METH_VARARGS, DOC_PYGAMEIMAGEFROMBUFFER},
     {NULL, NULL, 0, NULL}};
 
+#ifndef PYPY_VERSION
+static int
+image_traverse(PyObject *mod, visitproc visit, void *arg)
+{
+    _ImageState *state = IMAGE_MOD_STATE(mod);
+
+    Py_VISIT(state->extload);
+    Py_VISIT(state->extloadmany);
+    Py_VISIT(state->extloadregion);
+    Py_VISIT(state->extbands);
+    Py_VISIT(state->extsave);
+    Py_VISIT(state->extsaveasync);
+    Py_VISIT(state->extwait);
+    Py_VISIT(state->extver);
+    return 0;
+}
+#endif /* PYPY_VERSION */
+
+static int
+image_clear(PyObject *mod)
+{
+    _ImageState *state = IMAGE_MOD_STATE(mod);
+
+    Py_CLEAR(state->extload);
+    Py_CLEAR(state->extloadmany);
+    Py_CLEAR(state->extloadregion);
+    Py_CLEAR(state->extbands);
+    Py_CLEAR(state->extsave);
+    Py_CLEAR(state->extsaveasync);
+    Py_CLEAR(state->extwait);
+    Py_CLEAR(state->extver);
+    return 0;
+}
+
 MODINIT_DEFINE(image)
 {
     PyObject *module;
     PyObject *extmodule;
+    _ImageState *state;
 
+#ifndef PYPY_VERSION
     static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
                                          "image",
                                          DOC_PYGAMEIMAGE,
-                                         -1,
+                                         sizeof(_ImageState),
                                          _image_methods,
                                          NULL,
-                                         NULL,
-                                         NULL,
+                                         image_traverse,
+                                         image_clear,
                                          NULL};
+#else  /* PYPY_VERSION */
+    static struct PyModuleDef _module = {
+        PyModuleDef_HEAD_INIT,
+        "image",
+        DOC_PYGAMEIMAGE,
+        -1, /* PyModule_GetState() not implemented */
+        _image_methods,
+        NULL,
+        NULL,
+        NULL,
+        NULL};
+#endif /* PYPY_VERSION */
 
     /* imported needed apis; Do this first so if there is an error
        the module is not loaded.
@@ -1511,21 +2779,47 @@ MODINIT_DEFINE(image)
     if (module == NULL) {
         return NULL;
     }
+    state = IMAGE_MOD_STATE(module);
 
     /* try to get extended formats */
     extmodule = PyImport_ImportModule(IMPPREFIX "imageext");
     if (extmodule) {
-        extloadobj = PyObject_GetAttrString(extmodule, "load_extended");
-        if (!extloadobj) {
+        state->extload = PyObject_GetAttrString(extmodule, "load_extended");
+        if (!state->extload) {
+            goto error;
+        }
+        state->extloadmany =
+            PyObject_GetAttrString(extmodule, "load_many_extended");
+        if (!state->extloadmany) {
+            goto error;
+        }
+        state->extloadregion =
+            PyObject_GetAttrString(extmodule, "load_region_extended");
+        if (!state->extloadregion) {
+            goto error;
+        }
+        state->extbands =
+            PyObject_GetAttrString(extmodule, "iter_bands_extended");
+        if (!state->extbands) {
+            goto error;
+        }
+        state->extsave = PyObject_GetAttrString(extmodule, "save_extended");
+        if (!state->extsave) {
+            goto error;
+        }
+        state->extsaveasync =
+            PyObject_GetAttrString(extmodule, "save_async_extended");
+        if (!state->extsaveasync) {
             goto error;
         }
-        extsaveobj = PyObject_GetAttrString(extmodule, "save_extended");
-        if (!extsaveobj) {
+        state->extwait =
+            PyObject_GetAttrString(extmodule, "wait_saves_extended");
+        if (!state->extwait) {
             goto error;
         }
-        extverobj =
+        state->extver =
             PyObject_GetAttrString(extmodule, "_get_sdl_image_version");
-        if (!extverobj) {
+        if (!state->extver) {
             goto error;
         }
         Py_DECREF(extmodule);
@@ -1537,9 +2831,7 @@ MODINIT_DEFINE(image)
     return module;
 
 error:
-    Py_XDECREF(extloadobj);
-    Py_XDECREF(extsaveobj);
-    Py_XDECREF(extverobj);
+    image_clear(module);
     Py_DECREF(extmodule);
     Py_DECREF(module);
     return NULL;
@@ -145,6 +145,105 @@ image_load_ext(PyObject *self, PyObject *arg)
     return final;
 }
 
+/* SDL_image <= 2.0.4 can not decode on several threads at once */
+#define PG_IMG_PARALLEL                                           \
+    (SDL_VERSIONNUM(SDL_IMAGE_MAJOR_VERSION, SDL_IMAGE_MINOR_VERSION, \
+                    SDL_IMAGE_PATCHLEVEL) > SDL_VERSIONNUM(2, 0, 4))
+
+typedef struct {
+    SDL_RWops *rw;
+    char *ext;
+    SDL_Surface *surf;
+    char error[128];
+} LoadJob;
+
+static void
+load_many_job(void *data, int index, int count)
+{
+    LoadJob *job = (LoadJob *)data + index;
+
+    /* RWops of file-like objects take the GIL for themselves */
+    job->surf = IMG_LoadTyped_RW(job->rw, 1, job->ext);
+    job->rw = NULL;
+    if (!job->surf)
+        SDL_strlcpy(job->error, IMG_GetError(), sizeof(job->error));
+}
+
+static PyObject *
+image_load_many_ext(PyObject *self, PyObject *arg)
+{
+    PyObject *files, *seq, *surfobj, *list = NULL;
+    LoadJob *jobs;
+    Py_ssize_t count, i;
+
+    if (!PyArg_ParseTuple(arg, "O", &files)) {
+        return NULL;
+    }
+    seq = PySequence_Fast(files, "files must be a sequence");
+    if (seq == NULL) {
+        return NULL;
+    }
+    count = PySequence_Fast_GET_SIZE(seq);
+    if (count > INT_MAX) {
+        Py_DECREF(seq);
+        return RAISE(PyExc_ValueError, "too many files");
+    }
+    jobs = (LoadJob *)PyMem_Calloc(count ? count : 1, sizeof(LoadJob));
+    if (jobs == NULL) {
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+
+    for (i = 0; i < count; i++) {
+        jobs[i].rw = pgRWops_FromObject(PySequence_Fast_GET_ITEM(seq, i));
+        if (jobs[i].rw == NULL) /* stop on NULL, error already set */
+            goto end;
+        jobs[i].ext = pgRWops_GetFileExtension(jobs[i].rw);
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    if (count > 1 && PG_IMG_PARALLEL) {
+        pg_ParallelFor(load_many_job, jobs, (int)count);
+    }
+    else {
+        for (i = 0; i < count; i++) {
+            load_many_job(jobs, (int)i, (int)count);
+        }
+    }
+    Py_END_ALLOW_THREADS;
+
+    for (i = 0; i < count; i++) {
+        if (jobs[i].surf == NULL) {
+            PyErr_SetString(pgExc_SDLError, jobs[i].error);
+            goto end;
+        }
+    }
+
+    list = PyList_New(count);
+    if (list == NULL)
+        goto end;
+    for (i = 0; i < count; i++) {
+        surfobj = (PyObject *)pgSurface_New(jobs[i].surf);
+        if (surfobj == NULL) {
+            Py_CLEAR(list);
+            goto end;
+        }
+        jobs[i].surf = NULL;
+        PyList_SET_ITEM(list, i, surfobj);
+    }
+
+end:
+    for (i = 0; i < count; i++) {
+        if (jobs[i].rw)
+            SDL_RWclose(jobs[i].rw);
+        if (jobs[i].surf)
+            SDL_FreeSurface(jobs[i].surf);
+    }
+    PyMem_Free(jobs);
+    Py_DECREF(seq);
+    return list;
+}
+
 #ifdef PNG_H
 
 static void
@@ -170,7 +269,8 @@ png_flush_fn(png_structp png_ptr)
 
 static int
 write_png(const char *file_name, SDL_RWops *rw, png_bytep *rows,
-          SDL_Palette *palette, int w, int h, int colortype, int bitdepth)
+          SDL_Palette *palette, int w, int h, int colortype, int bitdepth,
+          int compression, int filters)
 {
     png_structp png_ptr = NULL;
     png_infop info_ptr = NULL;
@@ -202,6 +302,12 @@ write_png(const char *file_name, SDL_RWops *rw, png_bytep *rows,
     /* doing = "init IO"; */
     png_set_write_fn(png_ptr, rwops, png_write_fn, png_flush_fn);
 
+    /* -1 keeps the libpng defaults */
+    if (compression >= 0)
+        png_set_compression_level(png_ptr, compression);
+    if (filters >= 0)
+        png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, filters);
+
     /* doing = "write header"; */
     png_set_IHDR(png_ptr, info_ptr, w, h, bitdepth, colortype,
                  PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE,
@@ -256,11 +362,12 @@ fail:
 }
 
 static int
-SavePNG(SDL_Surface *surface, const char *file, SDL_RWops *rw)
+SavePNG(SDL_Surface *surface, const char *file, SDL_RWops *rw,
+        int compression, int filters)
 {
-    static unsigned char **ss_rows;
-    static int ss_size;
-    static int ss_w, ss_h;
+    unsigned char **ss_rows;
+    int ss_size;
+    int ss_w, ss_h;
     SDL_Surface *ss_surface;
     SDL_Rect ss_rect;
     int r, i;
@@ -342,15 +449,15 @@ SavePNG(SDL_Surface *surface, const char *file, SDL_RWops *rw)
 
     if (palette) {
         r = write_png(file, rw, ss_rows, palette, surface->w, surface->h,
-                      PNG_COLOR_TYPE_PALETTE, 8);
+                      PNG_COLOR_TYPE_PALETTE, 8, compression, filters);
     }
     else if (alpha) {
         r = write_png(file, rw, ss_rows, NULL, surface->w, surface->h,
-                      PNG_COLOR_TYPE_RGB_ALPHA, 8);
+                      PNG_COLOR_TYPE_RGB_ALPHA, 8, compression, filters);
     }
     else {
         r = write_png(file, rw, ss_rows, NULL, surface->w, surface->h,
-                      PNG_COLOR_TYPE_RGB, 8);
+                      PNG_COLOR_TYPE_RGB, 8, compression, filters);
     }
 
     free(ss_rows);
@@ -361,8 +468,73 @@ SavePNG(SDL_Surface *surface, const char *file, SDL_RWops *rw)
 
 #endif /* end if PNG_H */
 
+#ifdef PNG_H
+/* libpng row filters by name */
+static const struct {
+    const char *name;
+    int filters;
+} png_filter_names[] = {
+    {"none", PNG_FILTER_NONE},   {"sub", PNG_FILTER_SUB},
+    {"up", PNG_FILTER_UP},       {"average", PNG_FILTER_AVG},
+    {"paeth", PNG_FILTER_PAETH}, {"all", PNG_ALL_FILTERS},
+};
+#endif /* PNG_H */
+
+/* Parse the arguments of save_extended and save_async_extended. filters
+ * and compression are -1 for the libpng defaults. Returns 0 on failure
+ * with an exception set.
+ */
+static int
+_parse_save_args(PyObject *args, PyObject *kwargs, pgSurfaceObject **surfobj,
+                 PyObject **obj, char **namehint, int *compression,
+                 int *filters)
+{
+    PyObject *filterobj = Py_None;
+    const char *filtername;
+    static char *keywords[] = {"surface", "file",   "namehint",
+                               "compression", "filter", NULL};
+
+    *namehint = NULL;
+    *compression = -1;
+    *filters = -1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|siO", keywords,
+                                     &pgSurface_Type, surfobj, obj, namehint,
+                                     compression, &filterobj)) {
+        return 0;
+    }
+    if (*compression < -1 || *compression > 9) {
+        PyErr_SetString(PyExc_ValueError,
+                        "compression must be from 0 to 9, or -1");
+        return 0;
+    }
+    if (filterobj == Py_None) {
+        return 1;
+    }
+    filtername = PyUnicode_Check(filterobj) ? PyUnicode_AsUTF8(filterobj)
+                                            : NULL;
+    if (filtername == NULL) {
+        if (!PyErr_Occurred())
+            PyErr_SetString(PyExc_TypeError, "filter must be a str or None");
+        return 0;
+    }
+#ifdef PNG_H
+    {
+        size_t i;
+
+        for (i = 0; i < SDL_arraysize(png_filter_names); i++) {
+            if (!strcmp(filtername, png_filter_names[i].name)) {
+                *filters = png_filter_names[i].filters;
+                return 1;
+            }
+        }
+    }
+#endif /* PNG_H */
+    PyErr_Format(PyExc_ValueError, "unknown PNG filter '%s'", filtername);
+    return 0;
+}
+
 static PyObject *
-image_save_ext(PyObject *self, PyObject *arg)
+image_save_ext(PyObject *self, PyObject *arg, PyObject *kwargs)
 {
     pgSurfaceObject *surfobj;
     PyObject *obj;
@@ -372,9 +544,10 @@ image_save_ext(PyObject *self, PyObject *arg)
     int result = 1;
     char *name = NULL;
     SDL_RWops *rw = NULL;
+    int compression, filters;
 
-    if (!PyArg_ParseTuple(arg, "O!O|s", &pgSurface_Type, &surfobj, &obj,
-                          &namehint)) {
+    if (!_parse_save_args(arg, kwargs, &surfobj, &obj, &namehint,
+                          &compression, &filters)) {
         return NULL;
     }
 
@@ -405,7 +578,12 @@ image_save_ext(PyObject *self, PyObject *arg)
     if (result > 0) {
         char *ext = iext_find_extension(name);
         if (!strcasecmp(ext, "jpeg") || !strcasecmp(ext, "jpg")) {
-            if (rw != NULL) {
+            if (compression != -1 || filters != -1) {
+                PyErr_SetString(PyExc_ValueError,
+                                "compression and filter only apply to PNG");
+                result = -2;
+            }
+            else if (rw != NULL) {
                 result = IMG_SaveJPG_RW(surf, rw, 0, JPEG_QUALITY);
             }
             else {
@@ -414,9 +592,10 @@ image_save_ext(PyObject *self, PyObject *arg)
         }
         else if (!strcasecmp(ext, "png")) {
 #ifdef PNG_H
-            /*Py_BEGIN_ALLOW_THREADS; */
-            result = SavePNG(surf, name, rw);
-            /*Py_END_ALLOW_THREADS; */
+            /* RWops of file-like objects take the GIL for themselves */
+            Py_BEGIN_ALLOW_THREADS;
+            result = SavePNG(surf, name, rw, compression, filters);
+            Py_END_ALLOW_THREADS;
 #else
             PyErr_SetString(pgExc_SDLError, "No support for png compiled in.");
             result = -2;
@@ -442,6 +621,628 @@ image_save_ext(PyObject *self, PyObject *arg)
     Py_RETURN_NONE;
 }
 
+/*
+ * Asynchronous saving: save_async_extended copies the surface and queues
+ * the copy for one writer thread, which saves the files in the order they
+ * were queued while the game carries on.
+ */
+typedef struct pgSaveJob {
+    struct pgSaveJob *next;
+    SDL_Surface *surf;
+    char *name;
+    int jpeg;
+    int compression;
+    int filters;
+} pgSaveJob;
+
+static SDL_mutex *_pg_save_lock = NULL;
+static SDL_cond *_pg_save_wake = NULL; /* a job was queued, or quitting */
+static SDL_cond *_pg_save_idle = NULL; /* the last pending job finished */
+static SDL_Thread *_pg_save_thread = NULL;
+static pgSaveJob *_pg_save_head = NULL;
+static pgSaveJob **_pg_save_tail = &_pg_save_head;
+static int _pg_save_pending = 0; /* jobs queued or being written */
+static int _pg_save_quit = 0;
+static char _pg_save_error[256]; /* the first failure since the last wait */
+
+static void
+_pg_save_job_free(pgSaveJob *job)
+{
+    if (job->surf)
+        SDL_FreeSurface(job->surf);
+    SDL_free(job->name);
+    SDL_free(job);
+}
+
+static int SDLCALL
+_pg_save_worker(void *unused)
+{
+    pgSaveJob *job;
+    int result;
+
+    SDL_LockMutex(_pg_save_lock);
+    for (;;) {
+        while (!_pg_save_head && !_pg_save_quit)
+            SDL_CondWait(_pg_save_wake, _pg_save_lock);
+        /* the queue is written out before quitting */
+        job = _pg_save_head;
+        if (!job)
+            break;
+        _pg_save_head = job->next;
+        if (!_pg_save_head)
+            _pg_save_tail = &_pg_save_head;
+        SDL_UnlockMutex(_pg_save_lock);
+
+#ifdef PNG_H
+        if (!job->jpeg)
+            result = SavePNG(job->surf, job->name, NULL, job->compression,
+                             job->filters);
+        else
+#endif /* PNG_H */
+            result = IMG_SaveJPG(job->surf, job->name, JPEG_QUALITY);
+
+        SDL_LockMutex(_pg_save_lock);
+        if (result && !_pg_save_error[0])
+            SDL_snprintf(_pg_save_error, sizeof(_pg_save_error), "%s: %s",
+                         job->name, SDL_GetError());
+        _pg_save_job_free(job);
+        if (--_pg_save_pending == 0)
+            SDL_CondBroadcast(_pg_save_idle);
+    }
+    SDL_UnlockMutex(_pg_save_lock);
+    return 0;
+}
+
+/* Finish the queued saves at exit, so no file is left half written */
+static void
+_pg_save_shutdown(void)
+{
+    if (!_pg_save_thread)
+        return;
+    SDL_LockMutex(_pg_save_lock);
+    _pg_save_quit = 1;
+    SDL_CondSignal(_pg_save_wake);
+    SDL_UnlockMutex(_pg_save_lock);
+    SDL_WaitThread(_pg_save_thread, NULL);
+    _pg_save_thread = NULL;
+}
+
+static int
+_pg_save_start(void)
+{
+    if (!_pg_save_lock) {
+        _pg_save_lock = SDL_CreateMutex();
+        _pg_save_wake = SDL_CreateCond();
+        _pg_save_idle = SDL_CreateCond();
+        if (!_pg_save_lock || !_pg_save_wake || !_pg_save_idle)
+            return -1;
+    }
+    if (!_pg_save_thread) {
+        _pg_save_thread =
+            SDL_CreateThread(_pg_save_worker, "pygame_image_save", NULL);
+        if (!_pg_save_thread)
+            return -1;
+        Py_AtExit(_pg_save_shutdown);
+    }
+    return 0;
+}
+
+static PyObject *
+image_save_async_ext(PyObject *self, PyObject *arg, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *obj, *oencoded;
+    SDL_Surface *surf;
+    pgSaveJob *job;
+    char *namehint, *ext;
+    int compression, filters, jpeg;
+
+    if (!_parse_save_args(arg, kwargs, &surfobj, &obj, &namehint,
+                          &compression, &filters)) {
+        return NULL;
+    }
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+
+    oencoded = pg_EncodeString(obj, "UTF-8", NULL, pgExc_SDLError);
+    if (oencoded == NULL)
+        return NULL;
+    if (oencoded == Py_None) {
+        Py_DECREF(oencoded);
+        return RAISE(PyExc_TypeError, "save_async needs a file name");
+    }
+
+    ext = iext_find_extension(namehint ? namehint
+                                       : PyBytes_AS_STRING(oencoded));
+    jpeg = !strcasecmp(ext, "jpeg") || !strcasecmp(ext, "jpg");
+    if (!jpeg && strcasecmp(ext, "png")) {
+        Py_DECREF(oencoded);
+        return RAISE(PyExc_ValueError,
+                     "save_async only writes PNG and JPEG files");
+    }
+    if (jpeg && (compression != -1 || filters != -1)) {
+        Py_DECREF(oencoded);
+        return RAISE(PyExc_ValueError,
+                     "compression and filter only apply to PNG");
+    }
+#ifndef PNG_H
+    if (!jpeg) {
+        Py_DECREF(oencoded);
+        return RAISE(pgExc_SDLError, "No support for png compiled in.");
+    }
+#endif /* ~PNG_H */
+
+    job = (pgSaveJob *)SDL_calloc(1, sizeof(pgSaveJob));
+    if (!job) {
+        Py_DECREF(oencoded);
+        return PyErr_NoMemory();
+    }
+    job->name = SDL_strdup(PyBytes_AS_STRING(oencoded));
+    Py_DECREF(oencoded);
+    job->jpeg = jpeg;
+    job->compression = compression;
+    job->filters = filters;
+    if (!job->name) {
+        _pg_save_job_free(job);
+        return PyErr_NoMemory();
+    }
+
+    /* the snapshot, so the surface can be drawn on again right away */
+    pgSurface_Prep(surfobj);
+    job->surf = SDL_ConvertSurface(surf, surf->format, 0);
+    pgSurface_Unprep(surfobj);
+    if (!job->surf || _pg_save_start()) {
+        _pg_save_job_free(job);
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+
+    SDL_LockMutex(_pg_save_lock);
+    *_pg_save_tail = job;
+    _pg_save_tail = &job->next;
+    _pg_save_pending++;
+    SDL_CondSignal(_pg_save_wake);
+    SDL_UnlockMutex(_pg_save_lock);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+image_wait_saves_ext(PyObject *self, PyObject *_null)
+{
+    char error[sizeof(_pg_save_error)];
+
+    if (!_pg_save_lock)
+        Py_RETURN_NONE;
+
+    Py_BEGIN_ALLOW_THREADS;
+    SDL_LockMutex(_pg_save_lock);
+    while (_pg_save_pending)
+        SDL_CondWait(_pg_save_idle, _pg_save_lock);
+    SDL_strlcpy(error, _pg_save_error, sizeof(error));
+    _pg_save_error[0] = '\0';
+    SDL_UnlockMutex(_pg_save_lock);
+    Py_END_ALLOW_THREADS;
+
+    if (error[0])
+        return RAISE(pgExc_SDLError, error);
+    Py_RETURN_NONE;
+}
+
+/* Copy an area of a decoded image into a new surface of the same format,
+ * for images that cannot be decoded a few rows at a time.
+ */
+static SDL_Surface *
+_copy_area(SDL_Surface *src, SDL_Rect *area)
+{
+    SDL_PixelFormat *fmt = src->format;
+    SDL_Surface *copy;
+    Uint32 colorkey;
+    int y;
+
+    copy = SDL_CreateRGBSurface(0, area->w, area->h, fmt->BitsPerPixel,
+                                fmt->Rmask, fmt->Gmask, fmt->Bmask,
+                                fmt->Amask);
+    if (!copy)
+        return NULL;
+    if (fmt->palette && SDL_SetSurfacePalette(copy, fmt->palette)) {
+        SDL_FreeSurface(copy);
+        return NULL;
+    }
+    for (y = 0; y < area->h; y++) {
+        memcpy((Uint8 *)copy->pixels + y * copy->pitch,
+               (Uint8 *)src->pixels + (area->y + y) * src->pitch +
+                   area->x * fmt->BytesPerPixel,
+               (size_t)area->w * fmt->BytesPerPixel);
+    }
+    if (SDL_GetColorKey(src, &colorkey) == 0)
+        SDL_SetColorKey(copy, SDL_TRUE, colorkey);
+    return copy;
+}
+
+#ifdef PNG_H
+/*
+ * Streaming PNG decoding: rows are read one at a time into a row buffer
+ * and only the columns wanted are kept, so a region or a band of a huge
+ * image needs memory for the region, not the whole image. Rows are always
+ * expanded to 8 bit RGB, or RGBA when the image has alpha.
+ */
+typedef struct {
+    png_structp png_ptr;
+    png_infop info_ptr;
+    png_bytep rowbuf;
+    int width;
+    int height;
+    int channels;
+} pgPNGReader;
+
+static void
+png_read_fn(png_structp png_ptr, png_bytep data, png_size_t length)
+{
+    SDL_RWops *rwops = (SDL_RWops *)png_get_io_ptr(png_ptr);
+    if (SDL_RWread(rwops, data, 1, length) != length) {
+        png_error(png_ptr, "Error while reading the PNG file (SDL_RWread)");
+    }
+}
+
+static void
+png_reader_error_fn(png_structp png_ptr, png_const_charp message)
+{
+    SDL_SetError("%s", message);
+    png_longjmp(png_ptr, 1);
+}
+
+static void
+png_reader_warning_fn(png_structp png_ptr, png_const_charp message)
+{
+}
+
+static void
+png_reader_close(pgPNGReader *reader)
+{
+    if (reader->png_ptr)
+        png_destroy_read_struct(&reader->png_ptr, &reader->info_ptr, NULL);
+    free(reader->rowbuf);
+    reader->rowbuf = NULL;
+}
+
+/* Start reading the PNG image at the current position of rw. Returns 0
+ * when rows can be read, or -1 with the SDL error set. Returns 1 when rw
+ * does not hold a PNG image or holds an interlaced one, which cannot be
+ * read a row at a time, after seeking rw back to where it was.
+ */
+static int
+png_reader_open(pgPNGReader *reader, SDL_RWops *rw)
+{
+    png_byte signature[8];
+    Sint64 start = SDL_RWtell(rw);
+    int color_type;
+
+    memset(reader, 0, sizeof(pgPNGReader));
+    if (SDL_RWread(rw, signature, 1, 8) != 8 ||
+        png_sig_cmp(signature, 0, 8)) {
+        goto rewind;
+    }
+
+    reader->png_ptr =
+        png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL,
+                               png_reader_error_fn, png_reader_warning_fn);
+    if (reader->png_ptr)
+        reader->info_ptr = png_create_info_struct(reader->png_ptr);
+    if (!reader->info_ptr) {
+        png_reader_close(reader);
+        SDL_OutOfMemory();
+        return -1;
+    }
+    if (setjmp(png_jmpbuf(reader->png_ptr))) {
+        png_reader_close(reader);
+        return -1;
+    }
+
+    png_set_read_fn(reader->png_ptr, rw, png_read_fn);
+    png_set_sig_bytes(reader->png_ptr, 8);
+    png_read_info(reader->png_ptr, reader->info_ptr);
+    if (png_get_interlace_type(reader->png_ptr, reader->info_ptr) !=
+        PNG_INTERLACE_NONE) {
+        png_reader_close(reader);
+        goto rewind;
+    }
+
+    /* palettes to RGB, gray below 8 bits to 8 bits, tRNS chunks to alpha */
+    png_set_expand(reader->png_ptr);
+    png_set_strip_16(reader->png_ptr);
+    color_type = png_get_color_type(reader->png_ptr, reader->info_ptr);
+    if (!(color_type & PNG_COLOR_MASK_COLOR))
+        png_set_gray_to_rgb(reader->png_ptr);
+    png_read_update_info(reader->png_ptr, reader->info_ptr);
+
+    reader->width = (int)png_get_image_width(reader->png_ptr,
+                                             reader->info_ptr);
+    reader->height = (int)png_get_image_height(reader->png_ptr,
+                                               reader->info_ptr);
+    reader->channels = png_get_channels(reader->png_ptr, reader->info_ptr);
+    reader->rowbuf = (png_bytep)malloc(
+        png_get_rowbytes(reader->png_ptr, reader->info_ptr));
+    if (!reader->rowbuf) {
+        png_reader_close(reader);
+        SDL_OutOfMemory();
+        return -1;
+    }
+    return 0;
+
+rewind:
+    if (SDL_RWseek(rw, start, RW_SEEK_SET) < 0)
+        return -1;
+    return 1;
+}
+
+/* A surface for w by h pixels of the rows the reader gives */
+static SDL_Surface *
+png_reader_surface(pgPNGReader *reader, int w, int h)
+{
+    if (reader->channels == 4) {
+        return SDL_CreateRGBSurface(0, w, h, 32,
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+                                    0xFF, 0xFF << 8, 0xFF << 16, 0xFFu << 24);
+#else
+                                    0xFFu << 24, 0xFF << 16, 0xFF << 8, 0xFF);
+#endif
+    }
+    return SDL_CreateRGBSurface(0, w, h, 24,
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+                                0xFF, 0xFF << 8, 0xFF << 16, 0);
+#else
+                                0xFF << 16, 0xFF << 8, 0xFF, 0);
+#endif
+}
+
+/* Read count rows, copying the columns from x of each into the rows of dst
+ * from the top. The rows are skipped when dst is NULL. Returns -1 with the
+ * SDL error set on failure.
+ */
+static int
+png_reader_rows(pgPNGReader *reader, SDL_Surface *dst, int x, int count)
+{
+    int y;
+
+    if (setjmp(png_jmpbuf(reader->png_ptr)))
+        return -1;
+    for (y = 0; y < count; y++) {
+        png_read_row(reader->png_ptr, reader->rowbuf, NULL);
+        if (dst) {
+            memcpy((Uint8 *)dst->pixels + y * dst->pitch,
+                   reader->rowbuf + x * reader->channels,
+                   (size_t)dst->w * reader->channels);
+        }
+    }
+    return 0;
+}
+#endif /* PNG_H */
+
+static PyObject *
+image_load_region_ext(PyObject *self, PyObject *arg)
+{
+    PyObject *obj;
+    char *name = NULL, *ext;
+    SDL_Rect area;
+    SDL_RWops *rw;
+    SDL_Surface *surf = NULL, *full;
+    int result = 1, width = 0, height = 0;
+#ifdef PNG_H
+    pgPNGReader reader;
+#endif /* PNG_H */
+
+    if (!PyArg_ParseTuple(arg, "O(iiii)|s", &obj, &area.x, &area.y, &area.w,
+                          &area.h, &name)) {
+        return NULL;
+    }
+    if (area.x < 0 || area.y < 0 || area.w < 1 || area.h < 1) {
+        return RAISE(PyExc_ValueError,
+                     "region must be a nonempty area inside the image");
+    }
+
+    rw = pgRWops_FromObject(obj);
+    if (rw == NULL) /* stop on NULL, error already set */
+        return NULL;
+    ext = pgRWops_GetFileExtension(rw);
+    if (name) /* override extension with namehint if given */
+        ext = iext_find_extension(name);
+
+    /* RWops of file-like objects take the GIL for themselves */
+    Py_BEGIN_ALLOW_THREADS;
+#ifdef PNG_H
+    result = png_reader_open(&reader, rw);
+    if (result == 0) {
+        width = reader.width;
+        height = reader.height;
+        if (area.x + area.w <= width && area.y + area.h <= height) {
+            surf = png_reader_surface(&reader, area.w, area.h);
+            if (!surf || png_reader_rows(&reader, NULL, 0, area.y) ||
+                png_reader_rows(&reader, surf, area.x, area.h)) {
+                result = -1;
+            }
+        }
+        png_reader_close(&reader);
+    }
+#endif /* PNG_H */
+    if (result == 1) {
+        full = IMG_LoadTyped_RW(rw, 0, ext);
+        if (full) {
+            width = full->w;
+            height = full->h;
+            if (area.x + area.w <= width && area.y + area.h <= height) {
+                surf = _copy_area(full, &area);
+            }
+            SDL_FreeSurface(full);
+        }
+        result = surf ? 0 : -1;
+    }
+    SDL_RWclose(rw);
+    Py_END_ALLOW_THREADS;
+
+    if (!surf && width && (area.x + area.w > width ||
+                           area.y + area.h > height)) {
+        return PyErr_Format(PyExc_ValueError,
+                            "region is outside the %dx%d image", width,
+                            height);
+    }
+    if (result || !surf) {
+        if (surf)
+            SDL_FreeSurface(surf);
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    return (PyObject *)pgSurface_New(surf);
+}
+
+/*
+ * The iterator of iter_bands_extended: yields (y, Surface) for each band
+ * of rows, reading the next band of a PNG image only when asked for it.
+ * Other images are decoded whole and handed out a band at a time.
+ */
+typedef struct {
+    PyObject_HEAD SDL_RWops *rw;
+#ifdef PNG_H
+    pgPNGReader reader;
+#endif /* PNG_H */
+    SDL_Surface *full; /* the whole image when it cannot be streamed */
+    int band_height;
+    int width;
+    int height;
+    int y; /* the top of the next band */
+} pgBandIterObject;
+
+static void
+band_iter_close(pgBandIterObject *self)
+{
+#ifdef PNG_H
+    png_reader_close(&self->reader);
+#endif /* PNG_H */
+    if (self->rw) {
+        SDL_RWclose(self->rw);
+        self->rw = NULL;
+    }
+    if (self->full) {
+        SDL_FreeSurface(self->full);
+        self->full = NULL;
+    }
+}
+
+static void
+band_iter_dealloc(pgBandIterObject *self)
+{
+    band_iter_close(self);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+band_iter_next(pgBandIterObject *self)
+{
+    SDL_Surface *surf = NULL;
+    SDL_Rect area;
+    int top = self->y;
+
+    if (top >= self->height) {
+        band_iter_close(self);
+        return NULL;
+    }
+    area.x = 0;
+    area.y = top;
+    area.w = self->width;
+    area.h = self->height - top;
+    if (area.h > self->band_height)
+        area.h = self->band_height;
+
+    if (self->full) {
+        surf = _copy_area(self->full, &area);
+    }
+#ifdef PNG_H
+    else {
+        Py_BEGIN_ALLOW_THREADS;
+        surf = png_reader_surface(&self->reader, area.w, area.h);
+        if (surf && png_reader_rows(&self->reader, surf, 0, area.h)) {
+            SDL_FreeSurface(surf);
+            surf = NULL;
+        }
+        Py_END_ALLOW_THREADS;
+    }
+#endif /* PNG_H */
+    if (!surf) {
+        /* the rows read are lost, so the iterator cannot go on */
+        self->y = self->height;
+        band_iter_close(self);
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    self->y += area.h;
+    if (self->y >= self->height)
+        band_iter_close(self);
+    return Py_BuildValue("(iN)", top, pgSurface_New(surf));
+}
+
+static PyTypeObject pgBandIter_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.imageext.BandIterator",
+    .tp_basicsize = sizeof(pgBandIterObject),
+    .tp_dealloc = (destructor)band_iter_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_iter = PyObject_SelfIter,
+    .tp_iternext = (iternextfunc)band_iter_next,
+};
+
+static PyObject *
+image_iter_bands_ext(PyObject *self, PyObject *arg)
+{
+    PyObject *obj;
+    pgBandIterObject *iter;
+    char *name = NULL, *ext;
+    int band_height = 64, result = 1;
+
+    if (!PyArg_ParseTuple(arg, "O|is", &obj, &band_height, &name)) {
+        return NULL;
+    }
+    if (band_height < 1) {
+        return RAISE(PyExc_ValueError, "band_height must be positive");
+    }
+
+    iter = PyObject_New(pgBandIterObject, &pgBandIter_Type);
+    if (!iter)
+        return NULL;
+    memset((char *)iter + sizeof(PyObject), 0,
+           sizeof(pgBandIterObject) - sizeof(PyObject));
+    iter->band_height = band_height;
+
+    iter->rw = pgRWops_FromObject(obj);
+    if (iter->rw == NULL) { /* stop on NULL, error already set */
+        Py_DECREF(iter);
+        return NULL;
+    }
+    ext = pgRWops_GetFileExtension(iter->rw);
+    if (name) /* override extension with namehint if given */
+        ext = iext_find_extension(name);
+
+    Py_BEGIN_ALLOW_THREADS;
+#ifdef PNG_H
+    result = png_reader_open(&iter->reader, iter->rw);
+    if (result == 0) {
+        iter->width = iter->reader.width;
+        iter->height = iter->reader.height;
+    }
+#endif /* PNG_H */
+    if (result == 1) {
+        iter->full = IMG_LoadTyped_RW(iter->rw, 1, ext);
+        iter->rw = NULL;
+        if (iter->full) {
+            iter->width = iter->full->w;
+            iter->height = iter->full->h;
+            result = 0;
+        }
+    }
+    Py_END_ALLOW_THREADS;
+
+    if (result) {
+        Py_DECREF(iter);
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    return (PyObject *)iter;
+}
+
 static PyObject *
 imageext_get_sdl_image_version(PyObject *self, PyObject *_null)
 {
@@ -464,7 +1265,18 @@ _imageext_free(void *ptr)
 
 static PyMethodDef _imageext_methods[] = {
     {"load_extended", image_load_ext, METH_VARARGS, DOC_PYGAMEIMAGE},
-    {"save_extended", image_save_ext, METH_VARARGS, DOC_PYGAMEIMAGE},
+    {"load_many_extended", image_load_many_ext, METH_VARARGS,
+     DOC_PYGAMEIMAGE},
+    {"save_extended", (PyCFunction)image_save_ext,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEIMAGE},
+    {"save_async_extended", (PyCFunction)image_save_async_ext,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEIMAGE},
+    {"wait_saves_extended", image_wait_saves_ext, METH_NOARGS,
+     DOC_PYGAMEIMAGE},
+    {"load_region_extended", image_load_region_ext, METH_VARARGS,
+     DOC_PYGAMEIMAGE},
+    {"iter_bands_extended", image_iter_bands_ext, METH_VARARGS,
+     DOC_PYGAMEIMAGE},
     {"_get_sdl_image_version", imageext_get_sdl_image_version, METH_NOARGS,
      "_get_sdl_image_version() -> (major, minor, patch)\n"
      "Note: Should not be used directly."},
@@ -512,6 +1324,10 @@ MODINIT_DEFINE(imageext)
     #endif
     */
 
+    if (PyType_Ready(&pgBandIter_Type) < 0) {
+        return NULL;
+    }
+
     /* create the module */
     return PyModule_Create(&_module);
 }
@@ -91,6 +91,43 @@ typedef struct pg_bufferinfo_s {
 /*
  * BASE module
  */
+
+/* Work item for pg_ParallelFor: called once for each index in [0, count) */
+typedef void (*pg_parallel_proc)(void *data, int index, int count);
+
+/* Task for pg_SubmitTask: called once, on a pool worker when there is one */
+typedef void (*pg_task_proc)(void *data);
+
+/* Pixel operations smaller than this stay on the calling thread */
+#define PG_PARALLEL_MIN_PIXELS (256 * 256)
+
+/* Instruction sets the C modules pick code paths by, as returned by
+ * pg_GetSIMDFlags: the ones the CPU has, less any turned off with
+ * pygame.set_simd_backend() */
+#define PG_SIMD_MMX 0x01
+#define PG_SIMD_SSE 0x02
+#define PG_SIMD_SSE2 0x04
+#define PG_SIMD_SSE42 0x08
+#define PG_SIMD_AVX2 0x10
+#define PG_SIMD_NEON 0x20
+
+#define pg_HasMMX() ((pg_GetSIMDFlags() & PG_SIMD_MMX) != 0)
+#define pg_HasSSE() ((pg_GetSIMDFlags() & PG_SIMD_SSE) != 0)
+#define pg_HasSSE2() ((pg_GetSIMDFlags() & PG_SIMD_SSE2) != 0)
+#define pg_HasSSE42() ((pg_GetSIMDFlags() & PG_SIMD_SSE42) != 0)
+#define pg_HasAVX2() ((pg_GetSIMDFlags() & PG_SIMD_AVX2) != 0)
+#define pg_HasNEON() ((pg_GetSIMDFlags() & PG_SIMD_NEON) != 0)
+
+/* Categories of the counts kept with pg_StatsBegin and pg_StatsEnd */
+#define PG_STAT_BLIT 0
+#define PG_STAT_CONVERT 1
+#define PG_STAT_TRANSFORM 2
+#define PG_STAT_DRAW 3
+#define PG_STAT_TEXT 4
+#define PG_STAT_EVENT 5
+#define PG_STAT_DISPLAY 6
+#define PG_STAT_NUM 7
+
 #ifndef PYGAMEAPI_BASE_INTERNAL
 #define pgExc_SDLError ((PyObject *)PYGAMEAPI_GET_SLOT(base, 0))
 
@@ -159,6 +196,22 @@ typedef struct pg_bufferinfo_s {
 #define pg_EnvShouldBlendAlphaSDL2 \
     (*(char *(*)(void))PYGAMEAPI_GET_SLOT(base, 23))
 
+#define pg_ParallelFor \
+    (*(void (*)(pg_parallel_proc, void *, int))PYGAMEAPI_GET_SLOT(base, 24))
+
+#define pg_GetNumThreads (*(int (*)(void))PYGAMEAPI_GET_SLOT(base, 25))
+
+#define pg_SubmitTask \
+    (*(int (*)(pg_task_proc, void *))PYGAMEAPI_GET_SLOT(base, 26))
+
+#define pg_GetSIMDFlags (*(int (*)(void))PYGAMEAPI_GET_SLOT(base, 27))
+
+#define pg_StatsBegin (*(Uint64(*)(void))PYGAMEAPI_GET_SLOT(base, 28))
+
+#define pg_StatsEnd                                   \
+    (*(void (*)(int, const char *, Uint64, Sint64)) \
+         PYGAMEAPI_GET_SLOT(base, 29))
+
 #define import_pygame_base() IMPORT_PYGAME_MODULE(base)
 #endif /* ~PYGAMEAPI_BASE_INTERNAL */
 
@@ -168,6 +221,13 @@ typedef struct {
 } pgRectObject;
 
 #define pgRect_AsRect(x) (((pgRectObject *)x)->r)
+
+typedef struct {
+    PyObject_HEAD SDL_FRect r;
+    PyObject *weakreflist;
+} pgFRectObject;
+
+#define pgFRect_AsRect(x) (((pgFRectObject *)x)->r)
 #ifndef PYGAMEAPI_RECT_INTERNAL
 #define pgRect_Type (*(PyTypeObject *)PYGAMEAPI_GET_SLOT(rect, 0))
 
@@ -182,6 +242,15 @@ typedef struct {
 
 #define pgRect_Normalize (*(void (*)(SDL_Rect *))PYGAMEAPI_GET_SLOT(rect, 4))
 
+#define pgFRect_Type (*(PyTypeObject *)PYGAMEAPI_GET_SLOT(rect, 5))
+
+#define pgFRect_Check(x) ((x)->ob_type == &pgFRect_Type)
+#define pgFRect_New4 \
+    (*(PyObject * (*)(float, float, float, float)) PYGAMEAPI_GET_SLOT(rect, 6))
+
+#define pgFRect_FromObject \
+    (*(SDL_FRect * (*)(PyObject *, SDL_FRect *)) PYGAMEAPI_GET_SLOT(rect, 7))
+
 #define import_pygame_rect() IMPORT_PYGAME_MODULE(rect)
 #endif /* ~PYGAMEAPI_RECT_INTERNAL */
 
@@ -264,9 +333,14 @@ typedef struct {
     PyObject *weakreflist;
     PyObject *locklist;
     PyObject *dependency;
+    Uint32 version; /* bumped whenever the pixels may have changed */
+    Py_ssize_t readlocks; /* see pgSurface_LockRead */
 } pgSurfaceObject;
 #define pgSurface_AsSurface(x) (((pgSurfaceObject *)x)->surf)
 
+/* Most rects a Surface damage tracker holds before merging */
+#define PG_DAMAGE_MAX_RECTS 16
+
 #ifndef PYGAMEAPI_SURFACE_INTERNAL
 #define pgSurface_Type (*(PyTypeObject *)PYGAMEAPI_GET_SLOT(surface, 0))
 
@@ -284,6 +358,26 @@ typedef struct {
     (*(int (*)(pgSurfaceObject *, pgSurfaceObject *, SDL_Rect *, SDL_Rect *, \
                int))PYGAMEAPI_GET_SLOT(surface, 2))
 
+#define pgSurface_AddDamage                     \
+    (*(void (*)(pgSurfaceObject *, SDL_Rect *)) \
+         PYGAMEAPI_GET_SLOT(surface, 4))
+
+#define pgSurface_PopDamage                    \
+    (*(int (*)(pgSurfaceObject *, SDL_Rect *)) \
+         PYGAMEAPI_GET_SLOT(surface, 5))
+
+#define pgSurfacePool_Type (*(PyTypeObject *)PYGAMEAPI_GET_SLOT(surface, 6))
+
+#define pgSurfacePool_CreateSurface                                   \
+    (*(SDL_Surface * (*)(PyObject *, int, int, int, Uint32, Uint32,  \
+                         Uint32, Uint32)) PYGAMEAPI_GET_SLOT(surface, 7))
+
+#define pgSurfacePool_FreeSurface \
+    (*(void (*)(SDL_Surface *))PYGAMEAPI_GET_SLOT(surface, 8))
+
+#define pgSurface_GetVersion \
+    (*(Uint32(*)(pgSurfaceObject *))PYGAMEAPI_GET_SLOT(surface, 9))
+
 #define import_pygame_surface()         \
     do {                                \
         IMPORT_PYGAME_MODULE(surface);  \
@@ -306,8 +400,8 @@ typedef struct {
 
 #define pgLifetimeLock_Check(x) ((x)->ob_type == &pgLifetimeLock_Type)
 
-#define pgSurface_Prep(x) \
-    if ((x)->subsurface)  \
+#define pgSurface_Prep(x)                                     \
+    if ((x)->subsurface || ((x)->surf && !(x)->surf->pixels)) \
     (*(*(void (*)(pgSurfaceObject *))PYGAMEAPI_GET_SLOT(surflock, 1)))(x)
 
 #define pgSurface_Unprep(x) \
@@ -328,6 +422,33 @@ typedef struct {
 
 #define pgSurface_LockLifetime \
     (*(PyObject * (*)(PyObject *, PyObject *)) PYGAMEAPI_GET_SLOT(surflock, 7))
+
+#define pgSurface_SharePixels \
+    (*(SDL_Surface * (*)(SDL_Surface *)) PYGAMEAPI_GET_SLOT(surflock, 8))
+
+#define pgSurface_Unshare \
+    (*(int (*)(SDL_Surface *))PYGAMEAPI_GET_SLOT(surflock, 9))
+
+#define pgSurface_ReleaseShare \
+    (*(void (*)(SDL_Surface *))PYGAMEAPI_GET_SLOT(surflock, 10))
+
+#define pgSurface_LockRead \
+    (*(int (*)(pgSurfaceObject *))PYGAMEAPI_GET_SLOT(surflock, 11))
+
+#define pgSurface_UnlockRead \
+    (*(int (*)(pgSurfaceObject *))PYGAMEAPI_GET_SLOT(surflock, 12))
+
+#define pgSurface_Pack \
+    (*(Py_ssize_t(*)(SDL_Surface *))PYGAMEAPI_GET_SLOT(surflock, 13))
+
+#define pgSurface_Unpack \
+    (*(int (*)(SDL_Surface *))PYGAMEAPI_GET_SLOT(surflock, 14))
+
+#define pgSurface_ReleasePack \
+    (*(void (*)(SDL_Surface *))PYGAMEAPI_GET_SLOT(surflock, 15))
+
+#define pgSurface_PackedSize \
+    (*(Py_ssize_t(*)(SDL_Surface *))PYGAMEAPI_GET_SLOT(surflock, 16))
 #endif
 
 /*
@@ -353,6 +474,8 @@ typedef struct pgEventObject pgEventObject;
 
 #define pg_GetKeyRepeat (*(void (*)(int *, int *))PYGAMEAPI_GET_SLOT(event, 5))
 
+#define pgEvent_Wakeup (*(void (*)(void))PYGAMEAPI_GET_SLOT(event, 6))
+
 #define import_pygame_event() IMPORT_PYGAME_MODULE(event)
 #endif
 
@@ -383,6 +506,9 @@ typedef struct pgEventObject pgEventObject;
 #define pgRWops_GetFileExtension \
     (*(char *(*)(SDL_RWops *))PYGAMEAPI_GET_SLOT(rwobject, 6))
 
+#define pg_MapFile \
+    (*(PyObject * (*)(PyObject *)) PYGAMEAPI_GET_SLOT(rwobject, 7))
+
 #define import_pygame_rwobject() IMPORT_PYGAME_MODULE(rwobject)
 
 #endif
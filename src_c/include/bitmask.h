@@ -49,9 +49,25 @@ extern "C" {
 
 typedef struct bitmask {
     int w, h;
+    /* The bounds of the set bits found by bitmask_bounds(), kept while
+       bounds_valid is nonzero. Anything changing bits must call
+       bitmask_changed(). While exported is nonzero the kept bounds are
+       ignored, as the bits may then be changed outside of this library. */
+    int bounds_valid, exported;
+    int bounds_x, bounds_y, bounds_w, bounds_h;
+    /* Counts the changes to the bits, for anything else kept from them. */
+    unsigned int changes;
     BITMASK_W bits[1];
 } bitmask_t;
 
+/* Marks the bits of m as changed, dropping the kept bounds. */
+static INLINE void
+bitmask_changed(bitmask_t *m)
+{
+    m->bounds_valid = 0;
+    m->changes++;
+}
+
 /* Creates a bitmask of width w and height h, where
    w and h must both be greater than or equal to 0.
    The mask is automatically cleared when created.
@@ -97,6 +113,7 @@ static INLINE void
 bitmask_setbit(bitmask_t *m, int x, int y)
 {
     m->bits[x / BITMASK_W_LEN * m->h + y] |= BITMASK_N(x & BITMASK_W_MASK);
+    bitmask_changed(m);
 }
 
 /* Clears the bit at (x,y) */
@@ -104,8 +121,15 @@ static INLINE void
 bitmask_clearbit(bitmask_t *m, int x, int y)
 {
     m->bits[x / BITMASK_W_LEN * m->h + y] &= ~BITMASK_N(x & BITMASK_W_MASK);
+    bitmask_changed(m);
 }
 
+/* Finds the smallest rectangle holding all the set bits of m. The result is
+   remembered until m changes, so repeated calls are cheap. Returns 0,
+   leaving x, y, w and h untouched, if no bits are set. */
+int
+bitmask_bounds(const bitmask_t *m, int *x, int *y, int *w, int *h);
+
 /* Returns nonzero if the masks overlap with the given offset.
    The overlap tests uses the following offsets (which may be negative):
 
@@ -164,6 +188,16 @@ void
 bitmask_convolve(const bitmask_t *a, const bitmask_t *b, bitmask_t *o,
                  int xoffset, int yoffset);
 
+/* Sets each bit of m that is within n bits of a set bit in x and y, so the
+ * set areas grow by a (2n + 1) by (2n + 1) square. */
+void
+bitmask_dilate(bitmask_t *m, int n);
+
+/* Clears each bit of m that is within n bits of an unset bit in x and y,
+ * counting the bits outside of m as unset. */
+void
+bitmask_erode(bitmask_t *m, int n);
+
 #ifdef __cplusplus
 } /* End of extern "C" { */
 #endif
@@ -108,6 +108,16 @@ typedef uint8_t Uint8;
 #define NO_SDL_MOUSEWHEEL_FLIPPED
 #endif
 
+#if !SDL_VERSION_ATLEAST(2, 0, 10)
+/* Added to SDL in 2.0.10, used by pygame.FRect. */
+typedef struct SDL_FRect {
+    float x;
+    float y;
+    float w;
+    float h;
+} SDL_FRect;
+#endif
+
 #endif /* defined(SDL_VERSION_ATLEAST) */
 
 #endif /* ~defined(PGCOMPAT_H) */
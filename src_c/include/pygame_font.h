@@ -24,11 +24,14 @@
 #include "pgplatform.h"
 
 struct TTF_Font;
+struct pgRenderCache_;
 
 typedef struct {
     PyObject_HEAD TTF_Font *font;
     PyObject *weakreflist;
     unsigned int ttf_init_generation;
+    struct pgRenderCache_ *render_cache;
+    Py_buffer file_view; /* of the shared mapping of the font file, if any */
 } PyFontObject;
 #define PyFont_AsFont(x) (((PyFontObject *)x)->font)
 
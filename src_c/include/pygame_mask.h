@@ -25,6 +25,11 @@
 typedef struct {
     PyObject_HEAD bitmask_t *mask;
     void *bufdata;
+    /* The last outline() result, for every outline_every points, while the
+       mask's changes count is still outline_changes. */
+    PyObject *outline;
+    int outline_every;
+    unsigned int outline_changes;
 } pgMaskObject;
 
 #define pgMask_AsBitmap(x) (((pgMaskObject *)x)->mask)
@@ -29,11 +29,13 @@
 #include "pgcompat.h"
 
 struct Mix_Chunk;
+struct pg_bufferinfo_s;
 
 typedef struct {
     PyObject_HEAD Mix_Chunk *chunk;
     Uint8 *mem;
     PyObject *weakreflist;
+    struct pg_bufferinfo_s *source; /* held export of samples not copied */
 } pgSoundObject;
 
 typedef struct {
@@ -64,6 +66,13 @@ PYGAMEAPI_DEFINE_SLOTS(mixer);
 
 #define pgChannel_New (*(PyObject * (*)(int)) PYGAMEAPI_GET_SLOT(mixer, 4))
 
+#define pgStream_Type (*(PyTypeObject *)PYGAMEAPI_GET_SLOT(mixer, 5))
+#define pgStream_Check(x) ((x)->ob_type == &pgStream_Type)
+
+#define pgStream_Write                                      \
+    (*(Py_ssize_t(*)(PyObject *, const void *, Py_ssize_t)) \
+         PYGAMEAPI_GET_SLOT(mixer, 6))
+
 #define import_pygame_mixer() _IMPORT_PYGAME_MODULE(mixer)
 
 #endif /* PYGAMEAPI_MIXER_INTERNAL */
@@ -505,6 +505,140 @@ joy_get_hat(PyObject *self, PyObject *args)
     return Py_BuildValue("(ii)", px, py);
 }
 
+/* the state values before the axes: the timestamp */
+#define PG_JOY_STATE_HEAD 1
+/* the state values after the hats: gyroscope and accelerometer x, y, z */
+#define PG_JOY_STATE_SENSORS 6
+
+/* reads the sensors of the game controller open for the joystick, if any;
+ * the values are left as 0 otherwise */
+static void
+_joy_read_sensors(SDL_Joystick *joy, double *values)
+{
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    static const SDL_SensorType types[2] = {SDL_SENSOR_GYRO,
+                                            SDL_SENSOR_ACCEL};
+    SDL_GameController *ctrl;
+    float data[3];
+    int i, j;
+
+    ctrl = SDL_GameControllerFromInstanceID(SDL_JoystickInstanceID(joy));
+    if (!ctrl) {
+        return;
+    }
+    for (i = 0; i < 2; i++) {
+        if (!SDL_GameControllerHasSensor(ctrl, types[i])) {
+            continue;
+        }
+        if (!SDL_GameControllerIsSensorEnabled(ctrl, types[i])) {
+            /* starts reporting from the next update */
+            SDL_GameControllerSetSensorEnabled(ctrl, types[i], SDL_TRUE);
+            continue;
+        }
+        if (SDL_GameControllerGetSensorData(ctrl, types[i], data, 3) == 0) {
+            for (j = 0; j < 3; j++) {
+                values[i * 3 + j] = data[j];
+            }
+        }
+    }
+#endif
+}
+
+static PyObject *
+joy_get_state(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    SDL_Joystick *joy = pgJoystick_AsSDL(self);
+    PyObject *obj = Py_None;
+    Py_buffer view;
+    const char *format;
+    double *values;
+    Py_ssize_t size;
+    int numaxes, numbuttons, numhats, i;
+    Uint8 hat;
+
+    static char *kwids[] = {"out", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", kwids, &obj)) {
+        return NULL;
+    }
+
+    JOYSTICK_INIT_CHECK();
+    if (!joy) {
+        return RAISE(pgExc_SDLError, "Joystick not initialized");
+    }
+
+    numaxes = SDL_JoystickNumAxes(joy);
+    numbuttons = SDL_JoystickNumButtons(joy);
+    numhats = SDL_JoystickNumHats(joy);
+    if (numaxes < 0 || numbuttons < 0 || numhats < 0) {
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    size = PG_JOY_STATE_HEAD + numaxes + numbuttons + 2 * numhats +
+           PG_JOY_STATE_SENSORS;
+
+    if (obj == Py_None) {
+        PyObject *module = PyImport_ImportModule("array");
+
+        if (!module) {
+            return NULL;
+        }
+        obj = PyObject_CallMethod(module, "array", "(sN)", "d",
+                                  PyBytes_FromStringAndSize(
+                                      NULL, size * sizeof(double)));
+        Py_DECREF(module);
+        if (!obj) {
+            return NULL;
+        }
+    }
+    else {
+        Py_INCREF(obj);
+    }
+    if (PyObject_GetBuffer(obj, &view,
+                           PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_ND)) {
+        Py_DECREF(obj);
+        return NULL;
+    }
+    format = view.format ? view.format : "B";
+    if (*format == '@' || *format == '=' ||
+        *format == (SDL_BYTEORDER == SDL_LIL_ENDIAN ? '<' : '>')) {
+        /* NumPy marks the byte order */
+        format++;
+    }
+    if (view.itemsize != sizeof(double) || strcmp(format, "d") != 0 ||
+        !PyBuffer_IsContiguous(&view, 'C')) {
+        PyBuffer_Release(&view);
+        Py_DECREF(obj);
+        return RAISE(PyExc_ValueError,
+                     "out must be a contiguous buffer of doubles");
+    }
+    if (view.len < size * (Py_ssize_t)sizeof(double)) {
+        PyBuffer_Release(&view);
+        Py_DECREF(obj);
+        return PyErr_Format(PyExc_ValueError,
+                            "out must hold at least %zd values", size);
+    }
+
+    values = (double *)view.buf;
+    memset(values, 0, size * sizeof(double));
+    *values++ = (double)SDL_GetTicks();
+    for (i = 0; i < numaxes; i++) {
+        *values++ = SDL_JoystickGetAxis(joy, i) / 32768.0;
+    }
+    for (i = 0; i < numbuttons; i++) {
+        *values++ = SDL_JoystickGetButton(joy, i);
+    }
+    for (i = 0; i < numhats; i++) {
+        hat = SDL_JoystickGetHat(joy, i);
+        values[0] = (hat & SDL_HAT_RIGHT) ? 1 : (hat & SDL_HAT_LEFT) ? -1 : 0;
+        values[1] = (hat & SDL_HAT_UP) ? 1 : (hat & SDL_HAT_DOWN) ? -1 : 0;
+        values += 2;
+    }
+    _joy_read_sensors(joy, values);
+
+    PyBuffer_Release(&view);
+    return obj;
+}
+
 static PyMethodDef joy_methods[] = {
     {"init", joy_init, METH_NOARGS, DOC_JOYSTICKINIT},
     {"quit", joy_quit, METH_NOARGS, DOC_JOYSTICKQUIT},
@@ -531,6 +665,8 @@ static PyMethodDef joy_methods[] = {
     {"get_ball", joy_get_ball, METH_VARARGS, DOC_JOYSTICKGETBALL},
     {"get_numhats", joy_get_numhats, METH_NOARGS, DOC_JOYSTICKGETNUMHATS},
     {"get_hat", joy_get_hat, METH_VARARGS, DOC_JOYSTICKGETHAT},
+    {"get_state", (PyCFunction)joy_get_state, METH_VARARGS | METH_KEYWORDS,
+     DOC_JOYSTICKGETSTATE},
 
     {NULL, NULL, 0, NULL}};
 
@@ -145,6 +145,80 @@ key_get_pressed(PyObject *self, PyObject *_null)
     return ret_obj;
 }
 
+/* the keyboard state at the last get_pressed_buffer() call, for the
+ * changed bits */
+static Uint8 _pg_key_last_state[SDL_NUM_SCANCODES];
+
+static PyObject *
+key_get_pressed_buffer(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *obj_out = Py_None, *obj_changed = Py_None;
+    Py_buffer out, changed;
+    const Uint8 *key_state;
+    Uint8 *bits;
+    int num_keys, i;
+
+    static char *kwids[] = {"out", "changed", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OO", kwids, &obj_out,
+                                     &obj_changed))
+        return NULL;
+
+    VIDEO_INIT_CHECK();
+
+    key_state = SDL_GetKeyboardState(&num_keys);
+    if (!key_state || !num_keys)
+        Py_RETURN_NONE;
+    if (num_keys > SDL_NUM_SCANCODES)
+        num_keys = SDL_NUM_SCANCODES;
+
+    if (obj_out == Py_None) {
+        if (!(obj_out = PyByteArray_FromStringAndSize(NULL, num_keys)))
+            return NULL;
+    }
+    else {
+        Py_INCREF(obj_out);
+    }
+    if (PyObject_GetBuffer(obj_out, &out, PyBUF_WRITABLE)) {
+        Py_DECREF(obj_out);
+        return NULL;
+    }
+    if (out.len < num_keys) {
+        PyBuffer_Release(&out);
+        Py_DECREF(obj_out);
+        return PyErr_Format(PyExc_ValueError,
+                            "out must be at least %d bytes long", num_keys);
+    }
+
+    if (obj_changed != Py_None) {
+        if (PyObject_GetBuffer(obj_changed, &changed, PyBUF_WRITABLE)) {
+            PyBuffer_Release(&out);
+            Py_DECREF(obj_out);
+            return NULL;
+        }
+        if (changed.len < (num_keys + 7) / 8) {
+            PyBuffer_Release(&changed);
+            PyBuffer_Release(&out);
+            Py_DECREF(obj_out);
+            return PyErr_Format(PyExc_ValueError,
+                                "changed must be at least %d bytes long",
+                                (num_keys + 7) / 8);
+        }
+        bits = (Uint8 *)changed.buf;
+        memset(bits, 0, (num_keys + 7) / 8);
+        for (i = 0; i < num_keys; i++) {
+            if (key_state[i] != _pg_key_last_state[i])
+                bits[i >> 3] |= (Uint8)(1 << (i & 7));
+        }
+        PyBuffer_Release(&changed);
+    }
+
+    memcpy(out.buf, key_state, num_keys);
+    memcpy(_pg_key_last_state, key_state, num_keys);
+    PyBuffer_Release(&out);
+    return obj_out;
+}
+
 /* keep our own table for backward compatibility */
 static const char *SDL1_scancode_names[SDL_NUM_SCANCODES] = {
     NULL,
@@ -803,6 +877,8 @@ static PyMethodDef _key_methods[] = {
     {"set_repeat", key_set_repeat, METH_VARARGS, DOC_PYGAMEKEYSETREPEAT},
     {"get_repeat", key_get_repeat, METH_NOARGS, DOC_PYGAMEKEYGETREPEAT},
     {"get_pressed", key_get_pressed, METH_NOARGS, DOC_PYGAMEKEYGETPRESSED},
+    {"get_pressed_buffer", (PyCFunction)key_get_pressed_buffer,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEKEYGETPRESSEDBUFFER},
     {"name", key_name, METH_VARARGS, DOC_PYGAMEKEYNAME},
     {"key_code", (PyCFunction)key_code, METH_VARARGS | METH_KEYWORDS,
      DOC_PYGAMEKEYNAME},
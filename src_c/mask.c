@@ -35,10 +35,16 @@
 
 #include "doc/mask_doc.h"
 
+#include "pgbufferproxy.h"
+
 #include "structmember.h"
 
 #include <math.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif /* __SSE2__ */
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -480,33 +486,32 @@ mask_angle(PyObject *self, PyObject *_null)
     }
 }
 
+/* Traces the outline of the set bits of c, taking every nth point.
+ *
+ * Returns:
+ *     a new list of the points, or NULL with an exception set
+ */
 static PyObject *
-mask_outline(PyObject *self, PyObject *args, PyObject *kwargs)
+trace_outline(bitmask_t *c, int every)
 {
-    bitmask_t *c = pgMask_AsBitmap(self);
     bitmask_t *m = NULL;
     PyObject *plist = NULL;
     PyObject *value = NULL;
     int x, y, firstx, firsty, secx, secy, currx, curry, nextx, nexty, n;
-    int e, every = 1;
+    int e, bx, by, bw, bh;
     int a[] = {1, 1, 0, -1, -1, -1, 0, 1, 1, 1, 0, -1, -1, -1};
     int b[] = {0, 1, 1, 1, 0, -1, -1, -1, 0, 1, 1, 1, 0, -1};
-    static char *keywords[] = {"every", NULL};
 
     firstx = firsty = secx = x = 0;
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|i", keywords, &every)) {
-        return NULL;
-    }
-
     plist = PyList_New(0);
     if (!plist) {
         return RAISE(PyExc_MemoryError,
                      "outline cannot allocate memory for list");
     }
 
-    if (!c->w || !c->h) {
-        return plist;
+    if (!c->w || !c->h || !bitmask_bounds(c, &bx, &by, &bw, &bh)) {
+        return plist; /* nothing to trace */
     }
 
     /* Copying to a larger mask to avoid border checking. */
@@ -519,8 +524,8 @@ mask_outline(PyObject *self, PyObject *args, PyObject *kwargs)
 
     bitmask_draw(m, c, 1, 1);
 
-    /* find the first set pixel in the mask */
-    for (y = 1; y < m->h - 1; y++) {
+    /* find the first set pixel in the mask, from its first set row */
+    for (y = by + 1; y < m->h - 1; y++) {
         for (x = 1; x < m->w - 1; x++) {
             if (bitmask_getbit(m, x, y)) {
                 firstx = x;
@@ -648,6 +653,45 @@ mask_outline(PyObject *self, PyObject *args, PyObject *kwargs)
     return plist;
 }
 
+static PyObject *
+mask_outline(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgMaskObject *maskobj = (pgMaskObject *)self;
+    bitmask_t *c = maskobj->mask;
+    PyObject *plist = NULL;
+    int every = 1;
+    static char *keywords[] = {"every", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|i", keywords, &every)) {
+        return NULL;
+    }
+
+    /* The last outline is kept until the mask changes. Its bits can change
+     * unseen while they are exported through the buffer interface.
+     */
+    if (NULL != maskobj->outline && maskobj->outline_every == every &&
+        maskobj->outline_changes == c->changes && !c->exported) {
+        return PyList_GetSlice(maskobj->outline, 0,
+                               PyList_GET_SIZE(maskobj->outline));
+    }
+
+    plist = trace_outline(c, every);
+    if (NULL == plist) {
+        return NULL; /* Exception already set. */
+    }
+
+    Py_XDECREF(maskobj->outline);
+    maskobj->outline = PyList_GetSlice(plist, 0, PyList_GET_SIZE(plist));
+    if (NULL == maskobj->outline) {
+        Py_DECREF(plist);
+        return NULL; /* Exception already set. */
+    }
+    maskobj->outline_every = every;
+    maskobj->outline_changes = c->changes;
+
+    return plist;
+}
+
 static PyObject *
 mask_convolve(PyObject *aobj, PyObject *args, PyObject *kwargs)
 {
@@ -690,6 +734,225 @@ mask_convolve(PyObject *aobj, PyObject *args, PyObject *kwargs)
     return oobj;
 }
 
+static PyObject *
+mask_dilate(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int n;
+    static char *keywords[] = {"n", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "i", keywords, &n)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (n < 0) {
+        return RAISE(PyExc_ValueError, "cannot dilate mask by negative n");
+    }
+
+    bitmask_dilate(pgMask_AsBitmap(self), n);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+mask_erode(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int n;
+    static char *keywords[] = {"n", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "i", keywords, &n)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (n < 0) {
+        return RAISE(PyExc_ValueError, "cannot erode mask by negative n");
+    }
+
+    bitmask_erode(pgMask_AsBitmap(self), n);
+
+    Py_RETURN_NONE;
+}
+
+/* Finds the squared distances d[q] from each q in [0, n) to the nearest p
+ * in the parabolas f[p] + (q - p)^2, by the lower envelope of Felzenszwalb
+ * and Huttenlocher. The infinite values of f are left out, and d is set to
+ * infinity if all of them are. v and z must hold n and n + 1 items.
+ */
+static void
+distance_transform_1d(const double *f, double *d, int n, int *v, double *z)
+{
+    int p, q, k = -1;
+    double s;
+
+    for (q = 0; q < n; ++q) {
+        if (f[q] == HUGE_VAL) {
+            continue;
+        }
+        if (k < 0) {
+            k = 0;
+            v[0] = q;
+            z[0] = -HUGE_VAL;
+            z[1] = HUGE_VAL;
+            continue;
+        }
+        /* drop the parabolas this one is below from where they start, which
+         * ends at the first as z[0] is -infinity */
+        for (;;) {
+            p = v[k];
+            s = ((f[q] + (double)q * q) - (f[p] + (double)p * p)) /
+                (2.0 * (q - p));
+            if (s > z[k]) {
+                break;
+            }
+            --k;
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = HUGE_VAL;
+    }
+
+    if (k < 0) {
+        for (q = 0; q < n; ++q) {
+            d[q] = HUGE_VAL;
+        }
+        return;
+    }
+    for (k = 0, q = 0; q < n; ++q) {
+        while (z[k + 1] < q) {
+            ++k;
+        }
+        d[q] = (double)(q - v[k]) * (q - v[k]) + f[v[k]];
+    }
+}
+
+/* Sets out[y * m->w + x] to the distance from (x, y) to the nearest set bit
+ * of m, or to infinity if no bits are set. The distances along each column
+ * are found first, then combined along each row.
+ *
+ * Returns:
+ *     0 on success, -1 if out of memory
+ */
+static int
+distance_transform(const bitmask_t *m, float *out)
+{
+    int x, y, w = m->w, h = m->h, *near, *v;
+    double *f, *d, *z;
+    float *row;
+
+    if (!w || !h) {
+        return 0;
+    }
+
+    near = PyMem_RawMalloc(sizeof(int) * (size_t)(2 * w));
+    f = PyMem_RawMalloc(sizeof(double) * (size_t)(3 * w + 1));
+    if (!near || !f) {
+        PyMem_RawFree(near);
+        PyMem_RawFree(f);
+        return -1;
+    }
+    v = near + w;
+    d = f + w;
+    z = d + w;
+
+    /* the distance to the nearest set bit above, then below, in the column,
+     * with -1 when there is none */
+    for (x = 0; x < w; ++x) {
+        near[x] = -1;
+    }
+    for (y = 0; y < h; ++y) {
+        row = out + (size_t)y * w;
+        for (x = 0; x < w; ++x) {
+            if (bitmask_getbit(m, x, y)) {
+                near[x] = 0;
+            }
+            else if (near[x] >= 0) {
+                ++near[x];
+            }
+            row[x] = near[x] < 0 ? (float)HUGE_VAL : (float)near[x];
+        }
+    }
+    for (x = 0; x < w; ++x) {
+        near[x] = -1;
+    }
+    for (y = h - 1; y >= 0; --y) {
+        row = out + (size_t)y * w;
+        for (x = 0; x < w; ++x) {
+            if (bitmask_getbit(m, x, y)) {
+                near[x] = 0;
+            }
+            else if (near[x] >= 0) {
+                ++near[x];
+            }
+            if (near[x] >= 0 && near[x] < row[x]) {
+                row[x] = (float)near[x];
+            }
+        }
+    }
+
+    for (y = 0; y < h; ++y) {
+        row = out + (size_t)y * w;
+        for (x = 0; x < w; ++x) {
+            f[x] = row[x] == (float)HUGE_VAL ? HUGE_VAL
+                                             : (double)row[x] * row[x];
+        }
+        distance_transform_1d(f, d, w, v, z);
+        for (x = 0; x < w; ++x) {
+            row[x] = (float)sqrt(d[x]);
+        }
+    }
+
+    PyMem_RawFree(near);
+    PyMem_RawFree(f);
+    return 0;
+}
+
+static PyObject *
+mask_distance_transform(PyObject *self, PyObject *_null)
+{
+    bitmask_t *mask = pgMask_AsBitmap(self);
+    PyObject *data, *dict, *proxy;
+    float *buf;
+    int result;
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    const char *typestr = "<f4";
+#else  /* SDL_BIG_ENDIAN */
+    const char *typestr = ">f4";
+#endif /* SDL_BIG_ENDIAN */
+
+    data = PyByteArray_FromStringAndSize(
+        NULL, (Py_ssize_t)mask->w * mask->h * sizeof(float));
+    if (NULL == data) {
+        return NULL; /* Exception already set. */
+    }
+    buf = (float *)PyByteArray_AS_STRING(data);
+
+    Py_BEGIN_ALLOW_THREADS; /* Release the GIL. */
+    result = distance_transform(mask, buf);
+    Py_END_ALLOW_THREADS; /* Obtain the GIL. */
+
+    if (result) {
+        Py_DECREF(data);
+        return RAISE(PyExc_MemoryError,
+                     "cannot allocate memory for distance transform");
+    }
+
+    /* the bytearray holding the distances lives as long as the proxy */
+    dict = Py_BuildValue("{s:(ii),s:s,s:(ii),s:(NO),s:O}", "shape", mask->w,
+                         mask->h, "typestr", typestr, "strides",
+                         (int)sizeof(float), mask->w * (int)sizeof(float),
+                         "data", PyLong_FromVoidPtr(buf), Py_False, "parent",
+                         data);
+    Py_DECREF(data);
+    if (NULL == dict) {
+        return NULL; /* Exception already set. */
+    }
+
+    proxy = PyObject_CallFunctionObjArgs((PyObject *)&pgBufproxy_Type, dict,
+                                         NULL);
+    Py_DECREF(dict);
+    return proxy;
+}
+
 /* Gets the color of a given pixel.
  *
  * Params:
@@ -759,19 +1022,266 @@ set_pixel_color(Uint8 *pixel, Uint8 bpp, Uint32 color)
     }
 }
 
+/* The 32 bit pixel kernels below build each word of a mask row at once,
+ * with SSE2 comparing 4 pixels per step where it is available. Each kernel
+ * is a 4 pixel test, passing back one bit per pixel, and a scalar test for
+ * the pixels left over at the end of a word.
+ */
+#ifdef __SSE2__
+static PG_INLINE int
+alpha_above4(const Uint32 *pixels, __m128i mm_amask, __m128i mm_ashift,
+             __m128i mm_threshold)
+{
+    __m128i mm_alpha = _mm_loadu_si128((const __m128i *)pixels);
+
+    mm_alpha = _mm_srl_epi32(_mm_and_si128(mm_alpha, mm_amask), mm_ashift);
+    return _mm_movemask_ps(
+        _mm_castsi128_ps(_mm_cmpgt_epi32(mm_alpha, mm_threshold)));
+}
+
+static PG_INLINE int
+not_colorkey4(const Uint32 *pixels, __m128i mm_colorkey)
+{
+    __m128i mm_src = _mm_loadu_si128((const __m128i *)pixels);
+
+    return ~_mm_movemask_ps(
+               _mm_castsi128_ps(_mm_cmpeq_epi32(mm_src, mm_colorkey))) &
+           0xF;
+}
+
+/* Tests that each of the r, g and b bytes of the pixels differ by less than
+ * those of mm_threshold. mm_rgbmask picks out the bytes to test.
+ */
+static PG_INLINE int
+rgb_within4(__m128i mm_src, __m128i mm_other, __m128i mm_threshold,
+            __m128i mm_rgbmask)
+{
+    __m128i mm_zero = _mm_setzero_si128();
+    __m128i mm_diff = _mm_or_si128(_mm_subs_epu8(mm_src, mm_other),
+                                   _mm_subs_epu8(mm_other, mm_src));
+    __m128i mm_fail = _mm_and_si128(
+        _mm_cmpeq_epi8(_mm_subs_epu8(mm_threshold, mm_diff), mm_zero),
+        mm_rgbmask);
+
+    return _mm_movemask_ps(
+        _mm_castsi128_ps(_mm_cmpeq_epi32(mm_fail, mm_zero)));
+}
+#endif /* __SSE2__ */
+
+/* Packs 16 pixels of 4 pixel test results, starting at pixels, into the low
+ * 16 bits of an int.
+ */
+#define PACK16(test, pixels)                                                 \
+    ((test((pixels))) | ((test((pixels) + 4)) << 4) |                        \
+     ((test((pixels) + 8)) << 8) | ((test((pixels) + 12)) << 12))
+
+/* Whether the r, g and b channels of a 32 bit format are each one whole
+ * byte, as needed to compare them a byte at a time.
+ */
+static int
+rgb_bytes_32(SDL_PixelFormat *format)
+{
+    return format->BytesPerPixel == 4 && !(format->Rshift & 7) &&
+           !(format->Gshift & 7) && !(format->Bshift & 7) &&
+           format->Rmask == (Uint32)0xFF << format->Rshift &&
+           format->Gmask == (Uint32)0xFF << format->Gshift &&
+           format->Bmask == (Uint32)0xFF << format->Bshift;
+}
+
+/* set_from_threshold() for 32 bit surfaces with an 8 bit alpha channel */
+static void
+set_from_alpha_32(SDL_Surface *surf, bitmask_t *bitmask, int threshold,
+                  int ystart, int yend)
+{
+    Uint32 amask = surf->format->Amask;
+    int ashift = surf->format->Ashift;
+    const Uint32 *pixels;
+    BITMASK_W *word;
+    BITMASK_W bits;
+    int x, y, i, n;
+#ifdef __SSE2__
+    __m128i mm_amask = _mm_set1_epi32((int)amask);
+    __m128i mm_ashift = _mm_cvtsi32_si128(ashift);
+    __m128i mm_threshold = _mm_set1_epi32(threshold);
+#define ALPHA_ABOVE4(p) alpha_above4((p), mm_amask, mm_ashift, mm_threshold)
+#endif /* __SSE2__ */
+
+    for (y = ystart; y < yend; ++y) {
+        pixels = (const Uint32 *)((Uint8 *)surf->pixels + y * surf->pitch);
+        word = bitmask->bits + y;
+
+        for (x = 0; x < surf->w; x += BITMASK_W_LEN, word += bitmask->h) {
+            n = MIN(surf->w - x, (int)BITMASK_W_LEN);
+            bits = 0;
+            i = 0;
+#ifdef __SSE2__
+            for (; i + 16 <= n; i += 16) {
+                bits |= (BITMASK_W)PACK16(ALPHA_ABOVE4, pixels + x + i) << i;
+            }
+            for (; i + 4 <= n; i += 4) {
+                bits |= (BITMASK_W)ALPHA_ABOVE4(pixels + x + i) << i;
+            }
+#endif /* __SSE2__ */
+            for (; i < n; ++i) {
+                if ((int)((pixels[x + i] & amask) >> ashift) > threshold) {
+                    bits |= BITMASK_N(i);
+                }
+            }
+            *word |= bits;
+        }
+    }
+#ifdef __SSE2__
+#undef ALPHA_ABOVE4
+#endif /* __SSE2__ */
+}
+
+/* set_from_colorkey() for 32 bit surfaces */
+static void
+set_from_colorkey_32(SDL_Surface *surf, bitmask_t *bitmask, Uint32 colorkey,
+                     int ystart, int yend)
+{
+    const Uint32 *pixels;
+    BITMASK_W *word;
+    BITMASK_W bits;
+    int x, y, i, n;
+#ifdef __SSE2__
+    __m128i mm_colorkey = _mm_set1_epi32((int)colorkey);
+#define NOT_COLORKEY4(p) not_colorkey4((p), mm_colorkey)
+#endif /* __SSE2__ */
+
+    for (y = ystart; y < yend; ++y) {
+        pixels = (const Uint32 *)((Uint8 *)surf->pixels + y * surf->pitch);
+        word = bitmask->bits + y;
+
+        for (x = 0; x < surf->w; x += BITMASK_W_LEN, word += bitmask->h) {
+            n = MIN(surf->w - x, (int)BITMASK_W_LEN);
+            bits = 0;
+            i = 0;
+#ifdef __SSE2__
+            for (; i + 16 <= n; i += 16) {
+                bits |= (BITMASK_W)PACK16(NOT_COLORKEY4, pixels + x + i) << i;
+            }
+            for (; i + 4 <= n; i += 4) {
+                bits |= (BITMASK_W)NOT_COLORKEY4(pixels + x + i) << i;
+            }
+#endif /* __SSE2__ */
+            for (; i < n; ++i) {
+                if (pixels[x + i] != colorkey) {
+                    bits |= BITMASK_N(i);
+                }
+            }
+            *word |= bits;
+        }
+    }
+#ifdef __SSE2__
+#undef NOT_COLORKEY4
+#endif /* __SSE2__ */
+}
+
+/* Whether each of the r, g and b bytes of two 32 bit pixels differ by less
+ * than those of threshold.
+ */
+static PG_INLINE int
+rgb_within(Uint32 pixel, Uint32 other, Uint32 threshold, Uint32 rgbmask)
+{
+    int shift;
+
+    for (shift = 0; shift < 32; shift += 8) {
+        if (((rgbmask >> shift) & 0xFF) &&
+            abs_diff_uint32((pixel >> shift) & 0xFF,
+                            (other >> shift) & 0xFF) >=
+                ((threshold >> shift) & 0xFF)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* bitmask_threshold() for 32 bit surfaces with byte sized r, g and b
+ * channels, comparing to the other surface if there is one, of the same
+ * format, or otherwise to the color.
+ */
+static void
+bitmask_threshold_32(bitmask_t *m, SDL_Surface *surf, SDL_Surface *surf2,
+                     Uint32 color, Uint32 threshold)
+{
+    SDL_PixelFormat *format = surf->format;
+    Uint32 rgbmask = format->Rmask | format->Gmask | format->Bmask;
+    const Uint32 *pixels, *pixels2 = NULL;
+    BITMASK_W *word;
+    BITMASK_W bits;
+    int x, y, i, n;
+#ifdef __SSE2__
+    __m128i mm_color = _mm_set1_epi32((int)color);
+    __m128i mm_threshold = _mm_set1_epi32((int)threshold);
+    __m128i mm_rgbmask = _mm_set1_epi32((int)rgbmask);
+#define RGB_WITHIN4(p)                                                       \
+    rgb_within4(_mm_loadu_si128((const __m128i *)(p)),                       \
+                pixels2 ? _mm_loadu_si128(                                   \
+                              (const __m128i *)(pixels2 + ((p) - pixels)))   \
+                        : mm_color,                                          \
+                mm_threshold, mm_rgbmask)
+#endif /* __SSE2__ */
+
+    for (y = 0; y < surf->h; ++y) {
+        pixels = (const Uint32 *)((Uint8 *)surf->pixels + y * surf->pitch);
+        if (surf2) {
+            pixels2 =
+                (const Uint32 *)((Uint8 *)surf2->pixels + y * surf2->pitch);
+        }
+        word = m->bits + y;
+
+        for (x = 0; x < surf->w; x += BITMASK_W_LEN, word += m->h) {
+            n = MIN(surf->w - x, (int)BITMASK_W_LEN);
+            bits = 0;
+            i = 0;
+#ifdef __SSE2__
+            for (; i + 16 <= n; i += 16) {
+                bits |= (BITMASK_W)PACK16(RGB_WITHIN4, pixels + x + i) << i;
+            }
+            for (; i + 4 <= n; i += 4) {
+                bits |= (BITMASK_W)RGB_WITHIN4(pixels + x + i) << i;
+            }
+#endif /* __SSE2__ */
+            for (; i < n; ++i) {
+                if (rgb_within(pixels[x + i],
+                               pixels2 ? pixels2[x + i] : color, threshold,
+                               rgbmask)) {
+                    bits |= BITMASK_N(i);
+                }
+            }
+            *word |= bits;
+        }
+    }
+#ifdef __SSE2__
+#undef RGB_WITHIN4
+#endif /* __SSE2__ */
+    bitmask_changed(m);
+}
+
+/* Sets the bit at (x, y) without bitmask_changed(), so that bands of
+ * different rows can be filled in at the same time.
+ */
+#define SET_ROW_BIT(m, x, y)                                       \
+    ((m)->bits[(x) / BITMASK_W_LEN * (m)->h + (y)] |=              \
+     BITMASK_N((x)&BITMASK_W_MASK))
+
 /* For each surface pixel's alpha that is greater than the threshold,
- * the corresponding bitmask bit is set.
+ * the corresponding bitmask bit is set. Only rows [ystart, yend) are
+ * looked at, and bitmask_changed() is left to the caller.
  *
  * Params:
  *     surf: surface
  *     bitmask: bitmask to alter
  *     threshold: threshold used check surface pixels (alpha) against
+ *     ystart, yend: rows to set
  *
  * Returns:
  *     void
  */
 static void
-set_from_threshold(SDL_Surface *surf, bitmask_t *bitmask, int threshold)
+set_from_threshold(SDL_Surface *surf, bitmask_t *bitmask, int threshold,
+                   int ystart, int yend)
 {
     SDL_PixelFormat *format = surf->format;
     Uint8 bpp = format->BytesPerPixel;
@@ -779,48 +1289,89 @@ set_from_threshold(SDL_Surface *surf, bitmask_t *bitmask, int threshold)
     Uint8 rgba[4];
     int x, y;
 
-    for (y = 0; y < surf->h; ++y) {
+    if (bpp == 4 && format->Amask == (Uint32)0xFF << format->Ashift) {
+        set_from_alpha_32(surf, bitmask, threshold, ystart, yend);
+        return;
+    }
+
+    for (y = ystart; y < yend; ++y) {
         pixel = (Uint8 *)surf->pixels + y * surf->pitch;
 
         for (x = 0; x < surf->w; ++x, pixel += bpp) {
             SDL_GetRGBA(get_pixel_color(pixel, bpp), format, rgba, rgba + 1,
                         rgba + 2, rgba + 3);
             if (rgba[3] > threshold) {
-                bitmask_setbit(bitmask, x, y);
+                SET_ROW_BIT(bitmask, x, y);
             }
         }
     }
 }
 
 /* For each surface pixel's color that is not equal to the colorkey, the
- * corresponding bitmask bit is set.
+ * corresponding bitmask bit is set. Only rows [ystart, yend) are looked
+ * at, and bitmask_changed() is left to the caller.
  *
  * Params:
  *     surf: surface
  *     bitmask: bitmask to alter
  *     colorkey: color used to check surface pixels against
+ *     ystart, yend: rows to set
  *
  * Returns:
  *     void
  */
 static void
-set_from_colorkey(SDL_Surface *surf, bitmask_t *bitmask, Uint32 colorkey)
+set_from_colorkey(SDL_Surface *surf, bitmask_t *bitmask, Uint32 colorkey,
+                  int ystart, int yend)
 {
     Uint8 bpp = surf->format->BytesPerPixel;
     Uint8 *pixel = NULL;
     int x, y;
 
-    for (y = 0; y < surf->h; ++y) {
+    if (bpp == 4) {
+        set_from_colorkey_32(surf, bitmask, colorkey, ystart, yend);
+        return;
+    }
+
+    for (y = ystart; y < yend; ++y) {
         pixel = (Uint8 *)surf->pixels + y * surf->pitch;
 
         for (x = 0; x < surf->w; ++x, pixel += bpp) {
             if (get_pixel_color(pixel, bpp) != colorkey) {
-                bitmask_setbit(bitmask, x, y);
+                SET_ROW_BIT(bitmask, x, y);
             }
         }
     }
 }
 
+#undef SET_ROW_BIT
+
+typedef struct {
+    SDL_Surface *surf;
+    bitmask_t *bitmask;
+    int use_thresh;
+    int threshold;
+    Uint32 colorkey;
+} FromSurfacePass;
+
+static void
+from_surface_band(void *data, int band, int nbands)
+{
+    FromSurfacePass *pass = (FromSurfacePass *)data;
+    int height = pass->surf->h;
+    int ystart = (int)((long long)height * band / nbands);
+    int yend = (int)((long long)height * (band + 1) / nbands);
+
+    if (pass->use_thresh) {
+        set_from_threshold(pass->surf, pass->bitmask, pass->threshold, ystart,
+                           yend);
+    }
+    else {
+        set_from_colorkey(pass->surf, pass->bitmask, pass->colorkey, ystart,
+                          yend);
+    }
+}
+
 /* Creates a mask from a given surface.
  *
  * Returns:
@@ -832,9 +1383,9 @@ mask_from_surface(PyObject *self, PyObject *args, PyObject *kwargs)
     SDL_Surface *surf = NULL;
     pgSurfaceObject *surfobj;
     pgMaskObject *maskobj = NULL;
-    Uint32 colorkey;
+    FromSurfacePass pass;
     int threshold = 127; /* default value */
-    int use_thresh = 1;
+    int nbands;
     static char *keywords[] = {"surface", "threshold", NULL};
 
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|i", keywords,
@@ -860,25 +1411,32 @@ mask_from_surface(PyObject *self, PyObject *args, PyObject *kwargs)
         return (PyObject *)maskobj;
     }
 
-    if (!pgSurface_Lock(surfobj)) {
+    if (!pgSurface_LockRead(surfobj)) {
         Py_DECREF((PyObject *)maskobj);
         return RAISE(PyExc_RuntimeError, "cannot lock surface");
     }
 
     Py_BEGIN_ALLOW_THREADS; /* Release the GIL. */
 
-    use_thresh = (SDL_GetColorKey(surf, &colorkey) == -1);
+    pass.surf = surf;
+    pass.bitmask = maskobj->mask;
+    pass.use_thresh = (SDL_GetColorKey(surf, &pass.colorkey) == -1);
+    pass.threshold = threshold;
 
-    if (use_thresh) {
-        set_from_threshold(surf, maskobj->mask, threshold);
+    /* Each row only sets its own bitmask words, so rows can be split up */
+    nbands = pg_GetNumThreads();
+    if ((long long)surf->w * surf->h < PG_PARALLEL_MIN_PIXELS) {
+        nbands = 1;
     }
-    else {
-        set_from_colorkey(surf, maskobj->mask, colorkey);
+    else if (nbands > surf->h) {
+        nbands = surf->h;
     }
+    pg_ParallelFor(from_surface_band, &pass, nbands);
+    bitmask_changed(maskobj->mask);
 
     Py_END_ALLOW_THREADS; /* Obtain the GIL. */
 
-    if (!pgSurface_Unlock(surfobj)) {
+    if (!pgSurface_UnlockRead(surfobj)) {
         Py_DECREF((PyObject *)maskobj);
         return RAISE(PyExc_RuntimeError, "cannot unlock surface");
     }
@@ -944,6 +1502,13 @@ bitmask_threshold(bitmask_t *m, SDL_Surface *surf, SDL_Surface *surf2,
         bpp2 = 0;
     }
 
+    if (rgb_bytes_32(format) &&
+        (!surf2 || (rgb_bytes_32(format2) && rmask2 == rmask &&
+                    gmask2 == gmask && bmask2 == bmask))) {
+        bitmask_threshold_32(m, surf, surf2, color, threshold);
+        return;
+    }
+
     SDL_GetRGBA(color, format, &r, &g, &b, &a);
     SDL_GetRGBA(threshold, format, &tr, &tg, &tb, &ta);
 
@@ -1135,205 +1700,493 @@ mask_from_threshold(PyObject *self, PyObject *args, PyObject *kwargs)
     return (PyObject *)maskobj;
 }
 
-/* The initial labelling phase of the connected components algorithm.
- *
- * Connected component labeling based on the SAUF algorithm by Kesheng Wu,
- * Ekow Otoo, and Kenji Suzuki. The algorithm is best explained by their
- * paper, "Two Strategies to Speed up Connected Component Labeling Algorithms",
- * but in summary, it is a very efficient two pass method for 8-connected
- * components. It uses a decision tree to minimize the number of neighbors that
- * need to be checked. It stores equivalence information in an array based
- * union-find.
- *
- * Params:
- *     input - the input mask
- *     image - an array to store labelled pixels
- *     ufind - the union-find label equivalence array
- *     largest - an array to store the number of pixels for each label
- *
- * Returns:
- *     the highest label in the labelled image
+/* A mask placed for collide_many(), with the bounds of its placement */
+typedef struct {
+    bitmask_t *mask;
+    int x, y, x2, y2;
+    Py_ssize_t index;
+} placed_mask;
+
+static int
+compare_placed_masks(const void *a, const void *b)
+{
+    int ax = ((const placed_mask *)a)->x, bx = ((const placed_mask *)b)->x;
+    return (ax > bx) - (ax < bx);
+}
+
+static int
+compare_index_pairs(const void *a, const void *b)
+{
+    const Py_ssize_t *pa = (const Py_ssize_t *)a, *pb = (const Py_ssize_t *)b;
+
+    if (pa[0] != pb[0]) {
+        return (pa[0] > pb[0]) - (pa[0] < pb[0]);
+    }
+    return (pa[1] > pb[1]) - (pa[1] < pb[1]);
+}
+
+/* Fills placed with the masks in the tuple masks at the positions in the
+ * sequence positions, leaving out empty masks, and sorts them by their
+ * left edges. Returns the number of masks placed, or -1 with an exception
+ * set.
  */
-unsigned int
-cc_label(bitmask_t *input, unsigned int *image, unsigned int *ufind,
-         unsigned int *largest)
+static Py_ssize_t
+place_masks(PyObject *masks, PyObject *positions, placed_mask *placed)
 {
-    unsigned int *buf;
-    unsigned int x, y, w, h, root, aroot, croot, temp, label;
+    PyObject *item;
+    bitmask_t *mask;
+    Py_ssize_t loop, count = 0;
+    int x, y, result;
+
+    for (loop = 0; loop < PyTuple_GET_SIZE(masks); ++loop) {
+        item = PyTuple_GET_ITEM(masks, loop);
+        if (!PyObject_TypeCheck(item, &pgMask_Type)) {
+            PyErr_SetString(PyExc_TypeError, "masks must be Mask objects");
+            return -1;
+        }
+        mask = pgMask_AsBitmap(item);
 
-    label = 0;
-    w = input->w;
-    h = input->h;
+        item = PySequence_GetItem(positions, loop);
+        result = item && pg_TwoIntsFromObj(item, &x, &y);
+        Py_XDECREF(item);
+
+        if (!result) {
+            PyErr_SetString(PyExc_TypeError,
+                            "positions must be pairs of numbers");
+            return -1;
+        }
+        if (!mask->w || !mask->h) {
+            continue;
+        }
+        placed[count].mask = mask;
+        placed[count].x = x;
+        placed[count].y = y;
+        placed[count].x2 = x + mask->w;
+        placed[count].y2 = y + mask->h;
+        placed[count].index = loop;
+        ++count;
+    }
+    qsort(placed, count, sizeof(placed_mask), compare_placed_masks);
+    return count;
+}
 
-    ufind[0] = 0;
-    buf = image;
+/* Drops the masks in active[0..n) that end at or before x, returning the
+ * number left.
+ */
+static Py_ssize_t
+sweep_active(placed_mask **active, Py_ssize_t n, int x)
+{
+    Py_ssize_t loop, left = 0;
 
-    /* special case for first pixel */
-    if (bitmask_getbit(input, 0, 0)) { /* process for a new connected comp: */
-        label++;                       /* create a new label */
-        *buf = label;                  /* give the pixel the label */
-        ufind[label] = label; /* put the label in the equivalence array */
-        largest[label] = 1;   /* the label has 1 pixel associated with it */
+    for (loop = 0; loop < n; ++loop) {
+        if (active[loop]->x2 > x) {
+            active[left++] = active[loop];
+        }
     }
-    else {
-        *buf = 0;
+    return left;
+}
+
+/* Sweeps the n placed masks and the m other placed masks, both sorted by
+ * their left edges, testing each pair whose rectangles overlap. The index
+ * pairs of the masks that collide are stored in *pairs, reallocated as
+ * needed, with their number in *npairs. Runs without the GIL.
+ *
+ * Returns 0 if out of memory.
+ */
+static int
+collide_placed_masks(placed_mask *placed, Py_ssize_t n, placed_mask *others,
+                     Py_ssize_t m, Py_ssize_t **pairs, Py_ssize_t *npairs)
+{
+    placed_mask **active, **other_active, *cur, *cand;
+    Py_ssize_t i = 0, j = 0, nactive = 0, nother = 0, loop, allocated = 0;
+    Py_ssize_t *grown;
+    int is_other;
+
+    *npairs = 0;
+    active = (placed_mask **)PyMem_RawMalloc(
+        (size_t)(n + m + 1) * sizeof(placed_mask *));
+    if (!active) {
+        return 0;
     }
-    buf++;
+    other_active = active + n;
 
-    /* special case for first row.
-           Go over the first row except the first pixel.
-    */
-    for (x = 1; x < w; x++) {
-        if (bitmask_getbit(input, x, 0)) {
-            if (*(buf - 1)) { /* d label */
-                *buf = *(buf - 1);
+    while (i < n || j < m) {
+        is_other = i == n || (j < m && others[j].x < placed[i].x);
+        cur = is_other ? &others[j++] : &placed[i++];
+
+        /* cur pairs with every active mask of the other set still
+         * reaching across its left edge
+         */
+        if (is_other) {
+            nactive = sweep_active(active, nactive, cur->x);
+        }
+        else {
+            nother = sweep_active(other_active, nother, cur->x);
+        }
+        for (loop = 0; loop < (is_other ? nactive : nother); ++loop) {
+            cand = is_other ? active[loop] : other_active[loop];
+            if (cand->y >= cur->y2 || cur->y >= cand->y2) {
+                continue;
             }
-            else { /* create label */
-                label++;
-                *buf = label;
-                ufind[label] = label;
-                largest[label] = 0;
+            if (!bitmask_overlap(cur->mask, cand->mask, cand->x - cur->x,
+                                 cand->y - cur->y)) {
+                continue;
             }
-            largest[*buf]++;
+            if (*npairs == allocated) {
+                allocated = allocated ? allocated * 2 : 64;
+                grown = (Py_ssize_t *)PyMem_RawRealloc(
+                    *pairs, (size_t)allocated * 2 * sizeof(Py_ssize_t));
+                if (!grown) {
+                    PyMem_RawFree(active);
+                    return 0;
+                }
+                *pairs = grown;
+            }
+            (*pairs)[2 * *npairs] = is_other ? cand->index : cur->index;
+            (*pairs)[2 * *npairs + 1] = is_other ? cur->index : cand->index;
+            ++*npairs;
+        }
+        if (is_other) {
+            other_active[nother++] = cur;
         }
         else {
-            *buf = 0;
+            active[nactive++] = cur;
         }
-        buf++;
     }
+    PyMem_RawFree(active);
 
-    /* the rest of the image */
-    for (y = 1; y < h; y++) {
-        /* first pixel of the row */
-        if (bitmask_getbit(input, 0, y)) {
-            if (*(buf - w)) { /* b label */
-                *buf = *(buf - w);
-            }
-            else if (*(buf - w + 1)) { /* c label */
-                *buf = *(buf - w + 1);
-            }
-            else { /* create label */
-                label++;
-                *buf = label;
-                ufind[label] = label;
-                largest[label] = 0;
-            }
-            largest[*buf]++;
+    qsort(*pairs, *npairs, 2 * sizeof(Py_ssize_t), compare_index_pairs);
+    return 1;
+}
+
+/* Tests every mask of one group against every mask of another, with a
+ * sort and sweep of their rectangles to skip the pairs that are apart.
+ *
+ * Returns:
+ *     list of (index, other_index) tuples for the colliding pairs, or NULL
+ *     to indicate a fail
+ */
+static PyObject *
+mask_collide_many(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *masks, *positions, *other_masks, *other_positions;
+    PyObject *masks_tuple = NULL, *others_tuple = NULL, *ret = NULL, *item;
+    placed_mask *placed = NULL, *others = NULL;
+    Py_ssize_t n, m, *pairs = NULL, npairs = 0, loop;
+    int result = 1;
+    static char *keywords[] = {"masks", "positions", "other_masks",
+                               "other_positions", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOOO", keywords, &masks,
+                                     &positions, &other_masks,
+                                     &other_positions)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!PySequence_Check(positions) || !PySequence_Check(other_positions)) {
+        return RAISE(PyExc_TypeError,
+                     "positions must be sequences of number pairs");
+    }
+
+    /* the tuples keep the masks alive while the GIL is released */
+    masks_tuple = PySequence_Tuple(masks);
+    if (!masks_tuple) {
+        return NULL;
+    }
+    others_tuple = PySequence_Tuple(other_masks);
+    if (!others_tuple) {
+        goto end;
+    }
+
+    n = PyTuple_GET_SIZE(masks_tuple);
+    m = PyTuple_GET_SIZE(others_tuple);
+    if (PySequence_Length(positions) != n ||
+        PySequence_Length(other_positions) != m) {
+        PyErr_SetString(PyExc_ValueError,
+                        "each mask must have exactly one position");
+        goto end;
+    }
+
+    placed = PyMem_New(placed_mask, n + 1);
+    others = PyMem_New(placed_mask, m + 1);
+    if (!placed || !others) {
+        PyErr_NoMemory();
+        goto end;
+    }
+
+    n = place_masks(masks_tuple, positions, placed);
+    if (n < 0) {
+        goto end;
+    }
+    m = place_masks(others_tuple, other_positions, others);
+    if (m < 0) {
+        goto end;
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    result = collide_placed_masks(placed, n, others, m, &pairs, &npairs);
+    Py_END_ALLOW_THREADS;
+
+    if (!result) {
+        PyErr_NoMemory();
+        goto end;
+    }
+
+    ret = PyList_New(npairs);
+    if (!ret) {
+        goto end;
+    }
+    for (loop = 0; loop < npairs; ++loop) {
+        item = Py_BuildValue("(nn)", pairs[2 * loop], pairs[2 * loop + 1]);
+        if (!item) {
+            Py_CLEAR(ret);
+            goto end;
+        }
+        PyList_SET_ITEM(ret, loop, item);
+    }
+
+end:
+    PyMem_RawFree(pairs);
+    PyMem_Free(placed);
+    PyMem_Free(others);
+    Py_XDECREF(masks_tuple);
+    Py_XDECREF(others_tuple);
+    return ret;
+}
+
+/* A run of set bits of a mask, from x to x2 - 1 on row y. While labelling,
+ * label links it to an earlier run of the same connected component, or to
+ * itself for the first run of one. Once resolved, label is the number of
+ * its component, counting from 1, or 0 if the component was left out.
+ */
+typedef struct {
+    int x, x2, y;
+    unsigned int label;
+} cc_run;
+
+/* The pixel count and bounds of a connected component, along with the
+ * number it has after small components are left out.
+ */
+typedef struct {
+    unsigned int count, label;
+    int x, y, x2, y2;
+} cc_component;
+
+/* Will hang if there are no bits set in w! */
+static INLINE int
+lowest_set_bit(BITMASK_W w)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzl(w);
+#else
+    int i = 0;
+    while ((w & 1) == 0) {
+        i++;
+        w >>= 1;
+    }
+    return i;
+#endif
+}
+
+/* Sets the bits from x to x2 - 1 on row y of the mask, a word at a time. */
+static void
+cc_set_run(bitmask_t *m, int x, int x2, int y)
+{
+    BITMASK_W *word = m->bits + x / BITMASK_W_LEN * m->h + y;
+    int start = x & BITMASK_W_MASK, len;
+
+    bitmask_changed(m);
+    while (x < x2) {
+        len = MIN(x2 - x, (int)BITMASK_W_LEN - start);
+        if (len == (int)BITMASK_W_LEN) {
+            *word = ~(BITMASK_W)0;
         }
         else {
-            *buf = 0;
-        }
-        buf++;
-        /* middle pixels of the row */
-        for (x = 1; x < (w - 1); x++) {
-            if (bitmask_getbit(input, x, y)) {
-                if (*(buf - w)) { /* b label */
-                    *buf = *(buf - w);
+            *word |= (BITMASK_N(len) - 1) << start;
+        }
+        x += len;
+        start = 0;
+        word += m->h;
+    }
+}
+
+/* Links the components of runs a and b, keeping the one of the earlier
+ * run as the root so the roots stay in scan order.
+ */
+static void
+cc_union(cc_run *runs, unsigned int a, unsigned int b)
+{
+    while (runs[a].label != a) {
+        a = runs[a].label = runs[runs[a].label].label;
+    }
+    while (runs[b].label != b) {
+        b = runs[b].label = runs[runs[b].label].label;
+    }
+    if (a < b) {
+        runs[b].label = a;
+    }
+    else {
+        runs[a].label = b;
+    }
+}
+
+/* The labelling phase of the connected components algorithm.
+ *
+ * Rather than labelling each pixel, the set bits of each row are found as
+ * runs, a word at a time, and each run is joined to the runs of the row
+ * above that it touches, including diagonally, for 8-connected components.
+ * The equivalences are kept in a union-find over the runs.
+ *
+ * Params:
+ *     input - the input mask, with a width and height above 0
+ *     ret_runs - passes back the runs in scan order, memory is allocated
+ *     num_runs - passes back the number of runs
+ *
+ * Returns:
+ *     0 on success
+ *     -2 on memory allocation error
+ */
+static int
+cc_label(bitmask_t *input, cc_run **ret_runs, unsigned int *num_runs)
+{
+    cc_run *runs = NULL, *grown;
+    unsigned int n = 0, allocated = 0, above = 0, row, i, j, k;
+    int y, stripe, stripes, base, start, len;
+    BITMASK_W word, rest;
+
+    stripes = (input->w - 1) / BITMASK_W_LEN + 1;
+
+    for (y = 0; y < input->h; ++y) {
+        row = n; /* the first run of this row */
+
+        for (stripe = 0; stripe < stripes; ++stripe) {
+            word = input->bits[stripe * input->h + y];
+            base = stripe * BITMASK_W_LEN;
+
+            while (word) {
+                start = lowest_set_bit(word);
+                rest = ~(word >> start);
+                len = rest ? lowest_set_bit(rest)
+                           : (int)BITMASK_W_LEN - start;
+
+                if (n > row && runs[n - 1].x2 == base + start) {
+                    /* the run carries on from the stripe before */
+                    runs[n - 1].x2 += len;
                 }
-                else if (*(buf - w + 1)) { /* c branch of tree */
-                    if (*(buf - w - 1)) {  /* union(c, a) */
-                        croot = root = *(buf - w + 1);
-                        while (ufind[root] < root) { /* find root */
-                            root = ufind[root];
-                        }
-                        if (croot != *(buf - w - 1)) {
-                            temp = aroot = *(buf - w - 1);
-                            while (ufind[aroot] < aroot) { /* find root */
-                                aroot = ufind[aroot];
-                            }
-                            if (root > aroot) {
-                                root = aroot;
-                            }
-                            while (ufind[temp] > root) { /* set root */
-                                aroot = ufind[temp];
-                                ufind[temp] = root;
-                                temp = aroot;
-                            }
+                else {
+                    if (n == allocated) {
+                        allocated = allocated ? allocated * 2 : 256;
+                        grown = (cc_run *)realloc(runs,
+                                                  sizeof(cc_run) * allocated);
+                        if (!grown) {
+                            free(runs);
+                            return -2;
                         }
-                        while (ufind[croot] > root) { /* set root */
-                            temp = ufind[croot];
-                            ufind[croot] = root;
-                            croot = temp;
-                        }
-                        *buf = root;
+                        runs = grown;
                     }
-                    else if (*(buf - 1)) { /* union(c, d) */
-                        croot = root = *(buf - w + 1);
-                        while (ufind[root] < root) { /* find root */
-                            root = ufind[root];
-                        }
-                        if (croot != *(buf - 1)) {
-                            temp = aroot = *(buf - 1);
-                            while (ufind[aroot] < aroot) { /* find root */
-                                aroot = ufind[aroot];
-                            }
-                            if (root > aroot) {
-                                root = aroot;
-                            }
-                            while (ufind[temp] > root) { /* set root */
-                                aroot = ufind[temp];
-                                ufind[temp] = root;
-                                temp = aroot;
-                            }
-                        }
-                        while (ufind[croot] > root) { /* set root */
-                            temp = ufind[croot];
-                            ufind[croot] = root;
-                            croot = temp;
-                        }
-                        *buf = root;
-                    }
-                    else { /* c label */
-                        *buf = *(buf - w + 1);
-                    }
-                }
-                else if (*(buf - w - 1)) { /* a label */
-                    *buf = *(buf - w - 1);
-                }
-                else if (*(buf - 1)) { /* d label */
-                    *buf = *(buf - 1);
+                    runs[n].x = base + start;
+                    runs[n].x2 = base + start + len;
+                    runs[n].y = y;
+                    runs[n].label = n;
+                    ++n;
                 }
-                else { /* create label */
-                    label++;
-                    *buf = label;
-                    ufind[label] = label;
-                    largest[label] = 0;
-                }
-                largest[*buf]++;
-            }
-            else {
-                *buf = 0;
+
+                start += len;
+                word = (start < (int)BITMASK_W_LEN)
+                           ? word >> start << start
+                           : 0;
             }
-            buf++;
         }
-        /* last pixel of the row, if its not also the first pixel of the row */
-        if (w > 1) {
-            if (bitmask_getbit(input, x, y)) {
-                if (*(buf - w)) { /* b label */
-                    *buf = *(buf - w);
-                }
-                else if (*(buf - w - 1)) { /* a label */
-                    *buf = *(buf - w - 1);
-                }
-                else if (*(buf - 1)) { /* d label */
-                    *buf = *(buf - 1);
+
+        /* join each run to those of the row above that touch it, both rows
+         * being in order of x
+         */
+        if (row && runs[row - 1].y == y - 1) {
+            for (i = above, j = row; j < n; ++j) {
+                while (i < row && runs[i].x2 < runs[j].x) {
+                    ++i;
                 }
-                else { /* create label */
-                    label++;
-                    *buf = label;
-                    ufind[label] = label;
-                    largest[label] = 0;
+                for (k = i; k < row && runs[k].x <= runs[j].x2; ++k) {
+                    cc_union(runs, k, j);
                 }
-                largest[*buf]++;
             }
-            else {
-                *buf = 0;
+        }
+        above = row;
+    }
+
+    *ret_runs = runs;
+    *num_runs = n;
+    return 0;
+}
+
+/* Numbers the connected components of the labelled runs in scan order and
+ * finds their pixel counts and bounds, leaving out those with fewer than
+ * min pixels.
+ *
+ * Params:
+ *     runs - the runs from cc_label(), their labels are resolved to the
+ *         component numbers
+ *     num_runs - the number of runs
+ *     min - minimum number of pixels for a component to be kept
+ *     ret_comps - passes back the kept components with the first at
+ *         index 1, memory is allocated
+ *
+ * Returns:
+ *     the number of components kept (>= 0)
+ *     -2 on memory allocation error
+ */
+static int
+cc_resolve(cc_run *runs, unsigned int num_runs, unsigned int min,
+           cc_component **ret_comps)
+{
+    cc_component *comps, *comp;
+    unsigned int i, label = 0, kept = 0;
+
+    /* each run links to an earlier one, so its root is already numbered */
+    for (i = 0; i < num_runs; ++i) {
+        runs[i].label =
+            (runs[i].label == i) ? ++label : runs[runs[i].label].label;
+    }
+
+    comps = (cc_component *)malloc(sizeof(cc_component) * (label + 1));
+    if (!comps) {
+        return -2;
+    }
+    comps[0].label = 0;
+    for (i = 1; i <= label; ++i) {
+        comps[i].count = 0;
+    }
+
+    for (i = 0; i < num_runs; ++i) {
+        comp = comps + runs[i].label;
+        if (!comp->count) {
+            comp->x = runs[i].x;
+            comp->y = runs[i].y;
+            comp->x2 = runs[i].x2;
+        }
+        comp->x = MIN(comp->x, runs[i].x);
+        comp->x2 = MAX(comp->x2, runs[i].x2);
+        comp->y2 = runs[i].y + 1;
+        comp->count += runs[i].x2 - runs[i].x;
+    }
+
+    for (i = 1; i <= label; ++i) {
+        comps[i].label = (comps[i].count >= min) ? ++kept : 0;
+    }
+    if (kept < label) {
+        /* renumber the runs, then move the kept components down */
+        for (i = 0; i < num_runs; ++i) {
+            runs[i].label = comps[runs[i].label].label;
+        }
+        for (i = 1; i <= label; ++i) {
+            if (comps[i].label) {
+                comps[comps[i].label] = comps[i];
             }
-            buf++;
         }
     }
 
-    return label;
+    *ret_comps = comps;
+    return (int)kept;
 }
 
 /* Creates a bounding rect for each connected component in the given mask.
@@ -1356,113 +2209,47 @@ static int
 get_bounding_rects(bitmask_t *input, int *num_bounding_boxes,
                    SDL_Rect **ret_rects)
 {
-    unsigned int *image, *ufind, *largest, *buf;
-    unsigned int x_uf, label = 0;
-    int x, y, w, h, temp, relabel;
-    SDL_Rect *rects;
+    cc_run *runs;
+    cc_component *comps;
+    unsigned int num_runs;
+    int i, num;
+    SDL_Rect *rects = NULL;
 
-    rects = NULL;
-
-    w = input->w;
-    h = input->h;
+    *num_bounding_boxes = 0;
+    *ret_rects = rects;
 
-    if (!w || !h) {
-        *ret_rects = rects;
+    if (!input->w || !input->h) {
         return 0;
     }
-    /* a temporary image to assign labels to each bit of the mask */
-    image = (unsigned int *)malloc(sizeof(unsigned int) * w * h);
-    if (!image) {
-        return -2;
-    }
 
-    /* allocate enough space for the maximum possible connected components */
-    /* the union-find array. see wikipedia for info on union find */
-    ufind = (unsigned int *)malloc(sizeof(unsigned int) * (w / 2 + 1) *
-                                   (h / 2 + 1));
-    if (!ufind) {
-        free(image);
+    if (cc_label(input, &runs, &num_runs) == -2) {
         return -2;
     }
 
-    largest = (unsigned int *)malloc(sizeof(unsigned int) * (w / 2 + 1) *
-                                     (h / 2 + 1));
-    if (!largest) {
-        free(image);
-        free(ufind);
+    num = cc_resolve(runs, num_runs, 0, &comps);
+    free(runs);
+    if (num == -2) {
         return -2;
     }
 
-    /* do the initial labelling */
-    label = cc_label(input, image, ufind, largest);
-
-    relabel = 0;
-    /* flatten and relabel the union-find equivalence array.  Start at label 1
-       because label 0 indicates an unset pixel.  For this reason, we also use
-       <= label rather than < label. */
-    for (x_uf = 1; x_uf <= label; ++x_uf) {
-        if (ufind[x_uf] < x_uf) {             /* is it a union find root? */
-            ufind[x_uf] = ufind[ufind[x_uf]]; /* relabel it to its root */
+    if (num) {
+        /* the bounding rects, need enough space for the number of labels */
+        rects = (SDL_Rect *)malloc(sizeof(SDL_Rect) * (num + 1));
+        if (!rects) {
+            free(comps);
+            return -2;
         }
-        else { /* its a root */
-            relabel++;
-            ufind[x_uf] = relabel; /* assign the lowest label available */
-        }
-    }
-
-    *num_bounding_boxes = relabel;
-
-    if (relabel == 0) {
-        /* early out, as we didn't find anything. */
-        free(image);
-        free(ufind);
-        free(largest);
-        *ret_rects = rects;
-        return 0;
-    }
 
-    /* the bounding rects, need enough space for the number of labels */
-    rects = (SDL_Rect *)malloc(sizeof(SDL_Rect) * (relabel + 1));
-    if (!rects) {
-        free(image);
-        free(ufind);
-        free(largest);
-        return -2;
-    }
-
-    for (temp = 0; temp <= relabel; temp++) {
-        rects[temp].h = 0; /* so we know if its a new rect or not */
-    }
-
-    /* find the bounding rect of each connected component */
-    buf = image;
-    for (y = 0; y < h; y++) {
-        for (x = 0; x < w; x++) {
-            if (ufind[*buf]) { /* if the pixel is part of a component */
-                if (rects[ufind[*buf]].h) { /* the component has a rect */
-                    temp = rects[ufind[*buf]].x;
-                    rects[ufind[*buf]].x = MIN(x, temp);
-                    rects[ufind[*buf]].y = MIN(y, rects[ufind[*buf]].y);
-                    rects[ufind[*buf]].w =
-                        MAX(rects[ufind[*buf]].w + temp, x + 1) -
-                        rects[ufind[*buf]].x;
-                    rects[ufind[*buf]].h = MAX(rects[ufind[*buf]].h,
-                                               y - rects[ufind[*buf]].y + 1);
-                }
-                else { /* otherwise, start the rect */
-                    rects[ufind[*buf]].x = x;
-                    rects[ufind[*buf]].y = y;
-                    rects[ufind[*buf]].w = 1;
-                    rects[ufind[*buf]].h = 1;
-                }
-            }
-            buf++;
+        for (i = 1; i <= num; ++i) {
+            rects[i].x = comps[i].x;
+            rects[i].y = comps[i].y;
+            rects[i].w = comps[i].x2 - comps[i].x;
+            rects[i].h = comps[i].y2 - comps[i].y;
         }
     }
 
-    free(image);
-    free(ufind);
-    free(largest);
+    free(comps);
+    *num_bounding_boxes = num;
     *ret_rects = rects;
 
     return 0;
@@ -1554,111 +2341,63 @@ mask_get_bounding_rects(PyObject *self, PyObject *_null)
 static int
 get_connected_components(bitmask_t *mask, bitmask_t ***components, int min)
 {
-    unsigned int *image, *ufind, *largest, *buf;
-    unsigned int x_uf, min_cc, label = 0;
-    int x, y, w, h, relabel;
-    bitmask_t **comps;
+    cc_run *runs;
+    cc_component *comps = NULL;
+    unsigned int num_runs, i;
+    int x, num;
+    bitmask_t **masks;
 
-    w = mask->w;
-    h = mask->h;
-
-    if (!w || !h) {
+    if (!mask->w || !mask->h) {
         return 0;
     }
 
-    /* a temporary image to assign labels to each bit of the mask */
-    image = (unsigned int *)malloc(sizeof(unsigned int) * w * h);
-    if (!image) {
+    if (cc_label(mask, &runs, &num_runs) == -2) {
         return -2;
     }
 
-    /* allocate enough space for the maximum possible connected components */
-    /* the union-find array. see wikipedia for info on union find */
-    ufind = (unsigned int *)malloc(sizeof(unsigned int) * (w / 2 + 1) *
-                                   (h / 2 + 1));
-    if (!ufind) {
-        free(image);
-        return -2;
-    }
-
-    largest = (unsigned int *)malloc(sizeof(unsigned int) * (w / 2 + 1) *
-                                     (h / 2 + 1));
-    if (!largest) {
-        free(image);
-        free(ufind);
-        return -2;
-    }
-
-    /* do the initial labelling */
-    label = cc_label(mask, image, ufind, largest);
-
-    for (x_uf = 1; x_uf <= label; ++x_uf) {
-        if (ufind[x_uf] < x_uf) {
-            largest[ufind[x_uf]] += largest[x_uf];
-        }
-    }
-
-    relabel = 0;
-    min_cc = (0 < min) ? (unsigned int)min : 0;
+    num = cc_resolve(runs, num_runs, (0 < min) ? (unsigned int)min : 0,
+                     &comps);
+    free(comps);
 
-    /* flatten and relabel the union-find equivalence array.  Start at label 1
-       because label 0 indicates an unset pixel.  For this reason, we also use
-       <= label rather than < label. */
-    for (x_uf = 1; x_uf <= label; ++x_uf) {
-        if (ufind[x_uf] < x_uf) {             /* is it a union find root? */
-            ufind[x_uf] = ufind[ufind[x_uf]]; /* relabel it to its root */
-        }
-        else { /* its a root */
-            if (largest[x_uf] >= min_cc) {
-                relabel++;
-                ufind[x_uf] = relabel; /* assign the lowest label available */
-            }
-            else {
-                ufind[x_uf] = 0;
-            }
-        }
-    }
-
-    if (relabel == 0) {
+    if (num <= 0) {
         /* early out, as we didn't find anything. */
-        free(image);
-        free(ufind);
-        free(largest);
-        return 0;
+        free(runs);
+        return num;
     }
 
     /* allocate space for the mask array */
-    comps = (bitmask_t **)malloc(sizeof(bitmask_t *) * (relabel + 1));
-    if (!comps) {
-        free(image);
-        free(ufind);
-        free(largest);
+    masks = (bitmask_t **)malloc(sizeof(bitmask_t *) * (num + 1));
+    if (!masks) {
+        free(runs);
         return -2;
     }
 
     /* create the empty masks */
-    for (x = 1; x <= relabel; x++) {
-        comps[x] = bitmask_create(w, h);
+    for (x = 1; x <= num; x++) {
+        masks[x] = bitmask_create(mask->w, mask->h);
+        if (!masks[x]) {
+            while (--x > 0) {
+                bitmask_free(masks[x]);
+            }
+            free(masks);
+            free(runs);
+            return -2;
+        }
     }
 
-    /* set the bits in each mask */
-    buf = image;
-    for (y = 0; y < h; y++) {
-        for (x = 0; x < w; x++) {
-            if (ufind[*buf]) { /* if the pixel is part of a component */
-                bitmask_setbit(comps[ufind[*buf]], x, y);
-            }
-            buf++;
+    /* set the runs of each component in its mask */
+    for (i = 0; i < num_runs; ++i) {
+        if (runs[i].label) {
+            cc_set_run(masks[runs[i].label], runs[i].x, runs[i].x2,
+                       runs[i].y);
         }
     }
 
-    free(image);
-    free(ufind);
-    free(largest);
+    free(runs);
 
-    *components = comps;
+    *components = masks;
 
-    return relabel;
+    return num;
 }
 
 static PyObject *
@@ -1751,69 +2490,53 @@ mask_connected_components(PyObject *self, PyObject *args, PyObject *kwargs)
 static int
 largest_connected_comp(bitmask_t *input, bitmask_t *output, int ccx, int ccy)
 {
-    unsigned int *image, *ufind, *largest, *buf;
-    unsigned int max, x, y, w, h, label;
+    cc_run *runs;
+    cc_component *comps;
+    unsigned int num_runs, i, max;
+    int num;
 
-    w = input->w;
-    h = input->h;
-
-    if (!w || !h) {
+    if (!input->w || !input->h) {
         return 0;
     }
 
-    /* a temporary image to assign labels to each bit of the mask */
-    image = (unsigned int *)malloc(sizeof(unsigned int) * w * h);
-    if (!image) {
-        return -2;
-    }
-    /* allocate enough space for the maximum possible connected components */
-    /* the union-find array. see wikipedia for info on union find */
-    ufind = (unsigned int *)malloc(sizeof(unsigned int) * (w / 2 + 1) *
-                                   (h / 2 + 1));
-    if (!ufind) {
-        free(image);
+    if (cc_label(input, &runs, &num_runs) == -2) {
         return -2;
     }
-    /* an array to track the number of pixels associated with each label */
-    largest = (unsigned int *)malloc(sizeof(unsigned int) * (w / 2 + 1) *
-                                     (h / 2 + 1));
-    if (!largest) {
-        free(image);
-        free(ufind);
+
+    num = cc_resolve(runs, num_runs, 0, &comps);
+    if (num == -2) {
+        free(runs);
         return -2;
     }
 
-    /* do the initial labelling */
-    label = cc_label(input, image, ufind, largest);
-
-    max = 1;
-    /* flatten the union-find equivalence array */
-    for (x = 2; x <= label; x++) {
-        if (ufind[x] != x) {                 /* is it a union find root? */
-            largest[ufind[x]] += largest[x]; /* add its pixels to its root */
-            ufind[x] = ufind[ufind[x]];      /* relabel it to its root */
+    max = 0;
+    if (ccx >= 0) {
+        /* the component of the run holding the given pixel */
+        for (i = 0; i < num_runs; ++i) {
+            if (runs[i].y == ccy && runs[i].x <= ccx && ccx < runs[i].x2) {
+                max = runs[i].label;
+                break;
+            }
         }
-        if (largest[ufind[x]] > largest[max]) { /* is it the new biggest? */
-            max = ufind[x];
+    }
+    else {
+        /* the biggest component, the first one found on a tie */
+        for (i = 1; i <= (unsigned int)num; ++i) {
+            if (!max || comps[i].count > comps[max].count) {
+                max = i;
+            }
         }
     }
 
-    /* write out the final image */
-    buf = image;
-    if (ccx >= 0)
-        max = ufind[*(buf + ccy * w + ccx)];
-    for (y = 0; y < h; y++) {
-        for (x = 0; x < w; x++) {
-            if (ufind[*buf] == max) {         /* if the label is the max one */
-                bitmask_setbit(output, x, y); /* set the bit in the mask */
-            }
-            buf++;
+    /* write out the runs of the chosen component */
+    for (i = 0; max && i < num_runs; ++i) {
+        if (runs[i].label == max) {
+            cc_set_run(output, runs[i].x, runs[i].x2, runs[i].y);
         }
     }
 
-    free(image);
-    free(ufind);
-    free(largest);
+    free(runs);
+    free(comps);
 
     return 0;
 }
@@ -1924,6 +2647,83 @@ extract_color(SDL_Surface *surf, PyObject *color_obj, Uint8 rgba_color[],
     return 0; /* Exception already set. */
 }
 
+/* Fills n 32 bit pixels from src, or with color if src is NULL. */
+static PG_INLINE void
+fill_row_32(Uint32 *pixel, int n, const Uint32 *src, Uint32 color)
+{
+    int i;
+
+    if (src) {
+        memcpy(pixel, src, n * sizeof(Uint32));
+    }
+    else {
+        for (i = 0; i < n; ++i) {
+            pixel[i] = color;
+        }
+    }
+}
+
+/* Draws n bits of row ym of a mask, from bit xm, onto a row of 32 bit
+ * pixels, walking the mask a word at a time. Words that are all set or all
+ * unset are filled in one go. In the others the bits are found by counting
+ * trailing zeros, with the set bits written over an unset fill. The colors
+ * for set and unset bits come from setpixel and unsetpixel when they are
+ * non-NULL, which are then rows of pixels lined up with the mask bits, or
+ * else from setcolor and unsetcolor.
+ */
+static void
+draw_row_32(Uint32 *pixel, bitmask_t *bitmask, int xm, int ym, int n,
+            int draw_setbits, int draw_unsetbits, const Uint32 *setpixel,
+            const Uint32 *unsetpixel, Uint32 setcolor, Uint32 unsetcolor)
+{
+    const BITMASK_W *word;
+    BITMASK_W bits, full;
+    int i, len, shift;
+
+    while (n > 0) {
+        word = bitmask->bits + xm / BITMASK_W_LEN * bitmask->h + ym;
+        shift = xm & BITMASK_W_MASK;
+        len = MIN(n, (int)BITMASK_W_LEN - shift);
+        full = (len < (int)BITMASK_W_LEN) ? BITMASK_N(len) - 1
+                                          : ~(BITMASK_W)0;
+        bits = (*word >> shift) & full;
+
+        if (bits == full || !bits) {
+            if (bits ? draw_setbits : draw_unsetbits) {
+                fill_row_32(pixel, len, bits ? setpixel : unsetpixel,
+                            bits ? setcolor : unsetcolor);
+            }
+        }
+        else if (draw_setbits) {
+            if (draw_unsetbits) {
+                fill_row_32(pixel, len, unsetpixel, unsetcolor);
+            }
+            /* overwrite the set bits, one at a time */
+            while (bits) {
+                i = lowest_set_bit(bits);
+                pixel[i] = setpixel ? setpixel[i] : setcolor;
+                bits &= bits - 1;
+            }
+        }
+        else if (draw_unsetbits) {
+            for (bits = ~bits & full; bits; bits &= bits - 1) {
+                i = lowest_set_bit(bits);
+                pixel[i] = unsetpixel ? unsetpixel[i] : unsetcolor;
+            }
+        }
+
+        pixel += len;
+        if (setpixel) {
+            setpixel += len;
+        }
+        if (unsetpixel) {
+            unsetpixel += len;
+        }
+        xm += len;
+        n -= len;
+    }
+}
+
 /* Draws a mask on a surface.
  *
  * Params:
@@ -1984,6 +2784,17 @@ draw_to_surface(SDL_Surface *surf, bitmask_t *bitmask, int x_dest, int y_dest,
         draw_setbits = draw_setbits && NULL != setcolor;
         draw_unsetbits = draw_unsetbits && NULL != unsetcolor;
 
+        if (bpp == 4) {
+            for (y = y_start, ym = ym_start; y < y_end; ++y, ++ym) {
+                pixel = (Uint8 *)surf->pixels + y * surf->pitch + x_start * 4;
+                draw_row_32((Uint32 *)pixel, bitmask, xm_start, ym,
+                            x_end - x_start, draw_setbits, draw_unsetbits,
+                            NULL, NULL, draw_setbits ? *setcolor : 0,
+                            draw_unsetbits ? *unsetcolor : 0);
+            }
+            return;
+        }
+
         for (y = y_start, ym = ym_start; y < y_end; ++y, ++ym) {
             pixel = (Uint8 *)surf->pixels + y * surf->pitch + x_start * bpp;
 
@@ -2015,6 +2826,13 @@ draw_to_surface(SDL_Surface *surf, bitmask_t *bitmask, int x_dest, int y_dest,
             unsetpixel = (Uint8 *)unsetsurf->pixels + ym * unsetsurf->pitch +
                          xm_start * bpp;
 
+            if (bpp == 4) {
+                draw_row_32((Uint32 *)pixel, bitmask, xm_start, ym,
+                            x_end - x_start, draw_setbits, draw_unsetbits,
+                            (Uint32 *)setpixel, (Uint32 *)unsetpixel, 0, 0);
+                continue;
+            }
+
             for (x = x_start, xm = xm_start; x < x_end;
                  ++x, ++xm, pixel += bpp, setpixel += bpp, unsetpixel += bpp) {
                 if (bitmask_getbit(bitmask, xm, ym)) {
@@ -2350,6 +3168,12 @@ static PyMethodDef mask_methods[] = {
      DOC_MASKOUTLINE},
     {"convolve", (PyCFunction)mask_convolve, METH_VARARGS | METH_KEYWORDS,
      DOC_MASKCONVOLVE},
+    {"dilate", (PyCFunction)mask_dilate, METH_VARARGS | METH_KEYWORDS,
+     DOC_MASKDILATE},
+    {"erode", (PyCFunction)mask_erode, METH_VARARGS | METH_KEYWORDS,
+     DOC_MASKERODE},
+    {"distance_transform", mask_distance_transform, METH_NOARGS,
+     DOC_MASKDISTANCETRANSFORM},
     {"connected_component", (PyCFunction)mask_connected_component,
      METH_VARARGS | METH_KEYWORDS, DOC_MASKCONNECTEDCOMPONENT},
     {"connected_components", (PyCFunction)mask_connected_components,
@@ -2414,6 +3238,8 @@ mask_dealloc(PyObject *self)
         bitmask_free(bitmask);
     }
 
+    Py_XDECREF(((pgMaskObject *)self)->outline);
+
     /* Free up the mask. */
     Py_TYPE(self)->tp_free(self);
 }
@@ -2435,6 +3261,7 @@ mask_new(PyTypeObject *subtype, PyObject *args, PyObject *kwargs)
     }
 
     maskobj->mask = NULL;
+    maskobj->outline = NULL;
     return (PyObject *)maskobj;
 }
 
@@ -2477,6 +3304,7 @@ mask_init(PyObject *self, PyObject *args, PyObject *kwargs)
     }
 
     ((pgMaskObject *)self)->mask = bitmask;
+    Py_CLEAR(((pgMaskObject *)self)->outline);
     return 0;
 }
 
@@ -2512,6 +3340,9 @@ pgMask_GetBuffer(pgMaskObject *self, Py_buffer *view, int flags)
         bufinfo->numbufs++;
     }
 
+    /* the bits can be changed through the buffer, so bitmask_bounds()
+     * rescans them while it is held */
+    m->exported++;
     view->buf = m->bits;
     view->len = m->h * ((m->w - 1) / BITMASK_W_LEN + 1) * sizeof(BITMASK_W);
     view->readonly = 0;
@@ -2539,6 +3370,8 @@ pgMask_ReleaseBuffer(pgMaskObject *self, Py_buffer *view)
 {
     mask_bufinfo *bufinfo = (mask_bufinfo *)view->internal;
 
+    self->mask->exported--;
+    bitmask_changed(self->mask);
     bufinfo->numbufs--;
     if (bufinfo->numbufs == 0) {
         PyMem_RawFree(bufinfo);
@@ -2568,6 +3401,8 @@ static PyMethodDef _mask_methods[] = {
      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEMASKFROMSURFACE},
     {"from_threshold", (PyCFunction)mask_from_threshold,
      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEMASKFROMTHRESHOLD},
+    {"collide_many", (PyCFunction)mask_collide_many,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEMASKCOLLIDEMANY},
     {NULL, NULL, 0, NULL}};
 
 MODINIT_DEFINE(mask)
@@ -2604,6 +3439,10 @@ MODINIT_DEFINE(mask)
     if (PyErr_Occurred()) {
         return NULL;
     }
+    import_pygame_bufferproxy();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
 
     /* create the mask type */
     if (PyType_Ready(&pgMask_Type) < 0) {
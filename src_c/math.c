@@ -27,7 +27,6 @@
 #endif
 
 #define PYGAMEAPI_MATH_INTERNAL
-#define NO_PYGAME_C_API
 #include "doc/math_doc.h"
 
 #include "pygame.h"
@@ -36,11 +35,28 @@
 
 #include "pgcompat.h"
 
+#include "pgfreelist.h"
+
 #include <float.h>
 #include <math.h>
 #include <stddef.h>
 #include <string.h>
 
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+// arm64 has neon optimisations enabled by default, even when fpu=neon is not
+// passed
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+#if defined(PG_ENABLE_ARM_NEON)
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "include/sse2neon.h"
+#define MATH_SIMD
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define MATH_SIMD
+#endif
+
 /* on some windows platforms math.h doesn't define M_PI */
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -108,6 +124,10 @@ typedef struct {
     PyObject_HEAD pgVector *vec;
 } vector_elementwiseproxy;
 
+/* Deallocated Vector2 and Vector3 objects, kept with their coords. */
+static pgFreeList vector2_freelist;
+static pgFreeList vector3_freelist;
+
 /* further forward declarations */
 /* generic helper functions */
 static int
@@ -576,6 +596,14 @@ pgVector_NEW(Py_ssize_t dim)
 static void
 vector_dealloc(pgVector *self)
 {
+    if (Py_TYPE(self) == &pgVector2_Type &&
+        pgFreeList_Push(&vector2_freelist, (PyObject *)self)) {
+        return;
+    }
+    if (Py_TYPE(self) == &pgVector3_Type &&
+        pgFreeList_Push(&vector3_freelist, (PyObject *)self)) {
+        return;
+    }
     PyMem_Free(self->coords);
     Py_TYPE(self)->tp_free((PyObject *)self);
 }
@@ -584,13 +612,52 @@ vector_dealloc(pgVector *self)
  * Generic vector PyNumber emulation routines
  **********************************************/
 
+/* Reads the coordinates of a Vector of the exact type for dim, or of an
+ * exact tuple or list of dim exact ints or floats, without running any
+ * Python code. Returns 0 for anything else, or for an int too large for a
+ * double, to be read the slow way.
+ */
+static int
+_vector_coords_from_exact(PyObject *obj, double *coords, Py_ssize_t dim)
+{
+    PyObject **items, *item;
+    Py_ssize_t i;
+
+    if (Py_TYPE(obj) == (dim == 2 ? &pgVector2_Type : &pgVector3_Type)) {
+        memcpy(coords, ((pgVector *)obj)->coords, sizeof(double) * dim);
+        return 1;
+    }
+    if (!(PyTuple_CheckExact(obj) || PyList_CheckExact(obj)) ||
+        PySequence_Fast_GET_SIZE(obj) != dim) {
+        return 0;
+    }
+    items = PySequence_Fast_ITEMS(obj);
+    for (i = 0; i < dim; ++i) {
+        item = items[i];
+        if (PyFloat_CheckExact(item)) {
+            coords[i] = PyFloat_AS_DOUBLE(item);
+        }
+        else if (PyLong_CheckExact(item)) {
+            coords[i] = PyLong_AsDouble(item);
+            if (coords[i] == -1.0 && PyErr_Occurred()) {
+                PyErr_Clear();
+                return 0;
+            }
+        }
+        else {
+            return 0;
+        }
+    }
+    return 1;
+}
+
 static PyObject *
 vector_generic_math(PyObject *o1, PyObject *o2, int op)
 {
     Py_ssize_t i, dim;
     double *vec_coords;
     double other_coords[VECTOR_MAX_SIZE] = {0};
-    double tmp;
+    double tmp, number = 0.;
     PyObject *other;
     pgVector *vec, *ret = NULL;
     if (pgVector_Check(o1)) {
@@ -611,13 +678,32 @@ vector_generic_math(PyObject *o1, PyObject *o2, int op)
         return NULL;
     }
 
-    if (pgVectorCompatible_Check(other, dim)) {
+    /* exact floats, ints, vectors and tuples are read without the number
+     * and sequence protocols */
+    if (PyFloat_CheckExact(other)) {
+        op |= OP_ARG_NUMBER;
+        number = PyFloat_AS_DOUBLE(other);
+    }
+    else if (PyLong_CheckExact(other)) {
+        op |= OP_ARG_NUMBER;
+        number = PyLong_AsDouble(other);
+        if (number == -1.0 && PyErr_Occurred())
+            return NULL;
+    }
+    else if (_vector_coords_from_exact(other, other_coords, dim)) {
+        op |= OP_ARG_VECTOR;
+    }
+    else if (pgVectorCompatible_Check(other, dim)) {
         op |= OP_ARG_VECTOR;
         if (!PySequence_AsVectorCoords(other, other_coords, dim))
             return NULL;
     }
-    else if (RealNumber_Check(other))
+    else if (RealNumber_Check(other)) {
         op |= OP_ARG_NUMBER;
+        number = PyFloat_AsDouble(other);
+        if (number == -1.0 && PyErr_Occurred())
+            return NULL;
+    }
     else
         op |= OP_ARG_UNKNOWN;
 
@@ -658,13 +744,13 @@ vector_generic_math(PyObject *o1, PyObject *o2, int op)
         case OP_MUL | OP_ARG_NUMBER:
         case OP_MUL | OP_ARG_NUMBER | OP_ARG_REVERSE:
         case OP_MUL | OP_ARG_NUMBER | OP_INPLACE:
-            tmp = PyFloat_AsDouble(other);
+            tmp = number;
             for (i = 0; i < dim; i++)
                 ret->coords[i] = vec_coords[i] * tmp;
             break;
         case OP_DIV | OP_ARG_NUMBER:
         case OP_DIV | OP_ARG_NUMBER | OP_INPLACE:
-            tmp = PyFloat_AsDouble(other);
+            tmp = number;
             if (tmp == 0.) {
                 PyErr_SetString(PyExc_ZeroDivisionError, "division by zero");
                 Py_DECREF(ret);
@@ -676,7 +762,7 @@ vector_generic_math(PyObject *o1, PyObject *o2, int op)
             break;
         case OP_FLOOR_DIV | OP_ARG_NUMBER:
         case OP_FLOOR_DIV | OP_ARG_NUMBER | OP_INPLACE:
-            tmp = PyFloat_AsDouble(other);
+            tmp = number;
             if (tmp == 0.) {
                 PyErr_SetString(PyExc_ZeroDivisionError, "division by zero");
                 Py_DECREF(ret);
@@ -2039,7 +2125,16 @@ static PyBufferProcs vector_as_buffer = {
 static PyObject *
 vector2_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
-    pgVector *vec = (pgVector *)type->tp_alloc(type, 0);
+    pgVector *vec;
+
+    if (type == &pgVector2_Type) {
+        vec = (pgVector *)pgFreeList_Pop(&vector2_freelist, type);
+        if (vec != NULL) {
+            vec->epsilon = VECTOR_EPSILON;
+            return (PyObject *)vec;
+        }
+    }
+    vec = (pgVector *)type->tp_alloc(type, 0);
 
     if (vec != NULL) {
         vec->dim = 2;
@@ -2467,7 +2562,16 @@ static PyTypeObject pgVector2_Type = {
 static PyObject *
 vector3_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
-    pgVector *vec = (pgVector *)type->tp_alloc(type, 0);
+    pgVector *vec;
+
+    if (type == &pgVector3_Type) {
+        vec = (pgVector *)pgFreeList_Pop(&vector3_freelist, type);
+        if (vec != NULL) {
+            vec->epsilon = VECTOR_EPSILON;
+            return (PyObject *)vec;
+        }
+    }
+    vec = (pgVector *)type->tp_alloc(type, 0);
 
     if (vec != NULL) {
         vec->dim = 3;
@@ -4047,68 +4151,1722 @@ vector_elementwise(pgVector *vec, PyObject *_null)
     return (PyObject *)proxy;
 }
 
+/*******************************************************
+ * Vector2Array and Vector3Array
+ *******************************************************/
+
+/* VectorArray: the coordinates of many vectors of one dimension stored one
+ * after another, with operations done over all of them in plain loops. The
+ * coordinates can be shared through the buffer interface as a (length, dim)
+ * array of doubles, and the array cannot change length while they are.
+ */
+typedef struct {
+    PyObject_HEAD double *coords; /* count * dim coordinates */
+    Py_ssize_t dim;
+    Py_ssize_t count, size;
+    Py_ssize_t exports;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+} pgVectorArray;
+
+static PyTypeObject pgVector2Array_Type;
+static PyTypeObject pgVector3Array_Type;
+
+#define pgVectorArray_Check(x)                                \
+    (PyType_IsSubtype(Py_TYPE(x), &pgVector2Array_Type) || \
+     PyType_IsSubtype(Py_TYPE(x), &pgVector3Array_Type))
+
+/* Makes room for count vectors in self. Returns 0 on success, -1 with an
+ * exception set on failure.
+ */
+static int
+_vectorarray_resize(pgVectorArray *self, Py_ssize_t count)
+{
+    double *coords;
+    Py_ssize_t size;
+
+    if (self->exports) {
+        PyErr_SetString(PyExc_BufferError,
+                        "cannot resize a vector array while it is exported");
+        return -1;
+    }
+    if (count > self->size) {
+        size = MAX(count, self->size * 2);
+        if (size > PY_SSIZE_T_MAX / (Py_ssize_t)sizeof(double) / self->dim) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        coords = PyMem_Realloc(self->coords, sizeof(double) * self->dim * size);
+        if (!coords) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        self->coords = coords;
+        self->size = size;
+    }
+    self->count = count;
+    return 0;
+}
+
+/* Returns a new array of count vectors, of the same dimension as like. The
+ * coordinates are not set.
+ */
+static pgVectorArray *
+_vectorarray_new_like(pgVectorArray *like, Py_ssize_t count)
+{
+    PyTypeObject *type =
+        like->dim == 2 ? &pgVector2Array_Type : &pgVector3Array_Type;
+    pgVectorArray *array = (pgVectorArray *)type->tp_alloc(type, 0);
+
+    if (!array) {
+        return NULL;
+    }
+    array->dim = like->dim;
+    if (_vectorarray_resize(array, count)) {
+        Py_DECREF(array);
+        return NULL;
+    }
+    return array;
+}
+
+/* Reads other as the second operand of an operation on self. Another array
+ * of the same dimension gives its coordinates, with a step of dim between
+ * vectors, and must be as long as self. A single vector is copied to buf
+ * and given with a step of 0, so that it is used for every vector of self.
+ * Returns 1 on success, 0 if other is not a vector operand and -1 with an
+ * exception set on failure.
+ */
+static int
+_vectorarray_operand(pgVectorArray *self, PyObject *other,
+                     const double **coords, Py_ssize_t *step, double *buf)
+{
+    pgVectorArray *array;
+
+    if (pgVectorArray_Check(other)) {
+        array = (pgVectorArray *)other;
+        if (array->dim != self->dim) {
+            return 0;
+        }
+        if (array->count != self->count) {
+            PyErr_SetString(PyExc_ValueError,
+                            "vector arrays must be of the same length");
+            return -1;
+        }
+        *coords = array->coords;
+        *step = self->dim;
+        return 1;
+    }
+    if (!pgVectorCompatible_Check(other, self->dim)) {
+        return 0;
+    }
+    if (!PySequence_AsVectorCoords(other, buf, self->dim)) {
+        return -1;
+    }
+    *coords = buf;
+    *step = 0;
+    return 1;
+}
+
+/* As _vectorarray_operand, with a TypeError if other is not a vector. */
+static int
+_vectorarray_vector_arg(pgVectorArray *self, PyObject *other,
+                        const double **coords, Py_ssize_t *step, double *buf)
+{
+    int ret = _vectorarray_operand(self, other, coords, step, buf);
+
+    if (!ret) {
+        PyErr_Format(PyExc_TypeError,
+                     "expected a Vector%zd or Vector%zdArray argument",
+                     self->dim, self->dim);
+        return -1;
+    }
+    return ret;
+}
+
+/* Returns a list of floats from values. */
 static PyObject *
-math_enable_swizzling(pgVector *self, PyObject *_null)
+_vectorarray_float_list(const double *values, Py_ssize_t count)
 {
-    if (PyErr_WarnEx(PyExc_DeprecationWarning,
-                     "pygame.math.enable_swizzling() is deprecated, "
-                     "and its functionality is removed. This function will be "
-                     "removed in a later version.",
-                     1) == -1) {
+    PyObject *list = PyList_New(count), *num;
+    Py_ssize_t i;
+
+    if (!list) {
         return NULL;
     }
-    Py_RETURN_NONE;
+    for (i = 0; i < count; ++i) {
+        if (!(num = PyFloat_FromDouble(values[i]))) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, num);
+    }
+    return list;
 }
 
 static PyObject *
-math_disable_swizzling(pgVector *self, PyObject *_null)
+vectorarray_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
-    if (PyErr_WarnEx(PyExc_DeprecationWarning,
-                     "pygame.math.disable_swizzling() is deprecated, "
-                     "and its functionality is removed. This function will be "
-                     "removed in a later version.",
-                     1) == -1) {
+    pgVectorArray *self = (pgVectorArray *)type->tp_alloc(type, 0);
+
+    if (self) {
+        self->dim = PyType_IsSubtype(type, &pgVector2Array_Type) ? 2 : 3;
+    }
+    return (PyObject *)self;
+}
+
+static int
+vectorarray_init(pgVectorArray *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *vectors = NULL, *seq;
+    Py_ssize_t i, count;
+    static char *keywords[] = {"vectors", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", keywords,
+                                     &vectors)) {
+        return -1;
+    }
+
+    if (!vectors) {
+        return _vectorarray_resize(self, 0);
+    }
+    if (PyIndex_Check(vectors)) {
+        count = PyNumber_AsSsize_t(vectors, PyExc_OverflowError);
+        if (count == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+        if (count < 0) {
+            PyErr_SetString(PyExc_ValueError,
+                            "vector array length cannot be negative");
+            return -1;
+        }
+        if (_vectorarray_resize(self, count)) {
+            return -1;
+        }
+        if (count) {
+            memset(self->coords, 0, sizeof(double) * self->dim * count);
+        }
+        return 0;
+    }
+    if (pgVectorArray_Check(vectors) &&
+        ((pgVectorArray *)vectors)->dim == self->dim) {
+        count = ((pgVectorArray *)vectors)->count;
+        if (_vectorarray_resize(self, count)) {
+            return -1;
+        }
+        if (count) {
+            memmove(self->coords, ((pgVectorArray *)vectors)->coords,
+                    sizeof(double) * self->dim * count);
+        }
+        return 0;
+    }
+
+    seq = PySequence_Fast(vectors, "vectors must be a sequence of vectors");
+    if (!seq) {
+        return -1;
+    }
+    count = PySequence_Fast_GET_SIZE(seq);
+    if (_vectorarray_resize(self, count)) {
+        Py_DECREF(seq);
+        return -1;
+    }
+    for (i = 0; i < count; ++i) {
+        if (!pgVectorCompatible_Check(PySequence_Fast_GET_ITEM(seq, i),
+                                      self->dim) ||
+            !PySequence_AsVectorCoords(PySequence_Fast_GET_ITEM(seq, i),
+                                       self->coords + i * self->dim,
+                                       self->dim)) {
+            self->count = 0;
+            Py_DECREF(seq);
+            PyErr_SetString(PyExc_TypeError,
+                            "vectors must be a sequence of vectors");
+            return -1;
+        }
+    }
+    Py_DECREF(seq);
+    return 0;
+}
+
+static void
+vectorarray_dealloc(pgVectorArray *self)
+{
+    PyMem_Free(self->coords);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+vectorarray_repr(pgVectorArray *self)
+{
+    return PyUnicode_FromFormat("<Vector%zdArray(%zd)>", self->dim,
+                                self->count);
+}
+
+static PyObject *
+vectorarray_append(pgVectorArray *self, PyObject *vector)
+{
+    double coords[VECTOR_MAX_SIZE];
+
+    if (!pgVectorCompatible_Check(vector, self->dim) ||
+        !PySequence_AsVectorCoords(vector, coords, self->dim)) {
+        return RAISE(PyExc_TypeError, "argument must be a vector");
+    }
+    if (_vectorarray_resize(self, self->count + 1)) {
         return NULL;
     }
+    memcpy(self->coords + (self->count - 1) * self->dim, coords,
+           sizeof(double) * self->dim);
     Py_RETURN_NONE;
 }
 
-static PyMethodDef _math_methods[] = {
-    {"enable_swizzling", (PyCFunction)math_enable_swizzling, METH_NOARGS,
-     "Deprecated, will be removed in a future version"},
-    {"disable_swizzling", (PyCFunction)math_disable_swizzling, METH_NOARGS,
-     "Deprecated, will be removed in a future version."},
-    {NULL, NULL, 0, NULL}};
+static PyObject *
+vectorarray_copy(pgVectorArray *self, PyObject *_null)
+{
+    pgVectorArray *ret = _vectorarray_new_like(self, self->count);
 
-/****************************
- * Module init function
- ****************************/
+    if (ret && self->count) {
+        memcpy(ret->coords, self->coords,
+               sizeof(double) * self->dim * self->count);
+    }
+    return (PyObject *)ret;
+}
 
-#if defined(BUILD_STATIC)
-// prevent name collision with CPython builtin PyInit_math from math module
-MODINIT_DEFINE(pg_math)
-#else
-MODINIT_DEFINE(math)
-#endif
+/**********************************************
+ * VectorArray PyNumber emulation routines
+ **********************************************/
+
+/* Works as vector_generic_math, on every vector of the array. The other
+ * operand can be an array of the same length and dimension, or a single
+ * vector, for addition and subtraction, and a number for multiplication
+ * and division.
+ */
+static PyObject *
+vectorarray_generic_math(PyObject *o1, PyObject *o2, int op)
 {
-    PyObject *module, *apiobj;
-    static void *c_api[PYGAMEAPI_MATH_NUMSLOTS];
+    Py_ssize_t i, j, dim, n, step = 0;
+    const double *other_coords = NULL;
+    double buf[VECTOR_MAX_SIZE];
+    double *src, *dst, scalar = 0.;
+    PyObject *other;
+    pgVectorArray *array, *ret;
+    int is_vector;
 
-    static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
-                                         "math",
-                                         DOC_PYGAMEMATH,
-                                         -1,
-                                         _math_methods,
-                                         NULL,
-                                         NULL,
-                                         NULL,
-                                         NULL};
+    if (pgVectorArray_Check(o1)) {
+        array = (pgVectorArray *)o1;
+        other = o2;
+    }
+    else {
+        array = (pgVectorArray *)o2;
+        other = o1;
+        op |= OP_ARG_REVERSE;
+    }
+    dim = array->dim;
+    n = array->count * dim;
+
+    is_vector = _vectorarray_operand(array, other, &other_coords, &step, buf);
+    if (is_vector < 0) {
+        return NULL;
+    }
+    if (is_vector) {
+        op |= OP_ARG_VECTOR;
+    }
+    else if (RealNumber_Check(other)) {
+        op |= OP_ARG_NUMBER;
+        scalar = PyFloat_AsDouble(other);
+        if (scalar == -1.0 && PyErr_Occurred()) {
+            return NULL;
+        }
+    }
+    else {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+
+    switch (op & ~OP_INPLACE) {
+        case OP_ADD | OP_ARG_VECTOR:
+        case OP_ADD | OP_ARG_VECTOR | OP_ARG_REVERSE:
+        case OP_SUB | OP_ARG_VECTOR:
+        case OP_SUB | OP_ARG_VECTOR | OP_ARG_REVERSE:
+        case OP_MUL | OP_ARG_NUMBER:
+        case OP_MUL | OP_ARG_NUMBER | OP_ARG_REVERSE:
+            break;
+        case OP_DIV | OP_ARG_NUMBER:
+            if (scalar == 0.) {
+                return RAISE(PyExc_ZeroDivisionError, "division by zero");
+            }
+            scalar = 1. / scalar;
+            break;
+        default:
+            Py_RETURN_NOTIMPLEMENTED;
+    }
+
+    if (op & OP_INPLACE) {
+        ret = array;
+        Py_INCREF(ret);
+    }
+    else if (!(ret = _vectorarray_new_like(array, array->count))) {
+        return NULL;
+    }
+    src = array->coords;
+    dst = ret->coords;
+
+    /* the loops are kept plain so that the compiler can vectorise them */
+    switch (op & ~(OP_INPLACE | OP_ARG_REVERSE)) {
+        case OP_ADD | OP_ARG_VECTOR:
+            if (step) {
+                for (i = 0; i < n; ++i)
+                    dst[i] = src[i] + other_coords[i];
+            }
+            else {
+                for (i = 0; i < n; i += dim)
+                    for (j = 0; j < dim; ++j)
+                        dst[i + j] = src[i + j] + other_coords[j];
+            }
+            break;
+        case OP_SUB | OP_ARG_VECTOR:
+            if (op & OP_ARG_REVERSE) {
+                for (i = 0; i < n; i += dim)
+                    for (j = 0; j < dim; ++j)
+                        dst[i + j] = other_coords[j] - src[i + j];
+            }
+            else if (step) {
+                for (i = 0; i < n; ++i)
+                    dst[i] = src[i] - other_coords[i];
+            }
+            else {
+                for (i = 0; i < n; i += dim)
+                    for (j = 0; j < dim; ++j)
+                        dst[i + j] = src[i + j] - other_coords[j];
+            }
+            break;
+        default: /* OP_MUL or OP_DIV by a number */
+            for (i = 0; i < n; ++i)
+                dst[i] = src[i] * scalar;
+            break;
+    }
+    return (PyObject *)ret;
+}
+
+static PyObject *
+vectorarray_add(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_ADD);
+}
+static PyObject *
+vectorarray_inplace_add(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_ADD | OP_INPLACE);
+}
+static PyObject *
+vectorarray_sub(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_SUB);
+}
+static PyObject *
+vectorarray_inplace_sub(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_SUB | OP_INPLACE);
+}
+static PyObject *
+vectorarray_mul(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_MUL);
+}
+static PyObject *
+vectorarray_inplace_mul(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_MUL | OP_INPLACE);
+}
+static PyObject *
+vectorarray_div(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_DIV);
+}
+static PyObject *
+vectorarray_inplace_div(PyObject *o1, PyObject *o2)
+{
+    return vectorarray_generic_math(o1, o2, OP_DIV | OP_INPLACE);
+}
+
+/**********************************************
+ * VectorArray methods
+ **********************************************/
+
+static PyObject *
+vectorarray_dot(pgVectorArray *self, PyObject *other)
+{
+    const double *other_coords;
+    double buf[VECTOR_MAX_SIZE], *values;
+    Py_ssize_t i, j, step, dim = self->dim;
+    PyObject *ret;
+
+    if (_vectorarray_vector_arg(self, other, &other_coords, &step, buf) < 0) {
+        return NULL;
+    }
+    if (!(values = PyMem_New(double, self->count + 1))) {
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < self->count; ++i) {
+        values[i] = 0.;
+        for (j = 0; j < dim; ++j)
+            values[i] +=
+                self->coords[i * dim + j] * other_coords[i * step + j];
+    }
+    ret = _vectorarray_float_list(values, self->count);
+    PyMem_Free(values);
+    return ret;
+}
+
+static PyObject *
+vectorarray_distance_to(pgVectorArray *self, PyObject *other)
+{
+    const double *other_coords;
+    double buf[VECTOR_MAX_SIZE], *values, tmp;
+    Py_ssize_t i, j, step, dim = self->dim;
+    PyObject *ret;
+
+    if (_vectorarray_vector_arg(self, other, &other_coords, &step, buf) < 0) {
+        return NULL;
+    }
+    if (!(values = PyMem_New(double, self->count + 1))) {
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < self->count; ++i) {
+        values[i] = 0.;
+        for (j = 0; j < dim; ++j) {
+            tmp = other_coords[i * step + j] - self->coords[i * dim + j];
+            values[i] += tmp * tmp;
+        }
+        values[i] = sqrt(values[i]);
+    }
+    ret = _vectorarray_float_list(values, self->count);
+    PyMem_Free(values);
+    return ret;
+}
+
+static PyObject *
+vectorarray_normalize_ip(pgVectorArray *self, PyObject *_null)
+{
+    Py_ssize_t i, j, dim = self->dim;
+    double *coords = self->coords, length;
+
+    /* checked first, so that nothing is changed on an error */
+    for (i = 0; i < self->count; ++i) {
+        if (_scalar_product(coords + i * dim, coords + i * dim, dim) == 0) {
+            return RAISE(PyExc_ValueError,
+                         "Can't normalize Vector of length Zero");
+        }
+    }
+    for (i = 0; i < self->count; ++i) {
+        length = sqrt(_scalar_product(coords + i * dim, coords + i * dim, dim));
+        for (j = 0; j < dim; ++j)
+            coords[i * dim + j] /= length;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+vectorarray_lerp(pgVectorArray *self, PyObject *args)
+{
+    const double *other_coords;
+    double buf[VECTOR_MAX_SIZE], t;
+    Py_ssize_t i, j, step, dim = self->dim;
+    PyObject *other;
+    pgVectorArray *ret;
+
+    if (!PyArg_ParseTuple(args, "Od:lerp", &other, &t)) {
+        return NULL;
+    }
+    if (_vectorarray_vector_arg(self, other, &other_coords, &step, buf) < 0) {
+        return NULL;
+    }
+    if (t < 0 || t > 1) {
+        return RAISE(PyExc_ValueError, "Argument 2 must be in range [0, 1]");
+    }
+    if (!(ret = _vectorarray_new_like(self, self->count))) {
+        return NULL;
+    }
+    for (i = 0; i < self->count; ++i)
+        for (j = 0; j < dim; ++j)
+            ret->coords[i * dim + j] = self->coords[i * dim + j] * (1 - t) +
+                                       other_coords[i * step + j] * t;
+    return (PyObject *)ret;
+}
+
+static PyObject *
+vectorarray_clamp_magnitude_ip(pgVectorArray *self, PyObject *args,
+                               PyObject *kwargs)
+{
+    Py_ssize_t i, j, dim = self->dim;
+    double *coords = self->coords;
+    double arg0, arg1 = 0, min_length, max_length, length_sq, fraction;
+    static char *keywords[] = {"arg0", "arg1", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "d|d", keywords, &arg0,
+                                     &arg1)) {
+        return NULL;
+    }
+    /* as in Vector.clamp_magnitude_ip, one argument is the max length */
+    if (arg1 != 0) {
+        min_length = arg0;
+        max_length = arg1;
+    }
+    else {
+        min_length = 0;
+        max_length = arg0;
+    }
+
+    for (i = 0; i < self->count; ++i) {
+        length_sq = _scalar_product(coords + i * dim, coords + i * dim, dim);
+        if (length_sq > max_length * max_length) {
+            fraction = max_length / sqrt(length_sq);
+        }
+        else if (length_sq < min_length * min_length && length_sq != 0) {
+            fraction = min_length / sqrt(length_sq);
+        }
+        else {
+            continue;
+        }
+        for (j = 0; j < dim; ++j)
+            coords[i * dim + j] *= fraction;
+    }
+    Py_RETURN_NONE;
+}
+
+/* Multiplies every vector of self by the dim x dim matrix m, stored by
+ * columns.
+ */
+static void
+_vectorarray_transform(pgVectorArray *self, const double *m)
+{
+    Py_ssize_t i;
+    double *c = self->coords, x, y, z;
+
+    if (self->dim == 2) {
+        for (i = 0; i < self->count * 2; i += 2) {
+            x = c[i];
+            y = c[i + 1];
+            c[i] = m[0] * x + m[2] * y;
+            c[i + 1] = m[1] * x + m[3] * y;
+        }
+    }
+    else {
+        for (i = 0; i < self->count * 3; i += 3) {
+            x = c[i];
+            y = c[i + 1];
+            z = c[i + 2];
+            c[i] = m[0] * x + m[3] * y + m[6] * z;
+            c[i + 1] = m[1] * x + m[4] * y + m[7] * z;
+            c[i + 2] = m[2] * x + m[5] * y + m[8] * z;
+        }
+    }
+}
+
+/* The rotation is found once, by rotating the unit vectors with the helper
+ * Vector.rotate uses, so that the results match it, and then applied to
+ * every vector.
+ */
+static PyObject *
+vector2array_rotate_ip(pgVectorArray *self, PyObject *angleObject)
+{
+    static const double units[4] = {1., 0., 0., 1.};
+    double angle, m[4];
+
+    angle = PyFloat_AsDouble(angleObject);
+    if (angle == -1.0 && PyErr_Occurred()) {
+        return NULL;
+    }
+    angle = DEG2RAD(angle);
+
+    if (!_vector2_rotate_helper(m, units, angle, VECTOR_EPSILON) ||
+        !_vector2_rotate_helper(m + 2, units + 2, angle, VECTOR_EPSILON)) {
+        return NULL;
+    }
+    _vectorarray_transform(self, m);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+vector3array_rotate_ip(pgVectorArray *self, PyObject *args)
+{
+    static const double units[9] = {1., 0., 0., 0., 1., 0., 0., 0., 1.};
+    double angle, axis_coords[3], m[9];
+    PyObject *axis;
+    int i;
+
+    if (!PyArg_ParseTuple(args, "dO:rotate_ip", &angle, &axis)) {
+        return NULL;
+    }
+    if (!pgVectorCompatible_Check(axis, 3)) {
+        return RAISE(PyExc_TypeError, "axis must be a 3D Vector");
+    }
+    if (!PySequence_AsVectorCoords(axis, axis_coords, 3)) {
+        return NULL;
+    }
+    angle = DEG2RAD(angle);
+
+    for (i = 0; i < 3; ++i) {
+        if (!_vector3_rotate_helper(m + i * 3, units + i * 3, axis_coords,
+                                    angle, VECTOR_EPSILON)) {
+            return NULL;
+        }
+    }
+    _vectorarray_transform(self, m);
+    Py_RETURN_NONE;
+}
+
+/* sequence functions */
+
+static Py_ssize_t
+vectorarray_length(pgVectorArray *self)
+{
+    return self->count;
+}
+
+static PyObject *
+vectorarray_item(pgVectorArray *self, Py_ssize_t i)
+{
+    pgVector *ret;
+
+    if (i < 0 || i >= self->count) {
+        return RAISE(PyExc_IndexError, "vector array index out of range");
+    }
+    if ((ret = (pgVector *)pgVector_NEW(self->dim))) {
+        memcpy(ret->coords, self->coords + i * self->dim,
+               sizeof(double) * self->dim);
+    }
+    return (PyObject *)ret;
+}
+
+static int
+vectorarray_ass_item(pgVectorArray *self, Py_ssize_t i, PyObject *v)
+{
+    double coords[VECTOR_MAX_SIZE];
+
+    if (i < 0 || i >= self->count) {
+        PyErr_SetString(PyExc_IndexError,
+                        "vector array assignment index out of range");
+        return -1;
+    }
+    if (!v) {
+        /* del array[i] */
+        if (self->exports) {
+            PyErr_SetString(
+                PyExc_BufferError,
+                "cannot resize a vector array while it is exported");
+            return -1;
+        }
+        memmove(self->coords + i * self->dim,
+                self->coords + (i + 1) * self->dim,
+                sizeof(double) * self->dim * (self->count - i - 1));
+        self->count--;
+        return 0;
+    }
+    if (!pgVectorCompatible_Check(v, self->dim) ||
+        !PySequence_AsVectorCoords(v, coords, self->dim)) {
+        PyErr_SetString(PyExc_TypeError, "argument must be a vector");
+        return -1;
+    }
+    memcpy(self->coords + i * self->dim, coords, sizeof(double) * self->dim);
+    return 0;
+}
+
+/* buffer functions */
+
+static int
+vectorarray_getbuffer(pgVectorArray *self, Py_buffer *view, int flags)
+{
+    if (!self->exports) {
+        self->shape[0] = self->count;
+        self->shape[1] = self->dim;
+        self->strides[0] = sizeof(double) * self->dim;
+        self->strides[1] = sizeof(double);
+    }
+    self->exports++;
+
+    view->buf = self->coords;
+    view->len = self->count * self->dim * sizeof(double);
+    view->readonly = 0;
+    view->itemsize = sizeof(double);
+    view->format = (flags & PyBUF_FORMAT) ? "d" : NULL;
+    view->ndim = 2;
+    view->shape = (flags & PyBUF_ND) ? self->shape : NULL;
+    view->strides = (flags & PyBUF_STRIDES) ? self->strides : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    Py_INCREF(self);
+    view->obj = (PyObject *)self;
+    return 0;
+}
+
+static void
+vectorarray_releasebuffer(pgVectorArray *self, Py_buffer *view)
+{
+    self->exports--;
+}
+
+static PyMethodDef vector2array_methods[] = {
+    {"append", (PyCFunction)vectorarray_append, METH_O,
+     DOC_VECTOR2ARRAYAPPEND},
+    {"copy", (PyCFunction)vectorarray_copy, METH_NOARGS,
+     DOC_VECTOR2ARRAYCOPY},
+    {"dot", (PyCFunction)vectorarray_dot, METH_O, DOC_VECTOR2ARRAYDOT},
+    {"distance_to", (PyCFunction)vectorarray_distance_to, METH_O,
+     DOC_VECTOR2ARRAYDISTANCETO},
+    {"normalize_ip", (PyCFunction)vectorarray_normalize_ip, METH_NOARGS,
+     DOC_VECTOR2ARRAYNORMALIZEIP},
+    {"rotate_ip", (PyCFunction)vector2array_rotate_ip, METH_O,
+     DOC_VECTOR2ARRAYROTATEIP},
+    {"lerp", (PyCFunction)vectorarray_lerp, METH_VARARGS,
+     DOC_VECTOR2ARRAYLERP},
+    {"clamp_magnitude_ip", (PyCFunction)vectorarray_clamp_magnitude_ip,
+     METH_VARARGS | METH_KEYWORDS, DOC_VECTOR2ARRAYCLAMPMAGNITUDEIP},
+    {NULL, NULL, 0, NULL}};
+
+static PyMethodDef vector3array_methods[] = {
+    {"append", (PyCFunction)vectorarray_append, METH_O,
+     DOC_VECTOR3ARRAYAPPEND},
+    {"copy", (PyCFunction)vectorarray_copy, METH_NOARGS,
+     DOC_VECTOR3ARRAYCOPY},
+    {"dot", (PyCFunction)vectorarray_dot, METH_O, DOC_VECTOR3ARRAYDOT},
+    {"distance_to", (PyCFunction)vectorarray_distance_to, METH_O,
+     DOC_VECTOR3ARRAYDISTANCETO},
+    {"normalize_ip", (PyCFunction)vectorarray_normalize_ip, METH_NOARGS,
+     DOC_VECTOR3ARRAYNORMALIZEIP},
+    {"rotate_ip", (PyCFunction)vector3array_rotate_ip, METH_VARARGS,
+     DOC_VECTOR3ARRAYROTATEIP},
+    {"lerp", (PyCFunction)vectorarray_lerp, METH_VARARGS,
+     DOC_VECTOR3ARRAYLERP},
+    {"clamp_magnitude_ip", (PyCFunction)vectorarray_clamp_magnitude_ip,
+     METH_VARARGS | METH_KEYWORDS, DOC_VECTOR3ARRAYCLAMPMAGNITUDEIP},
+    {NULL, NULL, 0, NULL}};
+
+static PyNumberMethods vectorarray_as_number = {
+    .nb_add = (binaryfunc)vectorarray_add,
+    .nb_subtract = (binaryfunc)vectorarray_sub,
+    .nb_multiply = (binaryfunc)vectorarray_mul,
+    .nb_true_divide = (binaryfunc)vectorarray_div,
+    .nb_inplace_add = (binaryfunc)vectorarray_inplace_add,
+    .nb_inplace_subtract = (binaryfunc)vectorarray_inplace_sub,
+    .nb_inplace_multiply = (binaryfunc)vectorarray_inplace_mul,
+    .nb_inplace_true_divide = (binaryfunc)vectorarray_inplace_div,
+};
+
+static PySequenceMethods vectorarray_as_sequence = {
+    .sq_length = (lenfunc)vectorarray_length,
+    .sq_item = (ssizeargfunc)vectorarray_item,
+    .sq_ass_item = (ssizeobjargproc)vectorarray_ass_item,
+};
+
+static PyBufferProcs vectorarray_as_buffer = {
+    (getbufferproc)vectorarray_getbuffer,
+    (releasebufferproc)vectorarray_releasebuffer};
+
+static PyTypeObject pgVector2Array_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.math.Vector2Array",
+    .tp_basicsize = sizeof(pgVectorArray),
+    .tp_dealloc = (destructor)vectorarray_dealloc,
+    .tp_repr = (reprfunc)vectorarray_repr,
+    .tp_as_number = &vectorarray_as_number,
+    .tp_as_sequence = &vectorarray_as_sequence,
+    .tp_as_buffer = &vectorarray_as_buffer,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_PYGAMEMATHVECTOR2ARRAY,
+    .tp_methods = vector2array_methods,
+    .tp_init = (initproc)vectorarray_init,
+    .tp_new = (newfunc)vectorarray_new,
+};
+
+static PyTypeObject pgVector3Array_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.math.Vector3Array",
+    .tp_basicsize = sizeof(pgVectorArray),
+    .tp_dealloc = (destructor)vectorarray_dealloc,
+    .tp_repr = (reprfunc)vectorarray_repr,
+    .tp_as_number = &vectorarray_as_number,
+    .tp_as_sequence = &vectorarray_as_sequence,
+    .tp_as_buffer = &vectorarray_as_buffer,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_PYGAMEMATHVECTOR3ARRAY,
+    .tp_methods = vector3array_methods,
+    .tp_init = (initproc)vectorarray_init,
+    .tp_new = (newfunc)vectorarray_new,
+};
+
+/*******************************************************
+ * Affine2
+ *******************************************************/
+
+/* Affine2: an immutable 2D affine transform, mapping (x, y) to
+ * (m[0] * x + m[1] * y + m[2], m[3] * x + m[4] * y + m[5]).
+ */
+typedef struct {
+    PyObject_HEAD double m[6];
+} pgAffine2;
+
+static PyTypeObject pgAffine2_Type;
+
+#define pgAffine2_Check(x) (PyType_IsSubtype(Py_TYPE(x), &pgAffine2_Type))
+
+static PyObject *
+_affine2_new(PyTypeObject *type, const double *m)
+{
+    pgAffine2 *self = (pgAffine2 *)type->tp_alloc(type, 0);
+
+    if (self) {
+        memcpy(self->m, m, sizeof(self->m));
+    }
+    return (PyObject *)self;
+}
+
+/* Stores a @ b, the transform doing b and then a, in dst. */
+static void
+_affine2_compose(double *dst, const double *a, const double *b)
+{
+    double m[6];
+
+    m[0] = a[0] * b[0] + a[1] * b[3];
+    m[1] = a[0] * b[1] + a[1] * b[4];
+    m[2] = a[0] * b[2] + a[1] * b[5] + a[2];
+    m[3] = a[3] * b[0] + a[4] * b[3];
+    m[4] = a[3] * b[1] + a[4] * b[4];
+    m[5] = a[3] * b[2] + a[4] * b[5] + a[5];
+    memcpy(dst, m, sizeof(m));
+}
+
+/* Transforms count points, stored as x, y pairs, in place. */
+static void
+_affine2_apply(const double *m, double *coords, Py_ssize_t count)
+{
+    Py_ssize_t i;
+    double x, y;
+
+    for (i = 0; i < count * 2; i += 2) {
+        x = coords[i];
+        y = coords[i + 1];
+        coords[i] = m[0] * x + m[1] * y + m[2];
+        coords[i + 1] = m[3] * x + m[4] * y + m[5];
+    }
+}
+
+/* Reads x and y from the arguments of a classmethod, given either as two
+ * numbers or as one sequence of two numbers.
+ */
+static int
+_affine2_xy_from_args(PyObject *args, double *xy)
+{
+    if (PyTuple_GET_SIZE(args) == 1) {
+        if (!pgVectorCompatible_Check(PyTuple_GET_ITEM(args, 0), 2)) {
+            PyErr_SetString(PyExc_TypeError,
+                            "expected two numbers or a sequence of two "
+                            "numbers");
+            return 0;
+        }
+        return PySequence_AsVectorCoords(PyTuple_GET_ITEM(args, 0), xy, 2);
+    }
+    return PyArg_ParseTuple(args, "dd", xy, xy + 1);
+}
+
+static PyObject *
+affine2_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    double m[6] = {1., 0., 0., 0., 1., 0.};
+    PyObject *seq;
+    Py_ssize_t i;
+
+    if (kwds && PyDict_Size(kwds)) {
+        return RAISE(PyExc_TypeError,
+                     "Affine2() takes no keyword arguments");
+    }
+    switch (PyTuple_GET_SIZE(args)) {
+        case 0:
+            break;
+        case 1:
+            seq = PySequence_Fast(PyTuple_GET_ITEM(args, 0),
+                                  "Affine2() argument must be a sequence "
+                                  "of 6 numbers");
+            if (!seq) {
+                return NULL;
+            }
+            if (PySequence_Fast_GET_SIZE(seq) != 6) {
+                Py_DECREF(seq);
+                return RAISE(PyExc_ValueError,
+                             "Affine2() argument must be a sequence of 6 "
+                             "numbers");
+            }
+            for (i = 0; i < 6; ++i) {
+                m[i] = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(seq, i));
+                if (m[i] == -1.0 && PyErr_Occurred()) {
+                    Py_DECREF(seq);
+                    return NULL;
+                }
+            }
+            Py_DECREF(seq);
+            break;
+        default:
+            if (!PyArg_ParseTuple(args, "dddddd:Affine2", m, m + 1, m + 2,
+                                  m + 3, m + 4, m + 5)) {
+                return NULL;
+            }
+            break;
+    }
+    return _affine2_new(type, m);
+}
+
+static PyObject *
+affine2_repr(pgAffine2 *self)
+{
+    char buffer[256];
+    int tmp = PyOS_snprintf(buffer, sizeof(buffer),
+                            "<Affine2(%g, %g, %g, %g, %g, %g)>", self->m[0],
+                            self->m[1], self->m[2], self->m[3], self->m[4],
+                            self->m[5]);
+
+    if (!_vector_check_snprintf_success(tmp, sizeof(buffer)))
+        return NULL;
+    return PyUnicode_FromString(buffer);
+}
+
+static PyObject *
+affine2_richcompare(PyObject *o1, PyObject *o2, int op)
+{
+    int equal;
+
+    if (!pgAffine2_Check(o1) || !pgAffine2_Check(o2) ||
+        (op != Py_EQ && op != Py_NE)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    equal = !memcmp(((pgAffine2 *)o1)->m, ((pgAffine2 *)o2)->m,
+                    sizeof(((pgAffine2 *)o1)->m));
+    if (equal == (op == Py_EQ))
+        Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+}
+
+static PyObject *
+affine2_identity(PyTypeObject *type, PyObject *_null)
+{
+    static const double m[6] = {1., 0., 0., 0., 1., 0.};
+
+    return _affine2_new(type, m);
+}
+
+static PyObject *
+affine2_translation(PyTypeObject *type, PyObject *args)
+{
+    double xy[2];
+
+    if (!_affine2_xy_from_args(args, xy)) {
+        return NULL;
+    }
+    {
+        double m[6] = {1., 0., xy[0], 0., 1., xy[1]};
+        return _affine2_new(type, m);
+    }
+}
+
+static PyObject *
+affine2_rotation(PyTypeObject *type, PyObject *angleObject)
+{
+    static const double unit[2] = {1., 0.};
+    double angle, cs[2];
+
+    angle = PyFloat_AsDouble(angleObject);
+    if (angle == -1.0 && PyErr_Occurred()) {
+        return NULL;
+    }
+    /* rotating a unit vector the way Vector2.rotate does keeps right
+     * angles exact */
+    if (!_vector2_rotate_helper(cs, unit, DEG2RAD(angle), VECTOR_EPSILON)) {
+        return NULL;
+    }
+    {
+        /* adding 0 turns the -0 of right angles into 0 */
+        double m[6] = {cs[0] + 0., 0. - cs[1], 0., cs[1] + 0., cs[0] + 0., 0.};
+        return _affine2_new(type, m);
+    }
+}
+
+static PyObject *
+affine2_scale(PyTypeObject *type, PyObject *args)
+{
+    double xy[2];
+
+    if (PyTuple_GET_SIZE(args) == 1 &&
+        RealNumber_Check(PyTuple_GET_ITEM(args, 0))) {
+        xy[0] = xy[1] = PyFloat_AsDouble(PyTuple_GET_ITEM(args, 0));
+        if (xy[0] == -1.0 && PyErr_Occurred()) {
+            return NULL;
+        }
+    }
+    else if (!_affine2_xy_from_args(args, xy)) {
+        return NULL;
+    }
+    {
+        double m[6] = {xy[0], 0., 0., 0., xy[1], 0.};
+        return _affine2_new(type, m);
+    }
+}
+
+static PyObject *
+affine2_shear(PyTypeObject *type, PyObject *args)
+{
+    double xy[2];
+
+    if (!_affine2_xy_from_args(args, xy)) {
+        return NULL;
+    }
+    {
+        double m[6] = {1., xy[0], 0., xy[1], 1., 0.};
+        return _affine2_new(type, m);
+    }
+}
+
+static PyObject *
+affine2_inverse(pgAffine2 *self, PyObject *_null)
+{
+    const double *m = self->m;
+    double inv[6], det = m[0] * m[4] - m[1] * m[3];
+
+    if (det == 0. || !isfinite(det)) {
+        return RAISE(PyExc_ValueError, "Affine2 is not invertible");
+    }
+    /* "+ 0." turns the -0. produced by negation into 0. */
+    inv[0] = m[4] / det + 0.;
+    inv[1] = -m[1] / det + 0.;
+    inv[3] = -m[3] / det + 0.;
+    inv[4] = m[0] / det + 0.;
+    inv[2] = -(inv[0] * m[2] + inv[1] * m[5]) + 0.;
+    inv[5] = -(inv[3] * m[2] + inv[4] * m[5]) + 0.;
+    return _affine2_new(Py_TYPE(self), inv);
+}
+
+static PyObject *
+affine2_transform_points(pgAffine2 *self, PyObject *points)
+{
+    pgVectorArray *ret;
+
+    if (PyObject_TypeCheck(points, &pgVector2Array_Type)) {
+        ret = (pgVectorArray *)vectorarray_copy((pgVectorArray *)points,
+                                                NULL);
+    }
+    else {
+        ret = (pgVectorArray *)PyObject_CallFunctionObjArgs(
+            (PyObject *)&pgVector2Array_Type, points, NULL);
+    }
+    if (ret) {
+        _affine2_apply(self->m, ret->coords, ret->count);
+    }
+    return (PyObject *)ret;
+}
+
+static PyObject *
+affine2_reduce(pgAffine2 *self, PyObject *_null)
+{
+    return Py_BuildValue("(O(dddddd))", (PyObject *)Py_TYPE(self),
+                         self->m[0], self->m[1], self->m[2], self->m[3],
+                         self->m[4], self->m[5]);
+}
+
+/* a @ b composes two transforms, and a @ v transforms a point or a
+ * Vector2Array of points. */
+static PyObject *
+affine2_matmul(PyObject *o1, PyObject *o2)
+{
+    pgAffine2 *self;
+    pgVector *vec;
+    double m[6];
+
+    if (!pgAffine2_Check(o1)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    self = (pgAffine2 *)o1;
+    if (pgAffine2_Check(o2)) {
+        _affine2_compose(m, self->m, ((pgAffine2 *)o2)->m);
+        return _affine2_new(Py_TYPE(o1), m);
+    }
+    if (PyObject_TypeCheck(o2, &pgVector2Array_Type)) {
+        return affine2_transform_points(self, o2);
+    }
+    if (!pgVectorCompatible_Check(o2, 2)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    if (!(vec = (pgVector *)pgVector_NEW(2))) {
+        return NULL;
+    }
+    if (!PySequence_AsVectorCoords(o2, vec->coords, 2)) {
+        Py_DECREF(vec);
+        return NULL;
+    }
+    _affine2_apply(self->m, vec->coords, 1);
+    return (PyObject *)vec;
+}
+
+static Py_ssize_t
+affine2_length(pgAffine2 *self)
+{
+    return 6;
+}
+
+static PyObject *
+affine2_item(pgAffine2 *self, Py_ssize_t i)
+{
+    if (i < 0 || i >= 6) {
+        return RAISE(PyExc_IndexError, "Affine2 index out of range");
+    }
+    return PyFloat_FromDouble(self->m[i]);
+}
+
+static PyMethodDef affine2_methods[] = {
+    {"identity", (PyCFunction)affine2_identity, METH_NOARGS | METH_CLASS,
+     DOC_AFFINE2IDENTITY},
+    {"translation", (PyCFunction)affine2_translation,
+     METH_VARARGS | METH_CLASS, DOC_AFFINE2TRANSLATION},
+    {"rotation", (PyCFunction)affine2_rotation, METH_O | METH_CLASS,
+     DOC_AFFINE2ROTATION},
+    {"scale", (PyCFunction)affine2_scale, METH_VARARGS | METH_CLASS,
+     DOC_AFFINE2SCALE},
+    {"shear", (PyCFunction)affine2_shear, METH_VARARGS | METH_CLASS,
+     DOC_AFFINE2SHEAR},
+    {"inverse", (PyCFunction)affine2_inverse, METH_NOARGS,
+     DOC_AFFINE2INVERSE},
+    {"transform_points", (PyCFunction)affine2_transform_points, METH_O,
+     DOC_AFFINE2TRANSFORMPOINTS},
+    {"__reduce__", (PyCFunction)affine2_reduce, METH_NOARGS, NULL},
+    {NULL, NULL, 0, NULL}};
+
+static PyNumberMethods affine2_as_number = {
+    .nb_matrix_multiply = (binaryfunc)affine2_matmul,
+};
+
+static PySequenceMethods affine2_as_sequence = {
+    .sq_length = (lenfunc)affine2_length,
+    .sq_item = (ssizeargfunc)affine2_item,
+};
+
+static PyTypeObject pgAffine2_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.math.Affine2",
+    .tp_basicsize = sizeof(pgAffine2),
+    .tp_repr = (reprfunc)affine2_repr,
+    .tp_as_number = &affine2_as_number,
+    .tp_as_sequence = &affine2_as_sequence,
+    .tp_hash = PyObject_HashNotImplemented,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_PYGAMEMATHAFFINE2,
+    .tp_richcompare = (richcmpfunc)affine2_richcompare,
+    .tp_methods = affine2_methods,
+    .tp_new = (newfunc)affine2_new,
+};
+
+static PyObject *
+math_enable_swizzling(pgVector *self, PyObject *_null)
+{
+    if (PyErr_WarnEx(PyExc_DeprecationWarning,
+                     "pygame.math.enable_swizzling() is deprecated, "
+                     "and its functionality is removed. This function will be "
+                     "removed in a later version.",
+                     1) == -1) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+math_disable_swizzling(pgVector *self, PyObject *_null)
+{
+    if (PyErr_WarnEx(PyExc_DeprecationWarning,
+                     "pygame.math.disable_swizzling() is deprecated, "
+                     "and its functionality is removed. This function will be "
+                     "removed in a later version.",
+                     1) == -1) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+math_freelist_stats(PyObject *self, PyObject *_null)
+{
+    return Py_BuildValue("{sNsN}", "Vector2",
+                         pgFreeList_Stats(&vector2_freelist), "Vector3",
+                         pgFreeList_Stats(&vector3_freelist));
+}
+
+/****************************
+ * Noise
+ ****************************/
+
+/* Gradient noise is filled into 2D buffers a row at a time. Along a row
+ * only x changes, so the hashes and gradients of a lattice cell, and the
+ * parts of the corner dot products from y and z, are worked out once per
+ * cell. What is left for each element is a few multiplies and adds, done
+ * four elements at a time with SSE2 or NEON. Both ways do the same float
+ * operations in the same order, so they give the same values.
+ */
+
+#define NOISE_MAX_OCTAVES 16
+#define NOISE_MAX_BANDS 64
+
+/* the largest value of one octave with these gradients is 1 / NOISE2_NORM
+ * or about 1 / NOISE3_NORM */
+#define NOISE2_NORM 1.41421356f
+#define NOISE3_NORM 1.0f
+
+static const float noise_grad2[8][2] = {{1.0f, 0.0f},
+                                        {-1.0f, 0.0f},
+                                        {0.0f, 1.0f},
+                                        {0.0f, -1.0f},
+                                        {0.70710678f, 0.70710678f},
+                                        {-0.70710678f, 0.70710678f},
+                                        {0.70710678f, -0.70710678f},
+                                        {-0.70710678f, -0.70710678f}};
+
+static const float noise_grad3[16][3] = {
+    {1, 1, 0},  {-1, 1, 0}, {1, -1, 0}, {-1, -1, 0}, {1, 0, 1},  {-1, 0, 1},
+    {1, 0, -1}, {-1, 0, -1}, {0, 1, 1}, {0, -1, 1},  {0, 1, -1}, {0, -1, -1},
+    {1, 1, 0},  {0, -1, 1}, {-1, 1, 0}, {0, -1, -1}};
+
+typedef struct {
+    unsigned char perm[512]; /* a shuffle of 0 to 255, twice over */
+    int dim;                 /* 2 or 3 */
+    char kind;               /* 'B', 'f' or 'd' */
+    int simd;
+    char *buf;
+    Py_ssize_t width, height;
+    Py_ssize_t xstride, ystride;
+    double scale, offset[2], z;
+    int octaves;
+    double persistence, lacunarity;
+    float norm;
+    float *scratch; /* acc and frac, 2 * width floats for each band */
+    int *cells;     /* width ints for each band */
+} NoisePass;
+
+/* Shuffles 0 to 255 into perm by the seed, with splitmix64 */
+static void
+_noise_permute(unsigned char *perm, unsigned long long seed)
+{
+    unsigned long long z;
+    unsigned char tmp;
+    int i, j;
+
+    for (i = 0; i < 256; ++i) {
+        perm[i] = (unsigned char)i;
+    }
+    for (i = 255; i > 0; --i) {
+        seed += 0x9E3779B97F4A7C15ULL;
+        z = seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        j = (int)(z % (unsigned long long)(i + 1));
+        tmp = perm[i];
+        perm[i] = perm[j];
+        perm[j] = tmp;
+    }
+    memcpy(perm + 256, perm, 256);
+}
+
+static PG_INLINE float
+_noise_fade(float t)
+{
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+/* Splits a coordinate into its lattice cell, wrapped to 0 to 255, and the
+ * fraction of the way across the cell. */
+static PG_INLINE int
+_noise_cell(double c, float *frac)
+{
+    double fc = floor(c);
+
+    *frac = (float)(c - fc);
+    return (int)(fc - 256.0 * floor(fc / 256.0));
+}
+
+/* One element of a cell: frac is how far across the cell it is, gx the x
+ * parts of the corner gradients and k the rest of each corner dot product.
+ * The corners go in x order first, then y, then z. */
+static PG_INLINE float
+_noise_point(float t, int ncorners, const float *gx, const float *k,
+             const float *fades)
+{
+    float u = _noise_fade(t);
+    float n[8];
+    int c, half;
+
+    for (c = 0; c < ncorners; c += 2) {
+        float n0 = gx[c] * t + k[c];
+        float n1 = gx[c + 1] * (t - 1.0f) + k[c + 1];
+
+        n[c / 2] = n0 + u * (n1 - n0);
+    }
+    for (half = ncorners / 4; half > 0; half /= 2, ++fades) {
+        for (c = 0; c < half; ++c) {
+            n[c] = n[2 * c] + *fades * (n[2 * c + 1] - n[2 * c]);
+        }
+    }
+    return n[0];
+}
+
+#ifdef MATH_SIMD
+/* Four elements of a cell at a time, as in _noise_point */
+static PG_INLINE __m128
+_noise_point4(__m128 t, int ncorners, const float *gx, const float *k,
+              const float *fades)
+{
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 u, n[4], n0, n1, f;
+    int c, half;
+
+    /* the fade curve, in the order of _noise_fade */
+    u = _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f));
+    u = _mm_add_ps(_mm_mul_ps(t, u), _mm_set1_ps(10.0f));
+    u = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), u);
+    for (c = 0; c < ncorners; c += 2) {
+        n0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(gx[c]), t),
+                        _mm_set1_ps(k[c]));
+        n1 = _mm_add_ps(
+            _mm_mul_ps(_mm_set1_ps(gx[c + 1]), _mm_sub_ps(t, one)),
+            _mm_set1_ps(k[c + 1]));
+        n[c / 2] = _mm_add_ps(n0, _mm_mul_ps(u, _mm_sub_ps(n1, n0)));
+    }
+    for (half = ncorners / 4; half > 0; half /= 2, ++fades) {
+        f = _mm_set1_ps(*fades);
+        for (c = 0; c < half; ++c) {
+            n[c] = _mm_add_ps(
+                n[2 * c], _mm_mul_ps(f, _mm_sub_ps(n[2 * c + 1], n[2 * c])));
+        }
+    }
+    return n[0];
+}
+#endif /* MATH_SIMD */
+
+/* Adds amp times one octave of noise to acc for a row of n elements.
+ * cells and frac hold the lattice cell and fraction of each element along
+ * x, and y and z the row coordinates in the lattice. */
+static void
+_noise_row(const NoisePass *pass, const int *cells, const float *frac,
+           double y, double z, float amp, float *acc)
+{
+    const unsigned char *perm = pass->perm;
+    Py_ssize_t n = pass->width;
+    Py_ssize_t i, end;
+    int ncorners = pass->dim == 2 ? 4 : 8;
+    int yi, zi = 0, x, c, h;
+    float yf, zf = 0.0f, fades[2];
+    float gx[8], k[8];
+    const float *g;
+
+    yi = _noise_cell(y, &yf);
+    fades[0] = _noise_fade(yf);
+    if (pass->dim == 3) {
+        zi = _noise_cell(z, &zf);
+        fades[1] = _noise_fade(zf);
+    }
+
+    for (i = 0; i < n; i = end) {
+        x = cells[i];
+        for (end = i + 1; end < n && cells[end] == x; ++end) {
+        }
+
+        for (c = 0; c < ncorners; ++c) {
+            /* corner c is at (x + (c & 1), y + (c >> 1 & 1), z + (c >> 2)) */
+            h = perm[perm[x + (c & 1)] + yi + (c >> 1 & 1)];
+            if (pass->dim == 2) {
+                g = noise_grad2[h & 7];
+                gx[c] = g[0];
+                k[c] = g[1] * (yf - (float)(c >> 1 & 1));
+            }
+            else {
+                g = noise_grad3[perm[h + zi + (c >> 2)] & 15];
+                gx[c] = g[0];
+                k[c] = g[1] * (yf - (float)(c >> 1 & 1)) +
+                       g[2] * (zf - (float)(c >> 2));
+            }
+        }
+
+#ifdef MATH_SIMD
+        if (pass->simd) {
+            __m128 a = _mm_set1_ps(amp);
+
+            for (; i + 4 <= end; i += 4) {
+                __m128 r = _noise_point4(_mm_loadu_ps(frac + i), ncorners,
+                                         gx, k, fades);
+
+                _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i),
+                                                  _mm_mul_ps(a, r)));
+            }
+        }
+#endif /* MATH_SIMD */
+        for (; i < end; ++i) {
+            acc[i] += amp * _noise_point(frac[i], ncorners, gx, k, fades);
+        }
+    }
+}
+
+/* Fills the rows from y0 up to y1, with acc, frac and cells as scratch */
+static void
+_noise_rows(const NoisePass *pass, Py_ssize_t y0, Py_ssize_t y1, float *acc,
+            float *frac, int *cells)
+{
+    Py_ssize_t w = pass->width;
+    Py_ssize_t i, j;
+    double freq;
+    float amp, v;
+    char *item;
+    int o, b;
+
+    for (j = y0; j < y1; ++j) {
+        memset(acc, 0, sizeof(float) * w);
+        freq = 1.0 / pass->scale;
+        amp = 1.0f;
+        for (o = 0; o < pass->octaves; ++o) {
+            for (i = 0; i < w; ++i) {
+                cells[i] = _noise_cell((i + pass->offset[0]) * freq, frac + i);
+            }
+            _noise_row(pass, cells, frac, (j + pass->offset[1]) * freq,
+                       pass->z * freq, amp, acc);
+            freq *= pass->lacunarity;
+            amp *= (float)pass->persistence;
+        }
+
+        item = pass->buf + j * pass->ystride;
+        for (i = 0; i < w; ++i, item += pass->xstride) {
+            v = acc[i] * pass->norm;
+            switch (pass->kind) {
+                case 'f':
+                    *(float *)item = v;
+                    break;
+                case 'd':
+                    *(double *)item = v;
+                    break;
+                default:
+                    b = (int)((v + 1.0f) * 127.5f + 0.5f);
+                    *(unsigned char *)item =
+                        (unsigned char)(b < 0 ? 0 : b > 255 ? 255 : b);
+            }
+        }
+    }
+}
+
+static void
+_noise_band(void *data, int band, int nbands)
+{
+    NoisePass *pass = (NoisePass *)data;
+    Py_ssize_t w = pass->width;
+    float *scratch = pass->scratch + 2 * w * band;
+
+    _noise_rows(pass, pass->height * band / nbands,
+                pass->height * (band + 1) / nbands, scratch, scratch + w,
+                pass->cells + w * band);
+}
+
+/* Whether the noise kernels can use SSE2 or NEON */
+static int
+_noise_use_simd(void)
+{
+#if defined(MATH_SIMD) && defined(PG_ENABLE_ARM_NEON)
+    return pg_HasNEON();
+#elif defined(MATH_SIMD)
+    return pg_HasSSE2();
+#else
+    return 0;
+#endif
+}
+
+/* Parses the arguments shared by noise2d and noise3d into pass and fills
+ * the buffer. Returns None, or NULL with an exception set. */
+static PyObject *
+_noise_fill(NoisePass *pass, PyObject *destobj, PyObject *offsetobj,
+            unsigned long long seed)
+{
+    Py_buffer view;
+    const char *format;
+    double ampsum = 0.0, amp = 1.0;
+    int o, nbands;
+
+    if (!(pass->scale > 0.0)) {
+        return RAISE(PyExc_ValueError, "scale must be positive");
+    }
+    if (pass->octaves < 1 || pass->octaves > NOISE_MAX_OCTAVES) {
+        return RAISE(PyExc_ValueError, "octaves must be from 1 to 16");
+    }
+    if (offsetobj == NULL) {
+        pass->offset[0] = pass->offset[1] = 0.0;
+    }
+    else if (!PySequence_AsVectorCoords(offsetobj, pass->offset, 2)) {
+        return NULL;
+    }
+
+    if (PyObject_GetBuffer(destobj, &view,
+                           PyBUF_RECORDS | PyBUF_WRITABLE | PyBUF_FORMAT)) {
+        return NULL;
+    }
+    format = view.format ? view.format : "B";
+    if (*format == '@' || *format == '=') {
+        ++format;
+    }
+    if (!((view.itemsize == 1 && strcmp(format, "B") == 0) ||
+          (view.itemsize == sizeof(float) && strcmp(format, "f") == 0) ||
+          (view.itemsize == sizeof(double) && strcmp(format, "d") == 0))) {
+        PyBuffer_Release(&view);
+        return RAISE(PyExc_ValueError,
+                     "expected a buffer of unsigned bytes, floats or doubles");
+    }
+    if (view.ndim != 2) {
+        PyBuffer_Release(&view);
+        return RAISE(PyExc_ValueError, "expected a 2D buffer");
+    }
+
+    pass->kind = *format;
+    pass->buf = (char *)view.buf;
+    pass->width = view.shape[0];
+    pass->height = view.shape[1];
+    pass->xstride = view.strides[0];
+    pass->ystride = view.strides[1];
+    if (pass->width == 0 || pass->height == 0) {
+        PyBuffer_Release(&view);
+        Py_RETURN_NONE;
+    }
+
+    for (o = 0; o < pass->octaves; ++o) {
+        ampsum += fabs(amp);
+        amp *= pass->persistence;
+    }
+    pass->norm = (float)((pass->dim == 2 ? NOISE2_NORM : NOISE3_NORM) /
+                         (ampsum > 0.0 ? ampsum : 1.0));
+    _noise_permute(pass->perm, seed);
+    pass->simd = _noise_use_simd();
+
+    /* Each row is filled on its own, so rows can be split up */
+    nbands = pg_GetNumThreads();
+    if ((long long)pass->width * pass->height < PG_PARALLEL_MIN_PIXELS) {
+        nbands = 1;
+    }
+    nbands = (int)MIN(MIN(nbands, NOISE_MAX_BANDS), pass->height);
+    if (nbands < 1) {
+        nbands = 1;
+    }
+
+    pass->scratch =
+        (float *)PyMem_Malloc(sizeof(float) * 2 * pass->width * nbands);
+    pass->cells = (int *)PyMem_Malloc(sizeof(int) * pass->width * nbands);
+    if (!pass->scratch || !pass->cells) {
+        PyMem_Free(pass->scratch);
+        PyMem_Free(pass->cells);
+        PyBuffer_Release(&view);
+        return PyErr_NoMemory();
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    pg_ParallelFor(_noise_band, pass, nbands);
+    Py_END_ALLOW_THREADS;
+
+    PyMem_Free(pass->scratch);
+    PyMem_Free(pass->cells);
+    PyBuffer_Release(&view);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+math_noise2d(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    NoisePass pass;
+    PyObject *destobj, *offsetobj = NULL;
+    unsigned long long seed = 0;
+    static char *keywords[] = {"dest",        "scale",      "offset",
+                               "octaves",     "persistence", "lacunarity",
+                               "seed",        NULL};
+
+    pass.octaves = 1;
+    pass.persistence = 0.5;
+    pass.lacunarity = 2.0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Od|OiddK", keywords,
+                                     &destobj, &pass.scale, &offsetobj,
+                                     &pass.octaves, &pass.persistence,
+                                     &pass.lacunarity, &seed)) {
+        return NULL;
+    }
+    pass.dim = 2;
+    pass.z = 0.0;
+    return _noise_fill(&pass, destobj, offsetobj, seed);
+}
+
+static PyObject *
+math_noise3d(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    NoisePass pass;
+    PyObject *destobj, *offsetobj = NULL;
+    unsigned long long seed = 0;
+    static char *keywords[] = {"dest",       "scale",   "z",
+                               "offset",     "octaves", "persistence",
+                               "lacunarity", "seed",    NULL};
+
+    pass.octaves = 1;
+    pass.persistence = 0.5;
+    pass.lacunarity = 2.0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Odd|OiddK", keywords,
+                                     &destobj, &pass.scale, &pass.z,
+                                     &offsetobj, &pass.octaves,
+                                     &pass.persistence, &pass.lacunarity,
+                                     &seed)) {
+        return NULL;
+    }
+    pass.dim = 3;
+    return _noise_fill(&pass, destobj, offsetobj, seed);
+}
+
+static PyMethodDef _math_methods[] = {
+    {"enable_swizzling", (PyCFunction)math_enable_swizzling, METH_NOARGS,
+     "Deprecated, will be removed in a future version"},
+    {"disable_swizzling", (PyCFunction)math_disable_swizzling, METH_NOARGS,
+     "Deprecated, will be removed in a future version."},
+    {"_freelist_stats", math_freelist_stats, METH_NOARGS,
+     "_freelist_stats() -> dict\nreturns how often new vectors reused "
+     "deallocated ones"},
+    {"noise2d", (PyCFunction)math_noise2d, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEMATHNOISE2D},
+    {"noise3d", (PyCFunction)math_noise3d, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMEMATHNOISE3D},
+    {NULL, NULL, 0, NULL}};
+
+/****************************
+ * Module init function
+ ****************************/
+
+#if defined(BUILD_STATIC)
+// prevent name collision with CPython builtin PyInit_math from math module
+MODINIT_DEFINE(pg_math)
+#else
+MODINIT_DEFINE(math)
+#endif
+{
+    PyObject *module, *apiobj;
+    static void *c_api[PYGAMEAPI_MATH_NUMSLOTS];
+
+    static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
+                                         "math",
+                                         DOC_PYGAMEMATH,
+                                         -1,
+                                         _math_methods,
+                                         NULL,
+                                         NULL,
+                                         NULL,
+                                         NULL};
+
+    /* imported needed apis; Do this first so if there is an error
+       the module is not loaded.
+    */
+    import_pygame_base();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
 
     /* initialize the extension types */
     if ((PyType_Ready(&pgVector2_Type) < 0) ||
         (PyType_Ready(&pgVector3_Type) < 0) ||
         (PyType_Ready(&pgVectorIter_Type) < 0) ||
-        (PyType_Ready(&pgVectorElementwiseProxy_Type) < 0) /*||
+        (PyType_Ready(&pgVectorElementwiseProxy_Type) < 0) ||
+        (PyType_Ready(&pgVector2Array_Type) < 0) ||
+        (PyType_Ready(&pgVector3Array_Type) < 0) ||
+        (PyType_Ready(&pgAffine2_Type) < 0) /*||
         (PyType_Ready(&pgVector4_Type) < 0)*/) {
         return NULL;
     }
@@ -4125,6 +5883,9 @@ MODINIT_DEFINE(math)
     Py_INCREF(&pgVector3_Type);
     Py_INCREF(&pgVectorIter_Type);
     Py_INCREF(&pgVectorElementwiseProxy_Type);
+    Py_INCREF(&pgVector2Array_Type);
+    Py_INCREF(&pgVector3Array_Type);
+    Py_INCREF(&pgAffine2_Type);
     /*
     Py_INCREF(&pgVector4_Type);
     */
@@ -4136,7 +5897,13 @@ MODINIT_DEFINE(math)
                             (PyObject *)&pgVectorElementwiseProxy_Type) !=
          0) ||
         (PyModule_AddObject(module, "VectorIterator",
-                            (PyObject *)&pgVectorIter_Type) != 0) /*||
+                            (PyObject *)&pgVectorIter_Type) != 0) ||
+        (PyModule_AddObject(module, "Vector2Array",
+                            (PyObject *)&pgVector2Array_Type) != 0) ||
+        (PyModule_AddObject(module, "Vector3Array",
+                            (PyObject *)&pgVector3Array_Type) != 0) ||
+        (PyModule_AddObject(module, "Affine2",
+                            (PyObject *)&pgAffine2_Type) != 0) /*||
 (PyModule_AddObject(module, "Vector4", (PyObject *)&pgVector4_Type) !=
 0)*/) {
         if (!PyObject_HasAttrString(module, "Vector2"))
@@ -4147,6 +5914,12 @@ MODINIT_DEFINE(math)
             Py_DECREF(&pgVectorElementwiseProxy_Type);
         if (!PyObject_HasAttrString(module, "VectorIterator"))
             Py_DECREF(&pgVectorIter_Type);
+        if (!PyObject_HasAttrString(module, "Vector2Array"))
+            Py_DECREF(&pgVector2Array_Type);
+        if (!PyObject_HasAttrString(module, "Vector3Array"))
+            Py_DECREF(&pgVector3Array_Type);
+        if (!PyObject_HasAttrString(module, "Affine2"))
+            Py_DECREF(&pgAffine2_Type);
         /*
         if (!PyObject_HasAttrString(module, "Vector4"))
             Py_DECREF(&pgVector4_Type);
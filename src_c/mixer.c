@@ -32,6 +32,27 @@
 
 #include "mixer.h"
 
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+// arm64 has neon optimisations enabled by default, even when fpu=neon is not
+// passed
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+#if defined(PG_ENABLE_ARM_NEON)
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "include/sse2neon.h"
+#define PG_DSP_SIMD
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define PG_DSP_SIMD
+#endif
+
 #define PyBUF_HAS_FLAG(f, F) (((f) & (F)) == (F))
 
 /* The SDL audio format constants are not defined for anything larger
@@ -84,6 +105,8 @@ static int
 snd_getbuffer(PyObject *, Py_buffer *, int);
 static void
 snd_releasebuffer(PyObject *, Py_buffer *);
+static void
+_load_shutdown(void);
 
 static int request_frequency = PYGAME_MIXER_DEFAULT_FREQUENCY;
 static int request_size = PYGAME_MIXER_DEFAULT_SIZE;
@@ -101,7 +124,7 @@ static struct ChannelData *channeldata = NULL;
 static int numchanneldata = 0;
 
 Mix_Music **mx_current_music;
-Mix_Music **mx_queue_music;
+void (*mx_quit_music_queue)(void);
 
 static int
 _format_itemsize(Uint16 format)
@@ -255,8 +278,11 @@ _format_view_to_audio(Py_buffer *view)
     return format;
 }
 
+/* Posts an event of the given type, with the code attribute for a user
+ * event, and a load attribute if load is not NULL.
+ */
 static void
-_pg_push_mixer_event(int type, int code)
+_pg_push_mixer_event(int type, int code, PyObject *load)
 {
     pgEventObject *e;
     PyObject *dict, *dictcode;
@@ -270,6 +296,9 @@ _pg_push_mixer_event(int type, int code)
             PyDict_SetItemString(dict, "code", dictcode);
             Py_DECREF(dictcode);
         }
+        if (load) {
+            PyDict_SetItemString(dict, "load", load);
+        }
         e = (pgEventObject *)pgEvent_New2(type, dict);
         Py_DECREF(dict);
 
@@ -288,7 +317,8 @@ endsound_callback(int channel)
 {
     if (channeldata) {
         if (channeldata[channel].endevent && SDL_WasInit(SDL_INIT_VIDEO))
-            _pg_push_mixer_event(channeldata[channel].endevent, channel);
+            _pg_push_mixer_event(channeldata[channel].endevent, channel,
+                                 NULL);
 
         if (channeldata[channel].queue) {
             PyGILState_STATE gstate = PyGILState_Ensure();
@@ -312,1000 +342,3161 @@ endsound_callback(int channel)
     }
 }
 
-static PyObject *
-import_music(void)
+/* Channel effects: a biquad filter and a reverb, a feedback delay network
+ * of four lines, run in an effect on each channel they are set for. The
+ * samples are processed as floats four at a time: the filter takes four
+ * samples of a frame at once, the reverb its four delay lines.
+ */
+#define PG_DSP_BLOCK 256
+#define PG_DSP_MAX_CHANNELS 8
+#define PG_DSP_LINES 4
+/* keeps the reverb tail from decaying into slow denormal floats */
+#define PG_DSP_ANTI_DENORMAL 1e-20f
+
+#define PG_FILTER_NONE 0
+#define PG_FILTER_LOWPASS 1
+#define PG_FILTER_HIGHPASS 2
+#define PG_FILTER_BANDPASS 3
+
+#define PG_DSP_RESET_FILTER 1
+#define PG_DSP_RESET_REVERB 2
+
+#ifdef PG_DSP_SIMD
+typedef __m128 pg_f4;
+#define f4_set1(x) _mm_set1_ps(x)
+#define f4_set(a, b, c, d) _mm_set_ps(d, c, b, a)
+#define f4_add(a, b) _mm_add_ps(a, b)
+#define f4_sub(a, b) _mm_sub_ps(a, b)
+#define f4_mul(a, b) _mm_mul_ps(a, b)
+#define f4_load(p) _mm_loadu_ps(p)
+#define f4_store(p, a) _mm_storeu_ps(p, a)
+
+/* The 4x4 Hadamard transform: sums and differences of the pairs, then of
+ * the pairs of those.
+ */
+static PG_INLINE pg_f4
+f4_hadamard(pg_f4 x)
 {
-    PyObject *music = PyImport_ImportModule(IMPPREFIX "mixer_music");
-    if (music == NULL) {
-        PyErr_Clear();
-        music = PyImport_ImportModule(RELATIVE_MODULE("mixer_music"));
-    }
-    return music;
+    pg_f4 a = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 2, 0, 0));
+    pg_f4 b = _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 1, 1));
+    pg_f4 p = _mm_add_ps(a, _mm_mul_ps(b, _mm_set_ps(-1.f, 1.f, -1.f, 1.f)));
+
+    a = _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 0, 1, 0));
+    b = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 2, 3, 2));
+    return _mm_add_ps(a, _mm_mul_ps(b, _mm_set_ps(-1.f, -1.f, 1.f, 1.f)));
 }
+#else /* ~PG_DSP_SIMD */
+typedef struct {
+    float v[4];
+} pg_f4;
 
-static PyObject *
-_init(int freq, int size, int channels, int chunk, char *devicename,
-      int allowedchanges)
+static PG_INLINE pg_f4
+f4_set(float a, float b, float c, float d)
 {
-    Uint16 fmt = 0;
-    int i;
-    PyObject *music;
-    char *drivername;
+    pg_f4 r = {{a, b, c, d}};
+    return r;
+}
 
-    if (!freq) {
-        freq = request_frequency;
-    }
-    if (!size) {
-        size = request_size;
-    }
+static PG_INLINE pg_f4
+f4_set1(float x)
+{
+    return f4_set(x, x, x, x);
+}
 
-    if (allowedchanges == -1) {
-        allowedchanges = request_allowedchanges;
-    }
+static PG_INLINE pg_f4
+f4_add(pg_f4 a, pg_f4 b)
+{
+    return f4_set(a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2],
+                  a.v[3] + b.v[3]);
+}
 
-    if (!channels) {
-        channels = request_channels;
-    }
-    if (allowedchanges & SDL_AUDIO_ALLOW_CHANNELS_CHANGE) {
-        if (channels <= 1)
-            channels = 1;
-        else if (channels <= 3)
-            channels = 2;
-        else if (channels <= 5)
-            channels = 4;
-        else
-            channels = 6;
-    }
-    else {
-        switch (channels) {
-            case 1:
-            case 2:
-            case 4:
-            case 6:
-                break;
-            default:
-                return RAISE(PyExc_ValueError,
-                             "'channels' must be 1, 2, 4, or 6");
-        }
+static PG_INLINE pg_f4
+f4_sub(pg_f4 a, pg_f4 b)
+{
+    return f4_set(a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2],
+                  a.v[3] - b.v[3]);
+}
+
+static PG_INLINE pg_f4
+f4_mul(pg_f4 a, pg_f4 b)
+{
+    return f4_set(a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2],
+                  a.v[3] * b.v[3]);
+}
+
+static PG_INLINE pg_f4
+f4_load(const float *p)
+{
+    return f4_set(p[0], p[1], p[2], p[3]);
+}
+
+static PG_INLINE void
+f4_store(float *p, pg_f4 a)
+{
+    memcpy(p, a.v, sizeof(a.v));
+}
+
+static PG_INLINE pg_f4
+f4_hadamard(pg_f4 x)
+{
+    float p0 = x.v[0] + x.v[1], p1 = x.v[0] - x.v[1];
+    float p2 = x.v[2] + x.v[3], p3 = x.v[2] - x.v[3];
+
+    return f4_set(p0 + p2, p1 + p3, p0 - p2, p1 - p3);
+}
+#endif /* ~PG_DSP_SIMD */
+
+typedef struct {
+    SDL_SpinLock lock; /* guards the settings */
+    int filter;
+    float b0, b1, b2, a1, a2;
+    float wet, feedback, damping;
+    int lengths[PG_DSP_LINES];
+    int reset;
+
+    /* the state, only touched by the effect */
+    float z1[PG_DSP_MAX_CHANNELS];
+    float z2[PG_DSP_MAX_CHANNELS];
+    float *lines; /* PG_DSP_LINES lines of max_length, set once */
+    int max_length;
+    int pos[PG_DSP_LINES];
+    float damped[PG_DSP_LINES];
+
+    SDL_atomic_t attached;
+} pgChannelDSP;
+
+/* delay line lengths in frames at 44100 Hz, prime so their echoes spread */
+static const int _reverb_lengths[PG_DSP_LINES] = {1117, 1367, 1613, 1861};
+
+static SDL_SpinLock _dsp_lock = 0; /* guards the array, not the DSPs */
+static pgChannelDSP **_dsp = NULL;
+static int _ndsp = 0;
+static Uint16 _dsp_format = 0;
+static int _dsp_channels = 0;
+
+static int
+_dsp_itemsize(void)
+{
+    switch (_dsp_format) {
+        case AUDIO_U8:
+        case AUDIO_S8:
+            return 1;
+        case AUDIO_S16SYS:
+            return 2;
+        case AUDIO_S32SYS:
+        case AUDIO_F32SYS:
+            return 4;
     }
+    return 0;
+}
 
-    if (!chunk) {
-        chunk = request_chunksize;
+#define PG_DSP_TO_FLOAT(type, scale, offset)                               \
+    for (f = 0; f < frames; f++, dst += stride) {                          \
+        for (c = 0; c < nch; c++) {                                        \
+            dst[c] = (((const type *)src)[f * nch + c] - (offset)) * (scale); \
+        }                                                                  \
     }
 
-    if (!devicename) {
-        devicename = request_devicename;
+#define PG_DSP_FROM_FLOAT(type, scale, offset)                           \
+    for (f = 0; f < frames; f++, src += stride) {                        \
+        for (c = 0; c < nch; c++) {                                      \
+            v = src[c] < -1.0f ? -1.0f : src[c] > 1.0f ? 1.0f : src[c]; \
+            ((type *)dst)[f * nch + c] = (type)(v * (scale) + (offset)); \
+        }                                                                \
     }
 
-    /* printf("size:%d:\n", size); */
+/* Converts frames of mixer samples to floats, padded to stride samples */
+static void
+_dsp_to_float(const Uint8 *src, float *dst, int frames, int stride)
+{
+    int f, c, nch = _dsp_channels;
+    float *start = dst;
 
-    switch (size) {
-        case 8:
-            fmt = AUDIO_U8;
-            break;
-        case -8:
-            fmt = AUDIO_S8;
+    switch (_dsp_format) {
+        case AUDIO_U8:
+            PG_DSP_TO_FLOAT(Uint8, 1.0f / 128.0f, 128);
             break;
-        case 16:
-            fmt = AUDIO_U16SYS;
+        case AUDIO_S8:
+            PG_DSP_TO_FLOAT(Sint8, 1.0f / 128.0f, 0);
             break;
-        case -16:
-            fmt = AUDIO_S16SYS;
+        case AUDIO_S16SYS:
+            PG_DSP_TO_FLOAT(Sint16, 1.0f / 32768.0f, 0);
             break;
-        case 32:
-            fmt = AUDIO_F32SYS;
+        case AUDIO_S32SYS:
+            PG_DSP_TO_FLOAT(Sint32, 1.0f / 2147483648.0f, 0);
             break;
         default:
-            PyErr_Format(PyExc_ValueError, "unsupported size %i", size);
-            return NULL;
+            PG_DSP_TO_FLOAT(float, 1.0f, 0);
+    }
+    if (nch < stride) {
+        for (f = 0, dst = start; f < frames; f++, dst += stride) {
+            for (c = nch; c < stride; c++) {
+                dst[c] = 0.0f;
+            }
+        }
     }
+}
 
-    /* printf("size:%d:\n", size); */
+static void
+_dsp_from_float(const float *src, Uint8 *dst, int frames, int stride)
+{
+    int f, c, nch = _dsp_channels;
+    float v;
 
-    /*make chunk a power of 2*/
-    for (i = 0; 1 << i < chunk; ++i)
-        ;                     /*yes, semicolon on for loop*/
-    chunk = MAX(1 << i, 256); /*do this after for loop exits*/
+    switch (_dsp_format) {
+        case AUDIO_U8:
+            PG_DSP_FROM_FLOAT(Uint8, 127.0f, 128.0f);
+            break;
+        case AUDIO_S8:
+            PG_DSP_FROM_FLOAT(Sint8, 127.0f, 0.0f);
+            break;
+        case AUDIO_S16SYS:
+            PG_DSP_FROM_FLOAT(Sint16, 32767.0f, 0.0f);
+            break;
+        case AUDIO_S32SYS:
+            /* as doubles, since 2147483647 rounds up in a float */
+            PG_DSP_FROM_FLOAT(Sint32, 2147483647.0, 0.0);
+            break;
+        default:
+            PG_DSP_FROM_FLOAT(float, 1.0f, 0.0f);
+    }
+}
 
-    if (!SDL_WasInit(SDL_INIT_AUDIO)) {
-        if (!channeldata) { /*should always be null*/
-            channeldata = (struct ChannelData *)malloc(
-                sizeof(struct ChannelData) * MIX_CHANNELS);
-            if (!channeldata) {
-                return PyErr_NoMemory();
-            }
-            numchanneldata = MIX_CHANNELS;
-            for (i = 0; i < numchanneldata; ++i) {
-                channeldata[i].sound = NULL;
-                channeldata[i].queue = NULL;
-                channeldata[i].endevent = 0;
-            }
+/* Runs the biquad over frames of stride samples, in transposed direct
+ * form II, a group of four channels at a time.
+ */
+static void
+_dsp_filter(pgChannelDSP *dsp, float *work, int frames, int stride,
+            const float *coeffs)
+{
+    pg_f4 b0 = f4_set1(coeffs[0]), b1 = f4_set1(coeffs[1]);
+    pg_f4 b2 = f4_set1(coeffs[2]), a1 = f4_set1(coeffs[3]);
+    pg_f4 a2 = f4_set1(coeffs[4]);
+    pg_f4 x, y, z1, z2;
+    float *w;
+    int g, f;
+
+    for (g = 0; g < stride; g += 4) {
+        z1 = f4_load(dsp->z1 + g);
+        z2 = f4_load(dsp->z2 + g);
+        for (f = 0, w = work + g; f < frames; f++, w += stride) {
+            x = f4_load(w);
+            y = f4_add(f4_mul(b0, x), z1);
+            z1 = f4_add(f4_sub(f4_mul(b1, x), f4_mul(a1, y)), z2);
+            z2 = f4_sub(f4_mul(b2, x), f4_mul(a2, y));
+            f4_store(w, y);
         }
+        f4_store(dsp->z1 + g, z1);
+        f4_store(dsp->z2 + g, z2);
+    }
+    for (g = 0; g < stride; g++) {
+        /* flush what would decay into denormals */
+        if (fabsf(dsp->z1[g]) < 1e-15f)
+            dsp->z1[g] = 0.0f;
+        if (fabsf(dsp->z2[g]) < 1e-15f)
+            dsp->z2[g] = 0.0f;
+    }
+}
 
-        /* Compatibility:
-            pulse and dsound audio drivers were renamed in SDL2,
-            and we don't want it to fail.
-        */
-        drivername = SDL_getenv("SDL_AUDIODRIVER");
-        if (drivername && SDL_strncasecmp("pulse", drivername,
-                                          SDL_strlen(drivername)) == 0) {
-            SDL_setenv("SDL_AUDIODRIVER", "pulseaudio", 1);
+/* Feeds the mean of each frame through the delay lines, mixing their
+ * outputs back in through the Hadamard transform, and mixes the even lines
+ * into the left channels and the odd lines into the right ones.
+ */
+static void
+_dsp_reverb(pgChannelDSP *dsp, float *work, int frames, int stride,
+            float wet, float feedback, float damping, const int *lengths)
+{
+    pg_f4 damp = f4_set1(1.0f - 0.85f * damping);
+    pg_f4 gain = f4_set1(feedback * 0.5f);
+    pg_f4 damped = f4_load(dsp->damped), out, v;
+    float *lines = dsp->lines, *w;
+    float taps[4], in, left, right;
+    int nch = _dsp_channels, f, c, i;
+    int *pos = dsp->pos;
+    int len0 = lengths[0], len1 = lengths[1], len2 = lengths[2];
+    int len3 = lengths[3], max = dsp->max_length;
+
+    for (i = 0; i < PG_DSP_LINES; i++) {
+        if (pos[i] >= lengths[i])
+            pos[i] = 0;
+    }
+    for (f = 0, w = work; f < frames; f++, w += stride) {
+        for (c = 0, in = 0.0f; c < nch; c++) {
+            in += w[c];
         }
-        else if (drivername && SDL_strncasecmp("dsound", drivername,
-                                               SDL_strlen(drivername)) == 0) {
-            SDL_setenv("SDL_AUDIODRIVER", "directsound", 1);
+        in = in / nch + PG_DSP_ANTI_DENORMAL;
+
+        out = f4_set(lines[pos[0]], lines[max + pos[1]],
+                     lines[2 * max + pos[2]], lines[3 * max + pos[3]]);
+        damped = f4_add(damped, f4_mul(damp, f4_sub(out, damped)));
+        v = f4_add(f4_mul(gain, f4_hadamard(damped)), f4_set1(in));
+
+        f4_store(taps, v);
+        lines[pos[0]] = taps[0];
+        lines[max + pos[1]] = taps[1];
+        lines[2 * max + pos[2]] = taps[2];
+        lines[3 * max + pos[3]] = taps[3];
+        pos[0] = pos[0] + 1 == len0 ? 0 : pos[0] + 1;
+        pos[1] = pos[1] + 1 == len1 ? 0 : pos[1] + 1;
+        pos[2] = pos[2] + 1 == len2 ? 0 : pos[2] + 1;
+        pos[3] = pos[3] + 1 == len3 ? 0 : pos[3] + 1;
+
+        f4_store(taps, out);
+        left = (taps[0] + taps[2]) * 0.5f;
+        right = (taps[1] + taps[3]) * 0.5f;
+        if (nch == 1) {
+            w[0] += wet * ((left + right) * 0.5f - w[0]);
+            continue;
         }
-
-        if (SDL_InitSubSystem(SDL_INIT_AUDIO))
-            return RAISE(pgExc_SDLError, SDL_GetError());
-
-#if SDL_MIXER_MAJOR_VERSION >= 2 && SDL_MIXER_MINOR_VERSION >= 0 && \
-    SDL_MIXER_PATCHLEVEL >= 2
-        if (Mix_OpenAudioDevice(freq, fmt, channels, chunk, devicename,
-                                allowedchanges) == -1) {
-#else
-        if (Mix_OpenAudio(freq, fmt, channels, chunk) == -1) {
-#endif
-            SDL_QuitSubSystem(SDL_INIT_AUDIO);
-            return RAISE(pgExc_SDLError, SDL_GetError());
-            ;
+        for (c = 0; c < nch; c++) {
+            w[c] += wet * ((c & 1 ? right : left) - w[c]);
         }
-        Mix_ChannelFinished(endsound_callback);
-        Mix_VolumeMusic(127);
     }
+    f4_store(dsp->damped, damped);
+}
 
-    mx_current_music = NULL;
-    mx_queue_music = NULL;
+static void SDLCALL
+_dsp_effect(int chan, void *stream, int len, void *udata)
+{
+    pgChannelDSP *dsp = (pgChannelDSP *)udata;
+    float work[PG_DSP_BLOCK * PG_DSP_MAX_CHANNELS];
+    float coeffs[5], wet, feedback, damping;
+    int lengths[PG_DSP_LINES];
+    int filter, reset, i, n;
+    int stride = _dsp_channels > 4 ? 8 : 4;
+    int frame_size = _dsp_itemsize() * _dsp_channels;
+    int frames = len / frame_size;
+    Uint8 *buf = (Uint8 *)stream;
+
+    SDL_AtomicLock(&dsp->lock);
+    filter = dsp->filter;
+    coeffs[0] = dsp->b0;
+    coeffs[1] = dsp->b1;
+    coeffs[2] = dsp->b2;
+    coeffs[3] = dsp->a1;
+    coeffs[4] = dsp->a2;
+    wet = dsp->wet;
+    feedback = dsp->feedback;
+    damping = dsp->damping;
+    memcpy(lengths, dsp->lengths, sizeof(lengths));
+    reset = dsp->reset;
+    dsp->reset = 0;
+    SDL_AtomicUnlock(&dsp->lock);
+
+    if (reset & PG_DSP_RESET_FILTER) {
+        memset(dsp->z1, 0, sizeof(dsp->z1));
+        memset(dsp->z2, 0, sizeof(dsp->z2));
+    }
+    if ((reset & PG_DSP_RESET_REVERB) && dsp->lines) {
+        memset(dsp->lines, 0,
+               sizeof(float) * PG_DSP_LINES * (size_t)dsp->max_length);
+        memset(dsp->pos, 0, sizeof(dsp->pos));
+        memset(dsp->damped, 0, sizeof(dsp->damped));
+    }
+    if (filter == PG_FILTER_NONE && wet <= 0.0f) {
+        return;
+    }
 
-    music = import_music();
-    if (music) {
-        PyObject *ptr;
-        ptr = PyObject_GetAttrString(music, "_MUSIC_POINTER");
-        if (ptr) {
-            mx_current_music =
-                (Mix_Music **)PyCapsule_GetPointer(ptr,
-                                                   "pygame.music_mixer."
-                                                   "_MUSIC_POINTER");
-            if (!mx_current_music) {
-                PyErr_Clear();
-            }
+    for (i = 0; i < frames; i += n) {
+        n = SDL_min(frames - i, PG_DSP_BLOCK);
+        _dsp_to_float(buf + i * frame_size, work, n, stride);
+        if (filter != PG_FILTER_NONE) {
+            _dsp_filter(dsp, work, n, stride, coeffs);
         }
-        else {
-            PyErr_Clear();
+        if (wet > 0.0f) {
+            _dsp_reverb(dsp, work, n, stride, wet, feedback, damping,
+                        lengths);
         }
+        _dsp_from_float(work, buf + i * frame_size, n, stride);
+    }
+}
 
-        ptr = PyObject_GetAttrString(music, "_QUEUE_POINTER");
-        if (ptr) {
-            mx_queue_music =
-                (Mix_Music **)PyCapsule_GetPointer(ptr,
-                                                   "pygame.music_mixer."
-                                                   "_QUEUE_POINTER");
-            if (!mx_queue_music) {
-                PyErr_Clear();
-            }
-        }
-        else {
-            PyErr_Clear();
-        }
+static void SDLCALL
+_dsp_done(int chan, void *udata)
+{
+    pgChannelDSP *dsp = (pgChannelDSP *)udata;
 
-        Py_DECREF(music);
-    }
-    else {
-        PyErr_Clear();
-    }
-    Py_RETURN_NONE;
+    /* the next Sound starts without the last one's tail */
+    SDL_AtomicLock(&dsp->lock);
+    dsp->reset = PG_DSP_RESET_FILTER | PG_DSP_RESET_REVERB;
+    SDL_AtomicUnlock(&dsp->lock);
+    SDL_AtomicSet(&dsp->attached, 0);
 }
 
-static PyObject *
-pgMixer_AutoInit(PyObject *self, PyObject *_null)
+/* Registers the effects of a channel, if it has any and they are not yet
+ * registered. SDL_mixer drops the effects of a channel when a Sound stops,
+ * so this is done whenever one starts. Call without the GIL.
+ */
+static void
+_dsp_attach(int channel)
 {
-    /* Return init with defaults */
-    return _init(0, 0, 0, 0, NULL, -1);
+    pgChannelDSP *dsp = NULL;
+
+    SDL_AtomicLock(&_dsp_lock);
+    if (channel >= 0 && channel < _ndsp) {
+        dsp = _dsp[channel];
+    }
+    SDL_AtomicUnlock(&_dsp_lock);
+    if (dsp && SDL_AtomicCAS(&dsp->attached, 0, 1) &&
+        !Mix_RegisterEffect(channel, _dsp_effect, _dsp_done, dsp)) {
+        SDL_AtomicSet(&dsp->attached, 0);
+    }
 }
 
-static PyObject *
-mixer_quit(PyObject *self, PyObject *_null)
+/* Registers the effects of every playing channel that lost them, such as
+ * those that went on to a queued Sound. Called from the audio thread.
+ */
+static void
+_dsp_attach_playing(void)
 {
     int i;
-    if (SDL_WasInit(SDL_INIT_AUDIO)) {
-        Py_BEGIN_ALLOW_THREADS;
-        Mix_HaltMusic();
-        Py_END_ALLOW_THREADS;
 
-        if (channeldata) {
-            for (i = 0; i < numchanneldata; ++i) {
-                Py_XDECREF(channeldata[i].sound);
-                Py_XDECREF(channeldata[i].queue);
-            }
-            free(channeldata);
-            channeldata = NULL;
-            numchanneldata = 0;
+    for (i = 0; i < _ndsp; i++) {
+        if (Mix_Playing(i)) {
+            _dsp_attach(i);
         }
+    }
+}
 
-        if (mx_current_music) {
-            if (*mx_current_music) {
-                Py_BEGIN_ALLOW_THREADS;
-                Mix_FreeMusic(*mx_current_music);
-                Py_END_ALLOW_THREADS;
-                *mx_current_music = NULL;
-            }
-            mx_current_music = NULL;
+/* The effects of a channel, created as needed */
+static pgChannelDSP *
+_dsp_get(int channel)
+{
+    pgChannelDSP **dsps, **old = NULL, *dsp;
+    int n;
+
+    if (!_dsp_itemsize() || _dsp_channels > PG_DSP_MAX_CHANNELS) {
+        PyErr_SetString(pgExc_SDLError,
+                        "effects are not supported by the mixer format");
+        return NULL;
+    }
+    if (channel >= _ndsp) {
+        n = channel + 1;
+        dsps = (pgChannelDSP **)PyMem_Calloc(n, sizeof(pgChannelDSP *));
+        if (!dsps) {
+            PyErr_NoMemory();
+            return NULL;
         }
-        if (mx_queue_music) {
-            if (*mx_queue_music) {
-                Py_BEGIN_ALLOW_THREADS;
-                Mix_FreeMusic(*mx_queue_music);
-                Py_END_ALLOW_THREADS;
-                *mx_queue_music = NULL;
-            }
-            mx_queue_music = NULL;
+        SDL_AtomicLock(&_dsp_lock);
+        if (_ndsp) {
+            memcpy(dsps, _dsp, sizeof(pgChannelDSP *) * _ndsp);
         }
-
-        Py_BEGIN_ALLOW_THREADS;
-        Mix_CloseAudio();
-        SDL_QuitSubSystem(SDL_INIT_AUDIO);
-        Py_END_ALLOW_THREADS;
+        old = _dsp;
+        _dsp = dsps;
+        _ndsp = n;
+        SDL_AtomicUnlock(&_dsp_lock);
+        PyMem_Free(old);
     }
-    Py_RETURN_NONE;
+    if (!_dsp[channel]) {
+        dsp = (pgChannelDSP *)PyMem_Calloc(1, sizeof(pgChannelDSP));
+        if (!dsp) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+        SDL_AtomicLock(&_dsp_lock);
+        _dsp[channel] = dsp;
+        SDL_AtomicUnlock(&_dsp_lock);
+    }
+    return _dsp[channel];
 }
 
-static PyObject *
-pg_mixer_init(PyObject *self, PyObject *args, PyObject *keywds)
+/* Frees the effects once the audio device is closed */
+static void
+_dsp_free_all(void)
 {
-    int freq = 0, size = 0, channels = 0, chunk = 0, allowedchanges = -1;
-    char *devicename = NULL;
+    int i;
 
-    static char *kwids[] = {"frequency", "size",       "channels",
-                            "buffer",    "devicename", "allowedchanges",
-                            NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, keywds, "|iiiizi", kwids, &freq,
-                                     &size, &channels, &chunk, &devicename,
-                                     &allowedchanges)) {
-        return NULL;
+    for (i = 0; i < _ndsp; i++) {
+        if (_dsp[i]) {
+            PyMem_Free(_dsp[i]->lines);
+            PyMem_Free(_dsp[i]);
+        }
     }
-    return _init(freq, size, channels, chunk, devicename, allowedchanges);
+    PyMem_Free(_dsp);
+    _dsp = NULL;
+    _ndsp = 0;
 }
 
-static PyObject *
-pg_mixer_get_init(PyObject *self, PyObject *_null)
+/* The sample clock counts the frames mixed since the mixer was opened, in
+ * an effect on the final mix. The same effect starts the Sounds scheduled
+ * with Channel.play_at() in the mixer buffer their onset falls in. A buffer
+ * is mixed at once, so each starts with the buffer, and a delay effect on
+ * its channel moves it onto the exact frame.
+ */
+#define PG_MAX_SCHEDULED 64
+
+typedef struct {
+    int channel;
+    Mix_Chunk *chunk;
+    int loops;
+    Uint64 onset;
+    PyObject *sound;
+} pgScheduled;
+
+typedef struct {
+    int delay; /* in bytes, less than a mixer buffer */
+    Uint8 *carry; /* the end of the last buffer, pushed out by the delay */
+    Uint8 *spill;
+} pgDelay;
+
+static SDL_SpinLock _clock_lock = 0;
+static Uint64 _clock = 0;
+static int _clock_frame_size = 0;
+static Uint8 _clock_silence = 0;
+static SDL_mutex *_sched_lock = NULL; /* guards the fields below */
+static pgScheduled _scheduled[PG_MAX_SCHEDULED];
+static SDL_atomic_t _nscheduled;
+
+static Uint64
+_get_clock(void)
 {
-    int freq, channels, realform;
-    Uint16 format;
+    Uint64 clock;
 
-    if (!SDL_WasInit(SDL_INIT_AUDIO))
-        Py_RETURN_NONE;
+    SDL_AtomicLock(&_clock_lock);
+    clock = _clock;
+    SDL_AtomicUnlock(&_clock_lock);
+    return clock;
+}
 
-    if (!Mix_QuerySpec(&freq, &format, &channels))
-        Py_RETURN_NONE;
+static void SDLCALL
+_delay_effect(int chan, void *stream, int len, void *udata)
+{
+    pgDelay *d = (pgDelay *)udata;
+    Uint8 *buf = (Uint8 *)stream, *held;
 
-    // create a signed or unsigned number of bits per sample
-    // XXX: When mixer is init'd with a format of -8, this returns +8
-    realform = (format & ~0xff) ? -(format & 0xff) : format & 0xff;
-    return Py_BuildValue("(iii)", freq, realform, channels);
+    if (len < d->delay) {
+        return;
+    }
+    memcpy(d->spill, buf + len - d->delay, d->delay);
+    memmove(buf + d->delay, buf, len - d->delay);
+    memcpy(buf, d->carry, d->delay);
+    held = d->carry;
+    d->carry = d->spill;
+    d->spill = held;
 }
 
-static PyObject *
-pre_init(PyObject *self, PyObject *args, PyObject *keywds)
+static void SDLCALL
+_delay_done(int chan, void *udata)
 {
-    static char *kwids[] = {"frequency", "size",       "channels",
-                            "buffer",    "devicename", "allowedchanges",
-                            NULL};
+    SDL_free(udata);
+}
 
-    request_frequency = 0;
-    request_size = 0;
-    request_channels = 0;
-    request_chunksize = 0;
-    request_devicename = NULL;
-    request_allowedchanges = -1;
-    if (!PyArg_ParseTupleAndKeywords(
-            args, keywds, "|iiiizi", kwids, &request_frequency, &request_size,
-            &request_channels, &request_chunksize, &request_devicename,
-            &request_allowedchanges))
-        return NULL;
-    if (!request_frequency) {
-        request_frequency = PYGAME_MIXER_DEFAULT_FREQUENCY;
-    }
-    if (!request_size) {
-        request_size = PYGAME_MIXER_DEFAULT_SIZE;
+/* Starts a scheduled Sound at the start of the buffer about to be mixed,
+ * which begins at frame clock and is len bytes long.
+ */
+static void
+_start_scheduled(pgScheduled *sched, Uint64 clock, int len)
+{
+    int delay = 0, channelnum;
+    pgDelay *d;
+    PyGILState_STATE gstate;
+
+    if (sched->onset > clock) {
+        delay = (int)(sched->onset - clock) * _clock_frame_size;
+        delay = SDL_min(delay, len - _clock_frame_size);
     }
-    if (!request_channels) {
-        request_channels = PYGAME_MIXER_DEFAULT_CHANNELS;
+    channelnum = Mix_PlayChannelTimed(sched->channel, sched->chunk,
+                                      sched->loops, -1);
+    if (channelnum != -1) {
+        Mix_GroupChannel(channelnum, (int)(intptr_t)sched->chunk);
+        _dsp_attach(channelnum);
+        if (delay > 0) {
+            d = (pgDelay *)SDL_malloc(sizeof(pgDelay) + 2 * delay);
+            if (d) {
+                d->delay = delay;
+                d->carry = (Uint8 *)(d + 1);
+                d->spill = d->carry + delay;
+                memset(d->carry, _clock_silence, delay);
+                if (!Mix_RegisterEffect(channelnum, _delay_effect,
+                                        _delay_done, d)) {
+                    SDL_free(d);
+                }
+            }
+        }
     }
-    if (!request_chunksize) {
-        request_chunksize = PYGAME_MIXER_DEFAULT_CHUNKSIZE;
+
+    gstate = PyGILState_Ensure();
+    if (channelnum != -1 && channeldata && channelnum < numchanneldata) {
+        Py_XDECREF(channeldata[channelnum].sound);
+        Py_XDECREF(channeldata[channelnum].queue);
+        channeldata[channelnum].sound = sched->sound;
+        channeldata[channelnum].queue = NULL;
     }
-    if (request_allowedchanges == -1) {
-        request_allowedchanges = PYGAME_MIXER_DEFAULT_ALLOWEDCHANGES;
+    else {
+        Py_DECREF(sched->sound);
     }
-    Py_RETURN_NONE;
+    PyGILState_Release(gstate);
 }
 
-/* sound object methods */
-
-static PyObject *
-pgSound_Play(PyObject *self, PyObject *args, PyObject *kwargs)
+static void SDLCALL
+_clock_effect(int chan, void *stream, int len, void *udata)
 {
-    Mix_Chunk *chunk = pgSound_AsChunk(self);
-    int channelnum = -1;
-    int loops = 0, playtime = -1, fade_ms = 0;
+    pgScheduled due[PG_MAX_SCHEDULED];
+    int ndue = 0, i, n;
+    Uint64 clock;
 
-    char *kwids[] = {"loops", "maxtime", "fade_ms", NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|iii", kwids, &loops,
-                                     &playtime, &fade_ms))
-        return NULL;
+    SDL_AtomicLock(&_clock_lock);
+    _clock += len / _clock_frame_size;
+    clock = _clock;
+    SDL_AtomicUnlock(&_clock_lock);
 
-    Py_BEGIN_ALLOW_THREADS;
-    if (fade_ms > 0) {
-        channelnum =
-            Mix_FadeInChannelTimed(-1, chunk, loops, fade_ms, playtime);
+    if (_ndsp) {
+        _dsp_attach_playing();
     }
-    else {
-        channelnum = Mix_PlayChannelTimed(-1, chunk, loops, playtime);
+    if (!SDL_AtomicGet(&_nscheduled)) {
+        return;
     }
-    Py_END_ALLOW_THREADS;
-    if (channelnum == -1)
-        Py_RETURN_NONE;
+    /* take out the Sounds due in the next buffer, which has the same
+       length as this one */
+    SDL_LockMutex(_sched_lock);
+    n = SDL_AtomicGet(&_nscheduled);
+    for (i = 0; i < n;) {
+        if (_scheduled[i].onset < clock + len / _clock_frame_size) {
+            due[ndue++] = _scheduled[i];
+            _scheduled[i] = _scheduled[--n];
+        }
+        else {
+            ++i;
+        }
+    }
+    SDL_AtomicSet(&_nscheduled, n);
+    SDL_UnlockMutex(_sched_lock);
 
-    Py_XDECREF(channeldata[channelnum].sound);
-    Py_XDECREF(channeldata[channelnum].queue);
-    channeldata[channelnum].queue = NULL;
-    channeldata[channelnum].sound = self;
-    Py_INCREF(self);
+    for (i = 0; i < ndue; i++) {
+        _start_scheduled(&due[i], clock, len);
+    }
+}
 
-    // make sure volume on this arbitrary channel is set to full
-    Mix_Volume(channelnum, 128);
+/* Cancels the Sound scheduled on a channel, or on all of them for -1. */
+static void
+_unschedule(int channel)
+{
+    PyObject *sounds[PG_MAX_SCHEDULED];
+    int nsounds = 0, i, n;
 
-    Py_BEGIN_ALLOW_THREADS;
-    Mix_GroupChannel(channelnum, (int)(intptr_t)chunk);
-    Py_END_ALLOW_THREADS;
+    if (!_sched_lock) {
+        return;
+    }
+    SDL_LockMutex(_sched_lock);
+    n = SDL_AtomicGet(&_nscheduled);
+    for (i = 0; i < n;) {
+        if (channel == -1 || _scheduled[i].channel == channel) {
+            sounds[nsounds++] = _scheduled[i].sound;
+            _scheduled[i] = _scheduled[--n];
+        }
+        else {
+            ++i;
+        }
+    }
+    SDL_AtomicSet(&_nscheduled, n);
+    SDL_UnlockMutex(_sched_lock);
 
-    return pgChannel_New(channelnum);
+    /* after unlocking, as freeing a Sound waits on the mixer */
+    for (i = 0; i < nsounds; i++) {
+        Py_DECREF(sounds[i]);
+    }
 }
 
-static PyObject *
-snd_get_num_channels(PyObject *self, PyObject *_null)
+/* Voices are a pool of light players for short, overlapping Sounds, such
+ * as many bullets firing at once. They skip SDL_mixer's channels: an
+ * effect on the final mix adds every active voice into it. When the pool
+ * is full, a new Sound takes the voice of the oldest Sound with the
+ * lowest priority, if that is not above its own. The audio thread never
+ * takes the GIL for voices; a finished voice keeps its Sound until the
+ * voice is reused or the voices are stopped.
+ */
+typedef struct {
+    Mix_Chunk *chunk; /* NULL when the voice is free */
+    PyObject *sound;
+    Uint32 pos; /* in bytes */
+    Uint32 serial;
+    int loops;
+    int priority;
+    float volume;
+} pgVoice;
+
+static SDL_mutex *_voice_lock = NULL; /* guards the fields below */
+static pgVoice *_voices = NULL;
+static int _nvoices = 0;
+static Uint32 _voice_serial = 0;
+static Uint32 _voices_started = 0;
+static Uint32 _voices_stolen = 0;
+static Uint32 _voices_rejected = 0;
+static int _voices_peak = 0;
+static SDL_atomic_t _voices_active;
+static SDL_atomic_t _voices_paused;
+
+#define PG_VOICE_CLAMP(v, lo, hi) ((v) < (lo) ? (lo) : (v) > (hi) ? (hi) : (v))
+
+/* Adds len bytes of samples into the mix, scaled by gain (at most 1) */
+static void
+_voice_accumulate(Uint8 *dst, const Uint8 *src, int len, float gain)
 {
-    Mix_Chunk *chunk = pgSound_AsChunk(self);
-    MIXER_INIT_CHECK();
-    return PyLong_FromLong(Mix_GroupCount((int)(intptr_t)chunk));
+    int i = 0, n, v;
+    Sint64 v64;
+
+    switch (_dsp_format) {
+        case AUDIO_S16SYS: {
+            Sint16 *d = (Sint16 *)dst;
+            const Sint16 *s = (const Sint16 *)src;
+            int g = (int)(gain * 32768.0f + 0.5f); /* 32768 is unity */
+
+            n = len / 2;
+#ifdef PG_DSP_SIMD
+            if (g >= 32768) {
+                for (; i + 8 <= n; i += 8) {
+                    __m128i a = _mm_loadu_si128((const __m128i *)(d + i));
+                    __m128i b = _mm_loadu_si128((const __m128i *)(s + i));
+                    _mm_storeu_si128((__m128i *)(d + i), _mm_adds_epi16(a, b));
+                }
+            }
+            else {
+                __m128i vg = _mm_set1_epi16((short)g);
+                for (; i + 8 <= n; i += 8) {
+                    __m128i a = _mm_loadu_si128((const __m128i *)(d + i));
+                    __m128i b = _mm_loadu_si128((const __m128i *)(s + i));
+                    b = _mm_slli_epi16(_mm_mulhi_epi16(b, vg), 1);
+                    _mm_storeu_si128((__m128i *)(d + i), _mm_adds_epi16(a, b));
+                }
+            }
+#endif /* PG_DSP_SIMD */
+            for (; i < n; i++) {
+                v = d[i] + ((s[i] * g) >> 15);
+                d[i] = (Sint16)PG_VOICE_CLAMP(v, -32768, 32767);
+            }
+            break;
+        }
+        case AUDIO_F32SYS: {
+            float *d = (float *)dst;
+            const float *s = (const float *)src;
+            pg_f4 vg = f4_set1(gain);
+
+            n = len / 4;
+            for (; i + 4 <= n; i += 4) {
+                f4_store(d + i, f4_add(f4_load(d + i),
+                                       f4_mul(f4_load(s + i), vg)));
+            }
+            for (; i < n; i++) {
+                d[i] += s[i] * gain;
+            }
+            break;
+        }
+        case AUDIO_S32SYS: {
+            Sint32 *d = (Sint32 *)dst;
+            const Sint32 *s = (const Sint32 *)src;
+
+            n = len / 4;
+            for (; i < n; i++) {
+                v64 = d[i] + (Sint64)((double)s[i] * gain);
+                d[i] = (Sint32)PG_VOICE_CLAMP(v64, -2147483647 - 1,
+                                              2147483647);
+            }
+            break;
+        }
+        case AUDIO_S8:
+            for (; i < len; i++) {
+                v = ((Sint8 *)dst)[i] + (int)(((const Sint8 *)src)[i] * gain);
+                ((Sint8 *)dst)[i] = (Sint8)PG_VOICE_CLAMP(v, -128, 127);
+            }
+            break;
+        case AUDIO_U8:
+            for (; i < len; i++) {
+                v = dst[i] + (int)((src[i] - 128) * gain);
+                dst[i] = (Uint8)PG_VOICE_CLAMP(v, 0, 255);
+            }
+            break;
+    }
 }
 
-static PyObject *
-snd_fadeout(PyObject *self, PyObject *args)
+/* Mixes a voice into len bytes of the mix. Called with _voice_lock held. */
+static void
+_voice_render(pgVoice *voice, Uint8 *stream, int len)
 {
-    Mix_Chunk *chunk = pgSound_AsChunk(self);
-    int _time;
-    if (!PyArg_ParseTuple(args, "i", &_time))
-        return NULL;
-
-    MIXER_INIT_CHECK();
-
-    Py_BEGIN_ALLOW_THREADS;
-    Mix_FadeOutGroup((int)(intptr_t)chunk, _time);
-    Py_END_ALLOW_THREADS;
-    Py_RETURN_NONE;
+    Mix_Chunk *chunk = voice->chunk;
+    float gain = voice->volume * chunk->volume / (float)MIX_MAX_VOLUME;
+    Uint32 n;
+
+    while (len > 0) {
+        n = SDL_min((Uint32)len, chunk->alen - voice->pos);
+        _voice_accumulate(stream, chunk->abuf + voice->pos, n, gain);
+        stream += n;
+        len -= n;
+        voice->pos += n;
+        if (voice->pos >= chunk->alen) {
+            if (voice->loops == 0) {
+                voice->chunk = NULL;
+                SDL_AtomicAdd(&_voices_active, -1);
+                return;
+            }
+            if (voice->loops > 0) {
+                --voice->loops;
+            }
+            voice->pos = 0;
+        }
+    }
 }
 
-static PyObject *
-snd_stop(PyObject *self, PyObject *_null)
+static void SDLCALL
+_voice_effect(int chan, void *stream, int len, void *udata)
 {
-    Mix_Chunk *chunk = pgSound_AsChunk(self);
-    MIXER_INIT_CHECK();
-    Py_BEGIN_ALLOW_THREADS;
-    Mix_HaltGroup((int)(intptr_t)chunk);
-    Py_END_ALLOW_THREADS;
-    Py_RETURN_NONE;
+    int i;
+
+    if (!SDL_AtomicGet(&_voices_active) || SDL_AtomicGet(&_voices_paused)) {
+        return;
+    }
+    SDL_LockMutex(_voice_lock);
+    for (i = 0; i < _nvoices; i++) {
+        if (_voices[i].chunk) {
+            _voice_render(&_voices[i], (Uint8 *)stream, len);
+        }
+    }
+    SDL_UnlockMutex(_voice_lock);
 }
 
-static PyObject *
-snd_set_volume(PyObject *self, PyObject *args)
+/* Resizes the pool to count voices, stopping all of them if stop is set,
+ * and releases the Sounds the stopped and finished voices held.
+ * Needs the GIL.
+ */
+static int
+_resize_voices(int count, int stop)
 {
-    Mix_Chunk *chunk = pgSound_AsChunk(self);
-    float volume;
+    PyObject **sounds;
+    pgVoice *voices;
+    int nsounds = 0, i;
 
-    if (!PyArg_ParseTuple(args, "f", &volume))
-        return NULL;
-
-    MIXER_INIT_CHECK();
+    if (!_voice_lock) {
+        return 0;
+    }
+    sounds = PyMem_New(PyObject *, _nvoices + 1);
+    if (!sounds) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    SDL_LockMutex(_voice_lock);
+    for (i = 0; i < _nvoices; i++) {
+        if (stop || i >= count || !_voices[i].chunk) {
+            if (_voices[i].chunk) {
+                _voices[i].chunk = NULL;
+                SDL_AtomicAdd(&_voices_active, -1);
+            }
+            if (_voices[i].sound) {
+                sounds[nsounds++] = _voices[i].sound;
+                _voices[i].sound = NULL;
+            }
+        }
+    }
+    if (!count) {
+        free(_voices);
+        _voices = NULL;
+        _nvoices = 0;
+    }
+    else if (count < _nvoices) {
+        /* keep the larger block, but only use the start of it */
+        _nvoices = count;
+    }
+    else if (count > _nvoices) {
+        voices = (pgVoice *)realloc(_voices, sizeof(pgVoice) * count);
+        if (voices) {
+            memset(voices + _nvoices, 0,
+                   sizeof(pgVoice) * (count - _nvoices));
+            _voices = voices;
+            _nvoices = count;
+        }
+        else {
+            count = -1;
+        }
+    }
+    SDL_UnlockMutex(_voice_lock);
 
-    Mix_VolumeChunk(chunk, (int)(volume * 128));
-    Py_RETURN_NONE;
+    /* after unlocking, as freeing a Sound waits on the mixer */
+    for (i = 0; i < nsounds; i++) {
+        Py_DECREF(sounds[i]);
+    }
+    PyMem_Free(sounds);
+    if (count == -1) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    return 0;
 }
 
 static PyObject *
-snd_get_volume(PyObject *self, PyObject *_null)
+import_music(void)
 {
-    Mix_Chunk *chunk = pgSound_AsChunk(self);
-    int volume;
-    MIXER_INIT_CHECK();
-
-    volume = Mix_VolumeChunk(chunk, -1);
-    return PyFloat_FromDouble(volume / 128.0);
+    PyObject *music = PyImport_ImportModule(IMPPREFIX "mixer_music");
+    if (music == NULL) {
+        PyErr_Clear();
+        music = PyImport_ImportModule(RELATIVE_MODULE("mixer_music"));
+    }
+    return music;
 }
 
 static PyObject *
-snd_get_length(PyObject *self, PyObject *_null)
+_init(int freq, int size, int channels, int chunk, char *devicename,
+      int allowedchanges)
 {
-    Mix_Chunk *chunk = pgSound_AsChunk(self);
-    int freq, channels, mixerbytes, numsamples;
-    Uint16 format;
-    MIXER_INIT_CHECK();
+    Uint16 fmt = 0;
+    int i;
+    PyObject *music;
+    char *drivername;
 
-    Mix_QuerySpec(&freq, &format, &channels);
+    if (!freq) {
+        freq = request_frequency;
+    }
+    if (!size) {
+        size = request_size;
+    }
+
+    if (allowedchanges == -1) {
+        allowedchanges = request_allowedchanges;
+    }
+
+    if (!channels) {
+        channels = request_channels;
+    }
+    if (allowedchanges & SDL_AUDIO_ALLOW_CHANNELS_CHANGE) {
+        if (channels <= 1)
+            channels = 1;
+        else if (channels <= 3)
+            channels = 2;
+        else if (channels <= 5)
+            channels = 4;
+        else
+            channels = 6;
+    }
+    else {
+        switch (channels) {
+            case 1:
+            case 2:
+            case 4:
+            case 6:
+                break;
+            default:
+                return RAISE(PyExc_ValueError,
+                             "'channels' must be 1, 2, 4, or 6");
+        }
+    }
+
+    if (!chunk) {
+        chunk = request_chunksize;
+    }
+
+    if (!devicename) {
+        devicename = request_devicename;
+    }
+
+    /* printf("size:%d:\n", size); */
+
+    switch (size) {
+        case 8:
+            fmt = AUDIO_U8;
+            break;
+        case -8:
+            fmt = AUDIO_S8;
+            break;
+        case 16:
+            fmt = AUDIO_U16SYS;
+            break;
+        case -16:
+            fmt = AUDIO_S16SYS;
+            break;
+        case 32:
+            fmt = AUDIO_F32SYS;
+            break;
+        default:
+            PyErr_Format(PyExc_ValueError, "unsupported size %i", size);
+            return NULL;
+    }
+
+    /* printf("size:%d:\n", size); */
+
+    /*make chunk a power of 2*/
+    for (i = 0; 1 << i < chunk; ++i)
+        ;                     /*yes, semicolon on for loop*/
+    chunk = MAX(1 << i, 256); /*do this after for loop exits*/
+
+    if (!SDL_WasInit(SDL_INIT_AUDIO)) {
+        if (!channeldata) { /*should always be null*/
+            channeldata = (struct ChannelData *)malloc(
+                sizeof(struct ChannelData) * MIX_CHANNELS);
+            if (!channeldata) {
+                return PyErr_NoMemory();
+            }
+            numchanneldata = MIX_CHANNELS;
+            for (i = 0; i < numchanneldata; ++i) {
+                channeldata[i].sound = NULL;
+                channeldata[i].queue = NULL;
+                channeldata[i].endevent = 0;
+            }
+        }
+
+        /* Compatibility:
+            pulse and dsound audio drivers were renamed in SDL2,
+            and we don't want it to fail.
+        */
+        drivername = SDL_getenv("SDL_AUDIODRIVER");
+        if (drivername && SDL_strncasecmp("pulse", drivername,
+                                          SDL_strlen(drivername)) == 0) {
+            SDL_setenv("SDL_AUDIODRIVER", "pulseaudio", 1);
+        }
+        else if (drivername && SDL_strncasecmp("dsound", drivername,
+                                               SDL_strlen(drivername)) == 0) {
+            SDL_setenv("SDL_AUDIODRIVER", "directsound", 1);
+        }
+
+        if (SDL_InitSubSystem(SDL_INIT_AUDIO))
+            return RAISE(pgExc_SDLError, SDL_GetError());
+
+#if SDL_MIXER_MAJOR_VERSION >= 2 && SDL_MIXER_MINOR_VERSION >= 0 && \
+    SDL_MIXER_PATCHLEVEL >= 2
+        if (Mix_OpenAudioDevice(freq, fmt, channels, chunk, devicename,
+                                allowedchanges) == -1) {
+#else
+        if (Mix_OpenAudio(freq, fmt, channels, chunk) == -1) {
+#endif
+            SDL_QuitSubSystem(SDL_INIT_AUDIO);
+            return RAISE(pgExc_SDLError, SDL_GetError());
+            ;
+        }
+        Mix_ChannelFinished(endsound_callback);
+        Mix_VolumeMusic(127);
+
+        if (!_sched_lock) {
+            _sched_lock = SDL_CreateMutex();
+        }
+        if (!_voice_lock) {
+            _voice_lock = SDL_CreateMutex();
+        }
+        _voices_started = _voices_stolen = _voices_rejected = 0;
+        _voices_peak = 0;
+        SDL_AtomicSet(&_voices_paused, 0);
+        Mix_QuerySpec(&freq, &fmt, &channels);
+        _clock = 0;
+        _clock_frame_size = SDL_AUDIO_BITSIZE(fmt) / 8 * channels;
+        _clock_silence = SDL_AUDIO_ISSIGNED(fmt) ? 0 : 0x80;
+        _dsp_format = fmt;
+        _dsp_channels = channels;
+        if (!_sched_lock || !_voice_lock ||
+            !Mix_RegisterEffect(MIX_CHANNEL_POST, _clock_effect, NULL,
+                                NULL) ||
+            !Mix_RegisterEffect(MIX_CHANNEL_POST, _voice_effect, NULL,
+                                NULL)) {
+            PyErr_SetString(pgExc_SDLError, SDL_GetError());
+            Mix_CloseAudio();
+            SDL_QuitSubSystem(SDL_INIT_AUDIO);
+            return NULL;
+        }
+    }
+
+    mx_current_music = NULL;
+    mx_quit_music_queue = NULL;
+
+    music = import_music();
+    if (music) {
+        PyObject *ptr;
+        ptr = PyObject_GetAttrString(music, "_MUSIC_POINTER");
+        if (ptr) {
+            mx_current_music =
+                (Mix_Music **)PyCapsule_GetPointer(ptr,
+                                                   "pygame.music_mixer."
+                                                   "_MUSIC_POINTER");
+            if (!mx_current_music) {
+                PyErr_Clear();
+            }
+        }
+        else {
+            PyErr_Clear();
+        }
+
+        ptr = PyObject_GetAttrString(music, "_QUEUE_QUIT");
+        if (ptr) {
+            mx_quit_music_queue =
+                (void (*)(void))PyCapsule_GetPointer(ptr,
+                                                     "pygame.music_mixer."
+                                                     "_QUEUE_QUIT");
+            if (!mx_quit_music_queue) {
+                PyErr_Clear();
+            }
+        }
+        else {
+            PyErr_Clear();
+        }
+
+        Py_DECREF(music);
+    }
+    else {
+        PyErr_Clear();
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pgMixer_AutoInit(PyObject *self, PyObject *_null)
+{
+    /* Return init with defaults */
+    return _init(0, 0, 0, 0, NULL, -1);
+}
+
+static PyObject *
+mixer_quit(PyObject *self, PyObject *_null)
+{
+    int i;
+    if (SDL_WasInit(SDL_INIT_AUDIO)) {
+        Py_BEGIN_ALLOW_THREADS;
+        _load_shutdown();
+        /* so the halt does not start the next queued track */
+        if (mx_quit_music_queue) {
+            mx_quit_music_queue();
+            mx_quit_music_queue = NULL;
+        }
+        Mix_HaltMusic();
+        Py_END_ALLOW_THREADS;
+        _unschedule(-1);
+        if (_resize_voices(0, 1)) {
+            return NULL;
+        }
+
+        if (channeldata) {
+            for (i = 0; i < numchanneldata; ++i) {
+                Py_XDECREF(channeldata[i].sound);
+                Py_XDECREF(channeldata[i].queue);
+            }
+            free(channeldata);
+            channeldata = NULL;
+            numchanneldata = 0;
+        }
+
+        if (mx_current_music) {
+            if (*mx_current_music) {
+                Py_BEGIN_ALLOW_THREADS;
+                Mix_FreeMusic(*mx_current_music);
+                Py_END_ALLOW_THREADS;
+                *mx_current_music = NULL;
+            }
+            mx_current_music = NULL;
+        }
+
+        Py_BEGIN_ALLOW_THREADS;
+        Mix_CloseAudio();
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        Py_END_ALLOW_THREADS;
+        _dsp_free_all();
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_mixer_init(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    int freq = 0, size = 0, channels = 0, chunk = 0, allowedchanges = -1;
+    char *devicename = NULL;
+
+    static char *kwids[] = {"frequency", "size",       "channels",
+                            "buffer",    "devicename", "allowedchanges",
+                            NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "|iiiizi", kwids, &freq,
+                                     &size, &channels, &chunk, &devicename,
+                                     &allowedchanges)) {
+        return NULL;
+    }
+    return _init(freq, size, channels, chunk, devicename, allowedchanges);
+}
+
+static PyObject *
+pg_mixer_get_init(PyObject *self, PyObject *_null)
+{
+    int freq, channels, realform;
+    Uint16 format;
+
+    if (!SDL_WasInit(SDL_INIT_AUDIO))
+        Py_RETURN_NONE;
+
+    if (!Mix_QuerySpec(&freq, &format, &channels))
+        Py_RETURN_NONE;
+
+    // create a signed or unsigned number of bits per sample
+    // XXX: When mixer is init'd with a format of -8, this returns +8
+    realform = (format & ~0xff) ? -(format & 0xff) : format & 0xff;
+    return Py_BuildValue("(iii)", freq, realform, channels);
+}
+
+static PyObject *
+pre_init(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwids[] = {"frequency", "size",       "channels",
+                            "buffer",    "devicename", "allowedchanges",
+                            NULL};
+
+    request_frequency = 0;
+    request_size = 0;
+    request_channels = 0;
+    request_chunksize = 0;
+    request_devicename = NULL;
+    request_allowedchanges = -1;
+    if (!PyArg_ParseTupleAndKeywords(
+            args, keywds, "|iiiizi", kwids, &request_frequency, &request_size,
+            &request_channels, &request_chunksize, &request_devicename,
+            &request_allowedchanges))
+        return NULL;
+    if (!request_frequency) {
+        request_frequency = PYGAME_MIXER_DEFAULT_FREQUENCY;
+    }
+    if (!request_size) {
+        request_size = PYGAME_MIXER_DEFAULT_SIZE;
+    }
+    if (!request_channels) {
+        request_channels = PYGAME_MIXER_DEFAULT_CHANNELS;
+    }
+    if (!request_chunksize) {
+        request_chunksize = PYGAME_MIXER_DEFAULT_CHUNKSIZE;
+    }
+    if (request_allowedchanges == -1) {
+        request_allowedchanges = PYGAME_MIXER_DEFAULT_ALLOWEDCHANGES;
+    }
+    Py_RETURN_NONE;
+}
+
+/* sound object methods */
+
+static PyObject *
+pgSound_Play(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    Mix_Chunk *chunk = pgSound_AsChunk(self);
+    int channelnum = -1;
+    int loops = 0, playtime = -1, fade_ms = 0;
+
+    char *kwids[] = {"loops", "maxtime", "fade_ms", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|iii", kwids, &loops,
+                                     &playtime, &fade_ms))
+        return NULL;
+
+    Py_BEGIN_ALLOW_THREADS;
+    if (fade_ms > 0) {
+        channelnum =
+            Mix_FadeInChannelTimed(-1, chunk, loops, fade_ms, playtime);
+    }
+    else {
+        channelnum = Mix_PlayChannelTimed(-1, chunk, loops, playtime);
+    }
+    Py_END_ALLOW_THREADS;
+    if (channelnum == -1)
+        Py_RETURN_NONE;
+
+    Py_XDECREF(channeldata[channelnum].sound);
+    Py_XDECREF(channeldata[channelnum].queue);
+    channeldata[channelnum].queue = NULL;
+    channeldata[channelnum].sound = self;
+    Py_INCREF(self);
+
+    // make sure volume on this arbitrary channel is set to full
+    Mix_Volume(channelnum, 128);
+
+    Py_BEGIN_ALLOW_THREADS;
+    Mix_GroupChannel(channelnum, (int)(intptr_t)chunk);
+    _dsp_attach(channelnum);
+    Py_END_ALLOW_THREADS;
+
+    return pgChannel_New(channelnum);
+}
+
+static PyObject *
+snd_get_num_channels(PyObject *self, PyObject *_null)
+{
+    Mix_Chunk *chunk = pgSound_AsChunk(self);
+    MIXER_INIT_CHECK();
+    return PyLong_FromLong(Mix_GroupCount((int)(intptr_t)chunk));
+}
+
+static PyObject *
+snd_fadeout(PyObject *self, PyObject *args)
+{
+    Mix_Chunk *chunk = pgSound_AsChunk(self);
+    int _time;
+    if (!PyArg_ParseTuple(args, "i", &_time))
+        return NULL;
+
+    MIXER_INIT_CHECK();
+
+    Py_BEGIN_ALLOW_THREADS;
+    Mix_FadeOutGroup((int)(intptr_t)chunk, _time);
+    Py_END_ALLOW_THREADS;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+snd_stop(PyObject *self, PyObject *_null)
+{
+    Mix_Chunk *chunk = pgSound_AsChunk(self);
+    MIXER_INIT_CHECK();
+    Py_BEGIN_ALLOW_THREADS;
+    Mix_HaltGroup((int)(intptr_t)chunk);
+    Py_END_ALLOW_THREADS;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+snd_set_volume(PyObject *self, PyObject *args)
+{
+    Mix_Chunk *chunk = pgSound_AsChunk(self);
+    float volume;
+
+    if (!PyArg_ParseTuple(args, "f", &volume))
+        return NULL;
+
+    MIXER_INIT_CHECK();
+
+    Mix_VolumeChunk(chunk, (int)(volume * 128));
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+snd_get_volume(PyObject *self, PyObject *_null)
+{
+    Mix_Chunk *chunk = pgSound_AsChunk(self);
+    int volume;
+    MIXER_INIT_CHECK();
+
+    volume = Mix_VolumeChunk(chunk, -1);
+    return PyFloat_FromDouble(volume / 128.0);
+}
+
+static PyObject *
+snd_get_length(PyObject *self, PyObject *_null)
+{
+    Mix_Chunk *chunk = pgSound_AsChunk(self);
+    int freq, channels, mixerbytes, numsamples;
+    Uint16 format;
+    MIXER_INIT_CHECK();
+
+    Mix_QuerySpec(&freq, &format, &channels);
     if (format == AUDIO_S8 || format == AUDIO_U8)
         mixerbytes = 1;
     else if (format == AUDIO_F32LSB || format == AUDIO_F32MSB) {
         mixerbytes = 4;
     }
-    else
-        mixerbytes = 2;
-    numsamples = chunk->alen / mixerbytes / channels;
+    else
+        mixerbytes = 2;
+    numsamples = chunk->alen / mixerbytes / channels;
+
+    return PyFloat_FromDouble((float)numsamples / (float)freq);
+}
+
+static PyObject *
+snd_get_raw(PyObject *self, PyObject *_null)
+{
+    Mix_Chunk *chunk = pgSound_AsChunk(self);
+
+    MIXER_INIT_CHECK();
+
+    return PyBytes_FromStringAndSize((const char *)chunk->abuf,
+                                     (Py_ssize_t)chunk->alen);
+}
+
+static PyObject *
+snd_get_arraystruct(PyObject *self, void *closure)
+{
+    Py_buffer view;
+    PyObject *cobj;
+
+    if (snd_getbuffer(self, &view, PyBUF_RECORDS)) {
+        return 0;
+    }
+    cobj = pgBuffer_AsArrayStruct(&view);
+    snd_releasebuffer(view.obj, &view);
+    Py_XDECREF(view.obj);
+    return cobj;
+}
+
+static PyObject *
+snd_get_arrayinterface(PyObject *self, void *closure)
+{
+    Py_buffer view;
+    PyObject *dict;
+
+    if (snd_getbuffer(self, &view, PyBUF_RECORDS)) {
+        return 0;
+    }
+    dict = pgBuffer_AsArrayInterface(&view);
+    snd_releasebuffer(self, &view);
+    Py_DECREF(self);
+    return dict;
+}
+
+static PyObject *
+snd_get_samples_address(PyObject *self, PyObject *closure)
+{
+    Mix_Chunk *chunk = pgSound_AsChunk(self);
+
+    MIXER_INIT_CHECK();
+
+#if SIZEOF_VOID_P > SIZEOF_LONG
+    return PyLong_FromUnsignedLongLong((unsigned PY_LONG_LONG)chunk->abuf);
+#else
+    return PyLong_FromUnsignedLong((unsigned long)chunk->abuf);
+#endif
+}
+
+PyMethodDef sound_methods[] = {
+    {"play", (PyCFunction)pgSound_Play, METH_VARARGS | METH_KEYWORDS,
+     DOC_SOUNDPLAY},
+    {"get_num_channels", snd_get_num_channels, METH_NOARGS,
+     DOC_SOUNDGETNUMCHANNELS},
+    {"fadeout", snd_fadeout, METH_VARARGS, DOC_SOUNDFADEOUT},
+    {"stop", snd_stop, METH_NOARGS, DOC_SOUNDSTOP},
+    {"set_volume", snd_set_volume, METH_VARARGS, DOC_SOUNDSETVOLUME},
+    {"get_volume", snd_get_volume, METH_NOARGS, DOC_SOUNDGETVOLUME},
+    {"get_length", snd_get_length, METH_NOARGS, DOC_SOUNDGETLENGTH},
+    {"get_raw", snd_get_raw, METH_NOARGS, DOC_SOUNDGETRAW},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef sound_getset[] = {
+    {"__array_struct__", snd_get_arraystruct, NULL, "Version 3", NULL},
+    {"__array_interface__", snd_get_arrayinterface, NULL, "Version 3", NULL},
+    {"_samples_address", (getter)snd_get_samples_address, NULL,
+     "samples buffer address (readonly)", NULL},
+    {NULL, NULL, NULL, NULL, NULL}};
+
+/*buffer protocol*/
+
+/*
+snd_buffer_iteminfo converts between SDL and python format constants.
+
+https://wiki.libsdl.org/SDL_AudioSpec
+https://docs.python.org/3/library/struct.html#format-characters
+
+returns:
+    -1 on error, else 0.
+    format: buffer string showing the format.
+    itemsize: bytes for each item.
+*/
+static int
+snd_buffer_iteminfo(char **format, Py_ssize_t *itemsize, int *channels)
+{
+    static char fmt_AUDIO_U8[] = "B";
+    static char fmt_AUDIO_S8[] = "b";
+    static char fmt_AUDIO_U16SYS[] = "=H";
+    static char fmt_AUDIO_S16SYS[] = "=h";
+
+    static char fmt_AUDIO_S32LSB[] = "<i";
+    static char fmt_AUDIO_S32MSB[] = ">i";
+    static char fmt_AUDIO_F32LSB[] = "<f";
+    static char fmt_AUDIO_F32MSB[] = ">f";
+
+    int freq = 0;
+    Uint16 mixer_format = 0;
+
+    Mix_QuerySpec(&freq, &mixer_format, channels);
+
+    switch (mixer_format) {
+        case AUDIO_U8:
+            *format = fmt_AUDIO_U8;
+            *itemsize = 1;
+            return 0;
+
+        case AUDIO_S8:
+            *format = fmt_AUDIO_S8;
+            *itemsize = 1;
+            return 0;
+
+        case AUDIO_U16SYS:
+            *format = fmt_AUDIO_U16SYS;
+            *itemsize = 2;
+            return 0;
+
+        case AUDIO_S16SYS:
+            *format = fmt_AUDIO_S16SYS;
+            *itemsize = 2;
+            return 0;
+
+        case AUDIO_S32LSB:
+            *format = fmt_AUDIO_S32LSB;
+            *itemsize = 4;
+            return 0;
+
+        case AUDIO_S32MSB:
+            *format = fmt_AUDIO_S32MSB;
+            *itemsize = 4;
+            return 0;
+
+        case AUDIO_F32LSB:
+            *format = fmt_AUDIO_F32LSB;
+            *itemsize = 4;
+            return 0;
+
+        case AUDIO_F32MSB:
+            *format = fmt_AUDIO_F32MSB;
+            *itemsize = 4;
+            return 0;
+    }
+
+    PyErr_Format(PyExc_SystemError,
+                 "Pygame bug (mixer.Sound): unknown mixer format %d",
+                 (int)mixer_format);
+    return -1;
+}
+
+/* Fills in view for len bytes of samples at buf, in the mixer format. */
+static int
+_sample_view(PyObject *obj, Py_buffer *view, int flags, void *buf,
+             Py_ssize_t len, int readonly)
+{
+    int channels;
+    char *format;
+    int ndim = 0;
+    Py_ssize_t *shape = 0;
+    Py_ssize_t *strides = 0;
+    Py_ssize_t itemsize;
+    Py_ssize_t samples;
+
+    view->obj = 0;
+    if (snd_buffer_iteminfo(&format, &itemsize, &channels)) {
+        return -1;
+    }
+    if (channels != 1 && PyBUF_HAS_FLAG(flags, PyBUF_F_CONTIGUOUS)) {
+        PyErr_SetString(pgExc_BufferError,
+                        "polyphonic sound is not Fortran contiguous");
+        return -1;
+    }
+    if (PyBUF_HAS_FLAG(flags, PyBUF_ND)) {
+        ndim = channels > 1 ? 2 : 1;
+        samples = len / (itemsize * channels);
+        shape = PyMem_New(Py_ssize_t, 2 * ndim);
+        if (!shape) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        shape[ndim - 1] = channels;
+        shape[0] = samples;
+        if (PyBUF_HAS_FLAG(flags, PyBUF_STRIDES)) {
+            strides = shape + ndim;
+            strides[0] = itemsize * channels;
+            strides[ndim - 1] = itemsize;
+        }
+    }
+    Py_INCREF(obj);
+    view->obj = obj;
+    view->buf = buf;
+    view->len = len;
+    view->readonly = readonly;
+    view->itemsize = itemsize;
+    view->format = PyBUF_HAS_FLAG(flags, PyBUF_FORMAT) ? format : 0;
+    view->ndim = ndim;
+    view->shape = shape;
+    view->strides = strides;
+    view->suboffsets = 0;
+    view->internal = shape;
+    return 0;
+}
+
+static int
+snd_getbuffer(PyObject *obj, Py_buffer *view, int flags)
+{
+    Mix_Chunk *chunk = pgSound_AsChunk(obj);
+    pg_buffer *source = ((pgSoundObject *)obj)->source;
+    int readonly = source && source->view.readonly;
+
+    view->obj = 0;
+    if (readonly && PyBUF_HAS_FLAG(flags, PyBUF_WRITABLE)) {
+        PyErr_SetString(pgExc_BufferError,
+                        "the samples of this Sound are read-only");
+        return -1;
+    }
+    return _sample_view(obj, view, flags, chunk->abuf,
+                        (Py_ssize_t)chunk->alen, readonly);
+}
+
+static void
+snd_releasebuffer(PyObject *obj, Py_buffer *view)
+{
+    if (view->internal) {
+        PyMem_Free(view->internal);
+        view->internal = 0;
+    }
+}
+
+static PyBufferProcs sound_as_buffer[] = {{snd_getbuffer, snd_releasebuffer}};
+
+/*sound object internals*/
+static void
+sound_dealloc(pgSoundObject *self)
+{
+    Mix_Chunk *chunk = pgSound_AsChunk((PyObject *)self);
+    if (chunk) {
+        Py_BEGIN_ALLOW_THREADS;
+        Mix_FreeChunk(chunk);
+        Py_END_ALLOW_THREADS;
+    }
+    if (self->mem)
+        PyMem_Free(self->mem);
+    if (self->source) {
+        pgBuffer_Release(self->source);
+        PyMem_Free(self->source);
+    }
+    if (self->weakreflist)
+        PyObject_ClearWeakRefs((PyObject *)self);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyTypeObject pgSound_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "Sound",
+    .tp_basicsize = sizeof(pgSoundObject),
+    .tp_dealloc = (destructor)sound_dealloc,
+    .tp_as_buffer = sound_as_buffer,
+    .tp_flags =
+        (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_NEWBUFFER),
+    .tp_doc = DOC_PYGAMEMIXERSOUND,
+    .tp_weaklistoffset = offsetof(pgSoundObject, weakreflist),
+    .tp_methods = sound_methods,
+    .tp_getset = sound_getset,
+    .tp_init = sound_init,
+    .tp_new = PyType_GenericNew,
+};
+
+/* channel object methods */
+static PyObject *
+chan_play(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int channelnum = pgChannel_AsInt(self);
+    PyObject *sound;
+    Mix_Chunk *chunk;
+    int loops = 0, playtime = -1, fade_ms = 0;
+
+    char *kwids[] = {"Sound", "loops", "maxtime", "fade_ms", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|iii", kwids,
+                                     &pgSound_Type, &sound, &loops, &playtime,
+                                     &fade_ms))
+        return NULL;
+    chunk = pgSound_AsChunk(sound);
+
+    Py_BEGIN_ALLOW_THREADS;
+    if (fade_ms > 0) {
+        channelnum = Mix_FadeInChannelTimed(channelnum, chunk, loops, fade_ms,
+                                            playtime);
+    }
+    else {
+        channelnum = Mix_PlayChannelTimed(channelnum, chunk, loops, playtime);
+    }
+    if (channelnum != -1) {
+        Mix_GroupChannel(channelnum, (int)(intptr_t)chunk);
+        _dsp_attach(channelnum);
+    }
+    Py_END_ALLOW_THREADS;
+
+    Py_XDECREF(channeldata[channelnum].sound);
+    Py_XDECREF(channeldata[channelnum].queue);
+    channeldata[channelnum].sound = sound;
+    channeldata[channelnum].queue = NULL;
+    Py_INCREF(sound);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+chan_play_at(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int channelnum = pgChannel_AsInt(self);
+    PyObject *sound, *old = NULL;
+    long long onset;
+    int loops = 0, i, n;
+
+    char *kwids[] = {"Sound", "time", "loops", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!L|i", kwids,
+                                     &pgSound_Type, &sound, &onset, &loops))
+        return NULL;
+    MIXER_INIT_CHECK();
+    if (onset < 0) {
+        return RAISE(PyExc_ValueError, "time must not be negative");
+    }
+
+    SDL_LockMutex(_sched_lock);
+    n = SDL_AtomicGet(&_nscheduled);
+    for (i = 0; i < n && _scheduled[i].channel != channelnum; i++)
+        ;
+    if (i == PG_MAX_SCHEDULED) {
+        SDL_UnlockMutex(_sched_lock);
+        return RAISE(pgExc_SDLError, "too many Sounds scheduled");
+    }
+    if (i < n) {
+        old = _scheduled[i].sound;
+    }
+    Py_INCREF(sound);
+    _scheduled[i].channel = channelnum;
+    _scheduled[i].chunk = pgSound_AsChunk(sound);
+    _scheduled[i].loops = loops;
+    _scheduled[i].onset = (Uint64)onset;
+    _scheduled[i].sound = sound;
+    if (i == n) {
+        SDL_AtomicSet(&_nscheduled, n + 1);
+    }
+    SDL_UnlockMutex(_sched_lock);
+
+    Py_XDECREF(old);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+chan_queue(PyObject *self, PyObject *args)
+{
+    int channelnum = pgChannel_AsInt(self);
+    PyObject *sound;
+    Mix_Chunk *chunk;
+
+    if (!PyArg_ParseTuple(args, "O!", &pgSound_Type, &sound))
+        return NULL;
+    chunk = pgSound_AsChunk(sound);
+
+    if (!channeldata[channelnum].sound) /*nothing playing*/
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        channelnum = Mix_PlayChannelTimed(channelnum, chunk, 0, -1);
+        if (channelnum != -1) {
+            Mix_GroupChannel(channelnum, (int)(intptr_t)chunk);
+            _dsp_attach(channelnum);
+        }
+        Py_END_ALLOW_THREADS;
+
+        channeldata[channelnum].sound = sound;
+        Py_INCREF(sound);
+    }
+    else {
+        Py_XDECREF(channeldata[channelnum].queue);
+        channeldata[channelnum].queue = sound;
+        Py_INCREF(sound);
+    }
+    Py_RETURN_NONE;
+}
 
-    return PyFloat_FromDouble((float)numsamples / (float)freq);
+static PyObject *
+chan_get_busy(PyObject *self, PyObject *_null)
+{
+    int channelnum = pgChannel_AsInt(self);
+    MIXER_INIT_CHECK();
+
+    return PyBool_FromLong(Mix_Playing(channelnum));
 }
 
 static PyObject *
-snd_get_raw(PyObject *self, PyObject *_null)
+chan_fadeout(PyObject *self, PyObject *args)
 {
-    Mix_Chunk *chunk = pgSound_AsChunk(self);
+    int channelnum = pgChannel_AsInt(self);
+    int _time;
+    if (!PyArg_ParseTuple(args, "i", &_time))
+        return NULL;
 
     MIXER_INIT_CHECK();
 
-    return PyBytes_FromStringAndSize((const char *)chunk->abuf,
-                                     (Py_ssize_t)chunk->alen);
+    Py_BEGIN_ALLOW_THREADS;
+    Mix_FadeOutChannel(channelnum, _time);
+    Py_END_ALLOW_THREADS;
+    Py_RETURN_NONE;
 }
 
 static PyObject *
-snd_get_arraystruct(PyObject *self, void *closure)
+chan_stop(PyObject *self, PyObject *_null)
 {
-    Py_buffer view;
-    PyObject *cobj;
+    int channelnum = pgChannel_AsInt(self);
+    MIXER_INIT_CHECK();
 
-    if (snd_getbuffer(self, &view, PyBUF_RECORDS)) {
-        return 0;
+    _unschedule(channelnum);
+    Py_BEGIN_ALLOW_THREADS;
+    Mix_HaltChannel(channelnum);
+    Py_END_ALLOW_THREADS;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+chan_pause(PyObject *self, PyObject *_null)
+{
+    int channelnum = pgChannel_AsInt(self);
+    MIXER_INIT_CHECK();
+
+    Mix_Pause(channelnum);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+chan_unpause(PyObject *self, PyObject *_null)
+{
+    int channelnum = pgChannel_AsInt(self);
+    MIXER_INIT_CHECK();
+
+    Py_BEGIN_ALLOW_THREADS;
+    Mix_Resume(channelnum);
+    Py_END_ALLOW_THREADS;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+chan_set_volume(PyObject *self, PyObject *args)
+{
+    int channelnum = pgChannel_AsInt(self);
+    float volume, stereovolume = -1.11f;
+#ifdef Py_DEBUG
+    int result;
+#endif
+    Uint8 left, right;
+    PyThreadState *_save;
+
+    if (!PyArg_ParseTuple(args, "f|f", &volume, &stereovolume))
+        return NULL;
+
+    MIXER_INIT_CHECK();
+    if ((stereovolume <= -1.10f) && (stereovolume >= -1.12f)) {
+        /* The normal volume will be used. No panning. so panning is
+         * set to full. this is in case it was set previously to
+         * something else. NOTE: there is no way to GetPanning
+         * variables.
+         */
+        left = 255;
+        right = 255;
+
+        _save = PyEval_SaveThread();
+        if (!Mix_SetPanning(channelnum, left, right)) {
+            PyEval_RestoreThread(_save);
+            return RAISE(pgExc_SDLError, Mix_GetError());
+        }
+        PyEval_RestoreThread(_save);
     }
-    cobj = pgBuffer_AsArrayStruct(&view);
-    snd_releasebuffer(view.obj, &view);
-    Py_XDECREF(view.obj);
-    return cobj;
+    else {
+        /* NOTE: here the volume will be set to 1.0 and the panning will
+         * be used. */
+        left = (Uint8)(volume * 255);
+        right = (Uint8)(stereovolume * 255);
+        /*
+        printf("left:%d:  right:%d:\n", left, right);
+        */
+
+        _save = PyEval_SaveThread();
+        if (!Mix_SetPanning(channelnum, left, right)) {
+            PyEval_RestoreThread(_save);
+            return RAISE(pgExc_SDLError, Mix_GetError());
+        }
+        PyEval_RestoreThread(_save);
+
+        volume = 1.0f;
+    }
+
+#ifdef Py_DEBUG
+    result =
+#endif
+        Mix_Volume(channelnum, (int)(volume * 128));
+    Py_RETURN_NONE;
 }
 
 static PyObject *
-snd_get_arrayinterface(PyObject *self, void *closure)
+chan_get_volume(PyObject *self, PyObject *_null)
 {
-    Py_buffer view;
-    PyObject *dict;
+    int channelnum = pgChannel_AsInt(self);
+    int volume;
 
-    if (snd_getbuffer(self, &view, PyBUF_RECORDS)) {
-        return 0;
+    MIXER_INIT_CHECK();
+
+    volume = Mix_Volume(channelnum, -1);
+
+    return PyFloat_FromDouble(volume / 128.0);
+}
+
+static PyObject *
+chan_get_sound(PyObject *self, PyObject *_null)
+{
+    int channelnum = pgChannel_AsInt(self);
+    PyObject *sound;
+
+    sound = channeldata[channelnum].sound;
+    if (!sound)
+        Py_RETURN_NONE;
+
+    Py_INCREF(sound);
+    return sound;
+}
+
+static PyObject *
+chan_get_queue(PyObject *self, PyObject *_null)
+{
+    int channelnum = pgChannel_AsInt(self);
+    PyObject *sound;
+
+    sound = channeldata[channelnum].queue;
+    if (!sound)
+        Py_RETURN_NONE;
+
+    Py_INCREF(sound);
+    return sound;
+}
+
+static PyObject *
+chan_set_filter(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int channelnum = pgChannel_AsInt(self);
+    char *type = NULL;
+    float frequency = 1000.0f, q = 0.70710678f;
+    int filter, freq, channels;
+    Uint16 format;
+    double w0, alpha, cosw, a0, b0, b1, b2;
+    pgChannelDSP *dsp;
+
+    char *kwids[] = {"type", "frequency", "q", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|zff", kwids, &type,
+                                     &frequency, &q))
+        return NULL;
+    MIXER_INIT_CHECK();
+
+    if (!type)
+        filter = PG_FILTER_NONE;
+    else if (!strcmp(type, "lowpass"))
+        filter = PG_FILTER_LOWPASS;
+    else if (!strcmp(type, "highpass"))
+        filter = PG_FILTER_HIGHPASS;
+    else if (!strcmp(type, "bandpass"))
+        filter = PG_FILTER_BANDPASS;
+    else
+        return RAISE(PyExc_ValueError,
+                     "filter type must be 'lowpass', 'highpass', 'bandpass' "
+                     "or None");
+    Mix_QuerySpec(&freq, &format, &channels);
+    if (!(frequency > 0.0f && frequency < freq / 2.0f))
+        return RAISE(PyExc_ValueError,
+                     "frequency must be between 0 and half the mixer "
+                     "frequency");
+    if (!(q > 0.0f))
+        return RAISE(PyExc_ValueError, "q must be positive");
+
+    dsp = _dsp_get(channelnum);
+    if (!dsp)
+        return NULL;
+
+    /* the coefficients of Robert Bristow-Johnson's audio EQ cookbook */
+    w0 = 2.0 * M_PI * frequency / freq;
+    cosw = cos(w0);
+    alpha = sin(w0) / (2.0 * q);
+    a0 = 1.0 + alpha;
+    switch (filter) {
+        case PG_FILTER_LOWPASS:
+            b0 = b2 = (1.0 - cosw) / 2.0;
+            b1 = 1.0 - cosw;
+            break;
+        case PG_FILTER_HIGHPASS:
+            b0 = b2 = (1.0 + cosw) / 2.0;
+            b1 = -(1.0 + cosw);
+            break;
+        default:
+            b0 = alpha;
+            b1 = 0.0;
+            b2 = -alpha;
     }
-    dict = pgBuffer_AsArrayInterface(&view);
-    snd_releasebuffer(self, &view);
-    Py_DECREF(self);
-    return dict;
+
+    SDL_AtomicLock(&dsp->lock);
+    if (dsp->filter != filter)
+        dsp->reset |= PG_DSP_RESET_FILTER;
+    dsp->filter = filter;
+    dsp->b0 = (float)(b0 / a0);
+    dsp->b1 = (float)(b1 / a0);
+    dsp->b2 = (float)(b2 / a0);
+    dsp->a1 = (float)(-2.0 * cosw / a0);
+    dsp->a2 = (float)((1.0 - alpha) / a0);
+    SDL_AtomicUnlock(&dsp->lock);
+
+    Py_BEGIN_ALLOW_THREADS;
+    if (Mix_Playing(channelnum))
+        _dsp_attach(channelnum);
+    Py_END_ALLOW_THREADS;
+    Py_RETURN_NONE;
 }
 
 static PyObject *
-snd_get_samples_address(PyObject *self, PyObject *closure)
+chan_set_reverb(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    Mix_Chunk *chunk = pgSound_AsChunk(self);
+    int channelnum = pgChannel_AsInt(self);
+    float wet, room_size = 0.5f, damping = 0.5f;
+    int freq, channels, max_length, i;
+    Uint16 format;
+    float *lines;
+    pgChannelDSP *dsp;
 
+    char *kwids[] = {"wet", "room_size", "damping", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "f|ff", kwids, &wet,
+                                     &room_size, &damping))
+        return NULL;
     MIXER_INIT_CHECK();
 
-#if SIZEOF_VOID_P > SIZEOF_LONG
-    return PyLong_FromUnsignedLongLong((unsigned PY_LONG_LONG)chunk->abuf);
-#else
-    return PyLong_FromUnsignedLong((unsigned long)chunk->abuf);
-#endif
+    if (!(wet >= 0.0f && wet <= 1.0f) ||
+        !(room_size >= 0.0f && room_size <= 1.0f) ||
+        !(damping >= 0.0f && damping <= 1.0f))
+        return RAISE(PyExc_ValueError,
+                     "wet, room_size and damping must be between 0 and 1");
+
+    dsp = _dsp_get(channelnum);
+    if (!dsp)
+        return NULL;
+    Mix_QuerySpec(&freq, &format, &channels);
+    if (!dsp->lines && wet > 0.0f) {
+        max_length = (int)((Sint64)_reverb_lengths[PG_DSP_LINES - 1] * freq /
+                           44100) +
+                     1;
+        lines = (float *)PyMem_Calloc((size_t)max_length * PG_DSP_LINES,
+                                      sizeof(float));
+        if (!lines)
+            return PyErr_NoMemory();
+        SDL_AtomicLock(&dsp->lock);
+        dsp->max_length = max_length;
+        dsp->lines = lines;
+        SDL_AtomicUnlock(&dsp->lock);
+    }
+
+    SDL_AtomicLock(&dsp->lock);
+    if (dsp->wet <= 0.0f)
+        dsp->reset |= PG_DSP_RESET_REVERB;
+    dsp->wet = wet;
+    dsp->feedback = 0.6f + 0.37f * room_size;
+    dsp->damping = damping;
+    for (i = 0; i < PG_DSP_LINES; i++) {
+        dsp->lengths[i] = SDL_max(
+            1, (int)(_reverb_lengths[i] * (0.25f + 0.75f * room_size) *
+                     freq / 44100.0f));
+    }
+    SDL_AtomicUnlock(&dsp->lock);
+
+    Py_BEGIN_ALLOW_THREADS;
+    if (Mix_Playing(channelnum))
+        _dsp_attach(channelnum);
+    Py_END_ALLOW_THREADS;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+chan_set_endevent(PyObject *self, PyObject *args)
+{
+    int channelnum = pgChannel_AsInt(self);
+    int event = SDL_NOEVENT;
+
+    if (!PyArg_ParseTuple(args, "|i", &event))
+        return NULL;
+
+    channeldata[channelnum].endevent = event;
+    Py_RETURN_NONE;
 }
 
-PyMethodDef sound_methods[] = {
-    {"play", (PyCFunction)pgSound_Play, METH_VARARGS | METH_KEYWORDS,
-     DOC_SOUNDPLAY},
-    {"get_num_channels", snd_get_num_channels, METH_NOARGS,
-     DOC_SOUNDGETNUMCHANNELS},
-    {"fadeout", snd_fadeout, METH_VARARGS, DOC_SOUNDFADEOUT},
-    {"stop", snd_stop, METH_NOARGS, DOC_SOUNDSTOP},
-    {"set_volume", snd_set_volume, METH_VARARGS, DOC_SOUNDSETVOLUME},
-    {"get_volume", snd_get_volume, METH_NOARGS, DOC_SOUNDGETVOLUME},
-    {"get_length", snd_get_length, METH_NOARGS, DOC_SOUNDGETLENGTH},
-    {"get_raw", snd_get_raw, METH_NOARGS, DOC_SOUNDGETRAW},
-    {NULL, NULL, 0, NULL}};
+static PyObject *
+chan_get_endevent(PyObject *self, PyObject *_null)
+{
+    int channelnum = pgChannel_AsInt(self);
+
+    return PyLong_FromLong(channeldata[channelnum].endevent);
+}
+
+static PyMethodDef channel_methods[] = {
+    {"play", (PyCFunction)chan_play, METH_VARARGS | METH_KEYWORDS,
+     DOC_CHANNELPLAY},
+    {"play_at", (PyCFunction)chan_play_at, METH_VARARGS | METH_KEYWORDS,
+     DOC_CHANNELPLAYAT},
+    {"queue", chan_queue, METH_VARARGS, DOC_CHANNELQUEUE},
+    {"set_filter", (PyCFunction)chan_set_filter, METH_VARARGS | METH_KEYWORDS,
+     DOC_CHANNELSETFILTER},
+    {"set_reverb", (PyCFunction)chan_set_reverb, METH_VARARGS | METH_KEYWORDS,
+     DOC_CHANNELSETREVERB},
+    {"get_busy", (PyCFunction)chan_get_busy, METH_NOARGS, DOC_CHANNELGETBUSY},
+    {"fadeout", chan_fadeout, METH_VARARGS, DOC_CHANNELFADEOUT},
+    {"stop", (PyCFunction)chan_stop, METH_NOARGS, DOC_CHANNELSTOP},
+    {"pause", (PyCFunction)chan_pause, METH_NOARGS, DOC_CHANNELPAUSE},
+    {"unpause", (PyCFunction)chan_unpause, METH_NOARGS, DOC_CHANNELUNPAUSE},
+    {"set_volume", chan_set_volume, METH_VARARGS, DOC_CHANNELSETVOLUME},
+    {"get_volume", (PyCFunction)chan_get_volume, METH_NOARGS,
+     DOC_CHANNELGETVOLUME},
+
+    {"get_sound", (PyCFunction)chan_get_sound, METH_NOARGS,
+     DOC_CHANNELGETSOUND},
+    {"get_queue", (PyCFunction)chan_get_queue, METH_NOARGS,
+     DOC_CHANNELGETQUEUE},
 
-static PyGetSetDef sound_getset[] = {
-    {"__array_struct__", snd_get_arraystruct, NULL, "Version 3", NULL},
-    {"__array_interface__", snd_get_arrayinterface, NULL, "Version 3", NULL},
-    {"_samples_address", (getter)snd_get_samples_address, NULL,
-     "samples buffer address (readonly)", NULL},
-    {NULL, NULL, NULL, NULL, NULL}};
+    {"set_endevent", chan_set_endevent, METH_VARARGS, DOC_CHANNELSETENDEVENT},
+    {"get_endevent", (PyCFunction)chan_get_endevent, METH_NOARGS,
+     DOC_CHANNELGETENDEVENT},
 
-/*buffer protocol*/
+    {NULL, NULL, 0, NULL}};
 
-/*
-snd_buffer_iteminfo converts between SDL and python format constants.
+/* channel object internals */
 
-https://wiki.libsdl.org/SDL_AudioSpec
-https://docs.python.org/3/library/struct.html#format-characters
+static void
+channel_dealloc(PyObject *self)
+{
+    PyObject_Free(self);
+}
 
-returns:
-    -1 on error, else 0.
-    format: buffer string showing the format.
-    itemsize: bytes for each item.
-*/
 static int
-snd_buffer_iteminfo(char **format, Py_ssize_t *itemsize, int *channels)
+_channel_init(pgChannelObject *self, int channelnum)
 {
-    static char fmt_AUDIO_U8[] = "B";
-    static char fmt_AUDIO_S8[] = "b";
-    static char fmt_AUDIO_U16SYS[] = "=H";
-    static char fmt_AUDIO_S16SYS[] = "=h";
-
-    static char fmt_AUDIO_S32LSB[] = "<i";
-    static char fmt_AUDIO_S32MSB[] = ">i";
-    static char fmt_AUDIO_F32LSB[] = "<f";
-    static char fmt_AUDIO_F32MSB[] = ">f";
-
-    int freq = 0;
-    Uint16 mixer_format = 0;
+    if (!SDL_WasInit(SDL_INIT_AUDIO)) {
+        PyErr_SetString(pgExc_SDLError, "mixer not initialized");
+        return -1;
+    }
+    if (channelnum < 0 || channelnum >= Mix_GroupCount(-1)) {
+        PyErr_SetString(PyExc_IndexError, "invalid channel index");
+        return -1;
+    }
+    self->chan = channelnum;
+    return 0;
+}
 
-    Mix_QuerySpec(&freq, &mixer_format, channels);
+static int
+channel_init(pgChannelObject *self, PyObject *args, PyObject *kwargs)
+{
+    int channelnum;
+    if (!PyArg_ParseTuple(args, "i", &channelnum)) {
+        return -1;
+    }
 
-    switch (mixer_format) {
-        case AUDIO_U8:
-            *format = fmt_AUDIO_U8;
-            *itemsize = 1;
-            return 0;
+    return _channel_init(self, channelnum);
+}
 
-        case AUDIO_S8:
-            *format = fmt_AUDIO_S8;
-            *itemsize = 1;
-            return 0;
+static PyTypeObject pgChannel_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "Channel",
+    .tp_basicsize = sizeof(pgChannelObject),
+    .tp_dealloc = channel_dealloc,
+    .tp_doc = DOC_PYGAMEMIXERCHANNEL,
+    .tp_methods = channel_methods,
+    .tp_init = (initproc)channel_init,
+    .tp_new = PyType_GenericNew,
+};
 
-        case AUDIO_U16SYS:
-            *format = fmt_AUDIO_U16SYS;
-            *itemsize = 2;
-            return 0;
+/* stream object
+ *
+ * A Stream is a single producer, single consumer ring of PCM bytes in the
+ * mixer format. The producer (Python code, or one C thread through
+ * pgStream_Write) advances head; the mixer consumes from tail in an effect
+ * run on the audio thread, which never takes the GIL. Both positions count
+ * bytes and wrap around at 2**32, the ring size being a power of two.
+ *
+ * To be mixed, the Stream plays a looped chunk of silence on a channel and
+ * replaces its samples with those queued, so channel volume, panning and
+ * the other effects all apply.
+ *
+ * A Stream opened on a WAV file is its own producer: a feeder thread reads
+ * and converts the samples a little ahead of playback, so that a long sound
+ * never needs to be held in memory whole.
+ */
+typedef struct {
+    PyObject_HEAD Mix_Chunk *chunk; /* silence, looped while playing */
+    Uint8 *buf;
+    Uint32 size; /* of buf, in bytes */
+    SDL_atomic_t head;
+    SDL_atomic_t tail;
+    SDL_atomic_t underruns;
+    Uint16 format;
+    int channels;
+    int frame_size;
+    Uint8 silence;
+    PyObject *weakreflist;
 
-        case AUDIO_S16SYS:
-            *format = fmt_AUDIO_S16SYS;
-            *itemsize = 2;
-            return 0;
+    /* fed from a file; only touched by the feeder thread while it runs */
+    SDL_RWops *rw;
+    SDL_AudioStream *convert;
+    Sint64 data_start;
+    Sint64 data_size;
+    Sint64 data_left;
+    int src_frame_size;
+    int loops;
+    int loops_left;
+    int flushed;
+    Uint32 period; /* between refills, in ms */
+    SDL_Thread *feeder;
+    SDL_atomic_t feeding;
+} pgStreamObject;
+
+#define pgStream_Check(x) (Py_TYPE(x) == &pgStream_Type)
+
+/* silent chunk length; a whole number of frames of every mixer format */
+#define PG_STREAM_CHUNK_SIZE 4608
+
+static PyTypeObject pgStream_Type;
 
-        case AUDIO_S32LSB:
-            *format = fmt_AUDIO_S32LSB;
-            *itemsize = 4;
-            return 0;
+static void
+_stream_effect(int chan, void *stream, int len, void *udata)
+{
+    pgStreamObject *self = (pgStreamObject *)udata;
+    Uint8 *dst = (Uint8 *)stream;
+    Uint32 tail = (Uint32)SDL_AtomicGet(&self->tail);
+    Uint32 queued = (Uint32)SDL_AtomicGet(&self->head) - tail;
+    Uint32 n = SDL_min(queued, (Uint32)len);
+    Uint32 start = tail & (self->size - 1);
+    Uint32 first = SDL_min(n, self->size - start);
+
+    /* the samples up to head were written before head was published */
+    SDL_MemoryBarrierAcquire();
+    memcpy(dst, self->buf + start, first);
+    memcpy(dst + first, self->buf, n - first);
+    if (n < (Uint32)len) {
+        memset(dst + n, self->silence, len - n);
+        SDL_AtomicAdd(&self->underruns, 1);
+    }
 
-        case AUDIO_S32MSB:
-            *format = fmt_AUDIO_S32MSB;
-            *itemsize = 4;
-            return 0;
+    /* done reading before the producer may overwrite */
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&self->tail, (int)(tail + n));
+}
 
-        case AUDIO_F32LSB:
-            *format = fmt_AUDIO_F32LSB;
-            *itemsize = 4;
-            return 0;
+/* Queues up to len bytes of data, in whole frames, returning the number of
+ * bytes queued. Safe to call without the GIL, from one thread at a time.
+ */
+static Py_ssize_t
+pgStream_Write(PyObject *obj, const void *data, Py_ssize_t len)
+{
+    pgStreamObject *self = (pgStreamObject *)obj;
+    Uint32 head = (Uint32)SDL_AtomicGet(&self->head);
+    Uint32 room = self->size - (head - (Uint32)SDL_AtomicGet(&self->tail));
+    Uint32 n, start, first;
 
-        case AUDIO_F32MSB:
-            *format = fmt_AUDIO_F32MSB;
-            *itemsize = 4;
-            return 0;
+    if (len < (Py_ssize_t)room) {
+        room = (Uint32)len;
     }
-
-    PyErr_Format(PyExc_SystemError,
-                 "Pygame bug (mixer.Sound): unknown mixer format %d",
-                 (int)mixer_format);
-    return -1;
+    n = room - room % self->frame_size;
+    start = head & (self->size - 1);
+    first = SDL_min(n, self->size - start);
+
+    /* the mixer was done reading the bytes freed before tail moved */
+    SDL_MemoryBarrierAcquire();
+    memcpy(self->buf + start, data, first);
+    memcpy(self->buf, (const Uint8 *)data + first, n - first);
+
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&self->head, (int)(head + n));
+    return (Py_ssize_t)n;
 }
 
+/* Reads the format of the WAV file at rw, leaving it at the first sample,
+ * and sets up its conversion to the mixer format.
+ */
 static int
-snd_getbuffer(PyObject *obj, Py_buffer *view, int flags)
+_stream_open_wav(pgStreamObject *self, SDL_RWops *rw)
 {
-    Mix_Chunk *chunk = pgSound_AsChunk(obj);
-    int channels;
-    char *format;
-    int ndim = 0;
-    Py_ssize_t *shape = 0;
-    Py_ssize_t *strides = 0;
-    Py_ssize_t itemsize;
-    Py_ssize_t samples;
+    Uint8 header[12], fmt[40];
+    Uint32 id, size;
+    Uint16 tag = 0, channels = 0, align = 0, bits = 0;
+    Uint32 rate = 0;
+    SDL_AudioFormat format;
+    int freq, mixer_channels;
+    Uint16 mixer_format;
+
+    if (SDL_RWread(rw, header, sizeof(header), 1) != 1 ||
+        SDL_memcmp(header, "RIFF", 4) || SDL_memcmp(header + 8, "WAVE", 4)) {
+        PyErr_SetString(pgExc_SDLError,
+                        "only WAV files can be streamed; load others with "
+                        "Sound");
+        return -1;
+    }
+    for (;;) {
+        id = SDL_ReadBE32(rw);
+        size = SDL_ReadLE32(rw);
+        if (id == 0x666d7420) { /* "fmt " */
+            if (size < 16 || size > sizeof(fmt) ||
+                SDL_RWread(rw, fmt, size, 1) != 1) {
+                break;
+            }
+            tag = fmt[0] | fmt[1] << 8;
+            channels = fmt[2] | fmt[3] << 8;
+            rate = fmt[4] | fmt[5] << 8 | fmt[6] << 16 | (Uint32)fmt[7] << 24;
+            align = fmt[12] | fmt[13] << 8;
+            bits = fmt[14] | fmt[15] << 8;
+            if (tag == 0xfffe && size >= 26) {
+                /* WAVE_FORMAT_EXTENSIBLE: the subformat GUID starts with it */
+                tag = fmt[24] | fmt[25] << 8;
+            }
+            if (size & 1) {
+                SDL_RWseek(rw, 1, RW_SEEK_CUR);
+            }
+        }
+        else if (id == 0x64617461) { /* "data" */
+            self->data_start = SDL_RWtell(rw);
+            self->data_size = size;
+            break;
+        }
+        else if (!size && !id) {
+            break;
+        }
+        else if (SDL_RWseek(rw, size + (size & 1), RW_SEEK_CUR) < 0) {
+            break;
+        }
+    }
+    if (!self->data_size || self->data_start < 0 || !tag) {
+        PyErr_SetString(pgExc_SDLError, "WAV file has no samples");
+        return -1;
+    }
 
-    view->obj = 0;
-    if (snd_buffer_iteminfo(&format, &itemsize, &channels)) {
+    if (tag == 1 && bits == 8) {
+        format = AUDIO_U8;
+    }
+    else if (tag == 1 && bits == 16) {
+        format = AUDIO_S16LSB;
+    }
+    else if (tag == 1 && bits == 32) {
+        format = AUDIO_S32LSB;
+    }
+    else if (tag == 3 && bits == 32) {
+        format = AUDIO_F32LSB;
+    }
+    else {
+        PyErr_Format(pgExc_SDLError,
+                     "cannot stream WAV samples of encoding %d and %d bits",
+                     (int)tag, (int)bits);
         return -1;
     }
-    if (channels != 1 && PyBUF_HAS_FLAG(flags, PyBUF_F_CONTIGUOUS)) {
-        PyErr_SetString(pgExc_BufferError,
-                        "polyphonic sound is not Fortran contiguous");
+    if (!channels || align != channels * bits / 8) {
+        PyErr_SetString(pgExc_SDLError, "corrupt WAV format");
         return -1;
     }
-    if (PyBUF_HAS_FLAG(flags, PyBUF_ND)) {
-        ndim = channels > 1 ? 2 : 1;
-        samples = chunk->alen / (itemsize * channels);
-        shape = PyMem_New(Py_ssize_t, 2 * ndim);
-        if (!shape) {
-            PyErr_NoMemory();
-            return -1;
+
+    Mix_QuerySpec(&freq, &mixer_format, &mixer_channels);
+    self->convert = SDL_NewAudioStream(format, (Uint8)channels, (int)rate,
+                                       mixer_format, (Uint8)mixer_channels,
+                                       freq);
+    if (!self->convert) {
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        return -1;
+    }
+    self->src_frame_size = align;
+    self->data_left = self->data_size;
+    return 0;
+}
+
+/* Moves as many samples from the file into the ring as there is room for.
+ * Returns 0 once the file has been played to its end, else 1.
+ */
+static int
+_stream_fill(pgStreamObject *self)
+{
+    Uint8 buf[4096];
+    size_t want, got;
+    Uint32 room;
+    int converted;
+
+    for (;;) {
+        room = self->size - ((Uint32)SDL_AtomicGet(&self->head) -
+                             (Uint32)SDL_AtomicGet(&self->tail));
+        want = SDL_min(room, sizeof(buf));
+        want -= want % self->frame_size;
+        if (!want) {
+            return 1;
         }
-        shape[ndim - 1] = channels;
-        shape[0] = samples;
-        if (PyBUF_HAS_FLAG(flags, PyBUF_STRIDES)) {
-            strides = shape + ndim;
-            strides[0] = itemsize * channels;
-            strides[ndim - 1] = itemsize;
+        converted = SDL_AudioStreamGet(self->convert, buf, (int)want);
+        if (converted < 0) {
+            return 0;
+        }
+        if (converted > 0) {
+            pgStream_Write((PyObject *)self, buf, converted);
+            continue;
+        }
+
+        if (!self->data_left) {
+            if (self->loops_left) {
+                if (self->loops_left > 0) {
+                    --self->loops_left;
+                }
+                if (SDL_RWseek(self->rw, self->data_start, RW_SEEK_SET) < 0) {
+                    return 0;
+                }
+                self->data_left = self->data_size;
+                continue;
+            }
+            if (self->flushed) {
+                return 0;
+            }
+            /* let the resampler give up what it holds back */
+            SDL_AudioStreamFlush(self->convert);
+            self->flushed = 1;
+            continue;
+        }
+
+        want = (size_t)SDL_min(self->data_left, (Sint64)sizeof(buf));
+        want -= want % self->src_frame_size;
+        got = want ? SDL_RWread(self->rw, buf, 1, want) : 0;
+        got -= got % self->src_frame_size;
+        if (!got) {
+            /* the data chunk ended early, or is of unknown size */
+            self->data_left = 0;
+            continue;
+        }
+        self->data_left -= got;
+        if (SDL_AudioStreamPut(self->convert, buf, (int)got) < 0) {
+            return 0;
         }
     }
-    Py_INCREF(obj);
-    view->obj = obj;
-    view->buf = chunk->abuf;
-    view->len = (Py_ssize_t)chunk->alen;
-    view->readonly = 0;
-    view->itemsize = itemsize;
-    view->format = PyBUF_HAS_FLAG(flags, PyBUF_FORMAT) ? format : 0;
-    view->ndim = ndim;
-    view->shape = shape;
-    view->strides = strides;
-    view->suboffsets = 0;
-    view->internal = shape;
+}
+
+static int SDLCALL
+_stream_feed(void *data)
+{
+    pgStreamObject *self = (pgStreamObject *)data;
+    int tag = (int)(intptr_t)self->chunk;
+
+    while (SDL_AtomicGet(&self->feeding)) {
+        if (!_stream_fill(self)) {
+            /* let what is queued play out, then free the channel */
+            while (SDL_AtomicGet(&self->feeding) &&
+                   SDL_AtomicGet(&self->head) != SDL_AtomicGet(&self->tail) &&
+                   Mix_GroupCount(tag) > 0) {
+                SDL_Delay(self->period);
+            }
+            if (SDL_AtomicGet(&self->feeding)) {
+                Mix_HaltGroup(tag);
+            }
+            break;
+        }
+        SDL_Delay(self->period);
+    }
+    SDL_AtomicSet(&self->feeding, 0);
     return 0;
 }
 
+/* Stops the feeder thread, if any, waiting for it. Call without the GIL. */
 static void
-snd_releasebuffer(PyObject *obj, Py_buffer *view)
+_stream_join_feeder(pgStreamObject *self)
 {
-    if (view->internal) {
-        PyMem_Free(view->internal);
-        view->internal = 0;
+    if (self->feeder) {
+        SDL_AtomicSet(&self->feeding, 0);
+        SDL_WaitThread(self->feeder, NULL);
+        self->feeder = NULL;
     }
 }
 
-static PyBufferProcs sound_as_buffer[] = {{snd_getbuffer, snd_releasebuffer}};
+/* Gets the file ready to feed from its start and queues its first samples.
+ * Call without the GIL.
+ */
+static int
+_stream_prime(pgStreamObject *self)
+{
+    _stream_join_feeder(self);
+    if (SDL_RWseek(self->rw, self->data_start, RW_SEEK_SET) < 0) {
+        return -1;
+    }
+    SDL_AudioStreamClear(self->convert);
+    self->data_left = self->data_size;
+    self->loops_left = self->loops;
+    self->flushed = 0;
+    _stream_fill(self);
+    return 0;
+}
 
-/*sound object internals*/
-static void
-sound_dealloc(pgSoundObject *self)
+static int
+_stream_start_feeder(pgStreamObject *self)
 {
-    Mix_Chunk *chunk = pgSound_AsChunk((PyObject *)self);
-    if (chunk) {
-        Py_BEGIN_ALLOW_THREADS;
-        Mix_FreeChunk(chunk);
-        Py_END_ALLOW_THREADS;
+    SDL_AtomicSet(&self->feeding, 1);
+    self->feeder = SDL_CreateThread(_stream_feed, "pygame.mixer.Stream", self);
+    if (!self->feeder) {
+        SDL_AtomicSet(&self->feeding, 0);
+        return -1;
+    }
+    return 0;
+}
+
+static int
+_stream_check_format(pgStreamObject *self)
+{
+    int freq, channels;
+    Uint16 format;
+
+    Mix_QuerySpec(&freq, &format, &channels);
+    if (format != self->format || channels != self->channels) {
+        PyErr_SetString(pgExc_SDLError,
+                        "mixer format changed since the Stream was created");
+        return -1;
     }
-    if (self->mem)
-        PyMem_Free(self->mem);
-    if (self->weakreflist)
-        PyObject_ClearWeakRefs((PyObject *)self);
-    Py_TYPE(self)->tp_free((PyObject *)self);
+    return 0;
 }
 
-static PyTypeObject pgSound_Type = {
-    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "Sound",
-    .tp_basicsize = sizeof(pgSoundObject),
-    .tp_dealloc = (destructor)sound_dealloc,
-    .tp_as_buffer = sound_as_buffer,
-    .tp_flags =
-        (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_NEWBUFFER),
-    .tp_doc = DOC_PYGAMEMIXERSOUND,
-    .tp_weaklistoffset = offsetof(pgSoundObject, weakreflist),
-    .tp_methods = sound_methods,
-    .tp_getset = sound_getset,
-    .tp_init = sound_init,
-    .tp_new = PyType_GenericNew,
-};
+static PyObject *
+stream_write(PyObject *self, PyObject *arg)
+{
+    Py_buffer view;
+    Py_ssize_t written;
+
+    if (((pgStreamObject *)self)->rw) {
+        return RAISE(PyExc_RuntimeError,
+                     "cannot write to a Stream fed from a file");
+    }
+    if (PyObject_GetBuffer(arg, &view, PyBUF_SIMPLE)) {
+        return NULL;
+    }
+    written = pgStream_Write(self, view.buf, view.len);
+    PyBuffer_Release(&view);
+    return PyLong_FromSsize_t(written);
+}
 
-/* channel object methods */
 static PyObject *
-chan_play(PyObject *self, PyObject *args, PyObject *kwargs)
+stream_play(PyObject *self, PyObject *_null)
 {
-    int channelnum = pgChannel_AsInt(self);
-    PyObject *sound;
-    Mix_Chunk *chunk;
-    int loops = 0, playtime = -1, fade_ms = 0;
+    pgStreamObject *stream = (pgStreamObject *)self;
+    int tag = (int)(intptr_t)stream->chunk;
+    int channelnum, started = 0, registered = 1, fed = 0;
 
-    char *kwids[] = {"Sound", "loops", "maxtime", "fade_ms", NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|iii", kwids,
-                                     &pgSound_Type, &sound, &loops, &playtime,
-                                     &fade_ms))
+    MIXER_INIT_CHECK();
+    if (_stream_check_format(stream)) {
         return NULL;
-    chunk = pgSound_AsChunk(sound);
+    }
 
     Py_BEGIN_ALLOW_THREADS;
-    if (fade_ms > 0) {
-        channelnum = Mix_FadeInChannelTimed(channelnum, chunk, loops, fade_ms,
-                                            playtime);
+    if (stream->rw && !SDL_AtomicGet(&stream->feeding)) {
+        /* the channel is started before the feeder, which stops it once the
+         * file has played out */
+        fed = _stream_prime(stream) == 0;
     }
-    else {
-        channelnum = Mix_PlayChannelTimed(channelnum, chunk, loops, playtime);
+    channelnum = Mix_GroupNewer(tag);
+    if (channelnum == -1) {
+        channelnum = Mix_PlayChannel(-1, stream->chunk, -1);
+        started = channelnum != -1;
+        if (started) {
+            registered = Mix_RegisterEffect(channelnum, _stream_effect, NULL,
+                                            stream);
+            if (registered) {
+                Mix_GroupChannel(channelnum, tag);
+                _dsp_attach(channelnum);
+            }
+            else {
+                Mix_HaltChannel(channelnum);
+            }
+        }
+    }
+    if (fed && registered && channelnum != -1 &&
+        _stream_start_feeder(stream)) {
+        Mix_HaltGroup(tag);
+        registered = 0;
     }
-    if (channelnum != -1)
-        Mix_GroupChannel(channelnum, (int)(intptr_t)chunk);
     Py_END_ALLOW_THREADS;
+    if (!registered) {
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    if (channelnum == -1) {
+        Py_RETURN_NONE;
+    }
 
-    Py_XDECREF(channeldata[channelnum].sound);
-    Py_XDECREF(channeldata[channelnum].queue);
-    channeldata[channelnum].sound = sound;
-    channeldata[channelnum].queue = NULL;
-    Py_INCREF(sound);
-    Py_RETURN_NONE;
+    if (started) {
+        Py_XDECREF(channeldata[channelnum].sound);
+        Py_XDECREF(channeldata[channelnum].queue);
+        channeldata[channelnum].sound = NULL;
+        channeldata[channelnum].queue = NULL;
+
+        // make sure volume on this arbitrary channel is set to full
+        Mix_Volume(channelnum, 128);
+    }
+
+    return pgChannel_New(channelnum);
 }
 
 static PyObject *
-chan_queue(PyObject *self, PyObject *args)
+stream_stop(PyObject *self, PyObject *_null)
 {
-    int channelnum = pgChannel_AsInt(self);
-    PyObject *sound;
-    Mix_Chunk *chunk;
-
-    if (!PyArg_ParseTuple(args, "O!", &pgSound_Type, &sound))
-        return NULL;
-    chunk = pgSound_AsChunk(sound);
-
-    if (!channeldata[channelnum].sound) /*nothing playing*/
-    {
-        Py_BEGIN_ALLOW_THREADS;
-        channelnum = Mix_PlayChannelTimed(channelnum, chunk, 0, -1);
-        if (channelnum != -1)
-            Mix_GroupChannel(channelnum, (int)(intptr_t)chunk);
-        Py_END_ALLOW_THREADS;
+    pgStreamObject *stream = (pgStreamObject *)self;
+    int tag = (int)(intptr_t)stream->chunk;
 
-        channeldata[channelnum].sound = sound;
-        Py_INCREF(sound);
-    }
-    else {
-        Py_XDECREF(channeldata[channelnum].queue);
-        channeldata[channelnum].queue = sound;
-        Py_INCREF(sound);
+    MIXER_INIT_CHECK();
+    Py_BEGIN_ALLOW_THREADS;
+    Mix_HaltGroup(tag);
+    if (stream->rw) {
+        /* the next play() starts the file over */
+        _stream_join_feeder(stream);
+        SDL_AtomicSet(&stream->tail, SDL_AtomicGet(&stream->head));
     }
+    Py_END_ALLOW_THREADS;
     Py_RETURN_NONE;
 }
 
 static PyObject *
-chan_get_busy(PyObject *self, PyObject *_null)
+stream_get_busy(PyObject *self, PyObject *_null)
 {
-    int channelnum = pgChannel_AsInt(self);
-    MIXER_INIT_CHECK();
+    int tag = (int)(intptr_t)((pgStreamObject *)self)->chunk;
 
-    return PyBool_FromLong(Mix_Playing(channelnum));
+    MIXER_INIT_CHECK();
+    return PyBool_FromLong(Mix_GroupCount(tag) > 0);
 }
 
 static PyObject *
-chan_fadeout(PyObject *self, PyObject *args)
+stream_get_queued(PyObject *self, PyObject *_null)
 {
-    int channelnum = pgChannel_AsInt(self);
-    int _time;
-    if (!PyArg_ParseTuple(args, "i", &_time))
-        return NULL;
+    pgStreamObject *stream = (pgStreamObject *)self;
+    Uint32 queued = (Uint32)SDL_AtomicGet(&stream->head) -
+                    (Uint32)SDL_AtomicGet(&stream->tail);
 
-    MIXER_INIT_CHECK();
-
-    Py_BEGIN_ALLOW_THREADS;
-    Mix_FadeOutChannel(channelnum, _time);
-    Py_END_ALLOW_THREADS;
-    Py_RETURN_NONE;
+    return PyLong_FromUnsignedLong(queued);
 }
 
 static PyObject *
-chan_stop(PyObject *self, PyObject *_null)
+stream_get_free(PyObject *self, PyObject *_null)
 {
-    int channelnum = pgChannel_AsInt(self);
-    MIXER_INIT_CHECK();
+    pgStreamObject *stream = (pgStreamObject *)self;
+    Uint32 queued = (Uint32)SDL_AtomicGet(&stream->head) -
+                    (Uint32)SDL_AtomicGet(&stream->tail);
+    Uint32 room = stream->size - queued;
 
-    Py_BEGIN_ALLOW_THREADS;
-    Mix_HaltChannel(channelnum);
-    Py_END_ALLOW_THREADS;
-    Py_RETURN_NONE;
+    return PyLong_FromUnsignedLong(room - room % stream->frame_size);
 }
 
 static PyObject *
-chan_pause(PyObject *self, PyObject *_null)
+stream_get_underruns(PyObject *self, PyObject *_null)
 {
-    int channelnum = pgChannel_AsInt(self);
-    MIXER_INIT_CHECK();
+    return PyLong_FromLong(
+        SDL_AtomicGet(&((pgStreamObject *)self)->underruns));
+}
 
-    Mix_Pause(channelnum);
+static PyObject *
+stream_reset_underruns(PyObject *self, PyObject *_null)
+{
+    SDL_AtomicSet(&((pgStreamObject *)self)->underruns, 0);
     Py_RETURN_NONE;
 }
 
 static PyObject *
-chan_unpause(PyObject *self, PyObject *_null)
+stream_advance(PyObject *self, PyObject *arg)
 {
-    int channelnum = pgChannel_AsInt(self);
-    MIXER_INIT_CHECK();
+    pgStreamObject *stream = (pgStreamObject *)self;
+    Uint32 head = (Uint32)SDL_AtomicGet(&stream->head);
+    Uint32 room = stream->size - (head - (Uint32)SDL_AtomicGet(&stream->tail));
+    long frames = PyLong_AsLong(arg);
 
-    Py_BEGIN_ALLOW_THREADS;
-    Mix_Resume(channelnum);
-    Py_END_ALLOW_THREADS;
+    if (frames == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (stream->rw) {
+        return RAISE(PyExc_RuntimeError,
+                     "cannot advance a Stream fed from a file");
+    }
+    if (frames < 0 || frames > (long)(room / stream->frame_size)) {
+        return RAISE(PyExc_ValueError, "frames outside the free space");
+    }
+
+    /* the samples written through the view before head is published */
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&stream->head, (int)(head + frames * stream->frame_size));
     Py_RETURN_NONE;
 }
 
-static PyObject *
-chan_set_volume(PyObject *self, PyObject *args)
+static PyMethodDef stream_methods[] = {
+    {"write", stream_write, METH_O, DOC_STREAMWRITE},
+    {"play", stream_play, METH_NOARGS, DOC_STREAMPLAY},
+    {"stop", stream_stop, METH_NOARGS, DOC_STREAMSTOP},
+    {"get_busy", stream_get_busy, METH_NOARGS, DOC_STREAMGETBUSY},
+    {"get_queued", stream_get_queued, METH_NOARGS, DOC_STREAMGETQUEUED},
+    {"get_free", stream_get_free, METH_NOARGS, DOC_STREAMGETFREE},
+    {"advance", stream_advance, METH_O, DOC_STREAMADVANCE},
+    {"get_underruns", stream_get_underruns, METH_NOARGS,
+     DOC_STREAMGETUNDERRUNS},
+    {"reset_underruns", stream_reset_underruns, METH_NOARGS,
+     DOC_STREAMRESETUNDERRUNS},
+    {NULL, NULL, 0, NULL}};
+
+/* Exports the free space after head, up to where the ring wraps, to be
+ * written in place and queued with advance().
+ */
+static int
+stream_getbuffer(PyObject *obj, Py_buffer *view, int flags)
 {
-    int channelnum = pgChannel_AsInt(self);
-    float volume, stereovolume = -1.11f;
-#ifdef Py_DEBUG
-    int result;
-#endif
-    Uint8 left, right;
-    PyThreadState *_save;
+    pgStreamObject *self = (pgStreamObject *)obj;
+    Uint32 head, room, start;
 
-    if (!PyArg_ParseTuple(args, "f|f", &volume, &stereovolume))
-        return NULL;
+    view->obj = 0;
+    if (self->rw) {
+        PyErr_SetString(pgExc_BufferError,
+                        "a Stream fed from a file has no free samples");
+        return -1;
+    }
+    if (self->size % self->frame_size) {
+        PyErr_SetString(pgExc_BufferError,
+                        "the Stream buffer does not hold whole frames of "
+                        "this many channels");
+        return -1;
+    }
+    head = (Uint32)SDL_AtomicGet(&self->head);
+    room = self->size - (head - (Uint32)SDL_AtomicGet(&self->tail));
+    start = head & (self->size - 1);
+
+    /* the mixer was done reading the bytes freed before tail moved */
+    SDL_MemoryBarrierAcquire();
+    return _sample_view(obj, view, flags, self->buf + start,
+                        (Py_ssize_t)SDL_min(room, self->size - start), 0);
+}
 
-    MIXER_INIT_CHECK();
-    if ((stereovolume <= -1.10f) && (stereovolume >= -1.12f)) {
-        /* The normal volume will be used. No panning. so panning is
-         * set to full. this is in case it was set previously to
-         * something else. NOTE: there is no way to GetPanning
-         * variables.
-         */
-        left = 255;
-        right = 255;
+static PyBufferProcs stream_as_buffer[] = {
+    {stream_getbuffer, snd_releasebuffer}};
 
-        _save = PyEval_SaveThread();
-        if (!Mix_SetPanning(channelnum, left, right)) {
-            PyEval_RestoreThread(_save);
-            return RAISE(pgExc_SDLError, Mix_GetError());
+static void
+stream_dealloc(pgStreamObject *self)
+{
+    if (self->feeder) {
+        Py_BEGIN_ALLOW_THREADS;
+        _stream_join_feeder(self);
+        Py_END_ALLOW_THREADS;
+    }
+    /* freeing the chunk halts its channel, removing the effect */
+    if (self->chunk) {
+        Uint8 *silence = self->chunk->abuf;
+        Py_BEGIN_ALLOW_THREADS;
+        Mix_FreeChunk(self->chunk);
+        Py_END_ALLOW_THREADS;
+        PyMem_Free(silence);
+    }
+    PyMem_Free(self->buf);
+    if (self->convert) {
+        SDL_FreeAudioStream(self->convert);
+    }
+    if (self->rw) {
+        pgRWops_ReleaseObject(self->rw);
+    }
+    if (self->weakreflist)
+        PyObject_ClearWeakRefs((PyObject *)self);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static int
+stream_init(pgStreamObject *self, PyObject *args, PyObject *kwargs)
+{
+    int size = 0, loops = 0, freq, itemsize;
+    Uint32 bytes = 1;
+    Uint8 *silence;
+    PyObject *file = Py_None;
+    SDL_RWops *rw;
+    static char *kwids[] = {"size", "file", "loops", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|iOi", kwids, &size,
+                                     &file, &loops)) {
+        return -1;
+    }
+    if (!SDL_WasInit(SDL_INIT_AUDIO)) {
+        PyErr_SetString(pgExc_SDLError, "mixer not initialized");
+        return -1;
+    }
+    if (self->chunk) {
+        PyErr_SetString(PyExc_RuntimeError, "Stream is already initialized");
+        return -1;
+    }
+    if (size < 0) {
+        PyErr_SetString(PyExc_ValueError, "size must not be negative");
+        return -1;
+    }
+
+    Mix_QuerySpec(&freq, &self->format, &self->channels);
+    itemsize = _format_itemsize(self->format);
+    if (itemsize == -1) {
+        return -1;
+    }
+    self->frame_size = itemsize * self->channels;
+    self->silence = SDL_AUDIO_ISSIGNED(self->format) ? 0 : 0x80;
+    if (!size) {
+        /* a quarter of a second */
+        size = freq / 4;
+    }
+    if ((Uint32)size > (1u << 30) / (Uint32)self->frame_size) {
+        PyErr_SetString(PyExc_ValueError, "size is too large");
+        return -1;
+    }
+    while (bytes < (Uint32)size * self->frame_size) {
+        bytes <<= 1;
+    }
+
+    PyMem_Free(self->buf);
+    self->buf = PyMem_Malloc(bytes);
+    silence = PyMem_Malloc(PG_STREAM_CHUNK_SIZE);
+    if (!self->buf || !silence) {
+        PyMem_Free(silence);
+        PyErr_NoMemory();
+        return -1;
+    }
+    self->size = bytes;
+    memset(silence, self->silence, PG_STREAM_CHUNK_SIZE);
+    self->chunk = Mix_QuickLoad_RAW(
+        silence,
+        PG_STREAM_CHUNK_SIZE - PG_STREAM_CHUNK_SIZE % self->frame_size);
+    if (!self->chunk) {
+        PyMem_Free(silence);
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        return -1;
+    }
+    /* refill often enough that a quarter of the ring is never missed */
+    self->period = (Uint32)SDL_max(
+        1, (Sint64)bytes * 250 / ((Sint64)freq * self->frame_size));
+
+    if (file != Py_None) {
+        rw = pgRWops_FromObject(file);
+        if (!rw) {
+            return -1;
         }
-        PyEval_RestoreThread(_save);
+        if (_stream_open_wav(self, rw)) {
+            pgRWops_ReleaseObject(rw);
+            return -1;
+        }
+        self->rw = rw;
+        self->loops = self->loops_left = loops;
     }
-    else {
-        /* NOTE: here the volume will be set to 1.0 and the panning will
-         * be used. */
-        left = (Uint8)(volume * 255);
-        right = (Uint8)(stereovolume * 255);
-        /*
-        printf("left:%d:  right:%d:\n", left, right);
-        */
+    return 0;
+}
 
-        _save = PyEval_SaveThread();
-        if (!Mix_SetPanning(channelnum, left, right)) {
-            PyEval_RestoreThread(_save);
-            return RAISE(pgExc_SDLError, Mix_GetError());
+static PyTypeObject pgStream_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "Stream",
+    .tp_basicsize = sizeof(pgStreamObject),
+    .tp_dealloc = (destructor)stream_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_PYGAMEMIXERSTREAM,
+    .tp_weaklistoffset = offsetof(pgStreamObject, weakreflist),
+    .tp_as_buffer = stream_as_buffer,
+    .tp_methods = stream_methods,
+    .tp_init = (initproc)stream_init,
+    .tp_new = PyType_GenericNew,
+};
+
+/*
+ * Background loading: load_async() queues the file for a small pool of
+ * loader threads, which decode it into a Mix_Chunk without the GIL, and
+ * returns a SoundLoad to collect the Sound from once it is ready.
+ */
+#define PG_LOAD_THREADS 2
+
+typedef struct pgSoundLoadObject {
+    PyObject_HEAD struct pgSoundLoadObject *next; /* in the queue */
+    SDL_RWops *rw;
+    int event;
+    /* guarded by _load_lock until state is no longer PG_LOAD_PENDING */
+    int state;
+    Mix_Chunk *chunk;
+    char error[256];
+    PyObject *sound;
+} pgSoundLoadObject;
+
+#define PG_LOAD_PENDING 0
+#define PG_LOAD_DONE 1
+#define PG_LOAD_FAILED 2
+
+static SDL_mutex *_load_lock = NULL;
+static SDL_cond *_load_wake = NULL; /* a load was queued, or quitting */
+static SDL_cond *_load_done = NULL; /* a load finished */
+static SDL_Thread *_load_threads[PG_LOAD_THREADS];
+static pgSoundLoadObject *_load_head = NULL;
+static pgSoundLoadObject **_load_tail = &_load_head;
+static int _load_pending = 0; /* loads queued or being decoded */
+static int _load_quit = 0;
+
+static int SDLCALL
+_load_worker(void *unused)
+{
+    pgSoundLoadObject *load;
+    Mix_Chunk *chunk;
+    PyGILState_STATE gstate;
+
+    SDL_LockMutex(_load_lock);
+    for (;;) {
+        while (!_load_head && !_load_quit)
+            SDL_CondWait(_load_wake, _load_lock);
+        load = _load_head;
+        if (!load)
+            break;
+        _load_head = load->next;
+        if (!_load_head)
+            _load_tail = &_load_head;
+        SDL_UnlockMutex(_load_lock);
+
+        chunk = Mix_LoadWAV_RW(load->rw, 0);
+
+        gstate = PyGILState_Ensure();
+        pgRWops_ReleaseObject(load->rw);
+        load->rw = NULL;
+        SDL_LockMutex(_load_lock);
+        load->chunk = chunk;
+        if (chunk) {
+            load->state = PG_LOAD_DONE;
         }
-        PyEval_RestoreThread(_save);
+        else {
+            SDL_strlcpy(load->error, SDL_GetError(), sizeof(load->error));
+            load->state = PG_LOAD_FAILED;
+        }
+        SDL_CondBroadcast(_load_done);
+        SDL_UnlockMutex(_load_lock);
+        if (load->event && SDL_WasInit(SDL_INIT_VIDEO))
+            _pg_push_mixer_event(load->event, 0, (PyObject *)load);
+        /* the queue's reference */
+        Py_DECREF(load);
+        PyGILState_Release(gstate);
+
+        SDL_LockMutex(_load_lock);
+        --_load_pending;
+        SDL_CondBroadcast(_load_done);
+    }
+    SDL_UnlockMutex(_load_lock);
+    return 0;
+}
+
+static int
+_load_start(void)
+{
+    int i;
 
-        volume = 1.0f;
+    if (!_load_lock) {
+        _load_lock = SDL_CreateMutex();
+        _load_wake = SDL_CreateCond();
+        _load_done = SDL_CreateCond();
+        if (!_load_lock || !_load_wake || !_load_done)
+            return -1;
     }
-
-#ifdef Py_DEBUG
-    result =
-#endif
-        Mix_Volume(channelnum, (int)(volume * 128));
-    Py_RETURN_NONE;
+    for (i = 0; i < PG_LOAD_THREADS; i++) {
+        if (!_load_threads[i]) {
+            _load_threads[i] =
+                SDL_CreateThread(_load_worker, "pygame_sound_load", NULL);
+            if (!_load_threads[i])
+                return i ? 0 : -1;
+        }
+    }
+    return 0;
 }
 
-static PyObject *
-chan_get_volume(PyObject *self, PyObject *_null)
+/* Finishes the queued loads and stops the loader threads, before the
+ * mixer closes the device the loads convert for. Call without the GIL.
+ */
+static void
+_load_shutdown(void)
 {
-    int channelnum = pgChannel_AsInt(self);
-    int volume;
+    int i;
 
-    MIXER_INIT_CHECK();
+    if (!_load_lock)
+        return;
+    SDL_LockMutex(_load_lock);
+    while (_load_pending)
+        SDL_CondWait(_load_done, _load_lock);
+    _load_quit = 1;
+    SDL_CondBroadcast(_load_wake);
+    SDL_UnlockMutex(_load_lock);
+    for (i = 0; i < PG_LOAD_THREADS; i++) {
+        if (_load_threads[i]) {
+            SDL_WaitThread(_load_threads[i], NULL);
+            _load_threads[i] = NULL;
+        }
+    }
+    _load_quit = 0;
+}
 
-    volume = Mix_Volume(channelnum, -1);
+static PyObject *
+soundload_done(PyObject *self, PyObject *_null)
+{
+    int state;
 
-    return PyFloat_FromDouble(volume / 128.0);
+    SDL_LockMutex(_load_lock);
+    state = ((pgSoundLoadObject *)self)->state;
+    SDL_UnlockMutex(_load_lock);
+    return PyBool_FromLong(state != PG_LOAD_PENDING);
 }
 
 static PyObject *
-chan_get_sound(PyObject *self, PyObject *_null)
+soundload_result(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    int channelnum = pgChannel_AsInt(self);
-    PyObject *sound;
+    pgSoundLoadObject *load = (pgSoundLoadObject *)self;
+    PyObject *timeout = Py_None;
+    double seconds = -1.0;
+    Uint32 start, elapsed, ms = 0;
+    int state;
+    static char *kwids[] = {"timeout", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", kwids, &timeout)) {
+        return NULL;
+    }
+    if (timeout != Py_None) {
+        seconds = PyFloat_AsDouble(timeout);
+        if (seconds == -1.0 && PyErr_Occurred()) {
+            return NULL;
+        }
+        if (seconds < 0.0) {
+            return RAISE(PyExc_ValueError, "timeout must not be negative");
+        }
+        ms = (Uint32)SDL_min(seconds * 1000.0, (double)SDL_MAX_UINT32 - 1);
+    }
 
-    sound = channeldata[channelnum].sound;
-    if (!sound)
-        Py_RETURN_NONE;
+    Py_BEGIN_ALLOW_THREADS;
+    start = SDL_GetTicks();
+    SDL_LockMutex(_load_lock);
+    while (load->state == PG_LOAD_PENDING) {
+        if (seconds < 0.0) {
+            SDL_CondWait(_load_done, _load_lock);
+            continue;
+        }
+        elapsed = SDL_GetTicks() - start;
+        if (elapsed >= ms) {
+            break;
+        }
+        SDL_CondWaitTimeout(_load_done, _load_lock, ms - elapsed);
+    }
+    state = load->state;
+    SDL_UnlockMutex(_load_lock);
+    Py_END_ALLOW_THREADS;
 
-    Py_INCREF(sound);
-    return sound;
+    if (state == PG_LOAD_PENDING) {
+        return RAISE(PyExc_TimeoutError, "the Sound has not loaded yet");
+    }
+    if (state == PG_LOAD_FAILED) {
+        return RAISE(pgExc_SDLError, load->error);
+    }
+    if (!load->sound) {
+        load->sound = pgSound_New(load->chunk);
+        if (!load->sound) {
+            return NULL;
+        }
+        load->chunk = NULL;
+    }
+    Py_INCREF(load->sound);
+    return load->sound;
 }
 
-static PyObject *
-chan_get_queue(PyObject *self, PyObject *_null)
+static PyMethodDef soundload_methods[] = {
+    {"done", soundload_done, METH_NOARGS, DOC_SOUNDLOADDONE},
+    {"result", (PyCFunction)soundload_result, METH_VARARGS | METH_KEYWORDS,
+     DOC_SOUNDLOADRESULT},
+    {NULL, NULL, 0, NULL}};
+
+static void
+soundload_dealloc(pgSoundLoadObject *self)
 {
-    int channelnum = pgChannel_AsInt(self);
-    PyObject *sound;
+    /* the queue holds a reference, so the load has finished */
+    if (self->chunk) {
+        Py_BEGIN_ALLOW_THREADS;
+        Mix_FreeChunk(self->chunk);
+        Py_END_ALLOW_THREADS;
+    }
+    Py_XDECREF(self->sound);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
 
-    sound = channeldata[channelnum].queue;
-    if (!sound)
-        Py_RETURN_NONE;
+static PyTypeObject pgSoundLoad_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "SoundLoad",
+    .tp_basicsize = sizeof(pgSoundLoadObject),
+    .tp_dealloc = (destructor)soundload_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_PYGAMEMIXERSOUNDLOAD,
+    .tp_methods = soundload_methods,
+};
 
-    Py_INCREF(sound);
-    return sound;
-}
+/*mixer module methods*/
 
 static PyObject *
-chan_set_endevent(PyObject *self, PyObject *args)
+get_sample_clock(PyObject *self, PyObject *_null)
 {
-    int channelnum = pgChannel_AsInt(self);
-    int event = SDL_NOEVENT;
+    MIXER_INIT_CHECK();
+    return PyLong_FromUnsignedLongLong(_get_clock());
+}
 
-    if (!PyArg_ParseTuple(args, "|i", &event))
+static PyObject *
+set_num_voices(PyObject *self, PyObject *args)
+{
+    int count;
+    if (!PyArg_ParseTuple(args, "i", &count))
         return NULL;
 
-    channeldata[channelnum].endevent = event;
+    MIXER_INIT_CHECK();
+    if (count < 0) {
+        return RAISE(PyExc_ValueError, "count must not be negative");
+    }
+    if (_resize_voices(count, 0)) {
+        return NULL;
+    }
     Py_RETURN_NONE;
 }
 
 static PyObject *
-chan_get_endevent(PyObject *self, PyObject *_null)
+get_num_voices(PyObject *self, PyObject *_null)
 {
-    int channelnum = pgChannel_AsInt(self);
-
-    return PyLong_FromLong(channeldata[channelnum].endevent);
+    MIXER_INIT_CHECK();
+    return PyLong_FromLong(_nvoices);
 }
 
-static PyMethodDef channel_methods[] = {
-    {"play", (PyCFunction)chan_play, METH_VARARGS | METH_KEYWORDS,
-     DOC_CHANNELPLAY},
-    {"queue", chan_queue, METH_VARARGS, DOC_CHANNELQUEUE},
-    {"get_busy", (PyCFunction)chan_get_busy, METH_NOARGS, DOC_CHANNELGETBUSY},
-    {"fadeout", chan_fadeout, METH_VARARGS, DOC_CHANNELFADEOUT},
-    {"stop", (PyCFunction)chan_stop, METH_NOARGS, DOC_CHANNELSTOP},
-    {"pause", (PyCFunction)chan_pause, METH_NOARGS, DOC_CHANNELPAUSE},
-    {"unpause", (PyCFunction)chan_unpause, METH_NOARGS, DOC_CHANNELUNPAUSE},
-    {"set_volume", chan_set_volume, METH_VARARGS, DOC_CHANNELSETVOLUME},
-    {"get_volume", (PyCFunction)chan_get_volume, METH_NOARGS,
-     DOC_CHANNELGETVOLUME},
-
-    {"get_sound", (PyCFunction)chan_get_sound, METH_NOARGS,
-     DOC_CHANNELGETSOUND},
-    {"get_queue", (PyCFunction)chan_get_queue, METH_NOARGS,
-     DOC_CHANNELGETQUEUE},
-
-    {"set_endevent", chan_set_endevent, METH_VARARGS, DOC_CHANNELSETENDEVENT},
-    {"get_endevent", (PyCFunction)chan_get_endevent, METH_NOARGS,
-     DOC_CHANNELGETENDEVENT},
+static PyObject *
+mixer_play_voice(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *sound, *released = NULL;
+    int priority = 0, loops = 0, voicenum = -1, active, i;
+    float volume = 1.0f;
+    pgVoice *voice;
+    static char *kwids[] = {"sound", "priority", "volume", "loops", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|ifi", kwids,
+                                     &pgSound_Type, &sound, &priority,
+                                     &volume, &loops))
+        return NULL;
 
-    {NULL, NULL, 0, NULL}};
+    MIXER_INIT_CHECK();
+    if (!_dsp_itemsize()) {
+        return RAISE(pgExc_SDLError,
+                     "voices need a native endian mixer format");
+    }
+    volume = volume < 0.0f ? 0.0f : volume > 1.0f ? 1.0f : volume;
 
-/* channel object internals */
+    SDL_LockMutex(_voice_lock);
+    /* a free voice, else the oldest with the lowest priority */
+    for (i = 0; i < _nvoices; i++) {
+        if (!_voices[i].chunk) {
+            voicenum = i;
+            break;
+        }
+        if (voicenum == -1 ||
+            _voices[i].priority < _voices[voicenum].priority ||
+            (_voices[i].priority == _voices[voicenum].priority &&
+             (Sint32)(_voices[i].serial - _voices[voicenum].serial) < 0)) {
+            voicenum = i;
+        }
+    }
+    if (voicenum != -1 && _voices[voicenum].chunk &&
+        _voices[voicenum].priority > priority) {
+        voicenum = -1;
+    }
+    if (voicenum == -1) {
+        ++_voices_rejected;
+    }
+    else {
+        voice = &_voices[voicenum];
+        if (voice->chunk) {
+            ++_voices_stolen;
+        }
+        else {
+            active = SDL_AtomicAdd(&_voices_active, 1) + 1;
+            _voices_peak = SDL_max(_voices_peak, active);
+        }
+        released = voice->sound;
+        Py_INCREF(sound);
+        voice->sound = sound;
+        voice->chunk = pgSound_AsChunk(sound);
+        voice->pos = 0;
+        voice->serial = _voice_serial++;
+        voice->loops = loops;
+        voice->priority = priority;
+        voice->volume = volume;
+        ++_voices_started;
+    }
+    SDL_UnlockMutex(_voice_lock);
 
-static void
-channel_dealloc(PyObject *self)
-{
-    PyObject_Free(self);
+    /* after unlocking, as freeing a Sound waits on the mixer */
+    Py_XDECREF(released);
+    return PyLong_FromLong(voicenum);
 }
 
-static int
-_channel_init(pgChannelObject *self, int channelnum)
+static PyObject *
+mixer_stop_voices(PyObject *self, PyObject *_null)
 {
-    if (!SDL_WasInit(SDL_INIT_AUDIO)) {
-        PyErr_SetString(pgExc_SDLError, "mixer not initialized");
-        return -1;
-    }
-    if (channelnum < 0 || channelnum >= Mix_GroupCount(-1)) {
-        PyErr_SetString(PyExc_IndexError, "invalid channel index");
-        return -1;
+    MIXER_INIT_CHECK();
+
+    if (_resize_voices(_nvoices, 1)) {
+        return NULL;
     }
-    self->chan = channelnum;
-    return 0;
+    Py_RETURN_NONE;
 }
 
-static int
-channel_init(pgChannelObject *self, PyObject *args, PyObject *kwargs)
+static PyObject *
+get_voice_stats(PyObject *self, PyObject *_null)
 {
-    int channelnum;
-    if (!PyArg_ParseTuple(args, "i", &channelnum)) {
-        return -1;
-    }
+    unsigned long started, stolen, rejected;
+    int peak;
 
-    return _channel_init(self, channelnum);
-}
-
-static PyTypeObject pgChannel_Type = {
-    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "Channel",
-    .tp_basicsize = sizeof(pgChannelObject),
-    .tp_dealloc = channel_dealloc,
-    .tp_doc = DOC_PYGAMEMIXERCHANNEL,
-    .tp_methods = channel_methods,
-    .tp_init = (initproc)channel_init,
-    .tp_new = PyType_GenericNew,
-};
+    MIXER_INIT_CHECK();
 
-/*mixer module methods*/
+    SDL_LockMutex(_voice_lock);
+    started = _voices_started;
+    stolen = _voices_stolen;
+    rejected = _voices_rejected;
+    peak = _voices_peak;
+    SDL_UnlockMutex(_voice_lock);
+
+    return Py_BuildValue("{s:i,s:i,s:i,s:k,s:k,s:k}", "voices", _nvoices,
+                         "active", SDL_AtomicGet(&_voices_active), "peak",
+                         peak, "started", started, "stolen", stolen,
+                         "rejected", rejected);
+}
 
 static PyObject *
 get_num_channels(PyObject *self, PyObject *_null)
@@ -1409,6 +3600,10 @@ mixer_stop(PyObject *self, PyObject *_null)
 {
     MIXER_INIT_CHECK();
 
+    _unschedule(-1);
+    if (_resize_voices(_nvoices, 1)) {
+        return NULL;
+    }
     Py_BEGIN_ALLOW_THREADS;
     Mix_HaltChannel(-1);
     Py_END_ALLOW_THREADS;
@@ -1421,6 +3616,7 @@ mixer_pause(PyObject *self, PyObject *_null)
     MIXER_INIT_CHECK();
 
     Mix_Pause(-1);
+    SDL_AtomicSet(&_voices_paused, 1);
     Py_RETURN_NONE;
 }
 
@@ -1432,6 +3628,7 @@ mixer_unpause(PyObject *self, PyObject *_null)
     Py_BEGIN_ALLOW_THREADS;
     Mix_Resume(-1);
     Py_END_ALLOW_THREADS;
+    SDL_AtomicSet(&_voices_paused, 0);
     Py_RETURN_NONE;
 }
 
@@ -1638,6 +3835,100 @@ _chunk_from_array(void *buf, PG_sample_format_t view_format, int ndim,
     return 0;
 }
 
+/* Checks that an array holds its samples as the mixer would, so that they
+ * can be played in place.
+ */
+static int
+_check_array_layout(Py_buffer *view)
+{
+    PG_sample_format_t view_format = _format_view_to_audio(view);
+    int freq, channels, itemsize, is_float, native;
+    Uint16 format;
+    char kind;
+
+    if (!view_format) {
+        return -1;
+    }
+    if (!Mix_QuerySpec(&freq, &format, &channels)) {
+        PyErr_SetString(pgExc_SDLError, "mixer not initialized");
+        return -1;
+    }
+    if (view->ndim != (channels == 1 ? 1 : 2) ||
+        (view->ndim == 2 && view->shape[1] != channels)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "Array shape must match the number of mixer channels");
+        return -1;
+    }
+
+    itemsize = SDL_AUDIO_BITSIZE(format) / 8;
+    kind = view->format ? view->format[strlen(view->format) - 1] : 'B';
+    is_float = kind == 'f' || kind == 'd';
+    native = (SDL_AUDIO_ISBIGENDIAN(format) != 0) ==
+             (SDL_BYTEORDER == SDL_BIG_ENDIAN);
+    if ((int)PG_SAMPLE_SIZE(view_format) != itemsize ||
+        is_float != (SDL_AUDIO_ISFLOAT(format) != 0) ||
+        (!is_float && ((view_format & PG_SAMPLE_SIGNED) != 0) !=
+                          (SDL_AUDIO_ISSIGNED(format) != 0)) ||
+        (itemsize > 1 &&
+         ((view_format & PG_SAMPLE_NATIVE_ENDIAN) != 0) != native)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "Array samples must be in the mixer format to be "
+                        "used without a copy");
+        return -1;
+    }
+    if (view->strides &&
+        (view->strides[view->ndim - 1] != itemsize ||
+         view->strides[0] != (Py_ssize_t)itemsize * channels)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "Array must be C contiguous to be used without a "
+                        "copy");
+        return -1;
+    }
+    return 0;
+}
+
+/* Wraps the samples exported by obj in a chunk without copying them. The
+ * export is returned in source, to be held for as long as the chunk lives.
+ */
+static int
+_chunk_from_source(PyObject *obj, int is_array, Mix_Chunk **chunk,
+                   pg_buffer **source)
+{
+    pg_buffer *pg_view = PyMem_New(pg_buffer, 1);
+    Py_buffer *view = (Py_buffer *)pg_view;
+
+    if (!pg_view) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    view->itemsize = 0;
+    view->obj = 0;
+    if (pgObject_GetBuffer(obj, pg_view,
+                           is_array ? PyBUF_RECORDS_RO : PyBUF_SIMPLE)) {
+        PyMem_Free(pg_view);
+        return -1;
+    }
+    if (is_array && _check_array_layout(view)) {
+        goto fail;
+    }
+    if ((size_t)view->len > SDL_MAX_UINT32) {
+        PyErr_SetString(PyExc_ValueError, "too many samples for a Sound");
+        goto fail;
+    }
+    *chunk = Mix_QuickLoad_RAW((Uint8 *)view->buf, (Uint32)view->len);
+    if (!*chunk) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+    *source = pg_view;
+    return 0;
+
+fail:
+    pgBuffer_Release(pg_view);
+    PyMem_Free(pg_view);
+    return -1;
+}
+
 static int
 sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
 {
@@ -1647,14 +3938,18 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
     PyObject *file = NULL;
     PyObject *buffer = NULL;
     PyObject *array = NULL;
-    PyObject *keys;
+    PyObject *key, *value;
     PyObject *kencoded;
     SDL_RWops *rw;
     Mix_Chunk *chunk = NULL;
     Uint8 *mem = NULL;
+    pg_buffer *source = NULL;
+    Py_ssize_t nkwargs = 0, pos = 0;
+    int copy = 1;
 
     ((pgSoundObject *)self)->chunk = NULL;
     ((pgSoundObject *)self)->mem = NULL;
+    ((pgSoundObject *)self)->source = NULL;
 
     /* Similar to MIXER_INIT_CHECK(), but different return value. */
     if (!SDL_WasInit(SDL_INIT_AUDIO)) {
@@ -1665,9 +3960,18 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
     /* Process arguments, returning cleaner error messages than
        PyArg_ParseTupleAndKeywords would.
     */
+    if (kwarg != NULL) {
+        nkwargs = PyDict_Size(kwarg);
+        if ((value = PyDict_GetItemString(kwarg, "copy")) != NULL) {
+            copy = PyObject_IsTrue(value);
+            if (copy == -1) {
+                return -1;
+            }
+            --nkwargs;
+        }
+    }
     if (arg != NULL && PyTuple_GET_SIZE(arg)) {
-        if ((kwarg != NULL && PyDict_Size(kwarg)) || /* conditional and */
-            PyTuple_GET_SIZE(arg) != 1) {
+        if (nkwargs || PyTuple_GET_SIZE(arg) != 1) {
             PyErr_SetString(PyExc_TypeError, arg_cnt_err_msg);
             return -1;
         }
@@ -1682,21 +3986,21 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
             buffer = obj;
         }
     }
-    else if (kwarg != NULL) {
-        if (PyDict_Size(kwarg) != 1) {
+    else if (nkwargs) {
+        if (nkwargs != 1) {
             PyErr_SetString(PyExc_TypeError, arg_cnt_err_msg);
             return -1;
         }
         if ((file = PyDict_GetItemString(kwarg, "file")) == NULL &&
             (buffer = PyDict_GetItemString(kwarg, "buffer")) == NULL &&
             (array = PyDict_GetItemString(kwarg, "array")) == NULL) {
-            keys = PyDict_Keys(kwarg);
-            if (keys == NULL) {
-                return -1;
+            while (PyDict_Next(kwarg, &pos, &key, &value)) {
+                if (!PyUnicode_Check(key) ||
+                    PyUnicode_CompareWithASCIIString(key, "copy")) {
+                    break;
+                }
             }
-            kencoded =
-                pg_EncodeString(PyList_GET_ITEM(keys, 0), NULL, NULL, NULL);
-            Py_DECREF(keys);
+            kencoded = pg_EncodeString(key, NULL, NULL, NULL);
             if (kencoded == NULL) {
                 return -1;
             }
@@ -1755,6 +4059,13 @@ LOAD_BUFFER:
                 return -1;
             }
         }
+        else if (!copy) {
+            PyBuffer_Release(&view);
+            if (_chunk_from_source(buffer, 0, &chunk, &source)) {
+                return -1;
+            }
+            ((pgSoundObject *)self)->source = source;
+        }
         else {
             rcode = _chunk_from_buf(view.buf, view.len, &chunk, &mem);
             PyBuffer_Release(&view);
@@ -1765,7 +4076,13 @@ LOAD_BUFFER:
         }
     }
 
-    if (array != NULL) {
+    if (array != NULL && !copy) {
+        if (_chunk_from_source(array, 1, &chunk, &source)) {
+            return -1;
+        }
+        ((pgSoundObject *)self)->source = source;
+    }
+    else if (array != NULL) {
         pg_buffer pg_view;
         PG_sample_format_t view_format;
         int rcode;
@@ -1805,6 +4122,59 @@ LOAD_BUFFER:
     return 0;
 }
 
+static PyObject *
+mixer_load_async(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *file;
+    pgSoundLoadObject *load;
+    SDL_RWops *rw;
+    int event = 0, started;
+    static char *kwids[] = {"file", "event", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|i", kwids, &file,
+                                     &event)) {
+        return NULL;
+    }
+    MIXER_INIT_CHECK();
+
+    rw = pgRWops_FromObject(file);
+    if (!rw) {
+        return NULL;
+    }
+    load = PyObject_New(pgSoundLoadObject, &pgSoundLoad_Type);
+    if (!load) {
+        pgRWops_ReleaseObject(rw);
+        return NULL;
+    }
+    load->next = NULL;
+    load->rw = rw;
+    load->event = event;
+    load->state = PG_LOAD_PENDING;
+    load->chunk = NULL;
+    load->error[0] = '\0';
+    load->sound = NULL;
+
+    Py_BEGIN_ALLOW_THREADS;
+    started = _load_start() == 0;
+    Py_END_ALLOW_THREADS;
+    if (!started) {
+        pgRWops_ReleaseObject(load->rw);
+        load->rw = NULL;
+        Py_DECREF(load);
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+
+    /* the queue's reference, dropped by the loader thread */
+    Py_INCREF(load);
+    SDL_LockMutex(_load_lock);
+    *_load_tail = load;
+    _load_tail = &load->next;
+    ++_load_pending;
+    SDL_CondSignal(_load_wake);
+    SDL_UnlockMutex(_load_lock);
+    return (PyObject *)load;
+}
+
 static PyMethodDef _mixer_methods[] = {
     {"_internal_mod_init", (PyCFunction)pgMixer_AutoInit, METH_NOARGS,
      "auto initialize for mixer"},
@@ -1817,9 +4187,21 @@ static PyMethodDef _mixer_methods[] = {
      DOC_PYGAMEMIXERPREINIT},
     {"get_num_channels", (PyCFunction)get_num_channels, METH_NOARGS,
      DOC_PYGAMEMIXERGETNUMCHANNELS},
+    {"get_sample_clock", (PyCFunction)get_sample_clock, METH_NOARGS,
+     DOC_PYGAMEMIXERGETSAMPLECLOCK},
     {"set_num_channels", set_num_channels, METH_VARARGS,
      DOC_PYGAMEMIXERSETNUMCHANNELS},
     {"set_reserved", set_reserved, METH_VARARGS, DOC_PYGAMEMIXERSETRESERVED},
+    {"set_num_voices", set_num_voices, METH_VARARGS,
+     DOC_PYGAMEMIXERSETNUMVOICES},
+    {"get_num_voices", (PyCFunction)get_num_voices, METH_NOARGS,
+     DOC_PYGAMEMIXERGETNUMVOICES},
+    {"play_voice", (PyCFunction)mixer_play_voice,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEMIXERPLAYVOICE},
+    {"stop_voices", (PyCFunction)mixer_stop_voices, METH_NOARGS,
+     DOC_PYGAMEMIXERSTOPVOICES},
+    {"get_voice_stats", (PyCFunction)get_voice_stats, METH_NOARGS,
+     DOC_PYGAMEMIXERGETVOICESTATS},
 
     {"get_busy", (PyCFunction)get_busy, METH_NOARGS, DOC_PYGAMEMIXERGETBUSY},
     {"find_channel", (PyCFunction)mixer_find_channel,
@@ -1831,6 +4213,8 @@ static PyMethodDef _mixer_methods[] = {
      DOC_PYGAMEMIXERUNPAUSE},
     {"get_sdl_mixer_version", (PyCFunction)mixer_get_sdl_mixer_version,
      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEMIXERGETSDLMIXERVERSION},
+    {"load_async", (PyCFunction)mixer_load_async,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEMIXERLOADASYNC},
     /*  { "lookup_frequency", lookup_frequency, 1, doc_lookup_frequency
        },*/
 
@@ -1912,6 +4296,12 @@ MODINIT_DEFINE(mixer)
     if (PyType_Ready(&pgChannel_Type) < 0) {
         return NULL;
     }
+    if (PyType_Ready(&pgStream_Type) < 0) {
+        return NULL;
+    }
+    if (PyType_Ready(&pgSoundLoad_Type) < 0) {
+        return NULL;
+    }
 
     /* create the module */
     module = PyModule_Create(&_module);
@@ -1944,12 +4334,27 @@ MODINIT_DEFINE(mixer)
         Py_DECREF(module);
         return NULL;
     }
+    Py_INCREF(&pgStream_Type);
+    if (PyModule_AddObject(module, "Stream", (PyObject *)&pgStream_Type)) {
+        Py_DECREF(&pgStream_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+    Py_INCREF(&pgSoundLoad_Type);
+    if (PyModule_AddObject(module, "SoundLoad",
+                           (PyObject *)&pgSoundLoad_Type)) {
+        Py_DECREF(&pgSoundLoad_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
     /* export the c api */
     c_api[0] = &pgSound_Type;
     c_api[1] = pgSound_New;
     c_api[2] = pgSound_Play;
     c_api[3] = &pgChannel_Type;
     c_api[4] = pgChannel_New;
+    c_api[5] = &pgStream_Type;
+    c_api[6] = pgStream_Write;
     apiobj = encapsulate_api(c_api, "mixer");
     if (PyModule_AddObject(module, PYGAMEAPI_LOCAL_ENTRY, apiobj)) {
         Py_XDECREF(apiobj);
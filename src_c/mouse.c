@@ -62,42 +62,82 @@ mouse_set_pos(PyObject *self, PyObject *args)
     Py_RETURN_NONE;
 }
 
+/* the mouse position in the coordinates of the display surface, which
+ * differ from the window's when it is scaled; returns the buttons held */
+static Uint32
+_pg_mouse_state(int *x, int *y)
+{
+    Uint32 state = SDL_GetMouseState(x, y);
+    SDL_Window *sdlWindow = pg_GetDefaultWindow();
+    SDL_Renderer *sdlRenderer = SDL_GetRenderer(sdlWindow);
+
+    if (sdlRenderer != NULL) {
+        SDL_Rect vprect;
+        float scalex, scaley;
+
+        SDL_RenderGetScale(sdlRenderer, &scalex, &scaley);
+        SDL_RenderGetViewport(sdlRenderer, &vprect);
+
+        *x = (int)(*x / scalex);
+        *y = (int)(*y / scaley);
+
+        *x -= vprect.x;
+        *y -= vprect.y;
+
+        if (*x < 0)
+            *x = 0;
+        if (*x >= vprect.w)
+            *x = vprect.w - 1;
+        if (*y < 0)
+            *y = 0;
+        if (*y >= vprect.h)
+            *y = vprect.h - 1;
+    }
+    return state;
+}
+
 static PyObject *
 mouse_get_pos(PyObject *self, PyObject *_null)
 {
     int x, y;
 
     VIDEO_INIT_CHECK();
-    SDL_GetMouseState(&x, &y);
+    _pg_mouse_state(&x, &y);
 
-    {
-        SDL_Window *sdlWindow = pg_GetDefaultWindow();
-        SDL_Renderer *sdlRenderer = SDL_GetRenderer(sdlWindow);
-        if (sdlRenderer != NULL) {
-            SDL_Rect vprect;
-            float scalex, scaley;
+    return Py_BuildValue("(ii)", x, y);
+}
 
-            SDL_RenderGetScale(sdlRenderer, &scalex, &scaley);
-            SDL_RenderGetViewport(sdlRenderer, &vprect);
+/* the buttons held at the last get_state_into() call, for the changed
+ * bits */
+static Uint32 _pg_mouse_last_buttons = 0;
 
-            x = (int)(x / scalex);
-            y = (int)(y / scaley);
+static PyObject *
+mouse_get_state_into(PyObject *self, PyObject *arg)
+{
+    Py_buffer view;
+    int fields[4];
+    Uint32 buttons;
 
-            x -= vprect.x;
-            y -= vprect.y;
+    VIDEO_INIT_CHECK();
 
-            if (x < 0)
-                x = 0;
-            if (x >= vprect.w)
-                x = vprect.w - 1;
-            if (y < 0)
-                y = 0;
-            if (y >= vprect.h)
-                y = vprect.h - 1;
-        }
+    if (PyObject_GetBuffer(arg, &view, PyBUF_WRITABLE))
+        return NULL;
+    if (view.len < (Py_ssize_t)sizeof(fields)) {
+        PyBuffer_Release(&view);
+        return PyErr_Format(PyExc_ValueError,
+                            "buffer must be at least %d bytes long",
+                            (int)sizeof(fields));
     }
 
-    return Py_BuildValue("(ii)", x, y);
+    buttons = _pg_mouse_state(&fields[0], &fields[1]);
+    fields[2] = (int)buttons;
+    fields[3] = (int)(buttons ^ _pg_mouse_last_buttons);
+    _pg_mouse_last_buttons = buttons;
+
+    /* the buffer may not be aligned for ints */
+    memcpy(view.buf, fields, sizeof(fields));
+    PyBuffer_Release(&view);
+    Py_RETURN_NONE;
 }
 
 static PyObject *
@@ -358,6 +398,8 @@ _set_color_cursor(int spotx, int spoty, pgSurfaceObject *surfobj)
     SDL_Cursor *lastcursor, *cursor = NULL;
     SDL_Surface *surf = NULL;
     surf = pgSurface_AsSurface(surfobj);
+    if (!pgSurface_Unpack(surf))
+        return NULL;
 
     cursor = SDL_CreateColorCursor(surf, spotx, spoty);
     if (!cursor)
@@ -467,6 +509,8 @@ static PyMethodDef _mouse_methods[] = {
      DOC_PYGAMEMOUSEGETPOS},
     {"get_rel", (PyCFunction)mouse_get_rel, METH_VARARGS,
      DOC_PYGAMEMOUSEGETREL},
+    {"get_state_into", mouse_get_state_into, METH_O,
+     DOC_PYGAMEMOUSEGETSTATEINTO},
     {"get_pressed", (PyCFunction)mouse_get_pressed,
      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEMOUSEGETPRESSED},
     {"set_visible", mouse_set_visible, METH_VARARGS,
@@ -33,8 +33,7 @@
 #include "mixer.h"
 
 static Mix_Music *current_music = NULL;
-static Mix_Music *queue_music = NULL;
-static int queue_music_loops = 0;
+static int current_loops = 0;
 static int endmusic_event = SDL_NOEVENT;
 static Uint64 music_pos = 0;
 static long music_pos_time = -1;
@@ -42,12 +41,268 @@ static int music_frequency = 0;
 static Uint16 music_format = 0;
 static int music_channels = 0;
 
+#if SDL_MIXER_MAJOR_VERSION > 2 || \
+    (SDL_MIXER_MAJOR_VERSION == 2 && SDL_MIXER_MINOR_VERSION >= 6)
+#define PG_MUSIC_HAS_DURATION 1
+#endif
+
+/* The queue is a playlist of tracks to follow the current music. Each is
+ * opened when it is queued, so it starts as soon as the one before ends.
+ * Tracks queued with wait=False are opened on a loader thread instead.
+ * No Mix_* function is called with queue_lock held, since the audio
+ * thread takes it when the music ends.
+ */
+typedef struct pgTrack {
+    struct pgTrack *next;      /* in the queue */
+    struct pgTrack *next_open; /* in the work list of the loader */
+    Mix_Music *music;
+    SDL_RWops *rw; /* until opened */
+    Mix_MusicType type;
+    int loops;
+    int fade_ms;
+    int state;
+} pgTrack;
+
+#define PG_TRACK_OPENING 0
+#define PG_TRACK_READY 1
+#define PG_TRACK_FAILED 2
+#define PG_TRACK_DROPPED 3 /* taken out of the queue while opening */
+
+static SDL_mutex *queue_lock = NULL; /* guards the fields below */
+static SDL_cond *queue_wake = NULL;
+static pgTrack *queue_head = NULL;
+static pgTrack *queue_tail = NULL;
+static int queue_length = 0;
+static int queue_waiting = 0; /* the music ended before the head opened */
+static pgTrack *open_head = NULL;
+static pgTrack *open_tail = NULL;
+static SDL_Thread *loader = NULL;
+static int loader_quit = 0;
+static SDL_atomic_t next_fade_ms;
+static int fading_out = 0;
+
+static void
+endmusic_callback(void);
+
+/* Fades the current music out over the fade in of the next track, so the
+ * two meet where the current music ends. SDL_mixer plays one music stream
+ * at a time, so the tracks cannot overlap.
+ */
+static void
+_fade_to_next(void)
+{
+#ifdef PG_MUSIC_HAS_DURATION
+    int fade_ms = SDL_AtomicGet(&next_fade_ms);
+    double duration, position;
+    int left_ms;
+
+    if (!fade_ms || fading_out || current_loops || !current_music) {
+        return;
+    }
+    duration = Mix_MusicDuration(current_music);
+    position = Mix_GetMusicPosition(current_music);
+    if (duration <= 0.0 || position < 0.0) {
+        return;
+    }
+    left_ms = (int)((duration - position) * 1000.0);
+    if (left_ms >= 1 && left_ms <= fade_ms) {
+        fading_out = 1;
+        Mix_FadeOutMusic(left_ms);
+    }
+#endif /* PG_MUSIC_HAS_DURATION */
+}
+
 static void
 mixmusic_callback(void *udata, Uint8 *stream, int len)
 {
     if (!Mix_PausedMusic()) {
         music_pos += len;
         music_pos_time = SDL_GetTicks();
+        _fade_to_next();
+    }
+}
+
+/* Call with queue_lock held */
+static void
+_queue_changed(void)
+{
+    SDL_AtomicSet(&next_fade_ms, queue_head ? queue_head->fade_ms : 0);
+}
+
+/* Takes the track to play next off the queue, passing over the ones that
+ * failed to open. Returns NULL if the queue is empty, or if its head is
+ * still opening, in which case the loader starts the head once open.
+ * Call with queue_lock held.
+ */
+static pgTrack *
+_pop_track(pgTrack **failed)
+{
+    pgTrack *track;
+
+    queue_waiting = 0;
+    while ((track = queue_head) != NULL) {
+        if (track->state == PG_TRACK_OPENING) {
+            queue_waiting = 1;
+            track = NULL;
+            break;
+        }
+        queue_head = track->next;
+        if (!queue_head) {
+            queue_tail = NULL;
+        }
+        --queue_length;
+        if (track->state == PG_TRACK_READY) {
+            break;
+        }
+        track->next = *failed;
+        *failed = track;
+    }
+    _queue_changed();
+    return track;
+}
+
+/* Empties the queue into a list of the tracks to free. The tracks still
+ * opening are left for the loader to free. Call with queue_lock held.
+ */
+static pgTrack *
+_detach_queue(void)
+{
+    pgTrack *track, *next, *detached = NULL;
+
+    for (track = queue_head; track; track = next) {
+        next = track->next;
+        if (track->state == PG_TRACK_OPENING) {
+            track->state = PG_TRACK_DROPPED;
+        }
+        else {
+            track->next = detached;
+            detached = track;
+        }
+    }
+    queue_head = queue_tail = NULL;
+    queue_length = 0;
+    queue_waiting = 0;
+    _queue_changed();
+    return detached;
+}
+
+static void
+_free_tracks(pgTrack *track)
+{
+    pgTrack *next;
+
+    for (; track; track = next) {
+        next = track->next;
+        if (track->music) {
+            Mix_FreeMusic(track->music);
+        }
+        SDL_free(track);
+    }
+}
+
+static void
+_clear_queue(void)
+{
+    pgTrack *detached;
+
+    if (!queue_lock) {
+        return;
+    }
+    SDL_LockMutex(queue_lock);
+    detached = _detach_queue();
+    SDL_UnlockMutex(queue_lock);
+    _free_tracks(detached);
+}
+
+/* Plays a track taken off the queue in place of the current music. */
+static void
+_start_track(pgTrack *track)
+{
+    if (current_music) {
+        Mix_FreeMusic(current_music);
+    }
+    current_music = track->music;
+    current_loops = track->loops;
+    fading_out = 0;
+    Mix_HookMusicFinished(endmusic_callback);
+    music_pos = 0;
+    Mix_FadeInMusic(current_music, track->loops, track->fade_ms);
+    SDL_free(track);
+}
+
+static int SDLCALL
+_loader_run(void *_null)
+{
+    pgTrack *track, *next, *failed;
+    Mix_Music *music;
+    int dropped;
+
+    SDL_LockMutex(queue_lock);
+    for (;;) {
+        while (!open_head && !loader_quit) {
+            SDL_CondWait(queue_wake, queue_lock);
+        }
+        if (!open_head) {
+            break;
+        }
+        track = open_head;
+        open_head = track->next_open;
+        if (!open_head) {
+            open_tail = NULL;
+        }
+        dropped = track->state == PG_TRACK_DROPPED;
+        SDL_UnlockMutex(queue_lock);
+
+        /* a track dropped before it was opened is not worth opening */
+        if (dropped) {
+            SDL_RWclose(track->rw);
+            music = NULL;
+        }
+        else {
+            music = Mix_LoadMUSType_RW(track->rw, track->type, SDL_TRUE);
+        }
+        track->rw = NULL;
+
+        failed = next = NULL;
+        SDL_LockMutex(queue_lock);
+        track->music = music;
+        if (track->state == PG_TRACK_DROPPED) {
+            track->next = NULL;
+            failed = track;
+        }
+        else {
+            track->state = music ? PG_TRACK_READY : PG_TRACK_FAILED;
+            if (queue_waiting && queue_head == track) {
+                next = _pop_track(&failed);
+            }
+        }
+        SDL_UnlockMutex(queue_lock);
+
+        _free_tracks(failed);
+        if (next) {
+            _start_track(next);
+        }
+        SDL_LockMutex(queue_lock);
+    }
+    SDL_UnlockMutex(queue_lock);
+    return 0;
+}
+
+/* Empties the queue and stops the loader, for mixer.quit(). Called without
+ * the GIL, as closing a Python file object in the loader takes it.
+ */
+static void
+_quit_queue(void)
+{
+    _clear_queue();
+    if (loader) {
+        SDL_LockMutex(queue_lock);
+        loader_quit = 1;
+        SDL_CondSignal(queue_wake);
+        SDL_UnlockMutex(queue_lock);
+        SDL_WaitThread(loader, NULL);
+        loader = NULL;
+        loader_quit = 0;
     }
 }
 
@@ -71,20 +326,24 @@ _pg_push_music_event(int type)
 static void
 endmusic_callback(void)
 {
+    pgTrack *track = NULL, *failed = NULL;
+    int waiting = 0;
+
     if (endmusic_event && SDL_WasInit(SDL_INIT_VIDEO))
         _pg_push_music_event(endmusic_event);
 
-    if (queue_music) {
-        if (current_music)
-            Mix_FreeMusic(current_music);
-        current_music = queue_music;
-        queue_music = NULL;
-        Mix_HookMusicFinished(endmusic_callback);
-        music_pos = 0;
-        Mix_PlayMusic(current_music, queue_music_loops);
-        queue_music_loops = 0;
+    if (queue_lock) {
+        SDL_LockMutex(queue_lock);
+        track = _pop_track(&failed);
+        waiting = queue_waiting;
+        SDL_UnlockMutex(queue_lock);
+        _free_tracks(failed);
     }
-    else {
+
+    if (track) {
+        _start_track(track);
+    }
+    else if (!waiting) {
         music_pos_time = -1;
         Mix_SetPostMix(NULL, NULL);
     }
@@ -113,6 +372,8 @@ music_play(PyObject *self, PyObject *args, PyObject *keywds)
     Mix_QuerySpec(&music_frequency, &music_format, &music_channels);
     music_pos = 0;
     music_pos_time = SDL_GetTicks();
+    current_loops = loops;
+    fading_out = 0;
 
     volume = Mix_VolumeMusic(-1);
     val = Mix_FadeInMusicPos(current_music, loops, fade_ms, startpos);
@@ -148,12 +409,8 @@ music_fadeout(PyObject *self, PyObject *args)
     MIXER_INIT_CHECK();
 
     Py_BEGIN_ALLOW_THREADS;
-    /* To prevent the queue_music from playing, free it before fading. */
-    if (queue_music) {
-        Mix_FreeMusic(queue_music);
-        queue_music = NULL;
-        queue_music_loops = 0;
-    }
+    /* To prevent the queued music from playing, free it before fading. */
+    _clear_queue();
 
     Mix_FadeOutMusic(_time);
 
@@ -167,12 +424,8 @@ music_stop(PyObject *self, PyObject *_null)
     MIXER_INIT_CHECK();
 
     Py_BEGIN_ALLOW_THREADS;
-    /* To prevent the queue_music from playing, free it before stopping. */
-    if (queue_music) {
-        Mix_FreeMusic(queue_music);
-        queue_music = NULL;
-        queue_music_loops = 0;
-    }
+    /* To prevent the queued music from playing, free it before stopping. */
+    _clear_queue();
 
     Mix_HaltMusic();
 
@@ -369,18 +622,16 @@ _get_type_from_hint(char *namehint)
     return type;
 }
 
-Mix_Music *
-_load_music(PyObject *obj, char *namehint)
+/* Opens obj for reading, and finds the type of music in it. */
+static SDL_RWops *
+_music_rw(PyObject *obj, char *namehint, Mix_MusicType *type)
 {
-    Mix_Music *new_music = NULL;
     char *ext = NULL;
     SDL_RWops *rw = NULL;
     PyObject *_type = NULL;
     PyObject *error = NULL;
     PyObject *_traceback = NULL;
 
-    MIXER_INIT_CHECK();
-
     rw = pgRWops_FromObject(obj);
     if (rw ==
         NULL) { /* stop on NULL, error already set is what we SHOULD do */
@@ -396,9 +647,26 @@ _load_music(PyObject *obj, char *namehint)
     else {
         ext = pgRWops_GetFileExtension(rw);
     }
+    *type = _get_type_from_hint(ext);
+    return rw;
+}
+
+Mix_Music *
+_load_music(PyObject *obj, char *namehint)
+{
+    Mix_Music *new_music = NULL;
+    Mix_MusicType type;
+    SDL_RWops *rw = NULL;
+
+    MIXER_INIT_CHECK();
+
+    rw = _music_rw(obj, namehint, &type);
+    if (rw == NULL) {
+        return NULL;
+    }
 
     Py_BEGIN_ALLOW_THREADS;
-    new_music = Mix_LoadMUSType_RW(rw, _get_type_from_hint(ext), SDL_TRUE);
+    new_music = Mix_LoadMUSType_RW(rw, type, SDL_TRUE);
     Py_END_ALLOW_THREADS;
 
     if (!new_music) {
@@ -428,15 +696,11 @@ music_load(PyObject *self, PyObject *args, PyObject *keywds)
         return NULL;
 
     Py_BEGIN_ALLOW_THREADS;
+    _clear_queue();
     if (current_music != NULL) {
         Mix_FreeMusic(current_music);
         current_music = NULL;
     }
-    if (queue_music != NULL) {
-        Mix_FreeMusic(queue_music);
-        queue_music = NULL;
-        queue_music_loops = 0;
-    }
     Py_END_ALLOW_THREADS;
 
     current_music = new_music;
@@ -449,15 +713,11 @@ music_unload(PyObject *self, PyObject *_null)
     MIXER_INIT_CHECK();
 
     Py_BEGIN_ALLOW_THREADS;
+    _clear_queue();
     if (current_music) {
         Mix_FreeMusic(current_music);
         current_music = NULL;
     }
-    if (queue_music) {
-        Mix_FreeMusic(queue_music);
-        queue_music = NULL;
-        queue_music_loops = 0;
-    }
     Py_END_ALLOW_THREADS;
 
     Py_RETURN_NONE;
@@ -466,36 +726,113 @@ music_unload(PyObject *self, PyObject *_null)
 static PyObject *
 music_queue(PyObject *self, PyObject *args, PyObject *keywds)
 {
-    Mix_Music *local_queue_music = NULL;
+    pgTrack *track, *detached = NULL;
     PyObject *obj;
-    int loops = 0;
+    int loops = 0, append = 0, fade_ms = 0, wait = 1;
     char *namehint = NULL;
-    static char *kwids[] = {"filename", "namehint", "loops", NULL};
+    static char *kwids[] = {"filename", "namehint", "loops", "append",
+                            "fade_ms",  "wait",     NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|si", kwids, &obj,
-                                     &namehint, &loops))
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|sipip", kwids, &obj,
+                                     &namehint, &loops, &append, &fade_ms,
+                                     &wait))
         return NULL;
 
     MIXER_INIT_CHECK();
 
-    queue_music_loops = loops;
+    if (!queue_lock) {
+        queue_lock = SDL_CreateMutex();
+        if (!queue_lock) {
+            return RAISE(pgExc_SDLError, SDL_GetError());
+        }
+    }
+    if (!queue_wake) {
+        queue_wake = SDL_CreateCond();
+        if (!queue_wake) {
+            return RAISE(pgExc_SDLError, SDL_GetError());
+        }
+    }
 
-    local_queue_music = _load_music(obj, namehint);
-    if (local_queue_music == NULL)  // meaning it has an error to return
-        return NULL;
+    track = (pgTrack *)SDL_calloc(1, sizeof(pgTrack));
+    if (!track) {
+        return PyErr_NoMemory();
+    }
+    track->loops = loops;
+    track->fade_ms = SDL_max(fade_ms, 0);
+    if (wait) {
+        track->music = _load_music(obj, namehint);
+        if (track->music == NULL) {  // meaning it has an error to return
+            SDL_free(track);
+            return NULL;
+        }
+        track->state = PG_TRACK_READY;
+    }
+    else {
+        track->rw = _music_rw(obj, namehint, &track->type);
+        if (track->rw == NULL) {
+            SDL_free(track);
+            return NULL;
+        }
+        track->state = PG_TRACK_OPENING;
+        if (!loader) {
+            loader = SDL_CreateThread(_loader_run, "pygame music loader",
+                                      NULL);
+            if (!loader) {
+                SDL_RWclose(track->rw);
+                SDL_free(track);
+                return RAISE(pgExc_SDLError, SDL_GetError());
+            }
+        }
+    }
 
-    Py_BEGIN_ALLOW_THREADS;
-    /* Free any existing queued music. */
-    if (queue_music != NULL) {
-        Mix_FreeMusic(queue_music);
+    SDL_LockMutex(queue_lock);
+    if (!append) {
+        detached = _detach_queue();
     }
-    Py_END_ALLOW_THREADS;
+    if (queue_tail) {
+        queue_tail->next = track;
+    }
+    else {
+        queue_head = track;
+    }
+    queue_tail = track;
+    ++queue_length;
+    if (track->state == PG_TRACK_OPENING) {
+        if (open_tail) {
+            open_tail->next_open = track;
+        }
+        else {
+            open_head = track;
+        }
+        open_tail = track;
+        SDL_CondSignal(queue_wake);
+    }
+    _queue_changed();
+    SDL_UnlockMutex(queue_lock);
 
-    queue_music = local_queue_music;
+    Py_BEGIN_ALLOW_THREADS;
+    /* Free any music queued before. */
+    _free_tracks(detached);
+    Py_END_ALLOW_THREADS;
 
     Py_RETURN_NONE;
 }
 
+static PyObject *
+music_get_queued(PyObject *self, PyObject *_null)
+{
+    int length = 0;
+
+    MIXER_INIT_CHECK();
+
+    if (queue_lock) {
+        SDL_LockMutex(queue_lock);
+        length = queue_length;
+        SDL_UnlockMutex(queue_lock);
+    }
+    return PyLong_FromLong(length);
+}
+
 static PyMethodDef _music_methods[] = {
     {"set_endevent", music_set_endevent, METH_VARARGS,
      DOC_PYGAMEMIXERMUSICSETENDEVENT},
@@ -522,6 +859,8 @@ static PyMethodDef _music_methods[] = {
     {"unload", music_unload, METH_NOARGS, DOC_PYGAMEMIXERMUSICUNLOAD},
     {"queue", (PyCFunction)music_queue, METH_VARARGS | METH_KEYWORDS,
      DOC_PYGAMEMIXERMUSICQUEUE},
+    {"get_queued", music_get_queued, METH_NOARGS,
+     DOC_PYGAMEMIXERMUSICGETQUEUED},
 
     {NULL, NULL, 0, NULL}};
 
@@ -568,9 +907,9 @@ MODINIT_DEFINE(mixer_music)
         Py_DECREF(module);
         return NULL;
     }
-    cobj =
-        PyCapsule_New(&queue_music, "pygame.music_mixer._QUEUE_POINTER", NULL);
-    if (PyModule_AddObject(module, "_QUEUE_POINTER", cobj)) {
+    cobj = PyCapsule_New((void *)_quit_queue,
+                         "pygame.music_mixer._QUEUE_QUIT", NULL);
+    if (PyModule_AddObject(module, "_QUEUE_QUIT", cobj)) {
         Py_XDECREF(cobj);
         Py_DECREF(module);
         return NULL;
@@ -0,0 +1,807 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+/*
+ *  pygame particles module
+ *
+ *  The particles of a ParticleSystem are kept as a structure of arrays, one
+ *  array of floats for each of x, y, x speed, y speed, life left and
+ *  starting life, and one of colours. The update loop has no branches, so
+ *  the compiler can vectorize it, and large systems are split between the
+ *  threads set with pygame.set_num_threads().
+ */
+
+#include "pygame.h"
+
+#include "pgcompat.h"
+
+#include "surface.h"
+
+#include "doc/particles_doc.h"
+
+/* Fewest particles worth splitting an update between threads */
+#define PG_PARTICLES_PARALLEL_MIN 32768
+
+typedef struct {
+    PyObject_HEAD Py_ssize_t capacity;
+    Py_ssize_t count;
+    float *x;
+    float *y;
+    float *vx;
+    float *vy;
+    float *life;
+    float *span;   /* the life each particle started with */
+    Uint32 *color; /* r | g << 8 | b << 16 | a << 24 */
+    float gravity[2];
+    float drag;
+    int size;
+    int fade;
+    int additive;
+    PyObject *image;
+    Uint32 seed; /* xorshift state for the spread of emitted particles */
+} pgParticleSystemObject;
+
+static PyTypeObject pgParticleSystem_Type;
+
+/* A float in [-1, 1) from the xorshift state of self */
+static float
+particles_random(pgParticleSystemObject *self)
+{
+    Uint32 r = self->seed;
+
+    r ^= r << 13;
+    r ^= r >> 17;
+    r ^= r << 5;
+    self->seed = r;
+    return (float)(r >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+/* The alpha a particle is drawn with */
+static Uint8
+particles_alpha(pgParticleSystemObject *self, Py_ssize_t i)
+{
+    Uint32 alpha = self->color[i] >> 24;
+
+    if (self->fade) {
+        float left = self->life[i] / self->span[i];
+
+        alpha = (Uint32)(alpha * (left < 1.0f ? left : 1.0f));
+    }
+    return (Uint8)alpha;
+}
+
+/* Move the last particle into slot i */
+static void
+particles_remove(pgParticleSystemObject *self, Py_ssize_t i)
+{
+    Py_ssize_t last = --self->count;
+
+    self->x[i] = self->x[last];
+    self->y[i] = self->y[last];
+    self->vx[i] = self->vx[last];
+    self->vy[i] = self->vy[last];
+    self->life[i] = self->life[last];
+    self->span[i] = self->span[last];
+    self->color[i] = self->color[last];
+}
+
+/********** integration **********/
+
+typedef struct {
+    pgParticleSystemObject *system;
+    float dt;
+} ParticlesStep;
+
+static void
+particles_step(pgParticleSystemObject *self, float dt, Py_ssize_t start,
+               Py_ssize_t end)
+{
+    float *x = self->x;
+    float *y = self->y;
+    float *vx = self->vx;
+    float *vy = self->vy;
+    float *life = self->life;
+    float gx = self->gravity[0] * dt;
+    float gy = self->gravity[1] * dt;
+    float damp = 1.0f - self->drag * dt;
+    Py_ssize_t i;
+
+    if (damp < 0.0f) {
+        damp = 0.0f;
+    }
+    for (i = start; i < end; i++) {
+        vx[i] = (vx[i] + gx) * damp;
+        vy[i] = (vy[i] + gy) * damp;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        life[i] -= dt;
+    }
+}
+
+static void
+particles_step_band(void *data, int band, int nbands)
+{
+    ParticlesStep *step = (ParticlesStep *)data;
+    Py_ssize_t count = step->system->count;
+
+    particles_step(step->system, step->dt, count * band / nbands,
+                   count * (band + 1) / nbands);
+}
+
+/********** drawing **********/
+
+/* Blend color with alpha into the pixel at p */
+static void
+particles_plot(Uint8 *p, SDL_PixelFormat *fmt, Uint32 color, Uint8 alpha,
+               int additive)
+{
+    Uint8 sR = color & 0xFF, sG = (color >> 8) & 0xFF;
+    Uint8 sB = (color >> 16) & 0xFF;
+    Uint8 dR, dG, dB, dA;
+    int dRi, dGi, dBi, dAi;
+    Uint32 pixel;
+
+    switch (fmt->BytesPerPixel) {
+        case 1:
+            pixel = *p;
+            break;
+        case 2:
+            pixel = *(Uint16 *)p;
+            break;
+        case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            pixel = p[0] | (p[1] << 8) | (p[2] << 16);
+#else
+            pixel = p[2] | (p[1] << 8) | (p[0] << 16);
+#endif
+            break;
+        default:
+            pixel = *(Uint32 *)p;
+            break;
+    }
+    SDL_GetRGBA(pixel, fmt, &dR, &dG, &dB, &dA);
+    dRi = dR;
+    dGi = dG;
+    dBi = dB;
+    dAi = dA;
+    if (additive) {
+        dRi += sR * alpha / 255;
+        dGi += sG * alpha / 255;
+        dBi += sB * alpha / 255;
+        dRi = dRi < 255 ? dRi : 255;
+        dGi = dGi < 255 ? dGi : 255;
+        dBi = dBi < 255 ? dBi : 255;
+    }
+    else {
+        if (!fmt->Amask) {
+            dAi = 255;
+        }
+        ALPHA_BLEND(sR, sG, sB, alpha, dRi, dGi, dBi, dAi);
+    }
+    pixel = SDL_MapRGBA(fmt, (Uint8)dRi, (Uint8)dGi, (Uint8)dBi, (Uint8)dAi);
+
+    switch (fmt->BytesPerPixel) {
+        case 1:
+            *p = (Uint8)pixel;
+            break;
+        case 2:
+            *(Uint16 *)p = (Uint16)pixel;
+            break;
+        case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            p[0] = pixel & 0xFF;
+            p[1] = (pixel >> 8) & 0xFF;
+            p[2] = (pixel >> 16) & 0xFF;
+#else
+            p[2] = pixel & 0xFF;
+            p[1] = (pixel >> 8) & 0xFF;
+            p[0] = (pixel >> 16) & 0xFF;
+#endif
+            break;
+        default:
+            *(Uint32 *)p = pixel;
+            break;
+    }
+}
+
+/* Draw each particle as a size by size square of its colour. Returns the
+   area drawn in, which is empty if nothing was drawn. */
+static SDL_Rect
+particles_draw_points(pgParticleSystemObject *self, SDL_Surface *surf,
+                      float ox, float oy)
+{
+    SDL_Rect clip = surf->clip_rect;
+    SDL_PixelFormat *fmt = surf->format;
+    int bpp = fmt->BytesPerPixel;
+    int size = self->size;
+    float half = size / 2.0f;
+    int minx = INT_MAX, miny = INT_MAX, maxx = INT_MIN, maxy = INT_MIN;
+    SDL_Rect area = {0, 0, 0, 0};
+    Py_ssize_t i;
+
+    for (i = 0; i < self->count; i++) {
+        Uint8 alpha = particles_alpha(self, i);
+        float fx = self->x[i] + ox - half;
+        float fy = self->y[i] + oy - half;
+        int left, top, right, bottom, px, py;
+
+        if (!alpha || fx >= clip.x + clip.w || fy >= clip.y + clip.h ||
+            fx + size <= clip.x || fy + size <= clip.y) {
+            continue;
+        }
+        left = (int)SDL_floorf(fx);
+        top = (int)SDL_floorf(fy);
+        right = left + size;
+        bottom = top + size;
+        left = left > clip.x ? left : clip.x;
+        top = top > clip.y ? top : clip.y;
+        right = right < clip.x + clip.w ? right : clip.x + clip.w;
+        bottom = bottom < clip.y + clip.h ? bottom : clip.y + clip.h;
+        if (left >= right || top >= bottom) {
+            continue;
+        }
+
+        for (py = top; py < bottom; py++) {
+            Uint8 *row = (Uint8 *)surf->pixels + py * surf->pitch;
+
+            for (px = left; px < right; px++) {
+                particles_plot(row + px * bpp, fmt, self->color[i], alpha,
+                               self->additive);
+            }
+        }
+        minx = left < minx ? left : minx;
+        miny = top < miny ? top : miny;
+        maxx = right > maxx ? right : maxx;
+        maxy = bottom > maxy ? bottom : maxy;
+    }
+    if (minx < maxx && miny < maxy) {
+        area.x = minx;
+        area.y = miny;
+        area.w = maxx - minx;
+        area.h = maxy - miny;
+    }
+    return area;
+}
+
+/* Blit the image centred on each particle. Fading sets the alpha of the
+   image for each blit, which additive blits do not use, and blends the
+   image while it does. Returns -1 with a Python exception set on
+   failure. */
+static int
+particles_draw_images(pgParticleSystemObject *self, pgSurfaceObject *dstobj,
+                      float ox, float oy)
+{
+    pgSurfaceObject *imgobj = (pgSurfaceObject *)self->image;
+    SDL_Surface *img = pgSurface_AsSurface(imgobj);
+    int flags = self->additive ? PYGAME_BLEND_ADD : 0;
+    int fade = self->fade && !self->additive;
+    Uint8 old_alpha = 255;
+    SDL_BlendMode old_mode = SDL_BLENDMODE_NONE;
+    Py_ssize_t i;
+
+    if (!img) {
+        PyErr_SetString(pgExc_SDLError, "display Surface quit");
+        return -1;
+    }
+    if (fade) {
+        SDL_GetSurfaceAlphaMod(img, &old_alpha);
+        SDL_GetSurfaceBlendMode(img, &old_mode);
+        SDL_SetSurfaceBlendMode(img, SDL_BLENDMODE_BLEND);
+    }
+    for (i = 0; i < self->count; i++) {
+        SDL_Rect dstrect;
+
+        if (fade) {
+            SDL_SetSurfaceAlphaMod(img, particles_alpha(self, i));
+        }
+        dstrect.x = (int)SDL_floorf(self->x[i] + ox - img->w / 2.0f);
+        dstrect.y = (int)SDL_floorf(self->y[i] + oy - img->h / 2.0f);
+        dstrect.w = img->w;
+        dstrect.h = img->h;
+        if (pgSurface_Blit(dstobj, imgobj, &dstrect, NULL, flags)) {
+            break;
+        }
+    }
+    if (fade) {
+        SDL_SetSurfaceAlphaMod(img, old_alpha);
+        SDL_SetSurfaceBlendMode(img, old_mode);
+    }
+    return i < self->count ? -1 : 0;
+}
+
+/********** ParticleSystem methods **********/
+
+static PyObject *
+particles_emit(pgParticleSystemObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *posobj, *velobj = NULL, *spreadobj = NULL, *colorobj = NULL;
+    int count = 1;
+    float life = 1.0f;
+    float px, py, vx = 0.0f, vy = 0.0f, sx = 0.0f, sy = 0.0f;
+    Uint8 rgba[4] = {255, 255, 255, 255};
+    Uint32 color;
+    Py_ssize_t i, n;
+    static char *keywords[] = {"pos",  "count", "velocity", "spread",
+                               "life", "color", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|iOOfO", keywords,
+                                     &posobj, &count, &velobj, &spreadobj,
+                                     &life, &colorobj)) {
+        return NULL;
+    }
+    if (!pg_TwoFloatsFromObj(posobj, &px, &py)) {
+        return RAISE(PyExc_TypeError, "invalid pos argument");
+    }
+    if (velobj && !pg_TwoFloatsFromObj(velobj, &vx, &vy)) {
+        return RAISE(PyExc_TypeError, "invalid velocity argument");
+    }
+    if (spreadobj && !pg_TwoFloatsFromObj(spreadobj, &sx, &sy)) {
+        return RAISE(PyExc_TypeError, "invalid spread argument");
+    }
+    if (colorobj && !pg_RGBAFromFuzzyColorObj(colorobj, rgba)) {
+        /* pg_RGBAFromFuzzyColorObj sets the exception for us */
+        return NULL;
+    }
+    if (count < 0) {
+        return RAISE(PyExc_ValueError, "count must not be negative");
+    }
+    if (!(life > 0.0f)) {
+        return RAISE(PyExc_ValueError, "life must be positive");
+    }
+
+    color = rgba[0] | (rgba[1] << 8) | (rgba[2] << 16) |
+            ((Uint32)rgba[3] << 24);
+    n = self->capacity - self->count;
+    if (count < n) {
+        n = count;
+    }
+    for (i = self->count; i < self->count + n; i++) {
+        self->x[i] = px;
+        self->y[i] = py;
+        self->vx[i] = vx + sx * particles_random(self);
+        self->vy[i] = vy + sy * particles_random(self);
+        self->life[i] = life;
+        self->span[i] = life;
+        self->color[i] = color;
+    }
+    self->count += n;
+    return PyLong_FromSsize_t(n);
+}
+
+static PyObject *
+particles_update(pgParticleSystemObject *self, PyObject *arg)
+{
+    float dt;
+    int nthreads = pg_GetNumThreads();
+    Py_ssize_t i;
+
+    if (!pg_FloatFromObj(arg, &dt)) {
+        return RAISE(PyExc_TypeError, "dt must be a number");
+    }
+
+    if (nthreads > 1 && self->count >= PG_PARTICLES_PARALLEL_MIN) {
+        ParticlesStep step;
+
+        step.system = self;
+        step.dt = dt;
+        pg_ParallelFor(particles_step_band, &step, nthreads);
+    }
+    else {
+        particles_step(self, dt, 0, self->count);
+    }
+
+    /* remove the particles that died, keeping the arrays packed */
+    i = 0;
+    while (i < self->count) {
+        if (self->life[i] <= 0.0f) {
+            particles_remove(self, i);
+        }
+        else {
+            i++;
+        }
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+particles_draw(pgParticleSystemObject *self, PyObject *args,
+               PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *offsetobj = NULL;
+    SDL_Surface *surf;
+    float ox = 0.0f, oy = 0.0f;
+    SDL_Rect area;
+    Uint64 stats_start;
+    static char *keywords[] = {"surface", "offset", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|O", keywords,
+                                     &pgSurface_Type, &surfobj, &offsetobj)) {
+        return NULL;
+    }
+    if (offsetobj && !pg_TwoFloatsFromObj(offsetobj, &ox, &oy)) {
+        return RAISE(PyExc_TypeError, "invalid offset argument");
+    }
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf) {
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    }
+
+    if (self->image) {
+        if (particles_draw_images(self, surfobj, ox, oy) < 0) {
+            return NULL;
+        }
+        Py_RETURN_NONE;
+    }
+    if (surf->format->BytesPerPixel <= 0 || surf->format->BytesPerPixel > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            surf->format->BytesPerPixel);
+    }
+
+    stats_start = pg_StatsBegin();
+    if (!pgSurface_Lock(surfobj)) {
+        return RAISE(PyExc_RuntimeError, "error locking surface");
+    }
+    area = particles_draw_points(self, surf, ox, oy);
+    if (!pgSurface_Unlock(surfobj)) {
+        return RAISE(PyExc_RuntimeError, "error unlocking surface");
+    }
+    pg_StatsEnd(PG_STAT_DRAW, "particles", stats_start,
+                (Sint64)area.w * area.h);
+    if (area.w) {
+        pgSurface_AddDamage(surfobj, &area);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+particles_clear(pgParticleSystemObject *self, PyObject *_null)
+{
+    self->count = 0;
+    Py_RETURN_NONE;
+}
+
+static Py_ssize_t
+particles_len(pgParticleSystemObject *self)
+{
+    return self->count;
+}
+
+/********** ParticleSystem attributes **********/
+
+static PyObject *
+particles_get_capacity(pgParticleSystemObject *self, void *closure)
+{
+    return PyLong_FromSsize_t(self->capacity);
+}
+
+static PyObject *
+particles_get_gravity(pgParticleSystemObject *self, void *closure)
+{
+    return Py_BuildValue("(ff)", self->gravity[0], self->gravity[1]);
+}
+
+static int
+particles_set_gravity(pgParticleSystemObject *self, PyObject *value,
+                      void *closure)
+{
+    DEL_ATTR_NOT_SUPPORTED_CHECK("gravity", value);
+    if (!pg_TwoFloatsFromObj(value, &self->gravity[0], &self->gravity[1])) {
+        PyErr_SetString(PyExc_TypeError, "gravity must be two numbers");
+        return -1;
+    }
+    return 0;
+}
+
+static PyObject *
+particles_get_drag(pgParticleSystemObject *self, void *closure)
+{
+    return PyFloat_FromDouble(self->drag);
+}
+
+static int
+particles_set_drag(pgParticleSystemObject *self, PyObject *value,
+                   void *closure)
+{
+    float drag;
+
+    DEL_ATTR_NOT_SUPPORTED_CHECK("drag", value);
+    if (!pg_FloatFromObj(value, &drag)) {
+        PyErr_SetString(PyExc_TypeError, "drag must be a number");
+        return -1;
+    }
+    if (drag < 0.0f) {
+        PyErr_SetString(PyExc_ValueError, "drag must not be negative");
+        return -1;
+    }
+    self->drag = drag;
+    return 0;
+}
+
+static PyObject *
+particles_get_size(pgParticleSystemObject *self, void *closure)
+{
+    return PyLong_FromLong(self->size);
+}
+
+static int
+particles_set_size(pgParticleSystemObject *self, PyObject *value,
+                   void *closure)
+{
+    int size;
+
+    DEL_ATTR_NOT_SUPPORTED_CHECK("size", value);
+    if (!pg_IntFromObj(value, &size)) {
+        PyErr_SetString(PyExc_TypeError, "size must be an integer");
+        return -1;
+    }
+    if (size < 1) {
+        PyErr_SetString(PyExc_ValueError, "size must be positive");
+        return -1;
+    }
+    self->size = size;
+    return 0;
+}
+
+static PyObject *
+particles_get_image(pgParticleSystemObject *self, void *closure)
+{
+    PyObject *image = self->image ? self->image : Py_None;
+
+    Py_INCREF(image);
+    return image;
+}
+
+static int
+particles_set_image(pgParticleSystemObject *self, PyObject *value,
+                    void *closure)
+{
+    DEL_ATTR_NOT_SUPPORTED_CHECK("image", value);
+    if (value != Py_None && !pgSurface_Check(value)) {
+        PyErr_SetString(PyExc_TypeError, "image must be a Surface or None");
+        return -1;
+    }
+    Py_XDECREF(self->image);
+    self->image = NULL;
+    if (value != Py_None) {
+        Py_INCREF(value);
+        self->image = value;
+    }
+    return 0;
+}
+
+static PyObject *
+particles_get_flag(pgParticleSystemObject *self, void *closure)
+{
+    int *flag = (int *)((char *)self + (Py_ssize_t)closure);
+
+    return PyBool_FromLong(*flag);
+}
+
+static int
+particles_set_flag(pgParticleSystemObject *self, PyObject *value,
+                   void *closure)
+{
+    int *flag = (int *)((char *)self + (Py_ssize_t)closure);
+    int truth;
+
+    DEL_ATTR_NOT_SUPPORTED_CHECK_NO_NAME(value);
+    truth = PyObject_IsTrue(value);
+    if (truth < 0) {
+        return -1;
+    }
+    *flag = truth;
+    return 0;
+}
+
+/********** ParticleSystem type **********/
+
+static int
+particles_init(pgParticleSystemObject *self, PyObject *args,
+               PyObject *kwargs)
+{
+    Py_ssize_t capacity;
+    PyObject *gravityobj = NULL, *imageobj = Py_None, *seedobj = Py_None;
+    float drag = 0.0f;
+    int size = 1, fade = 1, additive = 0;
+    float *floats;
+    static char *keywords[] = {"capacity", "gravity",  "drag", "image",
+                               "size",     "additive", "fade", "seed",
+                               NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "n|OfOippO", keywords,
+                                     &capacity, &gravityobj, &drag,
+                                     &imageobj, &size, &additive, &fade,
+                                     &seedobj)) {
+        return -1;
+    }
+    if (capacity < 0 || capacity > PY_SSIZE_T_MAX / (Py_ssize_t)(
+                                        6 * sizeof(float) + sizeof(Uint32))) {
+        PyErr_SetString(PyExc_ValueError, "invalid capacity");
+        return -1;
+    }
+
+    PyMem_Free(self->x);
+    PyMem_Free(self->color);
+    self->x = NULL;
+    self->color = NULL;
+    self->count = 0;
+    self->capacity = 0;
+
+    self->gravity[0] = self->gravity[1] = 0.0f;
+    if (gravityobj && particles_set_gravity(self, gravityobj, NULL) < 0) {
+        return -1;
+    }
+    if (drag < 0.0f) {
+        PyErr_SetString(PyExc_ValueError, "drag must not be negative");
+        return -1;
+    }
+    if (size < 1) {
+        PyErr_SetString(PyExc_ValueError, "size must be positive");
+        return -1;
+    }
+    if (particles_set_image(self, imageobj, NULL) < 0) {
+        return -1;
+    }
+    self->drag = drag;
+    self->size = size;
+    self->fade = fade;
+    self->additive = additive;
+
+    if (seedobj == Py_None) {
+        self->seed = (Uint32)SDL_GetPerformanceCounter();
+    }
+    else {
+        self->seed = (Uint32)PyLong_AsUnsignedLongMask(seedobj);
+        if (PyErr_Occurred()) {
+            return -1;
+        }
+    }
+    if (!self->seed) {
+        /* zero is a fixed point of xorshift */
+        self->seed = 0x9E3779B9;
+    }
+
+    /* one block for the six float arrays, so they sit side by side */
+    floats = PyMem_Malloc(capacity ? 6 * capacity * sizeof(float) : 1);
+    self->color = PyMem_Malloc(capacity ? capacity * sizeof(Uint32) : 1);
+    if (!floats || !self->color) {
+        PyMem_Free(floats);
+        PyMem_Free(self->color);
+        self->color = NULL;
+        PyErr_NoMemory();
+        return -1;
+    }
+    self->x = floats;
+    self->y = floats + capacity;
+    self->vx = floats + 2 * capacity;
+    self->vy = floats + 3 * capacity;
+    self->life = floats + 4 * capacity;
+    self->span = floats + 5 * capacity;
+    self->capacity = capacity;
+    return 0;
+}
+
+static void
+particles_dealloc(pgParticleSystemObject *self)
+{
+    PyMem_Free(self->x);
+    PyMem_Free(self->color);
+    Py_XDECREF(self->image);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+particles_repr(pgParticleSystemObject *self)
+{
+    return PyUnicode_FromFormat("<ParticleSystem(%zd of %zd particles)>",
+                                self->count, self->capacity);
+}
+
+static PyMethodDef particles_methods[] = {
+    {"emit", (PyCFunction)particles_emit, METH_VARARGS | METH_KEYWORDS,
+     DOC_PARTICLESYSTEMEMIT},
+    {"update", (PyCFunction)particles_update, METH_O,
+     DOC_PARTICLESYSTEMUPDATE},
+    {"draw", (PyCFunction)particles_draw, METH_VARARGS | METH_KEYWORDS,
+     DOC_PARTICLESYSTEMDRAW},
+    {"clear", (PyCFunction)particles_clear, METH_NOARGS,
+     DOC_PARTICLESYSTEMCLEAR},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef particles_getsets[] = {
+    {"capacity", (getter)particles_get_capacity, NULL,
+     DOC_PARTICLESYSTEMCAPACITY, NULL},
+    {"gravity", (getter)particles_get_gravity, (setter)particles_set_gravity,
+     DOC_PARTICLESYSTEMGRAVITY, NULL},
+    {"drag", (getter)particles_get_drag, (setter)particles_set_drag,
+     DOC_PARTICLESYSTEMDRAG, NULL},
+    {"size", (getter)particles_get_size, (setter)particles_set_size,
+     DOC_PARTICLESYSTEMSIZE, NULL},
+    {"image", (getter)particles_get_image, (setter)particles_set_image,
+     DOC_PARTICLESYSTEMIMAGE, NULL},
+    {"additive", (getter)particles_get_flag, (setter)particles_set_flag,
+     DOC_PARTICLESYSTEMADDITIVE,
+     (void *)offsetof(pgParticleSystemObject, additive)},
+    {"fade", (getter)particles_get_flag, (setter)particles_set_flag,
+     DOC_PARTICLESYSTEMFADE, (void *)offsetof(pgParticleSystemObject, fade)},
+    {NULL, NULL, NULL, NULL, NULL}};
+
+static PySequenceMethods particles_as_sequence = {
+    .sq_length = (lenfunc)particles_len,
+};
+
+static PyTypeObject pgParticleSystem_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.particles.ParticleSystem",
+    .tp_basicsize = sizeof(pgParticleSystemObject),
+    .tp_dealloc = (destructor)particles_dealloc,
+    .tp_repr = (reprfunc)particles_repr,
+    .tp_as_sequence = &particles_as_sequence,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_PYGAMEPARTICLESPARTICLESYSTEM,
+    .tp_methods = particles_methods,
+    .tp_getset = particles_getsets,
+    .tp_init = (initproc)particles_init,
+    .tp_new = PyType_GenericNew,
+};
+
+MODINIT_DEFINE(particles)
+{
+    PyObject *module;
+    static struct PyModuleDef _module = {
+        .m_base = PyModuleDef_HEAD_INIT,
+        .m_name = "particles",
+        .m_doc = DOC_PYGAMEPARTICLES,
+        .m_size = -1,
+    };
+
+    /* imported needed apis; Do this first so if there is an error
+       the module is not loaded.
+    */
+    import_pygame_base();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+    import_pygame_color();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+    import_pygame_surface();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
+    if (PyType_Ready(&pgParticleSystem_Type) < 0) {
+        return NULL;
+    }
+
+    module = PyModule_Create(&_module);
+    if (!module) {
+        return NULL;
+    }
+    Py_INCREF(&pgParticleSystem_Type);
+    if (PyModule_AddObject(module, "ParticleSystem",
+                           (PyObject *)&pgParticleSystem_Type)) {
+        Py_DECREF(&pgParticleSystem_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+    return module;
+}
@@ -0,0 +1,87 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/* Free lists of deallocated objects, kept for reuse by the next object of
+ * the same type, as CPython does for floats and tuples. This saves the
+ * allocator calls for the many short lived Rect, Vector2 and Color objects
+ * of expressions like rect.move(v).center.
+ *
+ * Only objects of the exact type are kept, as subclass instances may be of
+ * another size. The types must not be garbage collected, since a kept
+ * object is brought back with PyObject_Init(), which only sets the type and
+ * the reference count. Everything else is left as it was when the object
+ * was deallocated. Nothing is kept on PyPy, where cpyext objects cannot be
+ * brought back this way.
+ */
+#ifndef PGFREELIST_H
+#define PGFREELIST_H
+
+#define PG_FREELIST_MAX 256
+
+typedef struct {
+    PyObject *items[PG_FREELIST_MAX];
+    int num;
+    /* the allocations served from the list, and the ones that were not */
+    unsigned long hits, misses;
+} pgFreeList;
+
+/* Returns a kept object initialized as a new one of type, or NULL if the
+ * list is empty.
+ */
+static PyObject *
+pgFreeList_Pop(pgFreeList *list, PyTypeObject *type)
+{
+#ifdef PYPY_VERSION
+    list->misses++;
+    return NULL;
+#else
+    if (list->num == 0) {
+        list->misses++;
+        return NULL;
+    }
+    list->hits++;
+    return PyObject_Init(list->items[--list->num], type);
+#endif
+}
+
+/* Keeps op, which is being deallocated, for reuse. Returns 0 if the list
+ * is full, leaving op to be freed.
+ */
+static int
+pgFreeList_Push(pgFreeList *list, PyObject *op)
+{
+#ifdef PYPY_VERSION
+    return 0;
+#else
+    if (list->num == PG_FREELIST_MAX) {
+        return 0;
+    }
+    list->items[list->num++] = op;
+    return 1;
+#endif
+}
+
+/* Returns {"hits": ..., "misses": ..., "free": ...} for list. */
+static PyObject *
+pgFreeList_Stats(pgFreeList *list)
+{
+    return Py_BuildValue("{sksksi}", "hits", list->hits, "misses",
+                         list->misses, "free", list->num);
+}
+
+#endif /* ~PGFREELIST_H */
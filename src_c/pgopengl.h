@@ -5,6 +5,8 @@
  ** use with the SDL function SDL_GL_GetProcAddress.
  **/
 
+#include <stddef.h>
+
 #if defined(_WIN32)
 #define GL_APIENTRY __stdcall
 #else
@@ -17,4 +19,40 @@ typedef void(GL_APIENTRY *GL_glReadPixels_Func)(int, int, int, int,
 
 typedef void(GL_APIENTRY *GL_glViewport_Func)(int, int, unsigned int,
                                               unsigned int);
+
+typedef void(GL_APIENTRY *GL_glTexImage2D_Func)(unsigned int, int, int, int,
+                                                int, int, unsigned int,
+                                                unsigned int, const void *);
+
+typedef void(GL_APIENTRY *GL_glTexSubImage2D_Func)(unsigned int, int, int,
+                                                   int, int, int,
+                                                   unsigned int, unsigned int,
+                                                   const void *);
+
+typedef void(GL_APIENTRY *GL_glPixelStorei_Func)(unsigned int, int);
+
+typedef void(GL_APIENTRY *GL_glGetIntegerv_Func)(unsigned int, int *);
+
+typedef void(GL_APIENTRY *GL_glBindBuffer_Func)(unsigned int, unsigned int);
+
+typedef void(GL_APIENTRY *GL_glBufferData_Func)(unsigned int, ptrdiff_t,
+                                                const void *, unsigned int);
+
+/* The few OpenGL enums pygame passes */
+#define PG_GL_TEXTURE_2D 0x0DE1
+#define PG_GL_UNPACK_ROW_LENGTH 0x0CF2
+#define PG_GL_UNPACK_ALIGNMENT 0x0CF5
+#define PG_GL_UNSIGNED_BYTE 0x1401
+#define PG_GL_RGB 0x1907
+#define PG_GL_RGBA 0x1908
+#define PG_GL_BGR 0x80E0
+#define PG_GL_BGRA 0x80E1
+#define PG_GL_RGB8 0x8051
+#define PG_GL_RGBA8 0x8058
+#define PG_GL_UNSIGNED_INT_8_8_8_8 0x8035
+#define PG_GL_UNSIGNED_INT_8_8_8_8_REV 0x8367
+#define PG_GL_UNSIGNED_SHORT_5_6_5 0x8363
+#define PG_GL_PIXEL_UNPACK_BUFFER 0x88EC
+#define PG_GL_PIXEL_UNPACK_BUFFER_BINDING 0x88EF
+#define PG_GL_STREAM_DRAW 0x88E0
 #endif
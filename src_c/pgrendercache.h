@@ -0,0 +1,177 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/* A cache of rendered text, kept by the font and freetype modules for
+ * fonts with a render_cache_limit. The results of render() are kept in a
+ * dict under a key made of everything the rendering depends on, so a font
+ * attribute that changes the rendering also changes the key. Python dicts
+ * keep their insertion order, so a hit is moved to the end by deleting and
+ * adding it again, and the first entry is the least recently used one,
+ * evicted first when the pixels kept go over the limit.
+ */
+#ifndef PGRENDERCACHE_H
+#define PGRENDERCACHE_H
+
+typedef struct pgRenderCache_ {
+    /* key -> (result, bytes), least recently used first */
+    PyObject *entries;
+    size_t max_bytes;
+    size_t bytes;
+    unsigned long hits, misses, evictions;
+} pgRenderCache;
+
+/* Returns 0 when the cache is empty */
+static int
+pgRenderCache_EvictOldest(pgRenderCache *cache)
+{
+    Py_ssize_t pos = 0;
+    PyObject *key, *value;
+
+    if (!PyDict_Next(cache->entries, &pos, &key, &value)) {
+        cache->bytes = 0;
+        return 0;
+    }
+    cache->bytes -= (size_t)PyLong_AsSsize_t(PyTuple_GET_ITEM(value, 1));
+    Py_INCREF(key);
+    if (PyDict_DelItem(cache->entries, key)) {
+        /* a key that was hashed once hashes again, so this is unlikely */
+        PyErr_Clear();
+        PyDict_Clear(cache->entries);
+        cache->bytes = 0;
+    }
+    Py_DECREF(key);
+    cache->evictions++;
+    return 1;
+}
+
+/* Sets the byte limit of the cache at *cachep, making the cache for a
+ * limit above 0 and freeing it for 0. Returns -1 with an exception set on
+ * failure.
+ */
+static int
+pgRenderCache_SetLimit(pgRenderCache **cachep, size_t max_bytes)
+{
+    pgRenderCache *cache = *cachep;
+
+    if (!max_bytes) {
+        if (cache) {
+            Py_DECREF(cache->entries);
+            PyMem_Free(cache);
+            *cachep = NULL;
+        }
+        return 0;
+    }
+    if (!cache) {
+        cache = PyMem_Malloc(sizeof(pgRenderCache));
+        if (!cache) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        cache->entries = PyDict_New();
+        if (!cache->entries) {
+            PyMem_Free(cache);
+            return -1;
+        }
+        cache->bytes = 0;
+        cache->hits = cache->misses = cache->evictions = 0;
+        *cachep = cache;
+    }
+    cache->max_bytes = max_bytes;
+    while (cache->bytes > max_bytes && pgRenderCache_EvictOldest(cache)) {
+    }
+    return 0;
+}
+
+/* Returns a new reference to the result kept under key, or NULL if there
+ * is none. NULL is also returned, with an exception set, on failure.
+ */
+static PyObject *
+pgRenderCache_Get(pgRenderCache *cache, PyObject *key)
+{
+    PyObject *value = PyDict_GetItemWithError(cache->entries, key);
+    PyObject *result;
+
+    if (!value) {
+        if (!PyErr_Occurred()) {
+            cache->misses++;
+        }
+        return NULL;
+    }
+
+    /* move it to the most recently used end */
+    Py_INCREF(value);
+    if (PyDict_DelItem(cache->entries, key) ||
+        PyDict_SetItem(cache->entries, key, value)) {
+        PyErr_Clear();
+        if (PyDict_DelItem(cache->entries, key)) {
+            PyErr_Clear();
+        }
+        cache->bytes -= (size_t)PyLong_AsSsize_t(PyTuple_GET_ITEM(value, 1));
+    }
+    result = PyTuple_GET_ITEM(value, 0);
+    Py_INCREF(result);
+    Py_DECREF(value);
+    cache->hits++;
+    return result;
+}
+
+/* Keeps result, using nbytes of pixels, under key, evicting the least
+ * recently used results to stay within the limit. A result larger than the
+ * limit is not kept. Returns -1 with an exception set on failure.
+ */
+static int
+pgRenderCache_Put(pgRenderCache *cache, PyObject *key, PyObject *result,
+                  size_t nbytes)
+{
+    PyObject *value;
+
+    if (nbytes > cache->max_bytes) {
+        return 0;
+    }
+    value = Py_BuildValue("(On)", result, (Py_ssize_t)nbytes);
+    if (!value) {
+        return -1;
+    }
+    while (cache->bytes + nbytes > cache->max_bytes &&
+           pgRenderCache_EvictOldest(cache)) {
+    }
+    if (PyDict_SetItem(cache->entries, key, value)) {
+        Py_DECREF(value);
+        return -1;
+    }
+    Py_DECREF(value);
+    cache->bytes += nbytes;
+    return 0;
+}
+
+/* Returns the counters of the cache, which may be NULL, as a new dict */
+static PyObject *
+pgRenderCache_Stats(pgRenderCache *cache)
+{
+    if (!cache) {
+        return Py_BuildValue("{sksksksnsn}", "hits", 0UL, "misses", 0UL,
+                             "evictions", 0UL, "surfaces", (Py_ssize_t)0,
+                             "bytes", (Py_ssize_t)0);
+    }
+    return Py_BuildValue("{sksksksnsn}", "hits", cache->hits, "misses",
+                         cache->misses, "evictions", cache->evictions,
+                         "surfaces", PyDict_Size(cache->entries), "bytes",
+                         (Py_ssize_t)cache->bytes);
+}
+
+#endif /* ~PGRENDERCACHE_H */
@@ -27,6 +27,22 @@
 #include "doc/pixelarray_doc.h"
 
 #include "surface.h"
+
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+// arm64 has neon optimisations enabled by default, even when fpu=neon is not
+// passed
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+#if defined(PG_ENABLE_ARM_NEON)
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "include/sse2neon.h"
+#define PG_PIXELARRAY_SIMD
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define PG_PIXELARRAY_SIMD
+#endif
+
 #if !defined(BUILD_STATIC)
 static char FormatUint8[] = "B";
 static char FormatUint16[] = "=H";
@@ -892,6 +908,97 @@ _pxarray_item(pgPixelArrayObject *array, Py_ssize_t index)
                                        1);
 }
 
+/* Fills the n pixels of bpp bytes each at dst with the bytes of pixel.
+ * The first pixel is written, then the filled part is copied onto the
+ * rest, doubling each time, unless a SIMD store loop can do it directly.
+ */
+static void
+_fill_run(Uint8 *dst, Py_ssize_t n, const Uint8 *pixel, int bpp)
+{
+    size_t size = (size_t)n * bpp;
+    size_t done = 0;
+    size_t chunk;
+
+    if (!n) {
+        return;
+    }
+    if (bpp == 1) {
+        memset(dst, *pixel, size);
+        return;
+    }
+#ifdef PG_PIXELARRAY_SIMD
+    if (bpp != 3 && size >= 16) {
+        Uint32 word;
+        __m128i v;
+
+        if (bpp == 2) {
+            Uint16 half;
+
+            memcpy(&half, pixel, 2);
+            word = half | ((Uint32)half << 16);
+        }
+        else {
+            memcpy(&word, pixel, 4);
+        }
+        v = _mm_set1_epi32((int)word);
+        for (; done + 16 <= size; done += 16) {
+            _mm_storeu_si128((__m128i *)(dst + done), v);
+        }
+        /* 16 is a whole number of pixels, so dst starts the pattern */
+        memcpy(dst + done, dst, size - done);
+        return;
+    }
+#endif
+    memcpy(dst, pixel, bpp);
+    done = bpp;
+    while (done < size) {
+        chunk = done < size - done ? done : size - done;
+        memcpy(dst + done, dst, chunk);
+        done += chunk;
+    }
+}
+
+/* The bytes of color as the assignments below store it */
+static void
+_get_pixel_bytes(Uint8 *pixel, Uint32 color, SDL_PixelFormat *format)
+{
+    switch (format->BytesPerPixel) {
+        case 1:
+            pixel[0] = (Uint8)color;
+            break;
+        case 2: {
+            Uint16 c = (Uint16)color;
+
+            memcpy(pixel, &c, 2);
+        } break;
+        case 3:
+#if (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+            pixel[format->Rshift >> 3] = (Uint8)(color >> 16);
+            pixel[format->Gshift >> 3] = (Uint8)(color >> 8);
+            pixel[format->Bshift >> 3] = (Uint8)color;
+#else
+            pixel[2 - (format->Rshift >> 3)] = (Uint8)(color >> 16);
+            pixel[2 - (format->Gshift >> 3)] = (Uint8)(color >> 8);
+            pixel[2 - (format->Bshift >> 3)] = (Uint8)color;
+#endif
+            break;
+        default: /* case 4: */
+            memcpy(pixel, &color, 4);
+            break;
+    }
+}
+
+/* Whether the assignments below write every byte of a pixel: 24 bit
+ * pixels are written channel by channel. */
+#define WRITES_WHOLE_PIXELS(f)                                   \
+    ((f)->BytesPerPixel != 3 || ((1 << ((f)->Rshift >> 3)) |     \
+                                 (1 << ((f)->Gshift >> 3)) |     \
+                                 (1 << ((f)->Bshift >> 3))) == 7)
+
+/* The lowest address of a row of n pixels stride bytes apart */
+#define ROW_START(row, n, stride) \
+    ((stride) < 0 ? (row) + ((n)-1) * (stride) : (row))
+
 static int
 _array_assign_array(pgPixelArrayObject *array, Py_ssize_t low, Py_ssize_t high,
                     pgPixelArrayObject *val)
@@ -918,6 +1025,7 @@ _array_assign_array(pgPixelArrayObject *array, Py_ssize_t low, Py_ssize_t high,
     Py_ssize_t x;
     Py_ssize_t y;
     int sizes_match = 0;
+    int same_layout;
 
     if (array->surface == NULL) {
         PyErr_SetString(PyExc_ValueError, "Operation on closed PixelArray.");
@@ -983,76 +1091,103 @@ _array_assign_array(pgPixelArrayObject *array, Py_ssize_t low, Py_ssize_t high,
     pixelrow = pixels;
     val_pixelrow = val_pixels;
 
-    switch (bpp) {
-        case 1:
-            for (y = 0; y < dim1; ++y) {
-                pixel_p = pixelrow;
-                val_pixel_p = val_pixelrow;
-                for (x = 0; x < dim0; ++x) {
-                    *pixel_p = *val_pixel_p;
-                    pixel_p += stride0;
-                    val_pixel_p += val_stride0;
-                }
-                pixelrow += stride1;
-                val_pixelrow += val_stride1;
+    /* 24 bit pixels are copied channel by channel, so their layouts have
+     * to agree for a plain copy */
+    same_layout = bpp != 3 ||
+                  (surf->format->Rshift == val_surf->format->Rshift &&
+                   surf->format->Gshift == val_surf->format->Gshift &&
+                   surf->format->Bshift == val_surf->format->Bshift);
+
+    if (same_layout && WRITES_WHOLE_PIXELS(surf->format) && dim0 &&
+        ABS(stride0) == bpp &&
+        (val_stride0 == stride0 || !val_stride0)) {
+        /* Whole rows are runs of pixels in the same order: copy them, or
+         * fill them with the one broadcast pixel. */
+        for (y = 0; y < dim1; ++y) {
+            pixel_p = ROW_START(pixelrow, dim0, stride0);
+            if (val_stride0) {
+                memcpy(pixel_p, ROW_START(val_pixelrow, dim0, val_stride0),
+                       (size_t)dim0 * bpp);
             }
-            break;
-        case 2:
-            for (y = 0; y < dim1; ++y) {
-                pixel_p = pixelrow;
-                val_pixel_p = val_pixelrow;
-                for (x = 0; x < dim0; ++x) {
-                    *((Uint16 *)pixel_p) = *((Uint16 *)val_pixel_p);
-                    pixel_p += stride0;
-                    val_pixel_p += val_stride0;
-                }
-                pixelrow += stride1;
-                val_pixelrow += val_stride1;
+            else {
+                _fill_run(pixel_p, dim0, val_pixelrow, bpp);
             }
-            break;
-        case 3: {
+            pixelrow += stride1;
+            val_pixelrow += val_stride1;
+        }
+    }
+    else {
+        switch (bpp) {
+            case 1:
+                for (y = 0; y < dim1; ++y) {
+                    pixel_p = pixelrow;
+                    val_pixel_p = val_pixelrow;
+                    for (x = 0; x < dim0; ++x) {
+                        *pixel_p = *val_pixel_p;
+                        pixel_p += stride0;
+                        val_pixel_p += val_stride0;
+                    }
+                    pixelrow += stride1;
+                    val_pixelrow += val_stride1;
+                }
+                break;
+            case 2:
+                for (y = 0; y < dim1; ++y) {
+                    pixel_p = pixelrow;
+                    val_pixel_p = val_pixelrow;
+                    for (x = 0; x < dim0; ++x) {
+                        *((Uint16 *)pixel_p) = *((Uint16 *)val_pixel_p);
+                        pixel_p += stride0;
+                        val_pixel_p += val_stride0;
+                    }
+                    pixelrow += stride1;
+                    val_pixelrow += val_stride1;
+                }
+                break;
+            case 3: {
 #if (SDL_BYTEORDER == SDL_LIL_ENDIAN)
-            Uint32 Roffset = surf->format->Rshift >> 3;
-            Uint32 Goffset = surf->format->Gshift >> 3;
-            Uint32 Boffset = surf->format->Bshift >> 3;
-            Uint32 vRoffset = val_surf->format->Rshift >> 3;
-            Uint32 vGoffset = val_surf->format->Gshift >> 3;
-            Uint32 vBoffset = val_surf->format->Bshift >> 3;
+                Uint32 Roffset = surf->format->Rshift >> 3;
+                Uint32 Goffset = surf->format->Gshift >> 3;
+                Uint32 Boffset = surf->format->Bshift >> 3;
+                Uint32 vRoffset = val_surf->format->Rshift >> 3;
+                Uint32 vGoffset = val_surf->format->Gshift >> 3;
+                Uint32 vBoffset = val_surf->format->Bshift >> 3;
 #else
-            Uint32 Roffset = 2 - (surf->format->Rshift >> 3);
-            Uint32 Goffset = 2 - (surf->format->Gshift >> 3);
-            Uint32 Boffset = 2 - (surf->format->Bshift >> 3);
-            Uint32 vRoffset = 2 - (val_surf->format->Rshift >> 3);
-            Uint32 vGoffset = 2 - (val_surf->format->Gshift >> 3);
-            Uint32 vBoffset = 2 - (val_surf->format->Bshift >> 3);
+                Uint32 Roffset = 2 - (surf->format->Rshift >> 3);
+                Uint32 Goffset = 2 - (surf->format->Gshift >> 3);
+                Uint32 Boffset = 2 - (surf->format->Bshift >> 3);
+                Uint32 vRoffset = 2 - (val_surf->format->Rshift >> 3);
+                Uint32 vGoffset = 2 - (val_surf->format->Gshift >> 3);
+                Uint32 vBoffset = 2 - (val_surf->format->Bshift >> 3);
 #endif
-            for (y = 0; y < dim1; ++y) {
-                pixel_p = pixelrow;
-                val_pixel_p = val_pixelrow;
-                for (x = 0; x < dim0; ++x) {
-                    pixel_p[Roffset] = val_pixel_p[vRoffset];
-                    pixel_p[Goffset] = val_pixel_p[vGoffset];
-                    pixel_p[Boffset] = val_pixel_p[vBoffset];
-                    pixel_p += stride0;
-                    val_pixel_p += val_stride0;
+                for (y = 0; y < dim1; ++y) {
+                    pixel_p = pixelrow;
+                    val_pixel_p = val_pixelrow;
+                    for (x = 0; x < dim0; ++x) {
+                        pixel_p[Roffset] = val_pixel_p[vRoffset];
+                        pixel_p[Goffset] = val_pixel_p[vGoffset];
+                        pixel_p[Boffset] = val_pixel_p[vBoffset];
+                        pixel_p += stride0;
+                        val_pixel_p += val_stride0;
+                    }
+                    pixelrow += stride1;
+                    val_pixelrow += val_stride1;
                 }
-                pixelrow += stride1;
-                val_pixelrow += val_stride1;
-            }
-        } break;
-        default: /* case 4: */
-            for (y = 0; y < dim1; ++y) {
-                pixel_p = pixelrow;
-                val_pixel_p = val_pixelrow;
-                for (x = 0; x < dim0; ++x) {
-                    *((Uint32 *)pixel_p) = *((Uint32 *)val_pixel_p);
-                    pixel_p += stride0;
-                    val_pixel_p += val_stride0;
+            } break;
+            default: /* case 4: */
+                for (y = 0; y < dim1; ++y) {
+                    pixel_p = pixelrow;
+                    val_pixel_p = val_pixelrow;
+                    for (x = 0; x < dim0; ++x) {
+                        *((Uint32 *)pixel_p) = *((Uint32 *)val_pixel_p);
+                        pixel_p += stride0;
+                        val_pixel_p += val_stride0;
+                    }
+                    pixelrow += stride1;
+                    val_pixelrow += val_stride1;
                 }
-                pixelrow += stride1;
-                val_pixelrow += val_stride1;
-            }
-            break;
+                break;
+        }
     }
 
     if (copied_pixels) {
@@ -1080,6 +1215,9 @@ _array_assign_sequence(pgPixelArrayObject *array, Py_ssize_t low,
     Uint32 *val_color_p;
     Py_ssize_t x;
     Py_ssize_t y;
+    Py_ssize_t rows = 0;
+    PyObject *seq;
+    PyObject **items;
     PyObject *item;
 
     if (val_dim0 != dim0) {
@@ -1100,19 +1238,42 @@ _array_assign_sequence(pgPixelArrayObject *array, Py_ssize_t low,
         PyErr_NoMemory();
         return -1;
     }
+    /* The tuple holds on to the items, so an item that is the same object
+     * as the one before it is the same color. */
+    seq = PySequence_Tuple(val);
+    if (!seq) {
+        free(val_colors);
+        return -1;
+    }
+    if (PyTuple_GET_SIZE(seq) != val_dim0) {
+        PyErr_SetString(PyExc_ValueError, "sequence size mismatch");
+        Py_DECREF(seq);
+        free(val_colors);
+        return -1;
+    }
+    items = &PyTuple_GET_ITEM(seq, 0);
     for (x = 0; x < val_dim0; ++x) {
-        item = PySequence_ITEM(val, x);
-        if (!_get_color_from_object(item, format, (val_colors + x))) {
-            Py_DECREF(item);
+        item = items[x];
+        if (x && item == items[x - 1]) {
+            val_colors[x] = val_colors[x - 1];
+        }
+        else if (!_get_color_from_object(item, format, (val_colors + x))) {
+            Py_DECREF(seq);
             free(val_colors);
             return -1;
         }
-        Py_DECREF(item);
     }
+    Py_DECREF(seq);
 
     pixelrow = pixels;
 
     Py_BEGIN_ALLOW_THREADS;
+    /* Every row gets the same pixels, so when rows are runs of pixels only
+     * the first is converted and the rest are copies of it. */
+    if (WRITES_WHOLE_PIXELS(format) && dim0 && ABS(stride0) == bpp) {
+        rows = dim1;
+        dim1 = 1;
+    }
     switch (bpp) {
         case 1:
             for (y = 0; y < dim1; ++y) {
@@ -1174,6 +1335,11 @@ _array_assign_sequence(pgPixelArrayObject *array, Py_ssize_t low,
             }
             break;
     }
+    for (y = 1; y < rows; ++y) {
+        memcpy(ROW_START(pixelrow, dim0, stride0),
+               ROW_START(pixels, dim0, stride0), (size_t)dim0 * bpp);
+        pixelrow += stride1;
+    }
     Py_END_ALLOW_THREADS;
 
     free(val_colors);
@@ -1204,66 +1370,83 @@ _array_assign_slice(pgPixelArrayObject *array, Py_ssize_t low, Py_ssize_t high,
     pixelrow = pixels;
 
     Py_BEGIN_ALLOW_THREADS;
-    switch (bpp) {
-        case 1: {
-            Uint8 c = (Uint8)color;
-
-            for (y = 0; y < dim1; ++y) {
-                pixel_p = pixelrow;
-                for (x = 0; x < dim0; ++x) {
-                    *pixel_p = c;
-                    pixel_p += stride0;
+    if (WRITES_WHOLE_PIXELS(surf->format) && dim0 && ABS(stride0) == bpp) {
+        /* Rows are runs of pixels, and when the rows follow each other
+         * without gaps the whole block is one run. */
+        Uint8 pixel[4];
+
+        _get_pixel_bytes(pixel, color, surf->format);
+        if (stride0 > 0 && stride1 == dim0 * bpp) {
+            dim0 *= dim1;
+            dim1 = 1;
+        }
+        for (y = 0; y < dim1; ++y) {
+            _fill_run(ROW_START(pixelrow, dim0, stride0), dim0, pixel, bpp);
+            pixelrow += stride1;
+        }
+    }
+    else {
+        switch (bpp) {
+            case 1: {
+                Uint8 c = (Uint8)color;
+
+                for (y = 0; y < dim1; ++y) {
+                    pixel_p = pixelrow;
+                    for (x = 0; x < dim0; ++x) {
+                        *pixel_p = c;
+                        pixel_p += stride0;
+                    }
+                    pixelrow += stride1;
                 }
-                pixelrow += stride1;
-            }
-        } break;
-        case 2: {
-            Uint16 c = (Uint16)color;
-
-            for (y = 0; y < dim1; ++y) {
-                pixel_p = pixelrow;
-                for (x = 0; x < dim0; ++x) {
-                    *((Uint16 *)pixel_p) = c;
-                    pixel_p += stride0;
+            } break;
+            case 2: {
+                Uint16 c = (Uint16)color;
+
+                for (y = 0; y < dim1; ++y) {
+                    pixel_p = pixelrow;
+                    for (x = 0; x < dim0; ++x) {
+                        *((Uint16 *)pixel_p) = c;
+                        pixel_p += stride0;
+                    }
+                    pixelrow += stride1;
                 }
-                pixelrow += stride1;
-            }
-        } break;
-        case 3: {
+            } break;
+            case 3: {
 #if (SDL_BYTEORDER == SDL_LIL_ENDIAN)
-            Uint32 Roffset = surf->format->Rshift >> 3;
-            Uint32 Goffset = surf->format->Gshift >> 3;
-            Uint32 Boffset = surf->format->Bshift >> 3;
+                Uint32 Roffset = surf->format->Rshift >> 3;
+                Uint32 Goffset = surf->format->Gshift >> 3;
+                Uint32 Boffset = surf->format->Bshift >> 3;
 #else
-            Uint32 Roffset = 2 - (surf->format->Rshift >> 3);
-            Uint32 Goffset = 2 - (surf->format->Gshift >> 3);
-            Uint32 Boffset = 2 - (surf->format->Bshift >> 3);
+                Uint32 Roffset = 2 - (surf->format->Rshift >> 3);
+                Uint32 Goffset = 2 - (surf->format->Gshift >> 3);
+                Uint32 Boffset = 2 - (surf->format->Bshift >> 3);
 #endif
-            Uint8 r = (Uint8)(color >> 16);
-            Uint8 g = (Uint8)(color >> 8);
-            Uint8 b = (Uint8)(color);
-
-            for (y = 0; y < dim1; ++y) {
-                pixel_p = pixelrow;
-                for (x = 0; x < dim0; ++x) {
-                    pixel_p[Roffset] = r;
-                    pixel_p[Goffset] = g;
-                    pixel_p[Boffset] = b;
-                    pixel_p += stride0;
+                Uint8 r = (Uint8)(color >> 16);
+                Uint8 g = (Uint8)(color >> 8);
+                Uint8 b = (Uint8)(color);
+
+                for (y = 0; y < dim1; ++y) {
+                    pixel_p = pixelrow;
+                    for (x = 0; x < dim0; ++x) {
+                        pixel_p[Roffset] = r;
+                        pixel_p[Goffset] = g;
+                        pixel_p[Boffset] = b;
+                        pixel_p += stride0;
+                    }
+                    pixelrow += stride1;
                 }
-                pixelrow += stride1;
-            }
-        } break;
-        default: /* case 4: */
-            for (y = 0; y < dim1; ++y) {
-                pixel_p = pixelrow;
-                for (x = 0; x < dim0; ++x) {
-                    *((Uint32 *)pixel_p) = color;
-                    pixel_p += stride0;
+            } break;
+            default: /* case 4: */
+                for (y = 0; y < dim1; ++y) {
+                    pixel_p = pixelrow;
+                    for (x = 0; x < dim0; ++x) {
+                        *((Uint32 *)pixel_p) = color;
+                        pixel_p += stride0;
+                    }
+                    pixelrow += stride1;
                 }
-                pixelrow += stride1;
-            }
-            break;
+                break;
+        }
     }
     Py_END_ALLOW_THREADS;
 
@@ -20,13 +20,12 @@
 
 /* Simple weighted Euclidean distance, which tries to get near to the
  * human eye reception using the weights.
- * It receives RGB values in the range 0-255 and returns a distance
- * value between 0.0 and 1.0.
+ * It receives RGB values in the range 0-255, the distance is
+ * sqrt(COLOR_DIFF_SUM(...)) / 255.0, a value between 0.0 and 1.0.
  */
-#define COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2, b2)          \
-    (sqrt(wr * (r1 - r2) * (r1 - r2) + wg * (g1 - g2) * (g1 - g2) + \
-          wb * (b1 - b2) * (b1 - b2)) /                             \
-     255.0)
+#define COLOR_DIFF_SUM(wr, wg, wb, r1, g1, b1, r2, g2, b2)   \
+    (wr * (r1 - r2) * (r1 - r2) + wg * (g1 - g2) * (g1 - g2) + \
+     wb * (b1 - b2) * (b1 - b2))
 
 #define WR_NTSC 0.299
 #define WG_NTSC 0.587
@@ -353,114 +352,243 @@ _get_weights(PyObject *weights, float *wr, float *wg, float *wb)
     return 0;
 }
 
-static PyObject *
-_replace_color(pgPixelArrayObject *array, PyObject *args, PyObject *kwds)
-{
-    PyObject *weights = 0;
-    PyObject *delcolor = 0;
-    PyObject *replcolor = 0;
-    SDL_Surface *surf;
+/* replace(), extract() and compare() run on bands of rows, on the worker
+ * pool for large arrays, with the GIL released. */
+typedef struct _PixelArrayPass PixelArrayPass;
+typedef void (*_pass_rows_func)(PixelArrayPass *, Py_ssize_t, Py_ssize_t);
+
+struct _PixelArrayPass {
+    _pass_rows_func rows;
     SDL_PixelFormat *format;
-    Py_ssize_t dim0 = array->shape[0];
-    Py_ssize_t dim1 = array->shape[1];
-    Py_ssize_t stride0 = array->strides[0];
-    Py_ssize_t stride1 = array->strides[1];
-    Uint8 *pixels = array->pixels;
-    int bpp;
-    Uint32 dcolor;
-    Uint32 rcolor;
-    Uint8 r1, g1, b1, r2, g2, b2, a2;
-    Uint8 *pixelrow;
-    Uint8 *pixel_p;
-    float distance = 0;
+    Uint8 *pixels;
+    Py_ssize_t dim0;
+    Py_ssize_t dim1;
+    Py_ssize_t stride0;
+    Py_ssize_t stride1;
+    /* the second array of compare() */
+    SDL_PixelFormat *other_format;
+    Uint8 *other_pixels;
+    Py_ssize_t other_stride0;
+    Py_ssize_t other_stride1;
+    Uint32 color; /* looked for by replace() and extract() */
+    Uint32 hit;   /* written to matching pixels */
+    Uint32 miss;  /* written to the others, unless keep is set */
+    int keep;
+    Uint8 r, g, b; /* color split up, for the distance checks */
+    float distance;
+    float limit; /* largest COLOR_DIFF_SUM() within distance */
     float wr, wg, wb;
-    Py_ssize_t x;
-    Py_ssize_t y;
-    static char *keys[] = {"color", "repcolor", "distance", "weights", NULL};
-
-    if (array->surface == NULL) {
-        return RAISE(PyExc_ValueError, "Operation on closed PixelArray.");
+};
+
+/* The distance only grows with COLOR_DIFF_SUM(), so comparing it against
+ * distance is the same as comparing the sum against the largest float
+ * that passes. Finding that once, by bisecting the bit
+ * patterns of the positive floats, keeps sqrt() and doubles out of the
+ * pixel loops without changing a single result. */
+static float
+_get_distance_limit(float distance)
+{
+    Uint32 lo = 0, hi = 0x7F800000; /* 0.0 always passes, inf never does */
+    Uint32 mid;
+    float sum;
+
+    while (hi - lo > 1) {
+        mid = lo + (hi - lo) / 2;
+        memcpy(&sum, &mid, sizeof(sum));
+        if (sqrt(sum) / 255.0 <= distance) {
+            lo = mid;
+        }
+        else {
+            hi = mid;
+        }
     }
-    surf = pgSurface_AsSurface(array->surface);
+    memcpy(&sum, &lo, sizeof(sum));
+    return sum;
+}
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|fO", keys, &delcolor,
-                                     &replcolor, &distance, &weights)) {
-        return 0;
-    }
+#define PASS_MATCHES(p, r2, g2, b2)                                    \
+    (COLOR_DIFF_SUM(p->wr, p->wg, p->wb, p->r, p->g, p->b, r2, g2, b2) <= \
+     p->limit)
 
-    if (distance < 0 || distance > 1) {
-        return RAISE(PyExc_ValueError,
-                     "distance must be in the range from 0.0 to 1.0");
-    }
+#ifdef PG_PIXELARRAY_SIMD
+/* The SIMD loops take rows of 32 bit pixels with 8 bit channels, the format
+ * of nearly every surface. Everything else takes the scalar loops. */
+#define PASS_SIMD_FORMAT(f)                                      \
+    ((f)->BytesPerPixel == 4 && !(f)->Rloss && !(f)->Gloss && \
+     !(f)->Bloss)
 
-    format = surf->format;
-    bpp = surf->format->BytesPerPixel;
+static PG_INLINE __m128i
+_channel_sse2(__m128i px, int shift)
+{
+    return _mm_and_si128(_mm_srl_epi32(px, _mm_cvtsi32_si128(shift)),
+                         _mm_set1_epi32(0xFF));
+}
 
-    if (!_get_color_from_object(delcolor, format, &dcolor) ||
-        !_get_color_from_object(replcolor, format, &rcolor)) {
-        return 0;
-    }
+/* COLOR_DIFF_SUM() of 4 pixels, the same float operations in the same
+ * order, so the lanes match the scalar sums exactly */
+static PG_INLINE __m128
+_diff_sum_sse2(__m128i r1, __m128i g1, __m128i b1, __m128i r2, __m128i g2,
+               __m128i b2, __m128 wr, __m128 wg, __m128 wb)
+{
+    __m128 dr = _mm_cvtepi32_ps(_mm_sub_epi32(r1, r2));
+    __m128 dg = _mm_cvtepi32_ps(_mm_sub_epi32(g1, g2));
+    __m128 db = _mm_cvtepi32_ps(_mm_sub_epi32(b1, b2));
+
+    return _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(_mm_mul_ps(wr, dr), dr),
+                   _mm_mul_ps(_mm_mul_ps(wg, dg), dg)),
+        _mm_mul_ps(_mm_mul_ps(wb, db), db));
+}
 
-    if (!_get_weights(weights, &wr, &wg, &wb)) {
-        return 0;
-    }
+static PG_INLINE __m128i
+_select_sse2(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
 
-    if (distance != 0.0) {
-        SDL_GetRGB(dcolor, format, &r1, &g1, &b1);
+/* replace() and extract() on whole blocks of 4 pixels of a row.
+ * Returns the pixels done. */
+static Py_ssize_t
+_match_row_sse2(PixelArrayPass *p, Uint32 *row)
+{
+    SDL_PixelFormat *format = p->format;
+    __m128i color = _mm_set1_epi32((int)p->color);
+    __m128i hit = _mm_set1_epi32((int)p->hit);
+    __m128i miss = _mm_set1_epi32((int)p->miss);
+    __m128i r1 = _mm_set1_epi32(p->r), g1 = _mm_set1_epi32(p->g),
+            b1 = _mm_set1_epi32(p->b);
+    __m128 wr = _mm_set1_ps(p->wr), wg = _mm_set1_ps(p->wg),
+           wb = _mm_set1_ps(p->wb), limit = _mm_set1_ps(p->limit);
+    __m128i px, match;
+    Py_ssize_t x;
+
+    for (x = 0; x + 4 <= p->dim0; x += 4) {
+        px = _mm_loadu_si128((__m128i *)(row + x));
+        if (p->distance != 0.0) {
+            match = _mm_castps_si128(_mm_cmple_ps(
+                _diff_sum_sse2(r1, g1, b1,
+                               _channel_sse2(px, format->Rshift),
+                               _channel_sse2(px, format->Gshift),
+                               _channel_sse2(px, format->Bshift), wr, wg,
+                               wb),
+                limit));
+        }
+        else {
+            match = _mm_cmpeq_epi32(px, color);
+        }
+        _mm_storeu_si128((__m128i *)(row + x),
+                         _select_sse2(match, hit, p->keep ? px : miss));
     }
+    return x;
+}
 
-    if (!dim1) {
-        dim1 = 1;
+/* compare() on whole blocks of 4 pixels of a row. Returns the pixels
+ * done. */
+static Py_ssize_t
+_compare_row_sse2(PixelArrayPass *p, Uint32 *row, Uint32 *other_row)
+{
+    SDL_PixelFormat *f1 = p->format, *f2 = p->other_format;
+    __m128i hit = _mm_set1_epi32((int)p->hit);
+    __m128i miss = _mm_set1_epi32((int)p->miss);
+    __m128 wr = _mm_set1_ps(p->wr), wg = _mm_set1_ps(p->wg),
+           wb = _mm_set1_ps(p->wb), limit = _mm_set1_ps(p->limit);
+    __m128i px, opx, match;
+    Py_ssize_t x;
+
+    for (x = 0; x + 4 <= p->dim0; x += 4) {
+        px = _mm_loadu_si128((__m128i *)(row + x));
+        opx = _mm_loadu_si128((__m128i *)(other_row + x));
+        if (p->distance != 0.0) {
+            match = _mm_castps_si128(_mm_cmple_ps(
+                _diff_sum_sse2(_channel_sse2(px, f1->Rshift),
+                               _channel_sse2(px, f1->Gshift),
+                               _channel_sse2(px, f1->Bshift),
+                               _channel_sse2(opx, f2->Rshift),
+                               _channel_sse2(opx, f2->Gshift),
+                               _channel_sse2(opx, f2->Bshift), wr, wg, wb),
+                limit));
+        }
+        else {
+            match = _mm_cmpeq_epi32(px, opx);
+        }
+        _mm_storeu_si128((__m128i *)(row + x),
+                         _select_sse2(match, hit, miss));
     }
-    pixelrow = pixels;
+    return x;
+}
+#endif /* PG_PIXELARRAY_SIMD */
 
-    Py_BEGIN_ALLOW_THREADS;
-    switch (bpp) {
+/* Rows start to end of replace() (keep set) and extract() */
+static void
+_match_rows(PixelArrayPass *p, Py_ssize_t start, Py_ssize_t end)
+{
+    SDL_PixelFormat *format = p->format;
+    Uint32 color = p->color;
+    Uint32 hit = p->hit;
+    Uint32 miss = p->miss;
+    int keep = p->keep;
+    int distance = p->distance != 0.0;
+    Uint8 r2, g2, b2;
+    Uint8 *pixelrow = p->pixels + start * p->stride1;
+    Uint8 *pixel_p;
+    Py_ssize_t x;
+    Py_ssize_t y;
+
+    switch (format->BytesPerPixel) {
         case 1: {
             Uint8 *px_p;
 
-            for (y = 0; y < dim1; ++y) {
+            for (y = start; y < end; ++y) {
                 pixel_p = pixelrow;
-                for (x = 0; x < dim0; ++x) {
+                for (x = 0; x < p->dim0; ++x) {
                     px_p = pixel_p;
-                    if (distance != 0.0) {
-                        GET_PIXELVALS_1(r2, g2, b2, a2, px_p, format);
-                        if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2,
-                                           b2) <= distance) {
-                            *px_p = (Uint8)rcolor;
+                    if (distance) {
+                        r2 = format->palette->colors[*px_p].r;
+                        g2 = format->palette->colors[*px_p].g;
+                        b2 = format->palette->colors[*px_p].b;
+                        if (PASS_MATCHES(p, r2, g2, b2)) {
+                            *px_p = (Uint8)hit;
+                        }
+                        else if (!keep) {
+                            *px_p = (Uint8)miss;
                         }
                     }
-                    else if (*px_p == dcolor) {
-                        *px_p = (Uint8)rcolor;
+                    else if (*px_p == color) {
+                        *px_p = (Uint8)hit;
                     }
-                    pixel_p += stride0;
+                    else if (!keep) {
+                        *px_p = (Uint8)miss;
+                    }
+                    pixel_p += p->stride0;
                 }
-                pixelrow += stride1;
+                pixelrow += p->stride1;
             }
         } break;
         case 2: {
             Uint16 *px_p;
-            int ppa =
-                (SDL_ISPIXELFORMAT_ALPHA(format->format) && format->Amask);
 
-            for (y = 0; y < dim1; ++y) {
+            for (y = start; y < end; ++y) {
                 pixel_p = pixelrow;
-                for (x = 0; x < dim0; ++x) {
+                for (x = 0; x < p->dim0; ++x) {
                     px_p = (Uint16 *)pixel_p;
-                    if (distance != 0.0) {
-                        GET_PIXELVALS(r2, g2, b2, a2, (Uint32)*px_p, format,
-                                      ppa);
-                        if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2,
-                                           b2) <= distance) {
-                            *px_p = (Uint16)rcolor;
+                    if (distance) {
+                        SDL_GetRGB((Uint32)*px_p, format, &r2, &g2, &b2);
+                        if (PASS_MATCHES(p, r2, g2, b2)) {
+                            *px_p = (Uint16)hit;
+                        }
+                        else if (!keep) {
+                            *px_p = (Uint16)miss;
                         }
                     }
-                    else if (*px_p == dcolor) {
-                        *px_p = (Uint16)rcolor;
+                    else if (*px_p == color) {
+                        *px_p = (Uint16)hit;
                     }
-                    pixel_p += stride0;
+                    else if (!keep) {
+                        *px_p = (Uint16)miss;
+                    }
+                    pixel_p += p->stride0;
                 }
-                pixelrow += stride1;
+                pixelrow += p->stride1;
             }
         } break;
         case 3: {
@@ -473,61 +601,329 @@ _replace_color(pgPixelArrayObject *array, PyObject *args, PyObject *kwds)
             Uint32 Goffset = 2 - (format->Gshift >> 3);
             Uint32 Boffset = 2 - (format->Bshift >> 3);
 #endif
-            Uint32 pxcolor;
-            int ppa =
-                (SDL_ISPIXELFORMAT_ALPHA(format->format) && format->Amask);
+            Uint32 pxcolor, newcolor;
+            int matches;
 
-            for (y = 0; y < dim1; ++y) {
+            for (y = start; y < end; ++y) {
                 pixel_p = pixelrow;
-                for (x = 0; x < dim0; ++x) {
+                for (x = 0; x < p->dim0; ++x) {
                     pxcolor = (((Uint32)pixel_p[Roffset] << 16) +
                                ((Uint32)pixel_p[Goffset] << 8) +
                                ((Uint32)pixel_p[Boffset]));
-                    if (distance != 0.0) {
-                        GET_PIXELVALS(r2, g2, b2, a2, pxcolor, format, ppa);
-                        if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2,
-                                           b2) <= distance) {
-                            pixel_p[Roffset] = (Uint8)(rcolor >> 16);
-                            pixel_p[Goffset] = (Uint8)(rcolor >> 8);
-                            pixel_p[Boffset] = (Uint8)rcolor;
-                        }
+                    if (distance) {
+                        SDL_GetRGB(pxcolor, format, &r2, &g2, &b2);
+                        matches = PASS_MATCHES(p, r2, g2, b2);
+                    }
+                    else {
+                        matches = pxcolor == color;
                     }
-                    else if (pxcolor == dcolor) {
-                        pixel_p[Roffset] = (Uint8)(rcolor >> 16);
-                        pixel_p[Goffset] = (Uint8)(rcolor >> 8);
-                        pixel_p[Boffset] = (Uint8)rcolor;
+                    if (matches || !keep) {
+                        newcolor = matches ? hit : miss;
+                        pixel_p[Roffset] = (Uint8)(newcolor >> 16);
+                        pixel_p[Goffset] = (Uint8)(newcolor >> 8);
+                        pixel_p[Boffset] = (Uint8)newcolor;
                     }
-                    pixel_p += stride0;
+                    pixel_p += p->stride0;
                 }
-                pixelrow += stride1;
+                pixelrow += p->stride1;
             }
         } break;
         default: /* case 4: */
         {
             Uint32 *px_p;
-            int ppa = (SDL_ISPIXELFORMAT_ALPHA(format->format) &&
-                       surf->format->Amask);
 
-            for (y = 0; y < dim1; ++y) {
+            for (y = start; y < end; ++y) {
                 pixel_p = pixelrow;
-                for (x = 0; x < dim0; ++x) {
+                x = 0;
+#ifdef PG_PIXELARRAY_SIMD
+                if (p->stride0 == 4 && PASS_SIMD_FORMAT(format)) {
+                    x = _match_row_sse2(p, (Uint32 *)pixel_p);
+                    pixel_p += x * 4;
+                }
+#endif
+                for (; x < p->dim0; ++x) {
                     px_p = (Uint32 *)pixel_p;
-                    if (distance != 0.0) {
-                        GET_PIXELVALS(r2, g2, b2, a2, *px_p, format, ppa);
-                        if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2,
-                                           b2) <= distance) {
-                            *px_p = rcolor;
+                    if (distance) {
+                        SDL_GetRGB(*px_p, format, &r2, &g2, &b2);
+                        if (PASS_MATCHES(p, r2, g2, b2)) {
+                            *px_p = hit;
+                        }
+                        else if (!keep) {
+                            *px_p = miss;
                         }
                     }
-                    else if (*px_p == dcolor) {
-                        *px_p = rcolor;
+                    else if (*px_p == color) {
+                        *px_p = hit;
                     }
-                    pixel_p += stride0;
+                    else if (!keep) {
+                        *px_p = miss;
+                    }
+                    pixel_p += p->stride0;
                 }
-                pixelrow += stride1;
+                pixelrow += p->stride1;
+            }
+        } break;
+    }
+}
+
+/* Rows start to end of compare() */
+static void
+_compare_rows(PixelArrayPass *p, Py_ssize_t start, Py_ssize_t end)
+{
+    SDL_PixelFormat *format = p->format;
+    SDL_PixelFormat *other_format = p->other_format;
+    Uint32 white = p->hit;
+    Uint32 black = p->miss;
+    int distance = p->distance != 0.0;
+    Uint8 r1, g1, b1, r2, g2, b2;
+    Uint8 *row_p = p->pixels + start * p->stride1;
+    Uint8 *other_row_p = p->other_pixels + start * p->other_stride1;
+    Uint8 *byte_p;
+    Uint8 *other_byte_p;
+    Py_ssize_t x;
+    Py_ssize_t y;
+
+#define PAIR_MATCHES                                                      \
+    (COLOR_DIFF_SUM(p->wr, p->wg, p->wb, r1, g1, b1, r2, g2, b2) <= \
+     p->limit)
+
+    switch (format->BytesPerPixel) {
+        case 1: {
+            Uint8 *pixel_p;
+            Uint8 *other_pixel_p;
+
+            for (y = start; y < end; ++y) {
+                byte_p = row_p;
+                other_byte_p = other_row_p;
+                for (x = 0; x < p->dim0; ++x) {
+                    pixel_p = byte_p;
+                    other_pixel_p = other_byte_p;
+                    if (distance) {
+                        r1 = format->palette->colors[*pixel_p].r;
+                        g1 = format->palette->colors[*pixel_p].g;
+                        b1 = format->palette->colors[*pixel_p].b;
+                        r2 = other_format->palette->colors[*other_pixel_p].r;
+                        g2 = other_format->palette->colors[*other_pixel_p].g;
+                        b2 = other_format->palette->colors[*other_pixel_p].b;
+                        *pixel_p = (Uint8)(PAIR_MATCHES ? white : black);
+                    }
+                    else {
+                        *pixel_p = (Uint8)(*pixel_p == *other_pixel_p ? white
+                                                                      : black);
+                    }
+                    byte_p += p->stride0;
+                    other_byte_p += p->other_stride0;
+                }
+                row_p += p->stride1;
+                other_row_p += p->other_stride1;
+            }
+        } break;
+        case 2: {
+            Uint16 *pixel_p;
+            Uint16 *other_pixel_p;
+
+            for (y = start; y < end; ++y) {
+                byte_p = row_p;
+                other_byte_p = other_row_p;
+                for (x = 0; x < p->dim0; ++x) {
+                    pixel_p = (Uint16 *)byte_p;
+                    other_pixel_p = (Uint16 *)other_byte_p;
+                    if (distance) {
+                        SDL_GetRGB((Uint32)*pixel_p, format, &r1, &g1, &b1);
+                        SDL_GetRGB((Uint32)*other_pixel_p, other_format, &r2,
+                                   &g2, &b2);
+                        *pixel_p = (Uint16)(PAIR_MATCHES ? white : black);
+                    }
+                    else {
+                        *pixel_p =
+                            (Uint16)(*pixel_p == *other_pixel_p ? white
+                                                                : black);
+                    }
+                    byte_p += p->stride0;
+                    other_byte_p += p->other_stride0;
+                }
+                row_p += p->stride1;
+                other_row_p += p->other_stride1;
+            }
+        } break;
+        case 3: {
+#if (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+            Uint32 Roffset = format->Rshift >> 3;
+            Uint32 Goffset = format->Gshift >> 3;
+            Uint32 Boffset = format->Bshift >> 3;
+            Uint32 oRoffset = other_format->Rshift >> 3;
+            Uint32 oGoffset = other_format->Gshift >> 3;
+            Uint32 oBoffset = other_format->Bshift >> 3;
+#else
+            Uint32 Roffset = 2 - (format->Rshift >> 3);
+            Uint32 Goffset = 2 - (format->Gshift >> 3);
+            Uint32 Boffset = 2 - (format->Bshift >> 3);
+            Uint32 oRoffset = 2 - (other_format->Rshift >> 3);
+            Uint32 oGoffset = 2 - (other_format->Gshift >> 3);
+            Uint32 oBoffset = 2 - (other_format->Bshift >> 3);
+#endif
+            Uint32 newcolor;
+
+            for (y = start; y < end; ++y) {
+                byte_p = row_p;
+                other_byte_p = other_row_p;
+                for (x = 0; x < p->dim0; ++x) {
+                    r1 = byte_p[Roffset];
+                    g1 = byte_p[Goffset];
+                    b1 = byte_p[Boffset];
+                    r2 = other_byte_p[oRoffset];
+                    g2 = other_byte_p[oGoffset];
+                    b2 = other_byte_p[oBoffset];
+                    if (distance) {
+                        newcolor = PAIR_MATCHES ? white : black;
+                    }
+                    else {
+                        newcolor =
+                            r1 == r2 && g1 == g2 && b1 == b2 ? white : black;
+                    }
+                    byte_p[Roffset] = (Uint8)(newcolor >> 16);
+                    byte_p[Goffset] = (Uint8)(newcolor >> 8);
+                    byte_p[Boffset] = (Uint8)newcolor;
+                    byte_p += p->stride0;
+                    other_byte_p += p->other_stride0;
+                }
+                row_p += p->stride1;
+                other_row_p += p->other_stride1;
+            }
+        } break;
+        default: /* case 4: */
+        {
+            Uint32 *pixel_p;
+            Uint32 *other_pixel_p;
+
+            for (y = start; y < end; ++y) {
+                byte_p = row_p;
+                other_byte_p = other_row_p;
+                x = 0;
+#ifdef PG_PIXELARRAY_SIMD
+                if (p->stride0 == 4 && p->other_stride0 == 4 &&
+                    PASS_SIMD_FORMAT(format) &&
+                    PASS_SIMD_FORMAT(other_format)) {
+                    x = _compare_row_sse2(p, (Uint32 *)byte_p,
+                                          (Uint32 *)other_byte_p);
+                    byte_p += x * 4;
+                    other_byte_p += x * 4;
+                }
+#endif
+                for (; x < p->dim0; ++x) {
+                    pixel_p = (Uint32 *)byte_p;
+                    other_pixel_p = (Uint32 *)other_byte_p;
+                    if (distance) {
+                        SDL_GetRGB(*pixel_p, format, &r1, &g1, &b1);
+                        SDL_GetRGB(*other_pixel_p, other_format, &r2, &g2,
+                                   &b2);
+                        *pixel_p = PAIR_MATCHES ? white : black;
+                    }
+                    else {
+                        *pixel_p = *pixel_p == *other_pixel_p ? white : black;
+                    }
+                    byte_p += p->stride0;
+                    other_byte_p += p->other_stride0;
+                }
+                row_p += p->stride1;
+                other_row_p += p->other_stride1;
             }
         } break;
     }
+#undef PAIR_MATCHES
+}
+
+static void
+_pass_band(void *data, int band, int nbands)
+{
+    PixelArrayPass *p = (PixelArrayPass *)data;
+    Py_ssize_t start = p->dim1 * band / nbands;
+    Py_ssize_t end = p->dim1 * (band + 1) / nbands;
+
+    if (start < end) {
+        p->rows(p, start, end);
+    }
+}
+
+/* Runs p->rows() over all the rows. Call without the GIL. */
+static void
+_run_pass(PixelArrayPass *p)
+{
+    int nthreads = pg_GetNumThreads();
+
+    if (!p->dim1) {
+        p->dim1 = 1;
+    }
+    if (nthreads > p->dim1) {
+        nthreads = (int)p->dim1;
+    }
+    if (nthreads < 2 ||
+        (long long)p->dim0 * p->dim1 < PG_PARALLEL_MIN_PIXELS) {
+        p->rows(p, 0, p->dim1);
+        return;
+    }
+    pg_ParallelFor(_pass_band, p, nthreads);
+}
+
+static PyObject *
+_replace_color(pgPixelArrayObject *array, PyObject *args, PyObject *kwds)
+{
+    PyObject *weights = 0;
+    PyObject *delcolor = 0;
+    PyObject *replcolor = 0;
+    SDL_Surface *surf;
+    SDL_PixelFormat *format;
+    Uint32 dcolor;
+    Uint32 rcolor;
+    float distance = 0;
+    PixelArrayPass pass;
+    static char *keys[] = {"color", "repcolor", "distance", "weights", NULL};
+
+    if (array->surface == NULL) {
+        return RAISE(PyExc_ValueError, "Operation on closed PixelArray.");
+    }
+    surf = pgSurface_AsSurface(array->surface);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|fO", keys, &delcolor,
+                                     &replcolor, &distance, &weights)) {
+        return 0;
+    }
+
+    if (distance < 0 || distance > 1) {
+        return RAISE(PyExc_ValueError,
+                     "distance must be in the range from 0.0 to 1.0");
+    }
+
+    format = surf->format;
+
+    if (!_get_color_from_object(delcolor, format, &dcolor) ||
+        !_get_color_from_object(replcolor, format, &rcolor)) {
+        return 0;
+    }
+
+    if (!_get_weights(weights, &pass.wr, &pass.wg, &pass.wb)) {
+        return 0;
+    }
+
+    pass.rows = _match_rows;
+    pass.format = format;
+    pass.pixels = array->pixels;
+    pass.dim0 = array->shape[0];
+    pass.dim1 = array->shape[1];
+    pass.stride0 = array->strides[0];
+    pass.stride1 = array->strides[1];
+    pass.color = dcolor;
+    pass.hit = rcolor;
+    pass.miss = 0;
+    pass.keep = 1;
+    pass.distance = distance;
+    if (distance != 0.0) {
+        SDL_GetRGB(dcolor, format, &pass.r, &pass.g, &pass.b);
+        pass.limit = _get_distance_limit(distance);
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    _run_pass(&pass);
     Py_END_ALLOW_THREADS;
 
     Py_RETURN_NONE;
@@ -538,26 +934,14 @@ _extract_color(pgPixelArrayObject *array, PyObject *args, PyObject *kwds)
 {
     PyObject *weights = 0;
     PyObject *excolor = 0;
-    int bpp;
-    Uint32 black;
-    Uint32 white;
     Uint32 color;
-    Uint8 r1, g1, b1, r2, g2, b2, a2;
-    Uint8 *pixelrow;
-    Uint8 *pixel_p;
     float distance = 0;
     float wr, wg, wb;
-    Py_ssize_t x;
-    Py_ssize_t y;
     PyObject *surface;
     SDL_Surface *surf;
     SDL_PixelFormat *format;
     pgPixelArrayObject *new_array;
-    Py_ssize_t dim0;
-    Py_ssize_t dim1;
-    Py_ssize_t stride0;
-    Py_ssize_t stride1;
-    Uint8 *pixels;
+    PixelArrayPass pass;
     static char *keys[] = {"color", "distance", "weights", NULL};
 
     if (array->surface == NULL) {
@@ -592,169 +976,34 @@ _extract_color(pgPixelArrayObject *array, PyObject *args, PyObject *kwds)
 
     surf = pgSurface_AsSurface(surface);
     format = surf->format;
-    bpp = surf->format->BytesPerPixel;
-    dim0 = new_array->shape[0];
-    dim1 = new_array->shape[1];
-    stride0 = new_array->strides[0];
-    stride1 = new_array->strides[1];
-    pixels = new_array->pixels;
-
-    black = SDL_MapRGBA(format, 0, 0, 0, 255);
-    white = SDL_MapRGBA(format, 255, 255, 255, 255);
 
     if (!_get_color_from_object(excolor, format, &color)) {
         Py_DECREF(new_array);
         return 0;
     }
 
+    pass.rows = _match_rows;
+    pass.format = format;
+    pass.pixels = new_array->pixels;
+    pass.dim0 = new_array->shape[0];
+    pass.dim1 = new_array->shape[1];
+    pass.stride0 = new_array->strides[0];
+    pass.stride1 = new_array->strides[1];
+    pass.color = color;
+    pass.hit = SDL_MapRGBA(format, 255, 255, 255, 255);
+    pass.miss = SDL_MapRGBA(format, 0, 0, 0, 255);
+    pass.keep = 0;
+    pass.distance = distance;
+    pass.wr = wr;
+    pass.wg = wg;
+    pass.wb = wb;
     if (distance != 0.0) {
-        SDL_GetRGB(color, format, &r1, &g1, &b1);
+        SDL_GetRGB(color, format, &pass.r, &pass.g, &pass.b);
+        pass.limit = _get_distance_limit(distance);
     }
 
-    if (!dim1) {
-        dim1 = 1;
-    }
-    pixelrow = pixels;
-
     Py_BEGIN_ALLOW_THREADS;
-    switch (bpp) {
-        case 1: {
-            Uint8 *px_p;
-
-            for (y = 0; y < dim1; ++y) {
-                pixel_p = pixelrow;
-                for (x = 0; x < dim0; ++x) {
-                    px_p = pixel_p;
-                    if (distance != 0.0) {
-                        GET_PIXELVALS_1(r2, g2, b2, a2, px_p, format);
-                        if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2,
-                                           b2) <= distance) {
-                            *px_p = (Uint8)white;
-                        }
-                        else {
-                            *px_p = (Uint8)black;
-                        }
-                    }
-                    else {
-                        *px_p = (Uint8)(*px_p == color ? white : black);
-                    }
-                    pixel_p += stride0;
-                }
-                pixelrow += stride1;
-            }
-        } break;
-        case 2: {
-            Uint16 *px_p;
-            int ppa =
-                (SDL_ISPIXELFORMAT_ALPHA(format->format) && format->Amask);
-
-            for (y = 0; y < dim1; ++y) {
-                pixel_p = pixelrow;
-                for (x = 0; x < dim0; ++x) {
-                    px_p = (Uint16 *)pixel_p;
-                    if (distance != 0.0) {
-                        GET_PIXELVALS(r2, g2, b2, a2, (Uint32)*px_p, format,
-                                      ppa);
-                        if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2,
-                                           b2) <= distance) {
-                            *px_p = (Uint16)white;
-                        }
-                        else {
-                            *px_p = (Uint16)black;
-                        }
-                    }
-                    else {
-                        *px_p = (Uint16)(*px_p == color ? white : black);
-                    }
-                    pixel_p += stride0;
-                }
-                pixelrow += stride1;
-            }
-        } break;
-        case 3: {
-#if (SDL_BYTEORDER == SDL_LIL_ENDIAN)
-            Uint32 Roffset = format->Rshift >> 3;
-            Uint32 Goffset = format->Gshift >> 3;
-            Uint32 Boffset = format->Bshift >> 3;
-#else
-            Uint32 Roffset = 2 - (format->Rshift >> 3);
-            Uint32 Goffset = 2 - (format->Gshift >> 3);
-            Uint32 Boffset = 2 - (format->Bshift >> 3);
-#endif
-            Uint8 white_r = (Uint8)(white >> 16);
-            Uint8 white_g = (Uint8)(white >> 8);
-            Uint8 white_b = (Uint8)white;
-            Uint8 black_r = (Uint8)(black >> 16);
-            Uint8 black_g = (Uint8)(black >> 8);
-            Uint8 black_b = (Uint8)black;
-            Uint32 pxcolor;
-            int ppa =
-                (SDL_ISPIXELFORMAT_ALPHA(format->format) && format->Amask);
-
-            for (y = 0; y < dim1; ++y) {
-                pixel_p = pixelrow;
-                for (x = 0; x < dim0; ++x) {
-                    pxcolor = (((Uint32)pixel_p[Roffset] << 16) +
-                               ((Uint32)pixel_p[Goffset] << 8) +
-                               ((Uint32)pixel_p[Boffset]));
-                    if (distance != 0.0) {
-                        GET_PIXELVALS(r2, g2, b2, a2, pxcolor, format, ppa);
-                        if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2,
-                                           b2) <= distance) {
-                            pixel_p[Roffset] = white_r;
-                            pixel_p[Goffset] = white_g;
-                            pixel_p[Boffset] = white_b;
-                        }
-                        else {
-                            pixel_p[Roffset] = black_r;
-                            pixel_p[Goffset] = black_g;
-                            pixel_p[Boffset] = black_b;
-                        }
-                    }
-                    else if (pxcolor == color) {
-                        pixel_p[Roffset] = white_r;
-                        pixel_p[Goffset] = white_g;
-                        pixel_p[Boffset] = white_b;
-                    }
-                    else {
-                        pixel_p[Roffset] = black_r;
-                        pixel_p[Goffset] = black_g;
-                        pixel_p[Boffset] = black_b;
-                    }
-                    pixel_p += stride0;
-                }
-                pixelrow += stride1;
-            }
-        } break;
-        default: /* case 4: */
-        {
-            Uint32 *px_p;
-            int ppa =
-                (SDL_ISPIXELFORMAT_ALPHA(format->format) && format->Amask);
-
-            for (y = 0; y < dim1; ++y) {
-                pixel_p = pixelrow;
-                for (x = 0; x < dim0; ++x) {
-                    px_p = (Uint32 *)pixel_p;
-                    if (distance != 0.0) {
-                        GET_PIXELVALS(r2, g2, b2, a2, *px_p, format, ppa);
-                        if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2,
-                                           b2) <= distance) {
-                            *px_p = white;
-                        }
-                        else {
-                            *px_p = black;
-                        }
-                    }
-                    else {
-                        *px_p = *px_p == color ? white : black;
-                    }
-                    pixel_p += stride0;
-                }
-                pixelrow += stride1;
-            }
-        } break;
-    }
+    _run_pass(&pass);
     Py_END_ALLOW_THREADS;
 
     return (PyObject *)new_array;
@@ -771,27 +1020,11 @@ _compare(pgPixelArrayObject *array, PyObject *args, PyObject *kwds)
     PyObject *weights = 0;
     SDL_Surface *other_surf;
     SDL_PixelFormat *other_format;
-    Py_ssize_t other_stride0;
-    Py_ssize_t other_stride1;
-    Uint8 *other_pixels;
-    int bpp;
-    Uint32 black;
-    Uint32 white;
-    Uint8 r1, g1, b1, a1, r2, g2, b2, a2;
-    Uint8 *row_p;
-    Uint8 *byte_p;
-    Uint8 *other_row_p;
-    Uint8 *other_byte_p;
     float distance = 0;
     float wr, wg, wb;
-    Py_ssize_t x;
-    Py_ssize_t y;
     pgPixelArrayObject *new_array;
     PyObject *new_surface;
-    SDL_PixelFormat *new_format;
-    Py_ssize_t stride0;
-    Py_ssize_t stride1;
-    Uint8 *pixels;
+    PixelArrayPass pass;
 
     static char *keys[] = {"array", "distance", "weights", NULL};
 
@@ -822,21 +1055,16 @@ _compare(pgPixelArrayObject *array, PyObject *args, PyObject *kwds)
     }
 
     format = surf->format;
-    bpp = surf->format->BytesPerPixel;
     other_surf = pgSurface_AsSurface(other_array->surface);
     other_format = other_surf->format;
 
-    if (other_format->BytesPerPixel != bpp) {
+    if (other_format->BytesPerPixel != format->BytesPerPixel) {
         /* bpp do not match. We cannot guarantee that the padding and co
          * would be set correctly. */
         PyErr_SetString(PyExc_ValueError, "bit depths do not match");
         return 0;
     }
 
-    other_stride0 = other_array->strides[0];
-    other_stride1 = other_array->strides[1];
-    other_pixels = other_array->pixels;
-
     /* Create the b/w mask surface. */
     new_surface = _make_surface(array, NULL);
     if (!new_surface) {
@@ -849,195 +1077,29 @@ _compare(pgPixelArrayObject *array, PyObject *args, PyObject *kwds)
         return 0;
     }
 
-    new_format = surf->format;
-    stride0 = new_array->strides[0];
-    stride1 = new_array->strides[1];
-    pixels = new_array->pixels;
-
-    black = SDL_MapRGBA(format, 0, 0, 0, 255);
-    white = SDL_MapRGBA(format, 255, 255, 255, 255);
-
-    Py_BEGIN_ALLOW_THREADS;
-    if (!dim1) {
-        dim1 = 1;
+    pass.rows = _compare_rows;
+    pass.format = format;
+    pass.pixels = new_array->pixels;
+    pass.dim0 = dim0;
+    pass.dim1 = dim1;
+    pass.stride0 = new_array->strides[0];
+    pass.stride1 = new_array->strides[1];
+    pass.other_format = other_format;
+    pass.other_pixels = other_array->pixels;
+    pass.other_stride0 = other_array->strides[0];
+    pass.other_stride1 = other_array->strides[1];
+    pass.hit = SDL_MapRGBA(format, 255, 255, 255, 255);
+    pass.miss = SDL_MapRGBA(format, 0, 0, 0, 255);
+    pass.distance = distance;
+    pass.wr = wr;
+    pass.wg = wg;
+    pass.wb = wb;
+    if (distance != 0.0) {
+        pass.limit = _get_distance_limit(distance);
     }
-    row_p = pixels;
-    other_row_p = other_pixels;
-
-    switch (bpp) {
-        case 1: {
-            Uint8 *pixel_p;
-            Uint8 *other_pixel_p;
-
-            for (y = 0; y < dim1; ++y) {
-                byte_p = row_p;
-                other_byte_p = other_row_p;
-                for (x = 0; x < dim0; ++x) {
-                    pixel_p = byte_p;
-                    other_pixel_p = other_byte_p;
-                    if (distance != 0.0) {
-                        GET_PIXELVALS_1(r1, g1, b1, a1, pixel_p, new_format);
-                        GET_PIXELVALS_1(r2, g2, b2, a2, other_pixel_p,
-                                        other_format);
-                        if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2,
-                                           b2) <= distance) {
-                            *pixel_p = (Uint8)white;
-                        }
-                        else {
-                            *pixel_p = (Uint8)black;
-                        }
-                    }
-                    else {
-                        *pixel_p = (Uint8)(*pixel_p == *other_pixel_p ? white
-                                                                      : black);
-                    }
-                    byte_p += stride0;
-                    other_byte_p += other_stride0;
-                }
-                row_p += stride1;
-                other_row_p += other_stride1;
-            }
-        } break;
-        case 2: {
-            Uint16 *pixel_p;
-            Uint16 *other_pixel_p;
-            int ppa =
-                (SDL_ISPIXELFORMAT_ALPHA(format->format) && format->Amask);
-            int other_ppa = (SDL_ISPIXELFORMAT_ALPHA(other_format->format) &&
-                             other_format->Amask);
-
-            for (y = 0; y < dim1; ++y) {
-                byte_p = row_p;
-                other_byte_p = other_row_p;
-                for (x = 0; x < dim0; ++x) {
-                    pixel_p = (Uint16 *)byte_p;
-                    other_pixel_p = (Uint16 *)other_byte_p;
-                    if (distance != 0.0) {
-                        GET_PIXELVALS(r1, g1, b1, a1, (Uint32)*pixel_p, format,
-                                      ppa);
-                        GET_PIXELVALS(r2, g2, b2, a2, (Uint32)*other_pixel_p,
-                                      other_format, other_ppa);
-                        if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2,
-                                           b2) <= distance) {
-                            *pixel_p = (Uint16)white;
-                        }
-                        else {
-                            *pixel_p = (Uint16)black;
-                        }
-                    }
-                    else {
-                        *pixel_p =
-                            (Uint16)(*pixel_p == *other_pixel_p ? white
-                                                                : black);
-                    }
-                    byte_p += stride0;
-                    other_byte_p += other_stride0;
-                }
-                row_p += stride1;
-                other_row_p += other_stride1;
-            }
-        } break;
-        case 3: {
-#if (SDL_BYTEORDER == SDL_LIL_ENDIAN)
-            Uint32 Roffset = format->Rshift >> 3;
-            Uint32 Goffset = format->Gshift >> 3;
-            Uint32 Boffset = format->Bshift >> 3;
-            Uint32 oRoffset = other_format->Rshift >> 3;
-            Uint32 oGoffset = other_format->Gshift >> 3;
-            Uint32 oBoffset = other_format->Bshift >> 3;
-#else
-            Uint32 Roffset = 2 - (format->Rshift >> 3);
-            Uint32 Goffset = 2 - (format->Gshift >> 3);
-            Uint32 Boffset = 2 - (format->Bshift >> 3);
-            Uint32 oRoffset = 2 - (other_format->Rshift >> 3);
-            Uint32 oGoffset = 2 - (other_format->Gshift >> 3);
-            Uint32 oBoffset = 2 - (other_format->Bshift >> 3);
-#endif
-            Uint8 white_r = (Uint8)(white >> 16);
-            Uint8 white_g = (Uint8)(white >> 8);
-            Uint8 white_b = (Uint8)white;
-            Uint8 black_r = (Uint8)(black >> 16);
-            Uint8 black_g = (Uint8)(black >> 8);
-            Uint8 black_b = (Uint8)black;
 
-            for (y = 0; y < dim1; ++y) {
-                byte_p = row_p;
-                other_byte_p = other_row_p;
-                for (x = 0; x < dim0; ++x) {
-                    r1 = byte_p[Roffset];
-                    g1 = byte_p[Goffset];
-                    b1 = byte_p[Boffset];
-                    r2 = other_byte_p[oRoffset];
-                    g2 = other_byte_p[oGoffset];
-                    b2 = other_byte_p[oBoffset];
-                    if (distance != 0.0) {
-                        if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2,
-                                           b2) <= distance) {
-                            byte_p[Roffset] = white_r;
-                            byte_p[Goffset] = white_g;
-                            byte_p[Boffset] = white_b;
-                        }
-                        else {
-                            byte_p[Roffset] = black_r;
-                            byte_p[Goffset] = black_g;
-                            byte_p[Boffset] = black_b;
-                        }
-                    }
-                    else if (r1 == r2 && g1 == g2 && b1 == b2) {
-                        byte_p[Roffset] = white_r;
-                        byte_p[Goffset] = white_g;
-                        byte_p[Boffset] = white_b;
-                    }
-                    else {
-                        byte_p[Roffset] = black_r;
-                        byte_p[Goffset] = black_g;
-                        byte_p[Boffset] = black_b;
-                    }
-                    byte_p += stride0;
-                    other_byte_p += other_stride0;
-                }
-                row_p += stride1;
-                other_row_p += other_stride1;
-            }
-        } break;
-        default: /* case 4: */
-        {
-            Uint32 *pixel_p;
-            Uint32 *other_pixel_p;
-            int ppa =
-                (SDL_ISPIXELFORMAT_ALPHA(format->format) && format->Amask);
-            int other_ppa = (SDL_ISPIXELFORMAT_ALPHA(other_format->format) &&
-                             other_format->Amask);
-
-            for (y = 0; y < dim1; ++y) {
-                byte_p = row_p;
-                other_byte_p = other_row_p;
-                for (x = 0; x < dim0; ++x) {
-                    pixel_p = (Uint32 *)byte_p;
-                    other_pixel_p = (Uint32 *)other_byte_p;
-                    if (distance != 0.0) {
-                        GET_PIXELVALS(r1, g1, b1, a1, *pixel_p, format, ppa);
-                        GET_PIXELVALS(r2, g2, b2, a2, *other_pixel_p,
-                                      other_format, other_ppa);
-                        if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2,
-                                           b2) <= distance) {
-                            *pixel_p = white;
-                        }
-                        else {
-                            *pixel_p = black;
-                        }
-                    }
-                    else {
-                        *pixel_p = *pixel_p == *other_pixel_p ? white : black;
-                    }
-                    byte_p += stride0;
-                    other_byte_p += other_stride0;
-                }
-                row_p += stride1;
-                other_row_p += other_stride1;
-            }
-        } break;
-    }
+    Py_BEGIN_ALLOW_THREADS;
+    _run_pass(&pass);
     Py_END_ALLOW_THREADS;
 
     return (PyObject *)new_array;
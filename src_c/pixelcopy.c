@@ -30,6 +30,25 @@
 
 #include <SDL_endian.h>
 
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+// arm64 has neon optimisations enabled by default, even when fpu=neon is not
+// passed
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+/* The vector paths build 3 byte items out of 32 bit lanes, so they are
+   only used on little endian machines */
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#if defined(PG_ENABLE_ARM_NEON)
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "include/sse2neon.h"
+#define PG_PIXELCOPY_SIMD
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define PG_PIXELCOPY_SIMD
+#endif
+#endif
+
 typedef enum {
     PXC_VIEWKIND_RED,
     PXC_VIEWKIND_GREEN,
@@ -188,6 +207,461 @@ typedef union {
     Uint8 bytes[sizeof(Uint32)];
 } _pc_pixel_t;
 
+/* Fast paths for the common layouts.
+
+   A _pc_copy_t describes a copy between a surface and an array of native
+   1, 2, 4 or 8 byte integers. The surface is split into bands of rows for
+   pg_ParallelFor, and each band into runs of pixels for the run() kernel.
+   Runs follow the surface rows when the array is laid out the same way.
+   When the array is transposed, as a default numpy array of shape
+   (w, h, ...) is, runs go down short columns of PC_TILE_ROWS pixels so
+   both sides are walked a cache line at a time.
+*/
+#define PC_TILE_ROWS 32
+
+typedef struct _pc_copy_s _pc_copy_t;
+
+typedef void (*_pc_run_t)(const _pc_copy_t *c, Uint8 *pix,
+                          Py_intptr_t pix_step, Uint8 *item,
+                          Py_intptr_t item_step, int n);
+
+struct _pc_copy_s {
+    _pc_run_t run;
+    Uint8 *pixels;
+    Py_intptr_t pitch;
+    int w;
+    int h;
+    int bpp;
+    Uint8 *buf;
+    Py_intptr_t dx;
+    Py_intptr_t dy;
+    Py_intptr_t dz; /* color plane stride of a 3d array */
+    int itemsize;
+    int rshift, gshift, bshift;
+    int rloss, gloss, bloss;
+    Uint32 alpha; /* or'ed into every pixel written to the surface */
+    int shift;    /* color plane position for _pc_run_channel_to_array */
+    Uint32 key;
+    Uint8 opaque;
+    Uint8 clear;
+};
+
+static PG_INLINE Uint64
+_pc_load(const Uint8 *p, int size)
+{
+    Uint8 u8;
+    Uint16 u16;
+    Uint32 u32;
+    Uint64 u64;
+
+    switch (size) {
+        case 1:
+            u8 = *p;
+            return u8;
+        case 2:
+            memcpy(&u16, p, 2);
+            return u16;
+        case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            return p[0] | (p[1] << 8) | ((Uint32)p[2] << 16);
+#else
+            return ((Uint32)p[0] << 16) | (p[1] << 8) | p[2];
+#endif
+        case 4:
+            memcpy(&u32, p, 4);
+            return u32;
+        default:
+            memcpy(&u64, p, 8);
+            return u64;
+    }
+}
+
+static PG_INLINE void
+_pc_store(Uint8 *p, int size, Uint64 value)
+{
+    Uint16 u16;
+    Uint32 u32;
+
+    switch (size) {
+        case 1:
+            *p = (Uint8)value;
+            break;
+        case 2:
+            u16 = (Uint16)value;
+            memcpy(p, &u16, 2);
+            break;
+        case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            p[0] = (Uint8)value;
+            p[1] = (Uint8)(value >> 8);
+            p[2] = (Uint8)(value >> 16);
+#else
+            p[0] = (Uint8)(value >> 16);
+            p[1] = (Uint8)(value >> 8);
+            p[2] = (Uint8)value;
+#endif
+            break;
+        case 4:
+            u32 = (Uint32)value;
+            memcpy(p, &u32, 4);
+            break;
+        default:
+            memcpy(p, &value, 8);
+    }
+}
+
+#define PC_STRIDED_COPY(T)                       \
+    for (i = 0; i < n; ++i) {                    \
+        T v;                                     \
+        memcpy(&v, src, sizeof(T));              \
+        memcpy(dst, &v, sizeof(T));              \
+        src += src_step;                         \
+        dst += dst_step;                         \
+    }
+
+/* Copies n integers, truncating or zero extending them to dst_size */
+static void
+_pc_copy_ints(Uint8 *dst, Py_intptr_t dst_step, int dst_size,
+              const Uint8 *src, Py_intptr_t src_step, int src_size, int n)
+{
+    int i;
+
+    if (dst_size == src_size) {
+        if (dst_step == dst_size && src_step == src_size) {
+            memcpy(dst, src, (size_t)n * dst_size);
+            return;
+        }
+        switch (dst_size) {
+            case 1:
+                PC_STRIDED_COPY(Uint8);
+                return;
+            case 2:
+                PC_STRIDED_COPY(Uint16);
+                return;
+            case 4:
+                PC_STRIDED_COPY(Uint32);
+                return;
+        }
+    }
+    for (i = 0; i < n; ++i) {
+        _pc_store(dst, dst_size, _pc_load(src, src_size));
+        src += src_step;
+        dst += dst_step;
+    }
+}
+
+static void
+_pc_run_mapped_to_array(const _pc_copy_t *c, Uint8 *pix, Py_intptr_t pix_step,
+                        Uint8 *item, Py_intptr_t item_step, int n)
+{
+    _pc_copy_ints(item, item_step, c->itemsize, pix, pix_step, c->bpp, n);
+}
+
+static void
+_pc_run_mapped_to_surface(const _pc_copy_t *c, Uint8 *pix,
+                          Py_intptr_t pix_step, Uint8 *item,
+                          Py_intptr_t item_step, int n)
+{
+    _pc_copy_ints(pix, pix_step, c->bpp, item, item_step, c->itemsize, n);
+}
+
+/* 24 or 32 bit pixels with 8 bit channels into a 3d uint8 array */
+static void
+_pc_run_rgb_to_array(const _pc_copy_t *c, Uint8 *pix, Py_intptr_t pix_step,
+                     Uint8 *item, Py_intptr_t item_step, int n)
+{
+    Py_intptr_t dz = c->dz;
+    Uint32 p;
+    int i = 0;
+
+#if defined(PG_PIXELCOPY_SIMD)
+    if (c->bpp == 4 && pix_step == 4 && item_step == 3 && dz == 1) {
+        const __m128i mask = _mm_set1_epi32(0xff);
+        const __m128i rs = _mm_cvtsi32_si128(c->rshift);
+        const __m128i gs = _mm_cvtsi32_si128(c->gshift);
+        const __m128i bs = _mm_cvtsi32_si128(c->bshift);
+        __m128i v, rgb;
+        Uint32 out[4];
+
+        for (; i + 4 <= n; i += 4) {
+            v = _mm_loadu_si128((const __m128i *)pix);
+            rgb = _mm_or_si128(
+                _mm_and_si128(_mm_srl_epi32(v, rs), mask),
+                _mm_or_si128(
+                    _mm_slli_epi32(_mm_and_si128(_mm_srl_epi32(v, gs), mask),
+                                   8),
+                    _mm_slli_epi32(_mm_and_si128(_mm_srl_epi32(v, bs), mask),
+                                   16)));
+            _mm_storeu_si128((__m128i *)out, rgb);
+            /* Each 4 byte store spills into the next item's red byte,
+               which the following store overwrites */
+            memcpy(item, out, 4);
+            memcpy(item + 3, out + 1, 4);
+            memcpy(item + 6, out + 2, 4);
+            memcpy(item + 9, out + 3, 3);
+            pix += 16;
+            item += 12;
+        }
+    }
+#endif /* PG_PIXELCOPY_SIMD */
+    for (; i < n; ++i) {
+        p = (Uint32)_pc_load(pix, c->bpp);
+        item[0] = (Uint8)(p >> c->rshift);
+        item[dz] = (Uint8)(p >> c->gshift);
+        item[2 * dz] = (Uint8)(p >> c->bshift);
+        pix += pix_step;
+        item += item_step;
+    }
+}
+
+/* A 3d uint8 array into 16 or 32 bit pixels */
+static void
+_pc_run_rgb_to_surface(const _pc_copy_t *c, Uint8 *pix, Py_intptr_t pix_step,
+                       Uint8 *item, Py_intptr_t item_step, int n)
+{
+    Py_intptr_t dz = c->dz;
+    Uint32 p;
+    int i = 0;
+
+#if defined(PG_PIXELCOPY_SIMD)
+    if (c->bpp == 4 && pix_step == 4 && item_step >= 3 && dz == 1) {
+        const __m128i mask = _mm_set1_epi32(0xff);
+        const __m128i alpha = _mm_set1_epi32((int)c->alpha);
+        const __m128i rl = _mm_cvtsi32_si128(c->rloss);
+        const __m128i gl = _mm_cvtsi32_si128(c->gloss);
+        const __m128i bl = _mm_cvtsi32_si128(c->bloss);
+        const __m128i rs = _mm_cvtsi32_si128(c->rshift);
+        const __m128i gs = _mm_cvtsi32_si128(c->gshift);
+        const __m128i bs = _mm_cvtsi32_si128(c->bshift);
+        __m128i v, r, g, b;
+        Uint32 w0, w1, w2, w3;
+
+        /* Each item is read as 4 bytes, so stop short of the last one */
+        for (; i + 4 < n; i += 4) {
+            memcpy(&w0, item, 4);
+            memcpy(&w1, item + item_step, 4);
+            memcpy(&w2, item + 2 * item_step, 4);
+            memcpy(&w3, item + 3 * item_step, 4);
+            v = _mm_set_epi32((int)w3, (int)w2, (int)w1, (int)w0);
+            r = _mm_and_si128(v, mask);
+            g = _mm_and_si128(_mm_srli_epi32(v, 8), mask);
+            b = _mm_and_si128(_mm_srli_epi32(v, 16), mask);
+            r = _mm_sll_epi32(_mm_srl_epi32(r, rl), rs);
+            g = _mm_sll_epi32(_mm_srl_epi32(g, gl), gs);
+            b = _mm_sll_epi32(_mm_srl_epi32(b, bl), bs);
+            v = _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, alpha));
+            _mm_storeu_si128((__m128i *)pix, v);
+            pix += 16;
+            item += 4 * item_step;
+        }
+    }
+#endif /* PG_PIXELCOPY_SIMD */
+    for (; i < n; ++i) {
+        p = ((Uint32)item[0] >> c->rloss << c->rshift) |
+            ((Uint32)item[dz] >> c->gloss << c->gshift) |
+            ((Uint32)item[2 * dz] >> c->bloss << c->bshift) | c->alpha;
+        _pc_store(pix, c->bpp, p);
+        pix += pix_step;
+        item += item_step;
+    }
+}
+
+/* One 8 bit color plane into a 2d uint8 array */
+static void
+_pc_run_channel_to_array(const _pc_copy_t *c, Uint8 *pix,
+                         Py_intptr_t pix_step, Uint8 *item,
+                         Py_intptr_t item_step, int n)
+{
+    int i = 0;
+
+#if defined(PG_PIXELCOPY_SIMD)
+    if (c->bpp == 4 && pix_step == 4 && item_step == 1) {
+        const __m128i mask = _mm_set1_epi32(0xff);
+        const __m128i s = _mm_cvtsi32_si128(c->shift);
+        __m128i v0, v1, v2, v3;
+
+        for (; i + 16 <= n; i += 16) {
+            v0 = _mm_loadu_si128((const __m128i *)pix);
+            v1 = _mm_loadu_si128((const __m128i *)(pix + 16));
+            v2 = _mm_loadu_si128((const __m128i *)(pix + 32));
+            v3 = _mm_loadu_si128((const __m128i *)(pix + 48));
+            v0 = _mm_and_si128(_mm_srl_epi32(v0, s), mask);
+            v1 = _mm_and_si128(_mm_srl_epi32(v1, s), mask);
+            v2 = _mm_and_si128(_mm_srl_epi32(v2, s), mask);
+            v3 = _mm_and_si128(_mm_srl_epi32(v3, s), mask);
+            _mm_storeu_si128((__m128i *)item,
+                             _mm_packus_epi16(_mm_packs_epi32(v0, v1),
+                                              _mm_packs_epi32(v2, v3)));
+            pix += 64;
+            item += 16;
+        }
+    }
+#endif /* PG_PIXELCOPY_SIMD */
+    for (; i < n; ++i) {
+        *item = (Uint8)(_pc_load(pix, c->bpp) >> c->shift);
+        pix += pix_step;
+        item += item_step;
+    }
+}
+
+static void
+_pc_run_colorkey_to_array(const _pc_copy_t *c, Uint8 *pix,
+                          Py_intptr_t pix_step, Uint8 *item,
+                          Py_intptr_t item_step, int n)
+{
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        *item = _pc_load(pix, c->bpp) == c->key ? c->clear : c->opaque;
+        pix += pix_step;
+        item += item_step;
+    }
+}
+
+static void
+_pc_run_fill_array(const _pc_copy_t *c, Uint8 *pix, Py_intptr_t pix_step,
+                   Uint8 *item, Py_intptr_t item_step, int n)
+{
+    int i;
+
+    if (item_step == 1) {
+        memset(item, c->opaque, n);
+        return;
+    }
+    for (i = 0; i < n; ++i) {
+        *item = c->opaque;
+        item += item_step;
+    }
+}
+
+static void
+_pc_copy_rows(const _pc_copy_t *c, int y0, int y1)
+{
+    Py_intptr_t adx = c->dx < 0 ? -c->dx : c->dx;
+    Py_intptr_t ady = c->dy < 0 ? -c->dy : c->dy;
+    int x, y, n;
+
+    if (adx <= ady) {
+        for (y = y0; y < y1; ++y) {
+            c->run(c, c->pixels + c->pitch * y, c->bpp, c->buf + c->dy * y,
+                   c->dx, c->w);
+        }
+        return;
+    }
+    for (y = y0; y < y1; y += PC_TILE_ROWS) {
+        n = y1 - y < PC_TILE_ROWS ? y1 - y : PC_TILE_ROWS;
+        for (x = 0; x < c->w; ++x) {
+            c->run(c, c->pixels + c->pitch * y + c->bpp * x, c->pitch,
+                   c->buf + c->dy * y + c->dx * x, c->dy, n);
+        }
+    }
+}
+
+static void
+_pc_copy_band(void *data, int band, int nbands)
+{
+    _pc_copy_t *c = (_pc_copy_t *)data;
+    int ntiles = (c->h + PC_TILE_ROWS - 1) / PC_TILE_ROWS;
+    int y0 = ntiles * band / nbands * PC_TILE_ROWS;
+    int y1 = ntiles * (band + 1) / nbands * PC_TILE_ROWS;
+
+    if (y1 > c->h) {
+        y1 = c->h;
+    }
+    if (y0 < y1) {
+        _pc_copy_rows(c, y0, y1);
+    }
+}
+
+/* Runs the copy over the whole surface. Call without the GIL. */
+static void
+_pc_copy(_pc_copy_t *c)
+{
+    int nthreads = pg_GetNumThreads();
+    int ntiles = (c->h + PC_TILE_ROWS - 1) / PC_TILE_ROWS;
+
+    if (nthreads > ntiles) {
+        nthreads = ntiles;
+    }
+    if (nthreads < 2 || (long long)c->w * c->h < PG_PARALLEL_MIN_PIXELS) {
+        _pc_copy_rows(c, 0, c->h);
+        return;
+    }
+    pg_ParallelFor(_pc_copy_band, c, nthreads);
+}
+
+static void
+_pc_init_copy(_pc_copy_t *c, _pc_run_t run, Py_buffer *view_p,
+              SDL_Surface *surf)
+{
+    SDL_PixelFormat *format = surf->format;
+
+    memset(c, 0, sizeof(_pc_copy_t));
+    c->run = run;
+    c->pixels = (Uint8 *)surf->pixels;
+    c->pitch = surf->pitch;
+    c->w = surf->w;
+    c->h = surf->h;
+    c->bpp = format->BytesPerPixel;
+    c->buf = (Uint8 *)view_p->buf;
+    c->dx = view_p->strides[0];
+    c->dy = view_p->strides[1];
+    c->dz = view_p->ndim == 3 ? view_p->strides[2] : 0;
+    c->itemsize = (int)view_p->itemsize;
+    c->rshift = format->Rshift;
+    c->gshift = format->Gshift;
+    c->bshift = format->Bshift;
+    c->rloss = format->Rloss;
+    c->gloss = format->Gloss;
+    c->bloss = format->Bloss;
+}
+
+/* True if the array items are native integers the fast paths can load */
+static int
+_pc_is_native_int(Py_buffer *view_p)
+{
+    Py_ssize_t size = view_p->itemsize;
+
+    return (size == 1 || size == 2 || size == 4 || size == 8) &&
+           !_is_swapped(view_p);
+}
+
+/* Finds where a color plane sits in a pixel. Returns 0 if it has to be
+   looked up with SDL_GetRGBA instead. */
+static int
+_pc_get_channel_shift(SDL_PixelFormat *format, _pc_view_kind_t view_kind,
+                      int *shift)
+{
+    Uint32 mask;
+    Uint8 loss;
+
+    if (format->palette) {
+        return 0;
+    }
+    switch (view_kind) {
+        case PXC_VIEWKIND_RED:
+            mask = format->Rmask;
+            loss = format->Rloss;
+            *shift = format->Rshift;
+            break;
+        case PXC_VIEWKIND_GREEN:
+            mask = format->Gmask;
+            loss = format->Gloss;
+            *shift = format->Gshift;
+            break;
+        case PXC_VIEWKIND_BLUE:
+            mask = format->Bmask;
+            loss = format->Bloss;
+            *shift = format->Bshift;
+            break;
+        default:
+            mask = format->Amask;
+            loss = format->Aloss;
+            *shift = format->Ashift;
+    }
+    return mask && !loss;
+}
+
 static int
 _copy_mapped(Py_buffer *view_p, SDL_Surface *surf)
 {
@@ -212,6 +686,7 @@ _copy_mapped(Py_buffer *view_p, SDL_Surface *surf)
     Py_intptr_t dy_dst = view_p->strides[1];
     Py_intptr_t dz_dst = 1;
     Py_intptr_t x, y, z;
+    _pc_copy_t copy;
 
     if (view_p->shape[0] != w || view_p->shape[1] != h) {
         PyErr_Format(PyExc_ValueError,
@@ -225,6 +700,13 @@ _copy_mapped(Py_buffer *view_p, SDL_Surface *surf)
                      pixelsize, intsize);
         return -1;
     }
+    if (_pc_is_native_int(view_p)) {
+        _pc_init_copy(&copy, _pc_run_mapped_to_array, view_p, surf);
+        Py_BEGIN_ALLOW_THREADS;
+        _pc_copy(&copy);
+        Py_END_ALLOW_THREADS;
+        return 0;
+    }
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
     if (_is_swapped(view_p)) {
         dst += intsize - 1;
@@ -275,6 +757,7 @@ _copy_colorplane(Py_buffer *view_p, SDL_Surface *surf,
     Uint8 *element = 0;
     _pc_pixel_t pixel = {0};
     Uint32 colorkey;
+    _pc_copy_t copy;
 
     if (view_p->shape[0] != w || view_p->shape[1] != h) {
         PyErr_Format(PyExc_ValueError,
@@ -309,6 +792,29 @@ _copy_colorplane(Py_buffer *view_p, SDL_Surface *surf,
                    view_kind == VIEWKIND_COLORKEY);
             element = &a;
     }
+    if (intsize == 1) {
+        _pc_init_copy(&copy, _pc_run_fill_array, view_p, surf);
+        copy.opaque = opaque;
+        copy.clear = clear;
+        if (view_kind == VIEWKIND_COLORKEY) {
+            if (SDL_GetColorKey(surf, &colorkey) == 0) {
+                copy.run = _pc_run_colorkey_to_array;
+                copy.key = colorkey;
+            }
+        }
+        else if (view_kind != PXC_VIEWKIND_ALPHA ||
+                 mode != SDL_BLENDMODE_NONE) {
+            copy.run = _pc_get_channel_shift(format, view_kind, &copy.shift)
+                           ? _pc_run_channel_to_array
+                           : NULL;
+        }
+        if (copy.run) {
+            Py_BEGIN_ALLOW_THREADS;
+            _pc_copy(&copy);
+            Py_END_ALLOW_THREADS;
+            return 0;
+        }
+    }
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
     dz_pix = 0;
     if (_is_swapped(view_p)) {
@@ -386,6 +892,7 @@ _copy_unmapped(Py_buffer *view_p, SDL_Surface *surf)
     Py_intptr_t x, y, z;
     _pc_pixel_t pixel = {0};
     Uint8 r, g, b;
+    _pc_copy_t copy;
 
     if (view_p->shape[0] != w || view_p->shape[1] != h ||
         view_p->shape[2] != 3) {
@@ -401,6 +908,14 @@ _copy_unmapped(Py_buffer *view_p, SDL_Surface *surf)
                      intsize);
         return -1;
     }
+    if (intsize == 1 && pixelsize >= 3 && !format->Rloss && !format->Gloss &&
+        !format->Bloss) {
+        _pc_init_copy(&copy, _pc_run_rgb_to_array, view_p, surf);
+        Py_BEGIN_ALLOW_THREADS;
+        _pc_copy(&copy);
+        Py_END_ALLOW_THREADS;
+        return 0;
+    }
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
     dz_pix = 0;
     if (_is_swapped(view_p)) {
@@ -473,6 +988,7 @@ array_to_surface(PyObject *self, PyObject *arg)
     int loopx, loopy;
     Py_ssize_t stridex, stridey, stridez = 0, stridez2 = 0, sizex, sizey;
     int Rloss, Gloss, Bloss, Rshift, Gshift, Bshift;
+    _pc_copy_t copy;
 
     if (!PyArg_ParseTuple(arg, "O!O", &pgSurface_Type, &surfobj, &arrayobj)) {
         return NULL;
@@ -535,6 +1051,34 @@ array_to_surface(PyObject *self, PyObject *arg)
 
     array_data = (char *)view_p->buf;
 
+    copy.run = NULL;
+    if (_pc_is_native_int(view_p)) {
+        if (view_p->ndim == 2 &&
+            view_p->itemsize >= surf->format->BytesPerPixel) {
+            _pc_init_copy(&copy, _pc_run_mapped_to_surface, view_p, surf);
+        }
+        else if (view_p->ndim == 3 && view_p->itemsize == 1 &&
+                 (surf->format->BytesPerPixel == 2 ||
+                  surf->format->BytesPerPixel == 4)) {
+            _pc_init_copy(&copy, _pc_run_rgb_to_surface, view_p, surf);
+            if (format->Amask) {
+                copy.alpha = 255 >> format->Aloss << format->Ashift;
+            }
+        }
+    }
+    if (copy.run) {
+        copy.dx = stridex;
+        copy.dy = stridey;
+        Py_BEGIN_ALLOW_THREADS;
+        _pc_copy(&copy);
+        Py_END_ALLOW_THREADS;
+        pgBuffer_Release(&pg_view);
+        if (!pgSurface_UnlockBy(surfobj, arrayobj)) {
+            return NULL;
+        }
+        Py_RETURN_NONE;
+    }
+
     switch (surf->format->BytesPerPixel) {
         case 1:
             if (view_p->ndim == 2) {
@@ -772,33 +1316,32 @@ surface_to_array(PyObject *self, PyObject *args, PyObject *kwds)
             &surfobj, _view_kind, (void *)&view_kind, &opaque, &clear)) {
         return 0;
     }
-    if (!pgSurface_Lock(surfobj)) {
-        return 0;
-    }
-    surf = pgSurface_AsSurface(surfobj);
-
+    /* Get the target first: it may be a view that write locks surfobj */
     if (pgObject_GetBuffer(arrayobj, &pg_view, PyBUF_RECORDS)) {
-        pgSurface_Unlock(surfobj);
         return 0;
     }
     if (_validate_view_format(view_p->format)) {
         pgBuffer_Release(&pg_view);
-        pgSurface_Unlock(surfobj);
         return 0;
     }
+    if (!pgSurface_LockRead(surfobj)) {
+        pgBuffer_Release(&pg_view);
+        return 0;
+    }
+    surf = pgSurface_AsSurface(surfobj);
 
     if (view_p->ndim == 2) {
         if (view_kind == VIEWKIND_RGB) {
             if (_copy_mapped(view_p, surf)) {
                 pgBuffer_Release(&pg_view);
-                pgSurface_Unlock(surfobj);
+                pgSurface_UnlockRead(surfobj);
                 return 0;
             }
         }
         else {
             if (_copy_colorplane(view_p, surf, view_kind, opaque, clear)) {
                 pgBuffer_Release(&pg_view);
-                pgSurface_Unlock(surfobj);
+                pgSurface_UnlockRead(surfobj);
                 return 0;
             }
         }
@@ -808,25 +1351,25 @@ surface_to_array(PyObject *self, PyObject *args, PyObject *kwds)
             PyErr_SetString(PyExc_ValueError,
                             "color planes only supported for 2d targets");
             pgBuffer_Release(&pg_view);
-            pgSurface_Unlock(surfobj);
+            pgSurface_UnlockRead(surfobj);
             return 0;
         }
         if (_copy_unmapped(view_p, surf)) {
             pgBuffer_Release(&pg_view);
-            pgSurface_Unlock(surfobj);
+            pgSurface_UnlockRead(surfobj);
             return 0;
         }
     }
     else {
         pgBuffer_Release(&pg_view);
-        pgSurface_Unlock(surfobj);
+        pgSurface_UnlockRead(surfobj);
         PyErr_Format(PyExc_ValueError, "unsupported array depth %d",
                      (int)view_p->ndim);
         return 0;
     }
 
     pgBuffer_Release(&pg_view);
-    if (!pgSurface_Unlock(surfobj)) {
+    if (!pgSurface_UnlockRead(surfobj)) {
         return 0;
     }
     Py_RETURN_NONE;
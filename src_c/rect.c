@@ -32,10 +32,14 @@
 
 #include "pgcompat.h"
 
+#include "pgfreelist.h"
+
 #include <limits.h>
 
 static PyTypeObject pgRect_Type;
 #define pgRect_Check(x) ((x)->ob_type == &pgRect_Type)
+static PyTypeObject pgFRect_Type;
+#define pgFRect_Check(x) ((x)->ob_type == &pgFRect_Type)
 
 static int
 pg_rect_init(pgRectObject *, PyObject *, PyObject *);
@@ -48,6 +52,8 @@ pg_rect_init(pgRectObject *, PyObject *, PyObject *);
 const int PG_RECT_FREELIST_MAX = PG_RECT_NUM;
 static pgRectObject *pg_rect_freelist[PG_RECT_NUM];
 int pg_rect_freelist_num = -1;
+#else
+static pgFreeList pg_rect_freelist;
 #endif
 
 /* Helper method to extract 4 ints from an object.
@@ -180,7 +186,13 @@ pg_rect_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         self = (pgRectObject *)type->tp_alloc(type, 0);
     }
 #else
-    self = (pgRectObject *)type->tp_alloc(type, 0);
+    self = NULL;
+    if (type == &pgRect_Type) {
+        self = (pgRectObject *)pgFreeList_Pop(&pg_rect_freelist, type);
+    }
+    if (self == NULL) {
+        self = (pgRectObject *)type->tp_alloc(type, 0);
+    }
 #endif
 
     if (self != NULL) {
@@ -208,10 +220,81 @@ pg_rect_dealloc(pgRectObject *self)
         Py_TYPE(self)->tp_free((PyObject *)self);
     }
 #else
-    Py_TYPE(self)->tp_free((PyObject *)self);
+    if (Py_TYPE(self) != &pgRect_Type ||
+        !pgFreeList_Push(&pg_rect_freelist, (PyObject *)self)) {
+        Py_TYPE(self)->tp_free((PyObject *)self);
+    }
 #endif
 }
 
+/* The interned name of the rect attribute pgRect_FromObject() looks up. */
+static PyObject *pg_rect_attr_name = NULL;
+
+/* Reads an exact int or float item as pg_IntFromObj() does, without running
+ * any Python code to convert it. Returns 0 for any other item, or if it
+ * does not fit.
+ */
+static int
+_pg_int_from_exact(PyObject *item, int *val)
+{
+    long tmp_val;
+
+    if (PyLong_CheckExact(item)) {
+        tmp_val = PyLong_AsLong(item);
+        if (tmp_val == -1 && PyErr_Occurred()) {
+            PyErr_Clear();
+            return 0;
+        }
+        *val = (int)tmp_val;
+        return 1;
+    }
+    if (PyFloat_CheckExact(item)) {
+        *val = (int)PyFloat_AS_DOUBLE(item);
+        return 1;
+    }
+    return 0;
+}
+
+/* Reads two items of an exact tuple or list, which must be exact ints or
+ * floats. Returns 0 for anything else.
+ */
+static int
+_pg_two_ints_from_exact(PyObject **items, int *val1, int *val2)
+{
+    return _pg_int_from_exact(items[0], val1) &&
+           _pg_int_from_exact(items[1], val2);
+}
+
+/* The common case of pgRect_FromObject(), for an exact tuple or list of 4
+ * numbers or of 2 exact tuples or lists of 2 numbers. The items are read in
+ * place, as nothing is run that could change them. Returns 0 if obj is not
+ * one of those, to be read the slow way.
+ */
+static int
+_pg_rect_from_exact_seq(PyObject *obj, SDL_Rect *r)
+{
+    PyObject **items = PySequence_Fast_ITEMS(obj), *pos, *size;
+
+    switch (PySequence_Fast_GET_SIZE(obj)) {
+        case 4:
+            return _pg_two_ints_from_exact(items, &r->x, &r->y) &&
+                   _pg_two_ints_from_exact(items + 2, &r->w, &r->h);
+        case 2:
+            pos = items[0];
+            size = items[1];
+            return (PyTuple_CheckExact(pos) || PyList_CheckExact(pos)) &&
+                   (PyTuple_CheckExact(size) || PyList_CheckExact(size)) &&
+                   PySequence_Fast_GET_SIZE(pos) == 2 &&
+                   PySequence_Fast_GET_SIZE(size) == 2 &&
+                   _pg_two_ints_from_exact(PySequence_Fast_ITEMS(pos), &r->x,
+                                           &r->y) &&
+                   _pg_two_ints_from_exact(PySequence_Fast_ITEMS(size),
+                                           &r->w, &r->h);
+        default:
+            return 0;
+    }
+}
+
 static SDL_Rect *
 pgRect_FromObject(PyObject *obj, SDL_Rect *temp)
 {
@@ -221,6 +304,24 @@ pgRect_FromObject(PyObject *obj, SDL_Rect *temp)
     if (pgRect_Check(obj)) {
         return &((pgRectObject *)obj)->r;
     }
+    if (pgFRect_Check(obj)) {
+        SDL_FRect *fr = &((pgFRectObject *)obj)->r;
+
+        temp->x = (int)fr->x;
+        temp->y = (int)fr->y;
+        temp->w = (int)fr->w;
+        temp->h = (int)fr->h;
+        return temp;
+    }
+    if (PyTuple_CheckExact(obj) || PyList_CheckExact(obj)) {
+        if (_pg_rect_from_exact_seq(obj, temp)) {
+            return temp;
+        }
+        if (PyTuple_CheckExact(obj) && PyTuple_GET_SIZE(obj) == 1) {
+            /* an argument tuple */
+            return pgRect_FromObject(PyTuple_GET_ITEM(obj, 0), temp);
+        }
+    }
     if (PySequence_Check(obj) && (length = PySequence_Length(obj)) > 0) {
         if (length == 4) {
             if (!pg_IntFromObjIndex(obj, 0, &val)) {
@@ -288,10 +389,11 @@ pgRect_FromObject(PyObject *obj, SDL_Rect *temp)
             }
         }
     }
-    if (PyObject_HasAttrString(obj, "rect")) {
+    /* a single lookup, as anything not found is no rect anyway */
+    {
         PyObject *rectattr;
         SDL_Rect *returnrect;
-        rectattr = PyObject_GetAttrString(obj, "rect");
+        rectattr = PyObject_GetAttr(obj, pg_rect_attr_name);
         if (rectattr == NULL) {
             PyErr_Clear();
             return NULL;
@@ -310,7 +412,6 @@ pgRect_FromObject(PyObject *obj, SDL_Rect *temp)
         Py_DECREF(rectattr);
         return returnrect;
     }
-    return NULL;
 }
 
 static PyObject *
@@ -947,17 +1048,14 @@ pg_rect_collidedictall(pgRectObject *self, PyObject *args)
     return ret;
 }
 
-static PyObject *
-pg_rect_clip(pgRectObject *self, PyObject *args)
+/* Crops A to the part of it inside B. If they do not intersect, A is left
+ * at its position with a size of 0.
+ */
+static void
+_pg_rect_clip(SDL_Rect *A, SDL_Rect *B)
 {
-    SDL_Rect *A, *B, temp;
     int x, y, w, h;
 
-    A = &self->r;
-    if (!(B = pgRect_FromObject(args, &temp))) {
-        return RAISE(PyExc_TypeError, "Argument must be rect style object");
-    }
-
     /* Left */
     if ((A->x >= B->x) && (A->x < (B->x + B->w))) {
         x = A->x;
@@ -994,10 +1092,27 @@ pg_rect_clip(pgRectObject *self, PyObject *args)
     else
         goto nointersect;
 
-    return _pg_rect_subtype_new4(Py_TYPE(self), x, y, w, h);
+    A->x = x;
+    A->y = y;
+    A->w = w;
+    A->h = h;
+    return;
 
 nointersect:
-    return _pg_rect_subtype_new4(Py_TYPE(self), A->x, A->y, 0, 0);
+    A->w = A->h = 0;
+}
+
+static PyObject *
+pg_rect_clip(pgRectObject *self, PyObject *args)
+{
+    SDL_Rect *B, temp, A = self->r;
+
+    if (!(B = pgRect_FromObject(args, &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+
+    _pg_rect_clip(&A, B);
+    return _pg_rect_subtype_new4(Py_TYPE(self), A.x, A.y, A.w, A.h);
 }
 
 /* clipline() - crops the given line within the rect
@@ -1148,37 +1263,38 @@ pg_rect_contains_seq(pgRectObject *self, PyObject *arg)
     return ret;
 }
 
+/* Moves r inside of area, or centers it on area if it is too large. */
+static void
+_pg_rect_clamp(SDL_Rect *r, SDL_Rect *area)
+{
+    if (r->w >= area->w) {
+        r->x = area->x + area->w / 2 - r->w / 2;
+    }
+    else if (r->x < area->x)
+        r->x = area->x;
+    else if (r->x + r->w > area->x + area->w)
+        r->x = area->x + area->w - r->w;
+
+    if (r->h >= area->h) {
+        r->y = area->y + area->h / 2 - r->h / 2;
+    }
+    else if (r->y < area->y)
+        r->y = area->y;
+    else if (r->y + r->h > area->y + area->h)
+        r->y = area->y + area->h - r->h;
+}
+
 static PyObject *
 pg_rect_clamp(pgRectObject *self, PyObject *args)
 {
-    SDL_Rect *argrect, temp;
-    int x, y;
+    SDL_Rect *argrect, temp, r = self->r;
 
     if (!(argrect = pgRect_FromObject(args, &temp))) {
         return RAISE(PyExc_TypeError, "Argument must be rect style object");
     }
 
-    if (self->r.w >= argrect->w) {
-        x = argrect->x + argrect->w / 2 - self->r.w / 2;
-    }
-    else if (self->r.x < argrect->x)
-        x = argrect->x;
-    else if (self->r.x + self->r.w > argrect->x + argrect->w)
-        x = argrect->x + argrect->w - self->r.w;
-    else
-        x = self->r.x;
-
-    if (self->r.h >= argrect->h) {
-        y = argrect->y + argrect->h / 2 - self->r.h / 2;
-    }
-    else if (self->r.y < argrect->y)
-        y = argrect->y;
-    else if (self->r.y + self->r.h > argrect->y + argrect->h)
-        y = argrect->y + argrect->h - self->r.h;
-    else
-        y = self->r.y;
-
-    return _pg_rect_subtype_new4(Py_TYPE(self), x, y, self->r.w, self->r.h);
+    _pg_rect_clamp(&r, argrect);
+    return _pg_rect_subtype_new4(Py_TYPE(self), r.x, r.y, r.w, r.h);
 }
 
 static PyObject *
@@ -1209,34 +1325,12 @@ static PyObject *
 pg_rect_clamp_ip(pgRectObject *self, PyObject *args)
 {
     SDL_Rect *argrect, temp;
-    int x, y;
 
     if (!(argrect = pgRect_FromObject(args, &temp))) {
         return RAISE(PyExc_TypeError, "Argument must be rect style object");
     }
 
-    if (self->r.w >= argrect->w) {
-        x = argrect->x + argrect->w / 2 - self->r.w / 2;
-    }
-    else if (self->r.x < argrect->x)
-        x = argrect->x;
-    else if (self->r.x + self->r.w > argrect->x + argrect->w)
-        x = argrect->x + argrect->w - self->r.w;
-    else
-        x = self->r.x;
-
-    if (self->r.h >= argrect->h) {
-        y = argrect->y + argrect->h / 2 - self->r.h / 2;
-    }
-    else if (self->r.y < argrect->y)
-        y = argrect->y;
-    else if (self->r.y + self->r.h > argrect->y + argrect->h)
-        y = argrect->y + argrect->h - self->r.h;
-    else
-        y = self->r.y;
-
-    self->r.x = x;
-    self->r.y = y;
+    _pg_rect_clamp(&self->r, argrect);
     Py_RETURN_NONE;
 }
 
@@ -1553,6 +1647,11 @@ pg_rect_richcompare(PyObject *o1, PyObject *o2, int opid)
     SDL_Rect *o1rect, *o2rect, temp1, temp2;
     int cmp;
 
+    if (pgFRect_Check(o1) || pgFRect_Check(o2)) {
+        /* compared by FRect, without truncating it */
+        goto Unimplemented;
+    }
+
     o1rect = pgRect_FromObject(o1, &temp1);
     if (!o1rect) {
         goto Unimplemented;
@@ -2189,53 +2288,2967 @@ pg_rect_init(pgRectObject *self, PyObject *args, PyObject *kwds)
     return 0;
 }
 
-static PyMethodDef _pg_module_methods[] = {{NULL, NULL, 0, NULL}};
+/* FRect: Rect with float fields, for positions between pixels. Everything
+ * taking a rect also takes an FRect, truncating its fields as it does for
+ * float sequences.
+ */
+static PyObject *
+_pg_frect_subtype_new4(PyTypeObject *type, float x, float y, float w,
+                       float h)
+{
+    pgFRectObject *rect = (pgFRectObject *)type->tp_alloc(type, 0);
 
-/*DOC*/ static char _pg_module_doc[] =
-    /*DOC*/ "Module for the rectangle object\n";
+    if (rect) {
+        rect->r.x = x;
+        rect->r.y = y;
+        rect->r.w = w;
+        rect->r.h = h;
+        rect->weakreflist = NULL;
+    }
+    return (PyObject *)rect;
+}
 
-MODINIT_DEFINE(rect)
+static PyObject *
+pg_frect_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
-    PyObject *module, *apiobj;
-    static void *c_api[PYGAMEAPI_RECT_NUMSLOTS];
+    return _pg_frect_subtype_new4(type, 0.0f, 0.0f, 0.0f, 0.0f);
+}
 
-    static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
-                                         "rect",
-                                         _pg_module_doc,
-                                         -1,
-                                         _pg_module_methods,
-                                         NULL,
-                                         NULL,
-                                         NULL,
-                                         NULL};
+static void
+pg_frect_dealloc(pgFRectObject *self)
+{
+    if (self->weakreflist != NULL) {
+        PyObject_ClearWeakRefs((PyObject *)self);
+    }
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
 
-    /* import needed apis; Do this first so if there is an error
-       the module is not loaded.
-    */
-    import_pygame_base();
+static SDL_FRect *
+pgFRect_FromObject(PyObject *obj, SDL_FRect *temp)
+{
+    float val;
+    Py_ssize_t length;
+
+    if (pgFRect_Check(obj)) {
+        return &((pgFRectObject *)obj)->r;
+    }
+    if (pgRect_Check(obj)) {
+        SDL_Rect *r = &((pgRectObject *)obj)->r;
+
+        temp->x = (float)r->x;
+        temp->y = (float)r->y;
+        temp->w = (float)r->w;
+        temp->h = (float)r->h;
+        return temp;
+    }
+    if (PySequence_Check(obj) && (length = PySequence_Length(obj)) > 0) {
+        if (length == 4) {
+            if (!pg_FloatFromObjIndex(obj, 0, &val)) {
+                return NULL;
+            }
+            temp->x = val;
+            if (!pg_FloatFromObjIndex(obj, 1, &val)) {
+                return NULL;
+            }
+            temp->y = val;
+            if (!pg_FloatFromObjIndex(obj, 2, &val)) {
+                return NULL;
+            }
+            temp->w = val;
+            if (!pg_FloatFromObjIndex(obj, 3, &val)) {
+                return NULL;
+            }
+            temp->h = val;
+            return temp;
+        }
+        if (length == 2) {
+            PyObject *sub = PySequence_GetItem(obj, 0);
+            int ok;
+
+            if (!sub) {
+                PyErr_Clear();
+                return NULL;
+            }
+            ok = pg_TwoFloatsFromObj(sub, &temp->x, &temp->y);
+            Py_DECREF(sub);
+            if (!ok) {
+                return NULL;
+            }
+
+            sub = PySequence_GetItem(obj, 1);
+            if (!sub) {
+                PyErr_Clear();
+                return NULL;
+            }
+            ok = pg_TwoFloatsFromObj(sub, &temp->w, &temp->h);
+            Py_DECREF(sub);
+            return ok ? temp : NULL;
+        }
+        if (PyTuple_Check(obj) && length == 1) /*looks like an arg?*/ {
+            return pgFRect_FromObject(PyTuple_GET_ITEM(obj, 0), temp);
+        }
+    }
     if (PyErr_Occurred()) {
-        return NULL;
+        PyErr_Clear();
+    }
+    {
+        PyObject *rectattr;
+        SDL_FRect *returnrect;
+        rectattr = PyObject_GetAttr(obj, pg_rect_attr_name);
+        if (rectattr == NULL) {
+            PyErr_Clear();
+            return NULL;
+        }
+        if (PyCallable_Check(rectattr)) /*call if it's a method*/
+        {
+            PyObject *rectresult = PyObject_CallObject(rectattr, NULL);
+            Py_DECREF(rectattr);
+            if (rectresult == NULL) {
+                PyErr_Clear();
+                return NULL;
+            }
+            rectattr = rectresult;
+        }
+        returnrect = pgFRect_FromObject(rectattr, temp);
+        Py_DECREF(rectattr);
+        return returnrect;
     }
+}
 
-    /* Create the module and add the functions */
-    if (PyType_Ready(&pgRect_Type) < 0) {
-        return NULL;
+static PyObject *
+pgFRect_New4(float x, float y, float w, float h)
+{
+    return _pg_frect_subtype_new4(&pgFRect_Type, x, y, w, h);
+}
+
+static int
+_pg_do_frects_intersect(SDL_FRect *A, SDL_FRect *B)
+{
+    if (A->w == 0 || A->h == 0 || B->w == 0 || B->h == 0) {
+        return 0;
     }
+    return (MIN(A->x, A->x + A->w) < MAX(B->x, B->x + B->w) &&
+            MIN(A->y, A->y + A->h) < MAX(B->y, B->y + B->h) &&
+            MAX(A->x, A->x + A->w) > MIN(B->x, B->x + B->w) &&
+            MAX(A->y, A->y + A->h) > MIN(B->y, B->y + B->h));
+}
 
-    module = PyModule_Create(&_module);
-    if (module == NULL) {
-        return NULL;
+static PyObject *
+pg_frect_normalize(pgFRectObject *self, PyObject *_null)
+{
+    if (self->r.w < 0) {
+        self->r.x += self->r.w;
+        self->r.w = -self->r.w;
     }
+    if (self->r.h < 0) {
+        self->r.y += self->r.h;
+        self->r.h = -self->r.h;
+    }
+    Py_RETURN_NONE;
+}
 
-    Py_INCREF(&pgRect_Type);
-    if (PyModule_AddObject(module, "RectType", (PyObject *)&pgRect_Type)) {
-        Py_DECREF(&pgRect_Type);
-        Py_DECREF(module);
-        return NULL;
+static PyObject *
+pg_frect_move(pgFRectObject *self, PyObject *args)
+{
+    float x = 0, y = 0;
+
+    if (!pg_TwoFloatsFromObj(args, &x, &y)) {
+        return RAISE(PyExc_TypeError, "argument must contain two numbers");
     }
-    Py_INCREF(&pgRect_Type);
-    if (PyModule_AddObject(module, "Rect", (PyObject *)&pgRect_Type)) {
-        Py_DECREF(&pgRect_Type);
+
+    return _pg_frect_subtype_new4(Py_TYPE(self), self->r.x + x,
+                                  self->r.y + y, self->r.w, self->r.h);
+}
+
+static PyObject *
+pg_frect_move_ip(pgFRectObject *self, PyObject *args)
+{
+    float x = 0, y = 0;
+
+    if (!pg_TwoFloatsFromObj(args, &x, &y)) {
+        return RAISE(PyExc_TypeError, "argument must contain two numbers");
+    }
+
+    self->r.x += x;
+    self->r.y += y;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_frect_inflate(pgFRectObject *self, PyObject *args)
+{
+    float x = 0, y = 0;
+
+    if (!pg_TwoFloatsFromObj(args, &x, &y)) {
+        return RAISE(PyExc_TypeError, "argument must contain two numbers");
+    }
+
+    return _pg_frect_subtype_new4(Py_TYPE(self), self->r.x - x / 2,
+                                  self->r.y - y / 2, self->r.w + x,
+                                  self->r.h + y);
+}
+
+static PyObject *
+pg_frect_inflate_ip(pgFRectObject *self, PyObject *args)
+{
+    float x = 0, y = 0;
+
+    if (!pg_TwoFloatsFromObj(args, &x, &y)) {
+        return RAISE(PyExc_TypeError, "argument must contain two numbers");
+    }
+    self->r.x -= x / 2;
+    self->r.y -= y / 2;
+    self->r.w += x;
+    self->r.h += y;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_frect_update(pgFRectObject *self, PyObject *args)
+{
+    SDL_FRect temp;
+    SDL_FRect *argrect = pgFRect_FromObject(args, &temp);
+
+    if (argrect == NULL) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    self->r = *argrect;
+    Py_RETURN_NONE;
+}
+
+/* Sets r to the union of r and B. */
+static void
+_pg_frect_union(SDL_FRect *r, SDL_FRect *B)
+{
+    float x = MIN(r->x, B->x);
+    float y = MIN(r->y, B->y);
+
+    r->w = MAX(r->x + r->w, B->x + B->w) - x;
+    r->h = MAX(r->y + r->h, B->y + B->h) - y;
+    r->x = x;
+    r->y = y;
+}
+
+static PyObject *
+pg_frect_union(pgFRectObject *self, PyObject *args)
+{
+    SDL_FRect *argrect, temp, r = self->r;
+
+    if (!(argrect = pgFRect_FromObject(args, &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    _pg_frect_union(&r, argrect);
+    return _pg_frect_subtype_new4(Py_TYPE(self), r.x, r.y, r.w, r.h);
+}
+
+static PyObject *
+pg_frect_union_ip(pgFRectObject *self, PyObject *args)
+{
+    SDL_FRect *argrect, temp;
+
+    if (!(argrect = pgFRect_FromObject(args, &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    _pg_frect_union(&self->r, argrect);
+    Py_RETURN_NONE;
+}
+
+/* Sets r to the union of r and the rects of the sequence in args.
+ * Returns 0 with an exception set on failure.
+ */
+static int
+_pg_frect_unionall(SDL_FRect *r, PyObject *args)
+{
+    SDL_FRect *argrect, temp;
+    Py_ssize_t loop, size;
+    PyObject *list, *obj;
+
+    if (!PyArg_ParseTuple(args, "O", &list)) {
+        return 0;
+    }
+    if (!PySequence_Check(list)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "Argument must be a sequence of rectstyle objects.");
+        return 0;
+    }
+
+    size = PySequence_Length(list);
+    if (size < 0) {
+        return 0;
+    }
+    for (loop = 0; loop < size; ++loop) {
+        obj = PySequence_GetItem(list, loop);
+        if (!obj || !(argrect = pgFRect_FromObject(obj, &temp))) {
+            Py_XDECREF(obj);
+            PyErr_SetString(
+                PyExc_TypeError,
+                "Argument must be a sequence of rectstyle objects.");
+            return 0;
+        }
+        _pg_frect_union(r, argrect);
+        Py_DECREF(obj);
+    }
+    return 1;
+}
+
+static PyObject *
+pg_frect_unionall(pgFRectObject *self, PyObject *args)
+{
+    SDL_FRect r = self->r;
+
+    if (!_pg_frect_unionall(&r, args)) {
+        return NULL;
+    }
+    return _pg_frect_subtype_new4(Py_TYPE(self), r.x, r.y, r.w, r.h);
+}
+
+static PyObject *
+pg_frect_unionall_ip(pgFRectObject *self, PyObject *args)
+{
+    SDL_FRect r = self->r;
+
+    if (!_pg_frect_unionall(&r, args)) {
+        return NULL;
+    }
+    self->r = r;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_frect_collidepoint(pgFRectObject *self, PyObject *args)
+{
+    float x = 0, y = 0;
+    int inside;
+
+    if (!pg_TwoFloatsFromObj(args, &x, &y)) {
+        return RAISE(PyExc_TypeError, "argument must contain two numbers");
+    }
+
+    inside = x >= self->r.x && x < self->r.x + self->r.w && y >= self->r.y &&
+             y < self->r.y + self->r.h;
+
+    return PyBool_FromLong(inside);
+}
+
+static PyObject *
+pg_frect_colliderect(pgFRectObject *self, PyObject *args)
+{
+    SDL_FRect *argrect, temp;
+
+    if (!(argrect = pgFRect_FromObject(args, &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    return PyBool_FromLong(_pg_do_frects_intersect(&self->r, argrect));
+}
+
+/* Returns the index of the first rect of the sequence in args colliding
+ * with self, or -1 if none does. With all set, returns the list of the
+ * indices of all of them instead.
+ */
+static PyObject *
+_pg_frect_collidelist(pgFRectObject *self, PyObject *args, int all)
+{
+    SDL_FRect *argrect, temp;
+    Py_ssize_t loop, size;
+    PyObject *list, *obj, *ret = NULL;
+
+    if (!PyArg_ParseTuple(args, "O", &list)) {
+        return NULL;
+    }
+    if (!PySequence_Check(list)) {
+        return RAISE(PyExc_TypeError,
+                     "Argument must be a sequence of rectstyle objects.");
+    }
+    if (all && !(ret = PyList_New(0))) {
+        return NULL;
+    }
+
+    size = PySequence_Length(list);
+    if (size < 0) {
+        Py_XDECREF(ret);
+        return NULL;
+    }
+    for (loop = 0; loop < size; ++loop) {
+        obj = PySequence_GetItem(list, loop);
+        if (!obj || !(argrect = pgFRect_FromObject(obj, &temp))) {
+            Py_XDECREF(obj);
+            Py_XDECREF(ret);
+            return RAISE(PyExc_TypeError,
+                         "Argument must be a sequence of rectstyle objects.");
+        }
+        Py_DECREF(obj);
+
+        if (_pg_do_frects_intersect(&self->r, argrect)) {
+            PyObject *num = PyLong_FromSsize_t(loop);
+
+            if (!all) {
+                return num;
+            }
+            if (!num || PyList_Append(ret, num)) {
+                Py_XDECREF(num);
+                Py_DECREF(ret);
+                return NULL;
+            }
+            Py_DECREF(num);
+        }
+    }
+    return all ? ret : PyLong_FromLong(-1);
+}
+
+static PyObject *
+pg_frect_collidelist(pgFRectObject *self, PyObject *args)
+{
+    return _pg_frect_collidelist(self, args, 0);
+}
+
+static PyObject *
+pg_frect_collidelistall(pgFRectObject *self, PyObject *args)
+{
+    return _pg_frect_collidelist(self, args, 1);
+}
+
+/* Returns the first object of the list argument colliding with self, or
+ * None if none does, or with all set the list of all of them. Each object
+ * is passed through the optional key function first.
+ */
+static PyObject *
+_pg_frect_collideobjects(pgFRectObject *self, PyObject *args,
+                         PyObject *kwargs, int all)
+{
+    SDL_FRect *argrect, temp;
+    Py_ssize_t loop, size;
+    PyObject *list, *obj, *ret = NULL;
+    PyObject *keyfunc = NULL;
+    static char *keywords[] = {"list", "key", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|$O", keywords, &list,
+                                     &keyfunc)) {
+        return NULL;
+    }
+    if (!PySequence_Check(list)) {
+        return RAISE(PyExc_TypeError,
+                     "Argument must be a sequence of objects.");
+    }
+    if (keyfunc == Py_None) {
+        keyfunc = NULL;
+    }
+    if (keyfunc && !PyCallable_Check(keyfunc)) {
+        return RAISE(PyExc_TypeError,
+                     "Key function must be callable with one argument.");
+    }
+    if (all && !(ret = PyList_New(0))) {
+        return NULL;
+    }
+
+    size = PySequence_Length(list);
+    if (size < 0) {
+        Py_XDECREF(ret);
+        return NULL;
+    }
+    for (loop = 0; loop < size; ++loop) {
+        PyObject *obj_with_rect;
+
+        if (!(obj = PySequence_GetItem(list, loop))) {
+            Py_XDECREF(ret);
+            return NULL;
+        }
+        if (keyfunc) {
+            obj_with_rect = PyObject_CallFunctionObjArgs(keyfunc, obj, NULL);
+            if (!obj_with_rect) {
+                Py_DECREF(obj);
+                Py_XDECREF(ret);
+                return NULL;
+            }
+        }
+        else {
+            obj_with_rect = obj;
+            Py_INCREF(obj_with_rect);
+        }
+        argrect = pgFRect_FromObject(obj_with_rect, &temp);
+        Py_DECREF(obj_with_rect);
+        if (!argrect) {
+            Py_DECREF(obj);
+            Py_XDECREF(ret);
+            return RAISE(PyExc_TypeError,
+                         keyfunc ? "Key function must return rect or "
+                                   "rect-like objects"
+                                 : "Sequence must contain rect or rect-like "
+                                   "objects");
+        }
+
+        if (_pg_do_frects_intersect(&self->r, argrect)) {
+            if (!all) {
+                return obj;
+            }
+            if (PyList_Append(ret, obj)) {
+                Py_DECREF(obj);
+                Py_DECREF(ret);
+                return NULL;
+            }
+        }
+        Py_DECREF(obj);
+    }
+    if (!all) {
+        Py_RETURN_NONE;
+    }
+    return ret;
+}
+
+static PyObject *
+pg_frect_collideobjects(pgFRectObject *self, PyObject *args,
+                        PyObject *kwargs)
+{
+    return _pg_frect_collideobjects(self, args, kwargs, 0);
+}
+
+static PyObject *
+pg_frect_collideobjectsall(pgFRectObject *self, PyObject *args,
+                           PyObject *kwargs)
+{
+    return _pg_frect_collideobjects(self, args, kwargs, 1);
+}
+
+/* Returns the first (key, value) pair of the dict argument colliding with
+ * self, or None if none does, or with all set the list of all of them.
+ */
+static PyObject *
+_pg_frect_collidedict(pgFRectObject *self, PyObject *args, int all)
+{
+    SDL_FRect *argrect, temp;
+    Py_ssize_t loop = 0;
+    Py_ssize_t values = 0; /* Defaults to expecting keys as rects. */
+    PyObject *dict, *key, *val, *ret = NULL;
+
+    if (!PyArg_ParseTuple(args, "O|n", &dict, &values)) {
+        return NULL;
+    }
+    if (!PyDict_Check(dict)) {
+        return RAISE(PyExc_TypeError, "first argument must be a dict");
+    }
+    if (all && !(ret = PyList_New(0))) {
+        return NULL;
+    }
+
+    while (PyDict_Next(dict, &loop, &key, &val)) {
+        if (!(argrect = pgFRect_FromObject(values ? val : key, &temp))) {
+            Py_XDECREF(ret);
+            return RAISE(PyExc_TypeError,
+                         values ? "dict must have rectstyle values"
+                                : "dict must have rectstyle keys");
+        }
+
+        if (_pg_do_frects_intersect(&self->r, argrect)) {
+            PyObject *pair = Py_BuildValue("(OO)", key, val);
+
+            if (!all) {
+                return pair;
+            }
+            if (!pair || PyList_Append(ret, pair)) {
+                Py_XDECREF(pair);
+                Py_DECREF(ret);
+                return NULL;
+            }
+            Py_DECREF(pair);
+        }
+    }
+    if (!all) {
+        Py_RETURN_NONE;
+    }
+    return ret;
+}
+
+static PyObject *
+pg_frect_collidedict(pgFRectObject *self, PyObject *args)
+{
+    return _pg_frect_collidedict(self, args, 0);
+}
+
+static PyObject *
+pg_frect_collidedictall(pgFRectObject *self, PyObject *args)
+{
+    return _pg_frect_collidedict(self, args, 1);
+}
+
+/* Crops A to the part of it inside B, as _pg_rect_clip(). */
+static void
+_pg_frect_clip(SDL_FRect *A, SDL_FRect *B)
+{
+    float x, y, w, h;
+
+    /* Left */
+    if ((A->x >= B->x) && (A->x < (B->x + B->w)))
+        x = A->x;
+    else if ((B->x >= A->x) && (B->x < (A->x + A->w)))
+        x = B->x;
+    else
+        goto nointersect;
+
+    /* Right */
+    if (((A->x + A->w) > B->x) && ((A->x + A->w) <= (B->x + B->w)))
+        w = (A->x + A->w) - x;
+    else if (((B->x + B->w) > A->x) && ((B->x + B->w) <= (A->x + A->w)))
+        w = (B->x + B->w) - x;
+    else
+        goto nointersect;
+
+    /* Top */
+    if ((A->y >= B->y) && (A->y < (B->y + B->h)))
+        y = A->y;
+    else if ((B->y >= A->y) && (B->y < (A->y + A->h)))
+        y = B->y;
+    else
+        goto nointersect;
+
+    /* Bottom */
+    if (((A->y + A->h) > B->y) && ((A->y + A->h) <= (B->y + B->h)))
+        h = (A->y + A->h) - y;
+    else if (((B->y + B->h) > A->y) && ((B->y + B->h) <= (A->y + A->h)))
+        h = (B->y + B->h) - y;
+    else
+        goto nointersect;
+
+    A->x = x;
+    A->y = y;
+    A->w = w;
+    A->h = h;
+    return;
+
+nointersect:
+    A->w = A->h = 0;
+}
+
+static PyObject *
+pg_frect_clip(pgFRectObject *self, PyObject *args)
+{
+    SDL_FRect *B, temp, A = self->r;
+
+    if (!(B = pgFRect_FromObject(args, &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+
+    _pg_frect_clip(&A, B);
+    return _pg_frect_subtype_new4(Py_TYPE(self), A.x, A.y, A.w, A.h);
+}
+
+static int
+_pg_frect_contains(pgFRectObject *self, PyObject *arg)
+{
+    SDL_FRect *argrect, temp_arg;
+
+    if (!(argrect = pgFRect_FromObject(arg, &temp_arg))) {
+        return -1;
+    }
+    return (self->r.x <= argrect->x) && (self->r.y <= argrect->y) &&
+           (self->r.x + self->r.w >= argrect->x + argrect->w) &&
+           (self->r.y + self->r.h >= argrect->y + argrect->h) &&
+           (self->r.x + self->r.w > argrect->x) &&
+           (self->r.y + self->r.h > argrect->y);
+}
+
+static PyObject *
+pg_frect_contains(pgFRectObject *self, PyObject *arg)
+{
+    int ret = _pg_frect_contains(self, arg);
+
+    if (ret < 0) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    return PyBool_FromLong(ret);
+}
+
+static int
+pg_frect_contains_seq(pgFRectObject *self, PyObject *arg)
+{
+    int ret;
+
+    if (PyLong_Check(arg) || PyFloat_Check(arg)) {
+        double coord = PyFloat_AsDouble(arg);
+
+        if (coord == -1.0 && PyErr_Occurred()) {
+            return -1;
+        }
+        return coord == self->r.x || coord == self->r.y ||
+               coord == self->r.w || coord == self->r.h;
+    }
+    ret = _pg_frect_contains(self, arg);
+    if (ret < 0) {
+        PyErr_SetString(PyExc_TypeError,
+                        "'in <pygame.FRect>' requires rect style object"
+                        " or number as left operand");
+    }
+    return ret;
+}
+
+/* Moves r inside of area, or centers it on area if it is too large. */
+static void
+_pg_frect_clamp(SDL_FRect *r, SDL_FRect *area)
+{
+    if (r->w >= area->w)
+        r->x = area->x + area->w / 2 - r->w / 2;
+    else if (r->x < area->x)
+        r->x = area->x;
+    else if (r->x + r->w > area->x + area->w)
+        r->x = area->x + area->w - r->w;
+
+    if (r->h >= area->h)
+        r->y = area->y + area->h / 2 - r->h / 2;
+    else if (r->y < area->y)
+        r->y = area->y;
+    else if (r->y + r->h > area->y + area->h)
+        r->y = area->y + area->h - r->h;
+}
+
+static PyObject *
+pg_frect_clamp(pgFRectObject *self, PyObject *args)
+{
+    SDL_FRect *argrect, temp, r = self->r;
+
+    if (!(argrect = pgFRect_FromObject(args, &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+
+    _pg_frect_clamp(&r, argrect);
+    return _pg_frect_subtype_new4(Py_TYPE(self), r.x, r.y, r.w, r.h);
+}
+
+static PyObject *
+pg_frect_clamp_ip(pgFRectObject *self, PyObject *args)
+{
+    SDL_FRect *argrect, temp;
+
+    if (!(argrect = pgFRect_FromObject(args, &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+
+    _pg_frect_clamp(&self->r, argrect);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_frect_fit(pgFRectObject *self, PyObject *args)
+{
+    SDL_FRect *argrect, temp;
+    float w, h, xratio, yratio, maxratio;
+
+    if (!(argrect = pgFRect_FromObject(args, &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+
+    xratio = self->r.w / argrect->w;
+    yratio = self->r.h / argrect->h;
+    maxratio = (xratio > yratio) ? xratio : yratio;
+
+    w = self->r.w / maxratio;
+    h = self->r.h / maxratio;
+
+    return _pg_frect_subtype_new4(Py_TYPE(self),
+                                  argrect->x + (argrect->w - w) / 2,
+                                  argrect->y + (argrect->h - h) / 2, w, h);
+}
+
+/* for pickling */
+static PyObject *
+pg_frect_reduce(pgFRectObject *self, PyObject *_null)
+{
+    return Py_BuildValue("(O(ffff))", Py_TYPE(self), self->r.x, self->r.y,
+                         self->r.w, self->r.h);
+}
+
+/* for copy module */
+static PyObject *
+pg_frect_copy(pgFRectObject *self, PyObject *_null)
+{
+    return _pg_frect_subtype_new4(Py_TYPE(self), self->r.x, self->r.y,
+                                  self->r.w, self->r.h);
+}
+
+static struct PyMethodDef pg_frect_methods[] = {
+    {"normalize", (PyCFunction)pg_frect_normalize, METH_NOARGS,
+     DOC_RECTNORMALIZE},
+    {"clip", (PyCFunction)pg_frect_clip, METH_VARARGS, DOC_RECTCLIP},
+    {"clamp", (PyCFunction)pg_frect_clamp, METH_VARARGS, DOC_RECTCLAMP},
+    {"clamp_ip", (PyCFunction)pg_frect_clamp_ip, METH_VARARGS,
+     DOC_RECTCLAMPIP},
+    {"copy", (PyCFunction)pg_frect_copy, METH_NOARGS, DOC_RECTCOPY},
+    {"fit", (PyCFunction)pg_frect_fit, METH_VARARGS, DOC_RECTFIT},
+    {"move", (PyCFunction)pg_frect_move, METH_VARARGS, DOC_RECTMOVE},
+    {"update", (PyCFunction)pg_frect_update, METH_VARARGS, DOC_RECTUPDATE},
+    {"inflate", (PyCFunction)pg_frect_inflate, METH_VARARGS,
+     DOC_RECTINFLATE},
+    {"union", (PyCFunction)pg_frect_union, METH_VARARGS, DOC_RECTUNION},
+    {"unionall", (PyCFunction)pg_frect_unionall, METH_VARARGS,
+     DOC_RECTUNIONALL},
+    {"move_ip", (PyCFunction)pg_frect_move_ip, METH_VARARGS,
+     DOC_RECTMOVEIP},
+    {"inflate_ip", (PyCFunction)pg_frect_inflate_ip, METH_VARARGS,
+     DOC_RECTINFLATEIP},
+    {"union_ip", (PyCFunction)pg_frect_union_ip, METH_VARARGS,
+     DOC_RECTUNIONIP},
+    {"unionall_ip", (PyCFunction)pg_frect_unionall_ip, METH_VARARGS,
+     DOC_RECTUNIONALLIP},
+    {"collidepoint", (PyCFunction)pg_frect_collidepoint, METH_VARARGS,
+     DOC_RECTCOLLIDEPOINT},
+    {"colliderect", (PyCFunction)pg_frect_colliderect, METH_VARARGS,
+     DOC_RECTCOLLIDERECT},
+    {"collidelist", (PyCFunction)pg_frect_collidelist, METH_VARARGS,
+     DOC_RECTCOLLIDELIST},
+    {"collidelistall", (PyCFunction)pg_frect_collidelistall, METH_VARARGS,
+     DOC_RECTCOLLIDELISTALL},
+    {"collideobjectsall", (PyCFunction)pg_frect_collideobjectsall,
+     METH_VARARGS | METH_KEYWORDS, DOC_RECTCOLLIDEOBJECTSALL},
+    {"collideobjects", (PyCFunction)pg_frect_collideobjects,
+     METH_VARARGS | METH_KEYWORDS, DOC_RECTCOLLIDEOBJECTS},
+    {"collidedict", (PyCFunction)pg_frect_collidedict, METH_VARARGS,
+     DOC_RECTCOLLIDEDICT},
+    {"collidedictall", (PyCFunction)pg_frect_collidedictall, METH_VARARGS,
+     DOC_RECTCOLLIDEDICTALL},
+    {"contains", (PyCFunction)pg_frect_contains, METH_VARARGS,
+     DOC_RECTCONTAINS},
+    {"__reduce__", (PyCFunction)pg_frect_reduce, METH_NOARGS, NULL},
+    {"__copy__", (PyCFunction)pg_frect_copy, METH_NOARGS, NULL},
+    {NULL, NULL, 0, NULL}};
+
+/* sequence functions */
+
+static PyObject *
+pg_frect_item(pgFRectObject *self, Py_ssize_t i)
+{
+    float *data = (float *)&self->r;
+
+    if (i < 0 || i > 3) {
+        if (i > -5 && i < 0) {
+            i += 4;
+        }
+        else {
+            return RAISE(PyExc_IndexError, "Invalid rect Index");
+        }
+    }
+    return PyFloat_FromDouble(data[i]);
+}
+
+static int
+pg_frect_ass_item(pgFRectObject *self, Py_ssize_t i, PyObject *v)
+{
+    float val = 0;
+    float *data = (float *)&self->r;
+
+    if (i < 0 || i > 3) {
+        if (i > -5 && i < 0) {
+            i += 4;
+        }
+        else {
+            PyErr_SetString(PyExc_IndexError, "Invalid rect Index");
+            return -1;
+        }
+    }
+    if (!v) {
+        PyErr_SetString(PyExc_TypeError, "item deletion is not supported");
+        return -1;
+    }
+    if (!pg_FloatFromObj(v, &val)) {
+        PyErr_SetString(PyExc_TypeError, "Must assign numeric values");
+        return -1;
+    }
+    data[i] = val;
+    return 0;
+}
+
+static PySequenceMethods pg_frect_as_sequence = {
+    .sq_length = pg_rect_length,
+    .sq_item = (ssizeargfunc)pg_frect_item,
+    .sq_ass_item = (ssizeobjargproc)pg_frect_ass_item,
+    .sq_contains = (objobjproc)pg_frect_contains_seq,
+};
+
+/* Finds the fields picked by op, an index, a slice or Ellipsis for all of
+ * them. Returns -1 with an exception set on failure.
+ */
+static int
+_pg_frect_slice(PyObject *op, Py_ssize_t *start, Py_ssize_t *step,
+                Py_ssize_t *slicelen)
+{
+    Py_ssize_t stop;
+
+    if (op == Py_Ellipsis) {
+        *start = 0;
+        *step = 1;
+        *slicelen = 4;
+        return 0;
+    }
+    if (PySlice_Check(op)) {
+        return PySlice_GetIndicesEx(op, 4, start, &stop, step, slicelen);
+    }
+    PyErr_SetString(PyExc_TypeError, "Invalid FRect slice");
+    return -1;
+}
+
+static PyObject *
+pg_frect_subscript(pgFRectObject *self, PyObject *op)
+{
+    float *data = (float *)&self->r;
+    Py_ssize_t start, step, slicelen, i;
+    PyObject *slice;
+
+    if (PyIndex_Check(op)) {
+        i = PyNumber_AsSsize_t(op, PyExc_IndexError);
+        if (i == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        return pg_frect_item(self, i);
+    }
+    if (_pg_frect_slice(op, &start, &step, &slicelen)) {
+        return NULL;
+    }
+
+    slice = PyList_New(slicelen);
+    if (slice == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < slicelen; ++i) {
+        PyObject *n = PyFloat_FromDouble(data[start + step * i]);
+
+        if (n == NULL) {
+            Py_DECREF(slice);
+            return NULL;
+        }
+        PyList_SET_ITEM(slice, i, n);
+    }
+    return slice;
+}
+
+static int
+pg_frect_ass_subscript(pgFRectObject *self, PyObject *op, PyObject *value)
+{
+    float *data = (float *)&self->r;
+    float val, values[4];
+    Py_ssize_t start, step, slicelen, i;
+
+    if (PyIndex_Check(op)) {
+        i = PyNumber_AsSsize_t(op, PyExc_IndexError);
+        if (i == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+        return pg_frect_ass_item(self, i, value);
+    }
+    if (_pg_frect_slice(op, &start, &step, &slicelen)) {
+        return -1;
+    }
+    if (!value) {
+        PyErr_SetString(PyExc_TypeError, "item deletion is not supported");
+        return -1;
+    }
+
+    if (pg_FloatFromObj(value, &val)) {
+        for (i = 0; i < slicelen; ++i) {
+            values[i] = val;
+        }
+    }
+    else if (PySequence_Check(value)) {
+        if (PySequence_Size(value) != slicelen) {
+            PyErr_Format(PyExc_TypeError, "Expected a length %zd sequence",
+                         slicelen);
+            return -1;
+        }
+        for (i = 0; i < slicelen; ++i) {
+            if (!pg_FloatFromObjIndex(value, (int)i, values + i)) {
+                PyErr_SetString(PyExc_TypeError, "Expected numbers");
+                return -1;
+            }
+        }
+    }
+    else {
+        PyErr_SetString(PyExc_TypeError, "Expected a number or sequence");
+        return -1;
+    }
+
+    for (i = 0; i < slicelen; ++i) {
+        data[start + step * i] = values[i];
+    }
+    return 0;
+}
+
+static PyMappingMethods pg_frect_as_mapping = {
+    .mp_length = (lenfunc)pg_rect_length,
+    .mp_subscript = (binaryfunc)pg_frect_subscript,
+    .mp_ass_subscript = (objobjargproc)pg_frect_ass_subscript,
+};
+
+/* numeric functions */
+static int
+pg_frect_bool(pgFRectObject *self)
+{
+    return self->r.w != 0 && self->r.h != 0;
+}
+
+static PyNumberMethods pg_frect_as_number = {
+    .nb_bool = (inquiry)pg_frect_bool,
+};
+
+static PyObject *
+pg_frect_repr(pgFRectObject *self)
+{
+    float *data = (float *)&self->r;
+    char *str[4] = {NULL, NULL, NULL, NULL};
+    PyObject *ret = NULL;
+    int i;
+
+    /* 7 digits are what a float holds, so 0.1 does not show as
+     * 0.10000000149011612 */
+    for (i = 0; i < 4; ++i) {
+        str[i] = PyOS_double_to_string(data[i], 'g', 7, Py_DTSF_ADD_DOT_0,
+                                       NULL);
+        if (!str[i]) {
+            goto end;
+        }
+    }
+    ret = PyUnicode_FromFormat("<frect(%s, %s, %s, %s)>", str[0], str[1],
+                               str[2], str[3]);
+end:
+    for (i = 0; i < 4; ++i) {
+        PyMem_Free(str[i]);
+    }
+    return ret;
+}
+
+static PyObject *
+pg_frect_richcompare(PyObject *o1, PyObject *o2, int opid)
+{
+    SDL_FRect *o1rect, *o2rect, temp1, temp2;
+    float *a, *b;
+    int i, cmp = 0;
+
+    o1rect = pgFRect_FromObject(o1, &temp1);
+    if (!o1rect) {
+        goto Unimplemented;
+    }
+    o2rect = pgFRect_FromObject(o2, &temp2);
+    if (!o2rect) {
+        goto Unimplemented;
+    }
+
+    a = (float *)o1rect;
+    b = (float *)o2rect;
+    for (i = 0; i < 4 && !cmp; ++i) {
+        if (a[i] != b[i]) {
+            cmp = a[i] < b[i] ? -1 : 1;
+        }
+    }
+
+    switch (opid) {
+        case Py_LT:
+            return PyBool_FromLong(cmp < 0);
+        case Py_LE:
+            return PyBool_FromLong(cmp <= 0);
+        case Py_EQ:
+            return PyBool_FromLong(cmp == 0);
+        case Py_NE:
+            return PyBool_FromLong(cmp != 0);
+        case Py_GT:
+            return PyBool_FromLong(cmp > 0);
+        case Py_GE:
+            return PyBool_FromLong(cmp >= 0);
+        default:
+            break;
+    }
+
+Unimplemented:
+    Py_INCREF(Py_NotImplemented);
+    return Py_NotImplemented;
+}
+
+static PyObject *
+pg_frect_iterator(pgFRectObject *self)
+{
+    PyObject *iter, *tup;
+
+    tup = Py_BuildValue("(ffff)", self->r.x, self->r.y, self->r.w, self->r.h);
+    if (!tup) {
+        return NULL;
+    }
+    iter = PyTuple_Type.tp_iter(tup);
+    Py_DECREF(tup);
+    return iter;
+}
+
+/* The attributes, each made of one or two of the parts in x and y below,
+ * packed into the closure by FRECT_ATTR().
+ */
+#define FRECT_NONE 0
+#define FRECT_START 1  /* left or top */
+#define FRECT_MIDDLE 2 /* centerx or centery */
+#define FRECT_END 3    /* right or bottom */
+#define FRECT_SIZE 4   /* width or height */
+#define FRECT_ATTR(x, y) ((void *)(Py_intptr_t)((x) | ((y) << 4)))
+
+static float
+_pg_frect_getpart(float pos, float size, int part)
+{
+    switch (part) {
+        case FRECT_MIDDLE:
+            return pos + size / 2;
+        case FRECT_END:
+            return pos + size;
+        case FRECT_SIZE:
+            return size;
+        default:
+            return pos;
+    }
+}
+
+static void
+_pg_frect_setpart(float *pos, float *size, int part, float val)
+{
+    switch (part) {
+        case FRECT_START:
+            *pos = val;
+            break;
+        case FRECT_MIDDLE:
+            *pos = val - *size / 2;
+            break;
+        case FRECT_END:
+            *pos = val - *size;
+            break;
+        case FRECT_SIZE:
+            *size = val;
+            break;
+    }
+}
+
+static PyObject *
+pg_frect_getattr(pgFRectObject *self, void *closure)
+{
+    int x = (int)(Py_intptr_t)closure & 15, y = (int)(Py_intptr_t)closure >> 4;
+    float xval = _pg_frect_getpart(self->r.x, self->r.w, x);
+    float yval = _pg_frect_getpart(self->r.y, self->r.h, y);
+
+    if (x == FRECT_NONE) {
+        return PyFloat_FromDouble(yval);
+    }
+    if (y == FRECT_NONE) {
+        return PyFloat_FromDouble(xval);
+    }
+    return Py_BuildValue("(ff)", xval, yval);
+}
+
+static int
+pg_frect_setattr(pgFRectObject *self, PyObject *value, void *closure)
+{
+    int x = (int)(Py_intptr_t)closure & 15, y = (int)(Py_intptr_t)closure >> 4;
+    float xval = 0, yval = 0;
+    int ok;
+
+    if (NULL == value) {
+        /* Attribute deletion not supported. */
+        PyErr_SetString(PyExc_AttributeError, "can't delete attribute");
+        return -1;
+    }
+
+    if (x == FRECT_NONE) {
+        ok = pg_FloatFromObj(value, &yval);
+    }
+    else if (y == FRECT_NONE) {
+        ok = pg_FloatFromObj(value, &xval);
+    }
+    else {
+        ok = pg_TwoFloatsFromObj(value, &xval, &yval);
+    }
+    if (!ok) {
+        PyErr_SetString(PyExc_TypeError, "invalid rect assignment");
+        return -1;
+    }
+    _pg_frect_setpart(&self->r.x, &self->r.w, x, xval);
+    _pg_frect_setpart(&self->r.y, &self->r.h, y, yval);
+    return 0;
+}
+
+#define FRECT_GETSET(name, x, y)                                       \
+    {                                                                  \
+        name, (getter)pg_frect_getattr, (setter)pg_frect_setattr, NULL, \
+            FRECT_ATTR(x, y)                                           \
+    }
+
+static PyGetSetDef pg_frect_getsets[] = {
+    FRECT_GETSET("x", FRECT_START, FRECT_NONE),
+    FRECT_GETSET("y", FRECT_NONE, FRECT_START),
+    FRECT_GETSET("w", FRECT_SIZE, FRECT_NONE),
+    FRECT_GETSET("h", FRECT_NONE, FRECT_SIZE),
+    FRECT_GETSET("width", FRECT_SIZE, FRECT_NONE),
+    FRECT_GETSET("height", FRECT_NONE, FRECT_SIZE),
+    FRECT_GETSET("top", FRECT_NONE, FRECT_START),
+    FRECT_GETSET("left", FRECT_START, FRECT_NONE),
+    FRECT_GETSET("bottom", FRECT_NONE, FRECT_END),
+    FRECT_GETSET("right", FRECT_END, FRECT_NONE),
+    FRECT_GETSET("centerx", FRECT_MIDDLE, FRECT_NONE),
+    FRECT_GETSET("centery", FRECT_NONE, FRECT_MIDDLE),
+    FRECT_GETSET("topleft", FRECT_START, FRECT_START),
+    FRECT_GETSET("topright", FRECT_END, FRECT_START),
+    FRECT_GETSET("bottomleft", FRECT_START, FRECT_END),
+    FRECT_GETSET("bottomright", FRECT_END, FRECT_END),
+    FRECT_GETSET("midtop", FRECT_MIDDLE, FRECT_START),
+    FRECT_GETSET("midleft", FRECT_START, FRECT_MIDDLE),
+    FRECT_GETSET("midbottom", FRECT_MIDDLE, FRECT_END),
+    FRECT_GETSET("midright", FRECT_END, FRECT_MIDDLE),
+    FRECT_GETSET("size", FRECT_SIZE, FRECT_SIZE),
+    FRECT_GETSET("center", FRECT_MIDDLE, FRECT_MIDDLE),
+
+    {"__safe_for_unpickling__", (getter)pg_rect_getsafepickle, NULL, NULL,
+     NULL},
+    {NULL, 0, NULL, NULL, NULL} /* Sentinel */
+};
+
+static int
+pg_frect_init(pgFRectObject *self, PyObject *args, PyObject *kwds)
+{
+    SDL_FRect temp;
+    SDL_FRect *argrect = pgFRect_FromObject(args, &temp);
+
+    if (argrect == NULL) {
+        PyErr_SetString(PyExc_TypeError, "Argument must be rect style object");
+        return -1;
+    }
+    self->r = *argrect;
+    return 0;
+}
+
+static PyTypeObject pgFRect_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.FRect",
+    .tp_basicsize = sizeof(pgFRectObject),
+    .tp_dealloc = (destructor)pg_frect_dealloc,
+    .tp_repr = (reprfunc)pg_frect_repr,
+    .tp_as_number = &pg_frect_as_number,
+    .tp_as_sequence = &pg_frect_as_sequence,
+    .tp_as_mapping = &pg_frect_as_mapping,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_PYGAMEFRECT,
+    .tp_richcompare = (richcmpfunc)pg_frect_richcompare,
+    .tp_weaklistoffset = offsetof(pgFRectObject, weakreflist),
+    .tp_iter = (getiterfunc)pg_frect_iterator,
+    .tp_methods = pg_frect_methods,
+    .tp_getset = pg_frect_getsets,
+    .tp_init = (initproc)pg_frect_init,
+    .tp_new = pg_frect_new,
+};
+
+/* RectIndex: rects in a uniform grid of square cells, for collision queries
+ * that only look at the rects near the area asked about. The rects are kept
+ * in a packed array, indexed by the ids handed out for them. Each cell that
+ * holds rects lists their ids, and the cells are found by their grid
+ * coordinates in an open addressed hash table. Rects covering more than
+ * RECTINDEX_BIG_CELLS cells are kept in a list of their own, which every
+ * query checks.
+ */
+#define RECTINDEX_BIG_CELLS 64
+#define RECTINDEX_DEFAULT_CELL_SIZE 64
+
+typedef struct {
+    SDL_Rect r;
+    /* the cells covered, with x1 < x0 when the rect has no area */
+    int x0, y0, x1, y1;
+    /* the next free id while unused, or -1 */
+    Py_ssize_t next_free;
+    /* the query this rect was last found by */
+    unsigned int mark;
+    char used, big;
+} pgRectIndexEntry;
+
+typedef struct {
+    int x, y;
+    char used;
+    Py_ssize_t count, size;
+    Py_ssize_t *ids;
+} pgRectIndexCell;
+
+typedef struct {
+    PyObject_HEAD int cell_size;
+    Py_ssize_t count;
+    pgRectIndexEntry *entries;
+    Py_ssize_t num_entries, entries_size, free_id;
+    pgRectIndexCell *cells;
+    Py_ssize_t cells_size, cells_used;
+    Py_ssize_t *big;
+    Py_ssize_t num_big, big_size;
+    Py_ssize_t *found;
+    Py_ssize_t num_found, found_size;
+    unsigned int mark;
+} pgRectIndexObject;
+
+static PyTypeObject pgRectIndex_Type;
+
+/* Grows *array of *size items to hold at least need items.
+ * Returns 0 on success, -1 with MemoryError set on failure.
+ */
+static int
+_pg_rectindex_grow(void **array, Py_ssize_t *size, Py_ssize_t need,
+                   size_t itemsize)
+{
+    Py_ssize_t new_size = MAX(*size, 8);
+    void *new_array;
+
+    if (need <= *size) {
+        return 0;
+    }
+    while (new_size < need) {
+        new_size *= 2;
+    }
+    if ((size_t)new_size > PY_SSIZE_T_MAX / itemsize) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    new_array = PyMem_Realloc(*array, (size_t)new_size * itemsize);
+    if (!new_array) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    *array = new_array;
+    *size = new_size;
+    return 0;
+}
+
+/* The cell coordinate of v, rounding down. This is kept inside of the int
+ * range, less one at each end so it can be looped up to.
+ */
+static int
+_pg_rectindex_cell_of(long long v, int cell_size)
+{
+    long long cell = v >= 0 ? v / cell_size : -((-v - 1) / cell_size) - 1;
+
+    return (int)MAX(MIN(cell, INT_MAX - 1), INT_MIN + 1);
+}
+
+static size_t
+_pg_rectindex_hash(int x, int y)
+{
+    return (size_t)((unsigned int)x * 0x9E3779B1u ^
+                    (unsigned int)y * 0x85EBCA77u);
+}
+
+/* Returns the cell at x, y, or NULL if it was never made. */
+static pgRectIndexCell *
+_pg_rectindex_find_cell(pgRectIndexObject *self, int x, int y)
+{
+    size_t mask = (size_t)self->cells_size - 1, i;
+    pgRectIndexCell *cell;
+
+    if (!self->cells_size) {
+        return NULL;
+    }
+    for (i = _pg_rectindex_hash(x, y) & mask;; i = (i + 1) & mask) {
+        cell = self->cells + i;
+        if (!cell->used) {
+            return NULL;
+        }
+        if (cell->x == x && cell->y == y) {
+            return cell;
+        }
+    }
+}
+
+/* Returns the cell at x, y, making it if needed. The cells are kept once
+ * made, so their ids lists can be reused. Returns NULL with MemoryError set
+ * on failure.
+ */
+static pgRectIndexCell *
+_pg_rectindex_get_cell(pgRectIndexObject *self, int x, int y)
+{
+    pgRectIndexCell *cell = _pg_rectindex_find_cell(self, x, y), *old;
+    Py_ssize_t old_size = self->cells_size, j;
+    size_t mask, i;
+
+    if (cell) {
+        return cell;
+    }
+
+    if (2 * (self->cells_used + 1) > self->cells_size) {
+        /* keep the table at most half full */
+        old = self->cells;
+        self->cells_size = MAX(64, 2 * old_size);
+        self->cells = PyMem_New(pgRectIndexCell, self->cells_size);
+        if (!self->cells) {
+            self->cells = old;
+            self->cells_size = old_size;
+            PyErr_NoMemory();
+            return NULL;
+        }
+        memset(self->cells, 0, sizeof(pgRectIndexCell) * self->cells_size);
+        mask = (size_t)self->cells_size - 1;
+        for (j = 0; j < old_size; ++j) {
+            if (!old[j].used) {
+                continue;
+            }
+            i = _pg_rectindex_hash(old[j].x, old[j].y) & mask;
+            while (self->cells[i].used) {
+                i = (i + 1) & mask;
+            }
+            self->cells[i] = old[j];
+        }
+        PyMem_Free(old);
+    }
+
+    mask = (size_t)self->cells_size - 1;
+    i = _pg_rectindex_hash(x, y) & mask;
+    while (self->cells[i].used) {
+        i = (i + 1) & mask;
+    }
+    cell = self->cells + i;
+    cell->x = x;
+    cell->y = y;
+    cell->used = 1;
+    self->cells_used++;
+    return cell;
+}
+
+static void
+_pg_rectindex_remove_id(Py_ssize_t *ids, Py_ssize_t *count, Py_ssize_t id)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < *count; ++i) {
+        if (ids[i] == id) {
+            ids[i] = ids[--*count];
+            return;
+        }
+    }
+}
+
+/* Takes the rect with the given id out of the cells or big list. Cells
+ * without it are skipped, so this also undoes a partly done placing.
+ */
+static void
+_pg_rectindex_unplace(pgRectIndexObject *self, Py_ssize_t id)
+{
+    pgRectIndexEntry *entry = self->entries + id;
+    pgRectIndexCell *cell;
+    int x, y;
+
+    if (entry->big) {
+        _pg_rectindex_remove_id(self->big, &self->num_big, id);
+        entry->big = 0;
+        return;
+    }
+    for (y = entry->y0; y <= entry->y1; ++y) {
+        for (x = entry->x0; x <= entry->x1; ++x) {
+            cell = _pg_rectindex_find_cell(self, x, y);
+            if (cell) {
+                _pg_rectindex_remove_id(cell->ids, &cell->count, id);
+            }
+        }
+    }
+}
+
+/* Finds the cells covered by r, in x0 .. x1 and y0 .. y1. Returns how many
+ * there are, which is 0 if r has no area.
+ */
+static long long
+_pg_rectindex_cells_of(SDL_Rect *r, int cell_size, int *x0, int *y0,
+                       int *x1, int *y1)
+{
+    long long left = MIN((long long)r->x, (long long)r->x + r->w);
+    long long top = MIN((long long)r->y, (long long)r->y + r->h);
+    long long right = MAX((long long)r->x, (long long)r->x + r->w);
+    long long bottom = MAX((long long)r->y, (long long)r->y + r->h);
+
+    if (!r->w || !r->h) {
+        *x0 = *y0 = 0;
+        *x1 = *y1 = -1;
+        return 0;
+    }
+    *x0 = _pg_rectindex_cell_of(left, cell_size);
+    *y0 = _pg_rectindex_cell_of(top, cell_size);
+    *x1 = _pg_rectindex_cell_of(right - 1, cell_size);
+    *y1 = _pg_rectindex_cell_of(bottom - 1, cell_size);
+    return ((long long)*x1 - *x0 + 1) * ((long long)*y1 - *y0 + 1);
+}
+
+/* Puts the rect with the given id into the cells it covers, or into the big
+ * list. Returns 0 on success, -1 with MemoryError set on failure.
+ */
+static int
+_pg_rectindex_place(pgRectIndexObject *self, Py_ssize_t id)
+{
+    pgRectIndexEntry *entry = self->entries + id;
+    pgRectIndexCell *cell;
+    long long ncells;
+    int x, y;
+
+    ncells = _pg_rectindex_cells_of(&entry->r, self->cell_size, &entry->x0,
+                                    &entry->y0, &entry->x1, &entry->y1);
+    if (ncells > RECTINDEX_BIG_CELLS) {
+        if (_pg_rectindex_grow((void **)&self->big, &self->big_size,
+                               self->num_big + 1, sizeof(Py_ssize_t))) {
+            return -1;
+        }
+        self->big[self->num_big++] = id;
+        entry->big = 1;
+        return 0;
+    }
+    for (y = entry->y0; y <= entry->y1; ++y) {
+        for (x = entry->x0; x <= entry->x1; ++x) {
+            cell = _pg_rectindex_get_cell(self, x, y);
+            if (!cell || _pg_rectindex_grow((void **)&cell->ids, &cell->size,
+                                            cell->count + 1,
+                                            sizeof(Py_ssize_t))) {
+                _pg_rectindex_unplace(self, id);
+                return -1;
+            }
+            cell->ids[cell->count++] = id;
+        }
+    }
+    return 0;
+}
+
+/* Adds r to the index. Returns its id, or -1 with MemoryError set. */
+static Py_ssize_t
+_pg_rectindex_insert(pgRectIndexObject *self, SDL_Rect *r)
+{
+    Py_ssize_t id = self->free_id;
+    pgRectIndexEntry *entry;
+
+    if (id < 0) {
+        if (_pg_rectindex_grow((void **)&self->entries, &self->entries_size,
+                               self->num_entries + 1,
+                               sizeof(pgRectIndexEntry))) {
+            return -1;
+        }
+        id = self->num_entries;
+    }
+    entry = self->entries + id;
+    entry->r = *r;
+    entry->mark = 0;
+    entry->big = 0;
+    if (_pg_rectindex_place(self, id)) {
+        return -1;
+    }
+    if (id == self->free_id) {
+        self->free_id = entry->next_free;
+    }
+    else {
+        self->num_entries++;
+    }
+    entry->next_free = -1;
+    entry->used = 1;
+    self->count++;
+    return id;
+}
+
+static int
+_pg_rectindex_add_found(pgRectIndexObject *self, Py_ssize_t id)
+{
+    if (_pg_rectindex_grow((void **)&self->found, &self->found_size,
+                           self->num_found + 1, sizeof(Py_ssize_t))) {
+        return -1;
+    }
+    self->found[self->num_found++] = id;
+    return 0;
+}
+
+static int
+_pg_rectindex_compare_ids(const void *a, const void *b)
+{
+    Py_ssize_t ida = *(const Py_ssize_t *)a, idb = *(const Py_ssize_t *)b;
+
+    return (ida > idb) - (ida < idb);
+}
+
+/* Finds the ids of the rects colliding with r into self->found, in
+ * increasing order. Collisions are tested as Rect.colliderect() does.
+ * Returns 0 on success, -1 with MemoryError set on failure.
+ */
+static int
+_pg_rectindex_query_rect(pgRectIndexObject *self, SDL_Rect *r)
+{
+    pgRectIndexEntry *entry;
+    pgRectIndexCell *cell;
+    long long ncells;
+    Py_ssize_t i;
+    int x, y, x0, y0, x1, y1;
+
+    self->num_found = 0;
+    ncells = _pg_rectindex_cells_of(r, self->cell_size, &x0, &y0, &x1, &y1);
+    if (!ncells || !self->count) {
+        return 0;
+    }
+
+    if (ncells > self->cells_used) {
+        /* more cells than hold rects, so test the rects themselves */
+        for (i = 0; i < self->num_entries; ++i) {
+            entry = self->entries + i;
+            if (entry->used && _pg_do_rects_intersect(&entry->r, r) &&
+                _pg_rectindex_add_found(self, i)) {
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    if (++self->mark == 0) {
+        /* the marks wrapped around, so forget the old ones */
+        for (i = 0; i < self->num_entries; ++i) {
+            self->entries[i].mark = 0;
+        }
+        self->mark = 1;
+    }
+    for (y = y0; y <= y1; ++y) {
+        for (x = x0; x <= x1; ++x) {
+            cell = _pg_rectindex_find_cell(self, x, y);
+            if (!cell) {
+                continue;
+            }
+            for (i = 0; i < cell->count; ++i) {
+                entry = self->entries + cell->ids[i];
+                if (entry->mark == self->mark) {
+                    continue;
+                }
+                entry->mark = self->mark;
+                if (_pg_do_rects_intersect(&entry->r, r) &&
+                    _pg_rectindex_add_found(self, cell->ids[i])) {
+                    return -1;
+                }
+            }
+        }
+    }
+    for (i = 0; i < self->num_big; ++i) {
+        if (_pg_do_rects_intersect(&self->entries[self->big[i]].r, r) &&
+            _pg_rectindex_add_found(self, self->big[i])) {
+            return -1;
+        }
+    }
+    if (self->num_found > 1) {
+        qsort(self->found, self->num_found, sizeof(Py_ssize_t),
+              _pg_rectindex_compare_ids);
+    }
+    return 0;
+}
+
+/* Returns a list of the ids in self->found. */
+static PyObject *
+_pg_rectindex_found_list(pgRectIndexObject *self)
+{
+    PyObject *list = PyList_New(self->num_found), *num;
+    Py_ssize_t i;
+
+    if (!list) {
+        return NULL;
+    }
+    for (i = 0; i < self->num_found; ++i) {
+        num = PyLong_FromSsize_t(self->found[i]);
+        if (!num) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, num);
+    }
+    return list;
+}
+
+/* Returns the entry for the id in obj, or NULL with KeyError set if there
+ * is no rect with that id.
+ */
+static pgRectIndexEntry *
+_pg_rectindex_entry_from_id(pgRectIndexObject *self, PyObject *obj)
+{
+    Py_ssize_t id = PyNumber_AsSsize_t(obj, NULL);
+
+    if (id == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (id < 0 || id >= self->num_entries || !self->entries[id].used) {
+        PyErr_SetObject(PyExc_KeyError, obj);
+        return NULL;
+    }
+    return self->entries + id;
+}
+
+static void
+_pg_rectindex_clear(pgRectIndexObject *self)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < self->cells_size; ++i) {
+        PyMem_Free(self->cells[i].ids);
+    }
+    PyMem_Free(self->cells);
+    PyMem_Free(self->entries);
+    PyMem_Free(self->big);
+    PyMem_Free(self->found);
+    self->cells = NULL;
+    self->entries = NULL;
+    self->big = NULL;
+    self->found = NULL;
+    self->cells_size = self->cells_used = 0;
+    self->count = self->num_entries = self->entries_size = 0;
+    self->num_big = self->big_size = 0;
+    self->num_found = self->found_size = 0;
+    self->free_id = -1;
+    self->mark = 0;
+}
+
+static int
+pg_rectindex_init(pgRectIndexObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *rects = NULL, *seq, *obj;
+    SDL_Rect *r, temp;
+    int cell_size = RECTINDEX_DEFAULT_CELL_SIZE;
+    Py_ssize_t i, size;
+    static char *keywords[] = {"rects", "cell_size", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|Oi", keywords, &rects,
+                                     &cell_size)) {
+        return -1;
+    }
+    if (cell_size < 1) {
+        PyErr_SetString(PyExc_ValueError, "cell_size must be positive");
+        return -1;
+    }
+
+    _pg_rectindex_clear(self);
+    self->cell_size = cell_size;
+    if (!rects) {
+        return 0;
+    }
+
+    seq = PySequence_Fast(rects, "rects must be a sequence of rect style "
+                                 "objects");
+    if (!seq) {
+        return -1;
+    }
+    size = PySequence_Fast_GET_SIZE(seq);
+    for (i = 0; i < size; ++i) {
+        obj = PySequence_Fast_GET_ITEM(seq, i);
+        if (!(r = pgRect_FromObject(obj, &temp))) {
+            Py_DECREF(seq);
+            PyErr_SetString(PyExc_TypeError,
+                            "rects must be a sequence of rect style objects");
+            return -1;
+        }
+        if (_pg_rectindex_insert(self, r) < 0) {
+            Py_DECREF(seq);
+            return -1;
+        }
+    }
+    Py_DECREF(seq);
+    return 0;
+}
+
+static PyObject *
+pg_rectindex_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    pgRectIndexObject *self = (pgRectIndexObject *)type->tp_alloc(type, 0);
+
+    if (self != NULL) {
+        self->cell_size = RECTINDEX_DEFAULT_CELL_SIZE;
+        self->free_id = -1;
+    }
+    return (PyObject *)self;
+}
+
+static void
+pg_rectindex_dealloc(pgRectIndexObject *self)
+{
+    _pg_rectindex_clear(self);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+pg_rectindex_insert(pgRectIndexObject *self, PyObject *args)
+{
+    SDL_Rect *r, temp;
+    Py_ssize_t id;
+
+    if (!(r = pgRect_FromObject(args, &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    id = _pg_rectindex_insert(self, r);
+    if (id < 0) {
+        return NULL; /* Exception already set. */
+    }
+    return PyLong_FromSsize_t(id);
+}
+
+static PyObject *
+pg_rectindex_remove(pgRectIndexObject *self, PyObject *arg)
+{
+    pgRectIndexEntry *entry = _pg_rectindex_entry_from_id(self, arg);
+    Py_ssize_t id;
+
+    if (!entry) {
+        return NULL; /* Exception already set. */
+    }
+    id = entry - self->entries;
+    _pg_rectindex_unplace(self, id);
+    entry->used = 0;
+    entry->next_free = self->free_id;
+    self->free_id = id;
+    self->count--;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_rectindex_move(pgRectIndexObject *self, PyObject *args)
+{
+    pgRectIndexEntry *entry;
+    PyObject *idobj, *rectobj;
+    SDL_Rect *r, temp, old;
+    Py_ssize_t id;
+    int x0, y0, x1, y1;
+
+    if (!PyArg_ParseTuple(args, "OO", &idobj, &rectobj)) {
+        return NULL;
+    }
+    if (!(entry = _pg_rectindex_entry_from_id(self, idobj))) {
+        return NULL; /* Exception already set. */
+    }
+    if (!(r = pgRect_FromObject(rectobj, &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    id = entry - self->entries;
+
+    _pg_rectindex_cells_of(r, self->cell_size, &x0, &y0, &x1, &y1);
+    if (!entry->big && x0 == entry->x0 && y0 == entry->y0 &&
+        x1 == entry->x1 && y1 == entry->y1) {
+        /* still in the same cells */
+        entry->r = *r;
+        Py_RETURN_NONE;
+    }
+
+    old = entry->r;
+    _pg_rectindex_unplace(self, id);
+    entry->r = *r;
+    if (_pg_rectindex_place(self, id)) {
+        /* put it back where it was, which cannot need more memory */
+        entry->r = old;
+        _pg_rectindex_place(self, id);
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/* Adds id to self->found if the point x, y is in its rect, as tested by
+ * Rect.collidepoint(). Returns 0 on success, -1 with MemoryError set on
+ * failure.
+ */
+static int
+_pg_rectindex_test_point(pgRectIndexObject *self, Py_ssize_t id, int x,
+                         int y)
+{
+    SDL_Rect *r = &self->entries[id].r;
+
+    if (x >= r->x && x < r->x + r->w && y >= r->y && y < r->y + r->h) {
+        return _pg_rectindex_add_found(self, id);
+    }
+    return 0;
+}
+
+static PyObject *
+pg_rectindex_collidepoint(pgRectIndexObject *self, PyObject *args)
+{
+    pgRectIndexCell *cell;
+    Py_ssize_t i;
+    int x = 0, y = 0;
+
+    if (!pg_TwoIntsFromObj(args, &x, &y)) {
+        return RAISE(PyExc_TypeError, "argument must contain two numbers");
+    }
+
+    /* a point is in one cell, so each rect is found at most once there */
+    self->num_found = 0;
+    cell = _pg_rectindex_find_cell(
+        self, _pg_rectindex_cell_of(x, self->cell_size),
+        _pg_rectindex_cell_of(y, self->cell_size));
+    for (i = 0; cell && i < cell->count; ++i) {
+        if (_pg_rectindex_test_point(self, cell->ids[i], x, y)) {
+            return NULL;
+        }
+    }
+    for (i = 0; i < self->num_big; ++i) {
+        if (_pg_rectindex_test_point(self, self->big[i], x, y)) {
+            return NULL;
+        }
+    }
+    if (self->num_found > 1) {
+        qsort(self->found, self->num_found, sizeof(Py_ssize_t),
+              _pg_rectindex_compare_ids);
+    }
+    return _pg_rectindex_found_list(self);
+}
+
+static PyObject *
+pg_rectindex_colliderect(pgRectIndexObject *self, PyObject *args)
+{
+    SDL_Rect *r, temp;
+
+    if (!(r = pgRect_FromObject(args, &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    if (_pg_rectindex_query_rect(self, r)) {
+        return NULL;
+    }
+    return _pg_rectindex_found_list(self);
+}
+
+static PyObject *
+pg_rectindex_collidelist(pgRectIndexObject *self, PyObject *arg)
+{
+    PyObject *seq, *ret, *ids;
+    SDL_Rect *r, temp;
+    Py_ssize_t i, size;
+
+    seq = PySequence_Fast(arg, "Argument must be a sequence of rectstyle "
+                               "objects.");
+    if (!seq) {
+        return NULL;
+    }
+    size = PySequence_Fast_GET_SIZE(seq);
+    ret = PyList_New(size);
+    if (!ret) {
+        Py_DECREF(seq);
+        return NULL;
+    }
+    for (i = 0; i < size; ++i) {
+        r = pgRect_FromObject(PySequence_Fast_GET_ITEM(seq, i), &temp);
+        if (!r) {
+            PyErr_SetString(
+                PyExc_TypeError,
+                "Argument must be a sequence of rectstyle objects.");
+            goto error;
+        }
+        if (_pg_rectindex_query_rect(self, r) ||
+            !(ids = _pg_rectindex_found_list(self))) {
+            goto error;
+        }
+        PyList_SET_ITEM(ret, i, ids);
+    }
+    Py_DECREF(seq);
+    return ret;
+
+error:
+    Py_DECREF(seq);
+    Py_DECREF(ret);
+    return NULL;
+}
+
+static Py_ssize_t
+pg_rectindex_length(pgRectIndexObject *self)
+{
+    return self->count;
+}
+
+static PyObject *
+pg_rectindex_subscript(pgRectIndexObject *self, PyObject *key)
+{
+    pgRectIndexEntry *entry = _pg_rectindex_entry_from_id(self, key);
+
+    if (!entry) {
+        return NULL; /* Exception already set. */
+    }
+    return pgRect_New(&entry->r);
+}
+
+static int
+pg_rectindex_contains(pgRectIndexObject *self, PyObject *key)
+{
+    Py_ssize_t id = PyNumber_AsSsize_t(key, NULL);
+
+    if (id == -1 && PyErr_Occurred()) {
+        if (!PyErr_ExceptionMatches(PyExc_TypeError)) {
+            return -1;
+        }
+        PyErr_Clear();
+        return 0;
+    }
+    return id >= 0 && id < self->num_entries && self->entries[id].used;
+}
+
+static PyMethodDef pg_rectindex_methods[] = {
+    {"insert", (PyCFunction)pg_rectindex_insert, METH_VARARGS,
+     DOC_RECTINDEXINSERT},
+    {"remove", (PyCFunction)pg_rectindex_remove, METH_O, DOC_RECTINDEXREMOVE},
+    {"move", (PyCFunction)pg_rectindex_move, METH_VARARGS,
+     DOC_RECTINDEXMOVE},
+    {"collidepoint", (PyCFunction)pg_rectindex_collidepoint, METH_VARARGS,
+     DOC_RECTINDEXCOLLIDEPOINT},
+    {"colliderect", (PyCFunction)pg_rectindex_colliderect, METH_VARARGS,
+     DOC_RECTINDEXCOLLIDERECT},
+    {"collidelist", (PyCFunction)pg_rectindex_collidelist, METH_O,
+     DOC_RECTINDEXCOLLIDELIST},
+    {NULL, NULL, 0, NULL}};
+
+static PySequenceMethods pg_rectindex_as_sequence = {
+    .sq_length = (lenfunc)pg_rectindex_length,
+    .sq_contains = (objobjproc)pg_rectindex_contains,
+};
+
+static PyMappingMethods pg_rectindex_as_mapping = {
+    .mp_length = (lenfunc)pg_rectindex_length,
+    .mp_subscript = (binaryfunc)pg_rectindex_subscript,
+};
+
+static PyTypeObject pgRectIndex_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.RectIndex",
+    .tp_basicsize = sizeof(pgRectIndexObject),
+    .tp_dealloc = (destructor)pg_rectindex_dealloc,
+    .tp_as_sequence = &pg_rectindex_as_sequence,
+    .tp_as_mapping = &pg_rectindex_as_mapping,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_PYGAMERECTINDEX,
+    .tp_methods = pg_rectindex_methods,
+    .tp_init = (initproc)pg_rectindex_init,
+    .tp_new = pg_rectindex_new,
+};
+
+/* RectArray: SDL_Rects stored one after another, with operations done over
+ * all of them in plain loops. The rects can be shared through the buffer
+ * interface as a (length, 4) array of ints, and the array cannot change
+ * length while they are.
+ */
+typedef struct {
+    PyObject_HEAD SDL_Rect *rects;
+    Py_ssize_t count, size;
+    Py_ssize_t exports;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+} pgRectArrayObject;
+
+static PyTypeObject pgRectArray_Type;
+
+/* Makes room for count rects in self. Returns 0 on success, -1 with an
+ * exception set on failure.
+ */
+static int
+_pg_rectarray_resize(pgRectArrayObject *self, Py_ssize_t count)
+{
+    if (self->exports) {
+        PyErr_SetString(PyExc_BufferError,
+                        "cannot resize a RectArray while it is exported");
+        return -1;
+    }
+    if (count > self->size &&
+        _pg_rectindex_grow((void **)&self->rects, &self->size, count,
+                           sizeof(SDL_Rect))) {
+        return -1;
+    }
+    self->count = count;
+    return 0;
+}
+
+/* Returns a new RectArray of count rects, which are not set. */
+static pgRectArrayObject *
+_pg_rectarray_new(Py_ssize_t count)
+{
+    pgRectArrayObject *array = (pgRectArrayObject *)pgRectArray_Type.tp_alloc(
+        &pgRectArray_Type, 0);
+
+    if (array && _pg_rectarray_resize(array, count)) {
+        Py_DECREF(array);
+        return NULL;
+    }
+    return array;
+}
+
+static int
+pg_rectarray_init(pgRectArrayObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *rects = NULL, *seq;
+    SDL_Rect *r, temp;
+    Py_ssize_t i, count;
+    static char *keywords[] = {"rects", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", keywords, &rects)) {
+        return -1;
+    }
+
+    if (!rects) {
+        return _pg_rectarray_resize(self, 0);
+    }
+    if (PyIndex_Check(rects)) {
+        count = PyNumber_AsSsize_t(rects, PyExc_OverflowError);
+        if (count == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+        if (count < 0) {
+            PyErr_SetString(PyExc_ValueError,
+                            "RectArray length cannot be negative");
+            return -1;
+        }
+        if (_pg_rectarray_resize(self, count)) {
+            return -1;
+        }
+        if (count) {
+            memset(self->rects, 0, sizeof(SDL_Rect) * count);
+        }
+        return 0;
+    }
+
+    seq = PySequence_Fast(rects, "rects must be a sequence of rect style "
+                                 "objects");
+    if (!seq) {
+        return -1;
+    }
+    count = PySequence_Fast_GET_SIZE(seq);
+    if (_pg_rectarray_resize(self, count)) {
+        Py_DECREF(seq);
+        return -1;
+    }
+    for (i = 0; i < count; ++i) {
+        if (!(r = pgRect_FromObject(PySequence_Fast_GET_ITEM(seq, i),
+                                    &temp))) {
+            self->count = 0;
+            Py_DECREF(seq);
+            PyErr_SetString(PyExc_TypeError,
+                            "rects must be a sequence of rect style objects");
+            return -1;
+        }
+        self->rects[i] = *r;
+    }
+    Py_DECREF(seq);
+    return 0;
+}
+
+static void
+pg_rectarray_dealloc(pgRectArrayObject *self)
+{
+    PyMem_Free(self->rects);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+pg_rectarray_repr(pgRectArrayObject *self)
+{
+    return PyUnicode_FromFormat("<RectArray(%zd)>", self->count);
+}
+
+static PyObject *
+pg_rectarray_append(pgRectArrayObject *self, PyObject *args)
+{
+    SDL_Rect *r, temp;
+
+    if (!(r = pgRect_FromObject(args, &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    if (_pg_rectarray_resize(self, self->count + 1)) {
+        return NULL;
+    }
+    self->rects[self->count - 1] = *r;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_rectarray_move_ip(pgRectArrayObject *self, PyObject *args)
+{
+    SDL_Rect *rects = self->rects;
+    Py_ssize_t i;
+    int x, y;
+
+    if (!pg_TwoIntsFromObj(args, &x, &y)) {
+        return RAISE(PyExc_TypeError, "argument must contain two numbers");
+    }
+    for (i = 0; i < self->count; ++i) {
+        rects[i].x += x;
+        rects[i].y += y;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_rectarray_clamp_ip(pgRectArrayObject *self, PyObject *args)
+{
+    SDL_Rect *argrect, temp;
+    Py_ssize_t i;
+
+    if (!(argrect = pgRect_FromObject(args, &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    for (i = 0; i < self->count; ++i) {
+        _pg_rect_clamp(self->rects + i, argrect);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_rectarray_clip(pgRectArrayObject *self, PyObject *args)
+{
+    SDL_Rect *argrect, temp;
+    pgRectArrayObject *ret;
+    Py_ssize_t i;
+
+    if (!(argrect = pgRect_FromObject(args, &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    if (!(ret = _pg_rectarray_new(self->count))) {
+        return NULL;
+    }
+    for (i = 0; i < self->count; ++i) {
+        ret->rects[i] = self->rects[i];
+        _pg_rect_clip(ret->rects + i, argrect);
+    }
+    return (PyObject *)ret;
+}
+
+static PyObject *
+pg_rectarray_union(pgRectArrayObject *self, PyObject *_null)
+{
+    SDL_Rect *rects = self->rects;
+    Py_ssize_t i;
+    int l, t, r, b;
+
+    if (!self->count) {
+        return RAISE(PyExc_ValueError,
+                     "cannot find the union of an empty RectArray");
+    }
+    l = rects[0].x;
+    t = rects[0].y;
+    r = rects[0].x + rects[0].w;
+    b = rects[0].y + rects[0].h;
+    for (i = 1; i < self->count; ++i) {
+        l = MIN(l, rects[i].x);
+        t = MIN(t, rects[i].y);
+        r = MAX(r, rects[i].x + rects[i].w);
+        b = MAX(b, rects[i].y + rects[i].h);
+    }
+    return pgRect_New4(l, t, r - l, b - t);
+}
+
+static int
+_pg_rect_compare_x(const void *a, const void *b)
+{
+    int xa = ((const SDL_Rect *)a)->x, xb = ((const SDL_Rect *)b)->x;
+
+    return (xa > xb) - (xa < xb);
+}
+
+static Py_ssize_t
+_pg_rectarray_find(Py_ssize_t *parent, Py_ssize_t i)
+{
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+static PyObject *
+pg_rectarray_merge_ip(pgRectArrayObject *self, PyObject *args)
+{
+    SDL_Rect *rects = self->rects, *argrect = NULL, temp, r;
+    PyObject *clipobj = Py_None;
+    Py_ssize_t *parent, count = 0, i, j, a, b;
+    int merged;
+
+    if (!PyArg_ParseTuple(args, "|O", &clipobj)) {
+        return NULL;
+    }
+    if (clipobj != Py_None && !(argrect = pgRect_FromObject(clipobj, &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    /* fails before anything changes if the array is exported */
+    if (_pg_rectarray_resize(self, self->count)) {
+        return NULL;
+    }
+
+    /* Empty rects cover nothing and collide with nothing, so they go */
+    for (i = 0; i < self->count; ++i) {
+        r = rects[i];
+        if (r.w < 0) {
+            r.x += r.w;
+            r.w = -r.w;
+        }
+        if (r.h < 0) {
+            r.y += r.h;
+            r.h = -r.h;
+        }
+        if (argrect) {
+            _pg_rect_clip(&r, argrect);
+        }
+        if (r.w && r.h) {
+            rects[count++] = r;
+        }
+    }
+    if (!(parent = PyMem_New(Py_ssize_t, count + 1))) {
+        return PyErr_NoMemory();
+    }
+
+    /* Sorted by their left edges, each rect only has to be tested against
+     * the ones after it that start before its right edge. Colliding rects
+     * are joined into sets, each set is replaced by its bounding box, and
+     * that is repeated until no boxes collide. */
+    do {
+        qsort(rects, count, sizeof(SDL_Rect), _pg_rect_compare_x);
+        for (i = 0; i < count; ++i) {
+            parent[i] = i;
+        }
+        merged = 0;
+        for (i = 0; i < count; ++i) {
+            for (j = i + 1; j < count && rects[j].x < rects[i].x + rects[i].w;
+                 ++j) {
+                if (rects[j].y < rects[i].y + rects[i].h &&
+                    rects[i].y < rects[j].y + rects[j].h) {
+                    a = _pg_rectarray_find(parent, i);
+                    b = _pg_rectarray_find(parent, j);
+                    if (a != b) {
+                        parent[b] = a;
+                        merged = 1;
+                    }
+                }
+            }
+        }
+        if (!merged) {
+            break;
+        }
+        for (i = 0; i < count; ++i) {
+            a = _pg_rectarray_find(parent, i);
+            if (a != i) {
+                r = rects[a];
+                rects[a].x = MIN(r.x, rects[i].x);
+                rects[a].y = MIN(r.y, rects[i].y);
+                rects[a].w = MAX(r.x + r.w, rects[i].x + rects[i].w) -
+                             rects[a].x;
+                rects[a].h = MAX(r.y + r.h, rects[i].y + rects[i].h) -
+                             rects[a].y;
+            }
+        }
+        for (i = j = 0; i < count; ++i) {
+            if (parent[i] == i) {
+                rects[j++] = rects[i];
+            }
+        }
+        count = j;
+    } while (count > 1);
+
+    PyMem_Free(parent);
+    self->count = count;
+    Py_RETURN_NONE;
+}
+
+/* Returns a list of the indices i that have a nonzero hits[i]. */
+static PyObject *
+_pg_rectarray_hit_list(const char *hits, Py_ssize_t count)
+{
+    PyObject *list = PyList_New(0), *num;
+    Py_ssize_t i;
+
+    if (!list) {
+        return NULL;
+    }
+    for (i = 0; i < count; ++i) {
+        if (!hits[i]) {
+            continue;
+        }
+        num = PyLong_FromSsize_t(i);
+        if (!num || PyList_Append(list, num)) {
+            Py_XDECREF(num);
+            Py_DECREF(list);
+            return NULL;
+        }
+        Py_DECREF(num);
+    }
+    return list;
+}
+
+static PyObject *
+pg_rectarray_collidepoint(pgRectArrayObject *self, PyObject *args)
+{
+    SDL_Rect *rects = self->rects;
+    PyObject *ret;
+    Py_ssize_t i;
+    char *hits;
+    int x = 0, y = 0;
+
+    if (!pg_TwoIntsFromObj(args, &x, &y)) {
+        return RAISE(PyExc_TypeError, "argument must contain two numbers");
+    }
+    if (!(hits = PyMem_Malloc(self->count + 1))) {
+        return PyErr_NoMemory();
+    }
+    /* the tests are done without branches, and the hits listed after */
+    for (i = 0; i < self->count; ++i) {
+        hits[i] = (x >= rects[i].x) & (x < rects[i].x + rects[i].w) &
+                  (y >= rects[i].y) & (y < rects[i].y + rects[i].h);
+    }
+    ret = _pg_rectarray_hit_list(hits, self->count);
+    PyMem_Free(hits);
+    return ret;
+}
+
+static PyObject *
+pg_rectarray_colliderect(pgRectArrayObject *self, PyObject *args)
+{
+    SDL_Rect *argrect, temp;
+    PyObject *ret;
+    Py_ssize_t i;
+    char *hits;
+
+    if (!(argrect = pgRect_FromObject(args, &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    if (!(hits = PyMem_Malloc(self->count + 1))) {
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < self->count; ++i) {
+        hits[i] = (char)_pg_do_rects_intersect(self->rects + i, argrect);
+    }
+    ret = _pg_rectarray_hit_list(hits, self->count);
+    PyMem_Free(hits);
+    return ret;
+}
+
+/* sequence functions */
+
+static Py_ssize_t
+pg_rectarray_length(pgRectArrayObject *self)
+{
+    return self->count;
+}
+
+static PyObject *
+pg_rectarray_item(pgRectArrayObject *self, Py_ssize_t i)
+{
+    if (i < 0 || i >= self->count) {
+        return RAISE(PyExc_IndexError, "RectArray index out of range");
+    }
+    return pgRect_New(self->rects + i);
+}
+
+static int
+pg_rectarray_ass_item(pgRectArrayObject *self, Py_ssize_t i, PyObject *v)
+{
+    SDL_Rect *r, temp;
+
+    if (i < 0 || i >= self->count) {
+        PyErr_SetString(PyExc_IndexError,
+                        "RectArray assignment index out of range");
+        return -1;
+    }
+    if (!v) {
+        /* del array[i] */
+        if (self->exports) {
+            PyErr_SetString(PyExc_BufferError,
+                            "cannot resize a RectArray while it is exported");
+            return -1;
+        }
+        memmove(self->rects + i, self->rects + i + 1,
+                sizeof(SDL_Rect) * (self->count - i - 1));
+        self->count--;
+        return 0;
+    }
+    if (!(r = pgRect_FromObject(v, &temp))) {
+        PyErr_SetString(PyExc_TypeError, "Argument must be rect style object");
+        return -1;
+    }
+    self->rects[i] = *r;
+    return 0;
+}
+
+/* buffer functions */
+
+static int
+pg_rectarray_getbuffer(pgRectArrayObject *self, Py_buffer *view, int flags)
+{
+    if (!self->exports) {
+        self->shape[0] = self->count;
+        self->shape[1] = 4;
+        self->strides[0] = sizeof(SDL_Rect);
+        self->strides[1] = sizeof(int);
+    }
+    self->exports++;
+
+    view->buf = self->rects;
+    view->len = self->count * sizeof(SDL_Rect);
+    view->readonly = 0;
+    view->itemsize = sizeof(int);
+    view->format = (flags & PyBUF_FORMAT) ? "i" : NULL;
+    view->ndim = 2;
+    view->shape = (flags & PyBUF_ND) ? self->shape : NULL;
+    view->strides = (flags & PyBUF_STRIDES) ? self->strides : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    Py_INCREF(self);
+    view->obj = (PyObject *)self;
+    return 0;
+}
+
+static void
+pg_rectarray_releasebuffer(pgRectArrayObject *self, Py_buffer *view)
+{
+    self->exports--;
+}
+
+static PyMethodDef pg_rectarray_methods[] = {
+    {"append", (PyCFunction)pg_rectarray_append, METH_VARARGS,
+     DOC_RECTARRAYAPPEND},
+    {"move_ip", (PyCFunction)pg_rectarray_move_ip, METH_VARARGS,
+     DOC_RECTARRAYMOVEIP},
+    {"clamp_ip", (PyCFunction)pg_rectarray_clamp_ip, METH_VARARGS,
+     DOC_RECTARRAYCLAMPIP},
+    {"clip", (PyCFunction)pg_rectarray_clip, METH_VARARGS,
+     DOC_RECTARRAYCLIP},
+    {"union", (PyCFunction)pg_rectarray_union, METH_NOARGS,
+     DOC_RECTARRAYUNION},
+    {"merge_ip", (PyCFunction)pg_rectarray_merge_ip, METH_VARARGS,
+     DOC_RECTARRAYMERGEIP},
+    {"collidepoint", (PyCFunction)pg_rectarray_collidepoint, METH_VARARGS,
+     DOC_RECTARRAYCOLLIDEPOINT},
+    {"colliderect", (PyCFunction)pg_rectarray_colliderect, METH_VARARGS,
+     DOC_RECTARRAYCOLLIDERECT},
+    {NULL, NULL, 0, NULL}};
+
+static PySequenceMethods pg_rectarray_as_sequence = {
+    .sq_length = (lenfunc)pg_rectarray_length,
+    .sq_item = (ssizeargfunc)pg_rectarray_item,
+    .sq_ass_item = (ssizeobjargproc)pg_rectarray_ass_item,
+};
+
+static PyBufferProcs pg_rectarray_as_buffer = {
+    (getbufferproc)pg_rectarray_getbuffer,
+    (releasebufferproc)pg_rectarray_releasebuffer};
+
+static PyTypeObject pgRectArray_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.RectArray",
+    .tp_basicsize = sizeof(pgRectArrayObject),
+    .tp_dealloc = (destructor)pg_rectarray_dealloc,
+    .tp_repr = (reprfunc)pg_rectarray_repr,
+    .tp_as_sequence = &pg_rectarray_as_sequence,
+    .tp_as_buffer = &pg_rectarray_as_buffer,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_PYGAMERECTARRAY,
+    .tp_methods = pg_rectarray_methods,
+    .tp_init = (initproc)pg_rectarray_init,
+    .tp_new = PyType_GenericNew,
+};
+
+/* RectPacker: places rects side by side inside a fixed area without
+ * overlapping, as for building texture atlases. It keeps the skyline of the
+ * area used so far: a list of segments across the area, each holding the
+ * y below which everything above it is used. A rect is put on the segment
+ * where its bottom ends up highest, so the area fills from the top down.
+ */
+typedef struct {
+    int x, y, w;
+} pgSkylineSegment;
+
+typedef struct {
+    PyObject_HEAD int width, height;
+    pgSkylineSegment *segments;
+    Py_ssize_t num_segments, segments_size;
+} pgRectPackerObject;
+
+/* Finds the y a w by h rect has when put on the segments from first on.
+ * Returns 0 if it does not fit there, 1 if it does.
+ */
+static int
+_pg_rectpacker_fit(pgRectPackerObject *self, Py_ssize_t first, int w, int h,
+                   int *y)
+{
+    pgSkylineSegment *seg = self->segments + first;
+    int x = seg->x, left = w;
+    Py_ssize_t i;
+
+    if (w > self->width - x) {
+        return 0;
+    }
+    *y = 0;
+    for (i = first; left > 0; ++i, ++seg) {
+        *y = MAX(*y, seg->y);
+        if (h > self->height - *y) {
+            return 0;
+        }
+        left -= seg->w;
+    }
+    return 1;
+}
+
+/* Places a w by h rect, which must have an area, into r. Returns 1 on
+ * success, 0 if there is no room left for it, and -1 with MemoryError set on
+ * failure.
+ */
+static int
+_pg_rectpacker_place(pgRectPackerObject *self, int w, int h, SDL_Rect *r)
+{
+    pgSkylineSegment *segs;
+    Py_ssize_t i, best = -1;
+    int y, best_y = 0, right;
+
+    for (i = 0; i < self->num_segments; ++i) {
+        /* the first of the highest fits is the one furthest left */
+        if (_pg_rectpacker_fit(self, i, w, h, &y) &&
+            (best < 0 || y < best_y)) {
+            best = i;
+            best_y = y;
+        }
+    }
+    if (best < 0) {
+        return 0;
+    }
+    if (_pg_rectindex_grow((void **)&self->segments, &self->segments_size,
+                           self->num_segments + 1,
+                           sizeof(pgSkylineSegment))) {
+        return -1;
+    }
+    segs = self->segments;
+    r->x = segs[best].x;
+    r->y = best_y;
+    r->w = w;
+    r->h = h;
+
+    /* the new segment along the bottom of r, in front of the ones it
+     * covers */
+    memmove(segs + best + 1, segs + best,
+            sizeof(pgSkylineSegment) * (self->num_segments - best));
+    self->num_segments++;
+    segs[best].x = r->x;
+    segs[best].y = r->y + h;
+    segs[best].w = w;
+
+    /* drop or shorten the segments now under r */
+    right = r->x + w;
+    i = best + 1;
+    while (i < self->num_segments && segs[i].x < right) {
+        if (segs[i].x + segs[i].w <= right) {
+            memmove(segs + i, segs + i + 1,
+                    sizeof(pgSkylineSegment) * (self->num_segments - i - 1));
+            self->num_segments--;
+            continue;
+        }
+        segs[i].w -= right - segs[i].x;
+        segs[i].x = right;
+        break;
+    }
+
+    /* join neighbouring segments at the same height */
+    for (i = 0; i + 1 < self->num_segments;) {
+        if (segs[i].y == segs[i + 1].y) {
+            segs[i].w += segs[i + 1].w;
+            memmove(segs + i + 1, segs + i + 2,
+                    sizeof(pgSkylineSegment) * (self->num_segments - i - 2));
+            self->num_segments--;
+        }
+        else {
+            ++i;
+        }
+    }
+    return 1;
+}
+
+/* Places a rect of the size in obj, returning it as a Rect, or None if there
+ * is no room left for it. Returns NULL with an exception set on failure.
+ */
+static PyObject *
+_pg_rectpacker_insert(pgRectPackerObject *self, PyObject *obj)
+{
+    SDL_Rect r = {0, 0, 0, 0};
+    int w, h, placed;
+
+    if (!pg_TwoIntsFromObj(obj, &w, &h)) {
+        return RAISE(PyExc_TypeError, "size must contain two numbers");
+    }
+    if (w < 0 || h < 0) {
+        return RAISE(PyExc_ValueError, "size must not be negative");
+    }
+    if (w && h) {
+        placed = _pg_rectpacker_place(self, w, h, &r);
+        if (placed < 0) {
+            return NULL;
+        }
+        if (!placed) {
+            Py_RETURN_NONE;
+        }
+    }
+    else {
+        /* a rect without area takes no room */
+        r.w = w;
+        r.h = h;
+    }
+    return pgRect_New(&r);
+}
+
+static void
+_pg_rectpacker_reset(pgRectPackerObject *self)
+{
+    self->num_segments = 0;
+    if (self->segments_size) {
+        self->segments[0].x = 0;
+        self->segments[0].y = 0;
+        self->segments[0].w = self->width;
+        self->num_segments = 1;
+    }
+}
+
+static int
+pg_rectpacker_init(pgRectPackerObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *size;
+    int width, height;
+    static char *keywords[] = {"size", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O", keywords, &size)) {
+        return -1;
+    }
+    if (!pg_TwoIntsFromObj(size, &width, &height)) {
+        PyErr_SetString(PyExc_TypeError, "size must contain two numbers");
+        return -1;
+    }
+    if (width < 0 || height < 0) {
+        PyErr_SetString(PyExc_ValueError, "size must not be negative");
+        return -1;
+    }
+    if (_pg_rectindex_grow((void **)&self->segments, &self->segments_size, 1,
+                           sizeof(pgSkylineSegment))) {
+        return -1;
+    }
+    self->width = width;
+    self->height = height;
+    _pg_rectpacker_reset(self);
+    return 0;
+}
+
+static void
+pg_rectpacker_dealloc(pgRectPackerObject *self)
+{
+    PyMem_Free(self->segments);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+pg_rectpacker_insert(pgRectPackerObject *self, PyObject *args)
+{
+    return _pg_rectpacker_insert(self, args);
+}
+
+typedef struct {
+    Py_ssize_t index;
+    int w, h;
+} pgRectPackerItem;
+
+static int
+_pg_rectpacker_compare_items(const void *a, const void *b)
+{
+    const pgRectPackerItem *ia = a, *ib = b;
+
+    /* tallest first, then widest, then in the order given */
+    if (ia->h != ib->h) {
+        return ia->h < ib->h ? 1 : -1;
+    }
+    if (ia->w != ib->w) {
+        return ia->w < ib->w ? 1 : -1;
+    }
+    return (ia->index > ib->index) - (ia->index < ib->index);
+}
+
+static PyObject *
+pg_rectpacker_insertlist(pgRectPackerObject *self, PyObject *arg)
+{
+    PyObject *seq, *ret = NULL, *item;
+    pgRectPackerItem *items = NULL;
+    Py_ssize_t i, size;
+    int placed;
+    SDL_Rect r;
+
+    seq = PySequence_Fast(arg, "Argument must be a sequence of sizes.");
+    if (!seq) {
+        return NULL;
+    }
+    size = PySequence_Fast_GET_SIZE(seq);
+    items = PyMem_New(pgRectPackerItem, MAX(size, 1));
+    if (!items) {
+        PyErr_NoMemory();
+        goto error;
+    }
+    for (i = 0; i < size; ++i) {
+        items[i].index = i;
+        if (!pg_TwoIntsFromObj(PySequence_Fast_GET_ITEM(seq, i), &items[i].w,
+                               &items[i].h)) {
+            PyErr_SetString(PyExc_TypeError,
+                            "Argument must be a sequence of sizes.");
+            goto error;
+        }
+        if (items[i].w < 0 || items[i].h < 0) {
+            PyErr_SetString(PyExc_ValueError, "size must not be negative");
+            goto error;
+        }
+    }
+    /* rects placed from the tallest down leave the fewest gaps */
+    qsort(items, size, sizeof(pgRectPackerItem),
+          _pg_rectpacker_compare_items);
+
+    ret = PyList_New(size);
+    if (!ret) {
+        goto error;
+    }
+    for (i = 0; i < size; ++i) {
+        r.x = r.y = 0;
+        r.w = items[i].w;
+        r.h = items[i].h;
+        placed = 1;
+        if (r.w && r.h) {
+            placed = _pg_rectpacker_place(self, r.w, r.h, &r);
+            if (placed < 0) {
+                goto error;
+            }
+        }
+        if (placed) {
+            item = pgRect_New(&r);
+            if (!item) {
+                goto error;
+            }
+        }
+        else {
+            item = Py_None;
+            Py_INCREF(item);
+        }
+        PyList_SET_ITEM(ret, items[i].index, item);
+    }
+    PyMem_Free(items);
+    Py_DECREF(seq);
+    return ret;
+
+error:
+    PyMem_Free(items);
+    Py_DECREF(seq);
+    Py_XDECREF(ret);
+    return NULL;
+}
+
+static PyObject *
+pg_rectpacker_clear(pgRectPackerObject *self, PyObject *_null)
+{
+    _pg_rectpacker_reset(self);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_rectpacker_get_size(pgRectPackerObject *self, void *closure)
+{
+    return Py_BuildValue("(ii)", self->width, self->height);
+}
+
+static PyMethodDef pg_rectpacker_methods[] = {
+    {"insert", (PyCFunction)pg_rectpacker_insert, METH_VARARGS,
+     DOC_RECTPACKERINSERT},
+    {"insertlist", (PyCFunction)pg_rectpacker_insertlist, METH_O,
+     DOC_RECTPACKERINSERTLIST},
+    {"clear", (PyCFunction)pg_rectpacker_clear, METH_NOARGS,
+     DOC_RECTPACKERCLEAR},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef pg_rectpacker_getsets[] = {
+    {"size", (getter)pg_rectpacker_get_size, NULL, DOC_RECTPACKERSIZE, NULL},
+    {NULL, 0, NULL, NULL, NULL}};
+
+static PyTypeObject pgRectPacker_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.RectPacker",
+    .tp_basicsize = sizeof(pgRectPackerObject),
+    .tp_dealloc = (destructor)pg_rectpacker_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_PYGAMERECTPACKER,
+    .tp_methods = pg_rectpacker_methods,
+    .tp_getset = pg_rectpacker_getsets,
+    .tp_init = (initproc)pg_rectpacker_init,
+    .tp_new = PyType_GenericNew,
+};
+
+#ifndef PYPY_VERSION
+static PyObject *
+pg_rect_freelist_stats(PyObject *self, PyObject *_null)
+{
+    return pgFreeList_Stats(&pg_rect_freelist);
+}
+#endif
+
+static PyMethodDef _pg_module_methods[] = {
+#ifndef PYPY_VERSION
+    {"_freelist_stats", pg_rect_freelist_stats, METH_NOARGS,
+     "_freelist_stats() -> dict\nreturns how often new Rects reused "
+     "deallocated ones"},
+#endif
+    {NULL, NULL, 0, NULL}};
+
+/*DOC*/ static char _pg_module_doc[] =
+    /*DOC*/ "Module for the rectangle object\n";
+
+MODINIT_DEFINE(rect)
+{
+    PyObject *module, *apiobj;
+    static void *c_api[PYGAMEAPI_RECT_NUMSLOTS];
+
+    static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
+                                         "rect",
+                                         _pg_module_doc,
+                                         -1,
+                                         _pg_module_methods,
+                                         NULL,
+                                         NULL,
+                                         NULL,
+                                         NULL};
+
+    /* import needed apis; Do this first so if there is an error
+       the module is not loaded.
+    */
+    import_pygame_base();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
+    pg_rect_attr_name = PyUnicode_InternFromString("rect");
+    if (pg_rect_attr_name == NULL) {
+        return NULL;
+    }
+
+    /* Create the module and add the functions */
+    if (PyType_Ready(&pgRect_Type) < 0) {
+        return NULL;
+    }
+    if (PyType_Ready(&pgFRect_Type) < 0) {
+        return NULL;
+    }
+    if (PyType_Ready(&pgRectIndex_Type) < 0) {
+        return NULL;
+    }
+    if (PyType_Ready(&pgRectArray_Type) < 0) {
+        return NULL;
+    }
+    if (PyType_Ready(&pgRectPacker_Type) < 0) {
+        return NULL;
+    }
+
+    module = PyModule_Create(&_module);
+    if (module == NULL) {
+        return NULL;
+    }
+
+    Py_INCREF(&pgRect_Type);
+    if (PyModule_AddObject(module, "RectType", (PyObject *)&pgRect_Type)) {
+        Py_DECREF(&pgRect_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+    Py_INCREF(&pgRect_Type);
+    if (PyModule_AddObject(module, "Rect", (PyObject *)&pgRect_Type)) {
+        Py_DECREF(&pgRect_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+    Py_INCREF(&pgFRect_Type);
+    if (PyModule_AddObject(module, "FRect", (PyObject *)&pgFRect_Type)) {
+        Py_DECREF(&pgFRect_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+    Py_INCREF(&pgRectIndex_Type);
+    if (PyModule_AddObject(module, "RectIndex",
+                           (PyObject *)&pgRectIndex_Type)) {
+        Py_DECREF(&pgRectIndex_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+    Py_INCREF(&pgRectArray_Type);
+    if (PyModule_AddObject(module, "RectArray",
+                           (PyObject *)&pgRectArray_Type)) {
+        Py_DECREF(&pgRectArray_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+    Py_INCREF(&pgRectPacker_Type);
+    if (PyModule_AddObject(module, "RectPacker",
+                           (PyObject *)&pgRectPacker_Type)) {
+        Py_DECREF(&pgRectPacker_Type);
         Py_DECREF(module);
         return NULL;
     }
@@ -2246,6 +5259,9 @@ MODINIT_DEFINE(rect)
     c_api[2] = pgRect_New4;
     c_api[3] = pgRect_FromObject;
     c_api[4] = pgRect_Normalize;
+    c_api[5] = &pgFRect_Type;
+    c_api[6] = pgFRect_New4;
+    c_api[7] = pgFRect_FromObject;
     apiobj = encapsulate_api(c_api, "rect");
     if (PyModule_AddObject(module, PYGAMEAPI_LOCAL_ENTRY, apiobj)) {
         Py_XDECREF(apiobj);
@@ -40,6 +40,11 @@
 #define PG_LSEEK lseek64
 #endif
 
+/* Reads from file objects without a file descriptor go through a buffer
+ * of this size, so decoders asking for a few bytes at a time do not take
+ * the GIL and call into Python for each of them. */
+#define PG_RW_READ_AHEAD 65536
+
 typedef struct {
     PyObject *read;
     PyObject *write;
@@ -48,6 +53,17 @@ typedef struct {
     PyObject *close;
     PyObject *file;
     int fileno;
+    /* Bytes of the file not yet read are buf[pos] up to buf[len], and the
+     * file object is at end_pos, just past them, or -1 when not known.
+     * buf is the read-ahead buffer, or the exported contents of a file
+     * read in place (view.obj is set), whose position only moves when
+     * the file is used directly. */
+    char *ahead;
+    const char *buf;
+    Py_ssize_t pos;
+    Py_ssize_t len;
+    Sint64 end_pos;
+    Py_buffer view;
 } pgRWHelper;
 
 /*static const char pg_default_encoding[] = "unicode_escape";*/
@@ -285,6 +301,120 @@ pgRWops_GetFileExtension(SDL_RWops *rw)
     }
 }
 
+/* Moves the file object to the position the reads have got to and drops
+ * the buffered bytes, before the file object is used directly. Must be
+ * called with the GIL held. Returns -1 with an exception set on failure.
+ */
+static int
+_pg_rw_sync(pgRWHelper *helper)
+{
+    PyObject *result = NULL;
+    Py_ssize_t unread = helper->len - helper->pos;
+
+    if (helper->view.obj) {
+        /* the file is read in place and has not moved */
+        PyBuffer_Release(&helper->view);
+        result = PyObject_CallFunction(helper->seek, "n", helper->pos);
+        helper->end_pos = -1;
+    }
+    else if (unread > 0) {
+        result = PyObject_CallFunction(helper->seek, "ni", -unread, SEEK_CUR);
+        if (helper->end_pos != -1) {
+            helper->end_pos -= unread;
+        }
+    }
+    else {
+        helper->pos = helper->len = 0;
+        return 0;
+    }
+    helper->buf = helper->ahead;
+    helper->pos = helper->len = 0;
+
+    if (!result) {
+        helper->end_pos = -1;
+        return -1;
+    }
+    Py_DECREF(result);
+    return 0;
+}
+
+/* Sets up how reads from a file object without a file descriptor are
+ * buffered. Files exposing their contents, io.BytesIO through getbuffer()
+ * and mmap through the buffer protocol, are read in place. Others get a
+ * read-ahead buffer, if they can seek back over what was read ahead.
+ * Returns -1 with an exception set on failure.
+ */
+static int
+_pg_rw_init_buffer(pgRWHelper *helper, PyObject *obj)
+{
+    PyObject *mem = NULL;
+    PyObject *result;
+    Py_ssize_t pos;
+    int seekable = 1;
+
+    if (!helper->read || !helper->seek || !helper->tell) {
+        return 0;
+    }
+
+    if (PyObject_CheckBuffer(obj)) {
+        mem = obj;
+        Py_INCREF(mem);
+    }
+    else if (PyObject_HasAttrString(obj, "getbuffer")) {
+        mem = PyObject_CallMethod(obj, "getbuffer", NULL);
+        if (!mem) {
+            PyErr_Clear();
+        }
+    }
+    if (mem) {
+        result = PyObject_CallFunction(helper->tell, NULL);
+        pos = result ? PyLong_AsSsize_t(result) : -1;
+        Py_XDECREF(result);
+        if (pos >= 0 &&
+            !PyObject_GetBuffer(mem, &helper->view, PyBUF_SIMPLE)) {
+            Py_DECREF(mem);
+            helper->buf = (const char *)helper->view.buf;
+            helper->len = helper->view.len;
+            helper->pos = pos;
+            helper->end_pos = helper->view.len;
+            return 0;
+        }
+        PyErr_Clear();
+        Py_DECREF(mem);
+    }
+
+    if (PyObject_HasAttrString(obj, "seekable")) {
+        result = PyObject_CallMethod(obj, "seekable", NULL);
+        seekable = result ? PyObject_IsTrue(result) : 0;
+        Py_XDECREF(result);
+        PyErr_Clear();
+    }
+    if (seekable != 1) {
+        return 0;
+    }
+
+    helper->ahead = PyMem_Malloc(PG_RW_READ_AHEAD);
+    if (!helper->ahead) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    helper->buf = helper->ahead;
+    return 0;
+}
+
+/* Frees the buffers of a helper. Must be called with the GIL held. */
+static void
+_pg_rw_free_buffer(pgRWHelper *helper)
+{
+    if (helper->view.obj) {
+        PyBuffer_Release(&helper->view);
+    }
+    PyMem_Free(helper->ahead);
+    helper->ahead = NULL;
+    helper->buf = NULL;
+    helper->pos = helper->len = 0;
+}
+
 static Sint64
 _pg_rw_size(SDL_RWops *context)
 {
@@ -297,6 +427,8 @@ _pg_rw_size(SDL_RWops *context)
     PyGILState_STATE state;
 #endif /* WITH_THREAD */
 
+    if (helper->view.obj)
+        return helper->len;
     if (!helper->seek || !helper->tell)
         return retval;
 #ifdef WITH_THREAD
@@ -304,6 +436,7 @@ _pg_rw_size(SDL_RWops *context)
 #endif /* WITH_THREAD */
 
     /* Current file position; need to restore it later.
+     * This is past any bytes read ahead, which stay valid.
      */
     pos = PyObject_CallFunction(helper->tell, NULL);
     if (!pos) {
@@ -361,29 +494,25 @@ end:
 static size_t
 _pg_rw_write(SDL_RWops *context, const void *ptr, size_t size, size_t num)
 {
-#ifndef WITH_THREAD
-    pgRWHelper *helper = (pgRWHelper *)context->hidden.unknown.data1;
-    PyObject *result;
-
-    if (!helper->write)
-        return -1;
-
-    result = PyObject_CallFunction(helper->write, "y#", (const char *)ptr,
-                                   (Py_ssize_t)size * num);
-    if (!result)
-        return -1;
-
-    Py_DECREF(result);
-    return num;
-#else  /* WITH_THREAD */
     pgRWHelper *helper = (pgRWHelper *)context->hidden.unknown.data1;
     PyObject *result;
     size_t retval;
-
+#ifdef WITH_THREAD
     PyGILState_STATE state;
+#endif /* WITH_THREAD */
+
     if (!helper->write)
         return -1;
+#ifdef WITH_THREAD
     state = PyGILState_Ensure();
+#endif /* WITH_THREAD */
+
+    /* write where the reads got to, not past the bytes read ahead */
+    if (_pg_rw_sync(helper)) {
+        PyErr_Print();
+        retval = -1;
+        goto end;
+    }
 
     result = PyObject_CallFunction(helper->write, "y#", (const char *)ptr,
                                    (Py_ssize_t)size * num);
@@ -394,12 +523,16 @@ _pg_rw_write(SDL_RWops *context, const void *ptr, size_t size, size_t num)
     }
 
     Py_DECREF(result);
+    if (helper->end_pos != -1) {
+        helper->end_pos += (Sint64)(size * num);
+    }
     retval = num;
 
 end:
+#ifdef WITH_THREAD
     PyGILState_Release(state);
-    return retval;
 #endif /* WITH_THREAD */
+    return retval;
 }
 
 static int
@@ -413,6 +546,9 @@ _pg_rw_close(SDL_RWops *context)
     state = PyGILState_Ensure();
 #endif /* WITH_THREAD */
 
+    /* an io.BytesIO can not be closed while its buffer is exported */
+    _pg_rw_free_buffer(helper);
+
     if (helper->close) {
         result = PyObject_CallFunction(helper->close, NULL);
         if (!result) {
@@ -451,6 +587,11 @@ pgRWops_FromFileObject(PyObject *obj)
     if (helper == NULL) {
         return (SDL_RWops *)PyErr_NoMemory();
     }
+    helper->ahead = NULL;
+    helper->buf = NULL;
+    helper->pos = helper->len = 0;
+    helper->end_pos = -1;
+    helper->view.obj = NULL;
     helper->fileno = PyObject_AsFileDescriptor(obj);
     if (helper->fileno == -1)
         PyErr_Clear();
@@ -458,9 +599,14 @@ pgRWops_FromFileObject(PyObject *obj)
         PyMem_Free(helper);
         return NULL;
     }
+    if (helper->fileno == -1 && _pg_rw_init_buffer(helper, obj)) {
+        PyMem_Free(helper);
+        return NULL;
+    }
 
     rw = SDL_AllocRW();
     if (rw == NULL) {
+        _pg_rw_free_buffer(helper);
         PyMem_Free(helper);
         return (SDL_RWops *)PyErr_NoMemory();
     }
@@ -501,10 +647,20 @@ pgRWops_ReleaseObject(SDL_RWops *context)
 
         pgRWHelper *helper = (pgRWHelper *)context->hidden.unknown.data1;
         PyObject *fileobj = helper->file;
-        /* 5 helper functions */
-        Py_ssize_t filerefcnt = Py_REFCNT(fileobj) - 1 - 5;
+        /* 5 helper functions, and the exported buffer */
+        Py_ssize_t filerefcnt =
+            Py_REFCNT(fileobj) - 1 - 5 - (helper->view.obj ? 1 : 0);
+        PyObject *type, *value, *traceback;
 
         if (filerefcnt) {
+            /* leave the file where the reads got to, keeping any error
+             * the caller is about to raise */
+            PyErr_Fetch(&type, &value, &traceback);
+            if (_pg_rw_sync(helper))
+                PyErr_Clear();
+            PyErr_Restore(type, value, traceback);
+            _pg_rw_free_buffer(helper);
+
             Py_XDECREF(helper->seek);
             Py_XDECREF(helper->tell);
             Py_XDECREF(helper->write);
@@ -541,8 +697,10 @@ _pg_rw_seek(SDL_RWops *context, Sint64 offset, int whence)
     pgRWHelper *helper = (pgRWHelper *)context->hidden.unknown.data1;
     PyObject *result;
     Sint64 retval;
+    Sint64 start, target = -1;
 #ifdef WITH_THREAD
     PyGILState_STATE state;
+#endif /* WITH_THREAD */
 
     if (helper->fileno != -1) {
         return PG_LSEEK(helper->fileno, offset, whence);
@@ -551,15 +709,47 @@ _pg_rw_seek(SDL_RWops *context, Sint64 offset, int whence)
     if (!helper->seek || !helper->tell)
         return -1;
 
+    /* Seeks over the buffered bytes need no call into Python. */
+    if (helper->buf && helper->end_pos != -1) {
+        start = helper->end_pos - helper->len;
+        if (whence == SEEK_SET)
+            target = offset;
+        else if (whence == SEEK_CUR)
+            target = start + helper->pos + offset;
+        else if (whence == SEEK_END && helper->view.obj)
+            target = helper->len + offset;
+
+        if (helper->view.obj) {
+            /* as io.BytesIO does, relative seeks stop at the start */
+            if (whence != SEEK_SET && target < 0)
+                target = 0;
+            if (target < 0 || target > PY_SSIZE_T_MAX)
+                return -1;
+            helper->pos = (Py_ssize_t)target;
+            return target;
+        }
+        if (target >= start && target <= helper->end_pos) {
+            helper->pos = (Py_ssize_t)(target - start);
+            return target;
+        }
+    }
+
+#ifdef WITH_THREAD
     state = PyGILState_Ensure();
+#endif /* WITH_THREAD */
 
     if (!(offset == 0 &&
           whence == SEEK_CUR)) /* being seek'd, not just tell'd */
     {
+        if (whence == SEEK_CUR)
+            offset -= helper->len - helper->pos;
+        helper->pos = helper->len = 0;
+
         result = PyObject_CallFunction(helper->seek, "Li", (long long)offset,
                                        whence);
         if (!result) {
             PyErr_Print();
+            helper->end_pos = -1;
             retval = -1;
             goto end;
         }
@@ -569,6 +759,7 @@ _pg_rw_seek(SDL_RWops *context, Sint64 offset, int whence)
     result = PyObject_CallFunction(helper->tell, NULL);
     if (!result) {
         PyErr_Print();
+        helper->end_pos = -1;
         retval = -1;
         goto end;
     }
@@ -579,39 +770,17 @@ _pg_rw_seek(SDL_RWops *context, Sint64 offset, int whence)
 
     Py_DECREF(result);
 
+    /* the file is past the bytes still buffered */
+    helper->end_pos = retval;
+    if (retval != -1)
+        retval -= helper->len - helper->pos;
+
 end:
+#ifdef WITH_THREAD
     PyGILState_Release(state);
+#endif /* WITH_THREAD */
 
     return retval;
-#else  /* ~WITH_THREAD */
-    if (helper->fileno != -1) {
-        return PG_LSEEK(helper->fileno, offset, whence);
-    }
-
-    if (!helper->seek || !helper->tell)
-        return -1;
-
-    if (!(offset == 0 && whence == SEEK_CUR)) /*being called only for 'tell'*/
-    {
-        result = PyObject_CallFunction(helper->seek, "Li", (long long)offset,
-                                       whence);
-        if (!result)
-            return -1;
-        Py_DECREF(result);
-    }
-
-    result = PyObject_CallFunction(helper->tell, NULL);
-    if (!result)
-        return -1;
-
-    retval = PyLong_AsLongLong(result);
-    if (retval == -1 && PyErr_Occurred())
-        PyErr_Clear();
-
-    Py_DECREF(result);
-
-    return retval;
-#endif /* ~WITH_THREAD*/
 }
 
 static size_t
@@ -620,6 +789,7 @@ _pg_rw_read(SDL_RWops *context, void *ptr, size_t size, size_t maxnum)
     pgRWHelper *helper = (pgRWHelper *)context->hidden.unknown.data1;
     PyObject *result;
     Py_ssize_t retval;
+    Py_ssize_t want, got = 0, n;
 #ifdef WITH_THREAD
     PyGILState_STATE state;
 #endif /* WITH_THREAD */
@@ -636,29 +806,60 @@ _pg_rw_read(SDL_RWops *context, void *ptr, size_t size, size_t maxnum)
     if (!helper->read)
         return -1;
 
+    want = (Py_ssize_t)(size * maxnum);
+    if (want == 0)
+        return 0;
+
+    /* Served from the buffered bytes without taking the GIL. */
+    if (helper->pos < helper->len) {
+        n = helper->len - helper->pos;
+        if (n > want)
+            n = want;
+        memcpy(ptr, helper->buf + helper->pos, n);
+        helper->pos += n;
+        got = n;
+    }
+    if (got == want || helper->view.obj)
+        return got / size;
+
 #ifdef WITH_THREAD
     state = PyGILState_Ensure();
 #endif /* WITH_THREAD */
-    result = PyObject_CallFunction(helper->read, "K",
-                                   (unsigned long long)size * maxnum);
+    /* Small reads fill the read-ahead buffer, large ones go straight
+     * through. */
+    n = want - got;
+    if (helper->ahead && n < PG_RW_READ_AHEAD)
+        n = PG_RW_READ_AHEAD;
+    result = PyObject_CallFunction(helper->read, "n", n);
     if (!result) {
         PyErr_Print();
-        retval = -1;
+        retval = got ? got / size : -1;
         goto end;
     }
 
     if (!PyBytes_Check(result)) {
         Py_DECREF(result);
         PyErr_Print();
-        retval = -1;
+        retval = got ? got / size : -1;
         goto end;
     }
 
-    retval = PyBytes_GET_SIZE(result);
-    if (retval) {
-        memcpy(ptr, PyBytes_AsString(result), retval);
-        retval /= size;
+    n = PyBytes_GET_SIZE(result);
+    if (helper->end_pos != -1)
+        helper->end_pos += n;
+    if (n > want - got) {
+        memcpy(helper->ahead, PyBytes_AS_STRING(result), n);
+        memcpy((char *)ptr + got, helper->ahead, want - got);
+        helper->len = n;
+        helper->pos = want - got;
+        got = want;
+    }
+    else {
+        memcpy((char *)ptr + got, PyBytes_AS_STRING(result), n);
+        helper->pos = helper->len = 0;
+        got += n;
     }
+    retval = got / size;
 
     Py_DECREF(result);
 
@@ -833,6 +1034,445 @@ pg_encode_file_path(PyObject *self, PyObject *args, PyObject *keywds)
     return pg_EncodeFilePath(obj, eclass);
 }
 
+/* Bundles: zip archives of stored entries, mapped into memory once. Each
+ * entry opens as a file object over its part of the mapping, exporting it
+ * through the buffer protocol, so loaders read it in place.
+ */
+typedef struct {
+    PyObject_HEAD PyObject *mapping; /* the mmap.mmap of the archive */
+    Py_buffer view;
+    PyObject *index; /* name -> (offset, size, method, flags) */
+} pgBundleObject;
+
+typedef struct {
+    PyObject_HEAD pgBundleObject *bundle;
+    PyObject *name;
+    const char *data;
+    Py_ssize_t size;
+    Py_ssize_t pos;
+    int closed;
+} pgBundleEntryObject;
+
+static PyTypeObject pgBundle_Type;
+static PyTypeObject pgBundleEntry_Type;
+
+#define PG_ZIP_LOCAL_SIG 0x04034b50
+#define PG_ZIP_CENTRAL_SIG 0x02014b50
+#define PG_ZIP_END_SIG 0x06054b50
+
+static Uint32
+_pg_zip_u32(const Uint8 *p)
+{
+    return (Uint32)p[0] | ((Uint32)p[1] << 8) | ((Uint32)p[2] << 16) |
+           ((Uint32)p[3] << 24);
+}
+
+static Uint16
+_pg_zip_u16(const Uint8 *p)
+{
+    return (Uint16)(p[0] | (p[1] << 8));
+}
+
+/* Reads the central directory of the mapped archive into the index.
+ * Returns -1 with an exception set on failure.
+ */
+static int
+_pg_bundle_read_index(pgBundleObject *self)
+{
+    const Uint8 *data = (const Uint8 *)self->view.buf;
+    Py_ssize_t len = self->view.len;
+    Py_ssize_t end, p, local, offset;
+    Py_ssize_t name_len, count, i;
+    Uint32 size;
+    Uint16 flags, method;
+    PyObject *name, *value;
+
+    /* the end record is last, but for a comment of up to 65535 bytes */
+    for (end = len - 22; end >= 0 && end >= len - 22 - 65535; end--) {
+        if (_pg_zip_u32(data + end) == PG_ZIP_END_SIG) {
+            break;
+        }
+    }
+    if (end < 0 || end < len - 22 - 65535) {
+        PyErr_SetString(PyExc_ValueError, "not a zip archive");
+        return -1;
+    }
+    count = _pg_zip_u16(data + end + 10);
+    p = (Py_ssize_t)_pg_zip_u32(data + end + 16);
+    if (count == 0xFFFF || _pg_zip_u32(data + end + 16) == 0xFFFFFFFF) {
+        PyErr_SetString(PyExc_ValueError,
+                        "zip64 archives are not supported");
+        return -1;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (p < 0 || p > len - 46 ||
+            _pg_zip_u32(data + p) != PG_ZIP_CENTRAL_SIG) {
+            goto corrupt;
+        }
+        flags = _pg_zip_u16(data + p + 8);
+        method = _pg_zip_u16(data + p + 10);
+        size = _pg_zip_u32(data + p + 20);
+        name_len = _pg_zip_u16(data + p + 28);
+        local = (Py_ssize_t)_pg_zip_u32(data + p + 42);
+        if (name_len > len - 46 - p) {
+            goto corrupt;
+        }
+
+        /* the data follows the local header, whose extra field may differ
+         * from the one in the central directory */
+        if (local < 0 || local > len - 30 ||
+            _pg_zip_u32(data + local) != PG_ZIP_LOCAL_SIG) {
+            goto corrupt;
+        }
+        offset = local + 30 + _pg_zip_u16(data + local + 26) +
+                 _pg_zip_u16(data + local + 28);
+        if (offset > len || (Py_ssize_t)size > len - offset) {
+            goto corrupt;
+        }
+
+        if (flags & 0x800) {
+            name = PyUnicode_DecodeUTF8((const char *)data + p + 46,
+                                        name_len, NULL);
+        }
+        else {
+            name = PyUnicode_Decode((const char *)data + p + 46, name_len,
+                                    "cp437", NULL);
+        }
+        if (!name) {
+            return -1;
+        }
+        /* directories take no space */
+        if (name_len && data[p + 46 + name_len - 1] == '/') {
+            Py_DECREF(name);
+        }
+        else {
+            value = Py_BuildValue("(nnii)", offset, (Py_ssize_t)size,
+                                  (int)method, (int)flags);
+            if (!value || PyDict_SetItem(self->index, name, value)) {
+                Py_XDECREF(value);
+                Py_DECREF(name);
+                return -1;
+            }
+            Py_DECREF(value);
+            Py_DECREF(name);
+        }
+
+        p += 46 + name_len + _pg_zip_u16(data + p + 30) +
+             _pg_zip_u16(data + p + 32);
+    }
+    return 0;
+
+corrupt:
+    PyErr_SetString(PyExc_ValueError, "corrupt zip archive");
+    return -1;
+}
+
+/* Maps the whole file at path read only, returning an mmap.mmap. */
+static PyObject *
+pg_MapFile(PyObject *path)
+{
+    PyObject *io, *mmap, *file, *fileno, *func, *args, *kwargs;
+    PyObject *mapping = NULL;
+    PyObject *type, *value, *traceback;
+
+    io = PyImport_ImportModule("io");
+    if (!io) {
+        return NULL;
+    }
+    mmap = PyImport_ImportModule("mmap");
+    if (!mmap) {
+        Py_DECREF(io);
+        return NULL;
+    }
+    file = PyObject_CallMethod(io, "open", "Os", path, "rb");
+    Py_DECREF(io);
+    if (!file) {
+        Py_DECREF(mmap);
+        return NULL;
+    }
+
+    fileno = PyObject_CallMethod(file, "fileno", NULL);
+    if (fileno) {
+        func = PyObject_GetAttrString(mmap, "mmap");
+        args = Py_BuildValue("(Oi)", fileno, 0);
+        kwargs = Py_BuildValue(
+            "{sN}", "access", PyObject_GetAttrString(mmap, "ACCESS_READ"));
+        if (func && args && kwargs) {
+            mapping = PyObject_Call(func, args, kwargs);
+        }
+        Py_XDECREF(func);
+        Py_XDECREF(args);
+        Py_XDECREF(kwargs);
+        Py_DECREF(fileno);
+    }
+    Py_DECREF(mmap);
+
+    /* the mapping keeps its own handle to the file */
+    PyErr_Fetch(&type, &value, &traceback);
+    Py_XDECREF(PyObject_CallMethod(file, "close", NULL));
+    PyErr_Clear();
+    PyErr_Restore(type, value, traceback);
+    Py_DECREF(file);
+    return mapping;
+}
+
+static int
+pg_bundle_init(pgBundleObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *path;
+    static char *keywords[] = {"file", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O", keywords, &path)) {
+        return -1;
+    }
+    if (self->index) {
+        PyErr_SetString(PyExc_RuntimeError, "Bundle is already open");
+        return -1;
+    }
+
+    self->mapping = pg_MapFile(path);
+    if (!self->mapping) {
+        return -1;
+    }
+    if (PyObject_GetBuffer(self->mapping, &self->view, PyBUF_SIMPLE)) {
+        return -1;
+    }
+    self->index = PyDict_New();
+    if (!self->index) {
+        return -1;
+    }
+    return _pg_bundle_read_index(self);
+}
+
+static void
+pg_bundle_dealloc(pgBundleObject *self)
+{
+    if (self->view.obj) {
+        PyBuffer_Release(&self->view);
+    }
+    Py_XDECREF(self->mapping);
+    Py_XDECREF(self->index);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+pg_bundle_open(pgBundleObject *self, PyObject *name)
+{
+    pgBundleEntryObject *entry;
+    PyObject *value;
+    Py_ssize_t offset, size;
+    int method, flags;
+
+    if (!self->index) {
+        return RAISE(PyExc_ValueError, "Bundle is not open");
+    }
+    value = PyDict_GetItemWithError(self->index, name);
+    if (!value) {
+        if (!PyErr_Occurred()) {
+            PyErr_SetObject(PyExc_KeyError, name);
+        }
+        return NULL;
+    }
+    if (!PyArg_ParseTuple(value, "nnii", &offset, &size, &method, &flags)) {
+        return NULL;
+    }
+    if (method != 0 || (flags & 1)) {
+        return PyErr_Format(PyExc_ValueError,
+                            "entry %R is compressed or encrypted, only "
+                            "stored entries can be read in place",
+                            name);
+    }
+
+    entry = PyObject_New(pgBundleEntryObject, &pgBundleEntry_Type);
+    if (!entry) {
+        return NULL;
+    }
+    Py_INCREF(self);
+    entry->bundle = self;
+    Py_INCREF(name);
+    entry->name = name;
+    entry->data = (const char *)self->view.buf + offset;
+    entry->size = size;
+    entry->pos = 0;
+    entry->closed = 0;
+    return (PyObject *)entry;
+}
+
+static PyObject *
+pg_bundle_names(pgBundleObject *self, PyObject *_null)
+{
+    if (!self->index) {
+        return RAISE(PyExc_ValueError, "Bundle is not open");
+    }
+    return PyDict_Keys(self->index);
+}
+
+static Py_ssize_t
+pg_bundle_length(pgBundleObject *self)
+{
+    return self->index ? PyDict_Size(self->index) : 0;
+}
+
+static int
+pg_bundle_contains(pgBundleObject *self, PyObject *name)
+{
+    return self->index ? PyDict_Contains(self->index, name) : 0;
+}
+
+static PyMethodDef pg_bundle_methods[] = {
+    {"open", (PyCFunction)pg_bundle_open, METH_O, DOC_BUNDLEOPEN},
+    {"names", (PyCFunction)pg_bundle_names, METH_NOARGS, DOC_BUNDLENAMES},
+    {NULL, NULL, 0, NULL}};
+
+static PySequenceMethods pg_bundle_as_sequence = {
+    .sq_length = (lenfunc)pg_bundle_length,
+    .sq_contains = (objobjproc)pg_bundle_contains,
+};
+
+static PyTypeObject pgBundle_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.rwobject.Bundle",
+    .tp_basicsize = sizeof(pgBundleObject),
+    .tp_dealloc = (destructor)pg_bundle_dealloc,
+    .tp_as_sequence = &pg_bundle_as_sequence,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_PYGAMEBUNDLE,
+    .tp_methods = pg_bundle_methods,
+    .tp_init = (initproc)pg_bundle_init,
+    .tp_new = PyType_GenericNew,
+};
+
+static void
+pg_bundle_entry_dealloc(pgBundleEntryObject *self)
+{
+    Py_DECREF(self->bundle);
+    Py_DECREF(self->name);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+pg_bundle_entry_read(pgBundleEntryObject *self, PyObject *args)
+{
+    Py_ssize_t size = -1;
+    Py_ssize_t left;
+
+    if (!PyArg_ParseTuple(args, "|n", &size)) {
+        return NULL;
+    }
+    if (self->closed) {
+        return RAISE(PyExc_ValueError, "I/O operation on closed file");
+    }
+    left = self->pos < self->size ? self->size - self->pos : 0;
+    if (size < 0 || size > left) {
+        size = left;
+    }
+    self->pos += size;
+    return PyBytes_FromStringAndSize(self->data + self->pos - size, size);
+}
+
+static PyObject *
+pg_bundle_entry_seek(pgBundleEntryObject *self, PyObject *args)
+{
+    Py_ssize_t offset;
+    int whence = SEEK_SET;
+
+    if (!PyArg_ParseTuple(args, "n|i", &offset, &whence)) {
+        return NULL;
+    }
+    if (self->closed) {
+        return RAISE(PyExc_ValueError, "I/O operation on closed file");
+    }
+    if (whence == SEEK_CUR) {
+        offset += self->pos;
+    }
+    else if (whence == SEEK_END) {
+        offset += self->size;
+    }
+    else if (whence != SEEK_SET) {
+        return RAISE(PyExc_ValueError, "invalid whence");
+    }
+    if (offset < 0) {
+        return RAISE(PyExc_ValueError, "negative seek position");
+    }
+    self->pos = offset;
+    return PyLong_FromSsize_t(self->pos);
+}
+
+static PyObject *
+pg_bundle_entry_tell(pgBundleEntryObject *self, PyObject *_null)
+{
+    if (self->closed) {
+        return RAISE(PyExc_ValueError, "I/O operation on closed file");
+    }
+    return PyLong_FromSsize_t(self->pos);
+}
+
+static PyObject *
+pg_bundle_entry_true(pgBundleEntryObject *self, PyObject *_null)
+{
+    Py_RETURN_TRUE;
+}
+
+static PyObject *
+pg_bundle_entry_close(pgBundleEntryObject *self, PyObject *_null)
+{
+    self->closed = 1;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_bundle_entry_get_closed(pgBundleEntryObject *self, void *closure)
+{
+    return PyBool_FromLong(self->closed);
+}
+
+static PyObject *
+pg_bundle_entry_get_name(pgBundleEntryObject *self, void *closure)
+{
+    Py_INCREF(self->name);
+    return self->name;
+}
+
+static int
+pg_bundle_entry_getbuffer(pgBundleEntryObject *self, Py_buffer *view,
+                          int flags)
+{
+    if (self->closed) {
+        PyErr_SetString(PyExc_ValueError, "I/O operation on closed file");
+        view->obj = NULL;
+        return -1;
+    }
+    return PyBuffer_FillInfo(view, (PyObject *)self, (void *)self->data,
+                             self->size, 1, flags);
+}
+
+static PyMethodDef pg_bundle_entry_methods[] = {
+    {"read", (PyCFunction)pg_bundle_entry_read, METH_VARARGS, NULL},
+    {"seek", (PyCFunction)pg_bundle_entry_seek, METH_VARARGS, NULL},
+    {"tell", (PyCFunction)pg_bundle_entry_tell, METH_NOARGS, NULL},
+    {"readable", (PyCFunction)pg_bundle_entry_true, METH_NOARGS, NULL},
+    {"seekable", (PyCFunction)pg_bundle_entry_true, METH_NOARGS, NULL},
+    {"close", (PyCFunction)pg_bundle_entry_close, METH_NOARGS, NULL},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef pg_bundle_entry_getsets[] = {
+    {"closed", (getter)pg_bundle_entry_get_closed, NULL, NULL, NULL},
+    {"name", (getter)pg_bundle_entry_get_name, NULL, NULL, NULL},
+    {NULL, NULL, NULL, NULL, NULL}};
+
+static PyBufferProcs pg_bundle_entry_as_buffer = {
+    (getbufferproc)pg_bundle_entry_getbuffer, NULL};
+
+static PyTypeObject pgBundleEntry_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.rwobject.BundleEntry",
+    .tp_basicsize = sizeof(pgBundleEntryObject),
+    .tp_dealloc = (destructor)pg_bundle_entry_dealloc,
+    .tp_as_buffer = &pg_bundle_entry_as_buffer,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_methods = pg_bundle_entry_methods,
+    .tp_getset = pg_bundle_entry_getsets,
+};
+
 static PyMethodDef _pg_rwobject_methods[] = {
     {"encode_string", (PyCFunction)pg_encode_string,
      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEENCODESTRING},
@@ -858,12 +1498,24 @@ MODINIT_DEFINE(rwobject)
                                          NULL,
                                          NULL};
 
+    if (PyType_Ready(&pgBundle_Type) < 0 ||
+        PyType_Ready(&pgBundleEntry_Type) < 0) {
+        return NULL;
+    }
+
     /* Create the module and add the functions */
     module = PyModule_Create(&_module);
     if (module == NULL) {
         return NULL;
     }
 
+    Py_INCREF(&pgBundle_Type);
+    if (PyModule_AddObject(module, "Bundle", (PyObject *)&pgBundle_Type)) {
+        Py_DECREF(&pgBundle_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
     /* export the c api */
     c_api[0] = pgRWops_FromObject;
     c_api[1] = pgRWops_IsFileObject;
@@ -872,6 +1524,7 @@ MODINIT_DEFINE(rwobject)
     c_api[4] = pgRWops_FromFileObject;
     c_api[5] = pgRWops_ReleaseObject;
     c_api[6] = pgRWops_GetFileExtension;
+    c_api[7] = pg_MapFile;
     apiobj = encapsulate_api(c_api, "rwobject");
     if (PyModule_AddObject(module, PYGAMEAPI_LOCAL_ENTRY, apiobj)) {
         Py_XDECREF(apiobj);
@@ -30,9 +30,33 @@
    surprised with this code!
 */
 
-#include <SDL.h>
+/* _pygame.h rather than pygame.h: the API slots, read by the SIMD checks,
+   are the ones transform.c defines and imports */
+#include "_pygame.h"
+
+#include <string.h>
+
+#ifndef MAX
 #define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+#ifndef MIN
 #define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+// arm64 has neon optimisations enabled by default, even when fpu=neon is not
+// passed
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+#if defined(PG_ENABLE_ARM_NEON)
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "include/sse2neon.h"
+#define SCALE2X_SIMD
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SCALE2X_SIMD
+#endif
 
 #define READINT24(x) ((x)[0] << 16 | (x)[1] << 8 | (x)[2])
 #define WRITEINT24(x, i)          \
@@ -42,6 +66,68 @@
         x[2] = i & 0xff;          \
     }
 
+/* Whether the 32 bit kernels can use SSE2 or NEON */
+static int
+scale2x_use_simd(void)
+{
+#if defined(SCALE2X_SIMD) && defined(PG_ENABLE_ARM_NEON)
+    return pg_HasNEON();
+#elif defined(SCALE2X_SIMD)
+    return pg_HasSSE2();
+#else
+    return 0;
+#endif
+}
+
+/* Scale2x of the 32 bit pixel x of row, with above and below the rows
+   around it, into pixels 2x and 2x + 1 of out0 and out1. */
+static PG_INLINE void
+scale2x_pixel32(const Uint32 *above, const Uint32 *row, const Uint32 *below,
+                Uint32 *out0, Uint32 *out1, int x, int width)
+{
+    Uint32 B = above[x], D = row[MAX(0, x - 1)], E = row[x];
+    Uint32 F = row[MIN(width - 1, x + 1)], H = below[x];
+
+    out0[2 * x] = D == B && B != F && D != H ? D : E;
+    out0[2 * x + 1] = B == F && B != D && F != H ? F : E;
+    out1[2 * x] = D == H && D != B && H != F ? D : E;
+    out1[2 * x + 1] = H == F && D != H && B != F ? F : E;
+}
+
+#ifdef SCALE2X_SIMD
+#define SCALE2X_SELECT(mask, a, b) \
+    _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b))
+
+/* scale2x_pixel32() of the pixels x to x + 3, none of them at either end of
+   the row. */
+static PG_INLINE void
+scale2x_simd4(const Uint32 *above, const Uint32 *row, const Uint32 *below,
+              Uint32 *out0, Uint32 *out1, int x)
+{
+    __m128i B = _mm_loadu_si128((const __m128i *)(above + x));
+    __m128i D = _mm_loadu_si128((const __m128i *)(row + x - 1));
+    __m128i E = _mm_loadu_si128((const __m128i *)(row + x));
+    __m128i F = _mm_loadu_si128((const __m128i *)(row + x + 1));
+    __m128i H = _mm_loadu_si128((const __m128i *)(below + x));
+    __m128i db = _mm_cmpeq_epi32(D, B), bf = _mm_cmpeq_epi32(B, F);
+    __m128i dh = _mm_cmpeq_epi32(D, H), hf = _mm_cmpeq_epi32(H, F);
+    __m128i e0, e1, e2, e3;
+
+    /* D == B && B != F && D != H, and so on, as in scale2x_pixel32() */
+    e0 = SCALE2X_SELECT(_mm_andnot_si128(_mm_or_si128(bf, dh), db), D, E);
+    e1 = SCALE2X_SELECT(_mm_andnot_si128(_mm_or_si128(db, hf), bf), F, E);
+    e2 = SCALE2X_SELECT(_mm_andnot_si128(_mm_or_si128(db, hf), dh), D, E);
+    e3 = SCALE2X_SELECT(_mm_andnot_si128(_mm_or_si128(dh, bf), hf), F, E);
+
+    _mm_storeu_si128((__m128i *)(out0 + 2 * x), _mm_unpacklo_epi32(e0, e1));
+    _mm_storeu_si128((__m128i *)(out0 + 2 * x + 4),
+                     _mm_unpackhi_epi32(e0, e1));
+    _mm_storeu_si128((__m128i *)(out1 + 2 * x), _mm_unpacklo_epi32(e2, e3));
+    _mm_storeu_si128((__m128i *)(out1 + 2 * x + 4),
+                     _mm_unpackhi_epi32(e2, e3));
+}
+#endif /* SCALE2X_SIMD */
+
 /*
   this requires a destination surface already setup to be twice as
   large as the source. oh, and formats must match too. this will just
@@ -162,33 +248,31 @@ scale2x(SDL_Surface *src, SDL_Surface *dst)
             break;
         }
         default: { /*case 4:*/
-            Uint32 E0, E1, E2, E3, B, D, E, F, H;
-            for (looph = 0; looph < height; ++looph) {
-                for (loopw = 0; loopw < width; ++loopw) {
-                    B = *(Uint32 *)(srcpix + (MAX(0, looph - 1) * srcpitch) +
-                                    (4 * loopw));
-                    D = *(Uint32 *)(srcpix + (looph * srcpitch) +
-                                    (4 * MAX(0, loopw - 1)));
-                    E = *(Uint32 *)(srcpix + (looph * srcpitch) + (4 * loopw));
-                    F = *(Uint32 *)(srcpix + (looph * srcpitch) +
-                                    (4 * MIN(width - 1, loopw + 1)));
-                    H = *(Uint32 *)(srcpix +
-                                    (MIN(height - 1, looph + 1) * srcpitch) +
-                                    (4 * loopw));
+            int simd = scale2x_use_simd();
 
-                    E0 = D == B && B != F && D != H ? D : E;
-                    E1 = B == F && B != D && F != H ? F : E;
-                    E2 = D == H && D != B && H != F ? D : E;
-                    E3 = H == F && D != H && B != F ? F : E;
-
-                    *(Uint32 *)(dstpix + looph * 2 * dstpitch +
-                                loopw * 2 * 4) = E0;
-                    *(Uint32 *)(dstpix + looph * 2 * dstpitch +
-                                (loopw * 2 + 1) * 4) = E1;
-                    *(Uint32 *)(dstpix + (looph * 2 + 1) * dstpitch +
-                                loopw * 2 * 4) = E2;
-                    *(Uint32 *)(dstpix + (looph * 2 + 1) * dstpitch +
-                                (loopw * 2 + 1) * 4) = E3;
+            for (looph = 0; looph < height; ++looph) {
+                const Uint32 *above =
+                    (const Uint32 *)(srcpix + MAX(0, looph - 1) * srcpitch);
+                const Uint32 *row =
+                    (const Uint32 *)(srcpix + looph * srcpitch);
+                const Uint32 *below =
+                    (const Uint32 *)(srcpix +
+                                     MIN(height - 1, looph + 1) * srcpitch);
+                Uint32 *out0 = (Uint32 *)(dstpix + looph * 2 * dstpitch);
+                Uint32 *out1 = (Uint32 *)(dstpix + (looph * 2 + 1) * dstpitch);
+
+                loopw = 0;
+#ifdef SCALE2X_SIMD
+                if (simd && width > 5) {
+                    scale2x_pixel32(above, row, below, out0, out1, 0, width);
+                    for (loopw = 1; loopw + 4 < width; loopw += 4) {
+                        scale2x_simd4(above, row, below, out0, out1, loopw);
+                    }
+                }
+#endif /* SCALE2X_SIMD */
+                for (; loopw < width; ++loopw) {
+                    scale2x_pixel32(above, row, below, out0, out1, loopw,
+                                    width);
                 }
             }
             break;
@@ -196,114 +280,291 @@ scale2x(SDL_Surface *src, SDL_Surface *dst)
     }
 }
 
-void
-scale2xraw(SDL_Surface *src, SDL_Surface *dst)
+static PG_INLINE Uint32
+scale_read_pixel(const Uint8 *pix, int bpp)
 {
-    int looph, loopw;
+    switch (bpp) {
+        case 1:
+            return *pix;
+        case 2:
+            return *(const Uint16 *)pix;
+        case 3:
+            return READINT24(pix);
+        default:
+            return *(const Uint32 *)pix;
+    }
+}
 
-    Uint8 *srcpix = (Uint8 *)src->pixels;
-    Uint8 *dstpix = (Uint8 *)dst->pixels;
+static PG_INLINE void
+scale_write_pixel(Uint8 *pix, int bpp, Uint32 color)
+{
+    switch (bpp) {
+        case 1:
+            *pix = (Uint8)color;
+            break;
+        case 2:
+            *(Uint16 *)pix = (Uint16)color;
+            break;
+        case 3:
+            WRITEINT24(pix, color);
+            break;
+        default:
+            *(Uint32 *)pix = color;
+            break;
+    }
+}
 
-    const int srcpitch = src->pitch;
-    const int dstpitch = dst->pitch;
-    const int width = src->w;
-    const int height = src->h;
+/* Scale3x of pixel x of row, with above and below the rows around it, into
+   pixels 3x to 3x + 2 of out0, out1 and out2. The neighbours are named
+   A B C / D E F / G H I, as on the AdvanceMAME page. */
+static PG_INLINE void
+scale3x_pixel(const Uint8 *above, const Uint8 *row, const Uint8 *below,
+              Uint8 *out0, Uint8 *out1, Uint8 *out2, int x, int width,
+              int bpp)
+{
+    int left = MAX(0, x - 1) * bpp, right = MIN(width - 1, x + 1) * bpp;
+    Uint32 A = scale_read_pixel(above + left, bpp);
+    Uint32 B = scale_read_pixel(above + x * bpp, bpp);
+    Uint32 C = scale_read_pixel(above + right, bpp);
+    Uint32 D = scale_read_pixel(row + left, bpp);
+    Uint32 E = scale_read_pixel(row + x * bpp, bpp);
+    Uint32 F = scale_read_pixel(row + right, bpp);
+    Uint32 G = scale_read_pixel(below + left, bpp);
+    Uint32 H = scale_read_pixel(below + x * bpp, bpp);
+    Uint32 I = scale_read_pixel(below + right, bpp);
+    int c0 = D == B && B != F && D != H;
+    int c2 = B == F && B != D && F != H;
+    int c6 = D == H && D != B && H != F;
+    int c8 = H == F && D != H && B != F;
+
+    x *= 3 * bpp;
+    scale_write_pixel(out0 + x, bpp, c0 ? D : E);
+    scale_write_pixel(out0 + x + bpp, bpp,
+                      (c0 && E != C) || (c2 && E != A) ? B : E);
+    scale_write_pixel(out0 + x + 2 * bpp, bpp, c2 ? F : E);
+    scale_write_pixel(out1 + x, bpp,
+                      (c0 && E != G) || (c6 && E != A) ? D : E);
+    scale_write_pixel(out1 + x + bpp, bpp, E);
+    scale_write_pixel(out1 + x + 2 * bpp, bpp,
+                      (c2 && E != I) || (c8 && E != C) ? F : E);
+    scale_write_pixel(out2 + x, bpp, c6 ? D : E);
+    scale_write_pixel(out2 + x + bpp, bpp,
+                      (c6 && E != I) || (c8 && E != G) ? H : E);
+    scale_write_pixel(out2 + x + 2 * bpp, bpp, c8 ? F : E);
+}
 
-    switch (src->format->BytesPerPixel) {
-        case 1: {
-            Uint8 E0, E1, E2, E3, E;
-            for (looph = 0; looph < height; ++looph) {
-                for (loopw = 0; loopw < width; ++loopw) {
-                    E = *(Uint8 *)(srcpix + (looph * srcpitch) + (1 * loopw));
+#ifdef SCALE2X_SIMD
+/* scale3x_pixel() of the 32 bit pixels x to x + 3, none of them at either
+   end of the row. The nine outputs of each pixel are worked out four
+   pixels at a time and then spread over the three output rows. */
+static PG_INLINE void
+scale3x_simd4(const Uint32 *above, const Uint32 *row, const Uint32 *below,
+              Uint32 *out0, Uint32 *out1, Uint32 *out2, int x)
+{
+    __m128i A = _mm_loadu_si128((const __m128i *)(above + x - 1));
+    __m128i B = _mm_loadu_si128((const __m128i *)(above + x));
+    __m128i C = _mm_loadu_si128((const __m128i *)(above + x + 1));
+    __m128i D = _mm_loadu_si128((const __m128i *)(row + x - 1));
+    __m128i E = _mm_loadu_si128((const __m128i *)(row + x));
+    __m128i F = _mm_loadu_si128((const __m128i *)(row + x + 1));
+    __m128i G = _mm_loadu_si128((const __m128i *)(below + x - 1));
+    __m128i H = _mm_loadu_si128((const __m128i *)(below + x));
+    __m128i I = _mm_loadu_si128((const __m128i *)(below + x + 1));
+    __m128i db = _mm_cmpeq_epi32(D, B), bf = _mm_cmpeq_epi32(B, F);
+    __m128i dh = _mm_cmpeq_epi32(D, H), hf = _mm_cmpeq_epi32(H, F);
+    __m128i c0 = _mm_andnot_si128(_mm_or_si128(bf, dh), db);
+    __m128i c2 = _mm_andnot_si128(_mm_or_si128(db, hf), bf);
+    __m128i c6 = _mm_andnot_si128(_mm_or_si128(db, hf), dh);
+    __m128i c8 = _mm_andnot_si128(_mm_or_si128(dh, bf), hf);
+    /* the c masks where E differs from the corner, as andnot(E == X, c) */
+    __m128i ea = _mm_cmpeq_epi32(E, A), ec = _mm_cmpeq_epi32(E, C);
+    __m128i eg = _mm_cmpeq_epi32(E, G), ei = _mm_cmpeq_epi32(E, I);
+    Uint32 e[9][4];
+    int i;
+
+    _mm_storeu_si128((__m128i *)e[0], SCALE2X_SELECT(c0, D, E));
+    _mm_storeu_si128(
+        (__m128i *)e[1],
+        SCALE2X_SELECT(_mm_or_si128(_mm_andnot_si128(ec, c0),
+                                    _mm_andnot_si128(ea, c2)),
+                       B, E));
+    _mm_storeu_si128((__m128i *)e[2], SCALE2X_SELECT(c2, F, E));
+    _mm_storeu_si128(
+        (__m128i *)e[3],
+        SCALE2X_SELECT(_mm_or_si128(_mm_andnot_si128(eg, c0),
+                                    _mm_andnot_si128(ea, c6)),
+                       D, E));
+    _mm_storeu_si128((__m128i *)e[4], E);
+    _mm_storeu_si128(
+        (__m128i *)e[5],
+        SCALE2X_SELECT(_mm_or_si128(_mm_andnot_si128(ei, c2),
+                                    _mm_andnot_si128(ec, c8)),
+                       F, E));
+    _mm_storeu_si128((__m128i *)e[6], SCALE2X_SELECT(c6, D, E));
+    _mm_storeu_si128(
+        (__m128i *)e[7],
+        SCALE2X_SELECT(_mm_or_si128(_mm_andnot_si128(ei, c6),
+                                    _mm_andnot_si128(eg, c8)),
+                       H, E));
+    _mm_storeu_si128((__m128i *)e[8], SCALE2X_SELECT(c8, F, E));
+
+    out0 += 3 * x;
+    out1 += 3 * x;
+    out2 += 3 * x;
+    for (i = 0; i < 4; ++i) {
+        out0[3 * i] = e[0][i];
+        out0[3 * i + 1] = e[1][i];
+        out0[3 * i + 2] = e[2][i];
+        out1[3 * i] = e[3][i];
+        out1[3 * i + 1] = e[4][i];
+        out1[3 * i + 2] = e[5][i];
+        out2[3 * i] = e[6][i];
+        out2[3 * i + 1] = e[7][i];
+        out2[3 * i + 2] = e[8][i];
+    }
+}
+#endif /* SCALE2X_SIMD */
 
-                    E0 = E;
-                    E1 = E;
-                    E2 = E;
-                    E3 = E;
+/*
+  AdvanceMAME Scale3x, with the same requirements as scale2x: a
+  destination three times as large as the source, in the same format.
+*/
+void
+scale3x(SDL_Surface *src, SDL_Surface *dst)
+{
+    const int bpp = src->format->BytesPerPixel;
+    const int width = src->w;
+    const int height = src->h;
+    int simd = bpp == 4 && scale2x_use_simd();
+    int looph, loopw;
 
-                    *(Uint8 *)(dstpix + looph * 2 * dstpitch + loopw * 2 * 1) =
-                        E0;
-                    *(Uint8 *)(dstpix + looph * 2 * dstpitch +
-                               (loopw * 2 + 1) * 1) = E1;
-                    *(Uint8 *)(dstpix + (looph * 2 + 1) * dstpitch +
-                               loopw * 2 * 1) = E2;
-                    *(Uint8 *)(dstpix + (looph * 2 + 1) * dstpitch +
-                               (loopw * 2 + 1) * 1) = E3;
-                }
+    for (looph = 0; looph < height; ++looph) {
+        const Uint8 *above =
+            (Uint8 *)src->pixels + MAX(0, looph - 1) * src->pitch;
+        const Uint8 *row = (Uint8 *)src->pixels + looph * src->pitch;
+        const Uint8 *below =
+            (Uint8 *)src->pixels + MIN(height - 1, looph + 1) * src->pitch;
+        Uint8 *out0 = (Uint8 *)dst->pixels + looph * 3 * dst->pitch;
+        Uint8 *out1 = out0 + dst->pitch;
+        Uint8 *out2 = out1 + dst->pitch;
+
+        loopw = 0;
+#ifdef SCALE2X_SIMD
+        if (simd && width > 5) {
+            scale3x_pixel(above, row, below, out0, out1, out2, 0, width, 4);
+            for (loopw = 1; loopw + 4 < width; loopw += 4) {
+                scale3x_simd4((const Uint32 *)above, (const Uint32 *)row,
+                              (const Uint32 *)below, (Uint32 *)out0,
+                              (Uint32 *)out1, (Uint32 *)out2, loopw);
             }
-            break;
         }
-        case 2: {
-            Uint16 E0, E1, E2, E3, E;
-            for (looph = 0; looph < height; ++looph) {
-                for (loopw = 0; loopw < width; ++loopw) {
-                    E = *(Uint16 *)(srcpix + (looph * srcpitch) + (2 * loopw));
-
-                    E0 = E;
-                    E1 = E;
-                    E2 = E;
-                    E3 = E;
+#endif /* SCALE2X_SIMD */
+        for (; loopw < width; ++loopw) {
+            scale3x_pixel(above, row, below, out0, out1, out2, loopw, width,
+                          bpp);
+        }
+    }
+}
 
-                    *(Uint16 *)(dstpix + looph * 2 * dstpitch +
-                                loopw * 2 * 2) = E0;
-                    *(Uint16 *)(dstpix + looph * 2 * dstpitch +
-                                (loopw * 2 + 1) * 2) = E1;
-                    *(Uint16 *)(dstpix + (looph * 2 + 1) * dstpitch +
-                                loopw * 2 * 2) = E2;
-                    *(Uint16 *)(dstpix + (looph * 2 + 1) * dstpitch +
-                                (loopw * 2 + 1) * 2) = E3;
+/* Repeat each 32 bit pixel of a row factor times */
+static void
+scale_repeat_row32(const Uint32 *row, Uint32 *out, int width, int factor,
+                   int simd)
+{
+    int x = 0, k;
+
+#ifdef SCALE2X_SIMD
+    if (simd) {
+        switch (factor) {
+            case 2:
+                for (; x + 4 <= width; x += 4, out += 8) {
+                    __m128i v = _mm_loadu_si128((const __m128i *)(row + x));
+
+                    _mm_storeu_si128((__m128i *)out, _mm_unpacklo_epi32(v, v));
+                    _mm_storeu_si128((__m128i *)(out + 4),
+                                     _mm_unpackhi_epi32(v, v));
                 }
-            }
-            break;
+                break;
+            case 3:
+                for (; x + 4 <= width; x += 4, out += 12) {
+                    __m128i v = _mm_loadu_si128((const __m128i *)(row + x));
+
+                    _mm_storeu_si128(
+                        (__m128i *)out,
+                        _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 0, 0)));
+                    _mm_storeu_si128(
+                        (__m128i *)(out + 4),
+                        _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 2, 1, 1)));
+                    _mm_storeu_si128(
+                        (__m128i *)(out + 8),
+                        _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 2)));
+                }
+                break;
+            default:
+                /* four copies of the pixel at a time */
+                for (; factor >= 4 && x < width; ++x) {
+                    __m128i v = _mm_set1_epi32((int)row[x]);
+
+                    for (k = 0; k + 4 <= factor; k += 4, out += 4) {
+                        _mm_storeu_si128((__m128i *)out, v);
+                    }
+                    for (; k < factor; ++k) {
+                        *out++ = row[x];
+                    }
+                }
+                break;
         }
-        case 3: {
-            int E0, E1, E2, E3, E;
-            for (looph = 0; looph < height; ++looph) {
-                for (loopw = 0; loopw < width; ++loopw) {
-                    E = READINT24(srcpix + (looph * srcpitch) + (3 * loopw));
-
-                    E0 = E;
-                    E1 = E;
-                    E2 = E;
-                    E3 = E;
+    }
+#endif /* SCALE2X_SIMD */
+    for (; x < width; ++x) {
+        for (k = 0; k < factor; ++k) {
+            *out++ = row[x];
+        }
+    }
+}
 
-                    WRITEINT24((dstpix + looph * 2 * dstpitch + loopw * 2 * 3),
-                               E0);
-                    WRITEINT24(
-                        (dstpix + looph * 2 * dstpitch + (loopw * 2 + 1) * 3),
-                        E1);
-                    WRITEINT24(
-                        (dstpix + (looph * 2 + 1) * dstpitch + loopw * 2 * 3),
-                        E2);
-                    WRITEINT24((dstpix + (looph * 2 + 1) * dstpitch +
-                                (loopw * 2 + 1) * 3),
-                               E3);
+/*
+  Nearest neighbour scaling by a whole factor of rows ystart to yend - 1 of
+  src, into rows ystart * factor to yend * factor - 1 of dst, which must be
+  factor times as large and of the same format. Each source row is
+  widened once and the result copied to the other factor - 1 rows, so
+  separate bands of rows can be scaled on separate threads.
+*/
+void
+scale_by_int_rows(SDL_Surface *src, SDL_Surface *dst, int factor, int ystart,
+                  int yend)
+{
+    const int bpp = src->format->BytesPerPixel;
+    const int width = src->w;
+    const size_t span = (size_t)width * factor * bpp;
+    int simd = bpp == 4 && scale2x_use_simd();
+    int looph, loopw, k;
+
+    for (looph = ystart; looph < yend; ++looph) {
+        const Uint8 *row = (Uint8 *)src->pixels + looph * src->pitch;
+        Uint8 *out = (Uint8 *)dst->pixels + looph * factor * dst->pitch;
+        Uint8 *pix = out;
+
+        switch (bpp) {
+            case 1:
+                for (loopw = 0; loopw < width; ++loopw, pix += factor) {
+                    memset(pix, row[loopw], factor);
                 }
-            }
-            break;
-        }
-        default: { /*case 4:*/
-            Uint32 E0, E1, E2, E3, E;
-            for (looph = 0; looph < height; ++looph) {
+                break;
+            case 4:
+                scale_repeat_row32((const Uint32 *)row, (Uint32 *)out, width,
+                                   factor, simd);
+                break;
+            default:
                 for (loopw = 0; loopw < width; ++loopw) {
-                    E = *(Uint32 *)(srcpix + (looph * srcpitch) + (4 * loopw));
-
-                    E0 = E;
-                    E1 = E;
-                    E2 = E;
-                    E3 = E;
-
-                    *(Uint32 *)(dstpix + looph * 2 * dstpitch +
-                                loopw * 2 * 4) = E0;
-                    *(Uint32 *)(dstpix + looph * 2 * dstpitch +
-                                (loopw * 2 + 1) * 4) = E1;
-                    *(Uint32 *)(dstpix + (looph * 2 + 1) * dstpitch +
-                                loopw * 2 * 4) = E2;
-                    *(Uint32 *)(dstpix + (looph * 2 + 1) * dstpitch +
-                                (loopw * 2 + 1) * 4) = E3;
+                    for (k = 0; k < factor; ++k, pix += bpp) {
+                        memcpy(pix, row + loopw * bpp, bpp);
+                    }
                 }
-            }
-            break;
+                break;
+        }
+        for (k = 1; k < factor; ++k) {
+            memcpy(out + k * dst->pitch, out, span);
         }
     }
 }
@@ -6,18 +6,56 @@
 char *pygame_scrap_plaintext_type = "text/plain;charset=utf-8";
 char **pygame_scrap_types;
 
+/* On X11 every clipboard read is a blocking round-trip to the owner, so
+ * the text is kept until SDL reports a change or it gets old. The age
+ * limit covers platforms that do not report changes by other programs.
+ */
+#define PG_SCRAP_CACHE_TICKS 250
+
+static char *_pg_scrap_cache = NULL;
+static Uint32 _pg_scrap_cache_time = 0;
+static SDL_atomic_t _pg_scrap_cache_stale;
+
+static int SDLCALL
+_pg_scrap_clipboard_watch(void *userdata, SDL_Event *event)
+{
+    if (event->type == SDL_CLIPBOARDUPDATE)
+        SDL_AtomicSet(&_pg_scrap_cache_stale, 1);
+    return 1;
+}
+
+static const char *
+_pg_scrap_text(void)
+{
+    int stale = SDL_AtomicSet(&_pg_scrap_cache_stale, 0);
+
+    if (_pg_scrap_cache && !stale &&
+        SDL_GetTicks() - _pg_scrap_cache_time < PG_SCRAP_CACHE_TICKS)
+        return _pg_scrap_cache;
+
+    if (_pg_scrap_cache)
+        SDL_free(_pg_scrap_cache);
+    _pg_scrap_cache = SDL_GetClipboardText();
+    _pg_scrap_cache_time = SDL_GetTicks();
+    return _pg_scrap_cache;
+}
+
 int
 pygame_scrap_contains(char *type)
 {
-    return (strcmp(type, pygame_scrap_plaintext_type) == 0) &&
-           SDL_HasClipboardText();
+    const char *text;
+
+    if (strcmp(type, pygame_scrap_plaintext_type) != 0)
+        return 0;
+    text = _pg_scrap_text();
+    return text && *text;
 }
 
 char *
 pygame_scrap_get(char *type, size_t *count)
 {
     char *retval = NULL;
-    char *clipboard = NULL;
+    const char *clipboard = NULL;
 
     if (!pygame_scrap_initialized()) {
         PyErr_SetString(pgExc_SDLError, "scrap system not initialized.");
@@ -25,11 +63,10 @@ pygame_scrap_get(char *type, size_t *count)
     }
 
     if (strcmp(type, pygame_scrap_plaintext_type) == 0) {
-        clipboard = SDL_GetClipboardText();
+        clipboard = _pg_scrap_text();
         if (clipboard != NULL) {
             *count = strlen(clipboard);
             retval = strdup(clipboard);
-            SDL_free(clipboard);
             return retval;
         }
     }
@@ -60,6 +97,9 @@ pygame_scrap_init(void)
     pygame_scrap_types[0] = pygame_scrap_plaintext_type;
     pygame_scrap_types[1] = NULL;
 
+    SDL_DelEventWatch(_pg_scrap_clipboard_watch, NULL);
+    SDL_AddEventWatch(_pg_scrap_clipboard_watch, NULL);
+
     _scrapinitialized = 1;
     return _scrapinitialized;
 }
@@ -80,6 +120,12 @@ pygame_scrap_put(char *type, Py_ssize_t srclen, char *src)
 
     if (strcmp(type, pygame_scrap_plaintext_type) == 0) {
         if (SDL_SetClipboardText(src) == 0) {
+            /* what we put is what the next get() would fetch */
+            if (_pg_scrap_cache)
+                SDL_free(_pg_scrap_cache);
+            _pg_scrap_cache = SDL_strdup(src);
+            _pg_scrap_cache_time = SDL_GetTicks();
+            SDL_AtomicSet(&_pg_scrap_cache_stale, 0);
             return 1;
         }
     }
@@ -29,6 +29,26 @@ void
 blit_blend_rgba_min_sse2(SDL_BlitInfo *info);
 void
 blit_blend_rgb_min_sse2(SDL_BlitInfo *info);
+void
+alphablit_alpha_sse2_argb_surf_alpha(SDL_BlitInfo *info);
+void
+alphablit_alpha_sse2_argb_no_surf_alpha(SDL_BlitInfo *info);
+void
+alphablit_alpha_sse2_argb_no_surf_alpha_opaque_dst(SDL_BlitInfo *info);
+void
+blit_palette8_sse2(SDL_BlitInfo *info);
+void
+blit_blend_rgb565_add_sse2(SDL_BlitInfo *info);
+void
+blit_blend_rgb565_sub_sse2(SDL_BlitInfo *info);
+void
+blit_blend_rgb565_mul_sse2(SDL_BlitInfo *info);
+void
+blit_blend_rgb565_min_sse2(SDL_BlitInfo *info);
+void
+blit_blend_rgb565_max_sse2(SDL_BlitInfo *info);
+void
+alphablit_alpha_sse2_argb_rgb565(SDL_BlitInfo *info);
 #endif /* (defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)) */
 
 void
@@ -51,3 +71,11 @@ void
 blit_blend_rgba_min_avx2(SDL_BlitInfo *info);
 void
 blit_blend_rgb_min_avx2(SDL_BlitInfo *info);
+void
+alphablit_alpha_avx2_argb_surf_alpha(SDL_BlitInfo *info);
+void
+alphablit_alpha_avx2_argb_no_surf_alpha(SDL_BlitInfo *info);
+void
+alphablit_alpha_avx2_argb_no_surf_alpha_opaque_dst(SDL_BlitInfo *info);
+void
+blit_palette8_avx2(SDL_BlitInfo *info);
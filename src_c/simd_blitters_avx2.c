@@ -4,13 +4,16 @@
 #include <immintrin.h>
 #endif /* defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H) */
 
+/* Blitters may run on pool workers or with the GIL released, so only
+   warn from a thread that holds the GIL. */
 #define RAISE_AVX2_RUNTIME_SSE2_COMPILED_WARNING()     \
     char warning[128];                                 \
     PyOS_snprintf(warning, sizeof(warning),            \
                   "Blitting with SSE2 blitter on AVX2" \
                   " capable system. Pygame may be "    \
                   "compiled without AVX2 support.");   \
-    PyErr_WarnEx(PyExc_RuntimeWarning, warning, 0)
+    if (PyGILState_Check())                            \
+        PyErr_WarnEx(PyExc_RuntimeWarning, warning, 0)
 
 #if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
     !defined(SDL_DISABLE_IMMINTRIN_H)
@@ -928,3 +931,304 @@ blit_blend_rgb_min_avx2(SDL_BlitInfo *info)
 }
 #endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
           !defined(SDL_DISABLE_IMMINTRIN_H) */
+
+#if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+/* The per-pixel alpha kernels below work on eight ARGB pixels at a time,
+   split into two registers of four pixels with 16 bits per channel. They
+   produce the same results as the SSE2 versions in alphablit.c:
+
+       dstRGB = (((dstRGB << 8) + (srcRGB - dstRGB) * srcA + srcRGB) >> 8)
+         dstA = srcA + dstA - ((srcA * dstA) / 255);
+
+   A source alpha of 255 copies the source colour with this equation, so
+   only the "dst alpha is 0" copy needs special casing: it is done by
+   raising the alpha used for RGB to 255 for those pixels. */
+
+/* copy the alpha channel of each 16 bit unpacked pixel over its RGB */
+#define AVX2_BROADCAST_ALPHA(x) \
+    _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, 0xFF), 0xFF)
+
+/* (x / 255) for x <= 255 * 255 */
+#define AVX2_DIV255(x)                                                   \
+    _mm256_srli_epi16(                                                   \
+        _mm256_mulhi_epu16(x, _mm256_set1_epi16((short)0x8081)), 7)
+
+static PG_FORCEINLINE __m256i
+avx2_blend_rgb(__m256i src, __m256i dst, __m256i alpha)
+{
+    __m256i sub_dst;
+
+    /* (srcRGB - dstRGB) */
+    sub_dst = _mm256_sub_epi16(src, dst);
+    /* (srcRGB - dstRGB) * srcA */
+    sub_dst = _mm256_mullo_epi16(sub_dst, alpha);
+    /* (srcRGB - dstRGB) * srcA + srcRGB */
+    sub_dst = _mm256_add_epi16(sub_dst, src);
+    /* ((dstRGB << 8) + (srcRGB - dstRGB) * srcA + srcRGB) */
+    sub_dst = _mm256_add_epi16(sub_dst, _mm256_slli_epi16(dst, 8));
+    /* (((dstRGB << 8) + (srcRGB - dstRGB) * srcA + srcRGB) >> 8) */
+    return _mm256_srli_epi16(sub_dst, 8);
+}
+
+/* Blend four unpacked pixels, using src_alpha for RGB and dst_alpha for
+   the resulting alpha. copy_mask holds 0xFF in the alpha of pixels that
+   should take the source colour unchanged. */
+static PG_FORCEINLINE __m256i
+avx2_blend_argb(__m256i src, __m256i dst, __m256i src_alpha,
+                __m256i dst_alpha, __m256i copy_mask)
+{
+    __m256i rgb, alpha;
+
+    rgb = avx2_blend_rgb(src, dst, _mm256_or_si256(src_alpha, copy_mask));
+
+    /* srcA + dstA - ((srcA * dstA) / 255) */
+    alpha = AVX2_DIV255(_mm256_mullo_epi16(src_alpha, dst_alpha));
+    alpha = _mm256_add_epi16(src_alpha, _mm256_sub_epi16(dst_alpha, alpha));
+
+    /* keep RGB from rgb and A from alpha */
+    return _mm256_blend_epi16(rgb, alpha, 0x88);
+}
+
+static PG_FORCEINLINE __m256i
+avx2_alpha_surf_alpha(__m256i mm256_src, __m256i mm256_dst,
+                      __m256i mm256_modulate, __m256i mm256_dst_amask,
+                      __m256i mm256_copy)
+{
+    __m256i mm256_zero = _mm256_setzero_si256();
+    __m256i src_lo, src_hi, dst_lo, dst_hi, dsta_lo, dsta_hi;
+    __m256i srca_lo, srca_hi;
+
+    src_lo = _mm256_unpacklo_epi8(mm256_src, mm256_zero);
+    src_hi = _mm256_unpackhi_epi8(mm256_src, mm256_zero);
+    dst_lo = _mm256_unpacklo_epi8(mm256_dst, mm256_zero);
+    dst_hi = _mm256_unpackhi_epi8(mm256_dst, mm256_zero);
+
+    /* modulate src alpha: (srcA * surface alpha) / 255 */
+    srca_lo = AVX2_DIV255(
+        _mm256_mullo_epi16(AVX2_BROADCAST_ALPHA(src_lo), mm256_modulate));
+    srca_hi = AVX2_DIV255(
+        _mm256_mullo_epi16(AVX2_BROADCAST_ALPHA(src_hi), mm256_modulate));
+
+    /* a destination without an alpha mask counts as 0 alpha in the result
+       alpha, but is never copied over */
+    mm256_dst = _mm256_and_si256(mm256_dst, mm256_dst_amask);
+    dsta_lo =
+        AVX2_BROADCAST_ALPHA(_mm256_unpacklo_epi8(mm256_dst, mm256_zero));
+    dsta_hi =
+        AVX2_BROADCAST_ALPHA(_mm256_unpackhi_epi8(mm256_dst, mm256_zero));
+
+    src_lo = avx2_blend_argb(
+        src_lo, dst_lo, srca_lo, dsta_lo,
+        _mm256_and_si256(_mm256_cmpeq_epi16(dsta_lo, mm256_zero), mm256_copy));
+    src_hi = avx2_blend_argb(
+        src_hi, dst_hi, srca_hi, dsta_hi,
+        _mm256_and_si256(_mm256_cmpeq_epi16(dsta_hi, mm256_zero), mm256_copy));
+
+    return _mm256_packus_epi16(src_lo, src_hi);
+}
+
+static PG_FORCEINLINE __m256i
+avx2_alpha_no_surf_alpha(__m256i mm256_src, __m256i mm256_dst)
+{
+    __m256i mm256_zero = _mm256_setzero_si256();
+    __m256i mm256_copy = _mm256_set1_epi16(0xFF);
+    __m256i src_lo, src_hi, dst_lo, dst_hi, srca_lo, srca_hi, dsta_lo, dsta_hi;
+
+    src_lo = _mm256_unpacklo_epi8(mm256_src, mm256_zero);
+    src_hi = _mm256_unpackhi_epi8(mm256_src, mm256_zero);
+    dst_lo = _mm256_unpacklo_epi8(mm256_dst, mm256_zero);
+    dst_hi = _mm256_unpackhi_epi8(mm256_dst, mm256_zero);
+
+    srca_lo = AVX2_BROADCAST_ALPHA(src_lo);
+    srca_hi = AVX2_BROADCAST_ALPHA(src_hi);
+    dsta_lo = AVX2_BROADCAST_ALPHA(dst_lo);
+    dsta_hi = AVX2_BROADCAST_ALPHA(dst_hi);
+
+    src_lo = avx2_blend_argb(
+        src_lo, dst_lo, srca_lo, dsta_lo,
+        _mm256_and_si256(_mm256_cmpeq_epi16(dsta_lo, mm256_zero), mm256_copy));
+    src_hi = avx2_blend_argb(
+        src_hi, dst_hi, srca_hi, dsta_hi,
+        _mm256_and_si256(_mm256_cmpeq_epi16(dsta_hi, mm256_zero), mm256_copy));
+
+    return _mm256_packus_epi16(src_lo, src_hi);
+}
+
+static PG_FORCEINLINE __m256i
+avx2_alpha_opaque_dst(__m256i mm256_src, __m256i mm256_dst)
+{
+    __m256i mm256_zero = _mm256_setzero_si256();
+    __m256i src_lo, src_hi, dst_lo, dst_hi;
+
+    src_lo = _mm256_unpacklo_epi8(mm256_src, mm256_zero);
+    src_hi = _mm256_unpackhi_epi8(mm256_src, mm256_zero);
+    dst_lo = _mm256_unpacklo_epi8(mm256_dst, mm256_zero);
+    dst_hi = _mm256_unpackhi_epi8(mm256_dst, mm256_zero);
+
+    src_lo = avx2_blend_rgb(src_lo, dst_lo, AVX2_BROADCAST_ALPHA(src_lo));
+    src_hi = avx2_blend_rgb(src_hi, dst_hi, AVX2_BROADCAST_ALPHA(src_hi));
+
+    /* pack everything back into pixels and reset alpha to 0 */
+    return _mm256_and_si256(_mm256_packus_epi16(src_lo, src_hi),
+                            _mm256_set1_epi32(0x00FFFFFF));
+}
+
+/* Run kernel over every row of the blit, eight pixels at a time. The last
+   (width % 8) pixels of a row go through a small stack buffer. */
+#define RUN_AVX2_ALPHA_KERNEL(kernel)                                        \
+    int n;                                                                   \
+    int width = info->width;                                                 \
+    int height = info->height;                                               \
+    Uint32 *srcp = (Uint32 *)info->s_pixels;                                 \
+    int srcskip = info->s_skip >> 2;                                         \
+    Uint32 *dstp = (Uint32 *)info->d_pixels;                                 \
+    int dstskip = info->d_skip >> 2;                                         \
+    int pre_8_width = width % 8;                                             \
+    int post_8_width = width / 8;                                            \
+    Uint32 src_tail[8], dst_tail[8];                                         \
+    __m256i mm256_src, mm256_dst;                                            \
+                                                                             \
+    while (height--) {                                                       \
+        if (post_8_width > 0) {                                              \
+            LOOP_UNROLLED4(                                                  \
+                {                                                            \
+                    mm256_src = _mm256_loadu_si256((__m256i *)srcp);         \
+                    mm256_dst = _mm256_loadu_si256((__m256i *)dstp);         \
+                    _mm256_storeu_si256((__m256i *)dstp, kernel);            \
+                    srcp += 8;                                               \
+                    dstp += 8;                                               \
+                },                                                           \
+                n, post_8_width);                                            \
+        }                                                                    \
+        if (pre_8_width > 0) {                                               \
+            memcpy(src_tail, srcp, pre_8_width * sizeof(Uint32));            \
+            memcpy(dst_tail, dstp, pre_8_width * sizeof(Uint32));            \
+            mm256_src = _mm256_loadu_si256((__m256i *)src_tail);             \
+            mm256_dst = _mm256_loadu_si256((__m256i *)dst_tail);             \
+            _mm256_storeu_si256((__m256i *)dst_tail, kernel);                \
+            memcpy(dstp, dst_tail, pre_8_width * sizeof(Uint32));            \
+            srcp += pre_8_width;                                             \
+            dstp += pre_8_width;                                             \
+        }                                                                    \
+        srcp += srcskip;                                                     \
+        dstp += dstskip;                                                     \
+    }
+
+void
+alphablit_alpha_avx2_argb_surf_alpha(SDL_BlitInfo *info)
+{
+    Uint32 dst_amask = info->dst->Amask;
+    __m256i mm256_modulate = _mm256_set1_epi16(info->src_blanket_alpha);
+    __m256i mm256_dst_amask = _mm256_set1_epi32(dst_amask);
+    __m256i mm256_copy = _mm256_set1_epi16(dst_amask ? 0xFF : 0);
+
+    RUN_AVX2_ALPHA_KERNEL(avx2_alpha_surf_alpha(mm256_src, mm256_dst,
+                                                mm256_modulate,
+                                                mm256_dst_amask, mm256_copy));
+}
+
+void
+alphablit_alpha_avx2_argb_no_surf_alpha(SDL_BlitInfo *info)
+{
+    RUN_AVX2_ALPHA_KERNEL(avx2_alpha_no_surf_alpha(mm256_src, mm256_dst));
+}
+
+void
+alphablit_alpha_avx2_argb_no_surf_alpha_opaque_dst(SDL_BlitInfo *info)
+{
+    RUN_AVX2_ALPHA_KERNEL(avx2_alpha_opaque_dst(mm256_src, mm256_dst));
+}
+#else
+/* These are picked for plain blits, so fall back to SSE2 without a
+   warning when this file was built without AVX2 */
+void
+alphablit_alpha_avx2_argb_surf_alpha(SDL_BlitInfo *info)
+{
+    alphablit_alpha_sse2_argb_surf_alpha(info);
+}
+
+void
+alphablit_alpha_avx2_argb_no_surf_alpha(SDL_BlitInfo *info)
+{
+    alphablit_alpha_sse2_argb_no_surf_alpha(info);
+}
+
+void
+alphablit_alpha_avx2_argb_no_surf_alpha_opaque_dst(SDL_BlitInfo *info)
+{
+    alphablit_alpha_sse2_argb_no_surf_alpha_opaque_dst(info);
+}
+#endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+          !defined(SDL_DISABLE_IMMINTRIN_H) */
+
+#if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+/* Look up eight pixels at a time in info->s_table with a gather, masking
+   out the pixels of the colorkey if there is one */
+void
+blit_palette8_avx2(SDL_BlitInfo *info)
+{
+    int n;
+    int width = info->width;
+    int height = info->height;
+    int pre_8_width = width % 8;
+    int post_8_width = width / 8;
+
+    Uint8 *srcp = info->s_pixels;
+    int srcskip = info->s_skip;
+
+    Uint32 *dstp = (Uint32 *)info->d_pixels;
+    int dstskip = info->d_skip >> 2;
+
+    const Uint32 *table = info->s_table;
+    int has_key = info->src_has_colorkey;
+    Uint32 key = info->src_colorkey;
+
+    __m256i mm256_src, mm256_idx, mm256_keep;
+    __m256i mm256_key = _mm256_set1_epi32((int)key);
+
+    while (height--) {
+        if (pre_8_width > 0) {
+            LOOP_UNROLLED4(
+                {
+                    if (!has_key || *srcp != key) {
+                        *dstp = table[*srcp];
+                    }
+                    srcp++;
+                    dstp++;
+                },
+                n, pre_8_width);
+        }
+        if (post_8_width > 0) {
+            LOOP_UNROLLED4(
+                {
+                    mm256_idx = _mm256_cvtepu8_epi32(
+                        _mm_loadl_epi64((__m128i *)srcp));
+                    mm256_src = _mm256_i32gather_epi32((const int *)table,
+                                                       mm256_idx, 4);
+                    if (has_key) {
+                        mm256_keep = _mm256_cmpeq_epi32(mm256_idx, mm256_key);
+                        mm256_src = _mm256_blendv_epi8(
+                            mm256_src,
+                            _mm256_loadu_si256((__m256i *)dstp), mm256_keep);
+                    }
+                    _mm256_storeu_si256((__m256i *)dstp, mm256_src);
+                    srcp += 8;
+                    dstp += 8;
+                },
+                n, post_8_width);
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+#else
+/* Picked for plain blits, so fall back to SSE2 without a warning */
+void
+blit_palette8_avx2(SDL_BlitInfo *info)
+{
+    blit_palette8_sse2(info);
+}
+#endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+          !defined(SDL_DISABLE_IMMINTRIN_H) */
@@ -897,3 +897,275 @@ blit_blend_rgb_min_sse2(SDL_BlitInfo *info)
     }
 }
 #endif /* (defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)) */
+
+#if (defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON))
+/* There is no gather in SSE2, so the lookups of four pixels in
+   info->s_table are written with one store, and the colorkey is applied
+   by masking rather than by a branch per pixel */
+void
+blit_palette8_sse2(SDL_BlitInfo *info)
+{
+    int n;
+    int width = info->width;
+    int height = info->height;
+    int pre_4_width = width % 4;
+    int post_4_width = width / 4;
+
+    Uint8 *srcp = info->s_pixels;
+    int srcskip = info->s_skip;
+
+    Uint32 *dstp = (Uint32 *)info->d_pixels;
+    int dstskip = info->d_skip >> 2;
+
+    const Uint32 *table = info->s_table;
+    int has_key = info->src_has_colorkey;
+    Uint32 key = info->src_colorkey;
+
+    __m128i mm_src, mm_idx, mm_keep;
+    __m128i mm_key = _mm_set1_epi32((int)key);
+
+    while (height--) {
+        if (pre_4_width > 0) {
+            LOOP_UNROLLED4(
+                {
+                    if (!has_key || *srcp != key) {
+                        *dstp = table[*srcp];
+                    }
+                    srcp++;
+                    dstp++;
+                },
+                n, pre_4_width);
+        }
+        if (post_4_width > 0) {
+            LOOP_UNROLLED4(
+                {
+                    mm_src = _mm_setr_epi32(
+                        (int)table[srcp[0]], (int)table[srcp[1]],
+                        (int)table[srcp[2]], (int)table[srcp[3]]);
+                    if (has_key) {
+                        mm_idx = _mm_setr_epi32(srcp[0], srcp[1], srcp[2],
+                                                srcp[3]);
+                        mm_keep = _mm_cmpeq_epi32(mm_idx, mm_key);
+                        mm_src = _mm_or_si128(
+                            _mm_andnot_si128(mm_keep, mm_src),
+                            _mm_and_si128(mm_keep,
+                                          _mm_loadu_si128((__m128i *)dstp)));
+                    }
+                    _mm_storeu_si128((__m128i *)dstp, mm_src);
+                    srcp += 4;
+                    dstp += 4;
+                },
+                n, post_4_width);
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+#endif /* (defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)) */
+
+#if (defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON))
+/* RGB565 pixels are worked on eight at a time, one 16 bit lane each.
+   The channels are widened to 8 bits the way SDL_GetRGBA does it, by
+   repeating their top bits in the bottom ones, and narrowed again by
+   dropping the low bits as CREATE_PIXEL does, so the results match the
+   generic blitters exactly. */
+static PG_FORCEINLINE void
+sse2_unpack_rgb565(__m128i px, __m128i *r, __m128i *g, __m128i *b)
+{
+    __m128i mm_r = _mm_srli_epi16(px, 11);
+    __m128i mm_g = _mm_and_si128(_mm_srli_epi16(px, 5), _mm_set1_epi16(0x3F));
+    __m128i mm_b = _mm_and_si128(px, _mm_set1_epi16(0x1F));
+
+    *r = _mm_or_si128(_mm_slli_epi16(mm_r, 3), _mm_srli_epi16(mm_r, 2));
+    *g = _mm_or_si128(_mm_slli_epi16(mm_g, 2), _mm_srli_epi16(mm_g, 4));
+    *b = _mm_or_si128(_mm_slli_epi16(mm_b, 3), _mm_srli_epi16(mm_b, 2));
+}
+
+static PG_FORCEINLINE __m128i
+sse2_pack_rgb565(__m128i r, __m128i g, __m128i b)
+{
+    r = _mm_slli_epi16(_mm_srli_epi16(r, 3), 11);
+    g = _mm_slli_epi16(_mm_srli_epi16(g, 2), 5);
+    b = _mm_srli_epi16(b, 3);
+    return _mm_or_si128(_mm_or_si128(r, g), b);
+}
+
+/* One channel of a BLEND_ mode, on values of 0 to 255 */
+static PG_FORCEINLINE __m128i
+sse2_blend_channel(__m128i s, __m128i d, int mode)
+{
+    switch (mode) {
+        case PYGAME_BLEND_ADD:
+            return _mm_min_epi16(_mm_add_epi16(d, s), _mm_set1_epi16(255));
+        case PYGAME_BLEND_SUB:
+            return _mm_subs_epu16(d, s);
+        case PYGAME_BLEND_MULT:
+            /* a zero operand gives 255 >> 8, so no special case */
+            return _mm_srli_epi16(
+                _mm_add_epi16(_mm_mullo_epi16(d, s), _mm_set1_epi16(255)),
+                8);
+        case PYGAME_BLEND_MIN:
+            return _mm_min_epi16(d, s);
+        default: /* PYGAME_BLEND_MAX */
+            return _mm_max_epi16(d, s);
+    }
+}
+
+static PG_FORCEINLINE __m128i
+sse2_blend_rgb565(const Uint16 *s, __m128i dst, int mode)
+{
+    __m128i sr, sg, sb, dr, dg, db;
+
+    sse2_unpack_rgb565(_mm_loadu_si128((const __m128i *)s), &sr, &sg, &sb);
+    sse2_unpack_rgb565(dst, &dr, &dg, &db);
+    return sse2_pack_rgb565(sse2_blend_channel(sr, dr, mode),
+                            sse2_blend_channel(sg, dg, mode),
+                            sse2_blend_channel(sb, db, mode));
+}
+
+/* Eight 8 bit channels, at shift in the 32 bit pixels of s */
+static PG_FORCEINLINE __m128i
+sse2_argb_channel(const Uint32 *s, __m128i shift)
+{
+    __m128i mask = _mm_set1_epi32(0xFF);
+    __m128i lo = _mm_loadu_si128((const __m128i *)s);
+    __m128i hi = _mm_loadu_si128((const __m128i *)(s + 4));
+
+    return _mm_packs_epi32(_mm_and_si128(_mm_srl_epi32(lo, shift), mask),
+                           _mm_and_si128(_mm_srl_epi32(hi, shift), mask));
+}
+
+/* The RGB565 destination has no alpha, so ALPHA_BLEND always takes its
+   blending branch: dstC = (((srcC - dstC) * srcA + srcC) >> 8) + dstC.
+   That is (dstC * (256 - srcA) + srcC * (srcA + 1)) >> 8, where every
+   term is positive and the sum fits in 16 bits. */
+static PG_FORCEINLINE __m128i
+sse2_alpha_argb_rgb565(const Uint32 *s, __m128i dst, __m128i rshift,
+                       __m128i gshift, __m128i bshift, __m128i ashift,
+                       __m128i modulate)
+{
+    __m128i dr, dg, db, alpha, dst_factor, src_factor;
+
+    sse2_unpack_rgb565(dst, &dr, &dg, &db);
+
+    /* (srcA * modulateA) / 255, with the division as a multiply */
+    alpha = _mm_mullo_epi16(sse2_argb_channel(s, ashift), modulate);
+    alpha = _mm_srli_epi16(
+        _mm_mulhi_epu16(alpha, _mm_set1_epi16((short)0x8081)), 7);
+
+    dst_factor = _mm_sub_epi16(_mm_set1_epi16(256), alpha);
+    src_factor = _mm_add_epi16(alpha, _mm_set1_epi16(1));
+    dr = _mm_srli_epi16(
+        _mm_add_epi16(_mm_mullo_epi16(dr, dst_factor),
+                      _mm_mullo_epi16(sse2_argb_channel(s, rshift),
+                                      src_factor)),
+        8);
+    dg = _mm_srli_epi16(
+        _mm_add_epi16(_mm_mullo_epi16(dg, dst_factor),
+                      _mm_mullo_epi16(sse2_argb_channel(s, gshift),
+                                      src_factor)),
+        8);
+    db = _mm_srli_epi16(
+        _mm_add_epi16(_mm_mullo_epi16(db, dst_factor),
+                      _mm_mullo_epi16(sse2_argb_channel(s, bshift),
+                                      src_factor)),
+        8);
+    return sse2_pack_rgb565(dr, dg, db);
+}
+
+/* Run kernel over every row of a blit to RGB565, eight pixels at a time,
+   with s pointing at the source pixels and mm_dst holding the destination
+   ones. The last (width % 8) pixels of a row go through a small stack
+   buffer. */
+#define RUN_SSE2_RGB565_KERNEL(src_type, kernel)                             \
+    int n;                                                                   \
+    int width = info->width;                                                 \
+    int height = info->height;                                               \
+    src_type *srcp = (src_type *)info->s_pixels;                             \
+    int srcskip = info->s_skip / (int)sizeof(src_type);                      \
+    Uint16 *dstp = (Uint16 *)info->d_pixels;                                 \
+    int dstskip = info->d_skip >> 1;                                         \
+    int pre_8_width = width % 8;                                             \
+    int post_8_width = width / 8;                                            \
+    src_type src_tail[8];                                                    \
+    Uint16 dst_tail[8];                                                      \
+    const src_type *s;                                                       \
+    __m128i mm_dst;                                                          \
+                                                                             \
+    while (height--) {                                                       \
+        if (post_8_width > 0) {                                              \
+            LOOP_UNROLLED4(                                                  \
+                {                                                            \
+                    s = srcp;                                                \
+                    mm_dst = _mm_loadu_si128((__m128i *)dstp);               \
+                    _mm_storeu_si128((__m128i *)dstp, kernel);               \
+                    srcp += 8;                                               \
+                    dstp += 8;                                               \
+                },                                                           \
+                n, post_8_width);                                            \
+        }                                                                    \
+        if (pre_8_width > 0) {                                               \
+            memcpy(src_tail, srcp, pre_8_width * sizeof(src_type));          \
+            memcpy(dst_tail, dstp, pre_8_width * sizeof(Uint16));            \
+            s = src_tail;                                                    \
+            mm_dst = _mm_loadu_si128((__m128i *)dst_tail);                   \
+            _mm_storeu_si128((__m128i *)dst_tail, kernel);                   \
+            memcpy(dstp, dst_tail, pre_8_width * sizeof(Uint16));            \
+            srcp += pre_8_width;                                             \
+            dstp += pre_8_width;                                             \
+        }                                                                    \
+        srcp += srcskip;                                                     \
+        dstp += dstskip;                                                     \
+    }
+
+void
+blit_blend_rgb565_add_sse2(SDL_BlitInfo *info)
+{
+    RUN_SSE2_RGB565_KERNEL(Uint16,
+                           sse2_blend_rgb565(s, mm_dst, PYGAME_BLEND_ADD));
+}
+
+void
+blit_blend_rgb565_sub_sse2(SDL_BlitInfo *info)
+{
+    RUN_SSE2_RGB565_KERNEL(Uint16,
+                           sse2_blend_rgb565(s, mm_dst, PYGAME_BLEND_SUB));
+}
+
+void
+blit_blend_rgb565_mul_sse2(SDL_BlitInfo *info)
+{
+    RUN_SSE2_RGB565_KERNEL(Uint16,
+                           sse2_blend_rgb565(s, mm_dst, PYGAME_BLEND_MULT));
+}
+
+void
+blit_blend_rgb565_min_sse2(SDL_BlitInfo *info)
+{
+    RUN_SSE2_RGB565_KERNEL(Uint16,
+                           sse2_blend_rgb565(s, mm_dst, PYGAME_BLEND_MIN));
+}
+
+void
+blit_blend_rgb565_max_sse2(SDL_BlitInfo *info)
+{
+    RUN_SSE2_RGB565_KERNEL(Uint16,
+                           sse2_blend_rgb565(s, mm_dst, PYGAME_BLEND_MAX));
+}
+
+/* A source with 8 bits per channel and per pixel alpha, over RGB565 */
+void
+alphablit_alpha_sse2_argb_rgb565(SDL_BlitInfo *info)
+{
+    SDL_PixelFormat *srcfmt = info->src;
+    __m128i mm_rshift = _mm_cvtsi32_si128(srcfmt->Rshift);
+    __m128i mm_gshift = _mm_cvtsi32_si128(srcfmt->Gshift);
+    __m128i mm_bshift = _mm_cvtsi32_si128(srcfmt->Bshift);
+    __m128i mm_ashift = _mm_cvtsi32_si128(srcfmt->Ashift);
+    __m128i mm_modulate = _mm_set1_epi16(info->src_blanket_alpha);
+
+    RUN_SSE2_RGB565_KERNEL(
+        Uint32, sse2_alpha_argb_rgb565(s, mm_dst, mm_rshift, mm_gshift,
+                                       mm_bshift, mm_ashift, mm_modulate));
+}
+#endif /* (defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)) */
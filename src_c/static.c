@@ -134,6 +134,9 @@ PyInit_mixer(void);
 PyMODINIT_FUNC
 PyInit_context(void);
 
+PyMODINIT_FUNC
+PyInit_particles(void);
+
 PyMODINIT_FUNC
 PyInit_controller(void);
 
@@ -175,6 +178,7 @@ PyGame_static_init()
     PyImport_AppendInittab("pygame_time", PyInit_pg_time);
     PyImport_AppendInittab("pygame_sdl2_video", PyInit_video);
     PyImport_AppendInittab("pygame_context", PyInit_context);
+    PyImport_AppendInittab("pygame_particles", PyInit_particles);
     PyImport_AppendInittab("pygame_sprite", PyInit__sprite);
     PyImport_AppendInittab("pygame__sdl2_sdl2", PyInit_sdl2);
     PyImport_AppendInittab("pygame__sdl2_sdl2_mixer", PyInit_mixer);
@@ -195,6 +199,15 @@ PyGame_static_init()
 #undef pgSurface_Unprep
 #undef pgLifetimeLock_Type
 #undef pgSurface_LockLifetime
+#undef pgSurface_SharePixels
+#undef pgSurface_Unshare
+#undef pgSurface_ReleaseShare
+#undef pgSurface_LockRead
+#undef pgSurface_UnlockRead
+#undef pgSurface_Pack
+#undef pgSurface_Unpack
+#undef pgSurface_ReleasePack
+#undef pgSurface_PackedSize
 
 #include "surflock.c"
 
@@ -214,6 +227,9 @@ PyGame_static_init()
 #undef pgSurface_New
 #undef pgSurface_Type
 #undef pgSurface_SetSurface
+#undef pgSurface_AddDamage
+#undef pgSurface_PopDamage
+#undef pgSurface_GetVersion
 
 #include "surface.c"
 
@@ -243,6 +259,7 @@ PyGame_static_init()
 
 #undef pg_EnableKeyRepeat
 #undef pg_GetKeyRepeat
+#undef pgEvent_Wakeup
 #undef pgEvent_FillUserEvent
 #undef pgEvent_Type
 #undef pgEvent_New
@@ -259,6 +276,8 @@ PyGame_static_init()
 
 #include "context.c"
 
+#include "particles.c"
+
 #include "_freetype.c"
 #include "freetype/ft_wrap.c"
 #include "freetype/ft_render.c"
@@ -282,6 +301,7 @@ PyGame_static_init()
 #include "alphablit.c"
 
 #include "surface_fill.c"
+#include "surface_hdr.c"
 #include "pixelarray.c"
 #include "pixelcopy.c"
 #include "newbuffer.c"
@@ -31,6 +31,22 @@
 #include "pgcompat.h"
 #include "doc/surface_doc.h"
 #include "pgbufferproxy.h"
+#include "pgopengl.h"
+
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+// arm64 has neon optimisations enabled by default, even when fpu=neon is not
+// passed
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+#if defined(PG_ENABLE_ARM_NEON)
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "include/sse2neon.h"
+#define SURFACE_SIMD
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SURFACE_SIMD
+#endif
 
 /* stdint.h is missing from some versions of MSVC. */
 #ifdef _MSC_VER
@@ -61,6 +77,8 @@ static char FormatUint32[] = "=I";
 typedef struct pg_bufferinternal_s {
     PyObject *consumer_ref; /* A weak reference to a bufferproxy object   */
     Py_ssize_t mem[6];      /* Enough memory for dim 3 shape and strides  */
+    Uint8 *staged;          /* Unpacked copy for a staged view, or NULL   */
+    SurfViewKind staged_kind;
 } pg_bufferinternal;
 
 /* copy of SDL Blit mapping definitions to enable pointer casting hack
@@ -101,6 +119,55 @@ typedef struct pg_BlitMap {
 int
 pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
                SDL_Rect *dstrect, SDL_Rect *srcrect, int the_args);
+void
+pgSurface_AddDamage(pgSurfaceObject *surfobj, SDL_Rect *rect);
+int
+pgSurface_PopDamage(pgSurfaceObject *surfobj, SDL_Rect *rects);
+Uint32
+pgSurface_GetVersion(pgSurfaceObject *surfobj);
+
+/* destination of a blit, resolved through any subsurface parents */
+typedef struct {
+    SDL_Surface *surf;  /* surface actually blitted to */
+    SDL_Surface *owner; /* top level owner, NULL if not a subsurface */
+    SDL_Rect orig_clip; /* owner clip rect to restore afterwards */
+    int offsetx;
+    int offsety;
+} pgBlitTarget;
+
+/* A surface and a rect of it, blitted like a subsurface without making an
+   SDL_Surface for it */
+typedef struct {
+    PyObject_HEAD pgSurfaceObject *surface;
+    SDL_Rect rect;
+    PyObject *subsurface; /* made by the first subsurface() or get_view() */
+} pgSurfaceRegionObject;
+
+static PyTypeObject pgSurfaceRegion_Type;
+#define pgSurfaceRegion_Check(x) \
+    (PyObject_IsInstance((x), (PyObject *)&pgSurfaceRegion_Type))
+
+static void
+surface_blit_target_begin(pgSurfaceObject *dstobj, pgBlitTarget *target);
+static void
+surface_blit_target_end(pgSurfaceObject *dstobj, pgBlitTarget *target);
+static int
+surface_blit_prepared(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
+                      SDL_Rect *dstrect, int the_args,
+                      const pgBlitSpans *spans);
+static PyObject *
+surface_get_spans(SDL_Surface *src, SDL_Surface *dst, int the_args);
+int
+pg_HasSurfaceRLE(SDL_Surface *surface);
+static int
+surface_blit_args(SDL_Surface *src, int the_args);
+static int
+surface_blit_pygame_alpha(SDL_Surface *src, SDL_Surface *dst, int the_args);
+static int
+surface_blit_pygame_palette(SDL_Surface *src, SDL_Surface *dst,
+                            int the_args);
+static int
+surface_pixels_overlap(SDL_Surface *a, SDL_Surface *b);
 
 /* statics */
 static pgSurfaceObject *
@@ -118,8 +185,14 @@ surface_dealloc(PyObject *self);
 static void
 surface_cleanup(pgSurfaceObject *self);
 static void
+surface_touch(pgSurfaceObject *surfobj);
+static void
+pgSurfacePool_FreeSurface(SDL_Surface *surf);
+static void
 surface_move(Uint8 *src, Uint8 *dst, int h, int span, int srcpitch,
              int dstpitch);
+static int
+surface_wrap(Uint8 *pixels, int w, int h, int bpp, int pitch, int dx, int dy);
 
 static PyObject *
 surf_get_at(PyObject *self, PyObject *args);
@@ -128,6 +201,10 @@ surf_set_at(PyObject *self, PyObject *args);
 static PyObject *
 surf_get_at_mapped(PyObject *self, PyObject *args);
 static PyObject *
+surf_get_at_many(pgSurfaceObject *self, PyObject *args, PyObject *keywds);
+static PyObject *
+surf_set_at_many(pgSurfaceObject *self, PyObject *args, PyObject *keywds);
+static PyObject *
 surf_map_rgb(PyObject *self, PyObject *args);
 static PyObject *
 surf_unmap_rgb(PyObject *self, PyObject *arg);
@@ -166,6 +243,8 @@ surf_convert(pgSurfaceObject *self, PyObject *args);
 static PyObject *
 surf_convert_alpha(pgSurfaceObject *self, PyObject *args);
 static PyObject *
+surf_premul_alpha(pgSurfaceObject *self, PyObject *args);
+static PyObject *
 surf_set_clip(PyObject *self, PyObject *args);
 static PyObject *
 surf_get_clip(PyObject *self, PyObject *args);
@@ -174,8 +253,20 @@ surf_blit(pgSurfaceObject *self, PyObject *args, PyObject *keywds);
 static PyObject *
 surf_blits(pgSurfaceObject *self, PyObject *args, PyObject *keywds);
 static PyObject *
+surf_fblits(pgSurfaceObject *self, PyObject *args, PyObject *keywds);
+static PyObject *
+surf_blit_many(pgSurfaceObject *self, PyObject *args, PyObject *keywds);
+static PyObject *
+surf_blit_array(pgSurfaceObject *self, PyObject *args, PyObject *keywds);
+static PyObject *
 surf_fill(pgSurfaceObject *self, PyObject *args, PyObject *keywds);
 static PyObject *
+surf_set_damage_tracking(pgSurfaceObject *self, PyObject *args);
+static PyObject *
+surf_get_damage(pgSurfaceObject *self, PyObject *args, PyObject *keywds);
+static PyObject *
+surf_get_version(pgSurfaceObject *self, PyObject *args);
+static PyObject *
 surf_scroll(PyObject *self, PyObject *args, PyObject *keywds);
 static PyObject *
 surf_get_abs_offset(PyObject *self, PyObject *args);
@@ -214,12 +305,22 @@ surf_get_parent(PyObject *self, PyObject *args);
 static PyObject *
 surf_subsurface(PyObject *self, PyObject *args);
 static PyObject *
+surf_region(PyObject *self, PyObject *args);
+static PyObject *
 surf_get_view(PyObject *self, PyObject *args);
 static PyObject *
 surf_get_buffer(PyObject *self, PyObject *args);
 static PyObject *
 surf_get_bounding_rect(PyObject *self, PyObject *args, PyObject *kwargs);
 static PyObject *
+surf_get_stats(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject *
+surf_compress(PyObject *self, PyObject *_null);
+static PyObject *
+surf_get_compressed_size(PyObject *self, PyObject *_null);
+static PyObject *
+surf_gl_upload(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject *
 surf_get_pixels_address(PyObject *self, PyObject *closure);
 static int
 _view_kind(PyObject *obj, void *view_kind_vptr);
@@ -240,18 +341,23 @@ _get_buffer_blue(PyObject *obj, Py_buffer *view_p, int flags);
 static int
 _get_buffer_alpha(PyObject *obj, Py_buffer *view_p, int flags);
 static int
-_get_buffer_colorplane(PyObject *obj, Py_buffer *view_p, int flags, char *name,
-                       Uint32 mask);
+_get_buffer_colorplane(PyObject *obj, Py_buffer *view_p, int flags,
+                       SurfViewKind view_kind, Uint32 mask);
+static int
+_get_buffer_staged(PyObject *obj, Py_buffer *view_p, int flags,
+                   SurfViewKind view_kind);
 static int
 _init_buffer(PyObject *surf, Py_buffer *view_p, int flags);
 static void
 _release_buffer(Py_buffer *view_p);
-static PyObject *
-_raise_get_view_ndim_error(int bitsize, SurfViewKind kind);
+static void
+_release_staged_buffer(Py_buffer *view_p);
 static PyObject *
 _raise_create_surface_error(void);
 static SDL_Surface *
 pg_DisplayFormatAlpha(SDL_Surface *surface);
+static Uint32
+pg_DisplayFormatAlphaEnum(void);
 static SDL_Surface *
 pg_DisplayFormat(SDL_Surface *surface);
 static int
@@ -300,6 +406,10 @@ static struct PyMethodDef surface_methods[] = {
     {"set_at", surf_set_at, METH_VARARGS, DOC_SURFACESETAT},
     {"get_at_mapped", surf_get_at_mapped, METH_VARARGS,
      DOC_SURFACEGETATMAPPED},
+    {"get_at_many", (PyCFunction)surf_get_at_many,
+     METH_VARARGS | METH_KEYWORDS, DOC_SURFACEGETATMANY},
+    {"set_at_many", (PyCFunction)surf_set_at_many,
+     METH_VARARGS | METH_KEYWORDS, DOC_SURFACESETATMANY},
     {"map_rgb", surf_map_rgb, METH_VARARGS, DOC_SURFACEMAPRGB},
     {"unmap_rgb", surf_unmap_rgb, METH_O, DOC_SURFACEUNMAPRGB},
 
@@ -332,6 +442,8 @@ static struct PyMethodDef surface_methods[] = {
     {"convert", (PyCFunction)surf_convert, METH_VARARGS, DOC_SURFACECONVERT},
     {"convert_alpha", (PyCFunction)surf_convert_alpha, METH_VARARGS,
      DOC_SURFACECONVERTALPHA},
+    {"premul_alpha", (PyCFunction)surf_premul_alpha, METH_NOARGS,
+     DOC_SURFACEPREMULALPHA},
 
     {"set_clip", surf_set_clip, METH_VARARGS, DOC_SURFACESETCLIP},
     {"get_clip", surf_get_clip, METH_NOARGS, DOC_SURFACEGETCLIP},
@@ -342,6 +454,18 @@ static struct PyMethodDef surface_methods[] = {
      DOC_SURFACEBLIT},
     {"blits", (PyCFunction)surf_blits, METH_VARARGS | METH_KEYWORDS,
      DOC_SURFACEBLITS},
+    {"fblits", (PyCFunction)surf_fblits, METH_VARARGS | METH_KEYWORDS,
+     DOC_SURFACEFBLITS},
+    {"blit_many", (PyCFunction)surf_blit_many, METH_VARARGS | METH_KEYWORDS,
+     DOC_SURFACEBLITMANY},
+    {"blit_array", (PyCFunction)surf_blit_array, METH_VARARGS | METH_KEYWORDS,
+     DOC_SURFACEBLITARRAY},
+    {"set_damage_tracking", (PyCFunction)surf_set_damage_tracking,
+     METH_VARARGS, DOC_SURFACESETDAMAGETRACKING},
+    {"get_damage", (PyCFunction)surf_get_damage, METH_VARARGS | METH_KEYWORDS,
+     DOC_SURFACEGETDAMAGE},
+    {"get_version", (PyCFunction)surf_get_version, METH_NOARGS,
+     DOC_SURFACEGETVERSION},
 
     {"scroll", (PyCFunction)surf_scroll, METH_VARARGS | METH_KEYWORDS,
      DOC_SURFACESCROLL},
@@ -363,6 +487,7 @@ static struct PyMethodDef surface_methods[] = {
     {"get_losses", surf_get_losses, METH_NOARGS, DOC_SURFACEGETLOSSES},
 
     {"subsurface", surf_subsurface, METH_VARARGS, DOC_SURFACESUBSURFACE},
+    {"region", surf_region, METH_VARARGS, DOC_SURFACEREGION},
     {"get_offset", surf_get_offset, METH_NOARGS, DOC_SURFACEGETOFFSET},
     {"get_abs_offset", surf_get_abs_offset, METH_NOARGS,
      DOC_SURFACEGETABSOFFSET},
@@ -371,16 +496,48 @@ static struct PyMethodDef surface_methods[] = {
      DOC_SURFACEGETABSPARENT},
     {"get_bounding_rect", (PyCFunction)surf_get_bounding_rect,
      METH_VARARGS | METH_KEYWORDS, DOC_SURFACEGETBOUNDINGRECT},
+    {"get_stats", (PyCFunction)surf_get_stats, METH_VARARGS | METH_KEYWORDS,
+     DOC_SURFACEGETSTATS},
     {"get_view", surf_get_view, METH_VARARGS, DOC_SURFACEGETVIEW},
     {"get_buffer", surf_get_buffer, METH_NOARGS, DOC_SURFACEGETBUFFER},
+    {"compress", surf_compress, METH_NOARGS, DOC_SURFACECOMPRESS},
+    {"get_compressed_size", surf_get_compressed_size, METH_NOARGS,
+     DOC_SURFACEGETCOMPRESSEDSIZE},
+    {"gl_upload", (PyCFunction)surf_gl_upload, METH_VARARGS | METH_KEYWORDS,
+     DOC_SURFACEGLUPLOAD},
 
     {NULL, NULL, 0, NULL}};
 
+/* Before any attribute of a compressed Surface other than its size is
+ * used, the Surface gets its pixels back. This covers every method, so
+ * they need not unpack the pixels themselves.
+ */
+static PyObject *
+surface_getattro(PyObject *self, PyObject *name)
+{
+    static const char *keep_packed[] = {
+        "get_size", "get_width", "get_height", "get_rect",
+        "compress", "get_compressed_size", NULL};
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    int i;
+
+    if (surf && (surf->flags & PG_SURF_PACKED)) {
+        for (i = 0; keep_packed[i]; ++i) {
+            if (!PyUnicode_CompareWithASCIIString(name, keep_packed[i]))
+                break;
+        }
+        if (!keep_packed[i] && !pgSurface_Unpack(surf))
+            return NULL;
+    }
+    return PyObject_GenericGetAttr(self, name);
+}
+
 static PyTypeObject pgSurface_Type = {
     PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.Surface",
     .tp_basicsize = sizeof(pgSurfaceObject),
     .tp_dealloc = surface_dealloc,
     .tp_repr = surface_str,
+    .tp_getattro = surface_getattro,
     .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
     .tp_doc = DOC_PYGAMESURFACE,
     .tp_weaklistoffset = offsetof(pgSurfaceObject, weakreflist),
@@ -414,6 +571,7 @@ pgSurface_SetSurface(pgSurfaceObject *self, SDL_Surface *s, int owner)
     surface_cleanup(self);
     self->surf = s;
     self->owner = owner;
+    surface_touch(self);
     return 0;
 }
 
@@ -433,6 +591,524 @@ surf_subtype_new(PyTypeObject *type, SDL_Surface *s, int owner)
     return (PyObject *)self;
 }
 
+/* Damage tracking: opt-in per Surface object list of changed areas,
+ * kept small by merging rects whenever that does not grow the total area.
+ * Trackers live in a short list keyed by the Surface object, so they
+ * survive the display Surface getting a new SDL surface. Only touched
+ * while holding the GIL.
+ */
+typedef struct pgDamageTracker {
+    pgSurfaceObject *surfobj;
+    struct pgDamageTracker *next;
+    int count;
+    SDL_Rect rects[PG_DAMAGE_MAX_RECTS];
+} pgDamageTracker;
+
+static pgDamageTracker *damage_trackers = NULL;
+
+static pgDamageTracker *
+surface_damage_find(pgSurfaceObject *surfobj)
+{
+    pgDamageTracker *tracker;
+
+    for (tracker = damage_trackers; tracker; tracker = tracker->next) {
+        if (tracker->surfobj == surfobj)
+            return tracker;
+    }
+    return NULL;
+}
+
+static void
+surface_damage_untrack(pgSurfaceObject *surfobj)
+{
+    pgDamageTracker **link = &damage_trackers;
+
+    while (*link) {
+        if ((*link)->surfobj == surfobj) {
+            pgDamageTracker *tracker = *link;
+
+            *link = tracker->next;
+            PyMem_Free(tracker);
+            return;
+        }
+        link = &(*link)->next;
+    }
+}
+
+static Sint64
+_rect_area(const SDL_Rect *r)
+{
+    return (Sint64)r->w * r->h;
+}
+
+static void
+surface_damage_add(pgDamageTracker *tracker, SDL_Rect rect)
+{
+    SDL_Rect merged;
+    int i, best;
+    Sint64 growth, best_growth;
+
+restart:
+    for (i = 0; i < tracker->count; ++i) {
+        SDL_UnionRect(&tracker->rects[i], &rect, &merged);
+        if (_rect_area(&merged) <=
+            _rect_area(&tracker->rects[i]) + _rect_area(&rect)) {
+            /* merging costs no extra pixels, so absorb the old rect and
+               retry, as the bigger rect may now cover others */
+            rect = merged;
+            tracker->rects[i] = tracker->rects[--tracker->count];
+            goto restart;
+        }
+    }
+
+    if (tracker->count == PG_DAMAGE_MAX_RECTS) {
+        /* full, so merge with the rect that grows the least */
+        best = 0;
+        best_growth = -1;
+        for (i = 0; i < tracker->count; ++i) {
+            SDL_UnionRect(&tracker->rects[i], &rect, &merged);
+            growth = _rect_area(&merged) - _rect_area(&tracker->rects[i]);
+            if (best_growth < 0 || growth < best_growth) {
+                best = i;
+                best_growth = growth;
+            }
+        }
+        SDL_UnionRect(&tracker->rects[best], &rect, &merged);
+        rect = merged;
+        tracker->rects[best] = tracker->rects[--tracker->count];
+        goto restart;
+    }
+
+    tracker->rects[tracker->count++] = rect;
+}
+
+/* Bump the version of surfobj and of its subsurface parents, whose pixels
+ * it shares.
+ */
+static void
+surface_touch(pgSurfaceObject *surfobj)
+{
+    for (;;) {
+        surfobj->version++;
+        if (!surfobj->subsurface)
+            break;
+        surfobj = (pgSurfaceObject *)surfobj->subsurface->owner;
+    }
+}
+
+/* The version of surfobj, which changes whenever it or one of its
+ * subsurface parents is modified. A sum, as a change to a parent shows
+ * through a subsurface.
+ */
+Uint32
+pgSurface_GetVersion(pgSurfaceObject *surfobj)
+{
+    Uint32 version = 0;
+
+    for (;;) {
+        version += surfobj->version;
+        if (!surfobj->subsurface)
+            break;
+        surfobj = (pgSurfaceObject *)surfobj->subsurface->owner;
+    }
+    return version;
+}
+
+/* Record rect as changed on surfobj and on any tracked subsurface
+ * parents, bumping their versions.
+ */
+void
+pgSurface_AddDamage(pgSurfaceObject *surfobj, SDL_Rect *rect)
+{
+    pgDamageTracker *tracker;
+    SDL_Surface *surf;
+    SDL_Rect area, bounds, clipped;
+
+    if (!rect || rect->w <= 0 || rect->h <= 0)
+        return;
+    surface_touch(surfobj);
+    if (!damage_trackers)
+        return;
+
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf || !SDL_IntersectRect(rect, &surf->clip_rect, &area))
+        return;
+
+    for (;;) {
+        tracker = surface_damage_find(surfobj);
+        if (tracker)
+            surface_damage_add(tracker, area);
+        if (!surfobj->subsurface)
+            break;
+
+        area.x += surfobj->subsurface->offsetx;
+        area.y += surfobj->subsurface->offsety;
+        surfobj = (pgSurfaceObject *)surfobj->subsurface->owner;
+        surf = pgSurface_AsSurface(surfobj);
+        if (!surf)
+            break;
+        bounds.x = bounds.y = 0;
+        bounds.w = surf->w;
+        bounds.h = surf->h;
+        if (!SDL_IntersectRect(&area, &bounds, &clipped))
+            break;
+        area = clipped;
+    }
+}
+
+/* Move the damage rects of surfobj into rects, which holds
+ * PG_DAMAGE_MAX_RECTS entries. Returns the count, or -1 if untracked.
+ */
+int
+pgSurface_PopDamage(pgSurfaceObject *surfobj, SDL_Rect *rects)
+{
+    pgDamageTracker *tracker = surface_damage_find(surfobj);
+    int count;
+
+    if (!tracker)
+        return -1;
+    count = tracker->count;
+    memcpy(rects, tracker->rects, count * sizeof(SDL_Rect));
+    tracker->count = 0;
+    return count;
+}
+
+/* Blit spans: the runs of skipped and opaque pixels along each row of a
+ * source surface, which let the blitters leave out or copy whole runs.
+ * They are kept in a dict keyed by the SDL surface address, each in a
+ * capsule so a blit running without the GIL keeps its spans alive. A
+ * surface gets an entry on its first blit and its runs on the second, if
+ * PG_SURF_SPANS shows nothing was written in between. Only touched while
+ * holding the GIL.
+ */
+static PyObject *surface_spans = NULL;
+
+static void
+surface_spans_destroy(PyObject *capsule)
+{
+    pgBlitSpans *spans = (pgBlitSpans *)PyCapsule_GetPointer(capsule, NULL);
+
+    PyMem_Free(spans->runs);
+    PyMem_Free(spans->rows);
+    PyMem_Free(spans);
+}
+
+/* The kind of spans a blit of src onto dst would use, or 0 if none */
+static int
+surface_spans_mode(SDL_Surface *src, SDL_Surface *dst, int the_args)
+{
+    Uint32 key;
+    Uint8 alpha;
+
+    /* on top of pixels that may change behind our back, the source must
+       own them or share them as a copy or pooled surface */
+    if (the_args != 0 || src->format->BytesPerPixel < 2 || src->locked ||
+        (src->flags & (SDL_RLEACCEL | PG_SURF_PINNED)) ||
+        ((src->flags & SDL_PREALLOC) &&
+         !(src->flags & (PG_SURF_SHARED | PG_SURF_POOLED)))) {
+        return 0;
+    }
+    if (surface_blit_pygame_alpha(src, dst, the_args)) {
+        return PG_SPANS_ALPHA;
+    }
+    /* colorkey blits are taken from SDL only for a straight copy */
+    if (SDL_GetColorKey(src, &key) == 0 && !src->format->Amask &&
+        src->format->format == dst->format->format &&
+        SDL_GetSurfaceAlphaMod(src, &alpha) == 0 && alpha == 255 &&
+        !pg_HasSurfaceRLE(src) && !pg_HasSurfaceRLE(dst) &&
+        !(dst->flags & SDL_RLEACCEL)) {
+        return PG_SPANS_KEY;
+    }
+    return 0;
+}
+
+/* Return a new reference to the capsule holding the spans for blitting
+ * src onto dst, or NULL if it has none yet. Never sets an exception, as
+ * blitting without spans is only slower.
+ */
+static PyObject *
+surface_get_spans(SDL_Surface *src, SDL_Surface *dst, int the_args)
+{
+    PyObject *key, *capsule;
+    pgBlitSpans *spans;
+    Uint32 colorkey = 0;
+    int mode = surface_spans_mode(src, dst, the_args);
+
+    if (!mode) {
+        return NULL;
+    }
+    if (mode == PG_SPANS_KEY) {
+        SDL_GetColorKey(src, &colorkey);
+    }
+    if (!surface_spans) {
+        surface_spans = PyDict_New();
+        if (!surface_spans) {
+            PyErr_Clear();
+            return NULL;
+        }
+    }
+    key = PyLong_FromVoidPtr(src);
+    if (!key) {
+        PyErr_Clear();
+        return NULL;
+    }
+
+    capsule = PyDict_GetItem(surface_spans, key);
+    if (capsule) {
+        spans = (pgBlitSpans *)PyCapsule_GetPointer(capsule, NULL);
+        if ((src->flags & PG_SURF_SPANS) && spans->pixels == src->pixels &&
+            spans->w == src->w && spans->h == src->h &&
+            spans->pitch == src->pitch &&
+            spans->format == src->format->format && spans->mode == mode &&
+            spans->colorkey == colorkey) {
+            Py_DECREF(key);
+            if (!spans->runs && pg_BuildBlitSpans(src, spans)) {
+                return NULL;
+            }
+            Py_INCREF(capsule);
+            return capsule;
+        }
+    }
+
+    /* first blit since the pixels changed, if ever */
+    spans = PyMem_New(pgBlitSpans, 1);
+    if (!spans) {
+        Py_DECREF(key);
+        PyErr_Clear();
+        return NULL;
+    }
+    spans->runs = NULL;
+    spans->rows = NULL;
+    spans->pixels = src->pixels;
+    spans->w = src->w;
+    spans->h = src->h;
+    spans->pitch = src->pitch;
+    spans->format = src->format->format;
+    spans->colorkey = colorkey;
+    spans->mode = mode;
+    capsule = PyCapsule_New(spans, NULL, surface_spans_destroy);
+    if (!capsule) {
+        PyMem_Free(spans);
+        PyErr_Clear();
+    }
+    else if (PyDict_SetItem(surface_spans, key, capsule) == 0) {
+        src->flags |= PG_SURF_SPANS;
+    }
+    else {
+        PyErr_Clear();
+    }
+    Py_XDECREF(capsule);
+    Py_DECREF(key);
+    return NULL;
+}
+
+/* Drop the spans kept for surf */
+static void
+surface_drop_spans(SDL_Surface *surf)
+{
+    PyObject *key;
+
+    if (!surface_spans || !PyDict_GET_SIZE(surface_spans)) {
+        return;
+    }
+    surf->flags &= ~PG_SURF_SPANS;
+    key = PyLong_FromVoidPtr(surf);
+    if (!key || PyDict_DelItem(surface_spans, key)) {
+        PyErr_Clear();
+    }
+    Py_XDECREF(key);
+}
+
+#define SURFACE_SPANS(capsule) \
+    ((capsule) ? (pgBlitSpans *)PyCapsule_GetPointer(capsule, NULL) : NULL)
+
+/* Auto-convert: with it enabled, a source blitted to a 32 bit surface of
+ * another pixel format gets a shadow copy converted to that format, which
+ * later blits use until the source version changes. Shadows are kept like
+ * the spans, in a dict keyed by the SDL surface address. As with the
+ * spans, the shadow is only made on the second blit with the pixels
+ * unchanged, so surfaces blitted once are not converted for nothing.
+ */
+typedef struct {
+    SDL_Surface *shadow; /* NULL until the second blit */
+    Uint32 version;      /* of the source when it was seen */
+    void *pixels;
+    int w;
+    int h;
+    int pitch;
+    Uint32 format; /* of the shadow */
+} pgShadow;
+
+static PyObject *surface_shadows = NULL;
+static int surface_auto_convert = 0;
+static int surface_auto_convert_warned = 0;
+
+static void
+surface_shadow_destroy(PyObject *capsule)
+{
+    pgShadow *shadow = (pgShadow *)PyCapsule_GetPointer(capsule, NULL);
+
+    if (shadow->shadow) {
+        surface_drop_spans(shadow->shadow);
+        SDL_FreeSurface(shadow->shadow);
+    }
+    PyMem_Free(shadow);
+}
+
+/* The format a shadow of src for blitting to dst would have, or
+ * SDL_PIXELFORMAT_UNKNOWN if src is blitted as it is. Like convert() and
+ * convert_alpha(), a source with per pixel alpha keeps it.
+ */
+static Uint32
+surface_shadow_format(SDL_Surface *src, SDL_Surface *dst, int the_args)
+{
+    SDL_PixelFormat *fmt = dst->format;
+    Uint32 key, format;
+
+    /* the source must own its pixels or share them as a copy or pooled
+       surface, so that its version covers every change to them */
+    if (the_args != 0 || fmt->BytesPerPixel != 4 ||
+        src->format->BytesPerPixel < 2 || SDL_GetColorKey(src, &key) == 0 ||
+        (src->flags & (SDL_RLEACCEL | PG_SURF_PINNED)) ||
+        ((src->flags & SDL_PREALLOC) &&
+         !(src->flags & (PG_SURF_SHARED | PG_SURF_POOLED)))) {
+        return SDL_PIXELFORMAT_UNKNOWN;
+    }
+    if (src->format->Amask) {
+        format = SDL_MasksToPixelFormatEnum(
+            32, fmt->Rmask, fmt->Gmask, fmt->Bmask,
+            fmt->Amask ? fmt->Amask
+                       : ~(fmt->Rmask | fmt->Gmask | fmt->Bmask));
+    }
+    else {
+        format = SDL_MasksToPixelFormatEnum(32, fmt->Rmask, fmt->Gmask,
+                                            fmt->Bmask, 0);
+    }
+    if (format == src->format->format)
+        return SDL_PIXELFORMAT_UNKNOWN;
+    return format;
+}
+
+/* Set *capsule to a new reference to the capsule holding the shadow of
+ * srcobj to blit onto dst in its place, or to NULL if srcobj is blitted
+ * itself. Returns -1 with an exception set only if the one time warning
+ * is turned into an error; anything else just leaves out the shadow.
+ */
+static int
+surface_get_shadow(pgSurfaceObject *srcobj, SDL_Surface *dst, int the_args,
+                   PyObject **capsule)
+{
+    SDL_Surface *src = pgSurface_AsSurface(srcobj);
+    PyObject *key, *entry;
+    pgShadow *shadow;
+    SDL_BlendMode mode;
+    Uint32 format, version;
+    Uint8 alpha;
+
+    *capsule = NULL;
+    if (!surface_auto_convert)
+        return 0;
+    format = surface_shadow_format(src, dst, the_args);
+    if (format == SDL_PIXELFORMAT_UNKNOWN)
+        return 0;
+    if (!surface_shadows) {
+        surface_shadows = PyDict_New();
+        if (!surface_shadows) {
+            PyErr_Clear();
+            return 0;
+        }
+    }
+    key = PyLong_FromVoidPtr(src);
+    if (!key) {
+        PyErr_Clear();
+        return 0;
+    }
+
+    version = pgSurface_GetVersion(srcobj);
+    *capsule = PyDict_GetItem(surface_shadows, key);
+    if (*capsule) {
+        shadow = (pgShadow *)PyCapsule_GetPointer(*capsule, NULL);
+        if (shadow->version == version && shadow->pixels == src->pixels &&
+            shadow->w == src->w && shadow->h == src->h &&
+            shadow->pitch == src->pitch && shadow->format == format) {
+            Py_DECREF(key);
+            if (!shadow->shadow) {
+                if (!surface_auto_convert_warned) {
+                    surface_auto_convert_warned = 1;
+                    if (PyErr_WarnEx(PyExc_RuntimeWarning,
+                                     "a Surface in another pixel format "
+                                     "is blitted repeatedly; call "
+                                     "convert() or convert_alpha() on it "
+                                     "once instead",
+                                     1) < 0) {
+                        *capsule = NULL;
+                        return -1;
+                    }
+                }
+                shadow->shadow = SDL_ConvertSurfaceFormat(src, format, 0);
+                if (!shadow->shadow) {
+                    *capsule = NULL;
+                    return 0;
+                }
+                shadow->shadow->flags |= src->flags & PG_SURF_PREMULTIPLIED;
+            }
+            /* these can change without touching the pixels */
+            if (SDL_GetSurfaceBlendMode(src, &mode) == 0)
+                SDL_SetSurfaceBlendMode(shadow->shadow, mode);
+            if (SDL_GetSurfaceAlphaMod(src, &alpha) == 0)
+                SDL_SetSurfaceAlphaMod(shadow->shadow, alpha);
+            Py_INCREF(*capsule);
+            return 0;
+        }
+    }
+
+    /* first blit since the pixels changed, if ever */
+    *capsule = NULL;
+    shadow = PyMem_New(pgShadow, 1);
+    if (!shadow) {
+        Py_DECREF(key);
+        PyErr_Clear();
+        return 0;
+    }
+    shadow->shadow = NULL;
+    shadow->version = version;
+    shadow->pixels = src->pixels;
+    shadow->w = src->w;
+    shadow->h = src->h;
+    shadow->pitch = src->pitch;
+    shadow->format = format;
+    entry = PyCapsule_New(shadow, NULL, surface_shadow_destroy);
+    if (!entry) {
+        PyMem_Free(shadow);
+        PyErr_Clear();
+    }
+    else if (PyDict_SetItem(surface_shadows, key, entry)) {
+        PyErr_Clear();
+    }
+    Py_XDECREF(entry);
+    Py_DECREF(key);
+    return 0;
+}
+
+/* Drop the shadow kept for surf */
+static void
+surface_drop_shadow(SDL_Surface *surf)
+{
+    PyObject *key;
+
+    if (!surface_shadows || !PyDict_GET_SIZE(surface_shadows)) {
+        return;
+    }
+    key = PyLong_FromVoidPtr(surf);
+    if (!key || PyDict_DelItem(surface_shadows, key)) {
+        PyErr_Clear();
+    }
+    Py_XDECREF(key);
+}
+
+#define SURFACE_SHADOW(capsule) \
+    (((pgShadow *)PyCapsule_GetPointer(capsule, NULL))->shadow)
+
 static PyObject *
 surface_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
@@ -446,6 +1122,7 @@ surface_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         self->weakreflist = NULL;
         self->dependency = NULL;
         self->locklist = NULL;
+        self->readlocks = 0;
     }
     return (PyObject *)self;
 }
@@ -454,8 +1131,13 @@ surface_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 static void
 surface_cleanup(pgSurfaceObject *self)
 {
+    surface_damage_untrack(self);
     if (self->surf && self->owner) {
-        SDL_FreeSurface(self->surf);
+        surface_drop_spans(self->surf);
+        surface_drop_shadow(self->surf);
+        pgSurface_ReleasePack(self->surf);
+        pgSurface_ReleaseShare(self->surf);
+        pgSurfacePool_FreeSurface(self->surf);
         self->surf = NULL;
     }
     if (self->subsurface) {
@@ -712,6 +1394,9 @@ surface_init(pgSurfaceObject *self, PyObject *args, PyObject *kwds)
     }
 
     if (surface) {
+        if ((flags & PGS_PREMULTIPLIED) && Amask) {
+            surface->flags |= PG_SURF_PREMULTIPLIED;
+        }
         self->surf = surface;
         self->owner = 1;
         self->subsurface = NULL;
@@ -730,44 +1415,109 @@ _raise_create_surface_error(void)
     return RAISE(pgExc_SDLError, msg);
 }
 
-/* surface object methods */
-static PyObject *
-surf_get_at(PyObject *self, PyObject *args)
+/* Read the mapped color of a pixel of a locked surface of 1 to 4 bytes
+   per pixel. */
+static PG_INLINE Uint32
+_surf_read_mapped(SDL_Surface *surf, int x, int y)
 {
-    SDL_Surface *surf = pgSurface_AsSurface(self);
-    SDL_PixelFormat *format = NULL;
-    Uint8 *pixels = NULL;
-    int x, y;
-    Uint32 color;
+    Uint8 *row = (Uint8 *)surf->pixels + y * surf->pitch;
     Uint8 *pix;
-    Uint8 rgba[4] = {0, 0, 0, 255};
-
-    if (!PyArg_ParseTuple(args, "(ii)", &x, &y))
-        return NULL;
-    if (!surf)
-        return RAISE(pgExc_SDLError, "display Surface quit");
-
-    if (x < 0 || x >= surf->w || y < 0 || y >= surf->h)
-        return RAISE(PyExc_IndexError, "pixel index out of range");
 
-    format = surf->format;
-
-    if (format->BytesPerPixel < 1 || format->BytesPerPixel > 4)
-        return RAISE(PyExc_RuntimeError, "invalid color depth for surface");
-
-    if (!pgSurface_Lock((pgSurfaceObject *)self))
-        return NULL;
-
-    pixels = (Uint8 *)surf->pixels;
-
-    switch (format->BytesPerPixel) {
+    switch (surf->format->BytesPerPixel) {
         case 1:
-            color = (Uint32) * ((Uint8 *)pixels + y * surf->pitch + x);
-            SDL_GetRGB(color, format, rgba, rgba + 1, rgba + 2);
-            break;
+            return row[x];
         case 2:
-            color = (Uint32) * ((Uint16 *)(pixels + y * surf->pitch) + x);
-            SDL_GetRGBA(color, format, rgba, rgba + 1, rgba + 2, rgba + 3);
+            return ((Uint16 *)row)[x];
+        case 3:
+            pix = row + x * 3;
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            return (pix[0]) + (pix[1] << 8) + (pix[2] << 16);
+#else
+            return (pix[2]) + (pix[1] << 8) + (pix[0] << 16);
+#endif
+        default: /* case 4: */
+            return ((Uint32 *)row)[x];
+    }
+}
+
+/* Write a mapped color to a pixel of a locked surface of 1 to 4 bytes per
+   pixel. */
+static PG_INLINE void
+_surf_write_mapped(SDL_Surface *surf, int x, int y, Uint32 color)
+{
+    SDL_PixelFormat *format = surf->format;
+    Uint8 *row = (Uint8 *)surf->pixels + y * surf->pitch;
+    Uint8 *byte_buf;
+
+    switch (format->BytesPerPixel) {
+        case 1:
+            row[x] = (Uint8)color;
+            break;
+        case 2:
+            ((Uint16 *)row)[x] = (Uint16)color;
+            break;
+        case 3:
+            byte_buf = row + x * 3;
+#if (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+            *(byte_buf + (format->Rshift >> 3)) =
+                (Uint8)(color >> format->Rshift);
+            *(byte_buf + (format->Gshift >> 3)) =
+                (Uint8)(color >> format->Gshift);
+            *(byte_buf + (format->Bshift >> 3)) =
+                (Uint8)(color >> format->Bshift);
+#else
+            *(byte_buf + 2 - (format->Rshift >> 3)) =
+                (Uint8)(color >> format->Rshift);
+            *(byte_buf + 2 - (format->Gshift >> 3)) =
+                (Uint8)(color >> format->Gshift);
+            *(byte_buf + 2 - (format->Bshift >> 3)) =
+                (Uint8)(color >> format->Bshift);
+#endif
+            break;
+        default: /* case 4: */
+            ((Uint32 *)row)[x] = color;
+            break;
+    }
+}
+
+/* surface object methods */
+static PyObject *
+surf_get_at(PyObject *self, PyObject *args)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    SDL_PixelFormat *format = NULL;
+    Uint8 *pixels = NULL;
+    int x, y;
+    Uint32 color;
+    Uint8 *pix;
+    Uint8 rgba[4] = {0, 0, 0, 255};
+
+    if (!PyArg_ParseTuple(args, "(ii)", &x, &y))
+        return NULL;
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+
+    if (x < 0 || x >= surf->w || y < 0 || y >= surf->h)
+        return RAISE(PyExc_IndexError, "pixel index out of range");
+
+    format = surf->format;
+
+    if (format->BytesPerPixel < 1 || format->BytesPerPixel > 4)
+        return RAISE(PyExc_RuntimeError, "invalid color depth for surface");
+
+    if (!pgSurface_LockRead((pgSurfaceObject *)self))
+        return NULL;
+
+    pixels = (Uint8 *)surf->pixels;
+
+    switch (format->BytesPerPixel) {
+        case 1:
+            color = (Uint32) * ((Uint8 *)pixels + y * surf->pitch + x);
+            SDL_GetRGB(color, format, rgba, rgba + 1, rgba + 2);
+            break;
+        case 2:
+            color = (Uint32) * ((Uint16 *)(pixels + y * surf->pitch) + x);
+            SDL_GetRGBA(color, format, rgba, rgba + 1, rgba + 2, rgba + 3);
             break;
         case 3:
             pix = ((Uint8 *)(pixels + y * surf->pitch) + x * 3);
@@ -784,7 +1534,7 @@ surf_get_at(PyObject *self, PyObject *args)
             SDL_GetRGBA(color, format, rgba, rgba + 1, rgba + 2, rgba + 3);
             break;
     }
-    if (!pgSurface_Unlock((pgSurfaceObject *)self))
+    if (!pgSurface_UnlockRead((pgSurfaceObject *)self))
         return NULL;
 
     return pgColor_New(rgba);
@@ -795,12 +1545,10 @@ surf_set_at(PyObject *self, PyObject *args)
 {
     SDL_Surface *surf = pgSurface_AsSurface(self);
     SDL_PixelFormat *format = NULL;
-    Uint8 *pixels;
     int x, y;
     Uint32 color;
     Uint8 rgba[4] = {0, 0, 0, 0};
     PyObject *rgba_obj;
-    Uint8 *byte_buf;
 
     if (!PyArg_ParseTuple(args, "(ii)O", &x, &y, &rgba_obj))
         return NULL;
@@ -835,37 +1583,7 @@ surf_set_at(PyObject *self, PyObject *args)
 
     if (!pgSurface_Lock((pgSurfaceObject *)self))
         return NULL;
-    pixels = (Uint8 *)surf->pixels;
-
-    switch (format->BytesPerPixel) {
-        case 1:
-            *((Uint8 *)pixels + y * surf->pitch + x) = (Uint8)color;
-            break;
-        case 2:
-            *((Uint16 *)(pixels + y * surf->pitch) + x) = (Uint16)color;
-            break;
-        case 3:
-            byte_buf = (Uint8 *)(pixels + y * surf->pitch) + x * 3;
-#if (SDL_BYTEORDER == SDL_LIL_ENDIAN)
-            *(byte_buf + (format->Rshift >> 3)) =
-                (Uint8)(color >> format->Rshift);
-            *(byte_buf + (format->Gshift >> 3)) =
-                (Uint8)(color >> format->Gshift);
-            *(byte_buf + (format->Bshift >> 3)) =
-                (Uint8)(color >> format->Bshift);
-#else
-            *(byte_buf + 2 - (format->Rshift >> 3)) =
-                (Uint8)(color >> format->Rshift);
-            *(byte_buf + 2 - (format->Gshift >> 3)) =
-                (Uint8)(color >> format->Gshift);
-            *(byte_buf + 2 - (format->Bshift >> 3)) =
-                (Uint8)(color >> format->Bshift);
-#endif
-            break;
-        default: /* case 4: */
-            *((Uint32 *)(pixels + y * surf->pitch) + x) = color;
-            break;
-    }
+    _surf_write_mapped(surf, x, y, color);
 
     if (!pgSurface_Unlock((pgSurfaceObject *)self))
         return NULL;
@@ -877,10 +1595,8 @@ surf_get_at_mapped(PyObject *self, PyObject *args)
 {
     SDL_Surface *surf = pgSurface_AsSurface(self);
     SDL_PixelFormat *format = NULL;
-    Uint8 *pixels = NULL;
     int x, y;
     Sint32 color;
-    Uint8 *pix;
 
     if (!PyArg_ParseTuple(args, "(ii)", &x, &y))
         return NULL;
@@ -895,31 +1611,10 @@ surf_get_at_mapped(PyObject *self, PyObject *args)
     if (format->BytesPerPixel < 1 || format->BytesPerPixel > 4)
         return RAISE(PyExc_RuntimeError, "invalid color depth for surface");
 
-    if (!pgSurface_Lock((pgSurfaceObject *)self))
+    if (!pgSurface_LockRead((pgSurfaceObject *)self))
         return NULL;
-
-    pixels = (Uint8 *)surf->pixels;
-
-    switch (format->BytesPerPixel) {
-        case 1:
-            color = (Uint32) * ((Uint8 *)pixels + y * surf->pitch + x);
-            break;
-        case 2:
-            color = (Uint32) * ((Uint16 *)(pixels + y * surf->pitch) + x);
-            break;
-        case 3:
-            pix = ((Uint8 *)(pixels + y * surf->pitch) + x * 3);
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-            color = (pix[0]) + (pix[1] << 8) + (pix[2] << 16);
-#else
-            color = (pix[2]) + (pix[1] << 8) + (pix[0] << 16);
-#endif
-            break;
-        default: /* case 4: */
-            color = *((Uint32 *)(pixels + y * surf->pitch) + x);
-            break;
-    }
-    if (!pgSurface_Unlock((pgSurfaceObject *)self))
+    color = (Sint32)_surf_read_mapped(surf, x, y);
+    if (!pgSurface_UnlockRead((pgSurfaceObject *)self))
         return NULL;
 
     return PyLong_FromLong((long)color);
@@ -994,7 +1689,8 @@ surf_get_locked(PyObject *self, PyObject *_null)
 {
     pgSurfaceObject *surf = (pgSurfaceObject *)self;
 
-    if (surf->locklist && PyList_Size(surf->locklist) > 0)
+    if (surf->readlocks > 0 ||
+        (surf->locklist && PyList_Size(surf->locklist) > 0))
         Py_RETURN_TRUE;
     Py_RETURN_FALSE;
 }
@@ -1156,6 +1852,7 @@ surf_set_palette(PyObject *self, PyObject *args)
     ecode = SDL_SetPaletteColors(pal, colors, 0, len);
     if (ecode != 0)
         return RAISE(pgExc_SDLError, SDL_GetError());
+    surface_touch((pgSurfaceObject *)self);
     Py_RETURN_NONE;
 }
 
@@ -1205,6 +1902,7 @@ surf_set_palette_at(PyObject *self, PyObject *args)
 
     if (SDL_SetPaletteColors(pal, &color, _index, 1) != 0)
         return RAISE(pgExc_SDLError, SDL_GetError());
+    surface_touch((pgSurfaceObject *)self);
 
     Py_RETURN_NONE;
 }
@@ -1247,6 +1945,10 @@ surf_set_colorkey(pgSurfaceObject *self, PyObject *args)
         hascolor = SDL_TRUE;
     }
 
+    /* RLE encoding is kept with the pixels, which copies cannot share */
+    if ((flags & PGS_RLEACCEL) && !pgSurface_Unshare(surf))
+        return NULL;
+
     pgSurface_Prep(self);
     result = 0;
     if (hascolor && surf->format->BytesPerPixel == 1) {
@@ -1265,6 +1967,7 @@ surf_set_colorkey(pgSurfaceObject *self, PyObject *args)
 
     if (result == -1)
         return RAISE(pgExc_SDLError, SDL_GetError());
+    surface_touch(self);
 
     Py_RETURN_NONE;
 }
@@ -1340,6 +2043,8 @@ surf_set_alpha(pgSurfaceObject *self, PyObject *args)
         if (SDL_SetSurfaceBlendMode(surf, SDL_BLENDMODE_NONE) != 0)
             return RAISE(pgExc_SDLError, SDL_GetError());
     }
+    if ((flags & PGS_RLEACCEL) && !pgSurface_Unshare(surf))
+        return NULL;
     pgSurface_Prep(self);
     result =
         SDL_SetSurfaceRLE(surf, (flags & PGS_RLEACCEL) ? SDL_TRUE : SDL_FALSE);
@@ -1366,6 +2071,7 @@ surf_set_alpha(pgSurfaceObject *self, PyObject *args)
 
     if (result == -1)
         return RAISE(pgExc_SDLError, SDL_GetError());
+    surface_touch(self);
 
     Py_RETURN_NONE;
 }
@@ -1403,6 +2109,58 @@ surf_get_blendmode(PyObject *self, PyObject *_null)
     return PyLong_FromLong((long)mode);
 }
 
+/* Whether a copy of surf can share its pixels until either is written to.
+ * Subsurfaces, the display surface and buffers from elsewhere are not
+ * ours to share; RLE, locks and subsurfaces of surf all hold on to the
+ * pixels. Unusual blend modes are left to SDL_ConvertSurface.
+ */
+static int
+_copy_can_share(SDL_Surface *surf)
+{
+    SDL_BlendMode mode;
+
+    if (!surf->pixels || surf->w < 1 || surf->h < 1 || surf->locked ||
+        (surf->flags & (SDL_RLEACCEL | PG_SURF_PINNED)))
+        return 0;
+    if ((surf->flags & SDL_PREALLOC) && !(surf->flags & PG_SURF_SHARED))
+        return 0;
+    return SDL_GetSurfaceBlendMode(surf, &mode) == 0 &&
+           (mode == SDL_BLENDMODE_NONE || mode == SDL_BLENDMODE_BLEND);
+}
+
+/* A copy of surf sharing its pixels, with the settings that
+ * SDL_ConvertSurface(surf, surf->format, 0) would give it.
+ * Returns NULL with a Python exception set on failure.
+ */
+static SDL_Surface *
+_copy_shared(SDL_Surface *surf)
+{
+    SDL_Palette *palette = surf->format->palette;
+    SDL_Surface *newsurf;
+    Uint8 r, g, b, a;
+    Uint32 key;
+
+    newsurf = pgSurface_SharePixels(surf);
+    if (!newsurf)
+        return NULL;
+
+    if (palette && newsurf->format->palette)
+        SDL_SetPaletteColors(newsurf->format->palette, palette->colors, 0,
+                             palette->ncolors);
+    if (SDL_GetColorKey(surf, &key) == 0)
+        SDL_SetColorKey(newsurf, SDL_TRUE, key);
+    SDL_GetSurfaceColorMod(surf, &r, &g, &b);
+    SDL_SetSurfaceColorMod(newsurf, r, g, b);
+    SDL_GetSurfaceAlphaMod(surf, &a);
+    SDL_SetSurfaceAlphaMod(newsurf, a);
+    SDL_SetSurfaceBlendMode(newsurf,
+                            surf->format->Amask || a != SDL_ALPHA_OPAQUE
+                                ? SDL_BLENDMODE_BLEND
+                                : SDL_BLENDMODE_NONE);
+    SDL_SetClipRect(newsurf, &surf->clip_rect);
+    return newsurf;
+}
+
 static PyObject *
 surf_copy(pgSurfaceObject *self, PyObject *_null)
 {
@@ -1413,9 +2171,19 @@ surf_copy(pgSurfaceObject *self, PyObject *_null)
     if (!surf)
         return RAISE(pgExc_SDLError, "display Surface quit");
 
-    pgSurface_Prep(self);
-    newsurf = SDL_ConvertSurface(surf, surf->format, 0);
-    pgSurface_Unprep(self);
+    if (_copy_can_share(surf)) {
+        newsurf = _copy_shared(surf);
+        if (!newsurf)
+            return NULL;
+    }
+    else {
+        pgSurface_Prep(self);
+        newsurf = SDL_ConvertSurface(surf, surf->format, 0);
+        pgSurface_Unprep(self);
+    }
+    if (newsurf) {
+        newsurf->flags |= surf->flags & PG_SURF_PREMULTIPLIED;
+    }
 
     final = surf_subtype_new(Py_TYPE(self), newsurf, 1);
     if (!final)
@@ -1432,6 +2200,7 @@ surf_convert(pgSurfaceObject *self, PyObject *args)
     SDL_Surface *src;
     SDL_Surface *newsurf;
     Uint32 flags = UINT32_MAX;
+    Uint64 start;
 
     Uint32 colorkey;
     Uint8 key_r, key_g, key_b, key_a = 255;
@@ -1444,6 +2213,7 @@ surf_convert(pgSurfaceObject *self, PyObject *args)
     if (!PyArg_ParseTuple(args, "|Oi", &argobject, &flags))
         return NULL;
 
+    start = pg_StatsBegin();
     pgSurface_Prep(self);
 
     if (SDL_GetColorKey(surf, &colorkey) == 0) {
@@ -1571,6 +2341,13 @@ surf_convert(pgSurfaceObject *self, PyObject *args)
         newsurf = pg_DisplayFormat(surf);
         SDL_SetSurfaceBlendMode(newsurf, SDL_BLENDMODE_NONE);
     }
+    pg_StatsEnd(PG_STAT_CONVERT, "convert", start, (Sint64)surf->w * surf->h);
+
+    /* the colours stay premultiplied, but without an alpha channel there
+       is nothing left to blend them with */
+    if (newsurf && newsurf->format->Amask) {
+        newsurf->flags |= surf->flags & PG_SURF_PREMULTIPLIED;
+    }
 
     if (has_colorkey) {
         colorkey = pg_map_rgba(newsurf, key_r, key_g, key_b, key_a);
@@ -1601,8 +2378,11 @@ pg_DisplayFormat(SDL_Surface *surface)
     return SDL_ConvertSurface(surface, displaysurf->format, 0);
 }
 
-static SDL_Surface *
-pg_DisplayFormatAlpha(SDL_Surface *surface)
+/* The 32 bit alpha format convert_alpha() picks for the display. Returns
+ * SDL_PIXELFORMAT_UNKNOWN with an SDL error set on failure.
+ */
+static Uint32
+pg_DisplayFormatAlphaEnum(void)
 {
     SDL_Surface *displaysurf;
     SDL_PixelFormat *dformat;
@@ -1614,7 +2394,7 @@ pg_DisplayFormatAlpha(SDL_Surface *surface)
 
     if (!pg_GetDefaultWindowSurface()) {
         SDL_SetError("No video mode has been set");
-        return NULL;
+        return SDL_PIXELFORMAT_UNKNOWN;
     }
     displaysurf = pgSurface_AsSurface(pg_GetDefaultWindowSurface());
     dformat = displaysurf->format;
@@ -1649,8 +2429,17 @@ pg_DisplayFormatAlpha(SDL_Surface *surface)
     pfe = SDL_MasksToPixelFormatEnum(32, rmask, gmask, bmask, amask);
     if (pfe == SDL_PIXELFORMAT_UNKNOWN) {
         SDL_SetError("unknown pixel format");
-        return NULL;
     }
+    return pfe;
+}
+
+static SDL_Surface *
+pg_DisplayFormatAlpha(SDL_Surface *surface)
+{
+    Uint32 pfe = pg_DisplayFormatAlphaEnum();
+
+    if (pfe == SDL_PIXELFORMAT_UNKNOWN)
+        return NULL;
     return SDL_ConvertSurfaceFormat(surface, pfe, 0);
 }
 
@@ -1661,6 +2450,7 @@ surf_convert_alpha(pgSurfaceObject *self, PyObject *args)
     PyObject *final;
     pgSurfaceObject *srcsurf = NULL;
     SDL_Surface *newsurf;
+    Uint64 start;
 
     if (!SDL_WasInit(SDL_INIT_VIDEO))
         return RAISE(pgExc_SDLError,
@@ -1676,8 +2466,14 @@ surf_convert_alpha(pgSurfaceObject *self, PyObject *args)
      * hmm, we have to figure this out, not all depths have good
      * support for alpha
      */
+    start = pg_StatsBegin();
     newsurf = pg_DisplayFormatAlpha(surf);
+    pg_StatsEnd(PG_STAT_CONVERT, "convert_alpha", start,
+                (Sint64)surf->w * surf->h);
     SDL_SetSurfaceBlendMode(newsurf, SDL_BLENDMODE_BLEND);
+    if (newsurf) {
+        newsurf->flags |= surf->flags & PG_SURF_PREMULTIPLIED;
+    }
     final = surf_subtype_new(Py_TYPE(self), newsurf, 1);
 
     if (!final)
@@ -1685,69 +2481,592 @@ surf_convert_alpha(pgSurfaceObject *self, PyObject *args)
     return final;
 }
 
-static PyObject *
-surf_set_clip(PyObject *self, PyObject *args)
+/*
+ * convert_many: convert a list of surfaces to one format, spread over
+ * the worker pool one surface at a time.
+ */
+
+/* Moves the byte channels of one 24 or 32 bit format into another, for
+ * the conversions that don't need SDL's blitters */
+typedef struct {
+    int srcbpp;
+    int dstbpp;
+    int nchannels; /* R, G, B, and A when both formats have it */
+    int srcshift[4];
+    int dstshift[4];
+    Uint32 alpha; /* opaque alpha for a destination the source can't fill */
+    int same;     /* the formats are identical, so rows are copied */
+} ConvertSwizzle;
+
+/* Whether a format is 24 or 32 bits with every channel in a whole byte */
+static int
+_convert_format_is_bytes(SDL_PixelFormat *format)
 {
-    SDL_Surface *surf = pgSurface_AsSurface(self);
-    PyObject *item;
-    SDL_Rect *rect = NULL, temp;
-    SDL_Rect sdlrect;
-    int result;
+    if (format->BytesPerPixel != 3 && format->BytesPerPixel != 4)
+        return 0;
+    if (format->Rloss || format->Gloss || format->Bloss ||
+        format->Rshift % 8 || format->Gshift % 8 || format->Bshift % 8)
+        return 0;
+    if (format->Amask && (format->BytesPerPixel != 4 || format->Aloss ||
+                          format->Ashift % 8))
+        return 0;
+    return 1;
+}
 
-    if (!surf)
-        return RAISE(pgExc_SDLError, "display Surface quit");
-    if (PyTuple_Size(args)) {
-        item = PyTuple_GET_ITEM(args, 0);
-        if (item == Py_None && PyTuple_Size(args) == 1) {
-            result = SDL_SetClipRect(surf, NULL);
-        }
-        else {
-            rect = pgRect_FromObject(args, &temp);
-            if (!rect)
-                return RAISE(PyExc_ValueError, "invalid rectstyle object");
-            sdlrect.x = rect->x;
-            sdlrect.y = rect->y;
-            sdlrect.h = rect->h;
-            sdlrect.w = rect->w;
-            result = SDL_SetClipRect(surf, &sdlrect);
-        }
-    }
-    else {
-        result = SDL_SetClipRect(surf, NULL);
-    }
+/* Set up a swizzle from src to format if the conversion is just moving
+ * bytes around. Returns 0 when it has to go through SDL_ConvertSurface,
+ * such as for palettes, packed 16 bit pixels, color keys and RLE.
+ */
+static int
+_convert_swizzle_init(ConvertSwizzle *swizzle, SDL_Surface *src,
+                      SDL_PixelFormat *format)
+{
+    SDL_PixelFormat *srcformat = src->format;
+    SDL_BlendMode mode;
+    Uint32 key;
 
-    if (result == -1) {
-        return RAISE(pgExc_SDLError, SDL_GetError());
-    }
+    if (!_convert_format_is_bytes(srcformat) ||
+        !_convert_format_is_bytes(format))
+        return 0;
+    if (SDL_GetColorKey(src, &key) == 0 || (src->flags & SDL_RLEACCEL))
+        return 0;
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    if (SDL_HasSurfaceRLE(src))
+        return 0;
+#endif /* SDL_VERSION_ATLEAST(2, 0, 14) */
+    if (SDL_GetSurfaceBlendMode(src, &mode) ||
+        (mode != SDL_BLENDMODE_NONE && mode != SDL_BLENDMODE_BLEND))
+        return 0;
 
-    Py_RETURN_NONE;
+    swizzle->srcbpp = srcformat->BytesPerPixel;
+    swizzle->dstbpp = format->BytesPerPixel;
+    swizzle->srcshift[0] = srcformat->Rshift;
+    swizzle->srcshift[1] = srcformat->Gshift;
+    swizzle->srcshift[2] = srcformat->Bshift;
+    swizzle->dstshift[0] = format->Rshift;
+    swizzle->dstshift[1] = format->Gshift;
+    swizzle->dstshift[2] = format->Bshift;
+    swizzle->nchannels = 3;
+    swizzle->alpha = 0;
+    if (srcformat->Amask && format->Amask) {
+        swizzle->srcshift[3] = srcformat->Ashift;
+        swizzle->dstshift[3] = format->Ashift;
+        swizzle->nchannels = 4;
+    }
+    else if (format->Amask) {
+        swizzle->alpha = format->Amask;
+    }
+    swizzle->same = swizzle->srcbpp == swizzle->dstbpp &&
+                    srcformat->Rmask == format->Rmask &&
+                    srcformat->Gmask == format->Gmask &&
+                    srcformat->Bmask == format->Bmask &&
+                    srcformat->Amask == format->Amask;
+    return 1;
 }
 
-static PyObject *
-surf_get_clip(PyObject *self, PyObject *_null)
+static PG_INLINE Uint32
+_convert_read_pixel(const Uint8 *pixel, int bpp)
 {
-    SDL_Surface *surf = pgSurface_AsSurface(self);
+    if (bpp == 4)
+        return *(const Uint32 *)pixel;
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    return pixel[0] | (pixel[1] << 8) | ((Uint32)pixel[2] << 16);
+#else
+    return ((Uint32)pixel[0] << 16) | (pixel[1] << 8) | pixel[2];
+#endif
+}
 
-    if (!surf)
-        return RAISE(pgExc_SDLError, "display Surface quit");
-    return pgRect_New(&surf->clip_rect);
+static PG_INLINE void
+_convert_write_pixel(Uint8 *pixel, int bpp, Uint32 value)
+{
+    if (bpp == 4) {
+        *(Uint32 *)pixel = value;
+        return;
+    }
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    pixel[0] = (Uint8)value;
+    pixel[1] = (Uint8)(value >> 8);
+    pixel[2] = (Uint8)(value >> 16);
+#else
+    pixel[0] = (Uint8)(value >> 16);
+    pixel[1] = (Uint8)(value >> 8);
+    pixel[2] = (Uint8)value;
+#endif
 }
 
-static PyObject *
-surf_fill(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
+/* Whether the 32 bit swizzle can use SSE2 or NEON */
+static int
+_convert_use_simd(void)
 {
-    SDL_Surface *surf = pgSurface_AsSurface(self);
-    SDL_Rect *rect, temp;
-    PyObject *r = NULL;
-    Uint32 color;
-    int result;
-    PyObject *rgba_obj;
-    Uint8 rgba[4];
-    SDL_Rect sdlrect;
-    int blendargs = 0;
+#if defined(SURFACE_SIMD) && defined(PG_ENABLE_ARM_NEON)
+    return pg_HasNEON();
+#elif defined(SURFACE_SIMD)
+    return pg_HasSSE2();
+#else
+    return 0;
+#endif
+}
 
-    static char *kwids[] = {"color", "rect", "special_flags", NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|Oi", kwids, &rgba_obj,
+#ifdef SURFACE_SIMD
+/* 32 to 32 bit swizzle of four pixels at a time, by shifting each channel
+ * down to the low byte, masking it and shifting it up into place */
+static int
+_convert_swizzle_row32_sse2(const ConvertSwizzle *swizzle, const Uint8 *src,
+                            Uint8 *dst, int width)
+{
+    __m128i mbyte = _mm_set1_epi32(0xff);
+    __m128i malpha = _mm_set1_epi32(swizzle->alpha);
+    __m128i srcshift[4], dstshift[4];
+    int x, c;
+
+    for (c = 0; c < swizzle->nchannels; c++) {
+        srcshift[c] = _mm_cvtsi32_si128(swizzle->srcshift[c]);
+        dstshift[c] = _mm_cvtsi32_si128(swizzle->dstshift[c]);
+    }
+    for (x = 0; x + 4 <= width; x += 4) {
+        __m128i pixels = _mm_loadu_si128((const __m128i *)(src + x * 4));
+        __m128i out = malpha;
+
+        for (c = 0; c < swizzle->nchannels; c++) {
+            out = _mm_or_si128(
+                out, _mm_sll_epi32(_mm_and_si128(_mm_srl_epi32(
+                                                     pixels, srcshift[c]),
+                                                 mbyte),
+                                   dstshift[c]));
+        }
+        _mm_storeu_si128((__m128i *)(dst + x * 4), out);
+    }
+    return x;
+}
+#endif /* SURFACE_SIMD */
+
+/* Unused bytes of the destination are cleared, as SDL's blitters do,
+ * unless the formats are the same and the rows are simply copied. */
+static void
+_convert_swizzle(const ConvertSwizzle *swizzle, SDL_Surface *src,
+                 SDL_Surface *dst)
+{
+    int srcbpp = swizzle->srcbpp, dstbpp = swizzle->dstbpp;
+    int x, y, c;
+
+    for (y = 0; y < src->h; y++) {
+        const Uint8 *srcrow = (Uint8 *)src->pixels + (size_t)y * src->pitch;
+        Uint8 *dstrow = (Uint8 *)dst->pixels + (size_t)y * dst->pitch;
+
+        if (swizzle->same) {
+            memcpy(dstrow, srcrow, (size_t)src->w * srcbpp);
+            continue;
+        }
+        x = 0;
+#ifdef SURFACE_SIMD
+        if (srcbpp == 4 && dstbpp == 4 && _convert_use_simd())
+            x = _convert_swizzle_row32_sse2(swizzle, srcrow, dstrow, src->w);
+#endif /* SURFACE_SIMD */
+        for (; x < src->w; x++) {
+            Uint32 value = _convert_read_pixel(srcrow + x * srcbpp, srcbpp);
+            Uint32 out = swizzle->alpha;
+
+            for (c = 0; c < swizzle->nchannels; c++) {
+                out |= ((value >> swizzle->srcshift[c]) & 0xff)
+                       << swizzle->dstshift[c];
+            }
+            _convert_write_pixel(dstrow + x * dstbpp, dstbpp, out);
+        }
+    }
+}
+
+/* SDL_ConvertSurface(src, format, 0), with byte swizzles done here. The
+ * new surface gets the same modulation, blend mode and clip rect SDL
+ * would give it. Safe to call from a worker thread for distinct sources.
+ */
+static SDL_Surface *
+_convert_surface(SDL_Surface *src, SDL_PixelFormat *format)
+{
+    ConvertSwizzle swizzle;
+    SDL_Surface *dst;
+    Uint8 r, g, b, a;
+
+    if (!_convert_swizzle_init(&swizzle, src, format))
+        return SDL_ConvertSurface(src, format, 0);
+
+    dst = SDL_CreateRGBSurface(0, src->w, src->h, format->BitsPerPixel,
+                               format->Rmask, format->Gmask, format->Bmask,
+                               format->Amask);
+    if (!dst)
+        return NULL;
+    if (src->w && src->h)
+        _convert_swizzle(&swizzle, src, dst);
+
+    SDL_GetSurfaceColorMod(src, &r, &g, &b);
+    SDL_SetSurfaceColorMod(dst, r, g, b);
+    SDL_GetSurfaceAlphaMod(src, &a);
+    SDL_SetSurfaceAlphaMod(dst, a);
+    SDL_SetSurfaceBlendMode(dst, (src->format->Amask && format->Amask) ||
+                                         a != SDL_ALPHA_OPAQUE
+                                     ? SDL_BLENDMODE_BLEND
+                                     : SDL_BLENDMODE_NONE);
+    SDL_SetClipRect(dst, &src->clip_rect);
+    return dst;
+}
+
+typedef struct {
+    pgSurfaceObject *surfobj;
+    SDL_Surface *src;
+    SDL_Surface *dst;
+    int serial; /* the same surface appears earlier in the list */
+    int has_colorkey;
+    Uint8 key[4];
+    char error[128];
+} ConvertJob;
+
+typedef struct {
+    ConvertJob *jobs;
+    SDL_PixelFormat *format;
+} ConvertManyPass;
+
+static void
+convert_many_job(void *data, int index, int count)
+{
+    ConvertManyPass *pass = (ConvertManyPass *)data;
+    ConvertJob *job = pass->jobs + index;
+
+    if (job->serial)
+        return;
+    job->dst = _convert_surface(job->src, pass->format);
+    if (!job->dst)
+        SDL_strlcpy(job->error, SDL_GetError(), sizeof(job->error));
+}
+
+static int
+_compare_job_sources(const void *a, const void *b)
+{
+    const ConvertJob *joba = *(const ConvertJob *const *)a;
+    const ConvertJob *jobb = *(const ConvertJob *const *)b;
+
+    if (joba->src != jobb->src)
+        return joba->src < jobb->src ? -1 : 1;
+    return joba < jobb ? -1 : joba > jobb;
+}
+
+/* SDL_ConvertSurface updates the blit map of its source, so only the
+ * first job for each source runs on the pool; the rest run afterwards.
+ * Returns -1 if out of memory.
+ */
+static int
+_convert_mark_duplicates(ConvertJob *jobs, Py_ssize_t count)
+{
+    ConvertJob **order;
+    Py_ssize_t i;
+
+    if (count < 2)
+        return 0;
+    order = (ConvertJob **)PyMem_Malloc(sizeof(ConvertJob *) * count);
+    if (!order)
+        return -1;
+    for (i = 0; i < count; i++) {
+        order[i] = jobs + i;
+    }
+    qsort(order, count, sizeof(ConvertJob *), _compare_job_sources);
+    for (i = 1; i < count; i++) {
+        if (order[i]->src == order[i - 1]->src)
+            order[i]->serial = 1;
+    }
+    PyMem_Free(order);
+    return 0;
+}
+
+static PyObject *
+surf_convert_many(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *surfacesobj, *seq = NULL, *formatobj = Py_None;
+    PyObject *list = NULL, *final;
+    ConvertManyPass pass;
+    ConvertJob *jobs = NULL;
+    SDL_PixelFormat *allocformat = NULL;
+    Py_ssize_t count = 0, i;
+    long long pixels = 0;
+    int alpha = 0;
+    static char *keywords[] = {"surfaces", "format", "alpha", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|Op", keywords,
+                                     &surfacesobj, &formatobj, &alpha))
+        return NULL;
+
+    if (!SDL_WasInit(SDL_INIT_VIDEO))
+        return RAISE(pgExc_SDLError,
+                     "cannot convert without pygame.display initialized");
+
+    if (alpha && formatobj != Py_None)
+        return RAISE(PyExc_ValueError,
+                     "format can't be given when converting for alpha");
+    if (formatobj != Py_None && !pgSurface_Check(formatobj))
+        return RAISE(PyExc_TypeError, "format must be a Surface or None");
+
+    if (formatobj != Py_None) {
+        pass.format = pgSurface_AsSurface(formatobj)->format;
+    }
+    else if (!pg_GetDefaultWindowSurface()) {
+        return RAISE(pgExc_SDLError, "No video mode has been set");
+    }
+    else if (alpha) {
+        Uint32 pfe = pg_DisplayFormatAlphaEnum();
+
+        if (pfe == SDL_PIXELFORMAT_UNKNOWN)
+            return RAISE(pgExc_SDLError, SDL_GetError());
+        allocformat = SDL_AllocFormat(pfe);
+        if (!allocformat)
+            return RAISE(pgExc_SDLError, SDL_GetError());
+        pass.format = allocformat;
+    }
+    else {
+        pass.format =
+            pgSurface_AsSurface(pg_GetDefaultWindowSurface())->format;
+    }
+
+    seq = PySequence_Fast(surfacesobj, "surfaces must be a sequence");
+    if (!seq)
+        goto end;
+    count = PySequence_Fast_GET_SIZE(seq);
+
+    jobs = (ConvertJob *)PyMem_Calloc(count ? count : 1, sizeof(ConvertJob));
+    if (!jobs) {
+        PyErr_NoMemory();
+        goto end;
+    }
+    for (i = 0; i < count; i++) {
+        PyObject *obj = PySequence_Fast_GET_ITEM(seq, i);
+
+        if (!pgSurface_Check(obj)) {
+            PyErr_SetString(PyExc_TypeError,
+                            "surfaces must only contain Surface objects");
+            goto end;
+        }
+        jobs[i].surfobj = (pgSurfaceObject *)obj;
+        jobs[i].src = pgSurface_AsSurface(obj);
+        if (!jobs[i].src) {
+            PyErr_SetString(pgExc_SDLError, "display Surface quit");
+            goto end;
+        }
+        if (!pgSurface_Unpack(jobs[i].src))
+            goto end;
+        pixels += (long long)jobs[i].src->w * jobs[i].src->h;
+    }
+    if (_convert_mark_duplicates(jobs, count)) {
+        PyErr_NoMemory();
+        goto end;
+    }
+
+    for (i = 0; i < count; i++) {
+        SDL_Surface *src = jobs[i].src;
+        Uint32 colorkey;
+
+        if (SDL_GetColorKey(src, &colorkey) == 0) {
+            ConvertJob *job = jobs + i;
+
+            job->has_colorkey = 1;
+            job->key[3] = 255;
+            if (SDL_ISPIXELFORMAT_ALPHA(src->format->format))
+                SDL_GetRGBA(colorkey, src->format, job->key, job->key + 1,
+                            job->key + 2, job->key + 3);
+            else
+                SDL_GetRGB(colorkey, src->format, job->key, job->key + 1,
+                           job->key + 2);
+        }
+        pgSurface_Prep(jobs[i].surfobj);
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    if (count > 1 && pixels >= PG_PARALLEL_MIN_PIXELS)
+        pg_ParallelFor(convert_many_job, &pass, (int)count);
+    else {
+        for (i = 0; i < count; i++) {
+            convert_many_job(&pass, (int)i, (int)count);
+        }
+    }
+    for (i = 0; i < count; i++) {
+        if (jobs[i].serial) {
+            jobs[i].serial = 0;
+            convert_many_job(&pass, (int)i, (int)count);
+        }
+    }
+    Py_END_ALLOW_THREADS;
+
+    for (i = 0; i < count; i++) {
+        pgSurface_Unprep(jobs[i].surfobj);
+    }
+
+    for (i = 0; i < count; i++) {
+        if (!jobs[i].dst) {
+            PyErr_SetString(pgExc_SDLError, jobs[i].error);
+            goto end;
+        }
+    }
+
+    list = PyList_New(count);
+    if (!list)
+        goto end;
+    for (i = 0; i < count; i++) {
+        ConvertJob *job = jobs + i;
+        SDL_Surface *newsurf = job->dst;
+
+        /* finish off as convert() and convert_alpha() would */
+        if (alpha)
+            SDL_SetSurfaceBlendMode(newsurf, SDL_BLENDMODE_BLEND);
+        else if (formatobj == Py_None)
+            SDL_SetSurfaceBlendMode(newsurf, SDL_BLENDMODE_NONE);
+        if (alpha || newsurf->format->Amask)
+            newsurf->flags |= job->src->flags & PG_SURF_PREMULTIPLIED;
+        if (job->has_colorkey && !alpha &&
+            SDL_SetColorKey(newsurf, SDL_TRUE,
+                            pg_map_rgba(newsurf, job->key[0], job->key[1],
+                                        job->key[2], job->key[3])) != 0) {
+            PyErr_SetString(pgExc_SDLError, SDL_GetError());
+            Py_CLEAR(list);
+            goto end;
+        }
+
+        final = surf_subtype_new(Py_TYPE(job->surfobj), newsurf, 1);
+        if (!final) {
+            Py_CLEAR(list);
+            goto end;
+        }
+        job->dst = NULL;
+        PyList_SET_ITEM(list, i, final);
+    }
+
+end:
+    if (jobs) {
+        for (i = 0; i < count; i++) {
+            if (jobs[i].dst)
+                SDL_FreeSurface(jobs[i].dst);
+        }
+        PyMem_Free(jobs);
+    }
+    Py_XDECREF(seq);
+    if (allocformat)
+        SDL_FreeFormat(allocformat);
+    return list;
+}
+
+static PyObject *
+surf_premul_alpha(pgSurfaceObject *self, PyObject *_null)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    SDL_PixelFormat *format;
+    SDL_Surface *newsurf;
+    PyObject *final;
+    Uint32 *row, *pixel, *end;
+    Uint32 px, r, g, b, a;
+    int y;
+
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    format = surf->format;
+    if (format->BytesPerPixel != 4 || !format->Amask) {
+        return RAISE(PyExc_ValueError,
+                     "premul_alpha only supported for 32 bit surfaces with "
+                     "per pixel alpha");
+    }
+
+    pgSurface_Prep(self);
+    newsurf = SDL_ConvertSurface(surf, format, 0);
+    pgSurface_Unprep(self);
+    if (!newsurf)
+        return RAISE(pgExc_SDLError, SDL_GetError());
+
+    /* a surface that is already premultiplied is just copied */
+    if (!(surf->flags & PG_SURF_PREMULTIPLIED)) {
+        format = newsurf->format;
+        row = (Uint32 *)newsurf->pixels;
+        for (y = 0; y < newsurf->h; ++y) {
+            end = row + newsurf->w;
+            for (pixel = row; pixel < end; ++pixel) {
+                px = *pixel;
+                r = (px & format->Rmask) >> format->Rshift;
+                g = (px & format->Gmask) >> format->Gshift;
+                b = (px & format->Bmask) >> format->Bshift;
+                a = (px & format->Amask) >> format->Ashift;
+                /* same rounding as Color.premul_alpha() */
+                *pixel = (px & format->Amask) |
+                         ((((r + 1) * a) >> 8) << format->Rshift) |
+                         ((((g + 1) * a) >> 8) << format->Gshift) |
+                         ((((b + 1) * a) >> 8) << format->Bshift);
+            }
+            row = (Uint32 *)((Uint8 *)row + newsurf->pitch);
+        }
+    }
+    newsurf->flags |= PG_SURF_PREMULTIPLIED;
+    SDL_SetSurfaceBlendMode(newsurf, SDL_BLENDMODE_BLEND);
+
+    final = surf_subtype_new(Py_TYPE(self), newsurf, 1);
+    if (!final)
+        SDL_FreeSurface(newsurf);
+    return final;
+}
+
+static PyObject *
+surf_set_clip(PyObject *self, PyObject *args)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    PyObject *item;
+    SDL_Rect *rect = NULL, temp;
+    SDL_Rect sdlrect;
+    int result;
+
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    if (PyTuple_Size(args)) {
+        item = PyTuple_GET_ITEM(args, 0);
+        if (item == Py_None && PyTuple_Size(args) == 1) {
+            result = SDL_SetClipRect(surf, NULL);
+        }
+        else {
+            rect = pgRect_FromObject(args, &temp);
+            if (!rect)
+                return RAISE(PyExc_ValueError, "invalid rectstyle object");
+            sdlrect.x = rect->x;
+            sdlrect.y = rect->y;
+            sdlrect.h = rect->h;
+            sdlrect.w = rect->w;
+            result = SDL_SetClipRect(surf, &sdlrect);
+        }
+    }
+    else {
+        result = SDL_SetClipRect(surf, NULL);
+    }
+
+    if (result == -1) {
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_clip(PyObject *self, PyObject *_null)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    return pgRect_New(&surf->clip_rect);
+}
+
+static PyObject *
+surf_fill(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    SDL_Rect *rect, temp;
+    PyObject *r = NULL;
+    Uint32 color;
+    int result;
+    PyObject *rgba_obj;
+    Uint8 rgba[4];
+    SDL_Rect sdlrect;
+    int blendargs = 0;
+
+    static char *kwids[] = {"color", "rect", "special_flags", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|Oi", kwids, &rgba_obj,
                                      &r, &blendargs))
         return NULL;
     if (!surf)
@@ -1811,6 +3130,8 @@ surf_fill(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
             return pgRect_New(&sdlrect);
         }
 
+        if (!pgSurface_Unshare(surf))
+            return NULL;
         if (blendargs != 0) {
             result = surface_fill_blend(surf, &sdlrect, color, blendargs);
         }
@@ -1823,16 +3144,75 @@ surf_fill(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
         }
         if (result == -1)
             return RAISE(pgExc_SDLError, SDL_GetError());
+        pgSurface_AddDamage(self, &sdlrect);
     }
     return pgRect_New(&sdlrect);
 }
 
+/* Resolve a blit source, a Surface or a SurfaceRegion, to the surface
+   object it reads and the area of that surface it covers.
+   Returns 0, or -1 if obj is neither. */
+static int
+surface_blit_source(PyObject *obj, pgSurfaceObject **srcobj,
+                    SDL_Rect *bounds)
+{
+    SDL_Surface *surf;
+    SDL_Rect whole;
+
+    if (pgSurface_Check(obj)) {
+        *srcobj = (pgSurfaceObject *)obj;
+    }
+    else if (pgSurfaceRegion_Check(obj) &&
+             ((pgSurfaceRegionObject *)obj)->surface) {
+        *srcobj = ((pgSurfaceRegionObject *)obj)->surface;
+    }
+    else {
+        return -1;
+    }
+    surf = pgSurface_AsSurface(*srcobj);
+    whole.x = whole.y = 0;
+    whole.w = surf ? surf->w : 0;
+    whole.h = surf ? surf->h : 0;
+    if ((PyObject *)*srcobj == obj) {
+        *bounds = whole;
+    }
+    else if (!SDL_IntersectRect(&((pgSurfaceRegionObject *)obj)->rect, &whole,
+                                bounds)) {
+        bounds->w = bounds->h = 0;
+    }
+    return 0;
+}
+
+/* Move area, given relative to a region, onto the region's surface and
+   clip it to bounds, the region's rect. What is cut off the top and left
+   moves the destination position, as SDL does at a surface's edges. */
+static void
+surface_region_area(const SDL_Rect *bounds, SDL_Rect *area, int *dx, int *dy)
+{
+    int x = area->x + bounds->x, y = area->y + bounds->y;
+    int right = MIN(x + area->w, bounds->x + bounds->w);
+    int bottom = MIN(y + area->h, bounds->y + bounds->h);
+
+    if (x < bounds->x) {
+        *dx += bounds->x - x;
+        x = bounds->x;
+    }
+    if (y < bounds->y) {
+        *dy += bounds->y - y;
+        y = bounds->y;
+    }
+    area->x = x;
+    area->y = y;
+    area->w = MAX(right - x, 0);
+    area->h = MAX(bottom - y, 0);
+}
+
 static PyObject *
 surf_blit(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
 {
     SDL_Surface *src, *dest = pgSurface_AsSurface(self);
-    SDL_Rect *src_rect, temp;
-    PyObject *argpos, *argrect = NULL;
+    SDL_Rect *src_rect, temp, bounds;
+    PyObject *srcarg, *argpos, *argrect = NULL;
     pgSurfaceObject *srcobject;
     int dx, dy, result;
     SDL_Rect dest_rect;
@@ -1840,11 +3220,13 @@ surf_blit(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
     int the_args = 0;
 
     static char *kwids[] = {"source", "dest", "area", "special_flags", NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O!O|Oi", kwids,
-                                     &pgSurface_Type, &srcobject, &argpos,
-                                     &argrect, &the_args))
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OO|Oi", kwids, &srcarg,
+                                     &argpos, &argrect, &the_args))
         return NULL;
 
+    if (surface_blit_source(srcarg, &srcobject, &bounds))
+        return RAISE(PyExc_TypeError,
+                     "source must be a Surface or a SurfaceRegion");
     src = pgSurface_AsSurface(srcobject);
     if (!dest || !src)
         return RAISE(pgExc_SDLError, "display Surface quit");
@@ -1863,11 +3245,14 @@ surf_blit(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
     if (argrect && argrect != Py_None) {
         if (!(src_rect = pgRect_FromObject(argrect, &temp)))
             return RAISE(PyExc_TypeError, "Invalid rectstyle argument");
+        if ((PyObject *)srcobject != srcarg) {
+            temp = *src_rect;
+            src_rect = &temp;
+            surface_region_area(&bounds, src_rect, &dx, &dy);
+        }
     }
     else {
-        temp.x = temp.y = 0;
-        temp.w = src->w;
-        temp.h = src->h;
+        temp = bounds;
         src_rect = &temp;
     }
 
@@ -1898,45 +3283,172 @@ surf_blit(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
 #define BLITS_ERR_PY_EXCEPTION_RAISED 9
 #define BLITS_ERR_SOURCE_NOT_SURFACE 10
 
-static PyObject *
-surf_blits(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
-{
-    SDL_Surface *src, *dest = pgSurface_AsSurface(self);
-    SDL_Rect *src_rect, temp;
-    PyObject *srcobject = NULL, *argpos = NULL, *argrect = NULL;
-    int dx, dy, result;
-    SDL_Rect dest_rect;
-    int sx, sy;
-    int the_args = 0;
+/* blits() gathers its items into groups of the same source, area and
+   flags, so the blitter is set up once per group rather than per item. An
+   item may join an earlier group only when it does not overlap anything in
+   the groups opened after that one, so the result is the same as blitting
+   the items in order. */
+#define BLITS_MAX_GROUPS 8
 
-    PyObject *blitsequence;
-    PyObject *iterator = NULL;
-    PyObject *item = NULL;
-    PyObject *special_flags = NULL;
-    PyObject *ret = NULL;
-    PyObject *retrect = NULL;
-    Py_ssize_t itemlength;
-    int doreturn = 1;
-    int bliterrornum = 0;
-    static char *kwids[] = {"blit_sequence", "doreturn", NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|i", kwids, &blitsequence,
-                                     &doreturn))
-        return NULL;
+typedef struct {
+    pgSurfaceObject *src; /* strong reference */
+    SDL_Rect area;
+    SDL_Rect bounds; /* of the destinations, for the overlap test */
+    int flags;
+} pgBlitsGroup;
 
-    if (doreturn) {
-        ret = PyList_New(0);
-        if (!ret)
-            return NULL;
-    }
-    if (!PyIter_Check(blitsequence) && !PySequence_Check(blitsequence)) {
-        bliterrornum = BLITS_ERR_SEQUENCE_REQUIRED;
-        goto bliterror;
-    }
-    iterator = PyObject_GetIter(blitsequence);
-    if (!iterator) {
-        Py_XDECREF(ret);
+typedef struct {
+    SDL_Rect dest; /* clipped to the area blitted once done */
+    int group;
+} pgBlitsItem;
+
+/* Blit the items of group g among items[first:last], resolving the source
+   shadow, the spans and the locks once for all of them.
+   Returns 0, or -1 with an exception set. */
+static int
+surface_blits_group(pgSurfaceObject *dstobj, pgBlitsGroup *group, int g,
+                    pgBlitsItem *items, Py_ssize_t first, Py_ssize_t last)
+{
+    pgSurfaceObject *srcobj = group->src;
+    SDL_Surface *src = pgSurface_AsSurface(srcobj);
+    pgBlitTarget target;
+    PyObject *spans, *shadow;
+    SDL_Rect srcrect;
+    Py_ssize_t i, done = first;
+    int result = 0;
+
+    if (!pgSurface_Unpack(src) ||
+        surface_get_shadow(srcobj, pgSurface_AsSurface(dstobj), group->flags,
+                           &shadow))
+        return -1;
+    if (!pgSurface_Unshare(pgSurface_AsSurface(dstobj))) {
+        Py_XDECREF(shadow);
+        return -1;
+    }
+    if (shadow)
+        src = SURFACE_SHADOW(shadow);
+    surface_blit_target_begin(dstobj, &target);
+    pgSurface_Prep(srcobj);
+    spans = surface_get_spans(src, target.surf,
+                              surface_blit_args(src, group->flags));
+
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = first; i < last; ++i) {
+        if (items[i].group != g)
+            continue;
+        srcrect = group->area;
+        items[i].dest.x += target.offsetx;
+        items[i].dest.y += target.offsety;
+        result = surface_blit_prepared(src, &srcrect, target.surf,
+                                       &items[i].dest, group->flags,
+                                       SURFACE_SPANS(spans));
+        items[i].dest.x -= target.offsetx;
+        items[i].dest.y -= target.offsety;
+        if (result != 0)
+            break;
+        done = i + 1;
+    }
+    Py_END_ALLOW_THREADS;
+
+    Py_XDECREF(spans);
+    Py_XDECREF(shadow);
+    surface_blit_target_end(dstobj, &target);
+    pgSurface_Unprep(srcobj);
+
+    for (i = first; i < done; ++i) {
+        if (items[i].group == g)
+            pgSurface_AddDamage(dstobj, &items[i].dest);
+    }
+    if (result == -1)
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+    if (result == -2)
+        PyErr_SetString(pgExc_SDLError, "Surface was lost");
+    return result != 0 ? -1 : 0;
+}
+
+/* Blit the pending groups in the order they were opened and release them.
+   Returns 0, or -1 with an exception set. */
+static int
+surface_blits_flush(pgSurfaceObject *dstobj, pgBlitsGroup *groups,
+                    int *ngroups, pgBlitsItem *items, Py_ssize_t first,
+                    Py_ssize_t last)
+{
+    int g, result = 0;
+
+    for (g = 0; g < *ngroups; ++g) {
+        if (result == 0)
+            result =
+                surface_blits_group(dstobj, &groups[g], g, items, first, last);
+        Py_DECREF(groups[g].src);
+    }
+    *ngroups = 0;
+    return result;
+}
+
+/* The group an item of src, area and flags blitted to dest goes in: the
+   newest matching group it can move back to without passing a group it
+   overlaps, or else a new group. Returns -1 when a new group is needed
+   but there is no room for one. */
+static int
+surface_blits_find_group(pgBlitsGroup *groups, int ngroups,
+                         pgSurfaceObject *src, const SDL_Rect *area,
+                         const SDL_Rect *dest, int flags)
+{
+    int g;
+
+    for (g = ngroups - 1; g >= 0; --g) {
+        if (groups[g].src == src && groups[g].flags == flags &&
+            groups[g].area.x == area->x && groups[g].area.y == area->y &&
+            groups[g].area.w == area->w && groups[g].area.h == area->h)
+            return g;
+        if (SDL_HasIntersection(&groups[g].bounds, dest))
+            break;
+    }
+    return ngroups < BLITS_MAX_GROUPS ? ngroups : -1;
+}
+
+static PyObject *
+surf_blits(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
+{
+    SDL_Surface *src, *dest = pgSurface_AsSurface(self);
+    SDL_Rect *src_rect, temp, bounds;
+    PyObject *srcobject = NULL, *argpos = NULL, *argrect = NULL;
+    pgSurfaceObject *srcsurf;
+    int dx, dy, g, selfblit;
+    SDL_Rect dest_rect;
+    int sx, sy;
+    int the_args = 0;
+
+    PyObject *blitsequence;
+    PyObject *iterator = NULL;
+    PyObject *item = NULL;
+    PyObject *special_flags = NULL;
+    PyObject *ret = NULL;
+    PyObject *retrect = NULL;
+    Py_ssize_t itemlength;
+    int doreturn = 1;
+    int bliterrornum = 0;
+    /* Python code run by a generator could change the surfaces between
+       items, so only the items of a list or tuple are held back */
+    int defer;
+    pgBlitsGroup groups[BLITS_MAX_GROUPS];
+    int ngroups = 0;
+    pgBlitsItem *items = NULL, *grown;
+    Py_ssize_t nitems = 0, maxitems = 0, first = 0, i;
+    PyObject *errtype, *errvalue, *errtraceback;
+    static char *kwids[] = {"blit_sequence", "doreturn", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|i", kwids, &blitsequence,
+                                     &doreturn))
         return NULL;
+
+    if (!PyIter_Check(blitsequence) && !PySequence_Check(blitsequence)) {
+        bliterrornum = BLITS_ERR_SEQUENCE_REQUIRED;
+        goto bliterror;
     }
+    defer = PyList_CheckExact(blitsequence) || PyTuple_CheckExact(blitsequence);
+    iterator = PyObject_GetIter(blitsequence);
+    if (!iterator)
+        return NULL;
 
     while ((item = PyIter_Next(iterator))) {
         if (PySequence_Check(item)) {
@@ -1974,12 +3486,12 @@ surf_blits(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
         /* Clear item to avoid double deref on errors */
         item = NULL;
 
-        if (!pgSurface_Check(srcobject)) {
+        if (surface_blit_source(srcobject, &srcsurf, &bounds)) {
             bliterrornum = BLITS_ERR_SOURCE_NOT_SURFACE;
             goto bliterror;
         }
 
-        src = pgSurface_AsSurface(srcobject);
+        src = pgSurface_AsSurface(srcsurf);
         if (!dest) {
             bliterrornum = BLITS_ERR_DISPLAY_SURF_QUIT;
             goto bliterror;
@@ -2006,11 +3518,14 @@ surf_blits(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
                 bliterrornum = BLITS_ERR_INVALID_RECT_STYLE;
                 goto bliterror;
             }
+            if ((PyObject *)srcsurf != srcobject) {
+                temp = *src_rect;
+                src_rect = &temp;
+                surface_region_area(&bounds, src_rect, &dx, &dy);
+            }
         }
         else {
-            temp.x = temp.y = 0;
-            temp.w = src->w;
-            temp.h = src->h;
+            temp = bounds;
             src_rect = &temp;
         }
 
@@ -2026,24 +3541,49 @@ surf_blits(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
             }
         }
 
-        result = pgSurface_Blit(self, (pgSurfaceObject *)srcobject, &dest_rect,
-                                src_rect, the_args);
-
-        if (result != 0) {
-            bliterrornum = BLITS_ERR_BLIT_FAIL;
-            goto bliterror;
+        if (nitems == maxitems) {
+            maxitems = maxitems ? maxitems * 2 : 64;
+            grown = PyMem_Resize(items, pgBlitsItem, maxitems);
+            if (!grown) {
+                PyErr_NoMemory();
+                bliterrornum = BLITS_ERR_PY_EXCEPTION_RAISED;
+                goto bliterror;
+            }
+            items = grown;
         }
 
-        if (doreturn) {
-            retrect = NULL;
-            retrect = pgRect_New(&dest_rect);
-            if (PyList_Append(ret, retrect) != 0) {
-                bliterrornum = BLITS_ERR_PY_EXCEPTION_RAISED;
+        /* blits of a surface onto itself read what earlier items wrote */
+        selfblit = surface_pixels_overlap(src, dest);
+        if (selfblit)
+            g = -1;
+        else
+            g = surface_blits_find_group(groups, ngroups, srcsurf, src_rect,
+                                         &dest_rect, the_args);
+        if (g < 0 && ngroups) {
+            if (surface_blits_flush(self, groups, &ngroups, items, first,
+                                    nitems)) {
+                bliterrornum = BLITS_ERR_BLIT_FAIL;
                 goto bliterror;
             }
-            Py_DECREF(retrect);
-            retrect = NULL; /* Clear to avoid double deref on errors */
+            first = nitems;
+            if (!doreturn)
+                first = nitems = 0;
+        }
+        if (g < 0 || g == ngroups) {
+            g = ngroups++;
+            Py_INCREF(srcsurf);
+            groups[g].src = srcsurf;
+            groups[g].area = *src_rect;
+            groups[g].bounds = dest_rect;
+            groups[g].flags = the_args;
+        }
+        else {
+            SDL_UnionRect(&groups[g].bounds, &dest_rect, &groups[g].bounds);
         }
+        items[nitems].dest = dest_rect;
+        items[nitems].group = g;
+        ++nitems;
+
         Py_DECREF(srcobject);
         Py_DECREF(argpos);
         Py_XDECREF(argrect);
@@ -2053,30 +3593,75 @@ surf_blits(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
         argpos = NULL;
         argrect = NULL;
         special_flags = NULL;
+
+        if (!defer || selfblit) {
+            if (surface_blits_flush(self, groups, &ngroups, items, first,
+                                    nitems)) {
+                bliterrornum = BLITS_ERR_BLIT_FAIL;
+                goto bliterror;
+            }
+            first = nitems;
+            if (!doreturn)
+                first = nitems = 0;
+        }
     }
 
     Py_DECREF(iterator);
+    iterator = NULL;
     if (PyErr_Occurred()) {
-        Py_XDECREF(ret);
-        return NULL;
+        bliterrornum = BLITS_ERR_PY_EXCEPTION_RAISED;
+        goto bliterror;
     }
-
-    if (doreturn) {
-        return ret;
+    if (surface_blits_flush(self, groups, &ngroups, items, first, nitems)) {
+        bliterrornum = BLITS_ERR_BLIT_FAIL;
+        goto bliterror;
     }
-    else {
+
+    if (!doreturn) {
+        PyMem_Free(items);
         Py_RETURN_NONE;
     }
+    ret = PyList_New(nitems);
+    if (!ret) {
+        PyMem_Free(items);
+        return NULL;
+    }
+    for (i = 0; i < nitems; ++i) {
+        retrect = pgRect_New(&items[i].dest);
+        if (!retrect) {
+            PyMem_Free(items);
+            Py_DECREF(ret);
+            return NULL;
+        }
+        PyList_SET_ITEM(ret, i, retrect);
+    }
+    PyMem_Free(items);
+    return ret;
 
 bliterror:
     Py_XDECREF(srcobject);
     Py_XDECREF(argpos);
     Py_XDECREF(argrect);
-    Py_XDECREF(retrect);
     Py_XDECREF(special_flags);
     Py_XDECREF(iterator);
     Py_XDECREF(item);
-    Py_XDECREF(ret);
+
+    /* the items before the failing one are still blitted, as they would be
+       one at a time */
+    if (ngroups) {
+        PyErr_Fetch(&errtype, &errvalue, &errtraceback);
+        if (surface_blits_flush(self, groups, &ngroups, items, first,
+                                nitems) == 0) {
+            PyErr_Restore(errtype, errvalue, errtraceback);
+        }
+        else {
+            Py_XDECREF(errtype);
+            Py_XDECREF(errvalue);
+            Py_XDECREF(errtraceback);
+            bliterrornum = BLITS_ERR_BLIT_FAIL;
+        }
+    }
+    PyMem_Free(items);
 
     switch (bliterrornum) {
         case BLITS_ERR_SEQUENCE_REQUIRED:
@@ -2100,121 +3685,860 @@ bliterror:
         case BLITS_ERR_PY_EXCEPTION_RAISED:
             return NULL; /* Raising a previously set exception */
         case BLITS_ERR_SOURCE_NOT_SURFACE:
-            return RAISE(PyExc_TypeError, "Source objects must be a surface");
+            return RAISE(PyExc_TypeError,
+                         "Source objects must be a surface or a region");
     }
     return RAISE(PyExc_TypeError, "Unknown error");
 }
 
-static PyObject *
-surf_scroll(PyObject *self, PyObject *args, PyObject *keywds)
+/* Accept only native 32 bit signed integer buffer formats. */
+static int
+_is_int32_format(const char *format, Py_ssize_t itemsize)
 {
-    int dx = 0, dy = 0;
-    SDL_Surface *surf;
-    int bpp;
-    int pitch;
-    SDL_Rect *clip_rect;
-    int w, h;
-    Uint8 *src, *dst;
+    if (itemsize != 4)
+        return 0;
+    if (!format)
+        return 0;
+    switch (*format) {
+        case '@':
+        case '=':
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        case '<':
+#else
+        case '>':
+        case '!':
+#endif
+            ++format;
+            break;
+    }
+    return (format[0] == 'i' || format[0] == 'l') && format[1] == '\0';
+}
 
-    static char *kwids[] = {"dx", "dy", NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, keywds, "|ii", kwids, &dx, &dy)) {
-        return NULL;
+/* Get a C contiguous int32 buffer holding a whole number of records of
+   stride ints. When count is not negative the buffer must hold exactly
+   count records. Returns the record count, or -1 with an exception set. */
+static Py_ssize_t
+_get_int32_records(PyObject *obj, Py_buffer *view, int stride,
+                   Py_ssize_t count, const char *name)
+{
+    Py_ssize_t length;
+
+    if (PyObject_GetBuffer(obj, view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) !=
+        0)
+        return -1;
+    if (!_is_int32_format(view->format, view->itemsize)) {
+        PyBuffer_Release(view);
+        PyErr_Format(PyExc_TypeError,
+                     "%s must be a buffer of 32 bit integers", name);
+        return -1;
     }
+    length = view->len / view->itemsize;
+    if (length % stride != 0) {
+        PyBuffer_Release(view);
+        PyErr_Format(PyExc_ValueError, "%s must hold groups of %d values",
+                     name, stride);
+        return -1;
+    }
+    if (count >= 0 && length / stride != count) {
+        PyBuffer_Release(view);
+        PyErr_Format(PyExc_ValueError, "%s must hold %zd records", name,
+                     count);
+        return -1;
+    }
+    return length / stride;
+}
 
-    surf = pgSurface_AsSurface(self);
-    if (!surf) {
-        return RAISE(pgExc_SDLError, "display Surface quit");
+/* Whether a w by h blit at (x, y), moved by the target offsets, misses
+   the target surface. It is worked out in 64 bits, so positions from a
+   buffer that would overflow an int once moved or clipped are skipped
+   before SDL sees them. */
+static PG_INLINE int
+surface_blit_misses(const pgBlitTarget *target, int x, int y, int w, int h)
+{
+    Sint64 left = (Sint64)x + target->offsetx;
+    Sint64 top = (Sint64)y + target->offsety;
+
+    return left >= target->surf->w || top >= target->surf->h ||
+           left + w <= 0 || top + h <= 0;
+}
+
+/* Blit the area of srcobj at count (x, y) positions. When the area is
+   all of srcobj and the blit takes the pygame_Blit route the blitter is
+   resolved once for the whole batch, otherwise each position goes through
+   surface_blit_prepared().
+   Returns 0, or -1 with an exception set. */
+static int
+surface_blit_positions(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
+                       const SDL_Rect *area, const int *positions,
+                       Py_ssize_t count, int the_args)
+{
+    SDL_Surface *src = pgSurface_AsSurface(srcobj);
+    SDL_Surface *dst = pgSurface_AsSurface(dstobj);
+    pgBlitTarget target;
+    SDL_Rect srcrect, dstrect;
+    PyObject *spans;
+    Py_ssize_t i;
+    int result = 0;
+
+    if (!pgSurface_Unpack(src) || !pgSurface_Unshare(dst))
+        return -1;
+    the_args = surface_blit_args(src, the_args);
+    spans = surface_get_spans(src, dst, the_args);
+    if (area->x == 0 && area->y == 0 && area->w == src->w &&
+        area->h == src->h && !surface_pixels_overlap(src, dst) &&
+        ((the_args != 0 && the_args != PYGAME_BLEND_ALPHA_SDL2) ||
+         surface_blit_pygame_alpha(src, dst, the_args) ||
+         surface_blit_pygame_palette(src, dst, the_args))) {
+        /* A subsurface shares the pixels of its owner, so it can be the
+           direct target once the owner is locked by pgSurface_Prep. */
+        pgSurface_Prep(dstobj);
+        pgSurface_Prep(srcobj);
+        Py_BEGIN_ALLOW_THREADS;
+        result = pygame_BlitMany(src, dst, positions, count, the_args,
+                                 SURFACE_SPANS(spans));
+        Py_END_ALLOW_THREADS;
+        pgSurface_Unprep(dstobj);
+        pgSurface_Unprep(srcobj);
     }
+    else {
+        surface_blit_target_begin(dstobj, &target);
+        pgSurface_Prep(srcobj);
+        Py_BEGIN_ALLOW_THREADS;
+        for (i = 0; i < count && result == 0; ++i) {
+            if (surface_blit_misses(&target, positions[2 * i],
+                                    positions[2 * i + 1], area->w, area->h))
+                continue;
+            srcrect = *area;
+            dstrect.x = positions[2 * i] + target.offsetx;
+            dstrect.y = positions[2 * i + 1] + target.offsety;
+            dstrect.w = area->w;
+            dstrect.h = area->h;
+            result = surface_blit_prepared(src, &srcrect, target.surf,
+                                           &dstrect, the_args,
+                                           SURFACE_SPANS(spans));
+        }
+        Py_END_ALLOW_THREADS;
+        surface_blit_target_end(dstobj, &target);
+        pgSurface_Unprep(srcobj);
+    }
+    Py_XDECREF(spans);
 
-    if (dx == 0 && dy == 0) {
-        Py_RETURN_NONE;
+    if (result == -1)
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+    if (result == -2)
+        PyErr_SetString(pgExc_SDLError, "Surface was lost");
+    if (result != 0)
+        return -1;
+
+    if (damage_trackers) {
+        dstrect.w = area->w;
+        dstrect.h = area->h;
+        for (i = 0; i < count; ++i) {
+            dstrect.x = positions[2 * i];
+            dstrect.y = positions[2 * i + 1];
+            pgSurface_AddDamage(dstobj, &dstrect);
+        }
     }
+    return 0;
+}
 
-    clip_rect = &surf->clip_rect;
-    w = clip_rect->w;
-    h = clip_rect->h;
-    if (dx >= w || dx <= -w || dy >= h || dy <= -h) {
+#define FBLITS_ERR_INDEX 1
+
+static PyObject *
+surf_fblits(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
+{
+    SDL_Surface *dest = pgSurface_AsSurface(self);
+    SDL_Surface **srcs = NULL;
+    pgSurfaceObject **srcobjs = NULL, *srcobj;
+    SDL_Rect *areas = NULL;
+    PyObject **spans = NULL;
+    PyObject *sources, *positions, *seq = NULL, **items;
+    Py_buffer view;
+    Py_ssize_t nsources, nrecords, ndone, nheld = 0, i;
+    pgBlitTarget target;
+    SDL_Rect srcrect, dstrect;
+    const int *rec;
+    int index, result = 0, err = 0;
+    int the_args = 0;
+
+    static char *kwids[] = {"sources", "positions", "special_flags", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OO|i", kwids, &sources,
+                                     &positions, &the_args))
+        return NULL;
+
+    if (!dest)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    if (!pgSurface_Unshare(dest))
+        return NULL;
+
+    if (surface_blit_source(sources, &srcobj, &srcrect) == 0) {
+        if (!pgSurface_AsSurface(srcobj))
+            return RAISE(pgExc_SDLError, "display Surface quit");
+        nrecords = _get_int32_records(positions, &view, 2, -1, "positions");
+        if (nrecords < 0)
+            return NULL;
+        /* a region could be given another surface while the GIL is
+           released, so the source is held here */
+        Py_INCREF(srcobj);
+        result = surface_blit_positions(self, srcobj, &srcrect,
+                                        (const int *)view.buf, nrecords,
+                                        the_args);
+        Py_DECREF(srcobj);
+        PyBuffer_Release(&view);
+        if (result)
+            return NULL;
         Py_RETURN_NONE;
     }
 
-    if (!pgSurface_Lock((pgSurfaceObject *)self)) {
+    seq = PySequence_Fast(sources,
+                          "sources must be a Surface or a sequence of "
+                          "Surfaces");
+    if (!seq)
         return NULL;
+    nsources = PySequence_Fast_GET_SIZE(seq);
+    items = PySequence_Fast_ITEMS(seq);
+
+    srcs = PyMem_New(SDL_Surface *, nsources ? nsources : 1);
+    srcobjs = PyMem_New(pgSurfaceObject *, nsources ? nsources : 1);
+    areas = PyMem_New(SDL_Rect, nsources ? nsources : 1);
+    spans = PyMem_New(PyObject *, nsources ? nsources : 1);
+    if (!srcs || !srcobjs || !areas || !spans) {
+        PyErr_NoMemory();
+        goto fail;
     }
-
-    bpp = surf->format->BytesPerPixel;
-    pitch = surf->pitch;
-    src = dst =
-        (Uint8 *)surf->pixels + clip_rect->y * pitch + clip_rect->x * bpp;
-    if (dx >= 0) {
-        w -= dx;
-        if (dy > 0) {
-            h -= dy;
-            dst += dy * pitch + dx * bpp;
+    /* The items of a list are borrowed, and the list or a region could be
+       changed by another thread while the GIL is released, so each source
+       surface is held until the blits are done. */
+    for (i = 0; i < nsources; ++i) {
+        if (surface_blit_source(items[i], &srcobjs[i], &areas[i])) {
+            PyErr_SetString(PyExc_TypeError,
+                            "Source objects must be a surface or a region");
+            goto fail;
         }
-        else {
-            h += dy;
-            src -= dy * pitch;
-            dst += dx * bpp;
+        Py_INCREF(srcobjs[i]);
+        nheld = i + 1;
+        if (!pgSurface_AsSurface(srcobjs[i])) {
+            PyErr_SetString(pgExc_SDLError, "display Surface quit");
+            goto fail;
         }
+        if (!pgSurface_Unpack(pgSurface_AsSurface(srcobjs[i])))
+            goto fail;
     }
-    else {
-        w += dx;
-        if (dy > 0) {
-            h -= dy;
-            src -= dx * bpp;
-            dst += dy * pitch;
-        }
-        else {
-            h += dy;
-            src -= dy * pitch + dx * bpp;
+
+    nrecords = _get_int32_records(positions, &view, 3, -1, "records");
+    if (nrecords < 0)
+        goto fail;
+
+    /* Resolve and lock everything once up front, so the loop below needs
+       neither the GIL nor any per item Python work. */
+    surface_blit_target_begin(self, &target);
+    for (i = 0; i < nsources; ++i) {
+        srcs[i] = pgSurface_AsSurface(srcobjs[i]);
+        pgSurface_Prep(srcobjs[i]);
+        spans[i] = surface_get_spans(srcs[i], target.surf,
+                                     surface_blit_args(srcs[i], the_args));
+    }
+
+    rec = (const int *)view.buf;
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < nrecords; ++i, rec += 3) {
+        SDL_Surface *src;
+
+        index = rec[0];
+        if (index < 0 || index >= nsources) {
+            err = FBLITS_ERR_INDEX;
+            break;
         }
+        src = srcs[index];
+        srcrect = areas[index];
+        if (surface_blit_misses(&target, rec[1], rec[2], srcrect.w,
+                                srcrect.h))
+            continue;
+        dstrect.x = rec[1] + target.offsetx;
+        dstrect.y = rec[2] + target.offsety;
+        dstrect.w = srcrect.w;
+        dstrect.h = srcrect.h;
+        result = surface_blit_prepared(src, &srcrect, target.surf, &dstrect,
+                                       the_args, SURFACE_SPANS(spans[index]));
+        if (result != 0)
+            break;
     }
-    surface_move(src, dst, h, w * bpp, pitch, pitch);
+    Py_END_ALLOW_THREADS;
+    ndone = i;
 
-    if (!pgSurface_Unlock((pgSurfaceObject *)self)) {
-        return NULL;
+    for (i = 0; i < nsources; ++i) {
+        Py_XDECREF(spans[i]);
+        pgSurface_Unprep(srcobjs[i]);
+        Py_DECREF(srcobjs[i]);
+    }
+    surface_blit_target_end(self, &target);
+
+    if (damage_trackers) {
+        rec = (const int *)view.buf;
+        for (i = 0; i < ndone; ++i, rec += 3) {
+            dstrect.x = rec[1];
+            dstrect.y = rec[2];
+            dstrect.w = areas[rec[0]].w;
+            dstrect.h = areas[rec[0]].h;
+            pgSurface_AddDamage(self, &dstrect);
+        }
     }
 
+    PyMem_Free(srcs);
+    PyMem_Free(srcobjs);
+    PyMem_Free(areas);
+    PyMem_Free(spans);
+    PyBuffer_Release(&view);
+    Py_DECREF(seq);
+
+    if (err == FBLITS_ERR_INDEX)
+        return RAISE(PyExc_IndexError, "source index out of range");
+    if (result == -1)
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    if (result == -2)
+        return RAISE(pgExc_SDLError, "Surface was lost");
     Py_RETURN_NONE;
+
+fail:
+    for (i = 0; i < nheld; ++i)
+        Py_DECREF(srcobjs[i]);
+    PyMem_Free(srcs);
+    PyMem_Free(srcobjs);
+    PyMem_Free(areas);
+    PyMem_Free(spans);
+    Py_DECREF(seq);
+    return NULL;
 }
 
-int
-pg_HasSurfaceRLE(SDL_Surface *surface)
+static PyObject *
+surf_get_at_many(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
 {
-    pg_BlitMap *blit_map;
-    /* this is part of a hack to allow us to access
-       the COPY_RLE_DESIRED flag from pygame */
-    if (!surface) {
-        return SDL_FALSE;
-    }
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    PyObject *coords, *mapped, *arraymod, *result;
+    Py_buffer view;
+    Py_ssize_t count, i;
+    const int *xy;
+    Sint32 *out;
+    int bad = 0;
+
+    static char *kwids[] = {"coords", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O", kwids, &coords))
+        return NULL;
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    if (surf->format->BytesPerPixel < 1 || surf->format->BytesPerPixel > 4)
+        return RAISE(PyExc_RuntimeError, "invalid color depth for surface");
 
-    blit_map = (pg_BlitMap *)surface->map;
+    count = _get_int32_records(coords, &view, 2, -1, "coords");
+    if (count < 0)
+        return NULL;
+    mapped = PyBytes_FromStringAndSize(NULL, count * sizeof(Sint32));
+    if (!mapped) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    if (!pgSurface_LockRead(self)) {
+        PyBuffer_Release(&view);
+        Py_DECREF(mapped);
+        return NULL;
+    }
 
-    if (!(blit_map->info.flags & PGS_COPY_RLE_DESIRED)) {
-        return SDL_FALSE;
+    xy = (const int *)view.buf;
+    out = (Sint32 *)PyBytes_AS_STRING(mapped);
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < count; ++i, xy += 2) {
+        if (xy[0] < 0 || xy[0] >= surf->w || xy[1] < 0 || xy[1] >= surf->h) {
+            bad = 1;
+            break;
+        }
+        out[i] = (Sint32)_surf_read_mapped(surf, xy[0], xy[1]);
     }
+    Py_END_ALLOW_THREADS;
 
-    return SDL_TRUE;
-}
+    PyBuffer_Release(&view);
+    if (!pgSurface_UnlockRead(self) || bad) {
+        Py_DECREF(mapped);
+        return bad ? RAISE(PyExc_IndexError, "pixel index out of range")
+                   : NULL;
+    }
 
-static int
-_PgSurface_SrcAlpha(SDL_Surface *surf)
-{
-    SDL_BlendMode mode;
-    if (SDL_GetSurfaceBlendMode(surf, &mode) < 0) {
-        PyErr_SetString(pgExc_SDLError, SDL_GetError());
-        return -1;
+    /* array.array("i", bytes) takes the values without making an int for
+       each of them */
+    arraymod = PyImport_ImportModule("array");
+    if (!arraymod) {
+        Py_DECREF(mapped);
+        return NULL;
     }
-    return (mode != SDL_BLENDMODE_NONE);
+    result = PyObject_CallMethod(arraymod, "array", "sO", "i", mapped);
+    Py_DECREF(arraymod);
+    Py_DECREF(mapped);
+    return result;
 }
 
 static PyObject *
-surf_get_flags(PyObject *self, PyObject *_null)
+surf_set_at_many(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
 {
-    Uint32 sdl_flags = 0;
-    Uint32 window_flags = 0;
-    Uint32 flags = 0;
-    int is_alpha;
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    PyObject *coords, *colors;
+    Py_buffer view, colorview;
+    Py_ssize_t count, i;
+    SDL_Rect *clip;
+    const int *xy;
+    const Uint32 *mapped = NULL;
+    Uint32 color = 0;
+    Uint8 rgba[4] = {0, 0, 0, 0};
+    int per_pixel;
+
+    static char *kwids[] = {"coords", "colors", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OO", kwids, &coords,
+                                     &colors))
+        return NULL;
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    if (surf->format->BytesPerPixel < 1 || surf->format->BytesPerPixel > 4)
+        return RAISE(PyExc_RuntimeError, "invalid color depth for surface");
+
+    /* a mapped color for each pixel, as get_at_many gives them, or one
+       color for every pixel, as set_at takes it */
+    per_pixel = PyObject_CheckBuffer(colors) &&
+                PyObject_IsInstance(colors, &pgColor_Type) <= 0;
+    if (!per_pixel && PyLong_Check(colors)) {
+        color = (Uint32)PyLong_AsLong(colors);
+        if (PyErr_Occurred() && (Sint32)color == -1)
+            return RAISE(PyExc_TypeError, "invalid color argument");
+    }
+    else if (!per_pixel) {
+        if (!pg_RGBAFromFuzzyColorObj(colors, rgba))
+            return NULL;
+        color = pg_map_rgba(surf, rgba[0], rgba[1], rgba[2], rgba[3]);
+    }
+
+    count = _get_int32_records(coords, &view, 2, -1, "coords");
+    if (count < 0)
+        return NULL;
+    if (per_pixel) {
+        if (_get_int32_records(colors, &colorview, 1, count, "colors") < 0) {
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+        mapped = (const Uint32 *)colorview.buf;
+    }
+    if (!pgSurface_Lock(self)) {
+        PyBuffer_Release(&view);
+        if (mapped)
+            PyBuffer_Release(&colorview);
+        return NULL;
+    }
+
+    /* pixels outside the clip area are skipped, as set_at does */
+    clip = &surf->clip_rect;
+    xy = (const int *)view.buf;
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < count; ++i, xy += 2) {
+        if (xy[0] < clip->x || xy[0] >= clip->x + clip->w ||
+            xy[1] < clip->y || xy[1] >= clip->y + clip->h)
+            continue;
+        _surf_write_mapped(surf, xy[0], xy[1], mapped ? mapped[i] : color);
+    }
+    Py_END_ALLOW_THREADS;
+
+    PyBuffer_Release(&view);
+    if (mapped)
+        PyBuffer_Release(&colorview);
+    if (!pgSurface_Unlock(self))
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_blit_many(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
+{
+    SDL_Surface *dest = pgSurface_AsSurface(self);
+    pgSurfaceObject *srcobject;
+    PyObject *srcarg, *positions;
+    SDL_Rect bounds;
+    Py_buffer view;
+    Py_ssize_t count;
+    int result;
+    int the_args = 0;
+
+    static char *kwids[] = {"source", "positions", "special_flags", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OO|i", kwids, &srcarg,
+                                     &positions, &the_args))
+        return NULL;
+
+    if (surface_blit_source(srcarg, &srcobject, &bounds))
+        return RAISE(PyExc_TypeError,
+                     "source must be a Surface or a SurfaceRegion");
+    if (!dest || !pgSurface_AsSurface(srcobject))
+        return RAISE(pgExc_SDLError, "display Surface quit");
+
+    count = _get_int32_records(positions, &view, 2, -1, "positions");
+    if (count < 0)
+        return NULL;
+    /* a region could be given another surface while the GIL is released,
+       so the source is held here */
+    Py_INCREF(srcobject);
+    result = surface_blit_positions(self, srcobject, &bounds,
+                                    (const int *)view.buf, count, the_args);
+    Py_DECREF(srcobject);
+    PyBuffer_Release(&view);
+    if (result)
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_blit_array(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
+{
+    SDL_Surface *dest = pgSurface_AsSurface(self);
+    SDL_Surface **srcs = NULL;
+    pgSurfaceObject **srcobjs;
+    PyObject **spans = NULL;
+    PyObject *sources, *rects, *flagsobj = NULL, *seq;
+    Py_buffer view, flagsview;
+    Py_ssize_t count, ndone, i;
+    pgBlitTarget target;
+    SDL_Rect srcrect, dstrect;
+    const int *rec, *flags = NULL;
+    int the_args = 0, result = 0;
+
+    static char *kwids[] = {"sources", "rects", "special_flags", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OO|O", kwids, &sources,
+                                     &rects, &flagsobj))
+        return NULL;
+
+    if (!dest)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    if (!pgSurface_Unshare(dest))
+        return NULL;
+
+    /* A tuple holds the sources while the GIL is released, where the items
+       of a list could be changed by another thread. */
+    seq = PySequence_Tuple(sources);
+    if (!seq) {
+        if (PyErr_ExceptionMatches(PyExc_TypeError)) {
+            PyErr_SetString(PyExc_TypeError,
+                            "sources must be a sequence of Surfaces");
+        }
+        return NULL;
+    }
+    count = PyTuple_GET_SIZE(seq);
+    srcobjs = (pgSurfaceObject **)&PyTuple_GET_ITEM(seq, 0);
+    for (i = 0; i < count; ++i) {
+        if (!pgSurface_Check((PyObject *)srcobjs[i])) {
+            Py_DECREF(seq);
+            return RAISE(PyExc_TypeError, "Source objects must be a surface");
+        }
+        if (!pgSurface_AsSurface(srcobjs[i])) {
+            Py_DECREF(seq);
+            return RAISE(pgExc_SDLError, "display Surface quit");
+        }
+        if (!pgSurface_Unpack(pgSurface_AsSurface(srcobjs[i]))) {
+            Py_DECREF(seq);
+            return NULL;
+        }
+    }
+
+    if (_get_int32_records(rects, &view, 4, count, "rects") < 0) {
+        Py_DECREF(seq);
+        return NULL;
+    }
+    if (flagsobj && PyLong_Check(flagsobj)) {
+        the_args = (int)PyLong_AsLong(flagsobj);
+        if (the_args == -1 && PyErr_Occurred()) {
+            PyBuffer_Release(&view);
+            Py_DECREF(seq);
+            return NULL;
+        }
+    }
+    else if (flagsobj && flagsobj != Py_None) {
+        if (_get_int32_records(flagsobj, &flagsview, 1, count,
+                               "special_flags") < 0) {
+            PyBuffer_Release(&view);
+            Py_DECREF(seq);
+            return NULL;
+        }
+        flags = (const int *)flagsview.buf;
+    }
+
+    srcs = PyMem_New(SDL_Surface *, count ? count : 1);
+    spans = PyMem_New(PyObject *, count ? count : 1);
+    if (!srcs || !spans) {
+        PyMem_Free(srcs);
+        PyMem_Free(spans);
+        if (flags)
+            PyBuffer_Release(&flagsview);
+        PyBuffer_Release(&view);
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+
+    /* As in fblits, resolve and lock everything up front. Sprites sharing
+       an image are often next to each other, so a row with the same source
+       and flags as the one before it shares its spans. */
+    surface_blit_target_begin(self, &target);
+    for (i = 0; i < count; ++i) {
+        srcs[i] = pgSurface_AsSurface(srcobjs[i]);
+        pgSurface_Prep(srcobjs[i]);
+        if (i && srcs[i] == srcs[i - 1] &&
+            (!flags || flags[i] == flags[i - 1])) {
+            spans[i] = spans[i - 1];
+            Py_XINCREF(spans[i]);
+        }
+        else {
+            spans[i] = surface_get_spans(
+                srcs[i], target.surf,
+                surface_blit_args(srcs[i], flags ? flags[i] : the_args));
+        }
+    }
+
+    rec = (const int *)view.buf;
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < count; ++i, rec += 4) {
+        if (surface_blit_misses(&target, rec[0], rec[1], srcs[i]->w,
+                                srcs[i]->h))
+            continue;
+        srcrect.x = srcrect.y = 0;
+        srcrect.w = srcs[i]->w;
+        srcrect.h = srcs[i]->h;
+        dstrect.x = rec[0] + target.offsetx;
+        dstrect.y = rec[1] + target.offsety;
+        dstrect.w = srcs[i]->w;
+        dstrect.h = srcs[i]->h;
+        result = surface_blit_prepared(srcs[i], &srcrect, target.surf,
+                                       &dstrect, flags ? flags[i] : the_args,
+                                       SURFACE_SPANS(spans[i]));
+        if (result != 0)
+            break;
+    }
+    Py_END_ALLOW_THREADS;
+    ndone = i;
+
+    for (i = 0; i < count; ++i) {
+        Py_XDECREF(spans[i]);
+        pgSurface_Unprep(srcobjs[i]);
+    }
+    surface_blit_target_end(self, &target);
+
+    if (damage_trackers) {
+        rec = (const int *)view.buf;
+        for (i = 0; i < ndone; ++i, rec += 4) {
+            dstrect.x = rec[0];
+            dstrect.y = rec[1];
+            dstrect.w = srcs[i]->w;
+            dstrect.h = srcs[i]->h;
+            pgSurface_AddDamage(self, &dstrect);
+        }
+    }
+
+    PyMem_Free(srcs);
+    PyMem_Free(spans);
+    if (flags)
+        PyBuffer_Release(&flagsview);
+    PyBuffer_Release(&view);
+    Py_DECREF(seq);
+
+    if (result == -1)
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    if (result == -2)
+        return RAISE(pgExc_SDLError, "Surface was lost");
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_set_damage_tracking(pgSurfaceObject *self, PyObject *args)
+{
+    pgDamageTracker *tracker;
+    int enabled = 1;
+
+    if (!PyArg_ParseTuple(args, "|p", &enabled))
+        return NULL;
+
+    if (!enabled) {
+        surface_damage_untrack(self);
+        Py_RETURN_NONE;
+    }
+    if (surface_damage_find(self))
+        Py_RETURN_NONE;
+
+    tracker = PyMem_New(pgDamageTracker, 1);
+    if (!tracker)
+        return PyErr_NoMemory();
+    tracker->surfobj = self;
+    tracker->count = 0;
+    tracker->next = damage_trackers;
+    damage_trackers = tracker;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_damage(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
+{
+    pgDamageTracker *tracker = surface_damage_find(self);
+    PyObject *list, *rect;
+    int i, clear = 1;
+
+    static char *kwids[] = {"clear", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "|p", kwids, &clear))
+        return NULL;
+
+    if (!tracker)
+        return PyList_New(0);
+
+    list = PyList_New(tracker->count);
+    if (!list)
+        return NULL;
+    for (i = 0; i < tracker->count; ++i) {
+        rect = pgRect_New(&tracker->rects[i]);
+        if (!rect) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, rect);
+    }
+    if (clear)
+        tracker->count = 0;
+    return list;
+}
+
+static PyObject *
+surf_get_version(pgSurfaceObject *self, PyObject *_null)
+{
+    return PyLong_FromUnsignedLong(pgSurface_GetVersion(self));
+}
+
+static PyObject *
+surf_scroll(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    int dx = 0, dy = 0;
+    SDL_Surface *surf;
+    int bpp;
+    int pitch;
+    SDL_Rect *clip_rect;
+    int w, h;
+    int wrap = 0;
+    Uint8 *src, *dst;
+
+    static char *kwids[] = {"dx", "dy", "wrap", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "|iip", kwids, &dx, &dy,
+                                     &wrap)) {
+        return NULL;
+    }
+
+    surf = pgSurface_AsSurface(self);
+    if (!surf) {
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    }
+
+    clip_rect = &surf->clip_rect;
+    w = clip_rect->w;
+    h = clip_rect->h;
+    if (wrap && w > 0 && h > 0) {
+        /* any scroll is the same as one by less than the clip size */
+        dx %= w;
+        if (dx < 0)
+            dx += w;
+        dy %= h;
+        if (dy < 0)
+            dy += h;
+    }
+
+    if (dx == 0 && dy == 0) {
+        Py_RETURN_NONE;
+    }
+
+    if (dx >= w || dx <= -w || dy >= h || dy <= -h) {
+        Py_RETURN_NONE;
+    }
+
+    if (!pgSurface_Lock((pgSurfaceObject *)self)) {
+        return NULL;
+    }
+
+    bpp = surf->format->BytesPerPixel;
+    pitch = surf->pitch;
+    src = dst =
+        (Uint8 *)surf->pixels + clip_rect->y * pitch + clip_rect->x * bpp;
+    if (wrap) {
+        if (surface_wrap(dst, w, h, bpp, pitch, dx, dy)) {
+            pgSurface_Unlock((pgSurfaceObject *)self);
+            return PyErr_NoMemory();
+        }
+    }
+    else if (dx >= 0) {
+        w -= dx;
+        if (dy > 0) {
+            h -= dy;
+            dst += dy * pitch + dx * bpp;
+        }
+        else {
+            h += dy;
+            src -= dy * pitch;
+            dst += dx * bpp;
+        }
+    }
+    else {
+        w += dx;
+        if (dy > 0) {
+            h -= dy;
+            src -= dx * bpp;
+            dst += dy * pitch;
+        }
+        else {
+            h += dy;
+            src -= dy * pitch + dx * bpp;
+        }
+    }
+    if (!wrap) {
+        surface_move(src, dst, h, w * bpp, pitch, pitch);
+    }
+
+    if (!pgSurface_Unlock((pgSurfaceObject *)self)) {
+        return NULL;
+    }
+    pgSurface_AddDamage((pgSurfaceObject *)self, clip_rect);
+
+    Py_RETURN_NONE;
+}
+
+int
+pg_HasSurfaceRLE(SDL_Surface *surface)
+{
+    pg_BlitMap *blit_map;
+    /* this is part of a hack to allow us to access
+       the COPY_RLE_DESIRED flag from pygame */
+    if (!surface) {
+        return SDL_FALSE;
+    }
+
+    blit_map = (pg_BlitMap *)surface->map;
+
+    if (!(blit_map->info.flags & PGS_COPY_RLE_DESIRED)) {
+        return SDL_FALSE;
+    }
+
+    return SDL_TRUE;
+}
+
+static int
+_PgSurface_SrcAlpha(SDL_Surface *surf)
+{
+    SDL_BlendMode mode;
+    if (SDL_GetSurfaceBlendMode(surf, &mode) < 0) {
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        return -1;
+    }
+    return (mode != SDL_BLENDMODE_NONE);
+}
+
+static PyObject *
+surf_get_flags(PyObject *self, PyObject *_null)
+{
+    Uint32 sdl_flags = 0;
+    Uint32 window_flags = 0;
+    Uint32 flags = 0;
+    int is_alpha;
     int is_window_surf = 0;
     SDL_Window *win = pg_GetDefaultWindow();
 
@@ -2236,8 +4560,11 @@ surf_get_flags(PyObject *self, PyObject *_null)
     }
     if (SDL_GetColorKey(surf, NULL) == 0)
         flags |= PGS_SRCCOLORKEY;
-    if (sdl_flags & SDL_PREALLOC)
+    if ((sdl_flags & SDL_PREALLOC) &&
+        !(sdl_flags & (PG_SURF_SHARED | PG_SURF_POOLED)))
         flags |= PGS_PREALLOC;
+    if (sdl_flags & PG_SURF_PREMULTIPLIED)
+        flags |= PGS_PREMULTIPLIED;
     if (pg_HasSurfaceRLE(surf))
         flags |= PGS_RLEACCELOK;
     if ((sdl_flags & SDL_RLEACCEL))
@@ -2433,7 +4760,10 @@ surf_subsurface(PyObject *self, PyObject *args)
         return RAISE(PyExc_ValueError,
                      "subsurface rectangle outside surface area");
 
-    pgSurface_Lock((pgSurfaceObject *)self);
+    if (!pgSurface_Lock((pgSurfaceObject *)self))
+        return NULL;
+    /* the subsurface points into these pixels from now on */
+    surf->flags |= PG_SURF_PINNED;
 
     pixeloffset = rect->x * format->BytesPerPixel + rect->y * surf->pitch;
     startpixel = ((char *)surf->pixels) + pixeloffset;
@@ -2446,6 +4776,7 @@ surf_subsurface(PyObject *self, PyObject *args)
 
     if (!sub)
         return _raise_create_surface_error();
+    sub->flags |= surf->flags & PG_SURF_PREMULTIPLIED;
 
     /* copy the colormap if we need it */
     if (SDL_ISPIXELFORMAT_INDEXED(surf->format->format) &&
@@ -2609,32 +4940,254 @@ surf_get_abs_parent(PyObject *self, PyObject *_null)
     return owner;
 }
 
-static PyObject *
-surf_get_bounding_rect(PyObject *self, PyObject *args, PyObject *kwargs)
+/*
+ * get_bounding_rect: the smallest rect holding the pixels that are not
+ * transparent, found by scanning whole rows inward from the edges. Formats
+ * with a byte of alpha, and colorkeys, are tested without SDL_GetRGBA(),
+ * 16 pixels at a time with SSE2 or NEON.
+ */
+
+typedef enum {
+    BOUNDS_GENERIC, /* SDL_GetRGBA() on each pixel */
+    BOUNDS_ALPHA8,  /* 32 bit pixels with a whole byte of alpha */
+    BOUNDS_KEY,     /* 16, 24 or 32 bit pixels compared to the colorkey */
+    BOUNDS_ALL,     /* every pixel counts, or none does */
+} BoundsMode;
+
+typedef struct {
+    BoundsMode mode;
+    SDL_Surface *surf;
+    int bpp;
+    int min_alpha;
+    int all;          /* BOUNDS_ALL: whether the pixels count */
+    int alpha_offset; /* BOUNDS_ALPHA8: the byte of a pixel with the alpha */
+    Uint32 mask, key; /* BOUNDS_KEY: the RGB bits of pixels and colorkey */
+    int has_colorkey; /* BOUNDS_GENERIC: compare RGB to keyr, keyg, keyb */
+    Uint8 keyr, keyg, keyb;
+} BoundsScan;
+
+static void
+_bounds_init(BoundsScan *scan, SDL_Surface *surf, int min_alpha)
 {
+    SDL_PixelFormat *format = surf->format;
+    Uint32 colorkey;
+    Uint8 a;
+
+    scan->surf = surf;
+    scan->bpp = format->BytesPerPixel;
+    scan->min_alpha = min_alpha;
+    scan->has_colorkey = SDL_GetColorKey(surf, &colorkey) == 0;
+    if (scan->has_colorkey) {
+        SDL_GetRGBA(colorkey, format, &scan->keyr, &scan->keyg, &scan->keyb,
+                    &a);
+        /* the palette may hold the colour of the key more than once */
+        scan->mode = scan->bpp > 1 ? BOUNDS_KEY : BOUNDS_GENERIC;
+        scan->mask = format->Rmask | format->Gmask | format->Bmask;
+        scan->key = colorkey & scan->mask;
+    }
+    else if (min_alpha <= 0 || min_alpha > 255) {
+        scan->mode = BOUNDS_ALL;
+        scan->all = min_alpha <= 0;
+    }
+    else if (!format->Amask && scan->bpp > 1) {
+        /* SDL_GetRGBA() gives these an alpha of 255 */
+        scan->mode = BOUNDS_ALL;
+        scan->all = 1;
+    }
+    else if (scan->bpp == 4 && format->Amask && !format->Aloss &&
+             format->Ashift % 8 == 0) {
+        scan->mode = BOUNDS_ALPHA8;
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-    const int BYTE0 = 0;
-    const int BYTE1 = 1;
-    const int BYTE2 = 2;
+        scan->alpha_offset = format->Ashift / 8;
 #else
-    const int BYTE0 = 2;
-    const int BYTE1 = 1;
-    const int BYTE2 = 0;
+        scan->alpha_offset = 3 - format->Ashift / 8;
 #endif
-    PyObject *rect;
-    SDL_Surface *surf = pgSurface_AsSurface(self);
-    SDL_PixelFormat *format = NULL;
-    Uint8 *pixels = NULL;
-    Uint8 *pixel;
-    int x, y;
-    int min_x, min_y, max_x, max_y;
-    int min_alpha = 1;
-    int found_alpha = 0;
-    Uint32 value;
-    Uint8 r, g, b, a;
-    int has_colorkey = 0;
-    Uint32 colorkey;
-    Uint8 keyr, keyg, keyb;
+    }
+    else {
+        scan->mode = BOUNDS_GENERIC;
+    }
+}
+
+/* Whether the pixel counts toward the bounding rect */
+static PG_INLINE int
+_bounds_pixel(const BoundsScan *scan, const Uint8 *pixel)
+{
+    Uint32 value;
+    Uint8 r, g, b, a;
+
+    switch (scan->mode) {
+        case BOUNDS_ALPHA8:
+            return pixel[scan->alpha_offset] >= scan->min_alpha;
+        case BOUNDS_KEY:
+            value = scan->bpp == 2 ? *(const Uint16 *)pixel
+                                   : _convert_read_pixel(pixel, scan->bpp);
+            return (value & scan->mask) != scan->key;
+        case BOUNDS_ALL:
+            return scan->all;
+        default:
+            switch (scan->bpp) {
+                case 1:
+                    value = *pixel;
+                    break;
+                case 2:
+                    value = *(const Uint16 *)pixel;
+                    break;
+                default:
+                    value = _convert_read_pixel(pixel, scan->bpp);
+            }
+            SDL_GetRGBA(value, scan->surf->format, &r, &g, &b, &a);
+            if (scan->has_colorkey)
+                return r != scan->keyr || g != scan->keyg || b != scan->keyb;
+            return a >= scan->min_alpha;
+    }
+}
+
+#ifdef SURFACE_SIMD
+/* Whether any of the 16 32 bit pixels counts toward the bounding rect */
+static PG_INLINE int
+_bounds_any16_sse2(const BoundsScan *scan, const Uint8 *pixels)
+{
+    const __m128i *p = (const __m128i *)pixels;
+    __m128i v0 = _mm_loadu_si128(p), v1 = _mm_loadu_si128(p + 1);
+    __m128i v2 = _mm_loadu_si128(p + 2), v3 = _mm_loadu_si128(p + 3);
+
+    if (scan->mode == BOUNDS_ALPHA8) {
+        /* a byte is at least min_alpha if it is its max with min_alpha */
+        __m128i threshold = _mm_set1_epi8((char)scan->min_alpha);
+        __m128i alphas =
+            _mm_set1_epi32((int)(0xFFu << (scan->alpha_offset * 8)));
+        __m128i ge =
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(
+                                          _mm_max_epu8(v0, threshold), v0),
+                                      _mm_cmpeq_epi8(
+                                          _mm_max_epu8(v1, threshold), v1)),
+                         _mm_or_si128(_mm_cmpeq_epi8(
+                                          _mm_max_epu8(v2, threshold), v2),
+                                      _mm_cmpeq_epi8(
+                                          _mm_max_epu8(v3, threshold), v3)));
+
+        return _mm_movemask_epi8(_mm_and_si128(ge, alphas)) != 0;
+    }
+    else {
+        __m128i mask = _mm_set1_epi32((int)scan->mask);
+        __m128i key = _mm_set1_epi32((int)scan->key);
+        __m128i eq = _mm_and_si128(
+            _mm_and_si128(_mm_cmpeq_epi32(_mm_and_si128(v0, mask), key),
+                          _mm_cmpeq_epi32(_mm_and_si128(v1, mask), key)),
+            _mm_and_si128(_mm_cmpeq_epi32(_mm_and_si128(v2, mask), key),
+                          _mm_cmpeq_epi32(_mm_and_si128(v3, mask), key)));
+
+        return _mm_movemask_epi8(eq) != 0xFFFF;
+    }
+}
+#endif /* SURFACE_SIMD */
+
+/* Whether _bounds_any16_sse2() can test the pixels of the scan */
+static int
+_bounds_use_simd(const BoundsScan *scan)
+{
+    return scan->bpp == 4 &&
+           (scan->mode == BOUNDS_ALPHA8 || scan->mode == BOUNDS_KEY) &&
+           _convert_use_simd();
+}
+
+/* The first pixel from start up to end that counts, or end */
+static int
+_bounds_first(const BoundsScan *scan, const Uint8 *row, int start, int end,
+              int simd)
+{
+    int x = start;
+
+    if (scan->mode == BOUNDS_ALL)
+        return scan->all ? start : end;
+#ifdef SURFACE_SIMD
+    if (simd) {
+        while (x + 16 <= end && !_bounds_any16_sse2(scan, row + x * 4))
+            x += 16;
+    }
+#endif /* SURFACE_SIMD */
+    for (; x < end; x++) {
+        if (_bounds_pixel(scan, row + x * scan->bpp))
+            return x;
+    }
+    return end;
+}
+
+/* The last pixel from start up to end that counts, or start - 1 */
+static int
+_bounds_last(const BoundsScan *scan, const Uint8 *row, int start, int end,
+             int simd)
+{
+    int x = end;
+
+    if (scan->mode == BOUNDS_ALL)
+        return scan->all ? end - 1 : start - 1;
+#ifdef SURFACE_SIMD
+    if (simd) {
+        while (x - 16 >= start &&
+               !_bounds_any16_sse2(scan, row + (x - 16) * 4))
+            x -= 16;
+    }
+#endif /* SURFACE_SIMD */
+    while (--x >= start) {
+        if (_bounds_pixel(scan, row + x * scan->bpp))
+            return x;
+    }
+    return start - 1;
+}
+
+/* Find the bounding rect of a locked surface. Touches no Python objects, so
+ * it may be called with the GIL released. */
+static void
+_bounds_scan(SDL_Surface *surf, int min_alpha, SDL_Rect *rect)
+{
+    BoundsScan scan;
+    const Uint8 *pixels = (const Uint8 *)surf->pixels;
+    int w = surf->w, h = surf->h, pitch = surf->pitch;
+    int min_x = 0, min_y, max_x, max_y, x, y, simd;
+
+    _bounds_init(&scan, surf, min_alpha);
+    simd = _bounds_use_simd(&scan);
+    rect->x = rect->y = rect->w = rect->h = 0;
+
+    /* the top and bottom rows, stopping at the first pixel found */
+    for (min_y = 0; min_y < h; min_y++) {
+        min_x = _bounds_first(&scan, pixels + min_y * pitch, 0, w, simd);
+        if (min_x < w)
+            break;
+    }
+    if (min_y == h)
+        return;
+    for (max_y = h - 1; max_y > min_y; max_y--) {
+        if (_bounds_first(&scan, pixels + max_y * pitch, 0, w, simd) < w)
+            break;
+    }
+
+    /* then only the parts of the rows outside the columns found so far */
+    max_x = _bounds_last(&scan, pixels + min_y * pitch, min_x, w, simd);
+    for (y = min_y + 1; y <= max_y && (min_x > 0 || max_x < w - 1); y++) {
+        const Uint8 *row = pixels + y * pitch;
+
+        x = _bounds_first(&scan, row, 0, min_x, simd);
+        if (x < min_x)
+            min_x = x;
+        x = _bounds_last(&scan, row, max_x + 1, w, simd);
+        if (x > max_x)
+            max_x = x;
+    }
+
+    rect->x = min_x;
+    rect->y = min_y;
+    rect->w = max_x - min_x + 1;
+    rect->h = max_y - min_y + 1;
+}
+
+static PyObject *
+surf_get_bounding_rect(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    SDL_Rect rect;
+    int min_alpha = 1;
 
     char *kwids[] = {"min_alpha", NULL};
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|i", kwids, &min_alpha))
@@ -2645,207 +5198,314 @@ surf_get_bounding_rect(PyObject *self, PyObject *args, PyObject *kwargs)
     if (!surf)
         return RAISE(pgExc_SDLError, "display Surface quit");
 
-    if (!pgSurface_Lock((pgSurfaceObject *)self))
+    if (!pgSurface_LockRead((pgSurfaceObject *)self))
         return RAISE(pgExc_SDLError, "could not lock surface");
 
-    format = surf->format;
+    _bounds_scan(surf, min_alpha, &rect);
 
-    if (SDL_GetColorKey(surf, &colorkey) == 0) {
-        has_colorkey = 1;
-        SDL_GetRGBA(colorkey, surf->format, &keyr, &keyg, &keyb, &a);
-    }
+    if (!pgSurface_UnlockRead((pgSurfaceObject *)self))
+        return RAISE(pgExc_SDLError, "could not unlock surface");
 
-    pixels = (Uint8 *)surf->pixels;
-    min_y = 0;
-    min_x = 0;
-    max_x = surf->w;
-    max_y = surf->h;
-
-    found_alpha = 0;
-    for (y = max_y - 1; y >= min_y; --y) {
-        for (x = min_x; x < max_x; ++x) {
-            pixel = (pixels + y * surf->pitch) + x * format->BytesPerPixel;
-            switch (format->BytesPerPixel) {
-                case 1:
-                    value = *pixel;
-                    break;
-                case 2:
-                    value = *(Uint16 *)pixel;
-                    break;
-                case 3:
-                    value = pixel[BYTE0];
-                    value |= pixel[BYTE1] << 8;
-                    value |= pixel[BYTE2] << 16;
-                    break;
-                default:
-                    assert(format->BytesPerPixel == 4);
-                    value = *(Uint32 *)pixel;
-            }
-            SDL_GetRGBA(value, surf->format, &r, &g, &b, &a);
-            if ((a >= min_alpha && has_colorkey == 0) ||
-                (has_colorkey != 0 && (r != keyr || g != keyg || b != keyb))) {
-                found_alpha = 1;
-                break;
-            }
-        }
-        if (found_alpha == 1) {
-            break;
-        }
-        max_y = y;
-    }
-    found_alpha = 0;
-    for (x = max_x - 1; x >= min_x; --x) {
-        for (y = min_y; y < max_y; ++y) {
-            pixel = (pixels + y * surf->pitch) + x * format->BytesPerPixel;
-            switch (format->BytesPerPixel) {
-                case 1:
-                    value = *pixel;
-                    break;
-                case 2:
-                    value = *(Uint16 *)pixel;
-                    break;
-                case 3:
-                    value = pixel[BYTE0];
-                    value |= pixel[BYTE1] << 8;
-                    value |= pixel[BYTE2] << 16;
-                    break;
-                default:
-                    assert(format->BytesPerPixel == 4);
-                    value = *(Uint32 *)pixel;
-            }
-            SDL_GetRGBA(value, surf->format, &r, &g, &b, &a);
-            if ((a >= min_alpha && has_colorkey == 0) ||
-                (has_colorkey != 0 && (r != keyr || g != keyg || b != keyb))) {
-                found_alpha = 1;
-                break;
-            }
-        }
-        if (found_alpha == 1) {
-            break;
-        }
-        max_x = x;
+    return pgRect_New(&rect);
+}
+
+/* The reductions live in transform, next to average_color(), which this
+ * shares its threading and SIMD code with. */
+static PyObject *
+surf_get_stats(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *rectobj = Py_None, *transform, *result;
+    char *kwids[] = {"rect", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", kwids, &rectobj))
+        return NULL;
+    if (!pgSurface_AsSurface(self))
+        return RAISE(pgExc_SDLError, "display Surface quit");
+
+    transform = PyImport_ImportModule("pygame.transform");
+    if (!transform)
+        return NULL;
+    result = PyObject_CallMethod(transform, "_get_stats", "OO", self, rectobj);
+    Py_DECREF(transform);
+    return result;
+}
+
+static PyObject *
+surf_compress(PyObject *self, PyObject *_null)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    pgSurfaceObject *surfobj = (pgSurfaceObject *)self;
+    Py_ssize_t size;
+
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+
+    /* locks, subsurfaces and views all hold on to the pixels */
+    if (surfobj->readlocks > 0 ||
+        (surfobj->locklist && PyList_GET_SIZE(surfobj->locklist) > 0) ||
+        surfobj->subsurface)
+        return PyLong_FromLong(0);
+    surface_drop_spans(surf);
+    surface_drop_shadow(surf);
+    size = pgSurface_Pack(surf);
+    if (size < 0)
+        return NULL;
+    return PyLong_FromSsize_t(size);
+}
+
+static PyObject *
+surf_get_compressed_size(PyObject *self, PyObject *_null)
+{
+    return PyLong_FromSsize_t(pgSurface_PackedSize(pgSurface_AsSurface(self)));
+}
+
+/* The OpenGL format and type reading the pixels of a surface as they are,
+ * or 0 if they need converting first. The packed types keep it independent
+ * of the byte order. */
+static int
+_gl_pixel_format(SDL_PixelFormat *fmt, unsigned int *format,
+                 unsigned int *type)
+{
+    switch (fmt->format) {
+        case SDL_PIXELFORMAT_ARGB8888:
+        case SDL_PIXELFORMAT_RGB888:
+            *format = PG_GL_BGRA;
+            *type = PG_GL_UNSIGNED_INT_8_8_8_8_REV;
+            return 1;
+        case SDL_PIXELFORMAT_ABGR8888:
+        case SDL_PIXELFORMAT_BGR888:
+            *format = PG_GL_RGBA;
+            *type = PG_GL_UNSIGNED_INT_8_8_8_8_REV;
+            return 1;
+        case SDL_PIXELFORMAT_RGBA8888:
+        case SDL_PIXELFORMAT_RGBX8888:
+            *format = PG_GL_RGBA;
+            *type = PG_GL_UNSIGNED_INT_8_8_8_8;
+            return 1;
+        case SDL_PIXELFORMAT_BGRA8888:
+        case SDL_PIXELFORMAT_BGRX8888:
+            *format = PG_GL_BGRA;
+            *type = PG_GL_UNSIGNED_INT_8_8_8_8;
+            return 1;
+        case SDL_PIXELFORMAT_RGB24:
+            *format = PG_GL_RGB;
+            *type = PG_GL_UNSIGNED_BYTE;
+            return 1;
+        case SDL_PIXELFORMAT_BGR24:
+            *format = PG_GL_BGR;
+            *type = PG_GL_UNSIGNED_BYTE;
+            return 1;
+        case SDL_PIXELFORMAT_RGB565:
+            *format = PG_GL_RGB;
+            *type = PG_GL_UNSIGNED_SHORT_5_6_5;
+            return 1;
     }
-    found_alpha = 0;
-    for (y = min_y; y < max_y; ++y) {
-        min_y = y;
-        for (x = min_x; x < max_x; ++x) {
-            pixel = (pixels + y * surf->pitch) + x * format->BytesPerPixel;
-            switch (format->BytesPerPixel) {
-                case 1:
-                    value = *pixel;
-                    break;
-                case 2:
-                    value = *(Uint16 *)pixel;
-                    break;
-                case 3:
-                    value = pixel[BYTE0];
-                    value |= pixel[BYTE1] << 8;
-                    value |= pixel[BYTE2] << 16;
-                    break;
-                default:
-                    assert(format->BytesPerPixel == 4);
-                    value = *(Uint32 *)pixel;
-            }
-            SDL_GetRGBA(value, surf->format, &r, &g, &b, &a);
-            if ((a >= min_alpha && has_colorkey == 0) ||
-                (has_colorkey != 0 && (r != keyr || g != keyg || b != keyb))) {
-                found_alpha = 1;
-                break;
-            }
-        }
-        if (found_alpha == 1) {
-            break;
+    return 0;
+}
+
+static PyObject *
+surf_gl_upload(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    SDL_Surface *pixels;
+    PyObject *offsetobj = Py_None;
+    unsigned int target = PG_GL_TEXTURE_2D, pbo = 0;
+    unsigned int format, type;
+    int level = 0, x = 0, y = 0, internalformat;
+    int row_length, alignment, binding = 0;
+    Uint32 key;
+    const void *data;
+    GL_glTexImage2D_Func p_glTexImage2D;
+    GL_glTexSubImage2D_Func p_glTexSubImage2D;
+    GL_glPixelStorei_Func p_glPixelStorei;
+    GL_glGetIntegerv_Func p_glGetIntegerv;
+    GL_glBindBuffer_Func p_glBindBuffer;
+    GL_glBufferData_Func p_glBufferData;
+
+    static char *kwids[] = {"target", "level", "offset", "pbo", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|IiOI", kwids, &target,
+                                     &level, &offsetobj, &pbo))
+        return NULL;
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    if (offsetobj != Py_None && !pg_TwoIntsFromObj(offsetobj, &x, &y))
+        return RAISE(PyExc_TypeError, "offset must be two numbers or None");
+    if (!SDL_GL_GetCurrentContext())
+        return RAISE(pgExc_SDLError, "no OpenGL context is current");
+
+    p_glTexImage2D =
+        (GL_glTexImage2D_Func)SDL_GL_GetProcAddress("glTexImage2D");
+    p_glTexSubImage2D =
+        (GL_glTexSubImage2D_Func)SDL_GL_GetProcAddress("glTexSubImage2D");
+    p_glPixelStorei =
+        (GL_glPixelStorei_Func)SDL_GL_GetProcAddress("glPixelStorei");
+    p_glGetIntegerv =
+        (GL_glGetIntegerv_Func)SDL_GL_GetProcAddress("glGetIntegerv");
+    p_glBindBuffer =
+        (GL_glBindBuffer_Func)SDL_GL_GetProcAddress("glBindBuffer");
+    p_glBufferData =
+        (GL_glBufferData_Func)SDL_GL_GetProcAddress("glBufferData");
+    if (!p_glTexImage2D || !p_glTexSubImage2D || !p_glPixelStorei ||
+        !p_glGetIntegerv)
+        return RAISE(pgExc_SDLError, "OpenGL functions not found");
+    if (pbo && (!p_glBindBuffer || !p_glBufferData))
+        return RAISE(pgExc_SDLError,
+                     "OpenGL pixel buffer objects not available");
+
+    if (!pgSurface_LockRead((pgSurfaceObject *)self))
+        return RAISE(pgExc_SDLError, "could not lock surface");
+
+    pixels = surf;
+    if (!_gl_pixel_format(surf->format, &format, &type) ||
+        surf->pitch % surf->format->BytesPerPixel) {
+        /* other formats are read through a copy in one GL takes */
+        pixels = SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_ARGB8888, 0);
+        if (!pixels) {
+            pgSurface_UnlockRead((pgSurfaceObject *)self);
+            return RAISE(pgExc_SDLError, SDL_GetError());
         }
+        _gl_pixel_format(pixels->format, &format, &type);
+    }
+    /* the copy turns a colorkey into alpha */
+    internalformat = (surf->format->Amask ||
+                      (pixels != surf && SDL_GetColorKey(surf, &key) == 0))
+                         ? PG_GL_RGBA8
+                         : PG_GL_RGB8;
+
+    p_glGetIntegerv(PG_GL_UNPACK_ROW_LENGTH, &row_length);
+    p_glGetIntegerv(PG_GL_UNPACK_ALIGNMENT, &alignment);
+    p_glPixelStorei(PG_GL_UNPACK_ROW_LENGTH,
+                    pixels->pitch / pixels->format->BytesPerPixel);
+    p_glPixelStorei(PG_GL_UNPACK_ALIGNMENT, 1);
+    if (p_glBindBuffer) {
+        /* a bound buffer would take the pixel pointer for an offset */
+        p_glGetIntegerv(PG_GL_PIXEL_UNPACK_BUFFER_BINDING, &binding);
+        p_glBindBuffer(PG_GL_PIXEL_UNPACK_BUFFER, pbo);
+    }
+
+    data = pixels->pixels;
+    if (pbo) {
+        /* orphans the old storage, so the driver need not wait for the
+         * previous upload to finish reading it */
+        p_glBufferData(PG_GL_PIXEL_UNPACK_BUFFER,
+                       (ptrdiff_t)pixels->pitch * pixels->h, data,
+                       PG_GL_STREAM_DRAW);
+        data = NULL;
+    }
+    if (offsetobj == Py_None) {
+        p_glTexImage2D(target, level, internalformat, pixels->w, pixels->h,
+                       0, format, type, data);
     }
-    found_alpha = 0;
-    for (x = min_x; x < max_x; ++x) {
-        min_x = x;
-        for (y = min_y; y < max_y; ++y) {
-            pixel = (pixels + y * surf->pitch) + x * format->BytesPerPixel;
-            switch (format->BytesPerPixel) {
-                case 1:
-                    value = *pixel;
-                    break;
-                case 2:
-                    value = *(Uint16 *)pixel;
-                    break;
-                case 3:
-                    value = pixel[BYTE0];
-                    value |= pixel[BYTE1] << 8;
-                    value |= pixel[BYTE2] << 16;
-                    break;
-                default:
-                    assert(format->BytesPerPixel == 4);
-                    value = *(Uint32 *)pixel;
-            }
-            SDL_GetRGBA(value, surf->format, &r, &g, &b, &a);
-            if ((a >= min_alpha && has_colorkey == 0) ||
-                (has_colorkey != 0 && (r != keyr || g != keyg || b != keyb))) {
-                found_alpha = 1;
-                break;
-            }
-        }
-        if (found_alpha == 1) {
-            break;
-        }
+    else {
+        p_glTexSubImage2D(target, level, x, y, pixels->w, pixels->h, format,
+                          type, data);
     }
-    if (!pgSurface_Unlock((pgSurfaceObject *)self))
+
+    if (p_glBindBuffer)
+        p_glBindBuffer(PG_GL_PIXEL_UNPACK_BUFFER, (unsigned int)binding);
+    p_glPixelStorei(PG_GL_UNPACK_ROW_LENGTH, row_length);
+    p_glPixelStorei(PG_GL_UNPACK_ALIGNMENT, alignment);
+
+    if (pixels != surf)
+        SDL_FreeSurface(pixels);
+    if (!pgSurface_UnlockRead((pgSurfaceObject *)self))
         return RAISE(pgExc_SDLError, "could not unlock surface");
+    Py_RETURN_NONE;
+}
 
-    rect = pgRect_New4(min_x, min_y, max_x - min_x, max_y - min_y);
-    return rect;
+typedef struct {
+    SDL_Surface **surfs;
+    SDL_Rect *rects;
+    int min_alpha;
+} BoundsManyPass;
+
+static void
+bounding_rects_job(void *data, int index, int count)
+{
+    BoundsManyPass *pass = (BoundsManyPass *)data;
+
+    _bounds_scan(pass->surfs[index], pass->min_alpha, pass->rects + index);
 }
 
 static PyObject *
-_raise_get_view_ndim_error(int bitsize, SurfViewKind kind)
+surf_get_bounding_rects(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    const char *name = "<unknown>"; /* guard against a segfault */
+    PyObject *surfacesobj, *seq, *list = NULL, *rect;
+    BoundsManyPass pass;
+    Py_ssize_t count, locked = 0, i;
+    long long pixels = 0;
+    int min_alpha = 1;
+    static char *keywords[] = {"surfaces", "min_alpha", NULL};
 
-    /* Put a human readable name to a surface view kind */
-    switch (kind) {
-            /* This switch statement is exhaustive over the SurfViewKind enum
-             */
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|i", keywords,
+                                     &surfacesobj, &min_alpha))
+        return NULL;
 
-        case VIEWKIND_0D:
-            name = "contiguous bytes";
-            break;
-        case VIEWKIND_1D:
-            name = "contiguous pixels";
-            break;
-        case VIEWKIND_2D:
-            name = "2D";
-            break;
-        case VIEWKIND_3D:
-            name = "3D";
-            break;
-        case VIEWKIND_RED:
-            name = "red";
-            break;
-        case VIEWKIND_GREEN:
-            name = "green";
-            break;
-        case VIEWKIND_BLUE:
-            name = "blue";
-            break;
-        case VIEWKIND_ALPHA:
-            name = "alpha";
-            break;
+    seq = PySequence_Fast(surfacesobj, "surfaces must be a sequence");
+    if (!seq)
+        return NULL;
+    count = PySequence_Fast_GET_SIZE(seq);
+    pass.min_alpha = min_alpha;
+    pass.surfs = PyMem_New(SDL_Surface *, count ? count : 1);
+    pass.rects = PyMem_New(SDL_Rect, count ? count : 1);
+    if (!pass.surfs || !pass.rects) {
+        PyErr_NoMemory();
+        goto end;
+    }
+    for (i = 0; i < count; i++) {
+        PyObject *obj = PySequence_Fast_GET_ITEM(seq, i);
 
-#ifndef NDEBUG
-            /* Assert this switch statement is exhaustive */
-        default:
-            /* Should not be here */
-            PyErr_Format(PyExc_SystemError,
-                         "pygame bug in _raise_get_view_ndim_error:"
-                         " unknown view kind %d",
-                         (int)kind);
-            return 0;
-#endif
+        if (!pgSurface_Check(obj)) {
+            PyErr_SetString(PyExc_TypeError,
+                            "surfaces must only contain Surface objects");
+            goto end;
+        }
+        pass.surfs[i] = pgSurface_AsSurface(obj);
+        if (!pass.surfs[i]) {
+            PyErr_SetString(pgExc_SDLError, "display Surface quit");
+            goto end;
+        }
+        if (!pgSurface_Unpack(pass.surfs[i]))
+            goto end;
+        pixels += (long long)pass.surfs[i]->w * pass.surfs[i]->h;
+    }
+    for (; locked < count; locked++) {
+        if (!pgSurface_LockRead(
+                (pgSurfaceObject *)PySequence_Fast_GET_ITEM(seq, locked))) {
+            PyErr_SetString(pgExc_SDLError, "could not lock surface");
+            goto end;
+        }
     }
-    PyErr_Format(PyExc_ValueError,
-                 "unsupported bit depth %d for %s reference array", bitsize,
-                 name);
-    return 0;
+
+    Py_BEGIN_ALLOW_THREADS;
+    if (count > 1 && pixels >= PG_PARALLEL_MIN_PIXELS)
+        pg_ParallelFor(bounding_rects_job, &pass, (int)count);
+    else {
+        for (i = 0; i < count; i++) {
+            bounding_rects_job(&pass, (int)i, (int)count);
+        }
+    }
+    Py_END_ALLOW_THREADS;
+
+    list = PyList_New(count);
+    for (i = 0; list && i < count; i++) {
+        rect = pgRect_New(pass.rects + i);
+        if (!rect)
+            Py_CLEAR(list);
+        else
+            PyList_SET_ITEM(list, i, rect);
+    }
+
+end:
+    for (i = 0; i < locked; i++) {
+        pgSurface_UnlockRead(
+            (pgSurfaceObject *)PySequence_Fast_GET_ITEM(seq, i));
+    }
+    PyMem_Free(pass.surfs);
+    PyMem_Free(pass.rects);
+    Py_DECREF(seq);
+    return list;
 }
 
 static PyObject *
@@ -2889,22 +5549,15 @@ surf_get_view(PyObject *self, PyObject *args)
         case VIEWKIND_2D:
             get_buffer = _get_buffer_2D;
             break;
+        /* Color layouts a strided view cannot describe, such as 8 and 16
+           bit pixels, get a staged view instead. See _get_buffer_staged.
+        */
         case VIEWKIND_3D:
-            if (format->BytesPerPixel < 3) {
-                return _raise_get_view_ndim_error(format->BytesPerPixel * 8,
-                                                  view_kind);
-            }
-            if (format->Gmask != 0x00ff00 &&
-                (format->BytesPerPixel != 4 || format->Gmask != 0xff0000)) {
-                return RAISE(PyExc_ValueError,
-                             "unsupported colormasks for 3D reference array");
-            }
             get_buffer = _get_buffer_3D;
             break;
         case VIEWKIND_RED:
             mask = format->Rmask;
-            if (mask != 0x000000ffU && mask != 0x0000ff00U &&
-                mask != 0x00ff0000U && mask != 0xff000000U) {
+            if (!mask && !format->palette) {
                 return RAISE(PyExc_ValueError,
                              "unsupported colormasks for red reference array");
             }
@@ -2912,8 +5565,7 @@ surf_get_view(PyObject *self, PyObject *args)
             break;
         case VIEWKIND_GREEN:
             mask = format->Gmask;
-            if (mask != 0x000000ffU && mask != 0x0000ff00U &&
-                mask != 0x00ff0000U && mask != 0xff000000U) {
+            if (!mask && !format->palette) {
                 return RAISE(
                     PyExc_ValueError,
                     "unsupported colormasks for green reference array");
@@ -2922,8 +5574,7 @@ surf_get_view(PyObject *self, PyObject *args)
             break;
         case VIEWKIND_BLUE:
             mask = format->Bmask;
-            if (mask != 0x000000ffU && mask != 0x0000ff00U &&
-                mask != 0x00ff0000U && mask != 0xff000000U) {
+            if (!mask && !format->palette) {
                 return RAISE(
                     PyExc_ValueError,
                     "unsupported colormasks for blue reference array");
@@ -2932,8 +5583,7 @@ surf_get_view(PyObject *self, PyObject *args)
             break;
         case VIEWKIND_ALPHA:
             mask = format->Amask;
-            if (mask != 0x000000ffU && mask != 0x0000ff00U &&
-                mask != 0x00ff0000U && mask != 0xff000000U) {
+            if (!mask) {
                 return RAISE(
                     PyExc_ValueError,
                     "unsupported colormasks for alpha reference array");
@@ -3148,12 +5798,48 @@ _get_buffer_2D(PyObject *obj, Py_buffer *view_p, int flags)
     return 0;
 }
 
+/* Returns the byte offset within a pixel of an 8 bit color component, or -1
+   if the component does not fill a whole byte. */
+static int
+_get_mask_offset(Uint32 mask, int pixelsize)
+{
+    int offset;
+
+    switch (mask) {
+        case 0x000000ffU:
+            offset = 0;
+            break;
+        case 0x0000ff00U:
+            offset = 1;
+            break;
+        case 0x00ff0000U:
+            offset = 2;
+            break;
+        case 0xff000000U:
+            offset = 3;
+            break;
+        default:
+            return -1;
+    }
+    if (offset >= pixelsize) {
+        return -1;
+    }
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    return offset;
+#else
+    return pixelsize - 1 - offset;
+#endif
+}
+
 static int
 _get_buffer_3D(PyObject *obj, Py_buffer *view_p, int flags)
 {
     SDL_Surface *surface = pgSurface_AsSurface(obj);
-    int pixelsize = surface->format->BytesPerPixel;
-    char *startpixel = (char *)surface->pixels;
+    SDL_PixelFormat *format = surface->format;
+    int pixelsize = format->BytesPerPixel;
+    int r = _get_mask_offset(format->Rmask, pixelsize);
+    int g = _get_mask_offset(format->Gmask, pixelsize);
+    int b = _get_mask_offset(format->Bmask, pixelsize);
 
     view_p->obj = 0;
     if (!PyBUF_HAS_FLAG(flags, PyBUF_STRIDES)) {
@@ -3168,6 +5854,10 @@ _get_buffer_3D(PyObject *obj, Py_buffer *view_p, int flags)
                         "A 3D surface view is not contiguous");
         return -1;
     }
+    /* The components must be whole bytes an equal step apart */
+    if (r < 0 || g < 0 || b < 0 || g == r || g - r != b - g) {
+        return _get_buffer_staged(obj, view_p, flags, VIEWKIND_3D);
+    }
     if (_init_buffer(obj, view_p, flags)) {
         return -1;
     }
@@ -3183,44 +5873,8 @@ _get_buffer_3D(PyObject *obj, Py_buffer *view_p, int flags)
     view_p->shape[2] = 3;
     view_p->strides[0] = pixelsize;
     view_p->strides[1] = surface->pitch;
-    switch (surface->format->Rmask) {
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-        case 0xffU:
-            view_p->strides[2] = 1;
-            break;
-        case 0xff00U:
-            assert(pixelsize == 4);
-            view_p->strides[2] = 1;
-            startpixel += 1;
-            break;
-        case 0xff0000U:
-            view_p->strides[2] = -1;
-            startpixel += 2;
-            break;
-        default: /* 0xff000000U */
-            assert(pixelsize == 4);
-            view_p->strides[2] = -1;
-            startpixel += 3;
-#else  /* SDL_BYTEORDER != SDL_LIL_ENDIAN */
-        case 0xffU:
-            view_p->strides[2] = -1;
-            startpixel += pixelsize - 1;
-            break;
-        case 0xff00U:
-            assert(pixelsize == 4);
-            view_p->strides[2] = -1;
-            startpixel += pixelsize - 2;
-            break;
-        case 0xff0000U:
-            view_p->strides[2] = 1;
-            startpixel += pixelsize - 3;
-            break;
-        default: /* 0xff000000U */
-            assert(pixelsize == 4);
-            view_p->strides[2] = 1;
-#endif /* SDL_BYTEORDER != SDL_LIL_ENDIAN */
-    }
-    view_p->buf = startpixel;
+    view_p->strides[2] = g - r;
+    view_p->buf = (char *)surface->pixels + r;
     Py_INCREF(obj);
     view_p->obj = obj;
     return 0;
@@ -3229,38 +5883,38 @@ _get_buffer_3D(PyObject *obj, Py_buffer *view_p, int flags)
 static int
 _get_buffer_red(PyObject *obj, Py_buffer *view_p, int flags)
 {
-    return _get_buffer_colorplane(obj, view_p, flags, "red",
+    return _get_buffer_colorplane(obj, view_p, flags, VIEWKIND_RED,
                                   pgSurface_AsSurface(obj)->format->Rmask);
 }
 
 static int
 _get_buffer_green(PyObject *obj, Py_buffer *view_p, int flags)
 {
-    return _get_buffer_colorplane(obj, view_p, flags, "green",
+    return _get_buffer_colorplane(obj, view_p, flags, VIEWKIND_GREEN,
                                   pgSurface_AsSurface(obj)->format->Gmask);
 }
 
 static int
 _get_buffer_blue(PyObject *obj, Py_buffer *view_p, int flags)
 {
-    return _get_buffer_colorplane(obj, view_p, flags, "blue",
+    return _get_buffer_colorplane(obj, view_p, flags, VIEWKIND_BLUE,
                                   pgSurface_AsSurface(obj)->format->Bmask);
 }
 
 static int
 _get_buffer_alpha(PyObject *obj, Py_buffer *view_p, int flags)
 {
-    return _get_buffer_colorplane(obj, view_p, flags, "alpha",
+    return _get_buffer_colorplane(obj, view_p, flags, VIEWKIND_ALPHA,
                                   pgSurface_AsSurface(obj)->format->Amask);
 }
 
 static int
-_get_buffer_colorplane(PyObject *obj, Py_buffer *view_p, int flags, char *name,
-                       Uint32 mask)
+_get_buffer_colorplane(PyObject *obj, Py_buffer *view_p, int flags,
+                       SurfViewKind view_kind, Uint32 mask)
 {
     SDL_Surface *surface = pgSurface_AsSurface(obj);
     int pixelsize = surface->format->BytesPerPixel;
-    char *startpixel = (char *)surface->pixels;
+    int offset = _get_mask_offset(mask, pixelsize);
 
     view_p->obj = 0;
     if (!PyBUF_HAS_FLAG(flags, PyBUF_STRIDES)) {
@@ -3276,51 +5930,13 @@ _get_buffer_colorplane(PyObject *obj, Py_buffer *view_p, int flags, char *name,
                         "A surface color plane view is not contiguous");
         return -1;
     }
-    switch (mask) {
-        /* This switch statement is exhaustive over possible mask value,
-           the allowable masks for 24 bit and 32 bit surfaces */
-
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-        case 0x000000ffU:
-            break;
-        case 0x0000ff00U:
-            startpixel += 1;
-            break;
-        case 0x00ff0000U:
-            startpixel += 2;
-            break;
-        case 0xff000000U:
-            startpixel += 3;
-            break;
-#else  /* SDL_BYTEORDER != SDL_LIL_ENDIAN */
-        case 0x000000ffU:
-            startpixel += pixelsize - 1;
-            break;
-        case 0x0000ff00U:
-            startpixel += pixelsize - 2;
-            break;
-        case 0x00ff0000U:
-            startpixel += pixelsize - 3;
-            break;
-        case 0xff000000U:
-            break;
-#endif /* SDL_BYTEORDER != SDL_LIL_ENDIAN */
-
-#ifndef NDEBUG
-            /* Assert this switch statement is exhaustive */
-        default:
-            /* Should not be here */
-            PyErr_Format(PyExc_SystemError,
-                         "Pygame bug caught at line %i in file %s: "
-                         "unknown mask value %p. Please report",
-                         (int)__LINE__, __FILE__, (void *)mask);
-            return -1;
-#endif
+    if (offset < 0) {
+        return _get_buffer_staged(obj, view_p, flags, view_kind);
     }
     if (_init_buffer(obj, view_p, flags)) {
         return -1;
     }
-    view_p->buf = startpixel;
+    view_p->buf = (char *)surface->pixels + offset;
     if (PyBUF_HAS_FLAG(flags, PyBUF_FORMAT)) {
         view_p->format = FormatUint8;
     }
@@ -3337,6 +5953,118 @@ _get_buffer_colorplane(PyObject *obj, Py_buffer *view_p, int flags, char *name,
     return 0;
 }
 
+static Uint32
+_get_view_pixel(const Uint8 *p, int pixelsize)
+{
+    switch (pixelsize) {
+        case 1:
+            return *p;
+        case 2:
+            return *(const Uint16 *)p;
+        case 3:
+            return GET_PIXEL_24(p);
+        default:
+            return *(const Uint32 *)p;
+    }
+}
+
+static void
+_set_view_pixel(Uint8 *p, int pixelsize, Uint32 pixel)
+{
+    switch (pixelsize) {
+        case 1:
+            *p = (Uint8)pixel;
+            break;
+        case 2:
+            *(Uint16 *)p = (Uint16)pixel;
+            break;
+        case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            p[0] = (Uint8)pixel;
+            p[1] = (Uint8)(pixel >> 8);
+            p[2] = (Uint8)(pixel >> 16);
+#else
+            p[0] = (Uint8)(pixel >> 16);
+            p[1] = (Uint8)(pixel >> 8);
+            p[2] = (Uint8)pixel;
+#endif
+            break;
+        default:
+            *(Uint32 *)p = pixel;
+    }
+}
+
+/* A staged view stands in for a 3D or color plane view whose components
+   are not whole, evenly spaced bytes, as with 8 and 16 bit surfaces. The
+   components are unpacked into a separate array of shape (w, h, 3) or
+   (w, h) when the buffer is acquired. Any that were changed are packed
+   back into the pixels when the buffer is released, so changes show up on
+   the surface only after that.
+*/
+static int
+_get_buffer_staged(PyObject *obj, Py_buffer *view_p, int flags,
+                   SurfViewKind view_kind)
+{
+    SDL_Surface *surface = pgSurface_AsSurface(obj);
+    SDL_PixelFormat *format = surface->format;
+    int pixelsize = format->BytesPerPixel;
+    int ncomps = view_kind == VIEWKIND_3D ? 3 : 1;
+    int comp = view_kind == VIEWKIND_3D ? 0 : (int)view_kind - VIEWKIND_RED;
+    Py_ssize_t len = (Py_ssize_t)surface->w * surface->h * ncomps;
+    pg_bufferinternal *internal;
+    Uint8 *staged;
+    Uint8 *dst;
+    Uint8 *row;
+    Uint8 rgba[4];
+    int x, y;
+
+    /* The second half keeps the unpacked values to find changes */
+    staged = (Uint8 *)PyMem_Malloc(len ? 2 * len : 1);
+    if (!staged) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    if (_init_buffer(obj, view_p, flags)) {
+        PyMem_Free(staged);
+        return -1;
+    }
+    dst = staged;
+    for (y = 0; y < surface->h; ++y) {
+        row = (Uint8 *)surface->pixels + (Py_ssize_t)surface->pitch * y;
+        for (x = 0; x < surface->w; ++x) {
+            SDL_GetRGBA(_get_view_pixel(row + pixelsize * x, pixelsize),
+                        format, rgba, rgba + 1, rgba + 2, rgba + 3);
+            memcpy(dst, rgba + comp, ncomps);
+            dst += ncomps;
+        }
+    }
+    memcpy(staged + len, staged, len);
+    internal = (pg_bufferinternal *)view_p->internal;
+    internal->staged = staged;
+    internal->staged_kind = view_kind;
+    ((pg_buffer *)view_p)->release_buffer = _release_staged_buffer;
+
+    view_p->buf = staged;
+    if (PyBUF_HAS_FLAG(flags, PyBUF_FORMAT)) {
+        view_p->format = FormatUint8;
+    }
+    view_p->itemsize = 1;
+    view_p->ndim = view_kind == VIEWKIND_3D ? 3 : 2;
+    view_p->readonly = 0;
+    view_p->len = len;
+    view_p->shape[0] = surface->w;
+    view_p->shape[1] = surface->h;
+    view_p->strides[0] = ncomps;
+    view_p->strides[1] = (Py_ssize_t)surface->w * ncomps;
+    if (ncomps == 3) {
+        view_p->shape[2] = 3;
+        view_p->strides[2] = 1;
+    }
+    Py_INCREF(obj);
+    view_p->obj = obj;
+    return 0;
+}
+
 static int
 _init_buffer(PyObject *surf, Py_buffer *view_p, int flags)
 {
@@ -3384,6 +6112,7 @@ _init_buffer(PyObject *surf, Py_buffer *view_p, int flags)
     view_p->ndim = 0;
     view_p->format = 0;
     view_p->suboffsets = 0;
+    internal->staged = NULL;
     view_p->internal = internal;
     ((pg_buffer *)view_p)->release_buffer = _release_buffer;
     return 0;
@@ -3412,6 +6141,46 @@ _release_buffer(Py_buffer *view_p)
     view_p->obj = 0;
 }
 
+static void
+_release_staged_buffer(Py_buffer *view_p)
+{
+    pg_bufferinternal *internal = (pg_bufferinternal *)view_p->internal;
+    SDL_Surface *surface = pgSurface_AsSurface(view_p->obj);
+    int ncomps = internal->staged_kind == VIEWKIND_3D ? 3 : 1;
+    int comp = ncomps == 3 ? 0 : (int)internal->staged_kind - VIEWKIND_RED;
+    Uint8 *src = internal->staged;
+    Uint8 *orig = src + view_p->len;
+    SDL_PixelFormat *format;
+    int pixelsize;
+    Uint8 *pix;
+    Uint8 rgba[4];
+    int x, y;
+
+    /* The surface may have been freed, as by pygame.display.quit() */
+    if (surface && surface->pixels) {
+        format = surface->format;
+        pixelsize = format->BytesPerPixel;
+        for (y = 0; y < surface->h; ++y) {
+            pix = (Uint8 *)surface->pixels + (Py_ssize_t)surface->pitch * y;
+            for (x = 0; x < surface->w; ++x) {
+                if (memcmp(src, orig, ncomps)) {
+                    SDL_GetRGBA(_get_view_pixel(pix, pixelsize), format, rgba,
+                                rgba + 1, rgba + 2, rgba + 3);
+                    memcpy(rgba + comp, src, ncomps);
+                    _set_view_pixel(pix, pixelsize,
+                                    SDL_MapRGBA(format, rgba[0], rgba[1],
+                                                rgba[2], rgba[3]));
+                }
+                src += ncomps;
+                orig += ncomps;
+                pix += pixelsize;
+            }
+        }
+    }
+    PyMem_Free(internal->staged);
+    _release_buffer(view_p);
+}
+
 static int
 _view_kind(PyObject *obj, void *view_kind_vptr)
 {
@@ -3490,6 +6259,11 @@ surf_get_pixels_address(PyObject *self, PyObject *closure)
     if (!surface->pixels) {
         return PyLong_FromLong(0L);
     }
+    /* the address may be written through at any time */
+    if (!pgSurface_Unshare(surface)) {
+        return NULL;
+    }
+    surface->flags |= PG_SURF_PINNED;
     address = surface->pixels;
 #if SIZEOF_VOID_P > SIZEOF_LONG
     return PyLong_FromUnsignedLongLong((unsigned PY_LONG_LONG)address);
@@ -3515,6 +6289,33 @@ surface_move(Uint8 *src, Uint8 *dst, int h, int span, int srcpitch,
     }
 }
 
+/* Rotate the w x h pixel block at pixels right by dx and down by dy, with
+ * 0 <= dx < w and 0 <= dy < h, so whatever leaves one edge comes back in
+ * at the opposite one. Returns -1 if the temporary copy cannot be made.
+ */
+static int
+surface_wrap(Uint8 *pixels, int w, int h, int bpp, int pitch, int dx, int dy)
+{
+    size_t span = (size_t)w * bpp;
+    size_t head = (size_t)(w - dx) * bpp;
+    Uint8 *copy, *row;
+    int y;
+
+    copy = (Uint8 *)PyMem_Malloc(span * h);
+    if (!copy)
+        return -1;
+    for (y = 0; y < h; ++y) {
+        memcpy(copy + y * span, pixels + y * pitch, span);
+    }
+    for (y = 0; y < h; ++y) {
+        row = copy + ((y - dy + h) % h) * span;
+        memcpy(pixels + y * pitch + dx * bpp, row, head);
+        memcpy(pixels + y * pitch, row + head, span - head);
+    }
+    PyMem_Free(copy);
+    return 0;
+}
+
 static int
 surface_do_overlap(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                    SDL_Rect *dstrect)
@@ -3598,52 +6399,135 @@ surface_do_overlap(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
 }
 
 /*this internal blit function is accessible through the C api*/
-int
-pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
-               SDL_Rect *dstrect, SDL_Rect *srcrect, int the_args)
+/* Redirect a blit onto a subsurface to its top level owner, clipping to
+   the subsurface area. Blit coordinates must be shifted by the returned
+   offsets. */
+static void
+surface_blit_target_begin(pgSurfaceObject *dstobj, pgBlitTarget *target)
 {
-    SDL_Surface *src = pgSurface_AsSurface(srcobj);
     SDL_Surface *dst = pgSurface_AsSurface(dstobj);
-    SDL_Surface *subsurface = NULL;
-    int result, suboffsetx = 0, suboffsety = 0;
-    SDL_Rect orig_clip, sub_clip;
-    Uint8 alpha;
-    Uint32 key;
+    SDL_Rect sub_clip;
+
+    target->surf = dst;
+    target->owner = NULL;
+    target->offsetx = target->offsety = 0;
 
     /* passthrough blits to the real surface */
-    if (((pgSurfaceObject *)dstobj)->subsurface) {
+    if (dstobj->subsurface) {
         PyObject *owner;
         struct pgSubSurface_Data *subdata;
 
-        subdata = ((pgSurfaceObject *)dstobj)->subsurface;
+        subdata = dstobj->subsurface;
         owner = subdata->owner;
-        subsurface = pgSurface_AsSurface(owner);
-        suboffsetx = subdata->offsetx;
-        suboffsety = subdata->offsety;
+        target->owner = pgSurface_AsSurface(owner);
+        target->offsetx = subdata->offsetx;
+        target->offsety = subdata->offsety;
 
         while (((pgSurfaceObject *)owner)->subsurface) {
             subdata = ((pgSurfaceObject *)owner)->subsurface;
             owner = subdata->owner;
-            subsurface = pgSurface_AsSurface(owner);
-            suboffsetx += subdata->offsetx;
-            suboffsety += subdata->offsety;
+            target->owner = pgSurface_AsSurface(owner);
+            target->offsetx += subdata->offsetx;
+            target->offsety += subdata->offsety;
         }
 
-        SDL_GetClipRect(subsurface, &orig_clip);
+        SDL_GetClipRect(target->owner, &target->orig_clip);
         SDL_GetClipRect(dst, &sub_clip);
-        sub_clip.x += suboffsetx;
-        sub_clip.y += suboffsety;
-        SDL_SetClipRect(subsurface, &sub_clip);
-        dstrect->x += suboffsetx;
-        dstrect->y += suboffsety;
-        dst = subsurface;
+        sub_clip.x += target->offsetx;
+        sub_clip.y += target->offsety;
+        SDL_SetClipRect(target->owner, &sub_clip);
+        target->surf = target->owner;
     }
     else {
         pgSurface_Prep(dstobj);
-        subsurface = NULL;
     }
+}
 
-    pgSurface_Prep(srcobj);
+static void
+surface_blit_target_end(pgSurfaceObject *dstobj, pgBlitTarget *target)
+{
+    if (target->owner)
+        SDL_SetClipRect(target->owner, &target->orig_clip);
+    else
+        pgSurface_Unprep(dstobj);
+}
+
+/* Plain blits of premultiplied surfaces use the premultiplied blitter,
+   which has no surface alpha or colorkey support. */
+static int
+surface_blit_args(SDL_Surface *src, int the_args)
+{
+    Uint8 alpha;
+    Uint32 key;
+
+    if (the_args == 0 && (src->flags & PG_SURF_PREMULTIPLIED) &&
+        _PgSurface_SrcAlpha(src) == 1 &&
+        SDL_GetSurfaceAlphaMod(src, &alpha) == 0 && alpha == 255 &&
+        SDL_GetColorKey(src, &key) != 0) {
+        return PYGAME_BLEND_PREMULTIPLIED;
+    }
+    return the_args;
+}
+
+/* If we have a 32bit source surface with per pixel alpha and no RLE we'll
+   use pygame_Blit so we can mimic how SDL1 behaved */
+static int
+surface_blit_pygame_alpha(SDL_Surface *src, SDL_Surface *dst, int the_args)
+{
+    Uint32 key;
+
+    return the_args != PYGAME_BLEND_ALPHA_SDL2 &&
+           !(pg_EnvShouldBlendAlphaSDL2()) &&
+           SDL_GetColorKey(src, &key) != 0 &&
+           (dst->format->BytesPerPixel == 4 ||
+            dst->format->BytesPerPixel == 2) &&
+           _PgSurface_SrcAlpha(src) &&
+           (SDL_ISPIXELFORMAT_ALPHA(src->format->format)) &&
+           !pg_HasSurfaceRLE(src) && !pg_HasSurfaceRLE(dst) &&
+           !(src->flags & SDL_RLEACCEL) && !(dst->flags & SDL_RLEACCEL);
+}
+
+/* Plain blits of 8 bit surfaces to 32 bit ones use pygame_Blit, which
+   looks the pixels up in a cached table of the palette */
+static int
+surface_blit_pygame_palette(SDL_Surface *src, SDL_Surface *dst, int the_args)
+{
+    Uint8 alpha;
+    SDL_BlendMode mode;
+
+    return the_args == 0 && src->format->BytesPerPixel == 1 &&
+           src->format->palette && dst->format->BytesPerPixel == 4 &&
+           SDL_GetSurfaceAlphaMod(src, &alpha) == 0 && alpha == 255 &&
+           SDL_GetSurfaceBlendMode(src, &mode) == 0 &&
+           mode == SDL_BLENDMODE_NONE && !pg_HasSurfaceRLE(src) &&
+           !pg_HasSurfaceRLE(dst) && !(src->flags & SDL_RLEACCEL) &&
+           !(dst->flags & SDL_RLEACCEL);
+}
+
+/* Whether the pixel memory of two surfaces may overlap */
+static int
+surface_pixels_overlap(SDL_Surface *a, SDL_Surface *b)
+{
+    Uint8 *a_start = (Uint8 *)a->pixels;
+    Uint8 *b_start = (Uint8 *)b->pixels;
+
+    return a_start < b_start + (size_t)b->h * b->pitch &&
+           b_start < a_start + (size_t)a->h * a->pitch;
+}
+
+/* Pick and run the blitter for two prepared surfaces. This touches no
+   Python objects, so it may be called with the GIL released.
+   Returns 0 on success, -1 on SDL error and -2 if a surface was lost. */
+static int
+surface_blit_prepared(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
+                      SDL_Rect *dstrect, int the_args,
+                      const pgBlitSpans *spans)
+{
+    int result;
+    Uint8 alpha;
+    Uint32 key;
+
+    the_args = surface_blit_args(src, the_args);
 
     if ((the_args != 0 && the_args != PYGAME_BLEND_ALPHA_SDL2) ||
         ((SDL_GetColorKey(src, &key) == 0 || _PgSurface_SrcAlpha(src) == 1) &&
@@ -3655,7 +6539,7 @@ pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
          dst->pixels == src->pixels &&
          surface_do_overlap(src, srcrect, dst, dstrect))) {
         /* Py_BEGIN_ALLOW_THREADS */
-        result = pygame_Blit(src, srcrect, dst, dstrect, the_args);
+        result = pygame_Blit(src, srcrect, dst, dstrect, the_args, spans);
         /* Py_END_ALLOW_THREADS */
     }
     /* can't blit alpha to 8bit, crashes SDL */
@@ -3664,7 +6548,7 @@ pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
               ((SDL_GetSurfaceAlphaMod(src, &alpha) == 0 && alpha != 255)))) {
         /* Py_BEGIN_ALLOW_THREADS */
         if (src->format->BytesPerPixel == 1) {
-            result = pygame_Blit(src, srcrect, dst, dstrect, 0);
+            result = pygame_Blit(src, srcrect, dst, dstrect, 0, NULL);
         }
         else {
             SDL_PixelFormat *fmt = src->format;
@@ -3696,35 +6580,65 @@ pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
         }
         /* Py_END_ALLOW_THREADS */
     }
-    else if (the_args != PYGAME_BLEND_ALPHA_SDL2 &&
-             !(pg_EnvShouldBlendAlphaSDL2()) &&
-             SDL_GetColorKey(src, &key) != 0 &&
-             (dst->format->BytesPerPixel == 4 ||
-              dst->format->BytesPerPixel == 2) &&
-             _PgSurface_SrcAlpha(src) &&
-             (SDL_ISPIXELFORMAT_ALPHA(src->format->format)) &&
-             !pg_HasSurfaceRLE(src) && !pg_HasSurfaceRLE(dst) &&
-             !(src->flags & SDL_RLEACCEL) && !(dst->flags & SDL_RLEACCEL)) {
-        /* If we have a 32bit source surface with per pixel alpha
-           and no RLE we'll use pygame_Blit so we can mimic how SDL1
-            behaved */
-        result = pygame_Blit(src, srcrect, dst, dstrect, the_args);
+    else if (surface_blit_pygame_alpha(src, dst, the_args) ||
+             surface_blit_pygame_palette(src, dst, the_args) ||
+             (spans && spans->mode == PG_SPANS_KEY)) {
+        /* colorkey spans are only made for blits pygame_Blit does the same
+           as SDL */
+        result = pygame_Blit(src, srcrect, dst, dstrect, the_args, spans);
     }
     else {
+        Uint64 start = pg_StatsBegin();
+
         /* Py_BEGIN_ALLOW_THREADS */
         result = SDL_BlitSurface(src, srcrect, dst, dstrect);
         /* Py_END_ALLOW_THREADS */
+        /* dstrect is clipped to the area SDL blitted */
+        pg_StatsEnd(PG_STAT_BLIT, "sdl", start,
+                    (Sint64)dstrect->w * dstrect->h);
     }
 
-    if (subsurface) {
-        SDL_SetClipRect(subsurface, &orig_clip);
-        dstrect->x -= suboffsetx;
-        dstrect->y -= suboffsety;
-    }
-    else
-        pgSurface_Unprep(dstobj);
+    return result;
+}
+
+int
+pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
+               SDL_Rect *dstrect, SDL_Rect *srcrect, int the_args)
+{
+    SDL_Surface *src = pgSurface_AsSurface(srcobj);
+    pgBlitTarget target;
+    PyObject *spans, *shadow;
+    int result;
+
+    if (!pgSurface_Unpack(src) ||
+        surface_get_shadow(srcobj, pgSurface_AsSurface(dstobj), the_args,
+                           &shadow))
+        return 1;
+    if (!pgSurface_Unshare(pgSurface_AsSurface(dstobj))) {
+        Py_XDECREF(shadow);
+        return 1;
+    }
+    if (shadow)
+        src = SURFACE_SHADOW(shadow);
+    surface_blit_target_begin(dstobj, &target);
+    dstrect->x += target.offsetx;
+    dstrect->y += target.offsety;
+    pgSurface_Prep(srcobj);
+
+    spans = surface_get_spans(src, target.surf,
+                              surface_blit_args(src, the_args));
+    result = surface_blit_prepared(src, srcrect, target.surf, dstrect,
+                                   the_args, SURFACE_SPANS(spans));
+    Py_XDECREF(spans);
+    Py_XDECREF(shadow);
+
+    dstrect->x -= target.offsetx;
+    dstrect->y -= target.offsety;
+    surface_blit_target_end(dstobj, &target);
     pgSurface_Unprep(srcobj);
 
+    if (result == 0)
+        pgSurface_AddDamage(dstobj, dstrect);
     if (result == -1)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
     if (result == -2)
@@ -3733,77 +6647,1068 @@ pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
     return result != 0;
 }
 
-static PyMethodDef _surface_methods[] = {{NULL, NULL, 0, NULL}};
+/* SurfacePool: idle pixel buffers kept for surfaces of the same size and
+ * format. A pooled surface borrows its buffer, so it carries SDL_PREALLOC
+ * and PG_SURF_POOLED, and holds a reference to its pool in userdata until
+ * pgSurfacePool_FreeSurface gives the buffer back.
+ */
+typedef struct {
+    void *pixels;
+    Uint32 format;
+    int w;
+    int h;
+} pgPoolBuffer;
 
-MODINIT_DEFINE(surface)
+typedef struct {
+    PyObject_HEAD pgPoolBuffer *buffers; /* idle buffers, oldest first */
+    Py_ssize_t count;
+    Py_ssize_t max_buffers;
+    Py_ssize_t hits;
+    Py_ssize_t misses;
+} pgSurfacePoolObject;
+
+static void *
+_pool_alloc(size_t size)
 {
-    PyObject *module, *apiobj;
-    static void *c_api[PYGAMEAPI_SURFACE_NUMSLOTS];
+#ifdef SDL_SIMD_ALIGNED
+    return SDL_SIMDAlloc(size);
+#else
+    return SDL_malloc(size);
+#endif
+}
 
-    static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
-                                         "surface",
-                                         DOC_PYGAMESURFACE,
-                                         -1,
-                                         _surface_methods,
-                                         NULL,
-                                         NULL,
-                                         NULL,
-                                         NULL};
+static void
+_pool_free(void *pixels)
+{
+#ifdef SDL_SIMD_ALIGNED
+    SDL_SIMDFree(pixels);
+#else
+    SDL_free(pixels);
+#endif
+}
 
-    /* imported needed apis; Do this first so if there is an error
-       the module is not loaded.
-    */
-    import_pygame_base();
-    if (PyErr_Occurred()) {
-        return NULL;
+static void
+_pool_clear(pgSurfacePoolObject *self)
+{
+    while (self->count > 0)
+        _pool_free(self->buffers[--self->count].pixels);
+}
+
+/* Create a w x h surface like SDL_CreateRGBSurface, with its pixels taken
+ * from pool when it is not NULL. Recycled pixels are cleared, so the
+ * result is the same either way. Returns NULL with a Python exception set
+ * on failure.
+ */
+static SDL_Surface *
+pgSurfacePool_CreateSurface(PyObject *pool, int w, int h, int depth,
+                            Uint32 Rmask, Uint32 Gmask, Uint32 Bmask,
+                            Uint32 Amask)
+{
+    pgSurfacePoolObject *self = (pgSurfacePoolObject *)pool;
+    SDL_Surface *surf;
+    Uint32 format = SDL_PIXELFORMAT_UNKNOWN;
+    void *pixels = NULL;
+    size_t size;
+    int pitch = 0;
+    Py_ssize_t i;
+
+    if (pool && depth >= 8 && w > 0 && h > 0 &&
+        (Sint64)w * ((depth + 7) / 8) < INT_MAX - 3) {
+        format = SDL_MasksToPixelFormatEnum(depth, Rmask, Gmask, Bmask, Amask);
+        pitch = (w * ((depth + 7) / 8) + 3) & ~3;
+    }
+    if (format == SDL_PIXELFORMAT_UNKNOWN) {
+        surf = SDL_CreateRGBSurface(0, w, h, depth, Rmask, Gmask, Bmask,
+                                    Amask);
+        if (!surf)
+            PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        return surf;
     }
-    import_pygame_color();
-    if (PyErr_Occurred()) {
-        return NULL;
+
+    size = (size_t)pitch * h;
+    for (i = self->count - 1; i >= 0; i--) {
+        pgPoolBuffer *buffer = self->buffers + i;
+
+        if (buffer->format == format && buffer->w == w && buffer->h == h) {
+            pixels = buffer->pixels;
+            memmove(buffer, buffer + 1,
+                    (self->count - i - 1) * sizeof(pgPoolBuffer));
+            self->count--;
+            break;
+        }
     }
-    import_pygame_rect();
-    if (PyErr_Occurred()) {
-        return NULL;
+    if (pixels) {
+        self->hits++;
+        memset(pixels, 0, size);
     }
-    import_pygame_bufferproxy();
-    if (PyErr_Occurred()) {
-        return NULL;
+    else {
+        self->misses++;
+        pixels = _pool_alloc(size);
+        if (!pixels)
+            return (SDL_Surface *)PyErr_NoMemory();
+        memset(pixels, 0, size);
     }
-    _IMPORT_PYGAME_MODULE(surflock);
-    if (PyErr_Occurred()) {
-        return NULL;
+
+    surf = SDL_CreateRGBSurfaceFrom(pixels, w, h, depth, pitch, Rmask,
+                                    Gmask, Bmask, Amask);
+    if (!surf) {
+        _pool_free(pixels);
+        return (SDL_Surface *)RAISE(pgExc_SDLError, SDL_GetError());
     }
+    surf->flags |= PG_SURF_POOLED;
+    surf->userdata = pool;
+    Py_INCREF(pool);
+    return surf;
+}
 
-    /* type preparation */
-    if (PyType_Ready(&pgSurface_Type) < 0) {
-        return NULL;
+/* SDL_FreeSurface, giving the pixels of a pooled surface back to its pool.
+ * The oldest idle buffer makes room when the pool is full.
+ */
+static void
+pgSurfacePool_FreeSurface(SDL_Surface *surf)
+{
+    pgSurfacePoolObject *pool;
+    pgPoolBuffer *buffer;
+
+    if (!surf || !(surf->flags & PG_SURF_POOLED) || surf->refcount > 1) {
+        SDL_FreeSurface(surf);
+        return;
+    }
+    pool = (pgSurfacePoolObject *)surf->userdata;
+    if (pool->max_buffers < 1) {
+        _pool_free(surf->pixels);
     }
+    else {
+        if (pool->count == pool->max_buffers) {
+            _pool_free(pool->buffers[0].pixels);
+            memmove(pool->buffers, pool->buffers + 1,
+                    (pool->count - 1) * sizeof(pgPoolBuffer));
+            pool->count--;
+        }
+        buffer = pool->buffers + pool->count++;
+        buffer->pixels = surf->pixels;
+        buffer->format = surf->format->format;
+        buffer->w = surf->w;
+        buffer->h = surf->h;
+    }
+    surf->pixels = NULL;
+    surf->flags &= ~PG_SURF_POOLED;
+    surf->userdata = NULL;
+    SDL_FreeSurface(surf);
+    Py_DECREF(pool);
+}
 
-    /* create the module */
-    module = PyModule_Create(&_module);
-    if (module == NULL) {
-        return NULL;
+static int
+surface_pool_init(pgSurfacePoolObject *self, PyObject *args, PyObject *kwds)
+{
+    Py_ssize_t max_buffers = 16;
+    pgPoolBuffer *buffers;
+    static char *kwids[] = {"max_buffers", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|n", kwids, &max_buffers))
+        return -1;
+    if (max_buffers < 0) {
+        PyErr_SetString(PyExc_ValueError, "max_buffers must not be negative");
+        return -1;
     }
-    Py_INCREF(&pgSurface_Type);
-    if (PyModule_AddObject(module, "SurfaceType",
-                           (PyObject *)&pgSurface_Type)) {
-        Py_DECREF(&pgSurface_Type);
-        Py_DECREF(module);
-        return NULL;
+
+    buffers = PyMem_New(pgPoolBuffer, max_buffers ? max_buffers : 1);
+    if (!buffers) {
+        PyErr_NoMemory();
+        return -1;
     }
+    _pool_clear(self);
+    PyMem_Free(self->buffers);
+    self->buffers = buffers;
+    self->max_buffers = max_buffers;
+    self->hits = self->misses = 0;
+    return 0;
+}
 
-    Py_INCREF(&pgSurface_Type);
+static void
+surface_pool_dealloc(pgSurfacePoolObject *self)
+{
+    _pool_clear(self);
+    PyMem_Free(self->buffers);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+surface_pool_clear(pgSurfacePoolObject *self, PyObject *_null)
+{
+    _pool_clear(self);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surface_pool_get_hits(pgSurfacePoolObject *self, void *closure)
+{
+    return PyLong_FromSsize_t(self->hits);
+}
+
+static PyObject *
+surface_pool_get_misses(pgSurfacePoolObject *self, void *closure)
+{
+    return PyLong_FromSsize_t(self->misses);
+}
+
+static PyObject *
+surface_pool_get_idle(pgSurfacePoolObject *self, void *closure)
+{
+    return PyLong_FromSsize_t(self->count);
+}
+
+static PyObject *
+surface_pool_get_max_buffers(pgSurfacePoolObject *self, void *closure)
+{
+    return PyLong_FromSsize_t(self->max_buffers);
+}
+
+static PyMethodDef surface_pool_methods[] = {
+    {"clear", (PyCFunction)surface_pool_clear, METH_NOARGS,
+     DOC_SURFACEPOOLCLEAR},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef surface_pool_getsets[] = {
+    {"hits", (getter)surface_pool_get_hits, NULL, DOC_SURFACEPOOLHITS, NULL},
+    {"misses", (getter)surface_pool_get_misses, NULL, DOC_SURFACEPOOLMISSES,
+     NULL},
+    {"idle", (getter)surface_pool_get_idle, NULL, DOC_SURFACEPOOLIDLE, NULL},
+    {"max_buffers", (getter)surface_pool_get_max_buffers, NULL,
+     DOC_SURFACEPOOLMAXBUFFERS, NULL},
+    {NULL, NULL, NULL, NULL, NULL}};
+
+static PyTypeObject pgSurfacePool_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.surface.SurfacePool",
+    .tp_basicsize = sizeof(pgSurfacePoolObject),
+    .tp_dealloc = (destructor)surface_pool_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_PYGAMESURFACEPOOL,
+    .tp_methods = surface_pool_methods,
+    .tp_getset = surface_pool_getsets,
+    .tp_init = (initproc)surface_pool_init,
+    .tp_new = PyType_GenericNew,
+};
+
+/* SurfaceRegion: a surface and a rect of it. Blits read the rect of the
+ * surface directly, so making one costs no SDL_Surface; subsurface() and
+ * get_view() make the matching subsurface the first time they are called.
+ */
+
+/* Fill in a region of surfobj from a rectstyle object.
+   Returns 0, or -1 with an exception set. */
+static int
+_region_set(pgSurfaceRegionObject *self, PyObject *surfobj, PyObject *rectobj)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(surfobj);
+    SDL_Rect *rect, temp;
+
+    if (!surf) {
+        PyErr_SetString(pgExc_SDLError, "display Surface quit");
+        return -1;
+    }
+    if (!(rect = pgRect_FromObject(rectobj, &temp))) {
+        PyErr_SetString(PyExc_ValueError, "invalid rectstyle argument");
+        return -1;
+    }
+    if (rect->x < 0 || rect->y < 0 || rect->w < 0 || rect->h < 0 ||
+        rect->x + rect->w > surf->w || rect->y + rect->h > surf->h) {
+        PyErr_SetString(PyExc_ValueError,
+                        "region rectangle outside surface area");
+        return -1;
+    }
+    Py_INCREF(surfobj);
+    Py_XDECREF(self->surface);
+    self->surface = (pgSurfaceObject *)surfobj;
+    Py_CLEAR(self->subsurface);
+    self->rect = *rect;
+    return 0;
+}
+
+static PyObject *
+surf_region(PyObject *self, PyObject *args)
+{
+    pgSurfaceRegionObject *region;
+
+    region = (pgSurfaceRegionObject *)pgSurfaceRegion_Type.tp_alloc(
+        &pgSurfaceRegion_Type, 0);
+    if (!region)
+        return NULL;
+    if (_region_set(region, self,
+                    PyTuple_GET_SIZE(args) == 1 ? PyTuple_GET_ITEM(args, 0)
+                                                : args)) {
+        Py_DECREF(region);
+        return NULL;
+    }
+    return (PyObject *)region;
+}
+
+static int
+surface_region_init(pgSurfaceRegionObject *self, PyObject *args,
+                    PyObject *kwds)
+{
+    PyObject *surfobj, *rectobj;
+    static char *kwids[] = {"surface", "rect", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!O", kwids,
+                                     &pgSurface_Type, &surfobj, &rectobj))
+        return -1;
+    return _region_set(self, surfobj, rectobj);
+}
+
+static void
+surface_region_dealloc(pgSurfaceRegionObject *self)
+{
+    Py_XDECREF(self->surface);
+    Py_XDECREF(self->subsurface);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+surface_region_repr(pgSurfaceRegionObject *self)
+{
+    return PyUnicode_FromFormat("<SurfaceRegion(%d, %d, %d, %d)>",
+                                self->rect.x, self->rect.y, self->rect.w,
+                                self->rect.h);
+}
+
+static PyObject *
+surface_region_subsurface(pgSurfaceRegionObject *self, PyObject *_null)
+{
+    PyObject *rect;
+
+    if (!self->surface)
+        return RAISE(PyExc_ValueError, "region is not initialized");
+    if (!self->subsurface) {
+        rect = pgRect_New(&self->rect);
+        if (!rect)
+            return NULL;
+        self->subsurface = PyObject_CallMethod((PyObject *)self->surface,
+                                               "subsurface", "(O)", rect);
+        Py_DECREF(rect);
+        if (!self->subsurface)
+            return NULL;
+    }
+    Py_INCREF(self->subsurface);
+    return self->subsurface;
+}
+
+static PyObject *
+surface_region_get_view(pgSurfaceRegionObject *self, PyObject *args)
+{
+    PyObject *sub, *view;
+
+    sub = surface_region_subsurface(self, NULL);
+    if (!sub)
+        return NULL;
+    view = surf_get_view(sub, args);
+    Py_DECREF(sub);
+    return view;
+}
+
+static PyObject *
+surface_region_get_size(pgSurfaceRegionObject *self, PyObject *_null)
+{
+    return Py_BuildValue("(ii)", self->rect.w, self->rect.h);
+}
+
+static PyObject *
+surface_region_get_surface(pgSurfaceRegionObject *self, void *closure)
+{
+    if (!self->surface)
+        Py_RETURN_NONE;
+    Py_INCREF(self->surface);
+    return (PyObject *)self->surface;
+}
+
+static PyObject *
+surface_region_get_rect(pgSurfaceRegionObject *self, void *closure)
+{
+    return pgRect_New(&self->rect);
+}
+
+static PyMethodDef surface_region_methods[] = {
+    {"get_size", (PyCFunction)surface_region_get_size, METH_NOARGS,
+     DOC_SURFACEREGIONGETSIZE},
+    {"subsurface", (PyCFunction)surface_region_subsurface, METH_NOARGS,
+     DOC_SURFACEREGIONSUBSURFACE},
+    {"get_view", (PyCFunction)surface_region_get_view, METH_VARARGS,
+     DOC_SURFACEREGIONGETVIEW},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef surface_region_getsets[] = {
+    {"surface", (getter)surface_region_get_surface, NULL,
+     DOC_SURFACEREGIONSURFACE, NULL},
+    {"rect", (getter)surface_region_get_rect, NULL, DOC_SURFACEREGIONRECT,
+     NULL},
+    {NULL, NULL, NULL, NULL, NULL}};
+
+static PyTypeObject pgSurfaceRegion_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.surface.SurfaceRegion",
+    .tp_basicsize = sizeof(pgSurfaceRegionObject),
+    .tp_dealloc = (destructor)surface_region_dealloc,
+    .tp_repr = (reprfunc)surface_region_repr,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_PYGAMESURFACEREGION,
+    .tp_methods = surface_region_methods,
+    .tp_getset = surface_region_getsets,
+    .tp_init = (initproc)surface_region_init,
+    .tp_new = PyType_GenericNew,
+};
+
+/* HDRSurface: float pixels in linear light, outside SDL, which has no
+ * float pixel formats. The kernels are in surface_hdr.c.
+ */
+typedef struct {
+    PyObject_HEAD float *pixels;
+    int w;
+    int h;
+} pgHDRSurfaceObject;
+
+static PyTypeObject pgHDRSurface_Type;
+#define pgHDRSurface_Check(x) \
+    (PyObject_IsInstance((x), (PyObject *)&pgHDRSurface_Type))
+
+#define HDR_PITCH(hdr) ((Py_ssize_t)(hdr)->w * 4)
+#define HDR_PIXEL(hdr, x, y) \
+    ((hdr)->pixels + (y)*HDR_PITCH(hdr) + (Py_ssize_t)(x)*4)
+
+/* Read a color for an HDRSurface into four premultiplied floats. A Color or
+   a color name is sRGB, a sequence of 3 or 4 numbers is linear light.
+   Returns 0, or -1 with an exception set. */
+static int
+_hdr_color(PyObject *obj, float *color)
+{
+    Uint8 rgba[4];
+    Py_ssize_t len, i;
+
+    if (PyObject_IsInstance(obj, &pgColor_Type) > 0 || PyUnicode_Check(obj)) {
+        if (!pg_RGBAFromFuzzyColorObj(obj, rgba))
+            return -1;
+        for (i = 0; i < 3; ++i) {
+            color[i] = pg_HDRFromSRGB(rgba[i]);
+        }
+        color[3] = rgba[3] / 255.0f;
+    }
+    else {
+        len = PySequence_Check(obj) ? PySequence_Size(obj) : -1;
+        if (len != 3 && len != 4) {
+            PyErr_Clear();
+            PyErr_SetString(PyExc_TypeError,
+                            "color must be a Color or 3 or 4 floats");
+            return -1;
+        }
+        color[3] = 1.0f;
+        for (i = 0; i < len; ++i) {
+            if (!pg_FloatFromObjIndex(obj, (int)i, color + i)) {
+                PyErr_SetString(PyExc_TypeError,
+                                "color must be a Color or 3 or 4 floats");
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/* Clip a blit of area of a sw by sh source to (*x, *y) of a dw by dh
+   destination. Returns 0 if nothing is left to blit. */
+static int
+_hdr_clip(SDL_Rect *area, int sw, int sh, int dw, int dh, int *x, int *y)
+{
+    int d;
+
+    if (area->x < 0) {
+        area->w += area->x;
+        *x -= area->x;
+        area->x = 0;
+    }
+    if (area->y < 0) {
+        area->h += area->y;
+        *y -= area->y;
+        area->y = 0;
+    }
+    if (*x < 0) {
+        area->w += *x;
+        area->x -= *x;
+        *x = 0;
+    }
+    if (*y < 0) {
+        area->h += *y;
+        area->y -= *y;
+        *y = 0;
+    }
+    d = area->x + area->w - sw;
+    if (d > 0)
+        area->w -= d;
+    d = area->y + area->h - sh;
+    if (d > 0)
+        area->h -= d;
+    d = *x + area->w - dw;
+    if (d > 0)
+        area->w -= d;
+    d = *y + area->h - dh;
+    if (d > 0)
+        area->h -= d;
+    return area->w > 0 && area->h > 0;
+}
+
+/* Parse the dest and area arguments of a blit from a sw by sh source onto
+   a dw by dh destination, into the clipped area and its position. Returns
+   0, or -1 with an exception set. */
+static int
+_hdr_blit_args(PyObject *destobj, PyObject *areaobj, int sw, int sh, int dw,
+               int dh, SDL_Rect *area, int *x, int *y)
+{
+    SDL_Rect *rect, temp;
+
+    *x = *y = 0;
+    if (destobj && !pg_TwoIntsFromObj(destobj, x, y)) {
+        if (!(rect = pgRect_FromObject(destobj, &temp))) {
+            PyErr_SetString(PyExc_TypeError, "invalid destination position");
+            return -1;
+        }
+        *x = rect->x;
+        *y = rect->y;
+    }
+    area->x = area->y = 0;
+    area->w = sw;
+    area->h = sh;
+    if (areaobj && areaobj != Py_None) {
+        if (!(rect = pgRect_FromObject(areaobj, &temp))) {
+            PyErr_SetString(PyExc_ValueError, "invalid rectstyle argument");
+            return -1;
+        }
+        *area = *rect;
+    }
+    if (!_hdr_clip(area, sw, sh, dw, dh, x, y)) {
+        area->w = area->h = 0;
+    }
+    return 0;
+}
+
+static int
+surface_hdr_init(pgHDRSurfaceObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *sizeobj;
+    float *pixels;
+    int w, h;
+    static char *kwids[] = {"size", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwids, &sizeobj))
+        return -1;
+    if (!pg_TwoIntsFromObj(sizeobj, &w, &h)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "size needs to be (number width, number height)");
+        return -1;
+    }
+    if (w < 0 || h < 0) {
+        PyErr_SetString(pgExc_SDLError, "Invalid resolution for Surface");
+        return -1;
+    }
+    if (w && (size_t)h > PY_SSIZE_T_MAX / sizeof(float) / 4 / w) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    pixels = PyMem_Calloc((size_t)w * h * 4, sizeof(float));
+    if (!pixels) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    PyMem_Free(self->pixels);
+    self->pixels = pixels;
+    self->w = w;
+    self->h = h;
+    return 0;
+}
+
+static void
+surface_hdr_dealloc(pgHDRSurfaceObject *self)
+{
+    PyMem_Free(self->pixels);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+surface_hdr_repr(pgHDRSurfaceObject *self)
+{
+    return PyUnicode_FromFormat("<HDRSurface(%dx%d)>", self->w, self->h);
+}
+
+static PyObject *
+surface_hdr_get_size(pgHDRSurfaceObject *self, PyObject *_null)
+{
+    return Py_BuildValue("(ii)", self->w, self->h);
+}
+
+static PyObject *
+surface_hdr_get_width(pgHDRSurfaceObject *self, PyObject *_null)
+{
+    return PyLong_FromLong(self->w);
+}
+
+static PyObject *
+surface_hdr_get_height(pgHDRSurfaceObject *self, PyObject *_null)
+{
+    return PyLong_FromLong(self->h);
+}
+
+static PyObject *
+surface_hdr_get_at(pgHDRSurfaceObject *self, PyObject *args)
+{
+    float *p;
+    int x, y;
+
+    if (!PyArg_ParseTuple(args, "(ii)", &x, &y))
+        return NULL;
+    if (x < 0 || x >= self->w || y < 0 || y >= self->h)
+        return RAISE(PyExc_IndexError, "pixel index out of range");
+    p = HDR_PIXEL(self, x, y);
+    return Py_BuildValue("(dddd)", (double)p[0], (double)p[1], (double)p[2],
+                         (double)p[3]);
+}
+
+static PyObject *
+surface_hdr_fill(pgHDRSurfaceObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *colorobj, *rectobj = NULL;
+    SDL_Rect *rect, temp, area;
+    float color[4];
+    int flags = 0, op, x, y, result;
+    static char *kwids[] = {"color", "rect", "special_flags", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|Oi", kwids, &colorobj,
+                                     &rectobj, &flags))
+        return NULL;
+    if (_hdr_color(colorobj, color))
+        return NULL;
+
+    switch (flags) {
+        case 0:
+            op = PG_HDR_OVER;
+            color[0] *= color[3];
+            color[1] *= color[3];
+            color[2] *= color[3];
+            break;
+        case PYGAME_BLEND_ADD:
+        case PYGAME_BLEND_RGBA_ADD:
+            op = PG_HDR_ADD;
+            color[0] *= color[3];
+            color[1] *= color[3];
+            color[2] *= color[3];
+            if (flags == PYGAME_BLEND_ADD)
+                color[3] = 0.0f;
+            break;
+        case PYGAME_BLEND_MULT:
+        case PYGAME_BLEND_RGBA_MULT:
+            op = PG_HDR_MULT;
+            if (flags == PYGAME_BLEND_MULT)
+                color[3] = 1.0f;
+            break;
+        default:
+            return RAISE(PyExc_ValueError,
+                         "special_flags must be 0 or a BLEND_ADD, "
+                         "BLEND_RGBA_ADD, BLEND_MULT or BLEND_RGBA_MULT flag");
+    }
+
+    area.x = area.y = 0;
+    area.w = self->w;
+    area.h = self->h;
+    if (rectobj && rectobj != Py_None) {
+        if (!(rect = pgRect_FromObject(rectobj, &temp)))
+            return RAISE(PyExc_ValueError, "invalid rectstyle object");
+        area = *rect;
+    }
+    x = area.x;
+    y = area.y;
+    area.x = area.y = 0;
+    if (!_hdr_clip(&area, area.w, area.h, self->w, self->h, &x, &y)) {
+        area.w = area.h = 0;
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    result = pg_HDRFill(HDR_PIXEL(self, x, y), HDR_PITCH(self), area.w,
+                        area.h, color, op);
+    Py_END_ALLOW_THREADS;
+    if (result)
+        return PyErr_NoMemory();
+    area.x = x;
+    area.y = y;
+    return pgRect_New(&area);
+}
+
+static PyObject *
+surface_hdr_blit(pgHDRSurfaceObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *srcobj, *destobj = NULL, *areaobj = NULL;
+    pgHDRSurfaceObject *src;
+    SDL_Surface *surf;
+    SDL_Rect area;
+    const float *pixels;
+    float *copy = NULL;
+    Py_ssize_t pitch;
+    int flags = 0, op, x, y, i, result;
+    static char *kwids[] = {"source", "dest", "area", "special_flags", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOi", kwids, &srcobj,
+                                     &destobj, &areaobj, &flags))
+        return NULL;
+
+    switch (flags) {
+        case 0:
+            op = PG_HDR_OVER;
+            break;
+        case PYGAME_BLEND_ADD:
+            op = PG_HDR_ADD;
+            break;
+        case PYGAME_BLEND_MULT:
+            op = PG_HDR_MULT;
+            break;
+        default:
+            return RAISE(PyExc_ValueError,
+                         "special_flags must be 0, BLEND_ADD or BLEND_MULT");
+    }
+
+    if (pgHDRSurface_Check(srcobj)) {
+        src = (pgHDRSurfaceObject *)srcobj;
+        if (_hdr_blit_args(destobj, areaobj, src->w, src->h, self->w,
+                           self->h, &area, &x, &y))
+            return NULL;
+        pixels = HDR_PIXEL(src, area.x, area.y);
+        pitch = HDR_PITCH(src);
+        if (src == self && area.w && area.h) {
+            /* the rows may overlap, so blend from a copy */
+            copy = PyMem_New(float, (size_t)area.w * area.h * 4);
+            if (!copy)
+                return PyErr_NoMemory();
+            for (i = 0; i < area.h; ++i) {
+                memcpy(copy + (size_t)i * area.w * 4, pixels + i * pitch,
+                       (size_t)area.w * 4 * sizeof(float));
+            }
+            pixels = copy;
+            pitch = (Py_ssize_t)area.w * 4;
+        }
+        Py_BEGIN_ALLOW_THREADS;
+        result = pg_HDRBlit(HDR_PIXEL(self, x, y), HDR_PITCH(self), pixels,
+                            pitch, area.w, area.h, op);
+        Py_END_ALLOW_THREADS;
+        PyMem_Free(copy);
+    }
+    else if (pgSurface_Check(srcobj)) {
+        surf = pgSurface_AsSurface(srcobj);
+        if (!surf)
+            return RAISE(pgExc_SDLError, "display Surface quit");
+        if (_hdr_blit_args(destobj, areaobj, surf->w, surf->h, self->w,
+                           self->h, &area, &x, &y))
+            return NULL;
+        if (!pgSurface_LockRead((pgSurfaceObject *)srcobj))
+            return NULL;
+        Py_BEGIN_ALLOW_THREADS;
+        result = pg_HDRBlitSurface(HDR_PIXEL(self, x, y), HDR_PITCH(self),
+                                   surf, area.x, area.y, area.w, area.h, op);
+        Py_END_ALLOW_THREADS;
+        if (!pgSurface_UnlockRead((pgSurfaceObject *)srcobj))
+            return NULL;
+    }
+    else {
+        return RAISE(PyExc_TypeError,
+                     "source must be an HDRSurface or a Surface");
+    }
+    if (result)
+        return PyErr_NoMemory();
+    area.x = x;
+    area.y = y;
+    return pgRect_New(&area);
+}
+
+static PyObject *
+surface_hdr_tonemap(pgHDRSurfaceObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *surfobj, *destobj = NULL, *areaobj = NULL;
+    SDL_Surface *surf;
+    SDL_PixelFormat *fmt;
+    SDL_Rect area, *clip;
+    const char *method_name = "reinhard";
+    float exposure = 1.0f;
+    int method, x, y, result;
+    static char *kwids[] = {"surface", "dest",   "area",
+                            "exposure", "method", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!|OOfs", kwids,
+                                     &pgSurface_Type, &surfobj, &destobj,
+                                     &areaobj, &exposure, &method_name))
+        return NULL;
+    if (!strcmp(method_name, "clamp"))
+        method = PG_HDR_CLAMP;
+    else if (!strcmp(method_name, "reinhard"))
+        method = PG_HDR_REINHARD;
+    else if (!strcmp(method_name, "aces"))
+        method = PG_HDR_ACES;
+    else
+        return RAISE(PyExc_ValueError,
+                     "method must be 'clamp', 'reinhard' or 'aces'");
+
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    fmt = surf->format;
+    if (fmt->BytesPerPixel != 4 || fmt->Rloss || fmt->Gloss || fmt->Bloss)
+        return RAISE(PyExc_ValueError,
+                     "tonemap needs a 32 bit Surface with 8 bit channels");
+
+    /* clip to the clip rect of the surface */
+    clip = &surf->clip_rect;
+    if (_hdr_blit_args(destobj, areaobj, self->w, self->h, clip->x + clip->w,
+                       clip->y + clip->h, &area, &x, &y))
+        return NULL;
+    if (x < clip->x) {
+        area.x += clip->x - x;
+        area.w -= clip->x - x;
+        x = clip->x;
+    }
+    if (y < clip->y) {
+        area.y += clip->y - y;
+        area.h -= clip->y - y;
+        y = clip->y;
+    }
+    if (area.w <= 0 || area.h <= 0) {
+        area.w = area.h = 0;
+    }
+
+    if (!pgSurface_Unshare(surf) ||
+        !pgSurface_Lock((pgSurfaceObject *)surfobj))
+        return NULL;
+    Py_BEGIN_ALLOW_THREADS;
+    result = pg_HDRTonemap(surf, x, y, HDR_PIXEL(self, area.x, area.y),
+                           HDR_PITCH(self), area.w, area.h, exposure, method);
+    Py_END_ALLOW_THREADS;
+    if (!pgSurface_Unlock((pgSurfaceObject *)surfobj))
+        return NULL;
+    if (result)
+        return PyErr_NoMemory();
+
+    area.x = x;
+    area.y = y;
+    if (area.w && area.h)
+        pgSurface_AddDamage((pgSurfaceObject *)surfobj, &area);
+    return pgRect_New(&area);
+}
+
+static int
+surface_hdr_getbuffer(pgHDRSurfaceObject *self, Py_buffer *view, int flags)
+{
+    Py_ssize_t *shape;
+
+    shape = PyMem_New(Py_ssize_t, 6);
+    if (!shape) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    shape[0] = self->h;
+    shape[1] = self->w;
+    shape[2] = 4;
+    shape[3] = (Py_ssize_t)self->w * 4 * sizeof(float);
+    shape[4] = 4 * sizeof(float);
+    shape[5] = sizeof(float);
+
+    view->buf = self->pixels;
+    view->obj = (PyObject *)self;
+    Py_INCREF(self);
+    view->len = (Py_ssize_t)self->w * self->h * 4 * sizeof(float);
+    view->readonly = 0;
+    view->itemsize = sizeof(float);
+    view->format = (flags & PyBUF_FORMAT) ? "f" : NULL;
+    view->ndim = 3;
+    view->shape = (flags & PyBUF_ND) == PyBUF_ND ? shape : NULL;
+    view->strides =
+        (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? shape + 3 : NULL;
+    view->suboffsets = NULL;
+    view->internal = shape;
+    if (!view->shape) {
+        /* a flat buffer of the floats */
+        view->ndim = 1;
+    }
+    return 0;
+}
+
+static void
+surface_hdr_releasebuffer(pgHDRSurfaceObject *self, Py_buffer *view)
+{
+    PyMem_Free(view->internal);
+}
+
+static PyBufferProcs surface_hdr_as_buffer = {
+    (getbufferproc)surface_hdr_getbuffer,
+    (releasebufferproc)surface_hdr_releasebuffer};
+
+static PyMethodDef surface_hdr_methods[] = {
+    {"get_size", (PyCFunction)surface_hdr_get_size, METH_NOARGS,
+     DOC_HDRSURFACEGETSIZE},
+    {"get_width", (PyCFunction)surface_hdr_get_width, METH_NOARGS,
+     DOC_HDRSURFACEGETWIDTH},
+    {"get_height", (PyCFunction)surface_hdr_get_height, METH_NOARGS,
+     DOC_HDRSURFACEGETHEIGHT},
+    {"get_at", (PyCFunction)surface_hdr_get_at, METH_VARARGS,
+     DOC_HDRSURFACEGETAT},
+    {"fill", (PyCFunction)surface_hdr_fill, METH_VARARGS | METH_KEYWORDS,
+     DOC_HDRSURFACEFILL},
+    {"blit", (PyCFunction)surface_hdr_blit, METH_VARARGS | METH_KEYWORDS,
+     DOC_HDRSURFACEBLIT},
+    {"tonemap", (PyCFunction)surface_hdr_tonemap,
+     METH_VARARGS | METH_KEYWORDS, DOC_HDRSURFACETONEMAP},
+    {NULL, NULL, 0, NULL}};
+
+static PyTypeObject pgHDRSurface_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.surface.HDRSurface",
+    .tp_basicsize = sizeof(pgHDRSurfaceObject),
+    .tp_dealloc = (destructor)surface_hdr_dealloc,
+    .tp_repr = (reprfunc)surface_hdr_repr,
+    .tp_as_buffer = &surface_hdr_as_buffer,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_PYGAMEHDRSURFACE,
+    .tp_methods = surface_hdr_methods,
+    .tp_init = (initproc)surface_hdr_init,
+    .tp_new = PyType_GenericNew,
+};
+
+static PyObject *
+surf_set_auto_convert(PyObject *self, PyObject *arg)
+{
+    int enabled = PyObject_IsTrue(arg);
+
+    if (enabled < 0)
+        return NULL;
+    surface_auto_convert = enabled;
+    if (!enabled && surface_shadows)
+        PyDict_Clear(surface_shadows);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_auto_convert(PyObject *self, PyObject *_null)
+{
+    return PyBool_FromLong(surface_auto_convert);
+}
+
+static PyMethodDef _surface_methods[] = {
+    {"convert_many", (PyCFunction)surf_convert_many,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMECONVERTMANY},
+    {"get_bounding_rects", (PyCFunction)surf_get_bounding_rects,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEGETBOUNDINGRECTS},
+    {"set_auto_convert", (PyCFunction)surf_set_auto_convert, METH_O,
+     DOC_PYGAMESETAUTOCONVERT},
+    {"get_auto_convert", (PyCFunction)surf_get_auto_convert, METH_NOARGS,
+     DOC_PYGAMEGETAUTOCONVERT},
+    {NULL, NULL, 0, NULL}};
+
+MODINIT_DEFINE(surface)
+{
+    PyObject *module, *apiobj;
+    static void *c_api[PYGAMEAPI_SURFACE_NUMSLOTS];
+
+    static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
+                                         "surface",
+                                         DOC_PYGAMESURFACE,
+                                         -1,
+                                         _surface_methods,
+                                         NULL,
+                                         NULL,
+                                         NULL,
+                                         NULL};
+
+    /* imported needed apis; Do this first so if there is an error
+       the module is not loaded.
+    */
+    import_pygame_base();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+    import_pygame_color();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+    import_pygame_rect();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+    import_pygame_bufferproxy();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+    _IMPORT_PYGAME_MODULE(surflock);
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
+    /* type preparation */
+    if (PyType_Ready(&pgSurface_Type) < 0) {
+        return NULL;
+    }
+    if (PyType_Ready(&pgSurfacePool_Type) < 0) {
+        return NULL;
+    }
+    if (PyType_Ready(&pgSurfaceRegion_Type) < 0) {
+        return NULL;
+    }
+    if (PyType_Ready(&pgHDRSurface_Type) < 0) {
+        return NULL;
+    }
+    pg_HDRInit();
+
+    /* create the module */
+    module = PyModule_Create(&_module);
+    if (module == NULL) {
+        return NULL;
+    }
+    Py_INCREF(&pgSurface_Type);
+    if (PyModule_AddObject(module, "SurfaceType",
+                           (PyObject *)&pgSurface_Type)) {
+        Py_DECREF(&pgSurface_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&pgSurface_Type);
     if (PyModule_AddObject(module, "Surface", (PyObject *)&pgSurface_Type)) {
         Py_DECREF(&pgSurface_Type);
         Py_DECREF(module);
         return NULL;
     }
 
+    Py_INCREF(&pgSurfacePool_Type);
+    if (PyModule_AddObject(module, "SurfacePool",
+                           (PyObject *)&pgSurfacePool_Type)) {
+        Py_DECREF(&pgSurfacePool_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&pgSurfaceRegion_Type);
+    if (PyModule_AddObject(module, "SurfaceRegion",
+                           (PyObject *)&pgSurfaceRegion_Type)) {
+        Py_DECREF(&pgSurfaceRegion_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&pgHDRSurface_Type);
+    if (PyModule_AddObject(module, "HDRSurface",
+                           (PyObject *)&pgHDRSurface_Type)) {
+        Py_DECREF(&pgHDRSurface_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
     /* export the c api */
     c_api[0] = &pgSurface_Type;
     c_api[1] = pgSurface_New2;
     c_api[2] = pgSurface_Blit;
     c_api[3] = pgSurface_SetSurface;
+    c_api[4] = pgSurface_AddDamage;
+    c_api[5] = pgSurface_PopDamage;
+    c_api[6] = &pgSurfacePool_Type;
+    c_api[7] = pgSurfacePool_CreateSurface;
+    c_api[8] = pgSurfacePool_FreeSurface;
+    c_api[9] = pgSurface_GetVersion;
     apiobj = encapsulate_api(c_api, "surface");
     if (PyModule_AddObject(module, PYGAMEAPI_LOCAL_ENTRY, apiobj)) {
         Py_XDECREF(apiobj);
@@ -344,12 +344,78 @@ surface_fill_blend(SDL_Surface *surface, SDL_Rect *rect, Uint32 color,
 void
 surface_respect_clip_rect(SDL_Surface *surface, SDL_Rect *rect);
 
+/* Runs of pixels along each row of a blit source. PG_SPAN_SKIP runs are
+ * colorkey or zero alpha pixels a blit leaves alone, PG_SPAN_COPY runs are
+ * fully opaque, and PG_SPAN_BLEND runs need the regular blitter. Each run
+ * is kind << 30 | length, and row y covers runs[rows[y]] to
+ * runs[rows[y + 1]]. runs is NULL until the spans are built.
+ */
+#define PG_SPAN_BLEND 0
+#define PG_SPAN_SKIP 1
+#define PG_SPAN_COPY 2
+#define PG_SPAN_KIND(run) ((run) >> 30)
+#define PG_SPAN_LENGTH(run) ((int)((run)&0x3FFFFFFF))
+
+#define PG_SPANS_ALPHA 1 /* runs follow per pixel alpha */
+#define PG_SPANS_KEY 2   /* runs follow the colorkey */
+
+typedef struct {
+    Uint32 *runs;
+    size_t *rows;
+    /* what the runs were made from */
+    void *pixels;
+    int w, h, pitch;
+    Uint32 format;
+    Uint32 colorkey;
+    int mode;
+} pgBlitSpans;
+
+int
+pg_BuildBlitSpans(SDL_Surface *src, pgBlitSpans *spans);
+
 int
 pygame_AlphaBlit(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                  SDL_Rect *dstrect, int the_args);
 
 int
 pygame_Blit(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
-            SDL_Rect *dstrect, int the_args);
+            SDL_Rect *dstrect, int the_args, const pgBlitSpans *spans);
+
+int
+pygame_BlitMany(SDL_Surface *src, SDL_Surface *dst, const int *positions,
+                Py_ssize_t count, int the_args, const pgBlitSpans *spans);
+
+/* HDRSurface pixels are four floats, red, green, blue and alpha in linear
+ * light with the colors premultiplied by alpha. Pitches count floats.
+ */
+#define PG_HDR_OVER 0 /* blits: alpha over, fills: set */
+#define PG_HDR_ADD 1
+#define PG_HDR_MULT 2
+
+#define PG_HDR_CLAMP 0
+#define PG_HDR_REINHARD 1
+#define PG_HDR_ACES 2
+
+void
+pg_HDRInit(void);
+
+float
+pg_HDRFromSRGB(Uint8 c);
+
+int
+pg_HDRBlit(float *dst, Py_ssize_t dstpitch, const float *src,
+           Py_ssize_t srcpitch, int w, int h, int op);
+
+int
+pg_HDRBlitSurface(float *dst, Py_ssize_t dstpitch, SDL_Surface *src, int x,
+                  int y, int w, int h, int op);
+
+int
+pg_HDRFill(float *dst, Py_ssize_t dstpitch, int w, int h, const float *color,
+           int op);
+
+int
+pg_HDRTonemap(SDL_Surface *dst, int x, int y, const float *src,
+              Py_ssize_t srcpitch, int w, int h, float exposure, int method);
 
 #endif /* SURFACE_H */
@@ -17,8 +17,8 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 */
 
-#define NO_PYGAME_C_API
 #include "_surface.h"
+#include "simd_blitters.h"
 
 /*
  * Changes SDL_Rect to respect any clipping rect defined on the surface.
@@ -848,6 +848,144 @@ surface_fill_blend_rgba_max(SDL_Surface *surface, SDL_Rect *rect, Uint32 color)
     return result;
 }
 
+/* Pick the SIMD blend blitter matching a fill blend mode, the same ones
+ * a blit between two surfaces of this format would use. Returns NULL if
+ * there is none.
+ */
+static pg_BlitFunc
+surface_fill_blend_simd_func(SDL_Surface *surface, int blendargs)
+{
+#if !defined(__EMSCRIPTEN__)
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    SDL_BlendMode mode;
+
+    if (surface->format->BytesPerPixel != 4) {
+        return NULL;
+    }
+
+    /* as in the scalar fills, RGBA modes need per pixel alpha */
+    SDL_GetSurfaceBlendMode(surface, &mode);
+    if (!surface->format->Amask || mode == SDL_BLENDMODE_NONE) {
+        switch (blendargs) {
+            case PYGAME_BLEND_RGBA_ADD:
+                blendargs = PYGAME_BLEND_ADD;
+                break;
+            case PYGAME_BLEND_RGBA_SUB:
+                blendargs = PYGAME_BLEND_SUB;
+                break;
+            case PYGAME_BLEND_RGBA_MULT:
+                blendargs = PYGAME_BLEND_MULT;
+                break;
+            case PYGAME_BLEND_RGBA_MIN:
+                blendargs = PYGAME_BLEND_MIN;
+                break;
+            case PYGAME_BLEND_RGBA_MAX:
+                blendargs = PYGAME_BLEND_MAX;
+                break;
+        }
+    }
+
+    if (pg_HasAVX2()) {
+        switch (blendargs) {
+            case PYGAME_BLEND_ADD:
+                return blit_blend_rgb_add_avx2;
+            case PYGAME_BLEND_SUB:
+                return blit_blend_rgb_sub_avx2;
+            case PYGAME_BLEND_MULT:
+                return blit_blend_rgb_mul_avx2;
+            case PYGAME_BLEND_MIN:
+                return blit_blend_rgb_min_avx2;
+            case PYGAME_BLEND_MAX:
+                return blit_blend_rgb_max_avx2;
+            case PYGAME_BLEND_RGBA_ADD:
+                return blit_blend_rgba_add_avx2;
+            case PYGAME_BLEND_RGBA_SUB:
+                return blit_blend_rgba_sub_avx2;
+            case PYGAME_BLEND_RGBA_MULT:
+                return blit_blend_rgba_mul_avx2;
+            case PYGAME_BLEND_RGBA_MIN:
+                return blit_blend_rgba_min_avx2;
+            case PYGAME_BLEND_RGBA_MAX:
+                return blit_blend_rgba_max_avx2;
+        }
+        return NULL;
+    }
+#if defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)
+#if PG_ENABLE_ARM_NEON
+    if (pg_HasNEON() || pg_HasSSE2()) {
+#else
+    if (pg_HasSSE2()) {
+#endif /* PG_ENABLE_ARM_NEON */
+        switch (blendargs) {
+            case PYGAME_BLEND_ADD:
+                return blit_blend_rgb_add_sse2;
+            case PYGAME_BLEND_SUB:
+                return blit_blend_rgb_sub_sse2;
+            case PYGAME_BLEND_MULT:
+                return blit_blend_rgb_mul_sse2;
+            case PYGAME_BLEND_MIN:
+                return blit_blend_rgb_min_sse2;
+            case PYGAME_BLEND_MAX:
+                return blit_blend_rgb_max_sse2;
+            case PYGAME_BLEND_RGBA_ADD:
+                return blit_blend_rgba_add_sse2;
+            case PYGAME_BLEND_RGBA_SUB:
+                return blit_blend_rgba_sub_sse2;
+            case PYGAME_BLEND_RGBA_MULT:
+                return blit_blend_rgba_mul_sse2;
+            case PYGAME_BLEND_RGBA_MIN:
+                return blit_blend_rgba_min_sse2;
+            case PYGAME_BLEND_RGBA_MAX:
+                return blit_blend_rgba_max_sse2;
+        }
+    }
+#endif /* __SSE2__ || PG_ENABLE_ARM_NEON */
+#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
+#endif /* __EMSCRIPTEN__ */
+    return NULL;
+}
+
+/* Fill by running a blend blitter over a single row of the fill color,
+ * using a negative source skip to re-read that row for every line.
+ */
+static int
+surface_fill_blend_simd(SDL_Surface *surface, SDL_Rect *rect, Uint32 color,
+                        pg_BlitFunc blitter)
+{
+    SDL_BlitInfo info;
+    Uint32 *row;
+    int i;
+
+    row = (Uint32 *)malloc(rect->w * sizeof(Uint32));
+    if (!row) {
+        SDL_OutOfMemory();
+        return -1;
+    }
+    for (i = 0; i < rect->w; ++i) {
+        row[i] = color;
+    }
+
+    info.width = rect->w;
+    info.height = rect->h;
+    info.s_pixels = (Uint8 *)row;
+    info.s_pxskip = 4;
+    info.s_skip = -rect->w * 4;
+    info.d_pixels = (Uint8 *)surface->pixels +
+                    (Uint16)rect->y * surface->pitch + (Uint16)rect->x * 4;
+    info.d_pxskip = 4;
+    info.d_skip = surface->pitch - rect->w * 4;
+    info.src = surface->format;
+    info.dst = surface->format;
+    SDL_GetSurfaceAlphaMod(surface, &info.src_blanket_alpha);
+    info.src_has_colorkey = 0;
+    SDL_GetSurfaceBlendMode(surface, &info.src_blend);
+    info.dst_blend = info.src_blend;
+
+    blitter(&info);
+    free(row);
+    return 0;
+}
+
 int
 surface_fill_blend(SDL_Surface *surface, SDL_Rect *rect, Uint32 color,
                    int blendargs)
@@ -864,6 +1002,18 @@ surface_fill_blend(SDL_Surface *surface, SDL_Rect *rect, Uint32 color,
         locked = 1;
     }
 
+    if (rect->w > 0 && rect->h > 0) {
+        pg_BlitFunc blitter = surface_fill_blend_simd_func(surface, blendargs);
+
+        if (blitter) {
+            result = surface_fill_blend_simd(surface, rect, color, blitter);
+            if (locked) {
+                SDL_UnlockSurface(surface);
+            }
+            return result;
+        }
+    }
+
     switch (blendargs) {
         case PYGAME_BLEND_ADD: {
             result = surface_fill_blend_add(surface, rect, color);
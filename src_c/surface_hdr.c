@@ -0,0 +1,576 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/* The pixel kernels of HDRSurface: blends and fills of float pixels in
+ * linear light, reading 8 bit surfaces into them and tonemapping them back
+ * to 32 bit surfaces. Each kernel runs a row at a time, banded over the
+ * worker pool for large areas.
+ */
+
+#include "_surface.h"
+
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+// arm64 has neon optimisations enabled by default, even when fpu=neon is not
+// passed
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+#if defined(PG_ENABLE_ARM_NEON)
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "include/sse2neon.h"
+#define HDR_SIMD
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define HDR_SIMD
+#endif
+
+#include <math.h>
+
+/* Linear values are encoded to sRGB through a table of this many steps */
+#define PG_HDR_ENCODE_STEPS 4096
+
+static float hdr_decode_table[256];
+static Uint8 hdr_encode_table[PG_HDR_ENCODE_STEPS + 1];
+
+/* Fill the sRGB tables. Called once, when the surface module loads. */
+void
+pg_HDRInit(void)
+{
+    double c;
+    int i;
+
+    for (i = 0; i < 256; ++i) {
+        c = i / 255.0;
+        c = c <= 0.04045 ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
+        hdr_decode_table[i] = (float)c;
+    }
+    for (i = 0; i <= PG_HDR_ENCODE_STEPS; ++i) {
+        c = (double)i / PG_HDR_ENCODE_STEPS;
+        c = c <= 0.0031308 ? c * 12.92 : 1.055 * pow(c, 1 / 2.4) - 0.055;
+        hdr_encode_table[i] = (Uint8)(c * 255 + 0.5);
+    }
+}
+
+/* The linear light value of an 8 bit sRGB channel */
+float
+pg_HDRFromSRGB(Uint8 c)
+{
+    return hdr_decode_table[c];
+}
+
+static Uint8
+hdr_encode(float v)
+{
+    if (!(v > 0.0f)) {
+        return 0;
+    }
+    if (v >= 1.0f) {
+        return 255;
+    }
+    return hdr_encode_table[(int)(v * PG_HDR_ENCODE_STEPS + 0.5f)];
+}
+
+static float
+hdr_tonemap(float v, int method)
+{
+    if (!(v > 0.0f)) {
+        return 0.0f;
+    }
+    if (v > 1e30f) {
+        /* the curves below would give inf / inf */
+        return 1.0f;
+    }
+    switch (method) {
+        case PG_HDR_REINHARD:
+            return v / (1.0f + v);
+        case PG_HDR_ACES:
+            /* Narkowicz's fit of the ACES filmic curve */
+            return v * (2.51f * v + 0.03f) / (v * (2.43f * v + 0.59f) + 0.14f);
+        default:
+            return v;
+    }
+}
+
+/* Scalar kernels */
+
+static void
+hdr_blit_row_c(float *d, const float *s, int n, int op)
+{
+    float k;
+
+    for (; n > 0; --n, d += 4, s += 4) {
+        switch (op) {
+            case PG_HDR_ADD:
+                d[0] += s[0];
+                d[1] += s[1];
+                d[2] += s[2];
+                break;
+            case PG_HDR_MULT:
+                /* the source over white, so transparent parts keep dst */
+                k = 1.0f - s[3];
+                d[0] *= s[0] + k;
+                d[1] *= s[1] + k;
+                d[2] *= s[2] + k;
+                break;
+            default:
+                k = 1.0f - s[3];
+                d[0] = s[0] + d[0] * k;
+                d[1] = s[1] + d[1] * k;
+                d[2] = s[2] + d[2] * k;
+                d[3] = s[3] + d[3] * k;
+                break;
+        }
+    }
+}
+
+static void
+hdr_fill_row_c(float *d, const float *c, int n, int op)
+{
+    int i;
+
+    for (; n > 0; --n, d += 4) {
+        for (i = 0; i < 4; ++i) {
+            switch (op) {
+                case PG_HDR_ADD:
+                    d[i] += c[i];
+                    break;
+                case PG_HDR_MULT:
+                    d[i] *= c[i];
+                    break;
+                default:
+                    d[i] = c[i];
+                    break;
+            }
+        }
+    }
+}
+
+static void
+hdr_tonemap_row_c(Uint32 *d, const float *s, int n, SDL_PixelFormat *fmt,
+                  float exposure, int method)
+{
+    float a, scale;
+    Uint32 amask = fmt->Amask;
+
+    for (; n > 0; --n, ++d, s += 4) {
+        a = s[3] > 0.0f ? (s[3] < 1.0f ? s[3] : 1.0f) : 0.0f;
+        scale = exposure;
+        if (amask) {
+            /* a surface with alpha takes the colors unpremultiplied */
+            scale = a > 0.0f ? exposure / a : 0.0f;
+        }
+        *d = (Uint32)hdr_encode(hdr_tonemap(s[0] * scale, method))
+                 << fmt->Rshift |
+             (Uint32)hdr_encode(hdr_tonemap(s[1] * scale, method))
+                 << fmt->Gshift |
+             (Uint32)hdr_encode(hdr_tonemap(s[2] * scale, method))
+                 << fmt->Bshift |
+             ((Uint32)(a * 255.0f + 0.5f) << fmt->Ashift & amask);
+    }
+}
+
+#ifdef HDR_SIMD
+/* A pixel is one vector, so the blends are a few operations each. The
+ * tonemap transposes four pixels to work on four reds, greens and blues
+ * at a time.
+ */
+
+static int
+hdr_use_simd(void)
+{
+#if defined(PG_ENABLE_ARM_NEON)
+    return pg_HasNEON();
+#else
+    return pg_HasSSE2();
+#endif
+}
+
+static void
+hdr_blit_row_simd(float *d, const float *s, int n, int op)
+{
+    __m128 mm_one = _mm_set1_ps(1.0f);
+    __m128 mm_rgb = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    __m128 mm_src, mm_dst, mm_k;
+
+    for (; n > 0; --n, d += 4, s += 4) {
+        mm_src = _mm_loadu_ps(s);
+        mm_dst = _mm_loadu_ps(d);
+        mm_k = _mm_sub_ps(mm_one, _mm_shuffle_ps(mm_src, mm_src, 0xFF));
+        switch (op) {
+            case PG_HDR_ADD:
+                mm_dst = _mm_add_ps(mm_dst, _mm_and_ps(mm_src, mm_rgb));
+                break;
+            case PG_HDR_MULT:
+                mm_k = _mm_add_ps(mm_src, mm_k);
+                mm_k = _mm_or_ps(_mm_and_ps(mm_k, mm_rgb),
+                                 _mm_andnot_ps(mm_rgb, mm_one));
+                mm_dst = _mm_mul_ps(mm_dst, mm_k);
+                break;
+            default:
+                mm_dst = _mm_add_ps(mm_src, _mm_mul_ps(mm_dst, mm_k));
+                break;
+        }
+        _mm_storeu_ps(d, mm_dst);
+    }
+}
+
+static void
+hdr_fill_row_simd(float *d, const float *c, int n, int op)
+{
+    __m128 mm_color = _mm_loadu_ps(c);
+
+    for (; n > 0; --n, d += 4) {
+        switch (op) {
+            case PG_HDR_ADD:
+                _mm_storeu_ps(d, _mm_add_ps(_mm_loadu_ps(d), mm_color));
+                break;
+            case PG_HDR_MULT:
+                _mm_storeu_ps(d, _mm_mul_ps(_mm_loadu_ps(d), mm_color));
+                break;
+            default:
+                _mm_storeu_ps(d, mm_color);
+                break;
+        }
+    }
+}
+
+static __m128
+hdr_tonemap_simd(__m128 v, int method)
+{
+    __m128 mm_one = _mm_set1_ps(1.0f);
+
+    v = _mm_max_ps(v, _mm_setzero_ps());
+    switch (method) {
+        case PG_HDR_REINHARD:
+            return _mm_div_ps(v, _mm_add_ps(mm_one, v));
+        case PG_HDR_ACES:
+            return _mm_div_ps(
+                _mm_mul_ps(v, _mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(2.51f)),
+                                         _mm_set1_ps(0.03f))),
+                _mm_add_ps(
+                    _mm_mul_ps(v, _mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(2.43f)),
+                                             _mm_set1_ps(0.59f))),
+                    _mm_set1_ps(0.14f)));
+        default:
+            return v;
+    }
+}
+
+static void
+hdr_tonemap_row_simd(Uint32 *d, const float *s, int n, SDL_PixelFormat *fmt,
+                     float exposure, int method)
+{
+    __m128 mm_r, mm_g, mm_b, mm_a, mm_scale;
+    __m128 mm_zero = _mm_setzero_ps();
+    __m128 mm_one = _mm_set1_ps(1.0f);
+    __m128 mm_exposure = _mm_set1_ps(exposure);
+    __m128 mm_steps = _mm_set1_ps((float)PG_HDR_ENCODE_STEPS);
+    __m128 mm_half = _mm_set1_ps(0.5f);
+    Uint32 amask = fmt->Amask;
+    int ri[4], gi[4], bi[4], ai[4];
+    int i;
+
+    for (; n >= 4; n -= 4, d += 4, s += 16) {
+        mm_r = _mm_loadu_ps(s);
+        mm_g = _mm_loadu_ps(s + 4);
+        mm_b = _mm_loadu_ps(s + 8);
+        mm_a = _mm_loadu_ps(s + 12);
+        _MM_TRANSPOSE4_PS(mm_r, mm_g, mm_b, mm_a);
+        mm_a = _mm_min_ps(_mm_max_ps(mm_a, mm_zero), mm_one);
+        mm_scale = mm_exposure;
+        if (amask) {
+            /* exposure / a, and 0 where a is 0 */
+            mm_scale = _mm_and_ps(
+                _mm_div_ps(mm_exposure, _mm_max_ps(mm_a, _mm_set1_ps(1e-20f))),
+                _mm_cmpgt_ps(mm_a, mm_zero));
+        }
+        mm_r = hdr_tonemap_simd(_mm_mul_ps(mm_r, mm_scale), method);
+        mm_g = hdr_tonemap_simd(_mm_mul_ps(mm_g, mm_scale), method);
+        mm_b = hdr_tonemap_simd(_mm_mul_ps(mm_b, mm_scale), method);
+        mm_r = _mm_add_ps(_mm_mul_ps(_mm_min_ps(mm_r, mm_one), mm_steps),
+                          mm_half);
+        mm_g = _mm_add_ps(_mm_mul_ps(_mm_min_ps(mm_g, mm_one), mm_steps),
+                          mm_half);
+        mm_b = _mm_add_ps(_mm_mul_ps(_mm_min_ps(mm_b, mm_one), mm_steps),
+                          mm_half);
+        mm_a = _mm_add_ps(_mm_mul_ps(mm_a, _mm_set1_ps(255.0f)), mm_half);
+        _mm_storeu_si128((__m128i *)ri, _mm_cvttps_epi32(mm_r));
+        _mm_storeu_si128((__m128i *)gi, _mm_cvttps_epi32(mm_g));
+        _mm_storeu_si128((__m128i *)bi, _mm_cvttps_epi32(mm_b));
+        _mm_storeu_si128((__m128i *)ai, _mm_cvttps_epi32(mm_a));
+        for (i = 0; i < 4; ++i) {
+            d[i] = (Uint32)hdr_encode_table[ri[i]] << fmt->Rshift |
+                   (Uint32)hdr_encode_table[gi[i]] << fmt->Gshift |
+                   (Uint32)hdr_encode_table[bi[i]] << fmt->Bshift |
+                   ((Uint32)ai[i] << fmt->Ashift & amask);
+        }
+    }
+    hdr_tonemap_row_c(d, s, n, fmt, exposure, method);
+}
+#endif /* HDR_SIMD */
+
+static void
+hdr_blit_row(float *d, const float *s, int n, int op)
+{
+#ifdef HDR_SIMD
+    if (hdr_use_simd()) {
+        hdr_blit_row_simd(d, s, n, op);
+        return;
+    }
+#endif /* HDR_SIMD */
+    hdr_blit_row_c(d, s, n, op);
+}
+
+/* Read n pixels of an SDL surface into premultiplied linear floats */
+static void
+hdr_decode_row(float *d, Uint8 *p, int n, SDL_PixelFormat *fmt,
+               int has_key, Uint32 key)
+{
+    int bpp = fmt->BytesPerPixel;
+    Uint32 pixel;
+    Uint8 r, g, b, a;
+    float k;
+
+    for (; n > 0; --n, d += 4, p += bpp) {
+        if (bpp == 1) {
+            pixel = *p;
+        }
+        else {
+            GET_PIXEL(pixel, bpp, p);
+        }
+        SDL_GetRGBA(pixel, fmt, &r, &g, &b, &a);
+        if (has_key && pixel == key) {
+            a = 0;
+        }
+        k = a / 255.0f;
+        d[0] = hdr_decode_table[r] * k;
+        d[1] = hdr_decode_table[g] * k;
+        d[2] = hdr_decode_table[b] * k;
+        d[3] = k;
+    }
+}
+
+/* Banding over the worker pool */
+
+typedef struct HDRJob HDRJob;
+
+/* Do row y of a job, with tmp a row of w floats pixels if job->tmp */
+typedef void (*hdr_row_proc)(HDRJob *job, int y, float *tmp);
+
+struct HDRJob {
+    hdr_row_proc row;
+    int w;
+    int h;
+    int op;
+    float *dst;
+    Py_ssize_t dstpitch;
+    const float *src;
+    Py_ssize_t srcpitch;
+    SDL_Surface *surf; /* the 8 bit side: a source, or the tonemap target */
+    int x;             /* where in surf the job starts */
+    int y;
+    const float *color;
+    float exposure;
+    int method;
+    int tmp;
+    int failed;
+};
+
+static void
+hdr_band(void *data, int band, int nbands)
+{
+    HDRJob *job = (HDRJob *)data;
+    int start = job->h * band / nbands;
+    int end = job->h * (band + 1) / nbands;
+    float *tmp = NULL;
+    int y;
+
+    if (start == end) {
+        return;
+    }
+    if (job->tmp) {
+        tmp = (float *)malloc((size_t)job->w * 4 * sizeof(float));
+        if (!tmp) {
+            job->failed = 1;
+            return;
+        }
+    }
+    for (y = start; y < end; ++y) {
+        job->row(job, y, tmp);
+    }
+    free(tmp);
+}
+
+/* Run a job, split into row bands over the worker pool when it is large.
+ * Returns 0, or -1 if out of memory.
+ */
+static int
+hdr_run(HDRJob *job, const char *name)
+{
+    int nthreads = pg_GetNumThreads();
+    Uint64 start = pg_StatsBegin();
+
+    job->failed = 0;
+    if (job->w > 0 && job->h > 0) {
+        if (nthreads < 2 || job->h < 2 ||
+            job->w * job->h < PG_PARALLEL_MIN_PIXELS) {
+            hdr_band(job, 0, 1);
+        }
+        else {
+            pg_ParallelFor(hdr_band, job,
+                           nthreads < job->h ? nthreads : job->h);
+        }
+    }
+    pg_StatsEnd(PG_STAT_BLIT, name, start, (Sint64)job->w * job->h);
+    return job->failed ? -1 : 0;
+}
+
+static void
+hdr_blit_job_row(HDRJob *job, int y, float *tmp)
+{
+    hdr_blit_row(job->dst + y * job->dstpitch, job->src + y * job->srcpitch,
+                 job->w, job->op);
+}
+
+static void
+hdr_blit_surface_job_row(HDRJob *job, int y, float *tmp)
+{
+    SDL_Surface *surf = job->surf;
+    Uint32 key = 0;
+    int has_key = SDL_GetColorKey(surf, &key) == 0;
+
+    hdr_decode_row(tmp,
+                   (Uint8 *)surf->pixels + (size_t)(job->y + y) * surf->pitch +
+                       (size_t)job->x * surf->format->BytesPerPixel,
+                   job->w, surf->format, has_key, key);
+    hdr_blit_row(job->dst + y * job->dstpitch, tmp, job->w, job->op);
+}
+
+static void
+hdr_fill_job_row(HDRJob *job, int y, float *tmp)
+{
+    float *d = job->dst + y * job->dstpitch;
+
+#ifdef HDR_SIMD
+    if (hdr_use_simd()) {
+        hdr_fill_row_simd(d, job->color, job->w, job->op);
+        return;
+    }
+#endif /* HDR_SIMD */
+    hdr_fill_row_c(d, job->color, job->w, job->op);
+}
+
+static void
+hdr_tonemap_job_row(HDRJob *job, int y, float *tmp)
+{
+    SDL_Surface *surf = job->surf;
+    Uint32 *d = (Uint32 *)((Uint8 *)surf->pixels +
+                           (size_t)(job->y + y) * surf->pitch) +
+                job->x;
+    const float *s = job->src + y * job->srcpitch;
+
+#ifdef HDR_SIMD
+    if (hdr_use_simd()) {
+        hdr_tonemap_row_simd(d, s, job->w, surf->format, job->exposure,
+                             job->method);
+        return;
+    }
+#endif /* HDR_SIMD */
+    hdr_tonemap_row_c(d, s, job->w, surf->format, job->exposure, job->method);
+}
+
+/* Blend a w by h area of src pixels onto dst with op */
+int
+pg_HDRBlit(float *dst, Py_ssize_t dstpitch, const float *src,
+           Py_ssize_t srcpitch, int w, int h, int op)
+{
+    HDRJob job;
+
+    memset(&job, 0, sizeof(job));
+    job.row = hdr_blit_job_row;
+    job.w = w;
+    job.h = h;
+    job.op = op;
+    job.dst = dst;
+    job.dstpitch = dstpitch;
+    job.src = src;
+    job.srcpitch = srcpitch;
+    return hdr_run(&job, "hdr_blit");
+}
+
+/* Blend the w by h area at (x, y) of a locked SDL surface onto dst with
+ * op, its colors read as sRGB */
+int
+pg_HDRBlitSurface(float *dst, Py_ssize_t dstpitch, SDL_Surface *src, int x,
+                  int y, int w, int h, int op)
+{
+    HDRJob job;
+
+    memset(&job, 0, sizeof(job));
+    job.row = hdr_blit_surface_job_row;
+    job.w = w;
+    job.h = h;
+    job.op = op;
+    job.dst = dst;
+    job.dstpitch = dstpitch;
+    job.surf = src;
+    job.x = x;
+    job.y = y;
+    job.tmp = 1;
+    return hdr_run(&job, "hdr_blit_surface");
+}
+
+/* Set, add or multiply a w by h area of dst by the four floats of color */
+int
+pg_HDRFill(float *dst, Py_ssize_t dstpitch, int w, int h, const float *color,
+           int op)
+{
+    HDRJob job;
+
+    memset(&job, 0, sizeof(job));
+    job.row = hdr_fill_job_row;
+    job.w = w;
+    job.h = h;
+    job.op = op;
+    job.dst = dst;
+    job.dstpitch = dstpitch;
+    job.color = color;
+    return hdr_run(&job, "hdr_fill");
+}
+
+/* Write a w by h area of src pixels to (x, y) of a locked 32 bit surface
+ * with 8 bit channels, scaled by exposure, tonemapped and sRGB encoded */
+int
+pg_HDRTonemap(SDL_Surface *dst, int x, int y, const float *src,
+              Py_ssize_t srcpitch, int w, int h, float exposure, int method)
+{
+    HDRJob job;
+
+    memset(&job, 0, sizeof(job));
+    job.row = hdr_tonemap_job_row;
+    job.w = w;
+    job.h = h;
+    job.src = src;
+    job.srcpitch = srcpitch;
+    job.surf = dst;
+    job.x = x;
+    job.y = y;
+    job.exposure = exposure;
+    job.method = method;
+    return hdr_run(&job, "hdr_tonemap");
+}
@@ -37,19 +37,460 @@ pgSurface_Unlock(pgSurfaceObject *);
 static int
 pgSurface_LockBy(pgSurfaceObject *, PyObject *);
 static int
+_lock_by(pgSurfaceObject *, PyObject *, int);
+static int
 pgSurface_UnlockBy(pgSurfaceObject *, PyObject *);
+static int
+pgSurface_LockRead(pgSurfaceObject *);
+static int
+pgSurface_UnlockRead(pgSurfaceObject *);
+static int
+pgSurface_Unpack(SDL_Surface *);
 
 static void
 _lifelock_dealloc(PyObject *);
 
+#ifdef SDL_SIMD_ALIGNED
+#define PG_SURF_BUFFER_FLAGS SDL_SIMD_ALIGNED
+#else
+#define PG_SURF_BUFFER_FLAGS 0
+#endif
+
+/* A pixel buffer shared by Surface.copy() results until they are written
+ * to. Members carry PG_SURF_SHARED and SDL_PREALLOC, so SDL never frees the
+ * buffer itself; the last member left takes it back as its own.
+ */
+typedef struct {
+    void *pixels;
+    Py_ssize_t members;
+    Uint32 bufferflags; /* allocation flags of the surface that made it */
+} pgSharedPixels;
+
+static pgSharedPixels *_shared = NULL;
+static Py_ssize_t _shared_count = 0;
+static Py_ssize_t _shared_size = 0;
+
+static pgSharedPixels *
+_shared_find(void *pixels)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < _shared_count; i++) {
+        if (_shared[i].pixels == pixels) {
+            return _shared + i;
+        }
+    }
+    return NULL;
+}
+
+/* Hand the buffer of the only member left back to it */
+static void
+_shared_adopt(SDL_Surface *surf, pgSharedPixels *share)
+{
+    surf->flags &= ~(SDL_PREALLOC | PG_SURF_SHARED);
+    surf->flags |= share->bufferflags;
+    *share = _shared[--_shared_count];
+}
+
+/* Return a new surface using the pixels of surf, or NULL with a Python
+ * exception set. The caller makes sure surf owns a plain, unlocked pixel
+ * buffer that is not pinned by subsurfaces.
+ */
+static SDL_Surface *
+pgSurface_SharePixels(SDL_Surface *surf)
+{
+    SDL_PixelFormat *fmt = surf->format;
+    pgSharedPixels *share = NULL;
+    SDL_Surface *copy;
+
+    copy = SDL_CreateRGBSurfaceFrom(surf->pixels, surf->w, surf->h,
+                                    fmt->BitsPerPixel, surf->pitch,
+                                    fmt->Rmask, fmt->Gmask, fmt->Bmask,
+                                    fmt->Amask);
+    if (copy == NULL) {
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        return NULL;
+    }
+
+    if (surf->flags & PG_SURF_SHARED) {
+        share = _shared_find(surf->pixels);
+    }
+    if (share == NULL) {
+        if (_shared_count == _shared_size) {
+            Py_ssize_t size = _shared_size ? _shared_size * 2 : 16;
+            pgSharedPixels *table = PyMem_Realloc(
+                _shared, (size_t)size * sizeof(pgSharedPixels));
+
+            if (table == NULL) {
+                SDL_FreeSurface(copy);
+                PyErr_NoMemory();
+                return NULL;
+            }
+            _shared = table;
+            _shared_size = size;
+        }
+        share = _shared + _shared_count++;
+        share->pixels = surf->pixels;
+        share->members = 1;
+        share->bufferflags = surf->flags & PG_SURF_BUFFER_FLAGS;
+        surf->flags &= ~PG_SURF_BUFFER_FLAGS;
+        surf->flags |= SDL_PREALLOC | PG_SURF_SHARED;
+    }
+    share->members++;
+    copy->flags |= PG_SURF_SHARED;
+    return copy;
+}
+
+/* Give surf pixels of its own before they are written to. Returns 0 with
+ * a Python exception set if out of memory.
+ */
+static int
+pgSurface_Unshare(SDL_Surface *surf)
+{
+    pgSharedPixels *share;
+    size_t size;
+    void *pixels;
+
+    if (surf == NULL) {
+        return 1;
+    }
+    if ((surf->flags & PG_SURF_PACKED) && !pgSurface_Unpack(surf)) {
+        return 0;
+    }
+    /* the pixels are about to change, so their blit spans go stale */
+    surf->flags &= ~PG_SURF_SPANS;
+    if (!(surf->flags & PG_SURF_SHARED)) {
+        return 1;
+    }
+    share = _shared_find(surf->pixels);
+    if (share == NULL) {
+        surf->flags &= ~PG_SURF_SHARED;
+        return 1;
+    }
+    if (share->members == 1) {
+        _shared_adopt(surf, share);
+        return 1;
+    }
+
+    size = (size_t)surf->pitch * surf->h;
+#ifdef SDL_SIMD_ALIGNED
+    pixels = SDL_SIMDAlloc(size ? size : 1);
+#else
+    pixels = SDL_malloc(size ? size : 1);
+#endif
+    if (pixels == NULL) {
+        PyErr_NoMemory();
+        return 0;
+    }
+    memcpy(pixels, surf->pixels, size);
+    surf->pixels = pixels;
+    surf->flags &= ~(SDL_PREALLOC | PG_SURF_SHARED);
+    surf->flags |= PG_SURF_BUFFER_FLAGS;
+    share->members--;
+    return 1;
+}
+
+/* Leave the share of a surface about to be freed */
+static void
+pgSurface_ReleaseShare(SDL_Surface *surf)
+{
+    pgSharedPixels *share;
+
+    if (surf == NULL || !(surf->flags & PG_SURF_SHARED)) {
+        return;
+    }
+    share = _shared_find(surf->pixels);
+    if (share != NULL && share->members > 1 && surf->refcount > 1) {
+        /* SDL keeps using the surface; it needs a buffer that stays */
+        if (pgSurface_Unshare(surf)) {
+            return;
+        }
+        PyErr_Clear();
+    }
+    if (share != NULL && share->members == 1) {
+        _shared_adopt(surf, share);
+        return;
+    }
+    if (share != NULL) {
+        share->members--;
+    }
+    surf->flags &= ~PG_SURF_SHARED;
+}
+
+/* Packed pixels: pgSurface_Pack swaps the pixels of a surface for a run
+ * length encoded copy and frees them. Like SDL does with an RLE surface,
+ * the surface is left with NULL pixels, here until pgSurface_Unpack
+ * decodes them into a new buffer. Locks, pgSurface_Prep and
+ * pgSurface_Unshare unpack first, so only code reading the pixels without
+ * any of them has to call pgSurface_Unpack itself.
+ *
+ * Each row is a series of packets, as in RLE TGA files: a count byte n
+ * followed by one pixel repeated (n & 0x7F) + 1 times if the top bit is
+ * set, or by n + 1 literal pixels if not.
+ */
+typedef struct {
+    SDL_Surface *surf;
+    Uint8 *data;
+    size_t size;
+    Uint32 bufferflags; /* allocation flags of the freed pixels */
+} pgPackedPixels;
+
+static pgPackedPixels *_packed = NULL;
+static Py_ssize_t _packed_count = 0;
+static Py_ssize_t _packed_size = 0;
+
+static pgPackedPixels *
+_packed_find(SDL_Surface *surf)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < _packed_count; i++) {
+        if (_packed[i].surf == surf) {
+            return _packed + i;
+        }
+    }
+    return NULL;
+}
+
+/* Encode the w pixels of bpp bytes at src into dst, returning the bytes
+ * written. dst holds at least w * bpp + (w + 127) / 128 bytes.
+ */
+static size_t
+_pack_row(const Uint8 *src, Uint8 *dst, int w, int bpp)
+{
+    Uint8 *out = dst;
+    int x = 0, run, raw;
+
+    while (x < w) {
+        /* a run of one pixel repeated */
+        run = 1;
+        while (x + run < w && run < 128 &&
+               !memcmp(src + x * bpp, src + (x + run) * bpp, bpp)) {
+            run++;
+        }
+        if (run > 1) {
+            *out++ = (Uint8)(0x80 | (run - 1));
+            memcpy(out, src + x * bpp, bpp);
+            out += bpp;
+            x += run;
+            continue;
+        }
+        /* literal pixels, up to where a run of two starts */
+        raw = 1;
+        while (x + raw < w && raw < 128 &&
+               (x + raw + 1 >= w ||
+                memcmp(src + (x + raw) * bpp, src + (x + raw + 1) * bpp,
+                       bpp))) {
+            raw++;
+        }
+        *out++ = (Uint8)(raw - 1);
+        memcpy(out, src + x * bpp, (size_t)raw * bpp);
+        out += (size_t)raw * bpp;
+        x += raw;
+    }
+    return out - dst;
+}
+
+static const Uint8 *
+_unpack_row(const Uint8 *src, Uint8 *dst, int w, int bpp)
+{
+    int x = 0, n, i;
+
+    while (x < w) {
+        n = (*src & 0x7F) + 1;
+        if (*src++ & 0x80) {
+            for (i = 0; i < n; i++) {
+                memcpy(dst + (x + i) * bpp, src, bpp);
+            }
+            src += bpp;
+        }
+        else {
+            memcpy(dst + x * bpp, src, (size_t)n * bpp);
+            src += (size_t)n * bpp;
+        }
+        x += n;
+    }
+    return src;
+}
+
+/* Pack the pixels of surf. Returns the bytes they take packed, 0 if surf
+ * is left as it is, because its pixels are not its own to free or would
+ * not get any smaller, or -1 with a Python exception set.
+ */
+static Py_ssize_t
+pgSurface_Pack(SDL_Surface *surf)
+{
+    pgPackedPixels *entry;
+    int bpp, y;
+    size_t rowsize, size = 0;
+    Uint8 *data, *smaller;
+
+    if (surf == NULL) {
+        return 0;
+    }
+    if (surf->flags & PG_SURF_PACKED) {
+        entry = _packed_find(surf);
+        return entry ? (Py_ssize_t)entry->size : 0;
+    }
+    if (!surf->pixels || surf->w < 1 || surf->h < 1 || surf->locked ||
+        (surf->flags & (SDL_PREALLOC | SDL_RLEACCEL | PG_SURF_SHARED |
+                        PG_SURF_PINNED | PG_SURF_POOLED))) {
+        return 0;
+    }
+
+    bpp = surf->format->BytesPerPixel;
+    rowsize = (size_t)surf->w * bpp + (surf->w + 127) / 128;
+    data = SDL_malloc(rowsize * surf->h);
+    if (data == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (y = 0; y < surf->h; y++) {
+        size += _pack_row((Uint8 *)surf->pixels + (size_t)y * surf->pitch,
+                          data + size, surf->w, bpp);
+    }
+    if (size >= (size_t)surf->pitch * surf->h) {
+        SDL_free(data);
+        return 0;
+    }
+    smaller = SDL_realloc(data, size);
+    if (smaller != NULL) {
+        data = smaller;
+    }
+
+    if (_packed_count == _packed_size) {
+        Py_ssize_t count = _packed_size ? _packed_size * 2 : 16;
+        pgPackedPixels *table = PyMem_Realloc(
+            _packed, (size_t)count * sizeof(pgPackedPixels));
+
+        if (table == NULL) {
+            SDL_free(data);
+            PyErr_NoMemory();
+            return -1;
+        }
+        _packed = table;
+        _packed_size = count;
+    }
+    entry = _packed + _packed_count++;
+    entry->surf = surf;
+    entry->data = data;
+    entry->size = size;
+    entry->bufferflags = surf->flags & PG_SURF_BUFFER_FLAGS;
+
+#ifdef SDL_SIMD_ALIGNED
+    if (surf->flags & SDL_SIMD_ALIGNED) {
+        SDL_SIMDFree(surf->pixels);
+    }
+    else {
+        SDL_free(surf->pixels);
+    }
+#else
+    SDL_free(surf->pixels);
+#endif
+    surf->pixels = NULL;
+    surf->flags &= ~(PG_SURF_BUFFER_FLAGS | PG_SURF_SPANS);
+    surf->flags |= PG_SURF_PACKED;
+    return (Py_ssize_t)size;
+}
+
+/* Give a packed surf its pixels back. Returns 0 with a Python exception
+ * set if out of memory.
+ */
+static int
+pgSurface_Unpack(SDL_Surface *surf)
+{
+    pgPackedPixels *entry;
+    const Uint8 *src;
+    Uint8 *pixels;
+    size_t size;
+    int bpp, y;
+
+    if (surf == NULL || !(surf->flags & PG_SURF_PACKED)) {
+        return 1;
+    }
+    entry = _packed_find(surf);
+    if (entry == NULL) {
+        surf->flags &= ~PG_SURF_PACKED;
+        return 1;
+    }
+
+    size = (size_t)surf->pitch * surf->h;
+#ifdef SDL_SIMD_ALIGNED
+    if (entry->bufferflags & SDL_SIMD_ALIGNED) {
+        pixels = SDL_SIMDAlloc(size);
+    }
+    else {
+        pixels = SDL_malloc(size);
+    }
+#else
+    pixels = SDL_malloc(size);
+#endif
+    if (pixels == NULL) {
+        PyErr_NoMemory();
+        return 0;
+    }
+    bpp = surf->format->BytesPerPixel;
+    src = entry->data;
+    for (y = 0; y < surf->h; y++) {
+        src = _unpack_row(src, pixels + (size_t)y * surf->pitch, surf->w,
+                          bpp);
+        memset(pixels + (size_t)y * surf->pitch + (size_t)surf->w * bpp, 0,
+               surf->pitch - (size_t)surf->w * bpp);
+    }
+
+    surf->pixels = pixels;
+    surf->flags &= ~PG_SURF_PACKED;
+    surf->flags |= entry->bufferflags;
+    SDL_free(entry->data);
+    *entry = _packed[--_packed_count];
+    return 1;
+}
+
+/* Drop the packed pixels of a surface about to be freed */
+static void
+pgSurface_ReleasePack(SDL_Surface *surf)
+{
+    pgPackedPixels *entry;
+
+    if (surf == NULL || !(surf->flags & PG_SURF_PACKED)) {
+        return;
+    }
+    entry = _packed_find(surf);
+    if (entry != NULL) {
+        SDL_free(entry->data);
+        *entry = _packed[--_packed_count];
+    }
+    surf->flags &= ~PG_SURF_PACKED;
+}
+
+/* The bytes the pixels of surf take packed, or 0 if they are not */
+static Py_ssize_t
+pgSurface_PackedSize(SDL_Surface *surf)
+{
+    pgPackedPixels *entry;
+
+    if (surf == NULL || !(surf->flags & PG_SURF_PACKED)) {
+        return 0;
+    }
+    entry = _packed_find(surf);
+    return entry ? (Py_ssize_t)entry->size : 0;
+}
+
 static void
 pgSurface_Prep(pgSurfaceObject *surfobj)
 {
     struct pgSubSurface_Data *data = ((pgSurfaceObject *)surfobj)->subsurface;
+
+    if (!pgSurface_Unpack(surfobj->surf)) {
+        /* there is no way to report it, and no pixels to use */
+        PyErr_Clear();
+        Py_FatalError("out of memory unpacking Surface pixels");
+    }
     if (data != NULL) {
         SDL_Surface *surf = pgSurface_AsSurface(surfobj);
         SDL_Surface *owner = pgSurface_AsSurface(data->owner);
-        pgSurface_LockBy((pgSurfaceObject *)data->owner, (PyObject *)surfobj);
+        /* the subsurface bumps the parent versions itself when written */
+        _lock_by((pgSurfaceObject *)data->owner, (PyObject *)surfobj, 0);
         surf->pixels = ((char *)owner->pixels) + data->pixeloffset;
     }
 }
@@ -78,10 +519,89 @@ pgSurface_Unlock(pgSurfaceObject *surfobj)
 
 static int
 pgSurface_LockBy(pgSurfaceObject *surfobj, PyObject *lockobj)
+{
+    /* writers wait for the readers to finish */
+    if (surfobj->readlocks > 0) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "Surface is locked for reading");
+        return 0;
+    }
+    return _lock_by(surfobj, lockobj, 1);
+}
+
+/* Lock surfobj for reading only. A read lock is a plain count rather than
+ * an entry in the lock list, and it neither unshares nor touches the
+ * pixels. While any are held pgSurface_LockBy fails, so the pixels can be
+ * read from several threads at once with the GIL released. Read locks are
+ * taken and dropped with the GIL held.
+ */
+static int
+pgSurface_LockRead(pgSurfaceObject *surfobj)
+{
+    struct pgSubSurface_Data *data = surfobj->subsurface;
+    pgSurfaceObject *owner = NULL;
+
+    if (surfobj->readlocks == 0 && !pgSurface_Unpack(surfobj->surf)) {
+        return 0;
+    }
+    if (surfobj->readlocks++ > 0) {
+        return 1;
+    }
+    if (data != NULL) {
+        owner = (pgSurfaceObject *)data->owner;
+        if (!pgSurface_LockRead(owner)) {
+            surfobj->readlocks--;
+            return 0;
+        }
+        surfobj->surf->pixels =
+            ((char *)owner->surf->pixels) + data->pixeloffset;
+    }
+    if (SDL_LockSurface(surfobj->surf) == -1) {
+        if (owner != NULL) {
+            pgSurface_UnlockRead(owner);
+        }
+        surfobj->readlocks--;
+        PyErr_SetString(PyExc_RuntimeError, "error locking surface");
+        return 0;
+    }
+    return 1;
+}
+
+static int
+pgSurface_UnlockRead(pgSurfaceObject *surfobj)
+{
+    if (surfobj->readlocks <= 0 || --surfobj->readlocks > 0) {
+        return 1;
+    }
+    if (surfobj->surf != NULL) {
+        SDL_UnlockSurface(surfobj->surf);
+    }
+    if (surfobj->subsurface != NULL) {
+        pgSurface_UnlockRead((pgSurfaceObject *)surfobj->subsurface->owner);
+    }
+    return 1;
+}
+
+/* Lock surfobj for lockobj. If touch is set the versions of surfobj and
+ * its subsurface parents are bumped.
+ */
+static int
+_lock_by(pgSurfaceObject *surfobj, PyObject *lockobj, int touch)
 {
     PyObject *ref;
     pgSurfaceObject *surf = (pgSurfaceObject *)surfobj;
+    pgSurfaceObject *touched = surf;
 
+    /* a lock hands out the pixels for writing */
+    if (!pgSurface_Unshare(surf->surf)) {
+        return 0;
+    }
+    while (touch) {
+        touched->version++;
+        if (!touched->subsurface)
+            break;
+        touched = (pgSurfaceObject *)touched->subsurface->owner;
+    }
     if (surf->locklist == NULL) {
         surf->locklist = PyList_New(0);
         if (surf->locklist == NULL) {
@@ -253,6 +773,15 @@ MODINIT_DEFINE(surflock)
     c_api[5] = pgSurface_LockBy;
     c_api[6] = pgSurface_UnlockBy;
     c_api[7] = pgSurface_LockLifetime;
+    c_api[8] = pgSurface_SharePixels;
+    c_api[9] = pgSurface_Unshare;
+    c_api[10] = pgSurface_ReleaseShare;
+    c_api[11] = pgSurface_LockRead;
+    c_api[12] = pgSurface_UnlockRead;
+    c_api[13] = pgSurface_Pack;
+    c_api[14] = pgSurface_Unpack;
+    c_api[15] = pgSurface_ReleasePack;
+    c_api[16] = pgSurface_PackedSize;
     apiobj = encapsulate_api(c_api, "surflock");
     if (PyModule_AddObject(module, PYGAMEAPI_LOCAL_ENTRY, apiobj)) {
         Py_XDECREF(apiobj);
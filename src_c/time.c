@@ -26,39 +26,288 @@
 
 #include "doc/time_doc.h"
 
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#elif !defined(__EMSCRIPTEN__) && \
+    (defined(unix) || defined(__unix__) || defined(__APPLE__))
+#define PG_HAVE_NANOSLEEP
+#include <time.h>
+#endif
+
 #define WORST_CLOCK_ACCURACY 12
 
+/* How much longer than asked the sleeps of _pg_sleep_ns() take, in
+ * milliseconds: a running average and mean deviation, learned from every
+ * sleep of _pg_delay_until() and only touched with the GIL held. */
+static double pg_sleep_overshoot = 1.0;
+static double pg_sleep_deviation = 1.0;
+
+/* The timers of set_timer() are kept in a hierarchical timing wheel with a
+ * slot for each millisecond of the next 256, then levels of 64 slots, each
+ * slot covering 64 slots of the level below. Timers are added and removed in
+ * constant time, and one SDL timer drives the whole wheel, waking only when
+ * a slot with timers comes up or a level above has to be spread out.
+ * Everything here is done with the GIL held, and then timermutex taken. */
+#define PG_WHEEL_ROOT_BITS 8
+#define PG_WHEEL_LEVEL_BITS 6
+#define PG_WHEEL_LEVELS 4
+#define PG_WHEEL_ROOT_SIZE (1 << PG_WHEEL_ROOT_BITS)
+#define PG_WHEEL_LEVEL_SIZE (1 << PG_WHEEL_LEVEL_BITS)
+#define PG_WHEEL_ROOT_MASK (PG_WHEEL_ROOT_SIZE - 1)
+#define PG_WHEEL_LEVEL_MASK (PG_WHEEL_LEVEL_SIZE - 1)
+/* the wheel spans 2 ** 32 milliseconds, later timers wait in its last level
+ * and are placed again as it turns */
+#define PG_WHEEL_MAX_DELTA 0xFFFFFFFFULL
+/* timers are found by event type in a table of this many buckets */
+#define PG_TIMER_BUCKETS 1024
+
 typedef struct pgEventTimer {
-    struct pgEventTimer *next;
-    intptr_t timer_id;
+    /* the slot list, where pprev points at the pointer to this timer */
+    struct pgEventTimer *next, **pprev;
+    struct pgEventTimer *type_next;
     pgEventObject *event;
+    Uint64 expires;
+    Uint32 interval;
+    /* events left to post, or -1 to repeat forever */
     int repeat;
 } pgEventTimer;
 
-static pgEventTimer *pg_event_timer = NULL;
+static pgEventTimer *pg_wheel_root[PG_WHEEL_ROOT_SIZE];
+static pgEventTimer *pg_wheel_levels[PG_WHEEL_LEVELS][PG_WHEEL_LEVEL_SIZE];
+static pgEventTimer *pg_timers_by_type[PG_TIMER_BUCKETS];
+static int pg_timer_count = 0;
+/* the next millisecond of the wheel to run */
+static Uint64 pg_wheel_now = 0;
+/* the SDL timer driving the wheel, and when it fires next */
+static SDL_TimerID pg_wheel_timer = 0;
+static Uint64 pg_wheel_wake = 0;
+/* passed to the SDL timer, so one that was replaced stops itself */
+static intptr_t pg_wheel_generation = 0;
 static SDL_mutex *timermutex = NULL;
-static intptr_t pg_timer_id = 0;
+
+static Uint64
+_pg_wheel_ms(void)
+{
+    return SDL_GetPerformanceCounter() /
+           (SDL_GetPerformanceFrequency() / 1000);
+}
+
+static void
+_pg_wheel_insert(pgEventTimer *timer)
+{
+    Uint64 expires = timer->expires, delta;
+    pgEventTimer **slot;
+
+    if (expires < pg_wheel_now)
+        expires = timer->expires = pg_wheel_now;
+    delta = expires - pg_wheel_now;
+    if (delta < PG_WHEEL_ROOT_SIZE) {
+        slot = &pg_wheel_root[expires & PG_WHEEL_ROOT_MASK];
+    }
+    else {
+        int level, shift = PG_WHEEL_ROOT_BITS;
+
+        if (delta > PG_WHEEL_MAX_DELTA) {
+            expires = pg_wheel_now + PG_WHEEL_MAX_DELTA;
+            delta = PG_WHEEL_MAX_DELTA;
+        }
+        for (level = 0; level < PG_WHEEL_LEVELS - 1; level++) {
+            if (delta < 1ULL << (shift + PG_WHEEL_LEVEL_BITS))
+                break;
+            shift += PG_WHEEL_LEVEL_BITS;
+        }
+        slot = &pg_wheel_levels[level][(expires >> shift) &
+                                       PG_WHEEL_LEVEL_MASK];
+    }
+
+    timer->next = *slot;
+    if (timer->next)
+        timer->next->pprev = &timer->next;
+    timer->pprev = slot;
+    *slot = timer;
+}
+
+static void
+_pg_wheel_unlink(pgEventTimer *timer)
+{
+    *timer->pprev = timer->next;
+    if (timer->next)
+        timer->next->pprev = timer->pprev;
+}
+
+/* Place the timers of a slot of a level again, now that the wheel has turned
+ * to it. Returns the index of the slot. */
+static int
+_pg_wheel_cascade(int level)
+{
+    int shift = PG_WHEEL_ROOT_BITS + level * PG_WHEEL_LEVEL_BITS;
+    int index = (int)((pg_wheel_now >> shift) & PG_WHEEL_LEVEL_MASK);
+    pgEventTimer *timer = pg_wheel_levels[level][index], *next;
+
+    pg_wheel_levels[level][index] = NULL;
+    for (; timer; timer = next) {
+        next = timer->next;
+        _pg_wheel_insert(timer);
+    }
+    return index;
+}
+
+/* Forget a timer that is not in the wheel. */
+static void
+_pg_timer_free(pgEventTimer *timer)
+{
+    pgEventTimer **hunt =
+        &pg_timers_by_type[timer->event->type % PG_TIMER_BUCKETS];
+
+    while (*hunt != timer)
+        hunt = &(*hunt)->type_next;
+    *hunt = timer->type_next;
+    pg_timer_count--;
+    Py_DECREF(timer->event);
+    PyMem_Free(timer);
+}
+
+static void
+_pg_timer_fire(pgEventTimer *timer)
+{
+    SDL_Event event;
+
+    if (SDL_WasInit(SDL_INIT_VIDEO)) {
+        if (pgEvent_FillUserEvent(timer->event, &event) < 0)
+            PyErr_Clear();
+        else if (SDL_PushEvent(&event) <= 0)
+            Py_DECREF(timer->event->dict);
+    }
+    else
+        timer->repeat = 0;
+
+    if (timer->repeat > 0)
+        timer->repeat--;
+    if (!timer->repeat) {
+        _pg_timer_free(timer);
+        return;
+    }
+    /* the next event is due an interval after this one was, so the events
+       do not drift */
+    timer->expires += timer->interval;
+    _pg_wheel_insert(timer);
+}
+
+/* Post the events of the timers due up to the millisecond until. */
+static void
+_pg_wheel_run(Uint64 until)
+{
+    while (pg_wheel_now <= until && pg_timer_count) {
+        int index = (int)(pg_wheel_now & PG_WHEEL_ROOT_MASK), level = 0;
+        pgEventTimer *timer, *next;
+
+        if (!index) {
+            while (level < PG_WHEEL_LEVELS && !_pg_wheel_cascade(level))
+                level++;
+        }
+        timer = pg_wheel_root[index];
+        pg_wheel_root[index] = NULL;
+        for (; timer; timer = next) {
+            next = timer->next;
+            _pg_timer_fire(timer);
+        }
+        pg_wheel_now++;
+    }
+    if (pg_wheel_now <= until)
+        pg_wheel_now = until + 1;
+}
+
+/* Milliseconds from pg_wheel_now until the wheel has to run again, or 0 when
+ * there are no timers. */
+static Uint32
+_pg_wheel_next_delay(void)
+{
+    int index = (int)(pg_wheel_now & PG_WHEEL_ROOT_MASK), i;
+
+    if (!pg_timer_count)
+        return 0;
+    for (i = index; i < PG_WHEEL_ROOT_SIZE; i++) {
+        if (pg_wheel_root[i])
+            return i - index + 1;
+    }
+    /* the root slots before index come up after the wheel turns over, which
+       is also when the levels above are spread out */
+    return PG_WHEEL_ROOT_SIZE - index + 1;
+}
+
+static Uint32
+_pg_wheel_callback(Uint32 interval, void *param)
+{
+    PyGILState_STATE gstate;
+    Uint32 delay = 0;
+
+    /* This function runs in a separate thread, so we acquire the GIL,
+     * posting events and freeing timers do python API calls. The GIL is
+     * always taken before the mutex. */
+    gstate = PyGILState_Ensure();
+    if (timermutex && (intptr_t)param == pg_wheel_generation &&
+        SDL_LockMutex(timermutex) == 0) {
+        Uint64 now = _pg_wheel_ms();
+
+        _pg_wheel_run(now);
+        delay = _pg_wheel_next_delay();
+        pg_wheel_wake = now + delay;
+        if (!delay)
+            pg_wheel_timer = 0;
+        SDL_UnlockMutex(timermutex);
+    }
+    PyGILState_Release(gstate);
+    return delay;
+}
+
+/* Make sure the SDL timer fires by the time the timer just added is due. */
+static int
+_pg_wheel_schedule(Uint64 now, Uint64 expires)
+{
+    if (pg_wheel_timer) {
+        if (pg_wheel_wake <= expires)
+            return 0;
+        SDL_RemoveTimer(pg_wheel_timer);
+    }
+    pg_wheel_generation++;
+    pg_wheel_wake = expires;
+    pg_wheel_timer =
+        SDL_AddTimer((Uint32)(expires > now ? expires - now : 1),
+                     _pg_wheel_callback, (void *)pg_wheel_generation);
+    return pg_wheel_timer ? 0 : -1;
+}
 
 static PyObject *
 pg_time_autoquit(PyObject *self, PyObject *_null)
 {
-    pgEventTimer *hunt, *todel;
+    int i, level;
+    pgEventTimer *timer, *next;
     /* We can let errors silently pass in this function, because this
      * needs to run */
     if (timermutex) {
         SDL_LockMutex(timermutex);
     }
-    if (pg_event_timer) {
-        hunt = pg_event_timer;
-        while (hunt) {
-            todel = hunt;
-            hunt = hunt->next;
-            Py_DECREF(todel->event);
-            PyMem_Free(todel);
+    if (pg_wheel_timer) {
+        SDL_RemoveTimer(pg_wheel_timer);
+        pg_wheel_timer = 0;
+    }
+    pg_wheel_generation++;
+    for (i = 0; i < PG_TIMER_BUCKETS; i++) {
+        for (timer = pg_timers_by_type[i]; timer; timer = next) {
+            next = timer->type_next;
+            Py_DECREF(timer->event);
+            PyMem_Free(timer);
         }
-        pg_event_timer = NULL;
-        pg_timer_id = 0;
+        pg_timers_by_type[i] = NULL;
     }
+    memset(pg_wheel_root, 0, sizeof(pg_wheel_root));
+    for (level = 0; level < PG_WHEEL_LEVELS; level++)
+        memset(pg_wheel_levels[level], 0, sizeof(pg_wheel_levels[level]));
+    pg_timer_count = 0;
     if (timermutex) {
         SDL_UnlockMutex(timermutex);
         /* After we are done, we can destroy the mutex as well */
@@ -82,126 +331,156 @@ pg_time_autoinit(PyObject *self, PyObject *_null)
     Py_RETURN_NONE;
 }
 
-static intptr_t
-_pg_add_event_timer(pgEventObject *ev, int repeat)
+/* Set the timer for the type of ev, replacing the one there was, or only
+ * remove it when millis is 0. Steals the reference to ev. */
+static int
+_pg_set_event_timer(pgEventObject *ev, int millis, int loops)
 {
-    pgEventTimer *new;
-
-    new = PyMem_New(pgEventTimer, 1);
-    if (!new) {
-        PyErr_NoMemory();
-        return 0;
+    pgEventTimer **hunt, *timer = NULL;
+    Uint64 now;
+    int ret = 0;
+
+    if (millis > 0) {
+        timer = PyMem_New(pgEventTimer, 1);
+        if (!timer) {
+            Py_DECREF(ev);
+            PyErr_NoMemory();
+            return -1;
+        }
     }
 
     if (SDL_LockMutex(timermutex) < 0) {
         /* this case will almost never happen, but still handle it */
-        PyMem_Free(new);
+        PyMem_Free(timer);
+        Py_DECREF(ev);
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
-        return 0;
+        return -1;
     }
 
-    pg_timer_id++;
-
-    new->next = pg_event_timer;
-    new->timer_id = pg_timer_id;
-    new->event = ev;
-    new->repeat = repeat;
-    pg_event_timer = new;
-
-    /* Chances of it failing here are next to zero, dont do anything */
-    SDL_UnlockMutex(timermutex);
-    return new->timer_id;
-}
+    /* stop original timer, if it exists */
+    hunt = &pg_timers_by_type[ev->type % PG_TIMER_BUCKETS];
+    while (*hunt && (*hunt)->event->type != ev->type)
+        hunt = &(*hunt)->type_next;
+    if (*hunt) {
+        _pg_wheel_unlink(*hunt);
+        _pg_timer_free(*hunt);
+    }
 
-static void
-_pg_remove_event_timer(pgEventObject *ev)
-{
-    pgEventTimer *hunt, *prev = NULL;
-
-    SDL_LockMutex(timermutex);
-    if (pg_event_timer) {
-        hunt = pg_event_timer;
-        while (hunt->event->type != ev->type) {
-            prev = hunt;
-            hunt = hunt->next;
-            if (!hunt) {
-                /* Reached end without finding a match, quit early */
-                SDL_UnlockMutex(timermutex);
-                return;
-            }
+    if (!timer) {
+        Py_DECREF(ev);
+    }
+    else {
+        now = _pg_wheel_ms();
+        if (!pg_timer_count) {
+            /* nothing is left to run in the wheel */
+            pg_wheel_now = now;
+        }
+        timer->event = ev;
+        timer->expires = now + millis;
+        timer->interval = millis;
+        timer->repeat = loops > 0 ? loops : -1;
+        timer->type_next = pg_timers_by_type[ev->type % PG_TIMER_BUCKETS];
+        pg_timers_by_type[ev->type % PG_TIMER_BUCKETS] = timer;
+        pg_timer_count++;
+        _pg_wheel_insert(timer);
+
+        if (_pg_wheel_schedule(now, timer->expires) < 0) {
+            _pg_wheel_unlink(timer);
+            _pg_timer_free(timer);
+            PyErr_SetString(pgExc_SDLError, SDL_GetError());
+            ret = -1;
         }
-        if (prev)
-            prev->next = hunt->next;
-        else
-            pg_event_timer = hunt->next;
-        Py_DECREF(hunt->event);
-        PyMem_Del(hunt);
     }
+
     /* Chances of it failing here are next to zero, dont do anything */
     SDL_UnlockMutex(timermutex);
+    return ret;
 }
 
-static pgEventTimer *
-_pg_get_event_on_timer(intptr_t timer_id)
+/* Sleep with the finest timer the platform has, this can be called without
+ * the GIL. */
+static void
+_pg_sleep_ns(Uint64 ns)
 {
-    pgEventTimer *hunt;
-
-    if (SDL_LockMutex(timermutex) < 0)
-        return NULL;
-
-    hunt = pg_event_timer;
-    while (hunt) {
-        if (hunt->timer_id == timer_id) {
-            if (hunt->repeat >= 0) {
-                hunt->repeat--;
-            }
-            break;
-        }
-        hunt = hunt->next;
+#if defined(_WIN32)
+    /* high resolution waitable timers exist from Windows 10 1803, Sleep()
+       only wakes on the scheduler tick */
+    HANDLE timer = CreateWaitableTimerExW(
+        NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (timer) {
+        LARGE_INTEGER due;
+        due.QuadPart = -(LONGLONG)(ns / 100);
+        if (SetWaitableTimer(timer, &due, 0, NULL, NULL, FALSE))
+            WaitForSingleObject(timer, INFINITE);
+        CloseHandle(timer);
+        return;
     }
-
-    /* Chances of it failing here are next to zero, dont do anything */
-    SDL_UnlockMutex(timermutex);
-    return hunt;
+    Sleep((DWORD)(ns / 1000000));
+#elif defined(PG_HAVE_NANOSLEEP)
+    struct timespec ts;
+    ts.tv_sec = (time_t)(ns / 1000000000);
+    ts.tv_nsec = (long)(ns % 1000000000);
+    nanosleep(&ts, NULL);
+#else
+    SDL_Delay((Uint32)(ns / 1000000));
+#endif
 }
 
-static Uint32
-timer_callback(Uint32 interval, void *param)
+/* Wait until the performance counter reaches until, and return how late
+ * that was in milliseconds, or -1.0 if until had already passed.
+ *
+ * Without spin this sleeps for the time left less the usual oversleep, so the
+ * wakeups land around until at little CPU cost. With spin it sleeps for the
+ * time left less a margin that covers nearly every oversleep seen, and spends
+ * the rest in a busy loop, which hits until closely for a fraction of a
+ * millisecond of spinning once the margin is learned. */
+static double
+_pg_delay_until(Uint64 until, int spin)
 {
-    pgEventTimer *evtimer;
-    SDL_Event event;
-    PyGILState_STATE gstate;
-
-    evtimer = _pg_get_event_on_timer((intptr_t)param);
-    if (!evtimer)
-        return 0;
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 now = SDL_GetPerformanceCounter(), slept = 0;
+    double asked, margin;
 
-    /* This function runs in a separate thread, so we acquire the GIL,
-     * pgEvent_FillUserEvent and _pg_remove_event_timer do python API calls */
-    gstate = PyGILState_Ensure();
+    if (now >= until)
+        return -1.0;
 
-    if (SDL_WasInit(SDL_INIT_VIDEO)) {
-        pgEvent_FillUserEvent(evtimer->event, &event);
-        if (SDL_PushEvent(&event) <= 0)
-            Py_DECREF(evtimer->event->dict);
+    if (spin) {
+        margin = pg_sleep_overshoot + 4 * pg_sleep_deviation;
+        if (margin > WORST_CLOCK_ACCURACY)
+            margin = WORST_CLOCK_ACCURACY;
     }
-    else
-        evtimer->repeat = 0;
+    else {
+        margin = pg_sleep_overshoot;
+    }
+    if (margin < 0)
+        margin = 0;
+    asked = (until - now) * 1000.0 / frequency - margin;
 
-    if (!evtimer->repeat) {
-        /* This does memory cleanup */
-        _pg_remove_event_timer(evtimer->event);
-        interval = 0;
+    Py_BEGIN_ALLOW_THREADS;
+    if (asked > 0) {
+        _pg_sleep_ns((Uint64)(asked * 1000000.0));
+        slept = SDL_GetPerformanceCounter() - now;
+    }
+    if (spin) {
+        while (SDL_GetPerformanceCounter() < until) {
+        }
     }
+    now = SDL_GetPerformanceCounter();
+    Py_END_ALLOW_THREADS;
 
-    PyGILState_Release(gstate);
-    return interval;
+    if (asked > 0) {
+        double over = slept * 1000.0 / frequency - asked;
+        pg_sleep_deviation +=
+            (fabs(over - pg_sleep_overshoot) - pg_sleep_deviation) / 16;
+        pg_sleep_overshoot += (over - pg_sleep_overshoot) / 16;
+    }
+    return now > until ? (now - until) * 1000.0 / frequency : 0.0;
 }
 
 static int
 accurate_delay(int ticks)
 {
-    int funcstart, delay;
+    int funcstart;
     if (ticks <= 0)
         return 0;
 
@@ -213,18 +492,9 @@ accurate_delay(int ticks)
     }
 
     funcstart = SDL_GetTicks();
-    if (ticks >= WORST_CLOCK_ACCURACY) {
-        delay = (ticks - 2) - (ticks % WORST_CLOCK_ACCURACY);
-        if (delay >= WORST_CLOCK_ACCURACY) {
-            Py_BEGIN_ALLOW_THREADS;
-            SDL_Delay(delay);
-            Py_END_ALLOW_THREADS;
-        }
-    }
-    do {
-        delay = ticks - (SDL_GetTicks() - funcstart);
-    } while (delay > 0);
-
+    _pg_delay_until(SDL_GetPerformanceCounter() +
+                        (Uint64)ticks * SDL_GetPerformanceFrequency() / 1000,
+                    1);
     return SDL_GetTicks() - funcstart;
 }
 
@@ -294,7 +564,6 @@ static PyObject *
 time_set_timer(PyObject *self, PyObject *args, PyObject *kwargs)
 {
     int ticks, loops = 0;
-    intptr_t timer_id;
     PyObject *obj;
     pgEventObject *e;
 
@@ -327,103 +596,140 @@ time_set_timer(PyObject *self, PyObject *args, PyObject *kwargs)
         return RAISE(PyExc_TypeError,
                      "first argument must be an event type or event object");
 
-    /* stop original timer, if it exists */
-    _pg_remove_event_timer(e);
-
-    if (ticks <= 0) {
-        Py_DECREF(e);
-        Py_RETURN_NONE;
-    }
-
     /* just doublecheck that timer is initialized */
-    if (!SDL_WasInit(SDL_INIT_TIMER)) {
+    if (ticks > 0 && !SDL_WasInit(SDL_INIT_TIMER)) {
         if (SDL_InitSubSystem(SDL_INIT_TIMER)) {
             Py_DECREF(e);
             return RAISE(pgExc_SDLError, SDL_GetError());
         }
     }
 
-    timer_id = _pg_add_event_timer(e, loops);
-    if (!timer_id) {
-        Py_DECREF(e);
+    if (_pg_set_event_timer(e, ticks, loops) < 0)
         return NULL;
-    }
-
-    if (!SDL_AddTimer(ticks, timer_callback, (void *)timer_id)) {
-        _pg_remove_event_timer(e); /* Does cleanup */
-        return RAISE(pgExc_SDLError, SDL_GetError());
-    }
 
     Py_RETURN_NONE;
 }
 
 /*clock object interface*/
 typedef struct {
-    PyObject_HEAD int last_tick;
-    int fps_count, fps_tick;
+    /* times are SDL performance counter values, durations are milliseconds */
+    PyObject_HEAD Uint64 last_tick;
+    /* when the clock was made */
+    Uint64 origin;
+    /* when the next frame is due when ticking at framerate, or 0 */
+    Uint64 deadline;
+    double framerate;
+    int fps_count;
+    Uint64 fps_tick;
     float fps;
-    int timepassed, rawpassed;
+    double timepassed, rawpassed;
+    /* how late the delays of tick() woke up, in milliseconds */
+    long late_count;
+    double late_sum, late_max;
+    /* timepassed and rawpassed in whole milliseconds, see _pg_clock_ms */
+    long timepassed_ms, rawpassed_ms;
     PyObject *rendered;
+    /* ring buffer of the last history_len frame times */
+    double *history;
+    Py_ssize_t history_len, history_pos, history_count;
 } PyClockObject;
 
+static double
+_pg_counter_to_ms(Uint64 count)
+{
+    return count * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+/* The whole milliseconds between two times, counted as the difference of
+ * their millisecond ticks since the clock was made, like SDL_GetTicks() does.
+ * Truncating the difference itself would make every frame of 16.7 ms a frame
+ * of 16 ms. */
+static long
+_pg_clock_ms(PyClockObject *_clock, Uint64 start, Uint64 end)
+{
+    return (long)_pg_counter_to_ms(end - _clock->origin) -
+           (long)_pg_counter_to_ms(start - _clock->origin);
+}
+
 // to be called by the other tick functions.
 static PyObject *
 clock_tick_base(PyObject *self, PyObject *arg, int use_accurate_delay)
 {
     PyClockObject *_clock = (PyClockObject *)self;
-    float framerate = 0.0f;
-    int nowtime;
+    double framerate = 0.0, late;
+    Uint64 nowtime, frequency;
 
-    if (!PyArg_ParseTuple(arg, "|f", &framerate))
+    if (!PyArg_ParseTuple(arg, "|d", &framerate))
         return NULL;
 
-    if (framerate) {
-        int delay, endtime = (int)((1.0f / framerate) * 1000.0f);
-        _clock->rawpassed = SDL_GetTicks() - _clock->last_tick;
-        delay = endtime - _clock->rawpassed;
-
-        /*just doublecheck that timer is initialized*/
-        if (!SDL_WasInit(SDL_INIT_TIMER)) {
-            if (SDL_InitSubSystem(SDL_INIT_TIMER)) {
-                return RAISE(pgExc_SDLError, SDL_GetError());
-            }
+    /*just doublecheck that timer is initialized*/
+    if (!SDL_WasInit(SDL_INIT_TIMER)) {
+        if (SDL_InitSubSystem(SDL_INIT_TIMER)) {
+            return RAISE(pgExc_SDLError, SDL_GetError());
         }
+    }
+    frequency = SDL_GetPerformanceFrequency();
 
-        if (use_accurate_delay)
-            delay = accurate_delay(delay);
-        else {
-            // this uses sdls delay, which can be inaccurate.
-            if (delay < 0)
-                delay = 0;
+    if (framerate > 0) {
+        Uint64 period = (Uint64)(frequency / framerate);
 
-            Py_BEGIN_ALLOW_THREADS;
-            SDL_Delay((Uint32)delay);
-            Py_END_ALLOW_THREADS;
-        }
+        nowtime = SDL_GetPerformanceCounter();
+        _clock->rawpassed = _pg_counter_to_ms(nowtime - _clock->last_tick);
+        _clock->rawpassed_ms =
+            _pg_clock_ms(_clock, _clock->last_tick, nowtime);
 
-        if (delay == -1)
-            return NULL;
+        /* Frames are due a period after the previous one was due rather than
+           after it ended, so the rounding of the delays does not add up.
+           When more than a frame late, the schedule starts over. */
+        if (!_clock->deadline || framerate != _clock->framerate)
+            _clock->deadline = _clock->last_tick + period;
+        else
+            _clock->deadline += period;
+        if (_clock->deadline + period < nowtime)
+            _clock->deadline = nowtime;
+        _clock->framerate = framerate;
+
+        late = _pg_delay_until(_clock->deadline, use_accurate_delay);
+        if (late >= 0) {
+            _clock->late_count++;
+            _clock->late_sum += late;
+            if (late > _clock->late_max)
+                _clock->late_max = late;
+        }
+    }
+    else {
+        _clock->deadline = 0;
     }
 
-    nowtime = SDL_GetTicks();
-    _clock->timepassed = nowtime - _clock->last_tick;
+    nowtime = SDL_GetPerformanceCounter();
+    _clock->timepassed = _pg_counter_to_ms(nowtime - _clock->last_tick);
+    _clock->timepassed_ms = _pg_clock_ms(_clock, _clock->last_tick, nowtime);
     _clock->fps_count += 1;
     _clock->last_tick = nowtime;
-    if (!framerate)
+    if (framerate <= 0) {
         _clock->rawpassed = _clock->timepassed;
+        _clock->rawpassed_ms = _clock->timepassed_ms;
+    }
+
+    if (_clock->history) {
+        _clock->history[_clock->history_pos] = _clock->timepassed;
+        _clock->history_pos = (_clock->history_pos + 1) % _clock->history_len;
+        if (_clock->history_count < _clock->history_len)
+            _clock->history_count++;
+    }
 
     if (!_clock->fps_tick) {
         _clock->fps_count = 0;
         _clock->fps_tick = nowtime;
     }
     else if (_clock->fps_count >= 10) {
-        _clock->fps =
-            _clock->fps_count / ((nowtime - _clock->fps_tick) / 1000.0f);
+        _clock->fps = (float)(_clock->fps_count * (double)frequency /
+                              (nowtime - _clock->fps_tick));
         _clock->fps_count = 0;
         _clock->fps_tick = nowtime;
         Py_XDECREF(_clock->rendered);
     }
-    return PyLong_FromLong(_clock->timepassed);
+    return PyLong_FromLong(_clock->timepassed_ms);
 }
 
 static PyObject *
@@ -449,14 +755,104 @@ static PyObject *
 clock_get_time(PyObject *self, PyObject *_null)
 {
     PyClockObject *_clock = (PyClockObject *)self;
-    return PyLong_FromLong(_clock->timepassed);
+    return PyLong_FromLong(_clock->timepassed_ms);
 }
 
 static PyObject *
 clock_get_rawtime(PyObject *self, PyObject *_null)
 {
     PyClockObject *_clock = (PyClockObject *)self;
-    return PyLong_FromLong(_clock->rawpassed);
+    return PyLong_FromLong(_clock->rawpassed_ms);
+}
+
+static PyObject *
+clock_get_jitter(PyObject *self, PyObject *_null)
+{
+    PyClockObject *_clock = (PyClockObject *)self;
+    double mean = 0.0;
+
+    if (_clock->late_count)
+        mean = _clock->late_sum / _clock->late_count;
+    return Py_BuildValue("(dd)", mean, _clock->late_max);
+}
+
+/* Copy the frame times in the history, oldest first, into a new bytes
+ * object. */
+static PyObject *
+_pg_clock_history_bytes(PyClockObject *_clock)
+{
+    Py_ssize_t count = _clock->history_count;
+    Py_ssize_t first = (_clock->history_pos - count + _clock->history_len) %
+                       _clock->history_len;
+    Py_ssize_t head = _clock->history_len - first;
+    PyObject *bytes;
+    double *times;
+
+    bytes = PyBytes_FromStringAndSize(NULL, count * sizeof(double));
+    if (!bytes)
+        return NULL;
+    times = (double *)PyBytes_AS_STRING(bytes);
+    if (head > count)
+        head = count;
+    memcpy(times, _clock->history + first, head * sizeof(double));
+    memcpy(times + head, _clock->history, (count - head) * sizeof(double));
+    return bytes;
+}
+
+static PyObject *
+clock_get_frame_times(PyObject *self, PyObject *_null)
+{
+    PyClockObject *_clock = (PyClockObject *)self;
+    PyObject *bytes, *view, *times;
+
+    if (!_clock->history)
+        return RAISE(PyExc_ValueError, "Clock has no frame history");
+
+    bytes = _pg_clock_history_bytes(_clock);
+    if (!bytes)
+        return NULL;
+    view = PyMemoryView_FromObject(bytes);
+    Py_DECREF(bytes);
+    if (!view)
+        return NULL;
+    times = PyObject_CallMethod(view, "cast", "s", "d");
+    Py_DECREF(view);
+    return times;
+}
+
+static int
+_pg_compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static PyObject *
+clock_get_frame_stats(PyObject *self, PyObject *_null)
+{
+    PyClockObject *_clock = (PyClockObject *)self;
+    PyObject *bytes, *stats;
+    Py_ssize_t count = _clock->history_count;
+    double *times;
+
+    if (!_clock->history)
+        return RAISE(PyExc_ValueError, "Clock has no frame history");
+    if (!count)
+        return Py_BuildValue("(dddd)", 0.0, 0.0, 0.0, 0.0);
+
+    bytes = _pg_clock_history_bytes(_clock);
+    if (!bytes)
+        return NULL;
+    times = (double *)PyBytes_AS_STRING(bytes);
+    qsort(times, count, sizeof(double), _pg_compare_doubles);
+
+/* the nearest rank percentile of the sorted frame times */
+#define PG_PERCENTILE(p) times[(Py_ssize_t)ceil((p) / 100.0 * count) - 1]
+    stats = Py_BuildValue("(dddd)", PG_PERCENTILE(50), PG_PERCENTILE(95),
+                          PG_PERCENTILE(99), times[count - 1]);
+#undef PG_PERCENTILE
+    Py_DECREF(bytes);
+    return stats;
 }
 
 /* clock object internals */
@@ -468,6 +864,11 @@ static struct PyMethodDef clock_methods[] = {
     {"get_rawtime", clock_get_rawtime, METH_NOARGS, DOC_CLOCKGETRAWTIME},
     {"tick_busy_loop", clock_tick_busy_loop, METH_VARARGS,
      DOC_CLOCKTICKBUSYLOOP},
+    {"get_jitter", clock_get_jitter, METH_NOARGS, DOC_CLOCKGETJITTER},
+    {"get_frame_times", clock_get_frame_times, METH_NOARGS,
+     DOC_CLOCKGETFRAMETIMES},
+    {"get_frame_stats", clock_get_frame_stats, METH_NOARGS,
+     DOC_CLOCKGETFRAMESTATS},
     {NULL, NULL, 0, NULL}};
 
 static void
@@ -475,6 +876,7 @@ clock_dealloc(PyObject *self)
 {
     PyClockObject *_clock = (PyClockObject *)self;
     Py_XDECREF(_clock->rendered);
+    PyMem_Free(_clock->history);
     PyObject_Free(self);
 }
 
@@ -496,13 +898,14 @@ clock_str(PyObject *self)
 static PyObject *
 clock_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
 {
-    char *kwids[] = {NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "", kwids)) {
-        /* This function does not actually take in any arguments, but this
-         * argparse function is used to generate pythonic error messages if
-         * any args are passed */
+    Py_ssize_t history = 0;
+    char *kwids[] = {"history", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|n", kwids, &history)) {
         return NULL;
     }
+    if (history < 0) {
+        return RAISE(PyExc_ValueError, "history must not be negative");
+    }
 
     if (!SDL_WasInit(SDL_INIT_TIMER)) {
         if (SDL_InitSubSystem(SDL_INIT_TIMER)) {
@@ -511,13 +914,34 @@ clock_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
     }
 
     PyClockObject *self = (PyClockObject *)(type->tp_alloc(type, 0));
+    if (!self) {
+        return NULL;
+    }
     self->fps_tick = 0;
     self->timepassed = 0;
     self->rawpassed = 0;
-    self->last_tick = SDL_GetTicks();
+    self->timepassed_ms = 0;
+    self->rawpassed_ms = 0;
+    self->last_tick = self->origin = SDL_GetPerformanceCounter();
+    self->deadline = 0;
+    self->framerate = 0;
     self->fps = 0.0f;
     self->fps_count = 0;
+    self->late_count = 0;
+    self->late_sum = 0.0;
+    self->late_max = 0.0;
     self->rendered = NULL;
+    self->history = NULL;
+    self->history_len = history;
+    self->history_pos = 0;
+    self->history_count = 0;
+    if (history) {
+        self->history = PyMem_New(double, history);
+        if (!self->history) {
+            Py_DECREF(self);
+            return PyErr_NoMemory();
+        }
+    }
 
     return (PyObject *)self;
 }
@@ -533,6 +957,392 @@ static PyTypeObject PyClock_Type = {
     .tp_new = clock_new,
 };
 
+/* profiler object interface */
+
+/* spans nested deeper than this are not recorded */
+#define PG_PROFILER_MAX_DEPTH 16
+
+/* A timed span, in performance counter ticks since its frame began */
+typedef struct {
+    int name; /* index into the names of the profiler */
+    int depth;
+    Uint64 start;
+    Uint64 ticks; /* 0 while the span is open */
+} pgProfilerSpan;
+
+typedef struct {
+    Uint64 ticks;
+    Py_ssize_t count;   /* spans recorded */
+    Py_ssize_t dropped; /* spans there was no room for */
+} pgProfilerFrame;
+
+/* The frames are a ring buffer, each with room for max_spans spans, so
+ * nothing is allocated while a frame is timed. */
+typedef struct {
+    PyObject_HEAD Uint64 frame_start; /* 0 outside of a frame */
+    pgProfilerFrame *frames;
+    pgProfilerSpan *spans;
+    Py_ssize_t num_frames, max_spans;
+    Py_ssize_t frame_pos, frame_count;
+    /* the index of each open span, or -1 if it was dropped */
+    Py_ssize_t open[PG_PROFILER_MAX_DEPTH];
+    int depth;
+    PyObject *names; /* list of the span names, by index */
+    PyObject *span_objects; /* dict of the Span for each name */
+} pgProfilerObject;
+
+typedef struct {
+    PyObject_HEAD pgProfilerObject *profiler;
+    int name;
+} pgProfilerSpanObject;
+
+static PyObject *
+profiler_span_enter(PyObject *self, PyObject *_null)
+{
+    pgProfilerSpanObject *span = (pgProfilerSpanObject *)self;
+    pgProfilerObject *prof = span->profiler;
+    pgProfilerFrame *frame;
+    pgProfilerSpan *rec;
+
+    if (prof && prof->frame_start) {
+        frame = prof->frames + prof->frame_pos;
+        if (prof->depth < PG_PROFILER_MAX_DEPTH) {
+            if (frame->count < prof->max_spans) {
+                rec = prof->spans + prof->frame_pos * prof->max_spans +
+                      frame->count;
+                rec->name = span->name;
+                rec->depth = prof->depth;
+                rec->start = SDL_GetPerformanceCounter() - prof->frame_start;
+                rec->ticks = 0;
+                prof->open[prof->depth] = frame->count++;
+            }
+            else {
+                prof->open[prof->depth] = -1;
+                frame->dropped++;
+            }
+        }
+        prof->depth++;
+    }
+    Py_INCREF(self);
+    return self;
+}
+
+/* Close the innermost open span of the frame being timed */
+static void
+_pg_profiler_close(pgProfilerObject *prof, Uint64 now)
+{
+    pgProfilerSpan *rec;
+    Py_ssize_t index;
+
+    prof->depth--;
+    if (prof->depth < PG_PROFILER_MAX_DEPTH) {
+        index = prof->open[prof->depth];
+        if (index >= 0) {
+            rec = prof->spans + prof->frame_pos * prof->max_spans + index;
+            rec->ticks = now - prof->frame_start - rec->start;
+        }
+    }
+}
+
+static PyObject *
+profiler_span_exit(PyObject *self, PyObject *args)
+{
+    pgProfilerObject *prof = ((pgProfilerSpanObject *)self)->profiler;
+
+    if (prof && prof->frame_start && prof->depth > 0) {
+        _pg_profiler_close(prof, SDL_GetPerformanceCounter());
+    }
+    Py_RETURN_FALSE;
+}
+
+static PyObject *
+profiler_span_get_name(PyObject *self, void *closure)
+{
+    pgProfilerSpanObject *span = (pgProfilerSpanObject *)self;
+    PyObject *name;
+
+    if (!span->profiler || !span->profiler->names) {
+        return RAISE(PyExc_RuntimeError, "the profiler of the span is gone");
+    }
+    name = PyList_GET_ITEM(span->profiler->names, span->name);
+    Py_INCREF(name);
+    return name;
+}
+
+static struct PyMethodDef profiler_span_methods[] = {
+    {"__enter__", profiler_span_enter, METH_NOARGS, NULL},
+    {"__exit__", profiler_span_exit, METH_VARARGS, NULL},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef profiler_span_getsets[] = {
+    {"name", profiler_span_get_name, NULL, NULL, NULL},
+    {NULL, NULL, NULL, NULL, NULL}};
+
+static int
+profiler_span_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(((pgProfilerSpanObject *)self)->profiler);
+    return 0;
+}
+
+static int
+profiler_span_clear(PyObject *self)
+{
+    Py_CLEAR(((pgProfilerSpanObject *)self)->profiler);
+    return 0;
+}
+
+static void
+profiler_span_dealloc(PyObject *self)
+{
+    PyObject_GC_UnTrack(self);
+    profiler_span_clear(self);
+    PyObject_GC_Del(self);
+}
+
+static PyTypeObject pgProfilerSpan_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "Span",
+    .tp_basicsize = sizeof(pgProfilerSpanObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_dealloc = profiler_span_dealloc,
+    .tp_traverse = profiler_span_traverse,
+    .tp_clear = profiler_span_clear,
+    .tp_methods = profiler_span_methods,
+    .tp_getset = profiler_span_getsets,
+};
+
+static PyObject *
+profiler_frame_begin(PyObject *self, PyObject *_null)
+{
+    pgProfilerObject *prof = (pgProfilerObject *)self;
+    pgProfilerFrame *frame = prof->frames + prof->frame_pos;
+
+    frame->ticks = 0;
+    frame->count = 0;
+    frame->dropped = 0;
+    prof->depth = 0;
+    prof->frame_start = SDL_GetPerformanceCounter();
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+profiler_frame_end(PyObject *self, PyObject *_null)
+{
+    pgProfilerObject *prof = (pgProfilerObject *)self;
+    pgProfilerFrame *frame = prof->frames + prof->frame_pos;
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    if (!prof->frame_start) {
+        return RAISE(PyExc_RuntimeError,
+                     "frame_end() called without frame_begin()");
+    }
+    while (prof->depth > 0) {
+        _pg_profiler_close(prof, now);
+    }
+    frame->ticks = now - prof->frame_start;
+    prof->frame_start = 0;
+    prof->frame_pos = (prof->frame_pos + 1) % prof->num_frames;
+    if (prof->frame_count < prof->num_frames) {
+        prof->frame_count++;
+    }
+    return PyFloat_FromDouble(_pg_counter_to_ms(frame->ticks));
+}
+
+static PyObject *
+profiler_span(PyObject *self, PyObject *name)
+{
+    pgProfilerObject *prof = (pgProfilerObject *)self;
+    pgProfilerSpanObject *span;
+
+    if (!PyUnicode_Check(name)) {
+        return RAISE(PyExc_TypeError, "span name must be a str");
+    }
+    span = (pgProfilerSpanObject *)PyDict_GetItemWithError(
+        prof->span_objects, name);
+    if (span) {
+        Py_INCREF(span);
+        return (PyObject *)span;
+    }
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
+    span = PyObject_GC_New(pgProfilerSpanObject, &pgProfilerSpan_Type);
+    if (!span) {
+        return NULL;
+    }
+    Py_INCREF(prof);
+    span->profiler = prof;
+    span->name = (int)PyList_GET_SIZE(prof->names);
+    PyObject_GC_Track(span);
+    if (PyList_Append(prof->names, name) ||
+        PyDict_SetItem(prof->span_objects, name, (PyObject *)span)) {
+        Py_DECREF(span);
+        return NULL;
+    }
+    return (PyObject *)span;
+}
+
+static PyObject *
+profiler_get_frames(PyObject *self, PyObject *_null)
+{
+    pgProfilerObject *prof = (pgProfilerObject *)self;
+    pgProfilerFrame *frame;
+    pgProfilerSpan *rec;
+    PyObject *frames, *spans, *item;
+    Py_ssize_t i, j, pos;
+
+    frames = PyList_New(prof->frame_count);
+    if (!frames) {
+        return NULL;
+    }
+    for (i = 0; i < prof->frame_count; i++) {
+        pos = (prof->frame_pos - prof->frame_count + i + prof->num_frames) %
+              prof->num_frames;
+        frame = prof->frames + pos;
+        spans = PyList_New(frame->count);
+        if (!spans) {
+            Py_DECREF(frames);
+            return NULL;
+        }
+        for (j = 0; j < frame->count; j++) {
+            rec = prof->spans + pos * prof->max_spans + j;
+            item = Py_BuildValue("(Oidd)",
+                                 PyList_GET_ITEM(prof->names, rec->name),
+                                 rec->depth, _pg_counter_to_ms(rec->start),
+                                 _pg_counter_to_ms(rec->ticks));
+            if (!item) {
+                Py_DECREF(spans);
+                Py_DECREF(frames);
+                return NULL;
+            }
+            PyList_SET_ITEM(spans, j, item);
+        }
+        item = Py_BuildValue("(dN)", _pg_counter_to_ms(frame->ticks), spans);
+        if (!item) {
+            Py_DECREF(frames);
+            return NULL;
+        }
+        PyList_SET_ITEM(frames, i, item);
+    }
+    return frames;
+}
+
+static PyObject *
+profiler_clear(PyObject *self, PyObject *_null)
+{
+    pgProfilerObject *prof = (pgProfilerObject *)self;
+
+    prof->frame_start = 0;
+    prof->frame_pos = 0;
+    prof->frame_count = 0;
+    prof->depth = 0;
+    Py_RETURN_NONE;
+}
+
+static struct PyMethodDef profiler_methods[] = {
+    {"frame_begin", profiler_frame_begin, METH_NOARGS,
+     DOC_PROFILERFRAMEBEGIN},
+    {"frame_end", profiler_frame_end, METH_NOARGS, DOC_PROFILERFRAMEEND},
+    {"span", profiler_span, METH_O, DOC_PROFILERSPAN},
+    {"get_frames", profiler_get_frames, METH_NOARGS, DOC_PROFILERGETFRAMES},
+    {"clear", profiler_clear, METH_NOARGS, DOC_PROFILERCLEAR},
+    {NULL, NULL, 0, NULL}};
+
+static int
+profiler_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    pgProfilerObject *prof = (pgProfilerObject *)self;
+
+    Py_VISIT(prof->names);
+    Py_VISIT(prof->span_objects);
+    return 0;
+}
+
+static int
+profiler_clear_refs(PyObject *self)
+{
+    pgProfilerObject *prof = (pgProfilerObject *)self;
+
+    Py_CLEAR(prof->span_objects);
+    Py_CLEAR(prof->names);
+    return 0;
+}
+
+static void
+profiler_dealloc(PyObject *self)
+{
+    pgProfilerObject *prof = (pgProfilerObject *)self;
+
+    PyObject_GC_UnTrack(self);
+    profiler_clear_refs(self);
+    PyMem_Free(prof->frames);
+    PyMem_Free(prof->spans);
+    PyObject_GC_Del(self);
+}
+
+static PyObject *
+profiler_repr(PyObject *self)
+{
+    pgProfilerObject *prof = (pgProfilerObject *)self;
+
+    return PyUnicode_FromFormat("<Profiler(%zd frames, %zd spans)>",
+                                prof->frame_count,
+                                PyList_GET_SIZE(prof->names));
+}
+
+static PyObject *
+profiler_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    Py_ssize_t frames = 120, spans = 64;
+    char *kwids[] = {"frames", "spans", NULL};
+    pgProfilerObject *self;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|nn", kwids, &frames,
+                                     &spans)) {
+        return NULL;
+    }
+    if (frames < 1 || spans < 1) {
+        return RAISE(PyExc_ValueError, "frames and spans must be positive");
+    }
+    if (spans > PY_SSIZE_T_MAX / frames / (Py_ssize_t)sizeof(pgProfilerSpan)) {
+        return PyErr_NoMemory();
+    }
+
+    self = (pgProfilerObject *)(type->tp_alloc(type, 0));
+    if (!self) {
+        return NULL;
+    }
+    self->num_frames = frames;
+    self->max_spans = spans;
+    self->frames = PyMem_New(pgProfilerFrame, frames);
+    self->spans = PyMem_New(pgProfilerSpan, frames * spans);
+    self->names = PyList_New(0);
+    self->span_objects = PyDict_New();
+    if (!self->frames || !self->spans) {
+        Py_DECREF(self);
+        return PyErr_NoMemory();
+    }
+    if (!self->names || !self->span_objects) {
+        Py_DECREF(self);
+        return NULL;
+    }
+    return (PyObject *)self;
+}
+
+static PyTypeObject pgProfiler_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "Profiler",
+    .tp_basicsize = sizeof(pgProfilerObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_dealloc = profiler_dealloc,
+    .tp_repr = profiler_repr,
+    .tp_doc = DOC_PYGAMETIMEPROFILER,
+    .tp_traverse = profiler_traverse,
+    .tp_clear = profiler_clear_refs,
+    .tp_methods = profiler_methods,
+    .tp_new = profiler_new,
+};
+
 static PyMethodDef _time_methods[] = {
     {"_internal_mod_init", (PyCFunction)pg_time_autoinit, METH_NOARGS,
      "auto initialize function for time"},
@@ -588,6 +1398,12 @@ MODINIT_DEFINE(time)
     if (PyType_Ready(&PyClock_Type) < 0) {
         return NULL;
     }
+    if (PyType_Ready(&pgProfiler_Type) < 0) {
+        return NULL;
+    }
+    if (PyType_Ready(&pgProfilerSpan_Type) < 0) {
+        return NULL;
+    }
 
     /* create the module */
     module = PyModule_Create(&_module);
@@ -602,5 +1418,13 @@ MODINIT_DEFINE(time)
         return NULL;
     }
 
+    Py_INCREF(&pgProfiler_Type);
+    if (PyModule_AddObject(module, "Profiler",
+                           (PyObject *)&pgProfiler_Type)) {
+        Py_DECREF(&pgProfiler_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
     return module;
 }
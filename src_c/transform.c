@@ -30,19 +30,53 @@
 
 #include "doc/transform_doc.h"
 
+#include "mask.h"
+
 #include <math.h>
 #include <string.h>
 
 #include "scale.h"
 
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+// arm64 has neon optimisations enabled by default, even when fpu=neon is not
+// passed
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+#if defined(PG_ENABLE_ARM_NEON)
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "include/sse2neon.h"
+#define TRANSFORM_SIMD
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define TRANSFORM_SIMD
+#endif
+
 typedef void (*SMOOTHSCALE_FILTER_P)(Uint8 *, Uint8 *, int, int, int, int,
                                      int);
+
+/* Fixed point weights for resampling one axis from srcsize to dstsize */
+typedef struct {
+    int filter;
+    int srcsize;
+    int dstsize;
+    int ksize;    /* weights stored for each destination pixel */
+    int *bounds;  /* first source pixel and tap count per destination pixel */
+    int *weights; /* ksize weights per destination pixel */
+    int users;    /* resample calls currently using the table */
+    int cached;   /* still held by the module's table cache */
+} ResampleTable;
+
+/* Number of weight tables kept between resample calls */
+#define RESAMPLE_CACHE_SIZE 8
+
 struct _module_state {
     const char *filter_type;
     SMOOTHSCALE_FILTER_P filter_shrink_X;
     SMOOTHSCALE_FILTER_P filter_shrink_Y;
     SMOOTHSCALE_FILTER_P filter_expand_X;
     SMOOTHSCALE_FILTER_P filter_expand_Y;
+    ResampleTable *resample_cache[RESAMPLE_CACHE_SIZE]; /* most recent first */
 };
 
 #define GETSTATE(m) ((struct _module_state *)PyModule_GetState(m))
@@ -54,9 +88,19 @@ struct _module_state {
 void
 scale2x(SDL_Surface *src, SDL_Surface *dst);
 void
-scale2xraw(SDL_Surface *src, SDL_Surface *dst);
-extern SDL_Surface *
-rotozoomSurface(SDL_Surface *src, double angle, double zoom, int smooth);
+scale3x(SDL_Surface *src, SDL_Surface *dst);
+void
+scale_by_int_rows(SDL_Surface *src, SDL_Surface *dst, int factor, int ystart,
+                  int yend);
+extern void
+rotozoomSurfaceDestSize(int width, int height, double angle, double zoom,
+                        int *dstwidth, int *dstheight);
+extern void
+rotozoomSurfaceRows(SDL_Surface *src, SDL_Surface *dst, double angle,
+                    double zoom, int smooth, int ystart, int yend);
+extern void
+affineSurfaceRows(SDL_Surface *src, SDL_Surface *dst, const double *m,
+                  int smooth, int ystart, int yend);
 
 static int
 _get_factor(PyObject *factorobj, float *x, float *y)
@@ -117,8 +161,10 @@ _PgSurface_SrcAlpha(SDL_Surface *surf)
 }
 #endif
 
+/* A new width x height surface with the format and blit settings of surf.
+ * Its pixels come from pool, a SurfacePool, unless that is NULL. */
 static SDL_Surface *
-newsurf_fromsurf(SDL_Surface *surf, int width, int height)
+newsurf_fromsurf(SDL_Surface *surf, int width, int height, PyObject *pool)
 {
     SDL_Surface *newsurf;
     Uint32 colorkey;
@@ -129,12 +175,12 @@ newsurf_fromsurf(SDL_Surface *surf, int width, int height)
         return (SDL_Surface *)(RAISE(
             PyExc_ValueError, "unsupported Surface bit depth for transform"));
 
-    newsurf = SDL_CreateRGBSurface(surf->flags, width, height,
-                                   surf->format->BitsPerPixel,
-                                   surf->format->Rmask, surf->format->Gmask,
-                                   surf->format->Bmask, surf->format->Amask);
+    newsurf = pgSurfacePool_CreateSurface(
+        pool, width, height, surf->format->BitsPerPixel, surf->format->Rmask,
+        surf->format->Gmask, surf->format->Bmask, surf->format->Amask);
     if (!newsurf)
-        return (SDL_Surface *)(RAISE(pgExc_SDLError, SDL_GetError()));
+        return NULL;
+    newsurf->flags |= surf->flags & PG_SURF_PREMULTIPLIED;
 
     /* Copy palette, colorkey, etc info */
     if (SDL_ISPIXELFORMAT_INDEXED(surf->format->format)) {
@@ -142,20 +188,20 @@ newsurf_fromsurf(SDL_Surface *surf, int width, int height)
                                  surf->format->palette->colors, 0,
                                  surf->format->palette->ncolors) != 0) {
             PyErr_SetString(pgExc_SDLError, SDL_GetError());
-            SDL_FreeSurface(newsurf);
+            pgSurfacePool_FreeSurface(newsurf);
             return NULL;
         }
     }
 
     if (SDL_GetSurfaceAlphaMod(surf, &alpha) != 0) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
-        SDL_FreeSurface(newsurf);
+        pgSurfacePool_FreeSurface(newsurf);
         return NULL;
     }
     if (alpha != 255) {
         if (SDL_SetSurfaceAlphaMod(newsurf, alpha) != 0) {
             PyErr_SetString(pgExc_SDLError, SDL_GetError());
-            SDL_FreeSurface(newsurf);
+            pgSurfacePool_FreeSurface(newsurf);
             return NULL;
         }
     }
@@ -164,19 +210,19 @@ newsurf_fromsurf(SDL_Surface *surf, int width, int height)
     if (isalpha == 1) {
         if (SDL_SetSurfaceBlendMode(newsurf, SDL_BLENDMODE_BLEND) != 0) {
             PyErr_SetString(pgExc_SDLError, SDL_GetError());
-            SDL_FreeSurface(newsurf);
+            pgSurfacePool_FreeSurface(newsurf);
             return NULL;
         }
     }
     else if (isalpha == -1) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
-        SDL_FreeSurface(newsurf);
+        pgSurfacePool_FreeSurface(newsurf);
         return NULL;
     }
     else {
         if (SDL_SetSurfaceBlendMode(newsurf, SDL_BLENDMODE_NONE) != 0) {
             PyErr_SetString(pgExc_SDLError, SDL_GetError());
-            SDL_FreeSurface(newsurf);
+            pgSurfacePool_FreeSurface(newsurf);
             return NULL;
         }
     }
@@ -185,7 +231,7 @@ newsurf_fromsurf(SDL_Surface *surf, int width, int height)
         if (SDL_SetColorKey(newsurf, SDL_TRUE, colorkey) != 0 ||
             SDL_SetSurfaceRLE(newsurf, SDL_TRUE) != 0) {
             PyErr_SetString(pgExc_SDLError, SDL_GetError());
-            SDL_FreeSurface(newsurf);
+            pgSurfacePool_FreeSurface(newsurf);
             return NULL;
         }
     }
@@ -193,15 +239,190 @@ newsurf_fromsurf(SDL_Surface *surf, int width, int height)
     return newsurf;
 }
 
+/* Whether the pixels of two surfaces share any memory */
+static int
+_surfaces_overlap(SDL_Surface *a, SDL_Surface *b)
+{
+    Uint8 *astart = (Uint8 *)a->pixels, *bstart = (Uint8 *)b->pixels;
+    Uint8 *aend, *bend;
+
+    if (!a->w || !a->h || !b->w || !b->h)
+        return 0;
+    aend = astart + (a->h - 1) * a->pitch + a->w * a->format->BytesPerPixel;
+    bend = bstart + (b->h - 1) * b->pitch + b->w * b->format->BytesPerPixel;
+    return astart < bend && bstart < aend;
+}
+
+/* Check that dst can receive a width x height transform of src, giving it
+ * pixels of its own if it is a copy-on-write copy. Raises ValueError and
+ * returns -1 if it is the wrong size or format, or if it shares pixels
+ * with src.
+ */
+static int
+_check_dest_surface(SDL_Surface *src, SDL_Surface *dst, int width,
+                    int height)
+{
+    if (dst->w != width || dst->h != height) {
+        PyErr_SetString(PyExc_ValueError,
+                        "Destination surface not the given width or height.");
+        return -1;
+    }
+    if (src->format->BytesPerPixel != dst->format->BytesPerPixel) {
+        PyErr_SetString(
+            PyExc_ValueError,
+            "Source and destination surfaces need the same format.");
+        return -1;
+    }
+    /* a copy still sharing the pixels of src gets its own first */
+    if (!pgSurface_Unshare(dst))
+        return -1;
+    if (_surfaces_overlap(src, dst)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "Source and destination surfaces must not overlap.");
+        return -1;
+    }
+    return 0;
+}
+
+static int
+_use_simd(void);
+static void
+flip(SDL_Surface *surf, SDL_Surface *newsurf, int xaxis, int yaxis);
+
+/* A quarter turn reads the source down its columns while writing the
+ * destination along its rows, touching a new source cache line for every
+ * pixel of a large surface. Copying in square tiles keeps the cache lines
+ * a tile reads in cache until all of their pixels are used; 16 pixels of
+ * 32 bits are one 64 byte line.
+ */
+#define ROTATE90_TILE 16
+
+/* Copy destination pixels [x0, x1) x [y0, y1) of a quarter turn one at a
+ * time. Destination pixel (x, y) is at origin + x * stepx + y * stepy in
+ * the source. */
+static void
+rotate90_rect(const Uint8 *origin, int stepx, int stepy, SDL_Surface *dst,
+              int x0, int x1, int y0, int y1)
+{
+    int bpp = dst->format->BytesPerPixel;
+    int x, y;
+
+    for (y = y0; y < y1; y++) {
+        const Uint8 *srcpix = origin + x0 * stepx + y * stepy;
+        Uint8 *dstpix = (Uint8 *)dst->pixels + (size_t)y * dst->pitch +
+                        (size_t)x0 * bpp;
+
+        switch (bpp) {
+            case 1:
+                for (x = x0; x < x1; x++, srcpix += stepx) {
+                    *dstpix++ = *srcpix;
+                }
+                break;
+            case 2:
+                for (x = x0; x < x1; x++, srcpix += stepx, dstpix += 2) {
+                    *(Uint16 *)dstpix = *(const Uint16 *)srcpix;
+                }
+                break;
+            case 3:
+                for (x = x0; x < x1; x++, srcpix += stepx, dstpix += 3) {
+                    dstpix[0] = srcpix[0];
+                    dstpix[1] = srcpix[1];
+                    dstpix[2] = srcpix[2];
+                }
+                break;
+            default: /* case 4: */
+                for (x = x0; x < x1; x++, srcpix += stepx, dstpix += 4) {
+                    *(Uint32 *)dstpix = *(const Uint32 *)srcpix;
+                }
+                break;
+        }
+    }
+}
+
+#ifdef TRANSFORM_SIMD
+/* Copy a 4x4 block of 32 bit pixels of a quarter turn: four source rows
+ * are loaded, transposed in registers and stored as four destination
+ * rows. stepy is one pixel either way along a source row. */
+static PG_INLINE void
+rotate90_block32(const Uint8 *src, int stepx, int stepy, Uint8 *dst,
+                 int dstpitch)
+{
+    const Uint8 *first = stepy < 0 ? src + 3 * stepy : src;
+    __m128i r0 = _mm_loadu_si128((const __m128i *)first);
+    __m128i r1 = _mm_loadu_si128((const __m128i *)(first + stepx));
+    __m128i r2 = _mm_loadu_si128((const __m128i *)(first + 2 * stepx));
+    __m128i r3 = _mm_loadu_si128((const __m128i *)(first + 3 * stepx));
+    __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+    __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+    __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+    __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+    __m128i c[4];
+    int i;
+
+    /* c[i] holds pixel i of each of the four source rows */
+    c[0] = _mm_unpacklo_epi64(t0, t1);
+    c[1] = _mm_unpackhi_epi64(t0, t1);
+    c[2] = _mm_unpacklo_epi64(t2, t3);
+    c[3] = _mm_unpackhi_epi64(t2, t3);
+    for (i = 0; i < 4; i++) {
+        _mm_storeu_si128((__m128i *)(dst + i * dstpitch),
+                         c[stepy < 0 ? 3 - i : i]);
+    }
+}
+#endif /* TRANSFORM_SIMD */
+
+/* Turn src a quarter turn counterclockwise into dst when numturns is 1,
+ * or clockwise when it is 3, a tile at a time. */
+static void
+rotate90_quarter(SDL_Surface *src, SDL_Surface *dst, int numturns)
+{
+    int bpp = src->format->BytesPerPixel;
+    const Uint8 *origin = (const Uint8 *)src->pixels;
+    int stepx, stepy, tx, ty, x, y, xend, yend;
+    int simd = 0;
+
+    if (numturns == 1) {
+        origin += (src->w - 1) * bpp;
+        stepx = src->pitch;
+        stepy = -bpp;
+    }
+    else {
+        origin += (src->h - 1) * src->pitch;
+        stepx = -src->pitch;
+        stepy = bpp;
+    }
+#ifdef TRANSFORM_SIMD
+    simd = bpp == 4 && _use_simd();
+#endif /* TRANSFORM_SIMD */
+
+    for (ty = 0; ty < dst->h; ty += ROTATE90_TILE) {
+        yend = MIN(ty + ROTATE90_TILE, dst->h);
+        for (tx = 0; tx < dst->w; tx += ROTATE90_TILE) {
+            xend = MIN(tx + ROTATE90_TILE, dst->w);
+            y = ty;
+#ifdef TRANSFORM_SIMD
+            for (; simd && y + 4 <= yend; y += 4) {
+                Uint8 *dstrow = (Uint8 *)dst->pixels + (size_t)y * dst->pitch;
+
+                for (x = tx; x + 4 <= xend; x += 4) {
+                    rotate90_block32(origin + x * stepx + y * stepy, stepx,
+                                     stepy, dstrow + x * 4, dst->pitch);
+                }
+                rotate90_rect(origin, stepx, stepy, dst, x, xend, y, y + 4);
+            }
+#endif /* TRANSFORM_SIMD */
+            rotate90_rect(origin, stepx, stepy, dst, tx, xend, y, yend);
+        }
+    }
+}
+
+/* Rotate src by a multiple of 90 degrees into dst, or into a new surface
+ * from pool when dst is NULL. */
 static SDL_Surface *
-rotate90(SDL_Surface *src, int angle)
+rotate90(SDL_Surface *src, SDL_Surface *dst, int angle, PyObject *pool)
 {
     int numturns = (angle / 90) % 4;
     int dstwidth, dstheight;
-    SDL_Surface *dst;
-    char *srcpix, *dstpix, *srcrow, *dstrow;
-    int srcstepx, srcstepy, dststepx, dststepy;
-    int loopx, loopy;
 
     if (numturns < 0)
         numturns = 4 + numturns;
@@ -214,108 +435,114 @@ rotate90(SDL_Surface *src, int angle)
         dstheight = src->w;
     }
 
-    dst = newsurf_fromsurf(src, dstwidth, dstheight);
+    if (!dst)
+        dst = newsurf_fromsurf(src, dstwidth, dstheight, pool);
+    else if (_check_dest_surface(src, dst, dstwidth, dstheight))
+        return NULL;
     if (!dst)
         return NULL;
 
     Py_BEGIN_ALLOW_THREADS;
     SDL_LockSurface(dst);
-    srcrow = (char *)src->pixels;
-    dstrow = (char *)dst->pixels;
-    srcstepx = dststepx = src->format->BytesPerPixel;
-    srcstepy = src->pitch;
-    dststepy = dst->pitch;
-
-    switch (numturns) {
-            /*case 0: we don't need to change anything*/
-        case 1:
-            srcrow += ((src->w - 1) * srcstepx);
-            srcstepy = -srcstepx;
-            srcstepx = src->pitch;
-            break;
-        case 2:
-            srcrow += ((src->h - 1) * srcstepy) + ((src->w - 1) * srcstepx);
-            srcstepx = -srcstepx;
-            srcstepy = -srcstepy;
-            break;
-        case 3:
-            srcrow += ((src->h - 1) * srcstepy);
-            srcstepx = -srcstepy;
-            srcstepy = src->format->BytesPerPixel;
-            break;
-    }
+    if (numturns % 2)
+        rotate90_quarter(src, dst, numturns);
+    else /* a half turn is a flip both ways */
+        flip(src, dst, numturns == 2, numturns == 2);
+    SDL_UnlockSurface(dst);
+    Py_END_ALLOW_THREADS;
+    return dst;
+}
+
+/* Rotations read the source along a diagonal, so walking whole
+ * destination rows touches a new source cache line for nearly every pixel
+ * of a large surface. Rotating in square destination tiles keeps the
+ * source area read for each tile small enough to stay in cache.
+ */
+#define ROTATE_TILE 32
+
+/* Rotate count pixels of one destination row, starting from source
+ * position (dx, dy) in 16.16 fixed point. */
+static void
+rotate_span(SDL_Surface *src, Uint8 *dstpos, int count, Uint32 bgcolor,
+            int dx, int dy, int icos, int isin)
+{
+    Uint8 *srcpix = (Uint8 *)src->pixels;
+    int srcpitch = src->pitch;
+    int xmaxval = ((src->w) << 16) - 1;
+    int ymaxval = ((src->h) << 16) - 1;
+    int x;
 
     switch (src->format->BytesPerPixel) {
         case 1:
-            for (loopy = 0; loopy < dstheight; ++loopy) {
-                dstpix = dstrow;
-                srcpix = srcrow;
-                for (loopx = 0; loopx < dstwidth; ++loopx) {
-                    *dstpix = *srcpix;
-                    srcpix += srcstepx;
-                    dstpix += dststepx;
-                }
-                dstrow += dststepy;
-                srcrow += srcstepy;
+            for (x = 0; x < count; x++) {
+                if (dx < 0 || dy < 0 || dx > xmaxval || dy > ymaxval)
+                    *dstpos++ = bgcolor;
+                else
+                    *dstpos++ = *(Uint8 *)(srcpix + ((dy >> 16) * srcpitch) +
+                                           (dx >> 16));
+                dx += icos;
+                dy += isin;
             }
             break;
-        case 2:
-            for (loopy = 0; loopy < dstheight; ++loopy) {
-                dstpix = dstrow;
-                srcpix = srcrow;
-                for (loopx = 0; loopx < dstwidth; ++loopx) {
-                    *(Uint16 *)dstpix = *(Uint16 *)srcpix;
-                    srcpix += srcstepx;
-                    dstpix += dststepx;
-                }
-                dstrow += dststepy;
-                srcrow += srcstepy;
+        case 2: {
+            Uint16 *dstpos16 = (Uint16 *)dstpos;
+
+            for (x = 0; x < count; x++) {
+                if (dx < 0 || dy < 0 || dx > xmaxval || dy > ymaxval)
+                    *dstpos16++ = bgcolor;
+                else
+                    *dstpos16++ =
+                        *(Uint16 *)(srcpix + ((dy >> 16) * srcpitch) +
+                                    ((long long)dx >> 16 << 1));
+                dx += icos;
+                dy += isin;
             }
             break;
-        case 3:
-            for (loopy = 0; loopy < dstheight; ++loopy) {
-                dstpix = dstrow;
-                srcpix = srcrow;
-                for (loopx = 0; loopx < dstwidth; ++loopx) {
-                    dstpix[0] = srcpix[0];
-                    dstpix[1] = srcpix[1];
-                    dstpix[2] = srcpix[2];
-                    srcpix += srcstepx;
-                    dstpix += dststepx;
-                }
-                dstrow += dststepy;
-                srcrow += srcstepy;
+        }
+        case 4: {
+            Uint32 *dstpos32 = (Uint32 *)dstpos;
+
+            for (x = 0; x < count; x++) {
+                if (dx < 0 || dy < 0 || dx > xmaxval || dy > ymaxval)
+                    *dstpos32++ = bgcolor;
+                else
+                    *dstpos32++ =
+                        *(Uint32 *)(srcpix + ((dy >> 16) * srcpitch) +
+                                    ((long long)dx >> 16 << 2));
+                dx += icos;
+                dy += isin;
             }
             break;
-        case 4:
-            for (loopy = 0; loopy < dstheight; ++loopy) {
-                dstpix = dstrow;
-                srcpix = srcrow;
-                for (loopx = 0; loopx < dstwidth; ++loopx) {
-                    *(Uint32 *)dstpix = *(Uint32 *)srcpix;
-                    srcpix += srcstepx;
-                    dstpix += dststepx;
+        }
+        default: /*case 3:*/
+            for (x = 0; x < count; x++) {
+                if (dx < 0 || dy < 0 || dx > xmaxval || dy > ymaxval) {
+                    memcpy(dstpos, &bgcolor, 3 * sizeof(Uint8));
+                    dstpos += 3;
                 }
-                dstrow += dststepy;
-                srcrow += srcstepy;
+                else {
+                    Uint8 *srcpos =
+                        (Uint8 *)(srcpix + ((dy >> 16) * srcpitch) +
+                                  ((dx >> 16) * 3));
+                    memcpy(dstpos, srcpos, 3 * sizeof(Uint8));
+                    dstpos += 3;
+                }
+                dx += icos;
+                dy += isin;
             }
             break;
     }
-    SDL_UnlockSurface(dst);
-    Py_END_ALLOW_THREADS;
-    return dst;
 }
 
 static void
 rotate(SDL_Surface *src, SDL_Surface *dst, Uint32 bgcolor, double sangle,
        double cangle)
 {
-    int x, y, dx, dy;
+    int y, tx, ty, xend, yend;
 
-    Uint8 *srcpix = (Uint8 *)src->pixels;
-    Uint8 *dstrow = (Uint8 *)dst->pixels;
-    int srcpitch = src->pitch;
+    Uint8 *dstpix = (Uint8 *)dst->pixels;
     int dstpitch = dst->pitch;
+    int bpp = dst->format->BytesPerPixel;
 
     int cy = dst->h / 2;
     int xd = ((src->w - dst->w) << 15);
@@ -329,87 +556,18 @@ rotate(SDL_Surface *src, SDL_Surface *dst, Uint32 bgcolor, double sangle,
     int ay =
         ((dst->h) << 15) - (int)(sangle * (((long long)dst->w - 1) << 15));
 
-    int xmaxval = ((src->w) << 16) - 1;
-    int ymaxval = ((src->h) << 16) - 1;
-
-    switch (src->format->BytesPerPixel) {
-        case 1:
-            for (y = 0; y < dst->h; y++) {
-                Uint8 *dstpos = (Uint8 *)dstrow;
-                dx = (ax + (isin * (cy - y))) + xd;
-                dy = (ay - (icos * (cy - y))) + yd;
-                for (x = 0; x < dst->w; x++) {
-                    if (dx < 0 || dy < 0 || dx > xmaxval || dy > ymaxval)
-                        *dstpos++ = bgcolor;
-                    else
-                        *dstpos++ =
-                            *(Uint8 *)(srcpix + ((dy >> 16) * srcpitch) +
-                                       (dx >> 16));
-                    dx += icos;
-                    dy += isin;
-                }
-                dstrow += dstpitch;
-            }
-            break;
-        case 2:
-            for (y = 0; y < dst->h; y++) {
-                Uint16 *dstpos = (Uint16 *)dstrow;
-                dx = (ax + (isin * (cy - y))) + xd;
-                dy = (ay - (icos * (cy - y))) + yd;
-                for (x = 0; x < dst->w; x++) {
-                    if (dx < 0 || dy < 0 || dx > xmaxval || dy > ymaxval)
-                        *dstpos++ = bgcolor;
-                    else
-                        *dstpos++ =
-                            *(Uint16 *)(srcpix + ((dy >> 16) * srcpitch) +
-                                        ((long long)dx >> 16 << 1));
-                    dx += icos;
-                    dy += isin;
-                }
-                dstrow += dstpitch;
-            }
-            break;
-        case 4:
-            for (y = 0; y < dst->h; y++) {
-                Uint32 *dstpos = (Uint32 *)dstrow;
-                dx = (ax + (isin * (cy - y))) + xd;
-                dy = (ay - (icos * (cy - y))) + yd;
-                for (x = 0; x < dst->w; x++) {
-                    if (dx < 0 || dy < 0 || dx > xmaxval || dy > ymaxval)
-                        *dstpos++ = bgcolor;
-                    else
-                        *dstpos++ =
-                            *(Uint32 *)(srcpix + ((dy >> 16) * srcpitch) +
-                                        ((long long)dx >> 16 << 2));
-                    dx += icos;
-                    dy += isin;
-                }
-                dstrow += dstpitch;
-            }
-            break;
-        default: /*case 3:*/
-            for (y = 0; y < dst->h; y++) {
-                Uint8 *dstpos = (Uint8 *)dstrow;
-                dx = (ax + (isin * (cy - y))) + xd;
-                dy = (ay - (icos * (cy - y))) + yd;
-                for (x = 0; x < dst->w; x++) {
-                    if (dx < 0 || dy < 0 || dx > xmaxval || dy > ymaxval) {
-                        memcpy(dstpos, &bgcolor, 3 * sizeof(Uint8));
-                        dstpos += 3;
-                    }
-                    else {
-                        Uint8 *srcpos =
-                            (Uint8 *)(srcpix + ((dy >> 16) * srcpitch) +
-                                      ((dx >> 16) * 3));
-                        memcpy(dstpos, srcpos, 3 * sizeof(Uint8));
-                        dstpos += 3;
-                    }
-                    dx += icos;
-                    dy += isin;
-                }
-                dstrow += dstpitch;
+    for (ty = 0; ty < dst->h; ty += ROTATE_TILE) {
+        yend = MIN(ty + ROTATE_TILE, dst->h);
+        for (tx = 0; tx < dst->w; tx += ROTATE_TILE) {
+            xend = MIN(tx + ROTATE_TILE, dst->w);
+            for (y = ty; y < yend; y++) {
+                rotate_span(src, dstpix + y * dstpitch + tx * bpp, xend - tx,
+                            bgcolor,
+                            (ax + (isin * (cy - y))) + xd + icos * tx,
+                            (ay - (icos * (cy - y))) + yd + isin * tx, icos,
+                            isin);
             }
-            break;
+        }
     }
 }
 
@@ -521,19 +679,62 @@ stretch(SDL_Surface *src, SDL_Surface *dst)
     }
 }
 
+typedef struct {
+    SDL_Surface *src;
+    SDL_Surface *dst;
+    int factor;
+} ScaleByIntPass;
+
+static void
+scale_by_int_band(void *data, int band, int nbands)
+{
+    ScaleByIntPass *pass = (ScaleByIntPass *)data;
+    int height = pass->src->h;
+
+    scale_by_int_rows(pass->src, pass->dst, pass->factor,
+                      (int)((long long)height * band / nbands),
+                      (int)((long long)height * (band + 1) / nbands));
+}
+
+/* Scale the locked src by a whole factor into dst, in bands of source rows
+ * on the worker pool when dst is large enough.
+ */
+static void
+scale_by_int_run(SDL_Surface *src, SDL_Surface *dst, int factor)
+{
+    ScaleByIntPass pass;
+    int nthreads = pg_GetNumThreads();
+
+    if (nthreads > src->h) {
+        nthreads = src->h;
+    }
+    if (nthreads < 2 || (long long)dst->w * dst->h < PG_PARALLEL_MIN_PIXELS) {
+        scale_by_int_rows(src, dst, factor, 0, src->h);
+        return;
+    }
+
+    pass.src = src;
+    pass.dst = dst;
+    pass.factor = factor;
+    pg_ParallelFor(scale_by_int_band, &pass, nthreads);
+}
+
 static PyObject *
 surf_scale(PyObject *self, PyObject *args, PyObject *kwargs)
 {
     pgSurfaceObject *surfobj;
-    PyObject *surfobj2 = NULL;
+    PyObject *surfobj2 = NULL, *pool = NULL;
     PyObject *size;
     SDL_Surface *surf, *newsurf;
     int width, height;
-    static char *keywords[] = {"surface", "size", "dest_surface", NULL};
+    Uint64 start;
+    static char *keywords[] = {"surface", "size", "dest_surface", "pool",
+                               NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|O!", keywords,
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|O!O!", keywords,
                                      &pgSurface_Type, &surfobj, &size,
-                                     &pgSurface_Type, &surfobj2))
+                                     &pgSurface_Type, &surfobj2,
+                                     &pgSurfacePool_Type, &pool))
         return NULL;
 
     if (!pg_TwoIntsFromObj(size, &width, &height))
@@ -545,7 +746,7 @@ surf_scale(PyObject *self, PyObject *args, PyObject *kwargs)
     surf = pgSurface_AsSurface(surfobj);
 
     if (!surfobj2) {
-        newsurf = newsurf_fromsurf(surf, width, height);
+        newsurf = newsurf_fromsurf(surf, width, height, pool);
         if (!newsurf)
             return NULL;
     }
@@ -560,19 +761,26 @@ surf_scale(PyObject *self, PyObject *args, PyObject *kwargs)
     if (surf->format->BytesPerPixel != newsurf->format->BytesPerPixel)
         return RAISE(PyExc_ValueError,
                      "Source and destination surfaces need the same format.");
+    if (!pgSurface_Unshare(newsurf))
+        return NULL;
 
     if ((width && height) && (surf->w && surf->h)) {
         SDL_LockSurface(newsurf);
         pgSurface_Lock(surfobj);
 
+        start = pg_StatsBegin();
         Py_BEGIN_ALLOW_THREADS;
-        if (width == 2 * surf->w && height == 2 * surf->h) {
-            scale2xraw(surf, newsurf);
+        /* whole factors give the same pixels as stretch() */
+        if (width % surf->w == 0 && height % surf->h == 0 &&
+            width / surf->w == height / surf->h) {
+            scale_by_int_run(surf, newsurf, width / surf->w);
         }
         else {
             stretch(surf, newsurf);
         }
         Py_END_ALLOW_THREADS;
+        pg_StatsEnd(PG_STAT_TRANSFORM, "scale", start,
+                    (Sint64)width * height);
 
         pgSurface_Unlock(surfobj);
         SDL_UnlockSurface(newsurf);
@@ -630,6 +838,7 @@ surf_scale2x(PyObject *self, PyObject *args, PyObject *kwargs)
     PyObject *surfobj, *surfobj2 = NULL;
     SDL_Surface *surf;
     SDL_Surface *newsurf;
+    Uint64 start;
     static char *keywords[] = {"surface", "dest_surface", NULL};
 
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|O!", keywords,
@@ -638,6 +847,8 @@ surf_scale2x(PyObject *self, PyObject *args, PyObject *kwargs)
         return NULL;
 
     surf = pgSurface_AsSurface(surfobj);
+    if (!pgSurface_Unpack(surf))
+        return NULL;
 
     /* if the second surface is not there, then make a new one. */
 
@@ -645,7 +856,7 @@ surf_scale2x(PyObject *self, PyObject *args, PyObject *kwargs)
         int width = surf->w * 2;
         int height = surf->h * 2;
 
-        newsurf = newsurf_fromsurf(surf, width, height);
+        newsurf = newsurf_fromsurf(surf, width, height, NULL);
 
         if (!newsurf)
             return NULL;
@@ -661,13 +872,18 @@ surf_scale2x(PyObject *self, PyObject *args, PyObject *kwargs)
     if (surf->format->BytesPerPixel != newsurf->format->BytesPerPixel)
         return RAISE(PyExc_ValueError,
                      "Source and destination surfaces need the same format.");
+    if (!pgSurface_Unshare(newsurf))
+        return NULL;
 
     SDL_LockSurface(newsurf);
     SDL_LockSurface(surf);
 
+    start = pg_StatsBegin();
     Py_BEGIN_ALLOW_THREADS;
     scale2x(surf, newsurf);
     Py_END_ALLOW_THREADS;
+    pg_StatsEnd(PG_STAT_TRANSFORM, "scale2x", start,
+                (Sint64)newsurf->w * newsurf->h);
 
     SDL_UnlockSurface(surf);
     SDL_UnlockSurface(newsurf);
@@ -681,70 +897,221 @@ surf_scale2x(PyObject *self, PyObject *args, PyObject *kwargs)
 }
 
 static PyObject *
-surf_rotate(PyObject *self, PyObject *args, PyObject *kwargs)
+surf_scale3x(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    pgSurfaceObject *surfobj;
-    SDL_Surface *surf, *newsurf;
-    float angle;
-
-    double radangle, sangle, cangle;
-    double x, y, cx, cy, sx, sy;
-    int nxmax, nymax;
-    Uint32 bgcolor;
-    static char *keywords[] = {"surface", "angle", NULL};
+    PyObject *surfobj, *surfobj2 = NULL;
+    SDL_Surface *surf;
+    SDL_Surface *newsurf;
+    Uint64 start;
+    static char *keywords[] = {"surface", "dest_surface", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!f", keywords,
-                                     &pgSurface_Type, &surfobj, &angle))
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|O!", keywords,
+                                     &pgSurface_Type, &surfobj,
+                                     &pgSurface_Type, &surfobj2))
         return NULL;
+
     surf = pgSurface_AsSurface(surfobj);
-    if (surf->w < 1 || surf->h < 1) {
-        Py_INCREF(surfobj);
-        return (PyObject *)surfobj;
+    if (!pgSurface_Unpack(surf))
+        return NULL;
+
+    if (!surfobj2) {
+        newsurf = newsurf_fromsurf(surf, surf->w * 3, surf->h * 3, NULL);
+        if (!newsurf)
+            return NULL;
     }
+    else
+        newsurf = pgSurface_AsSurface(surfobj2);
 
-    if (surf->format->BytesPerPixel == 0 || surf->format->BytesPerPixel > 4)
+    if (newsurf->w != (surf->w * 3) || newsurf->h != (surf->h * 3))
+        return RAISE(PyExc_ValueError, "Destination surface not 3x bigger.");
+
+    if (surf->format->BytesPerPixel != newsurf->format->BytesPerPixel)
         return RAISE(PyExc_ValueError,
-                     "unsupported Surface bit depth for transform");
+                     "Source and destination surfaces need the same format.");
+    if (!pgSurface_Unshare(newsurf))
+        return NULL;
 
-    if (!(fmod((double)angle, (double)90.0f))) {
-        pgSurface_Lock(surfobj);
+    SDL_LockSurface(newsurf);
+    SDL_LockSurface(surf);
 
-        /* The function releases GIL internally, don't release here */
-        newsurf = rotate90(surf, (int)angle);
+    start = pg_StatsBegin();
+    Py_BEGIN_ALLOW_THREADS;
+    scale3x(surf, newsurf);
+    Py_END_ALLOW_THREADS;
+    pg_StatsEnd(PG_STAT_TRANSFORM, "scale3x", start,
+                (Sint64)newsurf->w * newsurf->h);
 
-        pgSurface_Unlock(surfobj);
-        if (!newsurf)
-            return NULL;
-        return (PyObject *)pgSurface_New(newsurf);
-    }
+    SDL_UnlockSurface(surf);
+    SDL_UnlockSurface(newsurf);
 
-    radangle = angle * .01745329251994329;
-    sangle = sin(radangle);
-    cangle = cos(radangle);
+    if (surfobj2) {
+        Py_INCREF(surfobj2);
+        return surfobj2;
+    }
+    else
+        return (PyObject *)pgSurface_New(newsurf);
+}
 
-    x = surf->w;
-    y = surf->h;
-    cx = cangle * x;
-    cy = cangle * y;
-    sx = sangle * x;
-    sy = sangle * y;
-    nxmax = (int)(MAX(MAX(MAX(fabs(cx + sy), fabs(cx - sy)), fabs(-cx + sy)),
-                      fabs(-cx - sy)));
-    nymax = (int)(MAX(MAX(MAX(fabs(sx + cy), fabs(sx - cy)), fabs(-sx + cy)),
-                      fabs(-sx - cy)));
+static PyObject *
+surf_scale_by_int(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *surfobj2 = NULL, *pool = NULL;
+    SDL_Surface *surf, *newsurf;
+    int factor, width, height;
+    Uint64 start;
+    static char *keywords[] = {"surface", "factor", "dest_surface", "pool",
+                               NULL};
 
-    newsurf = newsurf_fromsurf(surf, nxmax, nymax);
-    if (!newsurf)
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!i|O!O!", keywords,
+                                     &pgSurface_Type, &surfobj, &factor,
+                                     &pgSurface_Type, &surfobj2,
+                                     &pgSurfacePool_Type, &pool))
         return NULL;
 
-    /* get the background color */
-    if (SDL_GetColorKey(surf, &bgcolor) != 0) {
-        SDL_LockSurface(surf);
-        switch (surf->format->BytesPerPixel) {
-            case 1:
-                bgcolor = *(Uint8 *)surf->pixels;
-                break;
-            case 2:
+    if (factor < 1)
+        return RAISE(PyExc_ValueError, "factor must be at least 1");
+
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    if ((long long)surf->w * factor > INT_MAX ||
+        (long long)surf->h * factor > INT_MAX)
+        return RAISE(PyExc_ValueError, "factor too large");
+    width = surf->w * factor;
+    height = surf->h * factor;
+
+    if (!surfobj2) {
+        newsurf = newsurf_fromsurf(surf, width, height, pool);
+        if (!newsurf)
+            return NULL;
+    }
+    else
+        newsurf = pgSurface_AsSurface(surfobj2);
+
+    if (newsurf->w != width || newsurf->h != height)
+        return RAISE(PyExc_ValueError,
+                     "Destination surface not factor times bigger.");
+
+    if (surf->format->BytesPerPixel != newsurf->format->BytesPerPixel)
+        return RAISE(PyExc_ValueError,
+                     "Source and destination surfaces need the same format.");
+    if (!pgSurface_Unshare(newsurf))
+        return NULL;
+
+    if (width && height) {
+        SDL_LockSurface(newsurf);
+        pgSurface_Lock(surfobj);
+
+        start = pg_StatsBegin();
+        Py_BEGIN_ALLOW_THREADS;
+        scale_by_int_run(surf, newsurf, factor);
+        Py_END_ALLOW_THREADS;
+        pg_StatsEnd(PG_STAT_TRANSFORM, "scale_by_int", start,
+                    (Sint64)width * height);
+
+        pgSurface_Unlock(surfobj);
+        SDL_UnlockSurface(newsurf);
+    }
+
+    if (surfobj2) {
+        Py_INCREF(surfobj2);
+        return surfobj2;
+    }
+    else
+        return (PyObject *)pgSurface_New(newsurf);
+}
+
+static PyObject *
+surf_rotate(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *surfobj2 = NULL, *pool = NULL;
+    SDL_Surface *surf, *newsurf, *dest = NULL;
+    float angle;
+
+    double radangle, sangle, cangle;
+    double x, y, cx, cy, sx, sy;
+    int nxmax, nymax;
+    Uint32 bgcolor;
+    Uint64 start;
+    static char *keywords[] = {"surface", "angle", "dest_surface", "pool",
+                               NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!f|O!O!", keywords,
+                                     &pgSurface_Type, &surfobj, &angle,
+                                     &pgSurface_Type, &surfobj2,
+                                     &pgSurfacePool_Type, &pool))
+        return NULL;
+    surf = pgSurface_AsSurface(surfobj);
+    if (surfobj2)
+        dest = pgSurface_AsSurface(surfobj2);
+    if (surf->w < 1 || surf->h < 1) {
+        if (surfobj2) {
+            Py_INCREF(surfobj2);
+            return surfobj2;
+        }
+        Py_INCREF(surfobj);
+        return (PyObject *)surfobj;
+    }
+
+    if (surf->format->BytesPerPixel == 0 || surf->format->BytesPerPixel > 4)
+        return RAISE(PyExc_ValueError,
+                     "unsupported Surface bit depth for transform");
+
+    if (!(fmod((double)angle, (double)90.0f))) {
+        pgSurface_Lock(surfobj);
+
+        /* The function releases GIL internally, don't release here */
+        start = pg_StatsBegin();
+        newsurf = rotate90(surf, dest, (int)angle, pool);
+        pg_StatsEnd(PG_STAT_TRANSFORM, "rotate90", start,
+                    (Sint64)surf->w * surf->h);
+
+        pgSurface_Unlock(surfobj);
+        if (!newsurf)
+            return NULL;
+        if (surfobj2) {
+            Py_INCREF(surfobj2);
+            return surfobj2;
+        }
+        return (PyObject *)pgSurface_New(newsurf);
+    }
+
+    radangle = angle * .01745329251994329;
+    sangle = sin(radangle);
+    cangle = cos(radangle);
+
+    x = surf->w;
+    y = surf->h;
+    cx = cangle * x;
+    cy = cangle * y;
+    sx = sangle * x;
+    sy = sangle * y;
+    nxmax = (int)(MAX(MAX(MAX(fabs(cx + sy), fabs(cx - sy)), fabs(-cx + sy)),
+                      fabs(-cx - sy)));
+    nymax = (int)(MAX(MAX(MAX(fabs(sx + cy), fabs(sx - cy)), fabs(-sx + cy)),
+                      fabs(-sx - cy)));
+
+    if (dest) {
+        if (_check_dest_surface(surf, dest, nxmax, nymax))
+            return NULL;
+        newsurf = dest;
+    }
+    else {
+        newsurf = newsurf_fromsurf(surf, nxmax, nymax, pool);
+        if (!newsurf)
+            return NULL;
+    }
+
+    /* get the background color */
+    if (SDL_GetColorKey(surf, &bgcolor) != 0) {
+        SDL_LockSurface(surf);
+        switch (surf->format->BytesPerPixel) {
+            case 1:
+                bgcolor = *(Uint8 *)surf->pixels;
+                break;
+            case 2:
                 bgcolor = *(Uint16 *)surf->pixels;
                 break;
             case 4:
@@ -768,47 +1135,54 @@ surf_rotate(PyObject *self, PyObject *args, PyObject *kwargs)
     SDL_LockSurface(newsurf);
     pgSurface_Lock(surfobj);
 
+    start = pg_StatsBegin();
     Py_BEGIN_ALLOW_THREADS;
     rotate(surf, newsurf, bgcolor, sangle, cangle);
     Py_END_ALLOW_THREADS;
+    pg_StatsEnd(PG_STAT_TRANSFORM, "rotate", start,
+                (Sint64)newsurf->w * newsurf->h);
 
     pgSurface_Unlock(surfobj);
     SDL_UnlockSurface(newsurf);
 
+    if (surfobj2) {
+        Py_INCREF(surfobj2);
+        return surfobj2;
+    }
     return (PyObject *)pgSurface_New(newsurf);
 }
 
-static PyObject *
-surf_flip(PyObject *self, PyObject *args, PyObject *kwargs)
+/* Copy a row of count 32 bit pixels last first: dst[i] = src[count-1-i] */
+static void
+flip_row32(Uint32 *dst, const Uint32 *src, int count)
 {
-    pgSurfaceObject *surfobj;
-    SDL_Surface *surf, *newsurf;
-    int xaxis, yaxis;
-    int loopx, loopy;
-    int srcpitch, dstpitch;
-    Uint8 *srcpix, *dstpix;
-    static char *keywords[] = {"surface", "flip_x", "flip_y", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!ii", keywords,
-                                     &pgSurface_Type, &surfobj, &xaxis,
-                                     &yaxis))
-        return NULL;
-    surf = pgSurface_AsSurface(surfobj);
-
-    newsurf = newsurf_fromsurf(surf, surf->w, surf->h);
-    if (!newsurf)
-        return NULL;
+    int x = 0;
 
-    srcpitch = surf->pitch;
-    dstpitch = newsurf->pitch;
+#ifdef TRANSFORM_SIMD
+    if (_use_simd()) {
+        for (; x + 4 <= count; x += 4) {
+            __m128i px =
+                _mm_loadu_si128((const __m128i *)(src + count - 4 - x));
 
-    SDL_LockSurface(newsurf);
-    pgSurface_Lock(surfobj);
-
-    srcpix = (Uint8 *)surf->pixels;
-    dstpix = (Uint8 *)newsurf->pixels;
+            _mm_storeu_si128((__m128i *)(dst + x),
+                             _mm_shuffle_epi32(px, _MM_SHUFFLE(0, 1, 2, 3)));
+        }
+    }
+#endif /* TRANSFORM_SIMD */
+    for (; x < count; x++) {
+        dst[x] = src[count - 1 - x];
+    }
+}
 
-    Py_BEGIN_ALLOW_THREADS;
+/* Flip surf into newsurf, which must be the same size and format */
+static void
+flip(SDL_Surface *surf, SDL_Surface *newsurf, int xaxis, int yaxis)
+{
+    int loopx, loopy;
+    int srcpitch = surf->pitch;
+    int dstpitch = newsurf->pitch;
+    Uint8 *srcpix = (Uint8 *)surf->pixels;
+    Uint8 *dstpix = (Uint8 *)newsurf->pixels;
 
     if (!xaxis) {
         if (!yaxis) {
@@ -851,13 +1225,11 @@ surf_flip(PyObject *self, PyObject *args, PyObject *kwargs)
                     break;
                 case 4:
                     for (loopy = 0; loopy < surf->h; ++loopy) {
-                        Uint32 *dst = (Uint32 *)(dstpix + loopy * dstpitch);
-                        Uint32 *src =
-                            ((Uint32 *)(srcpix +
-                                        (surf->h - 1 - loopy) * srcpitch)) +
-                            surf->w - 1;
-                        for (loopx = 0; loopx < surf->w; ++loopx)
-                            *dst++ = *src--;
+                        flip_row32(
+                            (Uint32 *)(dstpix + loopy * dstpitch),
+                            (Uint32 *)(srcpix +
+                                       (surf->h - 1 - loopy) * srcpitch),
+                            surf->w);
                     }
                     break;
                 case 3:
@@ -900,11 +1272,9 @@ surf_flip(PyObject *self, PyObject *args, PyObject *kwargs)
                     break;
                 case 4:
                     for (loopy = 0; loopy < surf->h; ++loopy) {
-                        Uint32 *dst = (Uint32 *)(dstpix + loopy * dstpitch);
-                        Uint32 *src = ((Uint32 *)(srcpix + loopy * srcpitch)) +
-                                      surf->w - 1;
-                        for (loopx = 0; loopx < surf->w; ++loopx)
-                            *dst++ = *src--;
+                        flip_row32((Uint32 *)(dstpix + loopy * dstpitch),
+                                   (Uint32 *)(srcpix + loopy * srcpitch),
+                                   surf->w);
                     }
                     break;
                 case 3:
@@ -924,30 +1294,266 @@ surf_flip(PyObject *self, PyObject *args, PyObject *kwargs)
             }
         }
     }
+}
+
+#define FLIP_SWAP(type, a, b)        \
+    do {                             \
+        type tmp = *(type *)(a);     \
+        *(type *)(a) = *(type *)(b); \
+        *(type *)(b) = tmp;          \
+    } while (0)
+
+/* Flip a surface in place by swapping pixels, with no second buffer */
+static void
+flip_in_place(SDL_Surface *surf, int xaxis, int yaxis)
+{
+    int bpp = surf->format->BytesPerPixel;
+    int pitch = surf->pitch;
+    int w = surf->w;
+    int h = surf->h;
+    Uint8 *pixels = (Uint8 *)surf->pixels;
+    int x, y, n, count;
+
+    if (!xaxis) {
+        if (yaxis) {
+            for (y = 0; y < h / 2; y++) {
+                Uint8 *top = pixels + y * pitch;
+                Uint8 *bottom = pixels + (h - 1 - y) * pitch;
+                for (n = 0; n < w * bpp; n++) {
+                    FLIP_SWAP(Uint8, top + n, bottom + n);
+                }
+            }
+        }
+        return;
+    }
+
+    /* Swap each pixel with its mirror image. When flipping both ways that
+     * is in the mirrored row, so only the top half of the rows is walked,
+     * and a row mirrored onto itself only swaps its first half. */
+    for (y = 0; y < (yaxis ? (h + 1) / 2 : h); y++) {
+        Uint8 *row = pixels + y * pitch;
+        Uint8 *other = yaxis ? pixels + (h - 1 - y) * pitch : row;
+        Uint8 *a = row;
+        Uint8 *b = other + (w - 1) * bpp;
+
+        count = other == row ? w / 2 : w;
+        x = 0;
+#ifdef TRANSFORM_SIMD
+        /* swap blocks of four 32 bit pixels, reversing each; a row
+         * mirrored onto itself stops before its blocks would meet */
+        if (bpp == 4 && _use_simd()) {
+            for (; x + 4 <= count; x += 4, a += 16, b -= 16) {
+                __m128i pa = _mm_loadu_si128((const __m128i *)a);
+                __m128i pb = _mm_loadu_si128((const __m128i *)(b - 12));
+
+                _mm_storeu_si128(
+                    (__m128i *)a,
+                    _mm_shuffle_epi32(pb, _MM_SHUFFLE(0, 1, 2, 3)));
+                _mm_storeu_si128(
+                    (__m128i *)(b - 12),
+                    _mm_shuffle_epi32(pa, _MM_SHUFFLE(0, 1, 2, 3)));
+            }
+        }
+#endif /* TRANSFORM_SIMD */
+        for (; x < count; x++, a += bpp, b -= bpp) {
+            switch (bpp) {
+                case 1:
+                    FLIP_SWAP(Uint8, a, b);
+                    break;
+                case 2:
+                    FLIP_SWAP(Uint16, a, b);
+                    break;
+                case 4:
+                    FLIP_SWAP(Uint32, a, b);
+                    break;
+                default: /*case 3:*/
+                    FLIP_SWAP(Uint8, a, b);
+                    FLIP_SWAP(Uint8, a + 1, b + 1);
+                    FLIP_SWAP(Uint8, a + 2, b + 2);
+                    break;
+            }
+        }
+    }
+}
+
+#undef FLIP_SWAP
+
+static PyObject *
+surf_flip(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *surfobj2 = NULL, *pool = NULL;
+    SDL_Surface *surf, *newsurf;
+    int xaxis, yaxis, inplace;
+    Uint64 start;
+    static char *keywords[] = {"surface", "flip_x", "flip_y", "dest_surface",
+                               "pool",    NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!ii|O!O!", keywords,
+                                     &pgSurface_Type, &surfobj, &xaxis,
+                                     &yaxis, &pgSurface_Type, &surfobj2,
+                                     &pgSurfacePool_Type, &pool))
+        return NULL;
+    surf = pgSurface_AsSurface(surfobj);
+
+    if (surfobj2) {
+        newsurf = pgSurface_AsSurface(surfobj2);
+        /* flipping a surface onto itself works in place */
+        inplace = newsurf->pixels == surf->pixels &&
+                  newsurf->pitch == surf->pitch && newsurf->w == surf->w &&
+                  newsurf->h == surf->h &&
+                  newsurf->format->BytesPerPixel ==
+                      surf->format->BytesPerPixel;
+        if (!inplace &&
+            _check_dest_surface(surf, newsurf, surf->w, surf->h))
+            return NULL;
+    }
+    else {
+        inplace = 0;
+        newsurf = newsurf_fromsurf(surf, surf->w, surf->h, pool);
+        if (!newsurf)
+            return NULL;
+    }
+
+    pgSurface_Lock(surfobj);
+    if (!inplace)
+        SDL_LockSurface(newsurf);
+
+    start = pg_StatsBegin();
+    Py_BEGIN_ALLOW_THREADS;
+    if (inplace)
+        flip_in_place(surf, xaxis, yaxis);
+    else
+        flip(surf, newsurf, xaxis, yaxis);
     Py_END_ALLOW_THREADS;
+    pg_StatsEnd(PG_STAT_TRANSFORM, inplace ? "flip_in_place" : "flip", start,
+                (Sint64)surf->w * surf->h);
 
+    if (!inplace)
+        SDL_UnlockSurface(newsurf);
     pgSurface_Unlock(surfobj);
-    SDL_UnlockSurface(newsurf);
+
+    if (surfobj2) {
+        Py_INCREF(surfobj2);
+        return surfobj2;
+    }
     return (PyObject *)pgSurface_New(newsurf);
 }
 
+typedef struct {
+    SDL_Surface *src;
+    SDL_Surface *dst;
+    double angle;
+    double zoom;
+} RotozoomPass;
+
+static void
+rotozoom_band(void *data, int band, int nbands)
+{
+    RotozoomPass *pass = (RotozoomPass *)data;
+    int height = pass->dst->h;
+
+    rotozoomSurfaceRows(pass->src, pass->dst, pass->angle, pass->zoom, 1,
+                        (int)((long long)height * band / nbands),
+                        (int)((long long)height * (band + 1) / nbands));
+}
+
+/* Smoothly rotozoom the locked 32 bit src into dst, in bands of rows on
+ * the worker pool when dst is large enough. Every destination pixel is
+ * computed on its own, so the result does not depend on the banding.
+ */
+static void
+rotozoom_run(SDL_Surface *src, SDL_Surface *dst, double angle, double zoom)
+{
+    RotozoomPass pass;
+    int nthreads = pg_GetNumThreads();
+
+    if (nthreads > dst->h) {
+        nthreads = dst->h;
+    }
+    if (nthreads < 2 || (long long)dst->w * dst->h < PG_PARALLEL_MIN_PIXELS) {
+        rotozoomSurfaceRows(src, dst, angle, zoom, 1, 0, dst->h);
+        return;
+    }
+
+    pass.src = src;
+    pass.dst = dst;
+    pass.angle = angle;
+    pass.zoom = zoom;
+    pg_ParallelFor(rotozoom_band, &pass, nthreads);
+}
+
 static PyObject *
 surf_rotozoom(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    pgSurfaceObject *surfobj;
-    SDL_Surface *surf, *newsurf, *surf32;
+    pgSurfaceObject *surfobj, *surfobj2 = NULL;
+    PyObject *pool = NULL;
+    SDL_Surface *surf, *newsurf = NULL, *surf32, *dest;
     float scale, angle;
-    static char *keywords[] = {"surface", "angle", "scale", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!ff", keywords,
+    Uint32 rmask = 0x000000ff, gmask = 0x0000ff00, bmask = 0x00ff0000,
+           amask = 0xff000000;
+    int destwidth = 0, destheight = 0;
+    Uint64 start;
+    static char *keywords[] = {"surface", "angle", "scale", "dest_surface",
+                               "pool",    NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!ff|O!O!", keywords,
                                      &pgSurface_Type, &surfobj, &angle,
-                                     &scale))
+                                     &scale, &pgSurface_Type, &surfobj2,
+                                     &pgSurfacePool_Type, &pool))
         return NULL;
     surf = pgSurface_AsSurface(surfobj);
+
+    /* the result is always 32 bit, in the source's channel order when it
+     * is already 32 bit */
+    if (surf->format->BitsPerPixel == 32) {
+        rmask = surf->format->Rmask;
+        gmask = surf->format->Gmask;
+        bmask = surf->format->Bmask;
+        amask = surf->format->Amask;
+    }
+    if (scale != 0.0 && surf->w != 0 && surf->h != 0) {
+        rotozoomSurfaceDestSize(surf->w, surf->h, angle, scale, &destwidth,
+                                &destheight);
+    }
+
+    if (surfobj2) {
+        dest = pgSurface_AsSurface(surfobj2);
+        if (dest->format->BitsPerPixel != 32 ||
+            dest->format->Rmask != rmask || dest->format->Gmask != gmask ||
+            dest->format->Bmask != bmask || dest->format->Amask != amask) {
+            return RAISE(PyExc_ValueError,
+                         "Destination surface must be 32 bit with the "
+                         "rotozoom channel order.");
+        }
+        if (dest->w != destwidth || dest->h != destheight) {
+            return RAISE(PyExc_ValueError,
+                         "Destination surface not the given width or height.");
+        }
+        if (!pgSurface_Unshare(dest))
+            return NULL;
+        if (_surfaces_overlap(surf, dest)) {
+            return RAISE(PyExc_ValueError,
+                         "Source and destination surfaces must not overlap.");
+        }
+    }
     if (scale == 0.0 || surf->w == 0 || surf->h == 0) {
-        newsurf = newsurf_fromsurf(surf, 0, 0);
+        if (surfobj2) {
+            Py_INCREF(surfobj2);
+            return (PyObject *)surfobj2;
+        }
+        newsurf = newsurf_fromsurf(surf, 0, 0, NULL);
         return (PyObject *)pgSurface_New(newsurf);
     }
+    if (!surfobj2) {
+        newsurf = pgSurfacePool_CreateSurface(pool, destwidth, destheight, 32,
+                                              rmask, gmask, bmask, amask);
+        if (!newsurf)
+            return NULL;
+        /* Turn on source-alpha support */
+        SDL_SetSurfaceAlphaMod(newsurf, SDL_ALPHA_OPAQUE);
+        dest = newsurf;
+    }
 
     if (surf->format->BitsPerPixel == 32) {
         surf32 = surf;
@@ -956,90 +1562,332 @@ surf_rotozoom(PyObject *self, PyObject *args, PyObject *kwargs)
     else {
         Py_BEGIN_ALLOW_THREADS;
         surf32 = SDL_CreateRGBSurface(SDL_SWSURFACE, surf->w, surf->h, 32,
-                                      0x000000ff, 0x0000ff00, 0x00ff0000,
-                                      0xff000000);
-        SDL_BlitSurface(surf, NULL, surf32, NULL);
+                                      rmask, gmask, bmask, amask);
+        if (surf32)
+            SDL_BlitSurface(surf, NULL, surf32, NULL);
         Py_END_ALLOW_THREADS;
+        if (!surf32) {
+            pgSurfacePool_FreeSurface(newsurf);
+            return RAISE(pgExc_SDLError, SDL_GetError());
+        }
     }
 
+    if (surfobj2)
+        pgSurface_Lock(surfobj2);
+    start = pg_StatsBegin();
     Py_BEGIN_ALLOW_THREADS;
-    newsurf = rotozoomSurface(surf32, angle, scale, 1);
+    rotozoom_run(surf32, dest, angle, scale);
     Py_END_ALLOW_THREADS;
+    pg_StatsEnd(PG_STAT_TRANSFORM, "rotozoom", start,
+                (Sint64)dest->w * dest->h);
+    if (surfobj2)
+        pgSurface_Unlock(surfobj2);
 
     if (surf32 == surf)
         pgSurface_Unlock(surfobj);
     else
         SDL_FreeSurface(surf32);
+    if (surfobj2) {
+        Py_INCREF(surfobj2);
+        return (PyObject *)surfobj2;
+    }
     return (PyObject *)pgSurface_New(newsurf);
 }
 
-static SDL_Surface *
-chop(SDL_Surface *src, int x, int y, int width, int height)
+typedef struct {
+    SDL_Surface *src;
+    SDL_Surface *dst;
+    double m[6];
+    int smooth;
+} AffinePass;
+
+static void
+affine_band(void *data, int band, int nbands)
+{
+    AffinePass *pass = (AffinePass *)data;
+    int height = pass->dst->h;
+
+    affineSurfaceRows(pass->src, pass->dst, pass->m, pass->smooth,
+                      (int)((long long)height * band / nbands),
+                      (int)((long long)height * (band + 1) / nbands));
+}
+
+/* Transform the locked 32 bit src into dst with the rotozoom core, in bands
+ * of rows on the worker pool when dst is large enough. m maps destination
+ * pixels to source positions, as affineSurfaceRows() takes it.
+ */
+static void
+affine_run(SDL_Surface *src, SDL_Surface *dst, const double *m, int smooth)
+{
+    AffinePass pass;
+    int nthreads = pg_GetNumThreads();
+
+    if (nthreads > dst->h) {
+        nthreads = dst->h;
+    }
+    if (nthreads < 2 || (long long)dst->w * dst->h < PG_PARALLEL_MIN_PIXELS) {
+        affineSurfaceRows(src, dst, m, smooth, 0, dst->h);
+        return;
+    }
+
+    pass.src = src;
+    pass.dst = dst;
+    memcpy(pass.m, m, sizeof(pass.m));
+    pass.smooth = smooth;
+    pg_ParallelFor(affine_band, &pass, nthreads);
+}
+
+/* Reads the 6 numbers a, b, c, d, e, f of an affine transform, such as a
+ * pygame.math.Affine2, from matrixobj. Returns 0 with an exception set on
+ * failure.
+ */
+static int
+_get_affine(PyObject *matrixobj, double *m)
+{
+    PyObject *seq;
+    Py_ssize_t i;
+
+    seq = PySequence_Fast(matrixobj,
+                          "matrix must be a sequence of 6 numbers");
+    if (!seq) {
+        return 0;
+    }
+    if (PySequence_Fast_GET_SIZE(seq) != 6) {
+        Py_DECREF(seq);
+        PyErr_SetString(PyExc_ValueError,
+                        "matrix must be a sequence of 6 numbers");
+        return 0;
+    }
+    for (i = 0; i < 6; i++) {
+        m[i] = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(seq, i));
+        if (m[i] == -1.0 && PyErr_Occurred()) {
+            Py_DECREF(seq);
+            return 0;
+        }
+        if (!isfinite(m[i])) {
+            Py_DECREF(seq);
+            PyErr_SetString(PyExc_ValueError, "matrix values must be finite");
+            return 0;
+        }
+    }
+    Py_DECREF(seq);
+    return 1;
+}
+
+static PyObject *
+surf_affine(PyObject *self, PyObject *args, PyObject *kwargs)
 {
+    pgSurfaceObject *surfobj;
+    PyObject *matrixobj, *size = Py_None;
+    SDL_Surface *surf, *newsurf, *surf32;
+    Uint32 rmask = 0x000000ff, gmask = 0x0000ff00, bmask = 0x00ff0000,
+           amask = 0xff000000;
+    double m[6], inv[6], r[6], det, offx = 0., offy = 0.;
+    double minx, miny, maxx, maxy, x, y;
+    int smooth = 1, destwidth, destheight, i;
+    static char *keywords[] = {"surface", "matrix", "size", "smooth", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|Op", keywords,
+                                     &pgSurface_Type, &surfobj, &matrixobj,
+                                     &size, &smooth))
+        return NULL;
+    surf = pgSurface_AsSurface(surfobj);
+
+    if (!_get_affine(matrixobj, m))
+        return NULL;
+    det = m[0] * m[4] - m[1] * m[3];
+    if (det == 0.)
+        return RAISE(PyExc_ValueError, "matrix is not invertible");
+    inv[0] = m[4] / det;
+    inv[1] = -m[1] / det;
+    inv[3] = -m[3] / det;
+    inv[4] = m[0] / det;
+    inv[2] = -(inv[0] * m[2] + inv[1] * m[5]);
+    inv[5] = -(inv[3] * m[2] + inv[4] * m[5]);
+
+    if (size == Py_None) {
+        /* the bounding box of the transformed surface, moved to (0, 0) */
+        minx = maxx = m[2];
+        miny = maxy = m[5];
+        for (i = 1; i < 4; i++) {
+            x = (i & 1) ? surf->w : 0;
+            y = (i & 2) ? surf->h : 0;
+            minx = MIN(minx, m[0] * x + m[1] * y + m[2]);
+            maxx = MAX(maxx, m[0] * x + m[1] * y + m[2]);
+            miny = MIN(miny, m[3] * x + m[4] * y + m[5]);
+            maxy = MAX(maxy, m[3] * x + m[4] * y + m[5]);
+        }
+        if (maxx - minx > INT_MAX / 2 || maxy - miny > INT_MAX / 2)
+            return RAISE(PyExc_ValueError, "transformed surface is too large");
+        /* rounding errors must not add a column or row */
+        destwidth = (int)ceil(maxx - minx - 1e-6);
+        destheight = (int)ceil(maxy - miny - 1e-6);
+        offx = minx;
+        offy = miny;
+    }
+    else if (!pg_TwoIntsFromObj(size, &destwidth, &destheight)) {
+        return RAISE(PyExc_TypeError, "size must be two numbers");
+    }
+    if (destwidth < 0 || destheight < 0)
+        return RAISE(PyExc_ValueError, "Cannot scale to negative size");
+
+    /* Destination pixel (x, y) samples the source at the point its center
+     * maps to. The rotozoom core reads the 2x2 block with that point in it
+     * when smoothing, and the pixel the point is in when not. */
+    r[0] = inv[0];
+    r[1] = inv[1];
+    r[3] = inv[3];
+    r[4] = inv[4];
+    r[2] = inv[0] * (offx + 0.5) + inv[1] * (offy + 0.5) + inv[2];
+    r[5] = inv[3] * (offx + 0.5) + inv[4] * (offy + 0.5) + inv[5];
+    if (smooth) {
+        r[2] -= 0.5;
+        r[5] -= 0.5;
+    }
+    /* the core works in 16.16 fixed point */
+    for (i = 0; i < 4; i++) {
+        x = r[0] * ((i & 1) ? destwidth : 0) +
+            r[1] * ((i & 2) ? destheight : 0) + r[2];
+        y = r[3] * ((i & 1) ? destwidth : 0) +
+            r[4] * ((i & 2) ? destheight : 0) + r[5];
+        if (!(fabs(x) < 32000. && fabs(y) < 32000. && fabs(r[i]) < 32000.))
+            return RAISE(PyExc_ValueError,
+                         "matrix maps the result too far outside the "
+                         "surface");
+    }
+
+    /* the result is always 32 bit, in the source's channel order when it
+     * is already 32 bit */
+    if (surf->format->BitsPerPixel == 32) {
+        rmask = surf->format->Rmask;
+        gmask = surf->format->Gmask;
+        bmask = surf->format->Bmask;
+        amask = surf->format->Amask;
+    }
+    newsurf = pgSurfacePool_CreateSurface(NULL, destwidth, destheight, 32,
+                                          rmask, gmask, bmask, amask);
+    if (!newsurf)
+        return NULL;
+    /* Turn on source-alpha support */
+    SDL_SetSurfaceAlphaMod(newsurf, SDL_ALPHA_OPAQUE);
+    if (surf->w == 0 || surf->h == 0 || destwidth == 0 || destheight == 0)
+        return (PyObject *)pgSurface_New(newsurf);
+
+    if (surf->format->BitsPerPixel == 32) {
+        surf32 = surf;
+        pgSurface_Lock(surfobj);
+    }
+    else {
+        Py_BEGIN_ALLOW_THREADS;
+        surf32 = SDL_CreateRGBSurface(SDL_SWSURFACE, surf->w, surf->h, 32,
+                                      rmask, gmask, bmask, amask);
+        if (surf32)
+            SDL_BlitSurface(surf, NULL, surf32, NULL);
+        Py_END_ALLOW_THREADS;
+        if (!surf32) {
+            SDL_FreeSurface(newsurf);
+            return RAISE(pgExc_SDLError, SDL_GetError());
+        }
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    affine_run(surf32, newsurf, r, smooth);
+    Py_END_ALLOW_THREADS;
+
+    if (surf32 == surf)
+        pgSurface_Unlock(surfobj);
+    else
+        SDL_FreeSurface(surf32);
+    return (PyObject *)pgSurface_New(newsurf);
+}
+
+typedef struct {
+    SDL_Surface *src;
     SDL_Surface *dst;
-    int dstwidth, dstheight;
-    char *srcpix, *dstpix, *srcrow, *dstrow;
-    int srcstepx, srcstepy, dststepx, dststepy;
-    int loopx, loopy;
+    int x, y, width, height;
+} ChopPass;
+
+/* Copy rows [start, stop) of dst from src, leaving out the chopped columns
+ * [x, x + width) and skipping the chopped rows [y, y + height) of src. Each
+ * row is at most two block copies, one either side of the chopped columns.
+ */
+static void
+chop_rows(ChopPass *pass, int start, int stop)
+{
+    SDL_Surface *src = pass->src, *dst = pass->dst;
+    int bpp = src->format->BytesPerPixel;
+    size_t left = (size_t)pass->x * bpp;
+    size_t skip = (size_t)(pass->x + pass->width) * bpp;
+    size_t right = (size_t)src->w * bpp - skip;
+    int row, srcrow;
+    Uint8 *srcpix, *dstpix;
+
+    for (row = start; row < stop; row++) {
+        srcrow = row < pass->y ? row : row + pass->height;
+        srcpix = (Uint8 *)src->pixels + (size_t)srcrow * src->pitch;
+        dstpix = (Uint8 *)dst->pixels + (size_t)row * dst->pitch;
+        memcpy(dstpix, srcpix, left);
+        memcpy(dstpix + left, srcpix + skip, right);
+    }
+}
+
+static void
+chop_band(void *data, int band, int nbands)
+{
+    ChopPass *pass = (ChopPass *)data;
+    int height = pass->dst->h;
+
+    chop_rows(pass, (int)((long long)height * band / nbands),
+              (int)((long long)height * (band + 1) / nbands));
+}
+
+/* Chop a rect out of src into dst, or into a new surface when dst is
+ * NULL. The rows are copied in bands on the worker pool when dst is large
+ * enough.
+ */
+static SDL_Surface *
+chop(SDL_Surface *src, SDL_Surface *dst, int x, int y, int width, int height)
+{
+    ChopPass pass;
+    int nthreads;
 
-    if ((x + width) > src->w)
-        width = MIN(MAX(src->w - x, 0), src->w);
-    if ((y + height) > src->h)
-        height = MIN(MAX(src->h - y, 0), src->h);
+    /* only the part of the rect over src is chopped */
     if (x < 0) {
-        width -= (-x);
+        width += x;
         x = 0;
     }
     if (y < 0) {
-        height -= (-y);
+        height += y;
         y = 0;
     }
+    x = MIN(x, src->w);
+    y = MIN(y, src->h);
+    width = MAX(MIN(width, src->w - x), 0);
+    height = MAX(MIN(height, src->h - y), 0);
 
-    dstwidth = src->w - width;
-    dstheight = src->h - height;
-
-    dst = newsurf_fromsurf(src, dstwidth, dstheight);
+    if (!dst)
+        dst = newsurf_fromsurf(src, src->w - width, src->h - height, NULL);
+    else if (_check_dest_surface(src, dst, src->w - width, src->h - height))
+        return NULL;
     if (!dst)
         return NULL;
 
+    pass.src = src;
+    pass.dst = dst;
+    pass.x = x;
+    pass.y = y;
+    pass.width = width;
+    pass.height = height;
+
     Py_BEGIN_ALLOW_THREADS;
     SDL_LockSurface(dst);
-    srcrow = (char *)src->pixels;
-    dstrow = (char *)dst->pixels;
-    srcstepx = dststepx = src->format->BytesPerPixel;
-    srcstepy = src->pitch;
-    dststepy = dst->pitch;
-
-    for (loopy = 0; loopy < src->h; loopy++) {
-        if ((loopy < y) || (loopy >= (y + height))) {
-            dstpix = dstrow;
-            srcpix = srcrow;
-            for (loopx = 0; loopx < src->w; loopx++) {
-                if ((loopx < x) || (loopx >= (x + width))) {
-                    switch (src->format->BytesPerPixel) {
-                        case 1:
-                            *dstpix = *srcpix;
-                            break;
-                        case 2:
-                            *(Uint16 *)dstpix = *(Uint16 *)srcpix;
-                            break;
-                        case 3:
-                            dstpix[0] = srcpix[0];
-                            dstpix[1] = srcpix[1];
-                            dstpix[2] = srcpix[2];
-                            break;
-                        case 4:
-                            *(Uint32 *)dstpix = *(Uint32 *)srcpix;
-                            break;
-                    }
-                    dstpix += dststepx;
-                }
-                srcpix += srcstepx;
-            }
-            dstrow += dststepy;
-        }
-        srcrow += srcstepy;
-    }
+    nthreads = pg_GetNumThreads();
+    if (nthreads > dst->h)
+        nthreads = dst->h;
+    if (nthreads < 2 || (long long)dst->w * dst->h < PG_PARALLEL_MIN_PIXELS)
+        chop_rows(&pass, 0, dst->h);
+    else
+        pg_ParallelFor(chop_band, &pass, nthreads);
     SDL_UnlockSurface(dst);
     Py_END_ALLOW_THREADS;
 
@@ -1049,25 +1897,192 @@ chop(SDL_Surface *src, int x, int y, int width, int height)
 static PyObject *
 surf_chop(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    PyObject *surfobj, *rectobj;
+    PyObject *surfobj, *rectobj, *surfobj2 = NULL;
     SDL_Surface *surf, *newsurf;
     SDL_Rect *rect, temp;
-    static char *keywords[] = {"surface", "rect", NULL};
+    static char *keywords[] = {"surface", "rect", "dest_surface", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O", keywords,
-                                     &pgSurface_Type, &surfobj, &rectobj))
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|O!", keywords,
+                                     &pgSurface_Type, &surfobj, &rectobj,
+                                     &pgSurface_Type, &surfobj2))
         return NULL;
 
     if (!(rect = pgRect_FromObject(rectobj, &temp)))
         return RAISE(PyExc_TypeError, "Rect argument is invalid");
 
     surf = pgSurface_AsSurface(surfobj);
+    if (!pgSurface_Unpack(surf) ||
+        (surfobj2 && !pgSurface_Unshare(pgSurface_AsSurface(surfobj2))))
+        return NULL;
     /* The function releases GIL internally, don't release here */
-    newsurf = chop(surf, rect->x, rect->y, rect->w, rect->h);
+    newsurf = chop(surf, surfobj2 ? pgSurface_AsSurface(surfobj2) : NULL,
+                   rect->x, rect->y, rect->w, rect->h);
+    if (!newsurf)
+        return NULL;
 
+    if (surfobj2) {
+        Py_INCREF(surfobj2);
+        return surfobj2;
+    }
     return (PyObject *)pgSurface_New(newsurf);
 }
 
+typedef struct {
+    SDL_Surface *src;
+    /* one surface per cell, or just the atlas the cells are stacked in */
+    SDL_Surface **cells;
+    int atlas;
+    int columns, count;
+    int cellw, cellh;
+} SplitGridPass;
+
+/* Copy cells [start, stop) of the grid, in row major order, out of src.
+ * A cell whose rows are contiguous in both surfaces, as when the cells
+ * span the whole width of src, is a single block copy.
+ */
+static void
+split_grid_cells(SplitGridPass *pass, int start, int stop)
+{
+    SDL_Surface *src = pass->src, *dst;
+    size_t rowbytes = (size_t)pass->cellw * src->format->BytesPerPixel;
+    Uint8 *srcpix, *dstpix;
+    int cell, row;
+
+    for (cell = start; cell < stop; cell++) {
+        dst = pass->cells[pass->atlas ? 0 : cell];
+        srcpix = (Uint8 *)src->pixels +
+                 (size_t)(cell / pass->columns) * pass->cellh * src->pitch +
+                 (size_t)(cell % pass->columns) * rowbytes;
+        dstpix = (Uint8 *)dst->pixels;
+        if (pass->atlas)
+            dstpix += (size_t)cell * pass->cellh * dst->pitch;
+        if (src->pitch == dst->pitch && rowbytes == (size_t)src->pitch) {
+            memcpy(dstpix, srcpix, rowbytes * pass->cellh);
+            continue;
+        }
+        for (row = 0; row < pass->cellh; row++) {
+            memcpy(dstpix, srcpix, rowbytes);
+            srcpix += src->pitch;
+            dstpix += dst->pitch;
+        }
+    }
+}
+
+static void
+split_grid_band(void *data, int band, int nbands)
+{
+    SplitGridPass *pass = (SplitGridPass *)data;
+
+    split_grid_cells(pass, (int)((long long)pass->count * band / nbands),
+                     (int)((long long)pass->count * (band + 1) / nbands));
+}
+
+static PyObject *
+surf_split_grid(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *size, *result = NULL, *rects = NULL, *item;
+    SDL_Surface *surf;
+    SplitGridPass pass;
+    int as_atlas = 0, nthreads, i;
+    static char *keywords[] = {"surface", "cell_size", "as_atlas", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|p", keywords,
+                                     &pgSurface_Type, &surfobj, &size,
+                                     &as_atlas))
+        return NULL;
+
+    if (!pg_TwoIntsFromObj(size, &pass.cellw, &pass.cellh))
+        return RAISE(PyExc_TypeError, "cell_size must be two numbers");
+    if (pass.cellw < 1 || pass.cellh < 1)
+        return RAISE(PyExc_ValueError, "cell_size must be positive");
+
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+
+    pass.src = surf;
+    pass.atlas = as_atlas;
+    pass.columns = surf->w / pass.cellw;
+    pass.count = pass.columns * (surf->h / pass.cellh);
+    pass.cells = (SDL_Surface **)calloc(as_atlas ? 1 : MAX(pass.count, 1),
+                                        sizeof(SDL_Surface *));
+    if (!pass.cells)
+        return PyErr_NoMemory();
+
+    /* every surface is made before any pixels are copied, so the copies
+     * can all run without the GIL */
+    if (as_atlas) {
+        pass.cells[0] = newsurf_fromsurf(surf, pass.cellw,
+                                         pass.cellh * pass.count, NULL);
+        if (!pass.cells[0])
+            goto error;
+    }
+    else {
+        for (i = 0; i < pass.count; i++) {
+            pass.cells[i] =
+                newsurf_fromsurf(surf, pass.cellw, pass.cellh, NULL);
+            if (!pass.cells[i])
+                goto error;
+        }
+    }
+
+    pgSurface_Lock(surfobj);
+    Py_BEGIN_ALLOW_THREADS;
+    nthreads = pg_GetNumThreads();
+    if (nthreads > pass.count)
+        nthreads = pass.count;
+    if (nthreads < 2 || (long long)pass.cellw * pass.cellh * pass.count <
+                            PG_PARALLEL_MIN_PIXELS)
+        split_grid_cells(&pass, 0, pass.count);
+    else
+        pg_ParallelFor(split_grid_band, &pass, nthreads);
+    Py_END_ALLOW_THREADS;
+    pgSurface_Unlock(surfobj);
+
+    if (as_atlas) {
+        rects = PyList_New(pass.count);
+        if (!rects)
+            goto error;
+        for (i = 0; i < pass.count; i++) {
+            item = pgRect_New4(0, i * pass.cellh, pass.cellw, pass.cellh);
+            if (!item)
+                goto error;
+            PyList_SET_ITEM(rects, i, item);
+        }
+        item = (PyObject *)pgSurface_New(pass.cells[0]);
+        if (!item)
+            goto error;
+        pass.cells[0] = NULL;
+        result = Py_BuildValue("(NN)", item, rects);
+        rects = NULL;
+    }
+    else {
+        result = PyList_New(pass.count);
+        if (!result)
+            goto error;
+        for (i = 0; i < pass.count; i++) {
+            item = (PyObject *)pgSurface_New(pass.cells[i]);
+            if (!item)
+                goto error;
+            pass.cells[i] = NULL;
+            PyList_SET_ITEM(result, i, item);
+        }
+    }
+    free(pass.cells);
+    return result;
+
+error:
+    for (i = 0; i < (as_atlas ? 1 : pass.count); i++) {
+        if (pass.cells[i])
+            SDL_FreeSurface(pass.cells[i]);
+    }
+    free(pass.cells);
+    Py_XDECREF(rects);
+    Py_XDECREF(result);
+    return NULL;
+}
+
 /*
  * smooth scale functions.
  */
@@ -1281,106 +2296,512 @@ filter_expand_Y_ONLYC(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch,
             *dstpix++ =
                 (Uint8)(((*srcrow0++ * ymult0) + (*srcrow1++ * ymult1)) >> 16);
         }
+        dstpix += dstpitch - width * 4;
     }
 }
 
-static void
-smoothscale_init(struct _module_state *st)
-{
-    if (st->filter_shrink_X) {
-        return;
-    }
+#ifdef TRANSFORM_SIMD
+#if defined(PG_ENABLE_ARM_NEON)
+#define SMOOTHSCALE_SIMD_NAME "NEON"
+#else
+#define SMOOTHSCALE_SIMD_NAME "SSE2"
+#endif
 
-#ifdef SCALE_MMX_SUPPORT
-    if (SDL_HasSSE()) {
-        st->filter_type = "SSE";
-        st->filter_shrink_X = filter_shrink_X_SSE;
-        st->filter_shrink_Y = filter_shrink_Y_SSE;
-        st->filter_expand_X = filter_expand_X_SSE;
-        st->filter_expand_Y = filter_expand_Y_SSE;
-    }
-    else if (SDL_HasMMX()) {
-        st->filter_type = "MMX";
-        st->filter_shrink_X = filter_shrink_X_MMX;
-        st->filter_shrink_Y = filter_shrink_Y_MMX;
-        st->filter_expand_X = filter_expand_X_MMX;
-        st->filter_expand_Y = filter_expand_Y_MMX;
-    }
-    else {
-        st->filter_type = "GENERIC";
-        st->filter_shrink_X = filter_shrink_X_ONLYC;
-        st->filter_shrink_Y = filter_shrink_Y_ONLYC;
-        st->filter_expand_X = filter_expand_X_ONLYC;
-        st->filter_expand_Y = filter_expand_Y_ONLYC;
-    }
-#else  /* ~SCALE_MMX_SUPPORT */
-    st->filter_type = "GENERIC";
-    st->filter_shrink_X = filter_shrink_X_ONLYC;
-    st->filter_shrink_Y = filter_shrink_Y_ONLYC;
-    st->filter_expand_X = filter_expand_X_ONLYC;
-    st->filter_expand_Y = filter_expand_Y_ONLYC;
-#endif /* ~SCALE_MMX_SUPPORT */
+/* The SSE2 and NEON filters give the same bytes as the _ONLYC ones: the
+ * 8 bit channels are widened to 16 bit lanes and every product the C code
+ * takes in an int is taken in a 32 bit lane.
+ */
+
+static int
+smoothscale_use_simd(void)
+{
+#if defined(PG_ENABLE_ARM_NEON)
+    return pg_HasNEON();
+#else
+    return pg_HasSSE2();
+#endif
 }
 
-static void
-convert_24_32(Uint8 *srcpix, int srcpitch, Uint8 *dstpix, int dstpitch,
-              int width, int height)
+/* (s0 * (0x10000 - w) + s1 * w) >> 16 for the 8 lanes, with w below
+ * 0x10000. That is s0 + floor((s1 - s0) * w / 0x10000); the signed high
+ * multiply reads a w of 0x8000 or more as w - 0x10000, which the masked
+ * (s1 - s0) puts back.
+ */
+static PG_INLINE __m128i
+smoothscale_lerp16(__m128i s0, __m128i s1, __m128i w)
 {
-    int srcdiff = srcpitch - (width * 3);
-    int dstdiff = dstpitch - (width * 4);
-    int x, y;
+    __m128i d = _mm_sub_epi16(s1, s0);
 
-    for (y = 0; y < height; y++) {
-        for (x = 0; x < width; x++) {
-            *dstpix++ = *srcpix++;
-            *dstpix++ = *srcpix++;
-            *dstpix++ = *srcpix++;
-            *dstpix++ = 0xff;
-        }
-        srcpix += srcdiff;
-        dstpix += dstdiff;
-    }
+    return _mm_add_epi16(
+        _mm_add_epi16(s0, _mm_mulhi_epi16(d, w)),
+        _mm_and_si128(d, _mm_srai_epi16(w, 15)));
 }
 
-static void
-convert_32_24(Uint8 *srcpix, int srcpitch, Uint8 *dstpix, int dstpitch,
-              int width, int height)
+/* The low byte of (v * recip) >> 16 for the 4 lanes of v */
+static PG_INLINE __m128i
+smoothscale_div32(__m128i v, __m128i recip)
 {
-    int srcdiff = srcpitch - (width * 4);
-    int dstdiff = dstpitch - (width * 3);
-    int x, y;
+    __m128i even = _mm_srli_epi64(_mm_mul_epu32(v, recip), 16);
+    __m128i odd = _mm_srli_epi64(
+        _mm_mul_epu32(_mm_srli_epi64(v, 32), recip), 16);
 
-    for (y = 0; y < height; y++) {
-        for (x = 0; x < width; x++) {
-            *dstpix++ = *srcpix++;
-            *dstpix++ = *srcpix++;
-            *dstpix++ = *srcpix++;
-            srcpix++;
-        }
-        srcpix += srcdiff;
-        dstpix += dstdiff;
-    }
+    return _mm_and_si128(_mm_or_si128(even, _mm_slli_epi64(odd, 32)),
+                         _mm_set1_epi64x(0x000000FF000000FFLL));
 }
 
-static void
-scalesmooth(SDL_Surface *src, SDL_Surface *dst, struct _module_state *st)
+/* The bytes of (acc + ((s * counter) >> 16)) * recip >> 16 for the 8
+ * lanes, packed in the low half of the result.
+ */
+static PG_INLINE __m128i
+smoothscale_shrink_out(__m128i acc, __m128i s, int counter, __m128i recip)
 {
-    Uint8 *srcpix = (Uint8 *)src->pixels;
-    Uint8 *dstpix = (Uint8 *)dst->pixels;
-    Uint8 *dst32 = NULL;
-    int srcpitch = src->pitch;
-    int dstpitch = dst->pitch;
+    __m128i zero = _mm_setzero_si128();
+    __m128i part, lo, hi;
+
+    part = counter == 0x10000
+               ? s
+               : _mm_mulhi_epu16(s, _mm_set1_epi16((short)counter));
+    lo = _mm_add_epi32(_mm_unpacklo_epi16(acc, zero),
+                       _mm_unpacklo_epi16(part, zero));
+    hi = _mm_add_epi32(_mm_unpackhi_epi16(acc, zero),
+                       _mm_unpackhi_epi16(part, zero));
+    lo = _mm_packs_epi32(smoothscale_div32(lo, recip),
+                         smoothscale_div32(hi, recip));
+    return _mm_packus_epi16(lo, lo);
+}
 
-    int srcwidth = src->w;
-    int srcheight = src->h;
-    int dstwidth = dst->w;
-    int dstheight = dst->h;
+static PG_INLINE __m128i
+smoothscale_load_pixel(const Uint8 *p)
+{
+    Uint32 pixel;
 
-    int bpp = src->format->BytesPerPixel;
+    memcpy(&pixel, p, 4);
+    return _mm_cvtsi32_si128((int)pixel);
+}
+
+static PG_INLINE void
+smoothscale_store_pixel(Uint8 *p, __m128i v)
+{
+    Uint32 pixel = (Uint32)_mm_cvtsi128_si32(v);
+
+    memcpy(p, &pixel, 4);
+}
+
+/* Every row of the band steps through the same source columns, so the
+ * filter runs two rows side by side in one register.
+ */
+static void
+filter_shrink_X_SIMD(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch,
+                     int dstpitch, int srcwidth, int dstwidth)
+{
+    __m128i zero = _mm_setzero_si128();
+    int xspace = 0x10000 * srcwidth / dstwidth; /* must be > 1 */
+    __m128i recip = _mm_set1_epi32((int)(0x100000000LL / xspace));
+    int x, y;
+
+    for (y = 0; y < height; y += 2) {
+        Uint8 *src0 = srcpix + (size_t)y * srcpitch;
+        Uint8 *src1 = y + 1 < height ? src0 + srcpitch : src0;
+        Uint8 *dst0 = dstpix + (size_t)y * dstpitch;
+        Uint8 *dst1 = y + 1 < height ? dst0 + dstpitch : NULL;
+        __m128i acc = zero;
+        int xcounter = xspace;
+
+        for (x = 0; x < srcwidth; x++) {
+            __m128i s = _mm_unpacklo_epi8(
+                _mm_unpacklo_epi32(smoothscale_load_pixel(src0 + x * 4),
+                                   smoothscale_load_pixel(src1 + x * 4)),
+                zero);
+
+            if (xcounter > 0x10000) {
+                acc = _mm_add_epi16(acc, s);
+                xcounter -= 0x10000;
+            }
+            else {
+                int xfrac = 0x10000 - xcounter;
+                __m128i out = smoothscale_shrink_out(acc, s, xcounter, recip);
+
+                smoothscale_store_pixel(dst0, out);
+                dst0 += 4;
+                if (dst1) {
+                    smoothscale_store_pixel(dst1, _mm_srli_si128(out, 4));
+                    dst1 += 4;
+                }
+                acc = _mm_mulhi_epu16(s, _mm_set1_epi16((short)xfrac));
+                xcounter = xspace - xfrac;
+            }
+        }
+    }
+}
+
+static void
+filter_shrink_Y_SIMD(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch,
+                     int dstpitch, int srcheight, int dstheight)
+{
+    __m128i zero = _mm_setzero_si128();
+    Uint16 *templine;
+    int n = width * 4;
+    int x, y;
+    int yspace = 0x10000 * srcheight / dstheight; /* must be > 1 */
+    int yrecip = (int)(0x100000000LL / yspace);
+    __m128i recip = _mm_set1_epi32(yrecip);
+    int ycounter = yspace;
+
+    templine = (Uint16 *)calloc(n, sizeof(Uint16));
+    if (templine == NULL)
+        return;
+
+    for (y = 0; y < srcheight; y++, srcpix += srcpitch) {
+        if (ycounter > 0x10000) {
+            for (x = 0; x + 8 <= n; x += 8) {
+                __m128i s = _mm_unpacklo_epi8(
+                    _mm_loadl_epi64((__m128i *)(srcpix + x)), zero);
+                __m128i acc = _mm_loadu_si128((__m128i *)(templine + x));
+                _mm_storeu_si128((__m128i *)(templine + x),
+                                 _mm_add_epi16(acc, s));
+            }
+            for (; x < n; x++) {
+                templine[x] += (Uint16)srcpix[x];
+            }
+            ycounter -= 0x10000;
+        }
+        else {
+            int yfrac = 0x10000 - ycounter;
+            __m128i frac = _mm_set1_epi16((short)yfrac);
+
+            /* write out a destination line and reload the accumulator
+               with the remainder of this line */
+            for (x = 0; x + 8 <= n; x += 8) {
+                __m128i s = _mm_unpacklo_epi8(
+                    _mm_loadl_epi64((__m128i *)(srcpix + x)), zero);
+                __m128i acc = _mm_loadu_si128((__m128i *)(templine + x));
+                _mm_storel_epi64(
+                    (__m128i *)(dstpix + x),
+                    smoothscale_shrink_out(acc, s, ycounter, recip));
+                _mm_storeu_si128((__m128i *)(templine + x),
+                                 _mm_mulhi_epu16(s, frac));
+            }
+            for (; x < n; x++) {
+                dstpix[x] = (Uint8)(((templine[x] +
+                                      ((srcpix[x] * ycounter) >> 16)) *
+                                     yrecip) >>
+                                    16);
+                templine[x] = (Uint16)((srcpix[x] * yfrac) >> 16);
+            }
+            dstpix += dstpitch;
+            ycounter = yspace - yfrac;
+        }
+    }
+
+    free(templine);
+}
+
+/* Two destination pixels per register: the pixel pairs to blend are
+ * loaded as 8 bytes each and regrouped into the left and right pixels.
+ */
+static void
+filter_expand_X_SIMD(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch,
+                     int dstpitch, int srcwidth, int dstwidth)
+{
+    __m128i zero = _mm_setzero_si128();
+    int *xidx0;
+    Uint16 *xmult1; /* the weight of each pixel, once per channel */
+    int x, y;
+
+    xidx0 = (int *)malloc(dstwidth * sizeof(int));
+    xmult1 = (Uint16 *)malloc(dstwidth * 4 * sizeof(Uint16));
+    if (xidx0 == NULL || xmult1 == NULL) {
+        free(xidx0);
+        free(xmult1);
+        return;
+    }
+
+    for (x = 0; x < dstwidth; x++) {
+        xidx0[x] = x * (srcwidth - 1) / dstwidth;
+        xmult1[x * 4] =
+            (Uint16)(0x10000 * ((x * (srcwidth - 1)) % dstwidth) / dstwidth);
+        xmult1[x * 4 + 1] = xmult1[x * 4 + 2] = xmult1[x * 4 + 3] =
+            xmult1[x * 4];
+    }
+
+    for (y = 0; y < height; y++) {
+        Uint8 *srcrow0 = srcpix + (size_t)y * srcpitch;
+        Uint8 *dst = dstpix + (size_t)y * dstpitch;
+
+        for (x = 0; x + 2 <= dstwidth; x += 2) {
+            __m128i p = _mm_unpacklo_epi64(
+                _mm_loadl_epi64((__m128i *)(srcrow0 + xidx0[x] * 4)),
+                _mm_loadl_epi64((__m128i *)(srcrow0 + xidx0[x + 1] * 4)));
+            __m128i lo = _mm_unpacklo_epi8(p, zero);
+            __m128i hi = _mm_unpackhi_epi8(p, zero);
+            __m128i w = _mm_loadu_si128((__m128i *)(xmult1 + x * 4));
+            __m128i out =
+                smoothscale_lerp16(_mm_unpacklo_epi64(lo, hi),
+                                   _mm_unpackhi_epi64(lo, hi), w);
+
+            _mm_storel_epi64((__m128i *)(dst + x * 4),
+                             _mm_packus_epi16(out, out));
+        }
+        for (; x < dstwidth; x++) {
+            Uint8 *src = srcrow0 + xidx0[x] * 4;
+            int xm1 = xmult1[x * 4];
+            int xm0 = 0x10000 - xm1;
+            int c;
+
+            for (c = 0; c < 4; c++) {
+                dst[x * 4 + c] =
+                    (Uint8)(((src[c] * xm0) + (src[c + 4] * xm1)) >> 16);
+            }
+        }
+    }
+
+    free(xidx0);
+    free(xmult1);
+}
+
+static void
+filter_expand_Y_SIMD(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch,
+                     int dstpitch, int srcheight, int dstheight)
+{
+    __m128i zero = _mm_setzero_si128();
+    int n = width * 4;
+    int x, y;
+
+    for (y = 0; y < dstheight; y++) {
+        int yidx0 = y * (srcheight - 1) / dstheight;
+        Uint8 *srcrow0 = srcpix + (size_t)yidx0 * srcpitch;
+        Uint8 *srcrow1 = srcrow0 + srcpitch;
+        Uint8 *dst = dstpix + (size_t)y * dstpitch;
+        int ymult1 = 0x10000 * ((y * (srcheight - 1)) % dstheight) / dstheight;
+        int ymult0 = 0x10000 - ymult1;
+        __m128i w = _mm_set1_epi16((short)ymult1);
+
+        for (x = 0; x + 16 <= n; x += 16) {
+            __m128i a = _mm_loadu_si128((__m128i *)(srcrow0 + x));
+            __m128i b = _mm_loadu_si128((__m128i *)(srcrow1 + x));
+            __m128i lo = smoothscale_lerp16(_mm_unpacklo_epi8(a, zero),
+                                            _mm_unpacklo_epi8(b, zero), w);
+            __m128i hi = smoothscale_lerp16(_mm_unpackhi_epi8(a, zero),
+                                            _mm_unpackhi_epi8(b, zero), w);
+
+            _mm_storeu_si128((__m128i *)(dst + x), _mm_packus_epi16(lo, hi));
+        }
+        for (; x < n; x++) {
+            dst[x] = (Uint8)(((srcrow0[x] * ymult0) + (srcrow1[x] * ymult1)) >>
+                             16);
+        }
+    }
+}
+#endif /* TRANSFORM_SIMD */
+
+static void
+smoothscale_init(struct _module_state *st)
+{
+    if (st->filter_shrink_X) {
+        return;
+    }
+
+#ifdef TRANSFORM_SIMD
+    if (smoothscale_use_simd()) {
+        st->filter_type = SMOOTHSCALE_SIMD_NAME;
+        st->filter_shrink_X = filter_shrink_X_SIMD;
+        st->filter_shrink_Y = filter_shrink_Y_SIMD;
+        st->filter_expand_X = filter_expand_X_SIMD;
+        st->filter_expand_Y = filter_expand_Y_SIMD;
+        return;
+    }
+#endif /* TRANSFORM_SIMD */
+
+#ifdef SCALE_MMX_SUPPORT
+    if (pg_HasSSE()) {
+        st->filter_type = "SSE";
+        st->filter_shrink_X = filter_shrink_X_SSE;
+        st->filter_shrink_Y = filter_shrink_Y_SSE;
+        st->filter_expand_X = filter_expand_X_SSE;
+        st->filter_expand_Y = filter_expand_Y_SSE;
+    }
+    else if (pg_HasMMX()) {
+        st->filter_type = "MMX";
+        st->filter_shrink_X = filter_shrink_X_MMX;
+        st->filter_shrink_Y = filter_shrink_Y_MMX;
+        st->filter_expand_X = filter_expand_X_MMX;
+        st->filter_expand_Y = filter_expand_Y_MMX;
+    }
+    else {
+        st->filter_type = "GENERIC";
+        st->filter_shrink_X = filter_shrink_X_ONLYC;
+        st->filter_shrink_Y = filter_shrink_Y_ONLYC;
+        st->filter_expand_X = filter_expand_X_ONLYC;
+        st->filter_expand_Y = filter_expand_Y_ONLYC;
+    }
+#else  /* ~SCALE_MMX_SUPPORT */
+    st->filter_type = "GENERIC";
+    st->filter_shrink_X = filter_shrink_X_ONLYC;
+    st->filter_shrink_Y = filter_shrink_Y_ONLYC;
+    st->filter_expand_X = filter_expand_X_ONLYC;
+    st->filter_expand_Y = filter_expand_Y_ONLYC;
+#endif /* ~SCALE_MMX_SUPPORT */
+}
+
+static void
+convert_24_32(Uint8 *srcpix, int srcpitch, Uint8 *dstpix, int dstpitch,
+              int width, int height)
+{
+    int srcdiff = srcpitch - (width * 3);
+    int dstdiff = dstpitch - (width * 4);
+    int x, y;
+
+    for (y = 0; y < height; y++) {
+        for (x = 0; x < width; x++) {
+            *dstpix++ = *srcpix++;
+            *dstpix++ = *srcpix++;
+            *dstpix++ = *srcpix++;
+            *dstpix++ = 0xff;
+        }
+        srcpix += srcdiff;
+        dstpix += dstdiff;
+    }
+}
+
+static void
+convert_32_24(Uint8 *srcpix, int srcpitch, Uint8 *dstpix, int dstpitch,
+              int width, int height)
+{
+    int srcdiff = srcpitch - (width * 4);
+    int dstdiff = dstpitch - (width * 3);
+    int x, y;
+
+    for (y = 0; y < height; y++) {
+        for (x = 0; x < width; x++) {
+            *dstpix++ = *srcpix++;
+            *dstpix++ = *srcpix++;
+            *dstpix++ = *srcpix++;
+            srcpix++;
+        }
+        srcpix += srcdiff;
+        dstpix += dstdiff;
+    }
+}
+
+typedef struct {
+    SMOOTHSCALE_FILTER_P filter;
+    Uint8 *srcpix;
+    Uint8 *dstpix;
+    int length; /* rows for an X pass, columns for a Y pass */
+    int srcpitch;
+    int dstpitch;
+    int srcsize;
+    int dstsize;
+    int vertical;
+} SmoothscalePass;
+
+/* Run one band of a smoothscale pass. X passes are split into bands of
+ * rows. Y passes carry state from row to row, so they are split into
+ * bands of columns instead, kept on 16 pixel (64 byte) boundaries so
+ * neighbouring bands do not write to the same cache line.
+ */
+static void
+smoothscale_pass_band(void *data, int band, int nbands)
+{
+    SmoothscalePass *pass = (SmoothscalePass *)data;
+    Uint8 *srcpix = pass->srcpix;
+    Uint8 *dstpix = pass->dstpix;
+    int start = pass->length * band / nbands;
+    int end = pass->length * (band + 1) / nbands;
+
+    if (pass->vertical) {
+        start &= ~15;
+        if (band != nbands - 1) {
+            end &= ~15;
+        }
+        srcpix += start * 4;
+        dstpix += start * 4;
+    }
+    else {
+        srcpix += start * pass->srcpitch;
+        dstpix += start * pass->dstpitch;
+    }
+    if (end <= start) {
+        return;
+    }
+    pass->filter(srcpix, dstpix, end - start, pass->srcpitch, pass->dstpitch,
+                 pass->srcsize, pass->dstsize);
+}
+
+/* Run a smoothscale filter, splitting it over the worker pool when the
+ * pass writes enough pixels to be worth it. Every band runs the same
+ * filter over a slice of the image, so the result does not depend on the
+ * number of threads.
+ */
+static void
+smoothscale_run_pass(SMOOTHSCALE_FILTER_P filter, Uint8 *srcpix,
+                     Uint8 *dstpix, int length, int srcpitch, int dstpitch,
+                     int srcsize, int dstsize, int vertical)
+{
+    SmoothscalePass pass;
+    int nthreads = pg_GetNumThreads();
+    int nbands = vertical ? length / 16 : length;
+
+    if (nthreads < 2 || nbands < 2 ||
+        (long long)length * dstsize < PG_PARALLEL_MIN_PIXELS) {
+        filter(srcpix, dstpix, length, srcpitch, dstpitch, srcsize, dstsize);
+        return;
+    }
+
+    pass.filter = filter;
+    pass.srcpix = srcpix;
+    pass.dstpix = dstpix;
+    pass.length = length;
+    pass.srcpitch = srcpitch;
+    pass.dstpitch = dstpitch;
+    pass.srcsize = srcsize;
+    pass.dstsize = dstsize;
+    pass.vertical = vertical;
+    if (nthreads > nbands) {
+        nthreads = nbands;
+    }
+    pg_ParallelFor(smoothscale_pass_band, &pass, nthreads);
+}
+
+static void
+scalesmooth(SDL_Surface *src, SDL_Surface *dst, struct _module_state *st)
+{
+    Uint8 *srcpix = (Uint8 *)src->pixels;
+    Uint8 *dstpix = (Uint8 *)dst->pixels;
+    Uint8 *dst32 = NULL;
+    int srcpitch = src->pitch;
+    int dstpitch = dst->pitch;
+
+    int srcwidth = src->w;
+    int srcheight = src->h;
+    int dstwidth = dst->w;
+    int dstheight = dst->h;
+
+    int bpp = src->format->BytesPerPixel;
 
     Uint8 *temppix = NULL;
     int tempwidth = 0, temppitch = 0;
 
+    SMOOTHSCALE_FILTER_P shrink_X = st->filter_shrink_X;
+    SMOOTHSCALE_FILTER_P shrink_Y = st->filter_shrink_Y;
+    SMOOTHSCALE_FILTER_P expand_X = st->filter_expand_X;
+    SMOOTHSCALE_FILTER_P expand_Y = st->filter_expand_Y;
+
+    /* pygame.set_simd_backend() may have turned off the backend's
+       instruction set since it was chosen */
+    if ((!strcmp(st->filter_type, "SSE") && !pg_HasSSE()) ||
+        (!strcmp(st->filter_type, "MMX") && !pg_HasMMX())
+#ifdef TRANSFORM_SIMD
+        || (!strcmp(st->filter_type, SMOOTHSCALE_SIMD_NAME) &&
+            !smoothscale_use_simd())
+#endif /* TRANSFORM_SIMD */
+    ) {
+        shrink_X = filter_shrink_X_ONLYC;
+        shrink_Y = filter_shrink_Y_ONLYC;
+        expand_X = filter_expand_X_ONLYC;
+        expand_Y = filter_expand_Y_ONLYC;
+    }
+
     /* convert to 32-bit if necessary */
     if (bpp == 3) {
         int newpitch = srcwidth * 4;
@@ -1419,39 +2840,39 @@ scalesmooth(SDL_Surface *src, SDL_Surface *dst, struct _module_state *st)
     if (dstwidth < srcwidth) /* shrink */
     {
         if (srcheight != dstheight)
-            st->filter_shrink_X(srcpix, temppix, srcheight, srcpitch,
-                                temppitch, srcwidth, dstwidth);
+            smoothscale_run_pass(shrink_X, srcpix, temppix, srcheight,
+                                 srcpitch, temppitch, srcwidth, dstwidth, 0);
         else
-            st->filter_shrink_X(srcpix, dstpix, srcheight, srcpitch, dstpitch,
-                                srcwidth, dstwidth);
+            smoothscale_run_pass(shrink_X, srcpix, dstpix, srcheight, srcpitch,
+                                 dstpitch, srcwidth, dstwidth, 0);
     }
     else if (dstwidth > srcwidth) /* expand */
     {
         if (srcheight != dstheight)
-            st->filter_expand_X(srcpix, temppix, srcheight, srcpitch,
-                                temppitch, srcwidth, dstwidth);
+            smoothscale_run_pass(expand_X, srcpix, temppix, srcheight,
+                                 srcpitch, temppitch, srcwidth, dstwidth, 0);
         else
-            st->filter_expand_X(srcpix, dstpix, srcheight, srcpitch, dstpitch,
-                                srcwidth, dstwidth);
+            smoothscale_run_pass(expand_X, srcpix, dstpix, srcheight, srcpitch,
+                                 dstpitch, srcwidth, dstwidth, 0);
     }
     /* Now do the Y scale */
     if (dstheight < srcheight) /* shrink */
     {
         if (srcwidth != dstwidth)
-            st->filter_shrink_Y(temppix, dstpix, tempwidth, temppitch,
-                                dstpitch, srcheight, dstheight);
+            smoothscale_run_pass(shrink_Y, temppix, dstpix, tempwidth,
+                                 temppitch, dstpitch, srcheight, dstheight, 1);
         else
-            st->filter_shrink_Y(srcpix, dstpix, srcwidth, srcpitch, dstpitch,
-                                srcheight, dstheight);
+            smoothscale_run_pass(shrink_Y, srcpix, dstpix, srcwidth, srcpitch,
+                                 dstpitch, srcheight, dstheight, 1);
     }
     else if (dstheight > srcheight) /* expand */
     {
         if (srcwidth != dstwidth)
-            st->filter_expand_Y(temppix, dstpix, tempwidth, temppitch,
-                                dstpitch, srcheight, dstheight);
+            smoothscale_run_pass(expand_Y, temppix, dstpix, tempwidth,
+                                 temppitch, dstpitch, srcheight, dstheight, 1);
         else
-            st->filter_expand_Y(srcpix, dstpix, srcwidth, srcpitch, dstpitch,
-                                srcheight, dstheight);
+            smoothscale_run_pass(expand_Y, srcpix, dstpix, srcwidth, srcpitch,
+                                 dstpitch, srcheight, dstheight, 1);
     }
 
     /* Convert back to 24-bit if necessary */
@@ -1472,15 +2893,18 @@ static PyObject *
 surf_scalesmooth(PyObject *self, PyObject *args, PyObject *kwargs)
 {
     pgSurfaceObject *surfobj;
-    PyObject *surfobj2 = NULL;
+    PyObject *surfobj2 = NULL, *pool = NULL;
     PyObject *size;
     SDL_Surface *surf, *newsurf;
     int width, height, bpp;
-    static char *keywords[] = {"surface", "size", "dest_surface", NULL};
+    Uint64 start;
+    static char *keywords[] = {"surface", "size", "dest_surface", "pool",
+                               NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|O!", keywords,
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|O!O!", keywords,
                                      &pgSurface_Type, &surfobj, &size,
-                                     &pgSurface_Type, &surfobj2))
+                                     &pgSurface_Type, &surfobj2,
+                                     &pgSurfacePool_Type, &pool))
         return NULL;
 
     if (!pg_TwoIntsFromObj(size, &width, &height))
@@ -1497,7 +2921,7 @@ surf_scalesmooth(PyObject *self, PyObject *args, PyObject *kwargs)
                      "Only 24-bit or 32-bit surfaces can be smoothly scaled");
 
     if (!surfobj2) {
-        newsurf = newsurf_fromsurf(surf, width, height);
+        newsurf = newsurf_fromsurf(surf, width, height, pool);
         if (!newsurf)
             return NULL;
     }
@@ -1512,6 +2936,8 @@ surf_scalesmooth(PyObject *self, PyObject *args, PyObject *kwargs)
         return RAISE(
             PyExc_ValueError,
             "SDL Error: destination surface pitch not 4-byte aligned.");
+    if (!pgSurface_Unshare(newsurf))
+        return NULL;
 
     if (width && height) {
         SDL_LockSurface(newsurf);
@@ -1529,9 +2955,12 @@ surf_scalesmooth(PyObject *self, PyObject *args, PyObject *kwargs)
         }
         else {
             struct _module_state *st = GETSTATE(self);
+            start = pg_StatsBegin();
             Py_BEGIN_ALLOW_THREADS;
             scalesmooth(surf, newsurf, st);
             Py_END_ALLOW_THREADS;
+            pg_StatsEnd(PG_STAT_TRANSFORM, "smoothscale", start,
+                        (Sint64)width * height);
         }
 
         pgSurface_Unlock(surfobj);
@@ -1606,6 +3035,21 @@ surf_set_smoothscale_backend(PyObject *self, PyObject *args, PyObject *kwargs)
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s", keywords, &type))
         return NULL;
 
+#ifdef TRANSFORM_SIMD
+    if (strcmp(type, SMOOTHSCALE_SIMD_NAME) == 0) {
+        if (!smoothscale_use_simd()) {
+            return PyErr_Format(PyExc_ValueError,
+                                "%s not supported on this machine", type);
+        }
+        st->filter_type = SMOOTHSCALE_SIMD_NAME;
+        st->filter_shrink_X = filter_shrink_X_SIMD;
+        st->filter_shrink_Y = filter_shrink_Y_SIMD;
+        st->filter_expand_X = filter_expand_X_SIMD;
+        st->filter_expand_Y = filter_expand_Y_SIMD;
+        Py_RETURN_NONE;
+    }
+#endif /* TRANSFORM_SIMD */
+
 #if defined(SCALE_MMX_SUPPORT)
     if (strcmp(type, "GENERIC") == 0) {
         st->filter_type = "GENERIC";
@@ -1615,7 +3059,7 @@ surf_set_smoothscale_backend(PyObject *self, PyObject *args, PyObject *kwargs)
         st->filter_expand_Y = filter_expand_Y_ONLYC;
     }
     else if (strcmp(type, "MMX") == 0) {
-        if (!SDL_HasMMX()) {
+        if (!pg_HasMMX()) {
             return RAISE(PyExc_ValueError,
                          "MMX not supported on this machine");
         }
@@ -1626,7 +3070,7 @@ surf_set_smoothscale_backend(PyObject *self, PyObject *args, PyObject *kwargs)
         st->filter_expand_Y = filter_expand_Y_MMX;
     }
     else if (strcmp(type, "SSE") == 0) {
-        if (!SDL_HasSSE()) {
+        if (!pg_HasSSE()) {
             return RAISE(PyExc_ValueError,
                          "SSE not supported on this machine");
         }
@@ -1642,42 +3086,552 @@ surf_set_smoothscale_backend(PyObject *self, PyObject *args, PyObject *kwargs)
     Py_RETURN_NONE;
 #else  /* Not an x86 processor */
     if (strcmp(type, "GENERIC") != 0) {
-        if (strcmp(st->filter_type, "MMX") == 0 ||
-            strcmp(st->filter_type, "SSE") == 0) {
+        if (strcmp(type, "MMX") == 0 || strcmp(type, "SSE") == 0 ||
+            strcmp(type, "SSE2") == 0 || strcmp(type, "NEON") == 0) {
             return PyErr_Format(PyExc_ValueError,
                                 "%s not supported on this machine", type);
         }
         return PyErr_Format(PyExc_ValueError, "Unknown backend type %s", type);
     }
+    st->filter_type = "GENERIC";
+    st->filter_shrink_X = filter_shrink_X_ONLYC;
+    st->filter_shrink_Y = filter_shrink_Y_ONLYC;
+    st->filter_expand_X = filter_expand_X_ONLYC;
+    st->filter_expand_Y = filter_expand_Y_ONLYC;
     Py_RETURN_NONE;
 #endif /* defined(SCALE_MMX_SUPPORT) */
 }
 
-/* _get_color_move_pixels is for iterating over pixels in a Surface.
-
-    bpp - bytes per pixel
-    the_color - is set for that pixel
-    pixels - pointer is advanced by one pixel.
+/*
+ * resample functions: separable convolution with a choice of filter.
  */
-static PG_INLINE Uint8 *
-_get_color_move_pixels(Uint8 bpp, Uint8 *pixels, Uint32 *the_color)
-{
-    Uint8 *pix;
-    // printf("bpp:%i, pixels:%p\n", bpp, pixels);
 
-    switch (bpp) {
-        case 1:
-            *the_color = (Uint32) * ((Uint8 *)pixels);
-            return pixels + 1;
-        case 2:
-            *the_color = (Uint32) * ((Uint16 *)pixels);
-            return pixels + 2;
-        case 3:
-            pix = ((Uint8 *)pixels);
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-            *the_color = (pix[0]) + (pix[1] << 8) + (pix[2] << 16);
-#else
-            *the_color = (pix[2]) + (pix[1] << 8) + (pix[0] << 16);
+#define RESAMPLE_BILINEAR 0
+#define RESAMPLE_BICUBIC 1
+#define RESAMPLE_LANCZOS 2
+
+/* Weights are stored as fixed point with this many fractional bits */
+#define RESAMPLE_PRECISION_BITS 14
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static double
+resample_bilinear_filter(double x)
+{
+    if (x < 0.0)
+        x = -x;
+    if (x < 1.0)
+        return 1.0 - x;
+    return 0.0;
+}
+
+static double
+resample_bicubic_filter(double x)
+{
+    /* Keys' cubic convolution with a = -0.5, as used by most imaging
+     * libraries */
+    const double a = -0.5;
+
+    if (x < 0.0)
+        x = -x;
+    if (x < 1.0)
+        return ((a + 2.0) * x - (a + 3.0)) * x * x + 1.0;
+    if (x < 2.0)
+        return (((x - 5.0) * x + 8.0) * x - 4.0) * a;
+    return 0.0;
+}
+
+static double
+resample_sinc(double x)
+{
+    if (x == 0.0)
+        return 1.0;
+    x *= M_PI;
+    return sin(x) / x;
+}
+
+static double
+resample_lanczos_filter(double x)
+{
+    /* Three lobed Lanczos window */
+    if (-3.0 <= x && x < 3.0)
+        return resample_sinc(x) * resample_sinc(x / 3.0);
+    return 0.0;
+}
+
+static const struct {
+    double (*func)(double);
+    double support;
+} resample_filters[] = {
+    {resample_bilinear_filter, 1.0},
+    {resample_bicubic_filter, 2.0},
+    {resample_lanczos_filter, 3.0},
+};
+
+static void
+resample_table_free(ResampleTable *table)
+{
+    free(table->bounds);
+    free(table->weights);
+    free(table);
+}
+
+/* Build the weights for scaling one axis from srcsize to dstsize pixels.
+ * When shrinking, the filter is stretched to cover every source pixel
+ * that lands in a destination pixel. Each pixel's weights add up to
+ * exactly 1 << RESAMPLE_PRECISION_BITS so flat areas stay flat.
+ */
+static ResampleTable *
+resample_table_new(int filter, int srcsize, int dstsize)
+{
+    double (*func)(double) = resample_filters[filter].func;
+    double scale = (double)srcsize / dstsize;
+    double filterscale = scale < 1.0 ? 1.0 : scale;
+    double support = resample_filters[filter].support * filterscale;
+    int ksize = (int)ceil(support) * 2 + 1;
+    ResampleTable *table;
+    double *k;
+    int x, i;
+
+    table = (ResampleTable *)calloc(1, sizeof(ResampleTable));
+    if (!table)
+        return NULL;
+    table->bounds = (int *)malloc(sizeof(int) * 2 * dstsize);
+    table->weights = (int *)malloc(sizeof(int) * (size_t)ksize * dstsize);
+    k = (double *)malloc(sizeof(double) * ksize);
+    if (!table->bounds || !table->weights || !k) {
+        free(k);
+        resample_table_free(table);
+        return NULL;
+    }
+    table->filter = filter;
+    table->srcsize = srcsize;
+    table->dstsize = dstsize;
+    table->ksize = ksize;
+
+    for (x = 0; x < dstsize; x++) {
+        double center = (x + 0.5) * scale;
+        double total = 0.0;
+        int *weights = table->weights + x * ksize;
+        int xmin = (int)(center - support + 0.5);
+        int xmax = (int)(center + support + 0.5);
+        int count, sum = 0, largest = 0;
+
+        if (xmin < 0)
+            xmin = 0;
+        if (xmax > srcsize)
+            xmax = srcsize;
+        count = xmax - xmin;
+
+        for (i = 0; i < count; i++) {
+            k[i] = func((i + xmin - center + 0.5) / filterscale);
+            total += k[i];
+        }
+        if (total == 0.0)
+            total = 1.0;
+        for (i = 0; i < count; i++) {
+            weights[i] = (int)floor(k[i] / total *
+                                        (1 << RESAMPLE_PRECISION_BITS) +
+                                    0.5);
+            sum += weights[i];
+            if (weights[i] > weights[largest])
+                largest = i;
+        }
+        /* put the rounding error on the largest tap */
+        if (count)
+            weights[largest] += (1 << RESAMPLE_PRECISION_BITS) - sum;
+        for (; i < ksize; i++) {
+            weights[i] = 0;
+        }
+        table->bounds[x * 2] = xmin;
+        table->bounds[x * 2 + 1] = count;
+    }
+
+    free(k);
+    return table;
+}
+
+static void
+resample_table_evict(ResampleTable *table)
+{
+    if (table) {
+        table->cached = 0;
+        if (!table->users)
+            resample_table_free(table);
+    }
+}
+
+/* Get a weight table from the module cache, building it on a miss.
+ * Tables are looked up and released with the GIL held. A table evicted
+ * while another call is still using it is freed by the last user.
+ */
+static ResampleTable *
+resample_table_get(struct _module_state *st, int filter, int srcsize,
+                   int dstsize)
+{
+    ResampleTable **cache = st->resample_cache;
+    ResampleTable *table;
+    int i;
+
+    for (i = 0; i < RESAMPLE_CACHE_SIZE && cache[i]; i++) {
+        table = cache[i];
+        if (table->filter == filter && table->srcsize == srcsize &&
+            table->dstsize == dstsize) {
+            memmove(cache + 1, cache, i * sizeof(ResampleTable *));
+            cache[0] = table;
+            table->users++;
+            return table;
+        }
+    }
+
+    table = resample_table_new(filter, srcsize, dstsize);
+    if (!table) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    resample_table_evict(cache[RESAMPLE_CACHE_SIZE - 1]);
+    memmove(cache + 1, cache,
+            (RESAMPLE_CACHE_SIZE - 1) * sizeof(ResampleTable *));
+    cache[0] = table;
+    table->cached = 1;
+    table->users = 1;
+    return table;
+}
+
+static void
+resample_table_release(ResampleTable *table)
+{
+    if (table && !--table->users && !table->cached)
+        resample_table_free(table);
+}
+
+static PG_INLINE Uint8
+resample_clip(int value)
+{
+    value >>= RESAMPLE_PRECISION_BITS;
+    if (value < 0)
+        return 0;
+    if (value > 255)
+        return 255;
+    return (Uint8)value;
+}
+
+typedef struct {
+    ResampleTable *table;
+    Uint8 *srcpix;
+    Uint8 *dstpix;
+    int srcpitch;
+    int dstpitch;
+    int height;   /* destination rows */
+    int rowbytes; /* destination bytes per row */
+    int bpp;
+    int *accumulate; /* rowbytes ints per band for the vertical pass */
+} ResamplePass;
+
+/* Horizontal pass over destination rows [start, end) */
+static void
+resample_horizontal(ResamplePass *pass, int start, int end)
+{
+    ResampleTable *table = pass->table;
+    int bpp = pass->bpp;
+    int x, y, i, c;
+
+    for (y = start; y < end; y++) {
+        Uint8 *srcrow = pass->srcpix + y * pass->srcpitch;
+        Uint8 *dstpos = pass->dstpix + y * pass->dstpitch;
+
+        for (x = 0; x < table->dstsize; x++) {
+            Uint8 *src = srcrow + table->bounds[x * 2] * bpp;
+            int count = table->bounds[x * 2 + 1];
+            int *weights = table->weights + x * table->ksize;
+            int acc[4];
+
+            for (c = 0; c < bpp; c++) {
+                acc[c] = 1 << (RESAMPLE_PRECISION_BITS - 1);
+            }
+            for (i = 0; i < count; i++) {
+                for (c = 0; c < bpp; c++) {
+                    acc[c] += src[c] * weights[i];
+                }
+                src += bpp;
+            }
+            for (c = 0; c < bpp; c++) {
+                *dstpos++ = resample_clip(acc[c]);
+            }
+        }
+    }
+}
+
+/* Vertical pass over destination rows [start, end). Each source row is
+ * folded into a row of accumulators in turn, which keeps the inner loop
+ * a straight multiply-add over contiguous bytes that compilers
+ * vectorise.
+ */
+static void
+resample_vertical(ResamplePass *pass, int start, int end, int *accumulate)
+{
+    ResampleTable *table = pass->table;
+    int rowbytes = pass->rowbytes;
+    int x, y, i;
+
+    for (y = start; y < end; y++) {
+        Uint8 *src = pass->srcpix + table->bounds[y * 2] * pass->srcpitch;
+        Uint8 *dstpos = pass->dstpix + y * pass->dstpitch;
+        int count = table->bounds[y * 2 + 1];
+        int *weights = table->weights + y * table->ksize;
+
+        for (x = 0; x < rowbytes; x++) {
+            accumulate[x] = 1 << (RESAMPLE_PRECISION_BITS - 1);
+        }
+        for (i = 0; i < count; i++) {
+            int weight = weights[i];
+
+            for (x = 0; x < rowbytes; x++) {
+                accumulate[x] += src[x] * weight;
+            }
+            src += pass->srcpitch;
+        }
+        for (x = 0; x < rowbytes; x++) {
+            dstpos[x] = resample_clip(accumulate[x]);
+        }
+    }
+}
+
+static void
+resample_pass_band(void *data, int band, int nbands)
+{
+    ResamplePass *pass = (ResamplePass *)data;
+    int start = pass->height * band / nbands;
+    int end = pass->height * (band + 1) / nbands;
+
+    if (pass->accumulate)
+        resample_vertical(pass, start, end,
+                          pass->accumulate + band * pass->rowbytes);
+    else
+        resample_horizontal(pass, start, end);
+}
+
+/* Run one resample pass, in row bands over the worker pool when it is
+ * large enough. Returns -1 if the accumulator rows can't be allocated.
+ */
+static int
+resample_run_pass(ResampleTable *table, Uint8 *srcpix, Uint8 *dstpix,
+                  int srcpitch, int dstpitch, int width, int height, int bpp,
+                  int vertical)
+{
+    ResamplePass pass;
+    int nbands = pg_GetNumThreads();
+
+    if (nbands < 2 ||
+        (long long)width * height < PG_PARALLEL_MIN_PIXELS) {
+        nbands = 1;
+    }
+    if (nbands > height) {
+        nbands = height;
+    }
+
+    pass.table = table;
+    pass.srcpix = srcpix;
+    pass.dstpix = dstpix;
+    pass.srcpitch = srcpitch;
+    pass.dstpitch = dstpitch;
+    pass.height = height;
+    pass.rowbytes = width * bpp;
+    pass.bpp = bpp;
+    pass.accumulate = NULL;
+    if (vertical) {
+        pass.accumulate =
+            (int *)malloc(sizeof(int) * (size_t)pass.rowbytes * nbands);
+        if (!pass.accumulate)
+            return -1;
+    }
+
+    if (nbands > 1)
+        pg_ParallelFor(resample_pass_band, &pass, nbands);
+    else
+        resample_pass_band(&pass, 0, 1);
+
+    free(pass.accumulate);
+    return 0;
+}
+
+/* Scale src into dst with the given axis tables. Either table may be NULL
+ * when that axis keeps its size. Returns -1 on a memory error.
+ */
+static int
+resample(SDL_Surface *src, SDL_Surface *dst, ResampleTable *xtable,
+         ResampleTable *ytable)
+{
+    Uint8 *temppix;
+    int bpp = src->format->BytesPerPixel;
+    int temppitch = dst->w * bpp;
+    int result;
+
+    if (!ytable)
+        return resample_run_pass(xtable, (Uint8 *)src->pixels,
+                                 (Uint8 *)dst->pixels, src->pitch,
+                                 dst->pitch, dst->w, dst->h, bpp, 0);
+    if (!xtable)
+        return resample_run_pass(ytable, (Uint8 *)src->pixels,
+                                 (Uint8 *)dst->pixels, src->pitch,
+                                 dst->pitch, dst->w, dst->h, bpp, 1);
+
+    temppix = (Uint8 *)malloc((size_t)temppitch * src->h);
+    if (!temppix)
+        return -1;
+    result = resample_run_pass(xtable, (Uint8 *)src->pixels, temppix,
+                               src->pitch, temppitch, dst->w, src->h, bpp, 0);
+    if (!result)
+        result = resample_run_pass(ytable, temppix, (Uint8 *)dst->pixels,
+                                   temppitch, dst->pitch, dst->w, dst->h,
+                                   bpp, 1);
+    free(temppix);
+    return result;
+}
+
+static PyObject *
+surf_resample(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *surfobj2 = NULL;
+    PyObject *size;
+    SDL_Surface *surf, *newsurf;
+    const char *filtername = "bicubic";
+    ResampleTable *xtable = NULL, *ytable = NULL;
+    struct _module_state *st = GETSTATE(self);
+    int width, height, bpp, filter, result = 0;
+    static char *keywords[] = {"surface", "size", "filter", "dest_surface",
+                               NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|sO!", keywords,
+                                     &pgSurface_Type, &surfobj, &size,
+                                     &filtername, &pgSurface_Type,
+                                     &surfobj2))
+        return NULL;
+
+    if (!pg_TwoIntsFromObj(size, &width, &height))
+        return RAISE(PyExc_TypeError, "size must be two numbers");
+
+    if (width < 0 || height < 0)
+        return RAISE(PyExc_ValueError, "Cannot scale to negative size");
+
+    if (strcmp(filtername, "bilinear") == 0)
+        filter = RESAMPLE_BILINEAR;
+    else if (strcmp(filtername, "bicubic") == 0)
+        filter = RESAMPLE_BICUBIC;
+    else if (strcmp(filtername, "lanczos") == 0)
+        filter = RESAMPLE_LANCZOS;
+    else
+        return PyErr_Format(PyExc_ValueError, "Unknown resample filter %s",
+                            filtername);
+
+    surf = pgSurface_AsSurface(surfobj);
+
+    bpp = surf->format->BytesPerPixel;
+    if (bpp < 3 || bpp > 4)
+        return RAISE(PyExc_ValueError,
+                     "Only 24-bit or 32-bit surfaces can be resampled");
+
+    if (surfobj2) {
+        newsurf = pgSurface_AsSurface(surfobj2);
+        if (newsurf->w != width || newsurf->h != height)
+            return RAISE(PyExc_ValueError,
+                         "Destination surface not the given width or height.");
+        if (newsurf->format->BytesPerPixel != bpp)
+            return RAISE(
+                PyExc_ValueError,
+                "Source and destination surfaces need the same format.");
+        if (!pgSurface_Unshare(newsurf))
+            return NULL;
+    }
+
+    if (width && height && surf->w != width) {
+        xtable = resample_table_get(st, filter, surf->w, width);
+        if (!xtable)
+            return NULL;
+    }
+    if (width && height && surf->h != height) {
+        ytable = resample_table_get(st, filter, surf->h, height);
+        if (!ytable) {
+            resample_table_release(xtable);
+            return NULL;
+        }
+    }
+
+    if (!surfobj2) {
+        newsurf = newsurf_fromsurf(surf, width, height, NULL);
+        if (!newsurf) {
+            resample_table_release(xtable);
+            resample_table_release(ytable);
+            return NULL;
+        }
+    }
+
+    if (width && height) {
+        SDL_LockSurface(newsurf);
+        pgSurface_Lock(surfobj);
+
+        Py_BEGIN_ALLOW_THREADS;
+        if (xtable || ytable) {
+            result = resample(surf, newsurf, xtable, ytable);
+        }
+        else {
+            int y;
+            for (y = 0; y < height; y++) {
+                memcpy((Uint8 *)newsurf->pixels + y * newsurf->pitch,
+                       (Uint8 *)surf->pixels + y * surf->pitch, width * bpp);
+            }
+        }
+        Py_END_ALLOW_THREADS;
+
+        pgSurface_Unlock(surfobj);
+        SDL_UnlockSurface(newsurf);
+    }
+
+    resample_table_release(xtable);
+    resample_table_release(ytable);
+
+    if (result) {
+        if (!surfobj2)
+            SDL_FreeSurface(newsurf);
+        return PyErr_NoMemory();
+    }
+
+    if (surfobj2) {
+        Py_INCREF(surfobj2);
+        return surfobj2;
+    }
+    else
+        return (PyObject *)pgSurface_New(newsurf);
+}
+
+/* _get_color_move_pixels is for iterating over pixels in a Surface.
+
+    bpp - bytes per pixel
+    the_color - is set for that pixel
+    pixels - pointer is advanced by one pixel.
+ */
+static PG_INLINE Uint8 *
+_get_color_move_pixels(Uint8 bpp, Uint8 *pixels, Uint32 *the_color)
+{
+    Uint8 *pix;
+    // printf("bpp:%i, pixels:%p\n", bpp, pixels);
+
+    switch (bpp) {
+        case 1:
+            *the_color = (Uint32) * ((Uint8 *)pixels);
+            return pixels + 1;
+        case 2:
+            *the_color = (Uint32) * ((Uint16 *)pixels);
+            return pixels + 2;
+        case 3:
+            pix = ((Uint8 *)pixels);
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            *the_color = (pix[0]) + (pix[1] << 8) + (pix[2] << 16);
+#else
+            *the_color = (pix[2]) + (pix[1] << 8) + (pix[0] << 16);
 #endif
             return pixels + 3;
         default: /* case 4: */
@@ -1726,12 +3680,135 @@ _set_at_pixels(int x, int y, Uint8 *pixels, SDL_PixelFormat *format,
     }
 }
 
+/* Whether the 32 bit reduction kernels can use SSE2 or NEON */
 static int
-get_threshold(SDL_Surface *dest_surf, SDL_Surface *surf,
-              Uint32 color_search_color, Uint32 color_threshold,
-              Uint32 color_set_color, int set_behavior,
-              SDL_Surface *search_surf, int inverse_set)
+_use_simd(void)
+{
+#if defined(TRANSFORM_SIMD) && defined(PG_ENABLE_ARM_NEON)
+    return pg_HasNEON();
+#elif defined(TRANSFORM_SIMD)
+    return pg_HasSSE2();
+#else
+    return 0;
+#endif
+}
+
+/* Whether a 32 bit format keeps R, G and B in whole bytes, so SDL_GetRGB
+ * of a pixel is just its bytes. */
+static int
+_rgb_in_bytes32(SDL_PixelFormat *format)
+{
+    return format->BytesPerPixel == 4 && format->Rloss == 0 &&
+           format->Gloss == 0 && format->Bloss == 0 &&
+           format->Rshift % 8 == 0 && format->Gshift % 8 == 0 &&
+           format->Bshift % 8 == 0;
+}
+
+/* Whether writing dst while reading src, pixel by pixel, could read a
+ * pixel already written for another position. */
+static int
+_surfaces_alias(SDL_Surface *src, SDL_Surface *dst)
+{
+    if (src->pixels == dst->pixels && src->pitch == dst->pitch &&
+        src->format->BytesPerPixel == dst->format->BytesPerPixel)
+        return 0;
+    return _surfaces_overlap(src, dst);
+}
+
+/* Most bands a reduction is split into; pg_ParallelFor never runs more
+ * threads than this. */
+#define REDUCE_MAX_BANDS 64
+
+typedef struct {
+    SDL_Surface *dest_surf;
+    SDL_Surface *surf;
+    SDL_Surface *search_surf;
+    Uint32 color_search_color;
+    Uint32 color_threshold;
+    Uint32 color_set_color;
+    int set_behavior;
+    int inverse_set;
+    int simd;
+    int similar[REDUCE_MAX_BANDS];
+} ThresholdPass;
+
+#ifdef TRANSFORM_SIMD
+/* Threshold rows ystart to yend - 1 of a 32 bit surface that keeps R, G
+ * and B in whole bytes, four pixels at a time. The search surface, if any,
+ * has the same channel layout. Pixels past the last group of four are left
+ * to the caller.
+ */
+static int
+threshold_rows32_sse2(ThresholdPass *pass, int ystart, int yend)
+{
+    SDL_Surface *surf = pass->surf, *search_surf = pass->search_surf;
+    SDL_Surface *dest_surf = pass->dest_surf;
+    SDL_PixelFormat *format = surf->format;
+    Uint8 threshold_r, threshold_g, threshold_b;
+    Uint32 threshold;
+    __m128i vthreshold, vsearch, zero = _mm_setzero_si128();
+    __m128i ones = _mm_cmpeq_epi32(zero, zero);
+    int x, y, i, bits, change, similar = 0;
+
+    SDL_GetRGB(pass->color_threshold, format, &threshold_r, &threshold_g,
+               &threshold_b);
+    /* the byte that is not R, G or B always matches */
+    threshold = ((Uint32)threshold_r << format->Rshift) |
+                ((Uint32)threshold_g << format->Gshift) |
+                ((Uint32)threshold_b << format->Bshift) |
+                ~(format->Rmask | format->Gmask | format->Bmask);
+    vthreshold = _mm_set1_epi32((int)threshold);
+    vsearch = _mm_set1_epi32((int)pass->color_search_color);
+
+    for (y = ystart; y < yend; y++) {
+        Uint32 *row = (Uint32 *)((Uint8 *)surf->pixels + y * surf->pitch);
+        Uint32 *row2 = NULL;
+
+        if (search_surf)
+            row2 = (Uint32 *)((Uint8 *)search_surf->pixels +
+                              y * search_surf->pitch);
+        for (x = 0; x + 4 <= surf->w; x += 4) {
+            __m128i pixels = _mm_loadu_si128((const __m128i *)(row + x));
+            __m128i search =
+                row2 ? _mm_loadu_si128((const __m128i *)(row2 + x)) : vsearch;
+            __m128i diff = _mm_or_si128(_mm_subs_epu8(pixels, search),
+                                        _mm_subs_epu8(search, pixels));
+            __m128i within =
+                _mm_cmpeq_epi8(_mm_subs_epu8(diff, vthreshold), zero);
+
+            bits = _mm_movemask_ps(
+                _mm_castsi128_ps(_mm_cmpeq_epi32(within, ones)));
+            similar += (bits & 1) + ((bits >> 1) & 1) + ((bits >> 2) & 1) +
+                       ((bits >> 3) & 1);
+            if (!pass->set_behavior)
+                continue;
+            change = pass->inverse_set ? bits : ~bits & 0xf;
+            for (i = 0; change; i++, change >>= 1) {
+                if (change & 1) {
+                    Uint32 color = pass->color_set_color;
+
+                    if (pass->set_behavior == 2)
+                        color = row2 ? row2[x + i] : row[x + i];
+                    _set_at_pixels(x + i, y, (Uint8 *)dest_surf->pixels,
+                                   dest_surf->format, dest_surf->pitch,
+                                   color);
+                }
+            }
+        }
+    }
+    return similar;
+}
+#endif /* TRANSFORM_SIMD */
+
+/* Threshold columns xstart to the surface width of rows ystart to
+ * yend - 1, one pixel at a time through SDL_GetRGB. */
+static int
+threshold_rows(ThresholdPass *pass, int xstart, int ystart, int yend)
 {
+    SDL_Surface *dest_surf = pass->dest_surf, *surf = pass->surf;
+    SDL_Surface *search_surf = pass->search_surf;
+    Uint32 color_set_color = pass->color_set_color;
+    int set_behavior = pass->set_behavior, inverse_set = pass->inverse_set;
     int x, y, similar;
     Uint8 *pixels, *destpixels = NULL, *pixels2 = NULL;
     SDL_PixelFormat *format;
@@ -1749,21 +3826,20 @@ get_threshold(SDL_Surface *dest_surf, SDL_Surface *surf,
     if (set_behavior) {
         destpixels = (Uint8 *)dest_surf->pixels;
     }
-    if (search_surf) {
-        pixels2 = (Uint8 *)search_surf->pixels;
-    }
 
-    SDL_GetRGB(color_search_color, format, &search_color_r, &search_color_g,
-               &search_color_b);
-    SDL_GetRGB(color_threshold, format, &threshold_r, &threshold_g,
+    SDL_GetRGB(pass->color_search_color, format, &search_color_r,
+               &search_color_g, &search_color_b);
+    SDL_GetRGB(pass->color_threshold, format, &threshold_r, &threshold_g,
                &threshold_b);
 
-    for (y = 0; y < surf->h; y++) {
-        pixels = (Uint8 *)surf->pixels + y * surf->pitch;
+    for (y = ystart; y < yend; y++) {
+        pixels = (Uint8 *)surf->pixels + y * surf->pitch +
+                 xstart * format->BytesPerPixel;
         if (search_surf)
-            pixels2 = (Uint8 *)search_surf->pixels + y * search_surf->pitch;
+            pixels2 = (Uint8 *)search_surf->pixels + y * search_surf->pitch +
+                      xstart * search_surf->format->BytesPerPixel;
 
-        for (x = 0; x < surf->w; x++) {
+        for (x = xstart; x < surf->w; x++) {
             pixels = _get_color_move_pixels(surf->format->BytesPerPixel,
                                             pixels, &the_color);
             SDL_GetRGB(the_color, surf->format, &surf_r, &surf_g, &surf_b);
@@ -1807,19 +3883,86 @@ get_threshold(SDL_Surface *dest_surf, SDL_Surface *surf,
     return similar;
 }
 
-/* _color_from_obj gets a color from a python object.
-
-Returns 0 if ok, and sets color to the color.
-   -1 means error.
-   If color_obj is NULL, use rgba_default.
-   If rgba_default is NULL, do not use a default color, return -1.
-*/
-int
-_color_from_obj(PyObject *color_obj, SDL_PixelFormat *format,
-                Uint8 rgba_default[4], Uint32 *color)
+static void
+threshold_band(void *data, int band, int nbands)
 {
-    if (color_obj) {
-        Uint8 rgba_color[4];
+    ThresholdPass *pass = (ThresholdPass *)data;
+    int height = pass->surf->h;
+    int ystart = (int)((long long)height * band / nbands);
+    int yend = (int)((long long)height * (band + 1) / nbands);
+    int xstart = 0, similar = 0;
+
+#ifdef TRANSFORM_SIMD
+    if (pass->simd) {
+        similar = threshold_rows32_sse2(pass, ystart, yend);
+        xstart = pass->surf->w & ~3;
+    }
+#endif /* TRANSFORM_SIMD */
+    pass->similar[band] = similar + threshold_rows(pass, xstart, ystart, yend);
+}
+
+/* Count the pixels of surf within threshold, setting dest_surf pixels as
+ * set_behavior says. Large surfaces are split into bands of rows over the
+ * worker pool, unless dest_surf partly overlaps a surface being read,
+ * where the order pixels are written in matters.
+ */
+static int
+get_threshold(SDL_Surface *dest_surf, SDL_Surface *surf,
+              Uint32 color_search_color, Uint32 color_threshold,
+              Uint32 color_set_color, int set_behavior,
+              SDL_Surface *search_surf, int inverse_set)
+{
+    ThresholdPass pass;
+    int band, nbands, similar = 0;
+    int aliased = set_behavior &&
+                  (_surfaces_alias(surf, dest_surf) ||
+                   (search_surf && _surfaces_alias(search_surf, dest_surf)));
+
+    pass.dest_surf = dest_surf;
+    pass.surf = surf;
+    pass.search_surf = search_surf;
+    pass.color_search_color = color_search_color;
+    pass.color_threshold = color_threshold;
+    pass.color_set_color = color_set_color;
+    pass.set_behavior = set_behavior;
+    pass.inverse_set = inverse_set;
+    pass.simd =
+        !aliased && _use_simd() && _rgb_in_bytes32(surf->format) &&
+        (!search_surf || (search_surf->format->BytesPerPixel == 4 &&
+                          search_surf->format->Rmask == surf->format->Rmask &&
+                          search_surf->format->Gmask == surf->format->Gmask &&
+                          search_surf->format->Bmask == surf->format->Bmask));
+
+    nbands = MIN(pg_GetNumThreads(), REDUCE_MAX_BANDS);
+    if (nbands > surf->h) {
+        nbands = surf->h;
+    }
+    if (aliased || nbands < 2 ||
+        (long long)surf->w * surf->h < PG_PARALLEL_MIN_PIXELS) {
+        threshold_band(&pass, 0, 1);
+        return pass.similar[0];
+    }
+
+    pg_ParallelFor(threshold_band, &pass, nbands);
+    for (band = 0; band < nbands; band++) {
+        similar += pass.similar[band];
+    }
+    return similar;
+}
+
+/* _color_from_obj gets a color from a python object.
+
+Returns 0 if ok, and sets color to the color.
+   -1 means error.
+   If color_obj is NULL, use rgba_default.
+   If rgba_default is NULL, do not use a default color, return -1.
+*/
+int
+_color_from_obj(PyObject *color_obj, SDL_PixelFormat *format,
+                Uint8 rgba_default[4], Uint32 *color)
+{
+    if (color_obj) {
+        Uint8 rgba_color[4];
 
         if (PyLong_Check(color_obj))
             *color = (Uint32)PyLong_AsLong(color_obj);
@@ -1982,6 +4125,8 @@ surf_threshold(PyObject *self, PyObject *args, PyObject *kwds)
                      "surf and search_surf not the same size");
     }
 
+    if (dest_surf && !pgSurface_Unshare(dest_surf))
+        return NULL;
     if (dest_surf)
         pgSurface_Lock((pgSurfaceObject *)dest_surf_obj);
     pgSurface_Lock(surf_obj);
@@ -2154,6 +4299,9 @@ laplacian(SDL_Surface *surf, SDL_Surface *destsurf)
                     SURF_GET_AT(sample[0], surf, x + -1, y + -1, pixels,
                                 format, pix);
                 }
+                else {
+                    sample[0] = LAPLACIAN_NUM;
+                }
 
                 SURF_GET_AT(sample[1], surf, x + 0, y + -1, pixels, format,
                             pix);
@@ -2162,6 +4310,9 @@ laplacian(SDL_Surface *surf, SDL_Surface *destsurf)
                     SURF_GET_AT(sample[2], surf, x + 1, y + -1, pixels, format,
                                 pix);
                 }
+                else {
+                    sample[2] = LAPLACIAN_NUM;
+                }
             }
             else {
                 sample[0] = LAPLACIAN_NUM;
@@ -2193,6 +4344,9 @@ laplacian(SDL_Surface *surf, SDL_Surface *destsurf)
                     SURF_GET_AT(sample[6], surf, x + -1, y + 1, pixels, format,
                                 pix);
                 }
+                else {
+                    sample[6] = LAPLACIAN_NUM;
+                }
 
                 SURF_GET_AT(sample[7], surf, x + 0, y + 1, pixels, format,
                             pix);
@@ -2201,6 +4355,9 @@ laplacian(SDL_Surface *surf, SDL_Surface *destsurf)
                     SURF_GET_AT(sample[8], surf, x + 1, y + 1, pixels, format,
                                 pix);
                 }
+                else {
+                    sample[8] = LAPLACIAN_NUM;
+                }
             }
             else {
                 sample[6] = LAPLACIAN_NUM;
@@ -2290,12 +4447,140 @@ laplacian(SDL_Surface *surf, SDL_Surface *destsurf)
     }
 }
 
+/* Whether laplacian32() can filter surf into destsurf: every channel of
+ * surf is a whole byte, so the kernel can run on the bytes of a pixel. */
+static int
+laplacian_in_bytes32(SDL_Surface *surf, SDL_Surface *destsurf)
+{
+    SDL_PixelFormat *format = surf->format;
+
+    return _rgb_in_bytes32(format) && destsurf->format->BytesPerPixel == 4 &&
+           (!format->Amask ||
+            (format->Aloss == 0 && format->Ashift % 8 == 0));
+}
+
+/* One row of laplacian32(). above, row and below hold the source rows with
+ * a padding pixel on either side, so pixel x and its neighbours are at
+ * x, x + 1 and x + 2. Bytes outside keep, the unused byte of a format
+ * without alpha, are cleared like SDL_MapRGBA does.
+ */
+static void
+laplacian_row32(const Uint32 *above, const Uint32 *row, const Uint32 *below,
+                Uint32 *dst, int width, Uint32 keep)
+{
+    int x = 0;
+
+#ifdef TRANSFORM_SIMD
+    if (_use_simd()) {
+        __m128i zero = _mm_setzero_si128();
+        __m128i vkeep = _mm_set1_epi32((int)keep);
+
+        for (; x + 4 <= width; x += 4) {
+            const Uint32 *rows[3] = {above + x, row + x, below + x};
+            __m128i lo = zero, hi = zero, p;
+            int i, j;
+
+            /* the 8 neighbours of 4 pixels, each byte widened to 16 bits */
+            for (i = 0; i < 3; i++) {
+                for (j = 0; j < 3; j++) {
+                    if (i == 1 && j == 1)
+                        continue;
+                    p = _mm_loadu_si128((const __m128i *)(rows[i] + j));
+                    lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(p, zero));
+                    hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(p, zero));
+                }
+            }
+            p = _mm_loadu_si128((const __m128i *)(row + x + 1));
+            lo = _mm_sub_epi16(
+                _mm_slli_epi16(_mm_unpacklo_epi8(p, zero), 3), lo);
+            hi = _mm_sub_epi16(
+                _mm_slli_epi16(_mm_unpackhi_epi8(p, zero), 3), hi);
+            _mm_storeu_si128((__m128i *)(dst + x),
+                             _mm_and_si128(_mm_packus_epi16(lo, hi), vkeep));
+        }
+    }
+#endif /* TRANSFORM_SIMD */
+    for (; x < width; x++) {
+        Uint32 px = 0;
+        int shift;
+
+        for (shift = 0; shift < 32; shift += 8) {
+            int total = ((above[x] >> shift) & 0xff) +
+                        ((above[x + 1] >> shift) & 0xff) +
+                        ((above[x + 2] >> shift) & 0xff) +
+                        ((row[x] >> shift) & 0xff) +
+                        ((row[x + 2] >> shift) & 0xff) +
+                        ((below[x] >> shift) & 0xff) +
+                        ((below[x + 1] >> shift) & 0xff) +
+                        ((below[x + 2] >> shift) & 0xff);
+            int value = (int)((row[x + 1] >> shift) & 0xff) * 8 - total;
+
+            px |= (Uint32)MIN(MAX(value, 0), 255) << shift;
+        }
+        dst[x] = px & keep;
+    }
+}
+
+/* laplacian() of a surface that laplacian_in_bytes32() accepts. Each
+ * source row is copied between two LAPLACIAN_NUM pixels into a ring of
+ * three rows, and the rows above the first and below the last are all
+ * LAPLACIAN_NUM, so the kernel reads its neighbours at fixed offsets with
+ * the same result as the generic path. Rows are copied before they are
+ * written, so destsurf may be surf. Returns -1 on a memory error.
+ */
+static int
+laplacian32(SDL_Surface *surf, SDL_Surface *destsurf)
+{
+    SDL_PixelFormat *format = surf->format;
+    Uint32 keep =
+        format->Rmask | format->Gmask | format->Bmask | format->Amask;
+    int width = surf->w, height = surf->h, stride = surf->w + 2;
+    size_t rowbytes = (size_t)width * 4;
+    Uint32 *buffer, *ring[3], *missing;
+    int x, y;
+
+    buffer = (Uint32 *)malloc(sizeof(Uint32) * stride * 4);
+    if (!buffer)
+        return -1;
+    for (y = 0; y < 3; y++) {
+        ring[y] = buffer + y * stride;
+        ring[y][0] = ring[y][stride - 1] = LAPLACIAN_NUM;
+    }
+    missing = buffer + 3 * stride;
+    for (x = 0; x < stride; x++) {
+        missing[x] = LAPLACIAN_NUM;
+    }
+
+    if (height)
+        memcpy(ring[0] + 1, surf->pixels, rowbytes);
+    for (y = 0; y < height; y++) {
+        const Uint32 *above = y > 0 ? ring[(y + 2) % 3] : missing;
+        const Uint32 *below = missing;
+
+        if (y + 1 < height) {
+            memcpy(ring[(y + 1) % 3] + 1,
+                   (Uint8 *)surf->pixels + (size_t)(y + 1) * surf->pitch,
+                   rowbytes);
+            below = ring[(y + 1) % 3];
+        }
+        laplacian_row32(
+            above, ring[y % 3], below,
+            (Uint32 *)((Uint8 *)destsurf->pixels +
+                       (size_t)y * destsurf->pitch),
+            width, keep);
+    }
+
+    free(buffer);
+    return 0;
+}
+
 static PyObject *
 surf_laplacian(PyObject *self, PyObject *args, PyObject *kwargs)
 {
     PyObject *surfobj, *surfobj2 = NULL;
     SDL_Surface *surf;
     SDL_Surface *newsurf;
+    int result = 0;
     static char *keywords[] = {"surface", "dest_surface", NULL};
 
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|O!", keywords,
@@ -2304,6 +4589,8 @@ surf_laplacian(PyObject *self, PyObject *args, PyObject *kwargs)
         return NULL;
 
     surf = pgSurface_AsSurface(surfobj);
+    if (!pgSurface_Unpack(surf))
+        return NULL;
 
     /* if the second surface is not there, then make a new one. */
 
@@ -2311,7 +4598,7 @@ surf_laplacian(PyObject *self, PyObject *args, PyObject *kwargs)
         int width = surf->w;
         int height = surf->h;
 
-        newsurf = newsurf_fromsurf(surf, width, height);
+        newsurf = newsurf_fromsurf(surf, width, height, NULL);
 
         if (!newsurf)
             return NULL;
@@ -2328,17 +4615,28 @@ surf_laplacian(PyObject *self, PyObject *args, PyObject *kwargs)
     if (surf->format->BytesPerPixel != newsurf->format->BytesPerPixel)
         return RAISE(PyExc_ValueError,
                      "Source and destination surfaces need the same format.");
+    if (!pgSurface_Unshare(newsurf))
+        return NULL;
 
     SDL_LockSurface(newsurf);
     SDL_LockSurface(surf);
 
     Py_BEGIN_ALLOW_THREADS;
-    laplacian(surf, newsurf);
+    if (laplacian_in_bytes32(surf, newsurf))
+        result = laplacian32(surf, newsurf);
+    else
+        laplacian(surf, newsurf);
     Py_END_ALLOW_THREADS;
 
     SDL_UnlockSurface(surf);
     SDL_UnlockSurface(newsurf);
 
+    if (result) {
+        if (!surfobj2)
+            SDL_FreeSurface(newsurf);
+        return PyErr_NoMemory();
+    }
+
     if (surfobj2) {
         Py_INCREF(surfobj2);
         return surfobj2;
@@ -2347,608 +4645,3336 @@ surf_laplacian(PyObject *self, PyObject *args, PyObject *kwargs)
         return (PyObject *)pgSurface_New(newsurf);
 }
 
-int
-average_surfaces(SDL_Surface **surfaces, size_t num_surfaces,
-                 SDL_Surface *destsurf, int palette_colors)
-{
-    /*
-        returns the average surface from the ones given.
-
-        All surfaces need to be the same size.
-
-        palette_colors - if true we average the colors in palette, otherwise we
-            average the pixel values.  This is useful if the surface is
-            actually greyscale colors, and not palette colors.
-
-    */
+/*
+ * sobel and scharr: the brightness gradient of a surface, from a pair of
+ * 3x3 kernels. The two differ only in their weights, 1 2 1 across the
+ * gradient for Sobel and 3 10 3 for Scharr, which is closer to rotation
+ * invariant.
+ */
 
-    Uint32 *accumulate;
-    Uint32 *the_idx;
-    Uint32 the_color;
-    SDL_Surface *surf;
-    size_t surf_idx;
-    int height, width, x, y;
+#define EDGE_MAGNITUDE 0
+#define EDGE_DIRECTION 1
+#define EDGE_MASK 2
 
-    float div_inv;
+/* Brightness of a colour, with the weights of the ITU-R 601 luma in 256ths;
+ * also used by histogram() and get_stats() */
+#define _LUMINANCE(r, g, b) (((r)*77 + (g)*150 + (b)*29 + 128) >> 8)
 
-    SDL_PixelFormat *format, *destformat;
-    Uint8 *pixels, *destpixels;
-    Uint8 *pix;
-    Uint8 *byte_buf;
+/* Byte of a 24 or 32 bit pixel holding the channel at shift */
+static PG_INLINE int
+edge_byte_offset(int shift, int bpp)
+{
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    return shift >> 3;
+#else
+    return bpp - 1 - (shift >> 3);
+#endif
+}
 
-    Uint32 rmask, gmask, bmask;
-    int rshift, gshift, bshift, rloss, gloss, bloss;
-    int num_elements;
+/* Whether a 24 or 32 bit format keeps R, G and B in whole bytes */
+static int
+edge_rgb_in_bytes(SDL_PixelFormat *format)
+{
+    if (format->BytesPerPixel == 4)
+        return _rgb_in_bytes32(format);
+    return format->BytesPerPixel == 3;
+}
 
-    if (!num_surfaces) {
-        return 0;
+/* Brightness of a row of pixels into gray[1] to gray[width], repeating
+ * the edge pixels into gray[0] and gray[width + 1]. */
+static void
+edge_gray_row(const Uint8 *src, Sint16 *gray, int width,
+              SDL_PixelFormat *format)
+{
+    int bpp = format->BytesPerPixel;
+    int roff = edge_byte_offset(format->Rshift, bpp);
+    int goff = edge_byte_offset(format->Gshift, bpp);
+    int boff = edge_byte_offset(format->Bshift, bpp);
+    int x;
+
+    for (x = 0; x < width; x++, src += bpp) {
+        gray[x + 1] = (Sint16)_LUMINANCE(src[roff], src[goff], src[boff]);
     }
+    gray[0] = gray[1];
+    gray[width + 1] = gray[width];
+}
 
-    height = surfaces[0]->h;
-    width = surfaces[0]->w;
+/* Gradient of one row from the padded brightness rows above, at and below
+ * it. side and centre are the kernel weights and scale turns the length
+ * of the gradient into 0 to 255. out gets the rounded length, or the
+ * direction in 256 steps a turn, clockwise from the right.
+ */
+static void
+edge_gradient_row(const Sint16 *above, const Sint16 *row,
+                  const Sint16 *below, Uint8 *out, int width, int side,
+                  int centre, float scale, int direction)
+{
+    int x = 0;
+
+#ifdef TRANSFORM_SIMD
+    if (!direction && _use_simd()) {
+        __m128i vside = _mm_set1_epi16((short)side);
+        __m128i vcentre = _mm_set1_epi16((short)centre);
+        __m128 vscale = _mm_set1_ps(scale);
+        __m128 vhalf = _mm_set1_ps(0.5f);
+
+        for (; x + 8 <= width; x += 8) {
+#define EDGE_LOAD(p, i) _mm_loadu_si128((const __m128i *)((p) + x + (i)))
+            __m128i a0 = EDGE_LOAD(above, 0), a1 = EDGE_LOAD(above, 1);
+            __m128i a2 = EDGE_LOAD(above, 2), b0 = EDGE_LOAD(below, 0);
+            __m128i b1 = EDGE_LOAD(below, 1), b2 = EDGE_LOAD(below, 2);
+            __m128i gx = _mm_add_epi16(
+                _mm_mullo_epi16(_mm_add_epi16(_mm_sub_epi16(a2, a0),
+                                              _mm_sub_epi16(b2, b0)),
+                                vside),
+                _mm_mullo_epi16(
+                    _mm_sub_epi16(EDGE_LOAD(row, 2), EDGE_LOAD(row, 0)),
+                    vcentre));
+            __m128i gy = _mm_add_epi16(
+                _mm_mullo_epi16(_mm_add_epi16(_mm_sub_epi16(b0, a0),
+                                              _mm_sub_epi16(b2, a2)),
+                                vside),
+                _mm_mullo_epi16(_mm_sub_epi16(b1, a1), vcentre));
+#undef EDGE_LOAD
+            /* gx * gx + gy * gy of each pixel, as 32 bits */
+            __m128i lo = _mm_unpacklo_epi16(gx, gy);
+            __m128i hi = _mm_unpackhi_epi16(gx, gy);
+            __m128 flo = _mm_cvtepi32_ps(_mm_madd_epi16(lo, lo));
+            __m128 fhi = _mm_cvtepi32_ps(_mm_madd_epi16(hi, hi));
+
+            lo = _mm_cvttps_epi32(
+                _mm_add_ps(_mm_mul_ps(_mm_sqrt_ps(flo), vscale), vhalf));
+            hi = _mm_cvttps_epi32(
+                _mm_add_ps(_mm_mul_ps(_mm_sqrt_ps(fhi), vscale), vhalf));
+            lo = _mm_packs_epi32(lo, hi);
+            _mm_storel_epi64((__m128i *)(out + x), _mm_packus_epi16(lo, lo));
+        }
+    }
+#endif /* TRANSFORM_SIMD */
+    for (; x < width; x++) {
+        int gx = (above[x + 2] - above[x] + below[x + 2] - below[x]) * side +
+                 (row[x + 2] - row[x]) * centre;
+        int gy = (below[x] - above[x] + below[x + 2] - above[x + 2]) * side +
+                 (below[x + 1] - above[x + 1]) * centre;
+
+        if (direction) {
+            out[x] = (Uint8)((int)(atan2f((float)gy, (float)gx) *
+                                       (float)(128.0 / M_PI) +
+                                   256.5f) &
+                             0xff);
+        }
+        else {
+            int length = (int)(sqrtf((float)(gx * gx + gy * gy)) * scale +
+                               0.5f);
 
-    destpixels = (Uint8 *)destsurf->pixels;
-    destformat = destsurf->format;
+            out[x] = (Uint8)MIN(length, 255);
+        }
+    }
+}
 
-    /* allocate an array to accumulate them all.
+/* Write a row of gray levels as opaque gray pixels */
+static void
+edge_store_row(const Uint8 *levels, Uint8 *dst, int width,
+               SDL_PixelFormat *format)
+{
+    int bpp = format->BytesPerPixel;
+    int x;
 
-    If we're using 1 byte per pixel, then only need to average on that much.
-    */
+    if (bpp == 4) {
+        Uint32 unit = (1u << format->Rshift) | (1u << format->Gshift) |
+                      (1u << format->Bshift);
 
-    if ((destformat->BytesPerPixel == 1) && (destformat->palette) &&
-        (!palette_colors)) {
-        num_elements = 1;
+        for (x = 0; x < width; x++) {
+            ((Uint32 *)dst)[x] = levels[x] * unit | format->Amask;
+        }
     }
     else {
-        num_elements = 3;
+        int roff = edge_byte_offset(format->Rshift, 3);
+        int goff = edge_byte_offset(format->Gshift, 3);
+        int boff = edge_byte_offset(format->Bshift, 3);
+
+        for (x = 0; x < width; x++, dst += 3) {
+            dst[roff] = dst[goff] = dst[boff] = levels[x];
+        }
     }
+}
 
-    accumulate =
-        (Uint32 *)calloc(1, sizeof(Uint32) * height * width * num_elements);
+/* Filter surf into destsurf, or into the bits of mask at or above
+ * threshold. The brightness of each source row is taken into a ring of
+ * three rows before the row is written, so destsurf may be surf. Returns
+ * -1 on a memory error.
+ */
+static int
+edge_detect(SDL_Surface *surf, SDL_Surface *destsurf, bitmask_t *mask,
+            int side, int centre, int output, int threshold)
+{
+    int width = surf->w, height = surf->h, stride = surf->w + 2;
+    float scale = 1.0f / (2 * side + centre);
+    Sint16 *ring[3];
+    Uint8 *levels;
+    void *buffer;
+    int x, y;
 
-    if (!accumulate) {
+    buffer = malloc(sizeof(Sint16) * stride * 3 + width);
+    if (!buffer)
         return -1;
+    for (y = 0; y < 3; y++) {
+        ring[y] = (Sint16 *)buffer + y * stride;
     }
+    levels = (Uint8 *)(ring[2] + stride);
 
-    /* add up the r,g,b from all the surfaces. */
-
-    for (surf_idx = 0; surf_idx < num_surfaces; surf_idx++) {
-        surf = surfaces[surf_idx];
-
-        pixels = (Uint8 *)surf->pixels;
-        format = surf->format;
-        rmask = format->Rmask;
-        gmask = format->Gmask;
-        bmask = format->Bmask;
-        rshift = format->Rshift;
-        gshift = format->Gshift;
-        bshift = format->Bshift;
-        rloss = format->Rloss;
-        gloss = format->Gloss;
-        bloss = format->Bloss;
-
-        the_idx = accumulate;
-        /* If palette surface, we use a different code path... */
+    if (height)
+        edge_gray_row((Uint8 *)surf->pixels, ring[0], width, surf->format);
+    for (y = 0; y < height; y++) {
+        const Sint16 *row = ring[y % 3];
+        const Sint16 *above = y > 0 ? ring[(y + 2) % 3] : row;
+        const Sint16 *below = row;
+
+        if (y + 1 < height) {
+            edge_gray_row(
+                (Uint8 *)surf->pixels + (size_t)(y + 1) * surf->pitch,
+                ring[(y + 1) % 3], width, surf->format);
+            below = ring[(y + 1) % 3];
+        }
+        edge_gradient_row(above, row, below, levels, width, side, centre,
+                          scale, output == EDGE_DIRECTION);
 
-        if ((format->BytesPerPixel == 1 && destformat->BytesPerPixel == 1) &&
-            (format->palette) && (destformat->palette) && (!palette_colors)) {
-            /*
-            This is useful if the surface is actually greyscale colors,
-            and not palette colors.
-            */
-            for (y = 0; y < height; y++) {
-                for (x = 0; x < width; x++) {
-                    SURF_GET_AT(the_color, surf, x, y, pixels, format, pix);
-                    *(the_idx) += the_color;
-                    the_idx++;
-                }
+        if (mask) {
+            for (x = 0; x < width; x++) {
+                if (levels[x] >= threshold)
+                    bitmask_setbit(mask, x, y);
             }
         }
         else {
-            /* TODO: This doesn't work correctly for palette surfaces yet, when
-               the source is paletted.  Probably need to use something like
-               GET_PIXELVALS_1 from surface.h
-            */
-
-            /* for non palette surfaces, we do this... */
-            for (y = 0; y < height; y++) {
-                for (x = 0; x < width; x++) {
-                    SURF_GET_AT(the_color, surf, x, y, pixels, format, pix);
-
-                    *(the_idx) += ((the_color & rmask) >> rshift) << rloss;
-                    *(the_idx + 1) += ((the_color & gmask) >> gshift) << gloss;
-                    *(the_idx + 2) += ((the_color & bmask) >> bshift) << bloss;
-                    the_idx += 3;
-                }
-            }
+            edge_store_row(
+                levels,
+                (Uint8 *)destsurf->pixels + (size_t)y * destsurf->pitch,
+                width, destsurf->format);
         }
     }
 
-    /* blit the accumulated array back to the destination surface. */
-
-    div_inv = (float)(1.0L / (num_surfaces));
-
-    the_idx = accumulate;
+    free(buffer);
+    return 0;
+}
 
-    if (num_elements == 1 && (!palette_colors)) {
-        /* this is where we are using the palette surface without using its
-        colors from the palette.
-        */
-        for (y = 0; y < height; y++) {
-            for (x = 0; x < width; x++) {
-                the_color = (Uint32)(*(the_idx)*div_inv + .5f);
-                SURF_SET_AT(the_color, destsurf, x, y, destpixels, destformat,
-                            byte_buf);
-                the_idx++;
-            }
-        }
-        /* TODO: will need to handle palette colors.
-         */
-    }
-    else if (num_elements == 3) {
-        for (y = 0; y < height; y++) {
-            for (x = 0; x < width; x++) {
-                the_color =
-                    SDL_MapRGB(destformat, (Uint8)(*(the_idx)*div_inv + .5f),
-                               (Uint8)(*(the_idx + 1) * div_inv + .5f),
-                               (Uint8)(*(the_idx + 2) * div_inv + .5f));
+static PyObject *
+edge_surface(PyObject *args, PyObject *kwargs, int side, int centre)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *surfobj2 = NULL, *maskobj = NULL;
+    SDL_Surface *surf, *newsurf = NULL;
+    bitmask_t *mask = NULL;
+    const char *outputname = "magnitude";
+    int output, threshold = 128, result = 0;
+    static char *keywords[] = {"surface", "output", "threshold",
+                               "dest_surface", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|siO!", keywords,
+                                     &pgSurface_Type, &surfobj, &outputname,
+                                     &threshold, &pgSurface_Type, &surfobj2))
+        return NULL;
 
-                /* TODO: should it take into consideration the output
-                    shifts/masks/losses?  Or does SDL_MapRGB do that correctly?
+    if (!strcmp(outputname, "magnitude"))
+        output = EDGE_MAGNITUDE;
+    else if (!strcmp(outputname, "direction"))
+        output = EDGE_DIRECTION;
+    else if (!strcmp(outputname, "mask"))
+        output = EDGE_MASK;
+    else
+        return RAISE(PyExc_ValueError,
+                     "output must be 'magnitude', 'direction' or 'mask'");
 
-                    *(the_idx) += ((the_color & rmask) >> rshift) << rloss;
-                    *(the_idx + 1) += ((the_color & gmask) >> gshift) << gloss;
-                    *(the_idx + 2) += ((the_color & bmask) >> bshift) << bloss;
-                */
+    if (threshold < 0 || threshold > 255)
+        return RAISE(PyExc_ValueError, "threshold must be between 0 and 255");
 
-                SURF_SET_AT(the_color, destsurf, x, y, destpixels, destformat,
-                            byte_buf);
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    if (!edge_rgb_in_bytes(surf->format))
+        return RAISE(PyExc_ValueError,
+                     "Only 24-bit or 32-bit surfaces can be filtered");
 
-                the_idx += 3;
-            }
-        }
+    if (output == EDGE_MASK) {
+        if (surfobj2)
+            return RAISE(PyExc_ValueError,
+                         "dest_surface can not be used with mask output");
+        maskobj = PyObject_CallFunction((PyObject *)&pgMask_Type, "((ii))",
+                                        surf->w, surf->h);
+        if (!maskobj)
+            return NULL;
+        mask = pgMask_AsBitmap(maskobj);
+    }
+    else if (surfobj2) {
+        newsurf = pgSurface_AsSurface(surfobj2);
+        if (!newsurf)
+            return RAISE(pgExc_SDLError, "display Surface quit");
+        if (newsurf->w != surf->w || newsurf->h != surf->h)
+            return RAISE(PyExc_ValueError,
+                         "Destination surface not the same size.");
+        if (newsurf->format->BytesPerPixel != surf->format->BytesPerPixel ||
+            !edge_rgb_in_bytes(newsurf->format))
+            return RAISE(
+                PyExc_ValueError,
+                "Source and destination surfaces need the same format.");
+        if (!pgSurface_Unshare(newsurf))
+            return NULL;
     }
     else {
-        free(accumulate);
-        return -4;
+        newsurf = newsurf_fromsurf(surf, surf->w, surf->h, NULL);
+        if (!newsurf)
+            return NULL;
     }
 
-    free(accumulate);
+    if (surf->w && surf->h) {
+        if (newsurf)
+            SDL_LockSurface(newsurf);
+        pgSurface_Lock(surfobj);
 
-    return 1;
-}
+        Py_BEGIN_ALLOW_THREADS;
+        result = edge_detect(surf, newsurf, mask, side, centre, output,
+                             threshold);
+        Py_END_ALLOW_THREADS;
 
-/*
-    returns the average surface from the ones given.
+        pgSurface_Unlock(surfobj);
+        if (newsurf)
+            SDL_UnlockSurface(newsurf);
+    }
 
-    All surfaces need to be the same size.
+    if (result) {
+        Py_XDECREF(maskobj);
+        if (newsurf && !surfobj2)
+            SDL_FreeSurface(newsurf);
+        return PyErr_NoMemory();
+    }
 
-    palette_colors - if true we average the colors in palette, otherwise we
-        average the pixel values.  This is useful if the surface is
-        actually greyscale colors, and not palette colors.
+    if (maskobj)
+        return maskobj;
+    if (surfobj2) {
+        Py_INCREF(surfobj2);
+        return surfobj2;
+    }
+    return (PyObject *)pgSurface_New(newsurf);
+}
 
-*/
 static PyObject *
-surf_average_surfaces(PyObject *self, PyObject *args, PyObject *kwargs)
+surf_sobel(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    PyObject *surfobj2 = NULL;
-    SDL_Surface *surf;
-    SDL_Surface *newsurf = NULL;
-    SDL_Surface **surfaces;
-    int width, height;
-    int an_error = 0;
-    size_t size, loop, loop_up_to;
-    int palette_colors = 1;
-    PyObject *list, *obj;
-    PyObject *ret = NULL;
-    static char *keywords[] = {"surfaces", "dest_surface", "palette_colors",
-                               NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O!i", keywords, &list,
-                                     &pgSurface_Type, &surfobj2,
-                                     &palette_colors))
-        return NULL;
-
-    if (!PySequence_Check(list))
-        return RAISE(PyExc_TypeError,
-                     "Argument must be a sequence of surface objects.");
-
-    size = PySequence_Length(list); /*warning, size could be -1 on error?*/
-
-    if (size < 1)
-        return RAISE(PyExc_TypeError,
-                     "Needs to be given at least one surface.");
+    return edge_surface(args, kwargs, 1, 2);
+}
 
-    /* Allocate an array of surface pointers. */
+static PyObject *
+surf_scharr(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    return edge_surface(args, kwargs, 3, 10);
+}
 
-    surfaces = (SDL_Surface **)calloc(1, sizeof(SDL_Surface *) * size);
+/*
+ * box_blur, gaussian_blur and convolve: filters over a fixed neighbourhood
+ * of each pixel. The blurs are separable, so they run as a horizontal pass
+ * into a temporary buffer and a vertical pass out of it.
+ */
 
-    if (!surfaces) {
-        return RAISE(PyExc_MemoryError,
-                     "Not enough memory to store surfaces.\n");
+/* Largest blur radius; it keeps box sums exact to divide by reciprocal */
+#define BLUR_MAX_RADIUS 2047
+
+typedef struct {
+    Uint8 *srcpix;
+    Uint8 *dstpix;
+    int srcpitch;
+    int dstpitch;
+    int width; /* pixels per row */
+    int height;
+    int bpp;
+    int radius;
+    const int *weights; /* 2 * radius + 1 fixed point taps, NULL for a box */
+    Uint32 inverse;     /* box: 2^32 / (2 * radius + 1), rounded up */
+    const Uint8 *zeros; /* a row of zeros, or NULL to repeat edge pixels */
+    int vertical;
+    Uint8 *scratch;
+    size_t bandsize; /* scratch bytes for each band */
+} BlurPass;
+
+/* Row y of an image, clamped to the edge rows when repeating edges.
+ * Returns NULL for rows outside the image otherwise. */
+static PG_INLINE const Uint8 *
+blur_source_row(const Uint8 *pixels, int pitch, int height, int y,
+                int repeat_edges)
+{
+    if (y < 0) {
+        if (!repeat_edges)
+            return NULL;
+        y = 0;
     }
+    else if (y >= height) {
+        if (!repeat_edges)
+            return NULL;
+        y = height - 1;
+    }
+    return pixels + (size_t)y * pitch;
+}
 
-    /* Iterate over 'surfaces' passed in. */
-
-    /* need to get the first surface to see how big it is */
+/* Copy a row into pad with radius pixels on either side, which repeat the
+ * edge pixels or are zero. Every tap is then a plain offset into pad. */
+static void
+blur_pad_row(Uint8 *pad, const Uint8 *row, int width, int bpp, int radius,
+             int repeat_edges)
+{
+    Uint8 *right = pad + (size_t)(radius + width) * bpp;
+    int i;
 
-    for (loop = 0; loop < size; ++loop) {
-        obj = PySequence_GetItem(list, loop);
+    memcpy(pad + radius * bpp, row, (size_t)width * bpp);
+    if (!repeat_edges) {
+        memset(pad, 0, (size_t)radius * bpp);
+        memset(right, 0, (size_t)radius * bpp);
+        return;
+    }
+    for (i = 0; i < radius; i++) {
+        memcpy(pad + i * bpp, row, bpp);
+        memcpy(right + i * bpp, row + (width - 1) * bpp, bpp);
+    }
+}
 
-        if (!obj) {
-            Py_XDECREF(obj);
-            ret = RAISE(PyExc_TypeError, "Needs to be a surface object.");
-            an_error = 1;
-            break;
+/* Box sums are at most 255 * 4095, small enough that multiplying by the
+ * rounded up reciprocal gives exactly the rounded quotient. */
+static void
+blur_box_store(Uint8 *dst, const int *accumulate, int count, int taps,
+               Uint32 inverse)
+{
+    Uint32 half = (Uint32)taps / 2;
+    int x = 0;
+
+#ifdef TRANSFORM_SIMD
+    if (_use_simd()) {
+        __m128i mhalf = _mm_set1_epi32(half);
+        __m128i minverse = _mm_set1_epi32(inverse);
+        __m128i mhigh = _mm_set_epi32(-1, 0, -1, 0);
+        __m128i q[4];
+        int i;
+
+        for (; x + 16 <= count; x += 16) {
+            for (i = 0; i < 4; i++) {
+                __m128i a = _mm_add_epi32(
+                    _mm_loadu_si128((const __m128i *)(accumulate + x) + i),
+                    mhalf);
+                __m128i even = _mm_mul_epu32(a, minverse);
+                __m128i odd =
+                    _mm_mul_epu32(_mm_srli_epi64(a, 32), minverse);
+
+                q[i] = _mm_or_si128(_mm_srli_epi64(even, 32),
+                                    _mm_and_si128(odd, mhigh));
+            }
+            _mm_storeu_si128((__m128i *)(dst + x),
+                             _mm_packus_epi16(_mm_packs_epi32(q[0], q[1]),
+                                              _mm_packs_epi32(q[2], q[3])));
         }
+    }
+#endif /* TRANSFORM_SIMD */
+    for (; x < count; x++) {
+        dst[x] = (Uint8)(((Uint64)(accumulate[x] + half) * inverse) >> 32);
+    }
+}
 
-        if (!pgSurface_Check(obj)) {
-            Py_XDECREF(obj);
-            ret = RAISE(PyExc_TypeError, "Needs to be a surface object.");
-            an_error = 1;
-            break;
+#ifdef TRANSFORM_SIMD
+/* Sum 16 bytes at offset x of every tap row, two taps per madd */
+static PG_INLINE void
+blur_weigh16_sse2(const Uint8 **rows, const int *weights, int taps, int x,
+                  Uint8 *dst)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i acc[4];
+    int i;
+
+    acc[0] = acc[1] = acc[2] = acc[3] =
+        _mm_set1_epi32(1 << (RESAMPLE_PRECISION_BITS - 1));
+    for (i = 0; i < taps; i += 2) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(rows[i] + x));
+        __m128i b = zero;
+        __m128i w = _mm_set1_epi32(weights[i] & 0xffff);
+        __m128i alo, ahi, blo, bhi;
+
+        if (i + 1 < taps) {
+            b = _mm_loadu_si128((const __m128i *)(rows[i + 1] + x));
+            w = _mm_set1_epi32((weights[i] & 0xffff) | (weights[i + 1] << 16));
         }
+        alo = _mm_unpacklo_epi8(a, zero);
+        ahi = _mm_unpackhi_epi8(a, zero);
+        blo = _mm_unpacklo_epi8(b, zero);
+        bhi = _mm_unpackhi_epi8(b, zero);
+        acc[0] = _mm_add_epi32(
+            acc[0], _mm_madd_epi16(_mm_unpacklo_epi16(alo, blo), w));
+        acc[1] = _mm_add_epi32(
+            acc[1], _mm_madd_epi16(_mm_unpackhi_epi16(alo, blo), w));
+        acc[2] = _mm_add_epi32(
+            acc[2], _mm_madd_epi16(_mm_unpacklo_epi16(ahi, bhi), w));
+        acc[3] = _mm_add_epi32(
+            acc[3], _mm_madd_epi16(_mm_unpackhi_epi16(ahi, bhi), w));
+    }
+    for (i = 0; i < 4; i++) {
+        acc[i] = _mm_srai_epi32(acc[i], RESAMPLE_PRECISION_BITS);
+    }
+    _mm_storeu_si128((__m128i *)(dst + x),
+                     _mm_packus_epi16(_mm_packs_epi32(acc[0], acc[1]),
+                                      _mm_packs_epi32(acc[2], acc[3])));
+}
+#endif /* TRANSFORM_SIMD */
 
-        surf = pgSurface_AsSurface(obj);
+/* dst[x] = sum of rows[i][x] * weights[i], in resample's fixed point */
+static void
+blur_weigh(const Uint8 **rows, const int *weights, int taps, Uint8 *dst,
+           int count, int *accumulate)
+{
+    int x = 0, i;
 
-        if (!surf) {
-            Py_XDECREF(obj);
-            ret = RAISE(PyExc_TypeError, "Needs to be a surface object.");
-            an_error = 1;
-            break;
+#ifdef TRANSFORM_SIMD
+    if (_use_simd()) {
+        for (; x + 16 <= count; x += 16) {
+            blur_weigh16_sse2(rows, weights, taps, x, dst);
         }
+    }
+#endif /* TRANSFORM_SIMD */
+    if (x == count)
+        return;
+    for (i = x; i < count; i++) {
+        accumulate[i] = 1 << (RESAMPLE_PRECISION_BITS - 1);
+    }
+    for (i = 0; i < taps; i++) {
+        const Uint8 *src = rows[i];
+        int weight = weights[i];
+        int j;
 
-        if (loop == 0) {
-            /* if the second surface is not there, then make a new one. */
-            if (!surfobj2) {
-                width = surf->w;
-                height = surf->h;
+        for (j = x; j < count; j++) {
+            accumulate[j] += src[j] * weight;
+        }
+    }
+    for (; x < count; x++) {
+        dst[x] = resample_clip(accumulate[x]);
+    }
+}
 
-                newsurf = newsurf_fromsurf(surf, width, height);
+static void
+blur_horizontal(BlurPass *pass, int start, int end, Uint8 *scratch)
+{
+    int bpp = pass->bpp;
+    int rowbytes = pass->width * bpp;
+    int taps = 2 * pass->radius + 1;
+    const Uint8 **rows = (const Uint8 **)scratch;
+    int *accumulate = (int *)(rows + taps);
+    Uint8 *pad = (Uint8 *)(accumulate + rowbytes);
+    int x, y, i;
+
+    for (i = 0; i < taps; i++) {
+        rows[i] = pad + i * bpp;
+    }
+    for (y = start; y < end; y++) {
+        Uint8 *dst = pass->dstpix + (size_t)y * pass->dstpitch;
+
+        blur_pad_row(pad, pass->srcpix + (size_t)y * pass->srcpitch,
+                     pass->width, bpp, pass->radius, !pass->zeros);
+        if (pass->weights) {
+            blur_weigh(rows, pass->weights, taps, dst, rowbytes, accumulate);
+            continue;
+        }
 
-                if (!newsurf) {
-                    Py_XDECREF(obj);
-                    ret = RAISE(PyExc_ValueError,
-                                "Could not create new surface.");
-                    an_error = 1;
-                    break;
-                }
+        /* sliding window: each sum is the one a pixel back, plus the byte
+         * entering the window and minus the one leaving it */
+        for (x = 0; x < bpp; x++) {
+            accumulate[x] = 0;
+            for (i = 0; i < taps; i++) {
+                accumulate[x] += pad[x + i * bpp];
             }
-            else
-                newsurf = pgSurface_AsSurface(surfobj2);
+        }
+        for (; x < rowbytes; x++) {
+            accumulate[x] = accumulate[x - bpp] + pad[x + (taps - 1) * bpp] -
+                            pad[x - bpp];
+        }
+        blur_box_store(dst, accumulate, rowbytes, taps, pass->inverse);
+    }
+}
 
-            /* check to see if the size is the correct size. */
-            if (newsurf->w != (surf->w) || newsurf->h != (surf->h)) {
-                Py_XDECREF(obj);
-                ret = RAISE(PyExc_ValueError,
-                            "Destination surface not the same size.");
-                an_error = 1;
-                break;
+static void
+blur_vertical(BlurPass *pass, int start, int end, Uint8 *scratch)
+{
+    int rowbytes = pass->width * pass->bpp;
+    int radius = pass->radius;
+    int taps = 2 * radius + 1;
+    int repeat_edges = !pass->zeros;
+    const Uint8 **rows = (const Uint8 **)scratch;
+    int *accumulate = (int *)(rows + taps);
+    const Uint8 *add, *sub;
+    int x, y, i;
+
+    if (pass->weights) {
+        for (y = start; y < end; y++) {
+            for (i = 0; i < taps; i++) {
+                rows[i] = blur_source_row(pass->srcpix, pass->srcpitch,
+                                          pass->height, y - radius + i,
+                                          repeat_edges);
+                if (!rows[i])
+                    rows[i] = pass->zeros;
             }
+            blur_weigh(rows, pass->weights, taps,
+                       pass->dstpix + (size_t)y * pass->dstpitch, rowbytes,
+                       accumulate);
+        }
+        return;
+    }
 
-            /* check to see if the format of the surface is the same. */
-            if (surf->format->BytesPerPixel !=
-                newsurf->format->BytesPerPixel) {
-                Py_XDECREF(obj);
-                ret = RAISE(
-                    PyExc_ValueError,
-                    "Source and destination surfaces need the same format.");
-                an_error = 1;
-                break;
+    /* box: sum the first window of the band, then slide it down a row at
+     * a time */
+    memset(accumulate, 0, sizeof(int) * (size_t)rowbytes);
+    for (i = -radius; i <= radius; i++) {
+        add = blur_source_row(pass->srcpix, pass->srcpitch, pass->height,
+                              start + i, repeat_edges);
+        if (!add)
+            continue;
+        for (x = 0; x < rowbytes; x++) {
+            accumulate[x] += add[x];
+        }
+    }
+    for (y = start; y < end; y++) {
+        blur_box_store(pass->dstpix + (size_t)y * pass->dstpitch, accumulate,
+                       rowbytes, taps, pass->inverse);
+        if (y + 1 == end)
+            break;
+        add = blur_source_row(pass->srcpix, pass->srcpitch, pass->height,
+                              y + radius + 1, repeat_edges);
+        sub = blur_source_row(pass->srcpix, pass->srcpitch, pass->height,
+                              y - radius, repeat_edges);
+        if (add) {
+            for (x = 0; x < rowbytes; x++) {
+                accumulate[x] += add[x];
+            }
+        }
+        if (sub) {
+            for (x = 0; x < rowbytes; x++) {
+                accumulate[x] -= sub[x];
             }
         }
+    }
+}
 
-        /* Copy surface pointer, and also lock surface. */
-        SDL_LockSurface(surf);
-        surfaces[loop] = surf;
+static void
+blur_pass_band(void *data, int band, int nbands)
+{
+    BlurPass *pass = (BlurPass *)data;
+    int start = (int)((long long)pass->height * band / nbands);
+    int end = (int)((long long)pass->height * (band + 1) / nbands);
+    Uint8 *scratch = pass->scratch + pass->bandsize * band;
 
-        Py_DECREF(obj);
-    }
+    if (start >= end)
+        return;
+    if (pass->vertical)
+        blur_vertical(pass, start, end, scratch);
+    else
+        blur_horizontal(pass, start, end, scratch);
+}
 
-    loop_up_to = loop;
+/* Run one blur pass, in row bands over the worker pool when it is large
+ * enough. Returns -1 if the scratch rows can't be allocated.
+ */
+static int
+blur_run_pass(BlurPass *pass)
+{
+    int nbands = pg_GetNumThreads();
+    int taps = 2 * pass->radius + 1;
+    size_t rowbytes = (size_t)pass->width * pass->bpp;
 
-    if (!an_error) {
-        /* Process images, get average surface. */
+    if (nbands < 2 ||
+        (long long)pass->width * pass->height < PG_PARALLEL_MIN_PIXELS) {
+        nbands = 1;
+    }
+    if (nbands > pass->height) {
+        nbands = pass->height;
+    }
 
-        SDL_LockSurface(newsurf);
+    /* tap row pointers, then an int per byte of a row, then a padded row;
+     * rounded up so bands don't share cache lines */
+    pass->bandsize = sizeof(Uint8 *) * taps + sizeof(int) * rowbytes +
+                     rowbytes + (size_t)2 * pass->radius * pass->bpp;
+    pass->bandsize = (pass->bandsize + 63) & ~(size_t)63;
+    pass->scratch = (Uint8 *)malloc(pass->bandsize * nbands);
+    if (!pass->scratch)
+        return -1;
 
-        Py_BEGIN_ALLOW_THREADS;
-        average_surfaces(surfaces, size, newsurf, palette_colors);
-        Py_END_ALLOW_THREADS;
+    if (nbands > 1)
+        pg_ParallelFor(blur_pass_band, pass, nbands);
+    else
+        blur_pass_band(pass, 0, 1);
 
-        SDL_UnlockSurface(newsurf);
+    free(pass->scratch);
+    pass->scratch = NULL;
+    return 0;
+}
 
-        if (surfobj2) {
-            Py_INCREF(surfobj2);
-            ret = surfobj2;
-        }
-        else {
-            ret = (PyObject *)pgSurface_New(newsurf);
-        }
+/* Gaussian taps for a radius, with the standard deviation OpenCV picks
+ * for that kernel size. The rounding error goes to the centre tap so the
+ * weights add up to exactly one. */
+static void
+blur_gaussian_weights(int *weights, int radius)
+{
+    double sigma = 0.3 * (radius - 1) + 0.8;
+    double total = 0.0;
+    int i, sum = 0;
+
+    for (i = -radius; i <= radius; i++) {
+        total += exp(-(double)(i * i) / (2.0 * sigma * sigma));
     }
+    for (i = -radius; i <= radius; i++) {
+        weights[i + radius] =
+            (int)(exp(-(double)(i * i) / (2.0 * sigma * sigma)) / total *
+                      (1 << RESAMPLE_PRECISION_BITS) +
+                  0.5);
+        sum += weights[i + radius];
+    }
+    weights[radius] += (1 << RESAMPLE_PRECISION_BITS) - sum;
+}
 
-    /* cleanup */
+/* Blur src into dst, which may be src itself or overlap it, since all of
+ * src is read before dst is written. Returns -1 on a memory error.
+ */
+static int
+blur(SDL_Surface *src, SDL_Surface *dst, int radius, int gaussian,
+     int repeat_edges)
+{
+    BlurPass pass;
+    Uint8 *temppix;
+    Uint8 *zeros = NULL;
+    int *weights = NULL;
+    int bpp = src->format->BytesPerPixel;
+    int rowbytes = src->w * bpp;
+    int result = -1, y;
 
-    /* unlock the surfaces we got up to. */
+    temppix = (Uint8 *)malloc((size_t)rowbytes * src->h);
+    if (!temppix)
+        return -1;
 
-    for (loop = 0; loop < loop_up_to; loop++) {
-        if (surfaces[loop]) {
-            SDL_UnlockSurface(surfaces[loop]);
+    if (!radius) {
+        for (y = 0; y < src->h; y++) {
+            memcpy(temppix + (size_t)y * rowbytes,
+                   (Uint8 *)src->pixels + (size_t)y * src->pitch, rowbytes);
         }
+        for (y = 0; y < src->h; y++) {
+            memcpy((Uint8 *)dst->pixels + (size_t)y * dst->pitch,
+                   temppix + (size_t)y * rowbytes, rowbytes);
+        }
+        free(temppix);
+        return 0;
     }
 
-    free(surfaces);
+    if (gaussian) {
+        weights = (int *)malloc(sizeof(int) * (2 * radius + 1));
+        if (!weights)
+            goto end;
+        blur_gaussian_weights(weights, radius);
+    }
+    if (!repeat_edges) {
+        zeros = (Uint8 *)calloc(rowbytes, 1);
+        if (!zeros)
+            goto end;
+    }
 
-    return ret;
+    pass.width = src->w;
+    pass.height = src->h;
+    pass.bpp = bpp;
+    pass.radius = radius;
+    pass.weights = weights;
+    pass.inverse = (Uint32)(0xFFFFFFFFu / (2 * radius + 1) + 1);
+    pass.zeros = zeros;
+
+    pass.srcpix = (Uint8 *)src->pixels;
+    pass.srcpitch = src->pitch;
+    pass.dstpix = temppix;
+    pass.dstpitch = rowbytes;
+    pass.vertical = 0;
+    if (blur_run_pass(&pass))
+        goto end;
+
+    pass.srcpix = temppix;
+    pass.srcpitch = rowbytes;
+    pass.dstpix = (Uint8 *)dst->pixels;
+    pass.dstpitch = dst->pitch;
+    pass.vertical = 1;
+    result = blur_run_pass(&pass);
+
+end:
+    free(temppix);
+    free(weights);
+    free(zeros);
+    return result;
 }
 
-/* VS 2015 crashes when compiling this function, turning off optimisations to
- try to fix it */
-#if defined(_MSC_VER) && (_MSC_VER == 1900)
-#pragma optimize("", off)
-#endif
+static PyObject *
+blur_surface(PyObject *args, PyObject *kwargs, int gaussian)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *surfobj2 = NULL;
+    SDL_Surface *surf, *newsurf;
+    int radius, repeat_edges = 1, bpp, result = 0;
+    static char *keywords[] = {"surface", "radius", "repeat_edge_pixels",
+                               "dest_surface", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!i|pO!", keywords,
+                                     &pgSurface_Type, &surfobj, &radius,
+                                     &repeat_edges, &pgSurface_Type,
+                                     &surfobj2))
+        return NULL;
 
-/* When GCC compiles the following function with -O3 on PPC64 little endian,
- * the function gives incorrect output with 24-bit surfaces. This is most
- * likely a compiler bug, see #2876 for related issue.
- * So turn optimisations off here */
-#if defined(__GNUC__) && defined(__PPC64__)
-#pragma GCC push_options
-#pragma GCC optimize("O0")
-#endif
+    if (radius < 0 || radius > BLUR_MAX_RADIUS)
+        return PyErr_Format(PyExc_ValueError,
+                            "radius must be between 0 and %d",
+                            BLUR_MAX_RADIUS);
 
-void
-average_color(SDL_Surface *surf, int x, int y, int width, int height, Uint8 *r,
-              Uint8 *g, Uint8 *b, Uint8 *a, SDL_bool consider_alpha)
-{
-    Uint32 color, rmask, gmask, bmask, amask;
-    Uint8 *pixels;
-    unsigned int rtot, gtot, btot, atot, size, rshift, gshift, bshift, ashift,
-        alpha;
-    unsigned int rloss, gloss, bloss, aloss;
-    int row, col, width_and_x, height_and_y;
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
 
-    SDL_PixelFormat *format;
+    bpp = surf->format->BytesPerPixel;
+    if (bpp < 3 || bpp > 4)
+        return RAISE(PyExc_ValueError,
+                     "Only 24-bit or 32-bit surfaces can be blurred");
 
-    format = surf->format;
-    rmask = format->Rmask;
-    gmask = format->Gmask;
-    bmask = format->Bmask;
-    amask = format->Amask;
-    rshift = format->Rshift;
-    gshift = format->Gshift;
-    bshift = format->Bshift;
-    ashift = format->Ashift;
-    rloss = format->Rloss;
-    gloss = format->Gloss;
-    bloss = format->Bloss;
-    aloss = format->Aloss;
-    rtot = gtot = btot = atot = 0;
+    if (surfobj2) {
+        newsurf = pgSurface_AsSurface(surfobj2);
+        if (!newsurf)
+            return RAISE(pgExc_SDLError, "display Surface quit");
+        if (newsurf->w != surf->w || newsurf->h != surf->h)
+            return RAISE(PyExc_ValueError,
+                         "Destination surface not the same size.");
+        if (newsurf->format->BytesPerPixel != bpp)
+            return RAISE(
+                PyExc_ValueError,
+                "Source and destination surfaces need the same format.");
+        if (!pgSurface_Unshare(newsurf))
+            return NULL;
+    }
+    else {
+        newsurf = newsurf_fromsurf(surf, surf->w, surf->h, NULL);
+        if (!newsurf)
+            return NULL;
+    }
 
-    /* make sure the area specified is within the Surface */
-    if ((x + width) > surf->w)
-        width = surf->w - x;
-    if ((y + height) > surf->h)
-        height = surf->h - y;
-    if (x < 0) {
-        width -= (-x);
-        x = 0;
+    if (surf->w && surf->h) {
+        SDL_LockSurface(newsurf);
+        pgSurface_Lock(surfobj);
+
+        Py_BEGIN_ALLOW_THREADS;
+        result = blur(surf, newsurf, radius, gaussian, repeat_edges);
+        Py_END_ALLOW_THREADS;
+
+        pgSurface_Unlock(surfobj);
+        SDL_UnlockSurface(newsurf);
     }
-    if (y < 0) {
-        height -= (-y);
-        y = 0;
+
+    if (result) {
+        if (!surfobj2)
+            SDL_FreeSurface(newsurf);
+        return PyErr_NoMemory();
     }
 
-    size = width * height;
-    width_and_x = width + x;
-    height_and_y = height + y;
+    if (surfobj2) {
+        Py_INCREF(surfobj2);
+        return surfobj2;
+    }
+    else
+        return (PyObject *)pgSurface_New(newsurf);
+}
 
-    if (consider_alpha) {
-        switch (format->BytesPerPixel) {
-            case 1: {
-                Uint8 color8;
-                for (row = y; row < height_and_y; row++) {
-                    pixels = (Uint8 *)surf->pixels + row * surf->pitch + x;
-                    for (col = x; col < width_and_x; col++) {
-                        color8 = *(Uint8 *)pixels;
-                        alpha = ((color8 & amask) >> ashift) << aloss;
-                        atot += alpha;
-                        rtot +=
-                            ((((color8 & rmask) >> rshift) << rloss) * alpha);
-                        gtot +=
-                            ((((color8 & gmask) >> gshift) << gloss) * alpha);
-                        btot +=
-                            ((((color8 & bmask) >> bshift) << bloss) * alpha);
-                        pixels++;
-                    }
+static PyObject *
+surf_box_blur(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    return blur_surface(args, kwargs, 0);
+}
+
+static PyObject *
+surf_gaussian_blur(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    return blur_surface(args, kwargs, 1);
+}
+
+typedef struct {
+    Uint8 *srcpix;
+    Uint8 *dstpix;
+    int srcpitch;
+    int dstpitch;
+    int width;
+    int height;
+    int bpp;
+    const float *kernel; /* kheight rows of kwidth weights */
+    int kwidth;
+    int kheight;
+    int repeat_edges;
+    Uint8 *scratch;
+    size_t bandsize;
+} ConvolvePass;
+
+/* Convolve rows [start, end) of one band. Each kernel row adds its
+ * weighted, shifted source row into a row of float accumulators, which
+ * keeps the inner loops contiguous for the compiler to vectorise.
+ */
+static void
+convolve_band(void *data, int band, int nbands)
+{
+    ConvolvePass *pass = (ConvolvePass *)data;
+    int start = (int)((long long)pass->height * band / nbands);
+    int end = (int)((long long)pass->height * (band + 1) / nbands);
+    int bpp = pass->bpp;
+    int rowbytes = pass->width * bpp;
+    float *accumulate = (float *)(pass->scratch + pass->bandsize * band);
+    Uint8 *pad = (Uint8 *)(accumulate + rowbytes);
+    int x, y, kx, ky;
+
+    for (y = start; y < end; y++) {
+        Uint8 *dst = pass->dstpix + (size_t)y * pass->dstpitch;
+
+        for (x = 0; x < rowbytes; x++) {
+            accumulate[x] = 0.0f;
+        }
+        for (ky = 0; ky < pass->kheight; ky++) {
+            const float *weights = pass->kernel + ky * pass->kwidth;
+            const Uint8 *row = blur_source_row(
+                pass->srcpix, pass->srcpitch, pass->height,
+                y + ky - pass->kheight / 2, pass->repeat_edges);
+
+            if (!row)
+                continue;
+            blur_pad_row(pad, row, pass->width, bpp, pass->kwidth / 2,
+                         pass->repeat_edges);
+            for (kx = 0; kx < pass->kwidth; kx++) {
+                const Uint8 *src = pad + kx * bpp;
+                float weight = weights[kx];
+
+                if (weight == 0.0f)
+                    continue;
+                for (x = 0; x < rowbytes; x++) {
+                    accumulate[x] += src[x] * weight;
                 }
-            } break;
-            case 2:
-                for (row = y; row < height_and_y; row++) {
-                    pixels = (Uint8 *)surf->pixels + row * surf->pitch + x * 2;
-                    for (col = x; col < width_and_x; col++) {
-                        color = (Uint32) * ((Uint16 *)pixels);
-                        alpha = ((color & amask) >> ashift) << aloss;
-                        atot += alpha;
-                        rtot +=
-                            ((((color & rmask) >> rshift) << rloss) * alpha);
-                        gtot +=
-                            ((((color & gmask) >> gshift) << gloss) * alpha);
-                        btot +=
-                            ((((color & bmask) >> bshift) << bloss) * alpha);
-                        pixels += 2;
-                    }
+            }
+        }
+        for (x = 0; x < rowbytes; x++) {
+            float value = accumulate[x] + 0.5f;
+
+            if (value <= 0.0f)
+                dst[x] = 0;
+            else if (value >= 255.0f)
+                dst[x] = 255;
+            else
+                dst[x] = (Uint8)value;
+        }
+    }
+}
+
+/* Convolve src into dst, which must not overlap it. Returns -1 on a
+ * memory error. */
+static int
+convolve(SDL_Surface *src, SDL_Surface *dst, const float *kernel,
+         int kwidth, int kheight, int repeat_edges)
+{
+    ConvolvePass pass;
+    int nbands = pg_GetNumThreads();
+    size_t rowbytes = (size_t)src->w * src->format->BytesPerPixel;
+
+    if (nbands < 2 ||
+        (long long)src->w * src->h * kwidth * kheight <
+            PG_PARALLEL_MIN_PIXELS) {
+        nbands = 1;
+    }
+    if (nbands > src->h) {
+        nbands = src->h;
+    }
+
+    pass.srcpix = (Uint8 *)src->pixels;
+    pass.dstpix = (Uint8 *)dst->pixels;
+    pass.srcpitch = src->pitch;
+    pass.dstpitch = dst->pitch;
+    pass.width = src->w;
+    pass.height = src->h;
+    pass.bpp = src->format->BytesPerPixel;
+    pass.kernel = kernel;
+    pass.kwidth = kwidth;
+    pass.kheight = kheight;
+    pass.repeat_edges = repeat_edges;
+    pass.bandsize = sizeof(float) * rowbytes + rowbytes +
+                    (size_t)(kwidth - 1) * pass.bpp;
+    pass.bandsize = (pass.bandsize + 63) & ~(size_t)63;
+    pass.scratch = (Uint8 *)malloc(pass.bandsize * nbands);
+    if (!pass.scratch)
+        return -1;
+
+    if (nbands > 1)
+        pg_ParallelFor(convolve_band, &pass, nbands);
+    else
+        convolve_band(&pass, 0, 1);
+
+    free(pass.scratch);
+    return 0;
+}
+
+/* Read a kernel given as a sequence of rows of numbers. Returns a new
+ * PyMem buffer of kheight * kwidth weights, or NULL with an exception.
+ */
+static float *
+convolve_kernel_from_obj(PyObject *obj, int *kwidth, int *kheight)
+{
+    PyObject *rows, *row;
+    float *kernel = NULL;
+    Py_ssize_t nrows, ncols = 0, i, j;
+
+    rows = PySequence_Fast(obj, "kernel must be a sequence of rows");
+    if (!rows)
+        return NULL;
+    nrows = PySequence_Fast_GET_SIZE(rows);
+
+    for (i = 0; i < nrows; i++) {
+        row = PySequence_Fast(PySequence_Fast_GET_ITEM(rows, i),
+                              "kernel must be a sequence of rows");
+        if (!row)
+            goto error;
+        if (!i) {
+            ncols = PySequence_Fast_GET_SIZE(row);
+            if (nrows % 2 == 0 || ncols % 2 == 0 ||
+                nrows > 2 * BLUR_MAX_RADIUS + 1 ||
+                ncols > 2 * BLUR_MAX_RADIUS + 1) {
+                Py_DECREF(row);
+                PyErr_Format(PyExc_ValueError,
+                             "kernel must have an odd number of rows and "
+                             "columns, at most %d",
+                             2 * BLUR_MAX_RADIUS + 1);
+                goto error;
+            }
+            kernel = (float *)PyMem_Malloc(sizeof(float) * nrows * ncols);
+            if (!kernel) {
+                Py_DECREF(row);
+                PyErr_NoMemory();
+                goto error;
+            }
+        }
+        else if (PySequence_Fast_GET_SIZE(row) != ncols) {
+            Py_DECREF(row);
+            PyErr_SetString(PyExc_ValueError,
+                            "kernel rows must all be the same length");
+            goto error;
+        }
+        for (j = 0; j < ncols; j++) {
+            double weight =
+                PyFloat_AsDouble(PySequence_Fast_GET_ITEM(row, j));
+
+            if (weight == -1.0 && PyErr_Occurred()) {
+                Py_DECREF(row);
+                goto error;
+            }
+            kernel[i * ncols + j] = (float)weight;
+        }
+        Py_DECREF(row);
+    }
+    if (!nrows) {
+        PyErr_SetString(PyExc_ValueError,
+                        "kernel must have an odd number of rows and columns");
+        goto error;
+    }
+
+    Py_DECREF(rows);
+    *kwidth = (int)ncols;
+    *kheight = (int)nrows;
+    return kernel;
+
+error:
+    Py_DECREF(rows);
+    PyMem_Free(kernel);
+    return NULL;
+}
+
+static PyObject *
+surf_convolve(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *surfobj2 = NULL;
+    PyObject *kernelobj;
+    SDL_Surface *surf, *newsurf;
+    float *kernel;
+    int kwidth, kheight, repeat_edges = 1, bpp, result = 0;
+    static char *keywords[] = {"surface", "kernel", "repeat_edge_pixels",
+                               "dest_surface", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|pO!", keywords,
+                                     &pgSurface_Type, &surfobj, &kernelobj,
+                                     &repeat_edges, &pgSurface_Type,
+                                     &surfobj2))
+        return NULL;
+
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+
+    bpp = surf->format->BytesPerPixel;
+    if (bpp < 3 || bpp > 4)
+        return RAISE(PyExc_ValueError,
+                     "Only 24-bit or 32-bit surfaces can be convolved");
+
+    if (surfobj2) {
+        newsurf = pgSurface_AsSurface(surfobj2);
+        if (!newsurf)
+            return RAISE(pgExc_SDLError, "display Surface quit");
+        if (_check_dest_surface(surf, newsurf, surf->w, surf->h))
+            return NULL;
+    }
+
+    kernel = convolve_kernel_from_obj(kernelobj, &kwidth, &kheight);
+    if (!kernel)
+        return NULL;
+
+    if (!surfobj2) {
+        newsurf = newsurf_fromsurf(surf, surf->w, surf->h, NULL);
+        if (!newsurf) {
+            PyMem_Free(kernel);
+            return NULL;
+        }
+    }
+
+    if (surf->w && surf->h) {
+        SDL_LockSurface(newsurf);
+        pgSurface_Lock(surfobj);
+
+        Py_BEGIN_ALLOW_THREADS;
+        result =
+            convolve(surf, newsurf, kernel, kwidth, kheight, repeat_edges);
+        Py_END_ALLOW_THREADS;
+
+        pgSurface_Unlock(surfobj);
+        SDL_UnlockSurface(newsurf);
+    }
+    PyMem_Free(kernel);
+
+    if (result) {
+        if (!surfobj2)
+            SDL_FreeSurface(newsurf);
+        return PyErr_NoMemory();
+    }
+
+    if (surfobj2) {
+        Py_INCREF(surfobj2);
+        return surfobj2;
+    }
+    else
+        return (PyObject *)pgSurface_New(newsurf);
+}
+
+typedef struct {
+    SDL_Surface **surfaces;
+    size_t num_surfaces;
+    SDL_Surface *destsurf;
+    int palette_colors;
+    int num_elements;
+    Uint32 *accumulate; /* num_elements sums per destination pixel */
+} AverageSurfacesPass;
+
+/* Add up rows ystart to yend - 1 of every surface and write their average
+ * to the same rows of the destination. */
+static void
+average_surfaces_rows(AverageSurfacesPass *pass, int ystart, int yend)
+{
+    SDL_Surface **surfaces = pass->surfaces;
+    SDL_Surface *destsurf = pass->destsurf;
+    size_t num_surfaces = pass->num_surfaces;
+    int palette_colors = pass->palette_colors;
+    int num_elements = pass->num_elements;
+    Uint32 *accumulate;
+    Uint32 *the_idx;
+    Uint32 the_color;
+    SDL_Surface *surf;
+    size_t surf_idx;
+    int width, x, y;
+
+    float div_inv;
+
+    SDL_PixelFormat *format, *destformat;
+    Uint8 *pixels, *destpixels;
+    Uint8 *pix;
+    Uint8 *byte_buf;
+
+    Uint32 rmask, gmask, bmask;
+    int rshift, gshift, bshift, rloss, gloss, bloss;
+
+    width = surfaces[0]->w;
+    accumulate =
+        pass->accumulate + (size_t)ystart * width * pass->num_elements;
+
+    destpixels = (Uint8 *)destsurf->pixels;
+    destformat = destsurf->format;
+
+    /* add up the r,g,b from all the surfaces. */
+
+    for (surf_idx = 0; surf_idx < num_surfaces; surf_idx++) {
+        surf = surfaces[surf_idx];
+
+        pixels = (Uint8 *)surf->pixels;
+        format = surf->format;
+        rmask = format->Rmask;
+        gmask = format->Gmask;
+        bmask = format->Bmask;
+        rshift = format->Rshift;
+        gshift = format->Gshift;
+        bshift = format->Bshift;
+        rloss = format->Rloss;
+        gloss = format->Gloss;
+        bloss = format->Bloss;
+
+        the_idx = accumulate;
+        /* If palette surface, we use a different code path... */
+
+        if ((format->BytesPerPixel == 1 && destformat->BytesPerPixel == 1) &&
+            (format->palette) && (destformat->palette) && (!palette_colors)) {
+            /*
+            This is useful if the surface is actually greyscale colors,
+            and not palette colors.
+            */
+            for (y = ystart; y < yend; y++) {
+                for (x = 0; x < width; x++) {
+                    SURF_GET_AT(the_color, surf, x, y, pixels, format, pix);
+                    *(the_idx) += the_color;
+                    the_idx++;
                 }
-                break;
-            case 3:
-                for (row = y; row < height_and_y; row++) {
-                    pixels = (Uint8 *)surf->pixels + row * surf->pitch + x * 3;
-                    for (col = x; col < width_and_x; col++) {
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                        color =
-                            (pixels[0]) + (pixels[1] << 8) + (pixels[2] << 16);
-#else
-                        color =
-                            (pixels[2]) + (pixels[1] << 8) + (pixels[0] << 16);
-#endif
-                        alpha = ((color & amask) >> ashift) << aloss;
-                        atot += alpha;
-                        rtot +=
-                            ((((color & rmask) >> rshift) << rloss) * alpha);
-                        gtot +=
-                            ((((color & gmask) >> gshift) << gloss) * alpha);
-                        btot +=
-                            ((((color & bmask) >> bshift) << bloss) * alpha);
-                        pixels += 3;
-                    }
+            }
+        }
+        else if (format->BytesPerPixel == 4) {
+            /* the common 32 bit case, reading whole rows directly */
+            for (y = ystart; y < yend; y++) {
+                Uint32 *row = (Uint32 *)(pixels + y * surf->pitch);
+
+                for (x = 0; x < width; x++) {
+                    the_color = row[x];
+                    the_idx[0] += ((the_color & rmask) >> rshift) << rloss;
+                    the_idx[1] += ((the_color & gmask) >> gshift) << gloss;
+                    the_idx[2] += ((the_color & bmask) >> bshift) << bloss;
+                    the_idx += 3;
                 }
-                break;
-            default: /* case 4: */
-                for (row = y; row < height_and_y; row++) {
-                    pixels = (Uint8 *)surf->pixels + row * surf->pitch + x * 4;
-                    for (col = x; col < width_and_x; col++) {
-                        color = *(Uint32 *)pixels;
-                        alpha = ((color & amask) >> ashift) << aloss;
-                        atot += alpha;
-                        rtot +=
-                            ((((color & rmask) >> rshift) << rloss) * alpha);
-                        gtot +=
-                            ((((color & gmask) >> gshift) << gloss) * alpha);
-                        btot +=
-                            ((((color & bmask) >> bshift) << bloss) * alpha);
-                        pixels += 4;
-                    }
+            }
+        }
+        else {
+            /* TODO: This doesn't work correctly for palette surfaces yet, when
+               the source is paletted.  Probably need to use something like
+               GET_PIXELVALS_1 from surface.h
+            */
+
+            /* for non palette surfaces, we do this... */
+            for (y = ystart; y < yend; y++) {
+                for (x = 0; x < width; x++) {
+                    SURF_GET_AT(the_color, surf, x, y, pixels, format, pix);
+
+                    *(the_idx) += ((the_color & rmask) >> rshift) << rloss;
+                    *(the_idx + 1) += ((the_color & gmask) >> gshift) << gloss;
+                    *(the_idx + 2) += ((the_color & bmask) >> bshift) << bloss;
+                    the_idx += 3;
+                }
+            }
+        }
+    }
+
+    /* blit the accumulated array back to the destination surface. */
+
+    div_inv = (float)(1.0L / (num_surfaces));
+
+    the_idx = accumulate;
+
+    if (num_elements == 1) {
+        /* this is where we are using the palette surface without using its
+        colors from the palette.
+        */
+        for (y = ystart; y < yend; y++) {
+            for (x = 0; x < width; x++) {
+                the_color = (Uint32)(*(the_idx)*div_inv + .5f);
+                SURF_SET_AT(the_color, destsurf, x, y, destpixels, destformat,
+                            byte_buf);
+                the_idx++;
+            }
+        }
+        /* TODO: will need to handle palette colors.
+         */
+    }
+    else {
+        for (y = ystart; y < yend; y++) {
+            for (x = 0; x < width; x++) {
+                the_color =
+                    SDL_MapRGB(destformat, (Uint8)(*(the_idx)*div_inv + .5f),
+                               (Uint8)(*(the_idx + 1) * div_inv + .5f),
+                               (Uint8)(*(the_idx + 2) * div_inv + .5f));
+
+                /* TODO: should it take into consideration the output
+                    shifts/masks/losses?  Or does SDL_MapRGB do that correctly?
+
+                    *(the_idx) += ((the_color & rmask) >> rshift) << rloss;
+                    *(the_idx + 1) += ((the_color & gmask) >> gshift) << gloss;
+                    *(the_idx + 2) += ((the_color & bmask) >> bshift) << bloss;
+                */
+
+                SURF_SET_AT(the_color, destsurf, x, y, destpixels, destformat,
+                            byte_buf);
+
+                the_idx += 3;
+            }
+        }
+    }
+}
+
+static void
+average_surfaces_band(void *data, int band, int nbands)
+{
+    AverageSurfacesPass *pass = (AverageSurfacesPass *)data;
+    int height = pass->surfaces[0]->h;
+
+    average_surfaces_rows(pass, (int)((long long)height * band / nbands),
+                          (int)((long long)height * (band + 1) / nbands));
+}
+
+int
+average_surfaces(SDL_Surface **surfaces, size_t num_surfaces,
+                 SDL_Surface *destsurf, int palette_colors)
+{
+    /*
+        returns the average surface from the ones given.
+
+        All surfaces need to be the same size.
+
+        palette_colors - if true we average the colors in palette, otherwise we
+            average the pixel values.  This is useful if the surface is
+            actually greyscale colors, and not palette colors.
+
+        Large jobs are split into bands of rows over the worker pool. Each
+        band adds up its rows of every surface, so the work per band grows
+        with the number of surfaces while the sums stay exact.
+    */
+
+    AverageSurfacesPass pass;
+    SDL_PixelFormat *destformat;
+    int height, width, nbands;
+    int num_elements;
+
+    if (!num_surfaces) {
+        return 0;
+    }
+
+    height = surfaces[0]->h;
+    width = surfaces[0]->w;
+
+    destformat = destsurf->format;
+
+    /* allocate an array to accumulate them all.
+
+    If we're using 1 byte per pixel, then only need to average on that much.
+    */
+
+    if ((destformat->BytesPerPixel == 1) && (destformat->palette) &&
+        (!palette_colors)) {
+        num_elements = 1;
+    }
+    else {
+        num_elements = 3;
+    }
+
+    pass.accumulate =
+        (Uint32 *)calloc(1, sizeof(Uint32) * height * width * num_elements);
+
+    if (!pass.accumulate) {
+        return -1;
+    }
+
+    pass.surfaces = surfaces;
+    pass.num_surfaces = num_surfaces;
+    pass.destsurf = destsurf;
+    pass.palette_colors = palette_colors;
+    pass.num_elements = num_elements;
+
+    nbands = pg_GetNumThreads();
+    if (nbands > height) {
+        nbands = height;
+    }
+    if (nbands < 2 || (long long)width * height * num_surfaces <
+                          PG_PARALLEL_MIN_PIXELS) {
+        average_surfaces_rows(&pass, 0, height);
+    }
+    else {
+        pg_ParallelFor(average_surfaces_band, &pass, nbands);
+    }
+
+    free(pass.accumulate);
+
+    return 1;
+}
+
+/*
+    returns the average surface from the ones given.
+
+    All surfaces need to be the same size.
+
+    palette_colors - if true we average the colors in palette, otherwise we
+        average the pixel values.  This is useful if the surface is
+        actually greyscale colors, and not palette colors.
+
+*/
+static PyObject *
+surf_average_surfaces(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *surfobj2 = NULL;
+    SDL_Surface *surf;
+    SDL_Surface *newsurf = NULL;
+    SDL_Surface **surfaces;
+    int width, height;
+    int an_error = 0;
+    size_t size, loop, loop_up_to;
+    int palette_colors = 1;
+    PyObject *list, *obj;
+    PyObject *ret = NULL;
+    static char *keywords[] = {"surfaces", "dest_surface", "palette_colors",
+                               NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O!i", keywords, &list,
+                                     &pgSurface_Type, &surfobj2,
+                                     &palette_colors))
+        return NULL;
+
+    if (!PySequence_Check(list))
+        return RAISE(PyExc_TypeError,
+                     "Argument must be a sequence of surface objects.");
+
+    size = PySequence_Length(list); /*warning, size could be -1 on error?*/
+
+    if (size < 1)
+        return RAISE(PyExc_TypeError,
+                     "Needs to be given at least one surface.");
+
+    /* Allocate an array of surface pointers. */
+
+    surfaces = (SDL_Surface **)calloc(1, sizeof(SDL_Surface *) * size);
+
+    if (!surfaces) {
+        return RAISE(PyExc_MemoryError,
+                     "Not enough memory to store surfaces.\n");
+    }
+
+    /* Iterate over 'surfaces' passed in. */
+
+    /* need to get the first surface to see how big it is */
+
+    for (loop = 0; loop < size; ++loop) {
+        obj = PySequence_GetItem(list, loop);
+
+        if (!obj) {
+            Py_XDECREF(obj);
+            ret = RAISE(PyExc_TypeError, "Needs to be a surface object.");
+            an_error = 1;
+            break;
+        }
+
+        if (!pgSurface_Check(obj)) {
+            Py_XDECREF(obj);
+            ret = RAISE(PyExc_TypeError, "Needs to be a surface object.");
+            an_error = 1;
+            break;
+        }
+
+        surf = pgSurface_AsSurface(obj);
+
+        if (!surf) {
+            Py_XDECREF(obj);
+            ret = RAISE(PyExc_TypeError, "Needs to be a surface object.");
+            an_error = 1;
+            break;
+        }
+        if (!pgSurface_Unpack(surf)) {
+            Py_XDECREF(obj);
+            an_error = 1;
+            break;
+        }
+
+        if (loop == 0) {
+            /* if the second surface is not there, then make a new one. */
+            if (!surfobj2) {
+                width = surf->w;
+                height = surf->h;
+
+                newsurf = newsurf_fromsurf(surf, width, height, NULL);
+
+                if (!newsurf) {
+                    Py_XDECREF(obj);
+                    ret = RAISE(PyExc_ValueError,
+                                "Could not create new surface.");
+                    an_error = 1;
+                    break;
                 }
+            }
+            else
+                newsurf = pgSurface_AsSurface(surfobj2);
+
+            /* check to see if the size is the correct size. */
+            if (newsurf->w != (surf->w) || newsurf->h != (surf->h)) {
+                Py_XDECREF(obj);
+                ret = RAISE(PyExc_ValueError,
+                            "Destination surface not the same size.");
+                an_error = 1;
+                break;
+            }
+
+            /* check to see if the format of the surface is the same. */
+            if (surf->format->BytesPerPixel !=
+                newsurf->format->BytesPerPixel) {
+                Py_XDECREF(obj);
+                ret = RAISE(
+                    PyExc_ValueError,
+                    "Source and destination surfaces need the same format.");
+                an_error = 1;
+                break;
+            }
+            if (!pgSurface_Unshare(newsurf)) {
+                Py_XDECREF(obj);
+                ret = NULL;
+                an_error = 1;
                 break;
+            }
+        }
+
+        /* Copy surface pointer, and also lock surface. */
+        SDL_LockSurface(surf);
+        surfaces[loop] = surf;
+
+        Py_DECREF(obj);
+    }
+
+    loop_up_to = loop;
+
+    if (!an_error) {
+        /* Process images, get average surface. */
+
+        SDL_LockSurface(newsurf);
+
+        Py_BEGIN_ALLOW_THREADS;
+        average_surfaces(surfaces, size, newsurf, palette_colors);
+        Py_END_ALLOW_THREADS;
+
+        SDL_UnlockSurface(newsurf);
+
+        if (surfobj2) {
+            Py_INCREF(surfobj2);
+            ret = surfobj2;
+        }
+        else {
+            ret = (PyObject *)pgSurface_New(newsurf);
+        }
+    }
+
+    /* cleanup */
+
+    /* unlock the surfaces we got up to. */
+
+    for (loop = 0; loop < loop_up_to; loop++) {
+        if (surfaces[loop]) {
+            SDL_UnlockSurface(surfaces[loop]);
+        }
+    }
+
+    free(surfaces);
+
+    return ret;
+}
+
+/* VS 2015 crashes when compiling this function, turning off optimisations to
+ try to fix it */
+#if defined(_MSC_VER) && (_MSC_VER == 1900)
+#pragma optimize("", off)
+#endif
+
+/* When GCC compiles the following function with -O3 on PPC64 little endian,
+ * the function gives incorrect output with 24-bit surfaces. This is most
+ * likely a compiler bug, see #2876 for related issue.
+ * So turn optimisations off here */
+#if defined(__GNUC__) && defined(__PPC64__)
+#pragma GCC push_options
+#pragma GCC optimize("O0")
+#endif
+
+typedef struct {
+    SDL_Surface *surf;
+    int x;
+    int width;
+    int y;
+    int height;
+    SDL_bool consider_alpha;
+    int simd;
+    unsigned int tot[REDUCE_MAX_BANDS][4]; /* r, g, b, a sums per band */
+} AverageColorPass;
+
+#ifdef TRANSFORM_SIMD
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define _BYTE_OF_SHIFT(shift) ((shift) >> 3)
+#else
+#define _BYTE_OF_SHIFT(shift) (3 - ((shift) >> 3))
+#endif
+
+/* average_color() sums for a width that is a multiple of four, over a 32
+ * bit surface keeping each channel in a whole byte. Sums wrap at 32 bits
+ * just like the scalar ones, so adding them up in another order gives the
+ * same totals.
+ */
+static void
+average_color_sums32_sse2(SDL_Surface *surf, int x, int width, int ystart,
+                          int yend, SDL_bool consider_alpha,
+                          unsigned int tot[4])
+{
+    SDL_PixelFormat *format = surf->format;
+    int rbyte = _BYTE_OF_SHIFT(format->Rshift);
+    int gbyte = _BYTE_OF_SHIFT(format->Gshift);
+    int bbyte = _BYTE_OF_SHIFT(format->Bshift);
+    int abyte = format->Amask ? _BYTE_OF_SHIFT(format->Ashift) : -1;
+    __m128i zero = _mm_setzero_si128();
+    __m128i bytemask = _mm_set1_epi32(0xff);
+    __m128i ashift = _mm_cvtsi32_si128(format->Ashift);
+    __m128i acc = zero, wacc = zero;
+    Uint32 sums[4], wsums[4];
+    int row, col;
+
+    for (row = ystart; row < yend; row++) {
+        Uint8 *pixels = (Uint8 *)surf->pixels + row * surf->pitch + x * 4;
+
+        for (col = 0; col < width; col += 4, pixels += 16) {
+            __m128i px = _mm_loadu_si128((const __m128i *)pixels);
+            __m128i lo = _mm_unpacklo_epi8(px, zero);
+            __m128i hi = _mm_unpackhi_epi8(px, zero);
+            __m128i pairs = _mm_add_epi16(lo, hi);
+
+            acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(pairs, zero));
+            acc = _mm_add_epi32(acc, _mm_unpackhi_epi16(pairs, zero));
+            if (consider_alpha) {
+                /* each pixel's alpha across its four 16 bit lanes */
+                __m128i alpha =
+                    _mm_and_si128(_mm_srl_epi32(px, ashift), bytemask);
+                __m128i wlo, whi;
+
+                alpha = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+                wlo = _mm_mullo_epi16(lo, _mm_unpacklo_epi32(alpha, alpha));
+                whi = _mm_mullo_epi16(hi, _mm_unpackhi_epi32(alpha, alpha));
+                wacc = _mm_add_epi32(wacc, _mm_unpacklo_epi16(wlo, zero));
+                wacc = _mm_add_epi32(wacc, _mm_unpackhi_epi16(wlo, zero));
+                wacc = _mm_add_epi32(wacc, _mm_unpacklo_epi16(whi, zero));
+                wacc = _mm_add_epi32(wacc, _mm_unpackhi_epi16(whi, zero));
+            }
+        }
+    }
+
+    _mm_storeu_si128((__m128i *)sums, acc);
+    _mm_storeu_si128((__m128i *)wsums, wacc);
+    if (consider_alpha) {
+        tot[0] += wsums[rbyte];
+        tot[1] += wsums[gbyte];
+        tot[2] += wsums[bbyte];
+        tot[3] += sums[abyte];
+    }
+    else {
+        tot[0] += sums[rbyte];
+        tot[1] += sums[gbyte];
+        tot[2] += sums[bbyte];
+        tot[3] += abyte < 0 ? 0 : sums[abyte];
+    }
+}
+
+#undef _BYTE_OF_SHIFT
+#endif /* TRANSFORM_SIMD */
+
+/* Add up the channels of rows ystart to yend - 1 of the clipped area, as
+ * average_color() needs them. With consider_alpha the colour sums are
+ * weighted by alpha.
+ */
+static void
+average_color_rows(AverageColorPass *pass, int ystart, int yend,
+                   unsigned int tot[4])
+{
+    SDL_Surface *surf = pass->surf;
+    Uint32 color, rmask, gmask, bmask, amask;
+    Uint8 *pixels;
+    unsigned int rtot, gtot, btot, atot, rshift, gshift, bshift, ashift,
+        alpha;
+    unsigned int rloss, gloss, bloss, aloss;
+    int row, col, xstart, width_and_x;
+
+    SDL_PixelFormat *format;
+
+    format = surf->format;
+    rmask = format->Rmask;
+    gmask = format->Gmask;
+    bmask = format->Bmask;
+    amask = format->Amask;
+    rshift = format->Rshift;
+    gshift = format->Gshift;
+    bshift = format->Bshift;
+    ashift = format->Ashift;
+    rloss = format->Rloss;
+    gloss = format->Gloss;
+    bloss = format->Bloss;
+    aloss = format->Aloss;
+    rtot = gtot = btot = atot = 0;
+
+    xstart = pass->x;
+    width_and_x = pass->width + pass->x;
+#ifdef TRANSFORM_SIMD
+    if (pass->simd) {
+        average_color_sums32_sse2(surf, pass->x, pass->width & ~3, ystart,
+                                  yend, pass->consider_alpha, tot);
+        xstart += pass->width & ~3;
+    }
+#endif /* TRANSFORM_SIMD */
+
+    if (pass->consider_alpha) {
+        switch (format->BytesPerPixel) {
+            case 1: {
+                Uint8 color8;
+                for (row = ystart; row < yend; row++) {
+                    pixels =
+                        (Uint8 *)surf->pixels + row * surf->pitch + xstart;
+                    for (col = xstart; col < width_and_x; col++) {
+                        color8 = *(Uint8 *)pixels;
+                        alpha = ((color8 & amask) >> ashift) << aloss;
+                        atot += alpha;
+                        rtot +=
+                            ((((color8 & rmask) >> rshift) << rloss) * alpha);
+                        gtot +=
+                            ((((color8 & gmask) >> gshift) << gloss) * alpha);
+                        btot +=
+                            ((((color8 & bmask) >> bshift) << bloss) * alpha);
+                        pixels++;
+                    }
+                }
+            } break;
+            case 2:
+                for (row = ystart; row < yend; row++) {
+                    pixels =
+                        (Uint8 *)surf->pixels + row * surf->pitch + xstart * 2;
+                    for (col = xstart; col < width_and_x; col++) {
+                        color = (Uint32) * ((Uint16 *)pixels);
+                        alpha = ((color & amask) >> ashift) << aloss;
+                        atot += alpha;
+                        rtot +=
+                            ((((color & rmask) >> rshift) << rloss) * alpha);
+                        gtot +=
+                            ((((color & gmask) >> gshift) << gloss) * alpha);
+                        btot +=
+                            ((((color & bmask) >> bshift) << bloss) * alpha);
+                        pixels += 2;
+                    }
+                }
+                break;
+            case 3:
+                for (row = ystart; row < yend; row++) {
+                    pixels =
+                        (Uint8 *)surf->pixels + row * surf->pitch + xstart * 3;
+                    for (col = xstart; col < width_and_x; col++) {
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+                        color =
+                            (pixels[0]) + (pixels[1] << 8) + (pixels[2] << 16);
+#else
+                        color =
+                            (pixels[2]) + (pixels[1] << 8) + (pixels[0] << 16);
+#endif
+                        alpha = ((color & amask) >> ashift) << aloss;
+                        atot += alpha;
+                        rtot +=
+                            ((((color & rmask) >> rshift) << rloss) * alpha);
+                        gtot +=
+                            ((((color & gmask) >> gshift) << gloss) * alpha);
+                        btot +=
+                            ((((color & bmask) >> bshift) << bloss) * alpha);
+                        pixels += 3;
+                    }
+                }
+                break;
+            default: /* case 4: */
+                for (row = ystart; row < yend; row++) {
+                    pixels =
+                        (Uint8 *)surf->pixels + row * surf->pitch + xstart * 4;
+                    for (col = xstart; col < width_and_x; col++) {
+                        color = *(Uint32 *)pixels;
+                        alpha = ((color & amask) >> ashift) << aloss;
+                        atot += alpha;
+                        rtot +=
+                            ((((color & rmask) >> rshift) << rloss) * alpha);
+                        gtot +=
+                            ((((color & gmask) >> gshift) << gloss) * alpha);
+                        btot +=
+                            ((((color & bmask) >> bshift) << bloss) * alpha);
+                        pixels += 4;
+                    }
+                }
+                break;
+        }
+    }
+    else {
+        switch (format->BytesPerPixel) {
+            case 1: {
+                Uint8 color8;
+                for (row = ystart; row < yend; row++) {
+                    pixels =
+                        (Uint8 *)surf->pixels + row * surf->pitch + xstart;
+                    for (col = xstart; col < width_and_x; col++) {
+                        color8 = *(Uint8 *)pixels;
+                        rtot += ((color8 & rmask) >> rshift) << rloss;
+                        gtot += ((color8 & gmask) >> gshift) << gloss;
+                        btot += ((color8 & bmask) >> bshift) << bloss;
+                        atot += ((color8 & amask) >> ashift) << aloss;
+                        pixels++;
+                    }
+                }
+            } break;
+            case 2:
+                for (row = ystart; row < yend; row++) {
+                    pixels =
+                        (Uint8 *)surf->pixels + row * surf->pitch + xstart * 2;
+                    for (col = xstart; col < width_and_x; col++) {
+                        color = (Uint32) * ((Uint16 *)pixels);
+                        rtot += ((color & rmask) >> rshift) << rloss;
+                        gtot += ((color & gmask) >> gshift) << gloss;
+                        btot += ((color & bmask) >> bshift) << bloss;
+                        atot += ((color & amask) >> ashift) << aloss;
+                        pixels += 2;
+                    }
+                }
+                break;
+            case 3:
+                for (row = ystart; row < yend; row++) {
+                    pixels =
+                        (Uint8 *)surf->pixels + row * surf->pitch + xstart * 3;
+                    for (col = xstart; col < width_and_x; col++) {
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+                        color =
+                            (pixels[0]) + (pixels[1] << 8) + (pixels[2] << 16);
+#else
+                        color =
+                            (pixels[2]) + (pixels[1] << 8) + (pixels[0] << 16);
+#endif
+                        rtot += ((color & rmask) >> rshift) << rloss;
+                        gtot += ((color & gmask) >> gshift) << gloss;
+                        btot += ((color & bmask) >> bshift) << bloss;
+                        atot += ((color & amask) >> ashift) << aloss;
+                        pixels += 3;
+                    }
+                }
+                break;
+            default: /* case 4: */
+                for (row = ystart; row < yend; row++) {
+                    pixels =
+                        (Uint8 *)surf->pixels + row * surf->pitch + xstart * 4;
+                    for (col = xstart; col < width_and_x; col++) {
+                        color = *(Uint32 *)pixels;
+                        rtot += ((color & rmask) >> rshift) << rloss;
+                        gtot += ((color & gmask) >> gshift) << gloss;
+                        btot += ((color & bmask) >> bshift) << bloss;
+                        atot += ((color & amask) >> ashift) << aloss;
+                        pixels += 4;
+                    }
+                }
+                break;
+        }
+    }
+    tot[0] += rtot;
+    tot[1] += gtot;
+    tot[2] += btot;
+    tot[3] += atot;
+}
+
+static void
+average_color_band(void *data, int band, int nbands)
+{
+    AverageColorPass *pass = (AverageColorPass *)data;
+    int ystart = pass->y + (int)((long long)pass->height * band / nbands);
+    int yend = pass->y + (int)((long long)pass->height * (band + 1) / nbands);
+
+    memset(pass->tot[band], 0, sizeof(pass->tot[band]));
+    average_color_rows(pass, ystart, yend, pass->tot[band]);
+}
+
+void
+average_color(SDL_Surface *surf, int x, int y, int width, int height, Uint8 *r,
+              Uint8 *g, Uint8 *b, Uint8 *a, SDL_bool consider_alpha)
+{
+    AverageColorPass pass;
+    SDL_PixelFormat *format = surf->format;
+    unsigned int rtot, gtot, btot, atot, size;
+    int band, nbands;
+
+    /* make sure the area specified is within the Surface */
+    if ((x + width) > surf->w)
+        width = surf->w - x;
+    if ((y + height) > surf->h)
+        height = surf->h - y;
+    if (x < 0) {
+        width -= (-x);
+        x = 0;
+    }
+    if (y < 0) {
+        height -= (-y);
+        y = 0;
+    }
+
+    size = width * height;
+
+    pass.surf = surf;
+    pass.x = x;
+    pass.y = y;
+    pass.width = width;
+    pass.height = height;
+    pass.consider_alpha = consider_alpha;
+    pass.simd = _use_simd() && _rgb_in_bytes32(format) &&
+                (format->Amask ? (format->Aloss == 0 &&
+                                  format->Ashift % 8 == 0)
+                               : !consider_alpha);
+
+    /* Every band sums its own rows; the totals do not depend on how the
+     * rows were split */
+    nbands = MIN(pg_GetNumThreads(), REDUCE_MAX_BANDS);
+    if (nbands > height) {
+        nbands = height;
+    }
+    if (nbands < 2 || width <= 0 ||
+        (long long)width * height < PG_PARALLEL_MIN_PIXELS) {
+        nbands = 1;
+        average_color_band(&pass, 0, 1);
+    }
+    else {
+        pg_ParallelFor(average_color_band, &pass, nbands);
+    }
+    rtot = gtot = btot = atot = 0;
+    for (band = 0; band < nbands; band++) {
+        rtot += pass.tot[band][0];
+        gtot += pass.tot[band][1];
+        btot += pass.tot[band][2];
+        atot += pass.tot[band][3];
+    }
+
+    if (consider_alpha) {
+        *a = atot / size;
+        size = (atot == 0 ? size : atot);
+        *r = rtot / size;
+        *g = gtot / size;
+        *b = btot / size;
+    }
+    else {
+        *r = rtot / size;
+        *g = gtot / size;
+        *b = btot / size;
+        *a = atot / size;
+    }
+}
+
+/* Optimisation was only disabled for one function - see above */
+#if defined(_MSC_VER) && (_MSC_VER == 1900)
+#pragma optimize("", on)
+#endif
+
+/* Optimisation was only disabled for one function on GCC+PPC64 - see above */
+#if defined(__GNUC__) && defined(__PPC64__)
+#pragma GCC pop_options
+#endif
+
+static PyObject *
+surf_average_color(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *rectobj = NULL;
+    SDL_Surface *surf;
+    SDL_Rect *rect, temp;
+    Uint8 r, g, b, a;
+    int x, y, w, h;
+    static char *keywords[] = {"surface", "rect", "consider_alpha", NULL};
+    SDL_bool consider_alpha = SDL_FALSE;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|Op", keywords,
+                                     &pgSurface_Type, &surfobj, &rectobj,
+                                     &consider_alpha))
+        return NULL;
+
+    surf = pgSurface_AsSurface(surfobj);
+    pgSurface_Lock(surfobj);
+
+    if (!rectobj) {
+        x = 0;
+        y = 0;
+        w = surf->w;
+        h = surf->h;
+    }
+    else {
+        if (!(rect = pgRect_FromObject(rectobj, &temp)))
+            return RAISE(PyExc_TypeError, "Rect argument is invalid");
+        x = rect->x;
+        y = rect->y;
+        w = rect->w;
+        h = rect->h;
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    average_color(surf, x, y, w, h, &r, &g, &b, &a, consider_alpha);
+    Py_END_ALLOW_THREADS;
+
+    pgSurface_Unlock(surfobj);
+    return Py_BuildValue("(bbbb)", r, g, b, a);
+}
+
+/*
+ * histogram and get_stats: reductions over an area of a surface, split
+ * into bands of rows like average_color(). Each band keeps partial
+ * results of its own, merged once every band is done.
+ *
+ * Both read rows of 4 byte pixels with R, G, B and A at known bytes: the
+ * rows of a 32 bit surface that keeps its channels in whole bytes, or
+ * rows of any other surface unpacked to RGBA.
+ */
+
+/* R, G, B, A and luminance */
+#define STATS_CHANNELS 5
+
+typedef struct {
+    Uint64 sum[STATS_CHANNELS];
+    int min[STATS_CHANNELS];
+    int max[STATS_CHANNELS];
+} StatsBand;
+
+typedef struct {
+    SDL_Surface *surf;
+    int x;
+    int y;
+    int width;
+    int height;
+    int offsets[4]; /* bytes of R, G, B and A in the rows read */
+    Uint32 fill;    /* set in every pixel read: the unused byte of xRGB */
+    int direct;     /* rows are read from the surface as they are */
+    int simd;
+    Uint8 *scratch; /* 4 * width bytes a band, to unpack rows to */
+    StatsBand bands[REDUCE_MAX_BANDS];
+    Uint32 *counts; /* histogram: STATS_CHANNELS * 256 counts a band */
+} StatsPass;
+
+static void
+stats_pass_init(StatsPass *pass, SDL_Surface *surf, SDL_Rect *area)
+{
+    SDL_PixelFormat *format = surf->format;
+
+    memset(pass, 0, sizeof(*pass));
+    pass->surf = surf;
+    pass->x = area->x;
+    pass->y = area->y;
+    pass->width = area->w;
+    pass->height = area->h;
+    pass->direct = _rgb_in_bytes32(format) &&
+                   (!format->Amask ||
+                    (format->Aloss == 0 && format->Ashift % 8 == 0));
+    if (pass->direct) {
+        pass->offsets[0] = edge_byte_offset(format->Rshift, 4);
+        pass->offsets[1] = edge_byte_offset(format->Gshift, 4);
+        pass->offsets[2] = edge_byte_offset(format->Bshift, 4);
+        if (format->Amask) {
+            pass->offsets[3] = edge_byte_offset(format->Ashift, 4);
+        }
+        else {
+            /* the one byte left, read as an opaque alpha like get_at() */
+            pass->offsets[3] = 6 - pass->offsets[0] - pass->offsets[1] -
+                               pass->offsets[2];
+            pass->fill = ~(format->Rmask | format->Gmask | format->Bmask);
+        }
+    }
+    else {
+        pass->offsets[0] = 0;
+        pass->offsets[1] = 1;
+        pass->offsets[2] = 2;
+        pass->offsets[3] = 3;
+    }
+    pass->simd = _use_simd();
+}
+
+/* Row y of the area as 4 byte pixels, unpacked into rgba when the
+ * surface can not be read as it is. */
+static const Uint8 *
+stats_row(StatsPass *pass, int y, Uint8 *rgba)
+{
+    SDL_Surface *surf = pass->surf;
+    SDL_PixelFormat *format = surf->format;
+    int bpp = format->BytesPerPixel;
+    Uint8 *pixels = (Uint8 *)surf->pixels + (size_t)y * surf->pitch +
+                    (size_t)pass->x * bpp;
+    Uint8 *dst = rgba;
+    Uint32 color;
+    int x;
+
+    if (pass->direct)
+        return pixels;
+
+    if (bpp == 3) {
+        int roff = edge_byte_offset(format->Rshift, 3);
+        int goff = edge_byte_offset(format->Gshift, 3);
+        int boff = edge_byte_offset(format->Bshift, 3);
+
+        for (x = 0; x < pass->width; x++, pixels += 3, dst += 4) {
+            dst[0] = pixels[roff];
+            dst[1] = pixels[goff];
+            dst[2] = pixels[boff];
+            dst[3] = 255;
+        }
+        return rgba;
+    }
+    for (x = 0; x < pass->width; x++, pixels += bpp, dst += 4) {
+        switch (bpp) {
+            case 1:
+                color = *pixels;
+                break;
+            case 2:
+                color = *(Uint16 *)pixels;
+                break;
+            default:
+                color = *(Uint32 *)pixels;
+                break;
+        }
+        SDL_GetRGBA(color, format, dst, dst + 1, dst + 2, dst + 3);
+    }
+    return rgba;
+}
+
+/* Add a row of 4 byte pixels to the sums, minimums and maximums of band */
+static void
+stats_reduce_row(StatsPass *pass, const Uint8 *pixels, StatsBand *band)
+{
+    const int *offsets = pass->offsets;
+    int width = pass->width;
+    int x = 0, i;
+
+#ifdef TRANSFORM_SIMD
+    if (pass->simd && width >= 4) {
+        __m128i zero = _mm_setzero_si128();
+        __m128i fill = _mm_set1_epi32((int)pass->fill);
+        __m128i vmin = _mm_set1_epi8((char)0xff), vmax = zero;
+        __m128i lmin = _mm_set1_epi16(255), lmax = zero;
+        __m128i acc = zero, lacc = zero, round = _mm_set1_epi32(128);
+        __m128i weights;
+        Sint16 w[8] = {0};
+        Uint8 bytes[16];
+        Uint32 sums[4];
+        Sint16 lows[8], highs[8];
+
+        /* the luminance weights at the bytes of R, G and B of two pixels */
+        w[offsets[0]] = w[offsets[0] + 4] = 77;
+        w[offsets[1]] = w[offsets[1] + 4] = 150;
+        w[offsets[2]] = w[offsets[2] + 4] = 29;
+        weights = _mm_loadu_si128((const __m128i *)w);
+
+        for (; x + 4 <= width; x += 4) {
+            __m128i px = _mm_or_si128(
+                _mm_loadu_si128((const __m128i *)(pixels + x * 4)), fill);
+            __m128i lo = _mm_unpacklo_epi8(px, zero);
+            __m128i hi = _mm_unpackhi_epi8(px, zero);
+            __m128i pairs = _mm_add_epi16(lo, hi);
+            __m128 halves_lo = _mm_castsi128_ps(_mm_madd_epi16(lo, weights));
+            __m128 halves_hi = _mm_castsi128_ps(_mm_madd_epi16(hi, weights));
+            __m128i level;
+
+            vmin = _mm_min_epu8(vmin, px);
+            vmax = _mm_max_epu8(vmax, px);
+            acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(pairs, zero));
+            acc = _mm_add_epi32(acc, _mm_unpackhi_epi16(pairs, zero));
+
+            /* each madd gives two halves of the weighted sum of a pixel */
+            level = _mm_add_epi32(
+                _mm_castps_si128(_mm_shuffle_ps(halves_lo, halves_hi,
+                                                _MM_SHUFFLE(2, 0, 2, 0))),
+                _mm_castps_si128(_mm_shuffle_ps(halves_lo, halves_hi,
+                                                _MM_SHUFFLE(3, 1, 3, 1))));
+            level = _mm_srli_epi32(_mm_add_epi32(level, round), 8);
+            lacc = _mm_add_epi32(lacc, level);
+            level = _mm_packs_epi32(level, level);
+            lmin = _mm_min_epi16(lmin, level);
+            lmax = _mm_max_epi16(lmax, level);
+        }
+
+        _mm_storeu_si128((__m128i *)sums, acc);
+        for (i = 0; i < 4; i++) {
+            band->sum[i] += sums[offsets[i]];
+        }
+        _mm_storeu_si128((__m128i *)sums, lacc);
+        band->sum[4] += (Uint64)sums[0] + sums[1] + sums[2] + sums[3];
+
+        _mm_storeu_si128((__m128i *)bytes, vmin);
+        for (i = 0; i < 16; i++) {
+            int *min = &band->min[i & 3];
+
+            *min = MIN(*min, bytes[(i & ~3) + offsets[i & 3]]);
+        }
+        _mm_storeu_si128((__m128i *)bytes, vmax);
+        for (i = 0; i < 16; i++) {
+            int *max = &band->max[i & 3];
+
+            *max = MAX(*max, bytes[(i & ~3) + offsets[i & 3]]);
+        }
+        _mm_storeu_si128((__m128i *)lows, lmin);
+        _mm_storeu_si128((__m128i *)highs, lmax);
+        for (i = 0; i < 4; i++) {
+            band->min[4] = MIN(band->min[4], lows[i]);
+            band->max[4] = MAX(band->max[4], highs[i]);
+        }
+    }
+#endif /* TRANSFORM_SIMD */
+    for (; x < width; x++) {
+        const Uint8 *px = pixels + x * 4;
+        int values[STATS_CHANNELS];
+
+        values[0] = px[offsets[0]];
+        values[1] = px[offsets[1]];
+        values[2] = px[offsets[2]];
+        values[3] = pass->fill ? 255 : px[offsets[3]];
+        values[4] = _LUMINANCE(values[0], values[1], values[2]);
+        for (i = 0; i < STATS_CHANNELS; i++) {
+            band->sum[i] += values[i];
+            band->min[i] = MIN(band->min[i], values[i]);
+            band->max[i] = MAX(band->max[i], values[i]);
+        }
+    }
+}
+static void
+stats_band(void *data, int band, int nbands)
+{
+    StatsPass *pass = (StatsPass *)data;
+    StatsBand *result = &pass->bands[band];
+    Uint8 *rgba = pass->scratch + (size_t)band * pass->width * 4;
+    int ystart = pass->y + (int)((long long)pass->height * band / nbands);
+    int yend = pass->y + (int)((long long)pass->height * (band + 1) / nbands);
+    int i, y;
+
+    for (i = 0; i < STATS_CHANNELS; i++) {
+        result->sum[i] = 0;
+        result->min[i] = 255;
+        result->max[i] = 0;
+    }
+    for (y = ystart; y < yend; y++) {
+        stats_reduce_row(pass, stats_row(pass, y, rgba), result);
+    }
+}
+
+/* Count the values of every channel in the rows of a band, into 256
+ * counts for each channel. A scatter of counts does not vectorise, so this
+ * is only split across threads. */
+static void
+histogram_band(void *data, int band, int nbands)
+{
+    StatsPass *pass = (StatsPass *)data;
+    Uint32 *counts = pass->counts + (size_t)band * STATS_CHANNELS * 256;
+    Uint8 *rgba = pass->scratch + (size_t)band * pass->width * 4;
+    const int *offsets = pass->offsets;
+    int ystart = pass->y + (int)((long long)pass->height * band / nbands);
+    int yend = pass->y + (int)((long long)pass->height * (band + 1) / nbands);
+    int x, y;
+
+    memset(counts, 0, sizeof(Uint32) * STATS_CHANNELS * 256);
+    for (y = ystart; y < yend; y++) {
+        const Uint8 *px = stats_row(pass, y, rgba);
+
+        for (x = 0; x < pass->width; x++, px += 4) {
+            int r = px[offsets[0]], g = px[offsets[1]], b = px[offsets[2]];
+
+            counts[r]++;
+            counts[256 + g]++;
+            counts[512 + b]++;
+            counts[768 + (pass->fill ? 255 : px[offsets[3]])]++;
+            counts[1024 + _LUMINANCE(r, g, b)]++;
+        }
+    }
+}
+
+/* Run band over the rows of pass, split across threads when the area is
+ * large enough. Returns the number of bands, or -1 on a memory error. */
+static int
+stats_run(StatsPass *pass, pg_parallel_proc band, int histogram)
+{
+    int nbands = MIN(pg_GetNumThreads(), REDUCE_MAX_BANDS);
+
+    if (nbands > pass->height)
+        nbands = pass->height;
+    if (nbands < 2 ||
+        (long long)pass->width * pass->height < PG_PARALLEL_MIN_PIXELS)
+        nbands = 1;
+
+    if (!pass->direct) {
+        pass->scratch = (Uint8 *)malloc((size_t)nbands * pass->width * 4);
+        if (!pass->scratch)
+            return -1;
+    }
+    if (histogram) {
+        pass->counts = (Uint32 *)malloc(sizeof(Uint32) * STATS_CHANNELS *
+                                        256 * nbands);
+        if (!pass->counts) {
+            free(pass->scratch);
+            return -1;
+        }
+    }
+
+    if (nbands > 1)
+        pg_ParallelFor(band, pass, nbands);
+    else
+        band(pass, 0, 1);
+
+    free(pass->scratch);
+    pass->scratch = NULL;
+    return nbands;
+}
+
+/* The part of surf inside rectobj, or all of it when rectobj is NULL or
+ * None. Returns -1 with an exception set for a bad rect. */
+static int
+stats_area(SDL_Surface *surf, PyObject *rectobj, SDL_Rect *area)
+{
+    SDL_Rect whole = {0, 0, surf->w, surf->h}, temp, *rect;
+
+    if (!rectobj || rectobj == Py_None) {
+        *area = whole;
+        return 0;
+    }
+    if (!(rect = pgRect_FromObject(rectobj, &temp))) {
+        PyErr_SetString(PyExc_TypeError, "Rect argument is invalid");
+        return -1;
+    }
+    if (!SDL_IntersectRect(rect, &whole, area))
+        area->w = area->h = 0;
+    return 0;
+}
+
+static PyObject *
+surf_histogram(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *rectobj = NULL, *result, *bincounts;
+    SDL_Surface *surf;
+    SDL_Rect area;
+    StatsPass pass;
+    const char *channels = "rgb";
+    const char *names = "rgbal";
+    unsigned long long totals[STATS_CHANNELS][256];
+    unsigned long long counts[256];
+    int bins = 256, nbands = 0, nchannels, band, c, i, v;
+    static char *keywords[] = {"surface", "channels", "bins", "rect", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|siO", keywords,
+                                     &pgSurface_Type, &surfobj, &channels,
+                                     &bins, &rectobj))
+        return NULL;
+
+    nchannels = (int)strlen(channels);
+    if (!nchannels || strspn(channels, names) != (size_t)nchannels)
+        return RAISE(PyExc_ValueError,
+                     "channels must be made of 'r', 'g', 'b', 'a' and 'l'");
+    if (bins < 1 || bins > 256)
+        return RAISE(PyExc_ValueError, "bins must be between 1 and 256");
+
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    if (stats_area(surf, rectobj, &area))
+        return NULL;
+
+    memset(totals, 0, sizeof(totals));
+    if (area.w && area.h) {
+        stats_pass_init(&pass, surf, &area);
+        pgSurface_Lock(surfobj);
+        Py_BEGIN_ALLOW_THREADS;
+        nbands = stats_run(&pass, histogram_band, 1);
+        Py_END_ALLOW_THREADS;
+        pgSurface_Unlock(surfobj);
+        if (nbands < 0)
+            return PyErr_NoMemory();
+
+        for (band = 0; band < nbands; band++) {
+            Uint32 *bandcounts =
+                pass.counts + (size_t)band * STATS_CHANNELS * 256;
+
+            for (c = 0; c < STATS_CHANNELS; c++) {
+                for (v = 0; v < 256; v++) {
+                    totals[c][v] += bandcounts[c * 256 + v];
+                }
+            }
+        }
+        free(pass.counts);
+    }
+
+    result = PyTuple_New(nchannels);
+    if (!result)
+        return NULL;
+    for (i = 0; i < nchannels; i++) {
+        c = (int)(strchr(names, channels[i]) - names);
+        memset(counts, 0, sizeof(counts));
+        for (v = 0; v < 256; v++) {
+            counts[v * bins / 256] += totals[c][v];
+        }
+        bincounts = PyList_New(bins);
+        if (!bincounts) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(result, i, bincounts);
+        for (v = 0; v < bins; v++) {
+            PyObject *count = PyLong_FromUnsignedLongLong(counts[v]);
+
+            if (!count) {
+                Py_DECREF(result);
+                return NULL;
+            }
+            PyList_SET_ITEM(bincounts, v, count);
+        }
+    }
+    return result;
+}
+
+/* Surface.get_stats() does its work here, next to the other reductions */
+static PyObject *
+surf_get_stats(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *rectobj = NULL;
+    SDL_Surface *surf;
+    SDL_Rect area;
+    StatsPass pass;
+    Uint64 sum[STATS_CHANNELS] = {0};
+    int min[STATS_CHANNELS], max[STATS_CHANNELS];
+    double count;
+    int nbands, band, c;
+    static char *keywords[] = {"surface", "rect", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|O", keywords,
+                                     &pgSurface_Type, &surfobj, &rectobj))
+        return NULL;
+
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    if (stats_area(surf, rectobj, &area))
+        return NULL;
+
+    if (!area.w || !area.h) {
+        return Py_BuildValue(
+            "{s:i,s:O,s:O,s:(iiii),s:O,s:O,s:O,s:O}", "count", 0, "min",
+            Py_None, "max", Py_None, "sum", 0, 0, 0, 0, "mean", Py_None,
+            "luminance_min", Py_None, "luminance_max", Py_None,
+            "luminance_mean", Py_None);
+    }
+
+    stats_pass_init(&pass, surf, &area);
+    pgSurface_Lock(surfobj);
+    Py_BEGIN_ALLOW_THREADS;
+    nbands = stats_run(&pass, stats_band, 0);
+    Py_END_ALLOW_THREADS;
+    pgSurface_Unlock(surfobj);
+    if (nbands < 0)
+        return PyErr_NoMemory();
+
+    for (c = 0; c < STATS_CHANNELS; c++) {
+        min[c] = 255;
+        max[c] = 0;
+        for (band = 0; band < nbands; band++) {
+            sum[c] += pass.bands[band].sum[c];
+            min[c] = MIN(min[c], pass.bands[band].min[c]);
+            max[c] = MAX(max[c], pass.bands[band].max[c]);
+        }
+    }
+
+    count = (double)area.w * area.h;
+    return Py_BuildValue(
+        "{s:L,s:(iiii),s:(iiii),s:(KKKK),s:(dddd),s:i,s:i,s:d}", "count",
+        (long long)area.w * area.h, "min", min[0], min[1], min[2], min[3],
+        "max", max[0], max[1], max[2], max[3], "sum",
+        (unsigned long long)sum[0], (unsigned long long)sum[1],
+        (unsigned long long)sum[2], (unsigned long long)sum[3], "mean",
+        sum[0] / count, sum[1] / count, sum[2] / count, sum[3] / count,
+        "luminance_min", min[4], "luminance_max", max[4], "luminance_mean",
+        sum[4] / count);
+}
+
+/*
+ * colorkey_to_alpha and alpha_to_colorkey move the transparency of a
+ * surface between its colorkey and its alpha channel in a single pass,
+ * instead of the generic per pixel conversion of convert_alpha().
+ */
+
+/* Copy a row of 32 bit pixels, clearing the amask bits of those whose
+ * rgbmask bits equal key and setting the force bits of the others. src and
+ * dst may be the same row.
+ */
+static void
+colorkey_to_alpha_row(const Uint32 *src, Uint32 *dst, int width,
+                      Uint32 rgbmask, Uint32 amask, Uint32 key, Uint32 force)
+{
+    int x = 0;
+#ifdef TRANSFORM_SIMD
+    __m128i vrgb = _mm_set1_epi32((int)rgbmask);
+    __m128i vamask = _mm_set1_epi32((int)amask);
+    __m128i vkey = _mm_set1_epi32((int)key);
+    __m128i vforce = _mm_set1_epi32((int)force);
+
+    for (; x + 4 <= width; x += 4) {
+        __m128i px = _mm_loadu_si128((const __m128i *)(src + x));
+        __m128i match = _mm_cmpeq_epi32(_mm_and_si128(px, vrgb), vkey);
+
+        px = _mm_andnot_si128(_mm_and_si128(match, vamask), px);
+        px = _mm_or_si128(px, _mm_andnot_si128(match, vforce));
+        _mm_storeu_si128((__m128i *)(dst + x), px);
+    }
+#endif /* TRANSFORM_SIMD */
+    for (; x < width; x++) {
+        Uint32 px = src[x];
+
+        dst[x] = (px & rgbmask) == key ? px & ~amask : px | force;
+    }
+}
+
+/* Copy a row of 32 bit pixels with 8 bit alpha at ashift, writing key for
+ * those with alpha below threshold and the rgbmask bits of the others.
+ */
+static void
+alpha_to_colorkey_row(const Uint32 *src, Uint32 *dst, int width,
+                      Uint32 rgbmask, int ashift, int threshold, Uint32 key)
+{
+    int x = 0;
+#ifdef TRANSFORM_SIMD
+    __m128i vrgb = _mm_set1_epi32((int)rgbmask);
+    __m128i vkey = _mm_set1_epi32((int)key);
+    __m128i vthreshold = _mm_set1_epi32(threshold);
+    __m128i vbyte = _mm_set1_epi32(0xff);
+    __m128i vshift = _mm_cvtsi32_si128(ashift);
+
+    for (; x + 4 <= width; x += 4) {
+        __m128i px = _mm_loadu_si128((const __m128i *)(src + x));
+        __m128i alpha = _mm_and_si128(_mm_srl_epi32(px, vshift), vbyte);
+        __m128i clear = _mm_cmplt_epi32(alpha, vthreshold);
+
+        px = _mm_or_si128(_mm_and_si128(clear, vkey),
+                          _mm_andnot_si128(clear, _mm_and_si128(px, vrgb)));
+        _mm_storeu_si128((__m128i *)(dst + x), px);
+    }
+#endif /* TRANSFORM_SIMD */
+    for (; x < width; x++) {
+        Uint32 px = src[x];
+
+        dst[x] = (int)((px >> ashift) & 0xff) < threshold ? key : px & rgbmask;
+    }
+}
+
+static PyObject *
+surf_colorkey_to_alpha(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj, *surfobj2 = NULL;
+    SDL_Surface *surf, *newsurf;
+    SDL_PixelFormat *fmt;
+    Uint32 key, rgbmask, amask, force;
+    Uint32 lut[256];
+    int has_key, x, y;
+    static char *keywords[] = {"surface", "dest_surface", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|O!", keywords,
+                                     &pgSurface_Type, &surfobj,
+                                     &pgSurface_Type, &surfobj2))
+        return NULL;
+
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    if (!pgSurface_Unpack(surf))
+        return NULL;
+    fmt = surf->format;
+    has_key = SDL_GetColorKey(surf, &key) == 0;
+
+    if (fmt->BytesPerPixel != 1 && fmt->BytesPerPixel != 4) {
+        /* SDL turns the colorkey into alpha as it converts */
+        if (surfobj2)
+            return RAISE(PyExc_ValueError,
+                         "dest_surface needs an 8 or 32 bit surface");
+        newsurf =
+            SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_ARGB8888, 0);
+        if (!newsurf)
+            return RAISE(pgExc_SDLError, SDL_GetError());
+        return (PyObject *)pgSurface_New(newsurf);
+    }
+
+    if (surfobj2) {
+        newsurf = pgSurface_AsSurface(surfobj2);
+        if (!newsurf)
+            return RAISE(pgExc_SDLError, "display Surface quit");
+        if (newsurf->w != surf->w || newsurf->h != surf->h)
+            return RAISE(PyExc_ValueError,
+                         "Destination surface not the same size.");
+        if (newsurf->format->BytesPerPixel != 4 || !newsurf->format->Amask ||
+            (fmt->BytesPerPixel == 4 &&
+             (newsurf->format->Rmask != fmt->Rmask ||
+              newsurf->format->Gmask != fmt->Gmask ||
+              newsurf->format->Bmask != fmt->Bmask)))
+            return RAISE(PyExc_ValueError,
+                         "dest_surface needs per pixel alpha and the colour "
+                         "masks of surface");
+        if (!pgSurface_Unshare(newsurf))
+            return NULL;
+    }
+    else if (fmt->BytesPerPixel == 4) {
+        /* the same layout, with the unused bits as alpha */
+        amask = fmt->Amask ? fmt->Amask
+                           : ~(fmt->Rmask | fmt->Gmask | fmt->Bmask);
+        newsurf = pgSurfacePool_CreateSurface(NULL, surf->w, surf->h, 32,
+                                              fmt->Rmask, fmt->Gmask,
+                                              fmt->Bmask, amask);
+        if (!newsurf)
+            return NULL;
+    }
+    else {
+        newsurf = pgSurfacePool_CreateSurface(NULL, surf->w, surf->h, 32,
+                                              0xff0000, 0xff00, 0xff,
+                                              0xff000000);
+        if (!newsurf)
+            return NULL;
+    }
+
+    if (fmt->BytesPerPixel == 1) {
+        SDL_Palette *palette = fmt->palette;
+
+        memset(lut, 0, sizeof(lut));
+        for (x = 0; palette && x < palette->ncolors && x < 256; x++) {
+            SDL_Color *c = palette->colors + x;
+
+            lut[x] = SDL_MapRGBA(newsurf->format, c->r, c->g, c->b,
+                                 has_key && (Uint32)x == key ? 0 : 255);
+        }
+    }
+    rgbmask = fmt->Rmask | fmt->Gmask | fmt->Bmask;
+    amask = newsurf->format->Amask;
+    /* a key that no colour matches when there is no colorkey */
+    key = has_key ? key & rgbmask : ~rgbmask;
+    force = fmt->Amask ? 0 : amask;
+
+    SDL_LockSurface(surf);
+    if (newsurf != surf)
+        SDL_LockSurface(newsurf);
+
+    Py_BEGIN_ALLOW_THREADS;
+    for (y = 0; y < surf->h; y++) {
+        Uint8 *srcrow = (Uint8 *)surf->pixels + y * surf->pitch;
+        Uint32 *dstrow =
+            (Uint32 *)((Uint8 *)newsurf->pixels + y * newsurf->pitch);
+
+        if (fmt->BytesPerPixel == 1) {
+            for (x = 0; x < surf->w; x++)
+                dstrow[x] = lut[srcrow[x]];
+        }
+        else {
+            colorkey_to_alpha_row((Uint32 *)srcrow, dstrow, surf->w, rgbmask,
+                                  amask, key, force);
+        }
+    }
+    Py_END_ALLOW_THREADS;
+
+    if (newsurf != surf)
+        SDL_UnlockSurface(newsurf);
+    SDL_UnlockSurface(surf);
+
+    SDL_SetColorKey(newsurf, SDL_FALSE, 0);
+    if (surfobj2) {
+        Py_INCREF(surfobj2);
+        return (PyObject *)surfobj2;
+    }
+    return (PyObject *)pgSurface_New(newsurf);
+}
+
+static PyObject *
+surf_alpha_to_colorkey(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj = NULL;
+    SDL_Surface *surf, *src, *newsurf;
+    Uint8 rgba[4] = {255, 0, 255, 255};
+    Uint32 key, rgbmask;
+    int threshold = 128, y;
+    static char *keywords[] = {"surface", "threshold", "colorkey", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|iO", keywords,
+                                     &pgSurface_Type, &surfobj, &threshold,
+                                     &colorobj))
+        return NULL;
+
+    if (threshold < 0 || threshold > 256)
+        return RAISE(PyExc_ValueError,
+                     "threshold must be between 0 and 256");
+    if (colorobj && !pg_RGBAFromFuzzyColorObj(colorobj, rgba))
+        return NULL;
+
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    if (!surf->format->Amask)
+        return RAISE(PyExc_ValueError, "surface has no per pixel alpha");
+    if (!pgSurface_Unpack(surf))
+        return NULL;
+
+    src = surf;
+    if (surf->format->BytesPerPixel != 4 || surf->format->Aloss != 0) {
+        src = SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_ARGB8888, 0);
+        if (!src)
+            return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    newsurf = pgSurfacePool_CreateSurface(NULL, src->w, src->h, 32,
+                                          src->format->Rmask,
+                                          src->format->Gmask,
+                                          src->format->Bmask, 0);
+    if (!newsurf) {
+        if (src != surf)
+            SDL_FreeSurface(src);
+        return NULL;
+    }
+    rgbmask = src->format->Rmask | src->format->Gmask | src->format->Bmask;
+    key = SDL_MapRGB(newsurf->format, rgba[0], rgba[1], rgba[2]);
+
+    SDL_LockSurface(src);
+    SDL_LockSurface(newsurf);
+
+    Py_BEGIN_ALLOW_THREADS;
+    for (y = 0; y < src->h; y++) {
+        alpha_to_colorkey_row(
+            (Uint32 *)((Uint8 *)src->pixels + y * src->pitch),
+            (Uint32 *)((Uint8 *)newsurf->pixels + y * newsurf->pitch),
+            src->w, rgbmask, src->format->Ashift, threshold, key);
+    }
+    Py_END_ALLOW_THREADS;
+
+    SDL_UnlockSurface(newsurf);
+    SDL_UnlockSurface(src);
+    if (src != surf)
+        SDL_FreeSurface(src);
+
+    SDL_SetColorKey(newsurf, SDL_TRUE, key);
+    return (PyObject *)pgSurface_New(newsurf);
+}
+
+/*
+ * compose_lights multiplies a scene by a light map of an ambient colour and
+ * many additive light sprites. The light map is built a tile at a time in a
+ * buffer that stays in cache, and multiplied into the scene as soon as the
+ * tile is done, so the frame is read and written once instead of once for
+ * each full screen BLEND_ADD and BLEND_MULT blit.
+ */
+
+#define LIGHTS_TILE_W 64
+#define LIGHTS_TILE_H 32
+
+typedef struct {
+    SDL_Surface *surf;      /* in the byte order of the scene */
+    SDL_Surface *converted; /* surf, when it is a converted copy to free */
+    PyObject *owner;        /* the locked Surface object of surf, or NULL */
+    SDL_Rect rect;          /* where it lands, clipped to the scene */
+    int x, y;               /* the pixel of surf at the top left of rect */
+} LightSprite;
+
+typedef struct {
+    SDL_Surface *scene;
+    SDL_Surface *dst;
+    Uint32 ambient; /* mapped in the format of the scene */
+    Uint32 keep;    /* the bits of each pixel left as they are in scene */
+    LightSprite *lights;
+    int nlights;
+    int *rowlights; /* nlights slots for each band, for the lights of a row */
+    int tilerows;
+} LightsPass;
+
+/* dst[i] = min(dst[i] + src[i], 255) for each byte of count pixels */
+static void
+lights_add_row(Uint32 *dst, const Uint32 *src, int count)
+{
+    int x = 0;
+
+#ifdef TRANSFORM_SIMD
+    if (_use_simd()) {
+        for (; x + 4 <= count; x += 4) {
+            __m128i d = _mm_loadu_si128((const __m128i *)(dst + x));
+            __m128i s = _mm_loadu_si128((const __m128i *)(src + x));
+
+            _mm_storeu_si128((__m128i *)(dst + x), _mm_adds_epu8(d, s));
+        }
+    }
+#endif /* TRANSFORM_SIMD */
+    for (; x < count; x++) {
+        const Uint8 *s = (const Uint8 *)(src + x);
+        Uint8 *d = (Uint8 *)(dst + x);
+        int i, sum;
+
+        for (i = 0; i < 4; i++) {
+            sum = d[i] + s[i];
+            d[i] = (Uint8)(sum > 255 ? 255 : sum);
+        }
+    }
+}
+
+/* dst = scene * light, each byte as BLEND_MULT does: (d * s + 255) >> 8.
+ * The keep bits of each pixel come from scene untouched.
+ */
+static void
+lights_mul_row(Uint32 *dst, const Uint32 *scene, const Uint32 *light,
+               int count, Uint32 keep)
+{
+    int x = 0;
+
+#ifdef TRANSFORM_SIMD
+    if (_use_simd()) {
+        __m128i zero = _mm_setzero_si128();
+        __m128i round = _mm_set1_epi16(255);
+        __m128i vkeep = _mm_set1_epi32((int)keep);
+
+        for (; x + 4 <= count; x += 4) {
+            __m128i s = _mm_loadu_si128((const __m128i *)(scene + x));
+            __m128i l = _mm_loadu_si128((const __m128i *)(light + x));
+            __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(s, zero),
+                                         _mm_unpacklo_epi8(l, zero));
+            __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(s, zero),
+                                         _mm_unpackhi_epi8(l, zero));
+            __m128i out;
+
+            lo = _mm_srli_epi16(_mm_add_epi16(lo, round), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(hi, round), 8);
+            out = _mm_packus_epi16(lo, hi);
+            out = _mm_or_si128(_mm_and_si128(s, vkeep),
+                               _mm_andnot_si128(vkeep, out));
+            _mm_storeu_si128((__m128i *)(dst + x), out);
+        }
+    }
+#endif /* TRANSFORM_SIMD */
+    for (; x < count; x++) {
+        const Uint8 *s = (const Uint8 *)(scene + x);
+        const Uint8 *l = (const Uint8 *)(light + x);
+        Uint32 out;
+        Uint8 *o = (Uint8 *)&out;
+        int i;
+
+        for (i = 0; i < 4; i++) {
+            o[i] = (Uint8)((s[i] * l[i] + 255) >> 8);
         }
-        *a = atot / size;
-        size = (atot == 0 ? size : atot);
-        *r = rtot / size;
-        *g = gtot / size;
-        *b = btot / size;
+        dst[x] = (scene[x] & keep) | (out & ~keep);
     }
-    else {
-        switch (format->BytesPerPixel) {
-            case 1: {
-                Uint8 color8;
-                for (row = y; row < height_and_y; row++) {
-                    pixels = (Uint8 *)surf->pixels + row * surf->pitch + x;
-                    for (col = x; col < width_and_x; col++) {
-                        color8 = *(Uint8 *)pixels;
-                        rtot += ((color8 & rmask) >> rshift) << rloss;
-                        gtot += ((color8 & gmask) >> gshift) << gloss;
-                        btot += ((color8 & bmask) >> bshift) << bloss;
-                        atot += ((color8 & amask) >> ashift) << aloss;
-                        pixels++;
-                    }
-                }
-            } break;
-            case 2:
-                for (row = y; row < height_and_y; row++) {
-                    pixels = (Uint8 *)surf->pixels + row * surf->pitch + x * 2;
-                    for (col = x; col < width_and_x; col++) {
-                        color = (Uint32) * ((Uint16 *)pixels);
-                        rtot += ((color & rmask) >> rshift) << rloss;
-                        gtot += ((color & gmask) >> gshift) << gloss;
-                        btot += ((color & bmask) >> bshift) << bloss;
-                        atot += ((color & amask) >> ashift) << aloss;
-                        pixels += 2;
-                    }
-                }
-                break;
-            case 3:
-                for (row = y; row < height_and_y; row++) {
-                    pixels = (Uint8 *)surf->pixels + row * surf->pitch + x * 3;
-                    for (col = x; col < width_and_x; col++) {
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                        color =
-                            (pixels[0]) + (pixels[1] << 8) + (pixels[2] << 16);
-#else
-                        color =
-                            (pixels[2]) + (pixels[1] << 8) + (pixels[0] << 16);
-#endif
-                        rtot += ((color & rmask) >> rshift) << rloss;
-                        gtot += ((color & gmask) >> gshift) << gloss;
-                        btot += ((color & bmask) >> bshift) << bloss;
-                        atot += ((color & amask) >> ashift) << aloss;
-                        pixels += 3;
-                    }
+}
+
+/* Light and multiply the tile rows [start, stop). rowlights has room for
+ * the index of every light.
+ */
+static void
+lights_rows(LightsPass *pass, int *rowlights, int start, int stop)
+{
+    Uint32 tile[LIGHTS_TILE_H][LIGHTS_TILE_W];
+    SDL_Surface *scene = pass->scene, *dst = pass->dst;
+    int ty, y0, x0, w, h, i, n, row, x;
+
+    for (ty = start; ty < stop; ty++) {
+        y0 = ty * LIGHTS_TILE_H;
+        h = MIN(LIGHTS_TILE_H, scene->h - y0);
+
+        /* the lights crossing this row of tiles */
+        n = 0;
+        for (i = 0; i < pass->nlights; i++) {
+            SDL_Rect *r = &pass->lights[i].rect;
+
+            if (r->y < y0 + h && r->y + r->h > y0)
+                rowlights[n++] = i;
+        }
+
+        for (x0 = 0; x0 < scene->w; x0 += LIGHTS_TILE_W) {
+            w = MIN(LIGHTS_TILE_W, scene->w - x0);
+            for (row = 0; row < h; row++) {
+                for (x = 0; x < w; x++) {
+                    tile[row][x] = pass->ambient;
                 }
-                break;
-            default: /* case 4: */
-                for (row = y; row < height_and_y; row++) {
-                    pixels = (Uint8 *)surf->pixels + row * surf->pitch + x * 4;
-                    for (col = x; col < width_and_x; col++) {
-                        color = *(Uint32 *)pixels;
-                        rtot += ((color & rmask) >> rshift) << rloss;
-                        gtot += ((color & gmask) >> gshift) << gloss;
-                        btot += ((color & bmask) >> bshift) << bloss;
-                        atot += ((color & amask) >> ashift) << aloss;
-                        pixels += 4;
-                    }
+            }
+
+            for (i = 0; i < n; i++) {
+                LightSprite *light = &pass->lights[rowlights[i]];
+                SDL_Rect *r = &light->rect;
+                int left = MAX(r->x, x0), right = MIN(r->x + r->w, x0 + w);
+                int top = MAX(r->y, y0), bottom = MIN(r->y + r->h, y0 + h);
+
+                for (row = top; row < bottom; row++) {
+                    const Uint8 *src =
+                        (const Uint8 *)light->surf->pixels +
+                        (size_t)(light->y + row - r->y) * light->surf->pitch +
+                        (size_t)(light->x + left - r->x) * 4;
+
+                    lights_add_row(&tile[row - y0][left - x0],
+                                   (const Uint32 *)src, right - left);
                 }
-                break;
+            }
+
+            for (row = 0; row < h; row++) {
+                lights_mul_row(
+                    (Uint32 *)((Uint8 *)dst->pixels +
+                               (size_t)(y0 + row) * dst->pitch) +
+                        x0,
+                    (const Uint32 *)((const Uint8 *)scene->pixels +
+                                     (size_t)(y0 + row) * scene->pitch) +
+                        x0,
+                    tile[row], w, pass->keep);
+            }
         }
-        *r = rtot / size;
-        *g = gtot / size;
-        *b = btot / size;
-        *a = atot / size;
     }
 }
 
-/* Optimisation was only disabled for one function - see above */
-#if defined(_MSC_VER) && (_MSC_VER == 1900)
-#pragma optimize("", on)
-#endif
+static void
+lights_band(void *data, int band, int nbands)
+{
+    LightsPass *pass = (LightsPass *)data;
 
-/* Optimisation was only disabled for one function on GCC+PPC64 - see above */
-#if defined(__GNUC__) && defined(__PPC64__)
-#pragma GCC pop_options
-#endif
+    lights_rows(pass, pass->rowlights + (size_t)band * pass->nlights,
+                (int)((long long)pass->tilerows * band / nbands),
+                (int)((long long)pass->tilerows * (band + 1) / nbands));
+}
+
+/* Run the pass over the locked surfaces, in bands of tile rows on the
+ * worker pool when the scene is large enough. Returns -1 when out of
+ * memory.
+ */
+static int
+lights_run(LightsPass *pass)
+{
+    int nbands = pg_GetNumThreads();
+
+    pass->tilerows = (pass->scene->h + LIGHTS_TILE_H - 1) / LIGHTS_TILE_H;
+    if (nbands > pass->tilerows)
+        nbands = pass->tilerows;
+    if (nbands > REDUCE_MAX_BANDS)
+        nbands = REDUCE_MAX_BANDS;
+    if ((long long)pass->scene->w * pass->scene->h < PG_PARALLEL_MIN_PIXELS)
+        nbands = 1;
+    if (nbands < 1)
+        return 0;
+
+    pass->rowlights =
+        (int *)malloc(sizeof(int) * MAX(pass->nlights, 1) * nbands);
+    if (!pass->rowlights)
+        return -1;
+    if (nbands == 1)
+        lights_rows(pass, pass->rowlights, 0, pass->tilerows);
+    else
+        pg_ParallelFor(lights_band, pass, nbands);
+    free(pass->rowlights);
+    return 0;
+}
+
+/* Unlock and free what compose_lights took for its first count lights */
+static void
+lights_release(LightSprite *lights, int count)
+{
+    int i;
+
+    for (i = 0; i < count; i++) {
+        if (lights[i].converted)
+            SDL_FreeSurface(lights[i].converted);
+        if (lights[i].owner)
+            pgSurface_Unlock((pgSurfaceObject *)lights[i].owner);
+    }
+    PyMem_Free(lights);
+}
 
 static PyObject *
-surf_average_color(PyObject *self, PyObject *args, PyObject *kwargs)
+surf_compose_lights(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    pgSurfaceObject *surfobj;
-    PyObject *rectobj = NULL;
-    SDL_Surface *surf;
-    SDL_Rect *rect, temp;
-    Uint8 r, g, b, a;
-    int x, y, w, h;
-    static char *keywords[] = {"surface", "rect", "consider_alpha", NULL};
-    SDL_bool consider_alpha = SDL_FALSE;
+    pgSurfaceObject *sceneobj, *dstobj = NULL;
+    PyObject *ambientobj, *lightsobj, *seq, **items;
+    SDL_Surface *scene, *dst;
+    LightsPass pass;
+    SDL_Rect temp, *rect;
+    Uint8 rgba[4];
+    Py_ssize_t count;
+    int i, x, y, result;
+    static char *keywords[] = {"scene", "ambient", "lights", "dest_surface",
+                               NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|Op", keywords,
-                                     &pgSurface_Type, &surfobj, &rectobj,
-                                     &consider_alpha))
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OO|O!", keywords,
+                                     &pgSurface_Type, &sceneobj, &ambientobj,
+                                     &lightsobj, &pgSurface_Type, &dstobj))
         return NULL;
 
-    surf = pgSurface_AsSurface(surfobj);
-    pgSurface_Lock(surfobj);
+    scene = pgSurface_AsSurface(sceneobj);
+    if (!scene)
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    if (!_rgb_in_bytes32(scene->format))
+        return RAISE(PyExc_ValueError,
+                     "the scene must be a 32 bit surface with a byte for "
+                     "each of R, G and B");
+    if (!pg_RGBAFromFuzzyColorObj(ambientobj, rgba))
+        return NULL;
 
-    if (!rectobj) {
-        x = 0;
-        y = 0;
-        w = surf->w;
-        h = surf->h;
+    if (!dstobj || dstobj == sceneobj) {
+        dstobj = sceneobj;
+        dst = scene;
     }
     else {
-        if (!(rect = pgRect_FromObject(rectobj, &temp)))
-            return RAISE(PyExc_TypeError, "Rect argument is invalid");
-        x = rect->x;
-        y = rect->y;
-        w = rect->w;
-        h = rect->h;
+        dst = pgSurface_AsSurface(dstobj);
+        if (!dst)
+            return RAISE(pgExc_SDLError, "display Surface quit");
+        if (_check_dest_surface(scene, dst, scene->w, scene->h))
+            return NULL;
+        if (dst->format->Rmask != scene->format->Rmask ||
+            dst->format->Gmask != scene->format->Gmask ||
+            dst->format->Bmask != scene->format->Bmask)
+            return RAISE(
+                PyExc_ValueError,
+                "Source and destination surfaces need the same format.");
+    }
+
+    seq = PySequence_Fast(lightsobj, "lights must be a sequence");
+    if (!seq)
+        return NULL;
+    count = PySequence_Fast_GET_SIZE(seq);
+    items = PySequence_Fast_ITEMS(seq);
+    if (count > INT_MAX / (Py_ssize_t)sizeof(LightSprite)) {
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    pass.lights = (LightSprite *)PyMem_Calloc(MAX(count, 1),
+                                              sizeof(LightSprite));
+    if (!pass.lights) {
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+
+    /* every light is checked, clipped and, when its format differs from
+     * the scene, converted before any pixel is drawn */
+    pass.nlights = 0;
+    for (i = 0; i < count; i++) {
+        PyObject *item = items[i];
+        SDL_Surface *light;
+        LightSprite *sprite = &pass.lights[pass.nlights];
+
+        if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 2 ||
+            !pgSurface_Check(PyTuple_GET_ITEM(item, 0))) {
+            PyErr_SetString(PyExc_TypeError,
+                            "each light must be a (Surface, position) pair");
+            goto error;
+        }
+        if (!pg_TwoIntsFromObj(PyTuple_GET_ITEM(item, 1), &x, &y)) {
+            if (!(rect = pgRect_FromObject(PyTuple_GET_ITEM(item, 1),
+                                           &temp))) {
+                PyErr_SetString(PyExc_TypeError,
+                                "invalid position for a light");
+                goto error;
+            }
+            x = rect->x;
+            y = rect->y;
+        }
+        light = pgSurface_AsSurface(PyTuple_GET_ITEM(item, 0));
+        if (!light) {
+            PyErr_SetString(pgExc_SDLError, "display Surface quit");
+            goto error;
+        }
+        if (_surfaces_overlap(light, dst)) {
+            PyErr_SetString(PyExc_ValueError,
+                            "a light overlaps the destination surface");
+            goto error;
+        }
+
+        sprite->rect.x = MAX(x, 0);
+        sprite->rect.y = MAX(y, 0);
+        sprite->rect.w = MIN(x + light->w, scene->w) - sprite->rect.x;
+        sprite->rect.h = MIN(y + light->h, scene->h) - sprite->rect.y;
+        if (sprite->rect.w <= 0 || sprite->rect.h <= 0)
+            continue;
+        sprite->x = sprite->rect.x - x;
+        sprite->y = sprite->rect.y - y;
+
+        if (light->format->BytesPerPixel == 4 &&
+            light->format->Rmask == scene->format->Rmask &&
+            light->format->Gmask == scene->format->Gmask &&
+            light->format->Bmask == scene->format->Bmask) {
+            sprite->surf = light;
+            sprite->owner = PyTuple_GET_ITEM(item, 0);
+            pgSurface_Lock((pgSurfaceObject *)sprite->owner);
+        }
+        else {
+            sprite->converted = SDL_ConvertSurface(light, scene->format, 0);
+            if (!sprite->converted) {
+                PyErr_SetString(pgExc_SDLError, SDL_GetError());
+                goto error;
+            }
+            sprite->surf = sprite->converted;
+        }
+        pass.nlights++;
     }
+    Py_DECREF(seq);
 
+    pass.scene = scene;
+    pass.dst = dst;
+    pass.ambient = SDL_MapRGB(scene->format, rgba[0], rgba[1], rgba[2]);
+    pass.keep = ~(scene->format->Rmask | scene->format->Gmask |
+                  scene->format->Bmask);
+
+    pgSurface_Lock(sceneobj);
+    if (dstobj != sceneobj)
+        pgSurface_Lock(dstobj);
     Py_BEGIN_ALLOW_THREADS;
-    average_color(surf, x, y, w, h, &r, &g, &b, &a, consider_alpha);
+    result = lights_run(&pass);
     Py_END_ALLOW_THREADS;
+    if (dstobj != sceneobj)
+        pgSurface_Unlock(dstobj);
+    pgSurface_Unlock(sceneobj);
+    lights_release(pass.lights, pass.nlights);
+    if (result)
+        return PyErr_NoMemory();
+
+    Py_INCREF(dstobj);
+    return (PyObject *)dstobj;
+
+error:
+    /* the light that failed holds nothing yet */
+    lights_release(pass.lights, pass.nlights);
+    Py_DECREF(seq);
+    return NULL;
+}
 
-    pgSurface_Unlock(surfobj);
-    return Py_BuildValue("(bbbb)", r, g, b, a);
+/*
+ * RotationCache: rotated copies of one surface at fixed angle steps,
+ * rendered on first use into a single atlas surface.
+ */
+
+typedef struct {
+    PyObject_HEAD PyObject *surface; /* the source surface */
+    PyObject *atlas;                 /* NULL until a frame is rendered */
+    PyObject **frames;               /* atlas subsurface for each step */
+    int steps;
+    int smooth;
+    int slot;    /* edge length of the square atlas cell for each step */
+    int columns; /* atlas cells per row */
+} pgRotationCacheObject;
+
+static void
+rotcache_clear(pgRotationCacheObject *self)
+{
+    int i;
+
+    if (self->frames) {
+        for (i = 0; i < self->steps; i++) {
+            Py_XDECREF(self->frames[i]);
+        }
+        PyMem_Free(self->frames);
+        self->frames = NULL;
+    }
+    Py_CLEAR(self->atlas);
+    Py_CLEAR(self->surface);
+}
+
+static void
+rotcache_dealloc(pgRotationCacheObject *self)
+{
+    rotcache_clear(self);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static int
+rotcache_init(pgRotationCacheObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *surfobj;
+    SDL_Surface *surf;
+    int steps = 36, smooth = 0;
+    static char *keywords[] = {"surface", "steps", "smooth", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|ip", keywords,
+                                     &pgSurface_Type, &surfobj, &steps,
+                                     &smooth))
+        return -1;
+
+    if (steps < 1) {
+        PyErr_SetString(PyExc_ValueError, "steps must be at least 1");
+        return -1;
+    }
+
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf) {
+        PyErr_SetString(pgExc_SDLError, "display Surface quit");
+        return -1;
+    }
+    if (surf->format->BytesPerPixel == 0 || surf->format->BytesPerPixel > 4) {
+        PyErr_SetString(PyExc_ValueError,
+                        "unsupported Surface bit depth for transform");
+        return -1;
+    }
+
+    rotcache_clear(self);
+    self->frames = (PyObject **)PyMem_Calloc(steps, sizeof(PyObject *));
+    if (!self->frames) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    Py_INCREF(surfobj);
+    self->surface = surfobj;
+    self->steps = steps;
+    self->smooth = smooth;
+    /* Every rotated frame fits in a square as wide as the source's
+     * diagonal, with two pixels to spare for rotozoom's even sizes */
+    self->slot = (int)ceil(sqrt((double)surf->w * surf->w +
+                                (double)surf->h * surf->h)) +
+                 2;
+    self->columns = (int)ceil(sqrt((double)steps));
+    return 0;
+}
+
+/* Render step index into the atlas and remember the subsurface holding
+ * it. Frames are made by rotate() or rotozoom() themselves, so they
+ * match what those functions return for the same angle.
+ */
+static PyObject *
+rotcache_render(pgRotationCacheObject *self, int index)
+{
+    float angle = (float)(index * 360.0 / self->steps);
+    PyObject *args, *frameobj, *sub;
+    SDL_Surface *frame, *atlas;
+    int x, y, w, h, row, bpp;
+
+    if (self->smooth)
+        args = Py_BuildValue("(Off)", self->surface, angle, 1.0f);
+    else
+        args = Py_BuildValue("(Of)", self->surface, angle);
+    if (!args)
+        return NULL;
+    if (self->smooth)
+        frameobj = surf_rotozoom(NULL, args, NULL);
+    else
+        frameobj = surf_rotate(NULL, args, NULL);
+    Py_DECREF(args);
+    if (!frameobj)
+        return NULL;
+
+    frame = pgSurface_AsSurface(frameobj);
+    w = frame->w;
+    h = frame->h;
+    if (w < 1 || h < 1 || w > self->slot || h > self->slot) {
+        /* nothing to pack; hand the frame back as it is */
+        return frameobj;
+    }
+
+    if (!self->atlas) {
+        int rows = (self->steps + self->columns - 1) / self->columns;
+
+        atlas = newsurf_fromsurf(frame, self->columns * self->slot,
+                                 rows * self->slot, NULL);
+        if (!atlas) {
+            Py_DECREF(frameobj);
+            return NULL;
+        }
+        /* subsurfaces share the atlas pixels, which RLE would hide */
+        SDL_SetSurfaceRLE(atlas, SDL_FALSE);
+        self->atlas = (PyObject *)pgSurface_New(atlas);
+        if (!self->atlas) {
+            SDL_FreeSurface(atlas);
+            Py_DECREF(frameobj);
+            return NULL;
+        }
+    }
+
+    atlas = pgSurface_AsSurface(self->atlas);
+    bpp = atlas->format->BytesPerPixel;
+    x = (index % self->columns) * self->slot;
+    y = (index / self->columns) * self->slot;
+    SDL_LockSurface(frame);
+    for (row = 0; row < h; row++) {
+        memcpy((Uint8 *)atlas->pixels + (y + row) * atlas->pitch + x * bpp,
+               (Uint8 *)frame->pixels + row * frame->pitch, (size_t)w * bpp);
+    }
+    SDL_UnlockSurface(frame);
+    Py_DECREF(frameobj);
+
+    sub = PyObject_CallMethod(self->atlas, "subsurface", "((iiii))", x, y, w,
+                              h);
+    if (!sub)
+        return NULL;
+    self->frames[index] = sub;
+    Py_INCREF(sub);
+    return sub;
+}
+
+static PyObject *
+rotcache_get(pgRotationCacheObject *self, PyObject *args, PyObject *kwargs)
+{
+    double angle;
+    int index;
+    static char *keywords[] = {"angle", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "d", keywords, &angle))
+        return NULL;
+    if (!self->frames)
+        return RAISE(PyExc_RuntimeError, "RotationCache is not initialized");
+
+    /* round to the nearest step, wrapping negative angles around */
+    index = (int)fmod(floor(angle * self->steps / 360.0 + 0.5), self->steps);
+    if (index < 0)
+        index += self->steps;
+
+    if (self->frames[index]) {
+        Py_INCREF(self->frames[index]);
+        return self->frames[index];
+    }
+    return rotcache_render(self, index);
+}
+
+static PyObject *
+rotcache_render_all(pgRotationCacheObject *self, PyObject *_null)
+{
+    PyObject *frame;
+    int i;
+
+    if (!self->frames)
+        return RAISE(PyExc_RuntimeError, "RotationCache is not initialized");
+
+    for (i = 0; i < self->steps; i++) {
+        if (!self->frames[i]) {
+            frame = rotcache_render(self, i);
+            if (!frame)
+                return NULL;
+            Py_DECREF(frame);
+        }
+    }
+    Py_RETURN_NONE;
 }
 
+static PyObject *
+rotcache_get_atlas(pgRotationCacheObject *self, void *closure)
+{
+    if (!self->atlas)
+        Py_RETURN_NONE;
+    Py_INCREF(self->atlas);
+    return self->atlas;
+}
+
+static PyObject *
+rotcache_get_steps(pgRotationCacheObject *self, void *closure)
+{
+    return PyLong_FromLong(self->steps);
+}
+
+static PyObject *
+rotcache_get_smooth(pgRotationCacheObject *self, void *closure)
+{
+    return PyBool_FromLong(self->smooth);
+}
+
+static PyMethodDef rotcache_methods[] = {
+    {"get", (PyCFunction)rotcache_get, METH_VARARGS | METH_KEYWORDS,
+     DOC_ROTATIONCACHEGET},
+    {"render_all", (PyCFunction)rotcache_render_all, METH_NOARGS,
+     DOC_ROTATIONCACHERENDERALL},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef rotcache_getsets[] = {
+    {"atlas", (getter)rotcache_get_atlas, NULL, DOC_ROTATIONCACHEATLAS, NULL},
+    {"steps", (getter)rotcache_get_steps, NULL, DOC_ROTATIONCACHESTEPS, NULL},
+    {"smooth", (getter)rotcache_get_smooth, NULL, DOC_ROTATIONCACHESMOOTH,
+     NULL},
+    {NULL, NULL, NULL, NULL, NULL}};
+
+static PyTypeObject pgRotationCache_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.transform.RotationCache",
+    .tp_basicsize = sizeof(pgRotationCacheObject),
+    .tp_dealloc = (destructor)rotcache_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_PYGAMETRANSFORMROTATIONCACHE,
+    .tp_methods = rotcache_methods,
+    .tp_getset = rotcache_getsets,
+    .tp_init = (initproc)rotcache_init,
+    .tp_new = PyType_GenericNew,
+};
+
 static PyMethodDef _transform_methods[] = {
     {"scale", (PyCFunction)surf_scale, METH_VARARGS | METH_KEYWORDS,
      DOC_PYGAMETRANSFORMSCALE},
@@ -2960,10 +7986,18 @@ static PyMethodDef _transform_methods[] = {
      DOC_PYGAMETRANSFORMFLIP},
     {"rotozoom", (PyCFunction)surf_rotozoom, METH_VARARGS | METH_KEYWORDS,
      DOC_PYGAMETRANSFORMROTOZOOM},
+    {"affine", (PyCFunction)surf_affine, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMETRANSFORMAFFINE},
     {"chop", (PyCFunction)surf_chop, METH_VARARGS | METH_KEYWORDS,
      DOC_PYGAMETRANSFORMCHOP},
+    {"split_grid", (PyCFunction)surf_split_grid, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMETRANSFORMSPLITGRID},
     {"scale2x", (PyCFunction)surf_scale2x, METH_VARARGS | METH_KEYWORDS,
      DOC_PYGAMETRANSFORMSCALE2X},
+    {"scale3x", (PyCFunction)surf_scale3x, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMETRANSFORMSCALE3X},
+    {"scale_by_int", (PyCFunction)surf_scale_by_int,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMETRANSFORMSCALEBYINT},
     {"smoothscale", (PyCFunction)surf_scalesmooth,
      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMETRANSFORMSMOOTHSCALE},
     {"smoothscale_by", (PyCFunction)surf_scalesmooth_by,
@@ -2972,16 +8006,52 @@ static PyMethodDef _transform_methods[] = {
      DOC_PYGAMETRANSFORMGETSMOOTHSCALEBACKEND},
     {"set_smoothscale_backend", (PyCFunction)surf_set_smoothscale_backend,
      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMETRANSFORMSETSMOOTHSCALEBACKEND},
+    {"resample", (PyCFunction)surf_resample, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMETRANSFORMRESAMPLE},
     {"threshold", (PyCFunction)surf_threshold, METH_VARARGS | METH_KEYWORDS,
      DOC_PYGAMETRANSFORMTHRESHOLD},
     {"laplacian", (PyCFunction)surf_laplacian, METH_VARARGS | METH_KEYWORDS,
-     DOC_PYGAMETRANSFORMTHRESHOLD},
+     DOC_PYGAMETRANSFORMLAPLACIAN},
+    {"sobel", (PyCFunction)surf_sobel, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMETRANSFORMSOBEL},
+    {"scharr", (PyCFunction)surf_scharr, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMETRANSFORMSCHARR},
+    {"box_blur", (PyCFunction)surf_box_blur, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMETRANSFORMBOXBLUR},
+    {"gaussian_blur", (PyCFunction)surf_gaussian_blur,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMETRANSFORMGAUSSIANBLUR},
+    {"convolve", (PyCFunction)surf_convolve, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMETRANSFORMCONVOLVE},
     {"average_surfaces", (PyCFunction)surf_average_surfaces,
      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMETRANSFORMAVERAGESURFACES},
     {"average_color", (PyCFunction)surf_average_color,
      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMETRANSFORMAVERAGECOLOR},
+    {"histogram", (PyCFunction)surf_histogram, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMETRANSFORMHISTOGRAM},
+    {"_get_stats", (PyCFunction)surf_get_stats, METH_VARARGS | METH_KEYWORDS,
+     NULL},
+    {"colorkey_to_alpha", (PyCFunction)surf_colorkey_to_alpha,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMETRANSFORMCOLORKEYTOALPHA},
+    {"alpha_to_colorkey", (PyCFunction)surf_alpha_to_colorkey,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMETRANSFORMALPHATOCOLORKEY},
+    {"compose_lights", (PyCFunction)surf_compose_lights,
+     METH_VARARGS | METH_KEYWORDS, DOC_PYGAMETRANSFORMCOMPOSELIGHTS},
     {NULL, NULL, 0, NULL}};
 
+static void
+transform_free(void *mod)
+{
+    struct _module_state *st = GETSTATE((PyObject *)mod);
+    int i;
+
+    if (!st)
+        return;
+    for (i = 0; i < RESAMPLE_CACHE_SIZE; i++) {
+        resample_table_evict(st->resample_cache[i]);
+        st->resample_cache[i] = NULL;
+    }
+}
+
 MODINIT_DEFINE(transform)
 {
     PyObject *module;
@@ -2995,7 +8065,7 @@ MODINIT_DEFINE(transform)
                                          NULL,
                                          NULL,
                                          NULL,
-                                         NULL};
+                                         transform_free};
 
     /* imported needed apis; Do this first so if there is an error
        the module is not loaded.
@@ -3016,6 +8086,10 @@ MODINIT_DEFINE(transform)
     if (PyErr_Occurred()) {
         return NULL;
     }
+    import_pygame_mask();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
 
     /* create the module */
     module = PyModule_Create(&_module);
@@ -3028,5 +8102,17 @@ MODINIT_DEFINE(transform)
     if (st->filter_type == 0) {
         smoothscale_init(st);
     }
+
+    if (PyType_Ready(&pgRotationCache_Type) < 0) {
+        Py_DECREF(module);
+        return NULL;
+    }
+    Py_INCREF(&pgRotationCache_Type);
+    if (PyModule_AddObject(module, "RotationCache",
+                           (PyObject *)&pgRotationCache_Type)) {
+        Py_DECREF(&pgRotationCache_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
     return module;
 }
@@ -25,6 +25,10 @@ Windows, MacOS, OS X, BeOS, FreeBSD, IRIX, and Linux."""
 
 import sys
 import os
+from importlib import import_module as _import_module
+from time import perf_counter as _perf_counter
+
+_import_start = _perf_counter()
 
 # Choose Windows display driver
 if os.name == "nt":
@@ -51,6 +55,8 @@ class MissingModule:
     _NOT_IMPLEMENTED_ = True
 
     def __init__(self, name, urgent=0):
+        import sys  # also made after the namespace cleanup, on first use
+
         self.name = name
         exc_type, exc_msg = sys.exc_info()[:2]
         self.info = str(exc_msg)
@@ -89,8 +95,8 @@ class MissingModule:
 from pygame.base import *  # pylint: disable=wildcard-import; lgtm[py/polluting-import]
 from pygame.constants import *  # now has __all__ pylint: disable=wildcard-import; lgtm[py/polluting-import]
 from pygame.version import *  # pylint: disable=wildcard-import; lgtm[py/polluting-import]
-from pygame.rect import Rect
-from pygame.rwobject import encode_string, encode_file_path
+from pygame.rect import Rect, FRect, RectArray, RectIndex, RectPacker
+from pygame.rwobject import encode_string, encode_file_path, Bundle
 import pygame.surflock
 import pygame.color
 
@@ -102,6 +108,8 @@ import pygame.math
 
 Vector2 = pygame.math.Vector2
 Vector3 = pygame.math.Vector3
+Vector2Array = pygame.math.Vector2Array
+Vector3Array = pygame.math.Vector3Array
 
 __version__ = ver
 
@@ -119,21 +127,11 @@ try:
 except (ImportError, OSError):
     display = MissingModule("display", urgent=1)
 
-try:
-    import pygame.draw
-except (ImportError, OSError):
-    draw = MissingModule("draw", urgent=1)
-
 try:
     import pygame.event
 except (ImportError, OSError):
     event = MissingModule("event", urgent=1)
 
-try:
-    import pygame.image
-except (ImportError, OSError):
-    image = MissingModule("image", urgent=1)
-
 try:
     import pygame.joystick
 except (ImportError, OSError):
@@ -149,31 +147,6 @@ try:
 except (ImportError, OSError):
     mouse = MissingModule("mouse", urgent=1)
 
-try:
-    import pygame.cursors
-    from pygame.cursors import Cursor
-except (ImportError, OSError):
-    cursors = MissingModule("cursors", urgent=1)
-
-    def Cursor(*args):  # pylint: disable=unused-argument
-        _attribute_undefined("pygame.Cursor")
-
-
-try:
-    import pygame.sprite
-except (ImportError, OSError):
-    sprite = MissingModule("sprite", urgent=1)
-
-try:
-    import pygame.threads
-except (ImportError, OSError):
-    threads = MissingModule("threads", urgent=1)
-
-try:
-    import pygame.pixelcopy
-except (ImportError, OSError):
-    pixelcopy = MissingModule("pixelcopy", urgent=1)
-
 
 def warn_unwanted_files():
     """warn about unneeded old files"""
@@ -229,7 +202,17 @@ def warn_unwanted_files():
 
 
 try:
-    from pygame.surface import Surface, SurfaceType
+    from pygame.surface import (
+        Surface,
+        SurfaceType,
+        SurfacePool,
+        SurfaceRegion,
+        HDRSurface,
+        convert_many,
+        get_bounding_rects,
+        set_auto_convert,
+        get_auto_convert,
+    )
 except (ImportError, OSError):
 
     def Surface(size, flags, depth, masks):  # pylint: disable=unused-argument
@@ -237,43 +220,34 @@ except (ImportError, OSError):
 
     SurfaceType = Surface
 
-try:
-    import pygame.mask
-    from pygame.mask import Mask
-except (ImportError, OSError):
-    mask = MissingModule("mask", urgent=0)
-
-    def Mask(size, fill):  # pylint: disable=unused-argument
-        _attribute_undefined("pygame.Mask")
-
+    def convert_many(surfaces, format=None, alpha=False):  # pylint: disable=unused-argument
+        _attribute_undefined("pygame.convert_many")
 
-try:
-    from pygame.pixelarray import PixelArray
-except (ImportError, OSError):
+    def get_bounding_rects(surfaces, min_alpha=1):  # pylint: disable=unused-argument
+        _attribute_undefined("pygame.get_bounding_rects")
 
-    def PixelArray(surface):  # pylint: disable=unused-argument
-        _attribute_undefined("pygame.PixelArray")
+    def set_auto_convert(enabled):  # pylint: disable=unused-argument
+        _attribute_undefined("pygame.set_auto_convert")
 
+    def get_auto_convert():
+        _attribute_undefined("pygame.get_auto_convert")
 
-try:
-    from pygame.overlay import Overlay
-except (ImportError, OSError):
+    def SurfacePool(max_buffers=16):  # pylint: disable=unused-argument
+        _attribute_undefined("pygame.SurfacePool")
 
-    def Overlay(format, size):  # pylint: disable=unused-argument
-        _attribute_undefined("pygame.Overlay")
+    def SurfaceRegion(surface, rect):  # pylint: disable=unused-argument
+        _attribute_undefined("pygame.SurfaceRegion")
 
+    def HDRSurface(size):  # pylint: disable=unused-argument
+        _attribute_undefined("pygame.HDRSurface")
 
 try:
     import pygame.time
 except (ImportError, OSError):
     time = MissingModule("time", urgent=1)
 
-try:
-    import pygame.transform
-except (ImportError, OSError):
-    transform = MissingModule("transform", urgent=1)
-
-# lastly, the "optional" pygame modules
+# font is loaded and initialised by pygame.init() anyway, and gets the
+# sysfont functions here
 if "PYGAME_FREETYPE" in os.environ:
     try:
         import pygame.ftfont as font
@@ -291,62 +265,91 @@ try:
 except (ImportError, OSError):
     font = MissingModule("font", urgent=0)
 
-# try and load pygame.mixer_music before mixer, for py2app...
-try:
-    import pygame.mixer_music
-
-    # del pygame.mixer_music
-    # print("NOTE2: failed importing pygame.mixer_music in lib/__init__.py")
-except (ImportError, OSError):
-    pass
-
-try:
-    import pygame.mixer
-except (ImportError, OSError):
-    mixer = MissingModule("mixer", urgent=0)
-
-try:
-    import pygame.scrap
-except (ImportError, OSError):
-    scrap = MissingModule("scrap", urgent=0)
+# the other modules are loaded on first use, by __getattr__ below, so that
+# a program only pays for the modules it uses. Each name maps to the module
+# to load, the attribute of it to give, or None for the module itself, and
+# whether a missing module warns when first used.
+_LAZY_ATTRIBUTES = {
+    "draw": ("draw", None, 1),
+    "image": ("image", None, 1),
+    "cursors": ("cursors", None, 1),
+    "Cursor": ("cursors", "Cursor", 1),
+    "sprite": ("sprite", None, 1),
+    "threads": ("threads", None, 1),
+    "pixelcopy": ("pixelcopy", None, 1),
+    "transform": ("transform", None, 1),
+    "mask": ("mask", None, 0),
+    "Mask": ("mask", "Mask", 0),
+    "atlas": ("atlas", None, 0),
+    "Atlas": ("atlas", "Atlas", 0),
+    "tilemap": ("tilemap", None, 0),
+    "Tilemap": ("tilemap", "Tilemap", 0),
+    "particles": ("particles", None, 0),
+    "ParticleSystem": ("particles", "ParticleSystem", 0),
+    "sharedsurface": ("sharedsurface", None, 0),
+    "SharedSurface": ("sharedsurface", "SharedSurface", 0),
+    "pixelarray": ("pixelarray", None, 0),
+    "PixelArray": ("pixelarray", "PixelArray", 0),
+    "overlay": ("overlay", None, 0),
+    "Overlay": ("overlay", "Overlay", 0),
+    "profiler": ("profiler", None, 0),
+    "assets": ("assets", None, 0),
+    "mixer": ("mixer", None, 0),
+    "mixer_music": ("mixer_music", None, 0),
+    "scrap": ("scrap", None, 0),
+    "surfarray": ("surfarray", None, 0),
+    "sndarray": ("sndarray", None, 0),
+    "fastevent": ("fastevent", None, 0),
+    "context": ("context", None, 0),
+    "pkgdata": ("pkgdata", None, 0),
+}
+
+# seconds taken to load the package, and each module loaded on first use
+_import_times = {}
+_sys_modules = sys.modules
+
+
+def _attribute_unavailable(name):
+    def unavailable(*args, **kwargs):  # pylint: disable=unused-argument
+        _attribute_undefined(f"pygame.{name}")
+
+    return unavailable
+
+
+def __getattr__(name):
+    try:
+        module_name, attribute, urgent = _LAZY_ATTRIBUTES[name]
+    except KeyError:
+        raise AttributeError(f"module 'pygame' has no attribute '{name}'") from None
 
-try:
-    import pygame.surfarray
-except (ImportError, OSError):
-    surfarray = MissingModule("surfarray", urgent=0)
+    start = _perf_counter()
+    loaded = f"pygame.{module_name}" in _sys_modules
+    try:
+        module = _import_module(f"pygame.{module_name}")
+    except (ImportError, OSError):
+        if attribute is None:
+            value = _MissingModule(module_name, urgent=urgent)
+        else:
+            value = _attribute_unavailable(name)
+    else:
+        value = module if attribute is None else getattr(module, attribute)
+    if not loaded:
+        _import_times[module_name] = _perf_counter() - start
 
-try:
-    import pygame.sndarray
-except (ImportError, OSError):
-    sndarray = MissingModule("sndarray", urgent=0)
+    globals()[name] = value
+    return value
 
-try:
-    import pygame.fastevent
-except (ImportError, OSError):
-    fastevent = MissingModule("fastevent", urgent=0)
 
-try:
-    import pygame.context
-except (ImportError, OSError):
-    context = MissingModule("context", urgent=0)
+def __dir__():
+    return sorted(set(globals()) | set(_LAZY_ATTRIBUTES))
 
-# there's also a couple "internal" modules not needed
-# by users, but putting them here helps "dependency finder"
-# programs get everything they need (like py2exe)
-try:
-    import pygame.imageext
 
-    del pygame.imageext
-except (ImportError, OSError):
-    pass
+def get_import_times():
+    """get the seconds taken to load pygame and its modules
 
-# this internal module needs to be included for dependency
-# finders, but can't be deleted, as some tests need it
-try:
-    import pygame.pkgdata
-
-except (ImportError, OSError):
-    pass
+    get_import_times() -> dict
+    """
+    return dict(_import_times)
 
 
 def packager_imports():
@@ -356,6 +359,33 @@ def packager_imports():
     import OpenGL.GL
     import pygame.macosx
     import pygame.colordict
+    import pygame.imageext
+
+    # the modules loaded on first use
+    import pygame.draw
+    import pygame.image
+    import pygame.cursors
+    import pygame.sprite
+    import pygame.threads
+    import pygame.pixelcopy
+    import pygame.transform
+    import pygame.mask
+    import pygame.atlas
+    import pygame.tilemap
+    import pygame.particles
+    import pygame.sharedsurface
+    import pygame.pixelarray
+    import pygame.overlay
+    import pygame.profiler
+    import pygame.assets
+    import pygame.mixer_music
+    import pygame.mixer
+    import pygame.scrap
+    import pygame.surfarray
+    import pygame.sndarray
+    import pygame.fastevent
+    import pygame.context
+    import pygame.pkgdata
 
 
 # make Rects pickleable
@@ -387,6 +417,8 @@ def __color_reduce(c):
 
 copyreg.pickle(Color, __color_reduce, __color_constructor)
 
+_MissingModule = MissingModule
+
 # Thanks for supporting pygame. Without support now, there won't be pygame later.
 if "PYGAME_HIDE_SUPPORT_PROMPT" not in os.environ:
     print(
@@ -396,5 +428,18 @@ if "PYGAME_HIDE_SUPPORT_PROMPT" not in os.environ:
     )
     print("Hello from the pygame community. https://www.pygame.org/contribute.html")
 
+# module __getattr__ is new in Python 3.7, so load everything before that
+if sys.version_info < (3, 7):
+    for _name in _LAZY_ATTRIBUTES:
+        __getattr__(_name)
+    del _name
+
 # cleanup namespace
 del pygame, os, sys, MissingModule, copyreg, warn_unwanted_files, packager_imports
+
+# "from pygame import *" still gives every module, loading them all
+__all__ = sorted(
+    {name for name in globals() if not name.startswith("_")} | set(_LAZY_ATTRIBUTES)
+)
+
+_import_times["pygame"] = _perf_counter() - _import_start
@@ -0,0 +1,196 @@
+#    pygame - Python Game Library
+#
+#    This library is free software; you can redistribute it and/or
+#    modify it under the terms of the GNU Library General Public
+#    License as published by the Free Software Foundation; either
+#    version 2 of the License, or (at your option) any later version.
+#
+#    This library is distributed in the hope that it will be useful,
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+#    Library General Public License for more details.
+#
+#    You should have received a copy of the GNU Library General Public
+#    License along with this library; if not, write to the Free
+#    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+"""pygame module for loading many images in the background
+
+A Batch loads its images a chunk at a time on a background thread. Each
+chunk is decoded and converted by pygame.image.load_many, on the worker
+threads set with pygame.set_num_threads, while the program carries on.
+Textures are made from the loaded images on the thread that asks for them,
+since a Renderer may only be used by the thread that made it.
+"""
+
+import threading
+import time
+
+import pygame.event
+import pygame.image
+
+__all__ = ["Batch", "load_batch"]
+
+
+class Batch:
+    """pygame object for a group of images loading in the background
+
+    Batch(files, convert=False, alpha=False, renderer=None, event=0,
+          chunk_size=16) -> Batch
+
+    The files are loaded chunk_size at a time, in order, as
+    pygame.image.load_many(chunk, convert, alpha) would. If event is given,
+    an event of that type is posted after each chunk, and when a chunk fails.
+    If renderer is given, update() and result() give Textures made with it,
+    and no more than two chunks of images wait to be made into Textures.
+    """
+
+    def __init__(
+        self, files, convert=False, alpha=False, renderer=None, event=0, chunk_size=16
+    ):
+        if chunk_size < 1:
+            raise ValueError("chunk_size must be positive")
+        self._files = list(files)
+        self.total = len(self._files)
+        self.loaded = 0
+        self._convert = convert
+        self._alpha = alpha
+        self._renderer = renderer
+        self._event = event
+        self._chunk_size = chunk_size
+        self._ready = []
+        self._results = []
+        self._error = None
+        self._finished = False
+        self._cancelled = False
+        self._cond = threading.Condition()
+        self._thread = threading.Thread(
+            target=self._run, name="pygame assets", daemon=True
+        )
+        self._thread.start()
+
+    def __len__(self):
+        return self.total
+
+    def _run(self):
+        for start in range(0, self.total, self._chunk_size):
+            with self._cond:
+                # the images waiting for update() are the memory in use
+                while (
+                    self._renderer is not None
+                    and len(self._ready) >= self._chunk_size
+                    and not self._cancelled
+                ):
+                    self._cond.wait()
+                if self._cancelled:
+                    break
+            chunk = self._files[start : start + self._chunk_size]
+            try:
+                surfaces = pygame.image.load_many(chunk, self._convert, self._alpha)
+            except Exception as e:  # pylint: disable=broad-except
+                with self._cond:
+                    self._error = e
+                self._post(str(e))
+                break
+            with self._cond:
+                self._ready.extend(surfaces)
+                self.loaded += len(surfaces)
+                self._cond.notify_all()
+            self._post(None)
+        with self._cond:
+            self._finished = True
+            self._cond.notify_all()
+
+    def _post(self, error):
+        if not self._event:
+            return
+        try:
+            pygame.event.post(
+                pygame.event.Event(
+                    self._event,
+                    batch=self,
+                    loaded=self.loaded,
+                    total=self.total,
+                    error=error,
+                )
+            )
+        except pygame.error:
+            pass  # the event module is not initialized
+
+    def done(self):
+        """check if the loading has finished
+
+        done() -> bool
+
+        Returns True once every image has been loaded, one has failed to
+        load, or the batch was cancelled.
+        """
+        with self._cond:
+            return self._finished
+
+    def cancel(self):
+        """stop loading after the chunk being loaded
+
+        cancel() -> None
+        """
+        with self._cond:
+            self._cancelled = True
+            self._cond.notify_all()
+
+    def update(self):
+        """take the images loaded since the last call
+
+        update() -> int
+
+        Makes Textures of the images loaded since the last call when the
+        Batch has a renderer, and returns how many images are ready in
+        total. Raises the error of a chunk that failed to load.
+        """
+        with self._cond:
+            ready = self._ready
+            self._ready = []
+            error = self._error
+            self._cond.notify_all()
+        if ready and self._renderer is not None:
+            # pylint: disable=import-outside-toplevel
+            from pygame._sdl2.video import Texture
+
+            ready = [Texture.from_surface(self._renderer, s) for s in ready]
+        self._results.extend(ready)
+        if error is not None:
+            raise error
+        return len(self._results)
+
+    def result(self, timeout=None):
+        """wait for every image and get them all
+
+        result(timeout=None) -> list
+
+        Returns the Surfaces, or Textures, in the order of the files. Raises
+        TimeoutError if they have not all loaded within timeout seconds.
+        """
+        deadline = None if timeout is None else time.monotonic() + timeout
+        while True:
+            with self._cond:
+                while not self._ready and not self._finished:
+                    remaining = None
+                    if deadline is not None:
+                        remaining = deadline - time.monotonic()
+                        if remaining <= 0:
+                            raise TimeoutError("the images are still loading")
+                    self._cond.wait(remaining)
+                finished = self._finished
+            self.update()
+            if finished:
+                return list(self._results)
+
+
+def load_batch(
+    files, convert=False, alpha=False, renderer=None, event=0, chunk_size=16
+):
+    """load many images in the background
+
+    load_batch(files, convert=False, alpha=False, renderer=None, event=0,
+               chunk_size=16) -> Batch
+    """
+    return Batch(files, convert, alpha, renderer, event, chunk_size)
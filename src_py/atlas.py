@@ -0,0 +1,154 @@
+#    pygame - Python Game Library
+#
+#    This library is free software; you can redistribute it and/or
+#    modify it under the terms of the GNU Library General Public
+#    License as published by the Free Software Foundation; either
+#    version 2 of the License, or (at your option) any later version.
+#
+#    This library is distributed in the hope that it will be useful,
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+#    Library General Public License for more details.
+#
+#    You should have received a copy of the GNU Library General Public
+#    License along with this library; if not, write to the Free
+#    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+"""pygame module for packing many small images into a few large ones
+
+An Atlas copies images into large surfaces, its pages, and hands back a
+subsurface of a page for each image. Blits of images that share a page read
+from the same memory, and each page can be uploaded as a single Texture.
+The images are placed by a pygame.RectPacker for each page.
+"""
+
+from pygame.constants import SRCALPHA
+from pygame.rect import Rect, RectPacker
+from pygame.surface import Surface
+
+__all__ = ["Atlas"]
+
+
+class Atlas:
+    """pygame object for packing many small images into a few large ones
+
+    Atlas(size=(1024, 1024), padding=1, flags=SRCALPHA, depth=32) -> Atlas
+
+    The images added are copied onto pages, surfaces of the given size,
+    flags and depth. A new page is made whenever an image does not fit on
+    the pages there are. The padding is the number of pixels kept clear
+    between images, so filtering a scaled Texture does not pick up the
+    pixels of a neighbour.
+    """
+
+    def __init__(self, size=(1024, 1024), padding=1, flags=SRCALPHA, depth=32):
+        width, height = size
+        if width < 1 or height < 1:
+            raise ValueError("size must be positive")
+        if padding < 0:
+            raise ValueError("padding must not be negative")
+        self.size = (width, height)
+        self.padding = padding
+        self.flags = flags
+        self.depth = depth
+        self.pages = []
+        self._packers = []
+        self._count = 0
+
+    def __len__(self):
+        return self._count
+
+    def __repr__(self):
+        name = self.__class__.__name__
+        return f"<{name}({len(self.pages)} pages, {self._count} images)>"
+
+    def add(self, surface):
+        """copy an image into the atlas
+
+        Atlas.add(surface): return Surface
+
+        Returns the subsurface of the page the image was copied to.
+        """
+        return self.add_many((surface,))[0]
+
+    def add_many(self, surfaces):
+        """copy many images into the atlas
+
+        Atlas.add_many(surfaces): return list
+
+        Places the images tallest first, which packs them more tightly than
+        adding them one at a time. Returns the subsurfaces of the pages the
+        images were copied to, in the order of the images given.
+        """
+        surfaces = list(surfaces)
+        width, height = self.size
+        padding = self.padding
+        sizes = []
+        for surface in surfaces:
+            surf_width, surf_height = surface.get_size()
+            if surf_width > width or surf_height > height:
+                raise ValueError(
+                    f"a {surf_width}x{surf_height} image does not fit on a "
+                    f"{width}x{height} page"
+                )
+            # the padding is kept on the right and below each image
+            sizes.append((surf_width + padding, surf_height + padding))
+
+        images = [None] * len(surfaces)
+        todo = list(range(len(surfaces)))
+        page_index = 0
+        while todo:
+            if page_index == len(self.pages):
+                self._new_page()
+            page = self.pages[page_index]
+            rects = self._packers[page_index].insertlist([sizes[i] for i in todo])
+            left = []
+            for i, rect in zip(todo, rects):
+                if rect is None:
+                    left.append(i)
+                    continue
+                surface = surfaces[i]
+                rect.size = surface.get_size()
+                page.blit(surface, rect)
+                images[i] = page.subsurface(rect)
+            todo = left
+            page_index += 1
+
+        self._count += len(images)
+        return images
+
+    def _new_page(self):
+        width, height = self.size
+        self.pages.append(Surface(self.size, self.flags, self.depth))
+        # the padding of the images along the right and bottom edges may
+        # fall outside the page
+        self._packers.append(
+            RectPacker((width + self.padding, height + self.padding))
+        )
+
+    def locate(self, image):
+        """find where an image is in the atlas
+
+        Atlas.locate(image): return (page_index, Rect)
+
+        Returns the index of the page holding a subsurface returned by add()
+        or add_many(), and its area on that page.
+        """
+        parent = image.get_parent()
+        for page_index, page in enumerate(self.pages):
+            if page is parent:
+                return page_index, Rect(image.get_offset(), image.get_size())
+        raise ValueError("the image is not in this atlas")
+
+    def textures(self, renderer):
+        """upload the pages as Textures
+
+        Atlas.textures(renderer): return list
+
+        Returns a pygame._sdl2.video.Texture for each page, made for the
+        given Renderer. Use locate() to find the area of an image in them.
+        """
+        # pylint: disable=import-outside-toplevel
+        from pygame._sdl2.video import Texture
+
+        return [Texture.from_surface(renderer, page) for page in self.pages]
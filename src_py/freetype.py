@@ -2,6 +2,7 @@
 
 from pygame._freetype import (
     Font,
+    TextLayout,
     STYLE_NORMAL,
     STYLE_OBLIQUE,
     STYLE_STRONG,
@@ -19,10 +20,14 @@ from pygame._freetype import (
     get_version,
     set_default_resolution,
 )
+from pygame.atlas import Atlas
+from pygame.color import Color
+from pygame.rect import Rect
 from pygame.sysfont import match_font, get_fonts, SysFont as _SysFont
 
 __all__ = [
     "Font",
+    "TextLayout",
     "STYLE_NORMAL",
     "STYLE_OBLIQUE",
     "STYLE_STRONG",
@@ -41,6 +46,7 @@ __all__ = [
     "set_default_resolution",
     "match_font",
     "get_fonts",
+    "GlyphAtlas",
 ]
 
 
@@ -76,3 +82,105 @@ def SysFont(name, size, bold=0, italic=0, constructor=None):
             return font
 
     return _SysFont(name, size, bold, italic, constructor)
+
+
+class GlyphAtlas:
+    """pygame object for drawing text from glyphs kept in an Atlas
+
+    GlyphAtlas(font, fgcolor, size=0, page_size=(512, 512)) -> GlyphAtlas
+
+    Each character is rendered once by the Font, in the given colour and
+    size, and its image kept on the pages of a pygame.Atlas. Drawing text
+    is then one Surface.blits() call of those images, or a copy of each
+    from one Texture per page.
+    """
+
+    def __init__(self, font, fgcolor, size=0, page_size=(512, 512)):
+        self.font = font
+        self.fgcolor = Color(fgcolor)
+        self.size = size
+        self.atlas = Atlas(page_size)
+        # char -> (image or None, left bearing, top bearing, advance)
+        self._glyphs = {}
+
+    def __len__(self):
+        return len(self._glyphs)
+
+    def _glyph(self, char):
+        glyph = self._glyphs.get(char)
+        if glyph is None:
+            surface, rect = self.font.render(char, self.fgcolor, size=self.size)
+            image = None
+            if surface.get_width() and surface.get_height():
+                image = self.atlas.add(surface)
+            metrics = self.font.get_metrics(char, size=self.size)[0]
+            advance = metrics[4] if metrics else rect.width
+            glyph = self._glyphs[char] = (image, rect.x, rect.y, advance)
+        return glyph
+
+    def add(self, text):
+        """render the characters of a text into the atlas
+
+        GlyphAtlas.add(text): return None
+
+        Characters are otherwise added as they are first drawn.
+        """
+        for char in text:
+            if char != "\n":
+                self._glyph(char)
+
+    def layout(self, text, dest=(0, 0)):
+        """find where the glyphs of a text go
+
+        GlyphAtlas.layout(text, dest=(0, 0)): return list
+
+        Returns a (image, Rect) pair for each glyph with any pixels. The
+        image is a subsurface of an Atlas page, and the Rect is where it goes
+        when the top left of the first line is at dest. A newline starts a
+        new line, one font height further down.
+        """
+        left, top = dest
+        height = self.font.get_sized_height(self.size)
+        baseline = top + self.font.get_sized_ascender(self.size)
+        pen = 0.0
+        placed = []
+        for char in text:
+            if char == "\n":
+                pen = 0.0
+                baseline += height
+                continue
+            image, bearing_x, bearing_y, advance = self._glyph(char)
+            if image is not None:
+                x = left + int(round(pen)) + bearing_x
+                rect = Rect((x, baseline - bearing_y), image.get_size())
+                placed.append((image, rect))
+            pen += advance
+        return placed
+
+    def render_to(self, surf, dest, text):
+        """draw text onto a surface
+
+        GlyphAtlas.render_to(surf, dest, text): return Rect
+
+        Blits the glyphs of the text with one Surface.blits() call, with the
+        top left of the first line at dest. Returns the area drawn to.
+        """
+        placed = self.layout(text, dest)
+        if not placed:
+            return Rect(dest, (0, 0))
+        rects = surf.blits([(image, rect) for image, rect in placed])
+        return rects[0].unionall(rects[1:])
+
+    def draw(self, textures, text, dest=(0, 0)):
+        """draw text with the textures of the atlas pages
+
+        GlyphAtlas.draw(textures, text, dest=(0, 0)): return None
+
+        textures are the Textures of the atlas pages, as returned by
+        Atlas.textures() on the atlas attribute. Each glyph is drawn with
+        Texture.draw() from the area of its page.
+        """
+        locate = self.atlas.locate
+        for image, rect in self.layout(text, dest):
+            page_index, area = locate(image)
+            textures[page_index].draw(area, rect)
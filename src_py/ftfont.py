@@ -16,6 +16,7 @@ from pygame._freetype import quit, get_default_font, get_init as _get_init
 from pygame._freetype import _internal_mod_init
 from pygame.sysfont import match_font, get_fonts, SysFont as _SysFont
 from pygame import encode_file_path
+from pygame.constants import FONT_LEFT
 
 
 class Font(_Font):
@@ -59,8 +60,11 @@ class Font(_Font):
         self.ucs4 = True
         self.underline_adjustment = 1.0
 
-    def render(self, text, antialias, color, background=None):
-        """render(text, antialias, color, background=None) -> Surface
+    def render(
+        self, text, antialias, color, background=None, wraplength=0, align=FONT_LEFT
+    ):
+        """render(text, antialias, color, background=None, wraplength=0,
+        align=FONT_LEFT) -> Surface
         draw text on a new Surface"""
 
         if text is None:
@@ -74,7 +78,9 @@ class Font(_Font):
         )
         self.antialiased = bool(antialias)
         try:
-            s, _ = super().render(text, color, background)
+            s, _ = super().render(
+                text, color, background, wraplength=wraplength, align=align
+            )
             return s
         finally:
             self.antialiased = save_antialiased
@@ -532,6 +532,7 @@ __all__ = [
     "OPENGL",
     "OPENGLBLIT",
     "PREALLOC",
+    "PREMULTIPLIED",
     "QUIT",
     "RENDER_DEVICE_RESET",
     "RENDER_TARGETS_RESET",
@@ -0,0 +1,108 @@
+#    pygame - Python Game Library
+#
+#    This library is free software; you can redistribute it and/or
+#    modify it under the terms of the GNU Library General Public
+#    License as published by the Free Software Foundation; either
+#    version 2 of the License, or (at your option) any later version.
+#
+#    This library is distributed in the hope that it will be useful,
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+#    Library General Public License for more details.
+#
+#    You should have received a copy of the GNU Library General Public
+#    License along with this library; if not, write to the Free
+#    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+"""pygame module for timing the parts of each frame
+
+The functions here time frames with a pygame.time.Profiler shared by the
+whole program. The spans are timed with the performance counter and kept in
+a ring buffer in C, so timing a span allocates nothing. draw() shows the
+recorded frames as a graph on a surface.
+"""
+
+from zlib import crc32
+
+from pygame.draw import line
+from pygame.rect import Rect
+from pygame.time import Profiler
+
+__all__ = [
+    "Profiler",
+    "frame_begin",
+    "frame_end",
+    "span",
+    "get_frames",
+    "clear",
+    "draw",
+]
+
+_profiler = Profiler()
+
+frame_begin = _profiler.frame_begin
+frame_end = _profiler.frame_end
+span = _profiler.span
+get_frames = _profiler.get_frames
+clear = _profiler.clear
+
+BACKGROUND = (16, 16, 24)
+OTHER = (96, 96, 96)
+TARGET = (255, 255, 255)
+COLORS = [
+    (230, 80, 70),
+    (90, 180, 80),
+    (70, 130, 220),
+    (230, 180, 50),
+    (170, 90, 200),
+    (60, 190, 190),
+    (230, 130, 60),
+    (200, 90, 140),
+]
+
+
+def _span_color(name):
+    """the color of a span, the same for a name in every run"""
+    return COLORS[crc32(name.encode("utf-8")) % len(COLORS)]
+
+
+def draw(surface, rect=None, target=1000 / 60, profiler=None):
+    """draw a graph of the recorded frames
+
+    draw(surface, rect=None, target=1000/60, profiler=None) -> Rect
+
+    Each frame is a column, the newest on the right, as tall as the frame
+    took, with its outermost spans in their own colors at the times they ran
+    and the rest of the frame in grey. The line across is the target frame
+    time, half way up the graph.
+    """
+    if profiler is None:
+        profiler = _profiler
+    if rect is None:
+        rect = (0, 0, 240, 60)
+    rect = Rect(rect).clip(surface.get_rect())
+    surface.fill(BACKGROUND, rect)
+    if rect.w < 1 or rect.h < 1:
+        return rect
+
+    frames = profiler.get_frames()[-rect.w :]
+    scale = rect.h / (2.0 * target)
+    width = max(1, rect.w // max(1, len(frames)))
+    x = rect.right - width * len(frames)
+    for frame_ms, spans in frames:
+        height = min(rect.h, round(frame_ms * scale))
+        surface.fill(OTHER, (x, rect.bottom - height, width, height))
+        for name, depth, start_ms, span_ms in spans:
+            if depth:
+                continue
+            height = round((start_ms + span_ms) * scale) - round(start_ms * scale)
+            y = rect.bottom - round(start_ms * scale)
+            if y - height < rect.top:
+                height = y - rect.top
+            if height > 0:
+                surface.fill(_span_color(name), (x, y - height, width, height))
+        x += width
+
+    y = rect.bottom - round(target * scale)
+    line(surface, TARGET, (rect.left, y), (rect.right - 1, y))
+    return rect
@@ -0,0 +1,125 @@
+#    pygame - Python Game Library
+#
+#    This library is free software; you can redistribute it and/or
+#    modify it under the terms of the GNU Library General Public
+#    License as published by the Free Software Foundation; either
+#    version 2 of the License, or (at your option) any later version.
+#
+#    This library is distributed in the hope that it will be useful,
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+#    Library General Public License for more details.
+#
+#    You should have received a copy of the GNU Library General Public
+#    License along with this library; if not, write to the Free
+#    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+"""pygame module for surfaces shared between processes
+
+A SharedSurface keeps its pixels in named shared memory, as a raw image like
+those written by pygame.image.save_raw(). Another process attaches to it by
+name and gets a Surface over the same memory, so frames are handed between
+processes without being copied or pickled. Only the name, and the small raw
+header read on attaching, are passed along.
+"""
+
+from multiprocessing import shared_memory
+
+from pygame import image
+from pygame.surface import Surface
+
+__all__ = ["SharedSurface"]
+
+
+class SharedSurface:
+    """pygame object for a Surface in memory shared between processes
+
+    SharedSurface(size, flags=0, depth=32, name=None) -> SharedSurface
+
+    Makes new shared memory holding a Surface of the given size, flags and
+    depth, under name or a name chosen by the system. Use attach() to reach
+    it from another process, and from_surface() to share a copy of a
+    Surface.
+    """
+
+    def __init__(self, size, flags=0, depth=32, name=None):
+        self._create(Surface(size, flags, depth), name)
+
+    @classmethod
+    def from_surface(cls, surface, name=None):
+        """share a copy of a Surface
+
+        SharedSurface.from_surface(surface, name=None): return SharedSurface
+
+        The shared Surface has the size, format, palette, colorkey and
+        alpha of surface, and a copy of its pixels.
+        """
+        shared = cls.__new__(cls)
+        shared._create(surface, name)
+        return shared
+
+    @classmethod
+    def attach(cls, name):
+        """reach a SharedSurface made by another process
+
+        SharedSurface.attach(name): return SharedSurface
+        """
+        shared = cls.__new__(cls)
+        shared._memory = shared_memory.SharedMemory(name)
+        try:
+            shared.surface = image.frombuffer_raw(shared._memory.buf)
+        except BaseException:
+            shared._memory.close()
+            raise
+        return shared
+
+    def _create(self, surface, name):
+        self._memory = shared_memory.SharedMemory(
+            name, create=True, size=image.raw_size(surface)
+        )
+        try:
+            image.tobuffer_raw(surface, self._memory.buf)
+            self.surface = image.frombuffer_raw(self._memory.buf)
+        except BaseException:
+            self._memory.close()
+            self._memory.unlink()
+            raise
+
+    def __repr__(self):
+        name = self.__class__.__name__
+        if self.surface is None:
+            return f"<{name}({self.name!r}, closed)>"
+        width, height = self.surface.get_size()
+        return f"<{name}({self.name!r}, {width}x{height})>"
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc_info):
+        self.close()
+
+    @property
+    def name(self):
+        """the name other processes attach with"""
+        return self._memory.name
+
+    def close(self):
+        """stop using the shared memory in this process
+
+        SharedSurface.close(): return None
+
+        Drops the surface attribute. Any other reference to the Surface, or
+        to a subsurface of it, must be dropped first, or BufferError is
+        raised.
+        """
+        self.surface = None
+        self._memory.close()
+
+    def unlink(self):
+        """free the shared memory once every process has closed it
+
+        SharedSurface.unlink(): return None
+
+        Call it once, from the process that made the SharedSurface.
+        """
+        self._memory.unlink()
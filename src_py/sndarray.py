@@ -74,22 +74,26 @@ def samples(sound):
     Creates a new array that directly references the samples in a Sound
     object. Modifying the array will change the Sound. The array will
     always be in the format returned from pygame.mixer.get_init().
+
+    A mixer.Stream can be passed too, for its free space up to where the
+    buffer wraps. Call its advance() with the number of frames written.
     """
 
     return numpy.array(sound, copy=False)
 
 
-def make_sound(array):
-    """pygame.sndarray.make_sound(array): return Sound
+def make_sound(array, copy=True):
+    """pygame.sndarray.make_sound(array, copy=True): return Sound
 
     Convert an array into a Sound object.
 
     Create a new playable Sound object from an array. The mixer module
     must be initialized and the array format must be similar to the mixer
-    audio format.
+    audio format. With copy=False the Sound plays the array in place, which
+    must then be in the mixer format exactly.
     """
 
-    return mixer.Sound(array=array)
+    return mixer.Sound(array=array, copy=copy)
 
 
 def use_arraytype(arraytype):
@@ -85,11 +85,15 @@ Sprites are not thread safe, so lock them yourself if using threads.
 # specific ones that aren't quite so general but fit into common
 # specialized cases.
 
+from array import array
+from bisect import bisect_left, insort
+from functools import partial
+from operator import attrgetter
 from warnings import warn
 
 import pygame
 
-from pygame.rect import Rect
+from pygame.rect import Rect, RectArray, RectIndex
 from pygame.time import get_ticks
 from pygame.mask import from_surface
 
@@ -342,6 +346,27 @@ class DirtySprite(Sprite):
         )
 
 
+def _update_calls(sprites):
+    """the calls Group.update() makes for sprites when cache_update is set"""
+    calls = []
+    batches = {}
+    for sprite in sprites:
+        cls = type(sprite)
+        batch_update = getattr(cls, "batch_update", None)
+        if batch_update is not None:
+            batch = batches.get(cls)
+            if batch is None:
+                batch = batches[cls] = []
+                calls.append(partial(batch_update, batch))
+            batch.append(sprite)
+            continue
+        update = sprite.update
+        # the update of the base class does nothing
+        if getattr(update, "__func__", None) is not Sprite.update:
+            calls.append(update)
+    return calls
+
+
 class AbstractGroup:
     """base class for containers of sprites
 
@@ -357,9 +382,20 @@ class AbstractGroup:
     # dummy val to identify sprite groups, and avoid infinite recursion
     _spritegroup = True
 
+    # when True, update() looks up the update methods of the sprites only
+    # when the sprites in the group change
+    cache_update = False
+
+    # when set, draw() blits the sprites in the order of this key
+    sort_key = None
+
     def __init__(self):
         self.spritedict = {}
         self.lostsprites = []
+        self._update_sprites = None
+        self._update_calls = None
+        self._sort_sprites = None
+        self._sort_order = None
 
     def sprites(self):
         """get a list of sprites in the group
@@ -533,10 +569,41 @@ class AbstractGroup:
         Calls the update method of every member sprite. All arguments that
         were passed to this method are passed to the Sprite update function.
 
+        When cache_update is True, the update methods are looked up again
+        only after the sprites in the group change. Sprites that do not
+        override Sprite.update are skipped, and the sprites of a class with
+        a batch_update(sprites, *args, **kwargs) class method are updated by
+        one call of it.
+
         """
+        if self.cache_update:
+            sprites = self.sprites()
+            if sprites != self._update_sprites:
+                self._update_sprites = sprites
+                self._update_calls = _update_calls(sprites)
+            for call in self._update_calls:
+                call(*args, **kwargs)
+            return
         for sprite in self.sprites():
             sprite.update(*args, **kwargs)
 
+    def _drawn_sprites(self):
+        """the sprites in the order draw() blits them"""
+        sprites = self.sprites()
+        sort_key = self.sort_key
+        if sort_key is None:
+            return sprites
+        if isinstance(sort_key, str):
+            sort_key = attrgetter(sort_key)
+        if sprites != self._sort_sprites:
+            self._sort_sprites = sprites
+            self._sort_order = list(sprites)
+        # list.sort merges the runs it finds in its input, so the order of
+        # the last frame, which is mostly still sorted, is sorted again in
+        # close to linear time
+        self._sort_order.sort(key=sort_key)
+        return self._sort_order
+
     def draw(self, surface):
         """draw all sprites onto the surface
 
@@ -545,7 +612,7 @@ class AbstractGroup:
         Draws all of the member sprites onto the given surface.
 
         """
-        sprites = self.sprites()
+        sprites = self._drawn_sprites()
         if hasattr(surface, "blits"):
             self.spritedict.update(
                 zip(sprites, surface.blits((spr.image, spr.rect) for spr in sprites))
@@ -656,7 +723,7 @@ class RenderUpdates(Group):
         dirty = self.lostsprites
         self.lostsprites = []
         dirty_append = dirty.append
-        for sprite in self.sprites():
+        for sprite in self._drawn_sprites():
             old_rect = self.spritedict[sprite]
             new_rect = surface_blit(sprite.image, sprite.rect)
             if old_rect:
@@ -725,12 +792,46 @@ class LayeredUpdates(AbstractGroup):
 
         """
         self._spritelayers = {}
-        self._spritelist = []
+        # layer -> the sprites in it, in the order they were added. A dict
+        # keeps that order and removes a sprite in constant time.
+        self._layers = {}
+        # the layers that hold sprites, bottom first
+        self._layer_order = []
+        self._sprite_cache = None
         AbstractGroup.__init__(self)
         self._default_layer = kwargs.get("default_layer", 0)
 
         self.add(*sprites, **kwargs)
 
+    def _add_to_layer(self, sprite, layer):
+        members = self._layers.get(layer)
+        if members is None:
+            members = self._layers[layer] = {}
+            insort(self._layer_order, layer)
+        members[sprite] = None
+        self._spritelayers[sprite] = layer
+        self._sprite_cache = None
+
+    def _remove_from_layer(self, sprite):
+        layer = self._spritelayers.pop(sprite)
+        members = self._layers[layer]
+        del members[sprite]
+        if not members:
+            del self._layers[layer]
+            del self._layer_order[bisect_left(self._layer_order, layer)]
+        self._sprite_cache = None
+
+    @property
+    def _spritelist(self):
+        """all the sprites, bottom layer first, built again after changes"""
+        sprites = self._sprite_cache
+        if sprites is None:
+            sprites = []
+            for layer in self._layer_order:
+                sprites.extend(self._layers[layer])
+            self._sprite_cache = sprites
+        return sprites
+
     def add_internal(self, sprite, layer=None):
         """Do not use this method directly.
 
@@ -748,25 +849,7 @@ class LayeredUpdates(AbstractGroup):
         elif hasattr(sprite, "_layer"):
             setattr(sprite, "_layer", layer)
 
-        sprites = self._spritelist  # speedup
-        sprites_layers = self._spritelayers
-        sprites_layers[sprite] = layer
-
-        # add the sprite at the right position
-        # bisect algorithmus
-        leng = len(sprites)
-        low = mid = 0
-        high = leng - 1
-        while low <= high:
-            mid = low + (high - low) // 2
-            if sprites_layers[sprites[mid]] <= layer:
-                low = mid + 1
-            else:
-                high = mid - 1
-        # linear search to find final position
-        while mid < leng and sprites_layers[sprites[mid]] <= layer:
-            mid += 1
-        sprites.insert(mid, sprite)
+        self._add_to_layer(sprite, layer)
 
     def add(self, *sprites, **kwargs):
         """add a sprite or sequence of sprites to a group
@@ -817,7 +900,7 @@ class LayeredUpdates(AbstractGroup):
         The group uses it to add a sprite.
 
         """
-        self._spritelist.remove(sprite)
+        self._remove_from_layer(sprite)
         # these dirty rects are suboptimal for one frame
         old_rect = self.spritedict[sprite]
         if old_rect is not self._init_rect:
@@ -826,7 +909,6 @@ class LayeredUpdates(AbstractGroup):
             self.lostsprites.append(sprite.rect)  # dirty rect
 
         del self.spritedict[sprite]
-        del self._spritelayers[sprite]
 
     def sprites(self):
         """return a ordered list of sprites (first back, last top).
@@ -848,18 +930,20 @@ class LayeredUpdates(AbstractGroup):
         self.lostsprites = []
         dirty_append = dirty.append
         init_rect = self._init_rect
-        for spr in self.sprites():
-            rec = spritedict[spr]
-            newrect = surface_blit(spr.image, spr.rect)
-            if rec is init_rect:
-                dirty_append(newrect)
-            else:
-                if newrect.colliderect(rec):
-                    dirty_append(newrect.union(rec))
-                else:
+        layers = self._layers
+        for layer in self._layer_order:
+            for spr in layers[layer]:
+                rec = spritedict[spr]
+                newrect = surface_blit(spr.image, spr.rect)
+                if rec is init_rect:
                     dirty_append(newrect)
-                    dirty_append(rec)
-            spritedict[spr] = newrect
+                else:
+                    if newrect.colliderect(rec):
+                        dirty_append(newrect.union(rec))
+                    else:
+                        dirty_append(newrect)
+                        dirty_append(rec)
+                spritedict[spr] = newrect
         return dirty
 
     def get_sprites_at(self, pos):
@@ -902,7 +986,7 @@ class LayeredUpdates(AbstractGroup):
         LayeredUpdates.layers(): return layers
 
         """
-        return sorted(set(self._spritelayers.values()))
+        return list(self._layer_order)
 
     def change_layer(self, sprite, new_layer):
         """change the layer of the sprite
@@ -913,33 +997,11 @@ class LayeredUpdates(AbstractGroup):
         checked.
 
         """
-        sprites = self._spritelist  # speedup
-        sprites_layers = self._spritelayers  # speedup
-
-        sprites.remove(sprite)
-        sprites_layers.pop(sprite)
-
-        # add the sprite at the right position
-        # bisect algorithmus
-        leng = len(sprites)
-        low = mid = 0
-        high = leng - 1
-        while low <= high:
-            mid = low + (high - low) // 2
-            if sprites_layers[sprites[mid]] <= new_layer:
-                low = mid + 1
-            else:
-                high = mid - 1
-        # linear search to find final position
-        while mid < leng and sprites_layers[sprites[mid]] <= new_layer:
-            mid += 1
-        sprites.insert(mid, sprite)
+        self._remove_from_layer(sprite)
+        self._add_to_layer(sprite, new_layer)
         if hasattr(sprite, "_layer"):
             setattr(sprite, "_layer", new_layer)
 
-        # add layer info
-        sprites_layers[sprite] = new_layer
-
     def get_layer_of_sprite(self, sprite):
         """return the layer that sprite is currently in
 
@@ -954,7 +1016,7 @@ class LayeredUpdates(AbstractGroup):
         LayeredUpdates.get_top_layer(): return layer
 
         """
-        return self._spritelayers[self._spritelist[-1]]
+        return self._layer_order[-1]
 
     def get_bottom_layer(self):
         """return the bottom layer
@@ -962,7 +1024,7 @@ class LayeredUpdates(AbstractGroup):
         LayeredUpdates.get_bottom_layer(): return layer
 
         """
-        return self._spritelayers[self._spritelist[0]]
+        return self._layer_order[0]
 
     def move_to_front(self, sprite):
         """bring the sprite to front layer
@@ -1005,17 +1067,7 @@ class LayeredUpdates(AbstractGroup):
         layer.
 
         """
-        sprites = []
-        sprites_append = sprites.append
-        sprite_layers = self._spritelayers
-        for spr in self._spritelist:
-            if sprite_layers[spr] == layer:
-                sprites_append(spr)
-            elif sprite_layers[spr] > layer:
-                # break after because no other will
-                # follow with same layer
-                break
-        return sprites
+        return list(self._layers.get(layer, ()))
 
     def switch_layer(self, layer1_nr, layer2_nr):
         """switch the sprites from layer1_nr to layer2_nr
@@ -1141,30 +1193,31 @@ class LayeredDirty(LayeredUpdates):
         # 0. decide whether to render with update or flip
         start_time = get_ticks()
         if self._use_update:  # dirty rects mode
-            # 1. find dirty area on screen and put the rects into
-            # self.lostsprites still not happy with that part
-            self._find_dirty_area(
+            # 1. find dirty area on screen, merged so that no two of its
+            # rects overlap
+            dirty_area = self._find_dirty_area(
                 latest_clip,
                 local_old_rect,
                 rect_type,
                 local_sprites,
                 local_update,
-                local_update.append,
                 self._init_rect,
             )
-            # can it be done better? because that is an O(n**2) algorithm in
-            # worst case
 
-            # clear using background
+            # clear using background, then 2. draw, all in one blits call
             if local_bgd is not None:
-                for rec in local_update:
-                    surf_blit_func(local_bgd, rec, rec)
-
-            # 2. draw
+                blit_list = [(local_bgd, rec, rec) for rec in dirty_area]
+            else:
+                blit_list = []
             self._draw_dirty_internal(
-                local_old_rect, rect_type, local_sprites, surf_blit_func, local_update
+                local_old_rect,
+                rect_type,
+                local_sprites,
+                surface.blits,
+                dirty_area,
+                blit_list,
             )
-            local_ret = list(local_update)
+            local_ret = list(dirty_area)
         else:  # flip, full screen mode
             if local_bgd is not None:
                 surf_blit_func(local_bgd, (0, 0))
@@ -1193,7 +1246,11 @@ class LayeredDirty(LayeredUpdates):
         return local_ret
 
     @staticmethod
-    def _draw_dirty_internal(_old_rect, _rect, _sprites, _surf_blit, _update):
+    def _draw_dirty_internal(
+        _old_rect, _rect, _sprites, _surf_blits, _update, _blit_list
+    ):
+        _blit_list_append = _blit_list.append
+        dirty_sprites = []
         for spr in _sprites:
             if spr.dirty < 1 and spr.visible:
                 # sprite not dirty; blit only the intersecting part
@@ -1210,59 +1267,53 @@ class LayeredDirty(LayeredUpdates):
 
                 _spr_rect_clip = _spr_rect.clip
 
-                for idx in _spr_rect.collidelistall(_update):
+                for idx in _update.colliderect(_spr_rect):
                     # clip
                     clip = _spr_rect_clip(_update[idx])
-                    _surf_blit(
-                        spr.image,
-                        clip,
+                    _blit_list_append(
                         (
-                            clip[0] + rect_offset_x,
-                            clip[1] + rect_offset_y,
-                            clip[2],
-                            clip[3],
-                        ),
-                        spr.blendmode,
+                            spr.image,
+                            clip,
+                            (
+                                clip[0] + rect_offset_x,
+                                clip[1] + rect_offset_y,
+                                clip[2],
+                                clip[3],
+                            ),
+                            spr.blendmode,
+                        )
                     )
             else:  # dirty sprite
                 if spr.visible:
-                    _old_rect[spr] = _surf_blit(
-                        spr.image, spr.rect, spr.source_rect, spr.blendmode
+                    dirty_sprites.append((len(_blit_list), spr))
+                    _blit_list_append(
+                        (spr.image, spr.rect, spr.source_rect, spr.blendmode)
                     )
                 if spr.dirty == 1:
                     spr.dirty = 0
 
+        blitted = _surf_blits(_blit_list)
+        for idx, spr in dirty_sprites:
+            _old_rect[spr] = blitted[idx]
+
     @staticmethod
-    def _find_dirty_area(
-        _clip, _old_rect, _rect, _sprites, _update, _update_append, init_rect
-    ):
+    def _find_dirty_area(_clip, _old_rect, _rect, _sprites, _update, init_rect):
+        # the lost areas and the new and old areas of the dirty sprites,
+        # with the overlapping ones merged in C
+        dirty_area = RectArray(_update)
+        dirty_area_append = dirty_area.append
         for spr in _sprites:
             if spr.dirty > 0:
                 # chose the right rect
                 if spr.source_rect:
-                    _union_rect = _rect(spr.rect.topleft, spr.source_rect.size)
+                    dirty_area_append(spr.rect.topleft, spr.source_rect.size)
                 else:
-                    _union_rect = _rect(spr.rect)
-
-                _union_rect_collidelist = _union_rect.collidelist
-                _union_rect_union_ip = _union_rect.union_ip
-                i = _union_rect_collidelist(_update)
-                while i > -1:
-                    _union_rect_union_ip(_update[i])
-                    del _update[i]
-                    i = _union_rect_collidelist(_update)
-                _update_append(_union_rect.clip(_clip))
+                    dirty_area_append(spr.rect)
 
                 if _old_rect[spr] is not init_rect:
-                    _union_rect = _rect(_old_rect[spr])
-                    _union_rect_collidelist = _union_rect.collidelist
-                    _union_rect_union_ip = _union_rect.union_ip
-                    i = _union_rect_collidelist(_update)
-                    while i > -1:
-                        _union_rect_union_ip(_update[i])
-                        del _update[i]
-                        i = _union_rect_collidelist(_update)
-                    _update_append(_union_rect.clip(_clip))
+                    dirty_area_append(_old_rect[spr])
+        dirty_area.merge_ip(_clip)
+        return dirty_area
 
     def clear(self, surface, bgd):
         """use to set background
@@ -1428,6 +1479,83 @@ class GroupSingle(AbstractGroup):
         return self.__sprite is sprite
 
 
+class ArrayGroup:
+    """A group that keeps its sprites in packed arrays
+
+    pygame.sprite.ArrayGroup(): return ArrayGroup
+
+    Instead of Sprite objects, each sprite is a row of three arrays: images,
+    a list of Surfaces; rects, a pygame.RectArray; and flags, an
+    array.array('i') of blit special_flags. draw() passes all three to
+    Surface.blit_array(), so drawing does no Python work per sprite. Move
+    the sprites by changing rects, for example with rects.move_ip() or
+    through its buffer.
+
+    """
+
+    def __init__(self):
+        self.images = []
+        self.rects = RectArray()
+        self.flags = array("i")
+
+    def add(self, image, rect=None, special_flags=0):
+        """add a sprite and return its index
+
+        ArrayGroup.add(image, rect=None, special_flags=0): return int
+
+        The rect defaults to image.get_rect().
+
+        """
+        self.rects.append(image.get_rect() if rect is None else rect)
+        self.images.append(image)
+        self.flags.append(special_flags)
+        return len(self.images) - 1
+
+    def remove(self, index):
+        """remove the sprite at index
+
+        ArrayGroup.remove(index): return None
+
+        The sprites after it move down one index, keeping the drawing order.
+
+        """
+        del self.rects[index]
+        del self.images[index]
+        del self.flags[index]
+
+    def empty(self):
+        """remove all sprites
+
+        ArrayGroup.empty(): return None
+
+        """
+        self.images = []
+        self.rects = RectArray()
+        self.flags = array("i")
+
+    def draw(self, surface):
+        """draw all sprites onto the surface
+
+        ArrayGroup.draw(surface): return None
+
+        """
+        surface.blit_array(self.images, self.rects, self.flags)
+
+    def clear(self, surface, bgd):
+        """erase the sprites with the matching area of bgd
+
+        ArrayGroup.clear(surface, bgd): return None
+
+        """
+        surface.blits([(bgd, rect, rect) for rect in self.rects], doreturn=0)
+
+    def __len__(self):
+        return len(self.images)
+
+    def __repr__(self):
+        return f"<{self.__class__.__name__}({len(self)} sprites)>"
+
+
 # Some different collision detection functions that could be used.
 def collide_rect(left, right):
     """collision detection between two sprites, using rects.
@@ -1650,6 +1778,63 @@ def collide_mask(left, right):
     return leftmask.overlap(rightmask, (xoffset, yoffset))
 
 
+# groupcollide() uses a RectIndex once it has at least this many pairs of
+# sprites to test
+_INDEX_MIN_PAIRS = 256
+
+
+def _collide_bounds(sprites, collided):
+    """bounding rects for the sprite areas tested by a collided callback
+
+    Returns a list with a Rect for each sprite that holds everything of the
+    sprite collided looks at, so sprites whose Rects do not collide cannot
+    collide. Returns None if collided is not one of the callbacks of this
+    module, or the area of a sprite cannot be bounded.
+
+    For the default collided the sprite rects themselves are returned, and
+    only if they are all Rects, so their collisions are exact.
+    """
+    if collided is None or collided is collide_rect:
+        bounds = [spr.rect for spr in sprites]
+        if all(type(rect) is Rect for rect in bounds):
+            return bounds
+        return None
+
+    bounds = []
+    append = bounds.append
+    if collided is collide_circle or isinstance(collided, collide_circle_ratio):
+        ratio = 1 if collided is collide_circle else collided.ratio
+        for spr in sprites:
+            rect = spr.rect
+            try:
+                radius = spr.radius
+            except AttributeError:
+                radius = 0.5 * ((rect.width**2 + rect.height**2) ** 0.5)
+                # store the radius on the sprite like collide_circle does
+                spr.radius = radius
+            radius *= ratio
+            if not 0 <= radius < 1 << 28:
+                return None
+            # a margin of a pixel or two covers the truncated float centers
+            half = int(radius) + 2
+            left = int(rect.centerx) - half
+            top = int(rect.centery) - half
+            append(Rect(left, top, half * 2, half * 2))
+        return bounds
+
+    if collided is collide_mask:
+        for spr in sprites:
+            try:
+                width, height = spr.mask.get_size()
+            except AttributeError:
+                width, height = spr.image.get_size()
+            rect = spr.rect
+            append(Rect(int(rect[0]) - 1, int(rect[1]) - 1, width + 2, height + 2))
+        return bounds
+
+    return None
+
+
 def spritecollide(sprite, group, dokill, collided=None):
     """find Sprites in a Group that intersect another Sprite
 
@@ -1670,6 +1855,22 @@ def spritecollide(sprite, group, dokill, collided=None):
     which will be used to calculate the collision.
 
     """
+    if collided is not None and collided is not collide_rect:
+        # test the bounds of all the sprites in one go, so the callback
+        # only runs for the sprites near enough to collide
+        group_sprites = group.sprites()
+        bounds = _collide_bounds(group_sprites + [sprite], collided)
+        if bounds is not None:
+            crashed = [
+                group_sprites[i]
+                for i in bounds.pop().collidelistall(bounds)
+                if collided(sprite, group_sprites[i])
+            ]
+            if dokill:
+                for group_sprite in crashed:
+                    group_sprite.kill()
+            return crashed
+
     # pull the default collision function in as a local variable outside
     # the loop as this makes the loop run faster
     default_sprite_collide_func = sprite.rect.colliderect
@@ -1722,6 +1923,24 @@ def groupcollide(groupa, groupb, dokilla, dokillb, collided=None):
 
     """
     crashed = {}
+    sprites_a = groupa.sprites()
+    sprites_b = groupb.sprites()
+    if len(sprites_a) * len(sprites_b) >= _INDEX_MIN_PAIRS:
+        bounds_b = _collide_bounds(sprites_b, collided)
+        bounds_a = bounds_b and _collide_bounds(sprites_a, collided)
+        if bounds_a:
+            _groupcollide_indexed(
+                crashed,
+                sprites_a,
+                sprites_b,
+                bounds_a,
+                bounds_b,
+                dokilla,
+                dokillb,
+                collided,
+            )
+            return crashed
+
     # pull the collision function in as a local variable outside
     # the loop as this makes the loop run faster
     sprite_collide_func = spritecollide
@@ -1739,6 +1958,48 @@ def groupcollide(groupa, groupb, dokilla, dokillb, collided=None):
     return crashed
 
 
+def _groupcollide_indexed(
+    crashed, sprites_a, sprites_b, bounds_a, bounds_b, dokilla, dokillb, collided
+):
+    """groupcollide() for the collided callbacks _collide_bounds() knows
+
+    Sorts the bounds of the second group into a RectIndex, a grid of cells in
+    C, so each sprite of the first group is only tested against the sprites
+    of the second group in the cells it covers. Gives the same results in the
+    same order as testing every pair.
+    """
+    # cells about as wide as the sprites are the fastest to search
+    cell_size = sum(rect[2] + rect[3] for rect in bounds_b) // (2 * len(bounds_b))
+    hits = RectIndex(bounds_b, max(cell_size, 8)).collidelist(bounds_a)
+    exact = collided is None or collided is collide_rect
+
+    # killed sprites leave groupb, so later sprites of groupa must miss them
+    killed = set()
+    if dokilla:
+        ids_b = {spr: i for i, spr in enumerate(sprites_b)}
+    for spr_a, ids in zip(sprites_a, hits):
+        if not ids:
+            continue
+        if killed:
+            ids = [i for i in ids if i not in killed]
+        if exact:
+            collision = [sprites_b[i] for i in ids]
+        else:
+            ids = [i for i in ids if collided(spr_a, sprites_b[i])]
+            collision = [sprites_b[i] for i in ids]
+        if not collision:
+            continue
+        if dokillb:
+            for spr_b in collision:
+                spr_b.kill()
+            killed.update(ids)
+        crashed[spr_a] = collision
+        if dokilla:
+            spr_a.kill()
+            if spr_a in ids_b:
+                killed.add(ids_b[spr_a])
+
+
 def spritecollideany(sprite, group, collided=None):
     """finds any sprites in a group that collide with the given sprite
 
@@ -202,8 +202,10 @@ def pixels3d(surface):
     Surface. Any changes to the array will affect the pixels in the
     Surface. This is a fast operation since no data is copied.
 
-    This will only work on Surfaces that have 24-bit or 32-bit
-    formats. Lower pixel formats cannot be referenced.
+    Surfaces whose color components are not whole bytes, such as 8-bit
+    and 16-bit Surfaces, cannot be referenced directly. For those the
+    array is a copy, and changes to it are written back to the Surface
+    when the array is deleted.
 
     The Surface this references will remain locked for the lifetime of
     the array (see the Surface.lock - lock the Surface memory for pixel
@@ -242,7 +244,9 @@ def pixels_alpha(surface):
     affect the pixels in the Surface. This is a fast operation since no
     data is copied.
 
-    This can only work on 32-bit Surfaces with a per-pixel alpha value.
+    This can only work on Surfaces with a per-pixel alpha value. The
+    alpha values of 16-bit Surfaces are copied and written back when the
+    array is deleted.
 
     The Surface this array references will remain locked for the
     lifetime of the array.
@@ -259,7 +263,8 @@ def pixels_red(surface):
     in a Surface. Any changes to the array will affect the pixels
     in the Surface. This is a fast operation since no data is copied.
 
-    This can only work on 24-bit or 32-bit Surfaces.
+    The values of 8-bit and 16-bit Surfaces are copied and written back
+    when the array is deleted.
 
     The Surface this array references will remain locked for the
     lifetime of the array.
@@ -294,7 +299,8 @@ def pixels_green(surface):
     in a Surface. Any changes to the array will affect the pixels
     in the Surface. This is a fast operation since no data is copied.
 
-    This can only work on 24-bit or 32-bit Surfaces.
+    The values of 8-bit and 16-bit Surfaces are copied and written back
+    when the array is deleted.
 
     The Surface this array references will remain locked for the
     lifetime of the array.
@@ -329,7 +335,8 @@ def pixels_blue(surface):
     in a Surface. Any changes to the array will affect the pixels
     in the Surface. This is a fast operation since no data is copied.
 
-    This can only work on 24-bit or 32-bit Surfaces.
+    The values of 8-bit and 16-bit Surfaces are copied and written back
+    when the array is deleted.
 
     The Surface this array references will remain locked for the
     lifetime of the array.
@@ -19,6 +19,7 @@
 # pete@shinners.org
 """sysfont, used in the font module to find system fonts"""
 
+import json
 import os
 import sys
 import warnings
@@ -201,6 +202,13 @@ def initsysfonts_unix(path="fc-list"):
     if sys.platform == "emscripten":
         return fonts
 
+    cache = _cache_path_unix()
+    if cache:
+        stamp = _font_dirs_stamp_unix()
+        fonts = _read_cache_unix(cache, path, stamp)
+        if fonts:
+            return fonts
+
     try:
         proc = subprocess.run(
             [path, ":", "file", "family", "style"],
@@ -235,9 +243,113 @@ def initsysfonts_unix(path="fc-list"):
                 # try the next one.
                 pass
 
+        if cache and fonts:
+            _write_cache_unix(cache, path, stamp, fonts)
+
     return fonts
 
 
+# the fc-list scan is cached on disk, keyed on the modification times of the
+# font directories, so that later runs don't have to wait on fc-list
+_CACHE_VERSION = 1
+
+
+def _cache_path_unix():
+    """
+    Returns the path of the system font cache file, or None if caching is
+    disabled by setting PYGAME_SYSFONT_CACHE to an empty string.
+    """
+    cache = os.environ.get("PYGAME_SYSFONT_CACHE")
+    if cache is not None:
+        return cache or None
+
+    if sys.platform == "darwin":
+        root = join(os.path.expanduser("~"), "Library", "Caches")
+    else:
+        root = os.environ.get("XDG_CACHE_HOME") or join(
+            os.path.expanduser("~"), ".cache"
+        )
+    return join(root, "pygame", "sysfont_cache.json")
+
+
+def _font_dirs_stamp_unix():
+    """
+    Lists the modification time of every directory fontconfig reads fonts or
+    its configuration from. Installing or removing a font changes the time of
+    the directory holding it, which invalidates the cache.
+    """
+    home = os.path.expanduser("~")
+    data_home = os.environ.get("XDG_DATA_HOME") or join(home, ".local", "share")
+    roots = (
+        "/etc/fonts",
+        "/usr/share/fonts",
+        "/usr/local/share/fonts",
+        join(home, ".fonts"),
+        join(data_home, "fonts"),
+    )
+
+    stamp = []
+    for root in roots:
+        for dirpath, _, _ in os.walk(root):
+            try:
+                stamp.append([dirpath, os.stat(dirpath).st_mtime_ns])
+            except OSError:
+                pass
+    return stamp
+
+
+def _read_cache_unix(cache, path, stamp):
+    """
+    Returns the font dictionary stored in the cache file, or an empty one if
+    the file is missing, unreadable or out of date.
+    """
+    fonts = {}
+    try:
+        with open(cache, encoding="utf-8") as f:
+            data = json.load(f)
+        if (
+            data["version"] != _CACHE_VERSION
+            or data["fc-list"] != path
+            or data["stamp"] != stamp
+        ):
+            return {}
+        for name, bold, italic, font in data["fonts"]:
+            _addfont(name, bold, italic, font, fonts)
+    except (OSError, ValueError, KeyError, TypeError):
+        return {}
+    return fonts
+
+
+def _write_cache_unix(cache, path, stamp, fonts):
+    """
+    Stores the font dictionary in the cache file. The file is replaced whole,
+    so that a concurrent reader never sees it half written, and failing to
+    write it is not an error.
+    """
+    data = {
+        "version": _CACHE_VERSION,
+        "fc-list": path,
+        "stamp": stamp,
+        "fonts": [
+            [name, bold, italic, font]
+            for name, styles in fonts.items()
+            for (bold, italic), font in styles.items()
+        ],
+    }
+    tmp = f"{cache}.{os.getpid()}.tmp"
+    try:
+        if dirname(cache):
+            os.makedirs(dirname(cache), exist_ok=True)
+        with open(tmp, "w", encoding="utf-8") as f:
+            json.dump(data, f)
+        os.replace(tmp, cache)
+    except OSError:
+        try:
+            os.remove(tmp)
+        except OSError:
+            pass
+
+
 def _parse_font_entry_unix(entry, fonts):
     """
     Parses an entry in the unix font data to add to the pygame font
@@ -0,0 +1,298 @@
+#    pygame - Python Game Library
+#
+#    This library is free software; you can redistribute it and/or
+#    modify it under the terms of the GNU Library General Public
+#    License as published by the Free Software Foundation; either
+#    version 2 of the License, or (at your option) any later version.
+#
+#    This library is distributed in the hope that it will be useful,
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+#    Library General Public License for more details.
+#
+#    You should have received a copy of the GNU Library General Public
+#    License along with this library; if not, write to the Free
+#    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+"""pygame module for drawing grids of tiles
+
+A Tilemap keeps a grid of tile indices and draws the part of it seen by a
+camera. The tiles are drawn a chunk at a time onto cached surfaces, so a
+frame costs a blit for each chunk in view rather than one for each tile.
+Changing a tile redraws only that tile of its chunk.
+"""
+
+import math
+from array import array
+
+from pygame.constants import SRCALPHA
+from pygame.rect import Rect
+from pygame.surface import Surface
+
+__all__ = ["Tilemap"]
+
+
+class Tilemap:
+    """pygame object for drawing a grid of tiles
+
+    Tilemap(tileset, tile_size, size, chunk_size=(16, 16), data=None) -> Tilemap
+
+    The tileset is a Surface cut into tiles of tile_size, numbered left to
+    right and then top to bottom, or a sequence of Surfaces of tile_size,
+    such as those returned by Atlas.add_many(). The map is size tiles
+    across and down. Each cell holds the index of its tile, or -1 for
+    none. data is an optional sequence of rows of indices to start with;
+    otherwise every cell is -1.
+    """
+
+    def __init__(self, tileset, tile_size, size, chunk_size=(16, 16), data=None):
+        tile_width, tile_height = tile_size
+        width, height = size
+        chunk_width, chunk_height = chunk_size
+        if tile_width < 1 or tile_height < 1:
+            raise ValueError("tile_size must be positive")
+        if width < 0 or height < 0:
+            raise ValueError("size must not be negative")
+        if chunk_width < 1 or chunk_height < 1:
+            raise ValueError("chunk_size must be positive")
+
+        if isinstance(tileset, Surface):
+            columns = tileset.get_width() // tile_width
+            rows = tileset.get_height() // tile_height
+            self.tiles = [
+                tileset.subsurface(
+                    (x * tile_width, y * tile_height, tile_width, tile_height)
+                )
+                for y in range(rows)
+                for x in range(columns)
+            ]
+        else:
+            self.tiles = list(tileset)
+        self.tile_size = (tile_width, tile_height)
+        self.size = (width, height)
+        self.chunk_size = (chunk_width, chunk_height)
+
+        self._grid = array("i", [-1]) * (width * height)
+        # chunk position -> cached Surface, and the tiles to redraw on it
+        self._chunks = {}
+        self._dirty = {}
+        # chunk position -> Texture, and the areas to upload to it
+        self._renderer = None
+        self._textures = {}
+        self._uploads = {}
+
+        if data is not None:
+            for y, row in enumerate(data):
+                for x, index in enumerate(row):
+                    self[x, y] = index
+
+    def __repr__(self):
+        name = self.__class__.__name__
+        return f"<{name}({self.size[0]}x{self.size[1]}, {len(self.tiles)} tiles)>"
+
+    def _offset(self, pos):
+        x, y = pos
+        width, height = self.size
+        if not (0 <= x < width and 0 <= y < height):
+            raise IndexError(f"tile position {(x, y)} is outside the map")
+        return y * width + x
+
+    def __getitem__(self, pos):
+        return self._grid[self._offset(pos)]
+
+    def __setitem__(self, pos, index):
+        offset = self._offset(pos)
+        if not -1 <= index < len(self.tiles):
+            raise ValueError(f"tile index {index} is not in the tileset")
+        if self._grid[offset] == index:
+            return
+        self._grid[offset] = index
+        x, y = pos
+        chunk = (x // self.chunk_size[0], y // self.chunk_size[1])
+        if chunk in self._chunks:
+            self._dirty.setdefault(chunk, set()).add((x, y))
+
+    def fill(self, index, rect=None):
+        """set many tiles to the same index
+
+        Tilemap.fill(index, rect=None): return None
+
+        Sets every tile in rect, given in tiles, or in the whole map.
+        """
+        area = Rect((0, 0), self.size)
+        if rect is not None:
+            area = area.clip(rect)
+        for y in range(area.top, area.bottom):
+            for x in range(area.left, area.right):
+                self[x, y] = index
+
+    def invalidate(self, rect=None):
+        """drop the cached chunks
+
+        Tilemap.invalidate(rect=None): return None
+
+        Drops the chunks overlapping rect, given in tiles, or all of them.
+        Call it after drawing onto the tiles, so they are drawn again. The
+        memory of the dropped chunks is freed.
+        """
+        if rect is None:
+            chunks = list(self._chunks)
+        else:
+            area = Rect(rect)
+            chunk_width, chunk_height = self.chunk_size
+            chunks = [
+                chunk
+                for chunk in self._chunks
+                if area.colliderect(
+                    (
+                        chunk[0] * chunk_width,
+                        chunk[1] * chunk_height,
+                        chunk_width,
+                        chunk_height,
+                    )
+                )
+            ]
+        for chunk in chunks:
+            del self._chunks[chunk]
+            self._dirty.pop(chunk, None)
+            self._textures.pop(chunk, None)
+            self._uploads.pop(chunk, None)
+
+    def _chunk_surface(self, chunk):
+        """the cached Surface of a chunk, with its changed tiles redrawn"""
+        surface = self._chunks.get(chunk)
+        if surface is not None and chunk not in self._dirty:
+            return surface
+
+        tile_width, tile_height = self.tile_size
+        chunk_width, chunk_height = self.chunk_size
+        left = chunk[0] * chunk_width
+        top = chunk[1] * chunk_height
+        if surface is None:
+            surface = Surface(
+                (chunk_width * tile_width, chunk_height * tile_height), SRCALPHA, 32
+            )
+            surface.fill((0, 0, 0, 0))
+            self._chunks[chunk] = surface
+            cells = [
+                (x, y)
+                for y in range(top, min(top + chunk_height, self.size[1]))
+                for x in range(left, min(left + chunk_width, self.size[0]))
+            ]
+            changed = [surface.get_rect()]
+        else:
+            cells = self._dirty.pop(chunk)
+            changed = []
+            for x, y in cells:
+                area = Rect(
+                    (x - left) * tile_width,
+                    (y - top) * tile_height,
+                    tile_width,
+                    tile_height,
+                )
+                surface.fill((0, 0, 0, 0), area)
+                changed.append(area)
+
+        width = self.size[0]
+        tiles = self.tiles
+        blits = []
+        for x, y in cells:
+            index = self._grid[y * width + x]
+            if index >= 0:
+                blits.append(
+                    (tiles[index], ((x - left) * tile_width, (y - top) * tile_height))
+                )
+        surface.blits(blits, doreturn=False)
+
+        if chunk in self._textures:
+            self._uploads.setdefault(chunk, []).extend(changed)
+        return surface
+
+    def _chunk_texture(self, renderer, chunk):
+        """the Texture of a chunk, up to date with its Surface"""
+        # pylint: disable=import-outside-toplevel
+        from pygame._sdl2.video import Texture
+
+        if renderer is not self._renderer:
+            self._renderer = renderer
+            self._textures = {}
+            self._uploads = {}
+        surface = self._chunk_surface(chunk)
+        texture = self._textures.get(chunk)
+        if texture is None:
+            texture = Texture.from_surface(renderer, surface)
+            self._textures[chunk] = texture
+            self._uploads.pop(chunk, None)
+        elif chunk in self._uploads:
+            for rect in self._uploads.pop(chunk):
+                texture.update(surface.subsurface(rect), rect)
+        return texture
+
+    def draw(self, target, camera=(0, 0), area=None):
+        """draw the tiles seen by a camera
+
+        Tilemap.draw(target, camera=(0, 0), area=None): return Rect
+
+        Draws onto target, a Surface or a pygame._sdl2.video.Renderer. The
+        map pixel at camera is drawn at the top left of area, which is the
+        whole target by default, and the tiles are drawn to fill area.
+        Returns the part of area the map was drawn on.
+        """
+        if isinstance(target, Surface):
+            view = Rect(area) if area is not None else target.get_rect()
+            view = view.clip(target.get_rect())
+        else:
+            if area is not None:
+                view = Rect(area)
+            else:
+                view = Rect((0, 0), target.get_viewport().size)
+
+        tile_width, tile_height = self.tile_size
+        chunk_width, chunk_height = self.chunk_size
+        chunk_pixel_width = chunk_width * tile_width
+        chunk_pixel_height = chunk_height * tile_height
+        camera_x = math.floor(camera[0])
+        camera_y = math.floor(camera[1])
+
+        # the part of the map in view, in map pixels
+        seen = Rect(camera_x, camera_y, view.w, view.h).clip(
+            (0, 0, self.size[0] * tile_width, self.size[1] * tile_height)
+        )
+        if not seen.w or not seen.h:
+            return Rect(view.x, view.y, 0, 0)
+
+        blits = []
+        for chunk_y in range(
+            seen.top // chunk_pixel_height, (seen.bottom - 1) // chunk_pixel_height + 1
+        ):
+            for chunk_x in range(
+                seen.left // chunk_pixel_width,
+                (seen.right - 1) // chunk_pixel_width + 1,
+            ):
+                chunk_rect = Rect(
+                    chunk_x * chunk_pixel_width,
+                    chunk_y * chunk_pixel_height,
+                    chunk_pixel_width,
+                    chunk_pixel_height,
+                )
+                part = chunk_rect.clip(seen)
+                dest = (view.x + part.x - camera_x, view.y + part.y - camera_y)
+                part.move_ip(-chunk_rect.x, -chunk_rect.y)
+                blits.append(((chunk_x, chunk_y), dest, part))
+
+        if isinstance(target, Surface):
+            target.blits(
+                [
+                    (self._chunk_surface(chunk), dest, part)
+                    for chunk, dest, part in blits
+                ],
+                doreturn=False,
+            )
+        else:
+            for chunk, dest, part in blits:
+                texture = self._chunk_texture(target, chunk)
+                texture.draw(part, Rect(dest, part.size))
+
+        return Rect(
+            view.x + seen.x - camera_x, view.y + seen.y - camera_y, seen.w, seen.h
+        )
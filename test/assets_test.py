@@ -0,0 +1,64 @@
+import os
+import shutil
+import tempfile
+import unittest
+
+import pygame
+from pygame import assets
+
+
+class AssetsTest(unittest.TestCase):
+    def setUp(self):
+        pygame.display.init()
+        self.tmpdir = tempfile.mkdtemp()
+        self.files = []
+        for i in range(10):
+            image = pygame.Surface((i + 1, 4))
+            image.fill((i * 20, 0, 0))
+            name = os.path.join(self.tmpdir, f"{i}.bmp")
+            pygame.image.save(image, name)
+            self.files.append(name)
+
+    def tearDown(self):
+        shutil.rmtree(self.tmpdir)
+        pygame.display.quit()
+
+    def test_load_batch(self):
+        batch = assets.load_batch(self.files, chunk_size=3)
+        images = batch.result(timeout=30)
+
+        self.assertTrue(batch.done())
+        self.assertEqual(len(batch), 10)
+        self.assertEqual(batch.loaded, 10)
+        self.assertEqual(batch.update(), 10)
+        self.assertEqual([image.get_width() for image in images], list(range(1, 11)))
+        self.assertEqual(images[4].get_at((0, 0)), (80, 0, 0, 255))
+
+    def test_load_batch__events(self):
+        loaded_event = pygame.event.custom_type()
+        batch = assets.load_batch(self.files, event=loaded_event, chunk_size=4)
+        batch.result(timeout=30)
+
+        events = pygame.event.get(loaded_event)
+        self.assertEqual([e.loaded for e in events], [4, 8, 10])
+        for event in events:
+            self.assertIs(event.batch, batch)
+            self.assertEqual(event.total, 10)
+            self.assertIsNone(event.error)
+
+    def test_load_batch__error(self):
+        files = self.files + [os.path.join(self.tmpdir, "missing.bmp")]
+        batch = assets.load_batch(files, chunk_size=4)
+
+        with self.assertRaises(pygame.error):
+            batch.result(timeout=30)
+        self.assertTrue(batch.done())
+        self.assertEqual(batch.loaded, 8)
+
+    def test_load_batch__invalid_chunk_size(self):
+        with self.assertRaises(ValueError):
+            assets.Batch(self.files, chunk_size=0)
+
+
+if __name__ == "__main__":
+    unittest.main()
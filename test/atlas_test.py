@@ -0,0 +1,102 @@
+import random
+import unittest
+
+import pygame
+from pygame.atlas import Atlas
+
+
+class AtlasTest(unittest.TestCase):
+    def _image(self, size, color):
+        image = pygame.Surface(size, pygame.SRCALPHA, 32)
+        image.fill(color)
+        return image
+
+    def _random_images(self, count, seed):
+        rand = random.Random(seed)
+        return [
+            self._image(
+                (rand.randint(1, 40), rand.randint(1, 40)),
+                (rand.randint(0, 255), rand.randint(0, 255), 255 - i, 255),
+            )
+            for i in range(count)
+        ]
+
+    def test_construction(self):
+        atlas = Atlas((128, 64), padding=2)
+
+        self.assertEqual(atlas.size, (128, 64))
+        self.assertEqual(atlas.padding, 2)
+        self.assertEqual(atlas.pages, [])
+        self.assertEqual(len(atlas), 0)
+        self.assertIs(pygame.Atlas, Atlas)
+
+    def test_construction__invalid(self):
+        with self.assertRaises(ValueError):
+            Atlas((0, 10))
+        with self.assertRaises(ValueError):
+            Atlas(padding=-1)
+
+    def test_add(self):
+        atlas = Atlas((64, 64))
+        source = self._image((10, 20), (10, 20, 30, 255))
+
+        image = atlas.add(source)
+
+        self.assertEqual(len(atlas), 1)
+        self.assertEqual(len(atlas.pages), 1)
+        self.assertIs(image.get_parent(), atlas.pages[0])
+        self.assertEqual(image.get_size(), (10, 20))
+        self.assertEqual(image.get_at((5, 5)), (10, 20, 30, 255))
+        self.assertEqual(atlas.locate(image), (0, pygame.Rect(0, 0, 10, 20)))
+
+    def test_add__whole_page(self):
+        atlas = Atlas((16, 16), padding=3)
+
+        image = atlas.add(self._image((16, 16), (1, 2, 3, 255)))
+
+        self.assertEqual(atlas.locate(image), (0, pygame.Rect(0, 0, 16, 16)))
+
+    def test_add__too_large(self):
+        atlas = Atlas((16, 16))
+
+        with self.assertRaises(ValueError):
+            atlas.add_many([self._image((8, 8), "red"), self._image((8, 17), "red")])
+        self.assertEqual(len(atlas), 0)
+
+    def test_add_many(self):
+        """The images are copied apart onto as many pages as needed."""
+        atlas = Atlas((100, 100), padding=1)
+        sources = self._random_images(60, 1)
+
+        images = atlas.add_many(sources)
+
+        self.assertEqual(len(atlas), 60)
+        self.assertGreater(len(atlas.pages), 1)
+        placed = [[] for _ in atlas.pages]
+        for source, image in zip(sources, images):
+            self.assertEqual(image.get_size(), source.get_size())
+            self.assertEqual(image.get_at((0, 0)), source.get_at((0, 0)))
+            page_index, rect = atlas.locate(image)
+            # the padding keeps images a pixel apart
+            self.assertEqual(rect.inflate(1, 1).collidelist(placed[page_index]), -1)
+            placed[page_index].append(rect.inflate(1, 1))
+
+    def test_add__fills_earlier_pages(self):
+        atlas = Atlas((20, 20), padding=0)
+        atlas.add(self._image((20, 15), "red"))
+        atlas.add(self._image((20, 15), "red"))
+
+        image = atlas.add(self._image((20, 5), "blue"))
+
+        self.assertEqual(atlas.locate(image), (0, pygame.Rect(0, 15, 20, 5)))
+
+    def test_locate__not_in_atlas(self):
+        atlas = Atlas((20, 20))
+        atlas.add(self._image((5, 5), "red"))
+
+        with self.assertRaises(ValueError):
+            atlas.locate(self._image((5, 5), "red"))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -1,3 +1,6 @@
+import json
+import os
+import subprocess
 import sys
 import unittest
 
@@ -36,6 +39,151 @@ class BaseModuleTest(unittest.TestCase):
         """Ensure the SDL version is valid"""
         self.assertEqual(len(pygame.get_sdl_version()), 3)
 
+    def test_set_num_threads(self):
+        """Ensure the thread count can be set, read back and restored"""
+        original = pygame.get_num_threads()
+        try:
+            pygame.set_num_threads(2)
+            self.assertEqual(pygame.get_num_threads(), 2)
+
+            pygame.set_num_threads(0)
+            self.assertGreaterEqual(pygame.get_num_threads(), 1)
+
+            pygame.set_num_threads(1)
+            self.assertEqual(pygame.get_num_threads(), 1)
+        finally:
+            pygame.set_num_threads(original)
+
+    def test_set_num_threads__invalid(self):
+        """Ensure bad thread counts are rejected"""
+        self.assertRaises(ValueError, pygame.set_num_threads, -1)
+        self.assertRaises(TypeError, pygame.set_num_threads, "2")
+
+    def test_get_num_threads__default(self):
+        """Ensure work stays on the calling thread by default"""
+        self.assertEqual(pygame.get_num_threads(), 1)
+
+    def test_get_parallel_threshold(self):
+        """Ensure the parallel threshold is a positive pixel count"""
+        threshold = pygame.get_parallel_threshold()
+
+        self.assertIsInstance(threshold, int)
+        self.assertGreater(threshold, 0)
+
+    def test_get_thread_pool_info(self):
+        """Ensure the pool reports its size and an idle occupancy"""
+        original = pygame.get_num_threads()
+        try:
+            pygame.set_num_threads(2)
+            self.assertEqual(pygame.get_thread_pool_info(), (2, 0, 0))
+
+            pygame.set_num_threads(1)
+            self.assertEqual(pygame.get_thread_pool_info(), (1, 0, 0))
+        finally:
+            pygame.set_num_threads(original)
+
+    def test_get_simd_backends(self):
+        """Ensure the usable SIMD backends are listed, scalar first"""
+        backends = pygame.get_simd_backends()
+
+        self.assertEqual(backends[0], "scalar")
+        for name in backends:
+            self.assertIn(name, ("scalar", "sse2", "avx2", "neon"))
+        self.assertIn(pygame.get_simd_backend(), backends)
+
+    def test_set_simd_backend(self):
+        """Ensure each usable backend can be forced and auto restored"""
+        original = pygame.get_simd_backend()
+        try:
+            for name in pygame.get_simd_backends():
+                pygame.set_simd_backend(name)
+                self.assertEqual(pygame.get_simd_backend(), name)
+        finally:
+            pygame.set_simd_backend("auto")
+        self.assertEqual(pygame.get_simd_backend(), original)
+
+    def test_set_simd_backend__scalar_results(self):
+        """Ensure additive blits give the same pixels with and without SIMD"""
+        src = pygame.Surface((67, 5), pygame.SRCALPHA)
+        for x in range(67):
+            src.fill((x * 3, 255 - x, x, x * 2), (x, 0, 1, 5))
+        results = []
+        try:
+            for name in ("scalar", "auto"):
+                pygame.set_simd_backend(name)
+                dst = pygame.Surface((67, 5), 0, 32)
+                dst.fill((10, 200, 30))
+                dst.blit(src, (0, 0), None, pygame.BLEND_RGB_ADD)
+                results.append(pygame.image.tostring(dst, "RGBA"))
+        finally:
+            pygame.set_simd_backend("auto")
+
+        self.assertEqual(results[0], results[1])
+
+    def test_set_simd_backend__invalid(self):
+        """Ensure unknown and unsupported backends are rejected"""
+        self.assertRaises(ValueError, pygame.set_simd_backend, "mmx2")
+        self.assertRaises(TypeError, pygame.set_simd_backend, 1)
+        for name in ("sse2", "avx2", "neon"):
+            if name not in pygame.get_simd_backends():
+                self.assertRaises(ValueError, pygame.set_simd_backend, name)
+
+    def test_stats(self):
+        """Ensure blits are counted while the counters are on"""
+        src = pygame.Surface((20, 10), pygame.SRCALPHA)
+        dst = pygame.Surface((20, 10), 0, 32)
+        try:
+            pygame.set_stats_enabled(True)
+            pygame.stats(reset=True)
+            dst.blit(src, (0, 0), None, pygame.BLEND_RGB_ADD)
+            stats = pygame.stats()
+        finally:
+            pygame.set_stats_enabled(False)
+
+        self.assertEqual(
+            sorted(stats),
+            ["blit", "convert", "display", "draw", "event", "text", "transform"],
+        )
+        self.assertEqual(len(stats["blit"]), 1)
+        counts = list(stats["blit"].values())[0]
+        self.assertEqual(counts["calls"], 1)
+        self.assertEqual(counts["pixels"], 200)
+        self.assertGreaterEqual(counts["ns"], 0)
+
+    def test_stats__reset(self):
+        """Ensure nothing is counted after a reset or while turned off"""
+        surf = pygame.Surface((5, 5), 0, 32)
+        try:
+            pygame.set_stats_enabled(True)
+            pygame.draw.line(surf, (255, 0, 0), (0, 0), (4, 4))
+            self.assertIn("line", pygame.stats(reset=True)["draw"])
+            self.assertEqual(pygame.stats()["draw"], {})
+        finally:
+            pygame.set_stats_enabled(False)
+
+        pygame.draw.line(surf, (255, 0, 0), (0, 0), (4, 4))
+        self.assertEqual(pygame.stats()["draw"], {})
+
+    def test_save_trace(self):
+        """Ensure the recorded calls are written as Chrome trace events"""
+        import io
+        import json
+
+        surf = pygame.Surface((8, 8), 0, 32)
+        out = io.StringIO()
+        try:
+            pygame.set_stats_enabled(True, trace=True)
+            pygame.draw.rect(surf, (0, 255, 0), (1, 1, 5, 5), 1, 2)
+            pygame.save_trace(out)
+        finally:
+            pygame.set_stats_enabled(False)
+            pygame.stats(reset=True)
+
+        events = json.loads(out.getvalue())["traceEvents"]
+        self.assertEqual([e["name"] for e in events], ["rect"])
+        self.assertEqual(events[0]["cat"], "draw")
+        self.assertEqual(events[0]["ph"], "X")
+
     class ExporterBase:
         def __init__(self, shape, typechar, itemsize):
             import ctypes
@@ -620,6 +768,52 @@ class BaseModuleTest(unittest.TestCase):
 
         self.assertFalse(pygame.get_init())
 
+    def test_get_import_times(self):
+        """Ensures get_import_times gives the seconds taken by imports."""
+        pygame.draw  # pylint: disable=pointless-statement
+        times = pygame.get_import_times()
+
+        self.assertIsInstance(times, dict)
+        self.assertGreater(times["pygame"], 0)
+        for seconds in times.values():
+            self.assertIsInstance(seconds, float)
+        times.clear()
+        self.assertIn("pygame", pygame.get_import_times())
+
+    def test_lazy_modules(self):
+        """Ensures modules outside the core are imported on first use."""
+        script = (
+            "import json, sys, pygame\n"
+            "before = 'pygame.draw' in sys.modules\n"
+            "listed = 'draw' in dir(pygame)\n"
+            "pygame.draw.line\n"
+            "print(json.dumps([before, listed, 'pygame.draw' in sys.modules,"
+            " sorted(pygame.get_import_times())]))\n"
+        )
+        env = dict(os.environ, PYGAME_HIDE_SUPPORT_PROMPT="1")
+        output = subprocess.run(
+            [sys.executable, "-c", script],
+            check=True,
+            env=env,
+            stdout=subprocess.PIPE,
+        ).stdout
+        before, listed, after, names = json.loads(output.splitlines()[-1])
+
+        self.assertFalse(before)
+        self.assertTrue(listed)
+        self.assertTrue(after)
+        self.assertIn("pygame", names)
+        self.assertIn("draw", names)
+
+    def test_star_import(self):
+        """Ensures from pygame import * still gives the modules used lazily."""
+        namespace = {}
+        exec("from pygame import *", namespace)  # pylint: disable=exec-used
+
+        self.assertIs(namespace["draw"], pygame.draw)
+        self.assertIs(namespace["Rect"], pygame.Rect)
+        self.assertNotIn("_import_times", namespace)
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -0,0 +1,431 @@
+"""Micro-benchmarks for pygame's C hot paths
+
+python -m pygame.tests.bench [-k PATTERN] [-o FILE] [--threads N] [--list]
+
+or
+
+python test/bench.py [<options>]
+
+Each benchmark times one call of a pygame function on fixed inputs, so runs
+on the same machine can be compared between pygame releases. The results are
+written as JSON with the environment they were measured in, including the
+CPU features the SIMD code paths are picked by. The output only depends on
+the timings, so two result files can be diffed or loaded for comparison.
+"""
+
+import fnmatch
+import json
+import optparse
+import os
+import platform
+import sys
+import timeit
+
+os.environ.setdefault("SDL_VIDEODRIVER", "dummy")
+
+import pygame
+
+SCHEMA_VERSION = 1
+
+# the size of the surfaces most benchmarks work on
+SIZE = (640, 480)
+
+BENCHMARKS = {}
+
+
+def benchmark(name):
+    """Registers a benchmark under name
+
+    The decorated function is called once to set up the inputs and returns the
+    function to time. It may return None when the benchmark does not apply to
+    this build, say for a smoothscale backend the CPU lacks.
+    """
+
+    def register(setup):
+        if name in BENCHMARKS:
+            raise ValueError(f"benchmark {name} is already defined")
+        BENCHMARKS[name] = setup
+        return setup
+
+    return register
+
+
+def _gradient_surface(size, flags=0, depth=32):
+    """A surface with varied colors, and alpha when flags has SRCALPHA"""
+    surf = pygame.Surface(size, flags, depth)
+    w, h = size
+    for y in range(0, h, 8):
+        for x in range(0, w, 8):
+            color = (x * 255 // w, y * 255 // h, (x + y) * 255 // (w + h))
+            alpha = (x ^ y) & 0xFF
+            surf.fill(color + (alpha,), (x, y, 8, 8))
+    return surf
+
+
+def _cpu_features():
+    """The SIMD instruction sets pygame picks code paths by, where known"""
+    wanted = ("mmx", "sse", "sse2", "sse4_1", "sse4_2", "avx", "avx2", "neon")
+    found = set()
+    try:
+        with open("/proc/cpuinfo", encoding="ascii", errors="replace") as f:
+            for line in f:
+                key, _, value = line.partition(":")
+                if key.strip() in ("flags", "Features"):
+                    found.update(value.split())
+    except OSError:
+        pass
+    if "asimd" in found:
+        found.add("neon")
+    if not found and platform.machine().lower() in ("arm64", "aarch64"):
+        found.add("neon")
+    return sorted(name for name in wanted if name in found)
+
+
+def environment():
+    """Describes where the results were measured"""
+    return {
+        "pygame": pygame.version.ver,
+        "sdl": ".".join(str(n) for n in pygame.get_sdl_version()),
+        "python": platform.python_version(),
+        "implementation": platform.python_implementation(),
+        "platform": sys.platform,
+        "machine": platform.machine(),
+        "cpu_features": _cpu_features(),
+        "smoothscale_backend": pygame.transform.get_smoothscale_backend(),
+        "threads": pygame.get_num_threads(),
+    }
+
+
+###########################################################################
+# Blits
+
+
+def _blit_setup(flags=0, alpha=None, colorkey=None, special_flags=0):
+    src = _gradient_surface(SIZE, flags)
+    dst = _gradient_surface(SIZE)
+    if alpha is not None:
+        src.set_alpha(alpha)
+    if colorkey is not None:
+        src.set_colorkey(colorkey)
+    return lambda: dst.blit(src, (0, 0), None, special_flags)
+
+
+@benchmark("blit.opaque")
+def bench_blit_opaque():
+    return _blit_setup()
+
+
+@benchmark("blit.per_pixel_alpha")
+def bench_blit_per_pixel_alpha():
+    return _blit_setup(pygame.SRCALPHA)
+
+
+@benchmark("blit.surface_alpha")
+def bench_blit_surface_alpha():
+    return _blit_setup(alpha=128)
+
+
+@benchmark("blit.colorkey")
+def bench_blit_colorkey():
+    return _blit_setup(colorkey=(0, 0, 0))
+
+
+@benchmark("blit.colorkey_alpha")
+def bench_blit_colorkey_alpha():
+    return _blit_setup(alpha=128, colorkey=(0, 0, 0))
+
+
+def _register_blend(name, special_flags, flags=0):
+    benchmark(f"blit.blend.{name}")(
+        lambda: _blit_setup(flags, special_flags=special_flags)
+    )
+
+
+for _name in ("add", "sub", "mult", "min", "max"):
+    _register_blend(_name, getattr(pygame, f"BLEND_RGB_{_name.upper()}"))
+    _register_blend(
+        f"rgba_{_name}",
+        getattr(pygame, f"BLEND_RGBA_{_name.upper()}"),
+        pygame.SRCALPHA,
+    )
+_register_blend("premultiplied", pygame.BLEND_PREMULTIPLIED, pygame.SRCALPHA)
+del _name
+
+
+###########################################################################
+# Transforms
+
+
+def _register_smoothscale(backend):
+    def setup(size):
+        try:
+            pygame.transform.set_smoothscale_backend(backend)
+        except ValueError:
+            return None
+        src = _gradient_surface(SIZE)
+
+        def run():
+            pygame.transform.set_smoothscale_backend(backend)
+            pygame.transform.smoothscale(src, size)
+
+        return run
+
+    benchmark(f"transform.smoothscale.{backend.lower()}.shrink")(
+        lambda: setup((SIZE[0] // 3, SIZE[1] // 3))
+    )
+    benchmark(f"transform.smoothscale.{backend.lower()}.expand")(
+        lambda: setup((SIZE[0] * 2, SIZE[1] * 2))
+    )
+
+
+for _backend in ("GENERIC", "MMX", "SSE"):
+    _register_smoothscale(_backend)
+del _backend
+
+
+@benchmark("transform.scale")
+def bench_transform_scale():
+    src = _gradient_surface(SIZE)
+    return lambda: pygame.transform.scale(src, (SIZE[0] * 2, SIZE[1] * 2))
+
+
+@benchmark("transform.rotate.90")
+def bench_transform_rotate_90():
+    src = _gradient_surface(SIZE)
+    return lambda: pygame.transform.rotate(src, 90)
+
+
+@benchmark("transform.rotate.33")
+def bench_transform_rotate_33():
+    src = _gradient_surface(SIZE, pygame.SRCALPHA)
+    return lambda: pygame.transform.rotate(src, 33)
+
+
+@benchmark("transform.rotozoom")
+def bench_transform_rotozoom():
+    src = _gradient_surface(SIZE, pygame.SRCALPHA)
+    return lambda: pygame.transform.rotozoom(src, 33, 1.5)
+
+
+###########################################################################
+# Drawing
+
+
+def _draw_setup(draw):
+    surf = _gradient_surface(SIZE)
+    return lambda: draw(surf)
+
+
+@benchmark("draw.line")
+def bench_draw_line():
+    return _draw_setup(lambda s: pygame.draw.line(s, "red", (0, 0), (639, 479), 5))
+
+
+@benchmark("draw.aaline")
+def bench_draw_aaline():
+    return _draw_setup(lambda s: pygame.draw.aaline(s, "red", (0, 0), (639, 479)))
+
+
+@benchmark("draw.lines")
+def bench_draw_lines():
+    points = [(x, (x * 37) % 480) for x in range(0, 640, 16)]
+    return _draw_setup(lambda s: pygame.draw.lines(s, "red", False, points, 3))
+
+
+@benchmark("draw.rect.filled")
+def bench_draw_rect_filled():
+    return _draw_setup(lambda s: pygame.draw.rect(s, "red", (20, 20, 600, 440)))
+
+
+@benchmark("draw.rect.outline")
+def bench_draw_rect_outline():
+    rect = (20, 20, 600, 440)
+    return _draw_setup(lambda s: pygame.draw.rect(s, "red", rect, 4, 12))
+
+
+@benchmark("draw.circle.filled")
+def bench_draw_circle_filled():
+    return _draw_setup(lambda s: pygame.draw.circle(s, "red", (320, 240), 200))
+
+
+@benchmark("draw.circle.outline")
+def bench_draw_circle_outline():
+    return _draw_setup(lambda s: pygame.draw.circle(s, "red", (320, 240), 200, 6))
+
+
+@benchmark("draw.ellipse")
+def bench_draw_ellipse():
+    return _draw_setup(lambda s: pygame.draw.ellipse(s, "red", (20, 20, 600, 440)))
+
+
+@benchmark("draw.polygon")
+def bench_draw_polygon():
+    points = [(320, 20), (620, 200), (500, 460), (140, 460), (20, 200)]
+    return _draw_setup(lambda s: pygame.draw.polygon(s, "red", points))
+
+
+###########################################################################
+# Masks and rects
+
+
+def _mask_pair():
+    surf = _gradient_surface(SIZE, pygame.SRCALPHA)
+    mask = pygame.mask.from_surface(surf)
+    other = pygame.mask.from_surface(pygame.transform.flip(surf, True, False))
+    return mask, other
+
+
+@benchmark("mask.from_surface")
+def bench_mask_from_surface():
+    surf = _gradient_surface(SIZE, pygame.SRCALPHA)
+    return lambda: pygame.mask.from_surface(surf)
+
+
+@benchmark("mask.overlap")
+def bench_mask_overlap():
+    mask, other = _mask_pair()
+    other.clear()
+    other.set_at((SIZE[0] - 11, SIZE[1] - 11))
+    return lambda: mask.overlap(other, (10, 10))
+
+
+@benchmark("mask.overlap_area")
+def bench_mask_overlap_area():
+    mask, other = _mask_pair()
+    return lambda: mask.overlap_area(other, (10, 10))
+
+
+@benchmark("rect.collidelist")
+def bench_rect_collidelist():
+    rects = [pygame.Rect(x * 7 % 600, x * 13 % 440, 8, 8) for x in range(1000)]
+    rect = pygame.Rect(-20, -20, 10, 10)
+    return lambda: rect.collidelist(rects)
+
+
+@benchmark("rect.collidelistall")
+def bench_rect_collidelistall():
+    rects = [pygame.Rect(x * 7 % 600, x * 13 % 440, 8, 8) for x in range(1000)]
+    rect = pygame.Rect(100, 100, 200, 200)
+    return lambda: rect.collidelistall(rects)
+
+
+###########################################################################
+# Running
+
+
+def run(names, repeat=5, min_time=0.05):
+    """Times the named benchmarks, returning a list of result dicts
+
+    Each benchmark is first called until a run takes at least min_time
+    seconds, to choose how many calls make a run. Then the best and median
+    of repeat runs are reported, in seconds per call. Benchmarks that do not
+    apply to this build are left out.
+    """
+    results = []
+    for name in names:
+        func = BENCHMARKS[name]()
+        if func is None:
+            continue
+        timer = timeit.Timer(func)
+        number = 1
+        while timer.timeit(number) < min_time:
+            number *= 2
+        times = sorted(t / number for t in timer.repeat(repeat, number))
+        results.append(
+            {
+                "name": name,
+                "best": times[0],
+                "median": times[len(times) // 2],
+                "calls": number,
+                "repeat": repeat,
+            }
+        )
+    return results
+
+
+def select(patterns):
+    """The names of the benchmarks matching any of the fnmatch patterns"""
+    names = sorted(BENCHMARKS)
+    if not patterns:
+        return names
+    return [n for n in names if any(fnmatch.fnmatch(n, p) for p in patterns)]
+
+
+def main(args=None):
+    parser = optparse.OptionParser(
+        usage="%prog [-k PATTERN] [-o FILE] [--threads N] [--list]"
+    )
+    parser.add_option(
+        "-k",
+        "--filter",
+        action="append",
+        dest="patterns",
+        default=[],
+        metavar="PATTERN",
+        help="only run benchmarks matching this fnmatch pattern, "
+        "such as 'blit.*'; may be repeated",
+    )
+    parser.add_option(
+        "-o",
+        "--output",
+        metavar="FILE",
+        help="write the JSON results to FILE instead of standard output",
+    )
+    parser.add_option(
+        "-r",
+        "--repeat",
+        type="int",
+        default=5,
+        help="runs per benchmark (default %default)",
+    )
+    parser.add_option(
+        "-t",
+        "--min-time",
+        type="float",
+        default=0.05,
+        help="shortest run in seconds (default %default)",
+    )
+    parser.add_option(
+        "--threads",
+        type="int",
+        help="worker thread count, as for pygame.set_num_threads()",
+    )
+    parser.add_option(
+        "-l", "--list", action="store_true", help="list the benchmark names"
+    )
+    options, extra = parser.parse_args(args)
+    if extra:
+        parser.error(f"unexpected arguments: {' '.join(extra)}")
+    if options.repeat < 1:
+        parser.error("--repeat must be at least 1")
+
+    names = select(options.patterns)
+    if options.list:
+        print("\n".join(names))
+        return 0
+
+    pygame.init()
+    try:
+        backend = pygame.transform.get_smoothscale_backend()
+        if options.threads is not None:
+            pygame.set_num_threads(options.threads)
+        report = {
+            "schema": SCHEMA_VERSION,
+            "environment": environment(),
+            "results": run(names, options.repeat, options.min_time),
+        }
+        pygame.transform.set_smoothscale_backend(backend)
+    finally:
+        pygame.quit()
+
+    text = json.dumps(report, indent=2, sort_keys=True)
+    if options.output:
+        with open(options.output, "w", encoding="utf-8") as f:
+            f.write(text + "\n")
+    else:
+        print(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,3 +1,4 @@
+import array
 import unittest
 
 import pygame
@@ -150,6 +151,382 @@ class BlitTest(unittest.TestCase):
             TypeError, dst.blits, [(pygame.Surface((10, 10), SRCALPHA, 32), None)]
         )
 
+    def test_blits_mixed_flags(self):
+        """blits gives the same pixels and rects as blitting one at a time,
+        however its items are grouped."""
+        sprite = pygame.Surface((6, 6), SRCALPHA, 32)
+        sprite.fill((200, 40, 40, 180))
+        glow = pygame.Surface((8, 8), SRCALPHA, 32)
+        glow.fill((30, 30, 90, 255))
+        items = []
+        for i in range(20):
+            items.append((sprite, (i * 5 % 37, i * 3 % 13)))
+            items.append((glow, (i * 7 % 33, i * 2 % 11), None, BLEND_ADD))
+        items.append((sprite, (-3, -3), (1, 1, 4, 4)))
+        items.append((glow, (36, 14), None, BLEND_RGBA_MULT))
+
+        expected = pygame.Surface((40, 20), SRCALPHA, 32)
+        expected.fill((10, 60, 10, 255))
+        dst = expected.copy()
+        expected_rects = [expected.blit(*item) for item in items]
+
+        for blit_sequence in (items, tuple(items), iter(items)):
+            dst.fill((10, 60, 10, 255))
+            self.assertEqual(dst.blits(blit_sequence), expected_rects)
+            self.assertEqual(
+                pygame.image.tostring(dst, "RGBA"),
+                pygame.image.tostring(expected, "RGBA"),
+            )
+
+    def test_fblits_single_source(self):
+        dst = pygame.Surface((40, 10), SRCALPHA, 32)
+        dst.fill((230, 230, 230))
+        src = pygame.Surface((10, 10), SRCALPHA, 32)
+        src.fill((10, 20, 30))
+        positions = array.array("i", [0, 0, 20, 0])
+
+        self.assertIsNone(dst.fblits(src, positions))
+        self.assertEqual(dst.get_at((5, 5)), (10, 20, 30))
+        self.assertEqual(dst.get_at((15, 5)), (230, 230, 230))
+        self.assertEqual(dst.get_at((25, 5)), (10, 20, 30))
+
+    def test_fblits_indexed_sources(self):
+        NUM_SURFS = 25
+        dst = pygame.Surface((NUM_SURFS * 10, 10), SRCALPHA, 32)
+        expected = pygame.Surface(dst.get_size(), SRCALPHA, 32)
+        dst.fill((230, 230, 230))
+        expected.fill((230, 230, 230))
+        blit_list = self.make_blit_list(NUM_SURFS)
+        sources = [surf for surf, _ in blit_list]
+        records = array.array("i")
+        for i, (surf, dest) in enumerate(blit_list):
+            records.extend((i, dest[0], dest[1]))
+
+        dst.fblits(sources, records)
+        expected.blits(blit_list, doreturn=0)
+
+        for x in range(dst.get_width()):
+            self.assertEqual(dst.get_at((x, 5)), expected.get_at((x, 5)))
+
+    def test_fblits_subsurface(self):
+        parent = pygame.Surface((30, 10), SRCALPHA, 32)
+        parent.fill((0, 0, 0))
+        dst = parent.subsurface((10, 0, 10, 10))
+        src = pygame.Surface((10, 10), SRCALPHA, 32)
+        src.fill((255, 0, 0))
+
+        # The second blit is clipped to the subsurface.
+        dst.fblits(src, array.array("i", [5, 0, 15, 0]))
+        self.assertEqual(parent.get_at((9, 5)), (0, 0, 0))
+        self.assertEqual(parent.get_at((15, 5)), (255, 0, 0))
+        self.assertEqual(parent.get_at((20, 5)), (0, 0, 0))
+
+    def test_fblits_bad_args(self):
+        dst = pygame.Surface((100, 10), SRCALPHA, 32)
+        src = pygame.Surface((10, 10), SRCALPHA, 32)
+
+        self.assertRaises(ValueError, dst.fblits, src, array.array("i", [0]))
+        self.assertRaises(
+            ValueError, dst.fblits, [src], array.array("i", [0, 0])
+        )
+        self.assertRaises(TypeError, dst.fblits, src, array.array("d", [0, 0]))
+        self.assertRaises(TypeError, dst.fblits, src, [0, 0])
+        self.assertRaises(TypeError, dst.fblits, [None], array.array("i"))
+        self.assertRaises(
+            IndexError, dst.fblits, [src], array.array("i", [1, 0, 0])
+        )
+
+    def test_blit_many(self):
+        for flags in (0, BLEND_RGBA_ADD, BLEND_RGB_MULT):
+            dst = pygame.Surface((50, 20), SRCALPHA, 32)
+            expected = pygame.Surface((50, 20), SRCALPHA, 32)
+            dst.fill((100, 50, 25, 200))
+            expected.fill((100, 50, 25, 200))
+            src = pygame.Surface((10, 10), SRCALPHA, 32)
+            src.fill((40, 80, 120, 128))
+            # includes positions clipped on every side and one fully outside
+            xy = [(-5, -5), (20, 5), (45, 15), (8, 2), (100, 100)]
+            positions = array.array("i", [c for pos in xy for c in pos])
+
+            self.assertIsNone(dst.blit_many(src, positions, flags))
+            for pos in xy:
+                expected.blit(src, pos, special_flags=flags)
+
+            for x in range(50):
+                for y in range(20):
+                    self.assertEqual(
+                        dst.get_at((x, y)), expected.get_at((x, y)), (flags, x, y)
+                    )
+
+    def test_blit_many_self(self):
+        surf = pygame.Surface((20, 10), SRCALPHA, 32)
+        surf.fill((255, 0, 0, 255), (0, 0, 10, 10))
+        surf.fill((0, 0, 0, 0), (10, 0, 10, 10))
+
+        surf.blit_many(surf, array.array("i", [10, 0]))
+        self.assertEqual(surf.get_at((15, 5)), (255, 0, 0, 255))
+
+    def test_blit_many_extreme_positions(self):
+        """Positions near the ends of the int32 range draw nothing"""
+        low, high = -(2**31), 2**31 - 1
+        xy = [(low, low), (high, high), (low, 0), (0, high), (high - 5, low + 5)]
+        positions = array.array("i", [c for pos in xy for c in pos])
+        src = pygame.Surface((10, 10), SRCALPHA, 32)
+        src.fill((40, 80, 120, 128))
+
+        for flags in (0, BLEND_RGBA_ADD):
+            dst = pygame.Surface((50, 20), SRCALPHA, 32)
+            dst.fill((100, 50, 25, 200))
+            sub = dst.subsurface((5, 5, 20, 10))
+
+            dst.blit_many(src, positions, flags)
+            sub.blit_many(src, positions, flags)
+            dst.fblits([src], array.array("i", [0, low, high, 0, high, low]), flags)
+
+            for x in range(50):
+                for y in range(20):
+                    self.assertEqual(dst.get_at((x, y)), (100, 50, 25, 200))
+
+    def test_blit_many_bad_args(self):
+        dst = pygame.Surface((100, 10), SRCALPHA, 32)
+        src = pygame.Surface((10, 10), SRCALPHA, 32)
+
+        self.assertRaises(ValueError, dst.blit_many, src, array.array("i", [0]))
+        self.assertRaises(TypeError, dst.blit_many, src, b"\0" * 8)
+        self.assertRaises(TypeError, dst.blit_many, None, array.array("i"))
+
+
+    def _tileset(self):
+        tiles = pygame.Surface((30, 10), SRCALPHA, 32)
+        for i, color in enumerate([(255, 0, 0), (0, 255, 0), (0, 0, 255)]):
+            tiles.fill(color, (i * 10, 0, 10, 10))
+        return tiles
+
+    def test_blit_region(self):
+        tiles = self._tileset()
+        cases = [(3, 4, None), (0, 0, (2, 3, 5, 4)), (7, -2, (-4, -1, 20, 8))]
+        for x, y, area in cases:
+            dst = pygame.Surface((30, 20), SRCALPHA, 32)
+            expected = pygame.Surface((30, 20), SRCALPHA, 32)
+            region = tiles.region(10, 0, 10, 10)
+
+            rect = dst.blit(region, (x, y), area)
+            self.assertEqual(
+                rect, expected.blit(region.subsurface(), (x, y), area), area
+            )
+            for px in range(30):
+                for py in range(20):
+                    self.assertEqual(dst.get_at((px, py)), expected.get_at((px, py)))
+
+        # nothing around the region is drawn
+        dst = pygame.Surface((30, 10), SRCALPHA, 32)
+        dst.blit(tiles.region(10, 0, 10, 10), (10, 0), (-10, 0, 30, 10))
+        self.assertEqual(dst.get_at((5, 5)), (0, 0, 0, 0))
+        self.assertEqual(dst.get_at((15, 5)), (0, 255, 0, 255))
+        self.assertEqual(dst.get_at((25, 5)), (0, 0, 0, 0))
+
+    def test_blits_region(self):
+        tiles = self._tileset()
+        dst = pygame.Surface((30, 10), SRCALPHA, 32)
+        dst.blits(
+            [
+                (tiles.region(20, 0, 10, 10), (0, 0)),
+                (tiles.region(0, 0, 10, 10), (10, 0), (0, 0, 5, 10)),
+                (tiles.region(10, 0, 10, 10), (20, 0), None, BLEND_RGBA_ADD),
+            ]
+        )
+        self.assertEqual(dst.get_at((5, 5)), (0, 0, 255, 255))
+        self.assertEqual(dst.get_at((12, 5)), (255, 0, 0, 255))
+        self.assertEqual(dst.get_at((17, 5)), (0, 0, 0, 0))
+        self.assertEqual(dst.get_at((25, 5)), (0, 255, 0, 255))
+
+    def test_fblits_regions(self):
+        tiles = self._tileset()
+        regions = [tiles.region(i * 10, 0, 10, 10) for i in range(3)]
+        dst = pygame.Surface((40, 10), SRCALPHA, 32)
+
+        dst.fblits(regions, array.array("i", [2, 0, 0, 0, 10, 0, 1, 35, 0]))
+        self.assertEqual(dst.get_at((5, 5)), (0, 0, 255, 255))
+        self.assertEqual(dst.get_at((15, 5)), (255, 0, 0, 255))
+        self.assertEqual(dst.get_at((25, 5)), (0, 0, 0, 0))
+        self.assertEqual(dst.get_at((37, 5)), (0, 255, 0, 255))
+
+        dst = pygame.Surface((40, 10), SRCALPHA, 32)
+        dst.fblits(regions[1], array.array("i", [0, 0, 30, 0]))
+        self.assertEqual(dst.get_at((5, 5)), (0, 255, 0, 255))
+        self.assertEqual(dst.get_at((15, 5)), (0, 0, 0, 0))
+        self.assertEqual(dst.get_at((35, 5)), (0, 255, 0, 255))
+
+    def test_blit_many_region(self):
+        tiles = self._tileset()
+        dst = pygame.Surface((40, 10), SRCALPHA, 32)
+
+        dst.blit_many(tiles.region(20, 0, 10, 10), array.array("i", [0, 0, 20, 0]))
+        self.assertEqual(dst.get_at((5, 5)), (0, 0, 255, 255))
+        self.assertEqual(dst.get_at((15, 5)), (0, 0, 0, 0))
+        self.assertEqual(dst.get_at((25, 5)), (0, 0, 255, 255))
+
+    def _indexed(self, w, h):
+        src = pygame.Surface((w, h), 0, 8)
+        src.set_palette([(i, 255 - i, (i * 7) % 256) for i in range(256)])
+        for x in range(w):
+            for y in range(h):
+                src.set_at((x, y), src.get_palette_at((x * 3 + y * 5) % 256))
+        return src
+
+    def test_blit_palette8(self):
+        src = self._indexed(37, 9)
+        for dst_flags in (0, SRCALPHA):
+            for key in (None, 5):
+                src.set_colorkey(None if key is None else src.get_palette_at(key))
+                dst = pygame.Surface((40, 12), dst_flags, 32)
+                dst.fill((1, 2, 3))
+                dst.blit(src, (2, 1))
+                for x in range(37):
+                    for y in range(9):
+                        index = (x * 3 + y * 5) % 256
+                        expected = src.get_palette_at(index)
+                        if index == key:
+                            expected = pygame.Color(1, 2, 3)
+                        self.assertEqual(
+                            dst.get_at((x + 2, y + 1)),
+                            expected,
+                            (dst_flags, key, x, y),
+                        )
+                self.assertEqual(dst.get_at((0, 0)), (1, 2, 3, 255))
+                self.assertEqual(dst.get_at((39, 11)), (1, 2, 3, 255))
+
+    def test_blit_palette8_cycling(self):
+        src = self._indexed(20, 4)
+        dst = pygame.Surface((20, 4), 0, 32)
+        palette = src.get_palette()
+        for shift in (1, 2, 0):
+            src.set_palette(palette[shift:] + palette[:shift])
+            dst.blit(src, (0, 0))
+            self.assertEqual(dst.get_at((1, 0)), palette[3 + shift])
+            dst.blit_many(src, array.array("i", [0, 0]))
+            self.assertEqual(dst.get_at((0, 1)), palette[5 + shift])
+
+        src.set_palette_at(3, (9, 8, 7))
+        dst.blit(src, (0, 0))
+        self.assertEqual(dst.get_at((1, 0)), (9, 8, 7, 255))
+
+    def _rgb565_pattern(self, w, h, seed):
+        surf = pygame.Surface((w, h), 0, 16)
+        for x in range(w):
+            for y in range(h):
+                color = (x * 37 + seed, y * 59 + seed, x * y + seed)
+                surf.set_at((x, y), [c % 256 for c in color])
+        return surf
+
+    def test_blit_rgb565_blend(self):
+        """16 bit blends match blending the 8 bit channels get_at gives"""
+        ops = {
+            BLEND_ADD: lambda s, d: min(s + d, 255),
+            BLEND_SUB: lambda s, d: max(d - s, 0),
+            BLEND_MULT: lambda s, d: (s * d + 255) >> 8 if s and d else 0,
+            BLEND_MIN: min,
+            BLEND_MAX: max,
+        }
+        src = self._rgb565_pattern(13, 3, 11)
+        packed = pygame.Surface((1, 1), 0, 16)
+        for flag, op in ops.items():
+            dst = self._rgb565_pattern(15, 4, 90)
+            before = dst.copy()
+            dst.blit(src, (1, 1), special_flags=flag)
+            for x in range(13):
+                for y in range(3):
+                    s = src.get_at((x, y))
+                    d = before.get_at((x + 1, y + 1))
+                    packed.set_at((0, 0), [op(s[i], d[i]) for i in range(3)])
+                    self.assertEqual(
+                        dst.get_at((x + 1, y + 1)), packed.get_at((0, 0)), (flag, x, y)
+                    )
+            self.assertEqual(dst.get_at((0, 0)), before.get_at((0, 0)))
+            self.assertEqual(dst.get_at((14, 3)), before.get_at((14, 3)))
+
+    def test_blit_rgb565_alpha(self):
+        """per pixel alpha over 16 bits matches the blend equation"""
+        src = pygame.Surface((13, 3), SRCALPHA, 32)
+        for x in range(13):
+            for y in range(3):
+                alpha = (x * 41 + y * 97) % 256
+                src.set_at((x, y), (x * 19 % 256, y * 83, x * 7, alpha))
+        packed = pygame.Surface((1, 1), 0, 16)
+        for modulate in (255, 100):
+            src.set_alpha(modulate)
+            dst = self._rgb565_pattern(13, 3, 45)
+            before = dst.copy()
+            dst.blit(src, (0, 0))
+            for x in range(13):
+                for y in range(3):
+                    s = src.get_at((x, y))
+                    d = before.get_at((x, y))
+                    a = s.a * modulate // 255
+                    packed.set_at(
+                        (0, 0),
+                        [(((s[i] - d[i]) * a + s[i]) >> 8) + d[i] for i in range(3)],
+                    )
+                    self.assertEqual(
+                        dst.get_at((x, y)), packed.get_at((0, 0)), (modulate, x, y)
+                    )
+
+    def test_blit_array(self):
+        dst = pygame.Surface((60, 20), SRCALPHA, 32)
+        expected = pygame.Surface((60, 20), SRCALPHA, 32)
+        dst.fill((100, 50, 25, 200))
+        expected.fill((100, 50, 25, 200))
+        red = pygame.Surface((10, 10), SRCALPHA, 32)
+        red.fill((200, 0, 0, 128))
+        blue = pygame.Surface((6, 4), SRCALPHA, 32)
+        blue.fill((0, 0, 200, 255))
+        sources = [red, red, blue, red, blue]
+        # the rect sizes are ignored, as with blit()
+        rects = pygame.RectArray(
+            [
+                (-5, -5, 1, 1),
+                (20, 5, 0, 0),
+                (45, 15, 6, 4),
+                (8, 2, 10, 10),
+                (30, 3, 6, 4),
+            ]
+        )
+        flags = array.array("i", [0, BLEND_RGBA_ADD, 0, BLEND_RGB_MULT, 0])
+
+        self.assertIsNone(dst.blit_array(sources, rects, flags))
+        for source, rect, flag in zip(sources, rects, flags):
+            expected.blit(source, rect, special_flags=flag)
+
+        for x in range(60):
+            for y in range(20):
+                self.assertEqual(dst.get_at((x, y)), expected.get_at((x, y)), (x, y))
+
+    def test_blit_array__one_flag(self):
+        dst = pygame.Surface((30, 10), SRCALPHA, 32)
+        dst.fill((10, 10, 10, 255))
+        src = pygame.Surface((10, 10), SRCALPHA, 32)
+        src.fill((20, 30, 40, 255))
+        rects = array.array("i", [0, 0, 10, 10, 20, 0, 10, 10])
+
+        dst.blit_array([src, src], rects, BLEND_RGB_ADD)
+        self.assertEqual(dst.get_at((5, 5)), (30, 40, 50, 255))
+        self.assertEqual(dst.get_at((15, 5)), (10, 10, 10, 255))
+        self.assertEqual(dst.get_at((25, 5)), (30, 40, 50, 255))
+
+    def test_blit_array_bad_args(self):
+        dst = pygame.Surface((100, 10), SRCALPHA, 32)
+        src = pygame.Surface((10, 10), SRCALPHA, 32)
+        rects = pygame.RectArray([(0, 0, 10, 10)])
+
+        self.assertRaises(ValueError, dst.blit_array, [src, src], rects)
+        self.assertRaises(ValueError, dst.blit_array, [src], array.array("i", [0, 0]))
+        self.assertRaises(
+            ValueError, dst.blit_array, [src], rects, array.array("i", [0, 0])
+        )
+        self.assertRaises(TypeError, dst.blit_array, [None], rects)
+        self.assertRaises(TypeError, dst.blit_array, src, rects)
+        self.assertRaises(TypeError, dst.blit_array, [src], [(0, 0, 10, 10)])
+
 
 if __name__ == "__main__":
     unittest.main()
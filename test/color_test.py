@@ -1,3 +1,4 @@
+import array
 import math
 import operator
 import platform
@@ -368,6 +369,27 @@ class ColorTypeTest(unittest.TestCase):
             self.assertEqual(color.b, values[2])
             self.assertEqual(color.a, values[3])
 
+    def test_color__name_str_arg_repeated(self):
+        """Ensures names parse the same way when they are seen again,
+        including names added to THECOLORS in between."""
+        for _ in range(2):
+            self.assertEqual(pygame.Color("Dark Blue"), (0, 0, 139, 255))
+            self.assertEqual(pygame.Color("".join(["dark", "blue"])), (0, 0, 139))
+            self.assertEqual(pygame.Color("#FF8800"), (255, 136, 0, 255))
+            self.assertRaises(ValueError, pygame.Color, "no such color")
+
+        # more strings than the cache holds
+        for i in range(1000):
+            self.assertEqual(pygame.Color(f"#{i:06x}"), (0, i >> 8, i & 0xFF))
+
+        self.assertRaises(ValueError, pygame.Color, "test color")
+        THECOLORS["testcolor"] = (1, 2, 3, 4)
+        try:
+            self.assertEqual(pygame.Color("test color"), (1, 2, 3, 4))
+        finally:
+            del THECOLORS["testcolor"]
+        self.assertRaises(ValueError, pygame.Color, "test color")
+
     def test_color__html_str_arg(self):
         """Ensures Color objects can be created using html strings."""
         # See test_webstyle() for related tests.
@@ -1247,6 +1269,135 @@ class ColorTypeTest(unittest.TestCase):
         self.assertTrue(isinstance(c, Collection))
         self.assertFalse(isinstance(c, Sequence))
 
+    @unittest.skipIf(
+        "PyPy" == platform.python_implementation(), "no free list on pypy"
+    )
+    def test_freelist(self):
+        """Deallocated Colors are reused by new ones."""
+        c = pygame.Color(1, 2, 3, 4)
+        del c
+        hits = pygame.color._freelist_stats()["hits"]
+
+        c = pygame.Color(5, 6, 7)
+
+        self.assertEqual(pygame.color._freelist_stats()["hits"], hits + 1)
+        self.assertEqual(c, pygame.Color(5, 6, 7, 255))
+
+
+class ColorModuleTest(unittest.TestCase):
+    """The bulk functions give the same colors as the Color methods."""
+
+    def setUp(self):
+        self.colors = [pygame.Color(*rgba) for rgba in rgba_combinations]
+        self.rgba = bytearray(b"".join(bytes(tuple(c)) for c in self.colors))
+
+    def assertColorsEqual(self, rgba, colors):
+        self.assertEqual(bytes(rgba), b"".join(bytes(tuple(c)) for c in colors))
+
+    def test_correct_gamma_array(self):
+        pygame.color.correct_gamma_array(self.rgba, 0.5)
+        self.assertColorsEqual(
+            self.rgba, [c.correct_gamma(0.5) for c in self.colors]
+        )
+
+    def test_lerp_array(self):
+        pygame.color.lerp_array(self.rgba, (10, 20, 30, 40), 0.3)
+        self.assertColorsEqual(
+            self.rgba, [c.lerp((10, 20, 30, 40), 0.3) for c in self.colors]
+        )
+
+        # a buffer of colors lerps color by color
+        others = bytearray(reversed(self.rgba))
+        expected = [
+            pygame.Color(*self.rgba[i : i + 4]).lerp(others[i : i + 4], 0.7)
+            for i in range(0, len(self.rgba), 4)
+        ]
+        pygame.color.lerp_array(self.rgba, others, 0.7)
+        self.assertColorsEqual(self.rgba, expected)
+
+        self.assertRaises(ValueError, pygame.color.lerp_array, self.rgba, others, 2)
+        self.assertRaises(
+            ValueError, pygame.color.lerp_array, self.rgba, others[:4], 0.5
+        )
+
+    def test_premul_alpha_array(self):
+        pygame.color.premul_alpha_array(self.rgba)
+        self.assertColorsEqual(self.rgba, [c.premul_alpha() for c in self.colors])
+
+    def test_color_space_conversions(self):
+        for to_space, from_space, attr in (
+            (pygame.color.rgba_to_hsva, pygame.color.hsva_to_rgba, "hsva"),
+            (pygame.color.rgba_to_hsla, pygame.color.hsla_to_rgba, "hsla"),
+        ):
+            for typecode in "fd":
+                values = array.array(typecode, [0]) * len(self.rgba)
+                to_space(self.rgba, values)
+                for i, c in enumerate(self.colors):
+                    got = values[i * 4 : i * 4 + 4]
+                    for value, expected in zip(got, getattr(c, attr)):
+                        self.assertAlmostEqual(value, expected, places=3)
+
+            values = array.array("d")
+            for c in self.colors:
+                values.extend(getattr(c, attr))
+            result = bytearray(len(self.rgba))
+            from_space(values, result)
+            expected = []
+            for c in self.colors:
+                converted = pygame.Color(0)
+                setattr(converted, attr, getattr(c, attr))
+                expected.append(converted)
+            self.assertColorsEqual(result, expected)
+
+            # nothing is written when a value is out of range
+            values[5] = 101
+            result = bytearray(len(self.rgba))
+            self.assertRaises(ValueError, from_space, values, result)
+            self.assertEqual(result, bytearray(len(self.rgba)))
+
+    def test_yuva(self):
+        yuva = array.array("d", [0]) * len(self.rgba)
+        pygame.color.rgba_to_yuva(self.rgba, yuva)
+        # the first color is transparent black, the last opaque white
+        for got, expected in zip(yuva[:4], (0, 0, 0, 0)):
+            self.assertAlmostEqual(got, expected)
+        for got, expected in zip(yuva[-4:], (1, 0, 0, 1)):
+            self.assertAlmostEqual(got, expected)
+
+        result = bytearray(len(self.rgba))
+        pygame.color.yuva_to_rgba(yuva, result)
+        self.assertEqual(result, self.rgba)
+
+        # values outside RGB are clamped
+        yuva = array.array("d", [2, 0, 0, 0.5, -1, 0.5, 0.5, 2])
+        result = bytearray(8)
+        pygame.color.yuva_to_rgba(yuva, result)
+        self.assertEqual(list(result), [255, 255, 255, 128, 0, 0, 0, 255])
+
+    def test_buffer_checks(self):
+        self.assertRaises(ValueError, pygame.color.premul_alpha_array, bytearray(6))
+        self.assertRaises(BufferError, pygame.color.premul_alpha_array, bytes(8))
+        self.assertRaises(
+            ValueError, pygame.color.premul_alpha_array, array.array("i", [0] * 4)
+        )
+        self.assertRaises(
+            ValueError,
+            pygame.color.rgba_to_hsva,
+            bytearray(8),
+            array.array("d", [0] * 4),
+        )
+        self.assertRaises(
+            ValueError,
+            pygame.color.rgba_to_hsva,
+            bytearray(4),
+            array.array("i", [0] * 4),
+        )
+
+        # a Color is one color for all of them, though it is a buffer too
+        rgba = bytearray(8)
+        pygame.color.lerp_array(rgba, pygame.Color(100, 50, 0, 128), 1)
+        self.assertEqual(list(rgba), [100, 50, 0, 128] * 2)
+
 
 class SubclassTest(unittest.TestCase):
     class MyColor(pygame.Color):
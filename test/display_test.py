@@ -50,6 +50,47 @@ class DisplayModuleTest(unittest.TestCase):
         with self.assertRaises(pygame.error):
             (pygame.display.flip())
 
+    def test_update_damage(self):
+        screen = pygame.display.set_mode((100, 100))
+
+        # untracked, updates the whole screen
+        self.assertIsNone(pygame.display.update_damage())
+
+        screen.set_damage_tracking(True)
+        screen.fill((66, 66, 53), (10, 10, 20, 20))
+        pygame.draw.line(screen, (255, 0, 0), (0, 90), (99, 90))
+        self.assertIsNone(pygame.display.update_damage())
+        self.assertEqual(screen.get_damage(), [])
+
+        # nothing changed
+        self.assertIsNone(pygame.display.update_damage())
+
+        pygame.display.quit()
+        with self.assertRaises(pygame.error):
+            pygame.display.update_damage()
+
+    def test_update_threshold(self):
+        self.assertEqual(pygame.display.get_update_threshold(), 0.75)
+        screen = pygame.display.set_mode((100, 100))
+        screen.fill((10, 20, 30))
+
+        try:
+            for threshold in (0, 0.25, 1):
+                pygame.display.set_update_threshold(threshold)
+                self.assertEqual(pygame.display.get_update_threshold(), threshold)
+                # overlapping, adjacent and covering rects
+                rects = [(0, 0, 60, 60), (30, 30, 60, 60), (60, 0, 40, 10)]
+                self.assertIsNone(pygame.display.update(rects))
+                self.assertIsNone(pygame.display.update((0, 0, 100, 100)))
+
+            for threshold in (-0.1, 1.5):
+                with self.assertRaises(ValueError):
+                    pygame.display.set_update_threshold(threshold)
+            with self.assertRaises(TypeError):
+                pygame.display.set_update_threshold("half")
+        finally:
+            pygame.display.set_update_threshold(0.75)
+
     def test_get_active(self):
         """Test the get_active function"""
 
@@ -145,6 +186,21 @@ class DisplayModuleTest(unittest.TestCase):
         with self.assertRaises(pygame.error):
             driver = display.get_driver()
 
+    def test_is_headless(self):
+        headless = display.get_driver() in ("dummy", "offscreen")
+        self.assertEqual(display.is_headless(), headless)
+
+        screen = display.set_mode((8, 8))
+        self.assertEqual(display.is_headless(), headless)
+        screen.fill((255, 0, 0))
+        display.flip()
+        display.update((0, 0, 4, 4))
+        self.assertEqual(screen.get_at((7, 7)), (255, 0, 0, 255))
+
+        display.quit()
+        with self.assertRaises(pygame.error):
+            display.is_headless()
+
     def test_get_init(self):
         """Ensures the module's initialization state can be retrieved."""
         # display.init() already called in setUp()
@@ -544,6 +600,38 @@ class DisplayModuleTest(unittest.TestCase):
         screen = pygame.display.set_mode((200, 200))
         self.assertEqual(screen.get_size(), (200, 200))
 
+    @unittest.skipIf(
+        sys.platform == "darwin" or sys.platform == "emscripten",
+        "async present needs the renderer on another thread",
+    )
+    def test_set_async_present(self):
+        screen = pygame.display.set_mode((100, 100))
+        with self.assertRaises(pygame.error):
+            pygame.display.set_async_present()
+
+        screen = pygame.display.set_mode((100, 100), pygame.SCALED)
+        with self.assertRaises(ValueError):
+            pygame.display.set_async_present(buffers=4)
+
+        for buffers in (2, 3):
+            pygame.display.set_async_present(buffers=buffers)
+            for i in range(5):
+                screen.fill((i * 50, 0, 0))
+                pygame.display.flip()
+                pygame.display.update((0, 0, 10, 10))
+            pygame.display.set_async_present(False)
+
+            latency, presented, dropped = pygame.display.get_present_stats()
+            self.assertGreaterEqual(latency, 0.0)
+            self.assertLessEqual(presented + dropped, 10)
+            if buffers == 2:
+                self.assertEqual(dropped, 0)
+
+        # a new display mode stops the presenter
+        pygame.display.set_async_present()
+        screen = pygame.display.set_mode((50, 50), pygame.SCALED)
+        pygame.display.flip()
+
     def test_screensaver_support(self):
         pygame.display.set_allow_screensaver(True)
         self.assertTrue(pygame.display.get_allow_screensaver())
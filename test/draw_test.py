@@ -1,3 +1,4 @@
+import array
 import math
 import unittest
 import sys
@@ -1059,6 +1060,37 @@ class DrawEllipseTest(DrawEllipseMixin, DrawTestCase):
     the class to add any draw.ellipse specific tests to.
     """
 
+    def test_ellipse__repeated(self):
+        """Ensures ellipses drawn again at the same size draw the same pixels."""
+        sizes = [(w, h) for w in range(1, 40, 3) for h in (1, 6, 13, 24)]
+        color = (200, 100, 50, 255)
+        expected = {}
+        for size in sizes:
+            surface = pygame.Surface((50, 40))
+            expected[size] = (
+                self.draw_ellipse(surface, color, ((4, 3), size)),
+                surface,
+            )
+
+        for offset in ((4, 3), (9, 7), (-5, -2)):
+            for size in reversed(sizes):
+                surface = pygame.Surface((50, 40))
+                drawn = self.draw_ellipse(surface, color, (offset, size))
+                expected_rect, expected_surface = expected[size]
+                dx, dy = offset[0] - 4, offset[1] - 3
+
+                self.assertEqual(
+                    drawn, expected_rect.move(dx, dy).clip(surface.get_rect())
+                )
+                for y in range(40):
+                    for x in range(50):
+                        if 0 <= x - dx < 50 and 0 <= y - dy < 40:
+                            self.assertEqual(
+                                surface.get_at((x, y)),
+                                expected_surface.get_at((x - dx, y - dy)),
+                                (size, offset, x, y),
+                            )
+
 
 # Commented out to avoid cluttering the test output. Add back in if draw_py
 # ever properly supports drawing ellipses.
@@ -1677,6 +1709,30 @@ class LineMixin(BaseLineMixin):
                 surface.unlock()
 
 
+    def test_line__depths(self):
+        """Ensures lines cover the same pixels at every surface depth."""
+        color = pygame.Color("red")
+        lines = [
+            ((2, 10), (57, 10), 1),
+            ((30, -5), (30, 70), 1),
+            ((3, 3), (50, 45), 4),
+            ((10, 55), (20, 2), 5),
+        ]
+        expected = None
+
+        for depth in (32, 24, 16, 8):
+            surface = pygame.Surface((60, 60), 0, depth)
+            surface.set_clip((4, 4, 50, 50))
+            rects = [
+                self.draw_line(surface, color, start, end, width)
+                for start, end, width in lines
+            ]
+            result = (rects, sorted(get_color_points(surface, color)))
+
+            if expected is None:
+                expected = result
+            self.assertEqual(result, expected, depth)
+
 # Commented out to avoid cluttering the test output. Add back in if draw_py
 # ever fully supports drawing single lines.
 # @unittest.skip('draw_py.draw_line not fully supported yet')
@@ -3797,6 +3853,64 @@ class DrawAALinesTest(AALinesMixin, DrawTestCase):
     class to add any draw.aalines specific tests to.
     """
 
+    def _waveform(self, count):
+        return [(i * 0.37 - 3, 20 + 18 * math.sin(i * 0.21)) for i in range(count)]
+
+    def test_aalines__same_as_aaline(self):
+        """Ensures aalines draws the same pixels as aaline for each segment."""
+        points = self._waveform(200)
+        for flags in (0, SRCALPHA):
+            for closed in (False, True):
+                for blend in (0, 1):
+                    surface = pygame.Surface((60, 45), flags, 32)
+                    surface.fill((20, 60, 100, 200))
+                    expected = surface.copy()
+                    surface.set_clip((2, 3, 50, 35))
+                    expected.set_clip((2, 3, 50, 35))
+
+                    rect = self.draw_aalines(
+                        surface, (250, 200, 10, 128), closed, points, blend
+                    )
+                    segments = list(zip(points, points[1:]))
+                    if closed:
+                        segments.append((points[-1], points[0]))
+                    expected_rect = None
+                    for start, end in segments:
+                        drawn = draw.aaline(
+                            expected, (250, 200, 10, 128), start, end, blend
+                        )
+                        if drawn.size != (0, 0):
+                            expected_rect = (
+                                drawn
+                                if expected_rect is None
+                                else expected_rect.union(drawn)
+                            )
+
+                    self.assertEqual(rect, expected_rect)
+                    for y in range(45):
+                        for x in range(60):
+                            self.assertEqual(
+                                surface.get_at((x, y)),
+                                expected.get_at((x, y)),
+                                (flags, closed, blend, x, y),
+                            )
+
+    def test_aalines__subsurface(self):
+        """Ensures aalines blends with the pixels of a subsurface."""
+        parent = pygame.Surface((80, 60), 0, 32)
+        for x in range(80):
+            parent.fill((x * 3, 255 - x * 3, 90), (x, 0, 1, 60))
+        subsurface = parent.subsurface((10, 5, 60, 45))
+        alone = subsurface.copy()
+        points = self._waveform(170)
+
+        self.draw_aalines(subsurface, (255, 255, 255), False, points)
+        self.draw_aalines(alone, (255, 255, 255), False, points)
+
+        for y in range(45):
+            for x in range(60):
+                self.assertEqual(subsurface.get_at((x, y)), alone.get_at((x, y)))
+
 
 ### Polygon Testing ###########################################################
 
@@ -4404,6 +4518,46 @@ class DrawPolygonMixin:
 
                 surface.unlock()
 
+    def test_polygon__many_vertices(self):
+        """Ensures a filled polygon with many crossing edges is drawn
+        with the even-odd scanline rule.
+        """
+        surface_color = pygame.Color("black")
+        polygon_color = pygame.Color("white")
+        surface = pygame.Surface((60, 60))
+        surface.fill(surface_color)
+
+        # A self-intersecting star with slanted edges in both directions.
+        vertices = [
+            (30 + (13 * i * 7) % 29 - 14, 3 + (i * i * 5) % 54) for i in range(23)
+        ]
+        self.draw_polygon(surface, polygon_color, vertices, 0)
+
+        miny = min(y for _, y in vertices)
+        maxy = max(y for _, y in vertices)
+        expected = set()
+        for y in range(miny, maxy + 1):
+            xs = []
+            for (x1, y1), (x2, y2) in zip(vertices[-1:] + vertices, vertices):
+                if y1 > y2:
+                    x1, y1, x2, y2 = x2, y2, x1, y1
+                if y1 < y2 and (y1 <= y < y2 or y == maxy == y2):
+                    # C integer division truncates toward zero.
+                    xs.append(int((y - y1) * (x2 - x1) / (y2 - y1)) + x1)
+            xs.sort()
+            for start, end in zip(xs[::2], xs[1::2]):
+                expected.update((x, y) for x in range(start, end + 1))
+        for (x1, y1), (x2, y2) in zip(vertices[-1:] + vertices, vertices):
+            if y1 == y2 and miny < y1 < maxy:
+                xs = range(min(x1, x2), max(x1, x2) + 1)
+                expected.update((x, y1) for x in xs)
+
+        for pt in ((x, y) for x in range(60) for y in range(60)):
+            if pt in expected:
+                self.assertEqual(surface.get_at(pt), polygon_color, pt)
+            else:
+                self.assertEqual(surface.get_at(pt), surface_color, pt)
+
 
 class DrawPolygonTest(DrawPolygonMixin, DrawTestCase):
     """Test draw module function polygon.
@@ -5062,6 +5216,51 @@ class DrawRectTest(DrawRectMixin, DrawTestCase):
     class to add any draw.rect specific tests to.
     """
 
+    def test_rect__rounded_repeated(self):
+        """Ensures rounded rects drawn again at the same size draw the same
+        pixels, for more shapes than are cached at once.
+        """
+        shapes = [
+            ((w, h), width, radius)
+            for w, h in ((40, 30), (25, 12), (9, 9))
+            for width in (0, 1, 3)
+            for radius in (2, 5, 8, 30)
+        ]
+        color = (10, 200, 90, 255)
+        expected = {}
+        for shape in shapes:
+            surface = pygame.Surface((50, 40))
+            size, width, radius = shape
+            expected[shape] = surface
+            self.draw_rect(surface, color, ((4, 3), size), width, radius)
+
+        for offset in ((4, 3), (6, 5), (1, 2)):
+            for shape in reversed(shapes):
+                surface = pygame.Surface((50, 40))
+                size, width, radius = shape
+                drawn = self.draw_rect(
+                    surface, color, (offset, size), width, radius
+                )
+                dx, dy = offset[0] - 4, offset[1] - 3
+
+                self.assertEqual(drawn, pygame.Rect(offset, size))
+                for y in range(40):
+                    for x in range(50):
+                        if 0 <= x - dx < 50 and 0 <= y - dy < 40:
+                            self.assertEqual(
+                                surface.get_at((x, y)),
+                                expected[shape].get_at((x - dx, y - dy)),
+                                (shape, offset, x, y),
+                            )
+
+        # corner radii of their own are part of the shape
+        first = pygame.Surface((50, 40))
+        second = pygame.Surface((50, 40))
+        self.draw_rect(first, color, (4, 3, 40, 30), 0, 8, 2)
+        self.draw_rect(second, color, (4, 3, 40, 30), 0, 8)
+
+        self.assertNotEqual(first.get_at((5, 4)), second.get_at((5, 4)))
+
 
 # Commented out to avoid cluttering the test output. Add back in if draw_py
 # ever properly supports drawing rects.
@@ -5836,6 +6035,33 @@ class DrawCircleMixin:
             self.assertEqual(bounding_rect.height, radius * 2)
 
 
+    def test_circle__depths(self):
+        """Ensures circles cover the same pixels at every surface depth."""
+        color = pygame.Color("red")
+        expected = None
+
+        for depth in (32, 24, 16, 8):
+            surface = pygame.Surface((60, 60), 0, depth)
+            surface.set_clip((5, 5, 50, 45))
+            rects = [
+                self.draw_circle(surface, color, (20, 25), 18, 5),
+                self.draw_circle(surface, color, (50, 8), 12, 3),
+                self.draw_circle(
+                    surface,
+                    color,
+                    (45, 40),
+                    14,
+                    0,
+                    draw_top_left=True,
+                    draw_bottom_right=True,
+                ),
+            ]
+            result = (rects, sorted(get_color_points(surface, color)))
+
+            if expected is None:
+                expected = result
+            self.assertEqual(result, expected, depth)
+
 class DrawCircleTest(DrawCircleMixin, DrawTestCase):
     """Test draw module function circle.
 
@@ -6438,6 +6664,517 @@ class DrawArcTest(DrawArcMixin, DrawTestCase):
 #    """
 
 
+### Batch Testing #############################################################
+
+
+class DrawBatchTest(unittest.TestCase):
+    """Test the draw functions taking buffers of many items."""
+
+    def setUp(self):
+        self.surface = pygame.Surface((80, 60))
+        self.expected = pygame.Surface((80, 60))
+        for surf in (self.surface, self.expected):
+            surf.fill((0, 0, 60))
+            surf.set_clip((3, 2, 70, 50))
+
+    def assertSameSurfaces(self):
+        self.assertEqual(
+            pygame.image.tostring(self.surface, "RGB"),
+            pygame.image.tostring(self.expected, "RGB"),
+        )
+
+    def expected_bounds(self, rects):
+        drawn = [r for r in rects if r.w and r.h]
+        return drawn[0].unionall(drawn[1:]) if drawn else pygame.Rect(0, 0, 0, 0)
+
+    def test_circles(self):
+        """Ensures circles draws what circle draws for each item."""
+        centers = [(10, 10), (40, 30), (75, 55), (-5, 20), (30, 5)]
+        radii = [6, 12, 9, 10, 0]
+        for width in (0, 1, 3, 20):
+            self.setUp()
+            rects = [
+                draw.circle(self.expected, (200, 50, 0), c, r, width)
+                for c, r in zip(centers, radii)
+            ]
+
+            bounds = draw.circles(
+                self.surface,
+                (200, 50, 0),
+                array.array("i", [v for c in centers for v in c]),
+                array.array("i", radii),
+                width,
+            )
+
+            self.assertSameSurfaces()
+            self.assertEqual(bounds, self.expected_bounds(rects))
+
+    def test_circles__one_radius_and_colors(self):
+        """Ensures circles takes one radius and a buffer of colors."""
+        centers = [(10, 10), (40, 30), (60, 20)]
+        colors = [(255, 0, 0), (0, 255, 0), (0, 0, 255)]
+        for center, color in zip(centers, colors):
+            draw.circle(self.expected, color, center, 7, 2)
+
+        mapped = array.array("I", [self.surface.map_rgb(c) for c in colors])
+        draw.circles(
+            self.surface,
+            mapped,
+            array.array("i", [v for c in centers for v in c]),
+            7,
+            width=2,
+        )
+
+        self.assertSameSurfaces()
+
+    def test_rects(self):
+        """Ensures rects draws what rect draws for each item."""
+        items = [(5, 5, 20, 10), (30, 20, 30, 30), (70, 50, 20, 20), (4, 40, 2, 9)]
+        for width in (0, 1, 4):
+            self.setUp()
+            rects = [draw.rect(self.expected, "white", r, width) for r in items]
+
+            bounds = draw.rects(
+                self.surface,
+                "white",
+                array.array("i", [v for r in items for v in r]),
+                width,
+            )
+
+            self.assertSameSurfaces()
+            self.assertEqual(bounds, self.expected_bounds(rects))
+
+    def test_line_segments(self):
+        """Ensures line_segments draws what line draws for each item."""
+        items = [(0, 0, 79, 59), (10, 50, 10, 3), (5, 30, 70, 30), (60, 5, 20, 55)]
+        for width in (1, 2, 5):
+            self.setUp()
+            rects = [
+                draw.line(self.expected, "yellow", s[:2], s[2:], width) for s in items
+            ]
+
+            bounds = draw.line_segments(
+                self.surface,
+                "yellow",
+                array.array("i", [v for s in items for v in s]),
+                width,
+            )
+
+            self.assertSameSurfaces()
+            self.assertEqual(bounds, self.expected_bounds(rects))
+
+    def test_nothing_drawn(self):
+        """Ensures batches that draw nothing return a zero size rect."""
+        empty = array.array("i")
+        segment = array.array("i", [0, 0, 10, 10])
+        zero = pygame.Rect(0, 0, 0, 0)
+
+        self.assertEqual(draw.circles(self.surface, "red", empty, 5), zero)
+        self.assertEqual(draw.rects(self.surface, "red", empty), zero)
+        self.assertEqual(draw.line_segments(self.surface, "red", segment, 0), zero)
+        self.assertSameSurfaces()
+
+    def test_invalid_buffers(self):
+        """Ensures badly shaped buffers are rejected."""
+        with self.assertRaises(TypeError):
+            draw.circles(self.surface, "red", array.array("d", [1, 2]), 3)
+        with self.assertRaises(TypeError):
+            draw.rects(self.surface, "red", array.array("h", [1, 2, 3, 4]))
+        with self.assertRaises(ValueError):
+            draw.circles(self.surface, "red", array.array("i", [1, 2, 3]), 3)
+        with self.assertRaises(ValueError):
+            draw.line_segments(self.surface, "red", array.array("i", [1, 2, 3]))
+        with self.assertRaises(ValueError):
+            draw.circles(
+                self.surface,
+                "red",
+                array.array("i", [1, 2, 3, 4]),
+                array.array("i", [5]),
+            )
+        with self.assertRaises(ValueError):
+            draw.rects(
+                self.surface, array.array("I", [0]), array.array("i", [0] * 8)
+            )
+        with self.assertRaises(TypeError):
+            draw.circles(self.surface, "red", [(1, 2)], 3)
+
+
+### Antialiased Fill Testing ##################################################
+
+
+class DrawAAFillTest(unittest.TestCase):
+    """Test the antialiased filled shape functions."""
+
+    def coverage(self, surface, rect=None):
+        """Sum the coverage of a white shape drawn on black."""
+        rect = rect or surface.get_rect()
+        return (
+            sum(
+                surface.get_at((x, y)).r
+                for x in range(rect.left, rect.right)
+                for y in range(rect.top, rect.bottom)
+            )
+            / 255.0
+        )
+
+    def test_aarect__matches_rect(self):
+        """Ensures whole pixel rects and squares fill like rect()."""
+        expected = pygame.Surface((40, 30))
+        draw.rect(expected, "white", (5, 4, 20, 11))
+        for shape in ("rect", "polygon"):
+            surface = pygame.Surface((40, 30))
+            if shape == "rect":
+                bounds = draw.aarect(surface, "white", (5, 4, 20, 11))
+            else:
+                points = [(5, 4), (25, 4), (25, 15), (5, 15)]
+                bounds = draw.aapolygon(surface, "white", points)
+
+            self.assertEqual(bounds, pygame.Rect(5, 4, 20, 11), shape)
+            self.assertEqual(
+                pygame.image.tostring(surface, "RGB"),
+                pygame.image.tostring(expected, "RGB"),
+                shape,
+            )
+
+    def test_aapolygon__partial_pixels(self):
+        """Ensures edge pixels are blended by the area covered."""
+        surface = pygame.Surface((20, 20))
+        points = [(2.5, 2.5), (12.5, 2.5), (12.5, 12.5), (2.5, 12.5)]
+
+        bounds = draw.aapolygon(surface, (200, 100, 40), points)
+
+        self.assertEqual(bounds, pygame.Rect(2, 2, 11, 11))
+        self.assertEqual(surface.get_at((5, 5)), (200, 100, 40))
+        self.assertEqual(surface.get_at((2, 6)), (100, 50, 20))
+        self.assertEqual(surface.get_at((6, 12)), (100, 50, 20))
+        self.assertEqual(surface.get_at((2, 2)), (50, 25, 10))
+        self.assertEqual(surface.get_at((1, 6)), (0, 0, 0))
+        self.assertAlmostEqual(self.coverage(surface) * 255 / 200, 100, delta=0.5)
+
+    def test_aacircle(self):
+        """Ensures circles cover the area of the circle, with smooth edges."""
+        surface = pygame.Surface((100, 100))
+        center, radius = (50, 50), 30
+
+        bounds = draw.aacircle(surface, "white", center, radius)
+
+        self.assertEqual(bounds, pygame.Rect(20, 20, 60, 60))
+        self.assertAlmostEqual(
+            self.coverage(surface), math.pi * radius**2, delta=radius
+        )
+        self.assertEqual(surface.get_at(center), (255, 255, 255))
+        self.assertEqual(surface.get_at((10, 10)), (0, 0, 0))
+        edge = [surface.get_at((x, 50)).r for x in range(15, 25)]
+        self.assertTrue(any(0 < value < 255 for value in edge), edge)
+
+    def test_aacircle__nothing_drawn(self):
+        """Ensures circles with no radius draw nothing."""
+        surface = pygame.Surface((20, 20))
+
+        for radius in (0, -3):
+            bounds = draw.aacircle(surface, "white", (7.9, 5), radius)
+
+            self.assertEqual(bounds, pygame.Rect(7, 5, 0, 0))
+        self.assertEqual(self.coverage(surface), 0)
+
+    def test_aaellipse(self):
+        """Ensures ellipses cover the area of the ellipse."""
+        surface = pygame.Surface((100, 60))
+
+        bounds = draw.aaellipse(surface, "white", (10, 5, 80, 40))
+
+        self.assertEqual(bounds, pygame.Rect(10, 5, 80, 40))
+        self.assertAlmostEqual(
+            self.coverage(surface), math.pi * 40 * 20, delta=40
+        )
+
+    def test_aarect__border_radius(self):
+        """Ensures rounded corners take off the area outside the arcs."""
+        surface = pygame.Surface((60, 60))
+        radius = 10
+
+        draw.aarect(surface, "white", (5, 5, 50, 40), border_radius=radius)
+
+        expected = 50 * 40 - (4 - math.pi) * radius**2
+        self.assertAlmostEqual(self.coverage(surface), expected, delta=2)
+        self.assertEqual(surface.get_at((5, 5)), (0, 0, 0))
+        self.assertEqual(surface.get_at((30, 5)), (255, 255, 255))
+
+    def test_surface_clip(self):
+        """Ensures the fills respect the surface clip area."""
+        surface = pygame.Surface((40, 40))
+        clip = pygame.Rect(10, 12, 15, 9)
+        surface.set_clip(clip)
+
+        draw.aacircle(surface, "white", (20, 20), 15.5)
+        draw.aapolygon(surface, "white", [(-10, 0), (50, 5), (20, 60)])
+
+        outside = get_color_points(surface, (0, 0, 0), match_color=False)
+        self.assertTrue(outside)
+        for pt in outside:
+            self.assertTrue(clip.collidepoint(pt), pt)
+
+    def test_depths(self):
+        """Ensures the fills work at every surface depth."""
+        for depth in (8, 16, 24, 32):
+            surface = pygame.Surface((30, 30), 0, depth)
+
+            draw.aacircle(surface, "white", (15, 15), 10.3)
+
+            self.assertEqual(surface.get_at((15, 15)), (255, 255, 255), depth)
+            self.assertEqual(surface.get_at((2, 2)), (0, 0, 0), depth)
+
+    def test_path__caps(self):
+        """Ensures path ends each stroke with the requested cap."""
+        areas = (("butt", 360), ("square", 376), ("round", 360 + 4 * math.pi))
+        for cap, area in areas:
+            surface = pygame.Surface((120, 30))
+
+            bounds = draw.path(surface, "white", [(10, 10), (100, 10)], 4, cap=cap)
+
+            self.assertAlmostEqual(
+                self.coverage(surface), area, delta=0.5, msg=cap
+            )
+            self.assertEqual(bounds.top, 8, cap)
+            self.assertEqual(bounds.height, 4, cap)
+
+    def test_path__joins(self):
+        """Ensures path fills the outside of each corner as requested."""
+        points = [(10, 10), (50, 10), (50, 50)]
+        areas = (("miter", 320), ("bevel", 318), ("round", 316 + math.pi))
+        for join, area in areas:
+            surface = pygame.Surface((60, 60))
+
+            draw.path(surface, "white", points, 4, join=join)
+
+            self.assertAlmostEqual(
+                self.coverage(surface), area, delta=0.5, msg=join
+            )
+
+        # A corner too sharp for a miter is beveled.
+        points = [(10, 10), (100, 20), (10, 30)]
+        surfaces = []
+        for join in ("miter", "bevel"):
+            surfaces.append(pygame.Surface((120, 40)))
+            draw.path(surfaces[-1], "white", points, 4, join=join)
+        self.assertEqual(
+            pygame.image.tostring(surfaces[0], "RGB"),
+            pygame.image.tostring(surfaces[1], "RGB"),
+        )
+
+    def test_path__overlap_drawn_once(self):
+        """Ensures a stroke crossing itself writes each pixel once."""
+        surface = pygame.Surface((40, 40), pygame.SRCALPHA)
+        color = pygame.Color(255, 255, 255, 128)
+
+        draw.path(surface, color, [(5, 20), (35, 20), (20, 5), (20, 35)], 4)
+
+        self.assertEqual(surface.get_at((20, 20)), color)
+        self.assertEqual(surface.get_at((10, 20)), color)
+        self.assertEqual(surface.get_at((20, 30)), color)
+
+    def test_path__invalid_args(self):
+        """Ensures path rejects bad joins, caps and point lists."""
+        surface = pygame.Surface((10, 10))
+
+        with self.assertRaises(ValueError):
+            draw.path(surface, "white", [(1, 1), (5, 5)], join="sharp")
+        with self.assertRaises(ValueError):
+            draw.path(surface, "white", [(1, 1), (5, 5)], cap="flat")
+        with self.assertRaises(ValueError):
+            draw.path(surface, "white", [(1, 1)])
+        with self.assertRaises(TypeError):
+            draw.path(surface, "white", [(1, 1), "ab"])
+
+        bounds = draw.path(surface, "white", [(3, 4), (8, 8)], 0)
+        self.assertEqual(bounds, pygame.Rect(3, 4, 0, 0))
+
+
+class DrawGradientTest(unittest.TestCase):
+    """Test the gradient and texture fill functions."""
+
+    def test_linear_gradient__vertical(self):
+        """Ensures the default gradient runs from the top to the bottom row."""
+        surface = pygame.Surface((4, 256))
+
+        bounds = draw.linear_gradient(
+            surface, surface.get_rect(), (0, 0, 0), (255, 255, 255)
+        )
+
+        self.assertEqual(bounds, surface.get_rect())
+        for y in range(256):
+            for x in range(4):
+                self.assertEqual(surface.get_at((x, y)), (y, y, y), (x, y))
+
+    def test_linear_gradient__positions(self):
+        """Ensures the gradient follows start_pos and end_pos, keeping the
+        end colors beyond them.
+        """
+        surface = pygame.Surface((20, 3))
+
+        draw.linear_gradient(
+            surface,
+            surface.get_rect(),
+            (0, 0, 0),
+            (100, 200, 50),
+            start_pos=(5, 0),
+            end_pos=(15, 0),
+        )
+
+        for x in range(20):
+            step = min(max(x - 5, 0), 10)
+            expected = (10 * step, 20 * step, 5 * step)
+            for y in range(3):
+                self.assertEqual(surface.get_at((x, y)), expected, (x, y))
+
+    def test_linear_gradient__surface_clip(self):
+        """Ensures the gradient is only drawn inside the clip area."""
+        surface = pygame.Surface((20, 20))
+        clip = pygame.Rect(5, 6, 4, 3)
+        surface.set_clip(clip)
+
+        bounds = draw.linear_gradient(surface, (0, 0, 20, 20), "red", "blue")
+
+        self.assertEqual(bounds, clip)
+        for pt in get_color_points(surface, (0, 0, 0), match_color=False):
+            self.assertTrue(clip.collidepoint(pt), pt)
+
+    def test_radial_gradient(self):
+        """Ensures the radial gradient fills the circle from the center out."""
+        surface = pygame.Surface((21, 21))
+        surface.fill("green")
+
+        bounds = draw.radial_gradient(surface, (10, 10), 5, "white", (0, 0, 0))
+
+        self.assertEqual(bounds, pygame.Rect(5, 5, 11, 11))
+        self.assertEqual(surface.get_at((10, 10)), (255, 255, 255))
+        self.assertEqual(surface.get_at((10, 15)), (0, 0, 0))
+        self.assertEqual(surface.get_at((15, 10)), (0, 0, 0))
+        self.assertEqual(surface.get_at((10, 16)), pygame.Color("green"))
+        self.assertEqual(surface.get_at((14, 14)), pygame.Color("green"))
+        middle = surface.get_at((10, 12)).r
+        self.assertTrue(100 < middle < 160, middle)
+
+        bounds = draw.radial_gradient(surface, (3, 4), 0, "white", "black")
+        self.assertEqual(bounds, pygame.Rect(3, 4, 0, 0))
+
+    def test_textured_polygon(self):
+        """Ensures the polygon pixels are copied from the tiled texture."""
+        texture = pygame.Surface((2, 3), 0, 24)
+        colors = [["red", "blue", "white"], ["green", "yellow", "purple"]]
+        for x in range(2):
+            for y in range(3):
+                texture.set_at((x, y), colors[x][y])
+        points = [(1, 1), (12, 3), (9, 11), (2, 8)]
+        expected = pygame.Surface((15, 15))
+        expected_bounds = draw.polygon(expected, "white", points)
+        filled = get_color_points(expected, (0, 0, 0), match_color=False)
+
+        for offset in ((0, 0), (1, 2), (-3, -4)):
+            surface = pygame.Surface((15, 15))
+
+            bounds = draw.textured_polygon(surface, points, texture, offset)
+
+            self.assertEqual(bounds, expected_bounds, offset)
+            for x in range(15):
+                for y in range(15):
+                    if (x, y) in filled:
+                        u = (x - offset[0]) % 2
+                        v = (y - offset[1]) % 3
+                        color = pygame.Color(colors[u][v])
+                    else:
+                        color = pygame.Color(0, 0, 0)
+                    self.assertEqual(surface.get_at((x, y)), color, (x, y))
+
+    def test_textured_polygon__self_texture(self):
+        """Ensures a surface can be filled from its own pixels."""
+        surface = pygame.Surface((10, 10))
+        surface.fill("red", (0, 0, 5, 10))
+        surface.fill("blue", (5, 0, 5, 10))
+
+        draw.textured_polygon(
+            surface, [(0, 0), (4, 0), (4, 9), (0, 9)], surface, (5, 0)
+        )
+
+        self.assertEqual(surface.get_at((2, 5)), pygame.Color("blue"))
+        self.assertEqual(surface.get_at((7, 5)), pygame.Color("blue"))
+
+
+class DrawCurveTest(unittest.TestCase):
+    """Test the Curve class."""
+
+    points = [(10, 50), (25, 5), (60, 95), (90, 30), (120, -35), (140, 90), (150, 50)]
+
+    def test_curve__flattening(self):
+        """Ensures a curve is flattened to lines through its end points."""
+        curve = draw.Curve(self.points)
+        finer = draw.Curve(self.points, tolerance=0.05)
+
+        self.assertEqual(curve.tolerance, 0.25)
+        self.assertEqual(
+            curve.control_points, tuple((float(x), float(y)) for x, y in self.points)
+        )
+        self.assertEqual(curve[0], (10.0, 50.0))
+        self.assertEqual(curve[len(curve) - 1], (150.0, 50.0))
+        self.assertIn((90.0, 30.0), list(curve))
+        self.assertGreater(len(finer), len(curve))
+        with self.assertRaises(IndexError):
+            curve[len(curve)]
+
+    def test_curve__straight(self):
+        """Ensures a straight segment is flattened to one line."""
+        curve = draw.Curve([(0, 0), (1, 1), (2, 2), (3, 3)])
+
+        self.assertEqual(list(curve), [(0.0, 0.0), (3.0, 3.0)])
+
+    def test_curve__stroke(self):
+        """Ensures stroke draws the same pixels as path along the curve."""
+        curve = draw.Curve(self.points)
+        surface = pygame.Surface((160, 100))
+        expected = pygame.Surface((160, 100))
+
+        bounds = curve.stroke(surface, "white", 3, cap="round")
+        expected_bounds = draw.path(expected, "white", list(curve), 3, cap="round")
+
+        self.assertEqual(bounds, expected_bounds)
+        self.assertEqual(
+            pygame.image.tostring(surface, "RGB"),
+            pygame.image.tostring(expected, "RGB"),
+        )
+
+    def test_curve__fill(self):
+        """Ensures fill draws the same pixels as aapolygon on the curve."""
+        curve = draw.Curve([(10, 80), (10, 0), (90, 0), (90, 80)])
+        surface = pygame.Surface((100, 100))
+        expected = pygame.Surface((100, 100))
+
+        bounds = curve.fill(surface, "white")
+        expected_bounds = draw.aapolygon(expected, "white", list(curve))
+
+        self.assertEqual(bounds, expected_bounds)
+        self.assertEqual(surface.get_at((50, 40)), pygame.Color("white"))
+        self.assertEqual(
+            pygame.image.tostring(surface, "RGB"),
+            pygame.image.tostring(expected, "RGB"),
+        )
+
+    def test_curve__invalid_args(self):
+        """Ensures Curve rejects bad control points and tolerances."""
+        surface = pygame.Surface((10, 10))
+        curve = draw.Curve([(1, 1), (2, 5), (5, 5), (8, 1)])
+
+        with self.assertRaises(ValueError):
+            draw.Curve([(1, 1), (2, 5), (5, 5)])
+        with self.assertRaises(ValueError):
+            draw.Curve([(1, 1), (2, 5), (5, 5), (8, 1), (9, 9)])
+        with self.assertRaises(ValueError):
+            draw.Curve([(1, 1), (2, 5), (5, 5), (8, 1)], tolerance=0)
+        with self.assertRaises(TypeError):
+            draw.Curve([(1, 1), (2, 5), "ab", (8, 1)])
+        with self.assertRaises(ValueError):
+            curve.stroke(surface, "white", join="sharp")
+
+
 ### Draw Module Testing #######################################################
 
 
@@ -1,4 +1,6 @@
+import array
 import collections
+import threading
 import time
 import unittest
 
@@ -491,6 +493,58 @@ class EventModuleTest(unittest.TestCase):
         queue = pygame.event.get()
         self.assertEqual(len(queue), 2)
 
+    def test_get_buffer(self):
+        """Ensure get_buffer() writes a record for each event taken."""
+        num_fields = len(pygame.event.BUFFER_FIELDS)
+        type_index = pygame.event.BUFFER_FIELDS.index("type")
+        records = array.array("i", [-1] * num_fields * 8)
+        for _ in range(5):
+            pygame.event.post(pygame.event.Event(pygame.USEREVENT, code=1))
+        pygame.event.post(pygame.event.Event(pygame.KEYDOWN, key=pygame.K_a))
+
+        count = pygame.event.get_buffer(records)
+
+        self.assertEqual(count, 6)
+        types = records[type_index::num_fields]
+        self.assertEqual(types[:6].tolist(), [pygame.USEREVENT] * 5 + [pygame.KEYDOWN])
+        # the records after the last event are left alone
+        self.assertEqual(records[6 * num_fields :].tolist(), [-1] * 2 * num_fields)
+        self.assertEqual(pygame.event.get(), [])
+
+    def test_get_buffer__full(self):
+        """Ensure the events that do not fit stay in the queue."""
+        num_fields = len(pygame.event.BUFFER_FIELDS)
+        records = bytearray(4 * num_fields * 3)
+        for _ in range(5):
+            pygame.event.post(pygame.event.Event(pygame.USEREVENT))
+
+        self.assertEqual(pygame.event.get_buffer(records), 3)
+        self.assertEqual(len(pygame.event.get()), 2)
+        self.assertEqual(pygame.event.get_buffer(records), 0)
+
+    def test_get_buffer__eventtype(self):
+        """Ensure get_buffer() only takes the event types asked for."""
+        num_fields = len(pygame.event.BUFFER_FIELDS)
+        records = array.array("i", bytes(4 * num_fields * 4))
+        pygame.event.post(pygame.event.Event(pygame.USEREVENT))
+        pygame.event.post(pygame.event.Event(pygame.KEYUP))
+        pygame.event.post(pygame.event.Event(pygame.MOUSEMOTION))
+
+        count = pygame.event.get_buffer(records, [pygame.KEYUP, pygame.MOUSEMOTION])
+
+        self.assertEqual(count, 2)
+        self.assertEqual(
+            sorted(records[0 : 2 * num_fields : num_fields]),
+            sorted([pygame.KEYUP, pygame.MOUSEMOTION]),
+        )
+        self.assertEqual([e.type for e in pygame.event.get()], [pygame.USEREVENT])
+
+    def test_get_buffer__invalid_buffer(self):
+        with self.assertRaises(ValueError):
+            pygame.event.get_buffer(bytearray(4 * len(pygame.event.BUFFER_FIELDS) + 1))
+        with self.assertRaises(TypeError):
+            pygame.event.get_buffer(bytes(4 * len(pygame.event.BUFFER_FIELDS)))
+
     def test_get__empty_queue(self):
         """Ensure get() works correctly on an empty queue."""
         expected_events = []
@@ -835,6 +889,37 @@ class EventModuleTest(unittest.TestCase):
 
         self.assertTrue(blocked)
 
+    def test_set_coalesce__and_get_symmetric(self):
+        """Ensure event coalescing can be set and retrieved."""
+        for etype in (pygame.MOUSEMOTION, pygame.FINGERMOTION):
+            self.assertFalse(pygame.event.get_coalesce(etype))
+
+            pygame.event.set_coalesce(etype)
+            self.assertTrue(pygame.event.get_coalesce(etype))
+
+            pygame.event.set_coalesce(etype, False)
+            self.assertFalse(pygame.event.get_coalesce(etype))
+
+    def test_set_coalesce__invalid_type(self):
+        """Ensure only motion events can be coalesced."""
+        with self.assertRaises(ValueError):
+            pygame.event.set_coalesce(pygame.KEYDOWN)
+        with self.assertRaises(ValueError):
+            pygame.event.get_coalesce(pygame.USEREVENT)
+
+    def test_set_coalesce__posted_events(self):
+        """Ensure posted motion events are never merged."""
+        pygame.event.set_coalesce(pygame.MOUSEMOTION)
+        for i in range(3):
+            pygame.event.post(
+                pygame.event.Event(pygame.MOUSEMOTION, pos=(i, i), rel=(1, 1))
+            )
+
+        events = pygame.event.get()
+
+        pygame.event.set_coalesce(pygame.MOUSEMOTION, False)
+        self.assertEqual([e.pos for e in events], [(0, 0), (1, 1), (2, 2)])
+
     # @unittest.skipIf(
     #     os.environ.get("SDL_VIDEODRIVER") == "dummy",
     #     'requires the SDL_VIDEODRIVER to be a non "dummy" value',
@@ -928,6 +1013,42 @@ class EventModuleTestsWithTiming(unittest.TestCase):
         pygame.time.set_timer(pygame.USEREVENT, 50, 1)
         self.assertEqual(pygame.event.wait(40).type, pygame.NOEVENT)
 
+    def test_event_wait__fractional_timeout(self):
+        """Ensure wait() takes timeouts shorter than a millisecond."""
+        start_time = time.perf_counter()
+        self.assertEqual(pygame.event.wait(0.5).type, pygame.NOEVENT)
+        self.assertLess(time.perf_counter() - start_time, 0.01)
+
+    def test_wakeup(self):
+        """Ensure wakeup() ends the next wait() without an event."""
+        pygame.event.wakeup()
+
+        start_time = time.perf_counter()
+        self.assertEqual(pygame.event.wait(1000).type, pygame.NOEVENT)
+        self.assertLess(time.perf_counter() - start_time, 0.5)
+
+        # the wakeup is used up
+        self.assertEqual(pygame.event.wait(20).type, pygame.NOEVENT)
+        self.assertGreater(time.perf_counter() - start_time, 0.015)
+
+    def test_wakeup__from_thread(self):
+        """Ensure wakeup() from another thread ends a wait() in progress."""
+        timer = threading.Timer(0.05, pygame.event.wakeup)
+        timer.start()
+
+        start_time = time.perf_counter()
+        self.assertEqual(pygame.event.wait().type, pygame.NOEVENT)
+        self.assertLess(time.perf_counter() - start_time, 1)
+        timer.join()
+
+    def test_wakeup__pending_event(self):
+        """Ensure events on the queue come before a wakeup."""
+        pygame.event.post(pygame.event.Event(pygame.USEREVENT))
+        pygame.event.wakeup()
+
+        self.assertEqual(pygame.event.wait(100).type, pygame.USEREVENT)
+        self.assertEqual(pygame.event.wait(100).type, pygame.NOEVENT)
+
 
 ################################################################################
 
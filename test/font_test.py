@@ -400,6 +400,67 @@ class FontTypeTest(unittest.TestCase):
         u = "ab\x00cd"
         self.assertRaises(ValueError, f.render, b, 0, [0, 0, 0])
 
+    def test_render_cache(self):
+        f = pygame_font.Font(None, 20)
+        black = (0, 0, 0)
+        self.assertEqual(f.render_cache_limit, 0)
+        self.assertIsNot(f.render("foo", True, black), f.render("foo", True, black))
+
+        f.render_cache_limit = 1 << 20
+        self.assertEqual(f.render_cache_limit, 1 << 20)
+        s = f.render("foo", True, black)
+        self.assertIs(f.render("foo", True, black), s)
+        self.assertIsNot(f.render("foo", True, (255, 0, 0)), s)
+        # a style change makes a new surface, and changing back finds the old
+        f.set_bold(True)
+        self.assertIsNot(f.render("foo", True, black), s)
+        f.set_bold(False)
+        self.assertIs(f.render("foo", True, black), s)
+
+        stats = f.get_render_cache_stats()
+        self.assertEqual((stats["hits"], stats["misses"]), (2, 3))
+        self.assertEqual((stats["surfaces"], stats["evictions"]), (3, 0))
+        self.assertGreater(stats["bytes"], 0)
+
+        f.render_cache_limit = 1
+        stats = f.get_render_cache_stats()
+        self.assertEqual((stats["surfaces"], stats["evictions"]), (0, 3))
+        f.render_cache_limit = 0
+        self.assertEqual(
+            f.get_render_cache_stats(),
+            {"hits": 0, "misses": 0, "evictions": 0, "surfaces": 0, "bytes": 0},
+        )
+        with self.assertRaises(ValueError):
+            f.render_cache_limit = -1
+
+    @unittest.skipIf(
+        pygame_font.get_sdl_ttf_version() < (2, 20, 0),
+        "wrapping and align need SDL_ttf 2.20.0",
+    )
+    def test_render_wraplength(self):
+        f = pygame_font.Font(None, 20)
+        black = (0, 0, 0)
+        text = "the quick brown fox jumps over the lazy dog"
+        line = f.render(text, True, black)
+
+        wrapped = f.render(text, True, black, wraplength=100)
+
+        self.assertLessEqual(wrapped.get_width(), 100)
+        self.assertGreaterEqual(wrapped.get_height(), 3 * line.get_height())
+        lines = f.render("one\ntwo", True, black, None, 1000)
+        self.assertGreaterEqual(lines.get_height(), 2 * f.get_height())
+        self.assertEqual(lines.get_width(), f.size("one")[0])
+        for align in (pygame.FONT_CENTER, pygame.FONT_RIGHT):
+            aligned = f.render(text, True, black, wraplength=100, align=align)
+            self.assertEqual(aligned.get_size(), wrapped.get_size())
+        self.assertEqual(
+            f.render(text, True, black, wraplength=0).get_size(), line.get_size()
+        )
+        with self.assertRaises(ValueError):
+            f.render(text, True, black, wraplength=-1)
+        with self.assertRaises(ValueError):
+            f.render(text, True, black, wraplength=100, align=3)
+
     def test_render_ucs2_ucs4(self):
         """that it renders without raising if there is a new enough SDL_ttf."""
         f = pygame_font.Font(None, 20)
@@ -520,6 +581,29 @@ class FontTypeTest(unittest.TestCase):
         )
         f = pygame_font.Font(pathlib.Path(font_path), 20)
 
+    def test_load_sizes_of_same_file(self):
+        """Fonts of one file in several sizes share it but not their size"""
+        font_path = os.path.join(FONTDIR, "test_sans.ttf")
+        with open(font_path, "rb") as f:
+            expected = pygame_font.Font(f, 30).render("Abc", True, "white")
+
+        fonts = [
+            pygame_font.Font(font_path, 10),
+            pygame_font.Font(pathlib.Path(font_path), 30),
+            pygame_font.Font(os.path.join(FONTDIR, ".", "test_sans.ttf"), 50),
+        ]
+        heights = [font.get_height() for font in fonts]
+        self.assertEqual(heights, sorted(set(heights)))
+
+        font = fonts[1]
+        del fonts
+        surf = font.render("Abc", True, "white")
+        self.assertEqual(surf.get_size(), expected.get_size())
+        self.assertEqual(
+            pygame.image.tostring(surf, "RGBA"),
+            pygame.image.tostring(expected, "RGBA"),
+        )
+
     def test_load_from_file_obj(self):
         font_name = pygame_font.get_default_font()
         font_path = os.path.join(
@@ -9,6 +9,7 @@ import weakref
 import gc
 import pathlib
 import platform
+import threading
 
 IS_PYPY = "PyPy" == platform.python_implementation()
 
@@ -750,6 +751,54 @@ class FreeTypeFontTest(unittest.TestCase):
             size=24,
         )
 
+    def test_freetype_Font_render_to__32bit(self):
+        """Anti-aliased text blends onto 32 bit surfaces as onto 24 bit ones."""
+        font = self._TEST_FONTS["sans"]
+        text = "Bxq, Wg!" * 3
+
+        for bg, fg in [
+            ((200, 120, 40, 255), (20, 80, 250, 255)),
+            ((200, 120, 40, 90), (20, 80, 250, 160)),
+            ((0, 0, 0, 0), (255, 255, 255, 255)),
+        ]:
+            surf24 = pygame.Surface((400, 40), 0, 24)
+            surf24.fill(bg[:3])
+            surf32 = pygame.Surface((400, 40), pygame.SRCALPHA, 32)
+            surf32.fill(bg)
+            font.render_to(surf24, (3, 4), text, fg, size=24)
+            font.render_to(surf32, (3, 4), text, fg, size=24)
+            for y in range(40):
+                for x in range(400):
+                    color24 = surf24.get_at((x, y))
+                    color32 = surf32.get_at((x, y))
+                    if bg[3] == 255:
+                        self.assertEqual(color32[:3], color24[:3], (x, y))
+                    self.assertGreaterEqual(color32.a, bg[3], (x, y))
+
+    def test_freetype_Font_render__threads(self):
+        """Fonts render from several threads at once as from one."""
+        fonts = [self._TEST_FONTS["sans"], self._TEST_FONTS["mono"]]
+        texts = [f"entry {i}: Wg\u00e9" for i in range(40)]
+        sizes = (11, 17, 23)
+
+        def bake(results):
+            for i, text in enumerate(texts):
+                font = fonts[i % len(fonts)]
+                surf, rect = font.render(text, (255, 255, 255), size=sizes[i % 3])
+                results.append((rect, pygame.image.tostring(surf, "RGBA")))
+
+        expected = []
+        bake(expected)
+        results = [[] for _ in range(4)]
+        threads = [threading.Thread(target=bake, args=(r,)) for r in results]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        for result in results:
+            self.assertEqual(result, expected)
+
     def test_freetype_Font_render(self):
 
         font = self._TEST_FONTS["sans"]
@@ -1481,6 +1530,152 @@ class FreeTypeFontTest(unittest.TestCase):
     except AttributeError:
         del test_freetype_Font_cache
 
+    def test_freetype_Font_get_cache_stats(self):
+        f = ft.Font(self._sans_path, size=24)
+        stats = f.get_cache_stats()
+        self.assertEqual(
+            stats, {"hits": 0, "misses": 0, "evictions": 0, "glyphs": 0, "bytes": 0}
+        )
+
+        f.render_raw("abc")
+        stats = f.get_cache_stats()
+        self.assertEqual((stats["hits"], stats["misses"]), (0, 3))
+        self.assertEqual(stats["glyphs"], 3)
+        self.assertGreater(stats["bytes"], 0)
+
+        f.render_raw("cab")
+        stats = f.get_cache_stats()
+        self.assertEqual((stats["hits"], stats["misses"]), (3, 3))
+        self.assertEqual(stats["glyphs"], 3)
+
+    def test_freetype_Font_cache_limit(self):
+        f = ft.Font(self._sans_path, size=24)
+        self.assertEqual(f.cache_limit, 0)
+
+        f.render_raw("abcdefghijklmnopqrstuvwxyz")
+        full = f.get_cache_stats()["bytes"]
+        f.cache_limit = full // 2
+        self.assertEqual(f.cache_limit, full // 2)
+
+        stats = f.get_cache_stats()
+        self.assertLessEqual(stats["bytes"], full // 2)
+        self.assertGreater(stats["evictions"], 0)
+        self.assertEqual(stats["glyphs"] + stats["evictions"], 26)
+
+        # The glyphs of the text being rendered are never evicted early.
+        f.cache_limit = 1
+        f.render_raw("xyz")
+        f.render_raw("zyx")
+        self.assertLessEqual(f.get_cache_stats()["glyphs"], 3)
+
+        with self.assertRaises(ValueError):
+            f.cache_limit = -1
+        with self.assertRaises(TypeError):
+            f.cache_limit = 1.5
+        with self.assertRaises(AttributeError):
+            del f.cache_limit
+
+    def test_freetype_Font_render_wraplength(self):
+        f = ft.Font(self._sans_path, size=24)
+        text = "the quick brown fox jumps over the lazy dog"
+        line_rect = f.get_rect(text)
+        height = f.get_sized_height()
+
+        surf, rect = f.render(text, "black", wraplength=120)
+
+        self.assertEqual(surf.get_size(), rect.size)
+        self.assertLessEqual(rect.width, 120)
+        self.assertGreaterEqual(rect.height, 3 * height)
+        self.assertEqual(f.get_rect(text, wraplength=120), rect)
+        self.assertEqual(f.get_rect(text, wraplength=0), line_rect)
+
+        # lines break at newlines, which are not drawn
+        rect = f.get_rect("abc\nabc", wraplength=1000)
+        self.assertEqual(rect.width, f.get_rect("abc").width)
+        rect2 = f.get_rect("abc\n\nabc", wraplength=1000)
+        self.assertAlmostEqual(rect2.height - rect.height, height, delta=1)
+
+        # a word longer than a line is broken
+        rect = f.get_rect("w" * 20, wraplength=50)
+        self.assertLessEqual(rect.width, 50)
+
+        # the lines are aligned within the widest
+        text = "wide wide wide i"
+        for align in (pygame.FONT_LEFT, pygame.FONT_CENTER, pygame.FONT_RIGHT):
+            surf, rect = f.render(text, "black", wraplength=150, align=align)
+            self.assertEqual(rect.size, f.get_rect(text, wraplength=150).size)
+        left = f.render(text, "black", wraplength=150)[0]
+        right = f.render(text, "black", wraplength=150, align=pygame.FONT_RIGHT)[0]
+        self.assertNotEqual(
+            pygame.image.tostring(left, "RGBA"), pygame.image.tostring(right, "RGBA")
+        )
+
+        surf = pygame.Surface((200, 200), pygame.SRCALPHA)
+        rect = f.render_to(surf, (10, 10), "one two", "black", wraplength=60)
+        self.assertEqual(rect.size, f.get_rect("one two", wraplength=60).size)
+
+        with self.assertRaises(ValueError):
+            f.render(text, wraplength=-1)
+        with self.assertRaises(ValueError):
+            f.render(text, wraplength=100, align=3)
+        with self.assertRaises(ValueError):
+            f.render(text, wraplength=100, rotation=90)
+        with self.assertRaises(ValueError):
+            f.render(text, wraplength=100, style=ft.STYLE_UNDERLINE)
+
+    def test_freetype_Font_render_cache(self):
+        f = ft.Font(self._sans_path, size=24)
+        f.render_cache_limit = 1 << 20
+
+        surf, rect = f.render("abc", "black")
+        surf2, rect2 = f.render("abc", "black")
+        self.assertIs(surf2, surf)
+        self.assertEqual(rect2, rect)
+        self.assertIsNot(rect2, rect)
+
+        # anything changing the rendering changes the surface
+        self.assertIsNot(f.render("abc", "black", size=12)[0], surf)
+        self.assertIsNot(f.render("abc", "black", "white")[0], surf)
+        f.strong = True
+        self.assertIsNot(f.render("abc", "black")[0], surf)
+        f.strong = False
+        f.antialiased = False
+        self.assertIsNot(f.render("abc", "black")[0], surf)
+        f.antialiased = True
+        self.assertIs(f.render("abc", "black")[0], surf)
+
+        stats = f.get_render_cache_stats()
+        self.assertEqual((stats["hits"], stats["misses"]), (2, 5))
+        self.assertEqual(stats["surfaces"], 5)
+
+        # a limit smaller than a surface keeps none
+        f.render_cache_limit = 16
+        self.assertEqual(f.get_render_cache_stats()["surfaces"], 0)
+        self.assertIsNot(f.render("abc", "black")[0], f.render("abc", "black")[0])
+
+    def test_freetype_Font_share_cache(self):
+        f1 = ft.Font(self._sans_path, size=24)
+        f2 = ft.Font(self._sans_path, size=24)
+        f2.share_cache(f1)
+
+        f1.render_raw("abc")
+        f2.render_raw("abc")
+        stats = f2.get_cache_stats()
+        self.assertEqual(stats, f1.get_cache_stats())
+        self.assertEqual((stats["hits"], stats["misses"]), (3, 3))
+
+        # The shared cache outlives the font it came from.
+        del f1
+        f2.render_raw("abc")
+        self.assertEqual(f2.get_cache_stats()["hits"], 6)
+
+        with self.assertRaises(ValueError):
+            f2.share_cache(ft.Font(self._fixed_path))
+        with self.assertRaises(ValueError):
+            f2.share_cache(ft.Font(self._sans_path, resolution=144))
+        with self.assertRaises(TypeError):
+            f2.share_cache(None)
+
     def test_undefined_character_code(self):
         # To be consistent with pygame.font.Font, undefined codes
         # are rendered as the undefined character, and has metrics
@@ -1795,5 +1990,149 @@ class FreeTypeTest(unittest.TestCase):
         self.assertIsNone(error_msg)
 
 
+class TextLayoutTest(unittest.TestCase):
+    _sans_path = os.path.join(FONTDIR, "test_sans.ttf")
+
+    def setUp(self):
+        ft.init()
+        self.font = ft.Font(self._sans_path, 24)
+
+    def tearDown(self):
+        ft.quit()
+
+    def _same_pixels(self, s1, s2):
+        self.assertEqual(s1.get_size(), s2.get_size())
+        w, h = s1.get_size()
+        for x in range(w):
+            for y in range(h):
+                self.assertEqual(s1.get_at((x, y)), s2.get_at((x, y)))
+
+    def test_attributes(self):
+        layout = ft.TextLayout(self.font, "Hello")
+
+        self.assertIs(layout.font, self.font)
+        self.assertEqual(layout.text, "Hello")
+        self.assertIs(pygame.freetype.TextLayout, ft.TextLayout)
+        with self.assertRaises(TypeError):
+            ft.TextLayout(self.font, 1)
+        with self.assertRaises(TypeError):
+            ft.TextLayout(None, "Hello")
+
+    def test_matches_font(self):
+        layout = ft.TextLayout(self.font, "Hello", size=32)
+
+        self.assertEqual(layout.get_rect(), self.font.get_rect("Hello", size=32))
+        self.assertEqual(
+            layout.get_metrics(), self.font.get_metrics("Hello", size=32)
+        )
+        surf, rect = layout.render("red")
+        expected, expected_rect = self.font.render("Hello", "red", size=32)
+        self.assertEqual(rect, expected_rect)
+        self._same_pixels(surf, expected)
+
+    def test_render_many_times(self):
+        layout = ft.TextLayout(self.font, "Hi")
+        self.font.render("something else entirely", "black")
+        self.font.size = 10
+
+        # the layout keeps the size and text it was made with
+        surf = pygame.Surface((200, 100), pygame.SRCALPHA)
+        rect = layout.render_to(surf, (5, 5), "blue")
+        rect2 = layout.render_to(surf, (100, 50), "green", "white")
+        self.assertEqual(rect.size, rect2.size)
+        self.assertEqual(rect2.topleft, (100, 50))
+        self.assertEqual(surf.get_at(rect2.topleft), pygame.Color("white"))
+        self.assertEqual(rect.size, self.font.get_rect("Hi", size=24).size)
+
+        # evicted glyphs are found again
+        self.font.cache_limit = 1
+        self.font.render("abcdefgh", "black")
+        expected = self.font.render("Hi", "red", size=24)[0]
+        self._same_pixels(layout.render("red")[0], expected)
+
+    def test_get_caret_positions(self):
+        text = "Hello world"
+        layout = ft.TextLayout(self.font, text)
+
+        carets = layout.get_caret_positions()
+
+        self.assertEqual(len(carets), len(text) + 1)
+        self.assertEqual(carets, sorted(carets))
+        width = self.font.get_rect(text).width
+        self.assertLessEqual(abs(carets[-1] - width), 1)
+        # a caret lies at the advance of the text before it
+        for i in range(1, len(text)):
+            prefix = ft.TextLayout(self.font, text[:i]).get_caret_positions()
+            self.assertLessEqual(abs(carets[i] - prefix[-1]), 1)
+
+        rotated = ft.TextLayout(self.font, text, rotation=90)
+        with self.assertRaises(ValueError):
+            rotated.get_caret_positions()
+
+    def test_index_at(self):
+        layout = ft.TextLayout(self.font, "Hello")
+        carets = layout.get_caret_positions()
+        height = layout.get_rect().height
+
+        for i in range(5):
+            self.assertEqual(layout.index_at((carets[i], height // 2)), i)
+            self.assertEqual(layout.index_at((carets[i + 1] - 1, 0)), i)
+        self.assertEqual(layout.index_at((carets[-1], 0)), -1)
+        self.assertEqual(layout.index_at((carets[0], height)), -1)
+        self.assertEqual(layout.index_at((-100, 0)), -1)
+        with self.assertRaises(TypeError):
+            layout.index_at("a")
+
+
+class GlyphAtlasTest(unittest.TestCase):
+    _sans_path = os.path.join(FONTDIR, "test_sans.ttf")
+
+    def setUp(self):
+        ft.init()
+        self.font = ft.Font(self._sans_path, 24)
+        self.glyphs = ft.GlyphAtlas(self.font, "red", page_size=(64, 64))
+
+    def tearDown(self):
+        ft.quit()
+
+    def test_add(self):
+        self.glyphs.add("Hello\nworld")
+
+        self.assertEqual(len(self.glyphs), len(set("Helloworld")))
+        image = self.glyphs.layout("H")[0][0]
+        surface, rect = self.font.render("H", "red")
+        self.assertEqual(image.get_size(), surface.get_size())
+        for pos in ((0, 0), (rect.w // 2, rect.h // 2), (rect.w - 1, rect.h - 1)):
+            self.assertEqual(image.get_at(pos), surface.get_at(pos))
+
+    def test_layout(self):
+        placed = self.glyphs.layout("AB\nA", (10, 20))
+
+        self.assertEqual(len(placed), 3)
+        first, second, third = (rect for image, rect in placed)
+        self.assertGreater(second.x, first.x)
+        self.assertEqual(third.x, first.x)
+        self.assertEqual(third.y - first.y, self.font.get_sized_height())
+        # the glyph is placed like Font.render_to places it at its origin
+        expected = pygame.Surface((100, 100), pygame.SRCALPHA)
+        self.font.origin = True
+        baseline = 20 + self.font.get_sized_ascender()
+        self.font.render_to(expected, (10, baseline), "A", "red")
+        surface = pygame.Surface((100, 100), pygame.SRCALPHA)
+        self.glyphs.render_to(surface, (10, 20), "A")
+        self.assertEqual(surface.get_bounding_rect(), expected.get_bounding_rect())
+
+    def test_render_to(self):
+        surface = pygame.Surface((200, 80), pygame.SRCALPHA)
+
+        rect = self.glyphs.render_to(surface, (5, 5), "Hi there")
+
+        self.assertTrue(rect.contains(surface.get_bounding_rect()))
+        self.assertGreater(surface.get_bounding_rect().width, 0)
+        self.assertEqual(
+            self.glyphs.render_to(surface, (5, 5), ""), pygame.Rect(5, 5, 0, 0)
+        )
+
+
 if __name__ == "__main__":
     unittest.main()
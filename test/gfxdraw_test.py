@@ -805,6 +805,35 @@ class GfxdrawDefaultTest(unittest.TestCase):
             for posn in bg_test_points:
                 self.check_at(surf, posn, bg_adjusted)
 
+    def test_filled_polygon__threads(self):
+        """Ensures filled_polygon can be called from several threads at once."""
+        import threading
+
+        fg = self.foreground_color
+        bg = self.background_color
+        points = [(10, 80), (10, 15), (92, 25), (92, 80)]
+        surfs = [pygame.Surface(self.default_size, 0, 32) for _ in range(4)]
+        errors = []
+
+        def draw(surf):
+            try:
+                for _ in range(50):
+                    surf.fill(bg)
+                    pygame.gfxdraw.filled_polygon(surf, points, fg)
+            except Exception as e:
+                errors.append(e)
+
+        threads = [threading.Thread(target=draw, args=(s,)) for s in surfs]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        self.assertEqual(errors, [])
+        for surf in surfs:
+            self.check_at(surf, (40, 50), fg)
+            self.check_at(surf, (5, 50), bg)
+
     def test_textured_polygon(self):
         """textured_polygon(surface, points, texture, tx, ty): return None"""
         w, h = self.default_size
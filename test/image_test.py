@@ -92,6 +92,48 @@ class ImageModuleTest(unittest.TestCase):
                     img_file = io.BytesIO(img_bytes)
                     image = pygame.image.load(img_file)
 
+    def test_load_file_object_position(self):
+        """Reads are buffered, but the file is left where the decoder stopped."""
+
+        class Stream(io.RawIOBase):
+            def __init__(self, data, seekable):
+                self.file = io.BytesIO(data)
+                self.can_seek = seekable
+                self.reads = 0
+
+            def readable(self):
+                return True
+
+            def seekable(self):
+                return self.can_seek
+
+            def read(self, size=-1):
+                self.reads += 1
+                return self.file.read(size)
+
+            def seek(self, offset, whence=0):
+                return self.file.seek(offset, whence)
+
+            def tell(self):
+                return self.file.tell()
+
+        with open(example_path("data/asprite.bmp"), "rb") as f:
+            data = f.read() + b"trailing data"
+        expected = pygame.image.load(io.BytesIO(data))
+
+        unbuffered = Stream(data, False)
+        buffered = Stream(data, True)
+        in_memory = io.BytesIO(data)
+        for file in (unbuffered, buffered, in_memory):
+            image = pygame.image.load(file)
+            self.assertEqual(image.get_size(), expected.get_size())
+            self.assertEqual(image.get_at((10, 10)), expected.get_at((10, 10)))
+            self.assertEqual(file.tell(), unbuffered.tell())
+        self.assertLess(buffered.reads, unbuffered.reads)
+
+        # the contents of the io.BytesIO are no longer exported
+        in_memory.write(b"more")
+
     def testSaveJPG(self):
         """JPG equivalent to issue #211 - color channel swapping
 
@@ -318,6 +360,38 @@ class ImageModuleTest(unittest.TestCase):
             # clean up the temp file, even if test fails
             os.remove(temp_filename)
 
+    def test_save_tga__load_basic(self):
+        """TGA files are read back by pygame itself, without SDL_image."""
+        rgba = pygame.Surface((300, 70), pygame.SRCALPHA, 32)
+        rgba.fill((10, 20, 30, 40))
+        rgba.fill((200, 100, 0, 255), (5, 5, 150, 30))
+        for x in range(0, 300, 7):
+            rgba.set_at((x, 50), (x % 256, 1, 2, 3))
+
+        indexed = pygame.Surface((33, 9), 0, 8)
+        indexed.set_palette_at(4, (9, 8, 7))
+        indexed.set_palette_at(5, (70, 80, 90))
+        indexed.fill(4)
+        indexed.fill(5, (3, 2, 20, 4))
+        indexed.set_colorkey(5)
+
+        for surf in (rgba, indexed):
+            fd, f_path = tempfile.mkstemp(suffix=".tga")
+            os.close(fd)
+            try:
+                pygame.image.save(surf, f_path)
+                for loaded in (
+                    pygame.image.load_basic(f_path),
+                    pygame.image.load(f_path),
+                ):
+                    self.assertEqual(loaded.get_size(), surf.get_size())
+                    self.assertEqual(loaded.get_colorkey(), surf.get_colorkey())
+                    for pos in ((0, 0), (6, 6), (154, 34), (7, 50), (32, 8)):
+                        if surf.get_rect().collidepoint(pos):
+                            self.assertEqual(loaded.get_at(pos), surf.get_at(pos))
+            finally:
+                os.remove(f_path)
+
     def test_save_pathlib(self):
         surf = pygame.Surface((1, 1))
         surf.fill((23, 23, 23))
@@ -604,6 +678,26 @@ class ImageModuleTest(unittest.TestCase):
                 'symmetric with "{}" format'.format(fmt),
             )
 
+    def test_tostring_fromstring__rgb_widths(self):
+        """RGB strings are right whatever the row width and flipping."""
+        for width in (1, 4, 5, 6, 7, 13, 31):
+            surf = pygame.Surface((width, 3), 0, 32)
+            for x in range(width):
+                for y in range(3):
+                    surf.set_at((x, y), (x * 8, y * 70, 255 - x))
+            for flipped in (False, True):
+                buf = pygame.image.tostring(surf, "RGB", flipped)
+                self.assertEqual(len(buf), width * 3 * 3)
+                first_row = 2 if flipped else 0
+                for x in range(width):
+                    color = surf.get_at((x, first_row))
+                    self.assertEqual(tuple(buf[x * 3 : x * 3 + 3]), color[:3])
+
+                restored = pygame.image.fromstring(buf, (width, 3), "RGB", flipped)
+                for x in range(width):
+                    for y in range(3):
+                        self.assertEqual(restored.get_at((x, y)), surf.get_at((x, y)))
+
     def test_tostring_depth_24(self):
         test_surface = pygame.Surface((64, 256), depth=24)
         for i in range(256):
@@ -990,6 +1084,48 @@ class ImageModuleTest(unittest.TestCase):
         self.assertEqual(argb_surf.get_at((2, 2)), pygame.Color(0, 0, 0, 79))
         self.assertEqual(argb_surf.get_at((3, 3)), pygame.Color(50, 200, 20, 255))
 
+    def test_frombuffer_pitch(self):
+        """Rows of a buffer can be further apart than the width of the image."""
+        pitch = 12
+        buffer = bytearray(pitch * 2 + 8)
+        buffer[0:4] = bytes((10, 20, 30, 40))
+        buffer[pitch + 4 : pitch + 8] = bytes((50, 60, 70, 80))
+        buffer[pitch * 2 + 4 :] = bytes((90, 100, 110, 120))
+
+        surf = pygame.image.frombuffer(buffer, (2, 3), "RGBA", pitch)
+        self.assertEqual(surf.get_pitch(), pitch)
+        self.assertEqual(surf.get_at((0, 0)), (10, 20, 30, 40))
+        self.assertEqual(surf.get_at((1, 1)), (50, 60, 70, 80))
+        self.assertEqual(surf.get_at((1, 2)), (90, 100, 110, 120))
+
+        # the pixels are shared with the buffer
+        surf.set_at((0, 1), (1, 2, 3, 4))
+        self.assertEqual(buffer[pitch : pitch + 4], bytes((1, 2, 3, 4)))
+
+        with self.assertRaises(ValueError):
+            pygame.image.frombuffer(buffer, (2, 3), "RGBA", 7)
+        with self.assertRaises(ValueError):
+            pygame.image.frombuffer(buffer, (2, 4), "RGBA", pitch)
+
+    def test_frombuffer_strided(self):
+        try:
+            import numpy
+        except ImportError:
+            self.skipTest("requires numpy")
+
+        array = numpy.zeros((3, 5, 4), numpy.uint8)
+        array[1, 2] = (10, 20, 30, 40)
+        view = array[:, 1:4]
+
+        surf = pygame.image.frombuffer(view, (3, 3), "RGBA")
+        self.assertEqual(surf.get_pitch(), 20)
+        self.assertEqual(surf.get_at((1, 1)), (10, 20, 30, 40))
+        surf.set_at((2, 2), (1, 2, 3, 4))
+        self.assertEqual(tuple(array[2, 3]), (1, 2, 3, 4))
+
+        with self.assertRaises(ValueError):
+            pygame.image.frombuffer(array[:, ::2], (3, 3), "RGBA")
+
     def test_get_extended(self):
         # Create a png file and try to load it. If it cannot, get_extended() should return False
         raw_image = []
@@ -1124,6 +1260,244 @@ class ImageModuleTest(unittest.TestCase):
                 pygame.error, pygame.image.save_extended, surf, f"temp_file.{fmt}"
             )
 
+    def test_save__compression_filter(self):
+        surf = pygame.Surface((40, 30))
+        surf.fill((10, 200, 30))
+        surf.fill((250, 5, 90), (3, 4, 20, 10))
+        fd, f_path = tempfile.mkstemp(suffix=".png")
+        os.close(fd)
+        try:
+            sizes = []
+            for compression in (0, 9):
+                pygame.image.save(surf, f_path, compression=compression, filter="up")
+                sizes.append(os.path.getsize(f_path))
+                loaded = pygame.image.load(f_path)
+                self.assertEqual(loaded.get_at((5, 5)), (250, 5, 90, 255))
+                self.assertEqual(loaded.get_at((30, 25)), (10, 200, 30, 255))
+            self.assertLess(sizes[1], sizes[0])
+        finally:
+            os.remove(f_path)
+
+        with self.assertRaises(ValueError):
+            pygame.image.save(surf, "temp.png", compression=10)
+        with self.assertRaises(ValueError):
+            pygame.image.save(surf, "temp.png", filter="median")
+        with self.assertRaises(ValueError):
+            pygame.image.save(surf, "temp.bmp", compression=1)
+
+    def test_save_async(self):
+        surf = pygame.Surface((16, 8))
+        surf.fill((1, 2, 3))
+        f_paths = []
+        try:
+            for i in range(4):
+                fd, f_path = tempfile.mkstemp(suffix=".png")
+                os.close(fd)
+                f_paths.append(f_path)
+                surf.set_at((i, 0), (255, 255, 255))
+                pygame.image.save_async(surf, f_path, compression=1)
+            # later drawing does not reach the queued copies
+            surf.fill((0, 0, 0))
+            pygame.image.wait_saves()
+
+            for i, f_path in enumerate(f_paths):
+                loaded = pygame.image.load(f_path)
+                self.assertEqual(loaded.get_at((i, 0)), (255, 255, 255, 255))
+                self.assertEqual(loaded.get_at((i + 1, 0)), (1, 2, 3, 255))
+        finally:
+            for f_path in f_paths:
+                os.remove(f_path)
+
+        with self.assertRaises(TypeError):
+            pygame.image.save_async(surf, io.BytesIO(), "png")
+        with self.assertRaises(ValueError):
+            pygame.image.save_async(surf, "temp.bmp")
+        pygame.image.save_async(surf, os.path.join(f_paths[0], "no_dir", "x.png"))
+        with self.assertRaises(pygame.error):
+            pygame.image.wait_saves()
+        pygame.image.wait_saves()
+
+    def test_save_raw__load_raw(self):
+        """Ensures raw files keep the pixels and settings of a surface."""
+        parent = pygame.Surface((30, 20), pygame.SRCALPHA, 32)
+        parent.fill((10, 20, 30, 40))
+        parent.fill((200, 100, 50, 255), (5, 5, 3, 3))
+        surf = parent.subsurface((4, 4, 17, 9))
+        surf.set_colorkey((1, 2, 3))
+        fd, f_path = tempfile.mkstemp(suffix=".raw")
+        os.close(fd)
+        try:
+            pygame.image.save_raw(surf, f_path)
+            loaded = pygame.image.load_raw(pathlib.Path(f_path))
+            self.assertEqual(loaded.get_size(), (17, 9))
+            self.assertEqual(loaded.get_flags() & pygame.SRCALPHA, pygame.SRCALPHA)
+            self.assertEqual(loaded.get_colorkey(), surf.get_colorkey())
+            for pos in ((0, 0), (1, 1), (3, 3), (16, 8)):
+                self.assertEqual(loaded.get_at(pos), surf.get_at(pos))
+
+            # drawing on the surface leaves the file alone
+            loaded.fill((0, 0, 0, 0))
+            del loaded
+            again = pygame.image.load_raw(f_path)
+            self.assertEqual(again.get_at((1, 1)), surf.get_at((1, 1)))
+            del again
+        finally:
+            os.remove(f_path)
+
+    def test_save_raw__load_raw_fileobj(self):
+        surf = pygame.Surface((5, 3), 0, 8)
+        surf.set_palette_at(7, (90, 80, 70))
+        surf.fill(7)
+        surf.set_at((4, 2), 3)
+
+        buffer = io.BytesIO()
+        pygame.image.save_raw(surf, buffer)
+        buffer.seek(0)
+        loaded = pygame.image.load_raw(buffer)
+
+        self.assertEqual(loaded.get_bitsize(), 8)
+        self.assertEqual(loaded.get_at((0, 0)), (90, 80, 70, 255))
+        self.assertEqual(loaded.get_at_mapped((4, 2)), 3)
+
+        with self.assertRaises(pygame.error):
+            pygame.image.load_raw(io.BytesIO(b"\0" * 64))
+        with self.assertRaises(FileNotFoundError):
+            pygame.image.load_raw(example_path("data/no_such.raw"))
+
+    def test_tobuffer_raw__frombuffer_raw(self):
+        """Ensures a surface made over a raw buffer shares its memory."""
+        surf = pygame.Surface((17, 9), pygame.SRCALPHA, 32)
+        surf.fill((10, 20, 30, 40))
+        surf.set_at((3, 4), (200, 100, 50, 255))
+        surf.set_colorkey((1, 2, 3))
+
+        size = pygame.image.raw_size(surf)
+        self.assertGreaterEqual(size, 17 * 9 * 4)
+        buffer = bytearray(size)
+        pygame.image.tobuffer_raw(surf, buffer)
+        shared = pygame.image.frombuffer_raw(buffer)
+        other = pygame.image.frombuffer_raw(memoryview(buffer))
+
+        self.assertEqual(shared.get_size(), (17, 9))
+        self.assertEqual(shared.get_flags() & pygame.SRCALPHA, pygame.SRCALPHA)
+        self.assertEqual(shared.get_colorkey(), surf.get_colorkey())
+        self.assertEqual(shared.get_at((3, 4)), (200, 100, 50, 255))
+        self.assertEqual(shared.get_at((0, 0)), (10, 20, 30, 40))
+
+        # both surfaces are over the same bytes
+        shared.set_at((5, 6), (1, 1, 1, 1))
+        self.assertEqual(other.get_at((5, 6)), (1, 1, 1, 1))
+        # and the buffer stays alive with them
+        del buffer
+        self.assertEqual(other.get_at((3, 4)), (200, 100, 50, 255))
+
+    def test_tobuffer_raw__palette(self):
+        surf = pygame.Surface((5, 3), 0, 8)
+        surf.set_palette_at(7, (90, 80, 70))
+        surf.fill(7)
+
+        buffer = bytearray(pygame.image.raw_size(surf))
+        pygame.image.tobuffer_raw(surf, buffer)
+        shared = pygame.image.frombuffer_raw(buffer)
+
+        self.assertEqual(shared.get_bitsize(), 8)
+        self.assertEqual(shared.get_at((4, 2)), (90, 80, 70, 255))
+
+    def test_tobuffer_raw__bad_buffer(self):
+        surf = pygame.Surface((8, 8), 0, 32)
+        size = pygame.image.raw_size(surf)
+
+        with self.assertRaises(ValueError):
+            pygame.image.tobuffer_raw(surf, bytearray(size - 1))
+        with self.assertRaises(BufferError):
+            pygame.image.tobuffer_raw(surf, bytes(size))
+        with self.assertRaises(pygame.error):
+            pygame.image.frombuffer_raw(bytearray(size))
+
+    def _region_source(self):
+        surf = pygame.Surface((23, 17), pygame.SRCALPHA, 32)
+        for x in range(23):
+            for y in range(17):
+                surf.set_at((x, y), (x * 10, y * 14, 200, 255 - x - y))
+        return surf
+
+    def test_load_region(self):
+        source = self._region_source()
+        rect = pygame.Rect(3, 5, 11, 7)
+        exts = ("png", "bmp") if pygame.image.get_extended() else ("bmp",)
+        for ext in exts:
+            fd, f_path = tempfile.mkstemp(suffix=f".{ext}")
+            os.close(fd)
+            try:
+                pygame.image.save(source, f_path)
+                region = pygame.image.load_region(f_path, rect)
+                self.assertEqual(region.get_size(), rect.size)
+                for x in range(rect.w):
+                    for y in range(rect.h):
+                        expected = source.get_at((rect.x + x, rect.y + y))
+                        if ext == "bmp":
+                            expected.a = region.get_at((x, y)).a
+                        self.assertEqual(region.get_at((x, y)), expected)
+
+                with self.assertRaises(ValueError):
+                    pygame.image.load_region(f_path, (20, 0, 4, 4))
+            finally:
+                os.remove(f_path)
+
+    def test_iter_bands(self):
+        if not pygame.image.get_extended():
+            self.skipTest("requires the extended image formats")
+        source = self._region_source()
+        buffer = io.BytesIO()
+        pygame.image.save(source, buffer, "png")
+        buffer.seek(0)
+
+        bands = list(pygame.image.iter_bands(buffer, 5, "png"))
+
+        self.assertEqual([y for y, band in bands], [0, 5, 10, 15])
+        self.assertEqual([band.get_height() for y, band in bands], [5, 5, 5, 2])
+        for y, band in bands:
+            self.assertEqual(band.get_width(), 23)
+            for row in range(band.get_height()):
+                self.assertEqual(band.get_at((7, row)), source.get_at((7, y + row)))
+
+        with self.assertRaises(ValueError):
+            pygame.image.iter_bands(buffer, 0)
+
+    def test_load_many(self):
+        filenames = ["asprite.bmp", "laplacian.png", "red.jpg", "blue.gif"]
+        paths = [example_path("data/" + filename) for filename in filenames]
+        with open(paths[0], "rb") as f:
+            surfs = pygame.image.load_many(paths + [f, pathlib.Path(paths[1])])
+
+        self.assertEqual(len(surfs), 6)
+        for surf, path in zip(surfs, paths + paths[:2]):
+            expected = pygame.image.load(path)
+            self.assertEqual(surf.get_size(), expected.get_size())
+            self.assertEqual(surf.get_at((0, 0)), expected.get_at((0, 0)))
+
+        self.assertEqual(pygame.image.load_many([]), [])
+        with self.assertRaises(FileNotFoundError):
+            pygame.image.load_many([paths[0], example_path("data/no_such.png")])
+        with self.assertRaises(pygame.error):
+            pygame.image.load_many([paths[0], io.BytesIO(b"not an image")])
+        with self.assertRaises(TypeError):
+            pygame.image.load_many(None)
+
+    def test_load_many__convert(self):
+        path = example_path("data/laplacian.png")
+        pygame.display.init()
+        try:
+            pygame.display.set_mode((1, 1))
+            surfs = pygame.image.load_many([path, path], convert=True)
+            alpha_surfs = pygame.image.load_many([path], alpha=True)
+        finally:
+            pygame.display.quit()
+
+        self.assertEqual(len(surfs), 2)
+        self.assertEqual(surfs[0].get_at((0, 0)), (10, 10, 70, 255))
+        self.assertNotEqual(alpha_surfs[0].get_flags() & pygame.SRCALPHA, 0)
+
     def threads_load(self, images):
         import pygame.threads
 
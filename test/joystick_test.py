@@ -125,6 +125,41 @@ class JoystickModuleTest(unittest.TestCase):
             pygame.joystick.quit()
 
 
+    def test_get_state(self):
+        """Ensures get_state packs the same values as the single getters."""
+        import array
+
+        pygame.joystick.init()
+        try:
+            if pygame.joystick.get_count() == 0:
+                self.skipTest("no joystick connected")
+            joy = pygame.joystick.Joystick(0)
+            numaxes = joy.get_numaxes()
+            numbuttons = joy.get_numbuttons()
+            numhats = joy.get_numhats()
+
+            state = joy.get_state()
+            self.assertIsInstance(state, array.array)
+            self.assertEqual(len(state), 7 + numaxes + numbuttons + 2 * numhats)
+            self.assertIs(joy.get_state(state), state)
+
+            values = state[1:]
+            for i in range(numaxes):
+                self.assertEqual(values.pop(0), joy.get_axis(i))
+            for i in range(numbuttons):
+                self.assertEqual(values.pop(0), joy.get_button(i))
+            for i in range(numhats):
+                self.assertEqual((values.pop(0), values.pop(0)), joy.get_hat(i))
+            self.assertEqual(len(values), 6)
+
+            with self.assertRaises(ValueError):
+                joy.get_state(array.array("d", [0.0] * (len(state) - 1)))
+            with self.assertRaises(ValueError):
+                joy.get_state(array.array("f", [0.0] * len(state)))
+        finally:
+            pygame.joystick.quit()
+
+
 class JoystickInteractiveTest(unittest.TestCase):
 
     __tags__ = ["interactive"]
@@ -75,6 +75,28 @@ class KeyModuleTest(unittest.TestCase):
         states = pygame.key.get_pressed()
         self.assertEqual(states[pygame.K_RIGHT], 0)
 
+    def test_get_pressed_buffer(self):
+        """Ensures get_pressed_buffer copies the same states as
+        get_pressed, and clears the changed bits when nothing changed."""
+        states = pygame.key.get_pressed()
+        keys = pygame.key.get_pressed_buffer()
+        self.assertIsInstance(keys, bytearray)
+        self.assertEqual(len(keys), len(states))
+        self.assertEqual(list(keys), [int(state) for state in states])
+
+        out = bytearray(b"\xff" * len(states))
+        changed = bytearray(b"\xff" * (len(states) // 8))
+        self.assertIs(pygame.key.get_pressed_buffer(out, changed=changed), out)
+        self.assertEqual(out, keys)
+        self.assertEqual(changed, bytes(len(changed)))
+
+        with self.assertRaises(ValueError):
+            pygame.key.get_pressed_buffer(bytearray(len(states) - 1))
+        with self.assertRaises(ValueError):
+            pygame.key.get_pressed_buffer(changed=bytearray(1))
+        with self.assertRaises(TypeError):
+            pygame.key.get_pressed_buffer(bytes(len(states)))
+
     def test_name(self):
         self.assertEqual(pygame.key.name(pygame.K_RETURN), "return")
         self.assertEqual(pygame.key.name(pygame.K_0), "0")
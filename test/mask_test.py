@@ -1,5 +1,7 @@
 from collections import OrderedDict
+import array
 import copy
+import math
 import platform
 import random
 import unittest
@@ -736,6 +738,65 @@ class MaskTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
                     self.assertEqual(mask1.get_size(), mask_size, msg)
                     self.assertEqual(mask2.get_size(), mask_size, msg)
 
+    def test_overlap__single_bit_rows(self):
+        """Ensures overlap and overlap_area find a single bit on any row.
+
+        Rows are compared a few at a time, so this checks bits both within
+        those blocks of rows and in the rows left over after them.
+        """
+        mask1 = pygame.mask.Mask((130, 11))
+        mask2 = pygame.mask.Mask((70, 9), fill=True)
+
+        for pos in ((0, 0), (65, 3), (100, 4), (129, 10), (64, 8)):
+            mask1.clear()
+            mask1.set_at(pos)
+
+            for offset in ((0, 0), (33, 2), (64, 2), (70, 3), (-5, -1)):
+                msg = f"pos={pos}, offset={offset}"
+                hit = mask2.get_rect(topleft=offset).collidepoint(pos)
+
+                self.assertEqual(
+                    mask1.overlap(mask2, offset), pos if hit else None, msg
+                )
+                self.assertEqual(
+                    mask1.overlap_area(mask2, offset), 1 if hit else 0, msg
+                )
+
+    def test_overlap__after_changes(self):
+        """Ensures overlap sees each change to a mask it has already tested.
+
+        An empty mask is rejected without scanning its bits, so this checks
+        that changing a mask by any means is noticed.
+        """
+        mask1 = pygame.mask.Mask((100, 10))
+        mask2 = pygame.mask.Mask((10, 10), fill=True)
+        offset = (80, 0)
+
+        self.assertIsNone(mask1.overlap(mask2, offset))
+
+        mask1.set_at((85, 5))
+        self.assertEqual(mask1.overlap(mask2, offset), (85, 5))
+
+        mask1.set_at((85, 5), 0)
+        self.assertIsNone(mask1.overlap(mask2, offset))
+
+        mask1.draw(mask2, (90, 0))
+        self.assertEqual(mask1.overlap(mask2, offset), (90, 0))
+
+        mask1.erase(mask2, (90, 0))
+        self.assertIsNone(mask1.overlap(mask2, offset))
+
+        mask1.invert()
+        self.assertEqual(mask1.overlap_area(mask2, offset), 100)
+
+        mask1.clear()
+        self.assertEqual(mask1.overlap_area(mask2, offset), 0)
+
+        with memoryview(mask1) as view:
+            bits = view.itemsize * 8
+            view[81 // bits, 3] = 1 << (81 % bits)
+        self.assertEqual(mask1.overlap(mask2, offset), (81, 3))
+
     @unittest.skipIf(IS_PYPY, "Segfaults on pypy")
     def test_overlap__invalid_mask_arg(self):
         """Ensure overlap handles invalid mask arguments correctly."""
@@ -1322,6 +1383,23 @@ class MaskTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
                     self.assertEqual(original_mask.count(), original_count, msg)
                     self.assertEqual(original_mask.get_size(), original_size, msg)
 
+    def test_scale__bits(self):
+        """Ensures each scaled bit is the source bit its position maps to,
+        for twice, half, and other widths across words.
+        """
+        random.seed(12)
+        original_mask = random_mask((70, 9))
+
+        for size in ((140, 9), (35, 18), (70, 4), (129, 7), (20, 30), (71, 9)):
+            mask = original_mask.scale(size)
+
+            for x in range(size[0]):
+                for y in range(size[1]):
+                    pos = (x * 70 // size[0], y * 9 // size[1])
+                    self.assertEqual(
+                        mask.get_at((x, y)), original_mask.get_at(pos), (size, x, y)
+                    )
+
     def test_scale__negative_size(self):
         """Ensure scale handles negative sizes correctly."""
         mask = pygame.Mask((100, 100))
@@ -1979,6 +2057,37 @@ class MaskTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
 
         # TODO: Test more corner case outlines.
 
+    def test_outline__after_changes(self):
+        """Ensures a repeated outline is a new list that follows any change
+        to the mask.
+        """
+        m = pygame.Mask((20, 20))
+        m.set_at((10, 10))
+        outline = m.outline()
+        outline.append((0, 0))
+
+        self.assertEqual(m.outline(), [(10, 10)])
+        self.assertIsNot(m.outline(), m.outline())
+
+        m.set_at((11, 11))
+        self.assertEqual(m.outline(), [(10, 10), (11, 11), (10, 10)])
+
+        m.draw(pygame.Mask((1, 1), fill=True), (12, 12))
+        self.assertEqual(m.outline(every=2), [(10, 10), (12, 12), (10, 10)])
+        self.assertEqual(
+            m.outline(), [(10, 10), (11, 11), (12, 12), (11, 11), (10, 10)]
+        )
+
+        m.clear()
+        self.assertEqual(m.outline(), [])
+
+        m.fill()
+        self.assertEqual(m.outline(every=1000), [(0, 0)])
+
+        with memoryview(m) as view:
+            view[0, 0] = 0  # Clears the first row.
+        self.assertEqual(m.outline(every=1000), [(0, 1)])
+
     def test_convolve__size(self):
         sizes = [(1, 1), (31, 31), (32, 32), (100, 100)]
         for s1 in sizes:
@@ -2060,6 +2169,136 @@ class MaskTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
                     conv.get_at((i, j)) == 0, m1.overlap(m2, (i - 99, j - 99)) is None
                 )
 
+    def test_convolve__long_runs(self):
+        """Ensures kernels with long runs of bits, within and across words,
+        convolve by the definition of convolution.
+        """
+        random.seed(5)
+        m1 = random_mask((40, 12))
+        m2 = pygame.Mask((150, 5))
+        m2.draw(pygame.Mask((150, 1), fill=True), (0, 0))
+        m2.draw(pygame.Mask((70, 1), fill=True), (60, 2))
+        m2.draw(pygame.Mask((70, 1), fill=True), (3, 3))
+        m2.draw(pygame.Mask((2, 1), fill=True), (100, 3))
+        for _ in range(20):
+            m2.set_at((random.randrange(150), 4))
+        conv = m1.convolve(m2)
+
+        for i in range(conv.get_size()[0]):
+            for j in range(conv.get_size()[1]):
+                self.assertEqual(
+                    conv.get_at((i, j)) == 0,
+                    m1.overlap(m2, (i - 149, j - 4)) is None,
+                    (i, j),
+                )
+
+    def _assert_morphology(self, mask, result, n, erode):
+        # Checks each bit of result against the bits of mask within n bits of
+        # it, counting the bits outside of mask as unset.
+        width, height = mask.get_size()
+        for x in range(width):
+            for y in range(height):
+                near = [
+                    0 <= i < width and 0 <= j < height and mask.get_at((i, j))
+                    for i in range(x - n, x + n + 1)
+                    for j in range(y - n, y + n + 1)
+                ]
+                expected = all(near) if erode else any(near)
+                self.assertEqual(result.get_at((x, y)), expected, (x, y, n))
+
+    def test_dilate(self):
+        """Ensures dilate sets the bits within n bits of a set bit."""
+        random.seed(7)
+        for size, n in (((70, 9), 0), ((70, 9), 1), ((130, 6), 3), ((5, 4), 9)):
+            mask = random_mask(size)
+            mask.erase(random_mask(size), (0, 0))
+            dilated = mask.copy()
+
+            self.assertIsNone(dilated.dilate(n))
+            self._assert_morphology(mask, dilated, n, False)
+
+    def test_dilate__single_bit(self):
+        """Ensures dilate grows a single bit into a square, clipped by the
+        edges of the mask.
+        """
+        mask = pygame.mask.Mask((100, 20))
+        mask.set_at((64, 10))
+        mask.set_at((1, 1))
+
+        mask.dilate(3)
+
+        self.assertEqual(mask.count(), 7 * 7 + 5 * 5)
+        self.assertEqual(
+            mask.get_bounding_rects(),
+            [pygame.Rect(0, 0, 5, 5), pygame.Rect(61, 7, 7, 7)],
+        )
+
+    def test_erode(self):
+        """Ensures erode clears the bits within n bits of an unset bit."""
+        random.seed(8)
+        for size, n in (((70, 9), 0), ((70, 9), 1), ((130, 6), 2)):
+            mask = random_mask(size)
+            mask.draw(random_mask(size), (0, 0))
+            eroded = mask.copy()
+
+            self.assertIsNone(eroded.erode(n))
+            self._assert_morphology(mask, eroded, n, True)
+
+    def test_erode__full_mask(self):
+        """Ensures erode clears the bits near the edges of a full mask."""
+        mask = pygame.mask.Mask((100, 20), fill=True)
+
+        mask.erode(2)
+
+        self.assertEqual(mask.count(), 96 * 16)
+        self.assertEqual(mask.get_bounding_rects(), [pygame.Rect(2, 2, 96, 16)])
+
+        mask.erode(10)
+
+        self.assertEqual(mask.count(), 0)
+
+    def test_dilate_erode__negative(self):
+        """Ensures dilate and erode reject a negative n."""
+        mask = pygame.mask.Mask((10, 10))
+
+        with self.assertRaises(ValueError):
+            mask.dilate(-1)
+        with self.assertRaises(ValueError):
+            mask.erode(-1)
+
+    def test_distance_transform(self):
+        """Ensures distance_transform finds the distance to the nearest set
+        bit.
+        """
+        random.seed(9)
+        width, height = 75, 11
+        mask = pygame.mask.Mask((width, height))
+        points = [(random.randrange(width), random.randrange(height))]
+        points += [(74, 0), (3, 10)]
+        for pos in points:
+            mask.set_at(pos)
+
+        distances = mask.distance_transform()
+        values = array.array("f", distances.raw)
+
+        self.assertIsInstance(distances, pygame.BufferProxy)
+        self.assertEqual(distances.length, width * height * 4)
+        self.assertEqual(distances.__array_interface__["shape"], (width, height))
+        for x in range(width):
+            for y in range(height):
+                expected = min(math.hypot(x - i, y - j) for i, j in points)
+                self.assertAlmostEqual(values[y * width + x], expected, 5)
+
+    def test_distance_transform__no_bits_set(self):
+        """Ensures distance_transform gives infinite distances when no bits
+        are set.
+        """
+        mask = pygame.mask.Mask((70, 3))
+
+        values = array.array("f", mask.distance_transform().raw)
+
+        self.assertEqual(list(values), [float("inf")] * 70 * 3)
+
     def _draw_component_pattern_box(self, mask, size, pos, inverse=False):
         # Helper method to create/draw a 'box' pattern for testing.
         #
@@ -2447,6 +2686,53 @@ class MaskTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
         self.assertEqual(mask.count(), mask_count)
         self.assertEqual(mask.get_size(), mask_size)
 
+    def test_connected_components__merged_labels(self):
+        """Ensures the components are counted whole when parts of them are
+        only found to be connected further down the mask.
+        """
+        rows = ("11011000", "11100001", "00001001", "01111110")
+        mask = pygame.mask.Mask((len(rows[0]), len(rows)))
+
+        for y, row in enumerate(rows):
+            for x, bit in enumerate(row):
+                if bit == "1":
+                    mask.set_at((x, y))
+
+        comps = mask.connected_components()
+        big_comps = mask.connected_components(minimum=9)
+        largest = mask.connected_component()
+
+        self.assertListEqual(sorted(comp.count() for comp in comps), [7, 9])
+        self.assertEqual(len(big_comps), 1)
+        self.assertEqual(big_comps[0].count(), 9)
+        self.assertEqual(largest.count(), 9)
+        self.assertTrue(largest.get_at((7, 1)))
+
+    def test_connected_components__across_words(self):
+        """Ensures runs of bits crossing the words of a mask and masks one bit
+        wide are labelled correctly.
+        """
+        mask = pygame.mask.Mask((200, 3))
+        mask.draw(pygame.mask.Mask((100, 1), fill=True), (10, 0))
+        mask.draw(pygame.mask.Mask((50, 1), fill=True), (110, 1))
+        mask.set_at((199, 2))
+        thin_mask = pygame.mask.Mask((1, 5))
+
+        for y in (0, 1, 3):
+            thin_mask.set_at((0, y))
+
+        comps = mask.connected_components()
+        rects = mask.get_bounding_rects()
+
+        self.assertEqual(len(comps), 2)
+        self.assertEqual(comps[0].count(), 150)
+        self.assertListEqual(
+            rects, [pygame.Rect(10, 0, 150, 2), pygame.Rect(199, 2, 1, 1)]
+        )
+        self.assertEqual(mask.connected_component((159, 1)).count(), 150)
+        self.assertEqual(len(thin_mask.connected_components()), 2)
+        self.assertEqual(thin_mask.connected_component().count(), 2)
+
     @unittest.skipIf(IS_PYPY, "Segfaults on pypy")
     def test_get_bounding_rects(self):
         """Ensures get_bounding_rects works correctly."""
@@ -5318,6 +5604,50 @@ class MaskTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
         self.assertEqual(to_surface.get_size(), mask_size)
         assertSurfaceFilled(self, to_surface, expected_color)
 
+    def test_to_surface__32bit_per_pixel(self):
+        """Ensures each pixel drawn on a 32 bit surface matches its bit, when
+        the mask has full, empty and mixed words and is offset on the surface.
+        """
+        random.seed(11)
+        mask_size = (200, 4)
+        mask = pygame.mask.Mask(mask_size)
+        mask.draw(pygame.mask.Mask((70, 4), fill=True), (5, 0))
+        for _ in range(150):
+            mask.set_at((random.randrange(75, 200), random.randrange(4)))
+        setsurface = pygame.Surface(mask_size, SRCALPHA, 32)
+        setsurface.fill((10, 20, 30, 40))
+        setsurface.fill((50, 60, 70, 80), (100, 0, 100, 4))
+        surface_color = pygame.Color(1, 2, 3, 4)
+        dest = (-3, 1)
+
+        for kwargs in (
+            {"setcolor": "red", "unsetcolor": "blue"},
+            {"setcolor": "red", "unsetcolor": None},
+            {"setcolor": None, "unsetcolor": "blue"},
+            {"setsurface": setsurface, "unsetcolor": "blue"},
+        ):
+            surface = pygame.Surface((190, 6), SRCALPHA, 32)
+            surface.fill(surface_color)
+
+            mask.to_surface(surface, dest=dest, **kwargs)
+
+            for pos in ((x, y) for x in range(190) for y in range(6)):
+                mask_pos = (pos[0] - dest[0], pos[1] - dest[1])
+                msg = f"{kwargs}, pos={pos}"
+                if not (0 <= mask_pos[1] < mask_size[1]):
+                    expected_color = surface_color
+                elif mask.get_at(mask_pos):
+                    if "setsurface" in kwargs:
+                        expected_color = setsurface.get_at(mask_pos)
+                    else:
+                        expected_color = kwargs["setcolor"] or surface_color
+                else:
+                    expected_color = kwargs["unsetcolor"] or surface_color
+
+                self.assertEqual(
+                    surface.get_at(pos), pygame.Color(expected_color), msg
+                )
+
     def test_zero_mask(self):
         """Ensures masks can be created with zero sizes."""
         for size in ((100, 0), (0, 100), (0, 0)):
@@ -6358,6 +6688,38 @@ class MaskModuleTest(unittest.TestCase):
             self.assertEqual(mask.count(), 100)
             self.assertEqual(mask.get_bounding_rects(), [pygame.Rect((40, 40, 10, 10))])
 
+    def test_from_surface__32bit_per_pixel(self):
+        """Ensures from_surface and from_threshold set the same bits as
+        testing each pixel of 32 bit surfaces, over several mask words.
+        """
+        random.seed(7)
+        size = (150, 3)
+        color = (100, 50, 200, 255)
+        threshold = (10, 20, 30, 255)
+        surface = pygame.Surface(size, SRCALPHA, 32)
+        key_surface = pygame.Surface(size, 0, 32)
+        key_surface.set_colorkey(color)
+
+        for pos in ((x, y) for x in range(size[0]) for y in range(size[1])):
+            pixel = [c + random.randint(-40, 40) for c in color[:3]]
+            pixel = [min(max(c, 0), 255) for c in pixel]
+            surface.set_at(pos, pixel + [random.randrange(256)])
+            key_surface.set_at(pos, color if random.random() < 0.5 else pixel)
+
+        alpha_mask = pygame.mask.from_surface(surface, 99)
+        key_mask = pygame.mask.from_surface(key_surface)
+        threshold_mask = pygame.mask.from_threshold(surface, color, threshold)
+
+        for pos in ((x, y) for x in range(size[0]) for y in range(size[1])):
+            pixel = surface.get_at(pos)
+            within = all(abs(pixel[i] - color[i]) < threshold[i] for i in range(3))
+
+            self.assertEqual(alpha_mask.get_at(pos), pixel.a > 99, pos)
+            self.assertEqual(
+                key_mask.get_at(pos), key_surface.get_at(pos) != color, pos
+            )
+            self.assertEqual(threshold_mask.get_at(pos), within, pos)
+
     def test_zero_size_from_surface(self):
         """Ensures from_surface can create masks from zero sized surfaces."""
         for size in ((100, 0), (0, 100), (0, 0)):
@@ -6399,6 +6761,55 @@ class MaskModuleTest(unittest.TestCase):
                 rects = mask.get_bounding_rects()
                 self.assertEqual(rects, [])
 
+    def test_collide_many(self):
+        """Ensures collide_many finds the same pairs as Mask.overlap."""
+        random.seed(3)
+        masks = []
+        positions = []
+        for size in ((5, 5), (20, 3), (1, 1), (64, 9), (0, 4), (12, 12)) * 4:
+            mask = pygame.mask.Mask(size)
+            for _ in range(size[0] * size[1] // 2):
+                mask.set_at((random.randrange(size[0]), random.randrange(size[1])))
+            masks.append(mask)
+            positions.append((random.randrange(-10, 90), random.randrange(-10, 60)))
+        others = masks[::-1]
+        other_positions = [(y, x) for x, y in positions]
+
+        expected = [
+            (i, j)
+            for i, (mask, pos) in enumerate(zip(masks, positions))
+            for j, (other, other_pos) in enumerate(zip(others, other_positions))
+            if mask.overlap(other, (other_pos[0] - pos[0], other_pos[1] - pos[1]))
+        ]
+
+        pairs = pygame.mask.collide_many(masks, positions, others, other_positions)
+
+        self.assertEqual(pairs, expected)
+        self.assertTrue(pairs)
+
+    def test_collide_many__empty(self):
+        """Ensures collide_many handles empty groups and missed masks."""
+        mask = pygame.mask.Mask((10, 10), fill=True)
+
+        self.assertEqual(pygame.mask.collide_many([], [], [mask], [(0, 0)]), [])
+        self.assertEqual(
+            pygame.mask.collide_many([mask], [(0, 0)], [mask], [(10, 0)]), []
+        )
+        self.assertEqual(
+            pygame.mask.collide_many([mask], [(0, 0)], [mask], [(9, 9)]), [(0, 0)]
+        )
+
+    def test_collide_many__invalid_args(self):
+        """Ensures collide_many rejects bad masks and positions."""
+        mask = pygame.mask.Mask((10, 10), fill=True)
+
+        with self.assertRaises(ValueError):
+            pygame.mask.collide_many([mask], [], [mask], [(0, 0)])
+        with self.assertRaises(TypeError):
+            pygame.mask.collide_many([mask], [(0, 0)], ["mask"], [(0, 0)])
+        with self.assertRaises(TypeError):
+            pygame.mask.collide_many([mask], [(0, 0)], [mask], ["ab"])
+
     def test_buffer_interface(self):
         size = (1000, 100)
         pixels_set = ((0, 1), (100, 10), (173, 90))
@@ -1,10 +1,12 @@
+import array
 import math
 import platform
+import random
 import unittest
 from collections.abc import Collection, Sequence
 
 import pygame.math
-from pygame.math import Vector2, Vector3
+from pygame.math import Affine2, Vector2, Vector2Array, Vector3, Vector3Array
 
 IS_PYPY = "PyPy" == platform.python_implementation()
 
@@ -1206,6 +1208,44 @@ class Vector2TypeTest(unittest.TestCase):
         self.assertEqual(type(other / 3), TestVector)
         self.assertEqual(type(other.elementwise() ** 3), TestVector)
 
+    @unittest.skipIf(
+        "PyPy" == platform.python_implementation(), "no free list on pypy"
+    )
+    def test_freelist(self):
+        """Deallocated Vector2s are reused by new ones."""
+        v = Vector2(1, 2)
+        del v
+        hits = pygame.math._freelist_stats()["Vector2"]["hits"]
+
+        v = Vector2(3, 4)
+
+        self.assertEqual(pygame.math._freelist_stats()["Vector2"]["hits"], hits + 1)
+        self.assertEqual(v, Vector2(3, 4))
+
+    def test_math_number_and_sequence_types(self):
+        """Ensures exact and other operand types give the same results."""
+
+        class Tuple(tuple):
+            pass
+
+        class Float(float):
+            pass
+
+        v = Vector2(1, 2)
+
+        for other in ((3, 4.5), [3, 4.5], Tuple((3, 4.5)), Vector2(3, 4.5)):
+            self.assertEqual(v + other, Vector2(4, 6.5))
+            self.assertEqual(other - v, Vector2(2, 2.5))
+        for number in (2, 2.0, Float(2), True + True):
+            self.assertEqual(v * number, Vector2(2, 4))
+            self.assertEqual(v / number, Vector2(0.5, 1))
+        with self.assertRaises(OverflowError):
+            v + (2**2000, 0)
+        with self.assertRaises(OverflowError):
+            v * 2**2000
+        with self.assertRaises(TypeError):
+            v + (1, "2")
+
 
 class Vector3TypeTest(unittest.TestCase):
     def setUp(self):
@@ -2553,5 +2593,329 @@ class Vector3TypeTest(unittest.TestCase):
         self.assertEqual(type(other.elementwise() ** 3), TestVector)
 
 
+class VectorArrayTest(unittest.TestCase):
+    def _random_vectors(self, vector_type, count=30):
+        return [
+            vector_type([random.uniform(-100, 100) for _ in range(len(vector_type()))])
+            for _ in range(count)
+        ]
+
+    def assertVectorsAlmostEqual(self, array, vectors):
+        self.assertEqual(len(array), len(vectors))
+        for vec, expected in zip(array, vectors):
+            for a, b in zip(vec, expected):
+                self.assertAlmostEqual(a, b, places=9)
+
+    def test_construction(self):
+        array = Vector2Array([Vector2(1, 2), (3, 4)])
+
+        self.assertEqual(list(array), [Vector2(1, 2), Vector2(3, 4)])
+        self.assertEqual(list(Vector3Array(2)), [Vector3()] * 2)
+        self.assertEqual(list(Vector2Array(array)), list(array))
+        self.assertEqual(len(Vector2Array()), 0)
+        with self.assertRaises(ValueError):
+            Vector2Array(-1)
+        with self.assertRaises(TypeError):
+            Vector2Array([(1, 2, 3)])
+        with self.assertRaises(TypeError):
+            Vector3Array([Vector2()])
+
+    def test_sequence(self):
+        array = Vector3Array([(1, 1, 1), (2, 2, 2)])
+
+        array.append((3, 3, 3))
+        array[0] = Vector3(4, 4, 4)
+        del array[1]
+
+        self.assertEqual(len(array), 2)
+        self.assertEqual(array[0], Vector3(4, 4, 4))
+        self.assertEqual(array[-1], Vector3(3, 3, 3))
+        self.assertEqual(array.copy()[1], Vector3(3, 3, 3))
+        with self.assertRaises(IndexError):
+            array[2]
+
+    def test_buffer(self):
+        array = Vector2Array([(1, 2), (3, 4)])
+
+        view = memoryview(array)
+        self.assertEqual(view.shape, (2, 2))
+        self.assertEqual(view.format, "d")
+        self.assertEqual(view.tolist(), [[1.0, 2.0], [3.0, 4.0]])
+
+        view[1, 0] = 50
+        self.assertEqual(array[1], Vector2(50, 4))
+        with self.assertRaises(BufferError):
+            array.append((0, 0))
+        with self.assertRaises(BufferError):
+            del array[0]
+
+        view.release()
+        array.append((0, 0))
+        self.assertEqual(len(array), 3)
+
+    def test_arithmetic(self):
+        """Ensures the array operations match the Vector ones."""
+        random.seed(7)
+        for vector_type, array_type in ((Vector2, Vector2Array), (Vector3, Vector3Array)):
+            vectors = self._random_vectors(vector_type)
+            others = self._random_vectors(vector_type)
+            one = others[0]
+            array, other_array = array_type(vectors), array_type(others)
+
+            self.assertVectorsAlmostEqual(
+                array + other_array, [v + w for v, w in zip(vectors, others)]
+            )
+            self.assertVectorsAlmostEqual(
+                array - other_array, [v - w for v, w in zip(vectors, others)]
+            )
+            self.assertVectorsAlmostEqual(array + one, [v + one for v in vectors])
+            self.assertVectorsAlmostEqual(one - array, [one - v for v in vectors])
+            self.assertVectorsAlmostEqual(array * 3, [v * 3 for v in vectors])
+            self.assertVectorsAlmostEqual(0.5 * array, [v * 0.5 for v in vectors])
+            self.assertVectorsAlmostEqual(array / 4, [v / 4 for v in vectors])
+
+            array -= other_array * 0.25
+            self.assertVectorsAlmostEqual(
+                array, [v - w * 0.25 for v, w in zip(vectors, others)]
+            )
+
+            with self.assertRaises(ValueError):
+                array + array_type(1)
+            with self.assertRaises(ZeroDivisionError):
+                array / 0
+            with self.assertRaises(TypeError):
+                array * array
+
+    def test_methods(self):
+        """Ensures the array methods match the Vector ones."""
+        random.seed(8)
+        for vector_type, array_type in ((Vector2, Vector2Array), (Vector3, Vector3Array)):
+            vectors = self._random_vectors(vector_type)
+            others = self._random_vectors(vector_type)
+            one = others[0]
+            array, other_array = array_type(vectors), array_type(others)
+
+            for a, b in zip(array.dot(other_array), [v.dot(w) for v, w in zip(vectors, others)]):
+                self.assertAlmostEqual(a, b, places=7)
+            for a, b in zip(array.distance_to(one), [v.distance_to(one) for v in vectors]):
+                self.assertAlmostEqual(a, b, places=9)
+            self.assertVectorsAlmostEqual(
+                array.lerp(other_array, 0.3), [v.lerp(w, 0.3) for v, w in zip(vectors, others)]
+            )
+            with self.assertRaises(ValueError):
+                array.lerp(one, 2)
+
+            clamped = array.copy()
+            clamped.clamp_magnitude_ip(20, 80)
+            self.assertVectorsAlmostEqual(clamped, [v.clamp_magnitude(20, 80) for v in vectors])
+
+            array.normalize_ip()
+            self.assertVectorsAlmostEqual(array, [v.normalize() for v in vectors])
+
+            if vector_type is Vector2:
+                array.rotate_ip(33)
+                expected = [v.normalize().rotate(33) for v in vectors]
+            else:
+                array.rotate_ip(33, (1, 2, 3))
+                expected = [v.normalize().rotate(33, (1, 2, 3)) for v in vectors]
+            self.assertVectorsAlmostEqual(array, expected)
+
+    def test_normalize_ip_zero(self):
+        array = Vector2Array([(3, 4), (0, 0)])
+
+        with self.assertRaises(ValueError):
+            array.normalize_ip()
+        self.assertEqual(array[0], Vector2(3, 4))
+
+        array.clamp_magnitude_ip(1)
+        self.assertEqual(list(array), [Vector2(0.6, 0.8), Vector2(0, 0)])
+
+    def test_rotate_ip_right_angles(self):
+        array = Vector2Array([(1, 2)])
+
+        array.rotate_ip(90)
+        self.assertEqual(array[0], Vector2(-2, 1))
+
+
+
+class Affine2Test(unittest.TestCase):
+    def assertMatricesAlmostEqual(self, a, b):
+        for x, y in zip(a, b):
+            self.assertAlmostEqual(x, y)
+
+    def test_construction(self):
+        self.assertEqual(list(Affine2()), [1, 0, 0, 0, 1, 0])
+        self.assertEqual(Affine2(), Affine2.identity())
+        self.assertEqual(Affine2([1, 2, 3, 4, 5, 6]), Affine2(1, 2, 3, 4, 5, 6))
+        self.assertEqual(len(Affine2()), 6)
+        self.assertEqual(Affine2(1, 2, 3, 4, 5, 6)[5], 6)
+        self.assertNotEqual(Affine2(), Affine2.translation(1, 0))
+
+        self.assertRaises(TypeError, Affine2, 1, 2, 3)
+        self.assertRaises(ValueError, Affine2, [1, 2, 3])
+        self.assertRaises(TypeError, hash, Affine2())
+
+    def test_named_constructors(self):
+        self.assertEqual(Affine2.translation(3, 4) @ Vector2(1, 1), Vector2(4, 5))
+        self.assertEqual(Affine2.translation((3, 4)), Affine2.translation(3, 4))
+        self.assertEqual(Affine2.scale(2) @ Vector2(1, 3), Vector2(2, 6))
+        self.assertEqual(Affine2.scale(2, 3) @ (1, 1), Vector2(2, 3))
+        self.assertEqual(Affine2.shear(1, 0) @ (0, 1), Vector2(1, 1))
+        # right angles are exact, like Vector2.rotate
+        self.assertEqual(Affine2.rotation(90) @ (1, 2), Vector2(-2, 1))
+        self.assertEqual(list(Affine2.rotation(180)), [-1, 0, 0, 0, -1, 0])
+
+        v = Vector2(3, 1)
+        self.assertAlmostEqual((Affine2.rotation(33) @ v).x, v.rotate(33).x)
+        self.assertAlmostEqual((Affine2.rotation(33) @ v).y, v.rotate(33).y)
+
+    def test_compose(self):
+        move = Affine2.translation(10, 0)
+        turn = Affine2.rotation(90)
+        v = Vector2(1, 0)
+
+        # the right hand matrix is applied first
+        self.assertEqual((move @ turn) @ v, move @ (turn @ v))
+        self.assertEqual((move @ turn) @ v, Vector2(10, 1))
+        self.assertEqual((turn @ move) @ v, Vector2(0, 11))
+
+    def test_inverse(self):
+        m = Affine2.translation(5, -2) @ Affine2.rotation(30) @ Affine2.scale(2, 3)
+        self.assertMatricesAlmostEqual(m @ m.inverse(), Affine2())
+        self.assertMatricesAlmostEqual(m.inverse() @ m, Affine2())
+        self.assertEqual(Affine2.rotation(90).inverse(), Affine2.rotation(-90))
+
+        self.assertRaises(ValueError, Affine2.scale(0, 1).inverse)
+
+    def test_transform_points(self):
+        m = Affine2.translation(1, 2) @ Affine2.rotation(45)
+        points = [(random.uniform(-9, 9), random.uniform(-9, 9)) for _ in range(20)]
+
+        result = m.transform_points(points)
+        self.assertIsInstance(result, Vector2Array)
+        for got, point in zip(result, points):
+            expected = m @ point
+            self.assertAlmostEqual(got.x, expected.x)
+            self.assertAlmostEqual(got.y, expected.y)
+
+        array = Vector2Array(points)
+        self.assertEqual(list(m @ array), list(result))
+        # the argument is left as it was
+        self.assertEqual(list(array), [Vector2(p) for p in points])
+
+    def test_pickle(self):
+        import pickle
+
+        m = Affine2(1, 2, 3, 4, 5, 6)
+        self.assertEqual(pickle.loads(pickle.dumps(m)), m)
+
+
+class NoiseTest(unittest.TestCase):
+    def _grid(self, width, height, typecode="f"):
+        """a zeroed array and a writable (width, height) view of it"""
+        items = array.array(typecode, [0]) * (width * height)
+        view = memoryview(items).cast("B").cast(typecode, (width, height))
+        return items, view
+
+    def test_noise2d(self):
+        items, grid = self._grid(40, 30)
+        pygame.math.noise2d(grid, 8.0, octaves=3)
+
+        self.assertTrue(all(-1.0 <= v <= 1.0 for v in items))
+        self.assertGreater(max(items) - min(items), 0.5)
+        # neighbours are close, as the noise is smooth
+        for x in range(39):
+            self.assertLess(abs(grid[x, 5] - grid[x + 1, 5]), 0.5)
+
+    def test_noise2d__repeatable(self):
+        first, grid1 = self._grid(16, 16)
+        second, grid2 = self._grid(16, 16)
+        other, grid3 = self._grid(16, 16)
+
+        pygame.math.noise2d(grid1, 5.5, (3, -7), 2, seed=42)
+        pygame.math.noise2d(grid2, 5.5, (3, -7), 2, seed=42)
+        pygame.math.noise2d(grid3, 5.5, (3, -7), 2, seed=43)
+
+        self.assertEqual(first, second)
+        self.assertNotEqual(first, other)
+
+    def test_noise2d__offset(self):
+        """the offset scrolls the noise by whole elements"""
+        whole, grid = self._grid(30, 20, "d")
+        part, subgrid = self._grid(10, 8, "d")
+
+        pygame.math.noise2d(grid, 6.0, (-4, 2), octaves=2)
+        pygame.math.noise2d(subgrid, 6.0, (1, 5), octaves=2)
+
+        for x in range(10):
+            for y in range(8):
+                self.assertAlmostEqual(subgrid[x, y], grid[x + 5, y + 3], 5)
+
+    def test_noise2d__bytes(self):
+        values, grid = self._grid(20, 12, "d")
+        levels = bytearray(20 * 12)
+
+        pygame.math.noise2d(grid, 4.0, seed=7)
+        pygame.math.noise2d(memoryview(levels).cast("B", (20, 12)), 4.0, seed=7)
+
+        for value, level in zip(values, levels):
+            self.assertLessEqual(abs((value + 1.0) * 127.5 - level), 1.0)
+
+    def test_noise2d__surface_channel(self):
+        surface = pygame.Surface((24, 16), 0, 32)
+        surface.fill((10, 20, 30))
+        levels = bytearray(24 * 16)
+
+        view = surface.get_view("G")
+        pygame.math.noise2d(view, 6.0, seed=5)
+        del view
+        pygame.math.noise2d(memoryview(levels).cast("B", (24, 16)), 6.0, seed=5)
+
+        for x in range(24):
+            for y in range(16):
+                color = surface.get_at((x, y))
+                self.assertEqual(color[1], levels[x * 16 + y])
+                self.assertEqual((color[0], color[2]), (10, 30))
+
+    def test_noise2d__large(self):
+        """grids split between threads match the same rows filled alone"""
+        whole, grid = self._grid(300, 300)
+        row, rowgrid = self._grid(300, 1)
+
+        pygame.math.noise2d(grid, 17.0, (2.5, 0), octaves=4)
+        pygame.math.noise2d(rowgrid, 17.0, (2.5, 250), octaves=4)
+
+        for x in range(300):
+            self.assertEqual(rowgrid[x, 0], grid[x, 250])
+
+    def test_noise3d(self):
+        items, grid = self._grid(32, 24)
+        later, grid2 = self._grid(32, 24)
+
+        pygame.math.noise3d(grid, 10.0, 3.0, octaves=2)
+        pygame.math.noise3d(grid2, 10.0, 3.25, octaves=2)
+
+        self.assertTrue(all(-1.1 <= v <= 1.1 for v in items))
+        self.assertNotEqual(items, later)
+        # the slices change smoothly along z
+        for a, b in zip(items, later):
+            self.assertLess(abs(a - b), 0.2)
+
+    def test_noise__invalid(self):
+        items, grid = self._grid(4, 4)
+
+        self.assertRaises(ValueError, pygame.math.noise2d, grid, 0.0)
+        self.assertRaises(ValueError, pygame.math.noise2d, grid, 1.0, octaves=0)
+        self.assertRaises(ValueError, pygame.math.noise3d, grid, 1.0, 0, octaves=17)
+        self.assertRaises(ValueError, pygame.math.noise2d, array.array("i", [0]), 1)
+        self.assertRaises(ValueError, pygame.math.noise2d, array.array("f", [0]), 1)
+        self.assertRaises(
+            (BufferError, TypeError),
+            pygame.math.noise2d,
+            memoryview(bytes(16)).cast("B", (4, 4)),
+            1.0,
+        )
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -160,6 +160,30 @@ class MixerMusicModuleTest(unittest.TestCase):
         pygame.mixer.music.queue(wav_file, "")
         pygame.mixer.music.queue(wav_file, "", 2)
 
+    def test_queue__append(self):
+        """Ensures queue() with append builds a playlist."""
+        ogg_file = example_path(os.path.join("data", "house_lo.ogg"))
+        wav_file = example_path(os.path.join("data", "house_lo.wav"))
+
+        pygame.mixer.music.queue(ogg_file)
+        pygame.mixer.music.queue(wav_file, append=True, fade_ms=100)
+        self.assertEqual(pygame.mixer.music.get_queued(), 2)
+
+        pygame.mixer.music.queue(wav_file)
+        self.assertEqual(pygame.mixer.music.get_queued(), 1)
+
+        pygame.mixer.music.stop()
+        self.assertEqual(pygame.mixer.music.get_queued(), 0)
+
+    def test_queue__no_wait(self):
+        """Ensures queue() can open the file in the background."""
+        wav_file = example_path(os.path.join("data", "house_lo.wav"))
+
+        pygame.mixer.music.queue(wav_file, append=True, wait=False)
+        pygame.mixer.music.queue(wav_file, append=True, wait=False)
+
+        self.assertEqual(pygame.mixer.music.get_queued(), 2)
+
     def test_queue__no_file(self):
         """Ensures queue() correctly handles missing the file argument."""
         with self.assertRaises(TypeError):
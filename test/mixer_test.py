@@ -3,6 +3,7 @@ import os
 import unittest
 import pathlib
 import platform
+import time
 
 from pygame.tests.test_utils import example_path, AssertRaisesRegexMixin
 
@@ -227,6 +228,60 @@ class MixerModuleTest(unittest.TestCase):
         os.environ.get("SDL_AUDIODRIVER") == "disk",
         "this test fails without real sound card",
     )
+    def test_sound_buffer_copy_false(self):
+        """Ensure a Sound made with copy=False plays the buffer in place."""
+        mixer.init(22050, -16, 1, allowedchanges=0)
+        try:
+            samples = bytearray(b"\x00\x01" * 20)
+            snd = mixer.Sound(buffer=samples, copy=False)
+            samples[:2] = b"\x7f\x7f"
+
+            self.assertEqual(snd.get_raw(), bytes(samples))
+            self.assertFalse(memoryview(snd).readonly)
+
+            # the samples of an immutable object can't be written through it
+            snd = mixer.Sound(buffer=bytes(samples), copy=False)
+
+            self.assertEqual(snd.get_raw(), bytes(samples))
+            self.assertTrue(memoryview(snd).readonly)
+
+            # copying is the default
+            snd = mixer.Sound(buffer=samples, copy=True)
+            samples[:2] = b"\x00\x00"
+
+            self.assertEqual(snd.get_raw()[:2], b"\x7f\x7f")
+        finally:
+            mixer.quit()
+
+    def test_array_keyword_copy_false(self):
+        """Ensure copy=False wraps arrays only when in the mixer format."""
+        try:
+            from numpy import arange, int16, int32, zeros
+        except ImportError:
+            self.skipTest("requires numpy")
+
+        mixer.init(22050, -16, 2, allowedchanges=0)
+        try:
+            a = zeros((256, 2), int16)
+            a[:, 0] = arange(256)
+            snd = mixer.Sound(array=a, copy=False)
+            a[0, 0] = 1000
+
+            self.assertEqual(snd.get_raw(), a.tobytes())
+
+            with self.assertRaises(ValueError):
+                mixer.Sound(array=a.astype(int32), copy=False)
+            with self.assertRaises(ValueError):
+                mixer.Sound(array=a[::2], copy=False)
+            with self.assertRaises(ValueError):
+                mixer.Sound(array=a[:, 0], copy=False)
+
+            # a copy converts the samples
+            snd = mixer.Sound(array=a.astype(int32))
+            self.assertEqual(snd.get_raw(), a.tobytes())
+        finally:
+            mixer.quit()
+
     def test_array_keyword(self):
         try:
             from numpy import (
@@ -651,6 +706,128 @@ class MixerModuleTest(unittest.TestCase):
 
         self.assertTupleEqual(linked_version, complied_version)
 
+    def test_get_sample_clock(self):
+        """Ensure the sample clock counts up as the mixer runs."""
+        mixer.init()
+        start = mixer.get_sample_clock()
+
+        deadline = time.time() + 2
+        while mixer.get_sample_clock() == start and time.time() < deadline:
+            time.sleep(0.01)
+
+        self.assertGreater(mixer.get_sample_clock(), start)
+
+    def test_get_sample_clock__before_init(self):
+        """Ensure exception for get_sample_clock with non-init mixer."""
+        with self.assertRaisesRegex(pygame.error, "mixer not initialized"):
+            mixer.get_sample_clock()
+
+    def test_set_num_voices(self):
+        """Ensure the voice pool takes the size it is given."""
+        mixer.init()
+        self.assertEqual(mixer.get_num_voices(), 0)
+
+        mixer.set_num_voices(16)
+        self.assertEqual(mixer.get_num_voices(), 16)
+        self.assertEqual(mixer.get_voice_stats()["voices"], 16)
+
+        mixer.set_num_voices(0)
+        self.assertEqual(mixer.get_num_voices(), 0)
+
+        with self.assertRaises(ValueError):
+            mixer.set_num_voices(-1)
+
+    def test_play_voice(self):
+        """Ensure play_voice steals the oldest voice of the lowest priority."""
+        mixer.init()
+        mixer.set_num_voices(2)
+        sound = mixer.Sound(buffer=bytes(4096))
+
+        self.assertEqual(mixer.play_voice(sound, loops=-1), 0)
+        self.assertEqual(mixer.play_voice(sound, priority=1, loops=-1), 1)
+        self.assertEqual(mixer.play_voice(sound, loops=-1), 0)
+        self.assertEqual(mixer.play_voice(sound, priority=-1), -1)
+
+        stats = mixer.get_voice_stats()
+        self.assertEqual(stats["active"], 2)
+        self.assertEqual(stats["peak"], 2)
+        self.assertEqual(stats["started"], 3)
+        self.assertEqual(stats["stolen"], 1)
+        self.assertEqual(stats["rejected"], 1)
+
+        mixer.stop_voices()
+        self.assertEqual(mixer.get_voice_stats()["active"], 0)
+
+    def test_play_voice__no_voices(self):
+        """Ensure play_voice returns -1 without a voice pool."""
+        mixer.init()
+        sound = mixer.Sound(buffer=bytes(4096))
+
+        self.assertEqual(mixer.play_voice(sound), -1)
+
+    def test_get_voice_stats__before_init(self):
+        """Ensure exception for get_voice_stats with non-init mixer."""
+        with self.assertRaisesRegex(pygame.error, "mixer not initialized"):
+            mixer.get_voice_stats()
+
+    def test_load_async(self):
+        """Ensure load_async loads the same Sound as Sound() does."""
+        mixer.init()
+        filename = example_path(os.path.join("data", "house_lo.wav"))
+
+        load = mixer.load_async(filename)
+
+        self.assertIsInstance(load, mixer.SoundLoad)
+        sound = load.result()
+        self.assertTrue(load.done())
+        self.assertIsInstance(sound, mixer.Sound)
+        self.assertIs(load.result(timeout=0), sound)
+        self.assertEqual(sound.get_raw(), mixer.Sound(filename).get_raw())
+
+    def test_load_async__invalid_file(self):
+        """Ensure result raises the error of a failed load."""
+        mixer.init()
+
+        load = mixer.load_async(example_path(os.path.join("data", "city.png")))
+
+        with self.assertRaises(pygame.error):
+            load.result()
+        self.assertTrue(load.done())
+
+    def test_load_async__event(self):
+        """Ensure the event is posted once the load finishes."""
+        pygame.display.init()
+        mixer.init()
+        event_type = pygame.event.custom_type()
+        try:
+            load = mixer.load_async(
+                example_path(os.path.join("data", "punch.wav")), event_type
+            )
+            load.result()
+            events = pygame.event.get(event_type)
+
+            self.assertEqual(len(events), 1)
+            self.assertIs(events[0].load, load)
+        finally:
+            pygame.display.quit()
+
+    def test_load_async__quit(self):
+        """Ensure quit waits for the pending loads."""
+        mixer.init()
+        loads = [
+            mixer.load_async(example_path(os.path.join("data", "house_lo.wav")))
+            for _ in range(4)
+        ]
+
+        mixer.quit()
+
+        self.assertTrue(all(load.done() for load in loads))
+
+    def test_load_async__before_init(self):
+        """Ensure exception for load_async with non-init mixer."""
+        with self.assertRaisesRegex(pygame.error, "mixer not initialized"):
+            mixer.load_async(example_path(os.path.join("data", "punch.wav")))
+
 
 ############################## CHANNEL CLASS TESTS #############################
 
@@ -717,6 +894,87 @@ class ChannelTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
 
         self.assertEqual(busy, expected_busy)
 
+    def test_set_filter(self):
+        """Ensure a filter can be set and removed."""
+        channel = mixer.Channel(0)
+        sound = mixer.Sound(example_path(os.path.join("data", "house_lo.wav")))
+
+        channel.set_filter("lowpass", 500)
+        channel.play(sound)
+        try:
+            self.assertTrue(channel.get_busy())
+            channel.set_filter("highpass", frequency=2000, q=2.0)
+            channel.set_filter("bandpass", 1000)
+            channel.set_filter(None)
+        finally:
+            channel.stop()
+
+    def test_set_filter__invalid_args(self):
+        """Ensure exception for invalid filter arguments."""
+        channel = mixer.Channel(0)
+        frequency = mixer.get_init()[0]
+
+        with self.assertRaises(ValueError):
+            channel.set_filter("notch")
+        with self.assertRaises(ValueError):
+            channel.set_filter("lowpass", 0)
+        with self.assertRaises(ValueError):
+            channel.set_filter("lowpass", frequency / 2)
+        with self.assertRaises(ValueError):
+            channel.set_filter("lowpass", 1000, q=0)
+
+    def test_set_reverb(self):
+        """Ensure a reverb can be set and removed."""
+        channel = mixer.Channel(0)
+        sound = mixer.Sound(example_path(os.path.join("data", "house_lo.wav")))
+
+        channel.set_reverb(0.5)
+        channel.play(sound)
+        try:
+            self.assertTrue(channel.get_busy())
+            channel.set_reverb(1.0, room_size=1.0, damping=0.0)
+            channel.set_reverb(0)
+        finally:
+            channel.stop()
+
+    def test_set_reverb__invalid_args(self):
+        """Ensure exception for reverb arguments out of range."""
+        channel = mixer.Channel(0)
+
+        for kwargs in ({"wet": -0.1}, {"wet": 1.1}, {"wet": 0.5, "room_size": 2}):
+            with self.assertRaises(ValueError):
+                channel.set_reverb(**kwargs)
+        with self.assertRaises(ValueError):
+            channel.set_reverb(0.5, damping=-1)
+
+    def test_play_at(self):
+        """Ensure play_at starts the Sound once the sample clock gets there."""
+        channel = mixer.Channel(0)
+        sound = mixer.Sound(example_path(os.path.join("data", "house_lo.wav")))
+
+        channel.play_at(sound, mixer.get_sample_clock() + 10**9)
+        self.assertFalse(channel.get_busy())
+        channel.stop()
+
+        channel.play_at(sound, mixer.get_sample_clock())
+        try:
+            deadline = time.time() + 2
+            while not channel.get_busy() and time.time() < deadline:
+                time.sleep(0.01)
+
+            self.assertTrue(channel.get_busy())
+            self.assertIs(channel.get_sound(), sound)
+        finally:
+            channel.stop()
+
+    def test_play_at__invalid_time(self):
+        """Ensure exception for a negative time."""
+        channel = mixer.Channel(0)
+        sound = mixer.Sound(buffer=bytes(64))
+
+        with self.assertRaises(ValueError):
+            channel.play_at(sound, -1)
+
     def todo_test_get_busy__active(self):
         """Ensure an active channel's busy state is correct."""
         self.fail()
@@ -1184,6 +1442,164 @@ class SoundTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
                 snd.get_raw()
 
 
+############################## STREAM CLASS TESTS ##############################
+
+
+class StreamTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
+    @classmethod
+    def tearDownClass(cls):
+        mixer.quit()
+
+    def setUp(cls):
+        # This makes sure the mixer is always initialized before each test (in
+        # case a test calls pygame.mixer.quit()).
+        if mixer.get_init() is None:
+            mixer.init()
+
+    def _frame_size(self):
+        _, size, channels = mixer.get_init()
+        return abs(size) // 8 * channels
+
+    def test_stream(self):
+        """Ensure Stream() creation works."""
+        stream = mixer.Stream()
+
+        self.assertIsInstance(stream, mixer.Stream)
+        self.assertEqual(stream.get_queued(), 0)
+        self.assertGreater(stream.get_free(), 0)
+        self.assertEqual(stream.get_underruns(), 0)
+
+    def test_stream__size(self):
+        """Ensure the Stream holds at least size frames."""
+        frame_size = self._frame_size()
+        stream = mixer.Stream(1000)
+
+        self.assertGreaterEqual(stream.get_free(), 1000 * frame_size)
+        self.assertEqual(stream.get_free() % frame_size, 0)
+
+        with self.assertRaises(ValueError):
+            mixer.Stream(-1)
+
+    def test_stream__before_init(self):
+        """Ensure exception for Stream() creation with non-init mixer."""
+        mixer.quit()
+
+        with self.assertRaisesRegex(pygame.error, "mixer not initialized"):
+            mixer.Stream()
+
+    def test_write(self):
+        """Ensure write queues whole frames, as many as there is room for."""
+        frame_size = self._frame_size()
+        stream = mixer.Stream(100)
+        free = stream.get_free()
+
+        self.assertEqual(stream.write(bytes(frame_size * 3 + 1)), frame_size * 3)
+        self.assertEqual(stream.get_queued(), frame_size * 3)
+        self.assertEqual(stream.get_free(), free - frame_size * 3)
+
+        self.assertEqual(stream.write(bytearray(free)), free - frame_size * 3)
+        self.assertEqual(stream.get_free(), 0)
+        self.assertEqual(stream.write(bytes(frame_size)), 0)
+        self.assertEqual(stream.get_queued(), free)
+
+    def test_write__invalid_buffer(self):
+        """Ensure exception for writing an object without the buffer API."""
+        stream = mixer.Stream()
+
+        with self.assertRaises(TypeError):
+            stream.write([0, 0, 0, 0])
+
+    def test_advance(self):
+        """Ensure samples written through the buffer are queued by advance."""
+        frame_size = self._frame_size()
+        stream = mixer.Stream(100)
+        free = stream.get_free()
+
+        view = memoryview(stream)
+        self.assertFalse(view.readonly)
+        self.assertEqual(view.nbytes, free)
+        self.assertEqual(view.shape[0] * frame_size, free)
+        view.release()
+
+        stream.advance(3)
+        self.assertEqual(stream.get_queued(), frame_size * 3)
+
+        with memoryview(stream) as view:
+            self.assertEqual(view.nbytes, free - frame_size * 3)
+
+        with self.assertRaises(ValueError):
+            stream.advance(free // frame_size)
+        with self.assertRaises(ValueError):
+            stream.advance(-1)
+
+    def test_play(self):
+        """Ensure play starts the Stream on a Channel, and stop ends it."""
+        stream = mixer.Stream()
+        stream.write(bytes(stream.get_free()))
+
+        channel = stream.play()
+
+        try:
+            self.assertIsInstance(channel, mixer.Channel)
+            self.assertTrue(stream.get_busy())
+            self.assertTrue(channel.get_busy())
+            self.assertIsNone(channel.get_sound())
+
+            # playing again keeps the Channel it has
+            channels = [mixer.Channel(i) for i in range(mixer.get_num_channels())]
+            busy = [c.get_busy() for c in channels]
+            stream.play()
+            self.assertEqual([c.get_busy() for c in channels], busy)
+        finally:
+            stream.stop()
+
+        self.assertFalse(stream.get_busy())
+
+    def test_stream__file(self):
+        """Ensure a Stream can be fed from a WAV file."""
+        stream = mixer.Stream(file=example_path("data/house_lo.wav"), loops=-1)
+
+        with self.assertRaises(RuntimeError):
+            stream.write(bytes(self._frame_size()))
+
+        channel = stream.play()
+
+        try:
+            self.assertIsInstance(channel, mixer.Channel)
+            self.assertTrue(stream.get_busy())
+            self.assertGreater(stream.get_queued(), 0)
+        finally:
+            stream.stop()
+
+        self.assertFalse(stream.get_busy())
+        self.assertEqual(stream.get_queued(), 0)
+
+    def test_stream__file_object(self):
+        """Ensure a Stream can be fed from a file object."""
+        with open(example_path("data/punch.wav"), "rb") as f:
+            stream = mixer.Stream(file=f)
+
+            stream.play()
+            stream.stop()
+            del stream
+
+    def test_stream__invalid_file(self):
+        """Ensure exception for a file that cannot be streamed."""
+        # ADPCM encoded
+        with self.assertRaises(pygame.error):
+            mixer.Stream(file=example_path("data/secosmic_lo.wav"))
+
+        with self.assertRaises(pygame.error):
+            mixer.Stream(file=example_path("data/house_lo.ogg"))
+
+    def test_reset_underruns(self):
+        """Ensure reset_underruns sets the count back to zero."""
+        stream = mixer.Stream()
+        stream.reset_underruns()
+
+        self.assertEqual(stream.get_underruns(), 0)
+
+
 ##################################### MAIN #####################################
 
 if __name__ == "__main__":
@@ -300,6 +300,25 @@ class MouseModuleTest(MouseTests):
         for value in pos:
             self.assertIsInstance(value, int)
 
+    def test_get_state_into(self):
+        """Ensures get_state_into writes the position and buttons."""
+        import array
+
+        state = array.array("i", [-1] * 4)
+        pygame.mouse.get_state_into(state)
+        pygame.mouse.get_state_into(state)
+
+        pressed = pygame.mouse.get_pressed(num_buttons=5)
+        buttons = sum(1 << i for i, held in enumerate(pressed) if held)
+        self.assertEqual(tuple(state[:2]), pygame.mouse.get_pos())
+        self.assertEqual(state[2], buttons)
+        self.assertEqual(state[3], 0)
+
+        with self.assertRaises(ValueError):
+            pygame.mouse.get_state_into(bytearray(15))
+        with self.assertRaises(TypeError):
+            pygame.mouse.get_state_into(bytes(16))
+
     def test_set_pos__invalid_pos(self):
         """Ensures set_pos handles invalid positions correctly."""
         for invalid_pos in ((1,), [1, 2, 3], 1, "1", (1, "1"), []):
@@ -0,0 +1,185 @@
+import unittest
+
+import pygame
+from pygame.particles import ParticleSystem
+
+
+class ParticleSystemTest(unittest.TestCase):
+    def _surface(self, color=(0, 0, 0, 255)):
+        surface = pygame.Surface((10, 10), pygame.SRCALPHA, 32)
+        surface.fill(color)
+        return surface
+
+    def test_construction(self):
+        system = ParticleSystem(100, gravity=(0, 9.5), drag=0.5, size=3)
+
+        self.assertEqual(system.capacity, 100)
+        self.assertEqual(len(system), 0)
+        self.assertEqual(system.gravity, (0.0, 9.5))
+        self.assertEqual(system.drag, 0.5)
+        self.assertEqual(system.size, 3)
+        self.assertIsNone(system.image)
+        self.assertFalse(system.additive)
+        self.assertTrue(system.fade)
+
+    def test_construction__invalid(self):
+        self.assertRaises(ValueError, ParticleSystem, -1)
+        self.assertRaises(ValueError, ParticleSystem, 10, drag=-1.0)
+        self.assertRaises(ValueError, ParticleSystem, 10, size=0)
+        self.assertRaises(TypeError, ParticleSystem, 10, gravity="down")
+        self.assertRaises(TypeError, ParticleSystem, 10, image=(1, 1))
+
+    def test_attributes__invalid(self):
+        system = ParticleSystem(10)
+
+        with self.assertRaises(AttributeError):
+            system.capacity = 20
+        with self.assertRaises(ValueError):
+            system.drag = -0.1
+        with self.assertRaises(ValueError):
+            system.size = 0
+        with self.assertRaises(TypeError):
+            system.image = "spark.png"
+
+    def test_emit(self):
+        system = ParticleSystem(10)
+
+        self.assertEqual(system.emit((0, 0), 4), 4)
+        self.assertEqual(system.emit((0, 0), 10), 6)
+        self.assertEqual(system.emit((0, 0)), 0)
+        self.assertEqual(len(system), 10)
+
+    def test_emit__invalid(self):
+        system = ParticleSystem(10)
+
+        self.assertRaises(TypeError, system.emit, "here")
+        self.assertRaises(ValueError, system.emit, (0, 0), -1)
+        self.assertRaises(ValueError, system.emit, (0, 0), life=0)
+        self.assertRaises(ValueError, system.emit, (0, 0), color="no such colour")
+
+    def test_update__life(self):
+        system = ParticleSystem(10)
+        system.emit((0, 0), 3, life=1.0)
+        system.emit((0, 0), 2, life=2.0)
+
+        system.update(0.75)
+        self.assertEqual(len(system), 5)
+        system.update(0.5)
+        self.assertEqual(len(system), 2)
+        system.update(1.0)
+        self.assertEqual(len(system), 0)
+
+    def test_update__motion(self):
+        """velocity, gravity and drag move the drawn particle"""
+        for gravity, drag, expected in (
+            ((0, 0), 0.0, (6, 2)),
+            ((0, 4), 0.0, (6, 6)),
+            ((0, 0), 0.5, (4, 2)),
+        ):
+            system = ParticleSystem(1, gravity=gravity, drag=drag, fade=False)
+            system.emit((2.5, 2.5), velocity=(4, 0), color=(255, 0, 0))
+            system.update(1.0)
+            surface = self._surface()
+            system.draw(surface)
+
+            self.assertEqual(surface.get_at(expected), (255, 0, 0, 255), gravity)
+
+    def test_draw__points(self):
+        system = ParticleSystem(10, size=3, fade=False)
+        system.emit((4.5, 4.5), color=(0, 255, 0))
+        surface = self._surface()
+
+        system.draw(surface, (1, 0))
+
+        for y in range(10):
+            for x in range(10):
+                inside = 4 <= x <= 6 and 3 <= y <= 5
+                expected = (0, 255, 0, 255) if inside else (0, 0, 0, 255)
+                self.assertEqual(surface.get_at((x, y)), expected, (x, y))
+
+    def test_draw__clipped(self):
+        system = ParticleSystem(10, size=4, fade=False)
+        system.emit((0, 0), color=(0, 0, 255))
+        system.emit((50, 50), color=(0, 0, 255))
+        surface = self._surface()
+        surface.set_clip((1, 1, 8, 8))
+
+        system.draw(surface)
+
+        self.assertEqual(surface.get_at((0, 0)), (0, 0, 0, 255))
+        self.assertEqual(surface.get_at((1, 1)), (0, 0, 255, 255))
+        self.assertEqual(surface.get_at((2, 2)), (0, 0, 0, 255))
+
+    def test_draw__additive(self):
+        system = ParticleSystem(10, additive=True, fade=False)
+        system.emit((1.5, 1.5), 2, color=(100, 50, 0))
+        surface = self._surface((100, 0, 0, 255))
+
+        system.draw(surface)
+
+        self.assertEqual(surface.get_at((1, 1)), (255, 100, 0, 255))
+        self.assertEqual(surface.get_at((0, 0)), (100, 0, 0, 255))
+
+    def test_draw__fade(self):
+        system = ParticleSystem(10)
+        system.emit((1.5, 1.5), color=(255, 255, 255))
+        system.update(0.5)
+        surface = self._surface()
+
+        system.draw(surface)
+
+        red = surface.get_at((1, 1)).r
+        self.assertTrue(120 <= red <= 135, red)
+
+    def test_draw__image(self):
+        image = pygame.Surface((2, 2))
+        image.fill((255, 0, 255))
+        system = ParticleSystem(10, image=image, fade=False)
+        system.emit((5, 5))
+        surface = self._surface()
+
+        system.draw(surface)
+
+        self.assertEqual(surface.get_at((4, 4)), (255, 0, 255, 255))
+        self.assertEqual(surface.get_at((5, 5)), (255, 0, 255, 255))
+        self.assertEqual(surface.get_at((6, 6)), (0, 0, 0, 255))
+
+    def test_draw__image_fade(self):
+        image = pygame.Surface((2, 2))
+        image.fill((255, 255, 255))
+        system = ParticleSystem(10, image=image)
+        system.emit((5, 5))
+        system.update(0.5)
+        surface = self._surface()
+
+        system.draw(surface)
+
+        red = surface.get_at((4, 4)).r
+        self.assertTrue(120 <= red <= 135, red)
+        self.assertIsNone(image.get_alpha())
+
+    def test_seed(self):
+        """the same seed spreads particles the same way"""
+        surfaces = []
+        for _ in range(2):
+            system = ParticleSystem(50, seed=1234, fade=False)
+            system.emit((5, 5), 50, spread=(4, 4))
+            system.update(1.0)
+            surface = self._surface()
+            system.draw(surface)
+            surfaces.append(pygame.image.tostring(surface, "RGBA"))
+
+        self.assertEqual(surfaces[0], surfaces[1])
+
+    def test_clear(self):
+        system = ParticleSystem(10)
+        system.emit((0, 0), 5)
+
+        system.clear()
+
+        self.assertEqual(len(system), 0)
+        self.assertEqual(system.emit((0, 0), 20), 10)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -1030,6 +1030,53 @@ class PixelArrayTypeTest(unittest.TestCase, TestMixin):
             self.assertEqual(ar[9][9], oval)
         # print("replace end")
 
+    def test_replace__large_surface(self):
+        """Ensures replace works on arrays big enough to be split across
+        threads, with the SIMD rows and with transposed views."""
+        size = (301, 257)
+        for transposed in (False, True):
+            sf = pygame.Surface(size, 0, 32)
+            sf.fill((255, 0, 0))
+            sf.fill((250, 10, 10), (0, 100, 301, 57))
+            sf.fill((0, 0, 255), (150, 0, 3, 257))
+            ar = pygame.PixelArray(sf)
+            if transposed:
+                ar = ar.transpose()
+            ar.replace((255, 0, 0), (0, 255, 0), distance=0.1)
+            del ar
+
+            self.assertEqual(sf.get_at((0, 0)), (0, 255, 0, 255))
+            self.assertEqual(sf.get_at((300, 256)), (0, 255, 0, 255))
+            self.assertEqual(sf.get_at((299, 120)), (0, 255, 0, 255))
+            self.assertEqual(sf.get_at((151, 120)), (0, 0, 255, 255))
+            self.assertEqual(sf.get_at((152, 256)), (0, 0, 255, 255))
+
+    def test_extract_compare__large_surface(self):
+        """Ensures extract and compare agree on arrays big enough to be split
+        across threads."""
+        size = (301, 257)
+        sf = pygame.Surface(size, 0, 32)
+        sf.fill((255, 0, 0))
+        sf2 = sf.copy()
+        sf2.fill((250, 10, 10), (0, 100, 301, 57))
+        sf.fill((0, 0, 255), (150, 0, 3, 257))
+        sf2.fill((0, 0, 255), (150, 0, 3, 257))
+        ar = pygame.PixelArray(sf)
+        ar2 = pygame.PixelArray(sf2)
+
+        for distance in (0.0, 0.1):
+            extracted = ar2.extract((255, 0, 0), distance=distance)
+            compared = ar.compare(ar2, distance=distance)
+            self.assertEqual(extracted.surface.get_at((0, 0)), (255, 255, 255))
+            self.assertEqual(extracted.surface.get_at((151, 0)), (0, 0, 0))
+            self.assertEqual(compared.surface.get_at((0, 0)), (255, 255, 255))
+            self.assertEqual(compared.surface.get_at((151, 0)), (255, 255, 255))
+            near = (255, 255, 255) if distance else (0, 0, 0)
+            self.assertEqual(extracted.surface.get_at((300, 120)), near)
+            self.assertEqual(compared.surface.get_at((300, 120)), near)
+            self.assertEqual(extracted.surface.get_at((151, 120)), (0, 0, 0))
+            self.assertEqual(compared.surface.get_at((151, 120)), (255, 255, 255))
+
     def test_extract(self):
         # print("extract start")
         for bpp in (8, 16, 24, 32):
@@ -1281,6 +1328,26 @@ class PixelArrayTypeTest(unittest.TestCase, TestMixin):
             for x in range(w):
                 self.assertEqual(ar[x, y], 42)
 
+    def test_assign_sequence__every_row(self):
+        """Ensures a sequence assigned to a 2D slice sets every row, in
+        order, also for reversed and stepped slices."""
+        w, h = 37, 5
+        for bpp in [1, 2, 3, 4]:
+            sf = pygame.Surface((w, h), 0, bpp * 8)
+            values = [sf.map_rgb((i * 6, 255 - i * 6, 99)) for i in range(w)]
+            ar = pygame.PixelArray(sf)
+            ar[:, 1:4] = values
+            for y in range(1, 4):
+                self.assertEqual([ar[x, y] for x in range(w)], values)
+            ar[::-1, 1:3] = values
+            for y in range(1, 3):
+                self.assertEqual([ar[w - 1 - x, y] for x in range(w)], values)
+            ar[:, ::2] = values
+            for y in range(0, h, 2):
+                self.assertEqual([ar[x, y] for x in range(w)], values)
+            ar[:, :] = values[0]
+            self.assertEqual(ar[w - 1, h - 1], values[0])
+
     def test_assign_size_mismatch(self):
         sf = pygame.Surface((7, 11), 0, 32)
         ar = pygame.PixelArray(sf)
@@ -577,6 +577,42 @@ class PixelCopyTestWithArray(unittest.TestCase):
         source = zeros((12, w - 1, 5), uint8)
         self.assertRaises(ValueError, map_array, target, source, surf)
 
+    def test_copy__large_surface(self):
+        """Copies big enough to be split across threads, in both layouts"""
+        try:
+            from numpy import arange, empty, uint8, uint32, array_equal
+        except ImportError:
+            return
+
+        w, h = 301, 263
+        surf = pygame.Surface((w, h), 0, 32)
+        rgb = (arange(w * h * 3, dtype=uint32) * 7 % 256).astype(uint8)
+        rgb = rgb.reshape((w, h, 3))
+        for source in [rgb, rgb.transpose(1, 0, 2).copy().transpose(1, 0, 2)]:
+            array_to_surface(surf, source)
+            for posn in [(0, 0), (w - 1, 0), (150, 131), (w - 1, h - 1)]:
+                self.assertEqual(surf.get_at(posn)[:3], tuple(source[posn]))
+
+            target = empty((w, h, 3), uint8)
+            surface_to_array(target, surf)
+            self.assertTrue(array_equal(target, rgb))
+            target = empty((h, w, 3), uint8).transpose(1, 0, 2)
+            surface_to_array(target, surf)
+            self.assertTrue(array_equal(target, rgb))
+
+            for i, kind in enumerate("RGB"):
+                plane = empty((w, h), uint8)
+                surface_to_array(plane, surf, kind)
+                self.assertTrue(array_equal(plane, rgb[..., i]))
+
+        mapped = empty((w, h), uint32)
+        surface_to_array(mapped, surf)
+        surf.fill((0, 0, 0))
+        array_to_surface(surf, mapped)
+        target = empty((w, h, 3), uint8)
+        surface_to_array(target, surf)
+        self.assertTrue(array_equal(target, rgb))
+
     ## def test_array_to_surface(self):
     ##     array_to_surface gets a good workout in the surfarray module's
     ##     unit tests under the alias blit_array.
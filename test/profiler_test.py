@@ -0,0 +1,56 @@
+import unittest
+
+import pygame
+import pygame.profiler
+
+
+class ProfilerModuleTest(unittest.TestCase):
+    def setUp(self):
+        pygame.profiler.clear()
+
+    def tearDown(self):
+        pygame.profiler.clear()
+
+    def test_frames(self):
+        """Ensure the module functions share one profiler"""
+        pygame.profiler.frame_begin()
+        with pygame.profiler.span("update"):
+            pass
+        pygame.profiler.frame_end()
+
+        frames = pygame.profiler.get_frames()
+        self.assertEqual(len(frames), 1)
+        self.assertEqual(frames[0][1][0][:2], ("update", 0))
+        self.assertIs(pygame.profiler.Profiler, pygame.time.Profiler)
+
+    def test_draw(self):
+        """Ensure the graph is drawn within its rect only"""
+        profiler = pygame.time.Profiler()
+        for i in range(10):
+            profiler.frame_begin()
+            with profiler.span("update"):
+                pass
+            profiler.frame_end()
+        surf = pygame.Surface((100, 50), 0, 32)
+        surf.fill((1, 2, 3))
+
+        rect = pygame.profiler.draw(surf, (10, 10, 40, 20), profiler=profiler)
+
+        self.assertEqual(rect, pygame.Rect(10, 10, 40, 20))
+        self.assertEqual(surf.get_at((9, 9)), (1, 2, 3, 255))
+        self.assertEqual(surf.get_at((50, 30)), (1, 2, 3, 255))
+        self.assertNotEqual(surf.get_at((10, 10)), (1, 2, 3, 255))
+        # the target line runs half way up
+        self.assertEqual(surf.get_at((10, 20)), pygame.profiler.TARGET + (255,))
+
+    def test_draw__clipped(self):
+        """Ensure a rect outside the surface draws nothing"""
+        surf = pygame.Surface((20, 20), 0, 32)
+
+        rect = pygame.profiler.draw(surf, (30, 30, 10, 10))
+
+        self.assertEqual(rect.size, (0, 0))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -1,9 +1,12 @@
 import math
+import pickle
 import platform
+import random
 import unittest
 from collections.abc import Collection, Sequence
 
-from pygame import Rect, Vector2
+import pygame
+from pygame import FRect, Rect, RectArray, RectIndex, RectPacker, Vector2
 from pygame.tests import test_utils
 
 IS_PYPY = "PyPy" == platform.python_implementation()
@@ -2534,6 +2537,18 @@ class RectTypeTest(unittest.TestCase):
         self.assertTrue(isinstance(r, Collection))
         self.assertFalse(isinstance(r, Sequence))
 
+    @unittest.skipIf(IS_PYPY, "no free list on pypy")
+    def test_freelist(self):
+        """Deallocated Rects are reused by new ones."""
+        r = Rect(1, 2, 3, 4)
+        del r
+        hits = pygame.rect._freelist_stats()["hits"]
+
+        r = Rect(5, 6, 7, 8)
+
+        self.assertEqual(pygame.rect._freelist_stats()["hits"], hits + 1)
+        self.assertEqual(r, Rect(5, 6, 7, 8))
+
 
 @unittest.skipIf(IS_PYPY, "fails on pypy")
 class SubclassTest(unittest.TestCase):
@@ -2604,5 +2619,345 @@ class SubclassTest(unittest.TestCase):
         self.assertFalse(isinstance(mr1, Sequence))
 
 
+class FRectTest(unittest.TestCase):
+    def test_construction(self):
+        self.assertEqual(tuple(FRect(1.5, 2.25, 3, 4)), (1.5, 2.25, 3.0, 4.0))
+        self.assertEqual(FRect((1.5, 2), (3, 4.5)), FRect(1.5, 2, 3, 4.5))
+        self.assertEqual(FRect(Rect(1, 2, 3, 4)), FRect(1, 2, 3, 4))
+        self.assertEqual(repr(FRect(0.1, 2, 3, 4)), "<frect(0.1, 2.0, 3.0, 4.0)>")
+        with self.assertRaises(TypeError):
+            FRect("a")
+
+    def test_attributes(self):
+        r = FRect(1.5, 2.5, 3, 5)
+
+        self.assertEqual(r.center, (3.0, 5.0))
+        self.assertEqual(r.bottomright, (4.5, 7.5))
+        self.assertEqual(r.midleft, (1.5, 5.0))
+        self.assertEqual(r.centerx, 3.0)
+
+        r.center = (0, 0)
+        self.assertEqual(r, FRect(-1.5, -2.5, 3, 5))
+        r.right = 10.25
+        self.assertEqual(r.x, 7.25)
+        r.size = (0.5, 0.5)
+        self.assertEqual(r, FRect(7.25, -2.5, 0.5, 0.5))
+
+    def test_sequence(self):
+        r = FRect(1, 2, 3, 4)
+
+        r[0] = 0.5
+        r[1:3] = (1.5, 2.5)
+        self.assertEqual(r[...], [0.5, 1.5, 2.5, 4.0])
+        self.assertEqual(r[-1], 4.0)
+        self.assertIn(2.5, r)
+        with self.assertRaises(IndexError):
+            r[4]
+
+    def test_methods(self):
+        r = FRect(0.5, 0.5, 2, 2)
+
+        self.assertEqual(r.move(0.25, 0.25), FRect(0.75, 0.75, 2, 2))
+        self.assertEqual(r.inflate(1, 1), FRect(0, 0, 3, 3))
+        self.assertEqual(r.clip(0, 0, 1, 1), FRect(0.5, 0.5, 0.5, 0.5))
+        self.assertEqual(r.union(3, 3, 1, 1), FRect(0.5, 0.5, 3.5, 3.5))
+        self.assertEqual(r.clamp(1, 1, 4, 4), FRect(1, 1, 2, 2))
+        self.assertTrue(r.colliderect(2.25, 2.25, 1, 1))
+        self.assertFalse(r.colliderect(2.5, 2.5, 1, 1))
+        self.assertTrue(r.collidepoint(2.4, 0.5))
+        self.assertFalse(r.collidepoint(2.5, 0.5))
+        self.assertEqual(r.collidelistall([(0, 0, 1, 1), (3, 3, 1, 1), r]), [0, 2])
+        self.assertTrue(r.contains(1, 1, 0.5, 0.5))
+
+    def test_rect_arguments(self):
+        """FRects are taken where Rects are, truncating their fields."""
+        r = FRect(1.75, -1.75, 2.5, 2.5)
+
+        self.assertEqual(Rect(r), Rect(1, -1, 2, 2))
+        self.assertTrue(Rect(0, 0, 2, 2).colliderect(r))
+        self.assertNotEqual(Rect(1, -1, 2, 2), r)
+        self.assertEqual(Rect(1, 2, 3, 4), FRect(1, 2, 3, 4))
+
+    def test_copy_and_pickle(self):
+        r = FRect(1.5, 2, 3, 4)
+
+        self.assertEqual(r.copy(), r)
+        self.assertEqual(pickle.loads(pickle.dumps(r)), r)
+
+
+class RectArrayTest(unittest.TestCase):
+    def _random_rects(self, count=30):
+        return [
+            Rect(
+                random.randint(-100, 100),
+                random.randint(-100, 100),
+                random.randint(-10, 60),
+                random.randint(-10, 60),
+            )
+            for _ in range(count)
+        ]
+
+    def test_construction(self):
+        rects = [Rect(1, 2, 3, 4), (5, 6, 7, 8)]
+
+        self.assertEqual(list(RectArray(rects)), [Rect(1, 2, 3, 4), Rect(5, 6, 7, 8)])
+        self.assertEqual(list(RectArray(2)), [Rect(0, 0, 0, 0)] * 2)
+        self.assertEqual(len(RectArray()), 0)
+        with self.assertRaises(ValueError):
+            RectArray(-1)
+        with self.assertRaises(TypeError):
+            RectArray([(1, 2)])
+
+    def test_sequence(self):
+        array = RectArray([Rect(1, 1, 1, 1), Rect(2, 2, 2, 2)])
+
+        array.append(3, 3, 3, 3)
+        array[0] = (4, 4, 4, 4)
+        del array[1]
+
+        self.assertEqual(len(array), 2)
+        self.assertEqual(array[0], Rect(4, 4, 4, 4))
+        self.assertEqual(array[-1], Rect(3, 3, 3, 3))
+        with self.assertRaises(IndexError):
+            array[2]
+
+    def test_buffer(self):
+        array = RectArray([Rect(1, 2, 3, 4), Rect(5, 6, 7, 8)])
+
+        view = memoryview(array)
+        self.assertEqual(view.shape, (2, 4))
+        self.assertEqual(view.tolist(), [[1, 2, 3, 4], [5, 6, 7, 8]])
+
+        view[1, 0] = 50
+        self.assertEqual(array[1], Rect(50, 6, 7, 8))
+        with self.assertRaises(BufferError):
+            array.append(Rect(0, 0, 1, 1))
+        with self.assertRaises(BufferError):
+            del array[0]
+
+        view.release()
+        array.append(Rect(0, 0, 1, 1))
+        self.assertEqual(len(array), 3)
+
+    def test_geometry(self):
+        """Ensures the array operations match the Rect ones."""
+        random.seed(6)
+        for _ in range(20):
+            rects = self._random_rects()
+            array = RectArray(rects)
+            area = Rect(-20, -30, 80, 70)
+            point = (random.randint(-50, 50), random.randint(-50, 50))
+
+            self.assertEqual(
+                array.colliderect(area),
+                [i for i, r in enumerate(rects) if r.colliderect(area)],
+            )
+            self.assertEqual(
+                array.collidepoint(point),
+                [i for i, r in enumerate(rects) if r.collidepoint(point)],
+            )
+            self.assertEqual(list(array.clip(area)), [r.clip(area) for r in rects])
+            self.assertEqual(array.union(), rects[0].unionall(rects[1:]))
+
+            array.clamp_ip(area)
+            array.move_ip(3, -4)
+            self.assertEqual(list(array), [r.clamp(area).move(3, -4) for r in rects])
+
+    def test_union__empty(self):
+        with self.assertRaises(ValueError):
+            RectArray().union()
+
+    def test_merge_ip(self):
+        """Ensures merged rects don't overlap and still cover every input."""
+        random.seed(8)
+        clip = Rect(-50, -50, 120, 100)
+        for _ in range(20):
+            rects = self._random_rects()
+            array = RectArray(rects)
+            array.merge_ip(clip)
+
+            merged = list(array)
+            for i, rect in enumerate(merged):
+                self.assertTrue(rect.w > 0 and rect.h > 0)
+                self.assertTrue(clip.contains(rect))
+                self.assertEqual(rect.collidelist(merged[i + 1 :]), -1)
+            for rect in rects:
+                rect = rect.clip(clip)
+                if rect.w > 0 and rect.h > 0:
+                    self.assertNotEqual(rect.collidelist(merged), -1)
+                    self.assertTrue(any(m.contains(rect) for m in merged))
+
+    def test_merge_ip__simple(self):
+        array = RectArray([(0, 0, 10, 10), (5, 5, 10, 10), (20, 0, 5, 5), (1, 1, 0, 0)])
+        array.merge_ip()
+
+        self.assertEqual(sorted(array), [Rect(0, 0, 15, 15), Rect(20, 0, 5, 5)])
+
+class RectIndexTest(unittest.TestCase):
+    def _random_rect(self, size=100):
+        return Rect(
+            random.randint(-500, 500),
+            random.randint(-500, 500),
+            random.randint(-20, size),
+            random.randint(-20, size),
+        )
+
+    def test_construction(self):
+        rects = [Rect(0, 0, 10, 10), (20, 0, 10, 10), Rect(0, 0, 0, 0)]
+
+        index = RectIndex(rects, cell_size=8)
+
+        self.assertEqual(len(index), 3)
+        for i, rect in enumerate(rects):
+            self.assertIn(i, index)
+            self.assertEqual(index[i], Rect(rect))
+        self.assertNotIn(3, index)
+        self.assertEqual(len(RectIndex()), 0)
+
+    def test_construction__invalid(self):
+        with self.assertRaises(ValueError):
+            RectIndex(cell_size=0)
+        with self.assertRaises(TypeError):
+            RectIndex([(1, 2)])
+
+    def test_insert_remove(self):
+        index = RectIndex()
+
+        first = index.insert(0, 0, 10, 10)
+        second = index.insert(Rect(5, 5, 10, 10))
+        index.remove(first)
+
+        self.assertEqual(len(index), 1)
+        self.assertNotIn(first, index)
+        self.assertEqual(index.colliderect(6, 6, 1, 1), [second])
+        self.assertEqual(index.collidepoint(1, 1), [])
+        with self.assertRaises(KeyError):
+            index.remove(first)
+        with self.assertRaises(KeyError):
+            index[first]
+
+    def test_move(self):
+        index = RectIndex([Rect(0, 0, 10, 10)], cell_size=16)
+
+        index.move(0, Rect(2, 2, 10, 10))
+        self.assertEqual(index[0], Rect(2, 2, 10, 10))
+        self.assertEqual(index.collidepoint((11, 11)), [0])
+
+        index.move(0, Rect(500, 500, 10, 10))
+        self.assertEqual(index.collidepoint((11, 11)), [])
+        self.assertEqual(index.collidepoint((505, 505)), [0])
+        with self.assertRaises(KeyError):
+            index.move(1, Rect(0, 0, 1, 1))
+
+    def test_collisions(self):
+        """Ensures the queries find what Rect collisions find, after
+        changes, for small and large cells and rects.
+        """
+        random.seed(3)
+        for cell_size in (1, 16, 64, 500):
+            rects = {i: self._random_rect() for i in range(100)}
+            rects[100] = Rect(-2000, -2000, 4000, 4000)
+            index = RectIndex([rects[i] for i in range(101)], cell_size=cell_size)
+            for i in range(0, 100, 3):
+                index.remove(i)
+                del rects[i]
+            for i in range(1, 100, 3):
+                rects[i] = rects[i].move(random.randint(-50, 50), 30)
+                index.move(i, rects[i])
+            for _ in range(20):
+                rect = self._random_rect()
+                rects[index.insert(rect)] = rect
+
+            queries = [self._random_rect(300) for _ in range(50)]
+            for query in queries:
+                self.assertEqual(
+                    index.colliderect(query),
+                    sorted(i for i, r in rects.items() if r.colliderect(query)),
+                )
+                point = query.topleft
+                self.assertEqual(
+                    index.collidepoint(point),
+                    sorted(i for i, r in rects.items() if r.collidepoint(point)),
+                )
+            self.assertEqual(
+                index.collidelist(queries),
+                [index.colliderect(query) for query in queries],
+            )
+
+    def test_zero_size(self):
+        index = RectIndex([Rect(0, 0, 0, 10), Rect(0, 0, 10, 10)])
+
+        self.assertEqual(index.colliderect(0, 0, 10, 10), [1])
+        self.assertEqual(index.colliderect(0, 0, 0, 0), [])
+        self.assertEqual(index.collidepoint(0, 5), [1])
+
+
+class RectPackerTest(unittest.TestCase):
+    def _check_packed(self, packer, sizes, rects):
+        """Asserts the rects have the sizes, fit the area and do not overlap."""
+        area = Rect((0, 0), packer.size)
+        placed = []
+        for size, rect in zip(sizes, rects):
+            if rect is None:
+                continue
+            self.assertEqual(rect.size, size)
+            if rect.w and rect.h:
+                self.assertTrue(area.contains(rect))
+                self.assertEqual(rect.collidelist(placed), -1)
+                placed.append(rect)
+        return placed
+
+    def test_construction(self):
+        self.assertEqual(RectPacker((30, 20)).size, (30, 20))
+        self.assertEqual(RectPacker(size=[0, 5]).size, (0, 5))
+        with self.assertRaises(ValueError):
+            RectPacker((-1, 10))
+        with self.assertRaises(TypeError):
+            RectPacker("size")
+
+    def test_insert(self):
+        packer = RectPacker((20, 20))
+
+        self.assertEqual(packer.insert(10, 10), Rect(0, 0, 10, 10))
+        self.assertEqual(packer.insert((10, 5)), Rect(10, 0, 10, 5))
+        self.assertEqual(packer.insert(10, 5), Rect(10, 5, 10, 5))
+        self.assertEqual(packer.insert(20, 10), Rect(0, 10, 20, 10))
+        self.assertIsNone(packer.insert(1, 1))
+        self.assertEqual(packer.insert(0, 4), Rect(0, 0, 0, 4))
+        with self.assertRaises(ValueError):
+            packer.insert(-1, 1)
+
+    def test_insertlist(self):
+        random.seed(52)
+        sizes = [(random.randint(8, 40), random.randint(8, 40)) for _ in range(300)]
+        packer = RectPacker((256, 256))
+
+        rects = packer.insertlist(sizes)
+
+        self.assertEqual(len(rects), len(sizes))
+        placed = self._check_packed(packer, sizes, rects)
+        # the area is filled up before anything is left out
+        self.assertIn(None, rects)
+        self.assertGreater(sum(r.w * r.h for r in placed), 0.9 * 256 * 256)
+
+    def test_insert__random(self):
+        random.seed(53)
+        for _ in range(20):
+            packer = RectPacker((random.randint(1, 200), random.randint(1, 200)))
+            sizes = [
+                (random.randint(0, 50), random.randint(0, 50)) for _ in range(60)
+            ]
+
+            self._check_packed(packer, sizes, [packer.insert(s) for s in sizes])
+
+    def test_clear(self):
+        packer = RectPacker((10, 10))
+        packer.insert(10, 10)
+
+        packer.clear()
+
+        self.assertEqual(packer.insert(10, 10), Rect(0, 0, 10, 10))
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -1,7 +1,13 @@
+import os
 import pathlib
+import shutil
+import tempfile
 import unittest
+import zipfile
 
+import pygame
 from pygame import encode_string, encode_file_path
+from pygame.tests.test_utils import example_path
 
 
 class RWopsEncodeStringTest(unittest.TestCase):
@@ -135,5 +141,63 @@ class RWopsEncodeFilePathTest(unittest.TestCase):
             self.assertRaises(TypeError, encode_file_path, "test", etype)
 
 
+class BundleTest(unittest.TestCase):
+    def setUp(self):
+        self.tmpdir = tempfile.mkdtemp()
+        self.path = os.path.join(self.tmpdir, "assets.zip")
+        with open(example_path("data/asprite.bmp"), "rb") as f:
+            self.bmp = f.read()
+        with zipfile.ZipFile(self.path, "w", zipfile.ZIP_STORED) as archive:
+            archive.writestr("images/", b"")
+            archive.writestr("images/asprite.bmp", self.bmp)
+            archive.writestr("text.txt", b"0123456789")
+            archive.writestr(
+                "packed.txt", b"x" * 100, compress_type=zipfile.ZIP_DEFLATED
+            )
+
+    def tearDown(self):
+        shutil.rmtree(self.tmpdir)
+
+    def test_names(self):
+        bundle = pygame.Bundle(pathlib.Path(self.path))
+
+        self.assertEqual(
+            bundle.names(), ["images/asprite.bmp", "text.txt", "packed.txt"]
+        )
+        self.assertEqual(len(bundle), 3)
+        self.assertIn("text.txt", bundle)
+        self.assertNotIn("images/", bundle)
+
+    def test_open(self):
+        bundle = pygame.Bundle(self.path)
+        entry = bundle.open("text.txt")
+
+        self.assertEqual(entry.name, "text.txt")
+        self.assertEqual(entry.read(3), b"012")
+        self.assertEqual(entry.seek(-2, 2), 8)
+        self.assertEqual(entry.read(), b"89")
+        self.assertEqual(entry.tell(), 10)
+        self.assertEqual(bytes(entry), b"0123456789")
+        entry.close()
+        self.assertTrue(entry.closed)
+        self.assertRaises(ValueError, entry.read)
+
+        self.assertRaises(KeyError, bundle.open, "missing.txt")
+        self.assertRaises(ValueError, bundle.open, "packed.txt")
+
+    def test_image_load(self):
+        bundle = pygame.Bundle(self.path)
+        entry = bundle.open("images/asprite.bmp")
+        expected = pygame.image.load(example_path("data/asprite.bmp"))
+
+        image = pygame.image.load(entry, entry.name)
+
+        self.assertEqual(image.get_size(), expected.get_size())
+        self.assertEqual(image.get_at((10, 10)), expected.get_at((10, 10)))
+
+    def test_not_a_zip(self):
+        self.assertRaises(ValueError, pygame.Bundle, example_path("data/asprite.bmp"))
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -0,0 +1,79 @@
+import unittest
+
+import pygame
+
+try:
+    from pygame.sharedsurface import SharedSurface
+except ImportError:
+    SharedSurface = None
+
+
+@unittest.skipIf(SharedSurface is None, "needs multiprocessing.shared_memory")
+class SharedSurfaceTest(unittest.TestCase):
+    def test_construction(self):
+        with SharedSurface((20, 10), pygame.SRCALPHA, 32) as shared:
+            try:
+                self.assertEqual(shared.surface.get_size(), (20, 10))
+                self.assertEqual(shared.surface.get_bitsize(), 32)
+                self.assertEqual(
+                    shared.surface.get_flags() & pygame.SRCALPHA, pygame.SRCALPHA
+                )
+                self.assertIsInstance(shared.name, str)
+            finally:
+                shared.unlink()
+        self.assertIsNone(shared.surface)
+
+    def test_attach(self):
+        shared = SharedSurface((16, 12), 0, 32)
+        try:
+            shared.surface.fill((10, 20, 30))
+            attached = SharedSurface.attach(shared.name)
+
+            self.assertEqual(attached.surface.get_size(), (16, 12))
+            self.assertEqual(attached.surface.get_at((4, 4)), (10, 20, 30, 255))
+
+            # each side sees what the other draws
+            attached.surface.fill((200, 0, 0), (0, 0, 5, 5))
+            self.assertEqual(shared.surface.get_at((2, 2)), (200, 0, 0, 255))
+            shared.surface.set_at((15, 11), (0, 0, 90))
+            self.assertEqual(attached.surface.get_at((15, 11)), (0, 0, 90, 255))
+            attached.close()
+        finally:
+            shared.close()
+            shared.unlink()
+
+    def test_from_surface(self):
+        surf = pygame.Surface((7, 5), 0, 8)
+        surf.set_palette_at(3, (90, 80, 70))
+        surf.fill(3)
+        surf.set_colorkey((90, 80, 70))
+
+        shared = SharedSurface.from_surface(surf)
+        try:
+            attached = SharedSurface.attach(shared.name)
+            self.assertEqual(attached.surface.get_bitsize(), 8)
+            self.assertEqual(attached.surface.get_at((6, 4)), (90, 80, 70, 255))
+            self.assertEqual(attached.surface.get_colorkey(), (90, 80, 70, 255))
+            attached.close()
+        finally:
+            shared.close()
+            shared.unlink()
+
+    def test_close__with_references(self):
+        shared = SharedSurface((4, 4))
+        try:
+            surface = shared.surface
+            with self.assertRaises(BufferError):
+                shared.close()
+            del surface
+            shared.close()
+        finally:
+            shared.unlink()
+
+    def test_attach__missing(self):
+        with self.assertRaises(FileNotFoundError):
+            SharedSurface.attach("pygame_no_such_shared_surface")
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -1,6 +1,7 @@
 #################################### IMPORTS ###################################
 
 
+import random
 import unittest
 
 import pygame
@@ -462,6 +463,82 @@ class SpriteCollideTest(unittest.TestCase):
 
         self.assertDictEqual(expected_dict, crashed)
 
+    def _many_sprites(self, count, seed):
+        """Sprites with random rects, radii and masks, all in one Group."""
+        rand = random.Random(seed)
+        group = sprite.Group()
+        for _ in range(count):
+            spr = sprite.Sprite(group)
+            spr.rect = pygame.Rect(
+                rand.randint(0, 400),
+                rand.randint(0, 400),
+                rand.randint(0, 30),
+                rand.randint(0, 30),
+            )
+            if rand.random() < 0.5:
+                spr.radius = rand.uniform(0, 20)
+            spr.mask = pygame.mask.Mask(spr.rect.size, fill=rand.random() < 0.8)
+        return group
+
+    def test_groupcollide__many_sprites(self):
+        """Large groups give the same results as testing every pair."""
+        callbacks = (
+            None,
+            sprite.collide_rect,
+            sprite.collide_circle,
+            sprite.collide_circle_ratio(1.5),
+            sprite.collide_mask,
+        )
+        for collided in callbacks:
+            for dokilla, dokillb in ((False, False), (True, False), (False, True)):
+                group_a = self._many_sprites(60, 1)
+                group_b = self._many_sprites(80, 2)
+                group_b.add(group_a.sprites()[:20])
+                expected = {}
+                test = collided or sprite.collide_rect
+                for spr_a in group_a.sprites():
+                    # the pair loop groupcollide() did before it used RectIndex
+                    collision = [spr_b for spr_b in group_b if test(spr_a, spr_b)]
+                    if collision:
+                        if dokillb:
+                            for spr_b in collision:
+                                spr_b.kill()
+                        expected[spr_a] = collision
+                        if dokilla:
+                            spr_a.kill()
+                expected_b = group_b.sprites()
+
+                group_a = self._many_sprites(60, 1)
+                group_b = self._many_sprites(80, 2)
+                group_b.add(group_a.sprites()[:20])
+                crashed = sprite.groupcollide(
+                    group_a, group_b, dokilla, dokillb, collided
+                )
+
+                self.assertNotEqual(crashed, {})
+                self.assertEqual(
+                    [(spr.rect, [s.rect for s in crashed[spr]]) for spr in crashed],
+                    [(spr.rect, [s.rect for s in expected[spr]]) for spr in expected],
+                )
+                self.assertEqual(
+                    [spr.rect for spr in group_b], [spr.rect for spr in expected_b]
+                )
+
+    def test_spritecollide__many_sprites(self):
+        """Large groups give the same results as testing every sprite."""
+        for collided in (sprite.collide_circle, sprite.collide_mask):
+            group = self._many_sprites(200, 3)
+            spr = sprite.Sprite()
+            spr.rect = pygame.Rect(150, 150, 100, 100)
+            spr.mask = pygame.mask.Mask(spr.rect.size, fill=True)
+            expected = [other for other in group if collided(spr, other)]
+
+            crashed = sprite.spritecollide(spr, group, True, collided)
+
+            self.assertNotEqual(crashed, [])
+            self.assertEqual(crashed, expected)
+            self.assertEqual(len(group), 200 - len(expected))
+
     def test_collide_rect(self):
         # Test colliding - some edges touching
         self.assertTrue(pygame.sprite.collide_rect(self.s1, self.s2))
@@ -663,6 +740,111 @@ class AbstractGroupTypeTest(unittest.TestCase):
         self.assertEqual(test_sprite.sink, [1, 2, 3])
         self.assertEqual(test_sprite.sink_kwargs, {"foo": 4, "bar": 5})
 
+    def test_update__cache_update(self):
+        class test_sprite(pygame.sprite.Sprite):
+            def update(self, *args, **kwargs):
+                self.calls.append((args, kwargs))
+
+        self.ag.cache_update = True
+        s = test_sprite(self.ag)
+        s.calls = []
+
+        self.ag.update(1, dt=2)
+        self.ag.update()
+        self.assertEqual(s.calls, [((1,), {"dt": 2}), ((), {})])
+
+        # the cached calls follow changes to the group
+        s2 = test_sprite(self.ag)
+        s2.calls = []
+        s.kill()
+        self.ag.update(3)
+        self.assertEqual(len(s.calls), 2)
+        self.assertEqual(s2.calls, [((3,), {})])
+
+    def test_update__batch_update(self):
+        class batch_sprite(pygame.sprite.Sprite):
+            batches = []
+
+            @classmethod
+            def batch_update(cls, sprites, *args, **kwargs):
+                cls.batches.append((sprites, args, kwargs))
+
+            def update(self, *args, **kwargs):
+                raise AssertionError("update() called instead of batch_update()")
+
+        self.ag.cache_update = True
+        s1 = batch_sprite(self.ag)
+        s2 = batch_sprite(self.ag)
+
+        self.ag.update(0.5)
+        self.ag.update(0.25, step=2)
+        first, second = batch_sprite.batches
+        self.assertEqual(first[0], [s1, s2])
+        self.assertIs(first[0], second[0])
+        self.assertEqual(first[1:], ((0.5,), {}))
+        self.assertEqual(second[1:], ((0.25,), {"step": 2}))
+
+        s1.kill()
+        self.ag.update()
+        self.assertEqual(batch_sprite.batches[2][0], [s2])
+
+    def test_update__batch_update_without_cache(self):
+        class batch_sprite(pygame.sprite.Sprite):
+            @classmethod
+            def batch_update(cls, sprites, *args, **kwargs):
+                raise AssertionError("batch_update() called without cache_update")
+
+            def update(self, *args, **kwargs):
+                self.updated = True
+
+        s = batch_sprite(self.ag)
+        self.ag.update()
+
+        self.assertTrue(s.updated)
+
+    def _sorted_sprites(self, group, colors):
+        sprites = []
+        for i, color in enumerate(colors):
+            spr = sprite.Sprite(group)
+            spr.image = pygame.Surface((10, 10))
+            spr.image.fill(color)
+            # added from the lowest bottom edge to the highest
+            spr.rect = spr.image.get_rect(topleft=(0, 2 - i))
+            sprites.append(spr)
+        return sprites
+
+    def test_draw__sort_key(self):
+        colors = [(255, 0, 0, 255), (0, 255, 0, 255), (0, 0, 255, 255)]
+        for group_type in (sprite.Group, sprite.RenderUpdates):
+            group = group_type()
+            sprites = self._sorted_sprites(group, colors)
+            group.sort_key = "rect.bottom"
+            surface = pygame.Surface((10, 20))
+
+            group.draw(surface)
+            self.assertEqual(surface.get_at((5, 5)), colors[0], group_type)
+
+            # the order kept from the last frame is sorted again
+            sprites[2].rect.y = 3
+            group.draw(surface)
+            self.assertEqual(surface.get_at((5, 5)), colors[2], group_type)
+
+            # and starts over when the sprites change
+            sprites[2].kill()
+            group.draw(surface)
+            self.assertEqual(surface.get_at((5, 5)), colors[0], group_type)
+
+    def test_draw__sort_key_callable(self):
+        colors = [(255, 0, 0, 255), (0, 255, 0, 255), (0, 0, 255, 255)]
+        group = sprite.Group()
+        self._sorted_sprites(group, colors)
+        group.sort_key = lambda spr: -spr.rect.bottom
+        surface = pygame.Surface((10, 20))
+
+        group.draw(surface)
+
+        self.assertEqual(surface.get_at((5, 5)), colors[2])
+
 
 ################################################################################
 
@@ -912,6 +1094,28 @@ class LayeredGroupBase:
 
         self.assertEqual(spr2.layer, expected_layer)
 
+    def test_change_layer__order(self):
+        sprites = [self.sprite() for _ in range(6)]
+        for i, spr in enumerate(sprites):
+            self.LG.add(spr, layer=i % 3)
+
+        # a sprite moves to the end of its new layer, and emptied layers go
+        self.LG.change_layer(sprites[0], 1)
+        self.LG.change_layer(sprites[3], 5)
+        self.LG.change_layer(sprites[4], 1)
+
+        self.assertEqual(
+            self.LG.sprites(),
+            [sprites[1], sprites[0], sprites[4], sprites[2], sprites[5], sprites[3]],
+        )
+        self.assertEqual(self.LG.layers(), [1, 2, 5])
+        self.assertEqual(
+            self.LG.get_sprites_from_layer(1), [sprites[1], sprites[0], sprites[4]]
+        )
+        self.assertEqual(self.LG.get_sprites_from_layer(0), [])
+        self.assertEqual(self.LG.get_bottom_layer(), 1)
+        self.assertEqual(self.LG.get_top_sprite(), sprites[3])
+
     def test_get_sprites_at(self):
         sprites = []
         expected_sprites = []
@@ -1361,6 +1565,67 @@ class DirtySpriteTypeTest(SpriteBase, unittest.TestCase):
     ]
 
 
+########################### ARRAY GROUP TESTS ##################################
+
+
+class ArrayGroupTest(unittest.TestCase):
+    def setUp(self):
+        self.images = []
+        for color in ("red", "green", "blue"):
+            image = pygame.Surface((10, 10))
+            image.fill(color)
+            self.images.append(image)
+
+    def test_add_remove(self):
+        group = sprite.ArrayGroup()
+
+        self.assertEqual(group.add(self.images[0]), 0)
+        self.assertEqual(group.add(self.images[1], (5, 5, 10, 10), pygame.BLEND_ADD), 1)
+        self.assertEqual(group.add(self.images[2], pygame.Rect(1, 2, 3, 4)), 2)
+        self.assertEqual(len(group), 3)
+        self.assertEqual(group.rects[0], pygame.Rect(0, 0, 10, 10))
+        self.assertEqual(list(group.flags), [0, pygame.BLEND_ADD, 0])
+
+        group.remove(1)
+        self.assertEqual(len(group), 2)
+        self.assertEqual(group.images, [self.images[0], self.images[2]])
+        self.assertEqual(list(group.rects), [(0, 0, 10, 10), (1, 2, 3, 4)])
+        self.assertEqual(list(group.flags), [0, 0])
+
+        group.empty()
+        self.assertEqual(len(group), 0)
+        self.assertEqual(len(group.rects), 0)
+
+    def test_draw(self):
+        """Ensures draw() matches blitting the images one at a time."""
+        group = sprite.ArrayGroup()
+        surface = pygame.Surface((40, 40))
+        expected = pygame.Surface((40, 40))
+        for i, image in enumerate(self.images * 3):
+            group.add(image, (i * 4, i * 3, 10, 10), pygame.BLEND_ADD if i % 2 else 0)
+        group.rects.move_ip(-2, 1)
+
+        group.draw(surface)
+        for image, rect, flags in zip(group.images, group.rects, group.flags):
+            expected.blit(image, rect, special_flags=flags)
+
+        for x in range(40):
+            for y in range(40):
+                self.assertEqual(surface.get_at((x, y)), expected.get_at((x, y)))
+
+    def test_clear(self):
+        group = sprite.ArrayGroup()
+        surface = pygame.Surface((30, 30))
+        background = pygame.Surface((30, 30))
+        background.fill("white")
+        group.add(self.images[0], (5, 5, 10, 10))
+
+        group.draw(surface)
+        group.clear(surface, background)
+        self.assertEqual(surface.get_at((7, 7)), (255, 255, 255, 255))
+        self.assertEqual(surface.get_at((20, 20)), (0, 0, 0, 255))
+
+
 ############################## BUG TESTS #######################################
 
 
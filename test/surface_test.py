@@ -15,6 +15,7 @@ import pygame
 from pygame.locals import *
 from pygame.bufferproxy import BufferProxy
 
+import array
 import platform
 import gc
 import weakref
@@ -205,6 +206,32 @@ class SurfaceTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
         self.assertEqual(bound_rect.width, 31)
         self.assertEqual(bound_rect.height, 31)
 
+        # every pixel compared one at a time, across the 16 pixel steps
+        for flags, depth in [(SRCALPHA, 32), (0, 32), (0, 24), (0, 16)]:
+            surf = pygame.Surface((37, 9), flags, depth)
+            if not flags:
+                surf.set_colorkey((0, 0, 0))
+            for points in ([], [(0, 0)], [(36, 8)], [(16, 4), (20, 2)], [(33, 7)]):
+                surf.fill((0, 0, 0, 0))
+                for point in points:
+                    surf.set_at(point, (255, 255, 255, 128))
+                for min_alpha in (1, 128, 129):
+                    found = [
+                        (x, y)
+                        for y in range(surf.get_height())
+                        for x in range(surf.get_width())
+                        if surf.get_at((x, y)) != surf.get_colorkey()
+                        and surf.get_at((x, y)).a >= min_alpha
+                    ]
+                    if found:
+                        xs = [x for x, y in found]
+                        ys = [y for x, y in found]
+                        expected = pygame.Rect(min(xs), min(ys), 1, 1)
+                        expected.union_ip((max(xs), max(ys), 1, 1))
+                    else:
+                        expected = pygame.Rect(0, 0, 0, 0)
+                    self.assertEqual(surf.get_bounding_rect(min_alpha), expected)
+
         # Issue #180
         pygame.display.init()
         try:
@@ -214,6 +241,62 @@ class SurfaceTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
         finally:
             pygame.display.quit()
 
+    def _expected_stats(self, surf, rect):
+        pixels = [
+            tuple(surf.get_at((x, y)))
+            for y in range(rect.top, rect.bottom)
+            for x in range(rect.left, rect.right)
+        ]
+        levels = [(77 * r + 150 * g + 29 * b + 128) >> 8 for r, g, b, _ in pixels]
+        channels = list(zip(*pixels))
+        count = len(pixels)
+        return {
+            "count": count,
+            "min": tuple(min(c) for c in channels),
+            "max": tuple(max(c) for c in channels),
+            "sum": tuple(sum(c) for c in channels),
+            "mean": tuple(sum(c) / count for c in channels),
+            "luminance_min": min(levels),
+            "luminance_max": max(levels),
+            "luminance_mean": sum(levels) / count,
+        }
+
+    def test_get_stats(self):
+        for flags, depth in ((SRCALPHA, 32), (0, 32), (0, 24), (0, 16), (0, 8)):
+            surf = pygame.Surface((19, 6), flags, depth)
+            surf.fill((200, 40, 90, 120))
+            for x in range(0, 19, 2):
+                surf.fill((x * 13, 255 - x * 7, x * 3, x * 11), (x, x % 6, 1, 3))
+
+            stats = surf.get_stats()
+            expected = self._expected_stats(surf, surf.get_rect())
+            self.assertEqual(stats.keys(), expected.keys())
+            for key, value in expected.items():
+                if key == "mean":
+                    for a, b in zip(stats[key], value):
+                        self.assertAlmostEqual(a, b)
+                elif key == "luminance_mean":
+                    self.assertAlmostEqual(stats[key], value)
+                else:
+                    self.assertEqual(stats[key], value, (depth, key))
+
+            stats = surf.get_stats((5, 1, 40, 3))
+            expected = self._expected_stats(surf, pygame.Rect(5, 1, 14, 3))
+            self.assertEqual(stats["sum"], expected["sum"], depth)
+            self.assertEqual(stats["min"], expected["min"], depth)
+            self.assertEqual(stats["luminance_max"], expected["luminance_max"])
+
+    def test_get_stats__empty(self):
+        surf = pygame.Surface((4, 4))
+
+        stats = surf.get_stats(rect=(10, 10, 2, 2))
+
+        self.assertEqual(stats["count"], 0)
+        self.assertEqual(stats["sum"], (0, 0, 0, 0))
+        self.assertIsNone(stats["min"])
+        self.assertIsNone(stats["luminance_mean"])
+        self.assertRaises(TypeError, surf.get_stats, "rect")
+
     def test_copy(self):
         """Ensure a surface can be copied."""
         color = (25, 25, 25, 25)
@@ -228,6 +311,217 @@ class SurfaceTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
         self.assertEqual(s1rect.size, s2rect.size)
         self.assertEqual(s2.get_at((10, 10)), color)
 
+    def test_copy__copy_on_write(self):
+        """Ensure copies sharing pixels stay independent once written to."""
+        red, green, blue = (255, 0, 0, 255), (0, 255, 0, 255), (0, 0, 255, 255)
+        original = pygame.Surface((16, 16), pygame.SRCALPHA, 32)
+        original.fill(red)
+        before = pygame.image.tostring(original, "RGBA")
+
+        copy1 = original.copy()
+        copy2 = copy1.copy()
+        self.assertFalse(copy1.get_flags() & pygame.PREALLOC)
+        self.assertFalse(original.get_flags() & pygame.PREALLOC)
+        self.assertEqual(pygame.image.tostring(copy2, "RGBA"), before)
+
+        copy1.set_at((1, 1), green)
+        self.assertEqual(copy1.get_at((1, 1)), green)
+        self.assertEqual(original.get_at((1, 1)), red)
+        self.assertEqual(copy2.get_at((1, 1)), red)
+
+        original.fill(blue)
+        self.assertEqual(copy2.get_at((1, 1)), red)
+        self.assertEqual(copy1.get_at((0, 0)), red)
+
+        pygame.draw.line(copy2, green, (0, 4), (15, 4))
+        self.assertEqual(copy2.get_at((8, 4)), green)
+        self.assertEqual(copy1.get_at((8, 4)), red)
+
+        # being a blit destination, or the source of its own copy
+        copy3 = original.copy()
+        copy3.blit(copy1, (0, 0))
+        self.assertEqual(copy3.get_at((1, 1)), green)
+        self.assertEqual(original.get_at((1, 1)), blue)
+        copy4 = copy3.copy()
+        copy3.blit(copy4, (1, 0))
+        self.assertEqual(copy3.get_at((2, 1)), green)
+        self.assertEqual(copy4.get_at((2, 1)), red)
+
+        # a lock hands out pixels of its own
+        copy5 = original.copy()
+        view = copy5.get_view("2")
+        del view
+        copy5.lock()
+        copy5.unlock()
+        self.assertEqual(copy5.get_at((0, 0)), blue)
+
+        # whichever surface goes first, the rest keep their pixels
+        copy6 = original.copy()
+        del original
+        self.assertEqual(copy6.get_at((5, 5)), blue)
+        sub = copy6.subsurface((2, 2, 4, 4))
+        sub.fill(green)
+        copy7 = copy6.copy()
+        self.assertEqual(copy7.get_at((3, 3)), green)
+        copy6.fill(red)
+        self.assertEqual(sub.get_at((0, 0)), red)
+        self.assertEqual(copy7.get_at((3, 3)), green)
+
+    def test_copy__copy_on_write_settings(self):
+        """Ensure copies sharing pixels keep the settings of the original."""
+        surf = pygame.Surface((8, 8), 0, 8)
+        surf.set_palette_at(3, (10, 20, 30))
+        surf.fill((10, 20, 30))
+        surf.set_colorkey((10, 20, 30))
+        surf.set_alpha(100)
+        surf.set_clip((1, 1, 4, 4))
+
+        copy = surf.copy()
+
+        self.assertEqual(copy.get_palette(), surf.get_palette())
+        self.assertEqual(copy.get_colorkey(), surf.get_colorkey())
+        self.assertEqual(copy.get_alpha(), 100)
+        self.assertEqual(copy.get_clip(), surf.get_clip())
+        self.assertEqual(copy.get_at_mapped((0, 0)), 3)
+
+        copy.set_palette_at(3, (40, 50, 60))
+        self.assertEqual(surf.get_at((0, 0)), (10, 20, 30, 255))
+
+    def test_premul_alpha(self):
+        """Ensure premul_alpha premultiplies colors and flags the copy."""
+        color = pygame.Color(200, 100, 50, 128)
+        surf = pygame.Surface((8, 8), pygame.SRCALPHA, 32)
+        surf.fill(color)
+
+        premul = surf.premul_alpha()
+
+        self.assertEqual(premul.get_at((3, 3)), color.premul_alpha())
+        self.assertEqual(surf.get_at((3, 3)), color)
+        self.assertTrue(premul.get_flags() & pygame.PREMULTIPLIED)
+        self.assertFalse(surf.get_flags() & pygame.PREMULTIPLIED)
+
+        # already premultiplied surfaces are copied unchanged
+        again = premul.premul_alpha()
+        self.assertEqual(again.get_at((3, 3)), color.premul_alpha())
+
+        for kept in (premul.copy(), premul.subsurface((1, 1, 4, 4))):
+            self.assertTrue(kept.get_flags() & pygame.PREMULTIPLIED)
+
+    def test_premul_alpha__bad_format(self):
+        """Ensure premul_alpha needs 32 bit per pixel alpha."""
+        for surf in (
+            pygame.Surface((4, 4), 0, 32),
+            pygame.Surface((4, 4), pygame.SRCALPHA, 16),
+        ):
+            self.assertRaises(ValueError, surf.premul_alpha)
+
+    def test_get_damage(self):
+        """Ensures drawing is recorded only while damage tracking is on."""
+        surf = pygame.Surface((100, 100))
+        src = pygame.Surface((10, 10))
+
+        surf.fill((1, 2, 3))
+        self.assertEqual(surf.get_damage(), [])
+
+        surf.set_damage_tracking(True)
+        surf.fill((1, 2, 3), (90, 90, 20, 20))
+        surf.blit(src, (-5, 0))
+        pygame.draw.rect(surf, (255, 0, 0), (40, 40, 5, 5))
+
+        damage = surf.get_damage(clear=False)
+        self.assertEqual(
+            sorted(damage),
+            [(0, 0, 5, 10), (40, 40, 5, 5), (90, 90, 10, 10)],
+        )
+        self.assertEqual(surf.get_damage(), damage)
+        self.assertEqual(surf.get_damage(), [])
+
+        surf.set_damage_tracking(False)
+        surf.fill((1, 2, 3))
+        self.assertEqual(surf.get_damage(), [])
+
+    def test_get_damage__merge(self):
+        """Ensures overlapping and excess damage rects are merged."""
+        surf = pygame.Surface((200, 200))
+        surf.set_damage_tracking(True)
+
+        surf.fill((1, 2, 3), (0, 0, 10, 10))
+        surf.fill((1, 2, 3), (5, 0, 10, 10))
+        self.assertEqual(surf.get_damage(), [(0, 0, 15, 10)])
+
+        # contained rects add nothing
+        surf.fill((1, 2, 3), (0, 0, 50, 50))
+        surf.fill((1, 2, 3), (10, 10, 5, 5))
+        self.assertEqual(surf.get_damage(), [(0, 0, 50, 50)])
+
+        for i in range(40):
+            surf.set_at((i * 5, i * 5), (255, 255, 255))
+            surf.fill((1, 2, 3), (i * 5, i * 5, 1, 1))
+        damage = surf.get_damage()
+        self.assertLessEqual(len(damage), 16)
+        for i in range(40):
+            self.assertTrue(any(r.collidepoint(i * 5, i * 5) for r in damage))
+
+    def test_get_damage__subsurface(self):
+        """Ensures drawing on a subsurface damages its tracked parent."""
+        surf = pygame.Surface((100, 100))
+        sub = surf.subsurface((50, 50, 20, 20))
+        surf.set_damage_tracking(True)
+
+        sub.fill((1, 2, 3), (-5, 5, 10, 10))
+        self.assertEqual(surf.get_damage(), [(50, 55, 5, 10)])
+        self.assertEqual(sub.get_damage(), [])
+
+    def test_get_version(self):
+        """Ensures changes to a surface or its parent change its version."""
+        surf = pygame.Surface((100, 100))
+        sub = surf.subsurface((50, 50, 20, 20))
+        other = pygame.Surface((10, 10))
+        version = surf.get_version()
+        self.assertEqual(surf.get_version(), version)
+
+        for change in (
+            lambda: surf.fill((1, 2, 3)),
+            lambda: surf.blit(other, (0, 0)),
+            lambda: pygame.draw.line(surf, (4, 5, 6), (0, 0), (9, 9)),
+            lambda: surf.set_colorkey((0, 0, 0)),
+            lambda: surf.set_alpha(100),
+            lambda: surf.lock(),
+        ):
+            change()
+            self.assertNotEqual(surf.get_version(), version)
+            version = surf.get_version()
+        surf.unlock()
+
+        sub_version = sub.get_version()
+        version = surf.get_version()
+        sub.fill((7, 8, 9))
+        self.assertNotEqual(surf.get_version(), version)
+        self.assertNotEqual(sub.get_version(), sub_version)
+
+        sub_version = sub.get_version()
+        surf.fill((0, 0, 0), (0, 0, 10, 10))
+        self.assertNotEqual(sub.get_version(), sub_version)
+
+        # an empty fill changes nothing
+        version = surf.get_version()
+        surf.fill((1, 1, 1), (0, 0, 0, 0))
+        self.assertEqual(surf.get_version(), version)
+
+    def test_premul_alpha__blit(self):
+        """Ensure plain blits of premultiplied surfaces blend premultiplied."""
+        src = pygame.Surface((16, 16), pygame.SRCALPHA, 32)
+        src.fill((200, 100, 50, 128))
+        premul = src.premul_alpha()
+        expected = pygame.Surface((16, 16), pygame.SRCALPHA, 32)
+        expected.fill((10, 20, 250, 255))
+        dst = expected.copy()
+
+        expected.blit(premul, (0, 0), special_flags=pygame.BLEND_PREMULTIPLIED)
+        dst.blit(premul, (0, 0))
+
+        self.assertEqual(dst.get_at((5, 5)), expected.get_at((5, 5)))
+
     def test_fill(self):
         """Ensure a surface can be filled."""
         color = (25, 25, 25, 25)
@@ -592,7 +886,7 @@ class SurfaceTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
         self.assertRaises(Error, s.get_view, "0")
         self.assertRaises(Error, s.get_view, "1")
         self.assertIsInstance(v2, BufferProxy)
-        self.assertRaises(Error, s.get_view, "3")
+        self.assertIsInstance(s.get_view("3"), BufferProxy)
 
         s = pygame.Surface((8, 7), 0, 8)
         length = s.get_bytesize() * s.get_width() * s.get_height()
@@ -610,7 +904,7 @@ class SurfaceTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
         self.assertRaises(Error, s.get_view, "0")
         self.assertRaises(Error, s.get_view, "1")
         self.assertIsInstance(v2, BufferProxy)
-        self.assertRaises(Error, s.get_view, "3")
+        self.assertIsInstance(s.get_view("3"), BufferProxy)
 
         s = pygame.Surface((8, 7), 0, 16)
         length = s.get_bytesize() * s.get_width() * s.get_height()
@@ -626,7 +920,7 @@ class SurfaceTypeTest(AssertRaisesRegexMixin, unittest.TestCase):
         v2 = s.get_view("2")
 
         self.assertIsInstance(v2, BufferProxy)
-        self.assertRaises(Error, s.get_view, "3")
+        self.assertIsInstance(s.get_view("3"), BufferProxy)
 
         s = pygame.Surface((5, 7), 0, 24)
         v2 = s.get_view("2")
@@ -970,6 +1264,117 @@ class TestSurfaceBlit(unittest.TestCase):
         for pt in test_utils.rect_area_pts(src.get_rect()):
             self.assertEqual(dst.get_at(pt)[1], src.get_at(pt)[1])
 
+    def test_blit__SRCALPHA_row_tails(self):
+        """Ensure per pixel alpha blits blend every pixel of short rows"""
+        src_color = (200, 100, 50, 100)
+        dst_color = (10, 20, 250, 200)
+        sa, da = src_color[3], dst_color[3]
+        expected = tuple(
+            ((d << 8) + (s - d) * sa + s) >> 8
+            for s, d in zip(src_color[:3], dst_color[:3])
+        ) + (sa + da - (sa * da) // 255,)
+
+        for width in range(1, 20):
+            src = pygame.Surface((width, 3), SRCALPHA, 32)
+            src.fill(src_color)
+            dst = pygame.Surface((width, 3), SRCALPHA, 32)
+            dst.fill(dst_color)
+
+            dst.blit(src, (0, 0))
+
+            for pt in test_utils.rect_area_pts(dst.get_rect()):
+                self.assertEqual(dst.get_at(pt), expected, (width, pt))
+
+    def test_blit__SRCALPHA_threaded(self):
+        """Ensure a blit split across threads matches a serial blit"""
+        size = (512, 384)
+        self.assertGreaterEqual(
+            size[0] * size[1], pygame.get_parallel_threshold()
+        )
+        src = pygame.Surface(size, SRCALPHA, 32)
+        src.fill((10, 200, 30, 128))
+        src.fill((250, 20, 90, 40), (0, 100, 512, 150))
+        base = pygame.Surface(size, SRCALPHA, 32)
+        base.fill((90, 60, 200, 255))
+        base.fill((0, 0, 0, 0), (100, 0, 200, 384))
+
+        serial = base.copy()
+        serial.blit(src, (0, 0))
+
+        original = pygame.get_num_threads()
+        try:
+            pygame.set_num_threads(4)
+            threaded = base.copy()
+            threaded.blit(src, (0, 0))
+        finally:
+            pygame.set_num_threads(original)
+
+        self.assertEqual(
+            pygame.image.tostring(threaded, "RGBA"),
+            pygame.image.tostring(serial, "RGBA"),
+        )
+
+    def test_blit__repeated_source(self):
+        """Ensure blitting an unchanged source again gives the same pixels"""
+
+        def make_sprite(flags, depth, alpha):
+            sprite = pygame.Surface((60, 12), flags, depth)
+            sprite.fill((0, 0, 0, 0) if flags else (255, 0, 255))
+            sprite.fill((200, 40, 90, alpha), (2, 0, 30, 12))
+            sprite.fill((20, 240, 10, alpha), (40, 3, 3, 6))
+            sprite.fill((90, 90, 250, 100 if flags else alpha), (33, 0, 5, 12))
+            if not flags:
+                sprite.set_colorkey((255, 0, 255))
+            return sprite
+
+        def make_dest(flags, depth):
+            dest = pygame.Surface((80, 30), flags, depth)
+            dest.fill((10, 120, 60, 180 if flags else 255))
+            dest.fill((0, 0, 0, 0), (0, 0, 25, 10))
+            return dest
+
+        positions = [(0, 0), (-20, 5), (50, 20), (10, -4), (30, 9)]
+        cases = [
+            (SRCALPHA, 32, 255, 0, 32),
+            (SRCALPHA, 32, 255, SRCALPHA, 32),
+            (SRCALPHA, 32, 128, 0, 32),
+            (0, 16, 255, 0, 16),
+            (0, 24, 255, 0, 24),
+            (0, 32, 255, 0, 32),
+        ]
+        for sflags, sdepth, alpha, dflags, ddepth in cases:
+            case = (sflags, sdepth, alpha, dflags, ddepth)
+            sprite = make_sprite(sflags, sdepth, 255)
+            if alpha != 255:
+                sprite.set_alpha(alpha)
+            repeated = make_dest(dflags, ddepth)
+            fresh = make_dest(dflags, ddepth)
+
+            for step in range(3):
+                if step == 2:
+                    # a changed source must not use the runs of before
+                    sprite.fill((5, 5, 5, 255), (0, 0, 50, 4))
+                    sprite.set_at((45, 8), (1, 2, 3, 40))
+                for pos in positions:
+                    repeated.blit(sprite, pos)
+                    fresh.blit(sprite.copy(), pos)
+                self.assertEqual(
+                    pygame.image.tostring(repeated, "RGBA"),
+                    pygame.image.tostring(fresh, "RGBA"),
+                    (case, step),
+                )
+
+            records = array.array("i", [c for pos in positions for c in pos])
+            for _ in range(2):
+                repeated.fblits(sprite, records)
+                for pos in positions:
+                    fresh.blit(sprite.copy(), pos)
+            self.assertEqual(
+                pygame.image.tostring(repeated, "RGBA"),
+                pygame.image.tostring(fresh, "RGBA"),
+                (case, "fblits"),
+            )
+
     def test_blit__blit_to_self(self):
         """Test that blit operation works on self, alpha value is
         correct, and that no RGB distortion occurs."""
@@ -1731,6 +2136,272 @@ class GeneralSurfaceTests(AssertRaisesRegexMixin, unittest.TestCase):
         finally:
             pygame.display.quit()
 
+
+    def test_convert_many(self):
+        """Ensure convert_many gives the same surfaces as converting each
+        surface by itself."""
+
+        def make_surfaces():
+            surfaces = []
+            for size, flags, depth in (
+                ((30, 20), 0, 24),
+                ((17, 9), 0, 32),
+                ((40, 31), SRCALPHA, 32),
+                ((5, 70), 0, 16),
+                ((8, 8), 0, 8),
+            ):
+                surf = pygame.Surface(size, flags, depth)
+                for x in range(size[0]):
+                    surf.fill(
+                        ((x * 37) % 256, (x * 11) % 256, 255 - x, (x * 53) % 256),
+                        (x, 0, 1, size[1]),
+                    )
+                surfaces.append(surf)
+            bgr = pygame.Surface((33, 12), 0, 32, (0xFF, 0xFF00, 0xFF0000, 0))
+            bgr.fill((1, 2, 3))
+            bgr.fill((200, 100, 50), (3, 3, 20, 5))
+            surfaces.append(bgr)
+            keyed = pygame.Surface((10, 10), 0, 32)
+            keyed.fill((255, 0, 255), (0, 0, 5, 10))
+            keyed.set_colorkey((255, 0, 255))
+            surfaces.append(keyed)
+            faded = pygame.Surface((12, 12), 0, 24)
+            faded.set_alpha(100)
+            surfaces.append(faded)
+            return surfaces
+
+        def same(a, b):
+            self.assertEqual(a.get_size(), b.get_size())
+            self.assertEqual(a.get_masks(), b.get_masks())
+            self.assertEqual(a.get_flags(), b.get_flags())
+            self.assertEqual(a.get_colorkey(), b.get_colorkey())
+            self.assertEqual(a.get_alpha(), b.get_alpha())
+            self.assertEqual(a.get_blendmode(), b.get_blendmode())
+            self.assertEqual(
+                pygame.image.tostring(a, "RGBA"), pygame.image.tostring(b, "RGBA")
+            )
+
+        pygame.display.init()
+        original = pygame.get_num_threads()
+        try:
+            pygame.display.set_mode((60, 60))
+            surfaces = make_surfaces()
+            formats = (
+                pygame.Surface((1, 1), 0, 24),
+                pygame.Surface((1, 1), SRCALPHA, 32),
+                pygame.Surface((1, 1), 0, 32, (0xFF00, 0xFF0000, 0xFF000000, 0)),
+            )
+            for threads in (1, 4):
+                pygame.set_num_threads(threads)
+                # enough surfaces to be worth splitting across threads
+                batch = surfaces * 40
+
+                converted = pygame.convert_many(batch)
+                self.assertEqual(len(converted), len(batch))
+                for surf, conv in zip(batch, converted):
+                    self.assertIsNot(surf, conv)
+                    same(conv, surf.convert())
+
+                for surf, conv in zip(batch, pygame.convert_many(batch, alpha=True)):
+                    same(conv, surf.convert_alpha())
+
+                for fmt in formats:
+                    for surf, conv in zip(batch, pygame.convert_many(batch, fmt)):
+                        same(conv, surf.convert(fmt))
+
+            sub = SurfaceSubclass((4, 4), 0, 32)
+            self.assertIsInstance(pygame.convert_many([sub])[0], SurfaceSubclass)
+            self.assertEqual(pygame.convert_many([]), [])
+            self.assertEqual(pygame.convert_many(()), [])
+
+            self.assertRaises(TypeError, pygame.convert_many, [surfaces[0], 1])
+            self.assertRaises(TypeError, pygame.convert_many, surfaces, 24)
+            self.assertRaises(ValueError, pygame.convert_many, surfaces, formats[0], True)
+        finally:
+            pygame.set_num_threads(original)
+            pygame.display.quit()
+
+        self.assertRaises(pygame.error, pygame.convert_many, [pygame.Surface((4, 4))])
+
+    def test_get_bounding_rects(self):
+        """Ensure get_bounding_rects gives what get_bounding_rect gives for
+        each surface, in order, on one thread or many."""
+        surfaces = []
+        for i, (flags, depth) in enumerate(
+            [(SRCALPHA, 32), (0, 32), (0, 24), (0, 16), (SRCALPHA, 16)] * 4
+        ):
+            surf = pygame.Surface((40 + i, 30), flags, depth)
+            surf.fill((0, 0, 0, 0))
+            if not flags and i % 2:
+                surf.set_colorkey((0, 0, 0))
+            surf.fill((200, 100, 50, 100 + i), (i, i % 7, 5, 3 + i))
+            surfaces.append(surf)
+
+        original = pygame.get_num_threads()
+        try:
+            for threads in (1, 4):
+                pygame.set_num_threads(threads)
+                for min_alpha in (1, 101, 120, 256):
+                    self.assertEqual(
+                        pygame.get_bounding_rects(surfaces, min_alpha),
+                        [s.get_bounding_rect(min_alpha) for s in surfaces],
+                    )
+        finally:
+            pygame.set_num_threads(original)
+
+        self.assertEqual(pygame.get_bounding_rects([]), [])
+        self.assertEqual(
+            pygame.get_bounding_rects(tuple(surfaces[:2])),
+            [surfaces[0].get_bounding_rect(), surfaces[1].get_bounding_rect()],
+        )
+        self.assertRaises(TypeError, pygame.get_bounding_rects, [surfaces[0], 1])
+        self.assertRaises(TypeError, pygame.get_bounding_rects, 1)
+
+    def test_auto_convert(self):
+        """Ensure blits with auto-convert enabled give the same pixels as
+        without, including after the source is changed."""
+        import warnings
+
+        dst_masks = (0xFF0000, 0xFF00, 0xFF, 0)
+        sources = []
+        for flags, depth in [(SRCALPHA, 32), (0, 24), (0, 16)]:
+            surf = pygame.Surface((8, 6), flags, depth)
+            surf.fill((10, 20, 30, 40))
+            surf.fill((250, 128, 3, 200), (2, 1, 4, 3))
+            sources.append(surf)
+        alpha_mod = pygame.Surface((8, 6), 0, 24)
+        alpha_mod.fill((90, 180, 45))
+        alpha_mod.set_alpha(100)
+        sources.append(alpha_mod)
+
+        def blit_all():
+            dst = pygame.Surface((12, 10), 0, 32, dst_masks)
+            dst.fill((60, 70, 80))
+            for surf in sources:
+                dst.blit(surf, (3, 2))
+                dst.blit(surf, (1, 1), (1, 1, 5, 4))
+            return pygame.image.tobytes(dst, "RGBA")
+
+        self.assertFalse(pygame.get_auto_convert())
+        expected = [blit_all()]
+        for surf in sources:
+            surf.fill((255, 0, 255, 90), (0, 0, 3, 3))
+        expected.append(blit_all())
+        for surf in sources:
+            surf.fill((10, 20, 30, 40), (0, 0, 3, 3))
+
+        pygame.set_auto_convert(True)
+        try:
+            self.assertTrue(pygame.get_auto_convert())
+            with warnings.catch_warnings():
+                warnings.simplefilter("ignore", RuntimeWarning)
+                for _ in range(3):
+                    self.assertEqual(blit_all(), expected[0])
+                for surf in sources:
+                    surf.fill((255, 0, 255, 90), (0, 0, 3, 3))
+                self.assertEqual(blit_all(), expected[1])
+                self.assertEqual(blit_all(), expected[1])
+        finally:
+            pygame.set_auto_convert(False)
+        self.assertFalse(pygame.get_auto_convert())
+
+    def test_compress(self):
+        """Ensure compressed pixels come back unchanged when used."""
+        for flags, depth in [(SRCALPHA, 32), (0, 24), (0, 16), (0, 8)]:
+            surf = pygame.Surface((40, 30), flags, depth)
+            surf.fill((10, 20, 30, 40))
+            surf.fill((250, 128, 3, 200), (5, 4, 20, 10))
+            surf.set_at((7, 20), (1, 2, 3, 4))
+            expected = pygame.image.tobytes(surf, "RGBA")
+            size = surf.get_pitch() * surf.get_height()
+
+            packed = surf.compress()
+            self.assertTrue(0 < packed < size)
+            self.assertEqual(surf.get_compressed_size(), packed)
+            self.assertEqual(surf.get_size(), (40, 30))
+            self.assertEqual(surf.get_compressed_size(), packed)
+            self.assertEqual(pygame.image.tobytes(surf, "RGBA"), expected)
+            self.assertEqual(surf.get_compressed_size(), 0)
+
+            surf.compress()
+            dst = pygame.Surface((40, 30), flags, depth)
+            dst.blit(surf, (0, 0))
+            self.assertEqual(surf.get_compressed_size(), 0)
+            self.assertEqual(pygame.image.tobytes(dst, "RGBA"), expected)
+
+            surf.compress()
+            surf.fill((0, 0, 0, 0), (0, 0, 2, 2))
+            dst.fill((0, 0, 0, 0), (0, 0, 2, 2))
+            self.assertEqual(
+                pygame.image.tobytes(surf, "RGBA"), pygame.image.tobytes(dst, "RGBA")
+            )
+
+        surf = pygame.Surface((40, 30))
+        sub = surf.subsurface((0, 0, 4, 4))
+        self.assertEqual(surf.compress(), 0)
+        self.assertEqual(sub.compress(), 0)
+        noise = pygame.Surface((8, 8), 0, 32)
+        for i in range(64):
+            noise.set_at((i % 8, i // 8), (i * 4, 255 - i, i))
+        self.assertEqual(noise.compress(), 0)
+        self.assertEqual(noise.get_compressed_size(), 0)
+
+    def test_gl_upload__no_context(self):
+        """Ensure gl_upload needs a current OpenGL context."""
+        surf = pygame.Surface((4, 4), SRCALPHA, 32)
+
+        with self.assertRaises(pygame.error):
+            surf.gl_upload()
+        with self.assertRaises(pygame.error):
+            surf.gl_upload(offset=(1, 1))
+        with self.assertRaises(TypeError):
+            surf.gl_upload(offset="a")
+
+    def test_surface_pool(self):
+        """Ensure a SurfacePool recycles the pixels of deleted transform
+        results and keeps count of it."""
+        pool = pygame.SurfacePool(max_buffers=2)
+        self.assertEqual(pool.max_buffers, 2)
+        self.assertEqual((pool.hits, pool.misses, pool.idle), (0, 0, 0))
+
+        surf = pygame.Surface((10, 6), 0, 32)
+        surf.fill((10, 20, 30))
+        surf.fill((200, 100, 50), (2, 2, 3, 3))
+        expected = pygame.transform.scale(surf, (20, 12))
+
+        scaled = pygame.transform.scale(surf, (20, 12), pool=pool)
+        self.assertEqual((pool.hits, pool.misses, pool.idle), (0, 1, 0))
+        self.assertEqual(
+            pygame.image.tostring(scaled, "RGBA"),
+            pygame.image.tostring(expected, "RGBA"),
+        )
+        del scaled
+        self.assertEqual(pool.idle, 1)
+
+        scaled = pygame.transform.scale(surf, (20, 12), pool=pool)
+        self.assertEqual((pool.hits, pool.misses, pool.idle), (1, 1, 0))
+        self.assertEqual(
+            pygame.image.tostring(scaled, "RGBA"),
+            pygame.image.tostring(expected, "RGBA"),
+        )
+        self.assertEqual(scaled.get_flags(), expected.get_flags())
+
+        flipped = pygame.transform.flip(scaled, True, False, pool=pool)
+        self.assertEqual((pool.hits, pool.misses, pool.idle), (1, 2, 0))
+        del flipped
+        # a different size does not reuse the idle buffer
+        rotated = pygame.transform.rotate(surf, 90, pool=pool)
+        self.assertEqual((pool.hits, pool.misses, pool.idle), (1, 3, 1))
+        # only max_buffers buffers are kept
+        del rotated, scaled
+        self.assertEqual(pool.idle, 2)
+
+        pool.clear()
+        self.assertEqual(pool.idle, 0)
+
+        self.assertRaises(ValueError, pygame.SurfacePool, -1)
+        self.assertRaises(TypeError, pygame.transform.scale, surf, (2, 2), pool=1)
+
     def test_get_abs_offset(self):
         pygame.display.init()
         try:
@@ -1832,6 +2503,68 @@ class GeneralSurfaceTests(AssertRaisesRegexMixin, unittest.TestCase):
                 "%i != %i, bitsize: %i" % (pixel, surf.map_rgb(color), bitsize),
             )
 
+    def test_get_at_many(self):
+        """Ensure get_at_many gives what get_at_mapped gives for each pixel."""
+        for bitsize in [8, 16, 24, 32]:
+            surf = pygame.Surface((5, 4), 0, bitsize)
+            for y in range(4):
+                for x in range(5):
+                    surf.set_at((x, y), (x * 50, y * 60, 30))
+            coords = array.array("i", [0, 0, 4, 3, 2, 1, 4, 0, 2, 1])
+            mapped = surf.get_at_many(coords)
+            self.assertIsInstance(mapped, array.array)
+            self.assertEqual(
+                list(mapped),
+                [
+                    surf.get_at_mapped(xy)
+                    for xy in zip(coords[0::2], coords[1::2])
+                ],
+            )
+
+        self.assertEqual(list(surf.get_at_many(array.array("i"))), [])
+        self.assertRaises(IndexError, surf.get_at_many, array.array("i", [5, 0]))
+        self.assertRaises(IndexError, surf.get_at_many, array.array("i", [0, -1]))
+        self.assertRaises(ValueError, surf.get_at_many, array.array("i", [0]))
+        self.assertRaises(TypeError, surf.get_at_many, array.array("d", [0, 0]))
+        self.assertRaises(TypeError, surf.get_at_many, [(0, 0)])
+
+    def test_set_at_many(self):
+        """Ensure set_at_many sets pixels as set_at does, with one color or
+        a mapped color for each pixel."""
+        coords = array.array("i", [0, 0, 3, 2, 1, 1, 9, 9, -1, 0])
+        for bitsize in [8, 16, 24, 32]:
+            surf = pygame.Surface((4, 3), 0, bitsize)
+            expected = pygame.Surface((4, 3), 0, bitsize)
+            for xy in zip(coords[0::2], coords[1::2]):
+                expected.set_at(xy, (255, 0, 0))
+            surf.set_at_many(coords, (255, 0, 0))
+            self.assertEqual(
+                list(surf.get_at_many(array.array("i", [0, 0, 3, 2, 1, 1, 2, 2]))),
+                list(expected.get_at_many(array.array("i", [0, 0, 3, 2, 1, 1, 2, 2]))),
+            )
+
+            # the mapped colors from one surface copy its pixels to another
+            for x in range(4):
+                surf.set_at((x, 0), (x * 60, 0, 255))
+            row = array.array("i", [0, 0, 1, 0, 2, 0, 3, 0])
+            other = pygame.Surface((4, 3), 0, surf)
+            other.set_at_many(row, surf.get_at_many(row))
+            for x in range(4):
+                self.assertEqual(other.get_at((x, 0)), surf.get_at((x, 0)))
+
+        # the clip area is respected
+        surf = pygame.Surface((4, 4), 0, 32)
+        surf.set_clip((1, 1, 2, 2))
+        surf.set_at_many(array.array("i", [0, 0, 1, 1]), pygame.Color("white"))
+        self.assertEqual(surf.get_at((0, 0)), (0, 0, 0, 255))
+        self.assertEqual(surf.get_at((1, 1)), (255, 255, 255, 255))
+        surf.set_at_many(array.array("i", [2, 2]), surf.map_rgb((1, 2, 3)))
+        self.assertEqual(surf.get_at((2, 2)), (1, 2, 3, 255))
+
+        self.assertRaises(ValueError, surf.set_at_many, coords, array.array("i", [0]))
+        self.assertRaises(TypeError, surf.set_at_many, coords, None)
+        self.assertRaises(ValueError, surf.set_at_many, coords, "not a color")
+
     def test_get_bitsize(self):
         pygame.display.init()
         try:
@@ -2409,6 +3142,45 @@ class GeneralSurfaceTests(AssertRaisesRegexMixin, unittest.TestCase):
         finally:
             pygame.display.quit()
 
+    def test_region(self):
+        surf = pygame.Surface((40, 30), SRCALPHA, 32)
+        surf.fill((10, 20, 30, 255), (5, 6, 7, 8))
+
+        region = surf.region((5, 6, 7, 8))
+        self.assertIsInstance(region, pygame.SurfaceRegion)
+        self.assertIs(region.surface, surf)
+        self.assertEqual(region.rect, (5, 6, 7, 8))
+        self.assertEqual(region.get_size(), (7, 8))
+        self.assertEqual(surf.region(5, 6, 7, 8).rect, region.rect)
+        self.assertEqual(surf.region((5, 6), (7, 8)).rect, region.rect)
+        self.assertEqual(pygame.SurfaceRegion(surf, (5, 6, 7, 8)).rect, region.rect)
+
+        sub = region.subsurface()
+        self.assertEqual(sub.get_offset(), (5, 6))
+        self.assertEqual(sub.get_size(), (7, 8))
+        self.assertIs(sub.get_parent(), surf)
+        self.assertIs(region.subsurface(), sub)
+        view = region.get_view("2")
+        self.assertEqual(view.shape, (7, 8))
+        self.assertEqual(sub.get_at((0, 0)), (10, 20, 30, 255))
+
+        # the region sees later changes to the surface
+        surf.fill((1, 2, 3, 255))
+        dst = pygame.Surface((7, 8), SRCALPHA, 32)
+        dst.blit(region, (0, 0))
+        self.assertEqual(dst.get_at((3, 3)), (1, 2, 3, 255))
+
+    def test_region__bad_args(self):
+        surf = pygame.Surface((40, 30))
+
+        for rect in [(-1, 0, 5, 5), (0, 0, 41, 5), (30, 20, 10, 11)]:
+            self.assertRaises(ValueError, surf.region, rect)
+        self.assertRaises(ValueError, surf.region, "not a rect")
+        self.assertRaises(TypeError, pygame.SurfaceRegion, None, (0, 0, 1, 1))
+        unset = pygame.SurfaceRegion.__new__(pygame.SurfaceRegion)
+        self.assertRaises(TypeError, surf.blit, unset, (0, 0))
+        self.assertRaises(ValueError, unset.subsurface)
+
     def test_subsurface(self):
 
         # __doc__ (as of 2008-08-02) for pygame.surface.Surface.subsurface:
@@ -2581,6 +3353,46 @@ class GeneralSurfaceTests(AssertRaisesRegexMixin, unittest.TestCase):
         surf.scroll(dx=-3, dy=-3)
         self.assertEqual(surf.get_at((0, 0)), spot_color)
 
+    def test_scroll__wrap(self):
+        """Ensure wrapped scrolls bring the pixels that leave one edge of
+        the clip area back in at the other."""
+        for bitsize, dx, dy in (
+            (8, 3, 2),
+            (16, -4, 7),
+            (24, 13, -1),
+            (32, -21, -15),
+            (32, 10, 0),
+            (32, 0, 0),
+        ):
+            surf = pygame.Surface((10, 7), 0, bitsize)
+            for x in range(10):
+                for y in range(7):
+                    surf.set_at((x, y), (x * 25, y * 36, 0))
+            comp = surf.copy()
+            surf.scroll(dx, dy, wrap=True)
+            for x in range(10):
+                for y in range(7):
+                    self.assertEqual(
+                        surf.get_at(((x + dx) % 10, (y + dy) % 7)),
+                        comp.get_at((x, y)),
+                    )
+
+        # only the clip area is rotated
+        surf = pygame.Surface((8, 8), 0, 32)
+        for x in range(8):
+            surf.fill((x * 30, 0, 0), (x, 0, 1, 8))
+        comp = surf.copy()
+        clip = Rect(2, 1, 4, 5)
+        surf.set_clip(clip)
+        surf.scroll(-1, wrap=True)
+        for x in range(8):
+            for y in range(8):
+                if clip.collidepoint(x, y):
+                    src = (clip.x + (x - clip.x + 1) % clip.w, y)
+                else:
+                    src = (x, y)
+                self.assertEqual(surf.get_at((x, y)), comp.get_at(src))
+
 
 class SurfaceSubtypeTest(unittest.TestCase):
     """Issue #280: Methods that return a new Surface preserve subclasses"""
@@ -3780,6 +4592,35 @@ class SurfaceBlendTest(unittest.TestCase):
                 dst.fill(fill_color, special_flags=getattr(pygame, blend_name))
                 self._assert_surface(dst, p, f", {blend_name}")
 
+    def test_fill_blend__area(self):
+        """Ensures blended fills of part of a wide surface touch only that
+        area, covering both vectorized runs and leftover pixels."""
+        blend = [
+            ("BLEND_ADD", lambda a, b: min(a + b, 255), 3),
+            ("BLEND_MULT", lambda a, b: ((a * b) + 255) >> 8, 3),
+            ("BLEND_RGBA_SUB", lambda a, b: max(a - b, 0), 4),
+            ("BLEND_RGBA_MAX", max, 4),
+        ]
+        base = (120, 60, 30, 200)
+        fill_color = (20, 100, 250, 60)
+        area = pygame.Rect(3, 1, 37, 2)
+
+        for blend_name, op, channels in blend:
+            dst = pygame.Surface((45, 4), SRCALPHA, 32)
+            dst.fill(base)
+            expected = list(base)
+            for i in range(channels):
+                expected[i] = op(base[i], fill_color[i])
+
+            dst.fill(fill_color, area, getattr(pygame, blend_name))
+
+            for x in range(45):
+                for y in range(4):
+                    color = expected if area.collidepoint(x, y) else base
+                    self.assertEqual(
+                        dst.get_at((x, y)), color, f"{blend_name} at {(x, y)}"
+                    )
+
 
 class SurfaceSelfBlitTest(unittest.TestCase):
     """Blit to self tests.
@@ -4020,5 +4861,127 @@ class SurfaceFillTest(unittest.TestCase):
             self.assertEqual(screen.get_at((10, y)), screen.get_at((330, 480 - y)))
 
 
+class HDRSurfaceTest(unittest.TestCase):
+    def assertPixel(self, hdr, pos, expected):
+        for got, want in zip(hdr.get_at(pos), expected):
+            self.assertAlmostEqual(got, want, places=5, msg=(pos, expected))
+
+    def test_new(self):
+        hdr = pygame.HDRSurface((7, 3))
+        self.assertEqual(hdr.get_size(), (7, 3))
+        self.assertEqual((hdr.get_width(), hdr.get_height()), (7, 3))
+        self.assertPixel(hdr, (6, 2), (0, 0, 0, 0))
+        self.assertRaises(IndexError, hdr.get_at, (7, 0))
+        self.assertRaises(pygame.error, pygame.HDRSurface, (-1, 3))
+
+    def test_fill(self):
+        hdr = pygame.HDRSurface((10, 10))
+        self.assertEqual(hdr.fill((2.0, 0.5, 0.25)), pygame.Rect(0, 0, 10, 10))
+        self.assertPixel(hdr, (3, 3), (2.0, 0.5, 0.25, 1.0))
+
+        rect = hdr.fill((1.0, 1.0, 1.0, 0.5), (8, -2, 5, 5), pygame.BLEND_ADD)
+        self.assertEqual(rect, pygame.Rect(8, 0, 2, 3))
+        self.assertPixel(hdr, (9, 2), (2.5, 1.0, 0.75, 1.0))
+        self.assertPixel(hdr, (9, 3), (2.0, 0.5, 0.25, 1.0))
+
+        hdr.fill((0.5, 0.5, 0.5, 0.5), special_flags=pygame.BLEND_MULT)
+        self.assertPixel(hdr, (0, 0), (1.0, 0.25, 0.125, 1.0))
+        hdr.fill((1, 1, 1, 0.5), special_flags=pygame.BLEND_RGBA_MULT)
+        self.assertPixel(hdr, (0, 0), (1.0, 0.25, 0.125, 0.5))
+
+        # a Color is sRGB encoded
+        hdr.fill(pygame.Color(255, 0, 188))
+        r, g, b, a = hdr.get_at((0, 0))
+        self.assertEqual((r, g, a), (1.0, 0.0, 1.0))
+        self.assertAlmostEqual(b, 0.5029, places=3)
+        self.assertRaises(TypeError, hdr.fill, (1, 2))
+        self.assertRaises(ValueError, hdr.fill, (1, 1, 1), None, pygame.BLEND_SUB)
+
+    def test_blit_add_does_not_saturate(self):
+        hdr = pygame.HDRSurface((4, 4))
+        spark = pygame.HDRSurface((2, 2))
+        spark.fill((0.4, 0.2, 0.1, 0.5))
+        for _ in range(10):
+            hdr.blit(spark, (1, 1), special_flags=pygame.BLEND_ADD)
+        self.assertPixel(hdr, (2, 2), (2.0, 1.0, 0.5, 0.0))
+        self.assertPixel(hdr, (0, 0), (0, 0, 0, 0))
+
+    def test_blit_over_and_mult(self):
+        hdr = pygame.HDRSurface((4, 4))
+        hdr.fill((1.0, 1.0, 1.0))
+        half = pygame.HDRSurface((4, 4))
+        half.fill((3.0, 0.0, 0.0, 0.5))
+        rect = hdr.blit(half, (2, 2))
+        self.assertEqual(rect, pygame.Rect(2, 2, 2, 2))
+        self.assertPixel(hdr, (3, 3), (2.0, 0.5, 0.5, 1.0))
+        self.assertPixel(hdr, (1, 1), (1.0, 1.0, 1.0, 1.0))
+
+        hdr.blit(half, (0, 0), (0, 0, 1, 1), pygame.BLEND_MULT)
+        self.assertPixel(hdr, (0, 0), (2.0, 0.5, 0.5, 1.0))
+
+        # overlapping self blit reads the pixels before the blit
+        hdr.blit(hdr, (1, 0), special_flags=pygame.BLEND_ADD)
+        self.assertPixel(hdr, (1, 0), (3.0, 1.5, 1.5, 1.0))
+        self.assertPixel(hdr, (2, 0), (2.0, 2.0, 2.0, 1.0))
+
+    def test_blit_surface(self):
+        surf = pygame.Surface((3, 1), pygame.SRCALPHA, 32)
+        surf.fill((255, 255, 255, 255))
+        surf.set_at((1, 0), (188, 0, 0, 0))
+        surf.set_at((2, 0), (255, 0, 0, 51))
+        hdr = pygame.HDRSurface((3, 1))
+        hdr.blit(surf)
+        self.assertPixel(hdr, (0, 0), (1, 1, 1, 1))
+        self.assertPixel(hdr, (1, 0), (0, 0, 0, 0))
+        self.assertPixel(hdr, (2, 0), (0.2, 0, 0, 0.2))
+        self.assertRaises(TypeError, hdr.blit, "surface")
+
+    def assertColor(self, surf, pos, expected):
+        for got, want in zip(surf.get_at(pos), expected):
+            self.assertAlmostEqual(got, want, delta=1, msg=(pos, expected))
+
+    def test_tonemap(self):
+        hdr = pygame.HDRSurface((4, 2))
+        hdr.fill(pygame.Color(188, 128, 0))
+        hdr.fill((0.0, 0.0, 0.0, 0.0), (0, 1, 4, 1))
+        screen = pygame.Surface((6, 2), 0, 32)
+        screen.fill((9, 9, 9))
+
+        rect = hdr.tonemap(screen, (3, 0), method="clamp")
+        self.assertEqual(rect, pygame.Rect(3, 0, 3, 2))
+        self.assertColor(screen, (3, 0), (188, 128, 0, 255))
+        self.assertEqual(screen.get_at((3, 1)), (0, 0, 0, 255))
+        self.assertEqual(screen.get_at((2, 0)), (9, 9, 9, 255))
+
+        hdr.fill((0.5, 4.0, 0.0))
+        hdr.tonemap(screen, exposure=0.25, method="clamp")
+        self.assertColor(screen, (0, 0), (99, 255, 0, 255))
+        hdr.tonemap(screen)
+        r, g = screen.get_at((0, 0))[:2]
+        self.assertLess(g, 255)
+        self.assertLess(r, 188)
+        hdr.tonemap(screen, method="aces")
+        self.assertLess(screen.get_at((0, 0))[1], 255)
+        self.assertRaises(ValueError, hdr.tonemap, screen, method="filmic")
+        self.assertRaises(ValueError, hdr.tonemap, pygame.Surface((2, 2), 0, 16))
+
+    def test_tonemap_alpha(self):
+        hdr = pygame.HDRSurface((1, 1))
+        hdr.fill(pygame.Color(128, 64, 255, 128))
+        surf = pygame.Surface((1, 1), pygame.SRCALPHA, 32)
+        hdr.tonemap(surf, method="clamp")
+        self.assertColor(surf, (0, 0), (128, 64, 255, 128))
+
+    def test_buffer(self):
+        hdr = pygame.HDRSurface((3, 2))
+        hdr.fill((0.25, 0.5, 0.75))
+        view = memoryview(hdr)
+        self.assertEqual(view.format, "f")
+        self.assertEqual(view.shape, (2, 3, 4))
+        self.assertEqual(view[1, 2, 1], 0.5)
+        view[1, 2, 0] = 8.0
+        self.assertPixel(hdr, (2, 1), (8.0, 0.5, 0.75, 1.0))
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -628,12 +628,19 @@ class SurfarrayModuleTest(unittest.TestCase):
         arr[0, 0] = color[:3]
         self.assertEqual(surf.get_at((0, 0)), color)
 
-        # Error checks
-        def do_pixels3d(surf):
-            pygame.surfarray.pixels3d(surf)
-
-        self.assertRaises(ValueError, do_pixels3d, self._make_surface(8))
-        self.assertRaises(ValueError, do_pixels3d, self._make_surface(16))
+        # 8 and 16 bit surfaces get a staged copy, written back on release
+        for bitsize in [8, 16]:
+            surf = self._make_src_surface(bitsize)
+            expected = [surf.get_at(posn)[:3] for posn, i in self.test_points]
+            arr = pygame.surfarray.pixels3d(surf)
+            self.assertTrue(surf.get_locked())
+            for ((x, y), i), color in zip(self.test_points, expected):
+                self.assertEqual(tuple(arr[x, y]), color)
+            arr[0, 0] = (0, 0, 0)
+            del arr
+            self.assertFalse(surf.get_locked())
+            self.assertEqual(surf.get_at((0, 0))[:3], (0, 0, 0))
+            self.assertEqual(surf.get_at((1, 0))[:3], expected[0])
 
     def test_pixels_alpha(self):
 
@@ -671,13 +678,22 @@ class SurfarrayModuleTest(unittest.TestCase):
         def do_pixels_alpha(surf):
             pygame.surfarray.pixels_alpha(surf)
 
-        targets = [(8, False), (16, False), (16, True), (24, False), (32, False)]
+        targets = [(8, False), (16, False), (24, False), (32, False)]
 
         for bitsize, srcalpha in targets:
             self.assertRaises(
                 ValueError, do_pixels_alpha, self._make_surface(bitsize, srcalpha)
             )
 
+        # A 16 bit alpha plane is staged and written back on release
+        surf = self._make_surface(16, srcalpha=True)
+        arr = pygame.surfarray.pixels_alpha(surf)
+        arr[0, 0] = 255
+        del arr
+        self.assertFalse(surf.get_locked())
+        self.assertEqual(surf.get_at((0, 0))[3], 255)
+        self.assertEqual(surf.get_at((1, 0))[3], 0)
+
     def test_pixels_red(self):
         self._test_pixels_rgb("red", 0)
 
@@ -718,13 +734,17 @@ class SurfarrayModuleTest(unittest.TestCase):
             self.assertFalse(surf.get_locked())
             self.assertEqual(surf.get_locks(), ())
 
-        # Check exceptions.
-        targets = [(8, False), (16, False), (16, True)]
+        # 8 and 16 bit surfaces get a staged copy of the plane.
+        for bitsize, srcalpha in [(8, False), (16, False), (16, True)]:
+            surf = self._make_src_surface(bitsize, srcalpha, palette)
+            arr = pixels_rgb(surf)
+            self.assertTrue(surf.get_locked())
+            for (x, y), i in self.test_points:
+                self.assertEqual(arr[x, y], surf.get_at((x, y))[mask_posn])
 
-        for bitsize, srcalpha in targets:
-            self.assertRaises(
-                ValueError, pixels_rgb, self._make_surface(bitsize, srcalpha)
-            )
+            del arr
+            self.assertFalse(surf.get_locked())
+            self.assertEqual(surf.get_locks(), ())
 
     def test_use_arraytype(self):
         def do_use_arraytype(atype):
@@ -1,5 +1,9 @@
-import unittest
+import os
 import platform
+import shutil
+import sys
+import tempfile
+import unittest
 
 
 class SysfontModuleTest(unittest.TestCase):
@@ -38,6 +42,57 @@ class SysfontModuleTest(unittest.TestCase):
 
         self.assertTrue(len(pygame.sysfont.get_fonts()) > 0)
 
+    @unittest.skipIf(
+        sys.platform in ("win32", "emscripten"), "fc-list is only used on unix"
+    )
+    def test_initsysfonts_unix_cache(self):
+        import pygame.sysfont
+
+        tmpdir = tempfile.mkdtemp()
+        fc_list = os.path.join(tmpdir, "fc-list")
+        cache = os.path.join(tmpdir, "cache", "sysfont.json")
+        with open(fc_list, "w") as f:
+            f.write(
+                "#!/bin/sh\n"
+                "echo '/fonts/Sans.ttf: Some Sans:style=Regular'\n"
+                "echo '/fonts/Sans-Bold.ttf: Some Sans:style=Bold'\n"
+            )
+        os.chmod(fc_list, 0o755)
+        expected = {
+            "somesans": {
+                (False, False): "/fonts/Sans.ttf",
+                (True, False): "/fonts/Sans-Bold.ttf",
+            }
+        }
+
+        old_env = os.environ.get("PYGAME_SYSFONT_CACHE")
+        old_stamp = pygame.sysfont._font_dirs_stamp_unix
+        os.environ["PYGAME_SYSFONT_CACHE"] = cache
+        try:
+            self.assertEqual(pygame.sysfont.initsysfonts_unix(fc_list), expected)
+            self.assertTrue(os.path.exists(cache))
+
+            # a second scan is read from the cache, without running fc-list
+            os.remove(fc_list)
+            self.assertEqual(pygame.sysfont.initsysfonts_unix(fc_list), expected)
+
+            # changed font directories invalidate the cache
+            pygame.sysfont._font_dirs_stamp_unix = lambda: [["/fonts", 1]]
+            with self.assertWarns(UserWarning):
+                self.assertEqual(pygame.sysfont.initsysfonts_unix(fc_list), {})
+
+            # an empty variable disables the cache
+            os.remove(cache)
+            os.environ["PYGAME_SYSFONT_CACHE"] = ""
+            self.assertIsNone(pygame.sysfont._cache_path_unix())
+        finally:
+            pygame.sysfont._font_dirs_stamp_unix = old_stamp
+            if old_env is None:
+                del os.environ["PYGAME_SYSFONT_CACHE"]
+            else:
+                os.environ["PYGAME_SYSFONT_CACHE"] = old_env
+            shutil.rmtree(tmpdir)
+
     @unittest.skipIf("Windows" not in platform.platform(), "Not windows we skip.")
     def test_initsysfonts_win32(self):
         import pygame.sysfont
@@ -0,0 +1,151 @@
+import unittest
+
+import pygame
+from pygame.tilemap import Tilemap
+
+
+class TilemapTest(unittest.TestCase):
+    COLORS = [(255, 0, 0, 255), (0, 255, 0, 255), (0, 0, 255, 255)]
+
+    def _tileset(self):
+        """three 4x4 tiles in a row, each of one colour"""
+        tileset = pygame.Surface((12, 4), pygame.SRCALPHA, 32)
+        for i, color in enumerate(self.COLORS):
+            tileset.fill(color, (i * 4, 0, 4, 4))
+        return tileset
+
+    def _expected(self, tilemap, x, y):
+        """the colour of map pixel (x, y)"""
+        index = tilemap[x // 4, y // 4]
+        return (0, 0, 0, 0) if index < 0 else self.COLORS[index]
+
+    def _check(self, tilemap, target, camera, area):
+        for y in range(area.h):
+            for x in range(area.w):
+                map_x, map_y = camera[0] + x, camera[1] + y
+                if 0 <= map_x < 40 and 0 <= map_y < 24:
+                    expected = self._expected(tilemap, map_x, map_y)
+                else:
+                    expected = (0, 0, 0, 0)
+                self.assertEqual(
+                    tuple(target.get_at((area.x + x, area.y + y))),
+                    expected,
+                    (camera, x, y),
+                )
+
+    def _tilemap(self):
+        data = [[(x + y) % 4 - 1 for x in range(10)] for y in range(6)]
+        return Tilemap(self._tileset(), (4, 4), (10, 6), (3, 2), data)
+
+    def test_construction(self):
+        tilemap = self._tilemap()
+
+        self.assertEqual(tilemap.size, (10, 6))
+        self.assertEqual(tilemap.tile_size, (4, 4))
+        self.assertEqual(tilemap.chunk_size, (3, 2))
+        self.assertEqual(len(tilemap.tiles), 3)
+        self.assertEqual(tilemap[0, 0], -1)
+        self.assertEqual(tilemap[2, 1], 2)
+
+    def test_construction__tile_list(self):
+        tiles = [pygame.Surface((4, 4)) for _ in range(5)]
+        tilemap = Tilemap(tiles, (4, 4), (2, 2))
+
+        self.assertEqual(tilemap.tiles, tiles)
+        self.assertEqual(tilemap[1, 1], -1)
+
+    def test_construction__invalid(self):
+        tileset = self._tileset()
+
+        self.assertRaises(ValueError, Tilemap, tileset, (0, 4), (2, 2))
+        self.assertRaises(ValueError, Tilemap, tileset, (4, 4), (-1, 2))
+        self.assertRaises(ValueError, Tilemap, tileset, (4, 4), (2, 2), (0, 1))
+        self.assertRaises(ValueError, Tilemap, tileset, (4, 4), (2, 2), data=[[3]])
+        self.assertRaises(IndexError, Tilemap, tileset, (4, 4), (2, 2), data=[[0] * 3])
+
+    def test_setitem__invalid(self):
+        tilemap = self._tilemap()
+
+        with self.assertRaises(IndexError):
+            tilemap[10, 0] = 0
+        with self.assertRaises(IndexError):
+            tilemap[0, -1] = 0
+        with self.assertRaises(ValueError):
+            tilemap[0, 0] = 3
+
+    def test_draw(self):
+        tilemap = self._tilemap()
+        for camera in ((0, 0), (5, 3), (-6, -2), (30, 20)):
+            target = pygame.Surface((20, 14), pygame.SRCALPHA, 32)
+            drawn = tilemap.draw(target, camera)
+            self._check(tilemap, target, camera, target.get_rect())
+            left, top = max(-camera[0], 0), max(-camera[1], 0)
+            self.assertEqual(
+                drawn,
+                pygame.Rect(
+                    left,
+                    top,
+                    min(20 - left, 40 - camera[0] - left),
+                    min(14 - top, 24 - camera[1] - top),
+                ),
+            )
+
+    def test_draw__area(self):
+        tilemap = self._tilemap()
+        target = pygame.Surface((30, 30), pygame.SRCALPHA, 32)
+        area = pygame.Rect(3, 5, 11, 9)
+
+        tilemap.draw(target, (7, 1), area)
+
+        self._check(tilemap, target, (7, 1), area)
+        self.assertEqual(tuple(target.get_at((2, 5))), (0, 0, 0, 0))
+        self.assertEqual(tuple(target.get_at((14, 13))), (0, 0, 0, 0))
+
+    def test_draw__outside(self):
+        tilemap = self._tilemap()
+        target = pygame.Surface((8, 8), pygame.SRCALPHA, 32)
+
+        self.assertEqual(tilemap.draw(target, (100, 0)), pygame.Rect(0, 0, 0, 0))
+
+    def test_setitem__redraws(self):
+        tilemap = self._tilemap()
+        target = pygame.Surface((40, 24), pygame.SRCALPHA, 32)
+        tilemap.draw(target)
+
+        tilemap[4, 3] = 0
+        tilemap[0, 0] = 2
+        tilemap[1, 0] = -1
+        target.fill((0, 0, 0, 0))
+        tilemap.draw(target)
+
+        self._check(tilemap, target, (0, 0), target.get_rect())
+        self.assertEqual(tuple(target.get_at((17, 13))), self.COLORS[0])
+        self.assertEqual(tuple(target.get_at((5, 1))), (0, 0, 0, 0))
+
+    def test_fill(self):
+        tilemap = self._tilemap()
+
+        tilemap.fill(1, (8, 4, 5, 5))
+        self.assertEqual(tilemap[9, 5], 1)
+        self.assertEqual(tilemap[7, 5], (7 + 5) % 4 - 1)
+
+        tilemap.fill(-1)
+        self.assertEqual(tilemap[3, 3], -1)
+
+    def test_invalidate(self):
+        tileset = self._tileset()
+        tilemap = Tilemap(tileset, (4, 4), (10, 6), (3, 2))
+        tilemap.fill(0)
+        target = pygame.Surface((40, 24), pygame.SRCALPHA, 32)
+        tilemap.draw(target)
+
+        tileset.fill(self.COLORS[2], (0, 0, 4, 4))
+        tilemap.invalidate((0, 0, 3, 2))
+        tilemap.draw(target)
+
+        self.assertEqual(tuple(target.get_at((1, 1))), self.COLORS[2])
+        self.assertEqual(tuple(target.get_at((13, 1))), self.COLORS[0])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -28,6 +28,79 @@ class ClockTypeTest(unittest.TestCase):
         self._fps_test(c, 60, delta)
         self._fps_test(c, 30, delta)
 
+    def test_construction__history(self):
+        """Ensure a Clock can be made with a frame history"""
+        c = Clock(history=10)
+
+        self.assertEqual(len(c.get_frame_times()), 0)
+        self.assertRaises(ValueError, Clock, history=-1)
+        self.assertRaises(ValueError, Clock().get_frame_times)
+        self.assertRaises(ValueError, Clock().get_frame_stats)
+
+    def test_get_frame_times(self):
+        """Ensure the history keeps the latest frame times, oldest first"""
+        c = Clock(history=5)
+        delays = [0.001, 0.002, 0.004, 0.008, 0.012, 0.016, 0.020]
+
+        for delay in delays:
+            time.sleep(delay)
+            c.tick()
+
+        frame_times = c.get_frame_times()
+        self.assertEqual(frame_times.format, "d")
+        self.assertEqual(len(frame_times), 5)
+        for frame_time, delay in zip(frame_times, delays[2:]):
+            self.assertGreaterEqual(frame_time, delay * 1000)
+            self.assertAlmostEqual(frame_time, delay * 1000, delta=10)
+        self.assertEqual(list(frame_times), sorted(frame_times))
+
+    def test_get_frame_stats(self):
+        """Ensure the percentiles come from the frame times in the history"""
+        c = Clock(history=100)
+        self.assertEqual(c.get_frame_stats(), (0.0, 0.0, 0.0, 0.0))
+
+        for i in range(20):
+            c.tick()
+        time.sleep(0.05)
+        c.tick()
+
+        p50, p95, p99, longest = c.get_frame_stats()
+        frame_times = sorted(c.get_frame_times())
+        self.assertEqual(p50, frame_times[10])
+        self.assertEqual(p95, frame_times[19])
+        self.assertEqual(p99, longest)
+        self.assertEqual(longest, frame_times[-1])
+        self.assertGreaterEqual(longest, 50)
+
+    def test_get_jitter(self):
+        """Ensure get_jitter() reports how late the framerate delays end"""
+        c = Clock()
+        self.assertEqual(c.get_jitter(), (0.0, 0.0))
+
+        for i in range(20):
+            c.tick_busy_loop(100)
+
+        mean, longest = c.get_jitter()
+        self.assertGreaterEqual(mean, 0.0)
+        self.assertGreaterEqual(longest, mean)
+        # the busy loop ends the delays within a fraction of a millisecond,
+        # this leaves room for a loaded machine
+        self.assertLess(mean, 2.0)
+
+    def test_tick__float_framerate(self):
+        """Ensure tick() keeps a fractional framerate on average"""
+        c = Clock()
+        c.tick()
+
+        start = time.perf_counter()
+        milliseconds = sum(c.tick(120.0) for i in range(60))
+        elapsed = time.perf_counter() - start
+
+        # frames are scheduled from when the previous one was due, so the
+        # rounding of each delay does not add up
+        self.assertAlmostEqual(elapsed, 0.5, delta=0.05)
+        self.assertAlmostEqual(milliseconds, elapsed * 1000, delta=2)
+
     def _fps_test(self, clock, fps, delta):
         """ticks fps times each second, hence get_fps() should return fps"""
         delay_per_frame = 1.0 / fps
@@ -237,6 +310,83 @@ class ClockTypeTest(unittest.TestCase):
         )
 
 
+class ProfilerTypeTest(unittest.TestCase):
+    def test_construction(self):
+        """Ensure a profiler starts with no frames and rejects bad sizes"""
+        profiler = pygame.time.Profiler(frames=4, spans=2)
+
+        self.assertEqual(profiler.get_frames(), [])
+        self.assertRaises(ValueError, pygame.time.Profiler, 0)
+        self.assertRaises(ValueError, pygame.time.Profiler, spans=0)
+
+    def test_spans(self):
+        """Ensure nested spans are recorded with their depth and times"""
+        profiler = pygame.time.Profiler()
+
+        profiler.frame_begin()
+        with profiler.span("update"):
+            with profiler.span("physics"):
+                time.sleep(0.002)
+        with profiler.span("draw"):
+            pass
+        frame_ms = profiler.frame_end()
+
+        frames = profiler.get_frames()
+        self.assertEqual(len(frames), 1)
+        self.assertEqual(frames[0][0], frame_ms)
+        spans = frames[0][1]
+        self.assertEqual(
+            [s[:2] for s in spans], [("update", 0), ("physics", 1), ("draw", 0)]
+        )
+        self.assertGreaterEqual(spans[1][3], 1.0)
+        self.assertGreaterEqual(spans[0][3], spans[1][3])
+        self.assertLessEqual(spans[0][2], spans[1][2])
+        self.assertGreaterEqual(frame_ms, spans[2][2] + spans[2][3])
+
+    def test_span__same_object(self):
+        """Ensure a name always gives the same span"""
+        profiler = pygame.time.Profiler()
+        span = profiler.span("update")
+
+        self.assertIs(profiler.span("update"), span)
+        self.assertEqual(span.name, "update")
+        self.assertRaises(TypeError, profiler.span, 1)
+
+    def test_ring_buffer(self):
+        """Ensure only the last frames and the spans that fit are kept"""
+        profiler = pygame.time.Profiler(frames=3, spans=2)
+
+        for i in range(5):
+            profiler.frame_begin()
+            for name in ("a", "b", "c"):
+                with profiler.span(name):
+                    pass
+            profiler.frame_end()
+
+        frames = profiler.get_frames()
+        self.assertEqual(len(frames), 3)
+        for frame_ms, spans in frames:
+            self.assertEqual([s[0] for s in spans], ["a", "b"])
+
+        profiler.clear()
+        self.assertEqual(profiler.get_frames(), [])
+
+    def test_frame_end(self):
+        """Ensure open spans are closed and unbegun frames rejected"""
+        profiler = pygame.time.Profiler()
+        self.assertRaises(RuntimeError, profiler.frame_end)
+
+        with profiler.span("outside"):
+            pass
+        profiler.frame_begin()
+        profiler.span("open").__enter__()
+        profiler.frame_end()
+
+        spans = profiler.get_frames()[0][1]
+        self.assertEqual([s[0] for s in spans], ["open"])
+        self.assertGreater(spans[0][3], 0.0)
+
+
 class TimeModuleTest(unittest.TestCase):
     __tags__ = ["timing"]
 
@@ -347,6 +497,25 @@ class TimeModuleTest(unittest.TestCase):
             self.assertEqual(pygame.event.get().count(e), repeat)
         pygame.quit()
 
+    def test_set_timer__many(self):
+        """Many timers with different delays each post their event once."""
+        pygame.init()
+        timer_types = [pygame.event.custom_type() for _ in range(200)]
+
+        pygame.event.clear()
+        for i, timer_type in enumerate(timer_types):
+            pygame.time.set_timer(timer_type, 10 + i % 50, loops=1)
+        # replacing a timer, or setting it to 0, leaves at most one
+        pygame.time.set_timer(timer_types[0], 30, loops=1)
+        pygame.time.set_timer(timer_types[1], 0)
+        pygame.time.delay(200)
+
+        posted = [event.type for event in pygame.event.get()]
+        for timer_type in timer_types[:1] + timer_types[2:]:
+            self.assertEqual(posted.count(timer_type), 1)
+        self.assertNotIn(timer_types[1], posted)
+        pygame.quit()
+
     def test_wait(self):
         """Tests time.wait() function."""
         millis = 100  # millisecond to wait on each iteration
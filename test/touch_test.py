@@ -36,6 +36,28 @@ class TouchTest(unittest.TestCase):
         self.assertRaises(TypeError, touch.get_num_fingers, "test")
         self.assertRaises(pygame.error, touch.get_num_fingers, -1234)
 
+    def test_get_fingers(self):
+        """Ensures get_fingers writes nothing for a device not there."""
+        import array
+
+        fingers = array.array("d", [-1.0] * 4 * 3)
+        self.assertEqual(touch.get_fingers(-1234, fingers), 0)
+        self.assertEqual(fingers.tolist(), [-1.0] * 4 * 3)
+
+        self.assertRaises(ValueError, touch.get_fingers, 0, array.array("d", [0.0] * 5))
+        self.assertRaises(ValueError, touch.get_fingers, 0, array.array("f", [0.0] * 4))
+        self.assertRaises(TypeError, touch.get_fingers, 0, bytes(32))
+
+    @unittest.skipIf(not has_touchdevice, "no touch devices found")
+    def test_get_fingers__device(self):
+        import array
+
+        touchid = touch.get_device(0)
+        fingers = array.array("d", [0.0] * 4 * 10)
+        count = touch.get_fingers(touchid, fingers)
+        self.assertGreaterEqual(count, 0)
+        self.assertLessEqual(count, 10)
+
 
 class TouchInteractiveTest(unittest.TestCase):
 
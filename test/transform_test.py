@@ -800,6 +800,99 @@ class TransformModuleTest(unittest.TestCase):
         self.assertEqual(s2.get_at((0, 31)), (255, 0, 0, 255))
         self.assertEqual(s2.get_at((31, 31)), (255, 0, 0, 255))
 
+    def test_laplacian__in_place(self):
+        for flags in (0, pygame.SRCALPHA):
+            surf = pygame.Surface((13, 7), flags, 32)
+            surf.fill((10, 10, 70))
+            pygame.draw.line(surf, (255, 0, 0), (0, 0), (12, 6))
+            expected = pygame.transform.laplacian(surf)
+
+            result = pygame.transform.laplacian(surf, surf)
+
+            self.assertIs(result, surf)
+            self.assertEqual(
+                pygame.image.tostring(surf, "RGBA"),
+                pygame.image.tostring(expected, "RGBA"),
+                flags,
+            )
+
+    def _step_surface(self, depth, vertical=False):
+        """a 16x6 surface, black before and white after the middle"""
+        surf = pygame.Surface((16, 6), 0, depth)
+        surf.fill((255, 255, 255), (0, 3, 16, 3) if vertical else (8, 0, 8, 6))
+        return surf
+
+    def test_sobel(self):
+        for edges in (pygame.transform.sobel, pygame.transform.scharr):
+            for depth in (32, 24):
+                surf = self._step_surface(depth)
+
+                result = edges(surf)
+
+                self.assertEqual(result.get_size(), surf.get_size())
+                for x in range(16):
+                    level = 255 if x in (7, 8) else 0
+                    self.assertEqual(
+                        result.get_at((x, 3)), (level, level, level, 255), x
+                    )
+
+    def test_sobel__direction(self):
+        for edges in (pygame.transform.sobel, pygame.transform.scharr):
+            across = edges(self._step_surface(32), "direction")
+            down = edges(self._step_surface(32, True), "direction")
+
+            self.assertEqual(across.get_at((8, 2)), (0, 0, 0, 255))
+            self.assertEqual(down.get_at((4, 3)), (64, 64, 64, 255))
+
+            upside_down = pygame.transform.flip(self._step_surface(32, True), 0, 1)
+            up = edges(upside_down, output="direction")
+            self.assertEqual(up.get_at((4, 2)), (192, 192, 192, 255))
+
+    def test_sobel__mask(self):
+        surf = self._step_surface(32)
+        surf.fill((128, 128, 128), (8, 0, 8, 3))
+
+        mask = pygame.transform.sobel(surf, "mask")
+        half = pygame.transform.sobel(surf, output="mask", threshold=200)
+
+        self.assertIsInstance(mask, pygame.mask.Mask)
+        self.assertEqual(mask.get_size(), surf.get_size())
+        self.assertEqual(mask.count(), 2 * 6)
+        self.assertEqual(mask.get_at((7, 0)), 1)
+        self.assertEqual(half.count(), 2 * 3)
+        self.assertEqual(half.get_at((8, 5)), 1)
+
+    def test_sobel__dest_surface(self):
+        surf = self._step_surface(32)
+        expected = pygame.transform.sobel(surf)
+        dest = pygame.Surface((16, 6), 0, 32)
+
+        self.assertIs(pygame.transform.sobel(surf, dest_surface=dest), dest)
+        self.assertEqual(
+            pygame.image.tostring(dest, "RGB"), pygame.image.tostring(expected, "RGB")
+        )
+
+        pygame.transform.sobel(surf, dest_surface=surf)
+        self.assertEqual(
+            pygame.image.tostring(surf, "RGB"), pygame.image.tostring(expected, "RGB")
+        )
+
+    def test_sobel__bad_args(self):
+        surf = self._step_surface(32)
+        sobel = pygame.transform.sobel
+
+        self.assertRaises(ValueError, sobel, surf, "gradient")
+        self.assertRaises(ValueError, sobel, surf, "mask", 256)
+        self.assertRaises(ValueError, sobel, surf, "mask", -1)
+        self.assertRaises(ValueError, sobel, pygame.Surface((4, 4), 0, 8))
+        self.assertRaises(ValueError, sobel, surf, "mask", 128, surf)
+        self.assertRaises(
+            ValueError, sobel, surf, dest_surface=pygame.Surface((4, 4), 0, 32)
+        )
+        self.assertRaises(
+            ValueError, sobel, surf, dest_surface=pygame.Surface((16, 6), 0, 24)
+        )
+
     def test_laplacian__24_big_endian(self):
         """ """
         pygame.display.init()
@@ -836,6 +929,163 @@ class TransformModuleTest(unittest.TestCase):
         finally:
             pygame.display.quit()
 
+    def test_box_blur(self):
+        """box_blur averages the square around each pixel."""
+        for depth in (24, 32):
+            s = pygame.Surface((21, 13), 0, depth)
+            s.fill((200, 100, 50))
+            for radius in (0, 1, 4, 30):
+                r = pygame.transform.box_blur(s, radius)
+                self.assertEqual(r.get_size(), s.get_size())
+                self.assertEqual(r.get_bitsize(), depth)
+                self.assertEqual(
+                    pygame.image.tostring(r, "RGB"), pygame.image.tostring(s, "RGB")
+                )
+
+            # edges count as zero unless they are repeated
+            r = pygame.transform.box_blur(s, 1, False)
+            self.assertEqual(r.get_at((10, 6)), (200, 100, 50, 255))
+            self.assertEqual(r.get_at((0, 6))[:3], (133, 67, 33))
+            self.assertEqual(r.get_at((0, 0))[:3], (89, 45, 22))
+
+        spot = pygame.Surface((9, 9), 0, 32)
+        spot.set_at((4, 4), (255, 255, 255))
+        r = pygame.transform.box_blur(spot, 1)
+        for x in range(9):
+            for y in range(9):
+                expected = 28 if 3 <= x <= 5 and 3 <= y <= 5 else 0
+                self.assertEqual(r.get_at((x, y))[0], expected)
+
+        # Also validate keyword arguments, and blurring in place
+        expected = pygame.image.tostring(pygame.transform.box_blur(spot, 2), "RGB")
+        r = pygame.transform.box_blur(
+            surface=spot, radius=2, repeat_edge_pixels=True, dest_surface=spot
+        )
+        self.assertIs(r, spot)
+        self.assertEqual(pygame.image.tostring(spot, "RGB"), expected)
+
+        self.assertRaises(ValueError, pygame.transform.box_blur, spot, -1)
+        self.assertRaises(ValueError, pygame.transform.box_blur, spot, 2048)
+        self.assertRaises(
+            ValueError, pygame.transform.box_blur, pygame.Surface((5, 5), 0, 8), 1
+        )
+        self.assertRaises(
+            ValueError,
+            pygame.transform.box_blur,
+            spot,
+            1,
+            True,
+            pygame.Surface((9, 8), 0, 32),
+        )
+
+    def test_gaussian_blur(self):
+        """gaussian_blur keeps flat areas flat and spreads out a spot."""
+        s = pygame.Surface((17, 11), SRCALPHA, 32)
+        s.fill((10, 120, 250, 128))
+        r = pygame.transform.gaussian_blur(s, 5)
+        self.assertEqual(
+            pygame.image.tostring(r, "RGBA"), pygame.image.tostring(s, "RGBA")
+        )
+
+        spot = pygame.Surface((15, 15), 0, 24)
+        spot.set_at((7, 7), (255, 255, 255))
+        r = pygame.transform.gaussian_blur(spot, 3)
+        centre = r.get_at((7, 7))[0]
+        self.assertLess(centre, 255)
+        for d in range(1, 4):
+            ring = [
+                r.get_at((7 + d, 7))[0],
+                r.get_at((7 - d, 7))[0],
+                r.get_at((7, 7 + d))[0],
+                r.get_at((7, 7 - d))[0],
+            ]
+            self.assertEqual(len(set(ring)), 1)
+            self.assertLessEqual(ring[0], centre)
+            centre = ring[0]
+        self.assertEqual(r.get_at((11, 7))[0], 0)
+        self.assertEqual(r.get_at((0, 0))[0], 0)
+
+        # a radius of 0 copies the surface
+        r = pygame.transform.gaussian_blur(spot, 0)
+        self.assertEqual(
+            pygame.image.tostring(r, "RGB"), pygame.image.tostring(spot, "RGB")
+        )
+
+    def test_convolve(self):
+        """convolve weighs the pixels around each pixel by the kernel."""
+        s = pygame.Surface((12, 10), 0, 32)
+        for x in range(12):
+            s.fill((x * 20, 255 - x * 20, 100), (x, 0, 1, 10))
+
+        identity = [[0, 0, 0], [0, 1, 0], [0, 0, 0]]
+        r = pygame.transform.convolve(s, identity)
+        self.assertEqual(
+            pygame.image.tostring(r, "RGB"), pygame.image.tostring(s, "RGB")
+        )
+
+        # the kernel is not flipped: a weight right of the centre reads the
+        # pixel to the right
+        r = pygame.transform.convolve(s, [[0, 0, 1]])
+        self.assertEqual(r.get_at((3, 5)), s.get_at((4, 5)))
+        self.assertEqual(r.get_at((11, 5)), s.get_at((11, 5)))
+        r = pygame.transform.convolve(s, [[0, 0, 1]], False)
+        self.assertEqual(r.get_at((11, 5))[:3], (0, 0, 0))
+
+        # a box kernel matches box_blur
+        box = [[1 / 9.0] * 3] * 3
+        flat = pygame.Surface((8, 8), 0, 24)
+        flat.fill((30, 60, 90))
+        r = pygame.transform.convolve(flat, box)
+        self.assertEqual(
+            pygame.image.tostring(r, "RGB"), pygame.image.tostring(flat, "RGB")
+        )
+
+        # results are clamped
+        r = pygame.transform.convolve(s, [[0, -1, 0], [-1, 5, -1], [0, -1, 0]])
+        self.assertEqual(r.get_at((5, 5)), s.get_at((5, 5)))
+        r = pygame.transform.convolve(s, [[3]])
+        self.assertEqual(r.get_at((11, 0))[:3], (255, 105, 255))
+
+        dest = pygame.Surface((12, 10), 0, 32)
+        r = pygame.transform.convolve(
+            surface=s, kernel=identity, repeat_edge_pixels=True, dest_surface=dest
+        )
+        self.assertIs(r, dest)
+
+        self.assertRaises(ValueError, pygame.transform.convolve, s, [[1, 1]])
+        self.assertRaises(ValueError, pygame.transform.convolve, s, [])
+        self.assertRaises(ValueError, pygame.transform.convolve, s, [[1], [1, 1, 1], [1]])
+        self.assertRaises(TypeError, pygame.transform.convolve, s, [[1, "x", 1]])
+        self.assertRaises(TypeError, pygame.transform.convolve, s, 5)
+        self.assertRaises(ValueError, pygame.transform.convolve, s, identity, True, s)
+
+    def test_blur__threaded(self):
+        """Threaded blurs give the same pixels as serial ones."""
+        src = pygame.Surface((600, 450), SRCALPHA, 32)
+        for x in range(0, 600, 5):
+            src.fill((x % 256, 255 - x % 256, (7 * x) % 256, x % 200), (x, 0, 5, 450))
+        src.fill((255, 255, 255, 255), (100, 50, 300, 20))
+
+        def run():
+            return [
+                pygame.transform.box_blur(src, 9),
+                pygame.transform.box_blur(src, 2, False),
+                pygame.transform.gaussian_blur(src, 6),
+                pygame.transform.convolve(src, [[1, -2, 1], [2, 0.5, -2], [1, 1, -1]]),
+            ]
+
+        original = pygame.get_num_threads()
+        serial = run()
+        try:
+            pygame.set_num_threads(4)
+            threaded = run()
+        finally:
+            pygame.set_num_threads(original)
+        for a, b in zip(serial, threaded):
+            self.assertEqual(
+                pygame.image.tostring(a, "RGBA"), pygame.image.tostring(b, "RGBA")
+            )
+
     def test_average_surfaces(self):
         """ """
 
@@ -1016,6 +1266,169 @@ class TransformModuleTest(unittest.TestCase):
         )
         self.assertEqual(avg_color, (10, 50, 100, 128))
 
+    def _striped_surface(self, size, flags=0, depth=32):
+        surf = pygame.Surface(size, flags, depth)
+        for x in range(0, size[0], 3):
+            surf.fill(
+                ((7 * x) % 256, (3 * x) % 256, 255 - x % 256, (11 * x) % 256),
+                (x, 0, 3, size[1]),
+            )
+        surf.fill((90, 180, 45, 200), (0, size[1] // 3, size[0], 17))
+        return surf
+
+    def _serial_and_threaded(self, func):
+        serial = func()
+        original = pygame.get_num_threads()
+        try:
+            pygame.set_num_threads(4)
+            threaded = func()
+        finally:
+            pygame.set_num_threads(original)
+        return serial, threaded
+
+    def test_average_color__threaded(self):
+        """Threaded and vectorised averages match the serial ones."""
+        for flags, depth in ((pygame.SRCALPHA, 32), (0, 32), (0, 24)):
+            surf = self._striped_surface((611, 403), flags, depth)
+
+            def averages():
+                return [
+                    pygame.transform.average_color(surf, rect, consider_alpha)
+                    for rect in (None, (5, 7, 598, 390), (1, 1, 3, 400))
+                    for consider_alpha in (False, True)
+                ]
+
+            serial, threaded = self._serial_and_threaded(averages)
+            self.assertEqual(serial, threaded)
+
+        surf = pygame.Surface((300, 300), pygame.SRCALPHA, 32)
+        surf.fill((10, 20, 30, 40))
+        surf.fill((50, 60, 70, 80), (0, 0, 150, 300))
+        # a width that is not a multiple of four leaves a scalar tail
+        self.assertEqual(
+            pygame.transform.average_color(surf, (0, 0, 151, 300)),
+            (49, 59, 69, 79),
+        )
+
+    def _expected_histogram(self, surf, channels, bins, rect=None):
+        rect = surf.get_rect().clip(rect or surf.get_rect())
+        counts = [[0] * bins for _ in channels]
+        for y in range(rect.top, rect.bottom):
+            for x in range(rect.left, rect.right):
+                r, g, b, a = surf.get_at((x, y))
+                values = {"r": r, "g": g, "b": b, "a": a}
+                values["l"] = (77 * r + 150 * g + 29 * b + 128) >> 8
+                for i, channel in enumerate(channels):
+                    counts[i][values[channel] * bins // 256] += 1
+        return tuple(counts)
+
+    def test_histogram(self):
+        for flags, depth in ((pygame.SRCALPHA, 32), (0, 32), (0, 24), (0, 16)):
+            surf = self._striped_surface((23, 7), flags, depth)
+
+            self.assertEqual(
+                pygame.transform.histogram(surf, "rgbal", 256),
+                self._expected_histogram(surf, "rgbal", 256),
+                depth,
+            )
+            self.assertEqual(
+                pygame.transform.histogram(surf, "lr", bins=5, rect=(3, 2, 30, 4)),
+                self._expected_histogram(surf, "lr", 5, (3, 2, 30, 4)),
+                depth,
+            )
+
+    def test_histogram__palette(self):
+        surf = pygame.Surface((9, 3), 0, 8)
+        surf.set_palette_at(1, (200, 100, 0))
+        surf.fill(1, (0, 0, 4, 3))
+
+        red, alpha = pygame.transform.histogram(surf, "ra")
+
+        self.assertEqual(red[200], 12)
+        self.assertEqual(red[0], 15)
+        self.assertEqual(alpha[255], 27)
+
+    def test_histogram__defaults(self):
+        surf = pygame.Surface((4, 4))
+        surf.fill((10, 20, 30))
+
+        result = pygame.transform.histogram(surf)
+
+        self.assertEqual(len(result), 3)
+        self.assertEqual([len(counts) for counts in result], [256] * 3)
+        self.assertEqual(result[0][10], 16)
+        self.assertEqual(result[2][30], 16)
+        self.assertEqual(
+            pygame.transform.histogram(surf, "r", 2, (10, 10, 5, 5)), ([0, 0],)
+        )
+
+    def test_histogram__bad_args(self):
+        surf = pygame.Surface((4, 4))
+        histogram = pygame.transform.histogram
+
+        self.assertRaises(ValueError, histogram, surf, "")
+        self.assertRaises(ValueError, histogram, surf, "rgbx")
+        self.assertRaises(ValueError, histogram, surf, "r", 0)
+        self.assertRaises(ValueError, histogram, surf, "r", 257)
+        self.assertRaises(TypeError, histogram, surf, "r", 4, "rect")
+
+    def test_histogram__threaded(self):
+        """Threaded histograms match the serial ones."""
+        surf = self._striped_surface((611, 403), pygame.SRCALPHA)
+
+        serial, threaded = self._serial_and_threaded(
+            lambda: pygame.transform.histogram(surf, "rgbal", 64)
+        )
+
+        self.assertEqual(serial, threaded)
+        self.assertEqual(sum(serial[4]), 611 * 403)
+
+    def test_threshold__threaded(self):
+        """Threaded and vectorised thresholds match the serial ones."""
+        surf = self._striped_surface((513, 387))
+        search = self._striped_surface((513, 387))
+        search.fill((0, 0, 0), (100, 100, 50, 50))
+
+        def thresholds():
+            results = []
+            for set_behavior, inverse_set in ((1, 0), (1, 1), (2, 0)):
+                dest = pygame.Surface(surf.get_size(), 0, 32)
+                dest.fill((1, 2, 3))
+                count = pygame.transform.threshold(
+                    dest,
+                    surf,
+                    (100, 100, 100) if set_behavior != 2 else (0, 255, 0),
+                    (60, 60, 60),
+                    (255, 0, 255) if set_behavior == 1 else None,
+                    set_behavior,
+                    None,
+                    inverse_set,
+                )
+                results.append((count, pygame.image.tostring(dest, "RGB")))
+            count = pygame.transform.threshold(
+                None, surf, None, (5, 5, 5), None, 0, search
+            )
+            results.append((count, None))
+            return results
+
+        serial, threaded = self._serial_and_threaded(thresholds)
+        self.assertEqual(serial, threaded)
+        self.assertEqual(serial[-1][0], 513 * 387 - 50 * 50)
+
+    def test_average_surfaces__threaded(self):
+        """Threaded average_surfaces matches the serial one."""
+        surfaces = [self._striped_surface((400, 257)) for _ in range(3)]
+        surfaces[1].fill((255, 255, 255), (0, 0, 200, 257))
+        surfaces[2].scroll(17, 0)
+
+        serial, threaded = self._serial_and_threaded(
+            lambda: pygame.transform.average_surfaces(surfaces)
+        )
+        self.assertEqual(
+            pygame.image.tostring(serial, "RGB"),
+            pygame.image.tostring(threaded, "RGB"),
+        )
+
     def test_rotate(self):
         # setting colors and canvas
         blue = (0, 0, 255, 255)
@@ -1067,6 +1480,63 @@ class TransformModuleTest(unittest.TestCase):
         for pt, color in gradient:
             self.assertTrue(s.get_at(pt) == color)
 
+    def test_rotate__quarter_turns(self):
+        """Tiled quarter turns put every pixel where a plain turn would."""
+        for depth in (8, 16, 24, 32):
+            big = pygame.Surface((45, 38), 0, depth)
+            for x in range(45):
+                for y in range(38):
+                    big.set_at((x, y), ((x * 37) % 256, (y * 53) % 256, x ^ y))
+            # a subsurface has a pitch wider than its rows
+            s = big.subsurface((1, 2, 41, 35))
+            w, h = s.get_size()
+            expected = {
+                90: lambda x, y: s.get_at((w - 1 - y, x)),
+                -90: lambda x, y: s.get_at((y, h - 1 - x)),
+                180: lambda x, y: s.get_at((w - 1 - x, h - 1 - y)),
+            }
+
+            for angle, source in expected.items():
+                r = pygame.transform.rotate(s, angle)
+                self.assertEqual(
+                    r.get_size(), (h, w) if angle % 180 else (w, h), angle
+                )
+                for y in range(r.get_height()):
+                    for x in range(r.get_width()):
+                        self.assertEqual(
+                            r.get_at((x, y)), source(x, y), (depth, angle, x, y)
+                        )
+
+    def test_rotate__large_surface(self):
+        """Rotating a surface spanning several tiles leaves no seams."""
+        fill = (10, 200, 30, 255)
+        key = (255, 0, 255, 255)
+
+        for depth in (8, 16, 24, 32):
+            flags = pygame.SRCALPHA if depth == 32 else 0
+            s = pygame.Surface((101, 75), flags, depth)
+            s.fill(fill)
+            fill_color = s.get_at((0, 0))
+            # rotate() pads with the colorkey
+            s.set_colorkey(key)
+
+            r = pygame.transform.rotate(s, 30)
+            w, h = r.get_size()
+            bg_color = r.get_at((0, 0))
+
+            self.assertNotEqual(bg_color, fill_color)
+            self.assertEqual(r.get_at((w // 2, h // 2)), fill_color)
+            for y in range(h):
+                row = [r.get_at((x, y)) == fill_color for x in range(w)]
+                for x in range(w):
+                    if not row[x]:
+                        self.assertEqual(r.get_at((x, y)), bg_color)
+                # the filled pixels of each row form a single span
+                if True in row:
+                    start = row.index(True)
+                    end = w - row[::-1].index(True)
+                    self.assertTrue(all(row[start:end]), (depth, y))
+
     def test_scale2x(self):
 
         # __doc__ (as of 2008-06-25) for pygame.transform.scale2x:
@@ -1100,9 +1570,118 @@ class TransformModuleTest(unittest.TestCase):
         for pt in test_utils.rect_area_pts(s2_2.get_rect()):
             self.assertEqual(s2_2.get_at(pt), s4.get_at(pt))
 
+    def _epx_surface(self, size, depth):
+        """a surface of a few colors in blocks and lines, for Scale2x/3x"""
+        w, h = size
+        s = pygame.Surface(size, 0, depth)
+        s.fill((0, 0, 0))
+        pygame.draw.circle(s, (255, 0, 0), (w // 2, h // 2), min(w, h) // 3)
+        pygame.draw.line(s, (0, 255, 0), (0, h - 1), (w - 1, 0))
+        pygame.draw.rect(s, (0, 0, 255), (1, 1, w // 4, h // 4), 1)
+        return s
+
+    def test_scale2x__pixels(self):
+        """Ensure scale2x gives the AdvanceMAME Scale2x pixels, on rows long
+        enough to be done several pixels at a time."""
+        for depth in (8, 16, 24, 32):
+            s = self._epx_surface((21, 9), depth)
+            w, h = s.get_size()
+            p = lambda x, y: s.get_at_mapped(
+                (min(w - 1, max(0, x)), min(h - 1, max(0, y)))
+            )
+            d = pygame.transform.scale2x(s)
+            for y in range(h):
+                for x in range(w):
+                    B, D, E = p(x, y - 1), p(x - 1, y), p(x, y)
+                    F, H = p(x + 1, y), p(x, y + 1)
+                    expected = [
+                        D if D == B and B != F and D != H else E,
+                        F if B == F and B != D and F != H else E,
+                        D if D == H and D != B and H != F else E,
+                        F if H == F and D != H and B != F else E,
+                    ]
+                    got = [
+                        d.get_at_mapped((2 * x, 2 * y)),
+                        d.get_at_mapped((2 * x + 1, 2 * y)),
+                        d.get_at_mapped((2 * x, 2 * y + 1)),
+                        d.get_at_mapped((2 * x + 1, 2 * y + 1)),
+                    ]
+                    self.assertEqual(got, expected, (depth, x, y))
+
+    def test_scale3x(self):
+        """Ensure scale3x gives the AdvanceMAME Scale3x pixels."""
+        for depth in (8, 16, 24, 32):
+            s = self._epx_surface((21, 9), depth)
+            w, h = s.get_size()
+            p = lambda x, y: s.get_at_mapped(
+                (min(w - 1, max(0, x)), min(h - 1, max(0, y)))
+            )
+            d = pygame.transform.scale3x(s)
+            self.assertEqual(d.get_size(), (w * 3, h * 3))
+            for y in range(h):
+                for x in range(w):
+                    A, B, C = p(x - 1, y - 1), p(x, y - 1), p(x + 1, y - 1)
+                    D, E, F = p(x - 1, y), p(x, y), p(x + 1, y)
+                    G, H, I = p(x - 1, y + 1), p(x, y + 1), p(x + 1, y + 1)
+                    c0 = D == B and B != F and D != H
+                    c2 = B == F and B != D and F != H
+                    c6 = D == H and D != B and H != F
+                    c8 = H == F and D != H and B != F
+                    expected = [
+                        D if c0 else E,
+                        B if (c0 and E != C) or (c2 and E != A) else E,
+                        F if c2 else E,
+                        D if (c0 and E != G) or (c6 and E != A) else E,
+                        E,
+                        F if (c2 and E != I) or (c8 and E != C) else E,
+                        D if c6 else E,
+                        H if (c6 and E != I) or (c8 and E != G) else E,
+                        F if c8 else E,
+                    ]
+                    got = [
+                        d.get_at_mapped((3 * x + i, 3 * y + j))
+                        for j in range(3)
+                        for i in range(3)
+                    ]
+                    self.assertEqual(got, expected, (depth, x, y))
+
+        dest = pygame.Surface((63, 27), 0, 32)
+        self.assertIs(pygame.transform.scale3x(s, dest_surface=dest), dest)
+        self.assertRaises(
+            ValueError, pygame.transform.scale3x, s, pygame.Surface((62, 27), 0, 32)
+        )
+
+    def test_scale_by_int(self):
+        """Ensure scale_by_int repeats each pixel into a factor by factor
+        block, as scale does."""
+        for depth in (8, 16, 24, 32):
+            s = self._epx_surface((13, 7), depth)
+            w, h = s.get_size()
+            for factor in (1, 2, 3, 4, 5, 9):
+                d = pygame.transform.scale_by_int(s, factor)
+                scaled = pygame.transform.scale(s, (w * factor, h * factor))
+                self.assertEqual(d.get_size(), (w * factor, h * factor))
+                for y in range(h * factor):
+                    for x in range(w * factor):
+                        expected = s.get_at_mapped((x // factor, y // factor))
+                        self.assertEqual(
+                            d.get_at_mapped((x, y)), expected, (depth, factor, x, y)
+                        )
+                        self.assertEqual(scaled.get_at_mapped((x, y)), expected)
+
+        dest = pygame.Surface((26, 14), 0, s)
+        self.assertIs(pygame.transform.scale_by_int(s, 2, dest_surface=dest), dest)
+        pooled = pygame.transform.scale_by_int(s, 2, pool=pygame.SurfacePool())
+        self.assertEqual(pooled.get_size(), (26, 14))
+        self.assertRaises(ValueError, pygame.transform.scale_by_int, s, 0)
+        self.assertRaises(ValueError, pygame.transform.scale_by_int, s, 3, dest)
+        self.assertEqual(
+            pygame.transform.scale_by_int(pygame.Surface((0, 4)), 3).get_size(), (0, 12)
+        )
+
     def test_get_smoothscale_backend(self):
         filter_type = pygame.transform.get_smoothscale_backend()
-        self.assertTrue(filter_type in ["GENERIC", "MMX", "SSE"])
+        self.assertTrue(filter_type in ["GENERIC", "SSE2", "NEON", "MMX", "SSE"])
         # It would be nice to test if a non-generic type corresponds to an x86
         # processor. But there is no simple test for this. platform.machine()
         # returns process version specific information, like 'i686'.
@@ -1132,16 +1711,45 @@ class TransformModuleTest(unittest.TestCase):
 
         self.assertRaises(TypeError, change)
         # Unsupported type, if possible.
-        if original_type != "SSE":
+        unsupported = {"SSE2": "NEON", "NEON": "SSE2", "GENERIC": "SSE"}
+        if original_type in unsupported:
 
             def change():
-                pygame.transform.set_smoothscale_backend("SSE")
+                pygame.transform.set_smoothscale_backend(unsupported[original_type])
 
             self.assertRaises(ValueError, change)
         # Should be back where we started.
         filter_type = pygame.transform.get_smoothscale_backend()
         self.assertEqual(filter_type, original_type)
 
+    def test_smoothscale_backends_match_generic(self):
+        """Every backend gives the same pixels as GENERIC"""
+        original_type = pygame.transform.get_smoothscale_backend()
+        source = pygame.Surface((53, 37), pygame.SRCALPHA, 32)
+        for x in range(53):
+            for y in range(37):
+                source.set_at((x, y), ((x * 7) % 256, (y * 13) % 256, x ^ y, 200))
+        sizes = [(20, 15), (140, 90), (20, 90), (140, 15), (53, 37), (1, 1)]
+
+        def scale_all(backend):
+            pygame.transform.set_smoothscale_backend(backend)
+            smoothscale = pygame.transform.smoothscale
+            return [
+                pygame.image.tostring(smoothscale(source, size), "RGBA")
+                for size in sizes
+            ]
+
+        try:
+            expected = scale_all("GENERIC")
+            for backend in ["SSE2", "NEON"]:
+                try:
+                    results = scale_all(backend)
+                except ValueError:
+                    continue
+                self.assertEqual(results, expected, backend)
+        finally:
+            pygame.transform.set_smoothscale_backend(original_type)
+
     def test_chop(self):
         original_surface = pygame.Surface((20, 20))
         pygame.draw.rect(original_surface, (255, 0, 0), (0, 0, 10, 10))
@@ -1203,6 +1811,95 @@ class TransformModuleTest(unittest.TestCase):
         rect = pygame.Rect(400, 400, 10, 10)
         test_surface = pygame.transform.chop(original_surface, rect)
         self.assertEqual(test_surface.get_size(), (20, 20))
+        # Test a rect sticking out on both sides of the surface
+        rect = pygame.Rect(-5, 0, 40, 5)
+        test_surface = pygame.transform.chop(original_surface, rect)
+        self.assertEqual(test_surface.get_size(), (0, 15))
+
+    def test_chop__large(self):
+        """Chopping a surface big enough to be split across threads"""
+        for depth in (8, 24, 32):
+            surf = pygame.Surface((300, 280), 0, depth)
+            for y in range(0, 280, 7):
+                for x in range(0, 300, 10):
+                    surf.fill(((x * 3) % 256, (y * 5) % 256, 90), (x, y, 10, 7))
+            rect = pygame.Rect(40, 100, 33, 21)
+
+            chopped = pygame.transform.chop(surf, rect)
+
+            self.assertEqual(chopped.get_size(), (267, 259))
+            for y in range(0, 259, 13):
+                for x in range(0, 267, 11):
+                    src_x = x if x < 40 else x + 33
+                    src_y = y if y < 100 else y + 21
+                    self.assertEqual(
+                        chopped.get_at((x, y)), surf.get_at((src_x, src_y))
+                    )
+
+    def _sheet(self, depth=32):
+        """a 5x3 sheet of 4x6 cells, with a strip left over on each side"""
+        sheet = pygame.Surface((22, 20), 0, depth)
+        for row in range(3):
+            for column in range(5):
+                sheet.fill((column * 50, row * 80, 30), (column * 4, row * 6, 4, 6))
+                sheet.set_at((column * 4 + 1, row * 6 + 2), (255, 255, 255))
+        return sheet
+
+    def test_split_grid(self):
+        for depth in (8, 16, 24, 32):
+            sheet = self._sheet(depth)
+
+            cells = pygame.transform.split_grid(sheet, (4, 6))
+
+            self.assertEqual(len(cells), 15)
+            for i, cell in enumerate(cells):
+                self.assertEqual(cell.get_size(), (4, 6))
+                self.assertEqual(cell.get_bitsize(), depth)
+                expected = sheet.subsurface(((i % 5) * 4, (i // 5) * 6, 4, 6))
+                for y in range(6):
+                    for x in range(4):
+                        self.assertEqual(
+                            cell.get_at((x, y)), expected.get_at((x, y)), (depth, i)
+                        )
+
+    def test_split_grid__as_atlas(self):
+        sheet = self._sheet()
+
+        atlas, rects = pygame.transform.split_grid(sheet, (4, 6), as_atlas=True)
+
+        self.assertEqual(atlas.get_size(), (4, 90))
+        self.assertEqual(rects, [pygame.Rect(0, i * 6, 4, 6) for i in range(15)])
+        for i, rect in enumerate(rects):
+            expected = sheet.subsurface(((i % 5) * 4, (i // 5) * 6, 4, 6))
+            for y in range(6):
+                for x in range(4):
+                    self.assertEqual(
+                        atlas.get_at((rect.x + x, rect.y + y)), expected.get_at((x, y))
+                    )
+
+    def test_split_grid__keeps_colorkey(self):
+        sheet = self._sheet()
+        sheet.set_colorkey((255, 255, 255))
+
+        cells = pygame.transform.split_grid(sheet, (11, 10))
+
+        self.assertEqual(len(cells), 4)
+        self.assertEqual(cells[0].get_colorkey(), (255, 255, 255, 255))
+
+    def test_split_grid__large_cells(self):
+        sheet = self._sheet()
+
+        self.assertEqual(pygame.transform.split_grid(sheet, (23, 6)), [])
+        atlas, rects = pygame.transform.split_grid(sheet, (22, 21), True)
+        self.assertEqual(atlas.get_size(), (22, 0))
+        self.assertEqual(rects, [])
+
+    def test_split_grid__bad_args(self):
+        sheet = self._sheet()
+
+        self.assertRaises(ValueError, pygame.transform.split_grid, sheet, (0, 6))
+        self.assertRaises(ValueError, pygame.transform.split_grid, sheet, (4, -1))
+        self.assertRaises(TypeError, pygame.transform.split_grid, sheet, 4)
 
     def test_rotozoom(self):
 
@@ -1227,6 +1924,80 @@ class TransformModuleTest(unittest.TestCase):
         self.assertEqual(s1.get_rect(), pygame.Rect(0, 0, 0, 0))
         self.assertEqual(s2.get_rect(), pygame.Rect(0, 0, 0, 0))
 
+    def test_rotozoom__threaded(self):
+        """Threaded rotozoom gives the same pixels as a serial one."""
+        surf = pygame.Surface((400, 300), pygame.SRCALPHA, 32)
+        for x in range(0, 400, 5):
+            surf.fill((x % 256, 255 - x % 256, (3 * x) % 256, 200), (x, 0, 5, 300))
+        surf.fill((20, 40, 60, 255), (0, 120, 400, 33))
+
+        args = ((30, 1.0), (-100, 1.7), (0, 2.5), (0, 1.3), (215, 0.9))
+        serial = [pygame.transform.rotozoom(surf, *a) for a in args]
+
+        original = pygame.get_num_threads()
+        try:
+            pygame.set_num_threads(4)
+            threaded = [pygame.transform.rotozoom(surf, *a) for a in args]
+        finally:
+            pygame.set_num_threads(original)
+
+        for a, b in zip(serial, threaded):
+            self.assertEqual(a.get_size(), b.get_size())
+            self.assertEqual(
+                pygame.image.tostring(a, "RGBA"),
+                pygame.image.tostring(b, "RGBA"),
+            )
+
+    def test_rotozoom__uniform(self):
+        """Filtering a single colour gives back that colour."""
+        surf = pygame.Surface((37, 23), pygame.SRCALPHA, 32)
+        surf.fill((201, 13, 77, 130))
+
+        for angle, scale in ((0, 3.0), (0, 0.6), (33, 1.0), (90, 2.0)):
+            result = pygame.transform.rotozoom(surf, angle, scale)
+            w, h = result.get_size()
+            # the centre is inside the source for every angle
+            self.assertEqual(result.get_at((w // 2, h // 2)), (201, 13, 77, 130))
+
+    def test_affine(self):
+        """Right-angle and identity matrices move whole pixels."""
+        surf = pygame.Surface((7, 5), pygame.SRCALPHA, 32)
+        for x in range(7):
+            for y in range(5):
+                surf.set_at((x, y), (x * 30, y * 50, 90, 255))
+
+        for smooth in (False, True):
+            same = pygame.transform.affine(surf, (1, 0, 0, 0, 1, 0), smooth=smooth)
+            self.assertEqual(same.get_size(), (7, 5))
+            self.assertEqual(
+                pygame.image.tostring(same, "RGBA"),
+                pygame.image.tostring(surf, "RGBA"),
+            )
+
+            turned = pygame.transform.affine(
+                surf, pygame.math.Affine2.rotation(90), smooth=smooth
+            )
+            self.assertEqual(turned.get_size(), (5, 7))
+            for x in range(7):
+                for y in range(5):
+                    self.assertEqual(turned.get_at((4 - y, x)), surf.get_at((x, y)))
+
+    def test_affine__size(self):
+        surf = pygame.Surface((10, 10), pygame.SRCALPHA, 32)
+        surf.fill((10, 20, 30, 255))
+
+        moved = pygame.transform.affine(surf, (1, 0, 5, 0, 1, 0), size=(20, 10))
+        self.assertEqual(moved.get_size(), (20, 10))
+        self.assertEqual(moved.get_at((2, 5)), (0, 0, 0, 0))
+        self.assertEqual(moved.get_at((10, 5)), (10, 20, 30, 255))
+
+        with self.assertRaises(ValueError):
+            pygame.transform.affine(surf, (1, 0, 0, 2, 0, 0))
+        with self.assertRaises(ValueError):
+            pygame.transform.affine(surf, (1, 0, 0, 0, 1))
+        with self.assertRaises(TypeError):
+            pygame.transform.affine(surf, (1, 0, 0, 0, 1, "0"))
+
     def test_smoothscale(self):
         """Tests the stated boundaries, sizing, and color blending of smoothscale function"""
         # __doc__ (as of 2008-08-02) for pygame.transform.smoothscale:
@@ -1293,6 +2064,355 @@ class TransformModuleTest(unittest.TestCase):
             )
             self.assertEqual(smaller_surface.get_size(), (k, 1))
 
+    def test_smoothscale__threaded(self):
+        """Threaded smoothscale gives the same pixels as a serial one."""
+        src = pygame.Surface((700, 500), 0, 32)
+        for x in range(0, 700, 7):
+            src.fill((x % 256, 255 - x % 256, (3 * x) % 256), (x, 0, 7, 500))
+        src.fill((20, 40, 60), (0, 200, 700, 45))
+
+        sizes = ((1001, 655), (333, 201), (1100, 300), (250, 777))
+        for depth in (24, 32):
+            surf = pygame.Surface(src.get_size(), 0, depth)
+            surf.blit(src, (0, 0))
+            serial = [pygame.transform.smoothscale(surf, s) for s in sizes]
+
+            original = pygame.get_num_threads()
+            try:
+                pygame.set_num_threads(4)
+                threaded = [pygame.transform.smoothscale(surf, s) for s in sizes]
+            finally:
+                pygame.set_num_threads(original)
+
+            for a, b in zip(serial, threaded):
+                self.assertEqual(
+                    pygame.image.tostring(a, "RGB"),
+                    pygame.image.tostring(b, "RGB"),
+                )
+
+
+    def test_resample(self):
+        """Resampling keeps flat areas flat and interpolates edges."""
+        for depth in (24, 32):
+            s = pygame.Surface((37, 23), 0, depth)
+            s.fill((10, 120, 250))
+            for filter in ("bilinear", "bicubic", "lanczos"):
+                for size in ((100, 61), (9, 5), (37, 50), (80, 23)):
+                    r = pygame.transform.resample(s, size, filter)
+                    self.assertEqual(r.get_size(), size)
+                    self.assertEqual(r.get_bitsize(), depth)
+                    for pt in ((0, 0), (size[0] - 1, size[1] - 1)):
+                        self.assertEqual(r.get_at(pt), (10, 120, 250, 255))
+
+        two_pixel_surface = pygame.Surface((2, 1), 0, 32)
+        two_pixel_surface.fill((0, 0, 0), (0, 0, 1, 1))
+        two_pixel_surface.fill((200, 200, 200), (1, 0, 1, 1))
+        r = pygame.transform.resample(two_pixel_surface, (4, 1), "bilinear")
+        self.assertEqual([r.get_at((x, 0))[0] for x in range(4)], [0, 50, 150, 200])
+
+        # Also validate keyword arguments
+        dest = pygame.Surface((4, 1), 0, 32)
+        r = pygame.transform.resample(
+            surface=two_pixel_surface, size=(4, 1), filter="lanczos", dest_surface=dest
+        )
+        self.assertIs(r, dest)
+
+        # default filter is bicubic
+        self.assertEqual(
+            pygame.image.tostring(pygame.transform.resample(s, (50, 50)), "RGB"),
+            pygame.image.tostring(
+                pygame.transform.resample(s, (50, 50), "bicubic"), "RGB"
+            ),
+        )
+
+    def test_resample__bad_args(self):
+        s = pygame.Surface((20, 20), 0, 32)
+        self.assertRaises(ValueError, pygame.transform.resample, s, (10, 10), "box")
+        self.assertRaises(ValueError, pygame.transform.resample, s, (-1, 10))
+        self.assertRaises(
+            ValueError, pygame.transform.resample, pygame.Surface((20, 20), 0, 8), (5, 5)
+        )
+        self.assertRaises(
+            ValueError,
+            pygame.transform.resample,
+            s,
+            (10, 10),
+            "bicubic",
+            pygame.Surface((11, 10), 0, 32),
+        )
+        self.assertRaises(
+            ValueError,
+            pygame.transform.resample,
+            s,
+            (10, 10),
+            "bicubic",
+            pygame.Surface((10, 10), 0, 24),
+        )
+        self.assertEqual(pygame.transform.resample(s, (0, 5)).get_size(), (0, 5))
+
+    def test_resample__threaded(self):
+        """Threaded resample gives the same pixels as a serial one."""
+        src = pygame.Surface((600, 450), SRCALPHA, 32)
+        for x in range(0, 600, 5):
+            src.fill((x % 256, 255 - x % 256, (7 * x) % 256, x % 200), (x, 0, 5, 450))
+
+        original = pygame.get_num_threads()
+        for size in ((901, 700), (210, 130)):
+            serial = pygame.transform.resample(src, size, "lanczos")
+            try:
+                pygame.set_num_threads(4)
+                threaded = pygame.transform.resample(src, size, "lanczos")
+            finally:
+                pygame.set_num_threads(original)
+            self.assertEqual(
+                pygame.image.tostring(serial, "RGBA"),
+                pygame.image.tostring(threaded, "RGBA"),
+            )
+
+
+    def test_rotation_cache(self):
+        """RotationCache steps match rotate() at the step angles."""
+        s = pygame.Surface((30, 17), SRCALPHA, 32)
+        s.fill((200, 30, 40, 255))
+        s.fill((0, 90, 250, 128), (4, 3, 10, 9))
+
+        cache = pygame.transform.RotationCache(s, steps=8)
+        self.assertEqual(cache.steps, 8)
+        self.assertFalse(cache.smooth)
+        self.assertIsNone(cache.atlas)
+
+        for angle, step_angle in ((0, 0), (44, 45), (-44, 315), (370, 0), (90, 90)):
+            frame = cache.get(angle)
+            expected = pygame.transform.rotate(s, step_angle)
+            self.assertEqual(frame.get_size(), expected.get_size())
+            self.assertEqual(
+                pygame.image.tostring(frame, "RGBA"),
+                pygame.image.tostring(expected, "RGBA"),
+            )
+            self.assertIs(frame.get_parent(), cache.atlas)
+
+        # lookups of a rendered step give back the same surface
+        self.assertIs(cache.get(45), cache.get(46))
+
+        cache.render_all()
+        for i in range(8):
+            self.assertIs(cache.get(i * 45).get_parent(), cache.atlas)
+
+    def test_rotation_cache__smooth(self):
+        s = pygame.Surface((20, 20), 0, 24)
+        s.fill((10, 200, 30))
+        cache = pygame.transform.RotationCache(surface=s, steps=6, smooth=True)
+        self.assertTrue(cache.smooth)
+
+        frame = cache.get(60)
+        expected = pygame.transform.rotozoom(s, 60, 1)
+        self.assertEqual(frame.get_size(), expected.get_size())
+        self.assertEqual(
+            pygame.image.tostring(frame, "RGBA"),
+            pygame.image.tostring(expected, "RGBA"),
+        )
+
+    def test_rotation_cache__bad_args(self):
+        s = pygame.Surface((8, 8))
+        self.assertRaises(ValueError, pygame.transform.RotationCache, s, 0)
+        self.assertRaises(TypeError, pygame.transform.RotationCache, "surface")
+        self.assertRaises(TypeError, pygame.transform.RotationCache(s).get, "90")
+
+    def _keyed_surface(self, flags=0, depth=32):
+        """a 13x5 surface with every third column the colorkey"""
+        surf = pygame.Surface((13, 5), flags, depth)
+        surf.fill((10, 20, 30, 100))
+        for x in range(0, 13, 3):
+            surf.fill((255, 0, 255), (x, 0, 1, 5))
+        surf.set_colorkey((255, 0, 255))
+        return surf
+
+    def test_colorkey_to_alpha(self):
+        for depth in (32, 24, 16, 8):
+            surf = self._keyed_surface(depth=depth)
+            result = pygame.transform.colorkey_to_alpha(surf)
+
+            self.assertEqual(result.get_size(), surf.get_size())
+            self.assertTrue(result.get_flags() & pygame.SRCALPHA, depth)
+            self.assertIsNone(result.get_colorkey())
+            for x in range(13):
+                color = result.get_at((x, 2))
+                if x % 3:
+                    expected = tuple(surf.get_at((x, 2)))[:3] + (255,)
+                    self.assertEqual(tuple(color), expected, (depth, x))
+                else:
+                    self.assertEqual(color.a, 0, (depth, x))
+
+    def test_colorkey_to_alpha__in_place(self):
+        surf = self._keyed_surface(pygame.SRCALPHA)
+
+        result = pygame.transform.colorkey_to_alpha(surf, dest_surface=surf)
+
+        self.assertIs(result, surf)
+        self.assertIsNone(surf.get_colorkey())
+        self.assertEqual(surf.get_at((0, 0)), (255, 0, 255, 0))
+        self.assertEqual(surf.get_at((1, 0)), (10, 20, 30, 100))
+
+    def test_colorkey_to_alpha__no_colorkey(self):
+        surf = pygame.Surface((6, 2))
+        surf.fill((255, 0, 255))
+
+        result = pygame.transform.colorkey_to_alpha(surf)
+
+        self.assertEqual(result.get_at((5, 1)), (255, 0, 255, 255))
+
+    def test_colorkey_to_alpha__bad_dest(self):
+        surf = self._keyed_surface()
+        colorkey_to_alpha = pygame.transform.colorkey_to_alpha
+
+        self.assertRaises(
+            ValueError, colorkey_to_alpha, surf, pygame.Surface((5, 5), 0, 32)
+        )
+        self.assertRaises(
+            ValueError, colorkey_to_alpha, surf, pygame.Surface((13, 5), 0, 32)
+        )
+        self.assertRaises(
+            ValueError, colorkey_to_alpha, self._keyed_surface(depth=16), surf
+        )
+
+    def test_alpha_to_colorkey(self):
+        surf = pygame.Surface((13, 5), pygame.SRCALPHA, 32)
+        for x in range(13):
+            surf.fill((10, x, 30, x * 20), (x, 0, 1, 5))
+
+        result = pygame.transform.alpha_to_colorkey(surf)
+
+        self.assertEqual(result.get_bitsize(), 32)
+        self.assertFalse(result.get_flags() & pygame.SRCALPHA)
+        self.assertEqual(result.get_colorkey(), (255, 0, 255, 255))
+        for x in range(13):
+            if x * 20 < 128:
+                expected = (255, 0, 255, 255)
+            else:
+                expected = (10, x, 30, 255)
+            self.assertEqual(result.get_at((x, 4)), expected, x)
+
+        result = pygame.transform.alpha_to_colorkey(
+            surf, threshold=200, colorkey=(0, 255, 0)
+        )
+        self.assertEqual(result.get_colorkey(), (0, 255, 0, 255))
+        self.assertEqual(result.get_at((9, 0)), (0, 255, 0, 255))
+        self.assertEqual(result.get_at((10, 0)), (10, 10, 30, 255))
+
+    def test_alpha_to_colorkey__round_trip(self):
+        surf = self._keyed_surface()
+        alpha = pygame.transform.colorkey_to_alpha(surf)
+
+        keyed = pygame.transform.alpha_to_colorkey(alpha, colorkey=(0, 0, 0))
+        back = pygame.transform.colorkey_to_alpha(keyed)
+
+        self.assertEqual(
+            pygame.image.tostring(back, "RGBA")[3::4],
+            pygame.image.tostring(alpha, "RGBA")[3::4],
+        )
+
+    def test_alpha_to_colorkey__bad_args(self):
+        alpha_to_colorkey = pygame.transform.alpha_to_colorkey
+        surf = pygame.Surface((4, 4), pygame.SRCALPHA, 32)
+
+        self.assertRaises(ValueError, alpha_to_colorkey, pygame.Surface((4, 4)))
+        self.assertRaises(ValueError, alpha_to_colorkey, surf, -1)
+        self.assertRaises(ValueError, alpha_to_colorkey, surf, 257)
+        self.assertRaises(ValueError, alpha_to_colorkey, surf, colorkey="nope")
+
+    def _lights_scene(self, size, flags=0):
+        scene = pygame.Surface(size, flags, 32)
+        for y in range(0, size[1], 5):
+            for x in range(0, size[0], 7):
+                scene.fill(((x * 3) % 256, (y * 5) % 256, 200, 150), (x, y, 7, 5))
+        return scene
+
+    def _lights(self):
+        lights = []
+        for i, (size, depth) in enumerate(
+            (((40, 30), 32), ((25, 60), 24), ((90, 20), 32), ((10, 10), 32))
+        ):
+            light = pygame.Surface(size, 0, depth)
+            light.fill((60 + i * 40, 120, 200 - i * 30))
+            light.fill((255, 255, 255), (2, 2, 5, 5))
+            lights.append(light)
+        positions = [(-10, -5), (50, 40), pygame.Rect(30, 90, 1, 1), (500, 0)]
+        return list(zip(lights, positions))
+
+    def _lit_by_blits(self, scene, ambient, lights):
+        """the scene lit with a light map and BLEND_ADD and BLEND_MULT blits"""
+        lightmap = pygame.Surface(scene.get_size(), 0, 32)
+        lightmap.fill(ambient)
+        for light, pos in lights:
+            lightmap.blit(light, pos, special_flags=pygame.BLEND_ADD)
+        lit = scene.copy()
+        lit.blit(lightmap, (0, 0), special_flags=pygame.BLEND_MULT)
+        return lit
+
+    def test_compose_lights(self):
+        for size in ((100, 100), (300, 280)):
+            scene = self._lights_scene(size)
+            lights = self._lights()
+            expected = self._lit_by_blits(scene, (30, 40, 50), lights)
+
+            result = pygame.transform.compose_lights(scene, (30, 40, 50), lights)
+
+            self.assertIs(result, scene)
+            for y in range(0, size[1], 3):
+                for x in range(0, size[0], 3):
+                    self.assertEqual(
+                        scene.get_at((x, y)), expected.get_at((x, y)), (x, y)
+                    )
+
+    def test_compose_lights__dest_surface(self):
+        scene = self._lights_scene((70, 50), pygame.SRCALPHA)
+        original = scene.copy()
+        dest = pygame.Surface((70, 50), pygame.SRCALPHA, 32)
+        light = pygame.Surface((20, 20), 0, 32)
+        light.fill((100, 0, 50))
+
+        result = pygame.transform.compose_lights(
+            scene, (128, 255, 0), [(light, (10, 10))], dest_surface=dest
+        )
+
+        self.assertIs(result, dest)
+        self.assertEqual(scene.get_at((15, 15)), original.get_at((15, 15)))
+        r, g, b, a = original.get_at((15, 15))
+        self.assertEqual(
+            dest.get_at((15, 15)),
+            ((r * 228 + 255) >> 8, g, (b * 50 + 255) >> 8, a),
+        )
+        r, g, b, a = original.get_at((40, 40))
+        self.assertEqual(dest.get_at((40, 40)), ((r * 128 + 255) >> 8, g, 0, a))
+
+    def test_compose_lights__no_lights(self):
+        scene = self._lights_scene((20, 20))
+
+        pygame.transform.compose_lights(scene, (0, 0, 0), [])
+
+        self.assertEqual(scene.get_at((5, 5)), (0, 0, 0, 255))
+
+    def test_compose_lights__bad_args(self):
+        compose_lights = pygame.transform.compose_lights
+        scene = self._lights_scene((20, 20))
+        light = pygame.Surface((4, 4))
+        black = (0, 0, 0)
+
+        self.assertRaises(
+            ValueError, compose_lights, pygame.Surface((4, 4), 0, 24), black, []
+        )
+        self.assertRaises(TypeError, compose_lights, scene, black, [light])
+        self.assertRaises(TypeError, compose_lights, scene, black, [(light, "nope")])
+        self.assertRaises(ValueError, compose_lights, scene, black, [(scene, (0, 0))])
+        self.assertRaises(
+            ValueError,
+            compose_lights,
+            scene,
+            black,
+            [],
+            dest_surface=pygame.Surface((21, 20), 0, 32),
+        )
+
 
 class TransformDisplayModuleTest(unittest.TestCase):
     def setUp(self):
@@ -1371,6 +2491,68 @@ class TransformDisplayModuleTest(unittest.TestCase):
         self.assertEqual(surf.get_at((0, 0)), surf2.get_at((0, 0)))
         self.assertEqual(surf2.get_at((0, 0)), (255, 0, 0, 255))
 
+    def test_flip__in_place(self):
+        """flipping a surface into itself matches a copying flip."""
+        for bpp in (8, 16, 24, 32):
+            for flip_x, flip_y in ((1, 0), (0, 1), (1, 1)):
+                big = pygame.Surface((17, 9), 0, bpp)
+                for x in range(17):
+                    for y in range(9):
+                        big.set_at((x, y), ((x * 15) % 256, y * 28, 99))
+                # a subsurface has a pitch wider than its rows
+                image = big.subsurface((2, 1, 13, 7))
+                expected = pygame.transform.flip(image, flip_x, flip_y)
+
+                result = pygame.transform.flip(image, flip_x, flip_y, image)
+
+                self.assertIs(result, image)
+                self.assertEqual(
+                    pygame.image.tostring(image, "RGB"),
+                    pygame.image.tostring(expected, "RGB"),
+                    f"bpp={bpp} flip_x={flip_x} flip_y={flip_y}",
+                )
+
+    def test_dest_surface(self):
+        """rotate, rotozoom, flip and chop can reuse a destination."""
+        image = pygame.Surface((12, 7), 0, 32)
+        for x in range(12):
+            for y in range(7):
+                image.set_at((x, y), (x * 20, y * 30, 77))
+
+        calls = (
+            (pygame.transform.flip, (image, 1, 0)),
+            (pygame.transform.rotate, (image, 30)),
+            (pygame.transform.rotate, (image, 90)),
+            (pygame.transform.rotozoom, (image, 30, 1.5)),
+            (pygame.transform.rotozoom, (image, 0, 0.5)),
+            (pygame.transform.chop, (image, (2, 2, 3, 3))),
+        )
+        for func, args in calls:
+            expected = func(*args)
+            dest = expected.copy()
+            dest.fill((1, 2, 3))
+
+            result = func(*args, dest_surface=dest)
+
+            self.assertIs(result, dest)
+            self.assertEqual(
+                pygame.image.tostring(dest, "RGBA"),
+                pygame.image.tostring(expected, "RGBA"),
+                func.__name__,
+            )
+
+        wrong_size = pygame.Surface((5, 5), 0, 32)
+        wrong_format = pygame.Surface(image.get_size(), 0, 16)
+        for func, args in calls:
+            with self.assertRaises(ValueError):
+                func(*args, dest_surface=wrong_size)
+        with self.assertRaises(ValueError):
+            pygame.transform.flip(image, 1, 0, wrong_format)
+        with self.assertRaises(ValueError):
+            pygame.transform.chop(image, (0, 0, 0, 0), dest_surface=image)
+        with self.assertRaises(ValueError):
+            pygame.transform.rotate(image, 180, dest_surface=image)
+
 
 if __name__ == "__main__":
     unittest.main()